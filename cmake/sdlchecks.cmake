@@ -259,13 +259,14 @@ macro(CheckX11)
     set(Xcursor_PKG_CONFIG_SPEC xcursor)
     set(Xi_PKG_CONFIG_SPEC xi)
     set(Xfixes_PKG_CONFIG_SPEC xfixes)
+    set(Xpresent_PKG_CONFIG_SPEC xpresent)
     set(Xrandr_PKG_CONFIG_SPEC xrandr)
     set(Xrender_PKG_CONFIG_SPEC xrender)
     set(Xss_PKG_CONFIG_SPEC xscrnsaver)
 
     find_package(X11)
 
-    foreach(_LIB X11 Xext Xcursor Xi Xfixes Xrandr Xrender Xss)
+    foreach(_LIB X11 Xext Xcursor Xi Xfixes Xpresent Xrandr Xrender Xss)
       get_filename_component(_libdir "${X11_${_LIB}_LIB}" DIRECTORY)
       FindLibraryAndSONAME("${_LIB}" LIBDIRS ${_libdir})
     endforeach()
@@ -294,6 +295,7 @@ macro(CheckX11)
     find_file(HAVE_XINPUT2_H NAMES "X11/extensions/XInput2.h" HINTS "${X11_INCLUDEDIR}")
     find_file(HAVE_XRANDR_H NAMES "X11/extensions/Xrandr.h" HINTS "${X11_INCLUDEDIR}")
     find_file(HAVE_XFIXES_H_ NAMES "X11/extensions/Xfixes.h" HINTS "${X11_INCLUDEDIR}")
+    find_file(HAVE_XPRESENT_H NAMES "X11/extensions/Xpresent.h" HINTS "${X11_INCLUDEDIR}")
     find_file(HAVE_XRENDER_H NAMES "X11/extensions/Xrender.h" HINTS "${X11_INCLUDEDIR}")
     find_file(HAVE_XSS_H NAMES "X11/extensions/scrnsaver.h" HINTS "${X11_INCLUDEDIR}")
     find_file(HAVE_XSHAPE_H NAMES "X11/extensions/shape.h" HINTS "${X11_INCLUDEDIR}")
@@ -433,6 +435,17 @@ macro(CheckX11)
         set(HAVE_X11_XFIXES TRUE)
       endif()
 
+      # Xpresent.h pulls in the Xfixes and Xrandr headers for its region and CRTC types
+      if(SDL_X11_XPRESENT AND HAVE_XPRESENT_H AND HAVE_XFIXES_H_ AND HAVE_XRANDR_H AND XPRESENT_LIB)
+        if(HAVE_X11_SHARED)
+          set(SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT "\"${XPRESENT_LIB_SONAME}\"")
+        else()
+          sdl_link_dependency(xpresent LIBS ${XPRESENT_LIB} PKG_CONFIG_SPECS ${Xpresent_PKG_CONFIG_SPEC})
+        endif()
+        set(SDL_VIDEO_DRIVER_X11_XPRESENT 1)
+        set(HAVE_X11_XPRESENT TRUE)
+      endif()
+
       if(SDL_X11_XRANDR AND HAVE_XRANDR_H AND XRANDR_LIB)
         if(HAVE_X11_SHARED)
           set(SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR "\"${XRANDR_LIB_SONAME}\"")
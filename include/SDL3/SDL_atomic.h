@@ -439,6 +439,75 @@ extern SDL_DECLSPEC int SDLCALL SDL_AtomicAdd(SDL_AtomicInt *a, int v);
 #define SDL_AtomicDecRef(a)    (SDL_AtomicAdd(a, -1) == 1)
 #endif
 
+/**
+ * A fair atomic lock.
+ *
+ * A ticket lock hands out the lock in the order threads asked for it, so no
+ * thread can be starved by others that keep grabbing it, which a plain
+ * spinlock allows under heavy contention. Threads that have been waiting
+ * for a while stop spinning and sleep until their turn comes.
+ *
+ * A ticket lock is unlocked when all of its bytes are zero, so it can be
+ * initialized with SDL_zero() or `= { 0 }`. Don't access its fields
+ * directly.
+ *
+ * The ticket locks are not safe to lock recursively.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_LockTicketLock
+ */
+typedef struct SDL_TicketLock
+{
+    SDL_AtomicInt next;
+    SDL_AtomicInt serving;
+    SDL_AtomicInt parked;
+} SDL_TicketLock;
+
+/**
+ * Try to lock a ticket lock without waiting.
+ *
+ * \param lock a pointer to a ticket lock.
+ * \returns SDL_TRUE if the lock succeeded, SDL_FALSE if the lock is already
+ *          held or other threads are waiting for it.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LockTicketLock
+ * \sa SDL_UnlockTicketLock
+ */
+extern SDL_DECLSPEC SDL_bool SDLCALL SDL_TryLockTicketLock(SDL_TicketLock *lock);
+
+/**
+ * Lock a ticket lock, waiting for every thread that asked for it first.
+ *
+ * \param lock a pointer to a ticket lock.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_TryLockTicketLock
+ * \sa SDL_UnlockTicketLock
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_LockTicketLock(SDL_TicketLock *lock);
+
+/**
+ * Unlock a ticket lock and hand it to the next waiting thread.
+ *
+ * \param lock a pointer to a ticket lock locked by the calling thread.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LockTicketLock
+ * \sa SDL_TryLockTicketLock
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_UnlockTicketLock(SDL_TicketLock *lock);
+
 /**
  * Set a pointer to a new value if it is currently an old value.
  *
@@ -355,6 +355,24 @@ typedef struct SDL_AudioSpec
  */
 typedef struct SDL_AudioStream SDL_AudioStream;
 
+/**
+ * The quality of the resampler an audio stream uses when converting between
+ * sample rates.
+ *
+ * Higher quality costs more CPU time per sample frame, and a little more
+ * latency, since the resampler looks further ahead.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+typedef enum SDL_AudioResampleQuality
+{
+    SDL_AUDIO_RESAMPLE_QUALITY_LOW,     /**< Linear interpolation, very cheap but with audible aliasing. Fine for voice. */
+    SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM,  /**< A 12 tap windowed sinc filter. This is the default. */
+    SDL_AUDIO_RESAMPLE_QUALITY_HIGH     /**< A 32 tap polyphase windowed sinc filter, band limited when downsampling. */
+} SDL_AudioResampleQuality;
+
 
 /* Function prototypes */
 
@@ -563,6 +581,50 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid
  */
 extern SDL_DECLSPEC int * SDLCALL SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count);
 
+/**
+ * Get the properties associated with an audio device.
+ *
+ * These read-only properties describe how the physical device behind
+ * `devid` is keeping up. They are updated each time this function is called,
+ * and reset each time the physical device is opened:
+ *
+ * - `SDL_PROP_AUDIODEVICE_LATENCY_NS_NUMBER`: an estimate, in nanoseconds,
+ *   of how long audio takes to get from the device thread to the speakers
+ *   (or from the microphone to the device thread, for recording devices).
+ *   This is the device buffer plus any latency the platform reports.
+ * - `SDL_PROP_AUDIODEVICE_XRUNS_NUMBER`: the number of underruns (playback)
+ *   or overruns (recording). This comes from the platform where it can tell
+ *   SDL; otherwise it counts the times the device thread woke up more than a
+ *   whole buffer late.
+ * - `SDL_PROP_AUDIODEVICE_WAKE_JITTER_NS_NUMBER`: the biggest difference, in
+ *   nanoseconds, between when the device thread woke up and when it was
+ *   expected to.
+ * - `SDL_PROP_AUDIODEVICE_MIX_TIME_NS_NUMBER`: how long, in nanoseconds, the
+ *   last device iteration spent converting and mixing.
+ * - `SDL_PROP_AUDIODEVICE_MAX_MIX_TIME_NS_NUMBER`: the longest time, in
+ *   nanoseconds, any device iteration spent converting and mixing.
+ *
+ * Logical devices report the values of their physical device, so the
+ * property ID returned can change if a default device moves to new hardware.
+ *
+ * \param devid the instance ID of the device to query.
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid);
+
+#define SDL_PROP_AUDIODEVICE_LATENCY_NS_NUMBER      "SDL.audiodevice.latency_ns"
+#define SDL_PROP_AUDIODEVICE_XRUNS_NUMBER           "SDL.audiodevice.xruns"
+#define SDL_PROP_AUDIODEVICE_WAKE_JITTER_NS_NUMBER  "SDL.audiodevice.wake_jitter_ns"
+#define SDL_PROP_AUDIODEVICE_MIX_TIME_NS_NUMBER     "SDL.audiodevice.mix_time_ns"
+#define SDL_PROP_AUDIODEVICE_MAX_MIX_TIME_NS_NUMBER "SDL.audiodevice.max_mix_time_ns"
+
 /**
  * Open a specific audio device.
  *
@@ -938,6 +1000,45 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
 /**
  * Get the properties associated with an audio stream.
  *
+ * The following read-write properties are provided by SDL:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER`: the SDL_AudioResampleQuality
+ *   used when the stream's input and output sample rates differ. This can be
+ *   changed at any time and takes effect on the next data retrieved from the
+ *   stream. This defaults to SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM.
+ * - `SDL_PROP_AUDIOSTREAM_QUEUE_CHUNK_SIZE_NUMBER`: the size, in bytes, of
+ *   the chunks of memory data put into the stream is copied into. This
+ *   defaults to 8192, and a change takes effect the next time data is put
+ *   into an empty stream.
+ * - `SDL_PROP_AUDIOSTREAM_QUEUE_MAX_FREE_CHUNKS_NUMBER`: how many chunks the
+ *   stream keeps around for reuse once their data has been read, instead of
+ *   freeing them. This defaults to 4.
+ * - `SDL_PROP_AUDIOSTREAM_QUEUE_RESERVED_CHUNKS_NUMBER`: how many chunks to
+ *   allocate up front, so that putting that much data into the stream
+ *   doesn't allocate. The stream keeps at least this many around for reuse.
+ *   This defaults to 0.
+ * - `SDL_PROP_AUDIOSTREAM_QUEUE_REALTIME_BOOLEAN`: if SDL_TRUE, chunks are
+ *   never freed while the stream exists, so the thread reading from the
+ *   stream (usually an audio device thread) never frees memory, and once the
+ *   stream has reserved enough chunks for the most data it holds at once,
+ *   putting data doesn't allocate. This defaults to SDL_FALSE.
+ *
+ * The queue settings take effect the next time data is put into the stream,
+ * and any chunks they reserve are allocated by the thread putting the data.
+ *
+ * These read-only properties are updated each time this function is called,
+ * and can be used to monitor the stream:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_QUEUED_FRAMES_NUMBER`: the number of sample frames,
+ *   in the output format, that the stream has ready to be read.
+ * - `SDL_PROP_AUDIOSTREAM_LATENCY_NS_NUMBER`: an estimate of how long, in
+ *   nanoseconds, data put into the stream now will take to be heard. This is
+ *   the queued data plus the latency of the device the stream is bound to,
+ *   if any.
+ * - `SDL_PROP_AUDIOSTREAM_UNDERRUNS_NUMBER`: the number of times a request
+ *   for data came back short. Short requests only count again once more data
+ *   has been put into the stream, so a stream that stays empty counts once.
+ *
  * \param stream the SDL_AudioStream to query.
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -946,6 +1047,15 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioStreamProperties(SDL_AudioStream *stream);
 
+#define SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER "SDL.audiostream.resample_quality"
+#define SDL_PROP_AUDIOSTREAM_QUEUE_CHUNK_SIZE_NUMBER      "SDL.audiostream.queue.chunk_size"
+#define SDL_PROP_AUDIOSTREAM_QUEUE_MAX_FREE_CHUNKS_NUMBER  "SDL.audiostream.queue.max_free_chunks"
+#define SDL_PROP_AUDIOSTREAM_QUEUE_RESERVED_CHUNKS_NUMBER  "SDL.audiostream.queue.reserved_chunks"
+#define SDL_PROP_AUDIOSTREAM_QUEUE_REALTIME_BOOLEAN        "SDL.audiostream.queue.realtime"
+#define SDL_PROP_AUDIOSTREAM_QUEUED_FRAMES_NUMBER    "SDL.audiostream.queued_frames"
+#define SDL_PROP_AUDIOSTREAM_LATENCY_NS_NUMBER       "SDL.audiostream.latency_ns"
+#define SDL_PROP_AUDIOSTREAM_UNDERRUNS_NUMBER        "SDL.audiostream.underruns"
+
 /**
  * Query the current format of an audio stream.
  *
@@ -1262,9 +1372,134 @@ extern SDL_DECLSPEC int SDLCALL SDL_SetAudioStreamOutputChannelMap(SDL_AudioStre
  * \sa SDL_FlushAudioStream
  * \sa SDL_GetAudioStreamData
  * \sa SDL_GetAudioStreamQueued
+ * \sa SDL_PutAudioStreamDataNoCopy
  */
 extern SDL_DECLSPEC int SDLCALL SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len);
 
+/**
+ * A callback that fires when a buffer handed to an audio stream is no longer
+ * needed.
+ *
+ * Apps pass this to SDL_PutAudioStreamDataNoCopy. Once it fires, SDL will not
+ * touch the buffer again, and the app may free or reuse it.
+ *
+ * \param userdata an opaque pointer provided by the app for their personal
+ *                 use.
+ * \param buf the pointer that was passed to SDL_PutAudioStreamDataNoCopy.
+ * \param buflen the length, in bytes, that was passed to
+ *               SDL_PutAudioStreamDataNoCopy.
+ *
+ * \threadsafety This callback may run from any thread, usually the one
+ *               reading from the stream. The stream's lock is held while it
+ *               runs, so it should return quickly.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+typedef void (SDLCALL *SDL_AudioStreamDataCompleteCallback)(void *userdata, const void *buf, int buflen);
+
+/**
+ * Add data to the stream without copying it.
+ *
+ * This works like SDL_PutAudioStreamData, but the stream keeps a pointer to
+ * `buf` instead of copying it. The app must not change or free the buffer
+ * until `callback` fires, which happens once the stream has read all of the
+ * buffer's data and moved on to data added after it, once the stream has
+ * been flushed and drained, or when the stream is cleared or destroyed.
+ *
+ * If `len` is zero, `callback` fires before this function returns. If this
+ * function fails, `callback` does not fire and the app still owns `buf`.
+ *
+ * \param stream the stream the audio data is being added to.
+ * \param buf a pointer to the audio data to add.
+ * \param len the number of bytes to add to the stream.
+ * \param callback the function to call when `buf` is no longer needed. Can
+ *                 be NULL if the app has another way to know the buffer is
+ *                 done.
+ * \param userdata an opaque pointer provided to the callback for its own
+ *                 personal use.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but if the
+ *               stream has a callback set, the caller might need to manage
+ *               extra locking.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ClearAudioStream
+ * \sa SDL_GetAudioStreamData
+ * \sa SDL_PutAudioStreamData
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata);
+
+/**
+ * Add planar data to the stream.
+ *
+ * This works like SDL_PutAudioStreamData, but takes one buffer per channel
+ * instead of interleaved sample frames, as many decoders and DSP libraries
+ * produce. Each buffer holds `num_samples` samples in the stream's input
+ * format, and the channels are interleaved (with SIMD where available) as
+ * they are added.
+ *
+ * An entry in `channel_buffers` may be NULL, in which case that channel is
+ * filled with silence.
+ *
+ * \param stream the stream the audio data is being added to.
+ * \param channel_buffers an array of `num_channels` pointers, one per
+ *                        channel, in the stream's input channel order.
+ * \param num_channels the number of entries in `channel_buffers`. This
+ *                     must match the channel count of the stream's input
+ *                     format, or be -1 to use it.
+ * \param num_samples the number of samples in each channel buffer.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but if the
+ *               stream has a callback set, the caller might need to manage
+ *               extra locking.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ * \sa SDL_SetAudioStreamFormat
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PutAudioStreamPlanarData(SDL_AudioStream *stream, const void * const *channel_buffers, int num_channels, int num_samples);
+
+/**
+ * Let one thread add data to a stream without waiting on the stream's lock.
+ *
+ * By default, SDL_PutAudioStreamData() and SDL_GetAudioStreamData() both
+ * hold the stream's lock, so an app thread putting data can stall the audio
+ * device thread that is pulling it, and the other way around.
+ *
+ * In single producer mode, SDL_PutAudioStreamData() copies data into a
+ * lock-free ring buffer, and the data is moved into the stream the next
+ * time anything else uses the stream. Puts that don't fit in the ring, or
+ * happen while a put callback is set, quietly use the locked path, so the
+ * data is always added in order.
+ *
+ * Only one thread may call SDL_PutAudioStreamData() on the stream while this
+ * is enabled, and that thread should also be the one that changes the
+ * stream's input format and channel map. Other functions can still be
+ * called from any thread.
+ *
+ * \param stream the stream to change.
+ * \param single_producer SDL_TRUE if only one thread puts data, SDL_FALSE to
+ *                        go back to locking on every put (the default).
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               no other thread is putting data at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetAudioStreamSingleProducer(SDL_AudioStream *stream, SDL_bool single_producer);
+
 /**
  * Get converted/resampled data from the stream.
  *
@@ -1802,6 +2037,75 @@ typedef void (SDLCALL *SDL_AudioPostmixCallback)(void *userdata, const SDL_Audio
  */
 extern SDL_DECLSPEC int SDLCALL SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata);
 
+/**
+ * A callback that reads or writes an audio device's buffer directly.
+ *
+ * This is used with SDL_SetAudioDeviceCallback, for apps that want the
+ * lowest possible latency and are willing to handle the device's native
+ * format themselves.
+ *
+ * For playback devices, the callback must fill all of `buffer` with audio
+ * data in the format described by `spec`; whatever is in the buffer when the
+ * callback returns is passed to the hardware. For recording devices,
+ * `buffer` holds audio that was just recorded, in the format described by
+ * `spec`, and the callback should consume it before returning.
+ *
+ * `spec` can change between calls if the device changed, and `buflen` can be
+ * smaller than the device's buffer size on some platforms.
+ *
+ * \param userdata a pointer provided by the app through
+ *                 SDL_SetAudioDeviceCallback, for its own use.
+ * \param spec the device's current audio format.
+ * \param buffer the device buffer to fill or read.
+ * \param buflen the size of `buffer` in bytes.
+ *
+ * \threadsafety This will run from the audio device thread, while holding
+ *               the device's lock. It must not block, and should return as
+ *               quickly as possible.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioDeviceCallback
+ */
+typedef void (SDLCALL *SDL_AudioDeviceCallback)(void *userdata, const SDL_AudioSpec *spec, Uint8 *buffer, int buflen);
+
+/**
+ * Give an opened audio device's buffer directly to an app callback.
+ *
+ * While a callback is set, SDL skips its usual pipeline for this device. It
+ * does no stream queueing, no format conversion, no mixing and no postmix.
+ * The callback is called on the device thread with the buffer that goes to
+ * (or came from) the hardware, in the device's native format, once for each
+ * buffer the hardware wants. Use SDL_GetAudioDeviceFormat to find the format
+ * and buffer size, and SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES to ask for a
+ * buffer size before the device is opened.
+ *
+ * The logical device must be the only device opened on its physical device,
+ * and no other device can be opened on that physical device while the
+ * callback is set. Streams bound to the device are ignored. While the device
+ * is paused, playback devices play silence and recorded data is dropped.
+ *
+ * This function will block until the audio device is in between iterations,
+ * so any existing callback that might be running will finish before this
+ * function sets the new callback and returns.
+ *
+ * Setting a NULL callback function goes back to the normal audio pipeline.
+ *
+ * \param devid the ID of an opened audio device.
+ * \param callback a callback function to be called. Can be NULL.
+ * \param userdata app-controlled pointer passed to callback. Can be NULL.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceFormat
+ * \sa SDL_OpenAudioDevice
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetAudioDeviceCallback(SDL_AudioDeviceID devid, SDL_AudioDeviceCallback callback, void *userdata);
+
 
 /**
  * Load the audio data of a WAVE file into memory.
@@ -1922,6 +2226,78 @@ extern SDL_DECLSPEC int SDLCALL SDL_LoadWAV_IO(SDL_IOStream * src, SDL_bool clos
 extern SDL_DECLSPEC int SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec * spec,
                                         Uint8 ** audio_buf, Uint32 * audio_len);
 
+/**
+ * Open a WAVE file as an audio stream that decodes on demand.
+ *
+ * Unlike SDL_LoadWAV_IO, this does not decode the whole file into memory.
+ * The WAVE headers are parsed immediately, but the audio data is read from
+ * `src` and decoded one block at a time, from the stream's get callback,
+ * whenever the stream needs more data. Memory use stays constant no matter
+ * how long the file is, which makes this suitable for music.
+ *
+ * The returned stream's input format is the decoded WAVE format (the same
+ * spec SDL_LoadWAV_IO would report), and its output format is initially the
+ * same. Change the output format with SDL_SetAudioStreamFormat, or bind the
+ * stream to a device with SDL_BindAudioStream, which does so automatically.
+ *
+ * The stream owns `src` until it is destroyed with SDL_DestroyAudioStream;
+ * the app must not read from or seek `src` in the meantime. If `closeio` is
+ * SDL_TRUE, `src` is closed when the stream is destroyed, or immediately if
+ * this function fails.
+ *
+ * The stream's get callback is used to feed it; replacing it with
+ * SDL_SetAudioStreamGetCallback stops the decoding. When the end of the
+ * audio data is reached, the stream is flushed so the remaining audio can
+ * be fully consumed. Use SDL_SeekWAVStream to rewind or loop.
+ *
+ * The stream's properties have `SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER` set
+ * to the total number of sample frames in the file.
+ *
+ * This supports the same encodings and respects the same hints as
+ * SDL_LoadWAV_IO.
+ *
+ * \param src the data source for the WAVE data.
+ * \param closeio if SDL_TRUE, calls SDL_CloseIO() on `src` when the stream
+ *                is destroyed or this function fails.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's format details on successful return. May be NULL.
+ * \returns a new audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_LoadWAV_IO
+ * \sa SDL_SeekWAVStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_OpenWAVStream(SDL_IOStream *src, SDL_bool closeio, SDL_AudioSpec *spec);
+
+#define SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER "SDL.audiostream.wav.frames"
+
+/**
+ * Seek an audio stream opened with SDL_OpenWAVStream.
+ *
+ * Any audio already queued in the stream is discarded, and decoding resumes
+ * at sample frame `frame`. The decoder jumps straight to the block that
+ * contains the frame (for ADPCM, a compressed block; every block can be
+ * decoded on its own), so seeking does not decode anything that is not
+ * played. Seeking past the end puts the stream at the end of the audio.
+ *
+ * \param stream an audio stream returned by SDL_OpenWAVStream.
+ * \param frame the sample frame to continue decoding from.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWAVStream
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SeekWAVStream(SDL_AudioStream *stream, Uint64 frame);
+
 /**
  * Mix audio data in a specified format.
  *
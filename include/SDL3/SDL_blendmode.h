@@ -72,7 +72,10 @@ typedef enum SDL_BlendOperation
     SDL_BLENDOPERATION_SUBTRACT         = 0x2,  /**< src - dst : supported by D3D, OpenGL, OpenGLES, and Vulkan */
     SDL_BLENDOPERATION_REV_SUBTRACT     = 0x3,  /**< dst - src : supported by D3D, OpenGL, OpenGLES, and Vulkan */
     SDL_BLENDOPERATION_MINIMUM          = 0x4,  /**< min(dst, src) : supported by D3D, OpenGL, OpenGLES, and Vulkan */
-    SDL_BLENDOPERATION_MAXIMUM          = 0x5   /**< max(dst, src) : supported by D3D, OpenGL, OpenGLES, and Vulkan */
+    SDL_BLENDOPERATION_MAXIMUM          = 0x5,  /**< max(dst, src) : supported by D3D, OpenGL, OpenGLES, and Vulkan */
+    SDL_BLENDOPERATION_MULTIPLY         = 0x6,  /**< src * dst, blended over dst with srcA : supported by OpenGLES with EXT_shader_framebuffer_fetch */
+    SDL_BLENDOPERATION_SCREEN           = 0x7,  /**< src + dst - src * dst, blended over dst with srcA : supported by OpenGLES with EXT_shader_framebuffer_fetch */
+    SDL_BLENDOPERATION_OVERLAY          = 0x8   /**< multiply or screen depending on dst, blended over dst with srcA : supported by OpenGLES with EXT_shader_framebuffer_fetch */
 } SDL_BlendOperation;
 
 /**
@@ -127,6 +130,20 @@ typedef enum SDL_BlendFactor
  * - `min(src, dst)`
  * - `max(src, dst)`
  *
+ * The `SDL_BLENDOPERATION_MULTIPLY`, `SDL_BLENDOPERATION_SCREEN` and
+ * `SDL_BLENDOPERATION_OVERLAY` operations can't be done with the factors
+ * above, so they ignore them and the alpha operation. As a color operation,
+ * they compute:
+ *
+ * ```c
+ * dstRGB = (blend(srcRGB, dstRGB) * srcA) + (dstRGB * (1-srcA));
+ * dstA = srcA + (dstA * (1-srcA));
+ * ```
+ *
+ * Where `blend(src, dst)` is `src * dst` for multiply,
+ * `src + dst - src * dst` for screen, and for overlay `2 * src * dst` where
+ * `dst` is below 0.5 and `1 - 2 * (1 - src) * (1 - dst)` elsewhere.
+ *
  * The red, green, and blue components are always multiplied with the first,
  * second, and third components of the SDL_BlendFactor, respectively. The
  * fourth component is not used.
@@ -152,7 +169,10 @@ typedef enum SDL_BlendFactor
  *   factors. OpenGL versions 1.1, 1.2, and 1.3 do not work correctly here.
  * - **opengles2**: Supports the `SDL_BLENDOPERATION_ADD`,
  *   `SDL_BLENDOPERATION_SUBTRACT`, `SDL_BLENDOPERATION_REV_SUBTRACT`
- *   operations with all factors.
+ *   operations with all factors. With the EXT_shader_framebuffer_fetch
+ *   extension it also supports `SDL_BLENDOPERATION_MULTIPLY`,
+ *   `SDL_BLENDOPERATION_SCREEN` and `SDL_BLENDOPERATION_OVERLAY`, which read
+ *   the render target in the fragment shader without extra passes.
  * - **psp**: No custom blend mode support.
  * - **software**: No custom blend mode support.
  *
@@ -350,6 +350,24 @@ extern SDL_DECLSPEC SDL_CameraID SDLCALL SDL_GetCameraID(SDL_Camera *camera);
 /**
  * Get the properties associated with an opened camera.
  *
+ * The following properties may be set by the app to control how frames are
+ * queued while waiting for SDL_AcquireCameraFrame(), and take effect for the
+ * next frame that arrives:
+ *
+ * - `SDL_PROP_CAMERA_FRAME_QUEUE_DEPTH_NUMBER`: the maximum number of frames
+ *   to hold for the app before new frames are dropped, between 1 and 8. The
+ *   default is 8. A smaller queue bounds latency for real-time processing.
+ * - `SDL_PROP_CAMERA_DROP_OLDEST_BOOLEAN`: true if a full queue should throw
+ *   away its oldest frame to make room for a new one, false to throw away
+ *   the new frame instead. The default is false.
+ *
+ * These properties are updated by SDL and can be read by the app:
+ *
+ * - `SDL_PROP_CAMERA_DROPPED_FRAMES_NUMBER`: the number of frames that were
+ *   thrown away without being delivered to the app.
+ * - `SDL_PROP_CAMERA_LATE_FRAMES_NUMBER`: the number of frames the app
+ *   acquired when a newer frame was already waiting.
+ *
  * \param camera the SDL_Camera obtained from SDL_OpenCamera().
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -360,6 +378,11 @@ extern SDL_DECLSPEC SDL_CameraID SDLCALL SDL_GetCameraID(SDL_Camera *camera);
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetCameraProperties(SDL_Camera *camera);
 
+#define SDL_PROP_CAMERA_FRAME_QUEUE_DEPTH_NUMBER    "SDL.camera.frame_queue_depth"
+#define SDL_PROP_CAMERA_DROP_OLDEST_BOOLEAN         "SDL.camera.drop_oldest"
+#define SDL_PROP_CAMERA_DROPPED_FRAMES_NUMBER       "SDL.camera.dropped_frames"
+#define SDL_PROP_CAMERA_LATE_FRAMES_NUMBER          "SDL.camera.late_frames"
+
 /**
  * Get the spec that a camera is using when generating images.
  *
@@ -414,6 +437,17 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_Came
  * SDL_EVENT_CAMERA_DEVICE_DENIED) event, or poll SDL_IsCameraApproved()
  * occasionally until it returns non-zero.
  *
+ * On platforms that support it, frames that are passed through without
+ * conversion may also expose the underlying buffer for zero-copy import
+ * into a GPU texture, through the following properties on the returned
+ * surface's SDL_GetSurfaceProperties():
+ *
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER`: (Linux) a DMA-BUF file
+ *   descriptor for the frame's pixels, owned by SDL and only valid until the
+ *   frame is released. This can be passed to SDL_CreateTextureWithProperties()
+ *   as `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_FD_NUMBER`, with the surface's
+ *   pitch as the plane's pitch.
+ *
  * \param camera opened camera device.
  * \param timestampNS a pointer filled in with the frame's timestamp, or 0 on
  *                    error. Can be NULL.
@@ -428,6 +462,8 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_Came
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_AcquireCameraFrame(SDL_Camera *camera, Uint64 *timestampNS);
 
+#define SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER "SDL.camera.frame.dmabuf_fd"
+
 /**
  * Release a frame of video acquired from a camera.
  *
@@ -33,6 +33,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -227,6 +228,38 @@ extern SDL_DECLSPEC int SDLCALL SDL_ClearClipboardData(void);
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_GetClipboardData(const char *mime_type, size_t *size);
 
+/**
+ * Open a stream that reads the clipboard data for a given mime type.
+ *
+ * Unlike SDL_GetClipboardData(), this doesn't have to hold all of the data
+ * in memory at once. On Wayland the stream reads from the transfer pipe as
+ * the other application writes to it, and on X11 large selections are
+ * fetched one INCR chunk at a time as the stream is read, so an application
+ * can process or save a very large clipboard image piece by piece. Streams
+ * like these can't seek and report their size as unknown. On other
+ * platforms the data is fetched up front and the stream reads from that.
+ *
+ * If the clipboard data belongs to this application, the stream reads
+ * directly from the buffer returned by its SDL_ClipboardDataCallback, so
+ * that buffer must stay valid until the stream is closed.
+ *
+ * Reading from the stream may need to process events, so it must be used
+ * on the main thread.
+ *
+ * \param mime_type the mime type to read from the clipboard.
+ * \returns a read-only SDL_IOStream, which should be closed with
+ *          SDL_CloseIO() when no longer needed, or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetClipboardData
+ * \sa SDL_HasClipboardData
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_OpenClipboardData(const char *mime_type);
+
 /**
  * Query whether there is data in the clipboard for the provided mime type.
  *
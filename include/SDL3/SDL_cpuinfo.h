@@ -64,6 +64,72 @@ extern "C" {
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetCPUCount(void);
 
+/**
+ * The classes of CPU cores found on hybrid processors.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUCoreCount
+ * \sa SDL_GetCPUCoreMask
+ */
+typedef enum SDL_CPUCoreType
+{
+    SDL_CPU_CORE_TYPE_ANY,          /**< All logical CPU cores */
+    SDL_CPU_CORE_TYPE_PERFORMANCE,  /**< The fastest cores (P-cores, big cores), or all cores if the processor isn't hybrid */
+    SDL_CPU_CORE_TYPE_EFFICIENCY    /**< The slower, power efficient cores (E-cores, LITTLE cores) */
+} SDL_CPUCoreType;
+
+/**
+ * Get the number of logical CPU cores of a given class.
+ *
+ * Processors that don't mix core types, and platforms that don't report
+ * them, have only performance cores.
+ *
+ * \param type the class of cores to count.
+ * \returns the number of logical CPU cores of that class, which may be 0.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUCount
+ * \sa SDL_GetCPUCoreMask
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetCPUCoreCount(SDL_CPUCoreType type);
+
+/**
+ * Get the logical CPU cores of a given class as a bitmask.
+ *
+ * Bit N of the result is set if logical CPU N is of the requested class.
+ * Only the first 64 logical CPUs are reported. The result can be used with
+ * `SDL_PROP_THREAD_CREATE_AFFINITY_MASK_NUMBER`.
+ *
+ * \param type the class of cores to get.
+ * \returns a bitmask of logical CPUs, or 0 if there are no cores of that
+ *          class or the platform doesn't report which CPUs they are.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUCoreCount
+ * \sa SDL_CreateThreadWithProperties
+ */
+extern SDL_DECLSPEC Uint64 SDLCALL SDL_GetCPUCoreMask(SDL_CPUCoreType type);
+
+/**
+ * Get the logical CPU cores that share the last level cache with a CPU.
+ *
+ * Threads that work on the same data run best on CPUs that share a cache.
+ * Bit N of the result is set if logical CPU N shares its last level cache
+ * with `cpu`, including `cpu` itself. Only the first 64 logical CPUs are
+ * reported. If the cache topology isn't known, only `cpu` is set.
+ *
+ * \param cpu the index of a logical CPU, from 0 to 63.
+ * \returns a bitmask of logical CPUs, or 0 if `cpu` is out of range.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetCPUCoreMask
+ */
+extern SDL_DECLSPEC Uint64 SDLCALL SDL_GetCPUCacheSharingMask(int cpu);
+
 /**
  * Determine the L1 cache line size of the CPU.
  *
@@ -1128,6 +1128,74 @@ extern SDL_DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType)
  */
 extern SDL_DECLSPEC SDL_bool SDLCALL SDL_PollEvent(SDL_Event *event);
 
+/**
+ * Poll for many currently pending events at once.
+ *
+ * This behaves like calling SDL_PollEvent() in a loop until it returns
+ * SDL_FALSE or `numevents` events have been retrieved, but takes the event
+ * queue lock only once. This makes it cheap to drain a large backlog of
+ * events, like the motion events from a high polling rate mouse or pen.
+ *
+ * Like SDL_PollEvent(), this stops at the end of the current poll cycle, so
+ * events added after the queue was pumped will be returned by the next call.
+ *
+ * As this function may implicitly call SDL_PumpEvents(), you can only call
+ * this function in the thread that set the video mode.
+ *
+ * ```c
+ * while (game_is_still_running) {
+ *     SDL_Event events[64];
+ *     int i, count;
+ *     while ((count = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+ *         for (i = 0; i < count; ++i) {
+ *             // decide what to do with events[i].
+ *         }
+ *     }
+ *
+ *     // update game state, draw the current frame
+ * }
+ * ```
+ *
+ * \param events destination buffer for the retrieved events.
+ * \param numevents the maximum number of events to store in `events`.
+ * \returns the number of events stored in `events`, 0 if there are none
+ *          available, or -1 on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_PollEvent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event *events, int numevents);
+
+/**
+ * Retrieve the raw motion samples recorded while motion coalescing is
+ * enabled.
+ *
+ * When SDL_HINT_EVENT_COALESCE_MOTION is enabled, every mouse, finger and
+ * pen motion event pushed onto the queue is also recorded here before it is
+ * merged, so applications that need every sample (for example, for drawing)
+ * can still get them. Each sample keeps its timestamp and the device it came
+ * from. The history holds the most recent 1024 samples; older ones are
+ * discarded if they aren't retrieved in time.
+ *
+ * The samples are removed from the history as they are retrieved, oldest
+ * first.
+ *
+ * \param events destination buffer for the samples.
+ * \param numevents the maximum number of samples to store in `events`.
+ * \returns the number of samples stored in `events`, or -1 on error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetMotionHistory(SDL_Event *events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -1178,6 +1246,50 @@ extern SDL_DECLSPEC SDL_bool SDLCALL SDL_WaitEvent(SDL_Event *event);
  */
 extern SDL_DECLSPEC SDL_bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 timeoutMS);
 
+/**
+ * Get an OS wait handle that is signaled when SDL has events to deliver.
+ *
+ * This lets an application that blocks in its own event loop, such as a
+ * network server waiting in epoll, kqueue or WaitForMultipleObjects(), wait
+ * for SDL events at the same time as everything else, instead of waking up
+ * on a timer to poll SDL.
+ *
+ * The following read-only properties are provided:
+ *
+ * - `SDL_PROP_EVENT_WAIT_FD_NUMBER`: a file descriptor that is readable
+ *   while the handle is signaled, on Linux and other Unix platforms. On
+ *   Linux this is an epoll descriptor that also becomes readable when the
+ *   video backend has input waiting, such as the X11 or Wayland connection
+ *   or Linux evdev devices.
+ * - `SDL_PROP_EVENT_WAIT_HANDLE_POINTER`: a Win32 manual-reset event HANDLE,
+ *   on Windows. Window messages don't signal it, so wait on it with
+ *   MsgWaitForMultipleObjects() to catch those too.
+ *
+ * The handle is signaled when an event is added to the queue, and reset by
+ * SDL_PumpEvents(), which SDL_PollEvent() and SDL_WaitEvent() call. When it
+ * is signaled, call SDL_PollEvent() until it returns SDL_FALSE before
+ * waiting on it again. Devices that SDL has to poll, such as some joysticks
+ * and sensors, only generate events when SDL_PumpEvents() is called, so
+ * applications that use them should still wait with a timeout.
+ *
+ * The handle is created the first time this is called and stays valid
+ * until SDL_Quit(). Applications must not read from, write to or close it.
+ *
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PollEvent
+ * \sa SDL_PumpEvents
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetEventWaitProperties(void);
+
+#define SDL_PROP_EVENT_WAIT_FD_NUMBER       "SDL.events.wait.fd"
+#define SDL_PROP_EVENT_WAIT_HANDLE_POINTER  "SDL.events.wait.handle"
+
 /**
  * Add an event to the event queue.
  *
@@ -1338,6 +1338,48 @@ extern SDL_DECLSPEC float SDLCALL SDL_GetGamepadSensorDataRate(SDL_Gamepad *game
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetGamepadSensorData(SDL_Gamepad *gamepad, SDL_SensorType type, float *data, int num_values);
 
+/**
+ * A single timestamped gamepad sensor reading.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetGamepadSensorDataBatch
+ */
+typedef struct SDL_GamepadSensorSample
+{
+    Uint64 timestamp;        /**< In nanoseconds, populated using SDL_GetTicksNS() */
+    Uint64 sensor_timestamp; /**< The timestamp of the sensor reading in nanoseconds, not necessarily synchronized with the system clock */
+    float data[3];           /**< Up to 3 values from the sensor, as reported by SDL_GetGamepadSensorData() */
+} SDL_GamepadSensorSample;
+
+/**
+ * Read the buffered samples of a gamepad sensor.
+ *
+ * Sensors on some gamepads report at several hundred samples per second,
+ * more than the latest value from SDL_GetGamepadSensorData() can show. This
+ * function returns every sample received since the last call, oldest first,
+ * so motion controls can integrate all of them.
+ *
+ * Buffering starts with the first call for a sensor, which usually returns
+ * no samples. Up to 256 samples are kept per sensor; if they aren't read in
+ * time the oldest ones are dropped. The sensor must be enabled with
+ * SDL_SetGamepadSensorEnabled() to receive samples.
+ *
+ * \param gamepad the gamepad to query.
+ * \param type the type of sensor to query.
+ * \param samples an array filled with the buffered samples.
+ * \param num_samples the number of elements in samples.
+ * \returns the number of samples written, which are removed from the buffer,
+ *          or a negative error code on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetGamepadSensorData
+ * \sa SDL_SetGamepadSensorEnabled
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetGamepadSensorDataBatch(SDL_Gamepad *gamepad, SDL_SensorType type, SDL_GamepadSensorSample *samples, int num_samples);
+
 /**
  * Start a rumble effect on a gamepad.
  *
@@ -197,6 +197,24 @@ extern "C" {
  */
 #define SDL_HINT_APPLE_TV_REMOTE_ALLOW_ROTATION "SDL_APPLE_TV_REMOTE_ALLOW_ROTATION"
 
+/**
+ * A variable that specifies which async I/O backend to use.
+ *
+ * By default, SDL uses the platform's native async I/O facility when it is
+ * available and falls back to a pool of background threads otherwise.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "io_uring": Use io_uring on Linux.
+ * - "generic": Use the thread pool implementation on every platform.
+ *
+ * This hint is read when the first SDL_AsyncIO object or queue is created,
+ * and again after SDL_Quit().
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_ASYNCIO_DRIVER "SDL_ASYNCIO_DRIVER"
+
 /**
  * Specify the default ALSA audio device name.
  *
@@ -367,7 +385,11 @@ extern "C" {
  *
  * The disk audio driver normally simulates real-time for the audio rate that
  * was specified, but you can use this variable to adjust this rate higher or
- * lower down to 0. The default value is "1.0".
+ * lower down to 0. The value is the fraction of real time each buffer takes,
+ * so "0.5" runs twice as fast as real time. "0" processes buffers as fast as
+ * the app can generate them, which is useful for rendering audio offline,
+ * but streams should be fed from a callback in that case, since anything
+ * pushed at real-time rates will underrun. The default value is "1.0".
  *
  * This hint should be set before an audio device is opened.
  *
@@ -394,7 +416,11 @@ extern "C" {
  *
  * The dummy audio driver normally simulates real-time for the audio rate that
  * was specified, but you can use this variable to adjust this rate higher or
- * lower down to 0. The default value is "1.0".
+ * lower down to 0. The value is the fraction of real time each buffer takes,
+ * so "0.5" runs twice as fast as real time. "0" processes buffers as fast as
+ * the app can generate them, which is useful for rendering audio offline,
+ * but streams should be fed from a callback in that case, since anything
+ * pushed at real-time rates will underrun. The default value is "1.0".
  *
  * This hint should be set before an audio device is opened.
  *
@@ -460,6 +486,31 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_INCLUDE_MONITORS "SDL_AUDIO_INCLUDE_MONITORS"
 
+/**
+ * A variable controlling how many threads mix the streams bound to a playback
+ * device.
+ *
+ * When a logical device has many bound streams, converting and resampling
+ * them can be spread over a small pool of worker threads. The device thread
+ * takes part in the work and every stream is still mixed before the buffer
+ * is handed to the device, so this doesn't add any latency.
+ *
+ * Note that while this is enabled, an audio stream's get callback can be
+ * called from one of the worker threads, and callbacks of different streams
+ * can run at the same time.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "1": Streams are mixed on the device thread. (default)
+ * - "0": Use one thread per CPU core.
+ * - "N": Use up to N threads, including the device thread.
+ *
+ * This hint can be set anytime, and takes effect on the next device buffer.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_AUDIO_MIX_THREADS "SDL_AUDIO_MIX_THREADS"
+
 /**
  * A variable controlling whether SDL updates joystick state when getting
  * input events.
@@ -555,6 +606,7 @@ extern "C" {
  * - "neon"
  * - "lsx"
  * - "lasx"
+ * - "pclmul"
  *
  * The items can be prefixed by '+'/'-' to add/remove features.
  *
@@ -623,6 +675,27 @@ extern "C" {
  */
 #define SDL_HINT_DISPLAY_USABLE_BOUNDS "SDL_DISPLAY_USABLE_BOUNDS"
 
+/**
+ * A variable controlling whether SDL_Init() loads driver libraries on a
+ * background thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Each driver loads its own libraries as it's probed.
+ * - "1": Libraries that driver probing will need, like the audio server and
+ *   windowing system client libraries, are loaded on a background thread
+ *   while the other subsystems initialize. Driver selection is not affected.
+ *   (default)
+ *
+ * This only has an effect on platforms where SDL loads driver libraries
+ * dynamically.
+ *
+ * This hint should be set before calling SDL_Init().
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_DRIVER_PRELOAD "SDL_DRIVER_PRELOAD"
+
 /**
  * Disable giving back control to the browser automatically when running with
  * asyncify.
@@ -711,6 +784,32 @@ extern "C" {
  */
 #define SDL_HINT_EVDEV_DEVICES "SDL_EVDEV_DEVICES"
 
+/**
+ * A variable controlling whether consecutive motion events are merged.
+ *
+ * High polling rate mice, touch screens and pen tablets can report thousands
+ * of positions per second. When this is enabled, mouse, finger and pen motion
+ * events for the same device, finger, window and button state are merged
+ * into the most recently pushed one until some other event is pushed or the
+ * event queue is read. The merged mouse and finger events report the latest
+ * position and the accumulated xrel/yrel or dx/dy.
+ * Button, wheel, window and all other events are not merged and keep their
+ * exact order relative to the motion.
+ *
+ * Event watchers still see every motion event, and the raw samples are
+ * available from SDL_GetMotionHistory().
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Every motion event is queued separately. (default)
+ * - "1": Consecutive motion events are merged.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
 /**
  * A variable controlling verbosity of the logging of SDL events pushed onto
  * the internal queue.
@@ -1971,12 +2070,18 @@ extern "C" {
 
 /**
  * A variable controlling whether a separate thread should be used for
- * handling joystick detection and raw input messages on Windows.
+ * handling joystick input.
+ *
+ * On Windows the thread handles joystick detection and raw input messages.
+ * On Linux the thread reads joystick and HIDAPI reports as they arrive, so
+ * input events are timestamped close to when the report was sent rather than
+ * when the application pumps events. Device detection still happens when
+ * events are pumped.
  *
  * The variable can be set to the following values:
  *
  * - "0": A separate thread is not used. (default)
- * - "1": A separate thread is used for handling raw input messages.
+ * - "1": A separate thread is used for handling joystick input.
  *
  * This hint should be set before SDL is initialized.
  *
@@ -2127,6 +2232,29 @@ extern "C" {
  */
 #define SDL_HINT_KEYCODE_OPTIONS "SDL_KEYCODE_OPTIONS"
 
+/**
+ * A variable controlling whether the KMSDRM video driver uses atomic
+ * modesetting.
+ *
+ * Atomic modesetting updates the display mode and all the planes of a display
+ * in one commit, which is needed to show video buffers on overlay planes with
+ * SDL_SetKMSDRMWindowOverlay(). SDL falls back to legacy modesetting if the
+ * driver or the display doesn't support it.
+ *
+ * The atomic path is new and hasn't been tested widely on real hardware yet,
+ * so it is off by default.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Always use legacy modesetting. (default)
+ * - "1": Use atomic modesetting when it is available.
+ *
+ * This hint should be set before the first window is created.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_KMSDRM_ATOMIC "SDL_KMSDRM_ATOMIC"
+
 /**
  * A variable that controls what KMSDRM device to use.
  *
@@ -2250,17 +2378,52 @@ extern "C" {
  */
 #define SDL_HINT_MAC_OPENGL_ASYNC_DISPATCH "SDL_MAC_OPENGL_ASYNC_DISPATCH"
 
+/**
+ * A variable controlling whether SDL_AppEvent() is called from a separate
+ * thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": SDL_AppEvent() is called from the main thread, between calls to
+ *   SDL_AppIterate(). (default)
+ * - "1": SDL_AppEvent() is called from a dedicated event thread, and may run
+ *   at the same time as SDL_AppIterate().
+ *
+ * Using an event thread lets the app respond to input while a long
+ * SDL_AppIterate() is running, but the app is responsible for synchronizing
+ * any state shared between the two callbacks. Events that must be handled
+ * immediately, like SDL_EVENT_TERMINATING, are still delivered from the
+ * thread that sent them.
+ *
+ * If the event thread can't be created, events are delivered from the main
+ * thread.
+ *
+ * This hint should be set before SDL_AppInit() returns.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_MAIN_CALLBACK_EVENT_THREAD "SDL_MAIN_CALLBACK_EVENT_THREAD"
+
 /**
  * Request SDL_AppIterate() be called at a specific rate.
  *
- * This number is in Hz, so "60" means try to iterate 60 times per second.
+ * The variable can be set to the following values:
+ *
+ * - A number in Hz, so "60" means try to iterate 60 times per second. This
+ *   may be fractional, like "59.94". "0" means iterate as fast as possible.
+ * - "display": Iterate at the refresh rate of the display the app's first
+ *   window is on, or the primary display if there are no windows.
+ * - "waitevent": Only iterate after new events arrive, sleeping otherwise.
+ *   This is useful for apps that only need to redraw in response to input.
  *
  * On some platforms, or if you are using SDL_main instead of SDL_AppIterate,
  * this hint is ignored. When the hint can be used, it is allowed to be
  * changed at any time.
  *
- * This defaults to 60, and specifying NULL for the hint's value will restore
- * the default.
+ * By default, SDL_AppIterate() is called 60 times per second while there are
+ * no windows, and as fast as the video subsystem allows (usually vsync) when
+ * there are windows. Once set, the hint's value is used even if there are
+ * windows. Specifying NULL for the hint's value will restore the default.
  *
  * This hint can be set anytime.
  *
@@ -2661,6 +2824,24 @@ extern "C" {
  */
 #define SDL_HINT_POLL_SENTINEL "SDL_POLL_SENTINEL"
 
+/**
+ * A variable controlling how long SDL_GetPowerInfo() reuses its last result,
+ * in milliseconds.
+ *
+ * Querying the battery can mean reading files, a D-Bus round trip or a JNI
+ * call, so SDL caches the answer. On platforms that report power changes, the
+ * cache is refreshed early when the power source changes or the app resumes.
+ *
+ * "0" disables the cache and queries the platform on every call. The default
+ * is "1000".
+ *
+ * This hint can be set anytime, and takes effect the next time the cache is
+ * refreshed.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_POWER_INFO_REFRESH_INTERVAL "SDL_POWER_INFO_REFRESH_INTERVAL"
+
 /**
  * Override for SDL_GetPreferredLocales().
  *
@@ -2789,6 +2970,26 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_LINE_METHOD "SDL_RENDER_LINE_METHOD"
 
+/**
+ * A variable controlling whether the 2D render API merges consecutive
+ * geometry draws into a single render command.
+ *
+ * When enabled, draws that use the same texture, blend mode, color and
+ * texture addressing mode and are queued back to back (for example, many
+ * SDL_RenderTexture() calls from one texture atlas) are combined into one
+ * vertex run, so the render backend issues a single draw call for them.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Each draw call is queued as a separate render command. (default)
+ * - "1": Compatible consecutive geometry draws are merged.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_RENDER_MERGE_GEOMETRY "SDL_RENDER_MERGE_GEOMETRY"
+
 /**
  * A variable controlling whether the Metal render driver select low power
  * device over default one.
@@ -2804,6 +3005,22 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_METAL_PREFER_LOW_POWER_DEVICE "SDL_RENDER_METAL_PREFER_LOW_POWER_DEVICE"
 
+/**
+ * A variable controlling whether the OpenGL render driver streams vertex data
+ * through a persistently mapped buffer when GL_ARB_buffer_storage is
+ * available.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use client side vertex arrays.
+ * - "1": Use a persistently mapped vertex buffer if available. (default)
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_RENDER_OPENGL_BUFFER_STORAGE "SDL_RENDER_OPENGL_BUFFER_STORAGE"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -2958,6 +3175,29 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling how many threads software surface blits may use.
+ *
+ * Large unscaled blits with SDL_BlitSurface(), scaled blits with
+ * SDL_BlitSurfaceScaled() and YUV to RGB conversions with
+ * SDL_ConvertPixelsAndColorspace() are split into bands of rows that are
+ * processed by a small pool of worker threads. The software renderer also
+ * uses these threads to draw each command list in bands, when it only
+ * contains clears, fills, points, unscaled copies and untextured geometry.
+ * The results are identical to blitting on a single thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "1": Blits run on the calling thread. (default)
+ * - "0": Use one thread per CPU core.
+ * - "N": Use up to N threads, including the calling thread.
+ *
+ * This hint can be set anytime, and takes effect on the next large blit.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_SURFACE_BLIT_THREADS "SDL_SURFACE_BLIT_THREADS"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -2987,6 +3227,32 @@ extern "C" {
  */
 #define SDL_HINT_THREAD_FORCE_REALTIME_TIME_CRITICAL "SDL_THREAD_FORCE_REALTIME_TIME_CRITICAL"
 
+/**
+ * Specifies whether the threads SDL creates for devices should use realtime
+ * scheduling.
+ *
+ * This covers the audio device and mixing threads, camera capture threads
+ * and the HIDAPI rumble thread, which wake up at a steady rate and need to
+ * be scheduled on time even when the system is under load.
+ *
+ * On Linux these threads are made SCHED_RR, either directly or through
+ * rtkit, with the same restrictions as described for
+ * SDL_HINT_THREAD_FORCE_REALTIME_TIME_CRITICAL. If the thread can't be made
+ * realtime, its priority is set as usual. On processors with both
+ * performance and efficiency cores, these threads are also kept on the
+ * performance cores.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": SDL device threads use the normal scheduling policy. (default)
+ * - "1": SDL device threads use a realtime scheduling policy.
+ *
+ * This hint should be set before opening audio, camera or joystick devices.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_THREAD_DEVICE_REALTIME "SDL_THREAD_DEVICE_REALTIME"
+
 /**
  * A string specifying additional information to use with
  * SDL_SetThreadPriority.
@@ -3010,6 +3276,28 @@ extern "C" {
  */
 #define SDL_HINT_THREAD_PRIORITY_POLICY         "SDL_THREAD_PRIORITY_POLICY"
 
+/**
+ * A variable controlling how many threads run timer callbacks.
+ *
+ * By default every timer callback runs on a single timer thread, one after
+ * another, so a slow callback delays all the other timers. If this is set to
+ * a number greater than zero, that many worker threads are started, and timer
+ * callbacks are handed to them as they come due. A timer's callback never runs
+ * concurrently with itself, but different timers' callbacks can run at the
+ * same time. Timers that must not run concurrently with each other can be
+ * marked with `SDL_PROP_TIMER_SERIALIZED_BOOLEAN`, and are then run one at a
+ * time on an extra thread of their own.
+ *
+ * The default value is "0", and the value is clamped to 64.
+ *
+ * This hint should be set before the timer subsystem is initialized.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetTimerProperties
+ */
+#define SDL_HINT_TIMER_DISPATCH_THREADS "SDL_TIMER_DISPATCH_THREADS"
+
 /**
  * A variable that controls the timer resolution, in milliseconds.
  *
@@ -3045,6 +3333,22 @@ extern "C" {
  */
 #define SDL_HINT_TOUCH_MOUSE_EVENTS    "SDL_TOUCH_MOUSE_EVENTS"
 
+/**
+ * A variable specifying a file to write SDL's internal trace events to.
+ *
+ * The file is written in the Chrome trace event format, and can be loaded
+ * into chrome://tracing or Perfetto to see where time goes inside SDL's event
+ * pumping, rendering, audio, joystick and camera code.
+ *
+ * This hint only has an effect if SDL was built with the SDL_TRACING option,
+ * and is unset by default.
+ *
+ * This hint should be set before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_TRACE_FILE "SDL_TRACE_FILE"
+
 /**
  * A variable controlling whether trackpads should be treated as touch
  * devices.
@@ -3439,6 +3743,28 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_X11_NODIRECTCOLOR "SDL_VIDEO_X11_NODIRECTCOLOR"
 
+/**
+ * A variable controlling whether the X11 Present extension should be used to
+ * show window surfaces.
+ *
+ * When enabled, window surface updates are presented through PresentPixmap,
+ * which reports completion times through the window properties. Window
+ * surface vsync is disabled by default, so updates are shown right away and
+ * may tear; enable it with SDL_SetWindowSurfaceVSync() for tear-free updates.
+ * An update made while earlier ones are still waiting for a refresh is
+ * skipped, and its area is shown with the next update.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Disable Present, update the window directly.
+ * - "1": Enable Present. (default)
+ *
+ * This hint should be set before creating a window surface.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_VIDEO_X11_PRESENT "SDL_VIDEO_X11_PRESENT"
+
 /**
  * A variable forcing the content scaling factor for X11 displays.
  *
@@ -3763,6 +4089,26 @@ extern "C" {
  */
 #define SDL_HINT_WINDOW_FRAME_USABLE_WHILE_CURSOR_HIDDEN    "SDL_WINDOW_FRAME_USABLE_WHILE_CURSOR_HIDDEN"
 
+/**
+ * A variable controlling whether window surfaces track which areas changed.
+ *
+ * When this is enabled, blits, fills and pixel writes into the surface
+ * returned by SDL_GetWindowSurface() are recorded, and SDL_UpdateWindowSurface()
+ * only copies the changed areas to the window. Locking the surface marks
+ * all of it as changed, so applications that write to the pixels directly
+ * should lock the surface first, or use SDL_UpdateWindowSurfaceRects().
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": SDL_UpdateWindowSurface() copies the whole surface. (default)
+ * - "1": SDL_UpdateWindowSurface() copies the areas that changed.
+ *
+ * This hint should be set before calling SDL_GetWindowSurface().
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING "SDL_WINDOW_SURFACE_DAMAGE_TRACKING"
+
 /**
  * A variable controlling whether SDL generates window-close events for Alt+F4
  * on Windows.
@@ -75,6 +75,37 @@ typedef enum SDL_IOWhence
     SDL_IO_SEEK_END,  /**< Seek relative to the end of data */
 } SDL_IOWhence;
 
+/**
+ * Expected access patterns for a memory-mapped SDL_IOStream.
+ *
+ * These are passed to the operating system as a hint for how far ahead it
+ * should read pages from disk; they never change what data is read.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ *
+ * \sa SDL_IOFromMappedFile
+ */
+typedef enum SDL_IOAccessPattern
+{
+    SDL_IO_ACCESS_NORMAL,      /**< No particular pattern, use the system default */
+    SDL_IO_ACCESS_SEQUENTIAL,  /**< Data will be read mostly front to back */
+    SDL_IO_ACCESS_RANDOM       /**< Data will be read in no particular order */
+} SDL_IOAccessPattern;
+
+/**
+ * One of the buffers in a vectored read or write.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReadIOV
+ * \sa SDL_WriteIOV
+ */
+typedef struct SDL_IOVec
+{
+    void *ptr;      /**< the memory to read into or write from */
+    size_t size;    /**< the number of bytes at `ptr` */
+} SDL_IOVec;
+
 /**
  * The function pointers that drive an SDL_IOStream.
  *
@@ -135,6 +166,34 @@ typedef struct SDL_IOStreamInterface
      *  \return 0 if successful or -1 on write error when flushing data.
      */
     int (SDLCALL *close)(void *userdata);
+
+    /**
+     *  Read from the data stream into each of the `count` buffers in `vecs`
+     *  in turn, filling one completely before moving on to the next.
+     *
+     *  This is optional. If it's NULL, SDL calls `read` once per buffer.
+     *
+     *  On an incomplete read, you should set `*status` to a value from the
+     *  SDL_IOStatus enum. You do not have to explicitly set this on
+     *  a complete, successful read.
+     *
+     *  \return the total number of bytes read
+     */
+    size_t (SDLCALL *readv)(void *userdata, const SDL_IOVec *vecs, int count, SDL_IOStatus *status);
+
+    /**
+     *  Write all of the `count` buffers in `vecs` to the data stream, in
+     *  order.
+     *
+     *  This is optional. If it's NULL, SDL calls `write` once per buffer.
+     *
+     *  On an incomplete write, you should set `*status` to a value from the
+     *  SDL_IOStatus enum. You do not have to explicitly set this on
+     *  a complete, successful write.
+     *
+     *  \return the total number of bytes written
+     */
+    size_t (SDLCALL *writev)(void *userdata, const SDL_IOVec *vecs, int count, SDL_IOStatus *status);
 } SDL_IOStreamInterface;
 
 
@@ -315,9 +374,17 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromConstMem(const void *mem, s
  *   memory of the stream. This can be set to NULL to transfer ownership of
  *   the memory to the application, which should free the memory with
  *   SDL_free(). If this is done, the next operation on the stream must be
- *   SDL_CloseIO().
+ *   SDL_CloseIO(). The memory is always followed by a null terminator, so
+ *   text written to the stream can be used as a string directly, and its
+ *   length is available from SDL_GetIOSize().
  * - `SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER`: memory will be allocated in
  *   multiples of this size, defaulting to 1024.
+ * - `SDL_PROP_IOSTREAM_DYNAMIC_CAPACITY_NUMBER`: the number of bytes to
+ *   allocate when data is first written to the stream. Setting this to the
+ *   expected size of the output avoids growing the memory while writing.
+ *
+ * The memory grows geometrically as data is written past its end, so
+ * writing a large amount of data doesn't repeatedly copy it.
  *
  * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
  *          SDL_GetError() for more information.
@@ -334,6 +401,90 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromDynamicMem(void);
 
 #define SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER    "SDL.iostream.dynamic.memory"
 #define SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER  "SDL.iostream.dynamic.chunksize"
+#define SDL_PROP_IOSTREAM_DYNAMIC_CAPACITY_NUMBER   "SDL.iostream.dynamic.capacity"
+
+/**
+ * Use this function to create a read-only SDL_IOStream that maps a named
+ * file into memory.
+ *
+ * Pages of the file are loaded by the operating system as they are first
+ * touched, so opening a large file is cheap and only the parts that are
+ * actually read cost any I/O. Reading from the stream is a plain memory
+ * copy out of the mapping.
+ *
+ * The contents of the file are also directly available through the
+ * properties below, so parsers that can work in place don't need to copy
+ * anything at all. That memory is read-only and remains valid until the
+ * stream is closed.
+ *
+ * The following properties are set at creation time by SDL:
+ *
+ * - `SDL_PROP_IOSTREAM_MAPPED_MEMORY_POINTER`: a pointer to the first byte
+ *   of the mapped file. This is NULL if the file is empty.
+ * - `SDL_PROP_IOSTREAM_MAPPED_SIZE_NUMBER`: the number of bytes mapped.
+ *
+ * If the file changes size while it is mapped, the result of reading it is
+ * undefined and can crash on some platforms.
+ *
+ * This function supports Unicode filenames, but they must be encoded in UTF-8
+ * format, regardless of the underlying operating system.
+ *
+ * \param file a UTF-8 string representing the filename to open.
+ * \param pattern how the file is expected to be read.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information. This will fail on platforms
+ *          that don't support memory-mapped files; SDL_IOFromFile() can be
+ *          used instead.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseIO
+ * \sa SDL_IOFromFile
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_TellIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromMappedFile(const char *file, SDL_IOAccessPattern pattern);
+
+#define SDL_PROP_IOSTREAM_MAPPED_MEMORY_POINTER  "SDL.iostream.mapped.memory"
+#define SDL_PROP_IOSTREAM_MAPPED_SIZE_NUMBER     "SDL.iostream.mapped.size"
+
+/**
+ * Use this function to create an SDL_IOStream that buffers access to another
+ * stream.
+ *
+ * Reads fetch `bufsize` bytes at a time from `src`, and writes are collected
+ * until the buffer is full, so reading or writing a file a few bytes at a
+ * time, like SDL_ReadU32LE() and friends do, doesn't cost a trip to the
+ * operating system for each value. Small reads and writes that fit in the
+ * buffer are handled without calling into the stream's interface at all.
+ *
+ * Requests larger than the buffer go directly to `src`. Seeking within the
+ * data that has already been read ahead doesn't touch `src` either.
+ *
+ * Buffered writes are sent to `src` when the buffer fills, when the stream
+ * is read from, seeked or queried for its size, and when it is closed. The
+ * application should not use `src` directly while the buffered stream is
+ * open.
+ *
+ * \param src the SDL_IOStream to buffer.
+ * \param bufsize the size of the buffer in bytes, or 0 to use a default size.
+ * \param closeio if SDL_TRUE, `src` is closed with SDL_CloseIO() when the
+ *                returned stream is closed, or if this function fails.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseIO
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_TellIO
+ * \sa SDL_WriteIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromBuffered(SDL_IOStream *src, size_t bufsize, SDL_bool closeio);
 
 /* @} *//* IOFrom functions */
 
@@ -527,6 +678,57 @@ extern SDL_DECLSPEC size_t SDLCALL SDL_ReadIO(SDL_IOStream *context, void *ptr,
  */
 extern SDL_DECLSPEC size_t SDLCALL SDL_WriteIO(SDL_IOStream *context, const void *ptr, size_t size);
 
+/**
+ * Read from a data source into several buffers at once.
+ *
+ * This reads into each of the `count` buffers in `vecs` in turn, filling
+ * one completely before moving on to the next, as if SDL_ReadIO() were
+ * called for each of them. Streams that support it do this in a single
+ * operation, which can save a system call or a copy per buffer.
+ *
+ * This function returns fewer bytes than the buffers hold on end of file or
+ * other failure, and the caller can use SDL_GetIOStatus() to find out which.
+ *
+ * \param context a pointer to an SDL_IOStream structure.
+ * \param vecs an array of buffers to read data into.
+ * \param count the number of elements in `vecs`.
+ * \returns the total number of bytes read, or 0 on end of file or other
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReadIO
+ * \sa SDL_WriteIOV
+ * \sa SDL_GetIOStatus
+ */
+extern SDL_DECLSPEC size_t SDLCALL SDL_ReadIOV(SDL_IOStream *context, const SDL_IOVec *vecs, int count);
+
+/**
+ * Write several buffers to an SDL_IOStream data stream at once.
+ *
+ * This writes each of the `count` buffers in `vecs` in order, as if
+ * SDL_WriteIO() were called for each of them, so a header and its payload
+ * can be written without first copying them together. Streams that support
+ * it do this in a single operation.
+ *
+ * If this fails for any reason, it'll return less than the total size of
+ * the buffers to demonstrate how far the write progressed.
+ *
+ * \param context a pointer to an SDL_IOStream structure.
+ * \param vecs an array of buffers containing data to write.
+ * \param count the number of elements in `vecs`.
+ * \returns the total number of bytes written, which will be less than the
+ *          total size of the buffers on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReadIOV
+ * \sa SDL_WriteIO
+ * \sa SDL_GetIOStatus
+ */
+extern SDL_DECLSPEC size_t SDLCALL SDL_WriteIOV(SDL_IOStream *context, const SDL_IOVec *vecs, int count);
+
 /**
  * Print to an SDL_IOStream data stream.
  *
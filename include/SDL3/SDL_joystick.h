@@ -1061,6 +1061,93 @@ extern SDL_DECLSPEC Uint8 SDLCALL SDL_GetJoystickHat(SDL_Joystick *joystick, int
  */
 extern SDL_DECLSPEC Uint8 SDLCALL SDL_GetJoystickButton(SDL_Joystick *joystick, int button);
 
+/**
+ * The state of a touchpad finger in a joystick snapshot.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetJoystickSnapshot
+ */
+typedef struct SDL_JoystickTouchpadFingerState
+{
+    int touchpad;   /**< The index of the touchpad */
+    int finger;     /**< The index of the finger on the touchpad */
+    Uint8 state;    /**< SDL_PRESSED if the finger is touching the touchpad */
+    float x;        /**< Normalized in the range 0...1 with 0 being on the left */
+    float y;        /**< Normalized in the range 0...1 with 0 being at the top */
+    float pressure; /**< Normalized in the range 0...1 */
+} SDL_JoystickTouchpadFingerState;
+
+/**
+ * The state of a sensor in a joystick snapshot.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetJoystickSnapshot
+ */
+typedef struct SDL_JoystickSensorState
+{
+    SDL_SensorType type; /**< The type of the sensor */
+    SDL_bool enabled;    /**< SDL_TRUE if the sensor is reporting data */
+    float data[3];       /**< The most recent sensor reading, see SDL_sensor.h */
+} SDL_JoystickSensorState;
+
+/**
+ * A copy of the complete input state of a joystick.
+ *
+ * The arrays are provided by the caller. On input each count holds the
+ * number of elements in the matching array, on output it holds the number of
+ * elements that were filled in. A NULL array is skipped and its count set to
+ * 0.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetJoystickSnapshot
+ */
+typedef struct SDL_JoystickSnapshot
+{
+    Uint64 timestamp;   /**< When the state was last updated, in nanoseconds since SDL_GetTicksNS() started */
+    Sint16 *axes;       /**< The axis values, see SDL_GetJoystickAxis() */
+    int num_axes;
+    Uint8 *buttons;     /**< The button states, see SDL_GetJoystickButton() */
+    int num_buttons;
+    Uint8 *hats;        /**< The hat positions, see SDL_GetJoystickHat() */
+    int num_hats;
+    SDL_JoystickTouchpadFingerState *touchpad_fingers; /**< The fingers of every touchpad, in touchpad order */
+    int num_touchpad_fingers;
+    SDL_JoystickSensorState *sensors; /**< The sensor states */
+    int num_sensors;
+} SDL_JoystickSnapshot;
+
+/**
+ * Get a consistent copy of the complete input state of a joystick.
+ *
+ * This copies the axes, buttons, hats, touchpads and sensors of the joystick
+ * as they were after one update, without taking the global joystick lock.
+ * This makes it cheap to read many inputs from threads other than the one
+ * pumping events. The snapshot is updated each time joystick input is
+ * processed, see SDL_UpdateJoysticks().
+ *
+ * The first call on a joystick sets up the snapshot and takes the joystick
+ * lock, later calls don't lock. The joystick must not be closed while this
+ * function is running on another thread.
+ *
+ * \param joystick the joystick to query.
+ * \param snapshot the caller provided arrays and their sizes, filled in with
+ *                 the current state.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetNumJoystickAxes
+ * \sa SDL_GetNumJoystickButtons
+ * \sa SDL_GetNumJoystickHats
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetJoystickSnapshot(SDL_Joystick *joystick, SDL_JoystickSnapshot *snapshot);
+
 /**
  * Start a rumble effect.
  *
@@ -1070,6 +1157,10 @@ extern SDL_DECLSPEC Uint8 SDLCALL SDL_GetJoystickButton(SDL_Joystick *joystick,
  * This function requires you to process SDL events or call
  * SDL_UpdateJoysticks() to update rumble state.
  *
+ * The rumble is sent to the device on a background thread where possible, so
+ * this function doesn't wait for the device. Rapid updates are combined and
+ * only the latest intensity is sent.
+ *
  * \param joystick the joystick to vibrate.
  * \param low_frequency_rumble the intensity of the low frequency (left)
  *                             rumble motor, from 0 to 0xFFFF.
@@ -435,6 +435,66 @@ extern SDL_DECLSPEC void SDLCALL SDL_GetLogOutputFunction(SDL_LogOutputFunction
  */
 extern SDL_DECLSPEC void SDLCALL SDL_SetLogOutputFunction(SDL_LogOutputFunction callback, void *userdata);
 
+/**
+ * Set whether log messages are written out on a background thread.
+ *
+ * By default the log output function is called on the thread that logs the
+ * message, which can take a long time on some platforms. In asynchronous
+ * mode messages are formatted on the calling thread into a fixed size ring
+ * buffer without taking any locks, and a background thread passes them to
+ * the log output function.
+ *
+ * Messages longer than 511 bytes are truncated in asynchronous mode. If the
+ * buffer is full the message is dropped and counted, see
+ * SDL_GetLogDroppedCount().
+ *
+ * Disabling asynchronous mode writes out any pending messages before
+ * returning.
+ *
+ * \param enabled SDL_TRUE to log on a background thread, SDL_FALSE to log on
+ *                the calling thread.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but not
+ *               from two threads at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_FlushLog
+ * \sa SDL_GetLogDroppedCount
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetLogAsync(SDL_bool enabled);
+
+/**
+ * Write out any pending asynchronous log messages on the calling thread.
+ *
+ * This is useful before shutting down or from a crash handler, so the last
+ * messages aren't lost. It does nothing if asynchronous mode is disabled.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetLogAsync
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_FlushLog(void);
+
+/**
+ * Get the number of log messages dropped because the asynchronous log buffer
+ * was full.
+ *
+ * \returns the number of messages dropped since SDL_SetLogAsync() was last
+ *          enabled.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetLogAsync
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetLogDroppedCount(void);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -326,7 +326,8 @@ extern SDLMAIN_DECLSPEC int SDLCALL SDL_AppInit(void **appstate, int argc, char
  *
  * On some platforms, this function will be called at the refresh rate of the
  * display (which might change during the life of your app!). There are no
- * promises made about what frequency this function might run at. You should
+ * promises made about what frequency this function might run at, though
+ * SDL_HINT_MAIN_CALLBACK_RATE can request one where supported. You should
  * use SDL's timer functions if you need to see how much time has passed since
  * the last iteration.
  *
@@ -375,7 +376,9 @@ extern SDLMAIN_DECLSPEC int SDLCALL SDL_AppIterate(void *appstate);
  * function. SDL is responsible for pumping the event queue between each call
  * to SDL_AppIterate, so in normal operation one should only get events in a
  * serial fashion, but be careful if you have a thread that explicitly calls
- * SDL_PushEvent.
+ * SDL_PushEvent. If SDL_HINT_MAIN_CALLBACK_EVENT_THREAD is enabled, events
+ * are delivered from a dedicated thread and may arrive while SDL_AppIterate
+ * is running.
  *
  * Events sent to this function are not owned by the app; if you need to save
  * the data, you should copy it.
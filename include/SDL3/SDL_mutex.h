@@ -30,6 +30,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_atomic.h>
 
 /******************************************************************************/
 /* Enable thread safety attributes only with clang.
@@ -806,6 +807,104 @@ extern SDL_DECLSPEC int SDLCALL SDL_WaitConditionTimeout(SDL_Condition *cond,
 /* @} *//* Condition variable functions */
 
 
+/**
+ *  \name Address wait functions
+ */
+/* @{ */
+
+/**
+ * Wait until an atomic variable no longer holds a given value.
+ *
+ * If `*a` is equal to `value`, the calling thread blocks until another
+ * thread calls SDL_SignalAtomicInt() or SDL_BroadcastAtomicInt() on `a`.
+ * The check and the start of the wait happen atomically with respect to
+ * those functions, so a wakeup that comes after the value was changed is
+ * never lost.
+ *
+ * This is the building block for blocking lock-free data structures: the
+ * uncontended path only touches the atomic variable, and the kernel is
+ * only involved when a thread actually has to sleep. It uses futex on
+ * Linux and Android and WaitOnAddress on Windows 8 and newer; other
+ * platforms fall back to a table of condition variables.
+ *
+ * Wakeups can be spurious, so the caller should check `*a` again after
+ * this returns.
+ *
+ * This function is the equivalent of calling SDL_WaitAtomicIntTimeout()
+ * with a time length of -1.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable to wait on.
+ * \param value the value that `*a` must hold for the caller to block.
+ * \returns 0 when woken up or when `*a` didn't hold `value`, or a negative
+ *          error code on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BroadcastAtomicInt
+ * \sa SDL_SignalAtomicInt
+ * \sa SDL_WaitAtomicIntTimeout
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_WaitAtomicInt(SDL_AtomicInt *a, int value);
+
+/**
+ * Wait until an atomic variable no longer holds a given value or a certain
+ * time has passed.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable to wait on.
+ * \param value the value that `*a` must hold for the caller to block.
+ * \param timeoutMS the maximum time to wait, in milliseconds, or -1 to wait
+ *                  indefinitely.
+ * \returns 0 when woken up or when `*a` didn't hold `value`,
+ *          `SDL_MUTEX_TIMEDOUT` if the wait timed out, or a negative error
+ *          code on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BroadcastAtomicInt
+ * \sa SDL_SignalAtomicInt
+ * \sa SDL_WaitAtomicInt
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_WaitAtomicIntTimeout(SDL_AtomicInt *a, int value, Sint32 timeoutMS);
+
+/**
+ * Wake up one of the threads waiting on an atomic variable.
+ *
+ * Change the value of the variable before calling this function.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BroadcastAtomicInt
+ * \sa SDL_WaitAtomicInt
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_SignalAtomicInt(SDL_AtomicInt *a);
+
+/**
+ * Wake up all of the threads waiting on an atomic variable.
+ *
+ * Change the value of the variable before calling this function.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SignalAtomicInt
+ * \sa SDL_WaitAtomicInt
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_BroadcastAtomicInt(SDL_AtomicInt *a);
+
+/* @} *//* Address wait functions */
+
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -184,6 +184,17 @@ typedef enum SDL_PackedLayout
 #define SDL_ISPIXELFORMAT_FOURCC(format)    \
     ((format) && (SDL_PIXELFLAG(format) != 1))
 
+#define SDL_ISPIXELFORMAT_COMPRESSED(format) \
+    (((format) == SDL_PIXELFORMAT_BC1) || \
+     ((format) == SDL_PIXELFORMAT_BC2) || \
+     ((format) == SDL_PIXELFORMAT_BC3) || \
+     ((format) == SDL_PIXELFORMAT_BC4) || \
+     ((format) == SDL_PIXELFORMAT_BC5) || \
+     ((format) == SDL_PIXELFORMAT_BC7) || \
+     ((format) == SDL_PIXELFORMAT_ETC2_RGB8) || \
+     ((format) == SDL_PIXELFORMAT_ETC2_RGBA8) || \
+     ((format) == SDL_PIXELFORMAT_ASTC_4X4))
+
 /* Note: If you modify this enum, update SDL_GetPixelFormatName() */
 
 /**
@@ -351,8 +362,29 @@ typedef enum SDL_PixelFormat
         /* SDL_DEFINE_PIXELFOURCC('N', 'V', '2', '1'), */
     SDL_PIXELFORMAT_P010 = 0x30313050u,      /**< Planar mode: Y + U/V interleaved  (2 planes) */
         /* SDL_DEFINE_PIXELFOURCC('P', '0', '1', '0'), */
-    SDL_PIXELFORMAT_EXTERNAL_OES = 0x2053454fu      /**< Android video texture format */
+    SDL_PIXELFORMAT_EXTERNAL_OES = 0x2053454fu,     /**< Android video texture format */
         /* SDL_DEFINE_PIXELFOURCC('O', 'E', 'S', ' ') */
+
+    /* Block compressed formats, only usable as static textures on renderers that list them as supported.
+       Image data is a sequence of rows of 4x4 pixel blocks, the pitch is the number of bytes in a row of blocks. */
+    SDL_PIXELFORMAT_BC1 = 0x20314342u,       /**< BC1 (DXT1) RGB with 1 bit alpha, 8 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('B', 'C', '1', ' '), */
+    SDL_PIXELFORMAT_BC2 = 0x20324342u,       /**< BC2 (DXT3) RGBA with explicit alpha, 16 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('B', 'C', '2', ' '), */
+    SDL_PIXELFORMAT_BC3 = 0x20334342u,       /**< BC3 (DXT5) RGBA with interpolated alpha, 16 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('B', 'C', '3', ' '), */
+    SDL_PIXELFORMAT_BC4 = 0x20344342u,       /**< BC4 (RGTC1) single channel, sampled as red, 8 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('B', 'C', '4', ' '), */
+    SDL_PIXELFORMAT_BC5 = 0x20354342u,       /**< BC5 (RGTC2) two channels, sampled as red and green, 16 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('B', 'C', '5', ' '), */
+    SDL_PIXELFORMAT_BC7 = 0x20374342u,       /**< BC7 (BPTC) RGBA, 16 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('B', 'C', '7', ' '), */
+    SDL_PIXELFORMAT_ETC2_RGB8 = 0x32435445u, /**< ETC2 RGB, 8 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('E', 'T', 'C', '2'), */
+    SDL_PIXELFORMAT_ETC2_RGBA8 = 0x41325445u, /**< ETC2 RGBA with EAC alpha, 16 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('E', 'T', '2', 'A'), */
+    SDL_PIXELFORMAT_ASTC_4X4 = 0x34345341u   /**< ASTC RGBA with 4x4 blocks, 16 bytes per block */
+        /* SDL_DEFINE_PIXELFOURCC('A', 'S', '4', '4') */
 } SDL_PixelFormat;
 
 /* Aliases for RGBA byte arrays of color data, for the current platform */
@@ -976,6 +1008,62 @@ extern SDL_DECLSPEC void SDLCALL SDL_GetRGB(Uint32 pixel, const SDL_PixelFormatD
  */
 extern SDL_DECLSPEC void SDLCALL SDL_GetRGBA(Uint32 pixel, const SDL_PixelFormatDetails *format, const SDL_Palette *palette, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a);
 
+/**
+ * Map an array of RGBA colors to pixel values in the specified format.
+ *
+ * This gives the same results as calling SDL_MapRGBA() for each color, but
+ * is much faster for large numbers of colors.
+ *
+ * The pixels are written tightly packed, using the number of bytes per pixel
+ * of the format, in the same layout as the pixels of an SDL_Surface.
+ *
+ * \param format a pointer to SDL_PixelFormatDetails describing the pixel
+ *               format.
+ * \param palette an optional palette for indexed formats, may be NULL.
+ * \param colors an array of `count` colors to map.
+ * \param pixels a buffer filled in with `count` pixels.
+ * \param count the number of colors to map.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the palette is not modified.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRGBAArray
+ * \sa SDL_MapRGBA
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_MapRGBAArray(const SDL_PixelFormatDetails *format, const SDL_Palette *palette, const SDL_Color *colors, void *pixels, int count);
+
+/**
+ * Get RGBA values from an array of pixels in the specified format.
+ *
+ * This gives the same results as calling SDL_GetRGBA() for each pixel, but
+ * is much faster for large numbers of pixels.
+ *
+ * The pixels are read tightly packed, using the number of bytes per pixel of
+ * the format, in the same layout as the pixels of an SDL_Surface.
+ *
+ * \param pixels an array of `count` pixels to read.
+ * \param format a pointer to SDL_PixelFormatDetails describing the pixel
+ *               format.
+ * \param palette an optional palette for indexed formats, may be NULL.
+ * \param colors an array filled in with `count` colors.
+ * \param count the number of pixels to read.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the palette is not modified.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRGBA
+ * \sa SDL_MapRGBAArray
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetRGBAArray(const void *pixels, const SDL_PixelFormatDetails *format, const SDL_Palette *palette, SDL_Color *colors, int count);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -243,6 +243,35 @@ extern SDL_DECLSPEC SDL_bool SDLCALL SDL_GetRectIntersection(const SDL_Rect * A,
                                                    const SDL_Rect * B,
                                                    SDL_Rect * result);
 
+/**
+ * Calculate the intersection of an array of rectangles with a clip rectangle.
+ *
+ * This gives the same results as calling SDL_GetRectIntersection() on each
+ * rectangle in turn, but is much faster for large numbers of rectangles.
+ * Rectangles that don't intersect `clip`, or that are too large to be safely
+ * intersected, keep their position but have their width and height set to
+ * zero in `results`, and have `visible` set to SDL_FALSE.
+ *
+ * `results` may be the same array as `rects` to clip the rectangles in place.
+ *
+ * \param rects an array of SDL_Rect structures to intersect with `clip`.
+ * \param count the number of rectangles in `rects`.
+ * \param clip an SDL_Rect structure representing the clip rectangle.
+ * \param results an array of `count` SDL_Rect structures filled in with the
+ *                intersections, may be NULL.
+ * \param visible an array of `count` SDL_bool values filled in with whether
+ *                each rectangle intersects `clip`, may be NULL.
+ * \returns the number of rectangles that intersect `clip` or a negative error
+ *          code on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRectIntersection
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetRectIntersections(const SDL_Rect *rects, int count, const SDL_Rect *clip, SDL_Rect *results, SDL_bool *visible);
+
 /**
  * Calculate the union of two rectangles.
  *
@@ -457,6 +486,36 @@ extern SDL_DECLSPEC SDL_bool SDLCALL SDL_GetRectIntersectionFloat(const SDL_FRec
                                                     const SDL_FRect * B,
                                                     SDL_FRect * result);
 
+/**
+ * Calculate the intersection of an array of rectangles with a clip rectangle
+ * with float precision.
+ *
+ * This gives the same results as calling SDL_GetRectIntersectionFloat() on
+ * each rectangle in turn, but is much faster for large numbers of rectangles.
+ * Rectangles that don't intersect `clip`, or that are too large to be safely
+ * intersected, keep their position but have their width and height set to
+ * zero in `results`, and have `visible` set to SDL_FALSE.
+ *
+ * `results` may be the same array as `rects` to clip the rectangles in place.
+ *
+ * \param rects an array of SDL_FRect structures to intersect with `clip`.
+ * \param count the number of rectangles in `rects`.
+ * \param clip an SDL_FRect structure representing the clip rectangle.
+ * \param results an array of `count` SDL_FRect structures filled in with the
+ *                intersections, may be NULL.
+ * \param visible an array of `count` SDL_bool values filled in with whether
+ *                each rectangle intersects `clip`, may be NULL.
+ * \returns the number of rectangles that intersect `clip` or a negative error
+ *          code on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRectIntersectionFloat
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetRectIntersectionsFloat(const SDL_FRect *rects, int count, const SDL_FRect *clip, SDL_FRect *results, SDL_bool *visible);
+
 /**
  * Calculate the union of two rectangles with float precision.
  *
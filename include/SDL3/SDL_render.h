@@ -82,6 +82,21 @@ typedef struct SDL_Vertex
     SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
 } SDL_Vertex;
 
+/**
+ * A single textured quad drawn by SDL_RenderTextureInstanced().
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTextureInstanced
+ */
+typedef struct SDL_TextureInstance
+{
+    SDL_FRect srcrect;          /**< The portion of the texture to draw, in texture pixels */
+    SDL_FRect dstrect;          /**< The destination rectangle, in SDL_Renderer coordinates */
+    float angle;                /**< Clockwise rotation in degrees around the center of `dstrect` */
+    SDL_FColor color;           /**< Color and alpha modulation for this instance */
+} SDL_TextureInstance;
+
 /**
  * The access pattern allowed for a texture.
  *
@@ -122,6 +137,56 @@ typedef struct SDL_Renderer SDL_Renderer;
  */
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ * A fragment shader program used in place of the renderer's built-in
+ * shaders.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderShader
+ */
+typedef struct SDL_RenderShader SDL_RenderShader;
+
+/**
+ * Rendering statistics for one frame.
+ *
+ * A frame is everything that was rendered between two calls to
+ * SDL_RenderPresent(), including the present itself.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRenderStats
+ */
+typedef struct SDL_RenderStats
+{
+    Uint64 frame;               /**< The number of frames presented so far */
+    int flushes;                /**< The number of times the command queue was sent to the backend */
+    int commands;               /**< The number of render commands sent to the backend */
+    int draw_commands;          /**< The number of commands that draw something */
+    int state_changes;          /**< The number of viewport, clip rectangle and draw color commands */
+    int redundant_commands;     /**< The number of commands removed because they wouldn't change the output */
+    Uint64 vertex_bytes;        /**< The number of bytes of vertex and index data sent to the backend */
+    int peak_commands;          /**< The most render commands queued at once */
+    Uint64 peak_vertex_bytes;   /**< The most bytes of vertex and index data queued at once */
+    int queue_allocations;      /**< The number of times queuing commands had to allocate memory */
+    Uint64 flush_ns;            /**< CPU time spent by the backend processing the command queue */
+    Uint64 present_ns;          /**< CPU time spent by the backend presenting the frame */
+    Uint64 gpu_ns;              /**< GPU time spent on the frame, or 0 if the renderer can't measure it. This lags a few frames behind. */
+} SDL_RenderStats;
+
+/**
+ * A list of draw calls recorded away from the rendering thread.
+ *
+ * Command lists don't belong to a renderer and can be filled on any thread,
+ * then replayed with SDL_SubmitRenderCommandList() on the thread that owns
+ * the renderer.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderCommandList
+ */
+typedef struct SDL_RenderCommandList SDL_RenderCommandList;
+
 /* Function prototypes */
 
 /**
@@ -236,6 +301,18 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window
  * - `SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER`: non-zero if you want
  *   present synchronized with the refresh rate. This property can take any
  *   value that is supported by SDL_SetRenderVSync() for the renderer.
+ * - `SDL_PROP_RENDERER_CREATE_PRESENT_MODE_NUMBER`: an SDL_PresentMode
+ *   value to use instead of `SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER`,
+ *   if it is supported by the renderer.
+ * - `SDL_PROP_RENDERER_CREATE_COMMAND_RESERVE_NUMBER`: the number of render
+ *   commands to allocate up front, defaults to 0. Frames that queue no more
+ *   than this many commands at once don't allocate commands.
+ * - `SDL_PROP_RENDERER_CREATE_VERTEX_RESERVE_NUMBER`: the number of bytes of
+ *   vertex data to allocate up front, defaults to 0.
+ * - `SDL_PROP_RENDERER_CREATE_QUEUE_SHRINK_FRAMES_NUMBER`: the number of
+ *   frames after which command queue memory beyond the reserve and beyond
+ *   the most used during those frames is freed, defaults to 0, which never
+ *   frees it before the renderer is destroyed.
  *
  * With the vulkan renderer:
  *
@@ -251,6 +328,40 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window
  *   queue family index used for rendering.
  * - `SDL_PROP_RENDERER_CREATE_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER`: the
  *   queue family index used for presentation.
+ * - `SDL_PROP_RENDERER_CREATE_VULKAN_FRAMES_IN_FLIGHT_NUMBER`: the number of
+ *   frames that can be queued on the GPU while the next one is recorded,
+ *   defaults to the number of swapchain images and is never more than that.
+ *   Lower values reduce latency and memory use, higher values let the CPU
+ *   and GPU overlap more.
+ * - `SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING`: the path
+ *   of a file used to keep compiled pipelines between runs, optional. It is
+ *   loaded when the renderer is created, if it exists and was written for
+ *   the same device and driver, and saved when the renderer is destroyed.
+ * - `SDL_PROP_RENDERER_CREATE_VULKAN_PREWARM_PIPELINES_BOOLEAN`: true if you
+ *   want the pipelines for the standard blend modes created when the
+ *   renderer is created, instead of when they're first drawn with, defaults
+ *   to false. This makes creating the renderer slower, but avoids stalls
+ *   during the first frames, and is cheap with a warm pipeline cache file.
+ *   The direct3d12 and metal renderers always create their common pipelines
+ *   up front.
+ *
+ * With the direct3d11 and direct3d12 renderers:
+ *
+ * - `SDL_PROP_RENDERER_CREATE_D3D_MAX_FRAME_LATENCY_NUMBER`: the number of
+ *   frames DXGI may queue for presentation before SDL_WaitForRenderFrame()
+ *   blocks, defaults to 1. Higher values smooth out uneven frame times at
+ *   the cost of input latency.
+ *
+ * With the software renderer:
+ *
+ * - `SDL_PROP_RENDERER_CREATE_SOFTWARE_THREADED_PRESENT_BOOLEAN`: true if
+ *   you want frames rendered into two back buffers and copied to the window
+ *   by a background thread, defaults to false. SDL_RenderPresent() then
+ *   returns as soon as the previous frame has been presented, so rendering
+ *   the next frame overlaps presenting this one. Presentation errors are
+ *   reported by the following SDL_RenderPresent() call. This only works
+ *   with video drivers that allow SDL_UpdateWindowSurface() from another
+ *   thread, such as x11.
  *
  * \param props the properties to use.
  * \returns a valid rendering context or NULL if there was an error; call
@@ -271,12 +382,21 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRendererWithProperties(SDL_
 #define SDL_PROP_RENDERER_CREATE_SURFACE_POINTER                            "surface"
 #define SDL_PROP_RENDERER_CREATE_OUTPUT_COLORSPACE_NUMBER                   "output_colorspace"
 #define SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER                       "present_vsync"
+#define SDL_PROP_RENDERER_CREATE_PRESENT_MODE_NUMBER                        "present_mode"
+#define SDL_PROP_RENDERER_CREATE_COMMAND_RESERVE_NUMBER                     "command_reserve"
+#define SDL_PROP_RENDERER_CREATE_VERTEX_RESERVE_NUMBER                      "vertex_reserve"
+#define SDL_PROP_RENDERER_CREATE_QUEUE_SHRINK_FRAMES_NUMBER                 "queue_shrink_frames"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_INSTANCE_POINTER                    "vulkan.instance"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_SURFACE_NUMBER                      "vulkan.surface"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_PHYSICAL_DEVICE_POINTER             "vulkan.physical_device"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_DEVICE_POINTER                      "vulkan.device"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_GRAPHICS_QUEUE_FAMILY_INDEX_NUMBER  "vulkan.graphics_queue_family_index"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER   "vulkan.present_queue_family_index"
+#define SDL_PROP_RENDERER_CREATE_VULKAN_FRAMES_IN_FLIGHT_NUMBER            "vulkan.frames_in_flight"
+#define SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING         "vulkan.pipeline_cache_file"
+#define SDL_PROP_RENDERER_CREATE_VULKAN_PREWARM_PIPELINES_BOOLEAN           "vulkan.prewarm_pipelines"
+#define SDL_PROP_RENDERER_CREATE_D3D_MAX_FRAME_LATENCY_NUMBER               "d3d.max_frame_latency"
+#define SDL_PROP_RENDERER_CREATE_SOFTWARE_THREADED_PRESENT_BOOLEAN          "software.threaded_present"
 
 /**
  * Create a 2D software rendering context for a surface.
@@ -344,6 +464,7 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  * - `SDL_PROP_RENDERER_SURFACE_POINTER`: the surface where rendering is
  *   displayed, if this is a software renderer without a window
  * - `SDL_PROP_RENDERER_VSYNC_NUMBER`: the current vsync setting
+ * - `SDL_PROP_RENDERER_PRESENT_MODE_NUMBER`: the current SDL_PresentMode
  * - `SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER`: the maximum texture width
  *   and height
  * - `SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER`: a (const SDL_PixelFormat *)
@@ -376,6 +497,10 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   with the renderer
  * - `SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER`: the IDXGISwapChain1
  *   associated with the renderer. This may change when the window is resized.
+ * - `SDL_PROP_RENDERER_D3D11_FRAME_LATENCY_WAITABLE_POINTER`: the HANDLE
+ *   that is signaled when the swap chain is ready for a new frame, or NULL
+ *   if the swap chain doesn't use the flip model. This may change when the
+ *   window is resized.
  *
  * With the direct3d12 renderer:
  *
@@ -385,6 +510,8 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   associated with the renderer.
  * - `SDL_PROP_RENDERER_D3D12_COMMAND_QUEUE_POINTER`: the ID3D12CommandQueue
  *   associated with the renderer
+ * - `SDL_PROP_RENDERER_D3D12_FRAME_LATENCY_WAITABLE_POINTER`: the HANDLE
+ *   that is signaled when the swap chain is ready for a new frame
  *
  * With the vulkan renderer:
  *
@@ -403,6 +530,17 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  * - `SDL_PROP_RENDERER_VULKAN_SWAPCHAIN_IMAGE_COUNT_NUMBER`: the number of
  *   swapchain images, or potential frames in flight, used by the Vulkan
  *   renderer
+ * - `SDL_PROP_RENDERER_VULKAN_FRAMES_IN_FLIGHT_NUMBER`: the number of frames
+ *   the Vulkan renderer can have queued on the GPU at once
+ * - `SDL_PROP_RENDERER_VULKAN_MEMORY_RESERVED_NUMBER`: the number of bytes
+ *   of device memory allocated by the Vulkan renderer, updated at each
+ *   present
+ * - `SDL_PROP_RENDERER_VULKAN_MEMORY_USED_NUMBER`: the number of bytes of
+ *   that memory in use by buffers and images
+ * - `SDL_PROP_RENDERER_VULKAN_MEMORY_ALLOCATION_COUNT_NUMBER`: the number of
+ *   VkDeviceMemory allocations held by the Vulkan renderer
+ * - `SDL_PROP_RENDERER_VULKAN_MEMORY_FRAGMENTATION_NUMBER`: how fragmented
+ *   the free device memory is, from 0 (all of it is in one piece) to 100
  *
  * \param renderer the rendering context.
  * \returns a valid property ID on success or 0 on failure; call
@@ -416,6 +554,7 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_WINDOW_POINTER                            "SDL.renderer.window"
 #define SDL_PROP_RENDERER_SURFACE_POINTER                           "SDL.renderer.surface"
 #define SDL_PROP_RENDERER_VSYNC_NUMBER                              "SDL.renderer.vsync"
+#define SDL_PROP_RENDERER_PRESENT_MODE_NUMBER                       "SDL.renderer.present_mode"
 #define SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER                   "SDL.renderer.max_texture_size"
 #define SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER                   "SDL.renderer.texture_formats"
 #define SDL_PROP_RENDERER_OUTPUT_COLORSPACE_NUMBER                  "SDL.renderer.output_colorspace"
@@ -425,9 +564,11 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
+#define SDL_PROP_RENDERER_D3D11_FRAME_LATENCY_WAITABLE_POINTER      "SDL.renderer.d3d11.frame_latency_waitable"
 #define SDL_PROP_RENDERER_D3D12_DEVICE_POINTER                      "SDL.renderer.d3d12.device"
 #define SDL_PROP_RENDERER_D3D12_SWAPCHAIN_POINTER                   "SDL.renderer.d3d12.swap_chain"
 #define SDL_PROP_RENDERER_D3D12_COMMAND_QUEUE_POINTER               "SDL.renderer.d3d12.command_queue"
+#define SDL_PROP_RENDERER_D3D12_FRAME_LATENCY_WAITABLE_POINTER      "SDL.renderer.d3d12.frame_latency_waitable"
 #define SDL_PROP_RENDERER_VULKAN_INSTANCE_POINTER                   "SDL.renderer.vulkan.instance"
 #define SDL_PROP_RENDERER_VULKAN_SURFACE_NUMBER                     "SDL.renderer.vulkan.surface"
 #define SDL_PROP_RENDERER_VULKAN_PHYSICAL_DEVICE_POINTER            "SDL.renderer.vulkan.physical_device"
@@ -435,6 +576,11 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_VULKAN_GRAPHICS_QUEUE_FAMILY_INDEX_NUMBER "SDL.renderer.vulkan.graphics_queue_family_index"
 #define SDL_PROP_RENDERER_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER  "SDL.renderer.vulkan.present_queue_family_index"
 #define SDL_PROP_RENDERER_VULKAN_SWAPCHAIN_IMAGE_COUNT_NUMBER       "SDL.renderer.vulkan.swapchain_image_count"
+#define SDL_PROP_RENDERER_VULKAN_FRAMES_IN_FLIGHT_NUMBER            "SDL.renderer.vulkan.frames_in_flight"
+#define SDL_PROP_RENDERER_VULKAN_MEMORY_RESERVED_NUMBER             "SDL.renderer.vulkan.memory_reserved"
+#define SDL_PROP_RENDERER_VULKAN_MEMORY_USED_NUMBER                 "SDL.renderer.vulkan.memory_used"
+#define SDL_PROP_RENDERER_VULKAN_MEMORY_ALLOCATION_COUNT_NUMBER     "SDL.renderer.vulkan.memory_allocation_count"
+#define SDL_PROP_RENDERER_VULKAN_MEMORY_FRAGMENTATION_NUMBER        "SDL.renderer.vulkan.memory_fragmentation"
 
 /**
  * Get the output size in pixels of a rendering context.
@@ -522,6 +668,46 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTexture(SDL_Renderer *render
  */
 extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface);
 
+/**
+ * Load a BMP image from a seekable SDL data stream into a texture.
+ *
+ * When the renderer supports the pixel format of the image, the pixels are
+ * decoded straight into a locked streaming texture, skipping the surface
+ * that SDL_LoadBMP_IO() and SDL_CreateTextureFromSurface() would go through.
+ * Otherwise this loads a surface and converts it, and the texture is
+ * `SDL_TEXTUREACCESS_STATIC`.
+ *
+ * \param renderer the rendering context.
+ * \param src the data stream for the image.
+ * \param closeio if SDL_TRUE, calls SDL_CloseIO() on `src` before returning,
+ *                even in the case of an error.
+ * \returns the created texture or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyTexture
+ * \sa SDL_LoadBMP_IO
+ * \sa SDL_LoadBMPTexture
+ */
+extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_LoadBMPTexture_IO(SDL_Renderer *renderer, SDL_IOStream *src, SDL_bool closeio);
+
+/**
+ * Load a BMP image from a file into a texture.
+ *
+ * \param renderer the rendering context.
+ * \param file the BMP file to load.
+ * \returns the created texture or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyTexture
+ * \sa SDL_LoadBMP
+ * \sa SDL_LoadBMPTexture_IO
+ */
+extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_LoadBMPTexture(SDL_Renderer *renderer, const char *file);
+
 /**
  * Create a texture for a rendering context with the specified properties.
  *
@@ -540,6 +726,33 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  *   pixels, required
  * - `SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER`: the height of the texture in
  *   pixels, required
+ * - `SDL_PROP_TEXTURE_CREATE_MIPMAPS_BOOLEAN`: true if the renderer should
+ *   keep a chain of downscaled copies of the texture, which is used to reduce
+ *   aliasing and memory bandwidth when the texture is drawn smaller than its
+ *   size with SDL_SCALEMODE_LINEAR or SDL_SCALEMODE_BEST. The downscaled
+ *   copies are updated automatically when the texture changes. This is
+ *   ignored if the renderer or texture format can't support it, check
+ *   SDL_PROP_TEXTURE_MIPMAPS_BOOLEAN on the new texture to see whether it's
+ *   being used. Defaults to false.
+ * - `SDL_PROP_TEXTURE_CREATE_LAYERS_NUMBER`: the number of layers in the
+ *   texture, each the full width and height, defaults to 1. The layers are
+ *   stacked vertically in one texture that is height * layers pixels high,
+ *   so drawing from several layers doesn't break batching in any renderer.
+ *   Use SDL_UpdateTextureLayer() and SDL_RenderTextureLayer() to address a
+ *   layer. As with any atlas, linear filtering can blend pixels along the
+ *   edges of neighboring layers. This is ignored for transient render
+ *   targets.
+ * - `SDL_PROP_TEXTURE_CREATE_TRANSIENT_BOOLEAN`: true if this is a render
+ *   target that is fully redrawn every time it's set as the render target,
+ *   such as an intermediate texture in a post-processing chain. The previous
+ *   contents of a transient render target are undefined each time it becomes
+ *   the render target, which lets tile-based GPUs skip loading them.
+ *   Destroyed transient render targets are kept in a pool by the renderer
+ *   for a few frames and handed back by later calls that ask for a
+ *   transient render target with the same format, colorspace and size,
+ *   avoiding the cost of allocating a new one. This is ignored for other
+ *   texture access modes and shouldn't be combined with the properties that
+ *   wrap an existing native texture. Defaults to false.
  * - `SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT`: for HDR10 and floating
  *   point textures, this defines the value of 100% diffuse white, with higher
  *   values being displayed in the High Dynamic Range headroom. This defaults
@@ -552,10 +765,42 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  *   will be scaled into the available HDR headroom, otherwise they are
  *   clipped.
  *
+ * With the opengl and opengles2 renderers, when the OpenGL context was
+ * created with EGL and EGL_EXT_image_dma_buf_import is available (for
+ * example with the wayland and kmsdrm video drivers), the texture can use a
+ * Linux DMA-BUF as its storage, such as a frame from a hardware video
+ * decoder, without copying it. The texture must have SDL_TEXTUREACCESS_STATIC
+ * access and can't be updated with SDL_UpdateTexture(), and the DMA-BUF must
+ * stay valid until the texture is destroyed. Each plane of the texture format
+ * is imported separately:
+ *
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_FD_NUMBER`: the DMA-BUF file
+ *   descriptor of the first plane. SDL doesn't take ownership of it.
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_PITCH_NUMBER`: the pitch of the
+ *   first plane, in bytes, required.
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_OFFSET_NUMBER`: the offset of the
+ *   first plane in its buffer, defaults to 0.
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_FD_NUMBER`,
+ *   `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_FD_NUMBER`: the DMA-BUF file
+ *   descriptors of the chroma planes of NV12, NV21, IYUV and YV12 textures,
+ *   default to the one of the first plane.
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_PITCH_NUMBER`,
+ *   `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_PITCH_NUMBER`: the pitches of the
+ *   chroma planes, required for those formats.
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_OFFSET_NUMBER`,
+ *   `SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_OFFSET_NUMBER`: the offsets of the
+ *   chroma planes in their buffers, default to 0.
+ * - `SDL_PROP_TEXTURE_CREATE_DMABUF_MODIFIER_NUMBER`: the DRM format modifier
+ *   of the buffer, if it isn't linear.
+ *
  * With the direct3d11 renderer:
  *
  * - `SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_POINTER`: the ID3D11Texture2D
  *   associated with the texture, if you want to wrap an existing texture.
+ * - `SDL_PROP_TEXTURE_CREATE_D3D11_SHARED_HANDLE_POINTER`: a HANDLE to a
+ *   shared ID3D11Texture2D, for example from another device or process, if
+ *   you want to wrap a texture you don't have a pointer to. NV12, NV21 and
+ *   P010 textures are shared as a single resource.
  * - `SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_U_POINTER`: the ID3D11Texture2D
  *   associated with the U plane of a YUV texture, if you want to wrap an
  *   existing texture.
@@ -567,6 +812,10 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  *
  * - `SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_POINTER`: the ID3D12Resource
  *   associated with the texture, if you want to wrap an existing texture.
+ * - `SDL_PROP_TEXTURE_CREATE_D3D12_SHARED_HANDLE_POINTER`: a HANDLE to a
+ *   shared ID3D12Resource, for example from another device or process, if
+ *   you want to wrap a texture you don't have a pointer to. NV12, NV21 and
+ *   P010 textures are shared as a single resource.
  * - `SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_U_POINTER`: the ID3D12Resource
  *   associated with the U plane of a YUV texture, if you want to wrap an
  *   existing texture.
@@ -638,14 +887,29 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
 #define SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER               "access"
 #define SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER                "width"
 #define SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER               "height"
+#define SDL_PROP_TEXTURE_CREATE_MIPMAPS_BOOLEAN             "mipmaps"
+#define SDL_PROP_TEXTURE_CREATE_LAYERS_NUMBER               "layers"
+#define SDL_PROP_TEXTURE_CREATE_TRANSIENT_BOOLEAN           "transient"
 #define SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT       "SDR_white_point"
 #define SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT          "HDR_headroom"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_FD_NUMBER     "dmabuf.plane0.fd"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_PITCH_NUMBER  "dmabuf.plane0.pitch"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_OFFSET_NUMBER "dmabuf.plane0.offset"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_FD_NUMBER     "dmabuf.plane1.fd"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_PITCH_NUMBER  "dmabuf.plane1.pitch"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_OFFSET_NUMBER "dmabuf.plane1.offset"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_FD_NUMBER     "dmabuf.plane2.fd"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_PITCH_NUMBER  "dmabuf.plane2.pitch"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_OFFSET_NUMBER "dmabuf.plane2.offset"
+#define SDL_PROP_TEXTURE_CREATE_DMABUF_MODIFIER_NUMBER      "dmabuf.modifier"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_POINTER       "d3d11.texture"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_U_POINTER     "d3d11.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_V_POINTER     "d3d11.texture_v"
+#define SDL_PROP_TEXTURE_CREATE_D3D11_SHARED_HANDLE_POINTER "d3d11.shared_handle"
 #define SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_POINTER       "d3d12.texture"
 #define SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_U_POINTER     "d3d12.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_V_POINTER     "d3d12.texture_v"
+#define SDL_PROP_TEXTURE_CREATE_D3D12_SHARED_HANDLE_POINTER "d3d12.shared_handle"
 #define SDL_PROP_TEXTURE_CREATE_METAL_PIXELBUFFER_POINTER   "metal.pixelbuffer"
 #define SDL_PROP_TEXTURE_CREATE_OPENGL_TEXTURE_NUMBER       "opengl.texture"
 #define SDL_PROP_TEXTURE_CREATE_OPENGL_TEXTURE_UV_NUMBER    "opengl.texture_uv"
@@ -670,6 +934,9 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
  *   SDL_TextureAccess.
  * - `SDL_PROP_TEXTURE_WIDTH_NUMBER`: the width of the texture in pixels.
  * - `SDL_PROP_TEXTURE_HEIGHT_NUMBER`: the height of the texture in pixels.
+ *   For layered textures this includes every layer.
+ * - `SDL_PROP_TEXTURE_LAYERS_NUMBER`: the number of layers in the texture.
+ * - `SDL_PROP_TEXTURE_MIPMAPS_BOOLEAN`: true if the texture has mipmaps.
  * - `SDL_PROP_TEXTURE_SDR_WHITE_POINT_FLOAT`: for HDR10 and floating point
  *   textures, this defines the value of 100% diffuse white, with higher
  *   values being displayed in the High Dynamic Range headroom. This defaults
@@ -759,6 +1026,8 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetTextureProperties(SDL_Textur
 #define SDL_PROP_TEXTURE_ACCESS_NUMBER                      "SDL.texture.access"
 #define SDL_PROP_TEXTURE_WIDTH_NUMBER                       "SDL.texture.width"
 #define SDL_PROP_TEXTURE_HEIGHT_NUMBER                      "SDL.texture.height"
+#define SDL_PROP_TEXTURE_LAYERS_NUMBER                      "SDL.texture.layers"
+#define SDL_PROP_TEXTURE_MIPMAPS_BOOLEAN                    "SDL.texture.mipmaps"
 #define SDL_PROP_TEXTURE_SDR_WHITE_POINT_FLOAT              "SDL.texture.SDR_white_point"
 #define SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT                 "SDL.texture.HDR_headroom"
 #define SDL_PROP_TEXTURE_D3D11_TEXTURE_POINTER              "SDL.texture.d3d11.texture"
@@ -1019,6 +1288,10 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetTextureBlendMode(SDL_Texture *texture, SD
  *
  * If the scale mode is not supported, the closest supported mode is chosen.
  *
+ * For textures with mipmaps, SDL_SCALEMODE_LINEAR uses trilinear filtering
+ * and SDL_SCALEMODE_BEST uses trilinear filtering with anisotropic filtering
+ * on renderers that support it.
+ *
  * \param texture the texture to update.
  * \param scaleMode the SDL_ScaleMode to use for texture scaling.
  * \returns 0 on success or a negative error code on failure; call
@@ -1076,6 +1349,81 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetTextureScaleMode(SDL_Texture *texture, SD
  */
 extern SDL_DECLSPEC int SDLCALL SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch);
 
+/**
+ * Update a rectangle within one layer of a layered texture.
+ *
+ * \param texture the texture to update.
+ * \param layer the layer to update, from 0 to the number of layers - 1.
+ * \param rect an SDL_Rect structure representing the area to update within
+ *             the layer, or NULL to update the entire layer.
+ * \param pixels the raw pixel data in the format of the texture.
+ * \param pitch the number of bytes in a row of pixel data, including padding
+ *              between lines.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTextureLayer
+ * \sa SDL_UpdateTexture
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_UpdateTextureLayer(SDL_Texture *texture, int layer, const SDL_Rect *rect, const void *pixels, int pitch);
+
+/**
+ * A callback used with SDL_UpdateTextureAsync().
+ *
+ * \param userdata what was passed as `userdata` to SDL_UpdateTextureAsync().
+ * \param texture the texture that was updated.
+ * \param result 0 if the texture was updated or a negative error code if it
+ *               wasn't.
+ *
+ * \threadsafety This callback is called on the thread that is rendering.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_UpdateTextureAsync
+ */
+typedef void (SDLCALL *SDL_TextureUpdateCallback)(void *userdata, SDL_Texture *texture, int result);
+
+/**
+ * Schedule an update of the given texture rectangle with new pixel data.
+ *
+ * This is like SDL_UpdateTexture(), but the copy doesn't happen right away.
+ * SDL references the pixel data and uploads it the next time the renderer
+ * sends its command queue to the GPU, which is at the latest in
+ * SDL_RenderPresent(). This keeps the render thread from stalling on uploads
+ * in the middle of a frame and avoids breaking up batches of draw calls that
+ * use the texture.
+ *
+ * Draws that were queued before the update is done use the previous contents
+ * of the texture. Updating, locking or destroying the texture completes or
+ * cancels any pending updates first.
+ *
+ * The pixel data must remain valid and unchanged until `callback` is called.
+ * The callback is always called exactly once, also if the update fails or is
+ * cancelled because the texture was destroyed.
+ *
+ * \param texture the texture to update.
+ * \param rect an SDL_Rect structure representing the area to update, or NULL
+ *             to update the entire texture.
+ * \param pixels the raw pixel data in the format of the texture.
+ * \param pitch the number of bytes in a row of pixel data, including padding
+ *              between lines.
+ * \param callback a function called when the update is done, may be NULL.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information. If this fails, the callback
+ *          is not called.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_FlushRenderer
+ * \sa SDL_UpdateTexture
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_UpdateTextureAsync(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch, SDL_TextureUpdateCallback callback, void *userdata);
+
 /**
  * Update a rectangle within a planar YV12 or IYUV texture with new pixel
  * data.
@@ -1841,6 +2189,49 @@ extern SDL_DECLSPEC int SDLCALL SDL_RenderFillRect(SDL_Renderer *renderer, const
  */
 extern SDL_DECLSPEC int SDLCALL SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count);
 
+/**
+ * Draw a series of connected thick lines on the current rendering target
+ * with the drawing color.
+ *
+ * The lines are queued as a single batch of geometry, with a one pixel
+ * anti-aliased edge along each side. The edge only blends smoothly when the
+ * draw blend mode is SDL_BLENDMODE_BLEND.
+ *
+ * \param renderer the renderer which should draw the lines.
+ * \param points the points along the lines.
+ * \param count the number of points, drawing count-1 lines.
+ * \param thickness the width of the lines, in render coordinates.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderLines
+ * \sa SDL_RenderFillCircles
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RenderThickLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count, float thickness);
+
+/**
+ * Fill some number of circles on the current rendering target with the
+ * drawing color.
+ *
+ * The circles are queued as a single batch of geometry, with a one pixel
+ * anti-aliased edge. The edge only blends smoothly when the draw blend mode
+ * is SDL_BLENDMODE_BLEND.
+ *
+ * \param renderer the renderer which should fill the circles.
+ * \param centers a pointer to an array of circle centers.
+ * \param count the number of circles.
+ * \param radius the radius of every circle, in render coordinates.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderThickLines
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RenderFillCircles(SDL_Renderer *renderer, const SDL_FPoint *centers, int count, float radius);
+
 /**
  * Copy a portion of the texture to the current rendering target at subpixel
  * precision.
@@ -1861,6 +2252,30 @@ extern SDL_DECLSPEC int SDLCALL SDL_RenderFillRects(SDL_Renderer *renderer, cons
  */
 extern SDL_DECLSPEC int SDLCALL SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect);
 
+/**
+ * Copy a portion of one layer of a layered texture to the current rendering
+ * target at subpixel precision.
+ *
+ * Copies from different layers of the same texture can be drawn together in
+ * one batch.
+ *
+ * \param renderer the renderer which should copy parts of a texture.
+ * \param texture the source texture.
+ * \param layer the layer to copy from, from 0 to the number of layers - 1.
+ * \param srcrect a pointer to the source rectangle within the layer, or
+ *                NULL for the entire layer.
+ * \param dstrect a pointer to the destination rectangle, or NULL for the
+ *                entire rendering target.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTexture
+ * \sa SDL_UpdateTextureLayer
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RenderTextureLayer(SDL_Renderer *renderer, SDL_Texture *texture, int layer, const SDL_FRect *srcrect, const SDL_FRect *dstrect);
+
 /**
  * Copy a portion of the source texture to the current rendering target, with
  * rotation and flipping, at subpixel precision.
@@ -1947,6 +2362,81 @@ extern SDL_DECLSPEC int SDLCALL SDL_RenderTextureTiled(SDL_Renderer *renderer, S
  */
 extern SDL_DECLSPEC int SDLCALL SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float left_width, float right_width, float top_height, float bottom_height, float scale, const SDL_FRect *dstrect);
 
+/**
+ * Copy many portions of a texture to the current rendering target in one
+ * call.
+ *
+ * This is equivalent to calling SDL_RenderTextureRotated() once per
+ * instance, but all of the instances are queued as a single draw, which is
+ * much cheaper for particle systems and sprite batches that draw thousands
+ * of pieces of the same texture atlas.
+ *
+ * Each instance's color is multiplied with the texture color and alpha
+ * modulation. Source rectangles are not clipped to the texture; portions
+ * outside of the texture are clamped to its edges.
+ *
+ * \param renderer the renderer which should copy parts of a texture.
+ * \param texture the source texture.
+ * \param instances an array of SDL_TextureInstance structures describing
+ *                  what to draw.
+ * \param count the number of instances.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTexture
+ * \sa SDL_RenderTextureRotated
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RenderTextureInstanced(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureInstance *instances, int count);
+
+/**
+ * The size, in pixels, of a single SDL_RenderDebugText() character.
+ *
+ * The font is monospaced and square, and this is the advance between
+ * characters, before any render scale is applied.
+ *
+ * \since This macro is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderDebugText
+ */
+#define SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE 8
+
+/**
+ * Draw debug text to an SDL_Renderer.
+ *
+ * This uses a built-in 8x8 bitmap font covering Latin-1; other codepoints
+ * are drawn as a placeholder glyph. The text is drawn in the current draw
+ * color and blended with its alpha. The string is decoded as UTF-8, and no
+ * layout is done: control characters such as newlines are drawn as glyphs.
+ *
+ * The glyphs come from a single atlas texture that is created the first
+ * time this is called on a renderer, and each call is queued as one
+ * geometry batch, which consecutive calls are merged into when nothing else
+ * changes in between. Applications can take the same approach with their
+ * own glyph atlases by drawing them with SDL_RenderTextureInstanced() or
+ * recording them into an SDL_RenderCommandList.
+ *
+ * This is intended for debug overlays and diagnostics; use a real text
+ * rendering library for anything else.
+ *
+ * \param renderer the renderer which should draw the text.
+ * \param x the x coordinate where the top-left corner of the text will
+ *          draw.
+ * \param y the y coordinate where the top-left corner of the text will
+ *          draw.
+ * \param str the string to render.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *str);
+
 /**
  * Render a list of triangles, optionally using a texture and indices into the
  * vertex array Color and alpha modulation is done per vertex
@@ -2005,6 +2495,203 @@ extern SDL_DECLSPEC int SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                                                int num_vertices,
                                                const void *indices, int num_indices, int size_indices);
 
+/**
+ * Create a custom fragment shader for a rendering context.
+ *
+ * Drawing with the shader goes through the normal command queue, so it is
+ * batched with the rest of the frame and doesn't need a flush or direct
+ * access to the underlying graphics API.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_RENDER_SHADER_CREATE_GLSL_FRAGMENT_STRING`: the GLSL source of
+ *   the fragment shader, used by the "opengl" renderer. The source can use
+ *   `varying vec4 v_color;` for the modulated vertex color,
+ *   `varying vec2 v_texCoord;` for the texture coordinate and
+ *   `uniform sampler2D tex0;` for the texture being drawn, and must write
+ *   `gl_FragColor`. Only `tex0` is bound, so multi-plane textures can't be
+ *   sampled.
+ *
+ * Renderers that don't have a source for their shading language in `props`
+ * fail with an "unsupported" error.
+ *
+ * The shader is destroyed automatically when the renderer is destroyed.
+ *
+ * \param renderer the rendering context.
+ * \param props the properties with the shader source.
+ * \returns the created shader or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyRenderShader
+ * \sa SDL_SetRenderShader
+ */
+extern SDL_DECLSPEC SDL_RenderShader * SDLCALL SDL_CreateRenderShader(SDL_Renderer *renderer, SDL_PropertiesID props);
+
+#define SDL_PROP_RENDER_SHADER_CREATE_GLSL_FRAGMENT_STRING "glsl.fragment"
+
+/**
+ * Set the shader used for drawing operations.
+ *
+ * The shader applies to everything drawn after this call, until another
+ * shader is set. Clearing the screen doesn't use it.
+ *
+ * \param renderer the rendering context.
+ * \param shader the shader to draw with, created for this renderer, or NULL
+ *               to go back to the built-in shaders.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderShader
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetRenderShader(SDL_Renderer *renderer, SDL_RenderShader *shader);
+
+/**
+ * Destroy a custom shader.
+ *
+ * If the shader is the current shader of its renderer, the renderer goes
+ * back to the built-in shaders.
+ *
+ * \param shader the shader to destroy.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderShader
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyRenderShader(SDL_RenderShader *shader);
+
+/**
+ * Create an empty render command list.
+ *
+ * \returns a new command list or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyRenderCommandList
+ * \sa SDL_RecordRenderGeometry
+ * \sa SDL_RecordRenderTextureInstanced
+ * \sa SDL_SubmitRenderCommandList
+ */
+extern SDL_DECLSPEC SDL_RenderCommandList * SDLCALL SDL_CreateRenderCommandList(void);
+
+/**
+ * Record a list of triangles into a render command list.
+ *
+ * This records the same draw as SDL_RenderGeometry(); the vertex and index
+ * data is copied into the list. The texture is not accessed until the list
+ * is submitted, and must still exist at that time.
+ *
+ * \param list the command list to record into.
+ * \param texture (optional) The SDL texture to use.
+ * \param vertices vertices.
+ * \param num_vertices number of vertices.
+ * \param indices (optional) An array of integer indices into the 'vertices'
+ *                array, if NULL all vertices will be rendered in sequential
+ *                order.
+ * \param num_indices number of indices.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               only one thread records into a given list at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderGeometry
+ * \sa SDL_SubmitRenderCommandList
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RecordRenderGeometry(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices);
+
+/**
+ * Record many portions of a texture into a render command list.
+ *
+ * This records the same draw as SDL_RenderTextureInstanced(). The texture
+ * color and alpha modulation in effect when the list is submitted is applied
+ * to these instances.
+ *
+ * \param list the command list to record into.
+ * \param texture the source texture.
+ * \param instances an array of SDL_TextureInstance structures describing
+ *                  what to draw.
+ * \param count the number of instances.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               only one thread records into a given list at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderTextureInstanced
+ * \sa SDL_SubmitRenderCommandList
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RecordRenderTextureInstanced(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_TextureInstance *instances, int count);
+
+/**
+ * Queue the draws recorded in a command list on a renderer.
+ *
+ * The draws are queued in the order they were recorded, using the
+ * renderer's current viewport, clip rectangle and scale. Submitting several
+ * lists one after another splices them in that order, which makes the final
+ * image independent of which threads recorded which list.
+ *
+ * The list is not modified and may be submitted again.
+ *
+ * \param renderer the rendering context.
+ * \param list the command list to submit.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function from the main thread, and
+ *               not while another thread is recording into `list`.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ClearRenderCommandList
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SubmitRenderCommandList(SDL_Renderer *renderer, SDL_RenderCommandList *list);
+
+/**
+ * Remove all recorded draws from a command list.
+ *
+ * The list keeps its memory, so recording the next frame into it doesn't
+ * need to allocate.
+ *
+ * \param list the command list to clear.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               no other thread is using `list`.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ClearRenderCommandList(SDL_RenderCommandList *list);
+
+/**
+ * Destroy a render command list.
+ *
+ * \param list the command list to destroy.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               no other thread is using `list`.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRenderCommandList
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyRenderCommandList(SDL_RenderCommandList *list);
+
 /**
  * Read pixels from the current rendering target.
  *
@@ -2024,6 +2711,67 @@ extern SDL_DECLSPEC int SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect);
 
+/**
+ * A callback used with SDL_RenderReadPixelsAsync().
+ *
+ * The surface is owned by SDL and is freed when the callback returns, so it
+ * should be copied if the pixels are needed afterwards.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_RenderReadPixelsAsync().
+ * \param surface the pixels that were read, or NULL if the read failed; call
+ *                SDL_GetError() for more information.
+ *
+ * \threadsafety This callback is called on the thread that is rendering.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+typedef void (SDLCALL *SDL_RenderReadPixelsCallback)(void *userdata, SDL_Surface *surface);
+
+/**
+ * Schedule a read of pixels from the current rendering target without
+ * waiting for the GPU.
+ *
+ * This works like SDL_RenderReadPixels(), but instead of stalling until the
+ * GPU has finished all pending rendering, the copy is queued behind the
+ * rendering and the pixels are handed to `callback` once they are available,
+ * usually during a call to SDL_RenderPresent() a frame or two later. This
+ * makes it possible to capture every frame for streaming or recording
+ * without losing the overlap between the CPU and GPU.
+ *
+ * Reads are delivered in the order they were requested. Destroying the
+ * renderer waits for and delivers any reads that are still pending. Renderers
+ * that can't read back asynchronously read the pixels right away and deliver
+ * them on the next present.
+ *
+ * If `format` is not SDL_PIXELFORMAT_UNKNOWN, the pixels are converted to it
+ * before they are delivered. This includes YUV formats like
+ * SDL_PIXELFORMAT_NV12, which is convenient for handing frames to a video
+ * encoder.
+ *
+ * \param renderer the rendering context.
+ * \param rect an SDL_Rect structure representing the area in pixels relative
+ *             to the to current viewport, or NULL for the entire viewport.
+ * \param format the pixel format to deliver the pixels in, or
+ *               SDL_PIXELFORMAT_UNKNOWN for the format of the rendering
+ *               target.
+ * \param callback a function called with the pixels.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information. If this fails, the callback
+ *          is not called.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderPresent
+ * \sa SDL_RenderReadPixels
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_PixelFormat format, SDL_RenderReadPixelsCallback callback, void *userdata);
+
 /**
  * Update the screen with any rendering performed since the previous call.
  *
@@ -2072,6 +2820,32 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RenderReadPixels(SDL_Renderer *ren
  */
 extern SDL_DECLSPEC int SDLCALL SDL_RenderPresent(SDL_Renderer *renderer);
 
+/**
+ * Wait until the renderer is ready to start drawing the next frame.
+ *
+ * Renderers that can tell when the display will accept another frame block
+ * here instead of in SDL_RenderPresent(). Calling this before reading input
+ * and drawing lets the frame be built from the most recent input, which can
+ * cut a frame or more of latency. If you don't call it, SDL_RenderPresent()
+ * waits as it always has.
+ *
+ * Currently the direct3d11 and direct3d12 renderers support this, using the
+ * DXGI frame latency waitable object. Other renderers return immediately.
+ *
+ * \param renderer the rendering context.
+ * \param timeoutMS the timeout in milliseconds, or -1 to wait indefinitely.
+ * \returns 0 if the renderer is ready for a new frame, `SDL_MUTEX_TIMEDOUT`
+ *          if the wait timed out, or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function on the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderPresent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_WaitForRenderFrame(SDL_Renderer *renderer, Sint32 timeoutMS);
+
 /**
  * Destroy the specified texture.
  *
@@ -2241,6 +3015,102 @@ extern SDL_DECLSPEC int SDLCALL SDL_SetRenderVSync(SDL_Renderer *renderer, int v
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetRenderVSync(SDL_Renderer *renderer, int *vsync);
 
+/**
+ * Check whether a renderer supports a presentation mode.
+ *
+ * SDL_PRESENTMODE_FIFO is always supported. The vulkan renderer supports the
+ * modes that the surface offers, and the direct3d11 and direct3d12
+ * renderers support SDL_PRESENTMODE_IMMEDIATE and SDL_PRESENTMODE_VRR when
+ * the system allows tearing. Any renderer supports SDL_PRESENTMODE_VRR if
+ * its window does.
+ *
+ * \param renderer the rendering context.
+ * \param mode the presentation mode to check.
+ * \returns SDL_TRUE if the mode is supported, SDL_FALSE otherwise.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetRenderPresentMode
+ * \sa SDL_WindowSupportsPresentMode
+ */
+extern SDL_DECLSPEC SDL_bool SDLCALL SDL_RenderSupportsPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode);
+
+/**
+ * Set the presentation mode of a renderer.
+ *
+ * This is a more precise alternative to SDL_SetRenderVSync(), the two
+ * replace each other's setting. Selecting SDL_PRESENTMODE_VRR also sets the
+ * presentation mode of the renderer's window, if the window supports it.
+ *
+ * \param renderer the rendering context.
+ * \param mode the presentation mode to use.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRenderPresentMode
+ * \sa SDL_RenderSupportsPresentMode
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetRenderPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode);
+
+/**
+ * Get the presentation mode of a renderer.
+ *
+ * \param renderer the rendering context.
+ * \param mode a pointer filled in with the current presentation mode.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetRenderPresentMode
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetRenderPresentMode(SDL_Renderer *renderer, SDL_PresentMode *mode);
+
+/**
+ * Get rendering statistics for the most recently presented frame.
+ *
+ * The statistics are collected by SDL itself, so they are available for
+ * every renderer. GPU time is only measured by renderers that support timer
+ * queries (currently the "opengl" renderer when GL_ARB_timer_query is
+ * available), otherwise it is 0.
+ *
+ * \param renderer the rendering context.
+ * \param stats an SDL_RenderStats structure filled in with the statistics.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RenderPresent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetRenderStats(SDL_Renderer *renderer, SDL_RenderStats *stats);
+
+/**
+ * Get the memory currently held by the textures of a renderer.
+ *
+ * This counts the same textures as SDL_MEMORY_CATEGORY_TEXTURES, but only
+ * those created by this renderer, including render targets kept for reuse.
+ * GPU memory is estimated from the size, format and mipmaps of each texture.
+ * The "software" renderer keeps its textures in surfaces, so they are also
+ * reported in SDL_MEMORY_CATEGORY_SURFACES.
+ *
+ * \param renderer the rendering context.
+ * \param stats an SDL_MemoryStats structure filled in with the statistics.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function from the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetMemoryStats
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetRendererMemoryStats(SDL_Renderer *renderer, SDL_MemoryStats *stats);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
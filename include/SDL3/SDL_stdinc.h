@@ -663,6 +663,135 @@ extern SDL_DECLSPEC void SDLCALL SDL_aligned_free(void *mem);
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * The kinds of objects SDL keeps memory statistics for.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetMemoryStats
+ */
+typedef enum SDL_MemoryCategory
+{
+    SDL_MEMORY_CATEGORY_SURFACES,       /**< SDL_Surface objects and the pixels SDL allocated for them, including released pixel buffers kept for reuse */
+    SDL_MEMORY_CATEGORY_TEXTURES,       /**< SDL_Texture objects of all renderers, including textures SDL creates internally for format conversion */
+    SDL_MEMORY_CATEGORY_AUDIO_QUEUES,   /**< Audio stream and device queues, including pooled buffers */
+    SDL_MEMORY_CATEGORY_EVENTS,         /**< Event queue entries, including free entries kept for reuse and temporary event memory */
+    SDL_MEMORY_CATEGORY_PROPERTIES,     /**< Property groups and the properties stored in them */
+    SDL_MEMORY_CATEGORY_COUNT           /**< The number of memory categories */
+} SDL_MemoryCategory;
+
+/**
+ * Memory held by a group of SDL objects.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetMemoryStats
+ * \sa SDL_GetRendererMemoryStats
+ */
+typedef struct SDL_MemoryStats
+{
+    Uint64 bytes;       /**< The number of bytes of system memory held */
+    Uint64 gpu_bytes;   /**< An estimate of the number of bytes of GPU memory held, or 0 if the objects don't use GPU memory */
+    int count;          /**< The number of objects alive */
+} SDL_MemoryStats;
+
+/**
+ * Get the memory currently held by one kind of SDL object.
+ *
+ * Only the objects themselves and the buffers SDL allocated for them are
+ * counted, memory provided by the application (e.g. with
+ * SDL_CreateSurfaceFrom()) is not. GPU memory is estimated from the size and
+ * format of each texture, the real usage depends on the driver.
+ *
+ * \param category the kind of object to query.
+ * \param stats an SDL_MemoryStats structure filled in with the statistics.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRendererMemoryStats
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetMemoryStats(SDL_MemoryCategory category, SDL_MemoryStats *stats);
+
+/**
+ * A bump allocator for memory with a common lifetime.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateMemoryArena
+ */
+typedef struct SDL_MemoryArena SDL_MemoryArena;
+
+/**
+ * Create a memory arena.
+ *
+ * An arena hands out memory by bumping a pointer through large blocks, so
+ * allocating is very cheap and nothing is freed individually. Instead, all
+ * the memory is released at once with SDL_ResetMemoryArena(), for example
+ * at the end of each frame. The blocks are kept for reuse, so an arena that
+ * is reset regularly stops allocating once it has grown to fit its usage.
+ *
+ * \param block_size the size of the blocks the arena allocates from, or 0
+ *                   for a reasonable default.
+ * \returns a new memory arena or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but an
+ *               arena may only be used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AllocateArenaMemory
+ * \sa SDL_ResetMemoryArena
+ * \sa SDL_DestroyMemoryArena
+ */
+extern SDL_DECLSPEC SDL_MemoryArena * SDLCALL SDL_CreateMemoryArena(size_t block_size);
+
+/**
+ * Allocate memory from a memory arena.
+ *
+ * The memory is suitably aligned for any type and is valid until the arena
+ * is reset or destroyed. It must not be passed to SDL_free().
+ *
+ * \param arena the arena to allocate from.
+ * \param size the size to allocate.
+ * \returns a pointer to the memory or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateMemoryArena
+ * \sa SDL_ResetMemoryArena
+ */
+extern SDL_DECLSPEC SDL_MALLOC void * SDLCALL SDL_AllocateArenaMemory(SDL_MemoryArena *arena, size_t size);
+
+/**
+ * Release all the memory allocated from a memory arena.
+ *
+ * The arena keeps its blocks, so later allocations reuse them.
+ *
+ * \param arena the arena to reset.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AllocateArenaMemory
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetMemoryArena(SDL_MemoryArena *arena);
+
+/**
+ * Destroy a memory arena and free all of its memory.
+ *
+ * \param arena the arena to destroy.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateMemoryArena
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyMemoryArena(SDL_MemoryArena *arena);
+
 extern SDL_DECLSPEC const char * SDLCALL SDL_getenv(const char *name);
 extern SDL_DECLSPEC int SDLCALL SDL_setenv(const char *name, const char *value, int overwrite);
 extern SDL_DECLSPEC int SDLCALL SDL_unsetenv(const char *name);
@@ -675,6 +804,66 @@ typedef int (SDLCALL *SDL_CompareCallback_r)(void *userdata, const void *a, cons
 extern SDL_DECLSPEC void SDLCALL SDL_qsort_r(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
 extern SDL_DECLSPEC void * SDLCALL SDL_bsearch_r(const void *key, const void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
 
+/**
+ * The type of key that SDL_RadixSort32() and SDL_RadixSort64() sort by.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ */
+typedef enum SDL_RadixKeyType
+{
+    SDL_RADIX_KEY_UNSIGNED,     /**< Uint32 or Uint64 keys */
+    SDL_RADIX_KEY_SIGNED,       /**< Sint32 or Sint64 keys */
+    SDL_RADIX_KEY_FLOAT         /**< float or double keys, NaN values sort at the ends */
+} SDL_RadixKeyType;
+
+/**
+ * Sort an array by a 32-bit key stored in each element.
+ *
+ * The key is read from `key_offset` bytes into each element and doesn't need
+ * to be aligned. This is a stable sort that doesn't call back into the
+ * application, so it's much faster than SDL_qsort() for large arrays, such
+ * as sorting sprites by depth.
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of each element in bytes.
+ * \param key_offset the offset of the key within each element, in bytes.
+ * \param type the type of key to sort by.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RadixSort64
+ * \sa SDL_qsort
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RadixSort32(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_RadixKeyType type);
+
+/**
+ * Sort an array by a 64-bit key stored in each element.
+ *
+ * This works exactly like SDL_RadixSort32(), with Uint64, Sint64 or double
+ * keys.
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of each element in bytes.
+ * \param key_offset the offset of the key within each element, in bytes.
+ * \param type the type of key to sort by.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RadixSort32
+ * \sa SDL_qsort
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RadixSort64(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_RadixKeyType type);
+
 extern SDL_DECLSPEC int SDLCALL SDL_abs(int x);
 
 /* NOTE: these double-evaluate their arguments, so you should never have side effects in the parameters */
@@ -88,6 +88,9 @@ typedef struct SDL_StorageInterface
 
     /* Get the space remaining, optional for read-only storage */
     Uint64 (SDLCALL *space_remaining)(void *userdata);
+
+    /* Write part of a file, creating it if needed, optional */
+    int (SDLCALL *write_file_range)(void *userdata, const char *path, Uint64 offset, const void *source, Uint64 length);
 } SDL_StorageInterface;
 
 /**
@@ -168,6 +171,33 @@ extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenUserStorage(const char *org, c
  */
 extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenFileStorage(const char *path);
 
+/**
+ * Opens up a read-only container for the contents of a ZIP archive.
+ *
+ * The archive's central directory is read once when it is opened, and kept
+ * in memory as an index of every path in the archive, so lookups don't
+ * touch the file. Where possible the archive is memory mapped and file
+ * reads are copied straight out of the mapping.
+ *
+ * Only entries that are stored without compression can be read; this suits
+ * pack files built with compression turned off (`zip -0`), which is usually
+ * what you want for assets that are already compressed. Encrypted entries
+ * are not supported.
+ *
+ * \param path the path of the archive file.
+ * \returns an archive storage container on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseStorage
+ * \sa SDL_EnumerateStorageDirectory
+ * \sa SDL_GetStorageFileSize
+ * \sa SDL_GetStoragePathInfo
+ * \sa SDL_ReadStorageFile
+ */
+extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenArchiveStorage(const char *path);
+
 /**
  * Opens up a container using a client-provided storage interface.
  *
@@ -277,6 +307,93 @@ extern SDL_DECLSPEC int SDLCALL SDL_ReadStorageFile(SDL_Storage *storage, const
  */
 extern SDL_DECLSPEC int SDLCALL SDL_WriteStorageFile(SDL_Storage *storage, const char *path, const void *source, Uint64 length);
 
+/**
+ * Synchronously write part of a file in a storage container.
+ *
+ * The rest of the file is left as it was, so small changes to a large file
+ * don't need the whole file rewritten. If the file doesn't exist it is
+ * created, and writing past the end of the file extends it.
+ *
+ * Outside of a transaction the change is made in place, so an interrupted
+ * write can leave the file partly updated. Inside a transaction the first
+ * change to a file makes a copy of it, and the changes are made to the copy
+ * until the transaction is committed.
+ *
+ * \param storage a storage container to write to.
+ * \param path the relative path of the file to write.
+ * \param offset the offset in the file to start writing at.
+ * \param source a client-provided buffer to write from.
+ * \param length the length of the source buffer.
+ * \returns 0 if the data was written or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BeginStorageTransaction
+ * \sa SDL_WriteStorageFile
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_WriteStorageFileRange(SDL_Storage *storage, const char *path, Uint64 offset, const void *source, Uint64 length);
+
+/**
+ * Start a batch of writes that are committed together.
+ *
+ * Until the transaction is committed or rolled back, SDL_WriteStorageFile()
+ * and SDL_WriteStorageFileRange() write to a temporary file next to each
+ * file they change, and reads still see the files as they were. Committing
+ * renames each temporary file over the file it replaces, so every file is
+ * either completely the old version or completely the new one, even if the
+ * program dies partway through writing it.
+ *
+ * This is also the way to get an atomic write of a single file: begin a
+ * transaction, write the file and commit.
+ *
+ * The storage container needs to support renaming and removing files;
+ * read-only containers can't start a transaction. Closing the container
+ * with a transaction in progress rolls it back.
+ *
+ * \param storage a storage container.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CommitStorageTransaction
+ * \sa SDL_RollbackStorageTransaction
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_BeginStorageTransaction(SDL_Storage *storage);
+
+/**
+ * Commit the writes made since SDL_BeginStorageTransaction().
+ *
+ * If replacing one of the files fails, the files after it in the batch are
+ * left unchanged, their temporary files are removed and an error is
+ * returned. The transaction is over either way.
+ *
+ * \param storage a storage container.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BeginStorageTransaction
+ * \sa SDL_RollbackStorageTransaction
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_CommitStorageTransaction(SDL_Storage *storage);
+
+/**
+ * Throw away the writes made since SDL_BeginStorageTransaction().
+ *
+ * \param storage a storage container.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BeginStorageTransaction
+ * \sa SDL_CommitStorageTransaction
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RollbackStorageTransaction(SDL_Storage *storage);
+
 /**
  * Create a directory in a writable storage container.
  *
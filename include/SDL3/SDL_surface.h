@@ -72,7 +72,7 @@ typedef enum SDL_ScaleMode
 {
     SDL_SCALEMODE_NEAREST, /**< nearest pixel sampling */
     SDL_SCALEMODE_LINEAR,  /**< linear filtering */
-    SDL_SCALEMODE_BEST     /**< anisotropic filtering */
+    SDL_SCALEMODE_BEST     /**< anisotropic filtering, or area averaging when reducing surfaces */
 } SDL_ScaleMode;
 
 /**
@@ -125,6 +125,10 @@ typedef struct SDL_Surface
 /**
  * Allocate a new surface with a specific pixel format.
  *
+ * The pixel memory is aligned for SIMD access and the pitch is a multiple of 4
+ * bytes. Use SDL_CreateSurfaceWithProperties() to request a different pitch
+ * alignment.
+ *
  * \param width the width of the surface.
  * \param height the height of the surface.
  * \param format the SDL_PixelFormat for the new surface's pixel format.
@@ -134,10 +138,46 @@ typedef struct SDL_Surface
  * \since This function is available since SDL 3.0.0.
  *
  * \sa SDL_CreateSurfaceFrom
+ * \sa SDL_CreateSurfaceWithProperties
  * \sa SDL_DestroySurface
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurface(int width, int height, SDL_PixelFormat format);
 
+/**
+ * Allocate a new surface with the specified properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_SURFACE_CREATE_WIDTH_NUMBER`: the width of the surface.
+ * - `SDL_PROP_SURFACE_CREATE_HEIGHT_NUMBER`: the height of the surface.
+ * - `SDL_PROP_SURFACE_CREATE_FORMAT_NUMBER`: one of the enumerated values in
+ *   SDL_PixelFormat, this is required.
+ * - `SDL_PROP_SURFACE_CREATE_COLORSPACE_NUMBER`: an SDL_Colorspace value
+ *   describing the surface colorspace, defaults to the default colorspace
+ *   for the pixel format.
+ * - `SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER`: the alignment in bytes
+ *   of each row of pixels, which must be a power of two. The pixel memory
+ *   will be aligned to at least this value as well. Defaults to 4. This is
+ *   ignored for FOURCC formats.
+ *
+ * \param props the properties to use.
+ * \returns the new SDL_Surface structure that is created or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateProperties
+ * \sa SDL_CreateSurface
+ * \sa SDL_DestroySurface
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_SURFACE_CREATE_WIDTH_NUMBER                "width"
+#define SDL_PROP_SURFACE_CREATE_HEIGHT_NUMBER               "height"
+#define SDL_PROP_SURFACE_CREATE_FORMAT_NUMBER               "format"
+#define SDL_PROP_SURFACE_CREATE_COLORSPACE_NUMBER           "colorspace"
+#define SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER      "pitch_alignment"
+
 /**
  * Allocate a new surface with a specific pixel format and existing pixel
  * data.
@@ -166,6 +206,36 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurface(int width, int heigh
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceFrom(int width, int height, SDL_PixelFormat format, void *pixels, int pitch);
 
+/**
+ * Create a surface that refers to a rectangle of the pixels of another
+ * surface.
+ *
+ * No copy is made of the pixel data; drawing to the view draws to the parent
+ * and vice versa. The view has the same format, palette and colorspace as
+ * the parent, and starts with the same color key, color and alpha
+ * modulation and blend mode.
+ *
+ * The view keeps a reference to the parent, so it is safe to destroy the
+ * parent before the view. Locking the view also locks the parent.
+ *
+ * If the parent uses RLE acceleration, it will keep its original pixels
+ * alongside the encoded data from now on, as if
+ * `SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN` had been set.
+ *
+ * \param parent the surface to reference.
+ * \param rect the SDL_Rect structure representing the area of the parent to
+ *             reference, or NULL to reference the entire surface. This is
+ *             clipped to the bounds of the parent.
+ * \returns the new SDL_Surface structure that is created or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurfaceFrom
+ * \sa SDL_DestroySurface
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceView(SDL_Surface *parent, const SDL_Rect *rect);
+
 /**
  * Free a surface.
  *
@@ -178,6 +248,7 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceFrom(int width, int h
  * \sa SDL_CreateStackSurface
  * \sa SDL_CreateSurface
  * \sa SDL_CreateSurfaceFrom
+ * \sa SDL_CreateSurfaceView
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DestroySurface(SDL_Surface *surface);
 
@@ -200,6 +271,11 @@ extern SDL_DECLSPEC void SDLCALL SDL_DestroySurface(SDL_Surface *surface);
  *   the same tone mapping that Chrome uses for HDR content, the form "*=N",
  *   where N is a floating point scale factor applied in linear space, and
  *   "none", which disables tone mapping. This defaults to "chrome".
+ * - `SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN`: true if the original pixels
+ *   of an RLE accelerated surface should be kept alongside the encoded data.
+ *   This uses more memory, but locking the surface doesn't need to decode
+ *   the pixels, and they come back exactly as they were. This defaults to
+ *   false.
  *
  * \param surface the SDL_Surface structure to query.
  * \returns a valid property ID on success or 0 on failure; call
@@ -212,6 +288,7 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetSurfaceProperties(SDL_Surfac
 #define SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT              "SDL.surface.SDR_white_point"
 #define SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT                 "SDL.surface.HDR_headroom"
 #define SDL_PROP_SURFACE_TONEMAP_OPERATOR_STRING            "SDL.surface.tonemap"
+#define SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN            "SDL.surface.RLE_keep_pixels"
 
 /**
  * Set the colorspace used by a surface.
@@ -507,7 +584,10 @@ extern SDL_DECLSPEC int SDLCALL SDL_SaveBMP(SDL_Surface *surface, const char *fi
  * Set the RLE acceleration hint for a surface.
  *
  * If RLE is enabled, color key and alpha blending blits are much faster, but
- * the surface must be locked before directly accessing the pixels.
+ * the surface must be locked before directly accessing the pixels. The
+ * original pixels are released once the surface is encoded, unless
+ * `SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN` is set in the surface
+ * properties.
  *
  * \param surface the SDL_Surface structure to optimize.
  * \param enabled SDL_TRUE to enable RLE acceleration, SDL_FALSE to disable
@@ -781,6 +861,10 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_DuplicateSurface(SDL_Surface *surf
  *
  * The returned surface should be freed with SDL_DestroySurface().
  *
+ * SDL_SCALEMODE_BEST averages all the source pixels covered by each
+ * destination pixel when reducing the surface, which avoids the aliasing
+ * that linear filtering has at large reduction ratios.
+ *
  * \param surface the surface to duplicate and scale.
  * \param width the width of the new surface.
  * \param height the height of the new surface.
@@ -1107,6 +1191,10 @@ extern SDL_DECLSPEC int SDLCALL SDL_BlitSurfaceUnchecked(SDL_Surface *src, const
  * Perform a scaled blit to a destination surface, which may be of a different
  * format.
  *
+ * SDL_SCALEMODE_BEST averages all the source pixels covered by each
+ * destination pixel when reducing the surface, which avoids the aliasing
+ * that linear filtering has at large reduction ratios.
+ *
  * \param src the SDL_Surface structure to be copied from.
  * \param srcrect the SDL_Rect structure representing the rectangle to be
  *                copied, or NULL to copy the entire surface.
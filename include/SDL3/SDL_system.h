@@ -152,6 +152,99 @@ typedef SDL_bool (SDLCALL *SDL_X11EventHook)(void *userdata, XEvent *xevent);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_SetX11EventHook(SDL_X11EventHook callback, void *userdata);
 
+/*
+ * Platform specific functions for KMSDRM
+ */
+
+/**
+ * Show a video buffer on a hardware overlay plane under a KMSDRM window.
+ *
+ * The buffer is a DMA-BUF, for example from a hardware video decoder or a
+ * camera, that the display controller scans out directly, so it is composited
+ * with the window contents without being copied or drawn with OpenGL ES. The
+ * change takes effect with the next SDL_GL_SwapWindow() and is flipped
+ * together with the new window contents. The buffer must not be modified
+ * until a later call to this function has replaced it and the following swap
+ * has completed.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_KMSDRM_OVERLAY_FORMAT_NUMBER`: the SDL_PixelFormat of the
+ *   buffer, defaults to SDL_PIXELFORMAT_NV12.
+ * - `SDL_PROP_KMSDRM_OVERLAY_WIDTH_NUMBER`: the width of the buffer, in
+ *   pixels. Required.
+ * - `SDL_PROP_KMSDRM_OVERLAY_HEIGHT_NUMBER`: the height of the buffer, in
+ *   pixels. Required.
+ * - `SDL_PROP_KMSDRM_OVERLAY_PLANE0_FD_NUMBER`: the DMA-BUF file descriptor
+ *   of the first plane. Required. SDL doesn't take ownership of it.
+ * - `SDL_PROP_KMSDRM_OVERLAY_PLANE0_PITCH_NUMBER`: the pitch of the first
+ *   plane, in bytes. Required.
+ * - `SDL_PROP_KMSDRM_OVERLAY_PLANE0_OFFSET_NUMBER`: the offset of the first
+ *   plane in its buffer, defaults to 0.
+ * - `SDL_PROP_KMSDRM_OVERLAY_PLANE1_FD_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_PLANE2_FD_NUMBER`: the DMA-BUF file descriptors
+ *   of the chroma planes of multi-planar formats, default to the one of the
+ *   previous plane.
+ * - `SDL_PROP_KMSDRM_OVERLAY_PLANE1_PITCH_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_PLANE2_PITCH_NUMBER`: the pitches of the chroma
+ *   planes, default to the pitch of the first plane, or half of it for
+ *   formats with three planes.
+ * - `SDL_PROP_KMSDRM_OVERLAY_PLANE1_OFFSET_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_PLANE2_OFFSET_NUMBER`: the offsets of the chroma
+ *   planes, default to right after the previous plane.
+ * - `SDL_PROP_KMSDRM_OVERLAY_MODIFIER_NUMBER`: the DRM format modifier of the
+ *   buffer, if it isn't linear.
+ * - `SDL_PROP_KMSDRM_OVERLAY_SRC_X_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_SRC_Y_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_SRC_W_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_SRC_H_NUMBER`: the part of the buffer to show,
+ *   defaults to all of it.
+ * - `SDL_PROP_KMSDRM_OVERLAY_X_NUMBER`, `SDL_PROP_KMSDRM_OVERLAY_Y_NUMBER`,
+ *   `SDL_PROP_KMSDRM_OVERLAY_W_NUMBER`, `SDL_PROP_KMSDRM_OVERLAY_H_NUMBER`:
+ *   where to show it on the display, in pixels, defaults to the whole
+ *   display. The display controller may not be able to scale.
+ * - `SDL_PROP_KMSDRM_OVERLAY_ZPOS_NUMBER`: the stacking position of the
+ *   overlay plane, if the driver lets it be changed. By default the driver
+ *   decides, usually putting overlays above the window.
+ *
+ * This needs a driver with atomic modesetting, which is enabled with
+ * SDL_HINT_KMSDRM_ATOMIC. If the display controller rejects the overlay when
+ * it is committed, an error is logged and the overlay is hidden.
+ *
+ * \param window the window to show the overlay under, created by the kmsdrm
+ *               video driver.
+ * \param props the properties describing the buffer, or 0 to hide the
+ *              overlay.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetKMSDRMWindowOverlay(SDL_Window *window, SDL_PropertiesID props);
+
+#define SDL_PROP_KMSDRM_OVERLAY_FORMAT_NUMBER           "SDL.kmsdrm.overlay.format"
+#define SDL_PROP_KMSDRM_OVERLAY_WIDTH_NUMBER            "SDL.kmsdrm.overlay.width"
+#define SDL_PROP_KMSDRM_OVERLAY_HEIGHT_NUMBER           "SDL.kmsdrm.overlay.height"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE0_FD_NUMBER        "SDL.kmsdrm.overlay.plane0.fd"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE0_PITCH_NUMBER     "SDL.kmsdrm.overlay.plane0.pitch"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE0_OFFSET_NUMBER    "SDL.kmsdrm.overlay.plane0.offset"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE1_FD_NUMBER        "SDL.kmsdrm.overlay.plane1.fd"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE1_PITCH_NUMBER     "SDL.kmsdrm.overlay.plane1.pitch"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE1_OFFSET_NUMBER    "SDL.kmsdrm.overlay.plane1.offset"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE2_FD_NUMBER        "SDL.kmsdrm.overlay.plane2.fd"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE2_PITCH_NUMBER     "SDL.kmsdrm.overlay.plane2.pitch"
+#define SDL_PROP_KMSDRM_OVERLAY_PLANE2_OFFSET_NUMBER    "SDL.kmsdrm.overlay.plane2.offset"
+#define SDL_PROP_KMSDRM_OVERLAY_MODIFIER_NUMBER         "SDL.kmsdrm.overlay.modifier"
+#define SDL_PROP_KMSDRM_OVERLAY_SRC_X_NUMBER            "SDL.kmsdrm.overlay.src.x"
+#define SDL_PROP_KMSDRM_OVERLAY_SRC_Y_NUMBER            "SDL.kmsdrm.overlay.src.y"
+#define SDL_PROP_KMSDRM_OVERLAY_SRC_W_NUMBER            "SDL.kmsdrm.overlay.src.w"
+#define SDL_PROP_KMSDRM_OVERLAY_SRC_H_NUMBER            "SDL.kmsdrm.overlay.src.h"
+#define SDL_PROP_KMSDRM_OVERLAY_X_NUMBER                "SDL.kmsdrm.overlay.x"
+#define SDL_PROP_KMSDRM_OVERLAY_Y_NUMBER                "SDL.kmsdrm.overlay.y"
+#define SDL_PROP_KMSDRM_OVERLAY_W_NUMBER                "SDL.kmsdrm.overlay.w"
+#define SDL_PROP_KMSDRM_OVERLAY_H_NUMBER                "SDL.kmsdrm.overlay.h"
+#define SDL_PROP_KMSDRM_OVERLAY_ZPOS_NUMBER             "SDL.kmsdrm.overlay.zpos"
+
 /* Platform specific functions for Linux*/
 #ifdef SDL_PLATFORM_LINUX
 
@@ -133,6 +133,12 @@ typedef struct
     SDL_Rect confine;
     SDL_bool hide_cursor;
 
+    /* Background load, for measuring under contention */
+    int load_threads;
+    int load_duty;
+    SDL_bool load_pin_threads;
+    int load_audio_streams;
+
 } SDLTest_CommonState;
 
 #include <SDL3/SDL_begin_code.h>
@@ -123,6 +123,62 @@ char *SDLTest_GenerateRunSeed(const int length);
  */
 int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *userRunSeed, Uint64 userExecKey, const char *filter, int testIterations, SDL_bool randomOrder);
 
+/* !< Function pointer to a benchmark body, run once per warmup and measured iteration */
+typedef void (*SDLTest_BenchmarkFp)(void *arg);
+
+/*
+ * Timing statistics for one benchmark, as measured by SDLTest_RunBenchmark.
+ */
+typedef struct SDLTest_BenchmarkResult {
+    /* !< Number of measured iterations */
+    int iterations;
+    /* !< Fastest iteration, in nanoseconds */
+    Uint64 minNS;
+    /* !< Median iteration, in nanoseconds */
+    Uint64 medianNS;
+    /* !< 99th percentile iteration, in nanoseconds */
+    Uint64 p99NS;
+    /* !< Throughput at the median, or 0 if bytesPerIteration was 0 */
+    double bytesPerSecond;
+    /* !< Throughput at the median, or 0 if itemsPerIteration was 0 */
+    double itemsPerSecond;
+} SDLTest_BenchmarkResult;
+
+/*
+ * Set where benchmark results go for the following SDLTest_RunSuites calls.
+ *
+ * Results of every SDLTest_RunBenchmark are written as JSON to outputFile at the end of
+ * SDLTest_RunSuites. If baselineFile is given (a previous outputFile), a benchmark whose
+ * median is more than maxRegression (0.1 being 10%) slower than its baseline fails the test case.
+ * Passing NULL for both files releases everything.
+ *
+ * \param outputFile File to write results to, or NULL.
+ * \param baselineFile Results to compare against, or NULL.
+ * \param maxRegression Allowed slowdown against the baseline, as a fraction.
+ *
+ * \returns 0 on success, -1 if the baseline couldn't be loaded.
+ */
+int SDLTest_SetBenchmarkOptions(const char *outputFile, const char *baselineFile, float maxRegression);
+
+/*
+ * Time a benchmark body from inside a test case.
+ *
+ * The body is run warmupIterations times untimed, then iterations times timed. The statistics
+ * are logged, recorded for the JSON output, and compared against the baseline if there is one.
+ *
+ * \param name Unique name of the benchmark, used to match it against the baseline.
+ * \param benchmark The body to time.
+ * \param arg Passed to the body.
+ * \param warmupIterations Number of untimed runs first.
+ * \param iterations Number of timed runs.
+ * \param bytesPerIteration Bytes processed by one run, for throughput, or 0.
+ * \param itemsPerIteration Items processed by one run, for throughput, or 0.
+ * \param result Filled in with the statistics, can be NULL.
+ *
+ * \returns TEST_COMPLETED, or TEST_ABORTED if the benchmark couldn't be run.
+ */
+int SDLTest_RunBenchmark(const char *name, SDLTest_BenchmarkFp benchmark, void *arg, int warmupIterations, int iterations, Uint64 bytesPerIteration, Uint64 itemsPerIteration, SDLTest_BenchmarkResult *result);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -58,6 +58,38 @@ void SDLTest_RandFillAllocations();
  */
 void SDLTest_LogAllocations(void);
 
+/**
+ * Start aggregating allocation statistics per call stack
+ *
+ * Each call stack records the number of allocations, the bytes allocated,
+ * the allocations still outstanding and a histogram of allocation lifetimes.
+ *
+ * \note This implicitly calls SDLTest_TrackAllocations()
+ */
+void SDLTest_ProfileAllocations(void);
+
+/**
+ * Get the number of allocations and bytes allocated since the last call to SDLTest_ResetFrameAllocations()
+ *
+ * \param count a pointer filled in with the number of allocations, may be NULL
+ * \param bytes a pointer filled in with the number of bytes allocated, may be NULL
+ *
+ * \note Allocations are only counted while SDLTest_TrackAllocations() is active
+ */
+void SDLTest_GetFrameAllocations(int *count, Uint64 *bytes);
+
+/**
+ * Reset the counters returned by SDLTest_GetFrameAllocations(), e.g. at the start of each frame
+ */
+void SDLTest_ResetFrameAllocations(void);
+
+/**
+ * Print the allocation statistics gathered since SDLTest_ProfileAllocations(), busiest call stacks first
+ *
+ * \note This can be called after SDL_Quit()
+ */
+void SDLTest_LogAllocationProfile(void);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -201,6 +201,13 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThread(SDL_ThreadFunction fn,
  *   only parameter. Optional, defaults to NULL.
  * - `SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER`: the size, in bytes, of the new
  *   thread's stack. Optional, defaults to 0 (system-defined default).
+ * - `SDL_PROP_THREAD_CREATE_AFFINITY_MASK_NUMBER`: a bitmask of the logical
+ *   CPUs the new thread may run on, bit N being CPU N. Optional, defaults to
+ *   0 (any CPU).
+ * - `SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER`: an SDL_CPUCoreType value, the
+ *   class of cores the new thread should run on. This is ignored if
+ *   `SDL_PROP_THREAD_CREATE_AFFINITY_MASK_NUMBER` is set. Optional, defaults
+ *   to SDL_CPU_CORE_TYPE_ANY.
  *
  * SDL makes an attempt to report `SDL_PROP_THREAD_CREATE_NAME_STRING` to the
  * system, so that debuggers can display it. Not all platforms support this.
@@ -227,6 +234,12 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThread(SDL_ThreadFunction fn,
  * of the system's page size (in many cases, this is 4 kilobytes, but check
  * your system documentation).
  *
+ * The affinity mask and core type are requests: the thread is created even
+ * if the system can't restrict where it runs, which is currently only
+ * possible on Linux, Android and Windows. Only the first 64 logical CPUs can
+ * be selected. SDL_GetCPUCoreMask() and SDL_GetCPUCacheSharingMask() are
+ * useful for building a mask.
+ *
  * Note that this "function" is actually a macro that calls an internal
  * function with two extra parameters not listed here; they are hidden through
  * preprocessor macros and are needed to support various C runtimes at the
@@ -256,6 +269,8 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThreadWithProperties(SDL_Prop
 #define SDL_PROP_THREAD_CREATE_NAME_STRING                             "name"
 #define SDL_PROP_THREAD_CREATE_USERDATA_POINTER                        "userdata"
 #define SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER                        "stacksize"
+#define SDL_PROP_THREAD_CREATE_AFFINITY_MASK_NUMBER                    "affinity_mask"
+#define SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER                        "core_type"
 
 /* end wiki documentation for macros that are meant to look like functions. */
 #endif
@@ -324,6 +339,8 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThreadWithPropertiesRuntime(S
 #define SDL_PROP_THREAD_CREATE_NAME_STRING                             "name"
 #define SDL_PROP_THREAD_CREATE_USERDATA_POINTER                        "userdata"
 #define SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER                        "stacksize"
+#define SDL_PROP_THREAD_CREATE_AFFINITY_MASK_NUMBER                    "affinity_mask"
+#define SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER                        "core_type"
 #endif
 
 
@@ -528,6 +545,213 @@ extern SDL_DECLSPEC int SDLCALL SDL_SetTLS(SDL_TLSID *id, const void *value, SDL
  */
 extern SDL_DECLSPEC void SDLCALL SDL_CleanupTLS(void);
 
+
+/**
+ * An opaque handle to a pool of worker threads that run jobs.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateThreadPool
+ */
+typedef struct SDL_ThreadPool SDL_ThreadPool;
+
+/**
+ * An opaque handle to a job created with SDL_CreateJob().
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateJob
+ */
+typedef struct SDL_Job SDL_Job;
+
+/**
+ * The function run by a thread pool worker for each job.
+ *
+ * \param userdata the pointer passed when the job was created.
+ *
+ * \threadsafety This is called on one of the pool's worker threads; jobs
+ *               can run concurrently with each other.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_CreateJob
+ */
+typedef void (SDLCALL *SDL_JobFunction)(void *userdata);
+
+/**
+ * Create a pool of worker threads that run jobs.
+ *
+ * Each worker keeps its own queue of jobs. Jobs submitted from a job running
+ * on a worker go on that worker's queue, and idle workers steal jobs from
+ * busy ones, so work that fans out into many small jobs stays spread across
+ * the pool without contending on a single lock.
+ *
+ * \param num_threads the number of worker threads, or 0 to use one per CPU
+ *                    core as reported by SDL_GetCPUCount().
+ * \param priority the priority each worker thread sets for itself with
+ *                 SDL_SetThreadPriority() when it starts. Failures to set the
+ *                 priority are ignored.
+ * \returns the new thread pool or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyThreadPool
+ * \sa SDL_SubmitJob
+ * \sa SDL_CreateJob
+ */
+extern SDL_DECLSPEC SDL_ThreadPool * SDLCALL SDL_CreateThreadPool(int num_threads, SDL_ThreadPriority priority);
+
+/**
+ * Run a fire-and-forget job on a thread pool.
+ *
+ * There is no handle to wait on the job; use SDL_CreateJob() for that, or
+ * SDL_WaitThreadPool() to wait for every job that has been started.
+ *
+ * \param pool the thread pool to run the job on.
+ * \param callback the function to call on a worker thread.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, including
+ *               from inside a job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateJob
+ * \sa SDL_WaitThreadPool
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SubmitJob(SDL_ThreadPool *pool, SDL_JobFunction callback, void *userdata);
+
+/**
+ * Create a job that can depend on other jobs and be waited on.
+ *
+ * The job does not run until it is started with SDL_RunJob(). Before that,
+ * SDL_AddJobDependency() can be used to make it wait for other jobs to
+ * finish. Every job created with this function must eventually be passed to
+ * SDL_WaitJob(), which frees it.
+ *
+ * \param pool the thread pool to run the job on.
+ * \param callback the function to call on a worker thread.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns the new job or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, including
+ *               from inside a job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddJobDependency
+ * \sa SDL_RunJob
+ * \sa SDL_WaitJob
+ */
+extern SDL_DECLSPEC SDL_Job * SDLCALL SDL_CreateJob(SDL_ThreadPool *pool, SDL_JobFunction callback, void *userdata);
+
+/**
+ * Make a job wait for another job to finish before it runs.
+ *
+ * This must be called before `job` is started with SDL_RunJob(). The
+ * dependency may already be running or finished, but must not have been
+ * passed to SDL_WaitJob() yet, and both jobs must belong to the same pool.
+ *
+ * \param job the job that should wait.
+ * \param dependency the job that must finish first.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               given `job` should only be set up by one thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateJob
+ * \sa SDL_RunJob
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_AddJobDependency(SDL_Job *job, SDL_Job *dependency);
+
+/**
+ * Start a job created with SDL_CreateJob().
+ *
+ * The job is queued as soon as all of its dependencies have finished, which
+ * may be immediately.
+ *
+ * \param job the job to start.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateJob
+ * \sa SDL_WaitJob
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_RunJob(SDL_Job *job);
+
+/**
+ * Wait for a job to finish and free it.
+ *
+ * If the job hasn't been started yet, it is started first. When called from
+ * inside a job running on the same pool, the calling worker runs other
+ * queued jobs while it waits instead of blocking.
+ *
+ * The job pointer is not valid after this call.
+ *
+ * It is safe to pass a NULL job to this function; it is a no-op.
+ *
+ * \param job the job to wait for.
+ *
+ * \threadsafety It is safe to call this function from any thread, but only
+ *               one thread may wait on a given job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateJob
+ * \sa SDL_RunJob
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WaitJob(SDL_Job *job);
+
+/**
+ * Wait for every started job on a thread pool to finish.
+ *
+ * This must not be called from inside a job running on `pool`.
+ *
+ * \param pool the thread pool to wait on.
+ *
+ * \threadsafety It is safe to call this function from any thread other than
+ *               the pool's workers.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_DestroyThreadPool
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WaitThreadPool(SDL_ThreadPool *pool);
+
+/**
+ * Wait for a thread pool's jobs to finish and destroy it.
+ *
+ * Jobs created with SDL_CreateJob() that are still waiting for
+ * SDL_WaitJob() must not be waited on after this call.
+ *
+ * It is safe to pass a NULL pool to this function; it is a no-op.
+ *
+ * \param pool the thread pool to destroy.
+ *
+ * \threadsafety This must not be called from inside a job running on
+ *               `pool`.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateThreadPool
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyThreadPool(SDL_ThreadPool *pool);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -30,6 +30,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_properties.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -124,6 +125,31 @@ extern SDL_DECLSPEC void SDLCALL SDL_Delay(Uint32 ms);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
 
+/**
+ * Wait until an absolute point in time before returning.
+ *
+ * The deadline is expressed in the same timebase as SDL_GetTicksNS(), which
+ * makes this function suitable for frame pacing: computing each deadline
+ * from the previous one, rather than delaying a relative amount after the
+ * frame's work is done, keeps the frame rate from drifting.
+ *
+ * The OS is asked to sleep until shortly before the deadline and the rest of
+ * the time is spent busy waiting. The length of that busy wait is adjusted
+ * automatically from how late the OS sleeps have been returning. This
+ * function could still return later than requested due to OS scheduling. It
+ * returns immediately if the deadline has already passed.
+ *
+ * \param ns the value of SDL_GetTicksNS() to wait for.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DelayNS
+ * \sa SDL_GetTicksNS
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DelayUntilNS(Uint64 ns);
+
 /**
  * Definition of the timer ID type.
  *
@@ -272,6 +298,42 @@ extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval, SDL_NSTi
  */
 extern SDL_DECLSPEC int SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ * Get the properties associated with a timer.
+ *
+ * The following read-write property is provided by SDL:
+ *
+ * - `SDL_PROP_TIMER_SERIALIZED_BOOLEAN`: true if this timer's callback must
+ *   never overlap with the callbacks of other serialized timers. This only
+ *   makes a difference when SDL_HINT_TIMER_DISPATCH_THREADS is set, and
+ *   defaults to false.
+ *
+ * The following read-only properties are updated each time this function is
+ * called:
+ *
+ * - `SDL_PROP_TIMER_FIRED_NUMBER`: the number of times the callback has run.
+ * - `SDL_PROP_TIMER_LATE_NS_NUMBER`: how late, in nanoseconds, the callback
+ *   started the last time it ran, compared to when it was scheduled.
+ * - `SDL_PROP_TIMER_MAX_LATE_NS_NUMBER`: the latest, in nanoseconds, the
+ *   callback has started.
+ *
+ * \param id the ID of the timer to query.
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddTimer
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetTimerProperties(SDL_TimerID id);
+
+#define SDL_PROP_TIMER_SERIALIZED_BOOLEAN   "SDL.timer.serialized"
+#define SDL_PROP_TIMER_FIRED_NUMBER         "SDL.timer.fired"
+#define SDL_PROP_TIMER_LATE_NS_NUMBER       "SDL.timer.late_ns"
+#define SDL_PROP_TIMER_MAX_LATE_NS_NUMBER   "SDL.timer.max_late_ns"
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -62,6 +62,18 @@ typedef Uint32 SDL_WindowID;
  */
 #define SDL_PROP_GLOBAL_VIDEO_WAYLAND_WL_DISPLAY_POINTER "SDL.video.wayland.wl_display"
 
+/**
+ * A file descriptor that becomes readable when Linux evdev input is waiting.
+ *
+ * This is set while the KMSDRM, Raspberry Pi, Vivante or dummy video backend
+ * reads input devices directly through evdev, on systems with epoll. It is
+ * an epoll descriptor covering every open input device and the udev hotplug
+ * monitor, so applications can add it to their own poll(), select() or epoll
+ * loop and call SDL_PumpEvents() when it is readable instead of polling on a
+ * timer. Applications must not read from, close or modify it.
+ */
+#define SDL_PROP_GLOBAL_VIDEO_EVDEV_INPUT_FD_NUMBER "SDL.video.evdev.input_fd"
+
 /**
  * System theme.
  *
@@ -201,6 +213,25 @@ typedef enum SDL_FlashOperation
     SDL_FLASH_UNTIL_FOCUSED             /**< Flash the window until it gets focus */
 } SDL_FlashOperation;
 
+/**
+ * Presentation modes for windows and renderers.
+ *
+ * These describe when a finished frame reaches the display. Windows and
+ * renderers support different subsets of these, use
+ * SDL_WindowSupportsPresentMode() and SDL_RenderSupportsPresentMode() to
+ * find out which ones are available.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ */
+typedef enum SDL_PresentMode
+{
+    SDL_PRESENTMODE_FIFO,           /**< Wait for the vertical blank and never tear, always supported */
+    SDL_PRESENTMODE_FIFO_RELAXED,   /**< Wait for the vertical blank, but present late frames right away, which may tear */
+    SDL_PRESENTMODE_MAILBOX,        /**< Don't wait, the newest frame replaces any queued one at the vertical blank, never tears */
+    SDL_PRESENTMODE_IMMEDIATE,      /**< Don't wait, frames are shown right away and may tear */
+    SDL_PRESENTMODE_VRR             /**< The display refreshes when a frame is ready (variable refresh rate) */
+} SDL_PresentMode;
+
 /**
  * An opaque handle to an OpenGL context.
  *
@@ -1232,6 +1263,22 @@ extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowParent(SDL_Window *window)
  *   associated with the window
  * - `SDL_PROP_WINDOW_WAYLAND_XDG_POSITIONER_POINTER`: the xdg_positioner
  *   associated with the window, in popup mode
+ * - `SDL_PROP_WINDOW_WAYLAND_PRESENTATION_TIME_NUMBER`: the time the last
+ *   frame presented to the window was shown, in nanoseconds on the
+ *   SDL_GetTicksNS() timeline, if the compositor supports wp_presentation
+ * - `SDL_PROP_WINDOW_WAYLAND_PRESENTATION_REFRESH_NUMBER`: the refresh
+ *   interval of the output the last frame was shown on, in nanoseconds, or 0
+ *   if unknown
+ * - `SDL_PROP_WINDOW_WAYLAND_PRESENTATION_SEQUENCE_NUMBER`: the vertical
+ *   retrace counter of the output when the last frame was shown, or 0 if
+ *   unknown
+ * - `SDL_PROP_WINDOW_WAYLAND_PRESENTATION_FLAGS_NUMBER`: the
+ *   wp_presentation_feedback_kind flags of the last frame shown
+ * - `SDL_PROP_WINDOW_WAYLAND_NEXT_FRAME_DEADLINE_NUMBER`: the predicted time
+ *   of the next output refresh after the last frame was shown, in nanoseconds
+ *   on the SDL_GetTicksNS() timeline, or 0 if unknown. Apps that want to
+ *   render as late as possible can schedule their frame to finish just before
+ *   this time, adding the refresh interval if it has already passed.
  *
  * On X11:
  *
@@ -1241,6 +1288,19 @@ extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowParent(SDL_Window *window)
  *   the window
  * - `SDL_PROP_WINDOW_X11_WINDOW_NUMBER`: the X11 Window associated with the
  *   window
+ * - `SDL_PROP_WINDOW_X11_PRESENTATION_TIME_NUMBER`: the time the last window
+ *   surface update presented through the Present extension was shown, in
+ *   nanoseconds on the SDL_GetTicksNS() timeline
+ * - `SDL_PROP_WINDOW_X11_PRESENTATION_REFRESH_NUMBER`: the measured refresh
+ *   interval of the CRTC the window is shown on, in nanoseconds, or 0 if
+ *   unknown
+ * - `SDL_PROP_WINDOW_X11_PRESENTATION_SEQUENCE_NUMBER`: the CRTC frame
+ *   counter when the last window surface update was shown
+ * - `SDL_PROP_WINDOW_X11_PRESENTATION_FLIPPED_BOOLEAN`: true if the last
+ *   window surface update was shown by flipping rather than copying
+ * - `SDL_PROP_WINDOW_X11_NEXT_FRAME_DEADLINE_NUMBER`: the predicted time of
+ *   the next refresh after the last window surface update was shown, in
+ *   nanoseconds on the SDL_GetTicksNS() timeline, or 0 if unknown
  *
  * \param window the window to query.
  * \returns a valid property ID on success or 0 on failure; call
@@ -1281,9 +1341,19 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetWindowProperties(SDL_Window
 #define SDL_PROP_WINDOW_WAYLAND_XDG_TOPLEVEL_EXPORT_HANDLE_STRING   "SDL.window.wayland.xdg_toplevel_export_handle"
 #define SDL_PROP_WINDOW_WAYLAND_XDG_POPUP_POINTER                   "SDL.window.wayland.xdg_popup"
 #define SDL_PROP_WINDOW_WAYLAND_XDG_POSITIONER_POINTER              "SDL.window.wayland.xdg_positioner"
+#define SDL_PROP_WINDOW_WAYLAND_PRESENTATION_TIME_NUMBER            "SDL.window.wayland.presentation_time"
+#define SDL_PROP_WINDOW_WAYLAND_PRESENTATION_REFRESH_NUMBER         "SDL.window.wayland.presentation_refresh"
+#define SDL_PROP_WINDOW_WAYLAND_PRESENTATION_SEQUENCE_NUMBER        "SDL.window.wayland.presentation_sequence"
+#define SDL_PROP_WINDOW_WAYLAND_PRESENTATION_FLAGS_NUMBER           "SDL.window.wayland.presentation_flags"
+#define SDL_PROP_WINDOW_WAYLAND_NEXT_FRAME_DEADLINE_NUMBER          "SDL.window.wayland.next_frame_deadline"
 #define SDL_PROP_WINDOW_X11_DISPLAY_POINTER                         "SDL.window.x11.display"
 #define SDL_PROP_WINDOW_X11_SCREEN_NUMBER                           "SDL.window.x11.screen"
 #define SDL_PROP_WINDOW_X11_WINDOW_NUMBER                           "SDL.window.x11.window"
+#define SDL_PROP_WINDOW_X11_PRESENTATION_TIME_NUMBER                "SDL.window.x11.presentation_time"
+#define SDL_PROP_WINDOW_X11_PRESENTATION_REFRESH_NUMBER             "SDL.window.x11.presentation_refresh"
+#define SDL_PROP_WINDOW_X11_PRESENTATION_SEQUENCE_NUMBER            "SDL.window.x11.presentation_sequence"
+#define SDL_PROP_WINDOW_X11_PRESENTATION_FLIPPED_BOOLEAN            "SDL.window.x11.presentation_flipped"
+#define SDL_PROP_WINDOW_X11_NEXT_FRAME_DEADLINE_NUMBER              "SDL.window.x11.next_frame_deadline"
 
 /**
  * Get the window flags.
@@ -2375,6 +2445,56 @@ extern SDL_DECLSPEC int SDLCALL SDL_SetWindowShape(SDL_Window *window, SDL_Surfa
  */
 extern SDL_DECLSPEC int SDLCALL SDL_FlashWindow(SDL_Window *window, SDL_FlashOperation operation);
 
+/**
+ * Check whether a window supports a presentation mode.
+ *
+ * For windows, the presentation mode is a request to the windowing system or
+ * the display about how the window's contents should reach the screen, and
+ * applies whatever API is used to draw to the window. The Wayland driver
+ * supports SDL_PRESENTMODE_IMMEDIATE if the compositor implements the
+ * tearing-control protocol, and the KMSDRM driver supports
+ * SDL_PRESENTMODE_VRR on displays that are VRR capable. SDL_PRESENTMODE_FIFO
+ * is always supported.
+ *
+ * \param window the window to query.
+ * \param mode the presentation mode to check.
+ * \returns SDL_TRUE if the mode is supported, SDL_FALSE otherwise.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetWindowPresentMode
+ */
+extern SDL_DECLSPEC SDL_bool SDLCALL SDL_WindowSupportsPresentMode(SDL_Window *window, SDL_PresentMode mode);
+
+/**
+ * Set the presentation mode of a window.
+ *
+ * \param window the window to change.
+ * \param mode the presentation mode to use.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetWindowPresentMode
+ * \sa SDL_WindowSupportsPresentMode
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_SetWindowPresentMode(SDL_Window *window, SDL_PresentMode mode);
+
+/**
+ * Get the presentation mode of a window.
+ *
+ * \param window the window to query.
+ * \param mode a pointer filled in with the current presentation mode.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetWindowPresentMode
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetWindowPresentMode(SDL_Window *window, SDL_PresentMode *mode);
+
 /**
  * Destroy a window.
  *
@@ -39,6 +39,7 @@
 #include "SDL_assert_c.h"
 #include "SDL_hints_c.h"
 #include "SDL_log_c.h"
+#include "SDL_preload_c.h"
 #include "SDL_properties_c.h"
 #include "audio/SDL_sysaudio.h"
 #include "camera/SDL_camera_c.h"
@@ -53,6 +54,7 @@
 #include "video/SDL_pixels_c.h"
 #include "video/SDL_video_c.h"
 #include "filesystem/SDL_filesystem_c.h"
+#include "file/SDL_asyncio_c.h"
 
 #define SDL_INIT_EVERYTHING ~0U
 
@@ -250,22 +252,27 @@ void SDL_SetMainReady(void)
 void SDL_InitMainThread(void)
 {
     SDL_InitTLSData();
+    SDL_EnableMemoryCache();
     SDL_InitTicks();
     SDL_InitFilesystem();
     SDL_InitLog();
     SDL_InitProperties();
     SDL_GetGlobalProperties();
     SDL_InitHints();
+    SDL_InitTrace();
+    SDL_InitCPUInfo();
 }
 
 static void SDL_QuitMainThread(void)
 {
+    SDL_QuitTrace();
     SDL_QuitHints();
     SDL_QuitProperties();
     SDL_QuitLog();
     SDL_QuitFilesystem();
     SDL_QuitTicks();
     SDL_QuitTLSData();
+    SDL_QuitAddressWait();
 }
 
 int SDL_InitSubSystem(SDL_InitFlags flags)
@@ -282,6 +289,9 @@ int SDL_InitSubSystem(SDL_InitFlags flags)
     SDL_DBus_Init();
 #endif
 
+    /* Start loading driver libraries while the other subsystems initialize */
+    SDL_StartDriverPreload(flags & ~SDL_WasInit(flags));
+
 #ifdef SDL_VIDEO_DRIVER_WINDOWS
     if (flags & (SDL_INIT_HAPTIC | SDL_INIT_JOYSTICK)) {
         if (SDL_HelperWindowCreate() < 0) {
@@ -477,9 +487,12 @@ int SDL_InitSubSystem(SDL_InitFlags flags)
 
     (void)flags_initialized; /* make static analysis happy, since this only gets used in error cases. */
 
+    SDL_FinishDriverPreload();
+
     return SDL_ClearError();
 
 quit_and_error:
+    SDL_FinishDriverPreload();
     SDL_QuitSubSystem(flags_initialized);
     return -1;
 }
@@ -627,7 +640,11 @@ void SDL_Quit(void)
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
 
+    SDL_QuitAsyncIO();
+    SDL_QuitBlitThreads();
     SDL_QuitPixelFormatDetails();
+    SDL_QuitPaletteCaches();
+    SDL_QuitSurfacePixelPool();
 
     SDL_QuitCPUInfo();
 
@@ -81,7 +81,8 @@ int SDL_ClearError(void)
 {
     SDL_error *error = SDL_GetErrBuf(SDL_FALSE);
 
-    if (error) {
+    /* Don't dirty the buffer's cache line when there's nothing to clear */
+    if (error && error->error != SDL_ErrorCodeNone) {
         error->error = SDL_ErrorCodeNone;
     }
     return 0;
@@ -0,0 +1,200 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+#include "SDL_handletable.h"
+
+/* The low bits of a handle are the slot index, the high bits its generation */
+#define SDL_HANDLE_INDEX_BITS   20
+#define SDL_HANDLE_INDEX_MASK   ((1u << SDL_HANDLE_INDEX_BITS) - 1)
+#define SDL_HANDLE_GENERATIONS  (1u << (32 - SDL_HANDLE_INDEX_BITS))
+
+/* Slots are allocated in fixed chunks that never move, so lookups can run
+   while the table grows */
+#define SDL_HANDLE_CHUNK_BITS   10
+#define SDL_HANDLE_CHUNK_SIZE   (1u << SDL_HANDLE_CHUNK_BITS)
+#define SDL_HANDLE_MAX_CHUNKS   (1u << (SDL_HANDLE_INDEX_BITS - SDL_HANDLE_CHUNK_BITS))
+
+/* Freed slots wait in a queue until this many are free, so a slot takes a
+   long time to cycle through its generations */
+#define SDL_HANDLE_MIN_FREE     1024
+
+typedef struct SDL_HandleSlot
+{
+    SDL_AtomicInt generation; /* never 0 */
+    void *object;             /* NULL if the slot is free */
+    Uint32 next_free;
+} SDL_HandleSlot;
+
+struct SDL_HandleTable
+{
+    SDL_HandleSlot *chunks[SDL_HANDLE_MAX_CHUNKS];
+    SDL_SpinLock lock;
+    Uint32 num_slots;
+    Uint32 num_free;
+    Uint32 free_head;
+    Uint32 free_tail;
+};
+
+static SDL_HandleSlot *SDL_GetHandleSlot(SDL_HandleTable *table, Uint32 index)
+{
+    SDL_HandleSlot *chunk = (SDL_HandleSlot *)SDL_AtomicGetPtr((void **)&table->chunks[index >> SDL_HANDLE_CHUNK_BITS]);
+    if (!chunk) {
+        return NULL;
+    }
+    return &chunk[index & (SDL_HANDLE_CHUNK_SIZE - 1)];
+}
+
+static Uint32 SDL_MakeHandle(Uint32 index, int generation)
+{
+    return ((Uint32)generation << SDL_HANDLE_INDEX_BITS) | index;
+}
+
+SDL_HandleTable *SDL_CreateHandleTable(void)
+{
+    return (SDL_HandleTable *)SDL_calloc(1, sizeof(SDL_HandleTable));
+}
+
+void SDL_DestroyHandleTable(SDL_HandleTable *table)
+{
+    if (table) {
+        Uint32 i;
+        for (i = 0; i < SDL_HANDLE_MAX_CHUNKS; ++i) {
+            SDL_free(table->chunks[i]);
+        }
+        SDL_free(table);
+    }
+}
+
+Uint32 SDL_AddToHandleTable(SDL_HandleTable *table, void *object)
+{
+    SDL_HandleSlot *slot;
+    Uint32 index;
+    Uint32 handle = 0;
+
+    SDL_assert(object != NULL);
+
+    SDL_LockSpinlock(&table->lock);
+    if (table->num_free >= SDL_HANDLE_MIN_FREE || (table->num_free > 0 && table->num_slots > SDL_HANDLE_INDEX_MASK)) {
+        index = table->free_head;
+        slot = SDL_GetHandleSlot(table, index);
+        table->free_head = slot->next_free;
+        --table->num_free;
+    } else if (table->num_slots <= SDL_HANDLE_INDEX_MASK) {
+        index = table->num_slots;
+        if (!table->chunks[index >> SDL_HANDLE_CHUNK_BITS]) {
+            SDL_HandleSlot *chunk = (SDL_HandleSlot *)SDL_calloc(SDL_HANDLE_CHUNK_SIZE, sizeof(*chunk));
+            if (!chunk) {
+                SDL_UnlockSpinlock(&table->lock);
+                return 0;
+            }
+            SDL_AtomicSetPtr((void **)&table->chunks[index >> SDL_HANDLE_CHUNK_BITS], chunk);
+        }
+        ++table->num_slots;
+        slot = SDL_GetHandleSlot(table, index);
+        SDL_AtomicSet(&slot->generation, 1);
+    } else {
+        SDL_UnlockSpinlock(&table->lock);
+        SDL_SetError("Too many objects");
+        return 0;
+    }
+
+    /* Index 0 with generation 0 would be handle 0, but generations start at 1 */
+    SDL_AtomicSetPtr(&slot->object, object);
+    handle = SDL_MakeHandle(index, SDL_AtomicGet(&slot->generation));
+    SDL_UnlockSpinlock(&table->lock);
+
+    return handle;
+}
+
+void *SDL_RemoveFromHandleTable(SDL_HandleTable *table, Uint32 handle)
+{
+    const Uint32 index = handle & SDL_HANDLE_INDEX_MASK;
+    SDL_HandleSlot *slot;
+    void *object = NULL;
+
+    SDL_LockSpinlock(&table->lock);
+    slot = (index < table->num_slots) ? SDL_GetHandleSlot(table, index) : NULL;
+    if (slot && SDL_MakeHandle(index, SDL_AtomicGet(&slot->generation)) == handle && slot->object) {
+        int generation = SDL_AtomicGet(&slot->generation) + 1;
+        if ((Uint32)generation >= SDL_HANDLE_GENERATIONS) {
+            generation = 1;
+        }
+
+        /* Move the generation first, so readers that already matched it notice on their recheck */
+        object = slot->object;
+        SDL_AtomicSet(&slot->generation, generation);
+        SDL_AtomicSetPtr(&slot->object, NULL);
+
+        slot->next_free = 0;
+        if (table->num_free == 0) {
+            table->free_head = index;
+        } else {
+            SDL_GetHandleSlot(table, table->free_tail)->next_free = index;
+        }
+        table->free_tail = index;
+        ++table->num_free;
+    }
+    SDL_UnlockSpinlock(&table->lock);
+
+    return object;
+}
+
+void *SDL_FindInHandleTable(SDL_HandleTable *table, Uint32 handle)
+{
+    const Uint32 index = handle & SDL_HANDLE_INDEX_MASK;
+    const int generation = (int)(handle >> SDL_HANDLE_INDEX_BITS);
+    SDL_HandleSlot *slot;
+    void *object;
+
+    if (!table || generation == 0) {
+        return NULL;
+    }
+
+    slot = SDL_GetHandleSlot(table, index);
+    if (!slot || SDL_AtomicGet(&slot->generation) != generation) {
+        return NULL;
+    }
+    object = SDL_AtomicGetPtr(&slot->object);
+    if (SDL_AtomicGet(&slot->generation) != generation) {
+        return NULL;
+    }
+    return object;
+}
+
+SDL_bool SDL_IterateHandleTable(SDL_HandleTable *table, Uint32 *handle, void **object, Uint32 *iter)
+{
+    SDL_bool found = SDL_FALSE;
+
+    SDL_LockSpinlock(&table->lock);
+    while (*iter < table->num_slots) {
+        const Uint32 index = (*iter)++;
+        SDL_HandleSlot *slot = SDL_GetHandleSlot(table, index);
+        if (slot->object) {
+            *handle = SDL_MakeHandle(index, SDL_AtomicGet(&slot->generation));
+            *object = slot->object;
+            found = SDL_TRUE;
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&table->lock);
+
+    return found;
+}
@@ -0,0 +1,51 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef SDL_handletable_h_
+#define SDL_handletable_h_
+
+/* A table of objects indexed by generational handles.
+
+   A handle holds a slot index and the generation of the slot when the object
+   was added, so a stale handle never resolves to an object that reused the
+   slot. Looking up a handle takes no lock; adding and removing objects is
+   serialized inside the table.
+
+   Like the SDL_HashTable lookups it replaces, a lookup only says the object
+   was valid at that moment; keeping it alive is up to the caller. */
+
+typedef struct SDL_HandleTable SDL_HandleTable;
+
+extern SDL_HandleTable *SDL_CreateHandleTable(void);
+extern void SDL_DestroyHandleTable(SDL_HandleTable *table);
+
+/* Returns the new handle, which is never 0, or 0 on failure */
+extern Uint32 SDL_AddToHandleTable(SDL_HandleTable *table, void *object);
+
+/* Returns the object removed, or NULL if the handle isn't valid */
+extern void *SDL_RemoveFromHandleTable(SDL_HandleTable *table, Uint32 handle);
+
+/* Returns the object for a handle, or NULL if the handle isn't valid */
+extern void *SDL_FindInHandleTable(SDL_HandleTable *table, Uint32 handle);
+
+/* Iterate over the valid handles, start with *iter set to 0 */
+extern SDL_bool SDL_IterateHandleTable(SDL_HandleTable *table, Uint32 *handle, void **object, Uint32 *iter);
+
+#endif /* SDL_handletable_h_ */
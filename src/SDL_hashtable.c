@@ -21,17 +21,28 @@
 #include "SDL_internal.h"
 #include "SDL_hashtable.h"
 
+// This is a Robin Hood hash table: open addressing with linear probing, where
+// an item being inserted takes the slot of any item that is closer to its own
+// home slot. That keeps probe sequences short and lets lookups stop as soon as
+// they pass the point where the key would have been placed. Removal shifts the
+// following items back a slot instead of leaving tombstones.
+
+#define MAX_HASHTABLE_SIZE 0x80000000u
+
 typedef struct SDL_HashItem
 {
     const void *key;
     const void *value;
-    struct SDL_HashItem *next;
+    Uint32 hash;
+    Uint32 probe_len : 31;  // distance from the slot the hash points to.
+    Uint32 live : 1;
 } SDL_HashItem;
 
 struct SDL_HashTable
 {
-    SDL_HashItem **table;
+    SDL_HashItem *table;
     Uint32 table_len;
+    Uint32 num_occupied_slots;
     int hash_shift;
     SDL_bool stackable;
     void *data;
@@ -59,7 +70,7 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
         return NULL;
     }
 
-    table->table = (SDL_HashItem **) SDL_calloc(num_buckets, sizeof (SDL_HashItem *));
+    table->table = (SDL_HashItem *) SDL_calloc(num_buckets, sizeof (SDL_HashItem));
     if (!table->table) {
         SDL_free(table);
         return NULL;
@@ -77,118 +88,236 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
 
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    // Mix the bits together, and use the highest bits as the bucket index.
+    // Mix the bits together; the highest bits are used as the slot index.
     const Uint32 BitMixer = 0x9E3779B1u;
-    return (table->hash(key, table->data) * BitMixer) >> table->hash_shift;
+    return table->hash(key, table->data) * BitMixer;
 }
 
+static SDL_INLINE Uint32 get_home_slot(Uint32 hash, int hash_shift)
+{
+    return hash >> hash_shift;
+}
+
+static SDL_HashItem *find_first_item(const SDL_HashTable *table, const void *key, Uint32 hash)
+{
+    const Uint32 hash_mask = table->table_len - 1;
+    Uint32 idx = get_home_slot(hash, table->hash_shift);
+    Uint32 probe_len = 0;
+
+    for (;;) {
+        SDL_HashItem *item = &table->table[idx];
+
+        // Past here the key would have displaced this item, so it isn't in the table.
+        if (!item->live || probe_len > item->probe_len) {
+            return NULL;
+        }
+        if (item->hash == hash && table->keymatch(key, item->key, table->data)) {
+            return item;
+        }
+
+        idx = (idx + 1) & hash_mask;
+        ++probe_len;
+    }
+}
+
+static void insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *slots, Uint32 table_len, int hash_shift)
+{
+    const Uint32 hash_mask = table_len - 1;
+    SDL_HashItem item = *item_to_insert;
+    Uint32 idx = get_home_slot(item.hash, hash_shift);
+
+    item.probe_len = 0;
+    item.live = 1;
+
+    for (;;) {
+        SDL_HashItem *slot = &slots[idx];
+
+        if (!slot->live) {
+            *slot = item;
+            return;
+        }
+
+        // Take from the rich (items near their home slot) and give to the poor.
+        if (slot->probe_len < item.probe_len) {
+            const SDL_HashItem displaced = *slot;
+            *slot = item;
+            item = displaced;
+        }
+
+        idx = (idx + 1) & hash_mask;
+        ++item.probe_len;
+    }
+}
+
+static SDL_bool resize(SDL_HashTable *table, Uint32 new_size)
+{
+    SDL_HashItem *old_table = table->table;
+    const Uint32 old_size = table->table_len;
+    SDL_HashItem *new_table;
+    int new_shift;
+    Uint32 i;
+
+    new_table = (SDL_HashItem *) SDL_calloc(new_size, sizeof (SDL_HashItem));
+    if (!new_table) {
+        return SDL_FALSE;
+    }
+
+    new_shift = 32 - SDL_MostSignificantBitIndex32(new_size);
+    for (i = 0; i < old_size; ++i) {
+        if (old_table[i].live) {
+            insert_item(&old_table[i], new_table, new_size, new_shift);
+        }
+    }
+
+    table->table = new_table;
+    table->table_len = new_size;
+    table->hash_shift = new_shift;
+    SDL_free(old_table);
+    return SDL_TRUE;
+}
+
+static SDL_bool maybe_resize(SDL_HashTable *table)
+{
+    // Keep the load under 7/8, where probe sequences start to get long.
+    const Uint32 max_load = table->table_len - (table->table_len >> 3);
+
+    if (table->num_occupied_slots < max_load) {
+        return SDL_TRUE;
+    }
+    if (table->table_len >= MAX_HASHTABLE_SIZE) {
+        // Full size; keep going as long as there's still an empty slot to stop probes.
+        return (table->num_occupied_slots < table->table_len - 1);
+    }
+    return resize(table, table->table_len * 2);
+}
 
 SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
 {
-    SDL_HashItem *item;
+    SDL_HashItem item;
     Uint32 hash;
 
     if (!table) {
         return SDL_FALSE;
     }
 
-    if ( (!table->stackable) && (SDL_FindInHashTable(table, key, NULL)) ) {
+    hash = calc_hash(table, key);
+
+    if ( (!table->stackable) && (find_first_item(table, key, hash)) ) {
         return SDL_FALSE;
     }
 
-    // !!! FIXME: grow and rehash table if it gets too saturated.
-    item = (SDL_HashItem *) SDL_malloc(sizeof (SDL_HashItem));
-    if (!item) {
+    if (!maybe_resize(table)) {
         return SDL_FALSE;
     }
 
-    hash = calc_hash(table, key);
-
-    item->key = key;
-    item->value = value;
-    item->next = table->table[hash];
-    table->table[hash] = item;
+    item.key = key;
+    item.value = value;
+    item.hash = hash;
+    insert_item(&item, table->table, table->table_len, table->hash_shift);
+    ++table->num_occupied_slots;
 
     return SDL_TRUE;
 }
 
 SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
 {
-    Uint32 hash;
-    void *data;
-    SDL_HashItem *i;
+    SDL_HashItem *item;
 
     if (!table) {
         return SDL_FALSE;
     }
 
-    hash = calc_hash(table, key);
-    data = table->data;
+    item = find_first_item(table, key, calc_hash(table, key));
+    if (!item) {
+        return SDL_FALSE;
+    }
 
-    for (i = table->table[hash]; i; i = i->next) {
-        if (table->keymatch(key, i->key, data)) {
-            if (_value) {
-                *_value = i->value;
-            }
-            return SDL_TRUE;
+    if (_value) {
+        *_value = item->value;
+    }
+    return SDL_TRUE;
+}
+
+static void delete_item(SDL_HashTable *table, SDL_HashItem *item)
+{
+    const Uint32 hash_mask = table->table_len - 1;
+    Uint32 idx = (Uint32)(item - table->table);
+
+    if (table->nuke) {
+        table->nuke(item->key, item->value, table->data);
+    }
+
+    // Shift the rest of the probe sequence back so lookups don't need tombstones.
+    for (;;) {
+        const Uint32 next = (idx + 1) & hash_mask;
+        SDL_HashItem *next_item = &table->table[next];
+
+        if (!next_item->live || next_item->probe_len == 0) {
+            break;
         }
+
+        table->table[idx] = *next_item;
+        --table->table[idx].probe_len;
+        idx = next;
     }
 
-    return SDL_FALSE;
+    SDL_zero(table->table[idx]);
+    --table->num_occupied_slots;
 }
 
 SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
-    Uint32 hash;
-    SDL_HashItem *item = NULL;
-    SDL_HashItem *prev = NULL;
-    void *data;
+    SDL_HashItem *item;
 
     if (!table) {
         return SDL_FALSE;
     }
 
-    hash = calc_hash(table, key);
-    data = table->data;
-
-    for (item = table->table[hash]; item; item = item->next) {
-        if (table->keymatch(key, item->key, data)) {
-            if (prev) {
-                prev->next = item->next;
-            } else {
-                table->table[hash] = item->next;
-            }
-
-            if (table->nuke) {
-                table->nuke(item->key, item->value, data);
-            }
-            SDL_free(item);
-            return SDL_TRUE;
-        }
-
-        prev = item;
+    item = find_first_item(table, key, calc_hash(table, key));
+    if (!item) {
+        return SDL_FALSE;
     }
 
-    return SDL_FALSE;
+    delete_item(table, item);
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter)
 {
     SDL_HashItem *item;
+    Uint32 hash_mask, home, idx, probe_len;
 
     if (!table) {
         return SDL_FALSE;
     }
 
-    item = *iter ? ((SDL_HashItem *)*iter)->next : table->table[calc_hash(table, key)];
-
-    while (item) {
-        if (table->keymatch(key, item->key, table->data)) {
-            *_value = item->value;
-            *iter = item;
-            return SDL_TRUE;
+    hash_mask = table->table_len - 1;
+
+    if (!*iter) {
+        item = find_first_item(table, key, calc_hash(table, key));
+    } else {
+        // Keep walking the probe sequence after the last match.
+        item = (SDL_HashItem *) *iter;
+        home = get_home_slot(item->hash, table->hash_shift);
+        idx = (Uint32)(item - table->table);
+        for (;;) {
+            idx = (idx + 1) & hash_mask;
+            probe_len = (idx - home) & hash_mask;
+            item = &table->table[idx];
+            if (!item->live || probe_len > item->probe_len) {
+                item = NULL;
+                break;
+            }
+            if (item->hash == ((SDL_HashItem *) *iter)->hash && table->keymatch(key, item->key, table->data)) {
+                break;
+            }
         }
-        item = item->next;
+    }
+
+    if (item) {
+        *_value = item->value;
+        *iter = item;
+        return SDL_TRUE;
     }
 
     // no more matches.
@@ -200,25 +329,18 @@ SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, co
 SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const void **_value, void **iter)
 {
     SDL_HashItem *item = (SDL_HashItem *) *iter;
-    Uint32 idx = 0;
 
     if (!table) {
         return SDL_FALSE;
     }
 
-    if (item) {
-        const SDL_HashItem *orig = item;
-        item = item->next;
-        if (!item) {
-            idx = calc_hash(table, orig->key) + 1;  // !!! FIXME: we probably shouldn't rehash each time.
-        }
-    }
+    item = item ? item + 1 : table->table;
 
-    while (!item && (idx < table->table_len)) {
-        item = table->table[idx++];  // skip empty buckets...
+    while (item < table->table + table->table_len && !item->live) {
+        ++item;  // skip empty slots...
     }
 
-    if (!item) {  // no more matches?
+    if (item == table->table + table->table_len) {  // no more matches?
         *_key = NULL;
         *iter = NULL;
         return SDL_FALSE;
@@ -233,17 +355,7 @@ SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, con
 
 SDL_bool SDL_HashTableEmpty(SDL_HashTable *table)
 {
-    if (table) {
-        Uint32 i;
-
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            if (item) {
-                return SDL_FALSE;
-            }
-        }
-    }
-    return SDL_TRUE;
+    return !(table && table->num_occupied_slots);
 }
 
 void SDL_EmptyHashTable(SDL_HashTable *table)
@@ -252,18 +364,17 @@ void SDL_EmptyHashTable(SDL_HashTable *table)
         void *data = table->data;
         Uint32 i;
 
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            while (item) {
-                SDL_HashItem *next = item->next;
-                if (table->nuke) {
+        if (table->nuke) {
+            for (i = 0; i < table->table_len; i++) {
+                SDL_HashItem *item = &table->table[i];
+                if (item->live) {
                     table->nuke(item->key, item->value, data);
                 }
-                SDL_free(item);
-                item = next;
             }
-            table->table[i] = NULL;
         }
+
+        SDL_memset(table->table, 0, sizeof(*table->table) * table->table_len);
+        table->num_occupied_slots = 0;
     }
 }
 
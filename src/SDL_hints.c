@@ -20,6 +20,7 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_hashtable.h"
 #include "SDL_hints_c.h"
 
 typedef struct SDL_HintWatch
@@ -38,6 +39,14 @@ typedef struct SDL_Hint
 
 static SDL_PropertiesID SDL_hint_props = 0;
 
+// Starts at 1 so a cached hint that was never read doesn't look up to date
+SDL_AtomicInt SDL_hint_version = { 1 };
+
+// Cached hints can be shared between threads, so the values they point at
+// can't be per-thread persistent strings. These live until SDL_QuitHints(),
+// and are only touched with the hint properties locked.
+static SDL_HashTable *SDL_hint_values = NULL;
+
 static SDL_PropertiesID GetHintProperties(SDL_bool create)
 {
     if (!SDL_hint_props && create) {
@@ -93,6 +102,7 @@ int SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriorit
                 char *old_value = hint->value;
 
                 hint->value = value ? SDL_strdup(value) : NULL;
+                SDL_AtomicAdd(&SDL_hint_version, 1);
                 SDL_HintWatch *entry = hint->callbacks;
                 while (entry) {
                     // Save the next entry in case this one is deleted
@@ -102,7 +112,10 @@ int SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriorit
                 }
                 SDL_free(old_value);
             }
-            hint->priority = priority;
+            if (hint->priority != priority) {
+                hint->priority = priority;
+                SDL_AtomicAdd(&SDL_hint_version, 1);
+            }
             retval = 0;
         }
     } else {  // Couldn't find the hint? Add a new one.
@@ -112,6 +125,7 @@ int SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriorit
             hint->priority = priority;
             hint->callbacks = NULL;
             retval = (SDL_SetPointerPropertyWithCleanup(hints, name, hint, CleanupHintProperty, NULL) != -1);
+            SDL_AtomicAdd(&SDL_hint_version, 1);
         }
     }
 
@@ -150,6 +164,7 @@ int SDL_ResetHint(const char *name)
         SDL_free(hint->value);
         hint->value = NULL;
         hint->priority = SDL_HINT_DEFAULT;
+        SDL_AtomicAdd(&SDL_hint_version, 1);
         retval = 0;
     }
 
@@ -178,6 +193,7 @@ static void SDLCALL ResetHintsCallback(void *userdata, SDL_PropertiesID hints, c
     SDL_free(hint->value);
     hint->value = NULL;
     hint->priority = SDL_HINT_DEFAULT;
+    SDL_AtomicAdd(&SDL_hint_version, 1);
 }
 
 void SDL_ResetHints(void)
@@ -217,6 +233,67 @@ const char *SDL_GetHint(const char *name)
     return retval;
 }
 
+static const char *GetInternedHintValue(const char *value)
+{
+    const char *retval = NULL;
+
+    if (!value) {
+        return NULL;
+    }
+
+    if (!SDL_hint_values) {
+        SDL_hint_values = SDL_CreateHashTable(NULL, 16, SDL_HashString, SDL_KeyMatchString, SDL_NukeFreeValue, SDL_FALSE);
+        if (!SDL_hint_values) {
+            return NULL;
+        }
+    }
+
+    if (!SDL_FindInHashTable(SDL_hint_values, value, (const void **)&retval)) {
+        char *new_value = SDL_strdup(value);
+        if (!new_value) {
+            return NULL;
+        }
+        if (!SDL_InsertIntoHashTable(SDL_hint_values, new_value, new_value)) {
+            SDL_free(new_value);
+            return NULL;
+        }
+        retval = new_value;
+    }
+    return retval;
+}
+
+const char *SDL_UpdateCachedHint(SDL_CachedHint *cache)
+{
+    const SDL_PropertiesID hints = GetHintProperties(SDL_TRUE);
+    if (!hints) {
+        return NULL;
+    }
+
+    // Everything happens under the hint properties lock, which is the same lock
+    // held while hints change and their callbacks run, so there's a single lock
+    // order and an older lookup can't overwrite a newer one.
+    SDL_LockProperties(hints);
+
+    // Hints are changed under this lock too, so the version matches the value we find
+    const int version = SDL_GetHintVersion();
+    const char *retval = SDL_getenv(cache->name);
+
+    SDL_Hint *hint = SDL_GetPointerProperty(hints, cache->name, NULL);
+    if (hint) {
+        if (!retval || hint->priority == SDL_HINT_OVERRIDE) {
+            retval = hint->value;
+        }
+    }
+    retval = GetInternedHintValue(retval);
+
+    SDL_AtomicSetPtr((void **)&cache->value, (void *)retval);
+    SDL_AtomicSet(&cache->version, version);
+
+    SDL_UnlockProperties(hints);
+
+    return retval;
+}
+
 int SDL_GetStringInteger(const char *value, int default_value)
 {
     if (!value || !*value) {
@@ -338,6 +415,14 @@ void SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *user
 
 void SDL_QuitHints(void)
 {
+    if (SDL_hint_props) {
+        SDL_LockProperties(SDL_hint_props);
+        SDL_AtomicAdd(&SDL_hint_version, 1);
+        SDL_DestroyHashTable(SDL_hint_values);
+        SDL_hint_values = NULL;
+        SDL_UnlockProperties(SDL_hint_props);
+    }
+
     SDL_DestroyProperties(SDL_hint_props);
     SDL_hint_props = 0;
 }
@@ -30,4 +30,42 @@ extern SDL_bool SDL_GetStringBoolean(const char *value, SDL_bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
 extern void SDL_QuitHints(void);
 
+/* A hint value that is only looked up again after some hint has changed.
+ * Declare it static with SDL_CACHED_HINT() and read it with
+ * SDL_GetCachedHint(), which costs a couple of loads while nothing changes.
+ * Environment variables are only picked up when the cache is refreshed, so
+ * changing one after the hint was first read has no effect until some hint
+ * is set or reset.
+ */
+typedef struct SDL_CachedHint
+{
+    const char *name;
+    SDL_AtomicInt version;
+    const char *value;
+} SDL_CachedHint;
+
+#define SDL_CACHED_HINT(name) { name, { 0 }, NULL }
+
+extern SDL_AtomicInt SDL_hint_version;
+extern const char *SDL_UpdateCachedHint(SDL_CachedHint *hint);
+
+/* This changes every time any hint is set or reset */
+SDL_FORCE_INLINE int SDL_GetHintVersion(void)
+{
+    return SDL_AtomicGet(&SDL_hint_version);
+}
+
+SDL_FORCE_INLINE const char *SDL_GetCachedHint(SDL_CachedHint *hint)
+{
+    if (SDL_AtomicGet(&hint->version) == SDL_GetHintVersion()) {
+        return (const char *)SDL_AtomicGetPtr((void **)&hint->value);
+    }
+    return SDL_UpdateCachedHint(hint);
+}
+
+SDL_FORCE_INLINE SDL_bool SDL_GetCachedHintBoolean(SDL_CachedHint *hint, SDL_bool default_value)
+{
+    return SDL_GetStringBoolean(SDL_GetCachedHint(hint), default_value);
+}
+
 #endif /* SDL_hints_c_h_ */
@@ -285,15 +285,29 @@ extern "C" {
 #endif
 
 #include "SDL_utils_c.h"
+#include "SDL_trace_c.h"
 
 /* Do any initialization that needs to happen before threads are started */
 extern void SDL_InitMainThread(void);
 
+/* Let the calling thread's allocator cache small freed blocks, the thread must
+   call SDL_FlushMemoryCache() before it exits or the cached blocks are leaked */
+extern void SDL_EnableMemoryCache(void);
+
+/* Return the small blocks the calling thread's allocator has cached to the heap,
+   and stop caching on this thread */
+extern void SDL_FlushMemoryCache(void);
+
+/* Copies and fills at least this big bypass the cache with streaming stores,
+   since they would evict more than they could keep useful */
+#define SDL_NONTEMPORAL_THRESHOLD (1024 * 1024)
+
 /* The internal implementations of these functions have up to nanosecond precision.
    We can expose these functions as part of the API if we want to later.
 */
 extern int SDLCALL SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS);
 extern int SDLCALL SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS);
+extern int SDLCALL SDL_WaitAtomicIntTimeoutNS(SDL_AtomicInt *a, int value, Sint64 timeoutNS);
 extern SDL_bool SDLCALL SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS);
 
 /* Ends C function definitions when using C++ */
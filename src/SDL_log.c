@@ -43,6 +43,12 @@
 
 #define DEFAULT_CATEGORY -1
 
+/* The number of records in the asynchronous log buffer, must be a power of two. */
+#define SDL_LOG_ASYNC_RECORDS 256
+
+/* The size of a message in the asynchronous log buffer, longer messages are truncated. */
+#define SDL_MAX_LOG_MESSAGE_ASYNC 512
+
 typedef struct SDL_LogLevel
 {
     int category;
@@ -50,6 +56,29 @@ typedef struct SDL_LogLevel
     struct SDL_LogLevel *next;
 } SDL_LogLevel;
 
+/* A bounded multi-producer queue: each record's sequence tells producers
+   whether it is free for the position they claimed and tells the consumer
+   whether it has been filled in. */
+typedef struct SDL_LogRecord
+{
+    SDL_AtomicInt sequence;
+    int category;
+    SDL_LogPriority priority;
+    char message[SDL_MAX_LOG_MESSAGE_ASYNC];
+} SDL_LogRecord;
+
+typedef struct SDL_LogQueue
+{
+    SDL_LogRecord records[SDL_LOG_ASYNC_RECORDS];
+    SDL_AtomicInt tail;      /* the next position producers will claim */
+    Uint32 head;             /* the next position to write out, protected by log_function_mutex */
+    int reported_drops;      /* protected by log_function_mutex */
+    SDL_AtomicInt published; /* bumped after each record is filled in, the log thread waits on it */
+    SDL_AtomicInt sleeping;
+    SDL_AtomicInt quit;
+    SDL_Thread *thread;
+} SDL_LogQueue;
+
 
 /* The default log output function */
 static void SDLCALL SDL_LogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message);
@@ -62,6 +91,9 @@ static SDL_LogPriority SDL_forced_priority_level;
 static SDL_LogOutputFunction SDL_log_function = SDL_LogOutput;
 static void *SDL_log_userdata = NULL;
 static SDL_Mutex *log_function_mutex = NULL;
+static SDL_LogQueue *SDL_log_queue = NULL;
+static SDL_AtomicInt SDL_log_queue_users;
+static SDL_AtomicInt SDL_log_dropped;
 
 #ifdef HAVE_GCC_DIAGNOSTIC_PRAGMA
 #pragma GCC diagnostic push
@@ -122,6 +154,7 @@ void SDL_InitLog(void)
 
 void SDL_QuitLog(void)
 {
+    SDL_SetLogAsync(SDL_FALSE);
     SDL_ResetLogPriorities();
     SDL_ResetLogPrefixes();
 
@@ -441,6 +474,195 @@ static const char *GetCategoryPrefix(int category)
 }
 #endif /* SDL_PLATFORM_ANDROID */
 
+static void SDL_ChopLogEndline(char *message, int len)
+{
+    /* Chop off final endline. */
+    if ((len > 0) && (message[len - 1] == '\n')) {
+        message[--len] = '\0';
+        if ((len > 0) && (message[len - 1] == '\r')) { /* catch "\r\n", too. */
+            message[--len] = '\0';
+        }
+    }
+}
+
+static SDL_bool SDL_QueueLogMessage(int category, SDL_LogPriority priority, const char *fmt, va_list ap)
+{
+    SDL_LogQueue *queue;
+    SDL_LogRecord *record;
+    Uint32 pos;
+    int len;
+    va_list aq;
+
+    /* Keep the queue alive while we use it, SDL_SetLogAsync() waits for us */
+    SDL_AtomicIncRef(&SDL_log_queue_users);
+    queue = (SDL_LogQueue *)SDL_AtomicGetPtr((void **)&SDL_log_queue);
+    if (!queue) {
+        SDL_AtomicAdd(&SDL_log_queue_users, -1);
+        return SDL_FALSE;
+    }
+
+    for (;;) {
+        Sint32 diff;
+
+        pos = (Uint32)SDL_AtomicGet(&queue->tail);
+        record = &queue->records[pos & (SDL_LOG_ASYNC_RECORDS - 1)];
+        diff = (Sint32)((Uint32)SDL_AtomicGet(&record->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_AtomicCompareAndSwap(&queue->tail, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The buffer is full, the log thread can't keep up */
+            SDL_AtomicIncRef(&SDL_log_dropped);
+            SDL_AtomicAdd(&SDL_log_queue_users, -1);
+            return SDL_TRUE;
+        }
+        /* Otherwise another thread claimed this position first, try again */
+    }
+
+    va_copy(aq, ap);
+    len = SDL_vsnprintf(record->message, sizeof(record->message), fmt, aq);
+    va_end(aq);
+    if (len < 0) {
+        len = 0;
+        record->message[0] = '\0';
+    } else if (len >= (int)sizeof(record->message)) {
+        len = (int)sizeof(record->message) - 1;
+    }
+    SDL_ChopLogEndline(record->message, len);
+    record->category = category;
+    record->priority = priority;
+    SDL_AtomicSet(&record->sequence, (int)(pos + 1));
+
+    SDL_AtomicAdd(&queue->published, 1);
+    if (SDL_AtomicGet(&queue->sleeping)) {
+        SDL_SignalAtomicInt(&queue->published);
+    }
+
+    SDL_AtomicAdd(&SDL_log_queue_users, -1);
+    return SDL_TRUE;
+}
+
+/* This must be called with log_function_mutex held */
+static void SDL_DrainLogQueue(SDL_LogQueue *queue)
+{
+    int dropped;
+
+    for (;;) {
+        SDL_LogRecord *record = &queue->records[queue->head & (SDL_LOG_ASYNC_RECORDS - 1)];
+        if ((Uint32)SDL_AtomicGet(&record->sequence) != queue->head + 1) {
+            break;
+        }
+        if (SDL_log_function) {
+            SDL_log_function(SDL_log_userdata, record->category, record->priority, record->message);
+        }
+        SDL_AtomicSet(&record->sequence, (int)(queue->head + SDL_LOG_ASYNC_RECORDS));
+        ++queue->head;
+    }
+
+    dropped = SDL_AtomicGet(&SDL_log_dropped);
+    if (dropped != queue->reported_drops) {
+        if (SDL_log_function) {
+            char message[SDL_MAX_LOG_MESSAGE_STACK];
+            (void)SDL_snprintf(message, sizeof(message), "%d log messages dropped, the log buffer was full", dropped - queue->reported_drops);
+            SDL_log_function(SDL_log_userdata, SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_WARN, message);
+        }
+        queue->reported_drops = dropped;
+    }
+}
+
+static int SDLCALL SDL_LogThread(void *data)
+{
+    SDL_LogQueue *queue = (SDL_LogQueue *)data;
+
+    while (!SDL_AtomicGet(&queue->quit)) {
+        /* Anything published after this is either drained below or wakes us up */
+        const int published = SDL_AtomicGet(&queue->published);
+
+        SDL_LockMutex(log_function_mutex);
+        SDL_DrainLogQueue(queue);
+        SDL_UnlockMutex(log_function_mutex);
+
+        SDL_AtomicSet(&queue->sleeping, 1);
+        SDL_WaitAtomicInt(&queue->published, published);
+        SDL_AtomicSet(&queue->sleeping, 0);
+    }
+    return 0;
+}
+
+int SDL_SetLogAsync(SDL_bool enabled)
+{
+    SDL_LogQueue *queue = (SDL_LogQueue *)SDL_AtomicGetPtr((void **)&SDL_log_queue);
+    int i;
+
+    if (enabled) {
+        if (queue) {
+            return 0;
+        }
+
+        if (!log_function_mutex) {
+            log_function_mutex = SDL_CreateMutex();
+        }
+
+        queue = (SDL_LogQueue *)SDL_calloc(1, sizeof(*queue));
+        if (!queue) {
+            return -1;
+        }
+        for (i = 0; i < SDL_LOG_ASYNC_RECORDS; ++i) {
+            SDL_AtomicSet(&queue->records[i].sequence, i);
+        }
+        SDL_AtomicSet(&SDL_log_dropped, 0);
+
+        queue->thread = SDL_CreateThread(SDL_LogThread, "SDLLog", queue);
+        if (!queue->thread) {
+            SDL_free(queue);
+            return -1;
+        }
+        SDL_AtomicSetPtr((void **)&SDL_log_queue, queue);
+    } else {
+        if (!queue) {
+            return 0;
+        }
+
+        /* New messages go straight to the output function from here on */
+        SDL_AtomicSetPtr((void **)&SDL_log_queue, NULL);
+        while (SDL_AtomicGet(&SDL_log_queue_users) > 0) {
+            SDL_CPUPauseInstruction();
+        }
+
+        SDL_AtomicSet(&queue->quit, 1);
+        SDL_AtomicAdd(&queue->published, 1);
+        SDL_SignalAtomicInt(&queue->published);
+        SDL_WaitThread(queue->thread, NULL);
+
+        SDL_LockMutex(log_function_mutex);
+        SDL_DrainLogQueue(queue);
+        SDL_UnlockMutex(log_function_mutex);
+
+        SDL_free(queue);
+    }
+    return 0;
+}
+
+void SDL_FlushLog(void)
+{
+    SDL_LogQueue *queue;
+
+    SDL_AtomicIncRef(&SDL_log_queue_users);
+    queue = (SDL_LogQueue *)SDL_AtomicGetPtr((void **)&SDL_log_queue);
+    if (queue) {
+        SDL_LockMutex(log_function_mutex);
+        SDL_DrainLogQueue(queue);
+        SDL_UnlockMutex(log_function_mutex);
+    }
+    SDL_AtomicAdd(&SDL_log_queue_users, -1);
+}
+
+int SDL_GetLogDroppedCount(void)
+{
+    return SDL_AtomicGet(&SDL_log_dropped);
+}
+
 void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_STRING const char *fmt, va_list ap)
 {
     char *message = NULL;
@@ -469,6 +691,10 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_S
         log_function_mutex = SDL_CreateMutex();
     }
 
+    if (SDL_AtomicGetPtr((void **)&SDL_log_queue) && SDL_QueueLogMessage(category, priority, fmt, ap)) {
+        return;
+    }
+
     /* Render into stack buffer */
     va_copy(aq, ap);
     len = SDL_vsnprintf(stack_buf, sizeof(stack_buf), fmt, aq);
@@ -492,13 +718,7 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_S
         message = stack_buf;
     }
 
-    /* Chop off final endline. */
-    if ((len > 0) && (message[len - 1] == '\n')) {
-        message[--len] = '\0';
-        if ((len > 0) && (message[len - 1] == '\r')) { /* catch "\r\n", too. */
-            message[--len] = '\0';
-        }
-    }
+    SDL_ChopLogEndline(message, len);
 
     SDL_LockMutex(log_function_mutex);
     SDL_log_function(SDL_log_userdata, category, priority, message);
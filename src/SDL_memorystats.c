@@ -0,0 +1,54 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+#include "SDL_internal.h"
+
+#include "SDL_memorystats_c.h"
+
+/* Updates are rare compared to the work that allocates the memory, so one lock is plenty */
+static SDL_SpinLock SDL_memory_stats_lock;
+static SDL_MemoryStats SDL_memory_stats[SDL_MEMORY_CATEGORY_COUNT];
+
+void SDL_TrackMemory(SDL_MemoryCategory category, Sint64 bytes, Sint64 gpu_bytes, int count)
+{
+    SDL_MemoryStats *stats = &SDL_memory_stats[category];
+
+    SDL_LockSpinlock(&SDL_memory_stats_lock);
+    stats->bytes += (Uint64)bytes;
+    stats->gpu_bytes += (Uint64)gpu_bytes;
+    stats->count += count;
+    SDL_UnlockSpinlock(&SDL_memory_stats_lock);
+}
+
+int SDL_GetMemoryStats(SDL_MemoryCategory category, SDL_MemoryStats *stats)
+{
+    if ((int)category < 0 || category >= SDL_MEMORY_CATEGORY_COUNT) {
+        return SDL_InvalidParamError("category");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&SDL_memory_stats_lock);
+    SDL_copyp(stats, &SDL_memory_stats[category]);
+    SDL_UnlockSpinlock(&SDL_memory_stats_lock);
+    return 0;
+}
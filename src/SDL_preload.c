@@ -0,0 +1,202 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_preload_c.h"
+
+typedef struct SDL_PreloadLibrary
+{
+    SDL_InitFlags subsystem;
+    const char *driver;     /* The driver that loads this library, or NULL if it's shared by all drivers */
+    const char *hint;       /* The hint that selects drivers for this subsystem */
+    const char *library;
+} SDL_PreloadLibrary;
+
+/* These are in roughly the order they'll be needed. Video drivers are probed
+   first on the main thread, so their libraries go last; the main thread will
+   usually have loaded the first one itself by the time we get there. */
+static const SDL_PreloadLibrary SDL_preload_libraries[] = {
+#ifdef SDL_AUDIO_DRIVER_PIPEWIRE_DYNAMIC
+    { SDL_INIT_AUDIO, "pipewire", SDL_HINT_AUDIO_DRIVER, SDL_AUDIO_DRIVER_PIPEWIRE_DYNAMIC },
+#endif
+#ifdef SDL_AUDIO_DRIVER_PULSEAUDIO_DYNAMIC
+    { SDL_INIT_AUDIO, "pulseaudio", SDL_HINT_AUDIO_DRIVER, SDL_AUDIO_DRIVER_PULSEAUDIO_DYNAMIC },
+#endif
+#ifdef SDL_AUDIO_DRIVER_ALSA_DYNAMIC
+    { SDL_INIT_AUDIO, "alsa", SDL_HINT_AUDIO_DRIVER, SDL_AUDIO_DRIVER_ALSA_DYNAMIC },
+#endif
+#ifdef SDL_AUDIO_DRIVER_JACK_DYNAMIC
+    { SDL_INIT_AUDIO, "jack", SDL_HINT_AUDIO_DRIVER, SDL_AUDIO_DRIVER_JACK_DYNAMIC },
+#endif
+#ifdef SDL_AUDIO_DRIVER_SNDIO_DYNAMIC
+    { SDL_INIT_AUDIO, "sndio", SDL_HINT_AUDIO_DRIVER, SDL_AUDIO_DRIVER_SNDIO_DYNAMIC },
+#endif
+#ifdef SDL_CAMERA_DRIVER_PIPEWIRE_DYNAMIC
+    { SDL_INIT_CAMERA, "pipewire", SDL_HINT_CAMERA_DRIVER, SDL_CAMERA_DRIVER_PIPEWIRE_DYNAMIC },
+#endif
+#ifdef SDL_UDEV_DYNAMIC
+    { SDL_INIT_JOYSTICK, NULL, NULL, SDL_UDEV_DYNAMIC },
+#endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC
+    { SDL_INIT_VIDEO, "wayland", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC },
+#endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC_EGL
+    { SDL_INIT_VIDEO, "wayland", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC_EGL },
+#endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC_CURSOR
+    { SDL_INIT_VIDEO, "wayland", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC_CURSOR },
+#endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC_XKBCOMMON
+    { SDL_INIT_VIDEO, "wayland", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_WAYLAND_DYNAMIC_XKBCOMMON },
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC
+    { SDL_INIT_VIDEO, "x11", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_X11_DYNAMIC },
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC_XEXT
+    { SDL_INIT_VIDEO, "x11", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_X11_DYNAMIC_XEXT },
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC_XCURSOR
+    { SDL_INIT_VIDEO, "x11", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_X11_DYNAMIC_XCURSOR },
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC_XINPUT2
+    { SDL_INIT_VIDEO, "x11", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_X11_DYNAMIC_XINPUT2 },
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR
+    { SDL_INIT_VIDEO, "x11", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR },
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES
+    { SDL_INIT_VIDEO, "x11", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES },
+#endif
+#ifdef SDL_VIDEO_DRIVER_KMSDRM_DYNAMIC
+    { SDL_INIT_VIDEO, "kmsdrm", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_KMSDRM_DYNAMIC },
+#endif
+#ifdef SDL_VIDEO_DRIVER_KMSDRM_DYNAMIC_GBM
+    { SDL_INIT_VIDEO, "kmsdrm", SDL_HINT_VIDEO_DRIVER, SDL_VIDEO_DRIVER_KMSDRM_DYNAMIC_GBM },
+#endif
+    { 0, NULL, NULL, NULL }
+};
+
+static int SDL_preload_depth;  /* SDL_InitSubSystem() can be called recursively by subsystems */
+static SDL_Thread *SDL_preload_thread;
+static void *SDL_preload_handles[SDL_arraysize(SDL_preload_libraries)];
+static SDL_InitFlags SDL_preload_flags;
+static SDL_AtomicInt SDL_preload_cancelled;
+
+/* Returns SDL_TRUE if the comma separated driver list in the hint names this driver */
+static SDL_bool SDL_DriverInHint(const char *hint, const char *driver)
+{
+    const size_t driver_len = SDL_strlen(driver);
+
+    while (hint && *hint) {
+        const char *end = SDL_strchr(hint, ',');
+        const size_t len = end ? (size_t)(end - hint) : SDL_strlen(hint);
+
+        if (len == driver_len && SDL_strncasecmp(hint, driver, len) == 0) {
+            return SDL_TRUE;
+        }
+        hint = end ? (end + 1) : NULL;
+    }
+    return SDL_FALSE;
+}
+
+static SDL_bool SDL_ShouldPreload(const SDL_PreloadLibrary *library)
+{
+    const char *hint;
+
+    if (!(SDL_preload_flags & library->subsystem)) {
+        return SDL_FALSE;
+    }
+    if (!library->driver || !library->hint) {
+        return SDL_TRUE;
+    }
+
+    /* If the app picked specific drivers, the others won't be probed */
+    hint = SDL_GetHint(library->hint);
+    if (hint && *hint) {
+        return SDL_DriverInHint(hint, library->driver);
+    }
+    return SDL_TRUE;
+}
+
+static int SDLCALL SDL_PreloadThread(void *data)
+{
+    int i;
+
+    for (i = 0; SDL_preload_libraries[i].library; ++i) {
+        if (SDL_AtomicGet(&SDL_preload_cancelled)) {
+            break;
+        }
+        if (SDL_ShouldPreload(&SDL_preload_libraries[i])) {
+            SDL_preload_handles[i] = SDL_LoadObject(SDL_preload_libraries[i].library);
+        }
+    }
+    return 0;
+}
+
+void SDL_StartDriverPreload(SDL_InitFlags flags)
+{
+    SDL_bool needed = SDL_FALSE;
+    int i;
+
+    if (SDL_preload_depth++ > 0) {
+        return;
+    }
+    if (!SDL_GetHintBoolean(SDL_HINT_DRIVER_PRELOAD, SDL_TRUE)) {
+        return;
+    }
+
+    SDL_preload_flags = flags;
+    for (i = 0; SDL_preload_libraries[i].library; ++i) {
+        if (SDL_ShouldPreload(&SDL_preload_libraries[i])) {
+            needed = SDL_TRUE;
+            break;
+        }
+    }
+    if (!needed) {
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_preload_cancelled, 0);
+    /* If this fails it's not a problem, the drivers will load what they need themselves */
+    SDL_preload_thread = SDL_CreateThread(SDL_PreloadThread, "SDLPreload", NULL);
+}
+
+void SDL_FinishDriverPreload(void)
+{
+    int i;
+
+    if (--SDL_preload_depth > 0 || !SDL_preload_thread) {
+        return;
+    }
+
+    /* Anything not loaded by now isn't going to help */
+    SDL_AtomicSet(&SDL_preload_cancelled, 1);
+    SDL_WaitThread(SDL_preload_thread, NULL);
+    SDL_preload_thread = NULL;
+
+    /* The drivers that were chosen hold their own references */
+    for (i = 0; i < SDL_arraysize(SDL_preload_handles); ++i) {
+        if (SDL_preload_handles[i]) {
+            SDL_UnloadObject(SDL_preload_handles[i]);
+            SDL_preload_handles[i] = NULL;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Loads the shared libraries that driver probing is going to dlopen() on a
+   background thread, so that work overlaps with initializing the other
+   subsystems instead of happening one library at a time on the main thread.
+
+   Driver selection is unchanged: the drivers still load their own libraries
+   in the usual order, they just find them already mapped.
+ */
+
+#ifndef SDL_preload_c_h_
+#define SDL_preload_c_h_
+
+/* Start loading libraries for the subsystems in flags that aren't initialized yet.
+   Calls nest, and each one must be matched by SDL_FinishDriverPreload(). */
+extern void SDL_StartDriverPreload(SDL_InitFlags flags);
+
+/* Wait for the preload thread and drop its references to the libraries */
+extern void SDL_FinishDriverPreload(void);
+
+#endif /* SDL_preload_c_h_ */
@@ -20,8 +20,10 @@
 */
 #include "SDL_internal.h"
 #include "SDL_hashtable.h"
+#include "SDL_handletable.h"
 #include "SDL_hints_c.h"
 #include "SDL_properties_c.h"
+#include "SDL_memorystats_c.h"
 
 
 typedef struct
@@ -45,18 +47,40 @@ typedef struct
 typedef struct
 {
     SDL_HashTable *props;
-    SDL_Mutex *lock;
+    SDL_RWLock *lock;
+    SDL_ThreadID owner;
+    int lock_count;
 } SDL_Properties;
 
-static SDL_HashTable *SDL_properties;
-static SDL_Mutex *SDL_properties_lock;
-static SDL_PropertiesID SDL_last_properties_id;
+static SDL_HandleTable *SDL_properties;
 static SDL_PropertiesID SDL_global_properties;
 
 
+/* The memory a property name and value add to the memory statistics, either may be NULL */
+static Sint64 SDL_GetPropertyMemory(const char *key, const SDL_Property *property)
+{
+    Sint64 bytes = 0;
+
+    if (key) {
+        bytes += SDL_strlen(key) + 1;
+    }
+    if (property) {
+        bytes += sizeof(*property);
+        if (property->type == SDL_PROPERTY_TYPE_STRING && property->value.string_value) {
+            bytes += SDL_strlen(property->value.string_value) + 1;
+        }
+        if (property->string_storage) {
+            bytes += SDL_strlen(property->string_storage) + 1;
+        }
+    }
+    return bytes;
+}
+
 static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, SDL_bool cleanup)
 {
     SDL_Property *property = (SDL_Property *)value;
+
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, -SDL_GetPropertyMemory((const char *)key, property), 0, 0);
     if (property) {
         switch (property->type) {
         case SDL_PROPERTY_TYPE_POINTER:
@@ -81,32 +105,78 @@ static void SDL_FreeProperty(const void *key, const void *value, void *data)
     SDL_FreePropertyWithCleanup(key, value, data, SDL_TRUE);
 }
 
-static void SDL_FreeProperties(const void *key, const void *value, void *data)
+static void SDL_FreeProperties(SDL_Properties *properties)
 {
-    SDL_Properties *properties = (SDL_Properties *)value;
     if (properties) {
         if (properties->props) {
             SDL_DestroyHashTable(properties->props);
             properties->props = NULL;
         }
         if (properties->lock) {
-            SDL_DestroyMutex(properties->lock);
+            SDL_DestroyRWLock(properties->lock);
             properties->lock = NULL;
         }
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, -(Sint64)sizeof(*properties), 0, -1);
         SDL_free(properties);
     }
 }
 
-int SDL_InitProperties(void)
+/* Property sets are read far more often than they are written, so readers
+ * share the lock. Writers and SDL_LockProperties() take it exclusively and
+ * remember the owning thread, so the owner can keep calling the get and set
+ * functions while it holds the lock.
+ */
+static void SDL_LockPropertiesForWriting(SDL_Properties *properties)
 {
-    if (!SDL_properties_lock) {
-        SDL_properties_lock = SDL_CreateMutex();
-        if (!SDL_properties_lock) {
-            return -1;
-        }
+    const SDL_ThreadID self = SDL_GetCurrentThreadID();
+
+    if (properties->owner == self) {
+        ++properties->lock_count;
+        return;
+    }
+    SDL_LockRWLockForWriting(properties->lock);
+    properties->owner = self;
+    properties->lock_count = 1;
+}
+
+static void SDL_UnlockPropertiesForWriting(SDL_Properties *properties)
+{
+    if (--properties->lock_count == 0) {
+        properties->owner = 0;
+        SDL_UnlockRWLock(properties->lock);
+    }
+}
+
+static SDL_bool SDL_LockPropertiesForReading(SDL_Properties *properties)
+{
+    if (properties->owner == SDL_GetCurrentThreadID()) {
+        return SDL_FALSE; /* we already hold it exclusively */
+    }
+    SDL_LockRWLockForReading(properties->lock);
+    return SDL_TRUE;
+}
+
+static void SDL_UnlockPropertiesForReading(SDL_Properties *properties, SDL_bool locked)
+{
+    if (locked) {
+        SDL_UnlockRWLock(properties->lock);
     }
+}
+
+static void SDL_PublishStringStorage(SDL_Property *property, char *string)
+{
+    /* Readers share the lock, so another thread may have beaten us to it */
+    if (SDL_AtomicCompareAndSwapPointer((void **)&property->string_storage, NULL, string)) {
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, SDL_strlen(string) + 1, 0, 0);
+    } else {
+        SDL_free(string);
+    }
+}
+
+int SDL_InitProperties(void)
+{
     if (!SDL_properties) {
-        SDL_properties = SDL_CreateHashTable(NULL, 16, SDL_HashID, SDL_KeyMatchID, SDL_FreeProperties, SDL_FALSE);
+        SDL_properties = SDL_CreateHandleTable();
         if (!SDL_properties) {
             return -1;
         }
@@ -121,13 +191,19 @@ void SDL_QuitProperties(void)
         SDL_global_properties = 0;
     }
     if (SDL_properties) {
-        SDL_DestroyHashTable(SDL_properties);
+        Uint32 handle;
+        void *value;
+        Uint32 iter = 0;
+
+        /* Cleanup callbacks may destroy other properties, so start over each time */
+        while (SDL_IterateHandleTable(SDL_properties, &handle, &value, &iter)) {
+            SDL_RemoveFromHandleTable(SDL_properties, handle);
+            SDL_FreeProperties((SDL_Properties *)value);
+            iter = 0;
+        }
+        SDL_DestroyHandleTable(SDL_properties);
         SDL_properties = NULL;
     }
-    if (SDL_properties_lock) {
-        SDL_DestroyMutex(SDL_properties_lock);
-        SDL_properties_lock = NULL;
-    }
 }
 
 SDL_PropertiesID SDL_GetGlobalProperties(void)
@@ -142,7 +218,6 @@ SDL_PropertiesID SDL_CreateProperties(void)
 {
     SDL_PropertiesID props = 0;
     SDL_Properties *properties = NULL;
-    SDL_bool inserted = SDL_FALSE;
 
     if (!SDL_properties && SDL_InitProperties() < 0) {
         return 0;
@@ -152,11 +227,12 @@ SDL_PropertiesID SDL_CreateProperties(void)
     if (!properties) {
         goto error;
     }
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, sizeof(*properties), 0, 1);
     properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, SDL_FALSE);
     if (!properties->props) {
         goto error;
     }
-    properties->lock = SDL_CreateMutex();
+    properties->lock = SDL_CreateRWLock();
     if (!properties->lock) {
         goto error;
     }
@@ -165,24 +241,14 @@ SDL_PropertiesID SDL_CreateProperties(void)
         goto error;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    ++SDL_last_properties_id;
-    if (SDL_last_properties_id == 0) {
-        ++SDL_last_properties_id;
-    }
-    props = SDL_last_properties_id;
-    if (SDL_InsertIntoHashTable(SDL_properties, (const void *)(uintptr_t)props, properties)) {
-        inserted = SDL_TRUE;
-    }
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (inserted) {
+    props = SDL_AddToHandleTable(SDL_properties, properties);
+    if (props) {
         /* All done! */
         return props;
     }
 
 error:
-    SDL_FreeProperties(NULL, properties, NULL);
+    SDL_FreeProperties(properties);
     return 0;
 }
 
@@ -199,10 +265,8 @@ int SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
         return SDL_InvalidParamError("dst");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)src, (const void **)&src_properties);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)dst, (const void **)&dst_properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    src_properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, src);
+    dst_properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, dst);
 
     if (!src_properties) {
         return SDL_InvalidParamError("src");
@@ -211,8 +275,8 @@ int SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
         return SDL_InvalidParamError("dst");
     }
 
-    SDL_LockMutex(src_properties->lock);
-    SDL_LockMutex(dst_properties->lock);
+    SDL_LockPropertiesForWriting(src_properties);
+    SDL_LockPropertiesForWriting(dst_properties);
     {
         void *iter;
         const void *key, *value;
@@ -243,17 +307,19 @@ int SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
                 continue;
             }
             SDL_copyp(dst_property, src_property);
+            dst_property->string_storage = NULL;
             if (src_property->type == SDL_PROPERTY_TYPE_STRING) {
                 dst_property->value.string_value = SDL_strdup(src_property->value.string_value);
             }
+            SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, SDL_GetPropertyMemory(dst_name, dst_property), 0, 0);
             if (!SDL_InsertIntoHashTable(dst_properties->props, dst_name, dst_property)) {
                 SDL_FreePropertyWithCleanup(dst_name, dst_property, NULL, SDL_FALSE);
                 result = -1;
             }
         }
     }
-    SDL_UnlockMutex(dst_properties->lock);
-    SDL_UnlockMutex(src_properties->lock);
+    SDL_UnlockPropertiesForWriting(dst_properties);
+    SDL_UnlockPropertiesForWriting(src_properties);
 
     return result;
 }
@@ -266,15 +332,13 @@ int SDL_LockProperties(SDL_PropertiesID props)
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     return 0;
 }
 
@@ -286,15 +350,13 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return;
     }
 
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 }
 
 static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
@@ -302,6 +364,11 @@ static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_
     SDL_Properties *properties = NULL;
     int result = 0;
 
+    /* Freeing the property takes it out of the memory statistics again */
+    if (property) {
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, SDL_GetPropertyMemory(NULL, property), 0, 0);
+    }
+
     if (!props) {
         SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_TRUE);
         return SDL_InvalidParamError("props");
@@ -311,27 +378,26 @@ static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_
         return SDL_InvalidParamError("name");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_TRUE);
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     {
         SDL_RemoveFromHashTable(properties->props, name);
         if (property) {
             char *key = SDL_strdup(name);
+            SDL_TrackMemory(SDL_MEMORY_CATEGORY_PROPERTIES, SDL_GetPropertyMemory(key, NULL), 0, 0);
             if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
                 SDL_FreePropertyWithCleanup(key, property, NULL, SDL_TRUE);
                 result = -1;
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 
     return result;
 }
@@ -464,6 +530,7 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
     SDL_Properties *properties = NULL;
     SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
+    SDL_bool locked;
 
     if (!props) {
         return SDL_PROPERTY_TYPE_INVALID;
@@ -472,22 +539,20 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
             type = property->type;
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return type;
 }
@@ -496,6 +561,7 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
 {
     SDL_Properties *properties = NULL;
     void *value = default_value;
+    SDL_bool locked;
 
     if (!props) {
         return value;
@@ -504,9 +570,7 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return value;
@@ -516,7 +580,7 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
      * hashtable while it's being modified. The value itself can easily be
      * freed from another thread after it is returned here.
      */
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
@@ -525,7 +589,7 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
@@ -534,6 +598,7 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
 {
     SDL_Properties *properties = NULL;
     const char *value = default_value;
+    SDL_bool locked;
 
     if (!props) {
         return value;
@@ -542,15 +607,13 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
@@ -559,23 +622,25 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
                 value = property->value.string_value;
                 break;
             case SDL_PROPERTY_TYPE_NUMBER:
+                if (!SDL_AtomicGetPtr((void **)&property->string_storage)) {
+                    char *string_storage = NULL;
+                    if (SDL_asprintf(&string_storage, "%" SDL_PRIs64, property->value.number_value) >= 0) {
+                        SDL_PublishStringStorage(property, string_storage);
+                    }
+                }
                 if (property->string_storage) {
                     value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
                 }
                 break;
             case SDL_PROPERTY_TYPE_FLOAT:
+                if (!SDL_AtomicGetPtr((void **)&property->string_storage)) {
+                    char *string_storage = NULL;
+                    if (SDL_asprintf(&string_storage, "%f", property->value.float_value) >= 0) {
+                        SDL_PublishStringStorage(property, string_storage);
+                    }
+                }
                 if (property->string_storage) {
                     value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
                 }
                 break;
             case SDL_PROPERTY_TYPE_BOOLEAN:
@@ -586,7 +651,7 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
@@ -595,6 +660,7 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
 {
     SDL_Properties *properties = NULL;
     Sint64 value = default_value;
+    SDL_bool locked;
 
     if (!props) {
         return value;
@@ -603,15 +669,13 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
@@ -633,7 +697,7 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
@@ -642,6 +706,7 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
 {
     SDL_Properties *properties = NULL;
     float value = default_value;
+    SDL_bool locked;
 
     if (!props) {
         return value;
@@ -650,15 +715,13 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
@@ -680,7 +743,7 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
@@ -689,6 +752,7 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
 {
     SDL_Properties *properties = NULL;
     SDL_bool value = default_value;
+    SDL_bool locked;
 
     if (!props) {
         return value;
@@ -697,15 +761,13 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
@@ -727,7 +789,7 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
@@ -748,15 +810,13 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    properties = (SDL_Properties *)SDL_FindInHandleTable(SDL_properties, props);
 
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     {
         void *iter;
         const void *key, *value;
@@ -766,7 +826,7 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
             callback(userdata, props, (const char *)key);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 
     return 0;
 }
@@ -805,11 +865,16 @@ int SDL_DumpProperties(SDL_PropertiesID props)
 
 void SDL_DestroyProperties(SDL_PropertiesID props)
 {
+    SDL_Properties *properties = NULL;
+
     if (!props) {
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props);
-    SDL_UnlockMutex(SDL_properties_lock);
+    if (SDL_properties) {
+        properties = (SDL_Properties *)SDL_RemoveFromHandleTable(SDL_properties, props);
+    }
+
+    /* Free outside the lock, cleanup callbacks may destroy other properties */
+    SDL_FreeProperties(properties);
 }
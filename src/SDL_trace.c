@@ -0,0 +1,235 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_TRACING_ENABLED
+
+/* Internal tracing of SDL's hot paths */
+
+/* Writes events in the Chrome trace event format, which can be loaded
+   into chrome://tracing, Perfetto or speedscope. The file is opened when
+   SDL initializes if SDL_HINT_TRACE_FILE is set. */
+
+#define TRACE_BUFFER_SIZE (64 * 1024)
+
+static SDL_SpinLock chrome_trace_lock;
+static SDL_IOStream *chrome_trace_file;
+static char *chrome_trace_buffer;
+static size_t chrome_trace_buffer_used;
+static SDL_bool chrome_trace_first_event;
+
+static void ChromeTrace_Flush(void)
+{
+    if (chrome_trace_buffer_used > 0) {
+        SDL_WriteIO(chrome_trace_file, chrome_trace_buffer, chrome_trace_buffer_used);
+        chrome_trace_buffer_used = 0;
+    }
+}
+
+/* This should be called with chrome_trace_lock held */
+static void ChromeTrace_Write(SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
+{
+    char event[512];
+    size_t length;
+    va_list ap;
+
+    if (!chrome_trace_file) {
+        return;
+    }
+
+    va_start(ap, fmt);
+    (void)SDL_vsnprintf(event, sizeof(event), fmt, ap);
+    va_end(ap);
+
+    length = SDL_strlen(event);
+    if (chrome_trace_buffer_used + length + 2 > TRACE_BUFFER_SIZE) {
+        ChromeTrace_Flush();
+    }
+    if (!chrome_trace_first_event) {
+        chrome_trace_buffer[chrome_trace_buffer_used++] = ',';
+        chrome_trace_buffer[chrome_trace_buffer_used++] = '\n';
+    }
+    SDL_memcpy(&chrome_trace_buffer[chrome_trace_buffer_used], event, length);
+    chrome_trace_buffer_used += length;
+    chrome_trace_first_event = SDL_FALSE;
+}
+
+static int ChromeTrace_Init(void)
+{
+    const char *path = SDL_GetHint(SDL_HINT_TRACE_FILE);
+
+    if (!path || !*path) {
+        return -1;
+    }
+
+    chrome_trace_buffer = (char *)SDL_malloc(TRACE_BUFFER_SIZE);
+    if (!chrome_trace_buffer) {
+        return -1;
+    }
+    chrome_trace_file = SDL_IOFromFile(path, "wb");
+    if (!chrome_trace_file) {
+        SDL_free(chrome_trace_buffer);
+        chrome_trace_buffer = NULL;
+        return -1;
+    }
+    chrome_trace_buffer_used = 0;
+    chrome_trace_first_event = SDL_TRUE;
+    SDL_WriteIO(chrome_trace_file, "[\n", 2);
+    return 0;
+}
+
+static void ChromeTrace_BeginZone(const char *name, Uint64 timestampNS)
+{
+    SDL_LockSpinlock(&chrome_trace_lock);
+    ChromeTrace_Write("{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%" SDL_PRIu64 "}",
+                      name, timestampNS / 1000.0, SDL_GetCurrentThreadID());
+    SDL_UnlockSpinlock(&chrome_trace_lock);
+}
+
+static void ChromeTrace_EndZone(Uint64 timestampNS)
+{
+    SDL_LockSpinlock(&chrome_trace_lock);
+    ChromeTrace_Write("{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%" SDL_PRIu64 "}",
+                      timestampNS / 1000.0, SDL_GetCurrentThreadID());
+    SDL_UnlockSpinlock(&chrome_trace_lock);
+}
+
+static void ChromeTrace_Counter(const char *name, Sint64 value, Uint64 timestampNS)
+{
+    SDL_LockSpinlock(&chrome_trace_lock);
+    ChromeTrace_Write("{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%" SDL_PRIu64 ",\"args\":{\"value\":%" SDL_PRIs64 "}}",
+                      name, timestampNS / 1000.0, SDL_GetCurrentThreadID(), value);
+    SDL_UnlockSpinlock(&chrome_trace_lock);
+}
+
+static void ChromeTrace_ThreadName(const char *name)
+{
+    char escaped[128];
+    size_t i;
+
+    /* Thread names come from the application, keep them from breaking the JSON */
+    for (i = 0; name[i] && i < sizeof(escaped) - 1; ++i) {
+        escaped[i] = (name[i] == '"' || name[i] == '\\' || (unsigned char)name[i] < ' ') ? '_' : name[i];
+    }
+    escaped[i] = '\0';
+
+    SDL_LockSpinlock(&chrome_trace_lock);
+    ChromeTrace_Write("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" SDL_PRIu64 ",\"args\":{\"name\":\"%s\"}}",
+                      SDL_GetCurrentThreadID(), escaped);
+    SDL_UnlockSpinlock(&chrome_trace_lock);
+}
+
+static void ChromeTrace_Quit(void)
+{
+    SDL_LockSpinlock(&chrome_trace_lock);
+    if (chrome_trace_file) {
+        ChromeTrace_Flush();
+        SDL_WriteIO(chrome_trace_file, "\n]\n", 3);
+        SDL_CloseIO(chrome_trace_file);
+        chrome_trace_file = NULL;
+    }
+    SDL_free(chrome_trace_buffer);
+    chrome_trace_buffer = NULL;
+    SDL_UnlockSpinlock(&chrome_trace_lock);
+}
+
+static const SDL_TraceSink ChromeTraceSink = {
+    "chrome",
+    ChromeTrace_Init,
+    ChromeTrace_BeginZone,
+    ChromeTrace_EndZone,
+    ChromeTrace_Counter,
+    ChromeTrace_ThreadName,
+    ChromeTrace_Quit
+};
+
+/* Other sinks (Tracy, Perfetto, ETW, os_signpost) can be added here, the first one that initializes is used */
+static const SDL_TraceSink *trace_sinks[] = {
+    &ChromeTraceSink,
+    NULL
+};
+
+static const SDL_TraceSink *SDL_trace_sink;
+
+void SDL_InitTrace(void)
+{
+    int i;
+
+    if (SDL_trace_sink) {
+        return;
+    }
+
+    for (i = 0; trace_sinks[i]; ++i) {
+        if (trace_sinks[i]->Init() == 0) {
+            SDL_trace_sink = trace_sinks[i];
+            SDL_TraceThreadName("main");
+            break;
+        }
+    }
+}
+
+void SDL_QuitTrace(void)
+{
+    const SDL_TraceSink *sink = SDL_trace_sink;
+
+    if (sink) {
+        SDL_trace_sink = NULL;
+        sink->Quit();
+    }
+}
+
+void SDL_TraceBeginZone(const char *name)
+{
+    const SDL_TraceSink *sink = SDL_trace_sink;
+
+    if (sink) {
+        sink->BeginZone(name, SDL_GetTicksNS());
+    }
+}
+
+void SDL_TraceEndZone(void)
+{
+    const SDL_TraceSink *sink = SDL_trace_sink;
+
+    if (sink) {
+        sink->EndZone(SDL_GetTicksNS());
+    }
+}
+
+void SDL_TraceCounter(const char *name, Sint64 value)
+{
+    const SDL_TraceSink *sink = SDL_trace_sink;
+
+    if (sink) {
+        sink->Counter(name, value, SDL_GetTicksNS());
+    }
+}
+
+void SDL_TraceThreadName(const char *name)
+{
+    const SDL_TraceSink *sink = SDL_trace_sink;
+
+    if (sink && name) {
+        sink->ThreadName(name);
+    }
+}
+
+#endif /* SDL_TRACING_ENABLED */
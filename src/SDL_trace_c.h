@@ -0,0 +1,69 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Lightweight internal tracing, compiled in with the SDL_TRACING build option.
+
+   Zones nest per thread and must be closed on the thread that opened them.
+   Zone and counter names must be string literals (or otherwise outlive SDL).
+ */
+
+#ifndef SDL_trace_c_h_
+#define SDL_trace_c_h_
+
+#ifdef SDL_TRACING_ENABLED
+
+/* A destination for trace events, e.g. a Chrome trace file or a platform profiler */
+typedef struct SDL_TraceSink
+{
+    const char *name;
+    int (*Init)(void);
+    void (*BeginZone)(const char *name, Uint64 timestampNS);
+    void (*EndZone)(Uint64 timestampNS);
+    void (*Counter)(const char *name, Sint64 value, Uint64 timestampNS);
+    void (*ThreadName)(const char *name);
+    void (*Quit)(void);
+} SDL_TraceSink;
+
+extern void SDL_InitTrace(void);
+extern void SDL_QuitTrace(void);
+extern void SDL_TraceBeginZone(const char *name);
+extern void SDL_TraceEndZone(void);
+extern void SDL_TraceCounter(const char *name, Sint64 value);
+extern void SDL_TraceThreadName(const char *name);
+
+#define SDL_TRACE_BEGIN(name)          SDL_TraceBeginZone(name)
+#define SDL_TRACE_END()                SDL_TraceEndZone()
+#define SDL_TRACE_COUNTER(name, value) SDL_TraceCounter(name, (Sint64)(value))
+#define SDL_TRACE_THREAD_NAME(name)    SDL_TraceThreadName(name)
+
+#else
+
+#define SDL_InitTrace()
+#define SDL_QuitTrace()
+#define SDL_TRACE_BEGIN(name)          do { } while (0)
+#define SDL_TRACE_END()                do { } while (0)
+#define SDL_TRACE_COUNTER(name, value) do { } while (0)
+#define SDL_TRACE_THREAD_NAME(name)    do { } while (0)
+
+#endif /* SDL_TRACING_ENABLED */
+
+#endif /* SDL_trace_c_h_ */
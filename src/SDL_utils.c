@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_hashtable.h"
+#include "thread/SDL_thread_c.h"
 
 #if defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)
 #include <unistd.h>
@@ -121,6 +122,23 @@ Uint32 SDL_GetNextObjectID(void)
 
 static SDL_HashTable *SDL_objects;
 
+#ifdef SDL_THREAD_LOCAL
+/* Each thread remembers the last object of each type that it validated, so
+   repeated calls on the same renderer or texture skip the hash table lookup.
+   The generation is bumped whenever any object goes away, which drops all of
+   the cached entries at once. */
+#define SDL_OBJECT_VALID_CACHE_SIZE (SDL_OBJECT_TYPE_HIDAPI_JOYSTICK + 1)
+
+typedef struct
+{
+    void *object;
+    int generation;
+} SDL_ObjectValidCache;
+
+static SDL_AtomicInt SDL_objects_generation;
+static SDL_THREAD_LOCAL SDL_ObjectValidCache SDL_object_valid_cache[SDL_OBJECT_VALID_CACHE_SIZE];
+#endif
+
 static Uint32 SDL_HashObject(const void *key, void *unused)
 {
     return (Uint32)(uintptr_t)key;
@@ -142,6 +160,9 @@ void SDL_SetObjectValid(void *object, SDL_ObjectType type, SDL_bool valid)
 
         SDL_InsertIntoHashTable(SDL_objects, object, (void *)(uintptr_t)type);
     } else {
+#ifdef SDL_THREAD_LOCAL
+        SDL_AtomicIncRef(&SDL_objects_generation);
+#endif
         if (SDL_objects) {
             SDL_RemoveFromHashTable(SDL_objects, object);
         }
@@ -154,16 +175,40 @@ SDL_bool SDL_ObjectValid(void *object, SDL_ObjectType type)
         return SDL_FALSE;
     }
 
+#ifdef SDL_THREAD_LOCAL
+    const int generation = SDL_AtomicGet(&SDL_objects_generation);
+    SDL_ObjectValidCache *cache = NULL;
+    if ((int)type >= 0 && (int)type < SDL_OBJECT_VALID_CACHE_SIZE) {
+        cache = &SDL_object_valid_cache[type];
+        if (cache->object == object && cache->generation == generation) {
+            return SDL_TRUE;
+        }
+    }
+#endif
+
     const void *object_type;
     if (!SDL_FindInHashTable(SDL_objects, object, &object_type)) {
         return SDL_FALSE;
     }
 
-    return (((SDL_ObjectType)(uintptr_t)object_type) == type);
+    if (((SDL_ObjectType)(uintptr_t)object_type) != type) {
+        return SDL_FALSE;
+    }
+
+#ifdef SDL_THREAD_LOCAL
+    if (cache) {
+        cache->object = object;
+        cache->generation = generation;
+    }
+#endif
+    return SDL_TRUE;
 }
 
 void SDL_SetObjectsInvalid(void)
 {
+#ifdef SDL_THREAD_LOCAL
+    SDL_AtomicIncRef(&SDL_objects_generation);
+#endif
     if (SDL_objects) {
         /* Log any leaked objects */
         const void *object, *object_type;
@@ -51,6 +51,7 @@ typedef enum
     SDL_OBJECT_TYPE_WINDOW,
     SDL_OBJECT_TYPE_RENDERER,
     SDL_OBJECT_TYPE_TEXTURE,
+    SDL_OBJECT_TYPE_RENDER_SHADER,
     SDL_OBJECT_TYPE_JOYSTICK,
     SDL_OBJECT_TYPE_GAMEPAD,
     SDL_OBJECT_TYPE_HAPTIC,
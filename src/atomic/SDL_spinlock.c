@@ -161,17 +161,29 @@ SDL_bool SDL_TryLockSpinlock(SDL_SpinLock *lock)
 #endif
 }
 
+/* The most pause instructions to run between looks at a contended lock
+   before giving up the timeslice instead. */
+#define SDL_SPINLOCK_MAX_BACKOFF 64
+
 void SDL_LockSpinlock(SDL_SpinLock *lock)
 {
-    int iterations = 0;
+    int backoff = 1;
+    int i;
+
     /* FIXME: Should we have an eventual timeout? */
     while (!SDL_TryLockSpinlock(lock)) {
-        if (iterations < 32) {
-            iterations++;
-            SDL_CPUPauseInstruction();
-        } else {
-            /* !!! FIXME: this doesn't definitely give up the current timeslice, it does different things on various platforms. */
-            SDL_Delay(0);
+        /* Only read the lock until it looks free, so waiting threads share the
+           cache line instead of bouncing it between cores with atomic writes. */
+        while (*(volatile SDL_SpinLock *)lock != 0) {
+            if (backoff <= SDL_SPINLOCK_MAX_BACKOFF) {
+                for (i = 0; i < backoff; ++i) {
+                    SDL_CPUPauseInstruction();
+                }
+                backoff *= 2;
+            } else {
+                /* !!! FIXME: this doesn't definitely give up the current timeslice, it does different things on various platforms. */
+                SDL_Delay(0);
+            }
         }
     }
 }
@@ -201,3 +213,47 @@ void SDL_UnlockSpinlock(SDL_SpinLock *lock)
     *lock = 0;
 #endif
 }
+
+/* How many pause instructions a waiter runs, in total, before it sleeps */
+#define SDL_TICKETLOCK_SPIN_COUNT 1000
+
+SDL_bool SDL_TryLockTicketLock(SDL_TicketLock *lock)
+{
+    const int ticket = SDL_AtomicGet(&lock->serving);
+
+    return SDL_AtomicCompareAndSwap(&lock->next, ticket, ticket + 1);
+}
+
+void SDL_LockTicketLock(SDL_TicketLock *lock)
+{
+    const int ticket = SDL_AtomicAdd(&lock->next, 1);
+    int serving;
+    int spins = 0;
+    int i;
+
+    while ((serving = SDL_AtomicGet(&lock->serving)) != ticket) {
+        if (spins < SDL_TICKETLOCK_SPIN_COUNT) {
+            /* Wait longer the more threads are ahead of us */
+            const int ahead = (int)((unsigned int)ticket - (unsigned int)serving);
+            for (i = 0; i < ahead; ++i) {
+                SDL_CPUPauseInstruction();
+            }
+            spins += ahead;
+        } else {
+            /* The unlocking thread checks for parked waiters after it moves
+               the lock on, so either it sees us here or we see the new value. */
+            SDL_AtomicIncRef(&lock->parked);
+            SDL_WaitAtomicIntTimeoutNS(&lock->serving, serving, -1);
+            SDL_AtomicAdd(&lock->parked, -1);
+        }
+    }
+}
+
+void SDL_UnlockTicketLock(SDL_TicketLock *lock)
+{
+    SDL_AtomicAdd(&lock->serving, 1);
+    if (SDL_AtomicGet(&lock->parked) > 0) {
+        /* Every parked thread has a different ticket, so wake them all to find the one whose turn it is */
+        SDL_BroadcastAtomicInt(&lock->serving);
+    }
+}
@@ -215,6 +215,13 @@ void OnAudioStreamDestroy(SDL_AudioStream *stream)
     }
 }
 
+// should hold device->lock before calling. Returns the logical device that owns the device buffer, if any.
+static SDL_LogicalAudioDevice *GetDirectCallbackLogicalDevice(SDL_AudioDevice *device)
+{
+    SDL_LogicalAudioDevice *logdev = device->logical_devices;
+    return (logdev && !logdev->next && logdev->device_callback) ? logdev : NULL;
+}
+
 // device should be locked when calling this.
 static SDL_bool AudioDeviceCanUseSimpleCopy(SDL_AudioDevice *device)
 {
@@ -223,6 +230,7 @@ static SDL_bool AudioDeviceCanUseSimpleCopy(SDL_AudioDevice *device)
         device->logical_devices &&  // there's a logical device
         !device->logical_devices->next &&  // there's only _ONE_ logical device
         !device->logical_devices->postmix && // there isn't a postmix callback
+        !device->logical_devices->device_callback && // the app isn't writing the device buffer itself
         device->logical_devices->bound_streams &&  // there's a bound stream
         !device->logical_devices->bound_streams->next_binding  // there's only _ONE_ bound stream.
     );
@@ -544,6 +552,7 @@ static void DestroyPhysicalAudioDevice(SDL_AudioDevice *device)
 
     SDL_UnlockMutex(device->lock);  // don't use ReleaseAudioDevice because we don't want to change refcounts while destroying.
 
+    SDL_DestroyProperties(device->props);
     SDL_DestroyMutex(device->lock);
     SDL_DestroyCondition(device->close_cond);
     SDL_free(device->work_buffer);
@@ -781,7 +790,7 @@ static void SDL_AudioFreeDeviceHandle_Default(SDL_AudioDevice *device) { /* no-o
 
 static void SDL_AudioThreadInit_Default(SDL_AudioDevice *device)
 {
-    SDL_SetThreadPriority(device->recording ? SDL_THREAD_PRIORITY_HIGH : SDL_THREAD_PRIORITY_TIME_CRITICAL);
+    SDL_SetDeviceThreadPriority(device->recording ? SDL_THREAD_PRIORITY_HIGH : SDL_THREAD_PRIORITY_TIME_CRITICAL);
 }
 
 static void SDL_AudioDetectDevices_Default(SDL_AudioDevice **default_playback, SDL_AudioDevice **default_recording)
@@ -1016,6 +1025,8 @@ int SDL_InitAudio(const char *driver_name)
     return 0;
 }
 
+static void QuitAudioMixThreads(void);
+
 void SDL_QuitAudio(void)
 {
     if (!current_audio.name) {  // not initialized?!
@@ -1060,6 +1071,9 @@ void SDL_QuitAudio(void)
     // Free the driver data
     current_audio.impl.Deinitialize();
 
+    QuitAudioMixThreads();
+    SDL_QuitAudioResampler();
+
     SDL_DestroyRWLock(current_audio.device_hash_lock);
     SDL_DestroyHashTable(device_hash);
 
@@ -1071,13 +1085,281 @@ void SDL_AudioThreadFinalize(SDL_AudioDevice *device)
 {
 }
 
-static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
+static void MixFloat32Audio(float *dst, const float *src, const int buffer_size, float gain)
+{
+    SDL_MixAudioFloat32(dst, src, (int) (buffer_size / sizeof (float)), gain);
+}
+
+
+// When SDL_HINT_AUDIO_MIX_THREADS is set, a logical device with lots of bound streams has them converted
+// by a small pool of worker threads. Each worker mixes the streams it claims into its own buffer, and the
+// device thread adds those partial mixes together once every stream is done, so the device still gets a
+// complete buffer each iteration. The device thread claims streams too, so it's never waiting on idle workers.
+#define AUDIO_MIX_THREADS_MAX 16
+#define AUDIO_MIX_THREADS_MIN_STREAMS 8
+
+typedef struct AudioMixWorker
+{
+    SDL_Thread *thread;
+    float *work_buffer;  // a stream's converted output.
+    float *mix_buffer;   // everything this worker mixed during the current job.
+    Uint32 mixed_job;    // the job that mix_buffer belongs to.
+} AudioMixWorker;
+
+static struct
+{
+    SDL_AtomicInt busy;
+    SDL_Mutex *lock;
+    SDL_Condition *work_available;
+    SDL_Condition *work_done;
+    AudioMixWorker workers[AUDIO_MIX_THREADS_MAX - 1];
+    int num_threads;
+    int buffer_size;
+    SDL_bool quit;
+
+    // The job currently running, protected by the lock.
+    Uint32 job;
+    SDL_AudioStream *next_stream;
+    float gain;
+    int work_buffer_size;
+    int streams_running;
+    SDL_bool failed;
+} audio_mix_threads;
+
+static int GetAudioMixThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_MIX_THREADS);
+    int count = 1;
+
+    if (hint && *hint) {
+        count = SDL_atoi(hint);
+        if (count <= 0) {
+            count = SDL_GetCPUCount();
+        }
+    }
+    return SDL_clamp(count, 1, AUDIO_MIX_THREADS_MAX);
+}
+
+// You must hold audio_mix_threads.lock before calling this! `worker` is NULL for the device thread,
+// which mixes straight into `mix_buffer` using the device's own work buffer.
+static SDL_bool MixNextAudioStream(AudioMixWorker *worker, float *mix_buffer, float *work_buffer)
+{
+    SDL_AudioStream *stream = audio_mix_threads.next_stream;
+    if (!stream) {
+        return SDL_FALSE;
+    }
+
+    audio_mix_threads.next_stream = stream->next_binding;
+    audio_mix_threads.streams_running++;
+
+    const int work_buffer_size = audio_mix_threads.work_buffer_size;
+    const float gain = audio_mix_threads.gain;
+    if (worker) {
+        if (worker->mixed_job != audio_mix_threads.job) {
+            worker->mixed_job = audio_mix_threads.job;
+            SDL_memset(worker->mix_buffer, '\0', work_buffer_size);  // start with silence.
+        }
+        mix_buffer = worker->mix_buffer;
+        work_buffer = worker->work_buffer;
+    }
+
+    SDL_UnlockMutex(audio_mix_threads.lock);
+    float stream_gain;
+    const int br = SDL_GetAudioStreamDataForMixing(stream, work_buffer, work_buffer_size, gain, &stream_gain);
+    if (br > 0) {
+        MixFloat32Audio(mix_buffer, work_buffer, br, stream_gain);
+    }
+    SDL_LockMutex(audio_mix_threads.lock);
+
+    if (br < 0) {
+        audio_mix_threads.failed = SDL_TRUE;
+    }
+    if ((--audio_mix_threads.streams_running == 0) && !audio_mix_threads.next_stream) {
+        SDL_SignalCondition(audio_mix_threads.work_done);
+    }
+    return SDL_TRUE;
+}
+
+static int SDLCALL AudioMixThread(void *data)
+{
+    AudioMixWorker *worker = (AudioMixWorker *) data;
+
+    // we're on the clock for the device buffer, same as the device thread.
+    SDL_SetDeviceThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+
+    SDL_LockMutex(audio_mix_threads.lock);
+    while (!audio_mix_threads.quit) {
+        if (!MixNextAudioStream(worker, NULL, NULL)) {
+            SDL_WaitCondition(audio_mix_threads.work_available, audio_mix_threads.lock);
+        }
+    }
+    SDL_UnlockMutex(audio_mix_threads.lock);
+    return 0;
+}
+
+static void StopAudioMixThreads(void)
+{
+    if (audio_mix_threads.num_threads == 0) {
+        return;
+    }
+
+    SDL_LockMutex(audio_mix_threads.lock);
+    audio_mix_threads.quit = SDL_TRUE;
+    SDL_BroadcastCondition(audio_mix_threads.work_available);
+    SDL_UnlockMutex(audio_mix_threads.lock);
+
+    for (int i = 0; i < audio_mix_threads.num_threads; i++) {
+        SDL_WaitThread(audio_mix_threads.workers[i].thread, NULL);
+        audio_mix_threads.workers[i].thread = NULL;
+    }
+    audio_mix_threads.num_threads = 0;
+    audio_mix_threads.quit = SDL_FALSE;
+}
+
+static void QuitAudioMixThreads(void)
 {
-    if (SDL_MixAudio((Uint8 *) dst, (const Uint8 *) src, SDL_AUDIO_F32, buffer_size, 1.0f) < 0) {
-        SDL_assert(!"This shouldn't happen.");
+    StopAudioMixThreads();
+
+    for (int i = 0; i < SDL_arraysize(audio_mix_threads.workers); i++) {
+        AudioMixWorker *worker = &audio_mix_threads.workers[i];
+        SDL_aligned_free(worker->work_buffer);
+        SDL_aligned_free(worker->mix_buffer);
+        SDL_zerop(worker);
+    }
+    audio_mix_threads.buffer_size = 0;
+
+    if (audio_mix_threads.lock) {
+        SDL_DestroyMutex(audio_mix_threads.lock);
+        audio_mix_threads.lock = NULL;
+    }
+    if (audio_mix_threads.work_available) {
+        SDL_DestroyCondition(audio_mix_threads.work_available);
+        audio_mix_threads.work_available = NULL;
+    }
+    if (audio_mix_threads.work_done) {
+        SDL_DestroyCondition(audio_mix_threads.work_done);
+        audio_mix_threads.work_done = NULL;
     }
 }
 
+// Makes sure there are `count - 1` workers with buffers of at least `buffer_size` bytes. Called by the pool owner while no job is running.
+static SDL_bool StartAudioMixThreads(int count, int buffer_size)
+{
+    if (buffer_size > audio_mix_threads.buffer_size) {
+        for (int i = 0; i < SDL_arraysize(audio_mix_threads.workers); i++) {
+            AudioMixWorker *worker = &audio_mix_threads.workers[i];
+            SDL_aligned_free(worker->work_buffer);
+            SDL_aligned_free(worker->mix_buffer);
+            worker->work_buffer = NULL;
+            worker->mix_buffer = NULL;
+        }
+        audio_mix_threads.buffer_size = buffer_size;
+    }
+
+    if (audio_mix_threads.num_threads != count - 1) {
+        StopAudioMixThreads();
+    }
+
+    if (!audio_mix_threads.lock) {
+        audio_mix_threads.lock = SDL_CreateMutex();
+        audio_mix_threads.work_available = SDL_CreateCondition();
+        audio_mix_threads.work_done = SDL_CreateCondition();
+        if (!audio_mix_threads.lock || !audio_mix_threads.work_available || !audio_mix_threads.work_done) {
+            QuitAudioMixThreads();
+            return SDL_FALSE;
+        }
+    }
+
+    // buffers for workers that are already running were freed above if they're too small, so check them all.
+    for (int i = 0; i < count - 1; i++) {
+        AudioMixWorker *worker = &audio_mix_threads.workers[i];
+        if (!worker->work_buffer) {
+            worker->work_buffer = (float *) SDL_aligned_alloc(SDL_GetSIMDAlignment(), audio_mix_threads.buffer_size);
+            worker->mix_buffer = (float *) SDL_aligned_alloc(SDL_GetSIMDAlignment(), audio_mix_threads.buffer_size);
+            worker->mixed_job = audio_mix_threads.job;
+            if (!worker->work_buffer || !worker->mix_buffer) {
+                StopAudioMixThreads();  // so nobody is using the buffers of the earlier workers.
+                return SDL_FALSE;
+            }
+        }
+    }
+
+    while (audio_mix_threads.num_threads < count - 1) {
+        AudioMixWorker *worker = &audio_mix_threads.workers[audio_mix_threads.num_threads];
+        worker->thread = SDL_CreateThread(AudioMixThread, "SDLAudioMix", worker);
+        if (!worker->thread) {
+            break;
+        }
+        audio_mix_threads.num_threads++;
+    }
+    return (audio_mix_threads.num_threads > 0);
+}
+
+// Mixes every stream bound to `logdev` into `mix_buffer`, spread over the worker pool when that's enabled and worth it.
+// Returns SDL_FALSE if getting data from a stream failed.
+static SDL_bool MixLogicalAudioDevice(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev, float *mix_buffer, int work_buffer_size)
+{
+    int num_streams = 0;
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream && (num_streams < AUDIO_MIX_THREADS_MIN_STREAMS); stream = stream->next_binding) {
+        num_streams++;
+    }
+
+    int count;
+    if ((num_streams >= AUDIO_MIX_THREADS_MIN_STREAMS) && ((count = GetAudioMixThreadCount()) > 1) &&
+        SDL_AtomicCompareAndSwap(&audio_mix_threads.busy, 0, 1)) {
+        SDL_bool retval = SDL_FALSE;
+        SDL_bool ran = SDL_FALSE;
+        if (StartAudioMixThreads(count, device->work_buffer_size)) {
+            SDL_LockMutex(audio_mix_threads.lock);
+            audio_mix_threads.job++;
+            audio_mix_threads.next_stream = logdev->bound_streams;
+            audio_mix_threads.gain = logdev->gain;
+            audio_mix_threads.work_buffer_size = work_buffer_size;
+            audio_mix_threads.failed = SDL_FALSE;
+            SDL_BroadcastCondition(audio_mix_threads.work_available);
+
+            while (MixNextAudioStream(NULL, mix_buffer, (float *) device->work_buffer)) {
+                // Help out until all the streams have been claimed.
+            }
+            while (audio_mix_threads.streams_running > 0) {
+                SDL_WaitCondition(audio_mix_threads.work_done, audio_mix_threads.lock);
+            }
+
+            // everyone is idle again, add up the partial mixes.
+            for (int i = 0; i < audio_mix_threads.num_threads; i++) {
+                const AudioMixWorker *worker = &audio_mix_threads.workers[i];
+                if (worker->mixed_job == audio_mix_threads.job) {
+                    MixFloat32Audio(mix_buffer, worker->mix_buffer, work_buffer_size, 1.0f);
+                }
+            }
+            retval = !audio_mix_threads.failed;
+            ran = SDL_TRUE;
+            SDL_UnlockMutex(audio_mix_threads.lock);
+        }
+        SDL_AtomicSet(&audio_mix_threads.busy, 0);
+
+        if (ran) {
+            return retval;
+        }
+    }
+
+    // Mix on this thread (few streams, threading disabled, or another device is using the pool).
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+        /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
+           for iterating here because the binding linked list can only change while the device lock is held.
+           (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
+           the same stream to different devices at the same time, though.) */
+        float gain;
+        const int br = SDL_GetAudioStreamDataForMixing(stream, device->work_buffer, work_buffer_size, logdev->gain, &gain);
+        if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+            return SDL_FALSE;
+        } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+            MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br, gain);  // the gain is applied while mixing.
+        }
+    }
+    return SDL_TRUE;
+}
+
 
 // Playback device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
@@ -1087,6 +1369,29 @@ void SDL_PlaybackAudioThreadSetup(SDL_AudioDevice *device)
     current_audio.impl.ThreadInit(device);
 }
 
+// should hold device->lock before calling. `frames` is how much audio this iteration handles.
+static void TrackAudioDeviceWake(SDL_AudioDevice *device, Uint64 now, int frames)
+{
+    if (device->last_wake_ns) {
+        const Uint64 interval = now - device->last_wake_ns;
+        const Uint64 expected = device->expected_wake_ns;
+        const Uint64 jitter = (interval > expected) ? (interval - expected) : (expected - interval);
+        device->max_wake_jitter_ns = SDL_max(device->max_wake_jitter_ns, jitter);
+        if (interval > (expected * 2)) {
+            device->late_wakes++;  // the whole previous buffer should have played out before we got here.
+        }
+    }
+    device->last_wake_ns = now;
+    device->expected_wake_ns = (device->spec.freq > 0) ? (((Uint64) frames) * SDL_NS_PER_SECOND) / device->spec.freq : 0;
+}
+
+// should hold device->lock before calling.
+static void TrackAudioDeviceMix(SDL_AudioDevice *device, Uint64 start)
+{
+    device->last_mix_ns = SDL_GetTicksNS() - start;
+    device->max_mix_ns = SDL_max(device->max_mix_ns, device->last_mix_ns);
+}
+
 SDL_bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
 {
     SDL_assert(!device->recording);
@@ -1098,6 +1403,8 @@ SDL_bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         return SDL_FALSE;  // we're done, shut it down.
     }
 
+    SDL_TRACE_BEGIN("SDL_PlaybackAudioThreadIterate");
+
     SDL_bool failed = SDL_FALSE;
     int buffer_size = device->buffer_size;
     Uint8 *device_buffer = device->GetDeviceBuf(device, &buffer_size);
@@ -1109,8 +1416,20 @@ SDL_bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         SDL_assert(buffer_size <= device->buffer_size);  // you can ask for less, but not more.
         SDL_assert(AudioDeviceCanUseSimpleCopy(device) == device->simple_copy);  // make sure this hasn't gotten out of sync.
 
+        const Uint64 mix_start = SDL_GetTicksNS();
+        TrackAudioDeviceWake(device, mix_start, buffer_size / SDL_AUDIO_FRAMESIZE(device->spec));
+
+        SDL_LogicalAudioDevice *direct = GetDirectCallbackLogicalDevice(device);
+
+        // the app wants the device buffer itself? Skip everything else.
+        if (direct) {
+            if (SDL_AtomicGet(&direct->paused)) {
+                SDL_memset(device_buffer, device->silence_value, buffer_size);
+            } else {
+                direct->device_callback(direct->device_callback_userdata, &device->spec, device_buffer, buffer_size);
+            }
         // can we do a basic copy without silencing/mixing the buffer? This is an extremely likely scenario, so we special-case it.
-        if (device->simple_copy) {
+        } else if (device->simple_copy) {
             SDL_LogicalAudioDevice *logdev = device->logical_devices;
             SDL_AudioStream *stream = logdev->bound_streams;
 
@@ -1152,24 +1471,16 @@ SDL_bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                 for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
                     // We should have updated this elsewhere if the format changed!
                     SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, stream->dst_chmap, device->chmap));
+                }
 
-                    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
-                       for iterating here because the binding linked list can only change while the device lock is held.
-                       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
-                       the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamDataAdjustGain(stream, device->work_buffer, work_buffer_size, logdev->gain);
-                    if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
-                        failed = SDL_TRUE;
-                        break;
-                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
-                    }
+                if (!MixLogicalAudioDevice(device, logdev, mix_buffer, work_buffer_size)) {
+                    failed = SDL_TRUE;
                 }
 
                 if (postmix) {
                     SDL_assert(mix_buffer == device->postmix_buffer);
                     postmix(logdev->postmix_userdata, &outspec, mix_buffer, work_buffer_size);
-                    MixFloat32Audio(final_mix_buffer, mix_buffer, work_buffer_size);
+                    MixFloat32Audio(final_mix_buffer, mix_buffer, work_buffer_size, 1.0f);
                 }
             }
 
@@ -1181,6 +1492,8 @@ SDL_bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
             }
         }
 
+        TrackAudioDeviceMix(device, mix_start);
+
         // PlayDevice SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice instead!
         if (device->PlayDevice(device, device_buffer, buffer_size) < 0) {
             failed = SDL_TRUE;
@@ -1193,6 +1506,7 @@ SDL_bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         SDL_AudioDeviceDisconnected(device);  // doh.
     }
 
+    SDL_TRACE_END();
     return SDL_TRUE;  // always go on if not shutting down, even if device failed.
 }
 
@@ -1246,6 +1560,8 @@ SDL_bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         return SDL_FALSE;  // we're done, shut it down.
     }
 
+    SDL_TRACE_BEGIN("SDL_RecordingAudioThreadIterate");
+
     SDL_bool failed = SDL_FALSE;
 
     if (!device->logical_devices) {
@@ -1256,7 +1572,18 @@ SDL_bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         if (br < 0) {  // uhoh, device failed for some reason!
             failed = SDL_TRUE;
         } else if (br > 0) {  // queue the new data to each bound stream.
-            for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+            const Uint64 mix_start = SDL_GetTicksNS();
+            TrackAudioDeviceWake(device, mix_start, br / SDL_AUDIO_FRAMESIZE(device->spec));
+
+            SDL_LogicalAudioDevice *direct = GetDirectCallbackLogicalDevice(device);
+            if (direct) {  // the app wants the data straight from the device, skip the streams.
+                if (!SDL_AtomicGet(&direct->paused)) {
+                    direct->device_callback(direct->device_callback_userdata, &device->spec, device->work_buffer, br);
+                }
+                br = 0;
+            }
+
+            for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev && (br > 0); logdev = logdev->next) {
                 if (SDL_AtomicGet(&logdev->paused)) {
                     continue;  // paused? Skip this logical device.
                 }
@@ -1295,6 +1622,8 @@ SDL_bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
                     }
                 }
             }
+
+            TrackAudioDeviceMix(device, mix_start);
         }
     }
 
@@ -1304,6 +1633,7 @@ SDL_bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         SDL_AudioDeviceDisconnected(device);  // doh.
     }
 
+    SDL_TRACE_END();
     return SDL_TRUE;  // always go on if not shutting down, even if device failed.
 }
 
@@ -1462,6 +1792,48 @@ int SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int *
     return retval;
 }
 
+// should hold device->lock before calling.
+static Uint64 GetAudioDeviceLatencyNS(SDL_AudioDevice *device)
+{
+    if (!device->currently_opened || (device->spec.freq <= 0)) {
+        return 0;
+    }
+    return ((((Uint64) device->sample_frames) * SDL_NS_PER_SECOND) / device->spec.freq) + device->backend_latency_ns;
+}
+
+Uint64 SDL_GetAudioDeviceLatencyNS(SDL_AudioDeviceID devid)
+{
+    Uint64 retval = 0;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        retval = GetAudioDeviceLatencyNS(device);
+    }
+    ReleaseAudioDevice(device);
+    return retval;
+}
+
+SDL_PropertiesID SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid)
+{
+    SDL_PropertiesID retval = 0;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        if (device->props == 0) {
+            device->props = SDL_CreateProperties();
+        }
+        retval = device->props;
+        if (retval) {
+            const Sint64 xruns = device->backend_reports_xruns ? (Sint64) SDL_AtomicGet(&device->xruns) : (Sint64) device->late_wakes;
+            SDL_SetNumberProperty(retval, SDL_PROP_AUDIODEVICE_LATENCY_NS_NUMBER, (Sint64) GetAudioDeviceLatencyNS(device));
+            SDL_SetNumberProperty(retval, SDL_PROP_AUDIODEVICE_XRUNS_NUMBER, xruns);
+            SDL_SetNumberProperty(retval, SDL_PROP_AUDIODEVICE_WAKE_JITTER_NS_NUMBER, (Sint64) device->max_wake_jitter_ns);
+            SDL_SetNumberProperty(retval, SDL_PROP_AUDIODEVICE_MIX_TIME_NS_NUMBER, (Sint64) device->last_mix_ns);
+            SDL_SetNumberProperty(retval, SDL_PROP_AUDIODEVICE_MAX_MIX_TIME_NS_NUMBER, (Sint64) device->max_mix_ns);
+        }
+    }
+    ReleaseAudioDevice(device);
+    return retval;
+}
+
 int *SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count)
 {
     int *retval = NULL;
@@ -1655,6 +2027,17 @@ static int OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
     device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq);
     SDL_UpdatedAudioDeviceFormat(device);  // start this off sane.
 
+    // start the instrumentation over; the backend can fill in what it knows during OpenDevice.
+    device->last_wake_ns = 0;
+    device->expected_wake_ns = 0;
+    device->max_wake_jitter_ns = 0;
+    device->last_mix_ns = 0;
+    device->max_mix_ns = 0;
+    device->late_wakes = 0;
+    SDL_AtomicSet(&device->xruns, 0);
+    device->backend_reports_xruns = SDL_FALSE;
+    device->backend_latency_ns = 0;
+
     device->currently_opened = SDL_TRUE;  // mark this true even if impl.OpenDevice fails, so we know to clean up.
     if (current_audio.impl.OpenDevice(device) < 0) {
         ClosePhysicalAudioDevice(device);  // clean up anything the backend left half-initialized.
@@ -1721,6 +2104,8 @@ SDL_AudioDeviceID SDL_OpenAudioDevice(SDL_AudioDeviceID devid, const SDL_AudioSp
         if (!wants_default && SDL_AtomicGet(&device->zombie)) {
             // uhoh, this device is undead, and just waiting to be cleaned up. Refuse explicit opens.
             SDL_SetError("Device was already lost and can't accept new opens");
+        } else if (GetDirectCallbackLogicalDevice(device)) {
+            SDL_SetError("Device is being used exclusively by another opened device");
         } else if ((logdev = (SDL_LogicalAudioDevice *) SDL_calloc(1, sizeof (SDL_LogicalAudioDevice))) == NULL) {
             /* SDL_calloc already called SDL_OutOfMemory */
         } else if (OpenPhysicalAudioDevice(device, spec) == -1) {  // if this is the first thing using this physical device, open at the OS level if necessary...
@@ -1861,6 +2246,25 @@ int SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallbac
     return retval;
 }
 
+int SDL_SetAudioDeviceCallback(SDL_AudioDeviceID devid, SDL_AudioDeviceCallback callback, void *userdata)
+{
+    SDL_AudioDevice *device = NULL;
+    SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid, &device);
+    int retval = -1;
+    if (logdev) {
+        if (callback && ((device->logical_devices != logdev) || logdev->next)) {
+            SDL_SetError("Device is shared with another opened device");
+        } else {
+            logdev->device_callback = callback;
+            logdev->device_callback_userdata = userdata;
+            UpdateAudioStreamFormatsPhysical(device);
+            retval = 0;
+        }
+    }
+    ReleaseAudioDevice(device);
+    return retval;
+}
+
 int SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream **streams, int num_streams)
 {
     const SDL_bool islogical = !(devid & (1<<1));
@@ -29,6 +29,15 @@
 #define SDL_INT_MAX ((int)(~0u>>1))
 #endif
 
+// Size of the lock-free input ring used by SDL_SetAudioStreamSingleProducer(). Must be a power of two.
+#define AUDIOSTREAM_RING_SIZE (128 * 1024)
+
+// Defaults and limits for the memory pool of a stream's queue, see SDL_PROP_AUDIOSTREAM_QUEUE_*.
+#define AUDIOSTREAM_DEFAULT_CHUNK_SIZE 8192
+#define AUDIOSTREAM_DEFAULT_MAX_FREE_CHUNKS 4
+#define AUDIOSTREAM_MIN_CHUNK_SIZE 256  // comfortably more than the largest sample frame.
+#define AUDIOSTREAM_MAX_CHUNK_SIZE (16 * 1024 * 1024)
+
 #ifdef SDL_SSE3_INTRINSICS
 // Convert from stereo to mono. Average left and right.
 static void SDL_TARGETING("sse3") SDL_ConvertStereoToMono_SSE3(float *dst, const float *src, int num_frames)
@@ -152,11 +161,17 @@ SDL_bool SDL_ChannelMapIsDefault(const int *chmap, int channels)
 // Swizzle audio channels. src and dst can be the same pointer. It does not change the buffer size.
 static void SwizzleAudio(const int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize)
 {
+    // the SIMD path takes care of whole groups of frames for the common layouts, the rest is done here.
+    const int done = ConvertAudioSwizzle(num_frames, dst, src, channels, map, bitsize);
+    if (done == num_frames) {
+        return;
+    }
+
     #define CHANNEL_SWIZZLE(bits) { \
-        Uint##bits *tdst = (Uint##bits *) dst; /* treat as UintX; we only care about moving bits and not the type here. */ \
-        const Uint##bits *tsrc = (const Uint##bits *) src; \
+        Uint##bits *tdst = ((Uint##bits *) dst) + (done * channels); /* treat as UintX; we only care about moving bits and not the type here. */ \
+        const Uint##bits *tsrc = ((const Uint##bits *) src) + (done * channels); \
         if (src != dst) {  /* don't need to copy to a temporary frame first. */ \
-            for (int i = 0; i < num_frames; i++, tsrc += channels, tdst += channels) { \
+            for (int i = done; i < num_frames; i++, tsrc += channels, tdst += channels) { \
                 for (int ch = 0; ch < channels; ch++) { \
                     tdst[ch] = tsrc[map[ch]]; \
                 } \
@@ -165,7 +180,7 @@ static void SwizzleAudio(const int num_frames, void *dst, const void *src, int c
             SDL_bool isstack; \
             Uint##bits *tmp = (Uint##bits *) SDL_small_alloc(int, channels, &isstack); /* !!! FIXME: allocate this when setting the channel map instead. */ \
             if (tmp) { \
-                for (int i = 0; i < num_frames; i++, tsrc += channels, tdst += channels) { \
+                for (int i = done; i < num_frames; i++, tsrc += channels, tdst += channels) { \
                     for (int ch = 0; ch < channels; ch++) { \
                         tmp[ch] = tsrc[map[ch]]; \
                     } \
@@ -412,7 +427,11 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
 
     retval->freq_ratio = 1.0f;
     retval->gain = 1.0f;
-    retval->queue = SDL_CreateAudioQueue(8192);
+    retval->resample_quality = SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM;
+    retval->starved = SDL_TRUE;  // an empty stream that was never fed hasn't underrun.
+    retval->queue_chunk_size = AUDIOSTREAM_DEFAULT_CHUNK_SIZE;
+    retval->queue_max_free = AUDIOSTREAM_DEFAULT_MAX_FREE_CHUNKS;
+    retval->queue = SDL_CreateAudioQueue(retval->queue_chunk_size);
 
     if (!retval->queue) {
         SDL_free(retval);
@@ -436,18 +455,6 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
     return retval;
 }
 
-SDL_PropertiesID SDL_GetAudioStreamProperties(SDL_AudioStream *stream)
-{
-    if (!stream) {
-        SDL_InvalidParamError("stream");
-        return 0;
-    }
-    if (stream->props == 0) {
-        stream->props = SDL_CreateProperties();
-    }
-    return stream->props;
-}
-
 int SDL_SetAudioStreamGetCallback(SDL_AudioStream *stream, SDL_AudioStreamCallback callback, void *userdata)
 {
     if (!stream) {
@@ -514,6 +521,44 @@ int SDL_GetAudioStreamFormat(SDL_AudioStream *stream, SDL_AudioSpec *src_spec, S
     return 0;
 }
 
+// You must hold stream->lock before calling this!
+// Moves everything the producer put in the lock-free ring into the queue, in order.
+static int DrainAudioStreamRing(SDL_AudioStream *stream)
+{
+    if (!stream->ring) {
+        return 0;
+    }
+
+    const Uint32 read_pos = (Uint32) SDL_AtomicGet(&stream->ring_read);
+    const Uint32 write_pos = (Uint32) SDL_AtomicGet(&stream->ring_write);
+    const Uint32 available = write_pos - read_pos;
+
+    if (available == 0) {
+        return 0;
+    }
+
+    SDL_MemoryBarrierAcquire();  // make sure we see the bytes the producer wrote before publishing write_pos.
+
+    // The ring holds whole sample frames, but they might wrap around the end of the buffer.
+    const Uint32 offset = read_pos & (stream->ring_size - 1);
+    const Uint32 first = SDL_min(available, stream->ring_size - offset);
+
+    if (SDL_WriteToAudioQueue(stream->queue, &stream->src_spec, stream->src_chmap, stream->ring + offset, first) != 0) {
+        return -1;
+    }
+
+    if (first < available) {
+        if (SDL_WriteToAudioQueue(stream->queue, &stream->src_spec, stream->src_chmap, stream->ring, available - first) != 0) {
+            SDL_AtomicSet(&stream->ring_read, (int) (read_pos + first));
+            return -1;
+        }
+    }
+
+    SDL_AtomicSet(&stream->ring_read, (int) write_pos);  // hand the space back to the producer.
+    stream->starved = SDL_FALSE;
+    return 0;
+}
+
 int SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
 {
     if (!stream) {
@@ -554,6 +599,12 @@ int SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_s
 
     SDL_LockMutex(stream->lock);
 
+    // data in the ring was put with the old format.
+    if (DrainAudioStreamRing(stream) != 0) {
+        SDL_UnlockMutex(stream->lock);
+        return -1;
+    }
+
     // quietly refuse to change the format of the end currently bound to a device.
     if (stream->bound_device) {
         if (stream->bound_device->physical_device->recording) {
@@ -590,11 +641,14 @@ int SetAudioStreamChannelMap(SDL_AudioStream *stream, const SDL_AudioSpec *spec,
         return SDL_InvalidParamError("stream");
     }
 
-    int retval = 0;
-
     SDL_LockMutex(stream->lock);
 
-    if (channels != spec->channels) {
+    // data in the ring was put with the old channel map.
+    int retval = DrainAudioStreamRing(stream);
+
+    if (retval != 0) {
+        // the ring is still holding data we couldn't queue.
+    } else if (channels != spec->channels) {
         retval = SDL_SetError("Wrong number of channels");
     } else if (!*stream_chmap && !chmap) {
         // already at default, we're good.
@@ -738,6 +792,57 @@ int SDL_SetAudioStreamGain(SDL_AudioStream *stream, float gain)
     return 0;
 }
 
+// You must hold stream->lock before calling this!
+// The quality only changes between calls, so the padding used to decide how much is available always matches the resampling.
+static void UpdateAudioStreamResampleQuality(SDL_AudioStream *stream)
+{
+    Sint64 quality = SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM;
+
+    if (stream->props) {
+        quality = SDL_GetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, quality);
+        if ((quality < SDL_AUDIO_RESAMPLE_QUALITY_LOW) || (quality > SDL_AUDIO_RESAMPLE_QUALITY_HIGH)) {
+            quality = SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM;
+        }
+    }
+
+    stream->resample_quality = (SDL_AudioResampleQuality) quality;
+}
+
+// You must hold stream->lock before calling this!
+// This runs before data is added, so whatever the settings reserve is allocated by the thread putting data.
+static int UpdateAudioStreamQueuePool(SDL_AudioStream *stream)
+{
+    if (!stream->props) {
+        return 0;
+    }
+
+    Sint64 chunk_size = SDL_GetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUE_CHUNK_SIZE_NUMBER, AUDIOSTREAM_DEFAULT_CHUNK_SIZE);
+    Sint64 max_free = SDL_GetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUE_MAX_FREE_CHUNKS_NUMBER, AUDIOSTREAM_DEFAULT_MAX_FREE_CHUNKS);
+    Sint64 reserved = SDL_GetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUE_RESERVED_CHUNKS_NUMBER, 0);
+    const SDL_bool realtime = SDL_GetBooleanProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUE_REALTIME_BOOLEAN, SDL_FALSE);
+
+    chunk_size = SDL_clamp(chunk_size, AUDIOSTREAM_MIN_CHUNK_SIZE, AUDIOSTREAM_MAX_CHUNK_SIZE);
+    max_free = SDL_max(max_free, 0);
+    reserved = SDL_max(reserved, 0);
+
+    // in realtime mode chunks always go back to the pool, so whoever reads from the stream never frees memory.
+    const size_t pool_max_free = realtime ? SIZE_MAX : (size_t) max_free;
+
+    if ((stream->queue_chunk_size == (size_t) chunk_size) && (stream->queue_max_free == pool_max_free) && (stream->queue_reserved == (size_t) reserved)) {
+        return 0;  // nothing changed.
+    }
+
+    const int rc = SDL_SetAudioQueuePool(stream->queue, (size_t) chunk_size, pool_max_free, (size_t) reserved);
+    if (rc < 0) {
+        return -1;
+    } else if (rc == 0) {  // otherwise the chunk size has to wait for the queue to empty out, so try again next time.
+        stream->queue_chunk_size = (size_t) chunk_size;
+        stream->queue_max_free = pool_max_free;
+        stream->queue_reserved = (size_t) reserved;
+    }
+    return 0;
+}
+
 static int CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
 {
     if (stream->src_spec.format == 0) {
@@ -749,6 +854,34 @@ static int CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
     return 0;
 }
 
+// This is called by the single producer without holding stream->lock, so it never waits on the consumer.
+// Returns SDL_FALSE if the data has to go through the locked path instead (no space, callbacks, errors to report).
+static SDL_bool PutAudioStreamRing(SDL_AudioStream *stream, const void *buf, int len)
+{
+    const int frame_size = SDL_AUDIO_FRAMESIZE(stream->src_spec);
+
+    if (stream->put_callback || !frame_size || !stream->dst_spec.format || ((len % frame_size) != 0)) {
+        return SDL_FALSE;
+    }
+
+    const Uint32 write_pos = (Uint32) SDL_AtomicGet(&stream->ring_write);
+    const Uint32 read_pos = (Uint32) SDL_AtomicGet(&stream->ring_read);
+
+    if ((Uint32) len > stream->ring_size - (write_pos - read_pos)) {
+        return SDL_FALSE;
+    }
+
+    const Uint32 offset = write_pos & (stream->ring_size - 1);
+    const Uint32 first = SDL_min((Uint32) len, stream->ring_size - offset);
+
+    SDL_memcpy(stream->ring + offset, buf, first);
+    SDL_memcpy(stream->ring, (const Uint8 *) buf + first, len - first);
+
+    SDL_MemoryBarrierRelease();  // the bytes have to be visible before the new write_pos is.
+    SDL_AtomicSet(&stream->ring_write, (int) (write_pos + len));
+    return SDL_TRUE;
+}
+
 static int PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int len, SDL_ReleaseAudioBufferCallback callback, void* userdata)
 {
 #if DEBUG_AUDIOSTREAM
@@ -767,6 +900,17 @@ static int PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int le
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    if (UpdateAudioStreamQueuePool(stream) != 0) {
+        SDL_UnlockMutex(stream->lock);
+        return -1;
+    }
+
+    // anything waiting in the ring was put first.
+    if (DrainAudioStreamRing(stream) != 0) {
+        SDL_UnlockMutex(stream->lock);
+        return -1;
+    }
+
     SDL_AudioTrack* track = NULL;
 
     if (callback) {
@@ -789,6 +933,7 @@ static int PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int le
     }
 
     if (retval == 0) {
+        stream->starved = SDL_FALSE;  // new data, so running out again counts as another underrun.
         if (stream->put_callback) {
             const int newavail = SDL_GetAudioStreamAvailable(stream) - prev_available;
             stream->put_callback(stream->put_callback_userdata, stream, newavail, newavail);
@@ -817,6 +962,10 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return 0; // nothing to do.
     }
 
+    if (stream->ring && PutAudioStreamRing(stream, buf, len)) {
+        return 0;
+    }
+
     // When copying in large amounts of data, try and do as much work as possible
     // outside of the stream lock, otherwise the output device is likely to be starved.
     const int large_input_thresh = 64 * 1024;
@@ -843,6 +992,77 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
     return PutAudioStreamBuffer(stream, buf, len, NULL, NULL);
 }
 
+static void SDLCALL DontFreeThisAudioBuffer(void *userdata, const void *buf, int len)
+{
+    // We don't own the buffer, but know it will outlive the stream
+}
+
+int SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    } else if (len == 0) {
+        if (callback) {
+            callback(userdata, buf, len);
+        }
+        return 0; // nothing to do.
+    }
+
+    // the queue tells apart copied and borrowed data by whether there's a callback, so always give it one.
+    return PutAudioStreamBuffer(stream, buf, len, callback ? callback : DontFreeThisAudioBuffer, userdata);
+}
+
+int SDL_PutAudioStreamPlanarData(SDL_AudioStream *stream, const void * const *channel_buffers, int num_channels, int num_samples)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!channel_buffers) {
+        return SDL_InvalidParamError("channel_buffers");
+    } else if (num_samples < 0) {
+        return SDL_InvalidParamError("num_samples");
+    }
+
+    SDL_LockMutex(stream->lock);
+    const SDL_AudioSpec spec = stream->src_spec;
+    SDL_UnlockMutex(stream->lock);
+
+    if (!spec.format) {
+        return SDL_SetError("Stream has no source format");
+    } else if (num_channels == -1) {
+        num_channels = spec.channels;
+    } else if (num_channels != spec.channels) {
+        return SDL_SetError("Channel count doesn't match the stream's source format");
+    }
+
+    if (num_samples == 0) {
+        return 0; // nothing to do.
+    }
+
+    const int framesize = SDL_AUDIO_FRAMESIZE(spec);
+    if (num_samples > (SDL_INT_MAX / framesize)) {
+        return SDL_SetError("Too much audio data");
+    }
+
+    // interleave outside of the stream lock, straight into a buffer the stream takes ownership of.
+    const int len = num_samples * framesize;
+    void *data = SDL_malloc(len);
+    if (!data) {
+        return -1;
+    }
+
+    ConvertAudioInterleave(data, channel_buffers, num_channels, num_samples, SDL_AUDIO_BITSIZE(spec.format), SDL_GetSilenceValueForFormat(spec.format));
+
+    const int ret = PutAudioStreamBuffer(stream, data, len, FreeAllocatedAudioBuffer, NULL);
+    if (ret < 0) {
+        SDL_free(data);
+    }
+    return ret;
+}
+
 int SDL_FlushAudioStream(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -850,10 +1070,44 @@ int SDL_FlushAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    const int retval = DrainAudioStreamRing(stream);
     SDL_FlushAudioQueue(stream->queue);
     SDL_UnlockMutex(stream->lock);
 
-    return 0;
+    return retval;
+}
+
+int SDL_SetAudioStreamSingleProducer(SDL_AudioStream *stream, SDL_bool single_producer)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    SDL_LockMutex(stream->lock);
+
+    int retval = DrainAudioStreamRing(stream);
+
+    if (retval == 0) {
+        if (single_producer && !stream->ring) {
+            Uint8 *ring = (Uint8 *) SDL_malloc(AUDIOSTREAM_RING_SIZE);
+            if (!ring) {
+                retval = -1;
+            } else {
+                SDL_AtomicSet(&stream->ring_write, 0);
+                SDL_AtomicSet(&stream->ring_read, 0);
+                stream->ring_size = AUDIOSTREAM_RING_SIZE;
+                stream->ring = ring;
+            }
+        } else if (!single_producer && stream->ring) {
+            SDL_free(stream->ring);
+            stream->ring = NULL;
+            stream->ring_size = 0;
+        }
+    }
+
+    SDL_UnlockMutex(stream->lock);
+
+    return retval;
 }
 
 /* this does not save the previous contents of stream->work_buffer. It's a work buffer!!
@@ -911,7 +1165,7 @@ static Sint64 NextAudioStreamIter(SDL_AudioStream* stream, void** inout_iter,
         // Past the end of the track, the right padding is filled with silence.
         // But we only want to do that if the track is actually finished (flushed).
         if (!flushed) {
-            output_frames -= SDL_GetResamplerPaddingFrames(resample_rate);
+            output_frames -= SDL_GetResamplerPaddingFrames(resample_rate, stream->resample_quality);
         }
 
         output_frames = SDL_GetResamplerOutputFrames(output_frames, resample_rate, &resample_offset);
@@ -1018,7 +1272,7 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     // Infact, input_frames can sometimes even be zero when upsampling.
     const int input_frames = (int) SDL_GetResamplerInputFrames(output_frames, resample_rate, stream->resample_offset);
 
-    const int padding_frames = SDL_GetResamplerPaddingFrames(resample_rate);
+    const int padding_frames = SDL_GetResamplerPaddingFrames(resample_rate, stream->resample_quality);
 
     const SDL_AudioFormat resample_format = SDL_AUDIO_F32;
 
@@ -1091,7 +1345,7 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     SDL_ResampleAudio(resample_channels,
                   (const float *) input_buffer, input_frames,
                   (float*) resample_buffer, output_frames,
-                  resample_rate, &stream->resample_offset);
+                  resample_rate, &stream->resample_offset, stream->resample_quality);
 
     // Convert to the final format, if necessary (src channel map is NULL because SDL_ReadFromAudioQueue already handled this).
     ConvertAudio(output_frames, resample_buffer, resample_format, resample_channels, NULL, buf, dst_format, dst_channels, dst_map, work_buffer, postresample_gain);
@@ -1100,7 +1354,9 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
 }
 
 // get converted/resampled data from the stream
-int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain)
+// if `out_gain` isn't NULL, the data is left at full volume and the gain that should have been applied is
+// reported there instead, so the caller can fold it into whatever it does with the data next (like mixing it).
+static int GetAudioStreamDataWithGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain, float *out_gain)
 {
     Uint8 *buf = (Uint8 *) voidbuf;
 
@@ -1125,7 +1381,19 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         return -1;
     }
 
-    const float gain = stream->gain * extra_gain;
+    if (DrainAudioStreamRing(stream) != 0) {
+        SDL_UnlockMutex(stream->lock);
+        return -1;
+    }
+
+    UpdateAudioStreamResampleQuality(stream);
+
+    float gain = stream->gain * extra_gain;
+    if (out_gain) {
+        *out_gain = gain;
+        gain = 1.0f;
+    }
+
     const int dst_frame_size = SDL_AUDIO_FRAMESIZE(stream->dst_spec);
 
     len -= len % dst_frame_size;  // chop off any fractional sample frame.
@@ -1150,6 +1418,12 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         total_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         additional_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
+
+        // the callback might have been the producer.
+        if (DrainAudioStreamRing(stream) != 0) {
+            SDL_UnlockMutex(stream->lock);
+            return -1;
+        }
     }
 
     // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
@@ -1195,6 +1469,15 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         total += output_frames * dst_frame_size;
     }
 
+    // count each time the stream runs dry, not every short read until more data arrives.
+    if (total >= 0) {
+        const SDL_bool starved = (total < len);
+        if (starved && !stream->starved) {
+            stream->underruns++;
+        }
+        stream->starved = starved;
+    }
+
     SDL_UnlockMutex(stream->lock);
 
 #if DEBUG_AUDIOSTREAM
@@ -1204,6 +1487,17 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
     return total;
 }
 
+int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain)
+{
+    return GetAudioStreamDataWithGain(stream, voidbuf, len, extra_gain, NULL);
+}
+
+int SDL_GetAudioStreamDataForMixing(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain, float *out_gain)
+{
+    *out_gain = 0.0f;
+    return GetAudioStreamDataWithGain(stream, voidbuf, len, extra_gain, out_gain);
+}
+
 int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
 {
     return SDL_GetAudioStreamDataAdjustGain(stream, voidbuf, len, 1.0f);
@@ -1223,6 +1517,9 @@ int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
         return 0;
     }
 
+    DrainAudioStreamRing(stream);
+    UpdateAudioStreamResampleQuality(stream);
+
     Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
 
     // convert from sample frames to bytes in destination format.
@@ -1243,6 +1540,8 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    DrainAudioStreamRing(stream);
+
     size_t total = SDL_GetAudioQueueQueued(stream->queue);
 
     SDL_UnlockMutex(stream->lock);
@@ -1251,6 +1550,44 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
     return (int) SDL_min(total, SDL_INT_MAX);
 }
 
+SDL_PropertiesID SDL_GetAudioStreamProperties(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return 0;
+    }
+    if (stream->props == 0) {
+        stream->props = SDL_CreateProperties();
+        if (stream->props == 0) {
+            return 0;
+        }
+    }
+
+    SDL_LockMutex(stream->lock);
+    const SDL_AudioDeviceID devid = stream->bound_device ? stream->bound_device->instance_id : 0;
+    Sint64 queued_frames = 0;
+    Uint64 latency_ns = 0;
+    if (stream->src_spec.format && stream->dst_spec.format) {
+        DrainAudioStreamRing(stream);
+        UpdateAudioStreamResampleQuality(stream);
+        queued_frames = GetAudioStreamAvailableFrames(stream, NULL);
+        latency_ns = (((Uint64) queued_frames) * SDL_NS_PER_SECOND) / stream->dst_spec.freq;
+    }
+    const Uint64 underruns = stream->underruns;
+    SDL_UnlockMutex(stream->lock);
+
+    // the device lock is taken before stream locks, so this has to wait until we let go of the stream.
+    if (devid) {
+        latency_ns += SDL_GetAudioDeviceLatencyNS(devid);
+    }
+
+    SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUED_FRAMES_NUMBER, queued_frames);
+    SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_LATENCY_NS_NUMBER, (Sint64) latency_ns);
+    SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_UNDERRUNS_NUMBER, (Sint64) underruns);
+
+    return stream->props;
+}
+
 int SDL_ClearAudioStream(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -1259,6 +1596,9 @@ int SDL_ClearAudioStream(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    if (stream->ring) {
+        SDL_AtomicSet(&stream->ring_read, SDL_AtomicGet(&stream->ring_write));  // drop whatever the producer put so far.
+    }
     SDL_ClearAudioQueue(stream->queue);
     SDL_zero(stream->input_spec);
     stream->input_chmap = NULL;
@@ -1274,8 +1614,6 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
         return;
     }
 
-    SDL_DestroyProperties(stream->props);
-
     OnAudioStreamDestroy(stream);
 
     const SDL_bool simplified = stream->simplified;
@@ -1288,18 +1626,17 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
         SDL_UnbindAudioStream(stream);
     }
 
+    // property cleanups may free what the callbacks use, so only do this once no device can call them.
+    SDL_DestroyProperties(stream->props);
+
     SDL_aligned_free(stream->work_buffer);
+    SDL_free(stream->ring);
     SDL_DestroyAudioQueue(stream->queue);
     SDL_DestroyMutex(stream->lock);
 
     SDL_free(stream);
 }
 
-static void SDLCALL DontFreeThisAudioBuffer(void *userdata, const void *buf, int len)
-{
-    // We don't own the buffer, but know it will outlive the stream
-}
-
 int SDL_ConvertAudioSamples(const SDL_AudioSpec *src_spec, const Uint8 *src_data, int src_len,
                             const SDL_AudioSpec *dst_spec, Uint8 **dst_data, int *dst_len)
 {
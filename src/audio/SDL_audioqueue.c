@@ -22,6 +22,7 @@
 
 #include "SDL_audioqueue.h"
 #include "SDL_sysaudio.h"
+#include "../SDL_memorystats_c.h"
 
 typedef struct SDL_MemoryPool SDL_MemoryPool;
 
@@ -67,7 +68,19 @@ struct SDL_AudioQueue
 // Allocate a new block, avoiding checking for ones already in the pool
 static void *AllocNewMemoryPoolBlock(const SDL_MemoryPool *pool)
 {
-    return SDL_malloc(pool->block_size);
+    void *block = SDL_malloc(pool->block_size);
+
+    if (block) {
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_AUDIO_QUEUES, (Sint64)pool->block_size, 0, 0);
+    }
+    return block;
+}
+
+// Really free a block, instead of returning it to the pool
+static void FreeMemoryPoolBlockMemory(const SDL_MemoryPool *pool, void *block)
+{
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_AUDIO_QUEUES, -(Sint64)pool->block_size, 0, 0);
+    SDL_free(block);
 }
 
 // Allocate a new block, first checking if there are any in the pool
@@ -91,7 +104,7 @@ static void FreeMemoryPoolBlock(SDL_MemoryPool *pool, void *block)
         pool->free_blocks = block;
         ++pool->num_free;
     } else {
-        SDL_free(block);
+        FreeMemoryPoolBlockMemory(pool, block);
     }
 }
 
@@ -104,7 +117,7 @@ static void DestroyMemoryPool(SDL_MemoryPool *pool)
 
     while (block) {
         void *next = *(void **)block;
-        SDL_free(block);
+        FreeMemoryPoolBlockMemory(pool, block);
         block = next;
     }
 }
@@ -138,6 +151,17 @@ static int ReserveMemoryPoolBlocks(SDL_MemoryPool *pool, size_t num_blocks)
     return 0;
 }
 
+// Frees blocks until the pool holds no more than max_free
+static void TrimMemoryPool(SDL_MemoryPool *pool)
+{
+    while (pool->num_free > pool->max_free) {
+        void *block = pool->free_blocks;
+        pool->free_blocks = *(void **)block;
+        --pool->num_free;
+        FreeMemoryPoolBlockMemory(pool, block);
+    }
+}
+
 void SDL_DestroyAudioQueue(SDL_AudioQueue *queue)
 {
     SDL_ClearAudioQueue(queue);
@@ -146,6 +170,7 @@ void SDL_DestroyAudioQueue(SDL_AudioQueue *queue)
     DestroyMemoryPool(&queue->chunk_pool);
     SDL_aligned_free(queue->history_buffer);
 
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_AUDIO_QUEUES, -(Sint64)(sizeof(*queue) + queue->history_capacity), 0, -1);
     SDL_free(queue);
 }
 
@@ -156,6 +181,7 @@ SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size)
     if (!queue) {
         return NULL;
     }
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_AUDIO_QUEUES, sizeof(*queue), 0, 1);
 
     InitMemoryPool(&queue->track_pool, sizeof(SDL_AudioTrack), 8);
     InitMemoryPool(&queue->chunk_pool, chunk_size, 4);
@@ -168,6 +194,43 @@ SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size)
     return queue;
 }
 
+int SDL_SetAudioQueuePool(SDL_AudioQueue *queue, size_t chunk_size, size_t max_free, size_t num_reserved)
+{
+    int retval = 0;
+
+    // Reserved blocks would be freed again as soon as they come back otherwise.
+    if (max_free < num_reserved) {
+        max_free = num_reserved;
+    }
+
+    if (chunk_size != queue->chunk_pool.block_size) {
+        if (queue->head) {
+            // Chunks of the old size are still in use, and would end up in the new pool.
+            retval = 1;
+        } else {
+            DestroyMemoryPool(&queue->chunk_pool);
+            InitMemoryPool(&queue->chunk_pool, chunk_size, max_free);
+        }
+    }
+
+    // Every chunk lives in its own track, so keep as many of those around.
+    queue->chunk_pool.max_free = max_free;
+    queue->track_pool.max_free = SDL_max(max_free, 8);
+    TrimMemoryPool(&queue->chunk_pool);
+    TrimMemoryPool(&queue->track_pool);
+
+    if (queue->chunk_pool.num_free < num_reserved &&
+        ReserveMemoryPoolBlocks(&queue->chunk_pool, num_reserved - queue->chunk_pool.num_free) != 0) {
+        return -1;
+    }
+    if (queue->track_pool.num_free < num_reserved &&
+        ReserveMemoryPoolBlocks(&queue->track_pool, num_reserved - queue->track_pool.num_free) != 0) {
+        return -1;
+    }
+
+    return retval;
+}
+
 static void DestroyAudioTrack(SDL_AudioQueue *queue, SDL_AudioTrack *track)
 {
     track->callback(track->userdata, track->data, (int)track->capacity);
@@ -641,6 +704,7 @@ int SDL_ResetAudioQueueHistory(SDL_AudioQueue *queue, int num_frames)
             return -1;
         }
         SDL_aligned_free(queue->history_buffer);
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_AUDIO_QUEUES, (Sint64)length - (Sint64)queue->history_capacity, 0, 0);
         queue->history_buffer = history_buffer;
         queue->history_capacity = length;
     }
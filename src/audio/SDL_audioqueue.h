@@ -25,7 +25,8 @@
 
 // Internal functions used by SDL_AudioStream for queueing audio.
 
-typedef void(SDLCALL *SDL_ReleaseAudioBufferCallback)(void *userdata, const void *buffer, int buflen);
+// Same signature as the public SDL_AudioStreamDataCompleteCallback, so app callbacks can be used directly.
+typedef SDL_AudioStreamDataCompleteCallback SDL_ReleaseAudioBufferCallback;
 
 typedef struct SDL_AudioQueue SDL_AudioQueue;
 typedef struct SDL_AudioTrack SDL_AudioTrack;
@@ -36,6 +37,10 @@ SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size);
 // Destroy an audio queue
 void SDL_DestroyAudioQueue(SDL_AudioQueue *queue);
 
+// Change the chunk size, the most chunks kept around for reuse, and how many to allocate up front
+// Returns 1 if the chunk size can't change until the queue is empty, everything else still applies.
+int SDL_SetAudioQueuePool(SDL_AudioQueue *queue, size_t chunk_size, size_t max_free, size_t num_reserved);
+
 // Completely clear the queue
 void SDL_ClearAudioQueue(SDL_AudioQueue *queue);
 
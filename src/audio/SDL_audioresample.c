@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 #include "SDL_audioresample.h"
 
@@ -48,6 +49,27 @@
 #define RESAMPLER_FILTER_INTERP_BITS        (32 - RESAMPLER_BITS_PER_ZERO_CROSSING)
 #define RESAMPLER_FILTER_INTERP_RANGE       (1 << RESAMPLER_FILTER_INTERP_BITS)
 
+// SDL_AUDIO_RESAMPLE_QUALITY_HIGH uses a longer polyphase filter instead: a bank of precomputed filters, one per
+// fraction of a frame ("phase"). Arbitrary ratios interpolate between the two nearest of RESAMPLER_HQ_PHASES phases.
+// Ratios that repeat with a short period (44.1kHz <-> 48kHz) get a bank with exactly one phase per output position.
+#define RESAMPLER_HQ_ZERO_CROSSINGS    16
+#define RESAMPLER_HQ_SAMPLES_PER_FRAME (RESAMPLER_HQ_ZERO_CROSSINGS * 2)
+#define RESAMPLER_HQ_PADDING_FRAMES    (RESAMPLER_HQ_ZERO_CROSSINGS + 1)
+#define RESAMPLER_HQ_PHASES            256
+#define RESAMPLER_HQ_CUTOFF            0.95f
+
+// When downsampling, the cutoff has to move down with the output's Nyquist frequency to avoid aliasing.
+// Rather than a bank per ratio, the ratio is rounded down to one of this many steps.
+#define RESAMPLER_HQ_CUTOFF_STEPS      32
+
+// Whole-number downsampling ratios (48kHz -> 16kHz, etc) always land on the same phase, so they skip the phase
+// lookup entirely. With SDL_AUDIO_RESAMPLE_QUALITY_HIGH that's a single filter with the cutoff at the output's
+// Nyquist frequency; the medium quality filter is the identity at phase 0, so it becomes a strided copy.
+#define RESAMPLER_MAX_DECIMATION       6
+
+// Linear interpolation only looks at the frames on either side.
+#define RESAMPLER_LINEAR_PADDING_FRAMES 1
+
 // ResampleFrame is just a vector/matrix/matrix multiplication.
 // It performs cubic interpolation of the filter, then multiplies that with the input.
 // dst = [1, frac, frac^2, frac^3] * filter * src
@@ -516,6 +538,270 @@ static void GenerateResamplerFilter(void)
 typedef void (*ResampleFrameFunc)(const float *src, float *dst, const Cubic *filter, float frac, int chans);
 static ResampleFrameFunc ResampleFrame[8];
 
+typedef struct ResamplerBank
+{
+    float *filters;  // (num_phases + 1) filters of RESAMPLER_HQ_SAMPLES_PER_FRAME taps, the last one being a whole frame along.
+    int num_phases;
+    SDL_bool interpolate;
+} ResamplerBank;
+
+// The first RESAMPLER_HQ_CUTOFF_STEPS banks are for arbitrary ratios, by cutoff. The next two are 44.1kHz->48kHz and 48kHz->44.1kHz.
+// The rest are for whole-number downsampling ratios, starting at 2:1.
+#define RESAMPLER_HQ_BANK_44100_TO_48000 RESAMPLER_HQ_CUTOFF_STEPS
+#define RESAMPLER_HQ_BANK_48000_TO_44100 (RESAMPLER_HQ_CUTOFF_STEPS + 1)
+#define RESAMPLER_HQ_BANK_DECIMATE(ratio) (RESAMPLER_HQ_CUTOFF_STEPS + (ratio))
+static ResamplerBank ResamplerBanks[RESAMPLER_HQ_CUTOFF_STEPS + RESAMPLER_MAX_DECIMATION + 1];
+static SDL_SpinLock ResamplerBanksLock;
+
+static int BuildResamplerBank(ResamplerBank *bank, int num_phases, float cutoff, SDL_bool interpolate)
+{
+    // if dB > 50, beta=(0.1102 * (dB - 8.7)), according to Matlab.
+    const float dB = 100.0f;
+    const float beta = 0.1102f * (dB - 8.7f);
+    const float bessel_beta = BesselI0(beta);
+    const size_t size = (size_t)(num_phases + 1) * RESAMPLER_HQ_SAMPLES_PER_FRAME * sizeof(float);
+    float *filters = (float *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
+    int phase, i;
+
+    if (!filters) {
+        return -1;
+    }
+
+    for (phase = 0; phase <= num_phases; ++phase) {
+        float *filter = &filters[phase * RESAMPLER_HQ_SAMPLES_PER_FRAME];
+        const double frac = (double)phase / num_phases;
+        double sum = 0.0;
+
+        // Tap i is multiplied with the frame at `srcindex + i - (RESAMPLER_HQ_ZERO_CROSSINGS - 1)`,
+        // and the output is `frac` of the way from `srcindex` to `srcindex + 1`.
+        for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; ++i) {
+            const double x = (double)(i - (RESAMPLER_HQ_ZERO_CROSSINGS - 1)) - frac;
+            const double w = x / RESAMPLER_HQ_ZERO_CROSSINGS;
+            double tap = 0.0;
+            if (w > -1.0 && w < 1.0) {
+                const double y = SDL_PI_D * cutoff * x;
+                const double sinc = (y == 0.0) ? 1.0 : (SDL_sin(y) / y);
+                // https://en.wikipedia.org/wiki/Kaiser_window
+                tap = cutoff * sinc * (BesselI0(beta * (float)SDL_sqrt(1.0 - (w * w))) / bessel_beta);
+            }
+            filter[i] = (float)tap;
+            sum += tap;
+        }
+
+        // Normalize each phase, so a constant signal comes out unchanged whatever the phase.
+        for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; ++i) {
+            filter[i] = (float)(filter[i] / sum);
+        }
+    }
+
+    bank->num_phases = num_phases;
+    bank->interpolate = interpolate;
+    SDL_MemoryBarrierRelease();
+    bank->filters = filters;
+    return 0;
+}
+
+static const ResamplerBank *GetResamplerBankByIndex(int index, int num_phases, float cutoff, SDL_bool interpolate)
+{
+    ResamplerBank *bank = &ResamplerBanks[index];
+
+    if (!bank->filters) {
+        SDL_LockSpinlock(&ResamplerBanksLock);
+        if (!bank->filters) {
+            BuildResamplerBank(bank, num_phases, cutoff, interpolate);
+        }
+        SDL_UnlockSpinlock(&ResamplerBanksLock);
+
+        if (!bank->filters) {
+            return NULL;
+        }
+    }
+
+    SDL_MemoryBarrierAcquire();
+    return bank;
+}
+
+// Returns the downsampling ratio if resample_rate is a whole number we have a decimation filter for, otherwise 0.
+static int GetDecimationRatio(Sint64 resample_rate)
+{
+    if ((resample_rate & 0xFFFFFFFF) != 0) {
+        return 0;
+    }
+
+    const Sint64 ratio = resample_rate >> 32;
+    if ((ratio < 2) || (ratio > RESAMPLER_MAX_DECIMATION)) {
+        return 0;
+    }
+    return (int)ratio;
+}
+
+static const ResamplerBank *GetResamplerBank(Sint64 resample_rate)
+{
+    int index, num_phases;
+    float cutoff = RESAMPLER_HQ_CUTOFF;
+    SDL_bool interpolate = SDL_FALSE;
+
+    if (resample_rate == SDL_GetResampleRate(44100, 48000)) {
+        // 147 input frames for every 160 output frames, so there are only 160 different phases.
+        index = RESAMPLER_HQ_BANK_44100_TO_48000;
+        num_phases = 160;
+    } else if (resample_rate == SDL_GetResampleRate(48000, 44100)) {
+        // 160 input frames for every 147 output frames, so there are only 147 different phases.
+        index = RESAMPLER_HQ_BANK_48000_TO_44100;
+        num_phases = 147;
+        cutoff *= 147.0f / 160.0f;
+    } else {
+        // (output rate / input rate) * RESAMPLER_HQ_CUTOFF_STEPS, rounded down.
+        Sint64 step = ((Sint64)RESAMPLER_HQ_CUTOFF_STEPS << 32) / resample_rate;
+        step = SDL_clamp(step, 1, RESAMPLER_HQ_CUTOFF_STEPS);
+        index = (int)step - 1;
+        num_phases = RESAMPLER_HQ_PHASES;
+        cutoff *= (float)step / RESAMPLER_HQ_CUTOFF_STEPS;
+        interpolate = SDL_TRUE;
+    }
+
+    return GetResamplerBankByIndex(index, num_phases, cutoff, interpolate);
+}
+
+static const ResamplerBank *GetDecimationBank(int ratio)
+{
+    // Only phase 0 is ever used, see ResampleAudio_Decimate.
+    return GetResamplerBankByIndex(RESAMPLER_HQ_BANK_DECIMATE(ratio), 1, RESAMPLER_HQ_CUTOFF / (float)ratio, SDL_FALSE);
+}
+
+typedef void (*ResampleFrameHQFunc)(const float *src, float *dst, const float *filter, int chans);
+static ResampleFrameHQFunc ResampleFrameHQ[8];
+
+static void ResampleFrameHQ_Generic(const float *src, float *dst, const float *filter, int chans)
+{
+    int i, chan;
+
+    for (chan = 0; chan < chans; ++chan) {
+        float out = 0.0f;
+
+        for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; ++i) {
+            out += src[i * chans + chan] * filter[i];
+        }
+
+        dst[chan] = out;
+    }
+}
+
+static void ResampleFrameHQ_Mono(const float *src, float *dst, const float *filter, int chans)
+{
+    int i;
+    float out0 = 0.0f;
+    float out1 = 0.0f;
+
+    for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; i += 2) {
+        out0 += src[i] * filter[i];
+        out1 += src[i + 1] * filter[i + 1];
+    }
+
+    dst[0] = out0 + out1;
+}
+
+static void ResampleFrameHQ_Stereo(const float *src, float *dst, const float *filter, int chans)
+{
+    int i;
+    float out0 = 0.0f;
+    float out1 = 0.0f;
+
+    for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; ++i) {
+        out0 += src[i * 2 + 0] * filter[i];
+        out1 += src[i * 2 + 1] * filter[i];
+    }
+
+    dst[0] = out0;
+    dst[1] = out1;
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+#if RESAMPLER_HQ_SAMPLES_PER_FRAME != 32
+#error Invalid samples per frame
+#endif
+
+static void SDL_TARGETING("avx2") ResampleFrameHQ_Mono_AVX2(const float *src, float *dst, const float *filter, int chans)
+{
+    __m256 out0 = _mm256_mul_ps(_mm256_loadu_ps(src + 0), _mm256_loadu_ps(filter + 0));
+    __m256 out1 = _mm256_mul_ps(_mm256_loadu_ps(src + 8), _mm256_loadu_ps(filter + 8));
+    out0 = _mm256_add_ps(out0, _mm256_mul_ps(_mm256_loadu_ps(src + 16), _mm256_loadu_ps(filter + 16)));
+    out1 = _mm256_add_ps(out1, _mm256_mul_ps(_mm256_loadu_ps(src + 24), _mm256_loadu_ps(filter + 24)));
+
+    // Horizontal sum
+    __m128 out = _mm_add_ps(_mm256_castps256_ps128(out0), _mm256_extractf128_ps(out0, 1));
+    out = _mm_add_ps(out, _mm_add_ps(_mm256_castps256_ps128(out1), _mm256_extractf128_ps(out1, 1)));
+    out = _mm_add_ps(out, _mm_movehl_ps(out, out));
+    out = _mm_add_ss(out, _mm_shuffle_ps(out, out, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    _mm_store_ss(dst, out);
+}
+
+static void SDL_TARGETING("avx2") ResampleFrameHQ_Stereo_AVX2(const float *src, float *dst, const float *filter, int chans)
+{
+    __m256 out0 = _mm256_setzero_ps();
+    __m256 out1 = _mm256_setzero_ps();
+    int i;
+
+    for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; i += 8) {
+        // Duplicate each of the taps, to match the interleaved input: [0 0 1 1 2 2 3 3] and [4 4 5 5 6 6 7 7]
+        const __m256 taps = _mm256_loadu_ps(filter + i);
+        const __m256 lo = _mm256_unpacklo_ps(taps, taps);
+        const __m256 hi = _mm256_unpackhi_ps(taps, taps);
+        out0 = _mm256_add_ps(out0, _mm256_mul_ps(_mm256_loadu_ps(src + i * 2 + 0), _mm256_permute2f128_ps(lo, hi, 0x20)));
+        out1 = _mm256_add_ps(out1, _mm256_mul_ps(_mm256_loadu_ps(src + i * 2 + 8), _mm256_permute2f128_ps(lo, hi, 0x31)));
+    }
+
+    // Add the accumulators and the 128-bit halves together, then the lower and upper pairs
+    out0 = _mm256_add_ps(out0, out1);
+    __m128 out = _mm_add_ps(_mm256_castps256_ps128(out0), _mm256_extractf128_ps(out0, 1));
+    out = _mm_add_ps(out, _mm_movehl_ps(out, out));
+
+    _mm_storel_pi((__m64 *)dst, out);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void ResampleFrameHQ_Mono_NEON(const float *src, float *dst, const float *filter, int chans)
+{
+    float32x4_t out0 = vdupq_n_f32(0);
+    float32x4_t out1 = vdupq_n_f32(0);
+    int i;
+
+    for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; i += 8) {
+        out0 = vmlaq_f32(out0, vld1q_f32(src + i), vld1q_f32(filter + i));
+        out1 = vmlaq_f32(out1, vld1q_f32(src + i + 4), vld1q_f32(filter + i + 4));
+    }
+
+    // Horizontal sum
+    out0 = vaddq_f32(out0, out1);
+    float32x2_t sum = vadd_f32(vget_low_f32(out0), vget_high_f32(out0));
+    sum = vpadd_f32(sum, sum);
+
+    vst1_lane_f32(dst, sum, 0);
+}
+
+static void ResampleFrameHQ_Stereo_NEON(const float *src, float *dst, const float *filter, int chans)
+{
+    float32x4_t left = vdupq_n_f32(0);
+    float32x4_t right = vdupq_n_f32(0);
+    int i;
+
+    for (i = 0; i < RESAMPLER_HQ_SAMPLES_PER_FRAME; i += 4) {
+        // vld2q deinterleaves the channels, so each can be multiplied with the taps as they are.
+        const float32x4x2_t in = vld2q_f32(src + i * 2);
+        const float32x4_t taps = vld1q_f32(filter + i);
+        left = vmlaq_f32(left, in.val[0], taps);
+        right = vmlaq_f32(right, in.val[1], taps);
+    }
+
+    // Horizontal sums, leaving [left, right]
+    float32x2_t out = vpadd_f32(vadd_f32(vget_low_f32(left), vget_high_f32(left)), vadd_f32(vget_low_f32(right), vget_high_f32(right)));
+
+    vst1_f32(dst, out);
+}
+#endif
+
 // Transpose 4x4 floats
 static void Transpose4x4(Cubic *data)
 {
@@ -562,6 +848,27 @@ static void SetupAudioResampler(void)
         ResampleFrame[1] = ResampleFrame_Stereo;
     }
 
+    for (i = 0; i < 8; ++i) {
+        ResampleFrameHQ[i] = ResampleFrameHQ_Generic;
+    }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        ResampleFrameHQ[0] = ResampleFrameHQ_Mono_AVX2;
+        ResampleFrameHQ[1] = ResampleFrameHQ_Stereo_AVX2;
+    } else
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        ResampleFrameHQ[0] = ResampleFrameHQ_Mono_NEON;
+        ResampleFrameHQ[1] = ResampleFrameHQ_Stereo_NEON;
+    } else
+#endif
+    {
+        ResampleFrameHQ[0] = ResampleFrameHQ_Mono;
+        ResampleFrameHQ[1] = ResampleFrameHQ_Stereo;
+    }
+
     if (transpose) {
         // Transpose each set of 4 coefficients, to reduce work when resampling
         for (i = 0; i < RESAMPLER_SAMPLES_PER_ZERO_CROSSING; ++i) {
@@ -575,18 +882,31 @@ static void SetupAudioResampler(void)
 void SDL_SetupAudioResampler(void)
 {
     static SDL_SpinLock running = 0;
+    static SDL_AtomicInt resampler_generation;
+    const int generation = (int)SDL_GetCPUDispatchGeneration();
 
-    if (!ResampleFrame[0]) {
+    if (SDL_AtomicGet(&resampler_generation) != generation) {
         SDL_LockSpinlock(&running);
 
-        if (!ResampleFrame[0]) {
+        if (SDL_AtomicGet(&resampler_generation) != generation) {
             SetupAudioResampler();
+            SDL_AtomicSet(&resampler_generation, generation);
         }
 
         SDL_UnlockSpinlock(&running);
     }
 }
 
+void SDL_QuitAudioResampler(void)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(ResamplerBanks); ++i) {
+        SDL_aligned_free(ResamplerBanks[i].filters);
+        SDL_zero(ResamplerBanks[i]);
+    }
+}
+
 Sint64 SDL_GetResampleRate(int src_rate, int dst_rate)
 {
     SDL_assert(src_rate > 0);
@@ -601,15 +921,27 @@ Sint64 SDL_GetResampleRate(int src_rate, int dst_rate)
 int SDL_GetResamplerHistoryFrames(void)
 {
     // Even if we aren't currently resampling, make sure to keep enough history in case we need to later.
+    // This covers every quality, since a stream's quality can change at any time.
 
-    return RESAMPLER_MAX_PADDING_FRAMES;
+    return RESAMPLER_HQ_PADDING_FRAMES;
 }
 
-int SDL_GetResamplerPaddingFrames(Sint64 resample_rate)
+int SDL_GetResamplerPaddingFrames(Sint64 resample_rate, SDL_AudioResampleQuality quality)
 {
     // This must always be <= SDL_GetResamplerHistoryFrames()
 
-    return resample_rate ? RESAMPLER_MAX_PADDING_FRAMES : 0;
+    if (!resample_rate) {
+        return 0;
+    }
+
+    switch (quality) {
+    case SDL_AUDIO_RESAMPLE_QUALITY_LOW:
+        return RESAMPLER_LINEAR_PADDING_FRAMES;
+    case SDL_AUDIO_RESAMPLE_QUALITY_HIGH:
+        return RESAMPLER_HQ_PADDING_FRAMES;
+    default:
+        return RESAMPLER_MAX_PADDING_FRAMES;
+    }
 }
 
 // These are not general purpose. They do not check for all possible underflow/overflow
@@ -669,8 +1001,123 @@ Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, S
     return output_frames;
 }
 
+static void ResampleAudio_Linear(int chans, const float *src, int inframes, float *dst, int outframes,
+                                 Sint64 resample_rate, Sint64 *inout_resample_offset)
+{
+    int i, chan;
+    Sint64 srcpos = *inout_resample_offset;
+
+    for (i = 0; i < outframes; ++i) {
+        int srcindex = (int)(Sint32)(srcpos >> 32);
+        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        const float frac = (float)srcfraction * (1.0f / 4294967296.0f);
+        const float *frame = &src[srcindex * chans];
+
+        for (chan = 0; chan < chans; ++chan) {
+            dst[chan] = frame[chan] + (frame[chan + chans] - frame[chan]) * frac;
+        }
+
+        dst += chans;
+    }
+
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+}
+
+static void ResampleAudio_HQ(int chans, const float *src, int inframes, float *dst, int outframes,
+                             Sint64 resample_rate, Sint64 *inout_resample_offset, const ResamplerBank *bank)
+{
+    int i, j;
+    Sint64 srcpos = *inout_resample_offset;
+    ResampleFrameHQFunc resample_frame = ResampleFrameHQ[chans - 1];
+    float interpolated[RESAMPLER_HQ_SAMPLES_PER_FRAME];
+
+    src -= (RESAMPLER_HQ_ZERO_CROSSINGS - 1) * chans;
+
+    for (i = 0; i < outframes; ++i) {
+        int srcindex = (int)(Sint32)(srcpos >> 32);
+        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        const float *filter;
+        if (bank->interpolate) {
+            // Interpolate between the nearest two phases
+            const Uint64 phasepos = (Uint64)srcfraction * bank->num_phases;
+            const float *f0 = &bank->filters[(phasepos >> 32) * RESAMPLER_HQ_SAMPLES_PER_FRAME];
+            const float *f1 = f0 + RESAMPLER_HQ_SAMPLES_PER_FRAME;
+            const float frac = (float)(Uint32)phasepos * (1.0f / 4294967296.0f);
+
+            for (j = 0; j < RESAMPLER_HQ_SAMPLES_PER_FRAME; ++j) {
+                interpolated[j] = f0[j] + (f1[j] - f0[j]) * frac;
+            }
+            filter = interpolated;
+        } else {
+            // Every position is (very nearly) on a phase, just take the nearest one.
+            // This can round up to the last filter, which is a whole frame along.
+            const Uint64 phase = (((Uint64)srcfraction * bank->num_phases) + 0x80000000u) >> 32;
+            filter = &bank->filters[phase * RESAMPLER_HQ_SAMPLES_PER_FRAME];
+        }
+
+        resample_frame(&src[srcindex * chans], dst, filter, chans);
+
+        dst += chans;
+    }
+
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+}
+
+// Whole-number downsampling: every output frame lands exactly on an input frame.
+static void ResampleAudio_Stride(int chans, const float *src, int inframes, float *dst, int outframes,
+                                 int ratio, Sint64 *inout_resample_offset)
+{
+    int i, chan;
+    int srcindex = (int)(Sint32)(*inout_resample_offset >> 32);
+
+    for (i = 0; i < outframes; ++i) {
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        const float *frame = &src[srcindex * chans];
+        for (chan = 0; chan < chans; ++chan) {
+            dst[chan] = frame[chan];
+        }
+
+        srcindex += ratio;
+        dst += chans;
+    }
+
+    *inout_resample_offset = ((Sint64)(srcindex - inframes)) << 32;
+}
+
+// The same, but with a strided FIR to filter out what the lower rate can't represent.
+static void ResampleAudio_Decimate(int chans, const float *src, int inframes, float *dst, int outframes,
+                                   int ratio, Sint64 *inout_resample_offset, const ResamplerBank *bank)
+{
+    int i;
+    int srcindex = (int)(Sint32)(*inout_resample_offset >> 32);
+    ResampleFrameHQFunc resample_frame = ResampleFrameHQ[chans - 1];
+    const float *filter = bank->filters;
+
+    src -= (RESAMPLER_HQ_ZERO_CROSSINGS - 1) * chans;
+
+    for (i = 0; i < outframes; ++i) {
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        resample_frame(&src[srcindex * chans], dst, filter, chans);
+
+        srcindex += ratio;
+        dst += chans;
+    }
+
+    *inout_resample_offset = ((Sint64)(srcindex - inframes)) << 32;
+}
+
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
-                       Sint64 resample_rate, Sint64 *inout_resample_offset)
+                       Sint64 resample_rate, Sint64 *inout_resample_offset, SDL_AudioResampleQuality quality)
 {
     int i;
     Sint64 srcpos = *inout_resample_offset;
@@ -678,6 +1125,33 @@ void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, in
 
     SDL_assert(resample_rate > 0);
 
+    if (quality == SDL_AUDIO_RESAMPLE_QUALITY_LOW) {
+        ResampleAudio_Linear(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset);
+        return;
+    } else if (GetDecimationRatio(resample_rate) && ((srcpos & 0xFFFFFFFF) == 0)) {
+        const int ratio = GetDecimationRatio(resample_rate);
+        if (quality != SDL_AUDIO_RESAMPLE_QUALITY_HIGH) {
+            ResampleAudio_Stride(chans, src, inframes, dst, outframes, ratio, inout_resample_offset);
+            return;
+        }
+
+        const ResamplerBank *bank = GetDecimationBank(ratio);
+        if (bank) {
+            ResampleAudio_Decimate(chans, src, inframes, dst, outframes, ratio, inout_resample_offset, bank);
+            return;
+        }
+        // Out of memory? Fall through to the regular filters.
+    }
+
+    if (quality == SDL_AUDIO_RESAMPLE_QUALITY_HIGH) {
+        const ResamplerBank *bank = GetResamplerBank(resample_rate);
+        if (bank) {
+            ResampleAudio_HQ(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset, bank);
+            return;
+        }
+        // Out of memory? The medium quality filter is shorter, so the padding we were given is plenty.
+    }
+
     src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
 
     for (i = 0; i < outframes; ++i) {
@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 #define DIVBY2147483648 0.0000000004656612873077392578125f // 0x1p-31f
 
@@ -769,6 +770,323 @@ static void SDL_Convert_Swap32_NEON(Uint32* dst, const Uint32* src, int num_samp
 }
 #endif
 
+// Channel swizzles and 24-bit expansion, done with byte shuffles.
+
+// Sample frames are moved in groups that fill 1 to 4 16-byte registers exactly, which covers
+// stereo, quad, 5.1 and 7.1 layouts in every sample size. Returns the number of registers per
+// group, or 0 if the layout can't be grouped, and fills `table` with the source byte offset of
+// every output byte in a group.
+#define SWIZZLE_MAX_REGS 4
+static int SDL_BuildSwizzleTable(Uint8 *table, int channels, const int *map, int bitsize)
+{
+    const int samplesize = bitsize / 8;
+    const int framesize = samplesize * channels;
+    int regs;
+
+    for (regs = 1; regs <= SWIZZLE_MAX_REGS; regs++) {
+        if (((regs * 16) % framesize) == 0) {
+            break;
+        }
+    }
+
+    if (regs > SWIZZLE_MAX_REGS) {
+        return 0;
+    }
+
+    const int groupframes = (regs * 16) / framesize;
+    for (int f = 0; f < groupframes; f++) {
+        for (int ch = 0; ch < channels; ch++) {
+            for (int b = 0; b < samplesize; b++) {
+                table[(f * framesize) + (ch * samplesize) + b] = (Uint8) ((f * framesize) + (map[ch] * samplesize) + b);
+            }
+        }
+    }
+
+    return regs;
+}
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static int SDL_TARGETING("ssse3") SDL_Convert_Swizzle_SSSE3(int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize)
+{
+    Uint8 table[SWIZZLE_MAX_REGS * 16];
+    __m128i masks[SWIZZLE_MAX_REGS][SWIZZLE_MAX_REGS];
+    const int regs = SDL_BuildSwizzleTable(table, channels, map, bitsize);
+
+    if (!regs) {
+        return 0;
+    }
+
+    // pshufb only looks into one register, so each output register is put together from one
+    // shuffle per input register, with 0x80 zeroing out the bytes that come from elsewhere.
+    for (int r = 0; r < regs; r++) {
+        for (int q = 0; q < regs; q++) {
+            Sint8 mask[16];
+            for (int j = 0; j < 16; j++) {
+                const int idx = table[(r * 16) + j];
+                mask[j] = (Sint8) (((idx / 16) == q) ? (idx % 16) : -0x80);
+            }
+            masks[r][q] = _mm_loadu_si128((const __m128i *) mask);
+        }
+    }
+
+    const int groupframes = (regs * 16) / ((bitsize / 8) * channels);
+    const int groups = num_frames / groupframes;
+    const Uint8 *s = (const Uint8 *) src;
+    Uint8 *d = (Uint8 *) dst;
+
+    for (int g = 0; g < groups; g++, s += regs * 16, d += regs * 16) {
+        __m128i in[SWIZZLE_MAX_REGS];
+        for (int q = 0; q < regs; q++) {
+            in[q] = _mm_loadu_si128((const __m128i *) (s + (q * 16)));
+        }
+        // everything is loaded before anything is stored, so this works in-place.
+        for (int r = 0; r < regs; r++) {
+            __m128i out = _mm_shuffle_epi8(in[0], masks[r][0]);
+            for (int q = 1; q < regs; q++) {
+                out = _mm_or_si128(out, _mm_shuffle_epi8(in[q], masks[r][q]));
+            }
+            _mm_storeu_si128((__m128i *) (d + (r * 16)), out);
+        }
+    }
+
+    return groups * groupframes;
+}
+
+static void SDL_TARGETING("ssse3") SDL_Convert_ExpandS24_SSSE3(Uint8 *dst, const Uint8 *src, size_t num_samples)
+{
+    const __m128i shuffle = _mm_set_epi8(11, 10, 9, -0x80, 8, 7, 6, -0x80, 5, 4, 3, -0x80, 2, 1, 0, -0x80);
+    size_t i = num_samples;
+
+    // the 16-byte loads read a little past the 12 bytes they use, so the top samples are done
+    // one at a time first. From there, every load only touches input that's still intact.
+    while ((i > 0) && ((i & 3) || ((i + 4) > num_samples))) {
+        --i;
+        dst[i * 4 + 0] = 0;
+        dst[i * 4 + 1] = src[i * 3 + 0];
+        dst[i * 4 + 2] = src[i * 3 + 1];
+        dst[i * 4 + 3] = src[i * 3 + 2];
+    }
+
+    while (i >= 4) {
+        i -= 4;
+        const __m128i ints = _mm_loadu_si128((const __m128i *) &src[i * 3]);
+        _mm_storeu_si128((__m128i *) &dst[i * 4], _mm_shuffle_epi8(ints, shuffle));
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+// AArch64 has table lookups across up to four registers, so every output register is one lookup.
+static int SDL_Convert_Swizzle_NEON(int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize)
+{
+    Uint8 table[SWIZZLE_MAX_REGS * 16];
+    uint8x16_t idx[SWIZZLE_MAX_REGS];
+    const int regs = SDL_BuildSwizzleTable(table, channels, map, bitsize);
+
+    if (!regs) {
+        return 0;
+    }
+
+    for (int r = 0; r < regs; r++) {
+        idx[r] = vld1q_u8(&table[r * 16]);
+    }
+
+    const int groupframes = (regs * 16) / ((bitsize / 8) * channels);
+    const int groups = num_frames / groupframes;
+    const Uint8 *s = (const Uint8 *) src;
+    Uint8 *d = (Uint8 *) dst;
+
+    for (int g = 0; g < groups; g++, s += regs * 16, d += regs * 16) {
+        switch (regs) {
+        case 1: {
+            const uint8x16_t in = vld1q_u8(s);
+            vst1q_u8(d, vqtbl1q_u8(in, idx[0]));
+            break;
+        }
+        case 2: {
+            const uint8x16x2_t in = vld1q_u8_x2(s);
+            vst1q_u8(d, vqtbl2q_u8(in, idx[0]));
+            vst1q_u8(d + 16, vqtbl2q_u8(in, idx[1]));
+            break;
+        }
+        case 3: {
+            const uint8x16x3_t in = vld1q_u8_x3(s);
+            vst1q_u8(d, vqtbl3q_u8(in, idx[0]));
+            vst1q_u8(d + 16, vqtbl3q_u8(in, idx[1]));
+            vst1q_u8(d + 32, vqtbl3q_u8(in, idx[2]));
+            break;
+        }
+        default: {
+            const uint8x16x4_t in = vld1q_u8_x4(s);
+            vst1q_u8(d, vqtbl4q_u8(in, idx[0]));
+            vst1q_u8(d + 16, vqtbl4q_u8(in, idx[1]));
+            vst1q_u8(d + 32, vqtbl4q_u8(in, idx[2]));
+            vst1q_u8(d + 48, vqtbl4q_u8(in, idx[3]));
+            break;
+        }
+        }
+    }
+
+    return groups * groupframes;
+}
+
+static void SDL_Convert_ExpandS24_NEON(Uint8 *dst, const Uint8 *src, size_t num_samples)
+{
+    static const Uint8 shuffle[16] = { 0xFF, 0, 1, 2, 0xFF, 3, 4, 5, 0xFF, 6, 7, 8, 0xFF, 9, 10, 11 };
+    const uint8x16_t idx = vld1q_u8(shuffle);
+    size_t i = num_samples;
+
+    // see the SSSE3 version for why the top samples are done one at a time.
+    while ((i > 0) && ((i & 3) || ((i + 4) > num_samples))) {
+        --i;
+        dst[i * 4 + 0] = 0;
+        dst[i * 4 + 1] = src[i * 3 + 0];
+        dst[i * 4 + 2] = src[i * 3 + 1];
+        dst[i * 4 + 3] = src[i * 3 + 2];
+    }
+
+    while (i >= 4) {
+        i -= 4;
+        vst1q_u8(&dst[i * 4], vqtbl1q_u8(vld1q_u8(&src[i * 3]), idx));
+    }
+}
+#endif
+
+static int SDL_Convert_Swizzle_Scalar(int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize)
+{
+    return 0;  // SwizzleAudio does it all.
+}
+
+static void SDL_Convert_ExpandS24_Scalar(Uint8 *dst, const Uint8 *src, size_t num_samples)
+{
+    // work from end to start, so this can expand in-place.
+    for (size_t i = num_samples; i > 0; i--) {
+        const size_t o = i - 1;
+        const Uint8 b1 = src[o * 3];
+        const Uint8 b2 = src[o * 3 + 1];
+        const Uint8 b3 = src[o * 3 + 2];
+
+        dst[o * 4 + 0] = 0;
+        dst[o * 4 + 1] = b1;
+        dst[o * 4 + 2] = b2;
+        dst[o * 4 + 3] = b3;
+    }
+}
+
+// Planar to interleaved. A NULL channel buffer is filled with silence.
+
+static void SDL_Convert_Interleave_Generic(void *dst, const void *const *src, int channels, int num_frames, int bitsize, Uint8 silence)
+{
+    #define INTERLEAVE(bits) { \
+        Uint##bits *tdst = (Uint##bits *) dst; \
+        Uint##bits fill; \
+        SDL_memset(&fill, silence, sizeof(fill)); \
+        for (int ch = 0; ch < channels; ch++) { \
+            const Uint##bits *tsrc = (const Uint##bits *) src[ch]; \
+            Uint##bits *out = tdst + ch; \
+            if (tsrc) { \
+                for (int i = 0; i < num_frames; i++, out += channels) { \
+                    *out = tsrc[i]; \
+                } \
+            } else { \
+                for (int i = 0; i < num_frames; i++, out += channels) { \
+                    *out = fill; \
+                } \
+            } \
+        } \
+    }
+
+    switch (bitsize) {
+        case 8: INTERLEAVE(8); break;
+        case 16: INTERLEAVE(16); break;
+        case 32: INTERLEAVE(32); break;
+        default: SDL_assert(!"Unsupported audio datatype size"); break;
+    }
+
+    #undef INTERLEAVE
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_Convert_InterleaveStereo_SSE2(void *dst, const void *const *src, int num_frames, int bitsize)
+{
+    int i = 0;
+
+    if (bitsize == 32) {
+        const float *l = (const float *) src[0];
+        const float *r = (const float *) src[1];
+        float *d = (float *) dst;
+        for (; (i + 4) <= num_frames; i += 4) {
+            const __m128 left = _mm_loadu_ps(&l[i]);
+            const __m128 right = _mm_loadu_ps(&r[i]);
+            _mm_storeu_ps(&d[i * 2], _mm_unpacklo_ps(left, right));
+            _mm_storeu_ps(&d[i * 2 + 4], _mm_unpackhi_ps(left, right));
+        }
+        for (; i < num_frames; i++) {
+            d[i * 2] = l[i];
+            d[i * 2 + 1] = r[i];
+        }
+    } else {
+        SDL_assert(bitsize == 16);
+        const Uint16 *l = (const Uint16 *) src[0];
+        const Uint16 *r = (const Uint16 *) src[1];
+        Uint16 *d = (Uint16 *) dst;
+        for (; (i + 8) <= num_frames; i += 8) {
+            const __m128i left = _mm_loadu_si128((const __m128i *) &l[i]);
+            const __m128i right = _mm_loadu_si128((const __m128i *) &r[i]);
+            _mm_storeu_si128((__m128i *) &d[i * 2], _mm_unpacklo_epi16(left, right));
+            _mm_storeu_si128((__m128i *) &d[i * 2 + 8], _mm_unpackhi_epi16(left, right));
+        }
+        for (; i < num_frames; i++) {
+            d[i * 2] = l[i];
+            d[i * 2 + 1] = r[i];
+        }
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_Convert_InterleaveStereo_NEON(void *dst, const void *const *src, int num_frames, int bitsize)
+{
+    int i = 0;
+
+    if (bitsize == 32) {
+        const Uint32 *l = (const Uint32 *) src[0];
+        const Uint32 *r = (const Uint32 *) src[1];
+        Uint32 *d = (Uint32 *) dst;
+        for (; (i + 4) <= num_frames; i += 4) {
+            uint32x4x2_t frames;
+            frames.val[0] = vld1q_u32(&l[i]);
+            frames.val[1] = vld1q_u32(&r[i]);
+            vst2q_u32(&d[i * 2], frames);
+        }
+        for (; i < num_frames; i++) {
+            d[i * 2] = l[i];
+            d[i * 2 + 1] = r[i];
+        }
+    } else {
+        SDL_assert(bitsize == 16);
+        const Uint16 *l = (const Uint16 *) src[0];
+        const Uint16 *r = (const Uint16 *) src[1];
+        Uint16 *d = (Uint16 *) dst;
+        for (; (i + 8) <= num_frames; i += 8) {
+            uint16x8x2_t frames;
+            frames.val[0] = vld1q_u16(&l[i]);
+            frames.val[1] = vld1q_u16(&r[i]);
+            vst2q_u16(&d[i * 2], frames);
+        }
+        for (; i < num_frames; i++) {
+            d[i * 2] = l[i];
+            d[i * 2 + 1] = r[i];
+        }
+    }
+}
+#endif
+
+static void SDL_Convert_InterleaveStereo_Scalar(void *dst, const void *const *src, int num_frames, int bitsize)
+{
+    SDL_Convert_Interleave_Generic(dst, src, 2, num_frames, bitsize, 0);
+}
+
 #undef CONVERT_16_FWD
 #undef CONVERT_16_REV
 
@@ -785,6 +1103,10 @@ static void (*SDL_Convert_F32_to_S32)(Sint32 *dst, const float *src, int num_sam
 static void (*SDL_Convert_Swap16)(Uint16* dst, const Uint16* src, int num_samples) = NULL;
 static void (*SDL_Convert_Swap32)(Uint32* dst, const Uint32* src, int num_samples) = NULL;
 
+static int (*SDL_Convert_Swizzle)(int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize) = NULL;
+static void (*SDL_Convert_ExpandS24)(Uint8 *dst, const Uint8 *src, size_t num_samples) = NULL;
+static void (*SDL_Convert_InterleaveStereo)(void *dst, const void *const *src, int num_frames, int bitsize) = NULL;
+
 void ConvertAudioToFloat(float *dst, const void *src, int num_samples, SDL_AudioFormat src_fmt)
 {
     switch (src_fmt) {
@@ -868,10 +1190,29 @@ void ConvertAudioSwapEndian(void* dst, const void* src, int num_samples, int bit
     }
 }
 
+int ConvertAudioSwizzle(int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize)
+{
+    return SDL_Convert_Swizzle(num_frames, dst, src, channels, map, bitsize);
+}
+
+void ConvertAudioExpandS24(void *dst, const void *src, size_t num_samples)
+{
+    SDL_Convert_ExpandS24((Uint8 *) dst, (const Uint8 *) src, num_samples);
+}
+
+void ConvertAudioInterleave(void *dst, const void *const *src, int channels, int num_frames, int bitsize, Uint8 silence)
+{
+    if ((channels == 2) && (bitsize != 8) && src[0] && src[1]) {
+        SDL_Convert_InterleaveStereo(dst, src, num_frames, bitsize);
+    } else {
+        SDL_Convert_Interleave_Generic(dst, src, channels, num_frames, bitsize, silence);
+    }
+}
+
 void SDL_ChooseAudioConverters(void)
 {
-    static SDL_bool converters_chosen = SDL_FALSE;
-    if (converters_chosen) {
+    static Uint32 converters_generation = 0;
+    if (converters_generation == SDL_GetCPUDispatchGeneration()) {
         return;
     }
 
@@ -895,6 +1236,26 @@ void SDL_ChooseAudioConverters(void)
 
 #undef SET_CONVERTER_FUNCS
 
+#define SET_CONVERTER_FUNCS(fntype) \
+    SDL_Convert_Swizzle = SDL_Convert_Swizzle_##fntype; \
+    SDL_Convert_ExpandS24 = SDL_Convert_ExpandS24_##fntype;
+
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        SET_CONVERTER_FUNCS(SSSE3);
+    } else
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+    if (SDL_HasNEON()) {
+        SET_CONVERTER_FUNCS(NEON);
+    } else
+#endif
+    {
+        SET_CONVERTER_FUNCS(Scalar);
+    }
+
+#undef SET_CONVERTER_FUNCS
+
 #define SET_CONVERTER_FUNCS(fntype) \
     SDL_Convert_S8_to_F32 = SDL_Convert_S8_to_F32_##fntype; \
     SDL_Convert_U8_to_F32 = SDL_Convert_U8_to_F32_##fntype; \
@@ -904,6 +1265,7 @@ void SDL_ChooseAudioConverters(void)
     SDL_Convert_F32_to_U8 = SDL_Convert_F32_to_U8_##fntype; \
     SDL_Convert_F32_to_S16 = SDL_Convert_F32_to_S16_##fntype; \
     SDL_Convert_F32_to_S32 = SDL_Convert_F32_to_S32_##fntype; \
+    SDL_Convert_InterleaveStereo = SDL_Convert_InterleaveStereo_##fntype; \
 
 #ifdef SDL_SSE2_INTRINSICS
     if (SDL_HasSSE2()) {
@@ -921,5 +1283,5 @@ void SDL_ChooseAudioConverters(void)
 
 #undef SET_CONVERTER_FUNCS
 
-    converters_chosen = SDL_TRUE;
+    converters_generation = SDL_GetCPUDispatchGeneration();
 }
@@ -23,6 +23,7 @@
 // This provides the default mixing callback for the SDL audio routines
 
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -82,10 +83,217 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / MIX_MAXVOLUME) + 128))
 
-// !!! FIXME: This needs some SIMD magic.
-// !!! FIXME: Add fast-path for volume = 1
 // !!! FIXME: Use larger scales for 16-bit/32-bit integers
 
+// Native endian F32 and S16 get SIMD versions, since that's what the device threads mix with.
+// They give exactly the same results as the scalar loops.
+static void SDL_MixAudio_F32_Scalar(float *dst, const float *src, int num_samples, float gain)
+{
+    for (int i = 0; i < num_samples; i++) {
+        const float dst_sample = dst[i] + (src[i] * gain);
+        dst[i] = SDL_clamp(dst_sample, -1.0f, 1.0f);
+    }
+}
+
+static void SDL_MixAudio_S16_Scalar(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    for (int i = 0; i < num_samples; i++) {
+        Sint16 src_sample = src[i];
+        ADJUST_VOLUME(Sint16, src_sample, volume);
+        const int dst_sample = dst[i] + src_sample;
+        dst[i] = (Sint16)SDL_clamp(dst_sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_MixAudio_F32_SSE2(float *dst, const float *src, int num_samples, float gain)
+{
+    const __m128 vgain = _mm_set1_ps(gain);
+    const __m128 vmax = _mm_set1_ps(1.0f);
+    const __m128 vmin = _mm_set1_ps(-1.0f);
+    int i = 0;
+
+    for (; (i + 8) <= num_samples; i += 8) {
+        __m128 a = _mm_add_ps(_mm_loadu_ps(&dst[i]), _mm_mul_ps(_mm_loadu_ps(&src[i]), vgain));
+        __m128 b = _mm_add_ps(_mm_loadu_ps(&dst[i + 4]), _mm_mul_ps(_mm_loadu_ps(&src[i + 4]), vgain));
+        _mm_storeu_ps(&dst[i], _mm_max_ps(_mm_min_ps(a, vmax), vmin));
+        _mm_storeu_ps(&dst[i + 4], _mm_max_ps(_mm_min_ps(b, vmax), vmin));
+    }
+    SDL_MixAudio_F32_Scalar(dst + i, src + i, num_samples - i, gain);
+}
+
+static void SDL_TARGETING("sse2") SDL_MixAudio_S16_SSE2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    int i = 0;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (; (i + 8) <= num_samples; i += 8) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)&dst[i]);
+            const __m128i b = _mm_loadu_si128((const __m128i *)&src[i]);
+            _mm_storeu_si128((__m128i *)&dst[i], _mm_adds_epi16(a, b));
+        }
+    } else {
+        const __m128i vvolume = _mm_set1_epi16((Sint16)volume);
+        const __m128i round = _mm_set1_epi32(MIX_MAXVOLUME - 1);
+
+        for (; (i + 8) <= num_samples; i += 8) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)&dst[i]);
+            const __m128i b = _mm_loadu_si128((const __m128i *)&src[i]);
+            const __m128i lo = _mm_mullo_epi16(b, vvolume);
+            const __m128i hi = _mm_mulhi_epi16(b, vvolume);
+            __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+            // divide by MIX_MAXVOLUME rounding towards zero, then wrap to 16 bits like the scalar cast does.
+            p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), round)), 7);
+            p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), round)), 7);
+            p0 = _mm_srai_epi32(_mm_slli_epi32(p0, 16), 16);
+            p1 = _mm_srai_epi32(_mm_slli_epi32(p1, 16), 16);
+            _mm_storeu_si128((__m128i *)&dst[i], _mm_adds_epi16(a, _mm_packs_epi32(p0, p1)));
+        }
+    }
+    SDL_MixAudio_S16_Scalar(dst + i, src + i, num_samples - i, volume);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_MixAudio_F32_AVX2(float *dst, const float *src, int num_samples, float gain)
+{
+    const __m256 vgain = _mm256_set1_ps(gain);
+    const __m256 vmax = _mm256_set1_ps(1.0f);
+    const __m256 vmin = _mm256_set1_ps(-1.0f);
+    int i = 0;
+
+    for (; (i + 16) <= num_samples; i += 16) {
+        // not _mm256_fmadd_ps, it rounds differently than the scalar code.
+        __m256 a = _mm256_add_ps(_mm256_loadu_ps(&dst[i]), _mm256_mul_ps(_mm256_loadu_ps(&src[i]), vgain));
+        __m256 b = _mm256_add_ps(_mm256_loadu_ps(&dst[i + 8]), _mm256_mul_ps(_mm256_loadu_ps(&src[i + 8]), vgain));
+        _mm256_storeu_ps(&dst[i], _mm256_max_ps(_mm256_min_ps(a, vmax), vmin));
+        _mm256_storeu_ps(&dst[i + 8], _mm256_max_ps(_mm256_min_ps(b, vmax), vmin));
+    }
+    SDL_MixAudio_F32_Scalar(dst + i, src + i, num_samples - i, gain);
+}
+
+static void SDL_TARGETING("avx2") SDL_MixAudio_S16_AVX2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    int i = 0;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (; (i + 16) <= num_samples; i += 16) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)&dst[i]);
+            const __m256i b = _mm256_loadu_si256((const __m256i *)&src[i]);
+            _mm256_storeu_si256((__m256i *)&dst[i], _mm256_adds_epi16(a, b));
+        }
+    } else {
+        const __m256i vvolume = _mm256_set1_epi16((Sint16)volume);
+        const __m256i round = _mm256_set1_epi32(MIX_MAXVOLUME - 1);
+
+        for (; (i + 16) <= num_samples; i += 16) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)&dst[i]);
+            const __m256i b = _mm256_loadu_si256((const __m256i *)&src[i]);
+            const __m256i lo = _mm256_mullo_epi16(b, vvolume);
+            const __m256i hi = _mm256_mulhi_epi16(b, vvolume);
+            // unpack and pack both work within 128-bit lanes, so the samples end up back in order.
+            __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+            __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+            p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), round)), 7);
+            p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), round)), 7);
+            p0 = _mm256_srai_epi32(_mm256_slli_epi32(p0, 16), 16);
+            p1 = _mm256_srai_epi32(_mm256_slli_epi32(p1, 16), 16);
+            _mm256_storeu_si256((__m256i *)&dst[i], _mm256_adds_epi16(a, _mm256_packs_epi32(p0, p1)));
+        }
+    }
+    SDL_MixAudio_S16_Scalar(dst + i, src + i, num_samples - i, volume);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_MixAudio_F32_NEON(float *dst, const float *src, int num_samples, float gain)
+{
+    const float32x4_t vmax = vdupq_n_f32(1.0f);
+    const float32x4_t vmin = vdupq_n_f32(-1.0f);
+    int i = 0;
+
+    for (; (i + 8) <= num_samples; i += 8) {
+        // not vmlaq_f32, which is fused on some cores and would round differently than the scalar code.
+        float32x4_t a = vaddq_f32(vld1q_f32(&dst[i]), vmulq_n_f32(vld1q_f32(&src[i]), gain));
+        float32x4_t b = vaddq_f32(vld1q_f32(&dst[i + 4]), vmulq_n_f32(vld1q_f32(&src[i + 4]), gain));
+        vst1q_f32(&dst[i], vmaxq_f32(vminq_f32(a, vmax), vmin));
+        vst1q_f32(&dst[i + 4], vmaxq_f32(vminq_f32(b, vmax), vmin));
+    }
+    SDL_MixAudio_F32_Scalar(dst + i, src + i, num_samples - i, gain);
+}
+
+static void SDL_MixAudio_S16_NEON(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    int i = 0;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (; (i + 8) <= num_samples; i += 8) {
+            vst1q_s16(&dst[i], vqaddq_s16(vld1q_s16(&dst[i]), vld1q_s16(&src[i])));
+        }
+    } else {
+        const int16x4_t vvolume = vdup_n_s16((Sint16)volume);
+        const int32x4_t round = vdupq_n_s32(MIX_MAXVOLUME - 1);
+
+        for (; (i + 8) <= num_samples; i += 8) {
+            const int16x8_t b = vld1q_s16(&src[i]);
+            int32x4_t p0 = vmull_s16(vget_low_s16(b), vvolume);
+            int32x4_t p1 = vmull_s16(vget_high_s16(b), vvolume);
+            p0 = vshrq_n_s32(vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), round)), 7);
+            p1 = vshrq_n_s32(vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), round)), 7);
+            // vmovn truncates, which wraps to 16 bits like the scalar cast does.
+            vst1q_s16(&dst[i], vqaddq_s16(vld1q_s16(&dst[i]), vcombine_s16(vmovn_s32(p0), vmovn_s32(p1))));
+        }
+    }
+    SDL_MixAudio_S16_Scalar(dst + i, src + i, num_samples - i, volume);
+}
+#endif
+
+static void (*SDL_MixAudio_F32)(float *dst, const float *src, int num_samples, float gain) = NULL;
+static void (*SDL_MixAudio_S16)(Sint16 *dst, const Sint16 *src, int num_samples, int volume) = NULL;
+
+static void SDL_ChooseAudioMixers(void)
+{
+    static Uint32 mixers_generation = 0;
+
+    if (mixers_generation == SDL_GetCPUDispatchGeneration()) {
+        return;
+    }
+
+#define SET_MIXER_FUNCS(fntype) \
+    SDL_MixAudio_S16 = SDL_MixAudio_S16_##fntype; \
+    SDL_MixAudio_F32 = SDL_MixAudio_F32_##fntype;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+    } else
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+    } else
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_MIXER_FUNCS(NEON);
+    } else
+#endif
+    {
+        SET_MIXER_FUNCS(Scalar);
+    }
+
+#undef SET_MIXER_FUNCS
+
+    mixers_generation = SDL_GetCPUDispatchGeneration();
+}
+
+void SDL_MixAudioFloat32(float *dst, const float *src, int num_samples, float gain)
+{
+    SDL_ChooseAudioMixers();
+    SDL_MixAudio_F32(dst, src, num_samples, gain);
+}
+
 int SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format,
                  Uint32 len, float fvolume)
 {
@@ -95,6 +303,15 @@ int SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format,
         return 0;
     }
 
+    if (format == SDL_AUDIO_F32) {
+        SDL_MixAudioFloat32((float *)dst, (const float *)src, (int)(len / 4), fvolume);
+        return 0;
+    } else if (format == SDL_AUDIO_S16 && volume <= SDL_MAX_SINT16) {
+        SDL_ChooseAudioMixers();
+        SDL_MixAudio_S16((Sint16 *)dst, (const Sint16 *)src, (int)(len / 2), volume);
+        return 0;
+    }
+
     switch (format) {
 
     case SDL_AUDIO_U8:
@@ -65,6 +65,10 @@ const SDL_AudioFormat *SDL_ClosestAudioFormats(SDL_AudioFormat format);
 // Must be called at least once before using converters.
 extern void SDL_ChooseAudioConverters(void);
 extern void SDL_SetupAudioResampler(void);
+extern void SDL_QuitAudioResampler(void);
+
+// Mixes native endian float samples into `dst`, scaling `src` by `gain` first and clamping to -1.0f..1.0f.
+extern void SDL_MixAudioFloat32(float *dst, const float *src, int num_samples, float gain);
 
 /* Backends should call this as devices are added to the system (such as
    a USB headset being plugged in), and should also be called for
@@ -113,6 +117,13 @@ extern void ConvertAudioToFloat(float *dst, const void *src, int num_samples, SD
 extern void ConvertAudioFromFloat(void *dst, const float *src, int num_samples, SDL_AudioFormat dst_fmt);
 extern void ConvertAudioSwapEndian(void* dst, const void* src, int num_samples, int bitsize);
 
+// Swizzles as many whole sample frames as the SIMD path can handle and returns how many that was; the caller does the rest.
+extern int ConvertAudioSwizzle(int num_frames, void *dst, const void *src, int channels, const int *map, int bitsize);
+// Shifts packed 24-bit samples to 32 bits, keeping the byte order. dst and src can be the same pointer.
+extern void ConvertAudioExpandS24(void *dst, const void *src, size_t num_samples);
+// Interleaves one buffer per channel into dst. NULL channel buffers are filled with `silence`.
+extern void ConvertAudioInterleave(void *dst, const void *const *src, int channels, int num_frames, int bitsize, Uint8 silence);
+
 extern SDL_bool SDL_ChannelMapIsDefault(const int *map, int channels);
 extern SDL_bool SDL_ChannelMapIsBogus(const int *map, int channels);
 
@@ -137,6 +148,12 @@ extern void OnAudioStreamDestroy(SDL_AudioStream *stream);
 // This just lets audio playback apply logical device gain at the same time as audiostream gain, so it's one multiplication instead of thousands.
 extern int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain);
 
+// Same as SDL_GetAudioStreamDataAdjustGain, but leaves the gain for SDL_MixAudioFloat32 to apply while it mixes.
+extern int SDL_GetAudioStreamDataForMixing(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain, float *out_gain);
+
+// Estimated latency of an opened device, in nanoseconds, for SDL_GetAudioStreamProperties. 0 if unknown.
+extern Uint64 SDL_GetAudioDeviceLatencyNS(SDL_AudioDeviceID devid);
+
 // This is the bulk of `SDL_SetAudioStream*putChannelMap`'s work, but it lets you skip the check about changing the device end of a stream if isinput==-1.
 extern int SetAudioStreamChannelMap(SDL_AudioStream *stream, const SDL_AudioSpec *spec, int **stream_chmap, const int *chmap, int channels, int isinput);
 
@@ -211,8 +228,21 @@ struct SDL_AudioStream
     int *dst_chmap;
     float freq_ratio;
     float gain;
+    SDL_AudioResampleQuality resample_quality;  // refreshed from the stream's properties each time data is requested.
+    Uint64 underruns;  // times a read came up short since data was last added.
+    SDL_bool starved;  // SDL_TRUE if a read came up short and no data was added since.
 
     struct SDL_AudioQueue* queue;
+    size_t queue_chunk_size;  // the queue's memory pool settings, as last applied from the stream's properties.
+    size_t queue_max_free;
+    size_t queue_reserved;
+
+    // Lock-free input ring for SDL_SetAudioStreamSingleProducer(). The producer owns ring_write and only reads ring_read,
+    // whoever holds `lock` owns ring_read and moves the data into `queue`.
+    Uint8 *ring;
+    Uint32 ring_size;  // always a power of two.
+    SDL_AtomicInt ring_write;  // total bytes written, wraps around.
+    SDL_AtomicInt ring_read;  // total bytes read, wraps around.
 
     SDL_AudioSpec input_spec; // The spec of input data currently being processed
     int *input_chmap;
@@ -265,6 +295,12 @@ struct SDL_LogicalAudioDevice
     // App-supplied pointer for postmix callback.
     void *postmix_userdata;
 
+    // If non-NULL, callback into the app that reads/writes the physical device buffer directly, skipping streams and mixing.
+    SDL_AudioDeviceCallback device_callback;
+
+    // App-supplied pointer for device callback.
+    void *device_callback_userdata;
+
     // double-linked list of opened devices on the same physical device.
     SDL_LogicalAudioDevice *next;
     SDL_LogicalAudioDevice *prev;
@@ -339,6 +375,20 @@ struct SDL_AudioDevice
     // SDL_TRUE if this physical device is currently opened by the backend.
     SDL_bool currently_opened;
 
+    // Instrumentation for SDL_GetAudioDeviceProperties(), reset when the device opens. Protected by `lock` unless noted.
+    SDL_PropertiesID props;
+    Uint64 last_wake_ns;  // when the last device iteration started, 0 before the first one.
+    Uint64 expected_wake_ns;  // how much audio the last iteration handled, so how long until the next one should start.
+    Uint64 max_wake_jitter_ns;
+    Uint64 last_mix_ns;
+    Uint64 max_mix_ns;
+    Uint64 late_wakes;  // iterations that started more than a whole buffer late.
+
+    // Backends fill these in if they know better. `xruns` can be bumped from any thread.
+    SDL_AtomicInt xruns;
+    SDL_bool backend_reports_xruns;  // if SDL_FALSE, late_wakes is reported instead of xruns.
+    Uint64 backend_latency_ns;  // latency past the device buffer (OS mixer, hardware, etc).
+
     // Data private to this driver
     struct SDL_PrivateAudioData *hidden;
 
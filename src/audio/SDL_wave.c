@@ -1158,7 +1158,10 @@ static int LAW_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* Expands 8-bit companded samples to 16-bit PCM in place. The buffer has to be
+ * large enough to hold sample_count 16-bit samples.
+ */
+static int LAW_Expand(Uint16 encoding, Uint8 *src, size_t sample_count)
 {
 #ifdef SDL_WAVE_LAW_LUT
     const Sint16 alaw_lut[256] = {
@@ -1199,53 +1202,12 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     };
 #endif
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
-
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return -1;
-        }
-    }
-
-    /* Nothing to decode, nothing to return. */
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return 0;
-    }
-
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_SetError("WAVE file too big");
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    /* 1 to avoid allocating zero bytes, to keep static analysis happy. */
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (!src) {
-        return -1;
-    }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
+    Sint16 *dst = (Sint16 *)src;
+    size_t i;
 
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
+    /* Work backwards, since we're expanding in-place. */
     i = sample_count;
-    switch (file->format.encoding) {
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
         while (i--) {
@@ -1290,10 +1252,59 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
-        SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
 
+    return 0;
+}
+
+static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return -1;
+        }
+    }
+
+    /* Nothing to decode, nothing to return. */
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return 0;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_SetError("WAVE file too big");
+    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    /* 1 to avoid allocating zero bytes, to keep static analysis happy. */
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (!src) {
+        return -1;
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    /* `format` will inform the caller about the byte order. */
+    if (LAW_Expand(format->encoding, src, sample_count) < 0) {
+        SDL_free(src);
+        return -1;
+    }
+
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
 
@@ -1343,11 +1354,23 @@ static int PCM_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
+/* Shifts packed 24-bit samples to 32 bits in place. The buffer has to be large
+ * enough to hold sample_count 32-bit samples.
+ */
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    /* The WAVE loader doesn't need the audio subsystem, so make sure the
+     * (possibly SIMD) converters are set up.
+     */
+    SDL_ChooseAudioConverters();
+    ConvertAudioExpandS24(ptr, ptr, sample_count);
+}
+
 static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1375,21 +1398,7 @@ static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    /* work from end to start, since we're expanding in-place. */
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return 0;
 }
@@ -1769,7 +1778,11 @@ static int WaveCheckFormat(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Parses the chunks and the format of a WAVE file and fills in the spec of the
+ * decoded audio. The data chunk is left in file->chunk, but none of its data is
+ * read yet. The position after the WAVE file is reported in endposition.
+ */
+static int WaveOpen(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1983,6 +1996,66 @@ static int WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint
     /* Process data chunk. */
     *chunk = datachunk;
 
+    /* Setting up the specs. All unsupported formats were filtered out
+     * by checks earlier in this function.
+     */
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = 0;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        /* These can be easily stored in the byte order of the system. */
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: /* Has been shifted to 32 bits. */
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            /* Just in case something unexpected happened in the checks. */
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    /* Report the end position back to the caller. */
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return 0;
+}
+
+static int WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (WaveOpen(src, file, spec, &endposition) < 0) {
+        return -1;
+    }
+
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result == -1) {
@@ -2026,51 +2099,8 @@ static int WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = 0;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        /* These can be easily stored in the byte order of the system. */
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: /* Has been shifted to 32 bits. */
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            /* Just in case something unexpected happened in the checks. */
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
-    }
-
     /* Report the end position back to the cleanup code. */
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return 0;
 }
@@ -2134,3 +2164,334 @@ int SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32
     return SDL_LoadWAV_IO(SDL_IOFromFile(path, "rb"), 1, spec, audio_buf, audio_len);
 }
 
+
+/* Number of sample frames decoded at once from formats that don't have blocks. */
+#define WAVE_STREAM_PCM_BLOCK_FRAMES 4096
+
+#define SDL_PROP_AUDIOSTREAM_WAVESTREAM_POINTER "SDL.internal.audiostream.wavestream"
+
+typedef struct WaveStream
+{
+    SDL_IOStream *src;
+    SDL_bool closeio;
+    WaveFile file;
+    size_t blocksize;       /* Size of a block in the data chunk in bytes. */
+    Sint64 blockframes;     /* Number of sample frames in a block. */
+    size_t outputframesize; /* Size of a decoded sample frame in bytes. */
+    Sint64 framepos;        /* The sample frame that will be decoded next. */
+    SDL_bool eof;           /* No more data will be decoded until the next seek. */
+    SDL_bool flushed;       /* The audio stream was flushed after reaching eof. */
+    Uint8 *input;           /* One block of raw ADPCM data. */
+    Uint8 *output;          /* One block of decoded data. */
+    void *cstate;           /* ADPCM decoding state for each channel. */
+} WaveStream;
+
+static void SDLCALL WaveStreamCleanup(void *userdata, void *value)
+{
+    WaveStream *ws = (WaveStream *)value;
+
+    if (ws->closeio) {
+        SDL_CloseIO(ws->src);
+    }
+    WaveFreeChunkData(&ws->file.chunk);
+    SDL_free(ws->file.decoderdata);
+    SDL_free(ws->input);
+    SDL_free(ws->output);
+    SDL_free(ws->cstate);
+    SDL_free(ws);
+}
+
+/* Decodes the ADPCM block that was just read into ws->input. Returns the number
+ * of sample frames in ws->output.
+ */
+static Sint64 WaveStreamDecodeADPCM(WaveStream *ws, size_t blocksize, Sint64 blockstart)
+{
+    WaveFile *file = &ws->file;
+    ADPCM_DecoderState state;
+    int result;
+
+    SDL_zero(state);
+    state.channels = file->format.channels;
+    state.blocksize = ws->blocksize;
+    state.samplesperblock = file->format.samplesperblock;
+    state.framesize = state.channels * sizeof(Sint16);
+    state.ddata = file->decoderdata;
+    state.cstate = ws->cstate;
+    state.framestotal = file->sampleframes;
+    state.framesleft = file->sampleframes - blockstart;
+    state.block.data = ws->input;
+    state.block.size = blocksize;
+    state.output.data = (Sint16 *)ws->output;
+    state.output.size = (size_t)ws->blockframes * state.channels;
+
+    if (file->format.encoding == MS_ADPCM_CODE) {
+        state.blockheadersize = (size_t)state.channels * 7;
+    } else {
+        state.blockheadersize = (size_t)state.channels * 4;
+    }
+
+    if (blocksize < state.blockheadersize) {
+        result = -1;
+    } else if (file->format.encoding == MS_ADPCM_CODE) {
+        result = MS_ADPCM_DecodeBlockHeader(&state);
+        if (result == 0) {
+            result = MS_ADPCM_DecodeBlockData(&state);
+        }
+    } else {
+        result = IMA_ADPCM_DecodeBlockHeader(&state);
+        if (result == 0) {
+            result = IMA_ADPCM_DecodeBlockData(&state);
+        }
+    }
+
+    if (result == -1) {
+        /* Truncated block. Same rules as WaveLoad for the partial data. */
+        ws->eof = SDL_TRUE;
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Truncated data chunk");
+        } else if (file->trunchint != TruncDropFrame) {
+            return 0;
+        }
+    }
+
+    return (Sint64)(state.output.pos / state.channels);
+}
+
+/* Decodes the block containing ws->framepos and puts it into the audio stream.
+ * Returns the number of bytes put into the stream, or -1 on error.
+ */
+static int WaveStreamDecodeBlock(WaveStream *ws, SDL_AudioStream *stream)
+{
+    WaveFile *file = &ws->file;
+    WaveFormat *format = &file->format;
+    const Sint64 block = ws->framepos / ws->blockframes;
+    const Sint64 blockstart = block * ws->blockframes;
+    const Sint64 skip = ws->framepos - blockstart;
+    Sint64 blockframes = SDL_min(ws->blockframes, file->sampleframes - blockstart);
+    const Sint64 blockoffset = block * (Sint64)ws->blocksize;
+    Sint64 position;
+    size_t length, got;
+    Sint64 frames;
+    int bytes;
+
+    if (blockframes <= 0 || blockoffset >= (Sint64)file->chunk.length) {
+        ws->eof = SDL_TRUE;
+        return 0;
+    }
+
+    length = ws->blocksize;
+    if ((Sint64)length > (Sint64)file->chunk.length - blockoffset) {
+        length = (size_t)((Sint64)file->chunk.length - blockoffset);
+    }
+
+    position = file->chunk.position + blockoffset;
+    if (SDL_SeekIO(ws->src, position, SDL_IO_SEEK_SET) != position) {
+        ws->eof = SDL_TRUE;
+        return SDL_SetError("Could not seek data of WAVE data chunk");
+    }
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        got = SDL_ReadIO(ws->src, ws->input, length);
+        frames = WaveStreamDecodeADPCM(ws, got, blockstart);
+        if (frames < 0) {
+            return -1;
+        }
+        break;
+    default:
+        /* PCM and companded data is read straight into the output buffer and
+         * expanded in place.
+         */
+        length = SDL_min(length, (size_t)blockframes * format->blockalign);
+        got = SDL_ReadIO(ws->src, ws->output, length);
+        frames = (Sint64)(got / format->blockalign);
+        if (got != length) {
+            ws->eof = SDL_TRUE;
+            if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+                return SDL_SetError("Truncated data chunk");
+            }
+        }
+        if (format->encoding == ALAW_CODE || format->encoding == MULAW_CODE) {
+            if (LAW_Expand(format->encoding, ws->output, (size_t)frames * format->channels) < 0) {
+                ws->eof = SDL_TRUE;
+                return -1;
+            }
+        } else if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+            PCM_ExpandSint24ToSint32(ws->output, (size_t)frames * format->channels);
+        }
+        break;
+    }
+
+    if (frames < blockframes) {
+        /* Short read or truncated block, this is where the audio ends. */
+        ws->eof = SDL_TRUE;
+        blockframes = frames;
+    }
+
+    ws->framepos = blockstart + blockframes;
+    if (ws->framepos >= file->sampleframes) {
+        ws->eof = SDL_TRUE;
+    }
+
+    if (blockframes <= skip) {
+        return 0;
+    }
+
+    bytes = (int)((blockframes - skip) * (Sint64)ws->outputframesize);
+    if (SDL_PutAudioStreamData(stream, ws->output + skip * ws->outputframesize, bytes) < 0) {
+        return -1;
+    }
+    return bytes;
+}
+
+static void SDLCALL WaveStreamGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    WaveStream *ws = (WaveStream *)userdata;
+
+    while (additional_amount > 0 && !ws->eof) {
+        const int bytes = WaveStreamDecodeBlock(ws, stream);
+        if (bytes < 0) {
+            break;
+        }
+        additional_amount -= bytes;
+    }
+
+    if (ws->eof && !ws->flushed) {
+        /* Let the resampler give up the last few frames. */
+        SDL_FlushAudioStream(stream);
+        ws->flushed = SDL_TRUE;
+    }
+}
+
+SDL_AudioStream *SDL_OpenWAVStream(SDL_IOStream *src, SDL_bool closeio, SDL_AudioSpec *spec)
+{
+    WaveStream *ws = NULL;
+    WaveFile *file;
+    WaveFormat *format;
+    SDL_AudioSpec wavspec;
+    SDL_AudioStream *stream = NULL;
+    SDL_PropertiesID props;
+    Sint64 endposition;
+    size_t outputsize;
+
+    if (spec) {
+        SDL_zerop(spec);
+    }
+
+    if (!src) {
+        return NULL;  /* Error may come from SDL_IOStream. */
+    }
+
+    ws = (WaveStream *)SDL_calloc(1, sizeof(*ws));
+    if (!ws) {
+        goto failed;
+    }
+    ws->src = src;
+    ws->closeio = closeio;
+
+    file = &ws->file;
+    format = &file->format;
+    file->riffhint = WaveGetRiffSizeHint();
+    file->trunchint = WaveGetTruncationHint();
+    file->facthint = WaveGetFactChunkHint();
+
+    if (WaveOpen(src, file, &wavspec, &endposition) < 0) {
+        goto failed;
+    }
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        ws->blocksize = format->blockalign;
+        ws->blockframes = format->samplesperblock;
+        ws->input = (Uint8 *)SDL_malloc(ws->blocksize);
+        if (!ws->input) {
+            goto failed;
+        }
+        if (format->encoding == MS_ADPCM_CODE) {
+            ws->cstate = SDL_calloc(format->channels, sizeof(MS_ADPCM_ChannelState));
+        } else {
+            ws->cstate = SDL_calloc(format->channels, sizeof(Sint8));
+        }
+        if (!ws->cstate) {
+            goto failed;
+        }
+        break;
+    default:
+        ws->blocksize = (size_t)WAVE_STREAM_PCM_BLOCK_FRAMES * format->blockalign;
+        ws->blockframes = WAVE_STREAM_PCM_BLOCK_FRAMES;
+        break;
+    }
+
+    ws->outputframesize = SDL_AUDIO_FRAMESIZE(wavspec);
+    outputsize = (size_t)ws->blockframes;
+    if (SafeMult(&outputsize, SDL_max(ws->outputframesize, format->blockalign))) {
+        SDL_SetError("WAVE file too big");
+        goto failed;
+    }
+    ws->output = (Uint8 *)SDL_malloc(outputsize);
+    if (!ws->output) {
+        goto failed;
+    }
+
+    ws->eof = (file->sampleframes == 0);
+
+    stream = SDL_CreateAudioStream(&wavspec, &wavspec);
+    if (!stream) {
+        goto failed;
+    }
+
+    props = SDL_GetAudioStreamProperties(stream);
+    if (!props) {
+        goto failed;
+    }
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER, file->sampleframes);
+    if (SDL_SetPointerPropertyWithCleanup(props, SDL_PROP_AUDIOSTREAM_WAVESTREAM_POINTER, ws, WaveStreamCleanup, NULL) < 0) {
+        ws = NULL;  /* The cleanup has already been called. */
+        goto failed;
+    }
+
+    if (SDL_SetAudioStreamGetCallback(stream, WaveStreamGetCallback, ws) < 0) {
+        ws = NULL;  /* The properties own it now. */
+        goto failed;
+    }
+
+    if (spec) {
+        SDL_copyp(spec, &wavspec);
+    }
+    return stream;
+
+failed:
+    /* Whoever owns the decoder state at this point also closes src. */
+    if (ws) {
+        WaveStreamCleanup(NULL, ws);
+    } else if (!stream && closeio) {
+        SDL_CloseIO(src);
+    }
+    SDL_DestroyAudioStream(stream);
+    return NULL;
+}
+
+int SDL_SeekWAVStream(SDL_AudioStream *stream, Uint64 frame)
+{
+    WaveStream *ws;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    ws = (WaveStream *)SDL_GetPointerProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_WAVESTREAM_POINTER, NULL);
+    if (!ws) {
+        return SDL_SetError("Audio stream was not opened with SDL_OpenWAVStream");
+    }
+
+    SDL_LockAudioStream(stream);
+    SDL_ClearAudioStream(stream);
+    ws->framepos = (Sint64)SDL_min(frame, (Uint64)ws->file.sampleframes);
+    ws->eof = (ws->framepos >= ws->file.sampleframes);
+    ws->flushed = SDL_FALSE;
+    SDL_UnlockAudioStream(stream);
+
+    return 0;
+}
@@ -322,9 +322,13 @@ static int BuildAAudioStream(SDL_AudioDevice *device)
     ctx.AAudioStreamBuilder_setErrorCallback(builder, AAUDIO_errorCallback, device);
     ctx.AAudioStreamBuilder_setDataCallback(builder, AAUDIO_dataCallback, device);
     // Some devices have flat sounding audio when low latency mode is enabled, but this is a better experience for most people
-    if (SDL_GetHintBoolean("SDL_ANDROID_LOW_LATENCY_AUDIO", SDL_TRUE)) {
+    const SDL_bool low_latency = SDL_GetHintBoolean("SDL_ANDROID_LOW_LATENCY_AUDIO", SDL_TRUE);
+    if (low_latency) {
         ctx.AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+        // Exclusive mode can get us a direct MMAP path to the hardware; AAudio quietly falls back to shared if it can't.
+        ctx.AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
     }
+    const int requested_sample_frames = device->sample_frames;
 
     LOGI("AAudio Try to open %u hz %u bit chan %u %s samples %u",
          device->spec.freq, SDL_AUDIO_BITSIZE(device->spec.format),
@@ -338,8 +342,15 @@ static int BuildAAudioStream(SDL_AudioDevice *device)
     }
     ctx.AAudioStreamBuilder_delete(builder);
 
+    const int burst_frames = (int)ctx.AAudioStream_getFramesPerBurst(hidden->stream);
     device->sample_frames = (int)ctx.AAudioStream_getFramesPerDataCallback(hidden->stream);
-    if (device->sample_frames == AAUDIO_UNSPECIFIED) {
+    if ((device->sample_frames == AAUDIO_UNSPECIFIED) && low_latency && (burst_frames > 0)) {
+        // Work in whole bursts, as close to what the app asked for as we can, and only keep two bursts queued in the device.
+        device->sample_frames = burst_frames * SDL_max(1, (requested_sample_frames + (burst_frames / 2)) / burst_frames);
+        if (!recording) {
+            ctx.AAudioStream_setBufferSizeInFrames(hidden->stream, burst_frames * 2);
+        }
+    } else if (device->sample_frames == AAUDIO_UNSPECIFIED) {
         // We'll get variable frames in the callback, make sure we have at least half a buffer available
         device->sample_frames = (int)ctx.AAudioStream_getBufferCapacityInFrames(hidden->stream) / 2;
     }
@@ -376,9 +387,10 @@ static int BuildAAudioStream(SDL_AudioDevice *device)
         return -1;
     }
 
-    LOGI("AAudio Actually opened %u hz %u bit chan %u %s samples %u, buffers %d",
+    LOGI("AAudio Actually opened %u hz %u bit chan %u %s samples %u, buffers %d, burst %d%s",
          device->spec.freq, SDL_AUDIO_BITSIZE(device->spec.format),
-         device->spec.channels, SDL_AUDIO_ISBIGENDIAN(device->spec.format) ? "BE" : "LE", device->sample_frames, hidden->num_buffers);
+         device->spec.channels, SDL_AUDIO_ISBIGENDIAN(device->spec.format) ? "BE" : "LE", device->sample_frames, hidden->num_buffers,
+         burst_frames, (ctx.AAudioStream_getSharingMode(hidden->stream) == AAUDIO_SHARING_MODE_EXCLUSIVE) ? " (exclusive)" : "");
 
     res = ctx.AAudioStream_requestStart(hidden->stream);
     if (res != AAUDIO_OK) {
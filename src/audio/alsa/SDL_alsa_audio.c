@@ -81,6 +81,9 @@ static int (*ALSA_snd_device_name_hint)(int, const char *, void ***);
 static char *(*ALSA_snd_device_name_get_hint)(const void *, const char *);
 static int (*ALSA_snd_device_name_free_hint)(void **);
 static snd_pcm_sframes_t (*ALSA_snd_pcm_avail)(snd_pcm_t *);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_avail_update)(snd_pcm_t *);
+static int (*ALSA_snd_pcm_mmap_begin)(snd_pcm_t *, const snd_pcm_channel_area_t **, snd_pcm_uframes_t *, snd_pcm_uframes_t *);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_mmap_commit)(snd_pcm_t *, snd_pcm_uframes_t, snd_pcm_uframes_t);
 #ifdef SND_CHMAP_API_VERSION
 static snd_pcm_chmap_t *(*ALSA_snd_pcm_get_chmap)(snd_pcm_t *);
 static int (*ALSA_snd_pcm_chmap_print)(const snd_pcm_chmap_t *map, size_t maxlen, char *buf);
@@ -151,6 +154,9 @@ static int load_alsa_syms(void)
     SDL_ALSA_SYM(snd_device_name_get_hint);
     SDL_ALSA_SYM(snd_device_name_free_hint);
     SDL_ALSA_SYM(snd_pcm_avail);
+    SDL_ALSA_SYM(snd_pcm_avail_update);
+    SDL_ALSA_SYM(snd_pcm_mmap_begin);
+    SDL_ALSA_SYM(snd_pcm_mmap_commit);
 #ifdef SND_CHMAP_API_VERSION
     SDL_ALSA_SYM(snd_pcm_get_chmap);
     SDL_ALSA_SYM(snd_pcm_chmap_print);
@@ -287,8 +293,32 @@ static int ALSA_WaitDevice(SDL_AudioDevice *device)
     return 0;
 }
 
+static int ALSA_PlayMmapDevice(SDL_AudioDevice *device)
+{
+    snd_pcm_t *pcm_handle = device->hidden->pcm_handle;
+    const snd_pcm_uframes_t frames = device->hidden->mmap_frames;
+    const snd_pcm_sframes_t rc = ALSA_snd_pcm_mmap_commit(pcm_handle, device->hidden->mmap_offset, frames);
+
+    device->hidden->mmap_frames = 0;
+
+    if ((rc < 0) || ((snd_pcm_uframes_t) rc != frames)) {
+        const int status = ALSA_snd_pcm_recover(pcm_handle, (rc < 0) ? (int) rc : -EPIPE, 0);
+        if (status < 0) {
+            // Hmm, not much we can do - abort
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "ALSA mmap commit failed (unrecoverable): %s", ALSA_snd_strerror((rc < 0) ? (int) rc : -EPIPE));
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 static int ALSA_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buflen)
 {
+    if (device->hidden->mmap_access) {
+        return ALSA_PlayMmapDevice(device);  // SDL mixed right into the ring buffer; just tell ALSA it's there.
+    }
+
     SDL_assert(buffer == device->hidden->mixbuf);
     Uint8 *sample_buf = (Uint8 *) buffer;  // !!! FIXME: deal with this without casting away constness
     const int frame_size = SDL_AUDIO_FRAMESIZE(device->spec);
@@ -316,8 +346,57 @@ static int ALSA_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buf
     return 0;
 }
 
+static Uint8 *ALSA_GetMmapDeviceBuf(SDL_AudioDevice *device, int *buffer_size)
+{
+    snd_pcm_t *pcm_handle = device->hidden->pcm_handle;
+    snd_pcm_sframes_t avail = ALSA_snd_pcm_avail_update(pcm_handle);
+    if (avail < 0) {
+        const int status = ALSA_snd_pcm_recover(pcm_handle, (int) avail, 0);
+        if (status < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "ALSA: snd_pcm_avail_update failed (unrecoverable): %s", ALSA_snd_strerror((int) avail));
+            return NULL;
+        }
+        *buffer_size = 0;  // recovered; try again next time.
+        return NULL;
+    } else if (avail == 0) {
+        *buffer_size = 0;  // We'll catch it next time
+        return NULL;
+    }
+
+    const snd_pcm_channel_area_t *areas = NULL;
+    snd_pcm_uframes_t offset = 0;
+    snd_pcm_uframes_t frames = (snd_pcm_uframes_t) SDL_min(device->sample_frames, avail);
+    const int rc = ALSA_snd_pcm_mmap_begin(pcm_handle, &areas, &offset, &frames);
+    if (rc < 0) {
+        const int status = ALSA_snd_pcm_recover(pcm_handle, rc, 0);
+        if (status < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "ALSA: snd_pcm_mmap_begin failed (unrecoverable): %s", ALSA_snd_strerror(rc));
+            return NULL;
+        }
+        *buffer_size = 0;
+        return NULL;
+    } else if (frames == 0) {
+        ALSA_snd_pcm_mmap_commit(pcm_handle, offset, 0);
+        *buffer_size = 0;
+        return NULL;
+    }
+
+    // interleaved access means every channel shares the first area, one frame every `step` bits.
+    SDL_assert(areas[0].step == (unsigned int) (SDL_AUDIO_FRAMESIZE(device->spec) * 8));
+
+    // this may be less than a full period if the ring buffer wraps around; we'll get the rest next time.
+    device->hidden->mmap_offset = offset;
+    device->hidden->mmap_frames = frames;
+    *buffer_size = (int) frames * SDL_AUDIO_FRAMESIZE(device->spec);
+    return ((Uint8 *) areas[0].addr) + (areas[0].first / 8) + ((offset * areas[0].step) / 8);
+}
+
 static Uint8 *ALSA_GetDeviceBuf(SDL_AudioDevice *device, int *buffer_size)
 {
+    if (device->hidden->mmap_access) {
+        return ALSA_GetMmapDeviceBuf(device, buffer_size);
+    }
+
     snd_pcm_sframes_t rc = ALSA_snd_pcm_avail(device->hidden->pcm_handle);
     if (rc <= 0) {
         // Wait a bit and try again, maybe the hardware isn't quite ready yet?
@@ -467,9 +546,24 @@ static int ALSA_OpenDevice(SDL_AudioDevice *device)
         return SDL_SetError("ALSA: Couldn't get hardware config: %s", ALSA_snd_strerror(status));
     }
 
-    // SDL only uses interleaved sample output
-    status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
-                                               SND_PCM_ACCESS_RW_INTERLEAVED);
+    // SDL only uses interleaved sample output. For playback, prefer mmap access, so we can mix straight
+    //  into the ring buffer instead of copying through snd_pcm_writei, but not every device supports it.
+    status = -1;
+    if (!recording) {
+        snd_pcm_hw_params_t *mmap_hwparams = NULL;
+        snd_pcm_hw_params_alloca(&mmap_hwparams);
+        ALSA_snd_pcm_hw_params_copy(mmap_hwparams, hwparams);
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, mmap_hwparams, SND_PCM_ACCESS_MMAP_INTERLEAVED);
+        if (status >= 0) {
+            ALSA_snd_pcm_hw_params_copy(hwparams, mmap_hwparams);
+            device->hidden->mmap_access = SDL_TRUE;
+        }
+    }
+
+    if (status < 0) {
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
+                                                   SND_PCM_ACCESS_RW_INTERLEAVED);
+    }
     if (status < 0) {
         return SDL_SetError("ALSA: Couldn't set interleaved access: %s", ALSA_snd_strerror(status));
     }
@@ -602,8 +696,8 @@ static int ALSA_OpenDevice(SDL_AudioDevice *device)
     // Calculate the final parameters for this audio specification
     SDL_UpdatedAudioDeviceFormat(device);
 
-    // Allocate mixing buffer
-    if (!recording) {
+    // Allocate mixing buffer (mmap access mixes right into the device's ring buffer instead).
+    if (!recording && !device->hidden->mmap_access) {
         device->hidden->mixbuf = (Uint8 *)SDL_malloc(device->buffer_size);
         if (!device->hidden->mixbuf) {
             return -1;
@@ -35,6 +35,11 @@ struct SDL_PrivateAudioData
     // Raw mixing buffer
     Uint8 *mixbuf;
 
+    // SDL_TRUE if we mix straight into the mmap'd ring buffer instead of mixbuf.
+    SDL_bool mmap_access;
+    snd_pcm_uframes_t mmap_offset;
+    snd_pcm_uframes_t mmap_frames;
+
     // swizzle function
     void (*swizzle_func)(SDL_AudioDevice *_this, void *buffer, Uint32 bufferlen);
 };
@@ -696,6 +696,27 @@ static int PrepareDevice(SDL_AudioDevice *device)
 
     device->hidden->deviceID = devid;
 
+    /* Ask the HAL to run its IO cycle at our buffer size, so the queue isn't
+       handing our buffers to a device that only wakes up every 512+ frames.
+       This is clamped to what the device supports; errors are fine here. */
+    AudioValueRange range;
+    size = sizeof(range);
+    addr.mSelector = kAudioDevicePropertyBufferFrameSizeRange;
+    result = AudioObjectGetPropertyData(devid, &addr, 0, NULL, &size, &range);
+    if (result == noErr) {
+        UInt32 frames = (UInt32) device->sample_frames;
+        if (frames < (UInt32) range.mMinimum) {
+            frames = (UInt32) range.mMinimum;
+        } else if (frames > (UInt32) range.mMaximum) {
+            frames = (UInt32) range.mMaximum;
+        }
+        addr.mSelector = kAudioDevicePropertyBufferFrameSize;
+        result = AudioObjectSetPropertyData(devid, &addr, 0, NULL, sizeof(frames), &frames);
+        #if DEBUG_COREAUDIO
+        SDL_Log("COREAUDIO: Set hardware buffer frame size to %u (result %d)\n", (unsigned int) frames, (int) result);
+        #endif
+    }
+
     return 0;
 }
 
@@ -717,6 +738,31 @@ static int AssignDeviceToAudioQueue(SDL_AudioDevice *device)
     CHECK_RESULT("AudioQueueSetProperty (kAudioQueueProperty_CurrentDevice)");
     return 0;
 }
+
+// Latency the hardware and driver add past the audio queue, for SDL_GetAudioDeviceProperties. Some devices don't report this, so errors are fine here.
+static Uint64 GetHardwareLatencyNS(SDL_AudioDevice *device)
+{
+    AudioObjectPropertyAddress addr = {
+        kAudioDevicePropertyLatency,
+        device->recording ? kAudioDevicePropertyScopeInput : kAudioDevicePropertyScopeOutput,
+        kAudioObjectPropertyElementMain
+    };
+
+    UInt32 latency_frames = 0;
+    UInt32 safety_frames = 0;
+    UInt32 size = sizeof(latency_frames);
+    if (AudioObjectGetPropertyData(device->hidden->deviceID, &addr, 0, NULL, &size, &latency_frames) != noErr) {
+        latency_frames = 0;
+    }
+
+    addr.mSelector = kAudioDevicePropertySafetyOffset;
+    size = sizeof(safety_frames);
+    if (AudioObjectGetPropertyData(device->hidden->deviceID, &addr, 0, NULL, &size, &safety_frames) != noErr) {
+        safety_frames = 0;
+    }
+
+    return (((Uint64) latency_frames + safety_frames) * SDL_NS_PER_SECOND) / device->spec.freq;
+}
 #endif
 
 static int PrepareAudioQueue(SDL_AudioDevice *device)
@@ -794,6 +840,12 @@ static int PrepareAudioQueue(SDL_AudioDevice *device)
     }
 
     device->hidden->numAudioBuffers = numAudioBuffers;
+
+    // the queue holds the rest of the buffers ahead of the one being filled.
+    device->backend_latency_ns = (((Uint64) device->sample_frames) * (numAudioBuffers - 1) * SDL_NS_PER_SECOND) / device->spec.freq;
+    #ifdef MACOSX_COREAUDIO
+    device->backend_latency_ns += GetHardwareLatencyNS(device);
+    #endif
     device->hidden->audioBuffer = SDL_calloc(numAudioBuffers, sizeof(AudioQueueBufferRef));
     if (device->hidden->audioBuffer == NULL) {
         return -1;
@@ -873,6 +925,9 @@ static int COREAUDIO_OpenDevice(SDL_AudioDevice *device)
         AVAudioSession *session = [AVAudioSession sharedInstance];
         [session setPreferredSampleRate:device->spec.freq error:nil];
         device->spec.freq = (int)session.sampleRate;
+
+        // Ask for an IO cycle that matches our buffer size, so the hardware doesn't sit on a much larger buffer than we queue.
+        [session setPreferredIOBufferDuration:((NSTimeInterval)device->sample_frames) / ((NSTimeInterval)device->spec.freq) error:nil];
         #ifdef SDL_PLATFORM_TVOS
         if (device->recording) {
             [session setPreferredInputNumberOfChannels:device->spec.channels error:nil];
@@ -32,7 +32,18 @@
 
 static int DISKAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
-    SDL_Delay(device->hidden->io_delay);
+    struct SDL_PrivateAudioData *h = device->hidden;
+
+    if (h->io_delay) {
+        // Schedule against a deadline instead of sleeping a fixed amount, so
+        // time spent mixing doesn't make us drift slower than the requested rate.
+        const Uint64 now = SDL_GetTicksNS();
+        if (!h->next_io || (h->next_io + h->io_delay) < now) {
+            h->next_io = now;  // first buffer, or we fell more than a buffer behind.
+        }
+        h->next_io += h->io_delay;
+        SDL_DelayUntilNS(h->next_io);
+    }
     return 0;
 }
 
@@ -110,15 +121,15 @@ static int DISKAUDIO_OpenDevice(SDL_AudioDevice *device)
         return -1;
     }
 
-    device->hidden->io_delay = ((device->sample_frames * 1000) / device->spec.freq);
-
+    double scale = 1.0;
     const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DISK_TIMESCALE);
     if (hint) {
-        double scale = SDL_atof(hint);
-        if (scale >= 0.0) {
-            device->hidden->io_delay = (Uint32)SDL_round(device->hidden->io_delay * scale);
+        scale = SDL_atof(hint);
+        if (scale < 0.0) {
+            scale = 1.0;
         }
     }
+    device->hidden->io_delay = (Uint64)SDL_round(((double)device->sample_frames * SDL_NS_PER_SECOND * scale) / device->spec.freq);
 
     // Open the "audio device"
     device->hidden->io = SDL_IOFromFile(fname, recording ? "rb" : "wb");
@@ -29,7 +29,8 @@ struct SDL_PrivateAudioData
 {
     // The file descriptor for the audio device
     SDL_IOStream *io;
-    Uint32 io_delay;
+    Uint64 io_delay; // nanoseconds between buffers, or 0 to run as fast as possible.
+    Uint64 next_io;  // when the next buffer is due, in SDL_GetTicksNS() time.
     Uint8 *mixbuf;
 };
 
@@ -28,7 +28,8 @@
 struct SDL_PrivateAudioData
 {
     Uint8 *mixbuf;   // The file descriptor for the audio device
-    Uint32 io_delay; // miliseconds to sleep in WaitDevice.
+    Uint64 io_delay; // nanoseconds between buffers, or 0 to run as fast as possible.
+    Uint64 next_io;  // when the next buffer is due, in SDL_GetTicksNS() time.
 };
 
 #endif // SDL_dummyaudio_h_
@@ -23,9 +23,20 @@
 #ifdef SDL_AUDIO_DRIVER_EMSCRIPTEN
 
 #include "../SDL_sysaudio.h"
+#include "../../SDL_utils_c.h"
 #include "SDL_emscriptenaudio.h"
 
 #include <emscripten/emscripten.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/threading.h>
+#include <errno.h>
+#endif
+
+// When the wasm heap is a SharedArrayBuffer and the browser has AudioWorklet, SDL mixes on its own audio
+//  thread into a ring buffer in the heap, and an AudioWorkletProcessor on the browser's audio rendering
+//  thread reads (or, for recording, writes) it directly, one 128-frame render quantum at a time. Otherwise
+//  we fall back to ScriptProcessorNode callbacks on the main thread.
+static SDL_bool EMSCRIPTENAUDIO_use_worklet = SDL_FALSE;
 
 // just turn off clang-format for this whole file, this INDENT_OFF stuff on
 //  each EM_ASM section is ugly.
@@ -88,14 +99,265 @@ static int EMSCRIPTENAUDIO_RecordDevice(SDL_AudioDevice *device, void *buffer, i
     return buflen;
 }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+
+static double EMSCRIPTENAUDIO_GetBufferMS(SDL_AudioDevice *device)
+{
+    return SDL_max(((double)device->sample_frames * 1000.0) / device->spec.freq, 10.0);
+}
+
+static int EMSCRIPTENAUDIO_GetQueuedFrames(SDL_AudioDevice *device)
+{
+    SDL_AtomicInt *positions = device->hidden->ring_positions;
+    const Uint32 read = (Uint32)SDL_AtomicGet(&positions[EMSCRIPTENAUDIO_RING_READ]);
+    const Uint32 write = (Uint32)SDL_AtomicGet(&positions[EMSCRIPTENAUDIO_RING_WRITE]);
+    return (int)(write - read);
+}
+
+static int EMSCRIPTENAUDIO_WaitWorkletDevice(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const int index = device->recording ? EMSCRIPTENAUDIO_RING_WRITE : EMSCRIPTENAUDIO_RING_READ;
+    const double timeout = EMSCRIPTENAUDIO_GetBufferMS(device);
+
+    while (!SDL_AtomicGet(&device->shutdown)) {
+        const int value = SDL_AtomicGet(&hidden->ring_positions[index]);
+        const int queued = EMSCRIPTENAUDIO_GetQueuedFrames(device);
+        if (device->recording ? (queued >= device->sample_frames) : ((hidden->ring_frames - queued) >= device->sample_frames)) {
+            break;
+        }
+
+        // The worklet wakes us up after every render quantum it processes.
+        if (emscripten_futex_wait(&hidden->ring_positions[index].value, (uint32_t)value, timeout) == -ETIMEDOUT) {
+            break;  // the browser isn't running the worklet (autoplay blocked, etc), carry on so the app makes progress.
+        }
+    }
+    return 0;
+}
+
+static int EMSCRIPTENAUDIO_PlayWorkletDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const int channels = device->spec.channels;
+    const int write = SDL_AtomicGet(&hidden->ring_positions[EMSCRIPTENAUDIO_RING_WRITE]);
+    const int offset = write & (hidden->ring_frames - 1);
+    const float *src = (const float *)buffer;
+    int frames = buffer_size / (int)SDL_AUDIO_FRAMESIZE(device->spec);
+    int first;
+
+    // if the worklet isn't running, drop whatever doesn't fit.
+    frames = SDL_min(frames, hidden->ring_frames - EMSCRIPTENAUDIO_GetQueuedFrames(device));
+    first = SDL_min(frames, hidden->ring_frames - offset);
+    SDL_memcpy(&hidden->ring[offset * channels], src, first * channels * sizeof(float));
+    SDL_memcpy(hidden->ring, &src[first * channels], (frames - first) * channels * sizeof(float));
+
+    SDL_AtomicSet(&hidden->ring_positions[EMSCRIPTENAUDIO_RING_WRITE], (int)((Uint32)write + frames));
+    return 0;
+}
+
+static void EMSCRIPTENAUDIO_FlushWorkletRecording(SDL_AudioDevice *device)
+{
+    SDL_AtomicInt *positions = device->hidden->ring_positions;
+    SDL_AtomicSet(&positions[EMSCRIPTENAUDIO_RING_READ], SDL_AtomicGet(&positions[EMSCRIPTENAUDIO_RING_WRITE]));
+}
+
+static int EMSCRIPTENAUDIO_RecordWorkletDevice(SDL_AudioDevice *device, void *buffer, int buflen)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const int channels = device->spec.channels;
+    const int read = SDL_AtomicGet(&hidden->ring_positions[EMSCRIPTENAUDIO_RING_READ]);
+    const int offset = read & (hidden->ring_frames - 1);
+    float *dst = (float *)buffer;
+    const int framesize = (int)SDL_AUDIO_FRAMESIZE(device->spec);
+    int frames = SDL_min(buflen / framesize, EMSCRIPTENAUDIO_GetQueuedFrames(device));
+    int first;
+
+    if (frames == 0) {
+        // the worklet isn't running, feed silence so the app makes progress.
+        SDL_memset(buffer, device->silence_value, buflen);
+        return buflen;
+    }
+
+    first = SDL_min(frames, hidden->ring_frames - offset);
+    SDL_memcpy(dst, &hidden->ring[offset * channels], first * channels * sizeof(float));
+    SDL_memcpy(&dst[first * channels], hidden->ring, (frames - first) * channels * sizeof(float));
+
+    SDL_AtomicSet(&hidden->ring_positions[EMSCRIPTENAUDIO_RING_READ], (int)((Uint32)read + frames));
+    return frames * framesize;
+}
+
+// Tell the worklet to stop touching the ring, and wait for it to let go. Returns SDL_FALSE if it never answered.
+static SDL_bool EMSCRIPTENAUDIO_StopWorklet(SDL_AudioDevice *device)
+{
+    SDL_AtomicInt *state = &device->hidden->ring_positions[EMSCRIPTENAUDIO_RING_STATE];
+    int tries;
+
+    for (tries = 0; tries < 10; ++tries) {
+        if (SDL_AtomicGet(state) == 2) {
+            return SDL_TRUE;
+        }
+        emscripten_futex_wait(&state->value, 1, EMSCRIPTENAUDIO_GetBufferMS(device));
+    }
+    return (SDL_AtomicGet(state) == 2);
+}
+
+static int EMSCRIPTENAUDIO_OpenWorkletDevice(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+
+    hidden->ring_frames = SDL_powerof2(device->sample_frames * 2);
+    hidden->ring = (float *)SDL_calloc(hidden->ring_frames * device->spec.channels, sizeof(float));
+    hidden->ring_positions = (SDL_AtomicInt *)SDL_calloc(3, sizeof(SDL_AtomicInt));
+    if (!hidden->ring || !hidden->ring_positions) {
+        return -1;
+    }
+
+    MAIN_THREAD_EM_ASM({
+        var SDL3 = Module['SDL3'];
+        var recording = $0;
+        var state = recording ? SDL3.audio_recording : SDL3.audio_playback;
+
+        if (SDL3.audioWorkletModule === undefined) {
+            // This runs on the audio rendering thread, it only sees the shared heap and its options.
+            var processor = function() {
+                class SDL3AudioProcessor extends AudioWorkletProcessor {
+                    constructor(options) {
+                        super();
+                        var opts = options['processorOptions'];
+                        this.recording = opts['recording'];
+                        this.channels = opts['channels'];
+                        this.mask = opts['frames'] - 1;
+                        this.samples = new Float32Array(opts['memory'], opts['samples'], opts['frames'] * opts['channels']);
+                        this.positions = new Int32Array(opts['memory'], opts['positions'], 3);
+                        this.closed = false;
+                    }
+
+                    process(inputs, outputs) {
+                        var positions = this.positions;
+                        if (this.closed) {
+                            return false;
+                        }
+                        if (Atomics.load(positions, 2) !== 0) {
+                            this.closed = true;  // SDL is closing the device, never touch the ring again.
+                            Atomics.store(positions, 2, 2);
+                            Atomics.notify(positions, 2);
+                            return false;
+                        }
+
+                        var channels = this.channels;
+                        var mask = this.mask;
+                        var samples = this.samples;
+                        var read = Atomics.load(positions, 0);
+                        var write = Atomics.load(positions, 1);
+                        var output = outputs[0];
+                        var frames = output[0].length;
+                        var i, c;
+
+                        if (this.recording) {
+                            var input = inputs[0];
+                            frames = Math.min(frames, (mask + 1) - ((write - read) | 0));
+                            for (i = 0; i < frames; ++i) {
+                                var j = ((write + i) & mask) * channels;
+                                for (c = 0; c < channels; ++c) {
+                                    samples[j + c] = (input.length > 0) ? input[Math.min(c, input.length - 1)][i] : 0.0;
+                                }
+                            }
+                            Atomics.store(positions, 1, (write + frames) | 0);
+                            Atomics.notify(positions, 1);
+                        } else {
+                            frames = Math.min(frames, (write - read) | 0);
+                            for (c = 0; c < output.length; ++c) {
+                                var channel = output[c];
+                                for (i = 0; i < frames; ++i) {
+                                    channel[i] = samples[(((read + i) & mask) * channels) + c];
+                                }
+                                channel.fill(0.0, frames);
+                            }
+                            Atomics.store(positions, 0, (read + frames) | 0);
+                            Atomics.notify(positions, 0);
+                        }
+                        return true;
+                    }
+                }
+                registerProcessor('SDL3AudioProcessor', SDL3AudioProcessor);
+            };
+            var url = URL.createObjectURL(new Blob(['(' + processor.toString() + ')();'], { type: 'text/javascript' }));
+            SDL3.audioWorkletModule = SDL3.audioContext['audioWorklet']['addModule'](url);
+        }
+
+        SDL3.audioWorkletModule.then(function() {
+            if ((recording ? SDL3.audio_recording : SDL3.audio_playback) !== state) {
+                return;  // closed while the module was loading.
+            }
+            var node = new AudioWorkletNode(SDL3.audioContext, 'SDL3AudioProcessor', {
+                'numberOfInputs': recording ? 1 : 0,
+                'numberOfOutputs': 1,
+                'outputChannelCount': [recording ? 1 : $1],
+                'processorOptions': { 'recording': recording, 'channels': $1, 'frames': $2, 'memory': HEAPU8.buffer, 'samples': $3, 'positions': $4 }
+            });
+            state.workletNode = node;
+            node['connect'](SDL3.audioContext['destination']);  // recording only outputs silence, but this keeps it running.
+
+            if (recording) {
+                // until the user allows the microphone, the worklet records silence.
+                var have_microphone = function(stream) {
+                    if (SDL3.audio_recording !== state) {
+                        return;
+                    }
+                    state.mediaStreamNode = SDL3.audioContext.createMediaStreamSource(stream);
+                    state.mediaStreamNode.connect(node);
+                    state.stream = stream;
+                };
+                var no_microphone = function(error) {
+                };
+                if ((navigator.mediaDevices !== undefined) && (navigator.mediaDevices.getUserMedia !== undefined)) {
+                    navigator.mediaDevices.getUserMedia({ audio: true, video: false }).then(have_microphone).catch(no_microphone);
+                } else if (navigator.webkitGetUserMedia !== undefined) {
+                    navigator.webkitGetUserMedia({ audio: true, video: false }, have_microphone, no_microphone);
+                }
+            }
+        });
+
+        if ((SDL3.audioContext.state === 'suspended') && ((typeof navigator.userActivation) !== 'undefined')) {  // uhoh, autoplay is blocked.
+            state.resumeTimer = setInterval(function() {
+                if (SDL3.audioContext.state !== 'suspended') {
+                    clearInterval(state.resumeTimer);
+                    state.resumeTimer = undefined;
+                } else if (navigator.userActivation.hasBeenActive) {
+                    SDL3.audioContext.resume();
+                }
+            }, 100);
+        }
+    }, device->recording, device->spec.channels, hidden->ring_frames, hidden->ring, hidden->ring_positions);
+
+    return 0;
+}
+
+#endif // __EMSCRIPTEN_PTHREADS__
+
 static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
 {
     if (!device->hidden) {
         return;
     }
 
-    MAIN_THREAD_EM_ASM({
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (device->hidden->ring_positions) {
+        SDL_AtomicSet(&device->hidden->ring_positions[EMSCRIPTENAUDIO_RING_STATE], 1);
+    }
+#endif
+
+    const int had_worklet = MAIN_THREAD_EM_ASM_INT({
         var SDL3 = Module['SDL3'];
+        var state = $0 ? SDL3.audio_recording : SDL3.audio_playback;
+        var had_worklet = 0;
+        if (state.resumeTimer !== undefined) {
+            clearInterval(state.resumeTimer);
+        }
+        if (state.workletNode !== undefined) {
+            state.workletNode.disconnect();
+            had_worklet = 1;
+        }
         if ($0) {
             if (SDL3.audio_recording.silenceTimer !== undefined) {
                 clearInterval(SDL3.audio_recording.silenceTimer);
@@ -126,9 +388,22 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
         if ((SDL3.audioContext !== undefined) && (SDL3.audio_playback === undefined) && (SDL3.audio_recording === undefined)) {
             SDL3.audioContext.close();
             SDL3.audioContext = undefined;
+            SDL3.audioWorkletModule = undefined;
         }
+        return had_worklet;
     }, device->recording);
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (had_worklet && !EMSCRIPTENAUDIO_StopWorklet(device)) {
+        // The browser might still run the worklet later, so leave its memory alone.
+        device->hidden->ring = NULL;
+        device->hidden->ring_positions = NULL;
+    }
+    SDL_free(device->hidden->ring);
+    SDL_free(device->hidden->ring_positions);
+#else
+    (void)had_worklet;
+#endif
     SDL_free(device->hidden->mixbuf);
     SDL_free(device->hidden);
     device->hidden = NULL;
@@ -194,6 +469,12 @@ static int EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
         SDL_memset(device->hidden->mixbuf, device->silence_value, device->buffer_size);
     }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (EMSCRIPTENAUDIO_use_worklet) {
+        return EMSCRIPTENAUDIO_OpenWorkletDevice(device);
+    }
+#endif
+
     if (device->recording) {
         /* The idea is to take the recording media stream, hook it up to an
            audio graph where we can pass it through a ScriptProcessorNode
@@ -313,6 +594,21 @@ static SDL_bool EMSCRIPTENAUDIO_Init(SDL_AudioDriverImpl *impl)
     // technically, this is just runs in idle time in the main thread, but it's close enough to a "thread" for our purposes.
     impl->ProvidesOwnCallbackThread = SDL_TRUE;
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    EMSCRIPTENAUDIO_use_worklet = MAIN_THREAD_EM_ASM_INT({
+        return ((typeof(AudioWorkletNode) !== 'undefined') && (typeof(SharedArrayBuffer) !== 'undefined') && (HEAPU8.buffer instanceof SharedArrayBuffer));
+    });
+    if (EMSCRIPTENAUDIO_use_worklet) {
+        // mix on a real SDL audio thread, the worklet pulls from it.
+        impl->ProvidesOwnCallbackThread = SDL_FALSE;
+        impl->WaitDevice = EMSCRIPTENAUDIO_WaitWorkletDevice;
+        impl->WaitRecordingDevice = EMSCRIPTENAUDIO_WaitWorkletDevice;
+        impl->PlayDevice = EMSCRIPTENAUDIO_PlayWorkletDevice;
+        impl->FlushRecording = EMSCRIPTENAUDIO_FlushWorkletRecording;
+        impl->RecordDevice = EMSCRIPTENAUDIO_RecordWorkletDevice;
+    }
+#endif
+
     // check availability
     available = MAIN_THREAD_EM_ASM_INT({
         if (typeof(AudioContext) !== 'undefined') {
@@ -25,9 +25,21 @@
 
 #include "../SDL_sysaudio.h"
 
+// Indices into the frame counters shared with the AudioWorklet
+#define EMSCRIPTENAUDIO_RING_READ   0
+#define EMSCRIPTENAUDIO_RING_WRITE  1
+#define EMSCRIPTENAUDIO_RING_STATE  2
+
 struct SDL_PrivateAudioData
 {
     Uint8 *mixbuf;
+
+    // Interleaved samples shared with the AudioWorklet, a power of two frames long
+    float *ring;
+    int ring_frames;
+
+    // Frames read and written so far (wrapping), and the close handshake state
+    SDL_AtomicInt *ring_positions;
 };
 
 #endif // SDL_emscriptenaudio_h_
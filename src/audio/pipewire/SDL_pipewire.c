@@ -52,6 +52,9 @@ enum PW_READY_FLAGS
 
 static SDL_bool pipewire_initialized = SDL_FALSE;
 
+// pw_buffer::requested (the frames the graph wants this cycle) showed up in libpipewire 0.3.49.
+static SDL_bool pipewire_buffer_has_requested = SDL_FALSE;
+
 // Pipewire entry points
 static const char *(*PIPEWIRE_pw_get_library_version)(void);
 static void (*PIPEWIRE_pw_init)(int *, char ***);
@@ -85,6 +88,7 @@ static int (*PIPEWIRE_pw_stream_connect)(struct pw_stream *, enum pw_direction,
 static enum pw_stream_state (*PIPEWIRE_pw_stream_get_state)(struct pw_stream *stream, const char **error);
 static struct pw_buffer *(*PIPEWIRE_pw_stream_dequeue_buffer)(struct pw_stream *);
 static int (*PIPEWIRE_pw_stream_queue_buffer)(struct pw_stream *, struct pw_buffer *);
+static int (*PIPEWIRE_pw_stream_get_time)(struct pw_stream *, struct pw_time *);
 static struct pw_properties *(*PIPEWIRE_pw_properties_new)(const char *, ...)SPA_SENTINEL;
 static int (*PIPEWIRE_pw_properties_set)(struct pw_properties *, const char *, const char *);
 static int (*PIPEWIRE_pw_properties_setf)(struct pw_properties *, const char *, const char *, ...) SPA_PRINTF_FUNC(3, 4);
@@ -172,6 +176,7 @@ static int load_pipewire_syms(void)
     SDL_PIPEWIRE_SYM(pw_stream_get_state);
     SDL_PIPEWIRE_SYM(pw_stream_dequeue_buffer);
     SDL_PIPEWIRE_SYM(pw_stream_queue_buffer);
+    SDL_PIPEWIRE_SYM(pw_stream_get_time);
     SDL_PIPEWIRE_SYM(pw_properties_new);
     SDL_PIPEWIRE_SYM(pw_properties_set);
     SDL_PIPEWIRE_SYM(pw_properties_setf);
@@ -183,6 +188,12 @@ static int init_pipewire_library(void)
 {
     if (!load_pipewire_library()) {
         if (!load_pipewire_syms()) {
+            int major = 0, minor = 0, patch = 0;
+            const char *version = PIPEWIRE_pw_get_library_version();
+            if (version && (SDL_sscanf(version, "%d.%d.%d", &major, &minor, &patch) == 3)) {
+                pipewire_buffer_has_requested = (major > 0) || (minor > 3) || ((minor == 3) && (patch >= 49));
+            }
+
             PIPEWIRE_pw_init(NULL, NULL);
             return 0;
         }
@@ -916,6 +927,18 @@ static Uint8 *PIPEWIRE_GetDeviceBuf(SDL_AudioDevice *device, int *buffer_size)
         return NULL;
     }
 
+    // Never write more than the buffer holds, and follow the graph's quantum: if it wants fewer frames
+    // than our period this cycle, only render that many so we don't pile up latency in the stream.
+    *buffer_size = SDL_min(*buffer_size, (int) spa_buf->datas[0].maxsize);
+#if PW_CHECK_VERSION(0, 3, 49)
+    if (pipewire_buffer_has_requested && (pw_buf->requested > 0)) {
+        const Uint64 requested = pw_buf->requested * (Uint64) device->hidden->stride;
+        if (requested < (Uint64) *buffer_size) {
+            *buffer_size = (int) requested;
+        }
+    }
+#endif
+
     device->hidden->pw_buf = pw_buf;
     return (Uint8 *) spa_buf->datas[0].data;
 }
@@ -925,6 +948,8 @@ static int PIPEWIRE_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int
     struct pw_stream *stream = device->hidden->stream;
     struct pw_buffer *pw_buf = device->hidden->pw_buf;
     struct spa_buffer *spa_buf = pw_buf->buffer;
+    struct pw_time time;
+
     spa_buf->datas[0].chunk->offset = 0;
     spa_buf->datas[0].chunk->stride = device->hidden->stride;
     spa_buf->datas[0].chunk->size = buffer_size;
@@ -932,6 +957,11 @@ static int PIPEWIRE_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int
     PIPEWIRE_pw_stream_queue_buffer(stream, pw_buf);
     device->hidden->pw_buf = NULL;
 
+    // the graph's delay is how long until the buffer we just queued reaches the device.
+    if ((PIPEWIRE_pw_stream_get_time(stream, &time) == 0) && (time.rate.denom != 0)) {
+        device->backend_latency_ns = (time.delay > 0) ? ((((Uint64) time.delay) * time.rate.num * SDL_NS_PER_SECOND) / time.rate.denom) : 0;
+    }
+
     return 0;
 }
 
@@ -127,6 +127,9 @@ static int (*PULSEAUDIO_pa_stream_disconnect)(pa_stream *);
 static void (*PULSEAUDIO_pa_stream_unref)(pa_stream *);
 static void (*PULSEAUDIO_pa_stream_set_write_callback)(pa_stream *, pa_stream_request_cb_t, void *);
 static void (*PULSEAUDIO_pa_stream_set_read_callback)(pa_stream *, pa_stream_request_cb_t, void *);
+static void (*PULSEAUDIO_pa_stream_set_underflow_callback)(pa_stream *, pa_stream_notify_cb_t, void *);
+static void (*PULSEAUDIO_pa_stream_set_overflow_callback)(pa_stream *, pa_stream_notify_cb_t, void *);
+static int (*PULSEAUDIO_pa_stream_get_latency)(pa_stream *, pa_usec_t *, int *);
 static pa_operation *(*PULSEAUDIO_pa_context_get_server_info)(pa_context *, pa_server_info_cb_t, void *);
 
 static int load_pulseaudio_syms(void);
@@ -241,6 +244,9 @@ static int load_pulseaudio_syms(void)
     SDL_PULSEAUDIO_SYM(pa_strerror);
     SDL_PULSEAUDIO_SYM(pa_stream_set_write_callback);
     SDL_PULSEAUDIO_SYM(pa_stream_set_read_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_underflow_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_overflow_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_get_latency);
     SDL_PULSEAUDIO_SYM(pa_context_get_server_info);
     SDL_PULSEAUDIO_SYM(pa_proplist_new);
     SDL_PULSEAUDIO_SYM(pa_proplist_free);
@@ -434,8 +440,12 @@ static int PULSEAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, i
 
     SDL_assert(h->bytes_requested >= buffer_size);
 
+    pa_usec_t latency_usec = 0;
+    int negative = 0;
+
     PULSEAUDIO_pa_threaded_mainloop_lock(pulseaudio_threaded_mainloop);
     const int rc = PULSEAUDIO_pa_stream_write(h->stream, buffer, buffer_size, NULL, 0LL, PA_SEEK_RELATIVE);
+    const int latency_rc = (rc < 0) ? -1 : PULSEAUDIO_pa_stream_get_latency(h->stream, &latency_usec, &negative);
     PULSEAUDIO_pa_threaded_mainloop_unlock(pulseaudio_threaded_mainloop);
 
     if (rc < 0) {
@@ -445,6 +455,13 @@ static int PULSEAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, i
     //SDL_Log("PULSEAUDIO FEED! nbytes=%d", buffer_size);
     h->bytes_requested -= buffer_size;
 
+    // Pulse's latency counts everything between here and the speaker, which includes the device buffer SDL already accounts for.
+    if ((latency_rc == 0) && !negative) {
+        const Uint64 latency_ns = SDL_US_TO_NS(latency_usec);
+        const Uint64 buffer_ns = (((Uint64) device->sample_frames) * SDL_NS_PER_SECOND) / device->spec.freq;
+        device->backend_latency_ns = (latency_ns > buffer_ns) ? (latency_ns - buffer_ns) : 0;
+    }
+
     //SDL_Log("PULSEAUDIO PLAYDEVICE END! written=%d", written);
     return 0;
 }
@@ -586,6 +603,12 @@ static void PULSEAUDIO_CloseDevice(SDL_AudioDevice *device)
     SDL_free(device->hidden);
 }
 
+static void PulseStreamXrunCallback(pa_stream *stream, void *userdata)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *) userdata;
+    SDL_AtomicIncRef(&device->xruns);
+}
+
 static void PulseStreamStateChangeCallback(pa_stream *stream, void *userdata)
 {
     PULSEAUDIO_pa_threaded_mainloop_signal(pulseaudio_threaded_mainloop, 0);  // just signal any waiting code, it can look up the details.
@@ -674,6 +697,7 @@ static int PULSEAUDIO_OpenDevice(SDL_AudioDevice *device)
     paattr.maxlength = -1;
     paattr.minreq = -1;
     flags |= PA_STREAM_ADJUST_LATENCY;
+    flags |= PA_STREAM_AUTO_TIMING_UPDATE | PA_STREAM_INTERPOLATE_TIMING;  // so pa_stream_get_latency doesn't have to ask the server.
 
     PULSEAUDIO_pa_threaded_mainloop_lock(pulseaudio_threaded_mainloop);
 
@@ -702,11 +726,14 @@ static int PULSEAUDIO_OpenDevice(SDL_AudioDevice *device)
         const char *device_path = ((PulseDeviceHandle *) device->handle)->device_path;
         if (recording) {
             PULSEAUDIO_pa_stream_set_read_callback(h->stream, ReadCallback, h);
+            PULSEAUDIO_pa_stream_set_overflow_callback(h->stream, PulseStreamXrunCallback, device);
             rc = PULSEAUDIO_pa_stream_connect_record(h->stream, device_path, &paattr, flags);
         } else {
             PULSEAUDIO_pa_stream_set_write_callback(h->stream, WriteCallback, h);
+            PULSEAUDIO_pa_stream_set_underflow_callback(h->stream, PulseStreamXrunCallback, device);
             rc = PULSEAUDIO_pa_stream_connect_playback(h->stream, device_path, &paattr, flags, NULL, NULL);
         }
+        device->backend_reports_xruns = SDL_TRUE;
 
         if (rc < 0) {
             retval = SDL_SetError("Could not connect PulseAudio stream");
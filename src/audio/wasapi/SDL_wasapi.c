@@ -526,6 +526,10 @@ static int WASAPI_RecordDevice(SDL_AudioDevice *device, void *buffer, int buflen
             const int leftover = total - cpy;
             const SDL_bool silent = (flags & AUDCLNT_BUFFERFLAGS_SILENT) ? SDL_TRUE : SDL_FALSE;
 
+            if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) {
+                SDL_AtomicIncRef(&device->xruns);  // we didn't read fast enough and the endpoint dropped data.
+            }
+
             SDL_assert(leftover == 0);  // according to MSDN, this isn't everything available, just one "packet" of data per-GetBuffer call.
 
             if (silent) {
@@ -679,6 +683,9 @@ static int mgmtthrtask_PrepDevice(void *userdata)
                 if (SUCCEEDED(ret)) {
                     new_sample_frames = (int)period_in_frames;
                     iaudioclient3_initialized = SDL_TRUE;
+                    device->hidden->low_latency = (period_in_frames < default_period_in_frames);
+                    SDL_LogDebug(SDL_LOG_CATEGORY_AUDIO, "WASAPI: shared engine period %u frames (default %u, min %u, max %u)",
+                                 (unsigned int) period_in_frames, (unsigned int) default_period_in_frames, (unsigned int) min_period_in_frames, (unsigned int) max_period_in_frames);
                 }
             }
 
@@ -705,6 +712,12 @@ static int mgmtthrtask_PrepDevice(void *userdata)
         return WIN_SetErrorFromHRESULT("WASAPI can't determine buffer size", ret);
     }
 
+    // This is the latency of the stream past the buffer we fill, in 100-nanosecond units. It's just for reporting, so failure isn't fatal.
+    REFERENCE_TIME stream_latency = 0;
+    if (SUCCEEDED(IAudioClient_GetStreamLatency(client, &stream_latency)) && (stream_latency > 0)) {
+        device->backend_latency_ns = ((Uint64) stream_latency) * 100;
+    }
+
     // Match the callback size to the period size to cut down on the number of
     // interrupts waited for in each call to WaitDevice
     if (new_sample_frames <= 0) {
@@ -734,6 +747,7 @@ static int mgmtthrtask_PrepDevice(void *userdata)
 
         SDL_assert(capture != NULL);
         device->hidden->capture = capture;
+        device->backend_reports_xruns = SDL_TRUE;
         ret = IAudioClient_Start(client);
         if (FAILED(ret)) {
             return WIN_SetErrorFromHRESULT("WASAPI can't start capture", ret);
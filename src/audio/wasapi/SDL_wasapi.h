@@ -38,6 +38,7 @@ struct SDL_PrivateAudioData
     IAudioCaptureClient *capture;
     HANDLE event;
     HANDLE task;
+    SDL_bool low_latency;  // SDL_TRUE if IAudioClient3 gave us an engine period below the default one.
     SDL_bool coinitialized;
     int framesize;
     SDL_bool device_lost;
@@ -40,8 +40,12 @@
 static HMODULE libavrt = NULL;
 typedef HANDLE(WINAPI *pfnAvSetMmThreadCharacteristicsW)(LPCWSTR, LPDWORD);
 typedef BOOL(WINAPI *pfnAvRevertMmThreadCharacteristics)(HANDLE);
+typedef BOOL(WINAPI *pfnAvSetMmThreadPriority)(HANDLE, int);
 static pfnAvSetMmThreadCharacteristicsW pAvSetMmThreadCharacteristicsW = NULL;
 static pfnAvRevertMmThreadCharacteristics pAvRevertMmThreadCharacteristics = NULL;
+static pfnAvSetMmThreadPriority pAvSetMmThreadPriority = NULL;
+
+#define SDL_AVRT_PRIORITY_CRITICAL 2  // AVRT_PRIORITY_CRITICAL from avrt.h
 
 static SDL_bool immdevice_initialized = SDL_FALSE;
 
@@ -97,6 +101,7 @@ int WASAPI_PlatformInit(void)
     if (libavrt) {
         pAvSetMmThreadCharacteristicsW = (pfnAvSetMmThreadCharacteristicsW)GetProcAddress(libavrt, "AvSetMmThreadCharacteristicsW");
         pAvRevertMmThreadCharacteristics = (pfnAvRevertMmThreadCharacteristics)GetProcAddress(libavrt, "AvRevertMmThreadCharacteristics");
+        pAvSetMmThreadPriority = (pfnAvSetMmThreadPriority)GetProcAddress(libavrt, "AvSetMmThreadPriority");
     }
 
     return 0;
@@ -119,6 +124,7 @@ void WASAPI_PlatformDeinit(void)
 
     pAvSetMmThreadCharacteristicsW = NULL;
     pAvRevertMmThreadCharacteristics = NULL;
+    pAvSetMmThreadPriority = NULL;
 
     StopWasapiHotplug();
 
@@ -141,8 +147,13 @@ void WASAPI_PlatformThreadInit(SDL_AudioDevice *device)
     if (pAvSetMmThreadCharacteristicsW) {
         DWORD idx = 0;
         device->hidden->task = pAvSetMmThreadCharacteristicsW(L"Pro Audio", &idx);
-    } else {
+    }
+
+    if (!device->hidden->task) {  // no MMCSS, or it refused us? Do the best we can.
         SDL_SetThreadPriority(device->recording ? SDL_THREAD_PRIORITY_HIGH : SDL_THREAD_PRIORITY_TIME_CRITICAL);
+    } else if (device->hidden->low_latency && pAvSetMmThreadPriority) {
+        // a short engine period leaves little slack per wakeup, so ask MMCSS to schedule us ahead of other pro audio work.
+        pAvSetMmThreadPriority(device->hidden->task, SDL_AVRT_PRIORITY_CRITICAL);
     }
 
 }
@@ -252,6 +252,7 @@ static void ClosePhysicalCamera(SDL_Camera *device)
     camera_driver.impl.CloseDevice(device);
 
     SDL_DestroyProperties(device->props);
+    device->props = 0;
 
     SDL_DestroySurface(device->acquire_surface);
     device->acquire_surface = NULL;
@@ -273,6 +274,8 @@ static void ClosePhysicalCamera(SDL_Camera *device)
 
     device->base_timestamp = 0;
     device->adjust_timestamp = 0;
+    device->dropped_frames = 0;
+    device->late_frames = 0;
 }
 
 // this must not be called while `device` is still in a device list, or while a device's camera thread is still running.
@@ -780,10 +783,64 @@ void SDL_CameraThreadSetup(SDL_Camera *device)
     }*/
 #else
     // The camera capture is always a high priority thread
-    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+    SDL_SetDeviceThreadPriority(SDL_THREAD_PRIORITY_HIGH);
 #endif
 }
 
+// must be called with device->lock held!
+static SDL_PropertiesID GetCameraPropertiesLocked(SDL_Camera *device)
+{
+    if (device->props == 0) {
+        device->props = SDL_CreateProperties();
+    }
+    return device->props;
+}
+
+// must be called with device->lock held!
+static void CountDroppedCameraFrame(SDL_Camera *device)
+{
+    device->dropped_frames++;
+    SDL_SetNumberProperty(GetCameraPropertiesLocked(device), SDL_PROP_CAMERA_DROPPED_FRAMES_NUMBER, (Sint64) device->dropped_frames);
+}
+
+// must be called with device->lock held! Returns SDL_TRUE if there's room in the queue for a new frame.
+static SDL_bool MakeRoomForCameraFrame(SDL_Camera *device)
+{
+    const SDL_PropertiesID props = device->props;
+    const int max_depth = (int) SDL_arraysize(device->output_surfaces);
+    const int depth = SDL_clamp((int) SDL_GetNumberProperty(props, SDL_PROP_CAMERA_FRAME_QUEUE_DEPTH_NUMBER, max_depth), 1, max_depth);
+
+    // frames are in this list from newest to oldest.
+    int queued = 0;
+    SurfaceList *oldestprev = &device->filled_output_surfaces;
+    for (SurfaceList *i = device->filled_output_surfaces.next; i != NULL; i = i->next) {
+        queued++;
+        if (i->next) {
+            oldestprev = i;
+        }
+    }
+
+    if ((queued < depth) && (device->empty_output_surfaces.next != NULL)) {
+        return SDL_TRUE;  // plenty of room.
+    } else if ((queued == 0) || !SDL_GetBooleanProperty(props, SDL_PROP_CAMERA_DROP_OLDEST_BOOLEAN, SDL_FALSE)) {
+        return SDL_FALSE;  // either the app is holding every surface, or the app wants us to drop the new frame.
+    }
+
+    // drop the oldest frame the app hasn't claimed yet and recycle its surface.
+    SurfaceList *oldest = oldestprev->next;
+    oldestprev->next = NULL;
+    if (!device->needs_conversion && !device->needs_scaling) {
+        device->ReleaseFrame(device, oldest->surface);
+        oldest->surface->pixels = NULL;
+        oldest->surface->pitch = 0;
+    }
+    oldest->timestampNS = 0;
+    oldest->next = device->empty_output_surfaces.next;
+    device->empty_output_surfaces.next = oldest;
+    CountDroppedCameraFrame(device);
+    return SDL_TRUE;
+}
+
 SDL_bool SDL_CameraThreadIterate(SDL_Camera *device)
 {
     SDL_LockMutex(device->lock);
@@ -799,6 +856,8 @@ SDL_bool SDL_CameraThreadIterate(SDL_Camera *device)
         return (permission < 0) ? SDL_FALSE : SDL_TRUE;  // if permission was denied, shut it down. if undecided, we're done for now.
     }
 
+    SDL_TRACE_BEGIN("SDL_CameraThreadIterate");
+
     SDL_bool failed = SDL_FALSE;  // set to true if disaster worthy of treating the device as lost has happened.
     SDL_Surface *acquired = NULL;
     SDL_Surface *output_surface = NULL;
@@ -821,7 +880,7 @@ SDL_bool SDL_CameraThreadIterate(SDL_Camera *device)
             device->ReleaseFrame(device, device->acquire_surface);
             device->acquire_surface->pixels = NULL;
             device->acquire_surface->pitch = 0;
-        } else if (device->empty_output_surfaces.next == NULL) {
+        } else if (!MakeRoomForCameraFrame(device)) {
             // uhoh, no output frames available! Either the app is slow, or it forgot to release frames when done with them. Drop this new frame.
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: No empty output surfaces! Dropping frame!");
@@ -829,6 +888,7 @@ SDL_bool SDL_CameraThreadIterate(SDL_Camera *device)
             device->ReleaseFrame(device, device->acquire_surface);
             device->acquire_surface->pixels = NULL;
             device->acquire_surface->pitch = 0;
+            CountDroppedCameraFrame(device);
         } else {
             if (!device->adjust_timestamp) {
                 device->adjust_timestamp = SDL_GetTicksNS();
@@ -872,25 +932,34 @@ SDL_bool SDL_CameraThreadIterate(SDL_Camera *device)
             output_surface->h = acquired->h;
             output_surface->pixels = acquired->pixels;
             output_surface->pitch = acquired->pitch;
+
+            // forward the driver's zero-copy handle, if any, so the app can import the frame directly.
+            const Sint64 dmabuf_fd = SDL_GetNumberProperty(SDL_GetSurfaceProperties(acquired), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, -1);
+            if (dmabuf_fd >= 0) {
+                SDL_SetNumberProperty(SDL_GetSurfaceProperties(output_surface), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, dmabuf_fd);
+            } else {
+                SDL_ClearProperty(SDL_GetSurfaceProperties(output_surface), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER);
+            }
         } else {  // convert/scale into a different surface.
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: Frame is getting converted!");
             #endif
             SDL_Surface *srcsurf = acquired;
-            if (device->needs_scaling == -1) {  // downscaling? Do it first.  -1: downscale, 0: no scaling, 1: upscale
+            const SDL_bool scale_first = device->needs_scaling && (!device->needs_conversion || device->scale_before_conversion);
+            if (scale_first) {
                 SDL_Surface *dstsurf = device->needs_conversion ? device->conversion_surface : output_surface;
-                SDL_SoftStretch(srcsurf, NULL, dstsurf, NULL, SDL_SCALEMODE_NEAREST);  // !!! FIXME: linear scale? letterboxing?
+                SDL_SoftStretch(srcsurf, NULL, dstsurf, NULL, device->scale_mode);  // !!! FIXME: letterboxing?
                 srcsurf = dstsurf;
             }
             if (device->needs_conversion) {
-                SDL_Surface *dstsurf = (device->needs_scaling == 1) ? device->conversion_surface : output_surface;
+                SDL_Surface *dstsurf = (device->needs_scaling && !scale_first) ? device->conversion_surface : output_surface;
                 SDL_ConvertPixels(srcsurf->w, srcsurf->h,
                                   srcsurf->format, srcsurf->pixels, srcsurf->pitch,
                                   dstsurf->format, dstsurf->pixels, dstsurf->pitch);
                 srcsurf = dstsurf;
             }
-            if (device->needs_scaling == 1) {  // upscaling? Do it last.  -1: downscale, 0: no scaling, 1: upscale
-                SDL_SoftStretch(srcsurf, NULL, output_surface, NULL, SDL_SCALEMODE_NEAREST);  // !!! FIXME: linear scale? letterboxing?
+            if (device->needs_scaling && !scale_first) {
+                SDL_SoftStretch(srcsurf, NULL, output_surface, NULL, device->scale_mode);  // !!! FIXME: letterboxing?
             }
 
             // we made a copy, so we can give the driver back its resources.
@@ -908,6 +977,7 @@ SDL_bool SDL_CameraThreadIterate(SDL_Camera *device)
         SDL_UnlockMutex(device->lock);
     }
 
+    SDL_TRACE_END();
     return SDL_TRUE;  // always go on if not shutting down, even if device failed.
 }
 
@@ -1062,6 +1132,15 @@ static void ChooseBestCameraSpec(SDL_Camera *device, const SDL_CameraSpec *spec,
     SDL_assert(closest->format != SDL_PIXELFORMAT_UNKNOWN);
 }
 
+// SDL_SoftStretch can only filter 8-bit-per-channel 32-bit pixels; everything else has to use nearest.
+static SDL_ScaleMode GetCameraScaleMode(SDL_PixelFormat format)
+{
+    if ((SDL_BYTESPERPIXEL(format) == 4) && !SDL_ISPIXELFORMAT_FOURCC(format) && !SDL_ISPIXELFORMAT_10BIT(format)) {
+        return SDL_SCALEMODE_LINEAR;
+    }
+    return SDL_SCALEMODE_NEAREST;
+}
+
 SDL_Camera *SDL_OpenCamera(SDL_CameraID instance_id, const SDL_CameraSpec *spec)
 {
     SDL_Camera *device = ObtainPhysicalCamera(instance_id);
@@ -1130,6 +1209,15 @@ SDL_Camera *SDL_OpenCamera(SDL_CameraID instance_id, const SDL_CameraSpec *spec)
 
     device->needs_conversion = (closest.format != device->spec.format);
 
+    // Scaling FOURCC (YUV) data means SDL_SoftStretch converts to RGB and back for every frame, so scale on
+    // whichever side of the conversion isn't FOURCC. Otherwise, scale on the side with fewer pixels.
+    if (SDL_ISPIXELFORMAT_FOURCC(closest.format) != SDL_ISPIXELFORMAT_FOURCC(device->spec.format)) {
+        device->scale_before_conversion = SDL_ISPIXELFORMAT_FOURCC(closest.format) ? SDL_FALSE : SDL_TRUE;
+    } else {
+        device->scale_before_conversion = (device->needs_scaling < 0);
+    }
+    device->scale_mode = GetCameraScaleMode((device->needs_conversion && !device->scale_before_conversion) ? device->spec.format : closest.format);
+
     device->acquire_surface = SDL_CreateSurfaceFrom(closest.width, closest.height, closest.format, NULL, 0);
     if (!device->acquire_surface) {
         ClosePhysicalCamera(device);
@@ -1140,9 +1228,9 @@ SDL_Camera *SDL_OpenCamera(SDL_CameraID instance_id, const SDL_CameraSpec *spec)
 
     // if we have to scale _and_ convert, we need a middleman surface, since we can't do both changes at once.
     if (device->needs_scaling && device->needs_conversion) {
-        const SDL_bool downsampling_first = (device->needs_scaling < 0);
-        const SDL_CameraSpec *s = downsampling_first ? &device->spec : &closest;
-        const SDL_PixelFormat fmt = downsampling_first ? closest.format : device->spec.format;
+        const SDL_bool scaling_first = device->scale_before_conversion;
+        const SDL_CameraSpec *s = scaling_first ? &device->spec : &closest;
+        const SDL_PixelFormat fmt = scaling_first ? closest.format : device->spec.format;
         device->conversion_surface = SDL_CreateSurface(s->width, s->height, fmt);
         if (!device->conversion_surface) {
             ClosePhysicalCamera(device);
@@ -1231,6 +1319,10 @@ SDL_Surface *SDL_AcquireCameraFrame(SDL_Camera *camera, Uint64 *timestampNS)
 
     const SDL_bool list_is_empty = (slist == slistprev);
     if (!list_is_empty) { // report the oldest frame.
+        if (slistprev != &device->filled_output_surfaces) {  // a newer frame is already waiting, so the app is behind.
+            device->late_frames++;
+            SDL_SetNumberProperty(GetCameraPropertiesLocked(device), SDL_PROP_CAMERA_LATE_FRAMES_NUMBER, (Sint64) device->late_frames);
+        }
         if (timestampNS) {
             *timestampNS = slist->timestampNS;
         }
@@ -1314,10 +1406,7 @@ SDL_PropertiesID SDL_GetCameraProperties(SDL_Camera *camera)
     } else {
         SDL_Camera *device = (SDL_Camera *) camera;  // currently there's no separation between physical and logical device.
         ObtainPhysicalCameraObj(device);
-        if (device->props == 0) {
-            device->props = SDL_CreateProperties();
-        }
-        retval = device->props;
+        retval = GetCameraPropertiesLocked(device);
         ReleaseCamera(device);
     }
 
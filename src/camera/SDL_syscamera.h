@@ -132,6 +132,10 @@ struct SDL_Camera
     SurfaceList empty_output_surfaces;         // this is LIFO
     SurfaceList app_held_output_surfaces;
 
+    // Frames thrown away because the queue was full, and frames the app acquired after a newer one had already arrived.
+    Uint64 dropped_frames;
+    Uint64 late_frames;
+
     // A fake video frame we allocate if the camera fails/disconnects.
     Uint8 *zombie_pixels;
 
@@ -141,6 +145,12 @@ struct SDL_Camera
     // SDL_TRUE if acquire_surface needs to be converted for final output.
     SDL_bool needs_conversion;
 
+    // SDL_TRUE if we scale before converting when doing both, SDL_FALSE to convert first.
+    SDL_bool scale_before_conversion;
+
+    // The filter used when scaling, chosen for the format the scaling happens in.
+    SDL_ScaleMode scale_mode;
+
     // Current state flags
     SDL_AtomicInt shutdown;
     SDL_AtomicInt zombie;
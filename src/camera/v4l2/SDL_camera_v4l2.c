@@ -44,14 +44,13 @@ SDL_COMPILE_TIME_ASSERT(v4l2devicecaps, offsetof(struct v4l2_capability,device_c
 #include "../../core/linux/SDL_evdev_capabilities.h"
 #include "../../core/linux/SDL_udev.h"
 
-#ifndef SDL_USE_LIBUDEV
 #include <dirent.h>
-#endif
 
 typedef struct V4L2DeviceHandle
 {
     char *bus_info;
     char *path;
+    SDL_bool mjpeg_as_nv12;  // MJPEG formats are offered as NV12, decoded by a hardware JPEG decoder.
 } V4L2DeviceHandle;
 
 
@@ -66,8 +65,21 @@ struct buffer {
     void   *start;
     size_t  length;
     int available; // Is available in userspace
+    int dmabuf_fd; // exported DMA-BUF for this buffer, or -1.
 };
 
+// A V4L2 memory-to-memory JPEG decoder, fed MJPEG frames from the camera.
+typedef struct V4L2JpegDecoder
+{
+    int fd;
+    int nb_in_buffers;
+    struct buffer *in_buffers;   // compressed frames copied in from the camera.
+    int nb_out_buffers;
+    struct buffer *out_buffers;  // decoded NV12 frames.
+    int pitch;
+    int height;  // the decoder may pad the luma plane past the frame height.
+} V4L2JpegDecoder;
+
 struct SDL_PrivateCameraData
 {
     int fd;
@@ -75,8 +87,14 @@ struct SDL_PrivateCameraData
     int nb_buffers;
     struct buffer *buffers;
     int driver_pitch;
+    V4L2JpegDecoder *decoder;  // non-NULL if we're decoding MJPEG from the camera.
 };
 
+// the JPEG decoder device we found, if any, and which compressed format it wants.
+static char *jpeg_decoder_path = NULL;
+static Uint32 jpeg_decoder_format = 0;
+static SDL_bool jpeg_decoder_checked = SDL_FALSE;
+
 static int xioctl(int fh, int request, void *arg)
 {
     int r;
@@ -91,6 +109,7 @@ static int xioctl(int fh, int request, void *arg)
 static int V4L2_WaitDevice(SDL_Camera *device)
 {
     const int fd = device->hidden->fd;
+    const int decoder_fd = device->hidden->decoder ? device->hidden->decoder->fd : -1;
 
     int retval;
 
@@ -98,12 +117,15 @@ static int V4L2_WaitDevice(SDL_Camera *device)
         fd_set fds;
         FD_ZERO(&fds);
         FD_SET(fd, &fds);
+        if (decoder_fd != -1) {
+            FD_SET(decoder_fd, &fds);  // a decoded frame is ready.
+        }
 
         struct timeval tv;
         tv.tv_sec = 0;
         tv.tv_usec = 100 * 1000;
 
-        retval = select(fd + 1, &fds, NULL, NULL, &tv);
+        retval = select(SDL_max(fd, decoder_fd) + 1, &fds, NULL, NULL, &tv);
         if ((retval == -1) && (errno == EINTR)) {
             retval = 0;  // pretend it was a timeout, keep looping.
         }
@@ -118,6 +140,147 @@ static int V4L2_WaitDevice(SDL_Camera *device)
     return retval;
 }
 
+// Move a compressed frame from the camera to the decoder, if one is ready. Returns 1 if fed, 0 if not, -1 on error.
+static int FeedJpegDecoder(SDL_Camera *device)
+{
+    V4L2JpegDecoder *decoder = device->hidden->decoder;
+    const int fd = device->hidden->fd;
+    struct v4l2_buffer buf;
+
+    // reclaim any compressed frames the decoder is done with.
+    for (;;) {
+        SDL_zero(buf);
+        buf.type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+        buf.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(decoder->fd, VIDIOC_DQBUF, &buf) == -1) {
+            break;
+        } else if ((int)buf.index < decoder->nb_in_buffers) {
+            decoder->in_buffers[buf.index].available = 1;
+        }
+    }
+
+    SDL_zero(buf);
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    if (xioctl(fd, VIDIOC_DQBUF, &buf) == -1) {
+        return (errno == EAGAIN) ? 0 : SDL_SetError("VIDIOC_DQBUF: %d", errno);
+    } else if ((int)buf.index < 0 || (int)buf.index >= device->hidden->nb_buffers) {
+        return SDL_SetError("invalid buffer index");
+    }
+
+    int i;
+    for (i = 0; i < decoder->nb_in_buffers; ++i) {
+        if (decoder->in_buffers[i].available) {
+            break;
+        }
+    }
+
+    // if the decoder is backed up or the camera flagged a bad frame, drop this one.
+    const SDL_bool feed = (i < decoder->nb_in_buffers) && ((buf.flags & V4L2_BUF_FLAG_ERROR) == 0) && (buf.bytesused > 0);
+    if (feed) {
+        const size_t len = SDL_min((size_t) buf.bytesused, decoder->in_buffers[i].length);
+        struct v4l2_buffer inbuf;
+
+        SDL_memcpy(decoder->in_buffers[i].start, device->hidden->buffers[buf.index].start, len);
+
+        SDL_zero(inbuf);
+        inbuf.type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+        inbuf.memory = V4L2_MEMORY_MMAP;
+        inbuf.index = i;
+        inbuf.bytesused = (Uint32) len;
+        inbuf.field = V4L2_FIELD_NONE;
+        inbuf.timestamp = buf.timestamp;  // the decoder copies this to the decoded frame.
+
+        if (xioctl(decoder->fd, VIDIOC_QBUF, &inbuf) == -1) {
+            return SDL_SetError("VIDIOC_QBUF on JPEG decoder: %d", errno);
+        }
+        decoder->in_buffers[i].available = 0;
+    }
+
+    // we copied the compressed frame out, so the camera can have its buffer back right away.
+    if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
+        return SDL_SetError("VIDIOC_QBUF");
+    }
+
+    return feed ? 1 : 0;
+}
+
+static int AcquireDecodedFrame(SDL_Camera *device, SDL_Surface *frame, Uint64 *timestampNS)
+{
+    V4L2JpegDecoder *decoder = device->hidden->decoder;
+    struct v4l2_buffer buf;
+
+    if (FeedJpegDecoder(device) < 0) {
+        return -1;
+    }
+
+    SDL_zero(buf);
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    if (xioctl(decoder->fd, VIDIOC_DQBUF, &buf) == -1) {
+        return (errno == EAGAIN) ? 0 : SDL_SetError("VIDIOC_DQBUF on JPEG decoder: %d", errno);
+    } else if ((int)buf.index < 0 || (int)buf.index >= decoder->nb_out_buffers) {
+        return SDL_SetError("invalid decoder buffer index");
+    }
+
+    struct buffer *out = &decoder->out_buffers[buf.index];
+
+    if ((buf.flags & V4L2_BUF_FLAG_ERROR) || (buf.bytesused == 0)) {  // corrupt JPEG data, probably. Skip it.
+        if (xioctl(decoder->fd, VIDIOC_QBUF, &buf) == -1) {
+            return SDL_SetError("VIDIOC_QBUF on JPEG decoder: %d", errno);
+        }
+        return 0;
+    }
+
+    if (decoder->height != frame->h) {
+        // SDL expects the chroma plane right after the visible rows, so close the gap the decoder left.
+        Uint8 *pixels = (Uint8 *) out->start;
+        SDL_memmove(pixels + ((size_t) decoder->pitch * frame->h), pixels + ((size_t) decoder->pitch * decoder->height), (size_t) decoder->pitch * ((frame->h + 1) / 2));
+    }
+
+    frame->pixels = out->start;
+    frame->pitch = decoder->pitch;
+    out->available = 1;
+
+    if ((out->dmabuf_fd != -1) && (decoder->height == frame->h)) {
+        SDL_SetNumberProperty(SDL_GetSurfaceProperties(frame), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, out->dmabuf_fd);
+    }
+
+    *timestampNS = (((Uint64) buf.timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf.timestamp.tv_usec);
+
+    return 1;
+}
+
+static void ReleaseDecodedFrame(SDL_Camera *device, SDL_Surface *frame)
+{
+    V4L2JpegDecoder *decoder = device->hidden->decoder;
+    int i;
+
+    for (i = 0; i < decoder->nb_out_buffers; ++i) {
+        if (frame->pixels == decoder->out_buffers[i].start) {
+            break;
+        }
+    }
+
+    if (i >= decoder->nb_out_buffers) {
+        return;  // oh well, we didn't own this.
+    }
+
+    struct v4l2_buffer buf;
+    SDL_zero(buf);
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = i;
+
+    if (xioctl(decoder->fd, VIDIOC_QBUF, &buf) == -1) {
+        // !!! FIXME: disconnect the device.
+        return; //SDL_SetError("VIDIOC_QBUF");
+    }
+    decoder->out_buffers[i].available = 0;
+}
+
 static int V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *frame, Uint64 *timestampNS)
 {
     const int fd = device->hidden->fd;
@@ -125,6 +288,10 @@ static int V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *frame, Uint64 *tim
     size_t size = device->hidden->buffers[0].length;
     struct v4l2_buffer buf;
 
+    if (device->hidden->decoder) {
+        return AcquireDecodedFrame(device, frame, timestampNS);
+    }
+
     switch (io) {
         case IO_METHOD_READ:
             if (read(fd, device->hidden->buffers[0].start, size) == -1) {
@@ -174,6 +341,10 @@ static int V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *frame, Uint64 *tim
             frame->pitch = device->hidden->driver_pitch;
             device->hidden->buffers[buf.index].available = 1;
 
+            if (device->hidden->buffers[buf.index].dmabuf_fd != -1) {
+                SDL_SetNumberProperty(SDL_GetSurfaceProperties(frame), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, device->hidden->buffers[buf.index].dmabuf_fd);
+            }
+
             *timestampNS = (((Uint64) buf.timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf.timestamp.tv_usec);
 
             #if DEBUG_CAMERA
@@ -239,6 +410,11 @@ static void V4L2_ReleaseFrame(SDL_Camera *device, SDL_Surface *frame)
     const io_method io = device->hidden->io;
     int i;
 
+    if (device->hidden->decoder) {
+        ReleaseDecodedFrame(device, frame);
+        return;
+    }
+
     for (i = 0; i < device->hidden->nb_buffers; ++i) {
         if (frame->pixels == device->hidden->buffers[i].start) {
             break;
@@ -345,16 +521,15 @@ static int AllocBufferRead(SDL_Camera *device, size_t buffer_size)
     return device->hidden->buffers[0].start ? 0 : -1;
 }
 
-static int AllocBufferMmap(SDL_Camera *device)
+static int MmapBuffers(const int fd, const enum v4l2_buf_type type, struct buffer *buffers, const int nb_buffers)
 {
-    const int fd = device->hidden->fd;
     int i;
-    for (i = 0; i < device->hidden->nb_buffers; ++i) {
+    for (i = 0; i < nb_buffers; ++i) {
         struct v4l2_buffer buf;
 
         SDL_zero(buf);
 
-        buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.type        = type;
         buf.memory      = V4L2_MEMORY_MMAP;
         buf.index       = i;
 
@@ -362,21 +537,245 @@ static int AllocBufferMmap(SDL_Camera *device)
             return SDL_SetError("VIDIOC_QUERYBUF");
         }
 
-        device->hidden->buffers[i].length = buf.length;
-        device->hidden->buffers[i].start =
+        buffers[i].length = buf.length;
+        buffers[i].start =
             mmap(NULL /* start anywhere */,
                     buf.length,
                     PROT_READ | PROT_WRITE /* required */,
                     MAP_SHARED /* recommended */,
                     fd, buf.m.offset);
 
-        if (MAP_FAILED == device->hidden->buffers[i].start) {
+        if (MAP_FAILED == buffers[i].start) {
             return SDL_SetError("mmap");
         }
+
+        #ifdef VIDIOC_EXPBUF
+        if (type == V4L2_BUF_TYPE_VIDEO_CAPTURE) {
+            // Export the buffer as a DMA-BUF too, so frames can be imported into a GPU without a copy. Not fatal if unsupported.
+            struct v4l2_exportbuffer expbuf;
+            SDL_zero(expbuf);
+            expbuf.type = type;
+            expbuf.index = i;
+            expbuf.flags = O_RDONLY | O_CLOEXEC;
+            if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) == 0) {
+                buffers[i].dmabuf_fd = expbuf.fd;
+            }
+        }
+        #endif
     }
     return 0;
 }
 
+static void UnmapBuffers(struct buffer *buffers, const int nb_buffers)
+{
+    for (int i = 0; i < nb_buffers; ++i) {
+        if (buffers[i].dmabuf_fd != -1) {
+            close(buffers[i].dmabuf_fd);
+        }
+        if (!buffers[i].start || (buffers[i].start == MAP_FAILED)) {
+            continue;  // we failed partway through mapping these.
+        } else if (munmap(buffers[i].start, buffers[i].length) == -1) {
+            SDL_SetError("munmap");
+        }
+    }
+}
+
+static int AllocBufferMmap(SDL_Camera *device)
+{
+    return MmapBuffers(device->hidden->fd, V4L2_BUF_TYPE_VIDEO_CAPTURE, device->hidden->buffers, device->hidden->nb_buffers);
+}
+
+static SDL_bool HasV4L2Format(const int fd, const enum v4l2_buf_type type, const Uint32 v4l2fmt)
+{
+    struct v4l2_fmtdesc fmtdesc;
+    SDL_zero(fmtdesc);
+    fmtdesc.type = type;
+    while (ioctl(fd, VIDIOC_ENUM_FMT, &fmtdesc) == 0) {
+        if (fmtdesc.pixelformat == v4l2fmt) {
+            return SDL_TRUE;
+        }
+        fmtdesc.index++;
+    }
+    return SDL_FALSE;
+}
+
+// Look for a memory-to-memory device (a hardware JPEG decoder) that can turn UVC MJPEG frames into NV12.
+static const char *FindJpegDecoder(void)
+{
+    if (jpeg_decoder_checked) {
+        return jpeg_decoder_path;
+    }
+
+    jpeg_decoder_checked = SDL_TRUE;
+
+    DIR *dirp = opendir("/dev");
+    if (dirp) {
+        struct dirent *dent;
+        while (!jpeg_decoder_path && ((dent = readdir(dirp)) != NULL)) {
+            int num = 0;
+            if (SDL_sscanf(dent->d_name, "video%d", &num) != 1) {
+                continue;
+            }
+
+            char fullpath[64];
+            SDL_snprintf(fullpath, sizeof (fullpath), "/dev/video%d", num);
+            const int fd = open(fullpath, O_RDWR | O_NONBLOCK, 0);
+            if (fd == -1) {
+                continue;
+            }
+
+            struct v4l2_capability vcap;
+            if ((ioctl(fd, VIDIOC_QUERYCAP, &vcap) == 0) && (vcap.device_caps & V4L2_CAP_VIDEO_M2M) &&
+                HasV4L2Format(fd, V4L2_BUF_TYPE_VIDEO_CAPTURE, V4L2_PIX_FMT_NV12)) {
+                if (HasV4L2Format(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT, V4L2_PIX_FMT_MJPEG)) {
+                    jpeg_decoder_format = V4L2_PIX_FMT_MJPEG;
+                } else if (HasV4L2Format(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT, V4L2_PIX_FMT_JPEG)) {
+                    jpeg_decoder_format = V4L2_PIX_FMT_JPEG;
+                }
+
+                if (jpeg_decoder_format) {
+                    #if DEBUG_CAMERA
+                    SDL_Log("CAMERA: Using JPEG decoder at '%s' name='%s'", fullpath, vcap.card);
+                    #endif
+                    jpeg_decoder_path = SDL_strdup(fullpath);
+                }
+            }
+            close(fd);
+        }
+        closedir(dirp);
+    }
+
+    return jpeg_decoder_path;
+}
+
+static int RequestDecoderBuffers(const int fd, const enum v4l2_buf_type type, struct buffer **buffers, int *nb_buffers)
+{
+    struct v4l2_requestbuffers req;
+    SDL_zero(req);
+    req.count = 4;
+    req.type = type;
+    req.memory = V4L2_MEMORY_MMAP;
+    if ((xioctl(fd, VIDIOC_REQBUFS, &req) == -1) || (req.count < 1)) {
+        return SDL_SetError("VIDIOC_REQBUFS on JPEG decoder");
+    }
+
+    *buffers = (struct buffer *) SDL_calloc(req.count, sizeof (**buffers));
+    if (!*buffers) {
+        return -1;
+    }
+
+    *nb_buffers = (int) req.count;
+    for (int i = 0; i < *nb_buffers; ++i) {
+        (*buffers)[i].dmabuf_fd = -1;
+    }
+
+    return MmapBuffers(fd, type, *buffers, *nb_buffers);
+}
+
+static int OpenJpegDecoder(SDL_Camera *device, const int w, const int h, const Uint32 max_jpeg_size)
+{
+    V4L2JpegDecoder *decoder = (V4L2JpegDecoder *) SDL_calloc(1, sizeof (V4L2JpegDecoder));
+    if (!decoder) {
+        return -1;
+    }
+
+    device->hidden->decoder = decoder;  // V4L2_CloseDevice cleans up if we fail partway through.
+
+    decoder->fd = open(jpeg_decoder_path, O_RDWR | O_NONBLOCK, 0);
+    if (decoder->fd == -1) {
+        return SDL_SetError("Cannot open JPEG decoder '%s': %d, %s", jpeg_decoder_path, errno, strerror(errno));
+    }
+
+    struct v4l2_format fmt;
+    SDL_zero(fmt);
+    fmt.type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+    fmt.fmt.pix.width = w;
+    fmt.fmt.pix.height = h;
+    fmt.fmt.pix.pixelformat = jpeg_decoder_format;
+    fmt.fmt.pix.sizeimage = max_jpeg_size;
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+    if (xioctl(decoder->fd, VIDIOC_S_FMT, &fmt) == -1) {
+        return SDL_SetError("Error VIDIOC_S_FMT on JPEG decoder input");
+    }
+
+    SDL_zero(fmt);
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = w;
+    fmt.fmt.pix.height = h;
+    fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_NV12;
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+    if (xioctl(decoder->fd, VIDIOC_S_FMT, &fmt) == -1) {
+        return SDL_SetError("Error VIDIOC_S_FMT on JPEG decoder output");
+    } else if ((fmt.fmt.pix.pixelformat != V4L2_PIX_FMT_NV12) || ((int) fmt.fmt.pix.width < w) || ((int) fmt.fmt.pix.height < h)) {
+        return SDL_SetError("JPEG decoder can't produce %dx%d NV12 frames", w, h);
+    }
+
+    decoder->pitch = (int) fmt.fmt.pix.bytesperline;
+    decoder->height = (int) fmt.fmt.pix.height;
+
+    if (RequestDecoderBuffers(decoder->fd, V4L2_BUF_TYPE_VIDEO_OUTPUT, &decoder->in_buffers, &decoder->nb_in_buffers) < 0) {
+        return -1;
+    } else if (RequestDecoderBuffers(decoder->fd, V4L2_BUF_TYPE_VIDEO_CAPTURE, &decoder->out_buffers, &decoder->nb_out_buffers) < 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < decoder->nb_in_buffers; ++i) {
+        decoder->in_buffers[i].available = 1;  // empty and ours to fill.
+    }
+
+    for (int i = 0; i < decoder->nb_out_buffers; ++i) {
+        struct v4l2_buffer buf;
+        SDL_zero(buf);
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = i;
+        if (xioctl(decoder->fd, VIDIOC_QBUF, &buf) == -1) {
+            return SDL_SetError("VIDIOC_QBUF on JPEG decoder");
+        }
+    }
+
+    enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+    if (xioctl(decoder->fd, VIDIOC_STREAMON, &type) == -1) {
+        return SDL_SetError("VIDIOC_STREAMON on JPEG decoder");
+    }
+    type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(decoder->fd, VIDIOC_STREAMON, &type) == -1) {
+        return SDL_SetError("VIDIOC_STREAMON on JPEG decoder");
+    }
+
+    return 0;
+}
+
+static void CloseJpegDecoder(V4L2JpegDecoder *decoder)
+{
+    if (!decoder) {
+        return;
+    }
+
+    if (decoder->fd != -1) {
+        enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+        xioctl(decoder->fd, VIDIOC_STREAMOFF, &type);
+        type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(decoder->fd, VIDIOC_STREAMOFF, &type);
+    }
+
+    if (decoder->in_buffers) {
+        UnmapBuffers(decoder->in_buffers, decoder->nb_in_buffers);
+        SDL_free(decoder->in_buffers);
+    }
+
+    if (decoder->out_buffers) {
+        UnmapBuffers(decoder->out_buffers, decoder->nb_out_buffers);
+        SDL_free(decoder->out_buffers);
+    }
+
+    if (decoder->fd != -1) {
+        close(decoder->fd);
+    }
+
+    SDL_free(decoder);
+}
+
 static int AllocBufferUserPtr(SDL_Camera *device, size_t buffer_size)
 {
     int i;
@@ -429,6 +828,8 @@ static void V4L2_CloseDevice(SDL_Camera *device)
         const io_method io = device->hidden->io;
         const int fd = device->hidden->fd;
 
+        CloseJpegDecoder(device->hidden->decoder);
+
         if ((io == IO_METHOD_MMAP) || (io == IO_METHOD_USERPTR)) {
             enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
             xioctl(fd, VIDIOC_STREAMOFF, &type);
@@ -444,11 +845,7 @@ static void V4L2_CloseDevice(SDL_Camera *device)
                     break;
 
                 case IO_METHOD_MMAP:
-                    for (int i = 0; i < device->hidden->nb_buffers; ++i) {
-                        if (munmap(device->hidden->buffers[i].start, device->hidden->buffers[i].length) == -1) {
-                            SDL_SetError("munmap");
-                        }
-                    }
+                    UnmapBuffers(device->hidden->buffers, device->hidden->nb_buffers);
                     break;
 
                 case IO_METHOD_USERPTR:
@@ -473,6 +870,7 @@ static void V4L2_CloseDevice(SDL_Camera *device)
 static int V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
 {
     const V4L2DeviceHandle *handle = (const V4L2DeviceHandle *) device->handle;
+    const SDL_bool decode_mjpeg = handle->mjpeg_as_nv12 && (spec->format == SDL_PIXELFORMAT_NV12);
     struct stat st;
     struct v4l2_capability cap;
     const int fd = open(handle->path, O_RDWR /* required */ | O_NONBLOCK, 0);
@@ -525,7 +923,7 @@ static int V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
     fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     fmt.fmt.pix.width = spec->width;
     fmt.fmt.pix.height = spec->height;
-    fmt.fmt.pix.pixelformat = format_sdl_to_v4l2(spec->format);
+    fmt.fmt.pix.pixelformat = decode_mjpeg ? V4L2_PIX_FMT_MJPEG : format_sdl_to_v4l2(spec->format);
     //fmt.fmt.pix.field = V4L2_FIELD_INTERLACED;
     fmt.fmt.pix.field = V4L2_FIELD_ANY;
 
@@ -600,6 +998,10 @@ static int V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
         return -1;
     }
 
+    for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+        device->hidden->buffers[i].dmabuf_fd = -1;
+    }
+
     size_t size, pitch;
     SDL_CalculateSurfaceSize(device->spec.format, device->spec.width, device->spec.height, &size, &pitch, SDL_FALSE);
 
@@ -624,6 +1026,10 @@ static int V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
 
     if (rc < 0) {
         return -1;
+    } else if (decode_mjpeg && (io != IO_METHOD_MMAP)) {
+        return SDL_SetError("Can't decode MJPEG from this device without mmap support");
+    } else if (decode_mjpeg && (OpenJpegDecoder(device, (int) fmt.fmt.pix.width, (int) fmt.fmt.pix.height, fmt.fmt.pix.sizeimage) < 0)) {
+        return -1;
     } else if (EnqueueBuffers(device) < 0) {
         return -1;
     } else if (io != IO_METHOD_READ) {
@@ -724,6 +1130,7 @@ static void MaybeAddDevice(const char *path)
 
     CameraFormatAddData add_data;
     SDL_zero(add_data);
+    SDL_bool mjpeg_as_nv12 = SDL_FALSE;
 
     struct v4l2_fmtdesc fmtdesc;
     SDL_zero(fmtdesc);
@@ -733,6 +1140,12 @@ static void MaybeAddDevice(const char *path)
         SDL_Colorspace colorspace = SDL_COLORSPACE_UNKNOWN;
         format_v4l2_to_sdl(fmtdesc.pixelformat, &sdlfmt, &colorspace);
 
+        if ((sdlfmt == SDL_PIXELFORMAT_UNKNOWN) && (fmtdesc.pixelformat == V4L2_PIX_FMT_MJPEG) && FindJpegDecoder()) {
+            sdlfmt = SDL_PIXELFORMAT_NV12;  // we'll decode it to NV12 in hardware.
+            colorspace = SDL_COLORSPACE_JPEG;
+            mjpeg_as_nv12 = SDL_TRUE;
+        }
+
         #if DEBUG_CAMERA
         SDL_Log("CAMERA:   - Has format '%s'%s%s", SDL_GetPixelFormatName(sdlfmt),
                 (fmtdesc.flags & V4L2_FMT_FLAG_EMULATED) ? " [EMULATED]" : "",
@@ -791,6 +1204,7 @@ static void MaybeAddDevice(const char *path)
     if (add_data.num_specs > 0) {
         V4L2DeviceHandle *handle = (V4L2DeviceHandle *) SDL_calloc(1, sizeof (V4L2DeviceHandle));
         if (handle) {
+            handle->mjpeg_as_nv12 = mjpeg_as_nv12;
             handle->path = SDL_strdup(path);
             if (handle->path) {
                 handle->bus_info = SDL_strdup((char *)vcap.bus_info);
@@ -847,6 +1261,11 @@ static void CameraUdevCallback(SDL_UDEV_deviceevent udev_type, int udev_class, c
 
 static void V4L2_Deinitialize(void)
 {
+    SDL_free(jpeg_decoder_path);
+    jpeg_decoder_path = NULL;
+    jpeg_decoder_format = 0;
+    jpeg_decoder_checked = SDL_FALSE;
+
 #ifdef SDL_USE_LIBUDEV
     SDL_UDEV_DelCallback(CameraUdevCallback);
     SDL_UDEV_Quit();
@@ -29,6 +29,18 @@ void SDL_SetX11EventHook(SDL_X11EventHook callback, void *userdata)
 
 #endif
 
+#ifndef SDL_VIDEO_DRIVER_KMSDRM
+
+SDL_DECLSPEC int SDLCALL SDL_SetKMSDRMWindowOverlay(SDL_Window *window, SDL_PropertiesID props);
+int SDL_SetKMSDRMWindowOverlay(SDL_Window *window, SDL_PropertiesID props)
+{
+    (void)window;
+    (void)props;
+    return SDL_Unsupported();
+}
+
+#endif
+
 #ifndef SDL_PLATFORM_LINUX
 
 SDL_DECLSPEC int SDLCALL SDL_SetLinuxThreadPriority(Sint64 threadID, int priority);
@@ -34,6 +34,7 @@
 #include "../../haptic/android/SDL_syshaptic_c.h"
 #include "../../hidapi/android/hid.h"
 #include "../../SDL_hints_c.h"
+#include "../../thread/SDL_thread_c.h"
 
 #include <android/log.h>
 #include <android/configuration.h>
@@ -329,6 +330,10 @@ static void checkJNIReady(void);
 static pthread_key_t mThreadKey;
 static pthread_once_t key_once = PTHREAD_ONCE_INIT;
 static JavaVM *mJavaVM = NULL;
+#ifdef SDL_THREAD_LOCAL
+/* Mirrors mThreadKey so Android_JNI_GetEnv() doesn't need to call into pthreads */
+static SDL_THREAD_LOCAL JNIEnv *tThreadEnv = NULL;
+#endif
 
 /* Main activity */
 static jclass mActivityClass;
@@ -384,6 +389,19 @@ static jmethodID midHapticRun;
 static jmethodID midHapticRumble;
 static jmethodID midHapticStop;
 
+/* battery status, looked up once instead of on every Android_JNI_GetPowerInfo() call */
+static jclass mIntentFilterClass;
+static jmethodID midIntentFilterInit;
+static jmethodID midRegisterReceiver;
+static jmethodID midIntentGetIntExtra;
+static jmethodID midIntentGetBooleanExtra;
+static jstring mBatteryChangedAction;
+static jstring mBatteryExtraPlugged;
+static jstring mBatteryExtraStatus;
+static jstring mBatteryExtraPresent;
+static jstring mBatteryExtraLevel;
+static jstring mBatteryExtraScale;
+
 /* Accelerometer data storage */
 static SDL_DisplayOrientation displayNaturalOrientation;
 static SDL_DisplayOrientation displayCurrentOrientation;
@@ -437,6 +455,9 @@ static int Android_NumLifecycleEvents;
 static int Android_JNI_SetEnv(JNIEnv *env)
 {
     int status = pthread_setspecific(mThreadKey, env);
+#ifdef SDL_THREAD_LOCAL
+    tThreadEnv = (status < 0) ? NULL : env;
+#endif
     if (status < 0) {
         __android_log_print(ANDROID_LOG_ERROR, "SDL", "Failed pthread_setspecific() in Android_JNI_SetEnv() (err=%d)", status);
     }
@@ -447,7 +468,14 @@ static int Android_JNI_SetEnv(JNIEnv *env)
 JNIEnv *Android_JNI_GetEnv(void)
 {
     /* Get JNIEnv from the Thread local storage */
-    JNIEnv *env = pthread_getspecific(mThreadKey);
+    JNIEnv *env;
+#ifdef SDL_THREAD_LOCAL
+    env = tThreadEnv;
+    if (env) {
+        return env;
+    }
+#endif
+    env = pthread_getspecific(mThreadKey);
     if (!env) {
         /* If it fails, try to attach ! (e.g the thread isn't created with SDL_CreateThread() */
         int status;
@@ -562,6 +590,44 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
     return JNI_VERSION_1_4;
 }
 
+static jstring Android_JNI_NewGlobalString(JNIEnv *env, const char *text)
+{
+    jstring string = (*env)->NewStringUTF(env, text);
+    jstring global = (jstring)(*env)->NewGlobalRef(env, string);
+    (*env)->DeleteLocalRef(env, string);
+    return global;
+}
+
+/* Look up everything Android_JNI_GetPowerInfo() needs, so polling the battery doesn't resolve classes and methods every time */
+static void Android_JNI_SetupPowerInfo(JNIEnv *env)
+{
+    jclass cls = (*env)->FindClass(env, "android/content/IntentFilter");
+    if (cls) {
+        mIntentFilterClass = (jclass)((*env)->NewGlobalRef(env, cls));
+        midIntentFilterInit = (*env)->GetMethodID(env, cls, "<init>", "(Ljava/lang/String;)V");
+        (*env)->DeleteLocalRef(env, cls);
+    }
+    midRegisterReceiver = (*env)->GetMethodID(env, mActivityClass, "registerReceiver", "(Landroid/content/BroadcastReceiver;Landroid/content/IntentFilter;)Landroid/content/Intent;");
+
+    cls = (*env)->FindClass(env, "android/content/Intent");
+    if (cls) {
+        midIntentGetIntExtra = (*env)->GetMethodID(env, cls, "getIntExtra", "(Ljava/lang/String;I)I");
+        midIntentGetBooleanExtra = (*env)->GetMethodID(env, cls, "getBooleanExtra", "(Ljava/lang/String;Z)Z");
+        (*env)->DeleteLocalRef(env, cls);
+    }
+
+    mBatteryChangedAction = Android_JNI_NewGlobalString(env, "android.intent.action.BATTERY_CHANGED");
+    mBatteryExtraPlugged = Android_JNI_NewGlobalString(env, "plugged"); /* == BatteryManager.EXTRA_PLUGGED (API 5) */
+    mBatteryExtraStatus = Android_JNI_NewGlobalString(env, "status");   /* == BatteryManager.EXTRA_STATUS (API 5) */
+    mBatteryExtraPresent = Android_JNI_NewGlobalString(env, "present"); /* == BatteryManager.EXTRA_PRESENT (API 5) */
+    mBatteryExtraLevel = Android_JNI_NewGlobalString(env, "level");     /* == BatteryManager.EXTRA_LEVEL (API 5) */
+    mBatteryExtraScale = Android_JNI_NewGlobalString(env, "scale");     /* == BatteryManager.EXTRA_SCALE (API 5) */
+
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
+    }
+}
+
 void checkJNIReady(void)
 {
     if (!mActivityClass || !mAudioManagerClass || !mControllerManagerClass) {
@@ -692,6 +758,10 @@ JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(nativeSetupJNI)(JNIEnv *env, jclass cl
         __android_log_print(ANDROID_LOG_WARN, "SDL", "Missing some Java callbacks, do you have the latest version of SDLActivity.java?");
     }
 
+    if (!mIntentFilterClass) {
+        Android_JNI_SetupPowerInfo(env);
+    }
+
     checkJNIReady();
 }
 
@@ -1886,16 +1956,15 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
 {
     struct LocalReferenceHolder refs = LocalReferenceHolder_Setup(__FUNCTION__);
     JNIEnv *env = Android_JNI_GetEnv();
-    jmethodID mid;
     jobject context;
-    jstring action;
-    jclass cls;
     jobject filter;
     jobject intent;
-    jstring iname;
-    jmethodID imid;
-    jstring bname;
-    jmethodID bmid;
+
+    if (!mIntentFilterClass || !midIntentFilterInit || !midRegisterReceiver ||
+        !midIntentGetIntExtra || !midIntentGetBooleanExtra) {
+        return -1;
+    }
+
     if (!LocalReferenceHolder_Init(&refs, env)) {
         LocalReferenceHolder_Cleanup(&refs);
         return -1;
@@ -1904,43 +1973,20 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
     /* context = SDLActivity.getContext(); */
     context = (*env)->CallStaticObjectMethod(env, mActivityClass, midGetContext);
 
-    action = (*env)->NewStringUTF(env, "android.intent.action.BATTERY_CHANGED");
-
-    cls = (*env)->FindClass(env, "android/content/IntentFilter");
-
-    mid = (*env)->GetMethodID(env, cls, "<init>", "(Ljava/lang/String;)V");
-    filter = (*env)->NewObject(env, cls, mid, action);
-
-    (*env)->DeleteLocalRef(env, action);
-
-    mid = (*env)->GetMethodID(env, mActivityClass, "registerReceiver", "(Landroid/content/BroadcastReceiver;Landroid/content/IntentFilter;)Landroid/content/Intent;");
-    intent = (*env)->CallObjectMethod(env, context, mid, NULL, filter);
-
+    filter = (*env)->NewObject(env, mIntentFilterClass, midIntentFilterInit, mBatteryChangedAction);
+    intent = (*env)->CallObjectMethod(env, context, midRegisterReceiver, NULL, filter);
     (*env)->DeleteLocalRef(env, filter);
 
-    cls = (*env)->GetObjectClass(env, intent);
-
-    imid = (*env)->GetMethodID(env, cls, "getIntExtra", "(Ljava/lang/String;I)I");
-
-    /* Watch out for C89 scoping rules because of the macro */
-#define GET_INT_EXTRA(var, key)                                  \
-    int var;                                                     \
-    iname = (*env)->NewStringUTF(env, key);                      \
-    (var) = (*env)->CallIntMethod(env, intent, imid, iname, -1); \
-    (*env)->DeleteLocalRef(env, iname);
-
-    bmid = (*env)->GetMethodID(env, cls, "getBooleanExtra", "(Ljava/lang/String;Z)Z");
+    if (!intent) {
+        LocalReferenceHolder_Cleanup(&refs);
+        return -1;
+    }
 
-    /* Watch out for C89 scoping rules because of the macro */
-#define GET_BOOL_EXTRA(var, key)                                            \
-    int var;                                                                \
-    bname = (*env)->NewStringUTF(env, key);                                 \
-    (var) = (*env)->CallBooleanMethod(env, intent, bmid, bname, JNI_FALSE); \
-    (*env)->DeleteLocalRef(env, bname);
+#define GET_INT_EXTRA(key) (*env)->CallIntMethod(env, intent, midIntentGetIntExtra, key, -1)
+#define GET_BOOL_EXTRA(key) (*env)->CallBooleanMethod(env, intent, midIntentGetBooleanExtra, key, JNI_FALSE)
 
     if (plugged) {
-        /* Watch out for C89 scoping rules because of the macro */
-        GET_INT_EXTRA(plug, "plugged") /* == BatteryManager.EXTRA_PLUGGED (API 5) */
+        const int plug = GET_INT_EXTRA(mBatteryExtraPlugged);
         if (plug == -1) {
             LocalReferenceHolder_Cleanup(&refs);
             return -1;
@@ -1951,8 +1997,7 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
     }
 
     if (charged) {
-        /* Watch out for C89 scoping rules because of the macro */
-        GET_INT_EXTRA(status, "status") /* == BatteryManager.EXTRA_STATUS (API 5) */
+        const int status = GET_INT_EXTRA(mBatteryExtraStatus);
         if (status == -1) {
             LocalReferenceHolder_Cleanup(&refs);
             return -1;
@@ -1962,8 +2007,7 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
     }
 
     if (battery) {
-        GET_BOOL_EXTRA(present, "present") /* == BatteryManager.EXTRA_PRESENT (API 5) */
-        *battery = present ? 1 : 0;
+        *battery = GET_BOOL_EXTRA(mBatteryExtraPresent) ? 1 : 0;
     }
 
     if (seconds) {
@@ -1971,19 +2015,8 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
     }
 
     if (percent) {
-        int level;
-        int scale;
-
-        /* Watch out for C89 scoping rules because of the macro */
-        {
-            GET_INT_EXTRA(level_temp, "level") /* == BatteryManager.EXTRA_LEVEL (API 5) */
-            level = level_temp;
-        }
-        /* Watch out for C89 scoping rules because of the macro */
-        {
-            GET_INT_EXTRA(scale_temp, "scale") /* == BatteryManager.EXTRA_SCALE (API 5) */
-            scale = scale_temp;
-        }
+        const int level = GET_INT_EXTRA(mBatteryExtraLevel);
+        const int scale = GET_INT_EXTRA(mBatteryExtraScale);
 
         if ((level == -1) || (scale == -1)) {
             LocalReferenceHolder_Cleanup(&refs);
@@ -1992,6 +2025,9 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
         *percent = level * 100 / scale;
     }
 
+#undef GET_INT_EXTRA
+#undef GET_BOOL_EXTRA
+
     (*env)->DeleteLocalRef(env, intent);
 
     LocalReferenceHolder_Cleanup(&refs);
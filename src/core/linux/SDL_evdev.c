@@ -37,6 +37,10 @@
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <linux/input.h>
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/epoll.h>
+#define SDL_EVDEV_USE_EPOLL
+#endif
 
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_scancode_tables_c.h"
@@ -75,6 +79,9 @@ typedef struct SDL_evdevlist_item
     int fd;
     int udev_class;
 
+    /* Set when the epoll set reports input waiting on fd */
+    SDL_bool ready;
+
     /* TODO: use this for every device, not just touchscreen */
     SDL_bool out_of_sync;
 
@@ -126,6 +133,7 @@ typedef struct SDL_EVDEV_PrivateData
     SDL_evdevlist_item *first;
     SDL_evdevlist_item *last;
     SDL_EVDEV_keyboard_state *kbd;
+    int epoll_fd; /* -1 if every device is read on every poll */
 } SDL_EVDEV_PrivateData;
 
 static SDL_EVDEV_PrivateData *_this = NULL;
@@ -135,6 +143,7 @@ static void SDL_EVDEV_sync_device(SDL_evdevlist_item *item);
 static int SDL_EVDEV_device_removed(const char *dev_path);
 
 static int SDL_EVDEV_device_added(const char *dev_path, int udev_class);
+static void SDL_EVDEV_watch_fd(int fd, void *data);
 #ifdef SDL_USE_LIBUDEV
 static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_class, const char *dev_path);
 #endif /* SDL_USE_LIBUDEV */
@@ -173,8 +182,18 @@ int SDL_EVDEV_Init(void)
             return -1;
         }
 
+        /* Only devices with input waiting are read, if the system supports it */
+#ifdef SDL_EVDEV_USE_EPOLL
+        _this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+#else
+        _this->epoll_fd = -1;
+#endif
+
 #ifdef SDL_USE_LIBUDEV
         if (SDL_UDEV_Init() < 0) {
+            if (_this->epoll_fd >= 0) {
+                close(_this->epoll_fd);
+            }
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -183,11 +202,17 @@ int SDL_EVDEV_Init(void)
         /* Set up the udev callback */
         if (SDL_UDEV_AddCallback(SDL_EVDEV_udev_callback) < 0) {
             SDL_UDEV_Quit();
+            if (_this->epoll_fd >= 0) {
+                close(_this->epoll_fd);
+            }
             SDL_free(_this);
             _this = NULL;
             return -1;
         }
 
+        /* Wake up event loops waiting on the epoll fd for hotplug too */
+        SDL_EVDEV_watch_fd(SDL_UDEV_GetMonitorFd(), NULL);
+
         /* Force a scan to build the initial device list */
         SDL_UDEV_Scan();
 #else
@@ -220,6 +245,11 @@ int SDL_EVDEV_Init(void)
         _this->kbd = SDL_EVDEV_kbd_init();
 
         SDL_EVDEV_UpdateKeyboardMute();
+
+        if (_this->epoll_fd >= 0) {
+            SDL_SetNumberProperty(SDL_GetGlobalProperties(), SDL_PROP_GLOBAL_VIDEO_EVDEV_INPUT_FD_NUMBER, _this->epoll_fd);
+            SDL_AddEventWaitSource(_this->epoll_fd);
+        }
     }
 
     SDL_GetMouse()->SetRelativeMouseMode = SDL_EVDEV_SetRelativeMouseMode;
@@ -254,6 +284,12 @@ void SDL_EVDEV_Quit(void)
         SDL_assert(_this->last == NULL);
         SDL_assert(_this->num_devices == 0);
 
+        if (_this->epoll_fd >= 0) {
+            SDL_ClearProperty(SDL_GetGlobalProperties(), SDL_PROP_GLOBAL_VIDEO_EVDEV_INPUT_FD_NUMBER);
+            SDL_RemoveEventWaitSource(_this->epoll_fd);
+            close(_this->epoll_fd);
+        }
+
         SDL_free(_this);
         _this = NULL;
     }
@@ -309,9 +345,51 @@ int SDL_EVDEV_GetDeviceCount(int device_class)
     return count;
 }
 
+static void SDL_EVDEV_watch_fd(int fd, void *data)
+{
+#ifdef SDL_EVDEV_USE_EPOLL
+    if (_this->epoll_fd >= 0 && fd >= 0) {
+        struct epoll_event event;
+
+        SDL_zero(event);
+        event.events = EPOLLIN;
+        event.data.ptr = data;
+        epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+#endif
+}
+
+static void SDL_EVDEV_unwatch_fd(int fd)
+{
+#ifdef SDL_EVDEV_USE_EPOLL
+    if (_this->epoll_fd >= 0) {
+        epoll_ctl(_this->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    }
+#endif
+}
+
+/* Mark the devices that have input waiting, so idle devices aren't read */
+static void SDL_EVDEV_find_ready_devices(void)
+{
+#ifdef SDL_EVDEV_USE_EPOLL
+    struct epoll_event ready[32];
+    int i, count;
+
+    /* Devices that don't fit are still ready on the next poll, and epoll rotates them to the front */
+    count = epoll_wait(_this->epoll_fd, ready, SDL_arraysize(ready), 0);
+    for (i = 0; i < count; ++i) {
+        SDL_evdevlist_item *item = (SDL_evdevlist_item *)ready[i].data.ptr;
+        if (item) {
+            item->ready = SDL_TRUE;
+        }
+    }
+#endif
+}
+
 void SDL_EVDEV_Poll(void)
 {
-    struct input_event events[32];
+    /* Read in big batches, a busy touchscreen can queue hundreds of events per frame */
+    struct input_event events[128];
     int i, j, len;
     SDL_evdevlist_item *item;
     SDL_Scancode scancode;
@@ -331,7 +409,18 @@ void SDL_EVDEV_Poll(void)
 
     mouse = SDL_GetMouse();
 
+    if (_this->epoll_fd >= 0) {
+        SDL_EVDEV_find_ready_devices();
+    }
+
     for (item = _this->first; item; item = item->next) {
+        if (_this->epoll_fd >= 0) {
+            if (!item->ready) {
+                continue;
+            }
+            item->ready = SDL_FALSE;
+        }
+
         while ((len = read(item->fd, events, sizeof(events))) > 0) {
             len /= sizeof(events[0]);
             for (i = 0; i < len; ++i) {
@@ -577,6 +666,11 @@ void SDL_EVDEV_Poll(void)
                     break;
                 }
             }
+
+            /* A short read means the device has nothing more queued */
+            if (len < (int)SDL_arraysize(events)) {
+                break;
+            }
         }
     }
 }
@@ -967,6 +1061,8 @@ static int SDL_EVDEV_device_added(const char *dev_path, int udev_class)
 
     SDL_EVDEV_sync_device(item);
 
+    SDL_EVDEV_watch_fd(item->fd, item);
+
     SDL_EVDEV_UpdateKeyboardMute();
 
     return _this->num_devices++;
@@ -996,6 +1092,7 @@ static int SDL_EVDEV_device_removed(const char *dev_path)
             } else if (item->udev_class & SDL_UDEV_DEVICE_KEYBOARD) {
                 SDL_EVDEV_destroy_keyboard(item);
             }
+            SDL_EVDEV_unwatch_fd(item->fd);
             close(item->fd);
             SDL_free(item->path);
             SDL_free(item);
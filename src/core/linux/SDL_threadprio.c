@@ -58,6 +58,9 @@ static const char *rtkit_dbus_path;
 static const char *rtkit_dbus_interface;
 
 static pthread_once_t rtkit_initialize_once = PTHREAD_ONCE_INIT;
+static pthread_once_t rtkit_rttime_once = PTHREAD_ONCE_INIT;
+static SDL_bool rtkit_available;
+static SDL_bool rtkit_rttime_set;
 static Sint32 rtkit_min_nice_level = -20;
 static Sint32 rtkit_max_realtime_priority = 99;
 static Sint64 rtkit_max_rttime_usec = 200000;
@@ -103,6 +106,7 @@ static DBusConnection *get_rtkit_dbus_connection(void)
     return NULL;
 }
 
+/* The limits are queried once, every later priority change only makes the one D-Bus call it needs */
 static void rtkit_initialize(void)
 {
     DBusConnection *dbus_conn;
@@ -110,9 +114,12 @@ static void rtkit_initialize(void)
     set_rtkit_interface();
     dbus_conn = get_rtkit_dbus_connection();
 
-    /* Try getting minimum nice level: this is often greater than PRIO_MIN (-20). */
-    if (!dbus_conn || !SDL_DBus_QueryPropertyOnConnection(dbus_conn, rtkit_dbus_node, rtkit_dbus_path, rtkit_dbus_interface, "MinNiceLevel",
-                                                                 DBUS_TYPE_INT32, &rtkit_min_nice_level)) {
+    /* Try getting minimum nice level: this is often greater than PRIO_MIN (-20).
+       If the service can't answer this, it won't answer priority requests either. */
+    if (dbus_conn && SDL_DBus_QueryPropertyOnConnection(dbus_conn, rtkit_dbus_node, rtkit_dbus_path, rtkit_dbus_interface, "MinNiceLevel",
+                                                        DBUS_TYPE_INT32, &rtkit_min_nice_level)) {
+        rtkit_available = SDL_TRUE;
+    } else {
         rtkit_min_nice_level = -20;
     }
 
@@ -129,7 +136,34 @@ static void rtkit_initialize(void)
     }
 }
 
-static SDL_bool rtkit_initialize_realtime_thread(void)
+/* RLIMIT_RTTIME is per process, so it only needs to be set up once */
+static void rtkit_initialize_rttime(void)
+{
+    struct rlimit rlimit;
+    rlim_t max_rttime;
+
+    if (getrlimit(RLIMIT_RTTIME, &rlimit) != 0) {
+        return;
+    }
+
+    // rtkit refuses processes whose hard limit is above its own maximum,
+    // and an unprivileged process can lower its hard limit but never raise it.
+    max_rttime = (rlim_t)rtkit_max_rttime_usec;
+    if (rlimit.rlim_max == RLIM_INFINITY || rlimit.rlim_max > max_rttime) {
+        rlimit.rlim_max = max_rttime;
+    }
+
+    // The soft limit sends SIGXCPU before the hard limit sends SIGKILL
+    if (rlimit.rlim_cur == RLIM_INFINITY || rlimit.rlim_cur > rlimit.rlim_max / 2) {
+        rlimit.rlim_cur = rlimit.rlim_max / 2;
+    }
+
+    if (setrlimit(RLIMIT_RTTIME, &rlimit) == 0) {
+        rtkit_rttime_set = SDL_TRUE;
+    }
+}
+
+static SDL_bool rtkit_initialize_realtime_thread(pid_t thread)
 {
     // Following is an excerpt from rtkit README that outlines the requirements
     // a thread must meet before making rtkit requests:
@@ -152,35 +186,32 @@ static SDL_bool rtkit_initialize_realtime_thread(void)
     //   * Client authorization is verified with PolicyKit
 
     int err;
-    struct rlimit rlimit;
-    int nLimit = RLIMIT_RTTIME;
-    pid_t nPid = 0; // self
-    int nSchedPolicy = sched_getscheduler(nPid) | SCHED_RESET_ON_FORK;
+    int nSchedPolicy;
     struct sched_param schedParam;
 
     SDL_zero(schedParam);
 
     // Requirement #1: Set RLIMIT_RTTIME
-    err = getrlimit(nLimit, &rlimit);
-    if (err) {
+    pthread_once(&rtkit_rttime_once, rtkit_initialize_rttime);
+    if (!rtkit_rttime_set) {
         return SDL_FALSE;
     }
 
-    // Current rtkit allows a max of 200ms right now
-    rlimit.rlim_max = rtkit_max_rttime_usec;
-    rlimit.rlim_cur = rlimit.rlim_max / 2;
-    err = setrlimit(nLimit, &rlimit);
-    if (err) {
+    // Requirement #2: Add SCHED_RESET_ON_FORK to the scheduler policy
+    nSchedPolicy = sched_getscheduler(thread);
+    if (nSchedPolicy < 0) {
         return SDL_FALSE;
     }
+    if (nSchedPolicy & SCHED_RESET_ON_FORK) {
+        return SDL_TRUE;
+    }
 
-    // Requirement #2: Add SCHED_RESET_ON_FORK to the scheduler policy
-    err = sched_getparam(nPid, &schedParam);
+    err = sched_getparam(thread, &schedParam);
     if (err) {
         return SDL_FALSE;
     }
 
-    err = sched_setscheduler(nPid, nSchedPolicy, &schedParam);
+    err = sched_setscheduler(thread, nSchedPolicy | SCHED_RESET_ON_FORK, &schedParam);
     if (err) {
         return SDL_FALSE;
     }
@@ -196,6 +227,9 @@ static SDL_bool rtkit_setpriority_nice(pid_t thread, int nice_level)
     Sint32 nice = (Sint32)nice_level;
 
     pthread_once(&rtkit_initialize_once, rtkit_initialize);
+    if (!rtkit_available) {
+        return SDL_FALSE;
+    }
     dbus_conn = get_rtkit_dbus_connection();
 
     if (nice < rtkit_min_nice_level) {
@@ -219,19 +253,20 @@ static SDL_bool rtkit_setpriority_realtime(pid_t thread, int rt_priority)
     Uint32 priority = (Uint32)rt_priority;
 
     pthread_once(&rtkit_initialize_once, rtkit_initialize);
+    if (!rtkit_available) {
+        return SDL_FALSE;
+    }
     dbus_conn = get_rtkit_dbus_connection();
 
     if (priority > rtkit_max_realtime_priority) {
         priority = rtkit_max_realtime_priority;
     }
 
-    // We always perform the thread state changes necessary for rtkit.
-    // This wastes some system calls if the state is already set but
-    // typically code sets a thread priority and leaves it so it's
-    // not expected that this wasted effort will be an issue.
-    // We also do not quit if this fails, we let the rtkit request
-    // go through to determine whether it really needs to fail or not.
-    rtkit_initialize_realtime_thread();
+    // We always make sure the thread state is what rtkit needs, which
+    // only costs system calls the first time for each thread. We also
+    // do not quit if this fails, we let the rtkit request go through
+    // to determine whether it really needs to fail or not.
+    rtkit_initialize_realtime_thread(thread);
 
     if (!dbus_conn || !SDL_DBus_CallMethodOnConnection(dbus_conn,
                                                               rtkit_dbus_node, rtkit_dbus_path, rtkit_dbus_interface, "MakeThreadRealtimeWithPID",
@@ -246,6 +281,20 @@ static SDL_bool rtkit_setpriority_realtime(pid_t thread, int rt_priority)
 #define rtkit_max_realtime_priority 99
 
 #endif /* dbus */
+
+/* Try to make the thread realtime directly, which works without rtkit
+   when the process has RLIMIT_RTPRIO or CAP_SYS_NICE */
+static SDL_bool set_realtime_priority_direct(pid_t thread, int schedPolicy, int rt_priority)
+{
+    struct sched_param schedParam;
+
+    SDL_zero(schedParam);
+    schedParam.sched_priority = rt_priority;
+    if (sched_setscheduler(thread, schedPolicy | SCHED_RESET_ON_FORK, &schedParam) == 0) {
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
 #endif /* threads */
 
 /* this is a public symbol, so it has to exist even if threads are disabled. */
@@ -288,6 +337,13 @@ int SDL_SetLinuxThreadPriorityAndPolicy(Sint64 threadID, int sdlPriority, int sc
 #else
     int osPriority;
 
+#ifdef SDL_USE_LIBDBUS
+    // The realtime priority range depends on what rtkit allows
+    if (schedPolicy == SCHED_RR || schedPolicy == SCHED_FIFO) {
+        pthread_once(&rtkit_initialize_once, rtkit_initialize);
+    }
+#endif
+
     if (schedPolicy == SCHED_RR || schedPolicy == SCHED_FIFO) {
         if (sdlPriority == SDL_THREAD_PRIORITY_LOW) {
             osPriority = 1;
@@ -298,6 +354,10 @@ int SDL_SetLinuxThreadPriorityAndPolicy(Sint64 threadID, int sdlPriority, int sc
         } else {
             osPriority = rtkit_max_realtime_priority / 2;
         }
+
+        if (set_realtime_priority_direct((pid_t)threadID, schedPolicy, osPriority)) {
+            return 0;
+        }
     } else {
         if (sdlPriority == SDL_THREAD_PRIORITY_LOW) {
             osPriority = 19;
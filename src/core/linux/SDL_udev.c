@@ -577,6 +577,14 @@ void SDL_UDEV_DelCallback(SDL_UDEV_Callback cb)
     }
 }
 
+int SDL_UDEV_GetMonitorFd(void)
+{
+    if (_this && _this->udev_mon) {
+        return _this->syms.udev_monitor_get_fd(_this->udev_mon);
+    }
+    return -1;
+}
+
 const SDL_UDEV_Symbols *SDL_UDEV_GetUdevSyms(void)
 {
     if (SDL_UDEV_Init() < 0) {
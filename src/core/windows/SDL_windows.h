@@ -163,6 +163,11 @@ extern BOOL WIN_IsRectEmpty(const RECT *rect);
 
 extern SDL_AudioFormat SDL_WaveFormatExToSDLFormat(WAVEFORMATEX *waveformat);
 
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+/* Returns a high resolution waitable timer for the current thread, or NULL if it couldn't be created */
+extern HANDLE SDL_GetWaitableTimer(void);
+#endif
+
 /* WideCharToMultiByte, but with some WinXP manangement. */
 extern int WIN_WideCharToMultiByte(UINT CodePage, DWORD dwFlags, LPCWCH lpWideCharStr, int cchWideChar, LPSTR lpMultiByteStr, int cbMultiByte, LPCCH lpDefaultChar, LPBOOL lpUsedDefaultChar);
 
@@ -36,6 +36,10 @@
 #include <sys/types.h>
 #include <sys/sysctl.h>
 #endif
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #if defined(SDL_PLATFORM_MACOS) && (defined(__ppc__) || defined(__ppc64__))
 #include <sys/sysctl.h> /* For AltiVec check */
 #elif defined(SDL_PLATFORM_OPENBSD) && defined(__powerpc__)
@@ -108,6 +112,7 @@
 #define CPU_HAS_ARM_SIMD (1 << 11)
 #define CPU_HAS_LSX      (1 << 12)
 #define CPU_HAS_LASX     (1 << 13)
+#define CPU_HAS_PCLMUL   (1 << 14)
 
 #define CPU_CFG2      0x2
 #define CPU_CFG2_LSX  (1 << 6)
@@ -562,6 +567,11 @@ static int CPU_readCPUCFG(void)
 #else
 #define CPU_haveAVX() (0)
 #endif
+#ifdef __PCLMUL__
+#define CPU_havePCLMUL() (1)
+#else
+#define CPU_havePCLMUL() (0)
+#endif
 #else
 #define CPU_haveMMX()   (CPU_CPUIDFeatures[3] & 0x00800000)
 #define CPU_haveSSE()   (CPU_CPUIDFeatures[3] & 0x02000000)
@@ -570,6 +580,7 @@ static int CPU_readCPUCFG(void)
 #define CPU_haveSSE41() (CPU_CPUIDFeatures[2] & 0x00080000)
 #define CPU_haveSSE42() (CPU_CPUIDFeatures[2] & 0x00100000)
 #define CPU_haveAVX()   (CPU_OSSavesYMM && (CPU_CPUIDFeatures[2] & 0x10000000))
+#define CPU_havePCLMUL() (CPU_CPUIDFeatures[2] & 0x00000002)
 #endif
 
 #ifdef __e2k__
@@ -651,6 +662,317 @@ int SDL_GetCPUCount(void)
     return SDL_CPUCount;
 }
 
+/* The topology masks describe at most this many logical CPUs */
+#define SDL_MAX_TOPOLOGY_CPUS 64
+
+#define SDL_CPU_BIT(cpu) ((Uint64)1 << (cpu))
+
+typedef struct SDL_CPUTopology
+{
+    int num_performance;
+    int num_efficiency;
+    Uint64 performance_mask;
+    Uint64 efficiency_mask;
+    Uint64 cache_sharing[SDL_MAX_TOPOLOGY_CPUS]; /* 0 if unknown */
+} SDL_CPUTopology;
+
+static SDL_CPUTopology SDL_CPUTopologyInfo;
+static SDL_bool SDL_CPUTopologyChecked = SDL_FALSE;
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+/* Read a small sysfs file into buffer, without touching the SDL error */
+static SDL_bool SDL_ReadCPUSysFile(const char *path, char *buffer, size_t size)
+{
+    ssize_t amount;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return SDL_FALSE;
+    }
+    amount = read(fd, buffer, size - 1);
+    close(fd);
+    if (amount <= 0) {
+        return SDL_FALSE;
+    }
+    buffer[amount] = '\0';
+    return SDL_TRUE;
+}
+
+/* Parse a CPU list like "0-3,8,10-11", returning the number of CPUs in it */
+static int SDL_ParseCPUList(const char *list, Uint64 *mask)
+{
+    int count = 0;
+
+    *mask = 0;
+    while (*list) {
+        char *end;
+        long first, last;
+
+        first = SDL_strtol(list, &end, 10);
+        if (end == list) {
+            break;
+        }
+        last = first;
+        if (*end == '-') {
+            list = end + 1;
+            last = SDL_strtol(list, &end, 10);
+            if (end == list) {
+                break;
+            }
+        }
+        for (; first <= last; ++first) {
+            if (first >= 0 && first < SDL_MAX_TOPOLOGY_CPUS) {
+                *mask |= SDL_CPU_BIT(first);
+            }
+            ++count;
+        }
+        list = end;
+        if (*list != ',') {
+            break;
+        }
+        ++list;
+    }
+    return count;
+}
+
+static void SDL_GetLinuxCPUTopology(SDL_CPUTopology *topology, int num_cpus)
+{
+    char path[128];
+    char text[1024];
+    int cpu;
+
+    /* Intel hybrid processors have a separate PMU for each core type */
+    if (SDL_ReadCPUSysFile("/sys/devices/cpu_core/cpus", text, sizeof(text))) {
+        topology->num_performance = SDL_ParseCPUList(text, &topology->performance_mask);
+        if (SDL_ReadCPUSysFile("/sys/devices/cpu_atom/cpus", text, sizeof(text))) {
+            topology->num_efficiency = SDL_ParseCPUList(text, &topology->efficiency_mask);
+        }
+    } else {
+        /* ARM big.LITTLE reports the relative capacity of each CPU */
+        int *capacity = (int *)SDL_malloc(num_cpus * sizeof(*capacity));
+        if (capacity) {
+            int max_capacity = 0;
+            int min_capacity = SDL_MAX_SINT32;
+
+            for (cpu = 0; cpu < num_cpus; ++cpu) {
+                (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu);
+                if (!SDL_ReadCPUSysFile(path, text, sizeof(text))) {
+                    break;
+                }
+                capacity[cpu] = SDL_atoi(text);
+                max_capacity = SDL_max(max_capacity, capacity[cpu]);
+                min_capacity = SDL_min(min_capacity, capacity[cpu]);
+            }
+            if (cpu == num_cpus && min_capacity < max_capacity) {
+                for (cpu = 0; cpu < num_cpus; ++cpu) {
+                    const Uint64 bit = (cpu < SDL_MAX_TOPOLOGY_CPUS) ? SDL_CPU_BIT(cpu) : 0;
+                    if (capacity[cpu] == max_capacity) {
+                        topology->performance_mask |= bit;
+                        ++topology->num_performance;
+                    } else {
+                        topology->efficiency_mask |= bit;
+                        ++topology->num_efficiency;
+                    }
+                }
+            }
+            SDL_free(capacity);
+        }
+    }
+
+    /* The highest cache index with the highest level is the last level cache */
+    for (cpu = 0; cpu < num_cpus && cpu < SDL_MAX_TOPOLOGY_CPUS; ++cpu) {
+        int index, best_level = 0;
+
+        for (index = 0;; ++index) {
+            int level;
+            Uint64 mask;
+
+            (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index);
+            if (!SDL_ReadCPUSysFile(path, text, sizeof(text))) {
+                break;
+            }
+            level = SDL_atoi(text);
+            if (level < best_level) {
+                continue;
+            }
+            (void)SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+            if (SDL_ReadCPUSysFile(path, text, sizeof(text)) && SDL_ParseCPUList(text, &mask) > 0) {
+                topology->cache_sharing[cpu] = mask;
+                best_level = level;
+            }
+        }
+    }
+}
+#elif defined(SDL_PLATFORM_WIN32) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES) && (_WIN32_WINNT >= 0x0601)
+static int SDL_CountAffinityBits(KAFFINITY mask)
+{
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        ++count;
+    }
+    return count;
+}
+
+static void SDL_GetWindowsCPUTopology(SDL_CPUTopology *topology)
+{
+    PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info;
+    BYTE *buffer;
+    DWORD size = 0;
+    DWORD offset;
+    BYTE max_class = 0;
+    BYTE min_class = 0xFF;
+    BYTE cache_level[SDL_MAX_TOPOLOGY_CPUS];
+
+    if (GetLogicalProcessorInformationEx(RelationAll, NULL, &size) || GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return;
+    }
+    buffer = (BYTE *)SDL_malloc(size);
+    if (!buffer) {
+        return;
+    }
+    if (!GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &size)) {
+        SDL_free(buffer);
+        return;
+    }
+
+    /* The higher the efficiency class, the faster the core */
+    for (offset = 0; offset < size; offset += info->Size) {
+        info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        if (info->Relationship == RelationProcessorCore) {
+            max_class = SDL_max(max_class, info->Processor.EfficiencyClass);
+            min_class = SDL_min(min_class, info->Processor.EfficiencyClass);
+        }
+    }
+
+    SDL_zeroa(cache_level);
+    for (offset = 0; offset < size; offset += info->Size) {
+        info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        if (info->Relationship == RelationProcessorCore && min_class < max_class) {
+            WORD group;
+            for (group = 0; group < info->Processor.GroupCount; ++group) {
+                const GROUP_AFFINITY *affinity = &info->Processor.GroupMask[group];
+                const int count = SDL_CountAffinityBits(affinity->Mask);
+                const Uint64 mask = (affinity->Group == 0) ? (Uint64)affinity->Mask : 0;
+                if (info->Processor.EfficiencyClass == max_class) {
+                    topology->performance_mask |= mask;
+                    topology->num_performance += count;
+                } else {
+                    topology->efficiency_mask |= mask;
+                    topology->num_efficiency += count;
+                }
+            }
+        } else if (info->Relationship == RelationCache && info->Cache.GroupMask.Group == 0) {
+            const Uint64 mask = (Uint64)info->Cache.GroupMask.Mask;
+            int cpu;
+            for (cpu = 0; cpu < SDL_MAX_TOPOLOGY_CPUS; ++cpu) {
+                if ((mask & SDL_CPU_BIT(cpu)) && info->Cache.Level >= cache_level[cpu]) {
+                    topology->cache_sharing[cpu] = mask;
+                    cache_level[cpu] = info->Cache.Level;
+                }
+            }
+        }
+    }
+    SDL_free(buffer);
+}
+#elif defined(SDL_PLATFORM_APPLE) && defined(HAVE_SYSCTLBYNAME)
+/* Apple reports how many cores of each kind there are, but not which ones */
+static void SDL_GetAppleCPUTopology(SDL_CPUTopology *topology)
+{
+    int levels = 0;
+    int performance = 0;
+    int efficiency = 0;
+    size_t size = sizeof(levels);
+
+    if (sysctlbyname("hw.nperflevels", &levels, &size, NULL, 0) != 0 || levels < 2) {
+        return;
+    }
+    size = sizeof(performance);
+    if (sysctlbyname("hw.perflevel0.logicalcpu", &performance, &size, NULL, 0) != 0) {
+        return;
+    }
+    size = sizeof(efficiency);
+    if (sysctlbyname("hw.perflevel1.logicalcpu", &efficiency, &size, NULL, 0) != 0) {
+        return;
+    }
+    topology->num_performance = performance;
+    topology->num_efficiency = efficiency;
+}
+#endif
+
+static const SDL_CPUTopology *SDL_GetCPUTopology(void)
+{
+    if (!SDL_CPUTopologyChecked) {
+        SDL_CPUTopology topology;
+        const int num_cpus = SDL_GetCPUCount();
+
+        SDL_zero(topology);
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+        SDL_GetLinuxCPUTopology(&topology, num_cpus);
+#elif defined(SDL_PLATFORM_WIN32) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES) && (_WIN32_WINNT >= 0x0601)
+        SDL_GetWindowsCPUTopology(&topology);
+#elif defined(SDL_PLATFORM_APPLE) && defined(HAVE_SYSCTLBYNAME)
+        SDL_GetAppleCPUTopology(&topology);
+#endif
+        /* Without hybrid information every core is a performance core */
+        if (topology.num_performance <= 0) {
+            topology.num_performance = num_cpus;
+            topology.num_efficiency = 0;
+            if (num_cpus >= SDL_MAX_TOPOLOGY_CPUS) {
+                topology.performance_mask = ~(Uint64)0;
+            } else {
+                topology.performance_mask = SDL_CPU_BIT(num_cpus) - 1;
+            }
+            topology.efficiency_mask = 0;
+        }
+
+        SDL_copyp(&SDL_CPUTopologyInfo, &topology);
+        SDL_CPUTopologyChecked = SDL_TRUE;
+    }
+    return &SDL_CPUTopologyInfo;
+}
+
+int SDL_GetCPUCoreCount(SDL_CPUCoreType type)
+{
+    const SDL_CPUTopology *topology = SDL_GetCPUTopology();
+
+    switch (type) {
+    case SDL_CPU_CORE_TYPE_PERFORMANCE:
+        return topology->num_performance;
+    case SDL_CPU_CORE_TYPE_EFFICIENCY:
+        return topology->num_efficiency;
+    default:
+        return SDL_GetCPUCount();
+    }
+}
+
+Uint64 SDL_GetCPUCoreMask(SDL_CPUCoreType type)
+{
+    const SDL_CPUTopology *topology = SDL_GetCPUTopology();
+
+    switch (type) {
+    case SDL_CPU_CORE_TYPE_PERFORMANCE:
+        return topology->performance_mask;
+    case SDL_CPU_CORE_TYPE_EFFICIENCY:
+        return topology->efficiency_mask;
+    default:
+        return topology->performance_mask | topology->efficiency_mask;
+    }
+}
+
+Uint64 SDL_GetCPUCacheSharingMask(int cpu)
+{
+    const SDL_CPUTopology *topology;
+
+    if (cpu < 0 || cpu >= SDL_MAX_TOPOLOGY_CPUS) {
+        return 0;
+    }
+    topology = SDL_GetCPUTopology();
+    if (topology->cache_sharing[cpu]) {
+        return topology->cache_sharing[cpu];
+    }
+    return SDL_CPU_BIT(cpu);
+}
+
 #ifdef __e2k__
 inline const char *
 SDL_GetCPUType(void)
@@ -887,6 +1209,7 @@ int SDL_GetCPUCacheLineSize(void)
 
 static Uint32 SDL_CPUFeatures = SDL_CPUFEATURES_RESET_VALUE;
 static Uint32 SDL_SIMDAlignment = 0xFFFFFFFF;
+static Uint32 SDL_CPUDispatchGeneration = 1;
 
 static SDL_bool ref_string_equals(const char *ref, const char *test, const char *end_test) {
     size_t len_test = end_test - test;
@@ -948,6 +1271,8 @@ static Uint32 SDLCALL SDL_CPUFeatureMaskFromHint(void)
                 spot_mask = CPU_HAS_LSX;
             } else if (ref_string_equals("lasx", spot, end)) {
                 spot_mask = CPU_HAS_LASX;
+            } else if (ref_string_equals("pclmul", spot, end)) {
+                spot_mask = CPU_HAS_PCLMUL;
             } else {
                 /* Ignore unknown/incorrect cpu feature(s) */
                 continue;
@@ -1024,13 +1349,66 @@ static Uint32 SDL_GetCPUFeatures(void)
             SDL_CPUFeatures |= CPU_HAS_LASX;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 32);
         }
+        if (CPU_havePCLMUL()) {
+            SDL_CPUFeatures |= CPU_HAS_PCLMUL;
+        }
         SDL_CPUFeatures &= SDL_CPUFeatureMaskFromHint();
     }
     return SDL_CPUFeatures;
 }
 
+void SDL_InitCPUInfo(void)
+{
+    static const struct
+    {
+        Uint32 feature;
+        const char *name;
+    } features[] = {
+        { CPU_HAS_ALTIVEC, "altivec" },
+        { CPU_HAS_MMX, "mmx" },
+        { CPU_HAS_SSE, "sse" },
+        { CPU_HAS_SSE2, "sse2" },
+        { CPU_HAS_SSE3, "sse3" },
+        { CPU_HAS_SSE41, "sse41" },
+        { CPU_HAS_SSE42, "sse42" },
+        { CPU_HAS_AVX, "avx" },
+        { CPU_HAS_AVX2, "avx2" },
+        { CPU_HAS_AVX512F, "avx512f" },
+        { CPU_HAS_ARM_SIMD, "arm-simd" },
+        { CPU_HAS_NEON, "neon" },
+        { CPU_HAS_LSX, "lsx" },
+        { CPU_HAS_LASX, "lasx" },
+        { CPU_HAS_PCLMUL, "pclmul" },
+    };
+    char text[256];
+    Uint32 cpu_features;
+    int i;
+
+    if (SDL_CPUFeatures != SDL_CPUFEATURES_RESET_VALUE) {
+        return;
+    }
+
+    /* Detect everything up front, now that hints are available, so every SIMD kernel choice agrees */
+    cpu_features = SDL_GetCPUFeatures();
+
+    text[0] = '\0';
+    for (i = 0; i < SDL_arraysize(features); ++i) {
+        if (cpu_features & features[i].feature) {
+            SDL_strlcat(text, " ", sizeof(text));
+            SDL_strlcat(text, features[i].name, sizeof(text));
+        }
+    }
+    SDL_LogDebug(SDL_LOG_CATEGORY_SYSTEM, "CPU features used for SIMD dispatch:%s", text[0] ? text : " none");
+}
+
 void SDL_QuitCPUInfo(void) {
     SDL_CPUFeatures = SDL_CPUFEATURES_RESET_VALUE;
+    ++SDL_CPUDispatchGeneration;
+}
+
+Uint32 SDL_GetCPUDispatchGeneration(void)
+{
+    return SDL_CPUDispatchGeneration;
 }
 
 #define CPU_FEATURE_AVAILABLE(f) ((SDL_GetCPUFeatures() & (f)) ? SDL_TRUE : SDL_FALSE)
@@ -1105,6 +1483,11 @@ SDL_bool SDL_HasLASX(void)
     return CPU_FEATURE_AVAILABLE(CPU_HAS_LASX);
 }
 
+SDL_bool SDL_HasPCLMUL(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_PCLMUL);
+}
+
 static int SDL_SystemRAM = 0;
 
 int SDL_GetSystemRAM(void)
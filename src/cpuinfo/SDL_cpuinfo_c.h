@@ -22,6 +22,14 @@
 #ifndef SDL_cpuinfo_c_h_
 #define SDL_cpuinfo_c_h_
 
+extern void SDL_InitCPUInfo(void);
 extern void SDL_QuitCPUInfo(void);
 
+/* Code that caches a choice of SIMD kernels should make it again when this changes.
+   It changes after SDL_Quit(), so a new SDL_HINT_CPU_FEATURE_MASK takes effect on the next SDL_Init(). */
+extern Uint32 SDL_GetCPUDispatchGeneration(void);
+
+/* Features that SDL uses internally but doesn't expose in the public API */
+extern SDL_bool SDL_HasPCLMUL(void);
+
 #endif /* SDL_cpuinfo_c_h_ */
@@ -1093,3 +1093,101 @@
 #define SDL_wcsnstr SDL_wcsnstr_REAL
 #define SDL_wcsstr SDL_wcsstr_REAL
 #define SDL_wcstol SDL_wcstol_REAL
+#define SDL_RenderTextureInstanced SDL_RenderTextureInstanced_REAL
+#define SDL_CreateRenderCommandList SDL_CreateRenderCommandList_REAL
+#define SDL_RecordRenderGeometry SDL_RecordRenderGeometry_REAL
+#define SDL_RecordRenderTextureInstanced SDL_RecordRenderTextureInstanced_REAL
+#define SDL_SubmitRenderCommandList SDL_SubmitRenderCommandList_REAL
+#define SDL_ClearRenderCommandList SDL_ClearRenderCommandList_REAL
+#define SDL_DestroyRenderCommandList SDL_DestroyRenderCommandList_REAL
+#define SDL_GetRenderStats SDL_GetRenderStats_REAL
+#define SDL_UpdateTextureAsync SDL_UpdateTextureAsync_REAL
+#define SDL_CreateSurfaceView SDL_CreateSurfaceView_REAL
+#define SDL_CreateSurfaceWithProperties SDL_CreateSurfaceWithProperties_REAL
+#define SDL_SetAudioStreamSingleProducer SDL_SetAudioStreamSingleProducer_REAL
+#define SDL_PutAudioStreamDataNoCopy SDL_PutAudioStreamDataNoCopy_REAL
+#define SDL_SetAudioDeviceCallback SDL_SetAudioDeviceCallback_REAL
+#define SDL_GetAudioDeviceProperties SDL_GetAudioDeviceProperties_REAL
+#define SDL_OpenWAVStream SDL_OpenWAVStream_REAL
+#define SDL_SeekWAVStream SDL_SeekWAVStream_REAL
+#define SDL_PutAudioStreamPlanarData SDL_PutAudioStreamPlanarData_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_GetMotionHistory SDL_GetMotionHistory_REAL
+#define SDL_GetTimerProperties SDL_GetTimerProperties_REAL
+#define SDL_DelayUntilNS SDL_DelayUntilNS_REAL
+#define SDL_CreateThreadPool SDL_CreateThreadPool_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_CreateJob SDL_CreateJob_REAL
+#define SDL_AddJobDependency SDL_AddJobDependency_REAL
+#define SDL_RunJob SDL_RunJob_REAL
+#define SDL_WaitJob SDL_WaitJob_REAL
+#define SDL_WaitThreadPool SDL_WaitThreadPool_REAL
+#define SDL_DestroyThreadPool SDL_DestroyThreadPool_REAL
+#define SDL_WaitAtomicInt SDL_WaitAtomicInt_REAL
+#define SDL_WaitAtomicIntTimeout SDL_WaitAtomicIntTimeout_REAL
+#define SDL_SignalAtomicInt SDL_SignalAtomicInt_REAL
+#define SDL_BroadcastAtomicInt SDL_BroadcastAtomicInt_REAL
+#define SDL_TryLockTicketLock SDL_TryLockTicketLock_REAL
+#define SDL_LockTicketLock SDL_LockTicketLock_REAL
+#define SDL_UnlockTicketLock SDL_UnlockTicketLock_REAL
+#define SDL_SetLogAsync SDL_SetLogAsync_REAL
+#define SDL_FlushLog SDL_FlushLog_REAL
+#define SDL_GetLogDroppedCount SDL_GetLogDroppedCount_REAL
+#define SDL_CreateMemoryArena SDL_CreateMemoryArena_REAL
+#define SDL_AllocateArenaMemory SDL_AllocateArenaMemory_REAL
+#define SDL_ResetMemoryArena SDL_ResetMemoryArena_REAL
+#define SDL_DestroyMemoryArena SDL_DestroyMemoryArena_REAL
+#define SDL_RadixSort32 SDL_RadixSort32_REAL
+#define SDL_RadixSort64 SDL_RadixSort64_REAL
+#define SDL_IOFromMappedFile SDL_IOFromMappedFile_REAL
+#define SDL_AsyncIOFromFile SDL_AsyncIOFromFile_REAL
+#define SDL_GetAsyncIOSize SDL_GetAsyncIOSize_REAL
+#define SDL_ReadAsyncIO SDL_ReadAsyncIO_REAL
+#define SDL_WriteAsyncIO SDL_WriteAsyncIO_REAL
+#define SDL_CloseAsyncIO SDL_CloseAsyncIO_REAL
+#define SDL_CreateAsyncIOQueue SDL_CreateAsyncIOQueue_REAL
+#define SDL_DestroyAsyncIOQueue SDL_DestroyAsyncIOQueue_REAL
+#define SDL_GetAsyncIOResult SDL_GetAsyncIOResult_REAL
+#define SDL_WaitAsyncIOResult SDL_WaitAsyncIOResult_REAL
+#define SDL_SignalAsyncIOQueue SDL_SignalAsyncIOQueue_REAL
+#define SDL_LoadFileAsync SDL_LoadFileAsync_REAL
+#define SDL_IOFromBuffered SDL_IOFromBuffered_REAL
+#define SDL_ReadIOV SDL_ReadIOV_REAL
+#define SDL_WriteIOV SDL_WriteIOV_REAL
+#define SDL_OpenArchiveStorage SDL_OpenArchiveStorage_REAL
+#define SDL_WriteStorageFileRange SDL_WriteStorageFileRange_REAL
+#define SDL_BeginStorageTransaction SDL_BeginStorageTransaction_REAL
+#define SDL_CommitStorageTransaction SDL_CommitStorageTransaction_REAL
+#define SDL_RollbackStorageTransaction SDL_RollbackStorageTransaction_REAL
+#define SDL_LoadBMPTexture_IO SDL_LoadBMPTexture_IO_REAL
+#define SDL_LoadBMPTexture SDL_LoadBMPTexture_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_SetKMSDRMWindowOverlay SDL_SetKMSDRMWindowOverlay_REAL
+#define SDL_WaitForRenderFrame SDL_WaitForRenderFrame_REAL
+#define SDL_WindowSupportsPresentMode SDL_WindowSupportsPresentMode_REAL
+#define SDL_SetWindowPresentMode SDL_SetWindowPresentMode_REAL
+#define SDL_GetWindowPresentMode SDL_GetWindowPresentMode_REAL
+#define SDL_RenderSupportsPresentMode SDL_RenderSupportsPresentMode_REAL
+#define SDL_SetRenderPresentMode SDL_SetRenderPresentMode_REAL
+#define SDL_GetRenderPresentMode SDL_GetRenderPresentMode_REAL
+#define SDL_GetJoystickSnapshot SDL_GetJoystickSnapshot_REAL
+#define SDL_GetGamepadSensorDataBatch SDL_GetGamepadSensorDataBatch_REAL
+#define SDL_RenderThickLines SDL_RenderThickLines_REAL
+#define SDL_RenderFillCircles SDL_RenderFillCircles_REAL
+#define SDL_UpdateTextureLayer SDL_UpdateTextureLayer_REAL
+#define SDL_RenderTextureLayer SDL_RenderTextureLayer_REAL
+#define SDL_CreateRenderShader SDL_CreateRenderShader_REAL
+#define SDL_SetRenderShader SDL_SetRenderShader_REAL
+#define SDL_DestroyRenderShader SDL_DestroyRenderShader_REAL
+#define SDL_RenderDebugText SDL_RenderDebugText_REAL
+#define SDL_GetEventWaitProperties SDL_GetEventWaitProperties_REAL
+#define SDL_OpenClipboardData SDL_OpenClipboardData_REAL
+#define SDL_GetCPUCoreCount SDL_GetCPUCoreCount_REAL
+#define SDL_GetCPUCoreMask SDL_GetCPUCoreMask_REAL
+#define SDL_GetCPUCacheSharingMask SDL_GetCPUCacheSharingMask_REAL
+#define SDL_GetRectIntersections SDL_GetRectIntersections_REAL
+#define SDL_GetRectIntersectionsFloat SDL_GetRectIntersectionsFloat_REAL
+#define SDL_MapRGBAArray SDL_MapRGBAArray_REAL
+#define SDL_GetRGBAArray SDL_GetRGBAArray_REAL
+#define SDL_GetMemoryStats SDL_GetMemoryStats_REAL
+#define SDL_GetRendererMemoryStats SDL_GetRendererMemoryStats_REAL
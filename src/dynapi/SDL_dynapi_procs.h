@@ -1099,3 +1099,101 @@ SDL_DYNAPI_PROC(size_t,SDL_wcsnlen,(const wchar_t *a, size_t b),(a,b),return)
 SDL_DYNAPI_PROC(wchar_t*,SDL_wcsnstr,(const wchar_t *a, const wchar_t *b, size_t c),(a,b,c),return)
 SDL_DYNAPI_PROC(wchar_t*,SDL_wcsstr,(const wchar_t *a, const wchar_t *b),(a,b),return)
 SDL_DYNAPI_PROC(long,SDL_wcstol,(const wchar_t *a, wchar_t **b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderTextureInstanced,(SDL_Renderer *a, SDL_Texture *b, const SDL_TextureInstance *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_RenderCommandList*,SDL_CreateRenderCommandList,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderGeometry,(SDL_RenderCommandList *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RecordRenderTextureInstanced,(SDL_RenderCommandList *a, SDL_Texture *b, const SDL_TextureInstance *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitRenderCommandList,(SDL_Renderer *a, SDL_RenderCommandList *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ClearRenderCommandList,(SDL_RenderCommandList *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderCommandList,(SDL_RenderCommandList *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetRenderStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_UpdateTextureAsync,(SDL_Texture *a, const SDL_Rect *b, const void *c, int d, SDL_TextureUpdateCallback e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateSurfaceView,(SDL_Surface *a, const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateSurfaceWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamSingleProducer,(SDL_AudioStream *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PutAudioStreamDataNoCopy,(SDL_AudioStream *a, const void *b, int c, SDL_AudioStreamDataCompleteCallback d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioDeviceCallback,(SDL_AudioDeviceID a, SDL_AudioDeviceCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetAudioDeviceProperties,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_OpenWAVStream,(SDL_IOStream *a, SDL_bool b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SeekWAVStream,(SDL_AudioStream *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PutAudioStreamPlanarData,(SDL_AudioStream *a, const void * const*b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetMotionHistory,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetTimerProperties,(SDL_TimerID a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DelayUntilNS,(Uint64 a),(a),)
+SDL_DYNAPI_PROC(SDL_ThreadPool*,SDL_CreateThreadPool,(int a, SDL_ThreadPriority b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitJob,(SDL_ThreadPool *a, SDL_JobFunction b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Job*,SDL_CreateJob,(SDL_ThreadPool *a, SDL_JobFunction b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AddJobDependency,(SDL_Job *a, SDL_Job *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RunJob,(SDL_Job *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJob,(SDL_Job *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_WaitThreadPool,(SDL_ThreadPool *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyThreadPool,(SDL_ThreadPool *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_WaitAtomicInt,(SDL_AtomicInt *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WaitAtomicIntTimeout,(SDL_AtomicInt *a, int b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_SignalAtomicInt,(SDL_AtomicInt *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_BroadcastAtomicInt,(SDL_AtomicInt *a),(a),)
+SDL_DYNAPI_PROC(SDL_bool,SDL_TryLockTicketLock,(SDL_TicketLock *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_LockTicketLock,(SDL_TicketLock *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_UnlockTicketLock,(SDL_TicketLock *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_SetLogAsync,(SDL_bool a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_FlushLog,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_GetLogDroppedCount,(void),(),return)
+SDL_DYNAPI_PROC(SDL_MemoryArena*,SDL_CreateMemoryArena,(size_t a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_AllocateArenaMemory,(SDL_MemoryArena *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetMemoryArena,(SDL_MemoryArena *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyMemoryArena,(SDL_MemoryArena *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RadixSort32,(void *a, size_t b, size_t c, size_t d, SDL_RadixKeyType e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RadixSort64,(void *a, size_t b, size_t c, size_t d, SDL_RadixKeyType e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_IOFromMappedFile,(const char *a, SDL_IOAccessPattern b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncIO*,SDL_AsyncIOFromFile,(const char *a, const char *b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetAsyncIOSize,(SDL_AsyncIO *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReadAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_WriteAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_CloseAsyncIO,(SDL_AsyncIO *a, SDL_bool b, SDL_AsyncIOQueue *c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOQueue*,SDL_CreateAsyncIOQueue,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_WaitAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_SignalAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_LoadFileAsync,(const char *a, SDL_AsyncIOQueue *b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_IOFromBuffered,(SDL_IOStream *a, size_t b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(size_t,SDL_ReadIOV,(SDL_IOStream *a, const SDL_IOVec *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(size_t,SDL_WriteIOV,(SDL_IOStream *a, const SDL_IOVec *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Storage*,SDL_OpenArchiveStorage,(const char *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_WriteStorageFileRange,(SDL_Storage *a, const char *b, Uint64 c, const void *d, Uint64 e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_BeginStorageTransaction,(SDL_Storage *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_CommitStorageTransaction,(SDL_Storage *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RollbackStorageTransaction,(SDL_Storage *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_LoadBMPTexture_IO,(SDL_Renderer *a, SDL_IOStream *b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_LoadBMPTexture,(SDL_Renderer *a, const char *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b, SDL_PixelFormat c, SDL_RenderReadPixelsCallback d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_SetKMSDRMWindowOverlay,(SDL_Window *a, SDL_PropertiesID b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WaitForRenderFrame,(SDL_Renderer *a, Sint32 b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_WindowSupportsPresentMode,(SDL_Window *a, SDL_PresentMode b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetWindowPresentMode,(SDL_Window *a, SDL_PresentMode b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetWindowPresentMode,(SDL_Window *a, SDL_PresentMode *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_RenderSupportsPresentMode,(SDL_Renderer *a, SDL_PresentMode b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetRenderPresentMode,(SDL_Renderer *a, SDL_PresentMode b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderPresentMode,(SDL_Renderer *a, SDL_PresentMode *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetJoystickSnapshot,(SDL_Joystick *a, SDL_JoystickSnapshot *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetGamepadSensorDataBatch,(SDL_Gamepad *a, SDL_SensorType b, SDL_GamepadSensorSample *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderThickLines,(SDL_Renderer *a, const SDL_FPoint *b, int c, float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderFillCircles,(SDL_Renderer *a, const SDL_FPoint *b, int c, float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_UpdateTextureLayer,(SDL_Texture *a, int b, const SDL_Rect *c, const void *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderTextureLayer,(SDL_Renderer *a, SDL_Texture *b, int c, const SDL_FRect *d, const SDL_FRect *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_RenderShader*,SDL_CreateRenderShader,(SDL_Renderer *a, SDL_PropertiesID b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetRenderShader,(SDL_Renderer *a, SDL_RenderShader *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderShader,(SDL_RenderShader *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderDebugText,(SDL_Renderer *a, float b, float c, const char *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetEventWaitProperties,(void),(),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_OpenClipboardData,(const char *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetCPUCoreCount,(SDL_CPUCoreType a),(a),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetCPUCoreMask,(SDL_CPUCoreType a),(a),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetCPUCacheSharingMask,(int a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetRectIntersections,(const SDL_Rect *a, int b, const SDL_Rect *c, SDL_Rect *d, SDL_bool *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_GetRectIntersectionsFloat,(const SDL_FRect *a, int b, const SDL_FRect *c, SDL_FRect *d, SDL_bool *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_MapRGBAArray,(const SDL_PixelFormatDetails *a, const SDL_Palette *b, const SDL_Color *c, void *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_GetRGBAArray,(const void *a, const SDL_PixelFormatDetails *b, const SDL_Palette *c, SDL_Color *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_GetMemoryStats,(SDL_MemoryCategory a, SDL_MemoryStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRendererMemoryStats,(SDL_Renderer *a, SDL_MemoryStats *b),(a,b),return)
@@ -24,6 +24,7 @@
 
 #include "SDL_events_c.h"
 #include "../SDL_hints_c.h"
+#include "../SDL_memorystats_c.h"
 #include "../audio/SDL_audio_c.h"
 #include "../camera/SDL_camera_c.h"
 #include "../timer/SDL_timer_c.h"
@@ -66,7 +67,7 @@ static int SDL_event_watchers_count = 0;
 static SDL_bool SDL_event_watchers_dispatching = SDL_FALSE;
 static SDL_bool SDL_event_watchers_removed = SDL_FALSE;
 static SDL_AtomicInt SDL_sentinel_pending;
-static Uint32 SDL_last_event_id = 0;
+static SDL_AtomicInt SDL_last_event_id;
 
 typedef struct
 {
@@ -76,11 +77,14 @@ typedef struct
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_EVENT_USER;
 
+// The entry header lives in the same allocation as the memory it tracks.
+// It's four pointers wide so the memory that follows stays suitably aligned.
 typedef struct SDL_TemporaryMemory
 {
     void *memory;
     struct SDL_TemporaryMemory *prev;
     struct SDL_TemporaryMemory *next;
+    size_t size;
 } SDL_TemporaryMemory;
 
 typedef struct SDL_TemporaryMemoryState
@@ -95,20 +99,75 @@ typedef struct SDL_EventEntry
 {
     SDL_Event event;
     SDL_TemporaryMemory *memory;
+    Uint32 serial;
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
+    struct SDL_EventEntry *bucket_prev;
+    struct SDL_EventEntry *bucket_next;
 } SDL_EventEntry;
 
+/* Queued events are also linked into one of these by type >> 8, which keeps
+   each event category (keyboard, mouse, pen, ...) together so that filtered
+   peeks and flushes don't have to walk unrelated events. */
+#define SDL_EVENT_BUCKET_COUNT 256
+
+/* Ranges spanning more buckets than this just walk the whole queue */
+#define SDL_EVENT_MAX_MERGED_BUCKETS 4
+
+typedef struct SDL_EventBucket
+{
+    SDL_EventEntry *head;
+    SDL_EventEntry *tail;
+} SDL_EventBucket;
+
+/* Events pushed while the ring is available go into a bounded lock-free
+   multi-producer ring, so producers on other threads never contend on the
+   queue lock. The reading side is serialized by SDL_EventQ.lock, and the
+   ring is only ever drained into the tail of the linked list, so everything
+   in the list is older than everything still in the ring. */
+#define SDL_EVENT_RING_SIZE 1024 /* must be a power of two */
+
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicInt sequence;
+    SDL_EventEntry entry;
+} SDL_EventRingSlot;
+
+typedef struct SDL_EventRing
+{
+    SDL_AtomicInt enqueue_pos;
+    Uint32 dequeue_pos; /* only touched with SDL_EventQ.lock held */
+    SDL_EventRingSlot slots[SDL_EVENT_RING_SIZE];
+} SDL_EventRing;
+
 static struct
 {
     SDL_Mutex *lock;
     SDL_bool active;
     SDL_AtomicInt count;
-    int max_events_seen;
+    SDL_AtomicInt max_events_seen;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
-} SDL_EventQ = { NULL, SDL_FALSE, { 0 }, 0, NULL, NULL, NULL };
+    SDL_EventRing *ring;
+    SDL_AtomicInt ring_users;
+    Uint32 next_serial;
+    SDL_EventBucket buckets[SDL_EVENT_BUCKET_COUNT];
+} SDL_EventQ;
+
+/* Motion events held back for merging, see SDL_HINT_EVENT_COALESCE_MOTION */
+#define SDL_MOTION_HISTORY_SIZE 1024
+
+static struct
+{
+    SDL_SpinLock lock;
+    SDL_bool enabled;
+    SDL_AtomicInt has_pending;
+    SDL_Event pending;
+    SDL_Event *history;
+    int history_head;
+    int history_count;
+} SDL_MotionQ;
 
 
 static void SDL_CleanupTemporaryMemory(void *data)
@@ -188,11 +247,9 @@ static void SDL_UnlinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_
     entry->next = NULL;
 }
 
-static void SDL_FreeTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry, SDL_bool free_data)
+static void SDL_FreeTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
 {
-    if (free_data) {
-        SDL_free(entry->memory);
-    }
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, -(Sint64)(sizeof(*entry) + entry->size), 0, 0);
     SDL_free(entry);
 }
 
@@ -262,43 +319,49 @@ static void SDL_TransferTemporaryMemoryFromEvent(SDL_EventEntry *event)
     event->memory = NULL;
 }
 
-static void *SDL_FreeLater(void *memory)
+static void *SDL_AllocateTemporaryMemoryEntry(size_t size)
 {
     SDL_TemporaryMemoryState *state;
+    SDL_TemporaryMemory *entry;
+    size_t total;
 
-    if (memory == NULL) {
+    if (SDL_size_add_overflow(size, sizeof(*entry), &total) != 0) {
+        SDL_OutOfMemory();
         return NULL;
     }
 
-    // Make sure we're not adding this to the list twice
-    //SDL_assert(!SDL_ClaimTemporaryMemory(memory));
-
     state = SDL_GetTemporaryMemoryState(SDL_TRUE);
     if (!state) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed.
+        return NULL;
     }
 
-    SDL_TemporaryMemory *entry = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*entry));
+    entry = (SDL_TemporaryMemory *)SDL_malloc(total);
     if (!entry) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed. We could probably pool up and reuse entries, though.
+        return NULL;
     }
-
-    entry->memory = memory;
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, (Sint64)total, 0, 0);
+    entry->memory = entry + 1;
+    entry->size = size;
 
     SDL_LinkTemporaryMemoryEntry(state, entry);
 
-    return memory;
+    return entry->memory;
 }
 
 void *SDL_AllocateTemporaryMemory(size_t size)
 {
-    return SDL_FreeLater(SDL_malloc(size));
+    return SDL_AllocateTemporaryMemoryEntry(size);
 }
 
 const char *SDL_CreateTemporaryString(const char *string)
 {
     if (string) {
-        return SDL_FreeLater(SDL_strdup(string));
+        size_t len = SDL_strlen(string) + 1;
+        char *copy = (char *)SDL_AllocateTemporaryMemoryEntry(len);
+        if (copy) {
+            SDL_memcpy(copy, string, len);
+        }
+        return copy;
     }
     return NULL;
 }
@@ -311,9 +374,14 @@ void *SDL_ClaimTemporaryMemory(const void *mem)
     if (state && mem) {
         SDL_TemporaryMemory *entry = SDL_GetTemporaryMemoryEntry(state, mem);
         if (entry) {
-            SDL_UnlinkTemporaryMemoryEntry(state, entry);
-            SDL_FreeTemporaryMemoryEntry(state, entry, SDL_FALSE);
-            return (void *)mem;
+            // The memory shares an allocation with its entry, so hand back a copy
+            void *claimed = SDL_malloc(entry->size ? entry->size : 1);
+            if (claimed) {
+                SDL_memcpy(claimed, entry->memory, entry->size);
+                SDL_UnlinkTemporaryMemoryEntry(state, entry);
+                SDL_FreeTemporaryMemoryEntry(state, entry);
+            }
+            return claimed;
         }
     }
     return NULL;
@@ -332,7 +400,7 @@ void SDL_FreeTemporaryMemory(void)
         SDL_TemporaryMemory *entry = state->head;
 
         SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        SDL_FreeTemporaryMemoryEntry(state, entry, SDL_TRUE);
+        SDL_FreeTemporaryMemoryEntry(state, entry);
     }
 }
 
@@ -358,6 +426,27 @@ static void SDLCALL SDL_AutoUpdateSensorsChanged(void *userdata, const char *nam
 
 #endif /* !SDL_SENSOR_DISABLED */
 
+static void SDL_FlushCoalescedMotion(void);
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    const SDL_bool enabled = SDL_GetStringBoolean(hint, SDL_FALSE);
+
+    if (enabled && !SDL_MotionQ.history) {
+        SDL_Event *history = (SDL_Event *)SDL_malloc(SDL_MOTION_HISTORY_SIZE * sizeof(*history));
+
+        SDL_LockSpinlock(&SDL_MotionQ.lock);
+        SDL_MotionQ.history = history;
+        SDL_MotionQ.history_head = 0;
+        SDL_MotionQ.history_count = 0;
+        SDL_UnlockSpinlock(&SDL_MotionQ.lock);
+    }
+    SDL_MotionQ.enabled = enabled;
+    if (!enabled) {
+        SDL_FlushCoalescedMotion();
+    }
+}
+
 static void SDLCALL SDL_PollSentinelChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
     SDL_SetEventEnabled(SDL_EVENT_POLL_SENTINEL, SDL_GetStringBoolean(hint, SDL_TRUE));
@@ -823,11 +912,34 @@ static void SDL_LogEvent(const SDL_Event *event)
 #undef uint
 }
 
+/* Return the oldest published slot in the ring, or NULL if there isn't one -- called with the queue locked */
+static SDL_EventRingSlot *SDL_GetEventRingSlot(SDL_EventRing *ring)
+{
+    const Uint32 pos = ring->dequeue_pos;
+    SDL_EventRingSlot *slot = &ring->slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+    const int delta = (int)((Uint32)SDL_AtomicGet(&slot->sequence) - (pos + 1));
+
+    if (delta < 0) {
+        /* Empty, or the producer that claimed this slot hasn't finished filling it */
+        return NULL;
+    }
+    SDL_assert(delta == 0);
+    return slot;
+}
+
+/* Hand a slot returned by SDL_GetEventRingSlot() back to the producers -- called with the queue locked */
+static void SDL_ReleaseEventRingSlot(SDL_EventRing *ring, SDL_EventRingSlot *slot)
+{
+    SDL_AtomicSet(&slot->sequence, (int)(ring->dequeue_pos + SDL_EVENT_RING_SIZE));
+    ++ring->dequeue_pos;
+}
+
 void SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
     int i;
     SDL_EventEntry *entry;
+    SDL_EventRing *ring;
 
     SDL_LockMutex(SDL_EventQ.lock);
 
@@ -835,27 +947,54 @@ void SDL_StopEventLoop(void)
 
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
-                SDL_EventQ.max_events_seen);
+                SDL_AtomicGet(&SDL_EventQ.max_events_seen));
+    }
+
+    /* Drop any motion that was being merged */
+    SDL_LockSpinlock(&SDL_MotionQ.lock);
+    SDL_MotionQ.enabled = SDL_FALSE;
+    SDL_AtomicSet(&SDL_MotionQ.has_pending, 0);
+    SDL_free(SDL_MotionQ.history);
+    SDL_MotionQ.history = NULL;
+    SDL_MotionQ.history_count = 0;
+    SDL_UnlockSpinlock(&SDL_MotionQ.lock);
+
+    /* Detach the ring and wait for any producer that is still writing to it */
+    ring = (SDL_EventRing *)SDL_AtomicSetPtr((void **)&SDL_EventQ.ring, NULL);
+    while (SDL_AtomicGet(&SDL_EventQ.ring_users) > 0) {
+        SDL_CPUPauseInstruction();
+    }
+    if (ring) {
+        SDL_EventRingSlot *slot;
+        while ((slot = SDL_GetEventRingSlot(ring)) != NULL) {
+            SDL_TransferTemporaryMemoryFromEvent(&slot->entry);
+            SDL_ReleaseEventRingSlot(ring, slot);
+        }
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, -(Sint64)sizeof(*ring), 0, 0);
+        SDL_free(ring);
     }
 
     /* Clean out EventQ */
     for (entry = SDL_EventQ.head; entry;) {
         SDL_EventEntry *next = entry->next;
         SDL_TransferTemporaryMemoryFromEvent(entry);
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, -(Sint64)sizeof(*entry), 0, -1);
         SDL_free(entry);
         entry = next;
     }
     for (entry = SDL_EventQ.free; entry;) {
         SDL_EventEntry *next = entry->next;
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, -(Sint64)sizeof(*entry), 0, -1);
         SDL_free(entry);
         entry = next;
     }
 
     SDL_AtomicSet(&SDL_EventQ.count, 0);
-    SDL_EventQ.max_events_seen = 0;
+    SDL_AtomicSet(&SDL_EventQ.max_events_seen, 0);
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
+    SDL_zeroa(SDL_EventQ.buckets);
     SDL_AtomicSet(&SDL_sentinel_pending, 0);
 
     /* Clear disabled event state */
@@ -911,43 +1050,187 @@ int SDL_StartEventLoop(void)
     }
 #endif /* !SDL_THREADS_DISABLED */
 
+    if (!SDL_EventQ.ring) {
+        /* If this fails, events just go through the locked list */
+        SDL_EventRing *ring = (SDL_EventRing *)SDL_calloc(1, sizeof(*ring));
+        if (ring) {
+            int i;
+            SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, sizeof(*ring), 0, 0);
+            for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_AtomicSet(&ring->slots[i].sequence, i);
+            }
+            SDL_AtomicSetPtr((void **)&SDL_EventQ.ring, ring);
+        }
+    }
+
     SDL_EventQ.active = SDL_TRUE;
     SDL_UnlockMutex(SDL_EventQ.lock);
     return 0;
 }
 
-/* Add an event to the event queue -- called with the queue locked */
-static int SDL_AddEvent(SDL_Event *event)
+static int SDL_GetEventBucket(Uint32 type)
+{
+    const Uint32 bucket = (type >> 8);
+    return (bucket < SDL_EVENT_BUCKET_COUNT) ? (int)bucket : (SDL_EVENT_BUCKET_COUNT - 1);
+}
+
+/* Walks the queued events in a type range in the order they were added */
+typedef struct SDL_EventCursor
+{
+    Uint32 minType;
+    Uint32 maxType;
+    int num_buckets; /* 0 if we're walking the whole list */
+    SDL_EventEntry *list;
+    SDL_EventEntry *buckets[SDL_EVENT_MAX_MERGED_BUCKETS];
+} SDL_EventCursor;
+
+/* Called with the queue locked */
+static void SDL_InitEventCursor(SDL_EventCursor *cursor, Uint32 minType, Uint32 maxType)
+{
+    const int first = SDL_GetEventBucket(minType);
+    const int last = SDL_GetEventBucket(maxType);
+    int i;
+
+    cursor->minType = minType;
+    cursor->maxType = maxType;
+    cursor->list = NULL;
+    if (minType > maxType) {
+        cursor->num_buckets = 0;
+    } else if ((last - first + 1) > SDL_EVENT_MAX_MERGED_BUCKETS) {
+        cursor->num_buckets = 0;
+        cursor->list = SDL_EventQ.head;
+    } else {
+        cursor->num_buckets = (last - first + 1);
+        for (i = 0; i < cursor->num_buckets; ++i) {
+            cursor->buckets[i] = SDL_EventQ.buckets[first + i].head;
+        }
+    }
+}
+
+/* Return the next event in range, which the caller may cut from the queue -- called with the queue locked */
+static SDL_EventEntry *SDL_NextEventInRange(SDL_EventCursor *cursor)
 {
     SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
+    Uint32 type;
+    int i, next = -1;
 
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
+    if (cursor->num_buckets == 0) {
+        while ((entry = cursor->list) != NULL) {
+            cursor->list = entry->next;
+            type = entry->event.type;
+            if (cursor->minType <= type && type <= cursor->maxType) {
+                return entry;
+            }
+        }
+        return NULL;
+    }
+
+    /* Merge the buckets in arrival order, only the first and last can hold types out of range */
+    for (i = 0; i < cursor->num_buckets; ++i) {
+        while ((entry = cursor->buckets[i]) != NULL) {
+            type = entry->event.type;
+            if (cursor->minType <= type && type <= cursor->maxType) {
+                break;
+            }
+            cursor->buckets[i] = entry->bucket_next;
+        }
+        if (entry && (next < 0 || (Sint32)(entry->serial - cursor->buckets[next]->serial) < 0)) {
+            next = i;
+        }
+    }
+    if (next < 0) {
+        return NULL;
+    }
+    entry = cursor->buckets[next];
+    cursor->buckets[next] = entry->bucket_next;
+    return entry;
+}
+
+static void SDL_UpdateMaxEventsSeen(int count)
+{
+    int max_events_seen = SDL_AtomicGet(&SDL_EventQ.max_events_seen);
+    while (count > max_events_seen) {
+        if (SDL_AtomicCompareAndSwap(&SDL_EventQ.max_events_seen, max_events_seen, count)) {
+            break;
+        }
+        max_events_seen = SDL_AtomicGet(&SDL_EventQ.max_events_seen);
+    }
+}
+
+/* Try to publish an event in the ring without taking the queue lock, returns 0 if it's full or gone */
+static int SDL_AddEventToRing(SDL_Event *event)
+{
+    SDL_EventRing *ring;
+    int status = 0;
+
+    SDL_AtomicIncRef(&SDL_EventQ.ring_users);
+    ring = (SDL_EventRing *)SDL_AtomicGetPtr((void **)&SDL_EventQ.ring);
+    if (ring) {
+        Uint32 pos = (Uint32)SDL_AtomicGet(&ring->enqueue_pos);
+        for (;;) {
+            SDL_EventRingSlot *slot = &ring->slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+            const int delta = (int)((Uint32)SDL_AtomicGet(&slot->sequence) - pos);
+
+            if (delta == 0) {
+                if (SDL_AtomicCompareAndSwap(&ring->enqueue_pos, (int)pos, (int)(pos + 1))) {
+                    /* We own the slot, fill it and publish it to the reader */
+                    SDL_copyp(&slot->entry.event, event);
+                    slot->entry.memory = NULL;
+                    slot->entry.prev = NULL;
+                    slot->entry.next = NULL;
+                    slot->entry.bucket_prev = NULL;
+                    slot->entry.bucket_next = NULL;
+                    SDL_TransferTemporaryMemoryToEvent(&slot->entry);
+                    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+                        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+                    }
+                    SDL_UpdateMaxEventsSeen(SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1);
+                    SDL_AtomicSet(&slot->sequence, (int)(pos + 1));
+                    status = 1;
+                    break;
+                }
+            } else if (delta < 0) {
+                /* The ring is full, the reader hasn't caught up with this slot yet */
+                break;
+            }
+            pos = (Uint32)SDL_AtomicGet(&ring->enqueue_pos);
+        }
     }
+    SDL_AtomicDecRef(&SDL_EventQ.ring_users);
+
+    return status;
+}
+
+/* Add an event to the tail of the list -- called with the queue locked */
+static int SDL_AddEventToList(SDL_Event *event, SDL_TemporaryMemory *memory)
+{
+    SDL_EventEntry *entry;
+    SDL_EventBucket *bucket;
 
     if (SDL_EventQ.free == NULL) {
         entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
         if (entry == NULL) {
             return 0;
         }
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_EVENTS, sizeof(*entry), 0, 1);
     } else {
         entry = SDL_EventQ.free;
         SDL_EventQ.free = entry->next;
     }
 
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
-    }
-
     SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+    entry->memory = memory;
+    entry->serial = SDL_EventQ.next_serial++;
+
+    bucket = &SDL_EventQ.buckets[SDL_GetEventBucket(event->type)];
+    entry->bucket_prev = bucket->tail;
+    entry->bucket_next = NULL;
+    if (bucket->tail) {
+        bucket->tail->bucket_next = entry;
+    } else {
+        bucket->head = entry;
     }
-    entry->memory = NULL;
-    SDL_TransferTemporaryMemoryToEvent(entry);
+    bucket->tail = entry;
 
     if (SDL_EventQ.tail) {
         SDL_EventQ.tail->next = entry;
@@ -961,22 +1244,123 @@ static int SDL_AddEvent(SDL_Event *event)
         entry->prev = NULL;
         entry->next = NULL;
     }
+    return 1;
+}
 
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+/* Move everything published in the ring to the tail of the list -- called with the queue locked
+   Returns the number of events moved, or -1 if the list is out of memory. */
+static int SDL_DrainEventRing(void)
+{
+    SDL_EventRing *ring = SDL_EventQ.ring;
+    SDL_EventRingSlot *slot;
+    int moved = 0;
+
+    if (!ring) {
+        return 0;
     }
+    while ((slot = SDL_GetEventRingSlot(ring)) != NULL) {
+        /* The event was already counted when it was published */
+        if (!SDL_AddEventToList(&slot->entry.event, slot->entry.memory)) {
+            return -1;
+        }
+        SDL_ReleaseEventRingSlot(ring, slot);
+        ++moved;
+    }
+    return moved;
+}
 
-    ++SDL_last_event_id;
+/* Add an event to the event queue, returns -1 if the event system has been shut down */
+static int SDL_AddEvent(SDL_Event *event)
+{
+    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
+    int status;
 
-    return 1;
+    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_SetError("Event queue is full (%d events)", initial_count);
+        return 0;
+    }
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    for (;;) {
+        if (SDL_AddEventToRing(event)) {
+            SDL_AtomicIncRef(&SDL_last_event_id);
+            return 1;
+        }
+
+        SDL_LockMutex(SDL_EventQ.lock);
+        {
+            if (!SDL_EventQ.active) {
+                SDL_UnlockMutex(SDL_EventQ.lock);
+                return -1;
+            }
+
+            if (SDL_EventQ.ring) {
+                /* The ring is full, make room by moving the oldest events to the list.
+                   New events always go through the ring, otherwise they could pass an
+                   older event that's stuck behind a slot another thread is still filling. */
+                status = SDL_DrainEventRing();
+                SDL_UnlockMutex(SDL_EventQ.lock);
+                if (status < 0) {
+                    return 0;
+                }
+                if (status == 0) {
+                    SDL_CPUPauseInstruction();
+                }
+                continue;
+            }
+
+            /* We couldn't allocate the ring, everything goes through the list */
+            status = SDL_AddEventToList(event, NULL);
+            if (status) {
+                SDL_TransferTemporaryMemoryToEvent(SDL_EventQ.tail);
+                if (event->type == SDL_EVENT_POLL_SENTINEL) {
+                    SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+                }
+                SDL_UpdateMaxEventsSeen(SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1);
+                SDL_AtomicIncRef(&SDL_last_event_id);
+            }
+        }
+        SDL_UnlockMutex(SDL_EventQ.lock);
+
+        return status;
+    }
+}
+
+/* Remove the oldest event from the ring -- called with the queue locked */
+static void SDL_CutEventRingSlot(SDL_EventRing *ring, SDL_EventRingSlot *slot)
+{
+    SDL_TransferTemporaryMemoryFromEvent(&slot->entry);
+
+    if (slot->entry.event.type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AtomicAdd(&SDL_sentinel_pending, -1);
+    }
+
+    SDL_ReleaseEventRingSlot(ring, slot);
+    SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
+    SDL_AtomicAdd(&SDL_EventQ.count, -1);
 }
 
 /* Remove an event from the queue -- called with the queue locked */
 static void SDL_CutEvent(SDL_EventEntry *entry)
 {
+    SDL_EventBucket *bucket = &SDL_EventQ.buckets[SDL_GetEventBucket(entry->event.type)];
+
     SDL_TransferTemporaryMemoryFromEvent(entry);
 
+    if (entry->bucket_prev) {
+        entry->bucket_prev->bucket_next = entry->bucket_next;
+    } else {
+        bucket->head = entry->bucket_next;
+    }
+    if (entry->bucket_next) {
+        entry->bucket_next->bucket_prev = entry->bucket_prev;
+    } else {
+        bucket->tail = entry->bucket_prev;
+    }
+
     if (entry->prev) {
         entry->prev->next = entry->next;
     }
@@ -1028,15 +1412,177 @@ static int SDL_SendWakeupEvent(void)
     return 0;
 }
 
+/* Queue the motion event being merged, if any, ahead of whatever comes next */
+static void SDL_FlushCoalescedMotion(void)
+{
+    if (!SDL_AtomicGet(&SDL_MotionQ.has_pending)) {
+        return;
+    }
+
+    /* Keep the lock while adding it, so nothing else can jump ahead of it */
+    SDL_LockSpinlock(&SDL_MotionQ.lock);
+    if (SDL_AtomicGet(&SDL_MotionQ.has_pending)) {
+        SDL_AddEvent(&SDL_MotionQ.pending);
+        SDL_AtomicSet(&SDL_MotionQ.has_pending, 0);
+    }
+    SDL_UnlockSpinlock(&SDL_MotionQ.lock);
+}
+
+static SDL_bool SDL_CanCoalesceMotion(const SDL_Event *pending, const SDL_Event *event)
+{
+    if (pending->type != event->type) {
+        return SDL_FALSE;
+    }
+    if (event->type == SDL_EVENT_MOUSE_MOTION) {
+        return (pending->motion.which == event->motion.which &&
+                pending->motion.windowID == event->motion.windowID &&
+                pending->motion.state == event->motion.state);
+    } else if (event->type == SDL_EVENT_FINGER_MOTION) {
+        return (pending->tfinger.touchID == event->tfinger.touchID &&
+                pending->tfinger.fingerID == event->tfinger.fingerID &&
+                pending->tfinger.windowID == event->tfinger.windowID);
+    } else {
+        return (pending->pmotion.which == event->pmotion.which &&
+                pending->pmotion.windowID == event->pmotion.windowID &&
+                pending->pmotion.pen_state == event->pmotion.pen_state);
+    }
+}
+
+/* Merge a mouse, finger or pen motion event into the one being held back, or start holding it back */
+static int SDL_CoalesceMotionEvent(const SDL_Event *event)
+{
+    SDL_LockSpinlock(&SDL_MotionQ.lock);
+    {
+        if (SDL_MotionQ.history) {
+            int slot = (SDL_MotionQ.history_head + SDL_MotionQ.history_count) % SDL_MOTION_HISTORY_SIZE;
+            if (SDL_MotionQ.history_count == SDL_MOTION_HISTORY_SIZE) {
+                /* Drop the oldest sample */
+                SDL_MotionQ.history_head = (SDL_MotionQ.history_head + 1) % SDL_MOTION_HISTORY_SIZE;
+            } else {
+                ++SDL_MotionQ.history_count;
+            }
+            SDL_copyp(&SDL_MotionQ.history[slot], event);
+        }
+
+        if (SDL_AtomicGet(&SDL_MotionQ.has_pending) && SDL_CanCoalesceMotion(&SDL_MotionQ.pending, event)) {
+            SDL_Event *pending = &SDL_MotionQ.pending;
+
+            if (event->type == SDL_EVENT_MOUSE_MOTION) {
+                const float xrel = pending->motion.xrel + event->motion.xrel;
+                const float yrel = pending->motion.yrel + event->motion.yrel;
+                SDL_copyp(&pending->motion, &event->motion);
+                pending->motion.xrel = xrel;
+                pending->motion.yrel = yrel;
+            } else if (event->type == SDL_EVENT_FINGER_MOTION) {
+                const float dx = pending->tfinger.dx + event->tfinger.dx;
+                const float dy = pending->tfinger.dy + event->tfinger.dy;
+                SDL_copyp(&pending->tfinger, &event->tfinger);
+                pending->tfinger.dx = dx;
+                pending->tfinger.dy = dy;
+            } else {
+                SDL_copyp(&pending->pmotion, &event->pmotion);
+            }
+        } else {
+            if (SDL_AtomicGet(&SDL_MotionQ.has_pending)) {
+                SDL_AddEvent(&SDL_MotionQ.pending);
+            }
+            SDL_copyp(&SDL_MotionQ.pending, event);
+            SDL_AtomicSet(&SDL_MotionQ.has_pending, 1);
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_MotionQ.lock);
+
+    return 1;
+}
+
+int SDL_GetMotionHistory(SDL_Event *events, int numevents)
+{
+    int used = 0;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+
+    SDL_LockSpinlock(&SDL_MotionQ.lock);
+    while (used < numevents && SDL_MotionQ.history_count > 0) {
+        SDL_copyp(&events[used], &SDL_MotionQ.history[SDL_MotionQ.history_head]);
+        SDL_MotionQ.history_head = (SDL_MotionQ.history_head + 1) % SDL_MOTION_HISTORY_SIZE;
+        --SDL_MotionQ.history_count;
+        ++used;
+    }
+    SDL_UnlockSpinlock(&SDL_MotionQ.lock);
+
+    return used;
+}
+
+/* Take events in arrival order straight off the list and the ring -- called with the queue locked */
+static int SDL_GetEventsInOrder(SDL_Event *events, int numevents, SDL_bool include_sentinel)
+{
+    SDL_EventRing *ring = SDL_EventQ.ring;
+    SDL_EventRingSlot *slot;
+    int used = 0;
+
+    while (used < numevents) {
+        if (SDL_EventQ.head) {
+            SDL_copyp(&events[used], &SDL_EventQ.head->event);
+            SDL_CutEvent(SDL_EventQ.head);
+        } else if (ring && (slot = SDL_GetEventRingSlot(ring)) != NULL) {
+            SDL_copyp(&events[used], &slot->entry.event);
+            SDL_CutEventRingSlot(ring, slot);
+        } else {
+            break;
+        }
+
+        if (events[used].type == SDL_EVENT_POLL_SENTINEL) {
+            /* Special handling for the sentinel event, see SDL_PeepEventsInternal() */
+            if (!include_sentinel || SDL_AtomicGet(&SDL_sentinel_pending) > 0) {
+                continue;
+            }
+
+            /* That's the end of this poll cycle */
+            ++used;
+            break;
+        }
+        ++used;
+    }
+    return used;
+}
+
 /* Lock the event queue, take a peep at it, and unlock it */
 static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAction action,
                                   Uint32 minType, Uint32 maxType, SDL_bool include_sentinel)
 {
     int i, used, sentinels_expected = 0;
 
-    /* Lock the event queue */
     used = 0;
 
+    if (action == SDL_ADDEVENT) {
+        /* Producers only take the queue lock if the ring is full */
+        if (!events) {
+            return SDL_InvalidParamError("events");
+        }
+        SDL_FlushCoalescedMotion();
+        for (i = 0; i < numevents; ++i) {
+            const int added = SDL_AddEvent(&events[i]);
+            if (added < 0) {
+                if (used == 0) {
+                    return -1;
+                }
+                break;
+            }
+            used += added;
+        }
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+            SDL_SignalEventWait();
+        }
+        return used;
+    }
+
+    /* Any motion being merged is older than whatever we'll find */
+    SDL_FlushCoalescedMotion();
+
+    /* Lock the event queue */
     SDL_LockMutex(SDL_EventQ.lock);
     {
         /* Don't look after we've quit */
@@ -1048,54 +1594,46 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
-        if (action == SDL_ADDEVENT) {
-            if (!events) {
-                SDL_UnlockMutex(SDL_EventQ.lock);
-                return SDL_InvalidParamError("events");
-            }
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
-            }
+        if (action == SDL_GETEVENT && events && minType == SDL_EVENT_FIRST && maxType == SDL_EVENT_LAST) {
+            /* Nothing to filter, no need to move events out of the ring */
+            used = SDL_GetEventsInOrder(events, numevents, include_sentinel);
         } else {
-            SDL_EventEntry *entry, *next;
+            SDL_EventCursor cursor;
+            SDL_EventEntry *entry;
             Uint32 type;
 
-            for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
-                next = entry->next;
+            SDL_DrainEventRing();
+
+            SDL_InitEventCursor(&cursor, minType, maxType);
+            while ((events == NULL || used < numevents) && (entry = SDL_NextEventInRange(&cursor)) != NULL) {
                 type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        SDL_copyp(&events[used], &entry->event);
+                if (events) {
+                    SDL_copyp(&events[used], &entry->event);
 
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
-                        }
+                    if (action == SDL_GETEVENT) {
+                        SDL_CutEvent(entry);
                     }
-                    if (type == SDL_EVENT_POLL_SENTINEL) {
-                        /* Special handling for the sentinel event */
-                        if (!include_sentinel) {
-                            /* Skip it, we don't want to include it */
-                            continue;
-                        }
-                        if (events == NULL || action != SDL_GETEVENT) {
-                            ++sentinels_expected;
-                        }
-                        if (SDL_AtomicGet(&SDL_sentinel_pending) > sentinels_expected) {
-                            /* Skip it, there's another one pending */
-                            continue;
-                        }
+                }
+                if (type == SDL_EVENT_POLL_SENTINEL) {
+                    /* Special handling for the sentinel event */
+                    if (!include_sentinel) {
+                        /* Skip it, we don't want to include it */
+                        continue;
+                    }
+                    if (events == NULL || action != SDL_GETEVENT) {
+                        ++sentinels_expected;
+                    }
+                    if (SDL_AtomicGet(&SDL_sentinel_pending) > sentinels_expected) {
+                        /* Skip it, there's another one pending */
+                        continue;
                     }
-                    ++used;
                 }
+                ++used;
             }
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
 
-    if (used > 0 && action == SDL_ADDEVENT) {
-        SDL_SendWakeupEvent();
-    }
-
     return used;
 }
 int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_EventAction action,
@@ -1121,8 +1659,8 @@ void SDL_FlushEvent(Uint32 type)
 
 void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 {
-    SDL_EventEntry *entry, *next;
-    Uint32 type;
+    SDL_EventCursor cursor;
+    SDL_EventEntry *entry;
 
     /* Make sure the events are current */
 #if 0
@@ -1132,6 +1670,8 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     SDL_PumpEvents();
 #endif
 
+    SDL_FlushCoalescedMotion();
+
     /* Lock the event queue */
     SDL_LockMutex(SDL_EventQ.lock);
     {
@@ -1140,12 +1680,11 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
-            if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
-            }
+        SDL_DrainEventRing();
+
+        SDL_InitEventCursor(&cursor, minType, maxType);
+        while ((entry = SDL_NextEventInRange(&cursor)) != NULL) {
+            SDL_CutEvent(entry);
         }
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1154,6 +1693,8 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 /* Run the system dependent event loops */
 static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
 {
+    SDL_TRACE_BEGIN("SDL_PumpEvents");
+
     /* Free any temporary memory from old events */
     SDL_FreeTemporaryMemory();
 
@@ -1207,6 +1748,12 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
         sentinel.common.timestamp = 0;
         SDL_PushEvent(&sentinel);
     }
+
+    /* Everything queued so far is read by the caller, including the sentinel */
+    SDL_ResetEventWait();
+
+    SDL_TRACE_COUNTER("SDL_EventQueueCount", SDL_AtomicGet(&SDL_EventQ.count));
+    SDL_TRACE_END();
 }
 
 void SDL_PumpEvents(void)
@@ -1221,6 +1768,33 @@ SDL_bool SDL_PollEvent(SDL_Event *event)
     return SDL_WaitEventTimeoutNS(event, 0);
 }
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    int result;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents < 0) {
+        return SDL_InvalidParamError("numevents");
+    }
+    if (numevents == 0) {
+        return 0;
+    }
+
+    /* If there isn't a poll sentinel event pending, pump events and add one */
+    if (SDL_AtomicGet(&SDL_sentinel_pending) == 0) {
+        SDL_PumpEventsInternal(SDL_TRUE);
+    }
+
+    result = SDL_PeepEventsInternal(events, numevents, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST, SDL_TRUE);
+    if (result > 0 && events[result - 1].type == SDL_EVENT_POLL_SENTINEL) {
+        /* Reached the end of a poll cycle */
+        --result;
+    }
+    return result;
+}
+
 #ifndef SDL_PLATFORM_ANDROID
 
 static Sint64 SDL_events_get_polling_interval(void)
@@ -1511,6 +2085,14 @@ int SDL_PushEvent(SDL_Event *event)
         return 0;
     }
 
+    if (SDL_MotionQ.enabled &&
+        (event->type == SDL_EVENT_MOUSE_MOTION || event->type == SDL_EVENT_FINGER_MOTION ||
+         event->type == SDL_EVENT_PEN_MOTION)) {
+        SDL_CoalesceMotionEvent(event);
+        SDL_SignalEventWait();
+        return 1;
+    }
+
     if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
         return -1;
     }
@@ -1528,8 +2110,10 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
         SDL_EventOK.userdata = userdata;
         if (filter) {
             /* Cut all events not accepted by the filter */
+            SDL_FlushCoalescedMotion();
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_DrainEventRing();
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1615,9 +2199,13 @@ void SDL_DelEventWatch(SDL_EventFilter filter, void *userdata)
 
 void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
+    SDL_FlushCoalescedMotion();
+
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1773,6 +2361,7 @@ int SDL_InitEvents(void)
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     if (SDL_StartEventLoop() < 0) {
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return -1;
@@ -1786,7 +2375,9 @@ int SDL_InitEvents(void)
 void SDL_QuitEvents(void)
 {
     SDL_QuitQuit();
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_StopEventLoop();
+    SDL_QuitEventWait();
     SDL_DelHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
@@ -57,6 +57,13 @@ extern void SDL_QuitEvents(void);
 
 extern void SDL_SendPendingSignalEvents(void);
 
+/* The handle returned by SDL_GetEventWaitProperties(), in SDL_eventwait.c */
+extern void SDL_SignalEventWait(void);
+extern void SDL_ResetEventWait(void);
+extern void SDL_AddEventWaitSource(int fd);
+extern void SDL_RemoveEventWaitSource(int fd);
+extern void SDL_QuitEventWait(void);
+
 extern int SDL_InitQuit(void);
 extern void SDL_QuitQuit(void);
 
@@ -0,0 +1,279 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* An OS handle that applications can wait on together with their own ones */
+
+#include "SDL_events_c.h"
+
+#if defined(SDL_PLATFORM_LINUX)
+#define SDL_EVENT_WAIT_EPOLL
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(SDL_PLATFORM_WINDOWS)
+#define SDL_EVENT_WAIT_WIN32
+#include "../core/windows/SDL_windows.h"
+#elif defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)
+#define SDL_EVENT_WAIT_PIPE
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+/* The most backend fds that can be added to the wait set */
+#define SDL_MAX_EVENT_WAIT_SOURCES 8
+
+static SDL_SpinLock SDL_event_wait_lock;
+static SDL_PropertiesID SDL_event_wait_props;
+static SDL_AtomicInt SDL_event_wait_active;   /* the handle exists */
+static SDL_AtomicInt SDL_event_wait_signaled; /* the handle was signaled and not reset yet */
+
+#ifdef SDL_EVENT_WAIT_EPOLL
+static int SDL_event_wait_epoll = -1;
+static int SDL_event_wait_eventfd = -1;
+#elif defined(SDL_EVENT_WAIT_WIN32)
+static HANDLE SDL_event_wait_handle;
+#elif defined(SDL_EVENT_WAIT_PIPE)
+static int SDL_event_wait_pipe[2] = { -1, -1 };
+#endif
+
+/* Backend fds that make the handle readable, kept while the handle doesn't exist too */
+static int SDL_event_wait_sources[SDL_MAX_EVENT_WAIT_SOURCES];
+static int SDL_num_event_wait_sources;
+
+#ifdef SDL_EVENT_WAIT_EPOLL
+static void SDL_WatchEventWaitSource(int fd)
+{
+    struct epoll_event event;
+
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(SDL_event_wait_epoll, EPOLL_CTL_ADD, fd, &event);
+}
+#endif
+
+/* Create the OS handle, called with SDL_event_wait_lock held */
+static int SDL_CreateEventWaitHandle(SDL_PropertiesID props)
+{
+#ifdef SDL_EVENT_WAIT_EPOLL
+    int i;
+
+    SDL_event_wait_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (SDL_event_wait_epoll < 0) {
+        return SDL_SetError("Couldn't create epoll set: %s", strerror(errno));
+    }
+    SDL_event_wait_eventfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (SDL_event_wait_eventfd < 0) {
+        close(SDL_event_wait_epoll);
+        SDL_event_wait_epoll = -1;
+        return SDL_SetError("Couldn't create eventfd: %s", strerror(errno));
+    }
+    SDL_WatchEventWaitSource(SDL_event_wait_eventfd);
+    for (i = 0; i < SDL_num_event_wait_sources; ++i) {
+        SDL_WatchEventWaitSource(SDL_event_wait_sources[i]);
+    }
+    return SDL_SetNumberProperty(props, SDL_PROP_EVENT_WAIT_FD_NUMBER, SDL_event_wait_epoll);
+#elif defined(SDL_EVENT_WAIT_WIN32)
+    SDL_event_wait_handle = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (!SDL_event_wait_handle) {
+        return WIN_SetError("CreateEvent()");
+    }
+    return SDL_SetPointerProperty(props, SDL_PROP_EVENT_WAIT_HANDLE_POINTER, SDL_event_wait_handle);
+#elif defined(SDL_EVENT_WAIT_PIPE)
+    int i;
+
+    if (pipe(SDL_event_wait_pipe) < 0) {
+        return SDL_SetError("Couldn't create pipe: %s", strerror(errno));
+    }
+    for (i = 0; i < 2; ++i) {
+        fcntl(SDL_event_wait_pipe[i], F_SETFL, fcntl(SDL_event_wait_pipe[i], F_GETFL) | O_NONBLOCK);
+        fcntl(SDL_event_wait_pipe[i], F_SETFD, FD_CLOEXEC);
+    }
+    return SDL_SetNumberProperty(props, SDL_PROP_EVENT_WAIT_FD_NUMBER, SDL_event_wait_pipe[0]);
+#else
+    return SDL_Unsupported();
+#endif
+}
+
+static void SDL_DestroyEventWaitHandle(void)
+{
+#ifdef SDL_EVENT_WAIT_EPOLL
+    if (SDL_event_wait_eventfd >= 0) {
+        close(SDL_event_wait_eventfd);
+        SDL_event_wait_eventfd = -1;
+    }
+    if (SDL_event_wait_epoll >= 0) {
+        close(SDL_event_wait_epoll);
+        SDL_event_wait_epoll = -1;
+    }
+#elif defined(SDL_EVENT_WAIT_WIN32)
+    if (SDL_event_wait_handle) {
+        CloseHandle(SDL_event_wait_handle);
+        SDL_event_wait_handle = NULL;
+    }
+#elif defined(SDL_EVENT_WAIT_PIPE)
+    if (SDL_event_wait_pipe[0] >= 0) {
+        close(SDL_event_wait_pipe[0]);
+        close(SDL_event_wait_pipe[1]);
+        SDL_event_wait_pipe[0] = SDL_event_wait_pipe[1] = -1;
+    }
+#endif
+}
+
+SDL_PropertiesID SDL_GetEventWaitProperties(void)
+{
+    SDL_PropertiesID props;
+
+    SDL_LockSpinlock(&SDL_event_wait_lock);
+    props = SDL_event_wait_props;
+    if (!props) {
+        props = SDL_CreateProperties();
+        if (props) {
+            if (SDL_CreateEventWaitHandle(props) < 0) {
+                SDL_DestroyEventWaitHandle();
+                SDL_DestroyProperties(props);
+                props = 0;
+            } else {
+                SDL_event_wait_props = props;
+                SDL_AtomicSet(&SDL_event_wait_active, 1);
+            }
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_event_wait_lock);
+
+    /* Events queued before anyone asked for the handle still need to be delivered */
+    if (props && SDL_HasEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST)) {
+        SDL_SignalEventWait();
+    }
+    return props;
+}
+
+void SDL_SignalEventWait(void)
+{
+    if (!SDL_AtomicGet(&SDL_event_wait_active)) {
+        return;
+    }
+
+    /* Only the first event after a reset needs a system call */
+    if (!SDL_AtomicCompareAndSwap(&SDL_event_wait_signaled, 0, 1)) {
+        return;
+    }
+
+#ifdef SDL_EVENT_WAIT_EPOLL
+    {
+        const Uint64 value = 1;
+        if (write(SDL_event_wait_eventfd, &value, sizeof(value)) < 0) {
+            /* The counter is already non-zero */
+        }
+    }
+#elif defined(SDL_EVENT_WAIT_WIN32)
+    SetEvent(SDL_event_wait_handle);
+#elif defined(SDL_EVENT_WAIT_PIPE)
+    {
+        const char value = 1;
+        if (write(SDL_event_wait_pipe[1], &value, sizeof(value)) < 0) {
+            /* The pipe is already readable */
+        }
+    }
+#endif
+}
+
+void SDL_ResetEventWait(void)
+{
+    if (!SDL_AtomicGet(&SDL_event_wait_signaled)) {
+        return;
+    }
+
+    /* Drain before clearing the flag: an event queued in between goes unsignaled,
+       but it's already in the queue that the application is about to read. */
+#ifdef SDL_EVENT_WAIT_EPOLL
+    {
+        Uint64 value;
+        if (read(SDL_event_wait_eventfd, &value, sizeof(value)) < 0) {
+            /* Nothing was pending */
+        }
+    }
+#elif defined(SDL_EVENT_WAIT_WIN32)
+    ResetEvent(SDL_event_wait_handle);
+#elif defined(SDL_EVENT_WAIT_PIPE)
+    {
+        char buffer[64];
+        while (read(SDL_event_wait_pipe[0], buffer, sizeof(buffer)) > 0) {
+        }
+    }
+#endif
+    SDL_AtomicSet(&SDL_event_wait_signaled, 0);
+}
+
+void SDL_AddEventWaitSource(int fd)
+{
+    if (fd < 0) {
+        return;
+    }
+
+    SDL_LockSpinlock(&SDL_event_wait_lock);
+    if (SDL_num_event_wait_sources < SDL_MAX_EVENT_WAIT_SOURCES) {
+        SDL_event_wait_sources[SDL_num_event_wait_sources++] = fd;
+#ifdef SDL_EVENT_WAIT_EPOLL
+        if (SDL_event_wait_epoll >= 0) {
+            SDL_WatchEventWaitSource(fd);
+        }
+#endif
+    }
+    SDL_UnlockSpinlock(&SDL_event_wait_lock);
+}
+
+void SDL_RemoveEventWaitSource(int fd)
+{
+    int i;
+
+    SDL_LockSpinlock(&SDL_event_wait_lock);
+    for (i = 0; i < SDL_num_event_wait_sources; ++i) {
+        if (SDL_event_wait_sources[i] == fd) {
+            SDL_event_wait_sources[i] = SDL_event_wait_sources[--SDL_num_event_wait_sources];
+#ifdef SDL_EVENT_WAIT_EPOLL
+            if (SDL_event_wait_epoll >= 0) {
+                epoll_ctl(SDL_event_wait_epoll, EPOLL_CTL_DEL, fd, NULL);
+            }
+#endif
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_event_wait_lock);
+}
+
+void SDL_QuitEventWait(void)
+{
+    SDL_LockSpinlock(&SDL_event_wait_lock);
+    SDL_AtomicSet(&SDL_event_wait_active, 0);
+    SDL_AtomicSet(&SDL_event_wait_signaled, 0);
+    SDL_DestroyEventWaitHandle();
+    if (SDL_event_wait_props) {
+        SDL_DestroyProperties(SDL_event_wait_props);
+        SDL_event_wait_props = 0;
+    }
+    SDL_UnlockSpinlock(&SDL_event_wait_lock);
+}
@@ -24,9 +24,16 @@
 #include "SDL_keyboard_c.h"
 #include "../SDL_hashtable.h"
 
+/* The number of distinct modifier states that affect the keymap: SHIFT, CAPS, ALT, and MODE */
+#define SDL_KEYMAP_MODIFIER_STATES 16
+
+/* Marks a scancode without an entry in the keymap, this isn't a valid keycode */
+#define SDL_KEYMAP_UNSET_KEYCODE ((SDL_Keycode)~0u)
+
 struct SDL_Keymap
 {
-    SDL_HashTable *scancode_to_keycode;
+    /* Direct lookup by modifier state and scancode, each state is allocated when it gets its first entry */
+    SDL_Keycode *scancode_to_keycode[SDL_KEYMAP_MODIFIER_STATES];
     SDL_HashTable *keycode_to_scancode;
 };
 
@@ -35,14 +42,13 @@ static SDL_Scancode SDL_GetDefaultScancodeFromKey(SDL_Keycode key, SDL_Keymod *m
 
 SDL_Keymap *SDL_CreateKeymap(void)
 {
-    SDL_Keymap *keymap = (SDL_Keymap *)SDL_malloc(sizeof(*keymap));
+    SDL_Keymap *keymap = (SDL_Keymap *)SDL_calloc(1, sizeof(*keymap));
     if (!keymap) {
         return NULL;
     }
 
-    keymap->scancode_to_keycode = SDL_CreateHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, NULL, SDL_FALSE);
     keymap->keycode_to_scancode = SDL_CreateHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, NULL, SDL_FALSE);
-    if (!keymap->scancode_to_keycode || !keymap->keycode_to_scancode) {
+    if (!keymap->keycode_to_scancode) {
         SDL_DestroyKeymap(keymap);
         return NULL;
     }
@@ -67,9 +73,43 @@ static SDL_Keymod NormalizeModifierStateForKeymap(SDL_Keymod modstate)
     return modstate;
 }
 
+static int GetKeymapModifierIndex(SDL_Keymod modstate)
+{
+    int index = 0;
+
+    if (modstate & SDL_KMOD_SHIFT) {
+        index |= 0x1;
+    }
+    if (modstate & SDL_KMOD_CAPS) {
+        index |= 0x2;
+    }
+    if (modstate & SDL_KMOD_ALT) {
+        index |= 0x4;
+    }
+    if (modstate & SDL_KMOD_MODE) {
+        index |= 0x8;
+    }
+    return index;
+}
+
+static SDL_Keycode GetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate)
+{
+    const SDL_Keycode *keycodes;
+
+    if (!keymap || ((int)scancode) < SDL_SCANCODE_UNKNOWN || scancode >= SDL_NUM_SCANCODES) {
+        return SDL_KEYMAP_UNSET_KEYCODE;
+    }
+
+    keycodes = keymap->scancode_to_keycode[GetKeymapModifierIndex(modstate)];
+    if (!keycodes) {
+        return SDL_KEYMAP_UNSET_KEYCODE;
+    }
+    return keycodes[scancode];
+}
+
 void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate, SDL_Keycode keycode)
 {
-    if (!keymap) {
+    if (!keymap || ((int)scancode) < SDL_SCANCODE_UNKNOWN || scancode >= SDL_NUM_SCANCODES) {
         return;
     }
 
@@ -77,27 +117,32 @@ void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod mo
         return;
     }
 
-    Uint32 key = ((Uint32)NormalizeModifierStateForKeymap(modstate) << 16) | scancode;
-    const void *value;
-    if (SDL_FindInHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, &value)) {
+    modstate = NormalizeModifierStateForKeymap(modstate);
+
+    SDL_Keycode **keycodes = &keymap->scancode_to_keycode[GetKeymapModifierIndex(modstate)];
+    if (!*keycodes) {
+        *keycodes = (SDL_Keycode *)SDL_malloc(SDL_NUM_SCANCODES * sizeof(**keycodes));
+        if (!*keycodes) {
+            return;
+        }
+        SDL_memset(*keycodes, 0xFF, SDL_NUM_SCANCODES * sizeof(**keycodes)); // SDL_KEYMAP_UNSET_KEYCODE
+    }
+
+    SDL_Keycode existing = (*keycodes)[scancode];
+    if (existing != SDL_KEYMAP_UNSET_KEYCODE) {
         // Changing the mapping, need to remove the existing entry from the keymap
-        SDL_RemoveFromHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key);
-        SDL_RemoveFromHashTable(keymap->keycode_to_scancode, value);
+        SDL_RemoveFromHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)existing);
     }
 
-    SDL_InsertIntoHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, (void *)(uintptr_t)keycode);
+    Uint32 key = ((Uint32)modstate << 16) | scancode;
+    (*keycodes)[scancode] = keycode;
     SDL_InsertIntoHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, (void *)(uintptr_t)key);
 }
 
 SDL_Keycode SDL_GetKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate)
 {
-    SDL_Keycode keycode;
-
-    Uint32 key = ((Uint32)NormalizeModifierStateForKeymap(modstate) << 16) | scancode;
-    const void *value;
-    if (keymap && SDL_FindInHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, &value)) {
-        keycode = (SDL_Keycode)(uintptr_t)value;
-    } else {
+    SDL_Keycode keycode = GetKeymapEntry(keymap, scancode, NormalizeModifierStateForKeymap(modstate));
+    if (keycode == SDL_KEYMAP_UNSET_KEYCODE) {
         keycode = SDL_GetDefaultKeyFromScancode(scancode, modstate);
     }
     return keycode;
@@ -121,11 +166,15 @@ SDL_Scancode SDL_GetKeymapScancode(SDL_Keymap *keymap, SDL_Keycode keycode, SDL_
 
 void SDL_DestroyKeymap(SDL_Keymap *keymap)
 {
+    int i;
+
     if (!keymap) {
         return;
     }
 
-    SDL_DestroyHashTable(keymap->scancode_to_keycode);
+    for (i = 0; i < SDL_arraysize(keymap->scancode_to_keycode); ++i) {
+        SDL_free(keymap->scancode_to_keycode[i]);
+    }
     SDL_DestroyHashTable(keymap->keycode_to_scancode);
     SDL_free(keymap);
 }
@@ -118,20 +118,20 @@ static int SDL_GetFingerIndex(const SDL_Touch *touch, SDL_FingerID fingerid)
 {
     int index;
     for (index = 0; index < touch->num_fingers; ++index) {
-        if (touch->fingers[index]->id == fingerid) {
+        if (touch->fingers[index].id == fingerid) {
             return index;
         }
     }
     return -1;
 }
 
-static SDL_Finger *SDL_GetFinger(const SDL_Touch *touch, SDL_FingerID id)
+static SDL_Finger *SDL_GetFinger(SDL_Touch *touch, SDL_FingerID id)
 {
     int index = SDL_GetFingerIndex(touch, id);
     if (index < 0 || index >= touch->num_fingers) {
         return NULL;
     }
-    return touch->fingers[index];
+    return &touch->fingers[index];
 }
 
 SDL_Finger **SDL_GetTouchFingers(SDL_TouchID touchID, int *count)
@@ -157,7 +157,7 @@ SDL_Finger **SDL_GetTouchFingers(SDL_TouchID touchID, int *count)
 
     for (int i = 0; i < touch->num_fingers; ++i) {
         fingers[i] = &finger_data[i];
-        SDL_copyp(fingers[i], touch->fingers[i]);
+        SDL_copyp(fingers[i], &touch->fingers[i]);
     }
     fingers[touch->num_fingers] = NULL;
 
@@ -189,7 +189,7 @@ int SDL_AddTouch(SDL_TouchID touchID, SDL_TouchDeviceType type, const char *name
     SDL_touchDevices = touchDevices;
     index = SDL_num_touch;
 
-    SDL_touchDevices[index] = (SDL_Touch *)SDL_malloc(sizeof(*SDL_touchDevices[index]));
+    SDL_touchDevices[index] = (SDL_Touch *)SDL_calloc(1, sizeof(*SDL_touchDevices[index]));
     if (!SDL_touchDevices[index]) {
         return -1;
     }
@@ -201,8 +201,6 @@ int SDL_AddTouch(SDL_TouchID touchID, SDL_TouchDeviceType type, const char *name
     SDL_touchDevices[index]->id = touchID;
     SDL_touchDevices[index]->type = type;
     SDL_touchDevices[index]->num_fingers = 0;
-    SDL_touchDevices[index]->max_fingers = 0;
-    SDL_touchDevices[index]->fingers = NULL;
     SDL_touchDevices[index]->name = SDL_strdup(name ? name : "");
 
     return index;
@@ -214,21 +212,11 @@ static int SDL_AddFinger(SDL_Touch *touch, SDL_FingerID fingerid, float x, float
 
     SDL_assert(fingerid != 0);
 
-    if (touch->num_fingers == touch->max_fingers) {
-        SDL_Finger **new_fingers;
-        new_fingers = (SDL_Finger **)SDL_realloc(touch->fingers, (touch->max_fingers + 1) * sizeof(*touch->fingers));
-        if (!new_fingers) {
-            return -1;
-        }
-        touch->fingers = new_fingers;
-        touch->fingers[touch->max_fingers] = (SDL_Finger *)SDL_malloc(sizeof(*finger));
-        if (!touch->fingers[touch->max_fingers]) {
-            return -1;
-        }
-        touch->max_fingers++;
+    if (touch->num_fingers == SDL_TOUCH_MAX_FINGERS) {
+        return SDL_SetError("Too many fingers on touch device");
     }
 
-    finger = touch->fingers[touch->num_fingers++];
+    finger = &touch->fingers[touch->num_fingers++];
     finger->id = fingerid;
     finger->x = x;
     finger->y = y;
@@ -245,12 +233,8 @@ static int SDL_DelFinger(SDL_Touch *touch, SDL_FingerID fingerid)
 
     --touch->num_fingers;
     if (index < (touch->num_fingers)) {
-        // Move the deleted finger to just past the end of the active fingers array and shift the active fingers by one.
-        // This ensures that the descriptor for the now-deleted finger is located at `touch->fingers[touch->num_fingers]`
-        // and is ready for use in SDL_AddFinger.
-        SDL_Finger *deleted_finger = touch->fingers[index];
+        // Shift the remaining fingers down, keeping them in the order they touched
         SDL_memmove(&touch->fingers[index], &touch->fingers[index + 1], (touch->num_fingers - index) * sizeof(touch->fingers[index]));
-        touch->fingers[touch->num_fingers] = deleted_finger;
     }
     return 0;
 }
@@ -478,7 +462,7 @@ int SDL_SendTouchMotion(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid,
 
 void SDL_DelTouch(SDL_TouchID id)
 {
-    int i, index;
+    int index;
     SDL_Touch *touch;
 
     if (SDL_num_touch == 0) {
@@ -492,10 +476,6 @@ void SDL_DelTouch(SDL_TouchID id)
         return;
     }
 
-    for (i = 0; i < touch->max_fingers; ++i) {
-        SDL_free(touch->fingers[i]);
-    }
-    SDL_free(touch->fingers);
     SDL_free(touch->name);
     SDL_free(touch);
 
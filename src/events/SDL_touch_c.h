@@ -23,13 +23,15 @@
 #ifndef SDL_touch_c_h_
 #define SDL_touch_c_h_
 
+/* The most fingers tracked at once on a touch device, additional contacts are ignored */
+#define SDL_TOUCH_MAX_FINGERS 64
+
 typedef struct SDL_Touch
 {
     SDL_TouchID id;
     SDL_TouchDeviceType type;
     int num_fingers;
-    int max_fingers;
-    SDL_Finger **fingers;
+    SDL_Finger fingers[SDL_TOUCH_MAX_FINGERS];
     char *name;
 } SDL_Touch;
 
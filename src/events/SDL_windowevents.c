@@ -24,6 +24,7 @@
 
 #include "SDL_events_c.h"
 #include "SDL_mouse_c.h"
+#include "../video/SDL_blit.h"
 
 
 static SDL_bool SDLCALL RemoveSupercededWindowEvents(void *userdata, SDL_Event *event)
@@ -66,6 +67,10 @@ int SDL_SendWindowEvent(SDL_Window *window, SDL_EventType windowevent,
         break;
     case SDL_EVENT_WINDOW_EXPOSED:
         window->flags &= ~SDL_WINDOW_OCCLUDED;
+        if (window->surface) {
+            /* The window contents need to be redrawn */
+            SDL_AddSurfaceDamage(window->surface, NULL);
+        }
         break;
     case SDL_EVENT_WINDOW_MOVED:
         window->undefined_x = SDL_FALSE;
@@ -0,0 +1,397 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_sysasyncio.h"
+#include "SDL_asyncio_c.h"
+
+static const char *AsyncFileModeValid(const char *mode)
+{
+    static const struct { const char *valid; const char *with_binary; } mode_map[] = {
+        { "r", "rb" },
+        { "w", "wb" },
+        { "r+", "rb+" },
+        { "w+", "wb+" }
+    };
+    int i;
+
+    for (i = 0; i < SDL_arraysize(mode_map); i++) {
+        if (SDL_strcmp(mode, mode_map[i].valid) == 0) {
+            return mode_map[i].with_binary;
+        }
+    }
+    return NULL;
+}
+
+SDL_AsyncIO *SDL_AsyncIOFromFile(const char *file, const char *mode)
+{
+    const char *binary_mode;
+    SDL_AsyncIO *asyncio;
+
+    if (!file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    } else if (!mode) {
+        SDL_InvalidParamError("mode");
+        return NULL;
+    }
+
+    binary_mode = AsyncFileModeValid(mode);
+    if (!binary_mode) {
+        SDL_SetError("Unsupported file mode");
+        return NULL;
+    }
+
+    asyncio = (SDL_AsyncIO *)SDL_calloc(1, sizeof(*asyncio));
+    if (!asyncio) {
+        return NULL;
+    }
+
+    asyncio->lock = SDL_CreateMutex();
+    if (!asyncio->lock) {
+        SDL_free(asyncio);
+        return NULL;
+    }
+
+    /* Backends get the "b" variant, so they can hand it to fopen() as is */
+    if (SDL_SYS_AsyncIOFromFile(file, binary_mode, asyncio) < 0) {
+        SDL_DestroyMutex(asyncio->lock);
+        SDL_free(asyncio);
+        return NULL;
+    }
+    return asyncio;
+}
+
+static void DestroyAsyncIO(SDL_AsyncIO *asyncio)
+{
+    asyncio->iface.destroy(asyncio->userdata);
+    SDL_DestroyMutex(asyncio->lock);
+    SDL_free(asyncio);
+}
+
+Sint64 SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio)
+{
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    }
+    return asyncio->iface.size(asyncio->userdata);
+}
+
+static SDL_AsyncIOTask *CreateAsyncIOTask(SDL_AsyncIO *asyncio, SDL_AsyncIOTaskType type, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *)SDL_calloc(1, sizeof(*task));
+    if (task) {
+        task->asyncio = asyncio;
+        task->queue = queue;
+        task->type = type;
+        task->result = SDL_ASYNCIO_COMPLETE;
+        task->app_userdata = userdata;
+    }
+    return task;
+}
+
+/* Called with the asyncio lock held */
+static void LinkAsyncIOTask(SDL_AsyncIO *asyncio, SDL_AsyncIOTask *task)
+{
+    task->prev = &asyncio->tasks;
+    task->next = asyncio->tasks.next;
+    if (task->next) {
+        task->next->prev = task;
+    }
+    asyncio->tasks.next = task;
+}
+
+/* Called with the asyncio lock held */
+static void UnlinkAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    task->prev->next = task->next;
+    if (task->next) {
+        task->next->prev = task->prev;
+    }
+    task->prev = NULL;
+    task->next = NULL;
+}
+
+static int StartAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIOQueue *queue = task->queue;
+
+    SDL_AtomicIncRef(&queue->tasks_inflight);
+    if (queue->iface.queue_task(queue->userdata, task) < 0) {
+        (void)SDL_AtomicDecRef(&queue->tasks_inflight);
+        return -1;
+    }
+    return 0;
+}
+
+static int QueueAsyncIOTask(SDL_AsyncIO *asyncio, SDL_AsyncIOTaskType type, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    } else if (!ptr && size > 0) {
+        return SDL_InvalidParamError("ptr");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    task = CreateAsyncIOTask(asyncio, type, queue, userdata);
+    if (!task) {
+        return -1;
+    }
+    task->buffer = ptr;
+    task->offset = offset;
+    task->requested_size = size;
+
+    SDL_LockMutex(asyncio->lock);
+    if (asyncio->closing) {
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_free(task);
+        return SDL_SetError("SDL_AsyncIO is closing, can't start new tasks");
+    }
+    LinkAsyncIOTask(asyncio, task);
+    if (StartAsyncIOTask(task) < 0) {
+        UnlinkAsyncIOTask(task);
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_free(task);
+        return -1;
+    }
+    SDL_UnlockMutex(asyncio->lock);
+
+    return 0;
+}
+
+int SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return QueueAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_READ, ptr, offset, size, queue, userdata);
+}
+
+int SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return QueueAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_WRITE, ptr, offset, size, queue, userdata);
+}
+
+int SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, SDL_bool flush, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    SDL_LockMutex(asyncio->lock);
+    if (asyncio->closing) {
+        SDL_UnlockMutex(asyncio->lock);
+        return SDL_SetError("SDL_AsyncIO is already closing");
+    }
+
+    task = CreateAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_CLOSE, queue, userdata);
+    if (!task) {
+        SDL_UnlockMutex(asyncio->lock);
+        return -1;
+    }
+    task->flush = flush;
+
+    /* If other tasks are pending, the last one to finish starts the close */
+    asyncio->closing = task;
+    if (!asyncio->tasks.next && StartAsyncIOTask(task) < 0) {
+        asyncio->closing = NULL;
+        SDL_UnlockMutex(asyncio->lock);
+        SDL_free(task);
+        return -1;
+    }
+    SDL_UnlockMutex(asyncio->lock);
+
+    return 0;
+}
+
+SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
+{
+    SDL_AsyncIOQueue *queue = (SDL_AsyncIOQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+
+    if (SDL_SYS_CreateAsyncIOQueue(queue) < 0) {
+        SDL_free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+/* Turns a finished task into an outcome for the app and frees it */
+static SDL_bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *outcome)
+{
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOTask *closing = NULL;
+    SDL_bool destroy = SDL_FALSE;
+
+    if (!task) {
+        return SDL_FALSE;
+    }
+
+    asyncio = task->asyncio;
+    queue = task->queue;
+
+    SDL_zerop(outcome);
+    outcome->asyncio = asyncio->oneshot ? NULL : asyncio;
+    outcome->type = task->type;
+    outcome->result = task->result;
+    outcome->buffer = task->buffer;
+    outcome->offset = task->offset;
+    outcome->bytes_requested = task->requested_size;
+    outcome->bytes_transferred = task->result_size;
+    outcome->userdata = task->app_userdata;
+
+    if (task->result == SDL_ASYNCIO_FAILURE) {
+        SDL_SetError("%s", task->error);
+    }
+
+    if (task->type == SDL_ASYNCIO_TASK_CLOSE) {
+        destroy = SDL_TRUE;
+    } else {
+        SDL_LockMutex(asyncio->lock);
+        UnlinkAsyncIOTask(task);
+        if (asyncio->oneshot) {
+            /* SDL_LoadFileAsync() is done, there's nothing left to do with the file */
+            if (task->result == SDL_ASYNCIO_COMPLETE) {
+                ((Uint8 *)outcome->buffer)[outcome->bytes_transferred] = '\0';
+            } else {
+                SDL_free(outcome->buffer);
+                outcome->buffer = NULL;
+            }
+            destroy = SDL_TRUE;
+        } else if (asyncio->closing && !asyncio->tasks.next) {
+            closing = asyncio->closing;
+        }
+        SDL_UnlockMutex(asyncio->lock);
+    }
+
+    (void)SDL_AtomicDecRef(&queue->tasks_inflight);
+    SDL_free(task);
+
+    if (closing && StartAsyncIOTask(closing) < 0) {
+        /* There's no way to report this to the app, but don't leak the file */
+        SDL_free(closing);
+        destroy = SDL_TRUE;
+    }
+    if (destroy) {
+        DestroyAsyncIO(asyncio);
+    }
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome)
+{
+    if (!queue || !outcome) {
+        return SDL_FALSE;
+    }
+    return GetAsyncIOTaskOutcome(queue->iface.get_results(queue->userdata), outcome);
+}
+
+SDL_bool SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome, Sint32 timeoutMS)
+{
+    if (!queue || !outcome) {
+        return SDL_FALSE;
+    }
+    return GetAsyncIOTaskOutcome(queue->iface.wait_results(queue->userdata, timeoutMS), outcome);
+}
+
+void SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    if (queue) {
+        queue->iface.signal(queue->userdata);
+    }
+}
+
+void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    if (!queue) {
+        return;
+    }
+
+    /* Wait for everything still in flight, throwing the results away */
+    while (SDL_AtomicGet(&queue->tasks_inflight) > 0) {
+        SDL_AsyncIOTask *task = queue->iface.wait_results(queue->userdata, -1);
+        if (task) {
+            const SDL_bool oneshot = task->asyncio->oneshot;
+            SDL_AsyncIOOutcome outcome;
+
+            GetAsyncIOTaskOutcome(task, &outcome);
+            if (oneshot) {
+                SDL_free(outcome.buffer);
+            }
+        }
+    }
+
+    queue->iface.destroy(queue->userdata);
+    SDL_free(queue);
+}
+
+int SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIO *asyncio;
+    Sint64 size;
+    void *ptr;
+
+    if (!file) {
+        return SDL_InvalidParamError("file");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    asyncio = SDL_AsyncIOFromFile(file, "r");
+    if (!asyncio) {
+        return -1;
+    }
+    asyncio->oneshot = SDL_TRUE;
+
+    size = SDL_GetAsyncIOSize(asyncio);
+    if (size < 0) {
+        DestroyAsyncIO(asyncio);
+        return -1;
+    } else if ((Uint64)size >= SDL_SIZE_MAX) {
+        DestroyAsyncIO(asyncio);
+        return SDL_SetError("%s is too large to load", file);
+    }
+
+    ptr = SDL_malloc((size_t)size + 1);
+    if (!ptr) {
+        DestroyAsyncIO(asyncio);
+        return -1;
+    }
+
+    if (QueueAsyncIOTask(asyncio, SDL_ASYNCIO_TASK_READ, ptr, 0, (Uint64)size, queue, userdata) < 0) {
+        SDL_free(ptr);
+        DestroyAsyncIO(asyncio);
+        return -1;
+    }
+    return 0;
+}
+
+void SDL_QuitAsyncIO(void)
+{
+    SDL_SYS_QuitAsyncIO();
+}
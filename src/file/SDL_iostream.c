@@ -508,6 +508,137 @@ static int SDLCALL mem_close(void *userdata)
     return 0;
 }
 
+/* Functions to read memory-mapped files, reusing the memory pointer functions above */
+
+#if (defined(SDL_PLATFORM_WIN32) || defined(SDL_PLATFORM_GDK)) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+#define SDL_IOSTREAM_MAP_WINDOWS
+#elif defined(HAVE_STDIO_H) && (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE))
+#define SDL_IOSTREAM_MAP_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(SDL_IOSTREAM_MAP_WINDOWS) || defined(SDL_IOSTREAM_MAP_POSIX)
+
+typedef struct IOStreamMappedData
+{
+    IOStreamMemData data; /* must be first, this is what the mem_* functions see */
+    size_t size;
+#ifdef SDL_IOSTREAM_MAP_WINDOWS
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} IOStreamMappedData;
+
+static void unmap_file(IOStreamMappedData *iodata)
+{
+#ifdef SDL_IOSTREAM_MAP_WINDOWS
+    if (iodata->data.base) {
+        UnmapViewOfFile(iodata->data.base);
+    }
+    if (iodata->mapping) {
+        CloseHandle(iodata->mapping);
+    }
+    if (iodata->file != INVALID_HANDLE_VALUE) {
+        CloseHandle(iodata->file);
+    }
+#else
+    if (iodata->data.base) {
+        munmap(iodata->data.base, iodata->size);
+    }
+#endif
+    SDL_free(iodata);
+}
+
+static int SDLCALL mapped_close(void *userdata)
+{
+    unmap_file((IOStreamMappedData *) userdata);
+    return 0;
+}
+
+static int map_file(IOStreamMappedData *iodata, const char *file, SDL_IOAccessPattern pattern)
+{
+#ifdef SDL_IOSTREAM_MAP_WINDOWS
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    LARGE_INTEGER size;
+    LPWSTR wstr;
+
+    if (pattern == SDL_IO_ACCESS_SEQUENTIAL) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (pattern == SDL_IO_ACCESS_RANDOM) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    wstr = WIN_UTF8ToStringW(file);
+    if (!wstr) {
+        return -1;
+    }
+    iodata->file = CreateFileW(wstr, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+    SDL_free(wstr);
+    if (iodata->file == INVALID_HANDLE_VALUE) {
+        return WIN_SetError("Couldn't open file");
+    }
+    if (!GetFileSizeEx(iodata->file, &size)) {
+        return WIN_SetError("Couldn't get file size");
+    }
+    if ((Uint64)size.QuadPart > SDL_SIZE_MAX) {
+        return SDL_SetError("%s is too large to map", file);
+    }
+    iodata->size = (size_t)size.QuadPart;
+    if (iodata->size == 0) {
+        return 0; /* an empty view can't be mapped, but an empty stream is fine */
+    }
+
+    iodata->mapping = CreateFileMappingW(iodata->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!iodata->mapping) {
+        return WIN_SetError("Couldn't create file mapping");
+    }
+    iodata->data.base = (Uint8 *)MapViewOfFile(iodata->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!iodata->data.base) {
+        return WIN_SetError("Couldn't map file");
+    }
+#else
+    struct stat st;
+    void *base;
+    int fd;
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return SDL_SetError("Couldn't open %s: %s", file, strerror(errno));
+    }
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return SDL_SetError("%s is not a regular file", file);
+    }
+    if ((Uint64)st.st_size > SDL_SIZE_MAX) {
+        close(fd);
+        return SDL_SetError("%s is too large to map", file);
+    }
+    iodata->size = (size_t)st.st_size;
+    if (iodata->size == 0) {
+        close(fd);
+        return 0; /* an empty mapping is invalid, but an empty stream is fine */
+    }
+
+    base = mmap(NULL, iodata->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* the mapping holds its own reference to the file */
+    if (base == MAP_FAILED) {
+        return SDL_SetError("Couldn't map %s: %s", file, strerror(errno));
+    }
+    iodata->data.base = (Uint8 *)base;
+
+    if (pattern == SDL_IO_ACCESS_SEQUENTIAL) {
+        madvise(base, iodata->size, MADV_SEQUENTIAL);
+    } else if (pattern == SDL_IO_ACCESS_RANDOM) {
+        madvise(base, iodata->size, MADV_RANDOM);
+    }
+#endif
+    return 0;
+}
+
+#endif /* SDL_IOSTREAM_MAP_WINDOWS || SDL_IOSTREAM_MAP_POSIX */
+
 /* Functions to create SDL_IOStream structures from various data sources */
 
 #if defined(HAVE_STDIO_H) && !defined(SDL_PLATFORM_WINDOWS)
@@ -741,6 +872,56 @@ SDL_IOStream *SDL_IOFromConstMem(const void *mem, size_t size)
     return iostr;
 }
 
+SDL_IOStream *SDL_IOFromMappedFile(const char *file, SDL_IOAccessPattern pattern)
+{
+#if defined(SDL_IOSTREAM_MAP_WINDOWS) || defined(SDL_IOSTREAM_MAP_POSIX)
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+    IOStreamMappedData *iodata = (IOStreamMappedData *) SDL_calloc(1, sizeof (*iodata));
+    if (!iodata) {
+        return NULL;
+    }
+#ifdef SDL_IOSTREAM_MAP_WINDOWS
+    iodata->file = INVALID_HANDLE_VALUE;
+#endif
+
+    if (map_file(iodata, file, pattern) < 0) {
+        unmap_file(iodata);
+        return NULL;
+    }
+    iodata->data.here = iodata->data.base;
+    iodata->data.stop = iodata->data.base + iodata->size;
+
+    SDL_IOStreamInterface iface;
+    SDL_zero(iface);
+    iface.size = mem_size;
+    iface.seek = mem_seek;
+    iface.read = mem_read;
+    // leave iface.write as NULL, the mapping is read-only.
+    iface.close = mapped_close;
+
+    SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        unmap_file(iodata);
+    } else {
+        const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
+        if (props) {
+            SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_MAPPED_MEMORY_POINTER, iodata->data.base);
+            SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_MAPPED_SIZE_NUMBER, (Sint64)iodata->size);
+        }
+    }
+    return iostr;
+#else
+    (void)file;
+    (void)pattern;
+    SDL_Unsupported();
+    return NULL;
+#endif
+}
+
 typedef struct IOStreamDynamicMemData
 {
     SDL_IOStream *stream;
@@ -768,14 +949,32 @@ static size_t SDLCALL dynamic_mem_read(void *userdata, void *ptr, size_t size, S
 
 static int dynamic_mem_realloc(IOStreamDynamicMemData *iodata, size_t size)
 {
-    size_t chunksize = (size_t)SDL_GetNumberProperty(SDL_GetIOProperties(iodata->stream), SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER, 0);
+    SDL_PropertiesID props = SDL_GetIOProperties(iodata->stream);
+    size_t chunksize = (size_t)SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER, 0);
     if (!chunksize) {
         chunksize = 1024;
     }
 
     // We're intentionally allocating more memory than needed so it can be null terminated
-    size_t chunks = (((iodata->end - iodata->data.base) + size) / chunksize) + 1;
-    size_t length = (chunks * chunksize);
+    size_t capacity = (size_t)(iodata->end - iodata->data.base);
+    size_t length = (size_t)(iodata->data.here - iodata->data.base) + size + 1;
+
+    // Grow geometrically, so streaming out a lot of data doesn't copy it over and over
+    if (capacity < (SDL_SIZE_MAX / 2) && length < (capacity * 2)) {
+        length = capacity * 2;
+    }
+    if (!iodata->data.base) {
+        size_t initial = (size_t)SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_CAPACITY_NUMBER, 0);
+        if (length < initial) {
+            length = initial;
+        }
+    }
+    if (length > (SDL_SIZE_MAX - chunksize)) {
+        SDL_OutOfMemory();
+        return -1;
+    }
+    length = ((length + chunksize - 1) / chunksize) * chunksize;
+
     Uint8 *base = (Uint8 *)SDL_realloc(iodata->data.base, length);
     if (!base) {
         return -1;
@@ -794,16 +993,40 @@ static size_t SDLCALL dynamic_mem_write(void *userdata, const void *ptr, size_t
 {
     IOStreamDynamicMemData *iodata = (IOStreamDynamicMemData *) userdata;
     if (size > (size_t)(iodata->data.stop - iodata->data.here)) {
-        if (size > (size_t)(iodata->end - iodata->data.here)) {
+        if (size >= (size_t)(iodata->end - iodata->data.here)) {
             if (dynamic_mem_realloc(iodata, size) < 0) {
                 return 0;
             }
         }
         iodata->data.stop = iodata->data.here + size;
+        *iodata->data.stop = '\0';
     }
     return mem_io(&iodata->data, iodata->data.here, ptr, size);
 }
 
+static size_t SDLCALL dynamic_mem_writev(void *userdata, const SDL_IOVec *vecs, int count, SDL_IOStatus *status)
+{
+    IOStreamDynamicMemData *iodata = (IOStreamDynamicMemData *) userdata;
+    size_t total = 0, bytes = 0;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        total += vecs[i].size;
+    }
+
+    /* Grow once for the whole write, rather than once per buffer */
+    if (total >= (size_t)(iodata->end - iodata->data.here)) {
+        if (dynamic_mem_realloc(iodata, total) < 0) {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < count; ++i) {
+        bytes += dynamic_mem_write(iodata, vecs[i].ptr, vecs[i].size, status);
+    }
+    return bytes;
+}
+
 static int SDLCALL dynamic_mem_close(void *userdata)
 {
     const IOStreamDynamicMemData *iodata = (IOStreamDynamicMemData *) userdata;
@@ -828,6 +1051,7 @@ SDL_IOStream *SDL_IOFromDynamicMem(void)
     iface.seek = dynamic_mem_seek;
     iface.read = dynamic_mem_read;
     iface.write = dynamic_mem_write;
+    iface.writev = dynamic_mem_writev;
     iface.close = dynamic_mem_close;
 
     iodata->data.base = NULL;
@@ -844,6 +1068,340 @@ SDL_IOStream *SDL_IOFromDynamicMem(void)
     return iostr;
 }
 
+#define SDL_BUFFERED_IO_DEFAULT_SIZE 4096
+
+typedef struct IOStreamBufferedData
+{
+    SDL_IOStream *src;
+    SDL_bool closeio;
+    SDL_bool writing;       /* the buffer holds data waiting to be written to src */
+    Uint8 *buffer;
+    size_t size;
+    size_t pos;             /* next byte to read, or the number of bytes waiting to be written */
+    size_t fill;            /* number of bytes read into the buffer */
+    Sint64 buffer_offset;   /* the offset in src of the start of the buffer, or -1 if not known */
+} IOStreamBufferedData;
+
+static void buffered_discard(IOStreamBufferedData *iodata)
+{
+    iodata->writing = SDL_FALSE;
+    iodata->pos = 0;
+    iodata->fill = 0;
+    iodata->buffer_offset = -1;
+}
+
+static int buffered_flush(IOStreamBufferedData *iodata)
+{
+    if (!iodata->writing) {
+        return 0;
+    }
+    if (iodata->pos > 0) {
+        size_t written = SDL_WriteIO(iodata->src, iodata->buffer, iodata->pos);
+        if (written < iodata->pos) {
+            /* Keep whatever didn't make it out, so it can be retried */
+            SDL_memmove(iodata->buffer, iodata->buffer + written, iodata->pos - written);
+            iodata->pos -= written;
+            return -1;
+        }
+    }
+    buffered_discard(iodata);
+    return 0;
+}
+
+/* Put src back at the position the application has read up to */
+static int buffered_unread(IOStreamBufferedData *iodata)
+{
+    if (!iodata->writing && iodata->pos < iodata->fill) {
+        if (SDL_SeekIO(iodata->src, -(Sint64)(iodata->fill - iodata->pos), SDL_IO_SEEK_CUR) < 0) {
+            return -1;
+        }
+    }
+    buffered_discard(iodata);
+    return 0;
+}
+
+static Sint64 SDLCALL buffered_size(void *userdata)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    if (buffered_flush(iodata) < 0) {
+        return -1;
+    }
+    return SDL_GetIOSize(iodata->src);
+}
+
+static Sint64 SDLCALL buffered_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    Sint64 result;
+
+    if (iodata->writing) {
+        if (buffered_flush(iodata) < 0) {
+            return -1;
+        }
+        return SDL_SeekIO(iodata->src, offset, whence);
+    }
+
+    /* Seeks that land inside the read-ahead buffer don't need to touch src */
+    if (iodata->fill > 0 && (whence == SDL_IO_SEEK_SET || whence == SDL_IO_SEEK_CUR)) {
+        if (iodata->buffer_offset < 0) {
+            Sint64 here = SDL_TellIO(iodata->src);
+            if (here >= 0) {
+                iodata->buffer_offset = here - (Sint64)iodata->fill;
+            }
+        }
+        if (iodata->buffer_offset >= 0) {
+            Sint64 target = offset;
+            if (whence == SDL_IO_SEEK_CUR) {
+                target += iodata->buffer_offset + (Sint64)iodata->pos;
+            }
+            if (target >= iodata->buffer_offset && target <= iodata->buffer_offset + (Sint64)iodata->fill) {
+                iodata->pos = (size_t)(target - iodata->buffer_offset);
+                return target;
+            }
+        }
+    }
+
+    if (whence == SDL_IO_SEEK_CUR) {
+        offset -= (Sint64)(iodata->fill - iodata->pos);
+    }
+    result = SDL_SeekIO(iodata->src, offset, whence);
+    if (result >= 0) {
+        buffered_discard(iodata);
+    }
+    return result;
+}
+
+static size_t SDLCALL buffered_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    if (buffered_flush(iodata) < 0) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+
+    while (size > 0) {
+        size_t avail = iodata->fill - iodata->pos;
+        size_t amount;
+
+        if (avail == 0) {
+            iodata->pos = 0;
+            iodata->fill = 0;
+            iodata->buffer_offset = -1;
+
+            if (size >= iodata->size) {
+                /* Large reads go straight into the caller's memory */
+                amount = SDL_ReadIO(iodata->src, dst, size);
+                if (amount == 0) {
+                    break;
+                }
+                dst += amount;
+                size -= amount;
+                total += amount;
+                continue;
+            }
+
+            iodata->fill = SDL_ReadIO(iodata->src, iodata->buffer, iodata->size);
+            if (iodata->fill == 0) {
+                break;
+            }
+            avail = iodata->fill;
+        }
+
+        amount = SDL_min(avail, size);
+        SDL_memcpy(dst, iodata->buffer + iodata->pos, amount);
+        iodata->pos += amount;
+        dst += amount;
+        size -= amount;
+        total += amount;
+    }
+
+    if (total == 0) {
+        *status = SDL_GetIOStatus(iodata->src);
+    }
+    return total;
+}
+
+/* Switch to writing, and make room for size bytes if they can fit at all */
+static SDL_bool buffered_prepare_write(IOStreamBufferedData *iodata, size_t size, SDL_IOStatus *status)
+{
+    if (!iodata->writing) {
+        if (buffered_unread(iodata) < 0) {
+            *status = SDL_IO_STATUS_ERROR;
+            return SDL_FALSE;
+        }
+        iodata->writing = SDL_TRUE;
+    }
+
+    if (size > (iodata->size - iodata->pos)) {
+        if (buffered_flush(iodata) < 0) {
+            *status = SDL_GetIOStatus(iodata->src);
+            return SDL_FALSE;
+        }
+        iodata->writing = SDL_TRUE;
+    }
+    return SDL_TRUE;
+}
+
+static size_t SDLCALL buffered_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    size_t written;
+
+    if (!buffered_prepare_write(iodata, size, status)) {
+        return 0;
+    }
+
+    if (size >= iodata->size) {
+        /* Large writes go straight out from the caller's memory */
+        written = SDL_WriteIO(iodata->src, ptr, size);
+        if (written < size) {
+            *status = SDL_GetIOStatus(iodata->src);
+        }
+        return written;
+    }
+
+    SDL_memcpy(iodata->buffer + iodata->pos, ptr, size);
+    iodata->pos += size;
+    return size;
+}
+
+static size_t SDLCALL buffered_writev(void *userdata, const SDL_IOVec *vecs, int count, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    size_t total = 0;
+    size_t written;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        total += vecs[i].size;
+    }
+
+    if (!buffered_prepare_write(iodata, total, status)) {
+        return 0;
+    }
+
+    if (total >= iodata->size) {
+        written = SDL_WriteIOV(iodata->src, vecs, count);
+        if (written < total) {
+            *status = SDL_GetIOStatus(iodata->src);
+        }
+        return written;
+    }
+
+    /* Gather everything into the buffer, to go out in one write later */
+    for (i = 0; i < count; ++i) {
+        SDL_memcpy(iodata->buffer + iodata->pos, vecs[i].ptr, vecs[i].size);
+        iodata->pos += vecs[i].size;
+    }
+    return total;
+}
+
+static int SDLCALL buffered_close(void *userdata)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    int retval = 0;
+
+    if (iodata->writing) {
+        retval = buffered_flush(iodata);
+    } else if (!iodata->closeio) {
+        /* Leave src where the application expects it to be */
+        buffered_unread(iodata);
+    }
+    if (iodata->closeio) {
+        if (SDL_CloseIO(iodata->src) < 0) {
+            retval = -1;
+        }
+    }
+    SDL_free(iodata);
+    return retval;
+}
+
+SDL_IOStream *SDL_IOFromBuffered(SDL_IOStream *src, size_t bufsize, SDL_bool closeio)
+{
+    IOStreamBufferedData *iodata;
+    SDL_IOStream *iostr;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    if (bufsize == 0) {
+        bufsize = SDL_BUFFERED_IO_DEFAULT_SIZE;
+    }
+
+    iodata = (IOStreamBufferedData *)SDL_malloc(sizeof(*iodata) + bufsize);
+    if (!iodata) {
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+        return NULL;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_zero(iface);
+    iface.size = buffered_size;
+    iface.seek = buffered_seek;
+    /* Leave out whatever src can't do, so failures show up right away
+       instead of when the buffer is flushed */
+    if (src->iface.read) {
+        iface.read = buffered_read;
+    }
+    if (src->iface.write) {
+        iface.write = buffered_write;
+        iface.writev = buffered_writev;
+    }
+    iface.close = buffered_close;
+
+    iodata->src = src;
+    iodata->closeio = closeio;
+    iodata->buffer = (Uint8 *)(iodata + 1);
+    iodata->size = bufsize;
+    buffered_discard(iodata);
+
+    iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        SDL_free(iodata);
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+    }
+    return iostr;
+}
+
+/* Satisfy small reads and writes on a buffered stream without going through
+   the interface, which is most of them when parsing a format field by field */
+SDL_FORCE_INLINE SDL_bool buffered_read_fast(SDL_IOStream *context, void *ptr, size_t size)
+{
+    if (context->iface.read == buffered_read) {
+        IOStreamBufferedData *iodata = (IOStreamBufferedData *) context->userdata;
+        if (!iodata->writing && (iodata->fill - iodata->pos) >= size) {
+            SDL_memcpy(ptr, iodata->buffer + iodata->pos, size);
+            iodata->pos += size;
+            context->status = SDL_IO_STATUS_READY;
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+SDL_FORCE_INLINE SDL_bool buffered_write_fast(SDL_IOStream *context, const void *ptr, size_t size)
+{
+    if (context->iface.write == buffered_write) {
+        IOStreamBufferedData *iodata = (IOStreamBufferedData *) context->userdata;
+        if (iodata->writing && size < (iodata->size - iodata->pos)) {
+            SDL_memcpy(iodata->buffer + iodata->pos, ptr, size);
+            iodata->pos += size;
+            context->status = SDL_IO_STATUS_READY;
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
 SDL_IOStatus SDL_GetIOStatus(SDL_IOStream *context)
 {
     if (!context) {
@@ -1013,6 +1571,8 @@ size_t SDL_ReadIO(SDL_IOStream *context, void *ptr, size_t size)
         context->status = SDL_IO_STATUS_WRITEONLY;
         SDL_Unsupported();
         return 0;
+    } else if (buffered_read_fast(context, ptr, size)) {
+        return size;
     }
 
     context->status = SDL_IO_STATUS_READY;
@@ -1044,6 +1604,8 @@ size_t SDL_WriteIO(SDL_IOStream *context, const void *ptr, size_t size)
         context->status = SDL_IO_STATUS_READONLY;
         SDL_Unsupported();
         return 0;
+    } else if (buffered_write_fast(context, ptr, size)) {
+        return size;
     }
 
     context->status = SDL_IO_STATUS_READY;
@@ -1060,6 +1622,110 @@ size_t SDL_WriteIO(SDL_IOStream *context, const void *ptr, size_t size)
     return bytes;
 }
 
+size_t SDL_ReadIOV(SDL_IOStream *context, const SDL_IOVec *vecs, int count)
+{
+    size_t total = 0, bytes = 0;
+    int i;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    } else if (count < 0 || (!vecs && count > 0)) {
+        SDL_InvalidParamError("vecs");
+        return 0;
+    } else if (!context->iface.read && !context->iface.readv) {
+        context->status = SDL_IO_STATUS_WRITEONLY;
+        SDL_Unsupported();
+        return 0;
+    }
+
+    context->status = SDL_IO_STATUS_READY;
+    SDL_ClearError();
+
+    for (i = 0; i < count; ++i) {
+        total += vecs[i].size;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    if (context->iface.readv) {
+        bytes = context->iface.readv(context->userdata, vecs, count, &context->status);
+    } else {
+        for (i = 0; i < count; ++i) {
+            size_t amount;
+
+            if (vecs[i].size == 0) {
+                continue;
+            }
+            amount = context->iface.read(context->userdata, vecs[i].ptr, vecs[i].size, &context->status);
+            bytes += amount;
+            if (amount < vecs[i].size) {
+                break;
+            }
+        }
+    }
+
+    if (bytes == 0 && context->status == SDL_IO_STATUS_READY) {
+        if (*SDL_GetError()) {
+            context->status = SDL_IO_STATUS_ERROR;
+        } else {
+            context->status = SDL_IO_STATUS_EOF;
+        }
+    }
+    return bytes;
+}
+
+size_t SDL_WriteIOV(SDL_IOStream *context, const SDL_IOVec *vecs, int count)
+{
+    size_t total = 0, bytes = 0;
+    int i;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    } else if (count < 0 || (!vecs && count > 0)) {
+        SDL_InvalidParamError("vecs");
+        return 0;
+    } else if (!context->iface.write && !context->iface.writev) {
+        context->status = SDL_IO_STATUS_READONLY;
+        SDL_Unsupported();
+        return 0;
+    }
+
+    context->status = SDL_IO_STATUS_READY;
+    SDL_ClearError();
+
+    for (i = 0; i < count; ++i) {
+        total += vecs[i].size;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    if (context->iface.writev) {
+        bytes = context->iface.writev(context->userdata, vecs, count, &context->status);
+    } else {
+        for (i = 0; i < count; ++i) {
+            size_t amount;
+
+            if (vecs[i].size == 0) {
+                continue;
+            }
+            amount = context->iface.write(context->userdata, vecs[i].ptr, vecs[i].size, &context->status);
+            bytes += amount;
+            if (amount < vecs[i].size) {
+                break;
+            }
+        }
+    }
+
+    if ((bytes == 0) && (context->status == SDL_IO_STATUS_READY)) {
+        context->status = SDL_IO_STATUS_ERROR;
+    }
+    return bytes;
+}
+
 size_t SDL_IOprintf(SDL_IOStream *context, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
 {
     va_list ap;
@@ -1097,12 +1763,23 @@ size_t SDL_IOvprintf(SDL_IOStream *context, SDL_PRINTF_FORMAT_STRING const char
 
 /* Functions for dynamically reading and writing endian-specific values */
 
+/* These are small enough that buffered streams can usually skip SDL_ReadIO() and SDL_WriteIO() */
+SDL_FORCE_INLINE SDL_bool ReadIOFully(SDL_IOStream *src, void *ptr, size_t size)
+{
+    return (src && buffered_read_fast(src, ptr, size)) || SDL_ReadIO(src, ptr, size) == size;
+}
+
+SDL_FORCE_INLINE SDL_bool WriteIOFully(SDL_IOStream *dst, const void *ptr, size_t size)
+{
+    return (dst && buffered_write_fast(dst, ptr, size)) || SDL_WriteIO(dst, ptr, size) == size;
+}
+
 SDL_bool SDL_ReadU8(SDL_IOStream *src, Uint8 *value)
 {
     Uint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1116,7 +1793,7 @@ SDL_bool SDL_ReadS8(SDL_IOStream *src, Sint8 *value)
     Sint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1130,7 +1807,7 @@ SDL_bool SDL_ReadU16LE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1149,7 +1826,7 @@ SDL_bool SDL_ReadU16BE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1168,7 +1845,7 @@ SDL_bool SDL_ReadU32LE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1187,7 +1864,7 @@ SDL_bool SDL_ReadU32BE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1206,7 +1883,7 @@ SDL_bool SDL_ReadU64LE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1225,7 +1902,7 @@ SDL_bool SDL_ReadU64BE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (ReadIOFully(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1241,18 +1918,18 @@ SDL_bool SDL_ReadS64BE(SDL_IOStream *src, Sint64 *value)
 
 SDL_bool SDL_WriteU8(SDL_IOStream *dst, Uint8 value)
 {
-    return (SDL_WriteIO(dst, &value, sizeof(value)) == sizeof(value));
+    return WriteIOFully(dst, &value, sizeof(value));
 }
 
 SDL_bool SDL_WriteS8(SDL_IOStream *dst, Sint8 value)
 {
-    return (SDL_WriteIO(dst, &value, sizeof(value)) == sizeof(value));
+    return WriteIOFully(dst, &value, sizeof(value));
 }
 
 SDL_bool SDL_WriteU16LE(SDL_IOStream *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_Swap16LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOFully(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16LE(SDL_IOStream *dst, Sint16 value)
@@ -1263,7 +1940,7 @@ SDL_bool SDL_WriteS16LE(SDL_IOStream *dst, Sint16 value)
 SDL_bool SDL_WriteU16BE(SDL_IOStream *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_Swap16BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOFully(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16BE(SDL_IOStream *dst, Sint16 value)
@@ -1274,7 +1951,7 @@ SDL_bool SDL_WriteS16BE(SDL_IOStream *dst, Sint16 value)
 SDL_bool SDL_WriteU32LE(SDL_IOStream *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_Swap32LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOFully(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32LE(SDL_IOStream *dst, Sint32 value)
@@ -1285,7 +1962,7 @@ SDL_bool SDL_WriteS32LE(SDL_IOStream *dst, Sint32 value)
 SDL_bool SDL_WriteU32BE(SDL_IOStream *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_Swap32BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOFully(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32BE(SDL_IOStream *dst, Sint32 value)
@@ -1296,7 +1973,7 @@ SDL_bool SDL_WriteS32BE(SDL_IOStream *dst, Sint32 value)
 SDL_bool SDL_WriteU64LE(SDL_IOStream *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_Swap64LE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOFully(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64LE(SDL_IOStream *dst, Sint64 value)
@@ -1307,7 +1984,7 @@ SDL_bool SDL_WriteS64LE(SDL_IOStream *dst, Sint64 value)
 SDL_bool SDL_WriteU64BE(SDL_IOStream *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_Swap64BE(value);
-    return (SDL_WriteIO(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return WriteIOFully(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64BE(SDL_IOStream *dst, Sint64 value)
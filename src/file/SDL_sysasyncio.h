@@ -0,0 +1,118 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_sysasyncio_h_
+#define SDL_sysasyncio_h_
+
+#include "SDL_internal.h"
+
+/* If there is no platform backend, the generic thread pool implementation
+   provides the SDL_SYS_* functions directly. Otherwise the platform backend
+   provides them, and falls back to the *_Generic versions at runtime when
+   the platform facility isn't available. */
+#if defined(SDL_PLATFORM_LINUX) && defined(HAVE_LINUX_IO_URING_H)
+#define SDL_ASYNCIO_IO_URING 1
+#else
+#define SDL_ASYNCIO_ONLY_HAVE_GENERIC 1
+#endif
+
+/* An outstanding task. These are linked into the list of tasks pending on
+   their SDL_AsyncIO, and by the backend into whatever queue structure it
+   needs while the task is in flight. */
+typedef struct SDL_AsyncIOTask SDL_AsyncIOTask;
+struct SDL_AsyncIOTask
+{
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOTaskType type;
+    SDL_AsyncIOResult result;
+    void *buffer;
+    Uint64 offset;
+    Uint64 requested_size;
+    Uint64 result_size;
+    SDL_bool flush;
+    void *app_userdata;
+    char error[128];    /* set with the failure reason when result is SDL_ASYNCIO_FAILURE */
+
+    SDL_AsyncIOTask *prev;          /* the list of tasks pending on the SDL_AsyncIO */
+    SDL_AsyncIOTask *next;
+    SDL_AsyncIOTask *queue_next;    /* owned by the backend */
+};
+
+typedef struct SDL_AsyncIOQueueInterface
+{
+    /* Start the work for a task, which goes on the queue when it's done */
+    int (*queue_task)(void *userdata, SDL_AsyncIOTask *task);
+
+    /* Return a finished task if there is one, or NULL */
+    SDL_AsyncIOTask *(*get_results)(void *userdata);
+
+    /* Wait up to timeoutMS for a finished task, -1 waits forever */
+    SDL_AsyncIOTask *(*wait_results)(void *userdata, Sint32 timeoutMS);
+
+    /* Wake up every thread blocked in wait_results */
+    void (*signal)(void *userdata);
+
+    /* Free the queue; there are no tasks in flight when this is called */
+    void (*destroy)(void *userdata);
+} SDL_AsyncIOQueueInterface;
+
+struct SDL_AsyncIOQueue
+{
+    SDL_AsyncIOQueueInterface iface;
+    void *userdata;
+    SDL_AtomicInt tasks_inflight;
+};
+
+typedef struct SDL_AsyncIOInterface
+{
+    Sint64 (*size)(void *userdata);
+
+    /* Free the file, closing it if that hasn't happened through a close task */
+    void (*destroy)(void *userdata);
+} SDL_AsyncIOInterface;
+
+struct SDL_AsyncIO
+{
+    SDL_AsyncIOInterface iface;
+    void *userdata;
+    SDL_Mutex *lock;
+    SDL_AsyncIOTask tasks;      /* list head of the tasks pending on this object */
+    SDL_AsyncIOTask *closing;   /* a close that is waiting for pending tasks to finish */
+    SDL_bool oneshot;           /* set by SDL_LoadFileAsync, destroyed after its read */
+};
+
+/* Fills in asyncio->iface and asyncio->userdata */
+extern int SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio);
+
+/* Fills in queue->iface and queue->userdata */
+extern int SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue);
+
+extern void SDL_SYS_QuitAsyncIO(void);
+
+#ifndef SDL_ASYNCIO_ONLY_HAVE_GENERIC
+extern int SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_AsyncIO *asyncio);
+extern int SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue);
+extern void SDL_SYS_QuitAsyncIO_Generic(void);
+#endif
+
+#endif /* SDL_sysasyncio_h_ */
+
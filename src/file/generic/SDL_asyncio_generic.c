@@ -0,0 +1,286 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* The generic backend runs every task as a job on a shared thread pool, doing
+   plain blocking I/O through an SDL_IOStream. Tasks on the same file are
+   serialized, since the stream only has one file position. */
+
+#include "SDL_internal.h"
+#include "../SDL_sysasyncio.h"
+
+#ifdef SDL_ASYNCIO_ONLY_HAVE_GENERIC
+#define SDL_SYS_AsyncIOFromFile_Generic SDL_SYS_AsyncIOFromFile
+#define SDL_SYS_CreateAsyncIOQueue_Generic SDL_SYS_CreateAsyncIOQueue
+#define SDL_SYS_QuitAsyncIO_Generic SDL_SYS_QuitAsyncIO
+#endif
+
+/* Workers spend most of their time blocked on the disk, so use a few even on
+   machines with few cores, to keep several requests in flight */
+#define GENERIC_ASYNCIO_MIN_THREADS 4
+#define GENERIC_ASYNCIO_MAX_THREADS 16
+
+typedef struct GenericAsyncIOData
+{
+    SDL_Mutex *lock;
+    SDL_IOStream *io;
+} GenericAsyncIOData;
+
+typedef struct GenericAsyncIOQueueData
+{
+    SDL_Mutex *lock;
+    SDL_Condition *condition;
+    SDL_AsyncIOTask *completed_head;
+    SDL_AsyncIOTask *completed_tail;
+} GenericAsyncIOQueueData;
+
+static SDL_ThreadPool *asyncio_pool;
+static SDL_SpinLock asyncio_pool_lock;
+
+static SDL_ThreadPool *GetAsyncIOThreadPool(void)
+{
+    SDL_ThreadPool *pool = (SDL_ThreadPool *)SDL_AtomicGetPtr((void **)&asyncio_pool);
+    if (!pool) {
+        SDL_LockSpinlock(&asyncio_pool_lock);
+        pool = asyncio_pool;
+        if (!pool) {
+            const int num_threads = SDL_clamp(SDL_GetCPUCount(), GENERIC_ASYNCIO_MIN_THREADS, GENERIC_ASYNCIO_MAX_THREADS);
+            pool = SDL_CreateThreadPool(num_threads, SDL_THREAD_PRIORITY_NORMAL);
+            SDL_AtomicSetPtr((void **)&asyncio_pool, pool);
+        }
+        SDL_UnlockSpinlock(&asyncio_pool_lock);
+    }
+    return pool;
+}
+
+static SDL_bool GenericAsyncIOReadWrite(GenericAsyncIOData *data, SDL_AsyncIOTask *task)
+{
+    Uint8 *ptr = (Uint8 *)task->buffer;
+    SDL_bool result = SDL_TRUE;
+
+    SDL_LockMutex(data->lock);
+    if (SDL_SeekIO(data->io, (Sint64)task->offset, SDL_IO_SEEK_SET) < 0) {
+        result = SDL_FALSE;
+    } else {
+        while (task->result_size < task->requested_size) {
+            const size_t amount = (size_t)SDL_min(task->requested_size - task->result_size, SDL_SIZE_MAX);
+            size_t transferred;
+
+            if (task->type == SDL_ASYNCIO_TASK_READ) {
+                transferred = SDL_ReadIO(data->io, ptr + task->result_size, amount);
+            } else {
+                transferred = SDL_WriteIO(data->io, ptr + task->result_size, amount);
+            }
+            task->result_size += transferred;
+
+            if (transferred == 0) {
+                /* End of file makes a short read, anything else is a failure */
+                if (task->type == SDL_ASYNCIO_TASK_WRITE || SDL_GetIOStatus(data->io) == SDL_IO_STATUS_ERROR) {
+                    result = SDL_FALSE;
+                }
+                break;
+            }
+        }
+    }
+    SDL_UnlockMutex(data->lock);
+
+    return result;
+}
+
+static void SDLCALL GenericAsyncIOTaskJob(void *userdata)
+{
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *)userdata;
+    GenericAsyncIOData *data = (GenericAsyncIOData *)task->asyncio->userdata;
+    GenericAsyncIOQueueData *queue = (GenericAsyncIOQueueData *)task->queue->userdata;
+    SDL_bool result;
+
+    if (task->type == SDL_ASYNCIO_TASK_CLOSE) {
+        /* There's no portable way to sync an SDL_IOStream to disk, so the
+           flush flag gets the C runtime's buffers written out and no more */
+        result = (SDL_CloseIO(data->io) == 0);
+        data->io = NULL;
+    } else {
+        result = GenericAsyncIOReadWrite(data, task);
+    }
+
+    if (!result) {
+        task->result = SDL_ASYNCIO_FAILURE;
+        SDL_strlcpy(task->error, SDL_GetError(), sizeof(task->error));
+    }
+
+    SDL_LockMutex(queue->lock);
+    task->queue_next = NULL;
+    if (queue->completed_tail) {
+        queue->completed_tail->queue_next = task;
+    } else {
+        queue->completed_head = task;
+    }
+    queue->completed_tail = task;
+    SDL_SignalCondition(queue->condition);
+    SDL_UnlockMutex(queue->lock);
+}
+
+static Sint64 GenericAsyncIOSize(void *userdata)
+{
+    GenericAsyncIOData *data = (GenericAsyncIOData *)userdata;
+    Sint64 size;
+
+    SDL_LockMutex(data->lock);
+    size = SDL_GetIOSize(data->io);
+    SDL_UnlockMutex(data->lock);
+
+    return size;
+}
+
+static void GenericAsyncIODestroy(void *userdata)
+{
+    GenericAsyncIOData *data = (GenericAsyncIOData *)userdata;
+
+    if (data->io) {
+        SDL_CloseIO(data->io);
+    }
+    SDL_DestroyMutex(data->lock);
+    SDL_free(data);
+}
+
+int SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+{
+    GenericAsyncIOData *data = (GenericAsyncIOData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+
+    data->lock = SDL_CreateMutex();
+    if (!data->lock) {
+        SDL_free(data);
+        return -1;
+    }
+
+    data->io = SDL_IOFromFile(file, mode);
+    if (!data->io) {
+        SDL_DestroyMutex(data->lock);
+        SDL_free(data);
+        return -1;
+    }
+
+    asyncio->iface.size = GenericAsyncIOSize;
+    asyncio->iface.destroy = GenericAsyncIODestroy;
+    asyncio->userdata = data;
+    return 0;
+}
+
+static int GenericAsyncIOQueueTask(void *userdata, SDL_AsyncIOTask *task)
+{
+    SDL_ThreadPool *pool = GetAsyncIOThreadPool();
+
+    if (!pool || SDL_SubmitJob(pool, GenericAsyncIOTaskJob, task) < 0) {
+        /* No threads to run it on, do the work right away instead */
+        GenericAsyncIOTaskJob(task);
+    }
+    return 0;
+}
+
+/* Called with the queue lock held */
+static SDL_AsyncIOTask *GenericAsyncIOPopResult(GenericAsyncIOQueueData *queue)
+{
+    SDL_AsyncIOTask *task = queue->completed_head;
+    if (task) {
+        queue->completed_head = task->queue_next;
+        if (!queue->completed_head) {
+            queue->completed_tail = NULL;
+        }
+        task->queue_next = NULL;
+    }
+    return task;
+}
+
+static SDL_AsyncIOTask *GenericAsyncIOGetResults(void *userdata)
+{
+    GenericAsyncIOQueueData *queue = (GenericAsyncIOQueueData *)userdata;
+    SDL_AsyncIOTask *task;
+
+    SDL_LockMutex(queue->lock);
+    task = GenericAsyncIOPopResult(queue);
+    SDL_UnlockMutex(queue->lock);
+
+    return task;
+}
+
+static SDL_AsyncIOTask *GenericAsyncIOWaitResults(void *userdata, Sint32 timeoutMS)
+{
+    GenericAsyncIOQueueData *queue = (GenericAsyncIOQueueData *)userdata;
+    SDL_AsyncIOTask *task;
+
+    SDL_LockMutex(queue->lock);
+    if (!queue->completed_head) {
+        SDL_WaitConditionTimeout(queue->condition, queue->lock, timeoutMS);
+    }
+    task = GenericAsyncIOPopResult(queue);
+    SDL_UnlockMutex(queue->lock);
+
+    return task;
+}
+
+static void GenericAsyncIOSignal(void *userdata)
+{
+    GenericAsyncIOQueueData *queue = (GenericAsyncIOQueueData *)userdata;
+
+    SDL_LockMutex(queue->lock);
+    SDL_BroadcastCondition(queue->condition);
+    SDL_UnlockMutex(queue->lock);
+}
+
+static void GenericAsyncIOQueueDestroy(void *userdata)
+{
+    GenericAsyncIOQueueData *queue = (GenericAsyncIOQueueData *)userdata;
+
+    SDL_DestroyCondition(queue->condition);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
+
+int SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue)
+{
+    GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+
+    data->lock = SDL_CreateMutex();
+    data->condition = SDL_CreateCondition();
+    if (!data->lock || !data->condition) {
+        GenericAsyncIOQueueDestroy(data);
+        return -1;
+    }
+
+    queue->iface.queue_task = GenericAsyncIOQueueTask;
+    queue->iface.get_results = GenericAsyncIOGetResults;
+    queue->iface.wait_results = GenericAsyncIOWaitResults;
+    queue->iface.signal = GenericAsyncIOSignal;
+    queue->iface.destroy = GenericAsyncIOQueueDestroy;
+    queue->userdata = data;
+    return 0;
+}
+
+void SDL_SYS_QuitAsyncIO_Generic(void)
+{
+    SDL_DestroyThreadPool(asyncio_pool);
+    asyncio_pool = NULL;
+}
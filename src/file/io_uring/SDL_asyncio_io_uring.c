@@ -0,0 +1,451 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* The Linux backend talks to io_uring directly through its system calls, so
+   there's no dependency on liburing. Each SDL_AsyncIOQueue is its own ring,
+   and files are plain file descriptors. If the kernel doesn't support the
+   io_uring features we need, or it's blocked (some container sandboxes do
+   that), everything goes through the generic thread pool backend instead. */
+
+#include "SDL_internal.h"
+#include "../SDL_sysasyncio.h"
+
+#ifdef SDL_ASYNCIO_IO_URING
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+
+#define IOURING_SQ_ENTRIES 128
+#define IOURING_CQ_ENTRIES 4096
+
+/* The kernel never transfers more than this in one read or write */
+#define IOURING_MAX_TRANSFER 0x7ffff000
+
+#define IOURING_REQUIRED_FEATURES (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)
+
+typedef struct IOUringAsyncIOData
+{
+    int fd;
+} IOUringAsyncIOData;
+
+typedef struct IOUringQueueData
+{
+    int fd;
+    void *ring;
+    size_t ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+
+    SDL_Mutex *sq_lock;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+
+    SDL_Mutex *cq_lock;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    SDL_AtomicInt waiters;
+} IOUringQueueData;
+
+static int use_io_uring = -1;
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg, size_t argsz)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+static SDL_bool UseIOUring(void)
+{
+    if (use_io_uring < 0) {
+        const char *hint = SDL_GetHint(SDL_HINT_ASYNCIO_DRIVER);
+
+        use_io_uring = 0;
+        if (!hint || !*hint || SDL_strcasecmp(hint, "io_uring") == 0) {
+            struct io_uring_params params;
+            int fd;
+
+            SDL_zero(params);
+            fd = io_uring_setup(1, &params);
+            if (fd >= 0) {
+                if ((params.features & IOURING_REQUIRED_FEATURES) == IOURING_REQUIRED_FEATURES) {
+                    use_io_uring = 1;
+                }
+                close(fd);
+            }
+        }
+    }
+    return use_io_uring ? SDL_TRUE : SDL_FALSE;
+}
+
+static Sint64 IOUringAsyncIOSize(void *userdata)
+{
+    IOUringAsyncIOData *data = (IOUringAsyncIOData *)userdata;
+    struct stat st;
+
+    if (fstat(data->fd, &st) < 0) {
+        return SDL_SetError("fstat failed: %s", strerror(errno));
+    }
+    return (Sint64)st.st_size;
+}
+
+static void IOUringAsyncIODestroy(void *userdata)
+{
+    IOUringAsyncIOData *data = (IOUringAsyncIOData *)userdata;
+
+    if (data->fd >= 0) {
+        close(data->fd);
+    }
+    SDL_free(data);
+}
+
+int SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+{
+    IOUringAsyncIOData *data;
+    int flags;
+
+    if (!UseIOUring()) {
+        return SDL_SYS_AsyncIOFromFile_Generic(file, mode, asyncio);
+    }
+
+    /* The mode has already been checked, it's one of "rb", "wb", "rb+" or "wb+" */
+    if (SDL_strchr(mode, '+')) {
+        flags = O_RDWR;
+    } else if (*mode == 'r') {
+        flags = O_RDONLY;
+    } else {
+        flags = O_WRONLY;
+    }
+    if (*mode == 'w') {
+        flags |= O_CREAT | O_TRUNC;
+    }
+
+    data = (IOUringAsyncIOData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+
+    data->fd = open(file, flags | O_CLOEXEC, 0666);
+    if (data->fd < 0) {
+        SDL_free(data);
+        return SDL_SetError("Couldn't open %s: %s", file, strerror(errno));
+    }
+
+    asyncio->iface.size = IOUringAsyncIOSize;
+    asyncio->iface.destroy = IOUringAsyncIODestroy;
+    asyncio->userdata = data;
+    return 0;
+}
+
+static int IOUringSubmit(IOUringQueueData *queue, const struct io_uring_sqe *sqe)
+{
+    unsigned tail, index;
+    int rc;
+
+    SDL_LockMutex(queue->sq_lock);
+
+    /* Every entry is submitted right away, so there's always room */
+    tail = *queue->sq_tail;
+    index = tail & queue->sq_mask;
+    queue->sqes[index] = *sqe;
+    queue->sq_array[index] = index;
+    __atomic_store_n(queue->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    do {
+        rc = io_uring_enter(queue->fd, 1, 0, 0, NULL, 0);
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        /* The kernel didn't take the entry, so it's safe to take it back */
+        const int error = errno;
+        __atomic_store_n(queue->sq_tail, tail, __ATOMIC_RELEASE);
+        SDL_UnlockMutex(queue->sq_lock);
+        if (error == EBUSY || error == EAGAIN) {
+            return SDL_SetError("Too many async I/O results waiting, get some results and try again");
+        }
+        return SDL_SetError("io_uring_enter failed: %s", strerror(error));
+    }
+
+    SDL_UnlockMutex(queue->sq_lock);
+    return 0;
+}
+
+/* Submits the rest of a read or write that hasn't transferred everything yet */
+static int IOUringSubmitReadWrite(IOUringQueueData *queue, SDL_AsyncIOTask *task)
+{
+    IOUringAsyncIOData *data = (IOUringAsyncIOData *)task->asyncio->userdata;
+    struct io_uring_sqe sqe;
+
+    SDL_zero(sqe);
+    sqe.opcode = (task->type == SDL_ASYNCIO_TASK_READ) ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe.fd = data->fd;
+    sqe.addr = (Uint64)(uintptr_t)((Uint8 *)task->buffer + task->result_size);
+    sqe.len = (Uint32)SDL_min(task->requested_size - task->result_size, IOURING_MAX_TRANSFER);
+    sqe.off = task->offset + task->result_size;
+    sqe.user_data = (Uint64)(uintptr_t)task;
+    return IOUringSubmit(queue, &sqe);
+}
+
+static int IOUringQueueTask(void *userdata, SDL_AsyncIOTask *task)
+{
+    IOUringQueueData *queue = (IOUringQueueData *)userdata;
+    IOUringAsyncIOData *data = (IOUringAsyncIOData *)task->asyncio->userdata;
+    struct io_uring_sqe sqe;
+
+    if (task->type != SDL_ASYNCIO_TASK_CLOSE) {
+        return IOUringSubmitReadWrite(queue, task);
+    }
+
+    /* The descriptor itself is closed when the result comes back, which is
+       cheap; the ring only has to do the part that might take a while */
+    SDL_zero(sqe);
+    sqe.opcode = task->flush ? IORING_OP_FSYNC : IORING_OP_NOP;
+    sqe.fd = data->fd;
+    sqe.user_data = (Uint64)(uintptr_t)task;
+    return IOUringSubmit(queue, &sqe);
+}
+
+static void IOUringSetTaskError(SDL_AsyncIOTask *task, int error)
+{
+    task->result = SDL_ASYNCIO_FAILURE;
+    SDL_strlcpy(task->error, strerror(error), sizeof(task->error));
+}
+
+/* Returns SDL_TRUE if the task is done, or SDL_FALSE if more work was started */
+static SDL_bool IOUringFinishTask(IOUringQueueData *queue, SDL_AsyncIOTask *task, int res)
+{
+    IOUringAsyncIOData *data = (IOUringAsyncIOData *)task->asyncio->userdata;
+
+    if (res < 0) {
+        IOUringSetTaskError(task, -res);
+        if (task->type != SDL_ASYNCIO_TASK_CLOSE) {
+            return SDL_TRUE;
+        }
+    }
+
+    if (task->type == SDL_ASYNCIO_TASK_CLOSE) {
+        if (close(data->fd) < 0 && task->result != SDL_ASYNCIO_FAILURE) {
+            IOUringSetTaskError(task, errno);
+        }
+        data->fd = -1;
+    } else if (res == 0) {
+        /* End of file makes a short read, but a write should always make progress */
+        if (task->type == SDL_ASYNCIO_TASK_WRITE && task->result_size < task->requested_size) {
+            IOUringSetTaskError(task, EIO);
+        }
+    } else {
+        task->result_size += (Uint64)res;
+        if (task->result_size < task->requested_size) {
+            if (IOUringSubmitReadWrite(queue, task) == 0) {
+                return SDL_FALSE;
+            }
+            task->result = SDL_ASYNCIO_FAILURE;
+            SDL_strlcpy(task->error, SDL_GetError(), sizeof(task->error));
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_AsyncIOTask *IOUringGetResults(void *userdata)
+{
+    IOUringQueueData *queue = (IOUringQueueData *)userdata;
+    SDL_AsyncIOTask *task = NULL;
+
+    SDL_LockMutex(queue->cq_lock);
+    while (!task) {
+        const unsigned head = *queue->cq_head;
+        const struct io_uring_cqe *cqe;
+        int res;
+
+        if (head == __atomic_load_n(queue->cq_tail, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        cqe = &queue->cqes[head & queue->cq_mask];
+        task = (SDL_AsyncIOTask *)(uintptr_t)cqe->user_data;
+        res = cqe->res;
+        __atomic_store_n(queue->cq_head, head + 1, __ATOMIC_RELEASE);
+
+        /* A NULL task is a wakeup from SDL_SignalAsyncIOQueue() */
+        if (task && !IOUringFinishTask(queue, task, res)) {
+            task = NULL;
+        }
+    }
+    SDL_UnlockMutex(queue->cq_lock);
+
+    return task;
+}
+
+static SDL_AsyncIOTask *IOUringWaitResults(void *userdata, Sint32 timeoutMS)
+{
+    IOUringQueueData *queue = (IOUringQueueData *)userdata;
+    SDL_AsyncIOTask *task = IOUringGetResults(userdata);
+
+    if (!task) {
+        SDL_AtomicIncRef(&queue->waiters);
+        if (timeoutMS < 0) {
+            io_uring_enter(queue->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        } else {
+            struct io_uring_getevents_arg arg;
+            struct __kernel_timespec ts;
+
+            ts.tv_sec = timeoutMS / 1000;
+            ts.tv_nsec = (long long)(timeoutMS % 1000) * 1000000;
+            SDL_zero(arg);
+            arg.ts = (Uint64)(uintptr_t)&ts;
+            io_uring_enter(queue->fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        }
+        (void)SDL_AtomicDecRef(&queue->waiters);
+
+        /* Timeouts and interruptions end up here too, and just find nothing */
+        task = IOUringGetResults(userdata);
+    }
+    return task;
+}
+
+static void IOUringSignal(void *userdata)
+{
+    IOUringQueueData *queue = (IOUringQueueData *)userdata;
+    const int waiters = SDL_AtomicGet(&queue->waiters);
+    int i;
+
+    /* Post an empty completion for every waiting thread */
+    for (i = 0; i < waiters; ++i) {
+        struct io_uring_sqe sqe;
+        SDL_zero(sqe);
+        sqe.opcode = IORING_OP_NOP;
+        if (IOUringSubmit(queue, &sqe) < 0) {
+            break;
+        }
+    }
+}
+
+static void IOUringQueueDestroy(void *userdata)
+{
+    IOUringQueueData *queue = (IOUringQueueData *)userdata;
+
+    if (queue->sqes) {
+        munmap(queue->sqes, queue->sqes_size);
+    }
+    if (queue->ring) {
+        munmap(queue->ring, queue->ring_size);
+    }
+    if (queue->fd >= 0) {
+        close(queue->fd);
+    }
+    SDL_DestroyMutex(queue->cq_lock);
+    SDL_DestroyMutex(queue->sq_lock);
+    SDL_free(queue);
+}
+
+int SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    struct io_uring_params params;
+    IOUringQueueData *data;
+    Uint8 *ring;
+    void *sqes;
+
+    if (!UseIOUring()) {
+        return SDL_SYS_CreateAsyncIOQueue_Generic(queue);
+    }
+
+    data = (IOUringQueueData *)SDL_calloc(1, sizeof(*data));
+    if (!data) {
+        return -1;
+    }
+    data->fd = -1;
+
+    data->sq_lock = SDL_CreateMutex();
+    data->cq_lock = SDL_CreateMutex();
+    if (!data->sq_lock || !data->cq_lock) {
+        IOUringQueueDestroy(data);
+        return -1;
+    }
+
+    /* A deep completion queue lets lots of small reads finish before the app
+       gets around to collecting them */
+    SDL_zero(params);
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = IOURING_CQ_ENTRIES;
+    data->fd = io_uring_setup(IOURING_SQ_ENTRIES, &params);
+    if (data->fd < 0) {
+        IOUringQueueDestroy(data);
+        return SDL_SetError("io_uring_setup failed: %s", strerror(errno));
+    }
+
+    /* IORING_FEAT_SINGLE_MMAP was checked for, so both rings share one mapping */
+    data->ring_size = SDL_max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                              params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+    ring = (Uint8 *)mmap(NULL, data->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, data->fd, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        IOUringQueueDestroy(data);
+        return SDL_SetError("Couldn't map io_uring: %s", strerror(errno));
+    }
+    data->ring = ring;
+
+    data->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes = mmap(NULL, data->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, data->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        IOUringQueueDestroy(data);
+        return SDL_SetError("Couldn't map io_uring: %s", strerror(errno));
+    }
+    data->sqes = (struct io_uring_sqe *)sqes;
+
+    data->sq_head = (unsigned *)(ring + params.sq_off.head);
+    data->sq_tail = (unsigned *)(ring + params.sq_off.tail);
+    data->sq_array = (unsigned *)(ring + params.sq_off.array);
+    data->sq_mask = *(unsigned *)(ring + params.sq_off.ring_mask);
+    data->sq_entries = params.sq_entries;
+    data->cq_head = (unsigned *)(ring + params.cq_off.head);
+    data->cq_tail = (unsigned *)(ring + params.cq_off.tail);
+    data->cq_mask = *(unsigned *)(ring + params.cq_off.ring_mask);
+    data->cqes = (struct io_uring_cqe *)(ring + params.cq_off.cqes);
+
+    queue->iface.queue_task = IOUringQueueTask;
+    queue->iface.get_results = IOUringGetResults;
+    queue->iface.wait_results = IOUringWaitResults;
+    queue->iface.signal = IOUringSignal;
+    queue->iface.destroy = IOUringQueueDestroy;
+    queue->userdata = data;
+    return 0;
+}
+
+void SDL_SYS_QuitAsyncIO(void)
+{
+    SDL_SYS_QuitAsyncIO_Generic();
+    use_io_uring = -1;
+}
+
+#endif /* SDL_ASYNCIO_IO_URING */
@@ -62,6 +62,18 @@ int SDL_CreateDirectory(const char *path)
     return SDL_SYS_CreateDirectory(path);
 }
 
+typedef struct EnumerateDirectoryData
+{
+    SDL_EnumerateDirectoryCallback callback;
+    void *userdata;
+} EnumerateDirectoryData;
+
+static int EnumerateDirectoryCallback(void *userdata, const char *dirname, const char *fname, SDL_PathType type)
+{
+    EnumerateDirectoryData *data = (EnumerateDirectoryData *) userdata;
+    return data->callback(data->userdata, dirname, fname);
+}
+
 int SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback callback, void *userdata)
 {
     if (!path) {
@@ -69,7 +81,11 @@ int SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback call
     } else if (!callback) {
         return SDL_InvalidParamError("callback");
     }
-    return (SDL_SYS_EnumerateDirectory(path, path, callback, userdata) < 0) ? -1 : 0;
+
+    EnumerateDirectoryData data;
+    data.callback = callback;
+    data.userdata = userdata;
+    return (SDL_SYS_EnumerateDirectory(path, path, EnumerateDirectoryCallback, &data) < 0) ? -1 : 0;
 }
 
 int SDL_GetPathInfo(const char *path, SDL_PathInfo *info)
@@ -239,9 +255,71 @@ typedef struct GlobDirCallbackData
     void *fsuserdata;
     size_t basedirlen;
     SDL_IOStream *string_stream;
+    char *path;  // the full path of the current entry; we push and pop names on the end of this as we walk the tree.
+    size_t pathlen;
+    size_t pathalloc;
+    char *folded;  // the casefolded path of the current entry relative to the base directory, for SDL_GLOB_CASEINSENSITIVE.
+    size_t foldedlen;
+    size_t foldedalloc;
 } GlobDirCallbackData;
 
-static int SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, const char *fname)
+static int GlobGrowBuffer(char **buffer, size_t *allocation, size_t needed)
+{
+    if (needed > *allocation) {
+        const size_t newalloc = SDL_max(needed, *allocation * 2);
+        char *ptr = (char *) SDL_realloc(*buffer, newalloc);
+        if (!ptr) {
+            return -1;
+        }
+        *buffer = ptr;
+        *allocation = newalloc;
+    }
+    return 0;
+}
+
+// Append "/fname" to the current path, and the casefolded name to the folded one if we need that.
+static int GlobPushPath(GlobDirCallbackData *data, const char *fname)
+{
+    const size_t fnamelen = SDL_strlen(fname);
+
+    if (GlobGrowBuffer(&data->path, &data->pathalloc, data->pathlen + fnamelen + 2) < 0) {
+        return -1;
+    }
+    data->path[data->pathlen++] = '/';
+    SDL_memcpy(data->path + data->pathlen, fname, fnamelen + 1);
+    data->pathlen += fnamelen;
+
+    if (data->flags & SDL_GLOB_CASEINSENSITIVE) {
+        // each byte of UTF-8 can fold to at most 3 codepoints of 4 bytes each (see CaseFoldUtf8String).
+        if (GlobGrowBuffer(&data->folded, &data->foldedalloc, data->foldedlen + (fnamelen * 3 * 4) + 2) < 0) {
+            return -1;
+        }
+        char *ptr = data->folded + data->foldedlen;
+        size_t remaining = data->foldedalloc - data->foldedlen;
+        if (data->foldedlen > 0) {
+            *(ptr++) = '/';
+            remaining--;
+        }
+        Uint32 codepoint;
+        while ((codepoint = SDL_StepUTF8(&fname, NULL)) != 0) {
+            Uint32 folded[3];
+            const int num_folded = SDL_CaseFoldUnicode(codepoint, folded);
+            for (int i = 0; i < num_folded; i++) {
+                const size_t rc = EncodeCodepointToUtf8(ptr, folded[i], remaining);
+                SDL_assert(rc > 0);
+                SDL_assert(rc < remaining);
+                remaining -= rc;
+                ptr += rc;
+            }
+        }
+        *ptr = '\0';
+        data->foldedlen = (size_t) (ptr - data->folded);
+    }
+
+    return 0;
+}
+
+static int GlobDirectoryCallback(void *userdata, const char *dirname, const char *fname, SDL_PathType type)
 {
     SDL_assert(userdata != NULL);
     SDL_assert(dirname != NULL);
@@ -251,49 +329,53 @@ static int SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, co
 
     GlobDirCallbackData *data = (GlobDirCallbackData *) userdata;
 
-    // !!! FIXME: if we're careful, we can keep a single buffer in `data` that we push and pop paths off the end of as we walk the tree,
-    // !!! FIXME: and only casefold the new pieces instead of allocating and folding full paths for all of this.
-
-    char *fullpath = NULL;
-    if (SDL_asprintf(&fullpath, "%s/%s", dirname, fname) < 0) {
+    // The walk is depth first, so data->path holds `dirname` every time we get here.
+    const size_t pathlen = data->pathlen;
+    const size_t foldedlen = data->foldedlen;
+    if (GlobPushPath(data, fname) < 0) {
         return -1;
     }
 
-    char *folded = NULL;
-    if (data->flags & SDL_GLOB_CASEINSENSITIVE) {
-        folded = CaseFoldUtf8String(fullpath);
-        if (!folded) {
-            return -1;
-        }
-    }
-
+    const char *subpath = data->path + data->basedirlen;
     SDL_bool matched_to_dir = SDL_FALSE;
-    const SDL_bool matched = data->matcher(data->pattern, (folded ? folded : fullpath) + data->basedirlen, &matched_to_dir);
-    //SDL_Log("GlobDirectoryCallback: Considered %spath='%s' vs pattern='%s': %smatched (matched_to_dir=%s)", folded ? "(folded) " : "", (folded ? folded : fullpath) + data->basedirlen, data->pattern, matched ? "" : "NOT ", matched_to_dir ? "TRUE" : "FALSE");
-    SDL_free(folded);
+    const SDL_bool matched = data->matcher(data->pattern, (data->flags & SDL_GLOB_CASEINSENSITIVE) ? data->folded : subpath, &matched_to_dir);
+    //SDL_Log("GlobDirectoryCallback: Considered path='%s' vs pattern='%s': %smatched (matched_to_dir=%s)", subpath, data->pattern, matched ? "" : "NOT ", matched_to_dir ? "TRUE" : "FALSE");
 
+    int retval = 1;  // keep enumerating by default.
     if (matched) {
-        const char *subpath = fullpath + data->basedirlen;
-        const size_t slen = SDL_strlen(subpath) + 1;
+        const size_t slen = (data->pathlen - data->basedirlen) + 1;
         if (SDL_WriteIO(data->string_stream, subpath, slen) != slen) {
-            SDL_free(fullpath);
-            return -1;  // stop enumerating, return failure to the app.
+            retval = -1;  // stop enumerating, return failure to the app.
+        } else {
+            data->num_entries++;
         }
-        data->num_entries++;
     }
 
-    int retval = 1;  // keep enumerating by default.
-    if (matched_to_dir) {
-        SDL_PathInfo info;
-        if ((data->getpathinfo(fullpath, &info, data->fsuserdata) == 0) && (info.type == SDL_PATHTYPE_DIRECTORY)) {
+    if ((retval == 1) && matched_to_dir) {
+        // Most platforms tell us the type with the directory listing, so we only stat when they don't.
+        if (type == SDL_PATHTYPE_NONE) {
+            SDL_PathInfo info;
+            if (data->getpathinfo(data->path, &info, data->fsuserdata) == 0) {
+                type = info.type;
+            }
+        }
+        if (type == SDL_PATHTYPE_DIRECTORY) {
             //SDL_Log("GlobDirectoryCallback: Descending into subdir '%s'", fname);
-            if (data->enumerator(fullpath, GlobDirectoryCallback, data, data->fsuserdata) < 0) {
+            // the enumerator might hold on to the path it was given while we grow data->path, so give it a copy.
+            char *subdir = SDL_strdup(data->path);
+            if (!subdir || (data->enumerator(subdir, GlobDirectoryCallback, data, data->fsuserdata) < 0)) {
                 retval = -1;
             }
+            SDL_free(subdir);
         }
     }
 
-    SDL_free(fullpath);
+    data->pathlen = pathlen;
+    data->path[pathlen] = '\0';
+    if (data->folded) {
+        data->foldedlen = foldedlen;
+        data->folded[foldedlen] = '\0';
+    }
 
     return retval;
 }
@@ -366,6 +448,16 @@ char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_Glob
     data.getpathinfo = getpathinfo;
     data.fsuserdata = userdata;
     data.basedirlen = SDL_strlen(path) + 1;  // +1 for the '/' we'll be adding.
+    data.pathlen = data.basedirlen - 1;
+    data.pathalloc = data.basedirlen + 256;
+    data.path = (char *) SDL_malloc(data.pathalloc);
+    if (!data.path) {
+        SDL_CloseIO(data.string_stream);
+        SDL_free(folded);
+        SDL_free(pathcpy);
+        return NULL;
+    }
+    SDL_memcpy(data.path, path, data.pathlen + 1);
 
     char **retval = NULL;
     if (data.enumerator(path, GlobDirectoryCallback, &data, data.fsuserdata) == 0) {
@@ -390,6 +482,8 @@ char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_Glob
     }
 
     SDL_CloseIO(data.string_stream);
+    SDL_free(data.folded);
+    SDL_free(data.path);
     SDL_free(folded);
     SDL_free(pathcpy);
 
@@ -401,9 +495,9 @@ static int GlobDirectoryGetPathInfo(const char *path, SDL_PathInfo *info, void *
     return SDL_GetPathInfo(path, info);
 }
 
-static int GlobDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
+static int GlobDirectoryEnumerator(const char *path, SDL_SYS_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
 {
-    return SDL_EnumerateDirectory(path, cb, cbuserdata);
+    return (SDL_SYS_EnumerateDirectory(path, path, cb, cbuserdata) < 0) ? -1 : 0;
 }
 
 char **SDL_GlobDirectory(const char *path, const char *pattern, SDL_GlobFlags flags, int *count)
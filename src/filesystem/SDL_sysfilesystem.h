@@ -27,14 +27,18 @@ extern char *SDL_SYS_GetBasePath(void);
 extern char *SDL_SYS_GetPrefPath(const char *org, const char *app);
 extern char *SDL_SYS_GetUserFolder(SDL_Folder folder);
 
-int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_EnumerateDirectoryCallback cb, void *userdata);
+// Like SDL_EnumerateDirectoryCallback, but also gets the type of the entry when the platform hands it out
+// with the directory listing for free. `type` is SDL_PATHTYPE_NONE when it isn't known without a stat.
+typedef int (*SDL_SYS_EnumerateDirectoryCallback)(void *userdata, const char *dirname, const char *fname, SDL_PathType type);
+
+int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_SYS_EnumerateDirectoryCallback cb, void *userdata);
 int SDL_SYS_RemovePath(const char *path);
 int SDL_SYS_RenamePath(const char *oldpath, const char *newpath);
 int SDL_SYS_CopyFile(const char *oldpath, const char *newpath);
 int SDL_SYS_CreateDirectory(const char *path);
 int SDL_SYS_GetPathInfo(const char *path, SDL_PathInfo *info);
 
-typedef int (*SDL_GlobEnumeratorFunc)(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata);
+typedef int (*SDL_GlobEnumeratorFunc)(const char *path, SDL_SYS_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata);
 typedef int (*SDL_GlobGetPathInfoFunc)(const char *path, SDL_PathInfo *info, void *userdata);
 char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_GlobFlags flags, int *count, SDL_GlobEnumeratorFunc enumerator, SDL_GlobGetPathInfoFunc getpathinfo, void *userdata);
 
@@ -28,7 +28,7 @@
 
 #include "../SDL_sysfilesystem.h"
 
-int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_EnumerateDirectoryCallback cb, void *userdata)
+int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_SYS_EnumerateDirectoryCallback cb, void *userdata)
 {
     return SDL_Unsupported();
 }
@@ -34,7 +34,7 @@
 #include <dirent.h>
 #include <sys/stat.h>
 
-int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_EnumerateDirectoryCallback cb, void *userdata)
+int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_SYS_EnumerateDirectoryCallback cb, void *userdata)
 {
     int retval = 1;
 
@@ -50,7 +50,17 @@ int SDL_SYS_EnumerateDirectory(const char *path, const char *dirname, SDL_Enumer
         if ((SDL_strcmp(name, ".") == 0) || (SDL_strcmp(name, "..") == 0)) {
             continue;
         }
-        retval = cb(userdata, dirname, name);
+
+        SDL_PathType type = SDL_PATHTYPE_NONE;
+#ifdef DT_DIR
+        // Symlinks and DT_UNKNOWN (some filesystems never fill d_type in) are left for the caller to stat.
+        if (ent->d_type == DT_REG) {
+            type = SDL_PATHTYPE_FILE;
+        } else if (ent->d_type == DT_DIR) {
+            type = SDL_PATHTYPE_DIRECTORY;
+        }
+#endif
+        retval = cb(userdata, dirname, name, type);
     }
 
     closedir(dir);
@@ -25,6 +25,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <locale.h>
+#include <time.h>
 #include <errno.h>
 
 /* Unix */
@@ -35,6 +36,7 @@
 #include <sys/utsname.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <pthread.h>
 
 /* Linux */
 #include <linux/hidraw.h>
@@ -72,12 +74,34 @@
 #define HIDIOCGINPUT(len)    _IOC(_IOC_WRITE|_IOC_READ, 'H', 0x0A, len)
 #endif
 
+/* Input reports are read by a thread per device into a single producer,
+   single consumer ring, so polling with a zero timeout never enters the
+   kernel. Each record is a 4 byte length followed by the report, padded to
+   4 bytes. A record that would straddle the end of the ring is replaced by
+   a wrap marker and written at the start instead. */
+#define INPUT_RING_SIZE   65536
+#define INPUT_REPORT_MAX  4096 /* HID_MAX_BUFFER_SIZE in the kernel */
+#define INPUT_RING_WRAP   0xFFFFFFFFu
+#define INPUT_RECORD_SIZE(len) (4 + (((len) + 3) & ~3u))
+
 struct hid_device_ {
 	int device_handle;
 	int blocking;
 	int needs_ble_hack;
 	wchar_t *last_error_str;
 	struct hid_device_info* device_info;
+
+	/* Reader thread, started by the first hid_read_timeout() */
+	int reader_started;
+	pthread_t reader;
+	int wakeup_pipe[2];
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+	unsigned char *input_ring;
+	unsigned int input_head; /* written by the reader thread only */
+	unsigned int input_tail; /* written by hid_read_timeout() only */
+	int waiting;             /* readers blocked on condition */
+	int read_errno;          /* set by the reader thread when it stops */
 };
 
 static struct hid_api_version api_version = {
@@ -98,6 +122,8 @@ static hid_device *new_hid_device(void)
 
 	dev->device_handle = -1;
 	dev->blocking = 1;
+	dev->wakeup_pipe[0] = -1;
+	dev->wakeup_pipe[1] = -1;
 	dev->last_error_str = NULL;
 	dev->device_info = NULL;
 
@@ -972,11 +998,105 @@ int HID_API_EXPORT hid_init(void)
 	return 0;
 }
 
+/* Cache of the device info built for each hidraw node, keyed by the sysfs
+   path of the node. The path contains the instance number of the HID device
+   (e.g. .../0003:046D:C52B.0005/hidraw/hidraw3), so a different device that
+   takes over the same hidraw node gets a new path and entries can't go stale.
+   This lets a rescan skip the report descriptor and string attribute reads
+   for every device that was already seen. */
+struct hid_enumeration_cache_entry {
+	char *sysfs_path;
+	unsigned bus_type;
+	unsigned short vendor_id;
+	unsigned short product_id;
+	unsigned short usage_page;
+	unsigned short usage;
+	struct hid_device_info *info;
+	struct timespec created;
+	int seen;
+	struct hid_enumeration_cache_entry *next;
+};
+
+/* Some devices, Bluetooth ones in particular, only get their serial number a
+   little after they appear, keep re-reading those for a while. */
+#define HID_ENUMERATION_CACHE_SETTLE_MS 5000
+
+static int enumeration_cache_entry_is_settled(const struct hid_enumeration_cache_entry *entry)
+{
+	struct timespec now;
+	long long age_ms;
+
+	if (!entry->info)
+		return 0;
+
+	if (entry->info->serial_number && *entry->info->serial_number)
+		return 1;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	age_ms = (long long)(now.tv_sec - entry->created.tv_sec) * 1000 +
+	         (now.tv_nsec - entry->created.tv_nsec) / 1000000;
+	return age_ms >= HID_ENUMERATION_CACHE_SETTLE_MS;
+}
+
+static pthread_mutex_t hid_enumeration_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct hid_enumeration_cache_entry *hid_enumeration_cache = NULL;
+
+static void free_enumeration_cache_entry(struct hid_enumeration_cache_entry *entry)
+{
+	hid_free_enumeration(entry->info);
+	free(entry->sysfs_path);
+	free(entry);
+}
+
+static void clear_enumeration_cache(void)
+{
+	pthread_mutex_lock(&hid_enumeration_cache_mutex);
+	while (hid_enumeration_cache) {
+		struct hid_enumeration_cache_entry *next = hid_enumeration_cache->next;
+		free_enumeration_cache_entry(hid_enumeration_cache);
+		hid_enumeration_cache = next;
+	}
+	pthread_mutex_unlock(&hid_enumeration_cache_mutex);
+}
+
+/* Returns a copy of the device info list, with *last set to its final element */
+static struct hid_device_info *copy_device_info_list(const struct hid_device_info *src, struct hid_device_info **last)
+{
+	struct hid_device_info *root = NULL;
+	struct hid_device_info *cur_dev = NULL;
+
+	for (; src; src = src->next) {
+		struct hid_device_info *tmp = (struct hid_device_info*) malloc(sizeof(struct hid_device_info));
+		if (!tmp)
+			break;
+
+		*tmp = *src;
+		tmp->path = src->path? strdup(src->path): NULL;
+		tmp->serial_number = src->serial_number? wcsdup(src->serial_number): NULL;
+		tmp->manufacturer_string = src->manufacturer_string? wcsdup(src->manufacturer_string): NULL;
+		tmp->product_string = src->product_string? wcsdup(src->product_string): NULL;
+		tmp->next = NULL;
+
+		if (cur_dev) {
+			cur_dev->next = tmp;
+		}
+		else {
+			root = tmp;
+		}
+		cur_dev = tmp;
+	}
+
+	*last = cur_dev;
+	return root;
+}
+
 int HID_API_EXPORT hid_exit(void)
 {
 	/* Free global error message */
 	register_global_error(NULL);
 
+	clear_enumeration_cache();
+
 	return 0;
 }
 
@@ -1004,15 +1124,18 @@ struct hid_device_info  HID_API_EXPORT *hid_enumerate(unsigned short vendor_id,
 	udev_enumerate_add_match_subsystem(enumerate, "hidraw");
 	udev_enumerate_scan_devices(enumerate);
 	devices = udev_enumerate_get_list_entry(enumerate);
+	pthread_mutex_lock(&hid_enumeration_cache_mutex);
+	for (struct hid_enumeration_cache_entry *entry = hid_enumeration_cache; entry; entry = entry->next) {
+		entry->seen = 0;
+	}
+
 	/* For each item, see if it matches the vid/pid, and if so
 	   create a udev_device record for it */
 	udev_list_entry_foreach(dev_list_entry, devices) {
 		const char *sysfs_path;
-		unsigned short dev_vid = 0;
-		unsigned short dev_pid = 0;
-		unsigned bus_type = 0;
 		struct udev_device *raw_dev; /* The device's hidraw udev node. */
-		struct hid_device_info * tmp;
+		struct hid_enumeration_cache_entry *entry;
+		struct hid_device_info *tmp, *last;
 
 		/* Get the filename of the /sys entry for the device
 		   and create a udev_device object (dev) representing it */
@@ -1020,38 +1143,75 @@ struct hid_device_info  HID_API_EXPORT *hid_enumerate(unsigned short vendor_id,
 		if (!sysfs_path)
 			continue;
 
+		for (entry = hid_enumeration_cache; entry; entry = entry->next) {
+			if (strcmp(entry->sysfs_path, sysfs_path) == 0)
+				break;
+		}
+
+		if (!entry) {
+			entry = (struct hid_enumeration_cache_entry*) calloc(1, sizeof(struct hid_enumeration_cache_entry));
+			if (!entry)
+				continue;
+			entry->sysfs_path = strdup(sysfs_path);
+			if (!entry->sysfs_path) {
+				free(entry);
+				continue;
+			}
+
+			if (!parse_hid_vid_pid_from_sysfs(sysfs_path, &entry->bus_type, &entry->vendor_id, &entry->product_id)) {
+				/* Not a HID device, remember that too */
+				entry->vendor_id = 0;
+				entry->product_id = 0;
+			}
+
+#ifdef HIDAPI_IGNORE_DEVICE
+			{
+				struct hidraw_report_descriptor report_desc;
+				if (get_hid_report_descriptor_from_sysfs(sysfs_path, &report_desc) >= 0) {
+					struct hid_usage_iterator usage_iterator;
+					memset(&usage_iterator, 0, sizeof(usage_iterator));
+					get_next_hid_usage(report_desc.value, report_desc.size, &usage_iterator, &entry->usage_page, &entry->usage);
+				}
+			}
+#endif
+
+			clock_gettime(CLOCK_MONOTONIC, &entry->created);
+			entry->next = hid_enumeration_cache;
+			hid_enumeration_cache = entry;
+		}
+		entry->seen = 1;
+
+		if (!enumeration_cache_entry_is_settled(entry)) {
+			raw_dev = udev_device_new_from_syspath(udev, sysfs_path);
+			if (!raw_dev)
+				continue;
+
+			hid_free_enumeration(entry->info);
+			entry->info = create_device_info_for_device(raw_dev);
+			udev_device_unref(raw_dev);
+		}
+
 		if (vendor_id != 0 || product_id != 0) {
-			if (!parse_hid_vid_pid_from_sysfs(sysfs_path, &bus_type, &dev_vid, &dev_pid))
+			if (entry->vendor_id == 0 && entry->product_id == 0)
 				continue;
 
-			if (vendor_id != 0 && vendor_id != dev_vid)
+			if (vendor_id != 0 && vendor_id != entry->vendor_id)
 				continue;
-			if (product_id != 0 && product_id != dev_pid)
+			if (product_id != 0 && product_id != entry->product_id)
 				continue;
 		}
 
 #ifdef HIDAPI_IGNORE_DEVICE
 		/* See if there are any devices we should skip in enumeration */
-		if (!parse_hid_vid_pid_from_sysfs(sysfs_path, &bus_type, &dev_vid, &dev_pid))
+		if (entry->vendor_id == 0 && entry->product_id == 0)
 			continue;
 
-		struct hidraw_report_descriptor report_desc;
-		unsigned short page = 0, usage = 0;
-		if (get_hid_report_descriptor_from_sysfs(sysfs_path, &report_desc) >= 0) {
-			struct hid_usage_iterator usage_iterator;
-			memset(&usage_iterator, 0, sizeof(usage_iterator));
-			get_next_hid_usage(report_desc.value, report_desc.size, &usage_iterator, &page, &usage);
-		}
-		if (HIDAPI_IGNORE_DEVICE(bus_type, dev_vid, dev_pid, page, usage)) {
+		if (HIDAPI_IGNORE_DEVICE(entry->bus_type, entry->vendor_id, entry->product_id, entry->usage_page, entry->usage)) {
 			continue;
 		}
 #endif
 
-		raw_dev = udev_device_new_from_syspath(udev, sysfs_path);
-		if (!raw_dev)
-			continue;
-
-		tmp = create_device_info_for_device(raw_dev);
+		tmp = copy_device_info_list(entry->info, &last);
 		if (tmp) {
 			if (cur_dev) {
 				cur_dev->next = tmp;
@@ -1059,16 +1219,27 @@ struct hid_device_info  HID_API_EXPORT *hid_enumerate(unsigned short vendor_id,
 			else {
 				root = tmp;
 			}
-			cur_dev = tmp;
 
 			/* move the pointer to the tail of returned list */
-			while (cur_dev->next != NULL) {
-				cur_dev = cur_dev->next;
-			}
+			cur_dev = last;
 		}
+	}
 
-		udev_device_unref(raw_dev);
+	/* Drop the devices that have gone away */
+	{
+		struct hid_enumeration_cache_entry **link = &hid_enumeration_cache;
+		while (*link) {
+			struct hid_enumeration_cache_entry *entry = *link;
+			if (!entry->seen) {
+				*link = entry->next;
+				free_enumeration_cache_entry(entry);
+			} else {
+				link = &entry->next;
+			}
+		}
 	}
+	pthread_mutex_unlock(&hid_enumeration_cache_mutex);
+
 	/* Free the enumerator and udev objects. */
 	udev_enumerate_unref(enumerate);
 	udev_unref(udev);
@@ -1208,54 +1379,254 @@ int HID_API_EXPORT hid_write(hid_device *dev, const unsigned char *data, size_t
 }
 
 
+static void wake_input_waiters(hid_device *dev)
+{
+	if (__atomic_load_n(&dev->waiting, __ATOMIC_SEQ_CST) > 0) {
+		pthread_mutex_lock(&dev->mutex);
+		pthread_cond_broadcast(&dev->condition);
+		pthread_mutex_unlock(&dev->mutex);
+	}
+}
+
+/* Returns 0 if there wasn't room for the report */
+static int push_input_report(hid_device *dev, const unsigned char *data, unsigned int length)
+{
+	const unsigned int head = dev->input_head;
+	const unsigned int tail = __atomic_load_n(&dev->input_tail, __ATOMIC_ACQUIRE);
+	const unsigned int offset = head & (INPUT_RING_SIZE - 1);
+	const unsigned int contiguous = INPUT_RING_SIZE - offset;
+	const unsigned int needed = INPUT_RECORD_SIZE(length);
+	unsigned int available = INPUT_RING_SIZE - (head - tail);
+	unsigned int skip = 0;
+
+	if (contiguous < needed) {
+		skip = contiguous;
+	}
+	if (available < skip + needed) {
+		return 0;
+	}
+
+	if (skip) {
+		const unsigned int marker = INPUT_RING_WRAP;
+		memcpy(&dev->input_ring[offset], &marker, sizeof(marker));
+	}
+	memcpy(&dev->input_ring[(head + skip) & (INPUT_RING_SIZE - 1)], &length, sizeof(length));
+	memcpy(&dev->input_ring[((head + skip) & (INPUT_RING_SIZE - 1)) + 4], data, length);
+	__atomic_store_n(&dev->input_head, head + skip + needed, __ATOMIC_SEQ_CST);
+	return 1;
+}
+
+/* Returns -1 if the ring is empty */
+static int pop_input_report(hid_device *dev, unsigned char *data, size_t length)
+{
+	unsigned int tail = dev->input_tail;
+
+	while (tail != __atomic_load_n(&dev->input_head, __ATOMIC_ACQUIRE)) {
+		const unsigned int offset = tail & (INPUT_RING_SIZE - 1);
+		unsigned int report_length;
+
+		memcpy(&report_length, &dev->input_ring[offset], sizeof(report_length));
+		if (report_length == INPUT_RING_WRAP) {
+			tail += INPUT_RING_SIZE - offset;
+			continue;
+		}
+
+		if (length > report_length) {
+			length = report_length;
+		}
+		memcpy(data, &dev->input_ring[offset + 4], length);
+		__atomic_store_n(&dev->input_tail, tail + INPUT_RECORD_SIZE(report_length), __ATOMIC_RELEASE);
+		return (int)length;
+	}
+	return -1;
+}
+
+static void *read_reports_thread(void *param)
+{
+	hid_device *dev = (hid_device *)param;
+	unsigned char buffer[INPUT_REPORT_MAX];
+	struct pollfd fds[2];
+	int error = 0;
+
+	fds[0].fd = dev->device_handle;
+	fds[0].events = POLLIN;
+	fds[1].fd = dev->wakeup_pipe[0];
+	fds[1].events = POLLIN;
+
+	for (;;) {
+		int ret, bytes_read;
+
+		fds[0].revents = 0;
+		fds[1].revents = 0;
+		ret = poll(fds, 2, -1);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			error = errno;
+			break;
+		}
+		if (fds[1].revents) {
+			/* hid_close() */
+			break;
+		}
+		if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			/* Don't rely on read() reporting disconnection, some kernels don't */
+			error = ENODEV;
+			break;
+		}
+
+		bytes_read = read(dev->device_handle, buffer, sizeof(buffer));
+		if (bytes_read < 0) {
+			if (errno == EAGAIN || errno == EINPROGRESS || errno == EINTR) {
+				continue;
+			}
+			error = errno;
+			break;
+		}
+
+		/* If the application isn't keeping up, wait for it rather than dropping reports */
+		while (!push_input_report(dev, buffer, (unsigned int)bytes_read)) {
+			wake_input_waiters(dev);
+			if (poll(&fds[1], 1, 1) > 0) {
+				goto done;
+			}
+		}
+		wake_input_waiters(dev);
+	}
+
+done:
+	__atomic_store_n(&dev->read_errno, error ? error : EBADF, __ATOMIC_SEQ_CST);
+	wake_input_waiters(dev);
+	return NULL;
+}
+
+static int start_read_reports_thread(hid_device *dev)
+{
+	pthread_condattr_t attr;
+
+	dev->input_ring = (unsigned char *)malloc(INPUT_RING_SIZE);
+	if (!dev->input_ring) {
+		register_device_error(dev, "Couldn't allocate memory");
+		return -1;
+	}
+	if (pipe(dev->wakeup_pipe) < 0) {
+		register_device_error(dev, strerror(errno));
+		free(dev->input_ring);
+		dev->input_ring = NULL;
+		return -1;
+	}
+
+	fcntl(dev->wakeup_pipe[0], F_SETFD, FD_CLOEXEC);
+	fcntl(dev->wakeup_pipe[1], F_SETFD, FD_CLOEXEC);
+
+	pthread_mutex_init(&dev->mutex, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&dev->condition, &attr);
+	pthread_condattr_destroy(&attr);
+
+	if (pthread_create(&dev->reader, NULL, read_reports_thread, dev) != 0) {
+		register_device_error(dev, "Couldn't create read thread");
+		pthread_cond_destroy(&dev->condition);
+		pthread_mutex_destroy(&dev->mutex);
+		close(dev->wakeup_pipe[0]);
+		close(dev->wakeup_pipe[1]);
+		dev->wakeup_pipe[0] = -1;
+		dev->wakeup_pipe[1] = -1;
+		free(dev->input_ring);
+		dev->input_ring = NULL;
+		return -1;
+	}
+	dev->reader_started = 1;
+	return 0;
+}
+
+static void stop_read_reports_thread(hid_device *dev)
+{
+	if (!dev->reader_started) {
+		return;
+	}
+
+	while (write(dev->wakeup_pipe[1], "", 1) < 0 && errno == EINTR) {
+	}
+	pthread_join(dev->reader, NULL);
+	dev->reader_started = 0;
+
+	pthread_cond_destroy(&dev->condition);
+	pthread_mutex_destroy(&dev->mutex);
+	close(dev->wakeup_pipe[0]);
+	close(dev->wakeup_pipe[1]);
+	free(dev->input_ring);
+	dev->input_ring = NULL;
+}
+
 int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t length, int milliseconds)
 {
+	struct timespec deadline;
+	int bytes_read;
+
 	/* Set device error to none */
 	register_device_error(dev, NULL);
 
-	int bytes_read;
+	if (!dev->reader_started && start_read_reports_thread(dev) < 0) {
+		return -1;
+	}
 
-	if (milliseconds >= 0) {
-		/* Milliseconds is either 0 (non-blocking) or > 0 (contains
-		   a valid timeout). In both cases we want to call poll()
-		   and wait for data to arrive.  Don't rely on non-blocking
-		   operation (O_NONBLOCK) since some kernels don't seem to
-		   properly report device disconnection through read() when
-		   in non-blocking mode.  */
-		int ret;
-		struct pollfd fds;
-
-		fds.fd = dev->device_handle;
-		fds.events = POLLIN;
-		fds.revents = 0;
-		ret = poll(&fds, 1, milliseconds);
-		if (ret == 0) {
-			/* Timeout */
-			return ret;
+	/* The common case, polling from the joystick update, is just a couple of loads */
+	bytes_read = pop_input_report(dev, data, length);
+	if (bytes_read >= 0) {
+		return bytes_read;
+	}
+	if (__atomic_load_n(&dev->read_errno, __ATOMIC_SEQ_CST)) {
+		/* Pick up anything queued before the thread stopped */
+		bytes_read = pop_input_report(dev, data, length);
+		if (bytes_read < 0) {
+			register_device_error(dev, "hid_read_timeout: unexpected poll error (device disconnected)");
 		}
-		if (ret == -1) {
-			/* Error */
-			register_device_error(dev, strerror(errno));
-			return ret;
+		return bytes_read;
+	}
+	if (milliseconds == 0) {
+		return 0;
+	}
+
+	if (milliseconds > 0) {
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_sec += milliseconds / 1000;
+		deadline.tv_nsec += (milliseconds % 1000) * 1000000L;
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
 		}
-		else {
-			/* Check for errors on the file descriptor. This will
-			   indicate a device disconnection. */
-			if (fds.revents & (POLLERR | POLLHUP | POLLNVAL)) {
-				// We cannot use strerror() here as no -1 was returned from poll().
+	}
+
+	pthread_mutex_lock(&dev->mutex);
+	__atomic_add_fetch(&dev->waiting, 1, __ATOMIC_SEQ_CST);
+	for (;;) {
+		bytes_read = pop_input_report(dev, data, length);
+		if (bytes_read >= 0) {
+			break;
+		}
+		if (__atomic_load_n(&dev->read_errno, __ATOMIC_SEQ_CST)) {
+			/* Pick up anything queued before the thread stopped */
+			bytes_read = pop_input_report(dev, data, length);
+			if (bytes_read < 0) {
 				register_device_error(dev, "hid_read_timeout: unexpected poll error (device disconnected)");
-				return -1;
 			}
+			break;
+		}
+		if (milliseconds < 0) {
+			pthread_cond_wait(&dev->condition, &dev->mutex);
+		} else if (pthread_cond_timedwait(&dev->condition, &dev->mutex, &deadline) == ETIMEDOUT) {
+			bytes_read = pop_input_report(dev, data, length);
+			if (bytes_read < 0) {
+				bytes_read = 0;
+			}
+			break;
 		}
 	}
-
-	bytes_read = read(dev->device_handle, data, length);
-	if (bytes_read < 0) {
-		if (errno == EAGAIN || errno == EINPROGRESS)
-			bytes_read = 0;
-		else
-			register_device_error(dev, strerror(errno));
-	}
+	__atomic_sub_fetch(&dev->waiting, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&dev->mutex);
 
 	return bytes_read;
 }
@@ -1343,6 +1714,8 @@ void HID_API_EXPORT hid_close(hid_device *dev)
 	if (!dev)
 		return;
 
+	stop_read_reports_thread(dev);
+
 	close(dev->device_handle);
 
 	/* Free the device error message */
@@ -83,6 +83,7 @@ typedef struct GamepadMapping_t
     char *name _guarded;
     char *mapping _guarded;
     SDL_GamepadMappingPriority priority _guarded;
+    Uint32 order _guarded; /* Position in s_pSupportedGamepads, earlier mappings win ties */
     struct GamepadMapping_t *next _guarded;
 } GamepadMapping_t;
 
@@ -101,6 +102,9 @@ typedef struct
 
 static SDL_GUID s_zeroGUID;
 static GamepadMapping_t *s_pSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static GamepadMapping_t *s_pSupportedGamepadsTail SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static Uint32 s_supportedGamepadsCount SDL_GUARDED_BY(SDL_joystick_lock) = 0;
+static SDL_HashTable *s_gamepadMappingsByGUID SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pDefaultMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pXInputMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static MappingChangeTracker *s_mappingChangeTracker SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
@@ -865,12 +869,40 @@ static GamepadMapping_t *SDL_CreateMappingForWGIGamepad(SDL_GUID guid)
     return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 
+/* The mappings are indexed by GUID without the version and CRC, so a lookup
+   finds every candidate for both the versioned and unversioned match. */
+static SDL_GUID SDL_GetGamepadMappingIndexGUID(const SDL_GUID *guid)
+{
+    SDL_GUID index_guid = *guid;
+
+    SDL_SetJoystickGUIDVersion(&index_guid, 0);
+    SDL_SetJoystickGUIDCRC(&index_guid, 0);
+    return index_guid;
+}
+
+static Uint32 SDL_HashGamepadMappingGUID(const void *key, void *unused)
+{
+    const SDL_GUID index_guid = SDL_GetGamepadMappingIndexGUID((const SDL_GUID *)key);
+
+    return SDL_crc32(0, &index_guid, sizeof(index_guid));
+}
+
+static SDL_bool SDL_KeyMatchGamepadMappingGUID(const void *a, const void *b, void *unused)
+{
+    const SDL_GUID guid_a = SDL_GetGamepadMappingIndexGUID((const SDL_GUID *)a);
+    const SDL_GUID guid_b = SDL_GetGamepadMappingIndexGUID((const SDL_GUID *)b);
+
+    return (SDL_memcmp(&guid_a, &guid_b, sizeof(guid_a)) == 0);
+}
+
 /*
  * Helper function to scan the mappings database for a gamepad with the specified GUID
  */
 static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_GUID guid, SDL_bool match_version)
 {
-    GamepadMapping_t *mapping, *best_match = NULL;
+    GamepadMapping_t *mapping, *best_match = NULL, *crc_match = NULL;
+    const void *value;
+    void *iter = NULL;
     Uint16 crc = 0;
 
     SDL_AssertJoysticksLocked();
@@ -884,9 +916,16 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_GUID guid, SD
         SDL_SetJoystickGUIDVersion(&guid, 0);
     }
 
-    for (mapping = s_pSupportedGamepads; mapping; mapping = mapping->next) {
+    if (!s_gamepadMappingsByGUID) {
+        return NULL;
+    }
+
+    /* Candidates come out of the index in no particular order, pick the first
+       one in s_pSupportedGamepads order like a scan of the list would. */
+    while (SDL_IterateHashTableKey(s_gamepadMappingsByGUID, &guid, &value, &iter)) {
         SDL_GUID mapping_guid;
 
+        mapping = (GamepadMapping_t *)value;
         if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
             continue;
         }
@@ -906,15 +945,18 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_GUID guid, SD
                 }
 
                 /* An exact match, including CRC */
-                return mapping;
+                if (!crc_match || mapping->order < crc_match->order) {
+                    crc_match = mapping;
+                }
+                continue;
             }
 
-            if (!best_match) {
+            if (!best_match || mapping->order < best_match->order) {
                 best_match = mapping;
             }
         }
     }
-    return best_match;
+    return crc_match ? crc_match : best_match;
 }
 
 /*
@@ -1630,20 +1672,28 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_GUID jGUID, const char
         pGamepadMapping->mapping = pchMapping;
         pGamepadMapping->next = NULL;
         pGamepadMapping->priority = priority;
+        pGamepadMapping->order = s_supportedGamepadsCount;
 
-        if (s_pSupportedGamepads) {
-            /* Add the mapping to the end of the list */
-            GamepadMapping_t *pCurrMapping, *pPrevMapping;
+        if (!s_gamepadMappingsByGUID) {
+            s_gamepadMappingsByGUID = SDL_CreateHashTable(NULL, 256, SDL_HashGamepadMappingGUID, SDL_KeyMatchGamepadMappingGUID, NULL, SDL_TRUE);
+        }
+        if (!s_gamepadMappingsByGUID ||
+            !SDL_InsertIntoHashTable(s_gamepadMappingsByGUID, &pGamepadMapping->guid, pGamepadMapping)) {
+            PopMappingChangeTracking();
+            SDL_free(pchName);
+            SDL_free(pchMapping);
+            SDL_free(pGamepadMapping);
+            return NULL;
+        }
 
-            for (pPrevMapping = s_pSupportedGamepads, pCurrMapping = pPrevMapping->next;
-                 pCurrMapping;
-                 pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next) {
-                /* continue; */
-            }
-            pPrevMapping->next = pGamepadMapping;
+        /* Add the mapping to the end of the list */
+        if (s_pSupportedGamepadsTail) {
+            s_pSupportedGamepadsTail->next = pGamepadMapping;
         } else {
             s_pSupportedGamepads = pGamepadMapping;
         }
+        s_pSupportedGamepadsTail = pGamepadMapping;
+        ++s_supportedGamepadsCount;
         if (existing) {
             *existing = SDL_FALSE;
         }
@@ -3273,6 +3323,50 @@ int SDL_GetGamepadSensorData(SDL_Gamepad *gamepad, SDL_SensorType type, float *d
     return SDL_Unsupported();
 }
 
+int SDL_GetGamepadSensorDataBatch(SDL_Gamepad *gamepad, SDL_SensorType type, SDL_GamepadSensorSample *samples, int num_samples)
+{
+    if (!samples && num_samples > 0) {
+        return SDL_InvalidParamError("samples");
+    }
+
+    SDL_LockJoysticks();
+    {
+        SDL_Joystick *joystick = SDL_GetGamepadJoystick(gamepad);
+        if (joystick) {
+            int i;
+            for (i = 0; i < joystick->nsensors; ++i) {
+                SDL_JoystickSensorInfo *sensor = &joystick->sensors[i];
+
+                if (sensor->type == type) {
+                    int count = 0;
+
+                    if (!sensor->samples) {
+                        /* Start buffering, samples arrive with the next update */
+                        sensor->samples = (SDL_GamepadSensorSample *)SDL_calloc(SDL_JOYSTICK_SENSOR_SAMPLE_BUFFER_SIZE, sizeof(*sensor->samples));
+                        if (!sensor->samples) {
+                            SDL_UnlockJoysticks();
+                            return -1;
+                        }
+                        sensor->samples_head = 0;
+                        sensor->samples_count = 0;
+                    }
+
+                    while (count < num_samples && sensor->samples_count > 0) {
+                        samples[count++] = sensor->samples[sensor->samples_head];
+                        sensor->samples_head = (sensor->samples_head + 1) % SDL_JOYSTICK_SENSOR_SAMPLE_BUFFER_SIZE;
+                        --sensor->samples_count;
+                    }
+                    SDL_UnlockJoysticks();
+                    return count;
+                }
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return SDL_Unsupported();
+}
+
 SDL_JoystickID SDL_GetGamepadID(SDL_Gamepad *gamepad)
 {
     SDL_Joystick *joystick = SDL_GetGamepadJoystick(gamepad);
@@ -3695,6 +3789,11 @@ void SDL_QuitGamepadMappings(void)
 
     SDL_AssertJoysticksLocked();
 
+    if (s_gamepadMappingsByGUID) {
+        SDL_DestroyHashTable(s_gamepadMappingsByGUID);
+        s_gamepadMappingsByGUID = NULL;
+    }
+
     while (s_pSupportedGamepads) {
         pGamepadMap = s_pSupportedGamepads;
         s_pSupportedGamepads = s_pSupportedGamepads->next;
@@ -3702,6 +3801,8 @@ void SDL_QuitGamepadMappings(void)
         SDL_free(pGamepadMap->mapping);
         SDL_free(pGamepadMap);
     }
+    s_pSupportedGamepadsTail = NULL;
+    s_supportedGamepadsCount = 0;
 
     SDL_FreeVIDPIDList(&SDL_allowed_gamepads);
     SDL_FreeVIDPIDList(&SDL_ignored_gamepads);
@@ -122,6 +122,36 @@ static int SDL_joystick_player_count SDL_GUARDED_BY(SDL_joystick_lock) = 0;
 static SDL_JoystickID *SDL_joystick_players SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static SDL_bool SDL_joystick_allows_background_events = SDL_FALSE;
 
+/* The platforms where every joystick driver can be updated off the main thread.
+   Device detection stays on the main thread, it shares udev with evdev input. */
+#if defined(SDL_PLATFORM_LINUX) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_THREADS_DISABLED)
+#define SDL_JOYSTICK_UPDATE_THREAD
+#endif
+
+#ifdef SDL_JOYSTICK_UPDATE_THREAD
+/* How often the update thread reads pending reports, HID devices report at up to 1000 Hz */
+#define SDL_JOYSTICK_UPDATE_THREAD_INTERVAL_MS 1
+
+static SDL_Thread *SDL_joystick_update_thread;
+static SDL_Semaphore *SDL_joystick_update_thread_sem;
+static SDL_AtomicInt SDL_joystick_update_thread_running;
+
+static void SDL_StartJoystickUpdateThread(void);
+static void SDL_StopJoystickUpdateThread(void);
+#endif
+
+#ifndef SDL_THREADS_DISABLED
+/* Rumble is written to the device on a separate thread so slow driver calls don't block the application */
+#define SDL_JOYSTICK_RUMBLE_THREAD
+
+static SDL_Thread *SDL_joystick_rumble_thread;
+static SDL_Semaphore *SDL_joystick_rumble_thread_sem;
+static SDL_AtomicInt SDL_joystick_rumble_thread_running;
+
+static int SDL_StartJoystickRumbleThread(void);
+static void SDL_StopJoystickRumbleThread(void);
+#endif
+
 static Uint32 initial_arcadestick_devices[] = {
     MAKE_VIDPID(0x0079, 0x181a), /* Venom Arcade Stick */
     MAKE_VIDPID(0x0079, 0x181b), /* Venom Arcade Stick */
@@ -651,8 +681,15 @@ int SDL_InitJoysticks(void)
 
     if (status < 0) {
         SDL_QuitJoysticks();
+        return status;
     }
 
+#ifdef SDL_JOYSTICK_UPDATE_THREAD
+    if (SDL_GetHintBoolean(SDL_HINT_JOYSTICK_THREAD, SDL_FALSE)) {
+        SDL_StartJoystickUpdateThread();
+    }
+#endif
+
     return status;
 }
 
@@ -1546,6 +1583,162 @@ Uint8 SDL_GetJoystickButton(SDL_Joystick *joystick, int button)
     return state;
 }
 
+static SDL_JoystickSnapshotData *SDL_CreateJoystickSnapshot(SDL_Joystick *joystick)
+{
+    SDL_JoystickSnapshotData *snapshot;
+    Uint8 *data;
+    int i, nfingers = 0;
+
+    SDL_AssertJoysticksLocked();
+
+    for (i = 0; i < joystick->ntouchpads; ++i) {
+        nfingers += joystick->touchpads[i].nfingers;
+    }
+
+    /* Largest alignment first, so each array is aligned after the one before it */
+    snapshot = (SDL_JoystickSnapshotData *)SDL_calloc(1, sizeof(*snapshot) +
+                                                         nfingers * sizeof(*snapshot->fingers) +
+                                                         joystick->nsensors * sizeof(*snapshot->sensors) +
+                                                         joystick->naxes * sizeof(*snapshot->axes) +
+                                                         joystick->nbuttons * sizeof(*snapshot->buttons) +
+                                                         joystick->nhats * sizeof(*snapshot->hats));
+    if (!snapshot) {
+        return NULL;
+    }
+
+    data = (Uint8 *)(snapshot + 1);
+    snapshot->nfingers = nfingers;
+    snapshot->fingers = (SDL_JoystickTouchpadFingerState *)data;
+    data += nfingers * sizeof(*snapshot->fingers);
+    snapshot->nsensors = joystick->nsensors;
+    snapshot->sensors = (SDL_JoystickSensorState *)data;
+    data += joystick->nsensors * sizeof(*snapshot->sensors);
+    snapshot->naxes = joystick->naxes;
+    snapshot->axes = (Sint16 *)data;
+    data += joystick->naxes * sizeof(*snapshot->axes);
+    snapshot->nbuttons = joystick->nbuttons;
+    snapshot->buttons = data;
+    data += joystick->nbuttons * sizeof(*snapshot->buttons);
+    snapshot->nhats = joystick->nhats;
+    snapshot->hats = data;
+
+    return snapshot;
+}
+
+static void SDL_PublishJoystickSnapshot(SDL_Joystick *joystick)
+{
+    SDL_JoystickSnapshotData *snapshot = joystick->snapshot;
+    int i, j, finger = 0;
+
+    SDL_AssertJoysticksLocked();
+
+    if (!snapshot) {
+        return;
+    }
+
+    (void)SDL_AtomicAdd(&joystick->snapshot_sequence, 1);
+    SDL_MemoryBarrierRelease();
+
+    snapshot->timestamp = SDL_GetTicksNS();
+    for (i = 0; i < joystick->ntouchpads; ++i) {
+        const SDL_JoystickTouchpadInfo *touchpad = &joystick->touchpads[i];
+
+        for (j = 0; j < touchpad->nfingers && finger < snapshot->nfingers; ++j, ++finger) {
+            SDL_JoystickTouchpadFingerState *state = &snapshot->fingers[finger];
+
+            state->touchpad = i;
+            state->finger = j;
+            state->state = touchpad->fingers[j].state;
+            state->x = touchpad->fingers[j].x;
+            state->y = touchpad->fingers[j].y;
+            state->pressure = touchpad->fingers[j].pressure;
+        }
+    }
+    for (i = 0; i < snapshot->nsensors; ++i) {
+        snapshot->sensors[i].type = joystick->sensors[i].type;
+        snapshot->sensors[i].enabled = joystick->sensors[i].enabled;
+        SDL_memcpy(snapshot->sensors[i].data, joystick->sensors[i].data, sizeof(snapshot->sensors[i].data));
+    }
+    for (i = 0; i < snapshot->naxes; ++i) {
+        snapshot->axes[i] = joystick->axes[i].value;
+    }
+    SDL_memcpy(snapshot->buttons, joystick->buttons, snapshot->nbuttons);
+    SDL_memcpy(snapshot->hats, joystick->hats, snapshot->nhats);
+
+    SDL_MemoryBarrierRelease();
+    (void)SDL_AtomicAdd(&joystick->snapshot_sequence, 1);
+}
+
+int SDL_GetJoystickSnapshot(SDL_Joystick *joystick, SDL_JoystickSnapshot *snapshot)
+{
+    const SDL_JoystickSnapshotData *data;
+    int max_axes, max_buttons, max_hats, max_fingers, max_sensors;
+
+    if (!joystick) {
+        return SDL_InvalidParamError("joystick");
+    }
+    if (!snapshot) {
+        return SDL_InvalidParamError("snapshot");
+    }
+
+    data = (const SDL_JoystickSnapshotData *)SDL_AtomicGetPtr((void **)&joystick->snapshot);
+    if (!data) {
+        /* Set up the snapshot on first use, after that readers don't need the lock */
+        SDL_LockJoysticks();
+        {
+            CHECK_JOYSTICK_MAGIC(joystick, -1);
+
+            if (!joystick->snapshot) {
+                SDL_JoystickSnapshotData *new_snapshot = SDL_CreateJoystickSnapshot(joystick);
+                if (!new_snapshot) {
+                    SDL_UnlockJoysticks();
+                    return -1;
+                }
+                SDL_AtomicSetPtr((void **)&joystick->snapshot, new_snapshot);
+                SDL_PublishJoystickSnapshot(joystick);
+            }
+            data = joystick->snapshot;
+        }
+        SDL_UnlockJoysticks();
+    }
+
+    max_axes = snapshot->axes ? snapshot->num_axes : 0;
+    max_buttons = snapshot->buttons ? snapshot->num_buttons : 0;
+    max_hats = snapshot->hats ? snapshot->num_hats : 0;
+    max_fingers = snapshot->touchpad_fingers ? snapshot->num_touchpad_fingers : 0;
+    max_sensors = snapshot->sensors ? snapshot->num_sensors : 0;
+
+    snapshot->num_axes = SDL_clamp(data->naxes, 0, max_axes);
+    snapshot->num_buttons = SDL_clamp(data->nbuttons, 0, max_buttons);
+    snapshot->num_hats = SDL_clamp(data->nhats, 0, max_hats);
+    snapshot->num_touchpad_fingers = SDL_clamp(data->nfingers, 0, max_fingers);
+    snapshot->num_sensors = SDL_clamp(data->nsensors, 0, max_sensors);
+
+    for (;;) {
+        const int sequence = SDL_AtomicGet(&joystick->snapshot_sequence);
+
+        if (sequence & 1) {
+            /* The state is being published right now */
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        snapshot->timestamp = data->timestamp;
+        SDL_memcpy(snapshot->axes, data->axes, snapshot->num_axes * sizeof(*snapshot->axes));
+        SDL_memcpy(snapshot->buttons, data->buttons, snapshot->num_buttons * sizeof(*snapshot->buttons));
+        SDL_memcpy(snapshot->hats, data->hats, snapshot->num_hats * sizeof(*snapshot->hats));
+        SDL_memcpy(snapshot->touchpad_fingers, data->fingers, snapshot->num_touchpad_fingers * sizeof(*snapshot->touchpad_fingers));
+        SDL_memcpy(snapshot->sensors, data->sensors, snapshot->num_sensors * sizeof(*snapshot->sensors));
+
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&joystick->snapshot_sequence) == sequence) {
+            break;
+        }
+    }
+    return 0;
+}
+
 /*
  * Return if the joystick in question is currently attached to the system,
  *  \return SDL_FALSE if not plugged in, SDL_TRUE if still present.
@@ -1720,6 +1913,51 @@ int SDL_SetJoystickPlayerIndex(SDL_Joystick *joystick, int player_index)
     return 0;
 }
 
+#ifdef SDL_JOYSTICK_RUMBLE_THREAD
+static SDL_bool SDL_IsJoystickRumbleAsync(SDL_Joystick *joystick)
+{
+    SDL_AssertJoysticksLocked();
+
+    if (joystick->ref_count <= 0 || SDL_joysticks_quitting) {
+        /* The joystick is closing, send the final rumble state directly */
+        return SDL_FALSE;
+    }
+#ifdef SDL_JOYSTICK_HIDAPI
+    if (joystick->driver == &SDL_HIDAPI_JoystickDriver) {
+        /* HIDAPI already has its own rumble thread */
+        return SDL_FALSE;
+    }
+#endif
+#ifdef SDL_JOYSTICK_VIRTUAL
+    if (joystick->driver == &SDL_VIRTUAL_JoystickDriver) {
+        /* Application callbacks are called on the application thread */
+        return SDL_FALSE;
+    }
+#endif
+    return SDL_TRUE;
+}
+
+static int SDL_QueueJoystickRumble(SDL_Joystick *joystick, const char *capability, SDL_bool *pending)
+{
+    SDL_AssertJoysticksLocked();
+
+    if (!SDL_GetBooleanProperty(SDL_GetJoystickProperties(joystick), capability, SDL_FALSE)) {
+        return SDL_Unsupported();
+    }
+
+    if (!SDL_joystick_rumble_thread && SDL_StartJoystickRumbleThread() < 0) {
+        return -1;
+    }
+
+    /* The rumble thread sends the latest values, so rapid updates are coalesced */
+    if (!*pending) {
+        *pending = SDL_TRUE;
+        SDL_SignalSemaphore(SDL_joystick_rumble_thread_sem);
+    }
+    return 0;
+}
+#endif
+
 int SDL_RumbleJoystick(SDL_Joystick *joystick, Uint16 low_frequency_rumble, Uint16 high_frequency_rumble, Uint32 duration_ms)
 {
     int retval;
@@ -1733,7 +1971,15 @@ int SDL_RumbleJoystick(SDL_Joystick *joystick, Uint16 low_frequency_rumble, Uint
             /* Just update the expiration */
             retval = 0;
         } else {
-            retval = joystick->driver->Rumble(joystick, low_frequency_rumble, high_frequency_rumble);
+#ifdef SDL_JOYSTICK_RUMBLE_THREAD
+            if (SDL_IsJoystickRumbleAsync(joystick)) {
+                retval = SDL_QueueJoystickRumble(joystick, SDL_PROP_JOYSTICK_CAP_RUMBLE_BOOLEAN, &joystick->rumble_pending);
+            } else
+#endif
+            {
+                retval = joystick->driver->Rumble(joystick, low_frequency_rumble, high_frequency_rumble);
+                joystick->rumble_pending = SDL_FALSE;
+            }
             if (retval == 0) {
                 joystick->rumble_resend = SDL_GetTicks() + SDL_RUMBLE_RESEND_MS;
                 if (joystick->rumble_resend == 0) {
@@ -1776,7 +2022,15 @@ int SDL_RumbleJoystickTriggers(SDL_Joystick *joystick, Uint16 left_rumble, Uint1
             /* Just update the expiration */
             retval = 0;
         } else {
-            retval = joystick->driver->RumbleTriggers(joystick, left_rumble, right_rumble);
+#ifdef SDL_JOYSTICK_RUMBLE_THREAD
+            if (SDL_IsJoystickRumbleAsync(joystick)) {
+                retval = SDL_QueueJoystickRumble(joystick, SDL_PROP_JOYSTICK_CAP_TRIGGER_RUMBLE_BOOLEAN, &joystick->trigger_rumble_pending);
+            } else
+#endif
+            {
+                retval = joystick->driver->RumbleTriggers(joystick, left_rumble, right_rumble);
+                joystick->trigger_rumble_pending = SDL_FALSE;
+            }
         }
 
         if (retval == 0) {
@@ -1869,6 +2123,16 @@ void SDL_CloseJoystick(SDL_Joystick *joystick)
             SDL_RumbleJoystickTriggers(joystick, 0, 0, 0);
         }
 
+        /* Flush anything the rumble thread hasn't sent yet */
+        if (joystick->rumble_pending) {
+            joystick->driver->Rumble(joystick, joystick->low_frequency_rumble, joystick->high_frequency_rumble);
+            joystick->rumble_pending = SDL_FALSE;
+        }
+        if (joystick->trigger_rumble_pending) {
+            joystick->driver->RumbleTriggers(joystick, joystick->left_trigger_rumble, joystick->right_trigger_rumble);
+            joystick->trigger_rumble_pending = SDL_FALSE;
+        }
+
         CleanupSensorFusion(joystick);
 
         joystick->driver->Close(joystick);
@@ -1904,7 +2168,11 @@ void SDL_CloseJoystick(SDL_Joystick *joystick)
             SDL_free(touchpad->fingers);
         }
         SDL_free(joystick->touchpads);
+        for (i = 0; i < joystick->nsensors; i++) {
+            SDL_free(joystick->sensors[i].samples);
+        }
         SDL_free(joystick->sensors);
+        SDL_free(joystick->snapshot);
         SDL_free(joystick);
     }
     SDL_UnlockJoysticks();
@@ -1915,6 +2183,14 @@ void SDL_QuitJoysticks(void)
     int i;
     SDL_JoystickID *joysticks;
 
+#ifdef SDL_JOYSTICK_UPDATE_THREAD
+    /* This has to happen before locking, the thread may be waiting on the lock */
+    SDL_StopJoystickUpdateThread();
+#endif
+#ifdef SDL_JOYSTICK_RUMBLE_THREAD
+    SDL_StopJoystickRumbleThread();
+#endif
+
     SDL_LockJoysticks();
 
     SDL_joysticks_quitting = SDL_TRUE;
@@ -2392,21 +2668,13 @@ static void SendSteamHandleUpdateEvents(void)
     }
 }
 
-void SDL_UpdateJoysticks(void)
+/* Read the pending input from every open device and send the resulting events */
+static void SDL_UpdateOpenJoysticks(void)
 {
-    int i;
     Uint64 now;
     SDL_Joystick *joystick;
 
-    if (!SDL_WasInit(SDL_INIT_JOYSTICK)) {
-        return;
-    }
-
-    SDL_LockJoysticks();
-
-    if (SDL_UpdateSteamVirtualGamepadInfo()) {
-        SendSteamHandleUpdateEvents();
-    }
+    SDL_AssertJoysticksLocked();
 
 #ifdef SDL_JOYSTICK_HIDAPI
     /* Special function for HIDAPI devices, as a single device can provide multiple SDL_Joysticks */
@@ -2424,6 +2692,8 @@ void SDL_UpdateJoysticks(void)
             SDL_GamepadHandleDelayedGuideButton(joystick);
         }
 
+        SDL_PublishJoystickSnapshot(joystick);
+
         now = SDL_GetTicks();
         if (joystick->rumble_expiration && now >= joystick->rumble_expiration) {
             SDL_RumbleJoystick(joystick, 0, 0, 0);
@@ -2431,7 +2701,14 @@ void SDL_UpdateJoysticks(void)
         }
 
         if (joystick->rumble_resend && now >= joystick->rumble_resend) {
-            joystick->driver->Rumble(joystick, joystick->low_frequency_rumble, joystick->high_frequency_rumble);
+#ifdef SDL_JOYSTICK_RUMBLE_THREAD
+            if (SDL_IsJoystickRumbleAsync(joystick)) {
+                SDL_QueueJoystickRumble(joystick, SDL_PROP_JOYSTICK_CAP_RUMBLE_BOOLEAN, &joystick->rumble_pending);
+            } else
+#endif
+            {
+                joystick->driver->Rumble(joystick, joystick->low_frequency_rumble, joystick->high_frequency_rumble);
+            }
             joystick->rumble_resend = now + SDL_RUMBLE_RESEND_MS;
             if (joystick->rumble_resend == 0) {
                 joystick->rumble_resend = 1;
@@ -2457,6 +2734,156 @@ void SDL_UpdateJoysticks(void)
             }
         }
     }
+}
+
+#ifdef SDL_JOYSTICK_UPDATE_THREAD
+static int SDLCALL SDL_JoystickUpdateThread(void *data)
+{
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (SDL_AtomicGet(&SDL_joystick_update_thread_running)) {
+        SDL_LockJoysticks();
+        SDL_UpdateOpenJoysticks();
+        SDL_UnlockJoysticks();
+
+        /* The semaphore is only signaled to wake us up for shutdown */
+        SDL_WaitSemaphoreTimeout(SDL_joystick_update_thread_sem, SDL_JOYSTICK_UPDATE_THREAD_INTERVAL_MS);
+    }
+    return 0;
+}
+
+static void SDL_StartJoystickUpdateThread(void)
+{
+    SDL_joystick_update_thread_sem = SDL_CreateSemaphore(0);
+    if (!SDL_joystick_update_thread_sem) {
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_joystick_update_thread_running, SDL_TRUE);
+    SDL_joystick_update_thread = SDL_CreateThread(SDL_JoystickUpdateThread, "SDL joystick update", NULL);
+    if (!SDL_joystick_update_thread) {
+        /* Fall back to updating joysticks from SDL_UpdateJoysticks() */
+        SDL_AtomicSet(&SDL_joystick_update_thread_running, SDL_FALSE);
+        SDL_DestroySemaphore(SDL_joystick_update_thread_sem);
+        SDL_joystick_update_thread_sem = NULL;
+    }
+}
+
+static void SDL_StopJoystickUpdateThread(void)
+{
+    if (SDL_joystick_update_thread) {
+        SDL_AtomicSet(&SDL_joystick_update_thread_running, SDL_FALSE);
+        SDL_SignalSemaphore(SDL_joystick_update_thread_sem);
+        SDL_WaitThread(SDL_joystick_update_thread, NULL);
+        SDL_joystick_update_thread = NULL;
+    }
+    if (SDL_joystick_update_thread_sem) {
+        SDL_DestroySemaphore(SDL_joystick_update_thread_sem);
+        SDL_joystick_update_thread_sem = NULL;
+    }
+}
+#endif /* SDL_JOYSTICK_UPDATE_THREAD */
+
+#ifdef SDL_JOYSTICK_RUMBLE_THREAD
+static int SDLCALL SDL_JoystickRumbleThread(void *data)
+{
+    Sint32 timeout = -1;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (SDL_AtomicGet(&SDL_joystick_rumble_thread_running)) {
+        SDL_Joystick *joystick;
+
+        SDL_WaitSemaphoreTimeout(SDL_joystick_rumble_thread_sem, timeout);
+        timeout = -1;
+
+        SDL_LockJoysticks();
+        for (joystick = SDL_joysticks; joystick; joystick = joystick->next) {
+            Uint64 now;
+
+            if (!joystick->rumble_pending && !joystick->trigger_rumble_pending) {
+                continue;
+            }
+
+            /* Limit how often we write to each device, the pending values keep being updated meanwhile */
+            now = SDL_GetTicks();
+            if (now < joystick->rumble_sent + SDL_RUMBLE_MIN_INTERVAL_MS) {
+                Sint32 delay = (Sint32)(joystick->rumble_sent + SDL_RUMBLE_MIN_INTERVAL_MS - now);
+                if (timeout < 0 || delay < timeout) {
+                    timeout = delay;
+                }
+                continue;
+            }
+
+            if (joystick->rumble_pending) {
+                joystick->rumble_pending = SDL_FALSE;
+                if (joystick->driver->Rumble(joystick, joystick->low_frequency_rumble, joystick->high_frequency_rumble) < 0) {
+                    joystick->rumble_resend = 0;
+                }
+            }
+            if (joystick->trigger_rumble_pending) {
+                joystick->trigger_rumble_pending = SDL_FALSE;
+                joystick->driver->RumbleTriggers(joystick, joystick->left_trigger_rumble, joystick->right_trigger_rumble);
+            }
+            joystick->rumble_sent = now;
+        }
+        SDL_UnlockJoysticks();
+    }
+    return 0;
+}
+
+static int SDL_StartJoystickRumbleThread(void)
+{
+    SDL_joystick_rumble_thread_sem = SDL_CreateSemaphore(0);
+    if (!SDL_joystick_rumble_thread_sem) {
+        return -1;
+    }
+
+    SDL_AtomicSet(&SDL_joystick_rumble_thread_running, SDL_TRUE);
+    SDL_joystick_rumble_thread = SDL_CreateThread(SDL_JoystickRumbleThread, "SDL joystick rumble", NULL);
+    if (!SDL_joystick_rumble_thread) {
+        SDL_AtomicSet(&SDL_joystick_rumble_thread_running, SDL_FALSE);
+        SDL_DestroySemaphore(SDL_joystick_rumble_thread_sem);
+        SDL_joystick_rumble_thread_sem = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static void SDL_StopJoystickRumbleThread(void)
+{
+    if (SDL_joystick_rumble_thread) {
+        SDL_AtomicSet(&SDL_joystick_rumble_thread_running, SDL_FALSE);
+        SDL_SignalSemaphore(SDL_joystick_rumble_thread_sem);
+        SDL_WaitThread(SDL_joystick_rumble_thread, NULL);
+        SDL_joystick_rumble_thread = NULL;
+    }
+    if (SDL_joystick_rumble_thread_sem) {
+        SDL_DestroySemaphore(SDL_joystick_rumble_thread_sem);
+        SDL_joystick_rumble_thread_sem = NULL;
+    }
+}
+#endif /* SDL_JOYSTICK_RUMBLE_THREAD */
+
+void SDL_UpdateJoysticks(void)
+{
+    int i;
+
+    if (!SDL_WasInit(SDL_INIT_JOYSTICK)) {
+        return;
+    }
+
+    SDL_TRACE_BEGIN("SDL_UpdateJoysticks");
+    SDL_LockJoysticks();
+
+    if (SDL_UpdateSteamVirtualGamepadInfo()) {
+        SendSteamHandleUpdateEvents();
+    }
+
+    /* This is still done with the update thread running, so the joystick state
+       is current after an explicit update, e.g. for virtual joysticks. Most of
+       the time the thread has already drained the pending input. */
+    SDL_UpdateOpenJoysticks();
 
     /* this needs to happen AFTER walking the joystick list above, so that any
        dangling hardware data from removed devices can be free'd
@@ -2466,6 +2893,7 @@ void SDL_UpdateJoysticks(void)
     }
 
     SDL_UnlockJoysticks();
+    SDL_TRACE_END();
 }
 
 static const Uint32 SDL_joystick_event_list[] = {
@@ -3638,6 +4066,22 @@ int SDL_SendJoystickSensor(Uint64 timestamp, SDL_Joystick *joystick, SDL_SensorT
                 SDL_memcpy(sensor->data, data, num_values * sizeof(*data));
                 joystick->update_complete = timestamp;
 
+                if (sensor->samples) {
+                    SDL_GamepadSensorSample *sample;
+
+                    if (sensor->samples_count == SDL_JOYSTICK_SENSOR_SAMPLE_BUFFER_SIZE) {
+                        /* Drop the oldest sample */
+                        sensor->samples_head = (sensor->samples_head + 1) % SDL_JOYSTICK_SENSOR_SAMPLE_BUFFER_SIZE;
+                        --sensor->samples_count;
+                    }
+                    sample = &sensor->samples[(sensor->samples_head + sensor->samples_count) % SDL_JOYSTICK_SENSOR_SAMPLE_BUFFER_SIZE];
+                    sample->timestamp = timestamp;
+                    sample->sensor_timestamp = sensor_timestamp;
+                    SDL_zeroa(sample->data);
+                    SDL_memcpy(sample->data, data, num_values * sizeof(*data));
+                    ++sensor->samples_count;
+                }
+
                 /* Post the event, if desired */
                 if (SDL_EventEnabled(SDL_EVENT_GAMEPAD_SENSOR_UPDATE)) {
                     SDL_Event event;
@@ -70,8 +70,31 @@ typedef struct SDL_JoystickSensorInfo
     SDL_bool enabled;
     float rate;
     float data[3]; /* If this needs to expand, update SDL_GamepadSensorEvent */
+
+    /* Ring buffer for SDL_GetGamepadSensorDataBatch(), allocated on first use */
+    SDL_GamepadSensorSample *samples;
+    int samples_head;
+    int samples_count;
 } SDL_JoystickSensorInfo;
 
+#define SDL_JOYSTICK_SENSOR_SAMPLE_BUFFER_SIZE 256
+
+/* The published copy of the joystick state for SDL_GetJoystickSnapshot(), allocated as one block */
+typedef struct SDL_JoystickSnapshotData
+{
+    Uint64 timestamp;
+    int nfingers;
+    SDL_JoystickTouchpadFingerState *fingers;
+    int nsensors;
+    SDL_JoystickSensorState *sensors;
+    int naxes;
+    Sint16 *axes;
+    int nbuttons;
+    Uint8 *buttons;
+    int nhats;
+    Uint8 *hats;
+} SDL_JoystickSnapshotData;
+
 #define _guarded SDL_GUARDED_BY(SDL_joystick_lock)
 
 struct SDL_Joystick
@@ -112,6 +135,10 @@ struct SDL_Joystick
     Uint16 right_trigger_rumble _guarded;
     Uint64 trigger_rumble_expiration _guarded;
 
+    SDL_bool rumble_pending _guarded;         /* Waiting for the rumble thread to send the motor values */
+    SDL_bool trigger_rumble_pending _guarded; /* Waiting for the rumble thread to send the trigger values */
+    Uint64 rumble_sent _guarded;              /* When the rumble thread last wrote to the device */
+
     Uint8 led_red _guarded;
     Uint8 led_green _guarded;
     Uint8 led_blue _guarded;
@@ -132,6 +159,10 @@ struct SDL_Joystick
 
     Uint64 update_complete _guarded;
 
+    /* Written with the joystick lock held and read without it, the sequence is odd while it's being written */
+    SDL_AtomicInt snapshot_sequence;
+    SDL_JoystickSnapshotData *snapshot;
+
     struct SDL_JoystickDriver *driver _guarded;
 
     struct joystick_hwdata *hwdata _guarded; /* Driver dependent information */
@@ -237,6 +268,9 @@ typedef struct SDL_JoystickDriver
  * to make long rumble work. */
 #define SDL_RUMBLE_RESEND_MS 2000
 
+/* Minimum time between rumble writes to a device from the rumble thread, newer requests replace older ones */
+#define SDL_RUMBLE_MIN_INTERVAL_MS 10
+
 #define SDL_LED_MIN_REPEAT_MS 5000
 
 /* The available joystick drivers */
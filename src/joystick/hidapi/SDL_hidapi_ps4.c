@@ -179,6 +179,7 @@ typedef struct
     Uint64 sensor_ticks;
     Uint16 last_tick;
     Uint16 valid_crc_packets; /* wrapping counter */
+    SDL_bool has_last_state;
     PS4StatePacket_t last_state;
 } SDL_DriverPS4_Context;
 
@@ -853,6 +854,7 @@ static SDL_bool HIDAPI_DriverPS4_OpenJoystick(SDL_HIDAPI_Device *device, SDL_Joy
     ctx->rumble_left = 0;
     ctx->rumble_right = 0;
     ctx->color_set = SDL_FALSE;
+    ctx->has_last_state = SDL_FALSE;
     SDL_zero(ctx->last_state);
 
     /* Initialize player index (needed for setting LEDs) */
@@ -1013,6 +1015,7 @@ static void HIDAPI_DriverPS4_HandleStatePacket(SDL_Joystick *joystick, SDL_hid_d
     Uint8 touchpad_state;
     int touchpad_x, touchpad_y;
     Uint64 timestamp = SDL_GetTicksNS();
+    const PS4StatePacket_t *last_state = ctx->has_last_state ? &ctx->last_state : NULL;
 
     if (ctx->last_state.rgucButtonsHatAndCounter[0] != packet->rgucButtonsHatAndCounter[0]) {
         {
@@ -1087,18 +1090,23 @@ static void HIDAPI_DriverPS4_HandleStatePacket(SDL_Joystick *joystick, SDL_hid_d
         SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_PS4_TOUCHPAD, (data & 0x02) ? SDL_PRESSED : SDL_RELEASED);
     }
 
-    axis = ((int)packet->ucTriggerLeft * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
-    axis = ((int)packet->ucTriggerRight * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
-    axis = ((int)packet->ucLeftJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-    axis = ((int)packet->ucLeftJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
-    axis = ((int)packet->ucRightJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-    axis = ((int)packet->ucRightJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
+    /* Only send the axes if their bytes in the report changed */
+    if (HIDAPI_ReportFieldChanged(last_state, packet, 7, 2)) { /* ucTriggerLeft and ucTriggerRight */
+        axis = ((int)packet->ucTriggerLeft * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
+        axis = ((int)packet->ucTriggerRight * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
+    }
+    if (HIDAPI_ReportFieldChanged(last_state, packet, 0, 4)) { /* ucLeftJoystickX to ucRightJoystickY */
+        axis = ((int)packet->ucLeftJoystickX * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
+        axis = ((int)packet->ucLeftJoystickY * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
+        axis = ((int)packet->ucRightJoystickX * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
+        axis = ((int)packet->ucRightJoystickY * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
+    }
 
     if (size > 9 && ctx->report_battery && ctx->enhanced_reports) {
         SDL_PowerState state;
@@ -1165,6 +1173,7 @@ static void HIDAPI_DriverPS4_HandleStatePacket(SDL_Joystick *joystick, SDL_hid_d
     }
 
     SDL_memcpy(&ctx->last_state, packet, sizeof(ctx->last_state));
+    ctx->has_last_state = SDL_TRUE;
 }
 
 static SDL_bool VerifyCRC(Uint8 *data, int size)
@@ -262,6 +262,7 @@ typedef struct
     EDS5LEDResetState led_reset_state;
     Uint64 sensor_ticks;
     Uint32 last_tick;
+    SDL_bool has_last_state;
     union
     {
         PS5SimpleStatePacket_t simple;
@@ -944,6 +945,7 @@ static SDL_bool HIDAPI_DriverPS5_OpenJoystick(SDL_HIDAPI_Device *device, SDL_Joy
     ctx->rumble_right = 0;
     ctx->color_set = SDL_FALSE;
     ctx->led_reset_state = k_EDS5LEDResetStateNone;
+    ctx->has_last_state = SDL_FALSE;
     SDL_zero(ctx->last_state);
 
     /* Initialize player index (needed for setting LEDs) */
@@ -1219,10 +1221,12 @@ static void HIDAPI_DriverPS5_HandleSimpleStatePacket(SDL_Joystick *joystick, SDL
     SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
 
     SDL_memcpy(&ctx->last_state.simple, packet, sizeof(ctx->last_state.simple));
+    ctx->has_last_state = SDL_FALSE; /* The simple report has a different layout */
 }
 
 static void HIDAPI_DriverPS5_HandleStatePacketCommon(SDL_Joystick *joystick, SDL_hid_device *dev, SDL_DriverPS5_Context *ctx, PS5StatePacketCommon_t *packet, Uint64 timestamp)
 {
+    const PS5StatePacketCommon_t *last_state = ctx->has_last_state ? &ctx->last_state.state : NULL;
     Sint16 axis;
 
     if (ctx->last_state.state.rgucButtonsAndHat[0] != packet->rgucButtonsAndHat[0]) {
@@ -1294,26 +1298,32 @@ static void HIDAPI_DriverPS5_HandleStatePacketCommon(SDL_Joystick *joystick, SDL
         SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_PS5_RIGHT_PADDLE, (data & 0x80) ? SDL_PRESSED : SDL_RELEASED);
     }
 
-    if (packet->ucTriggerLeft == 0 && (packet->rgucButtonsAndHat[1] & 0x04)) {
-        axis = SDL_JOYSTICK_AXIS_MAX;
-    } else {
-        axis = ((int)packet->ucTriggerLeft * 257) - 32768;
+    /* Only send the axes if their bytes in the report changed, the digital trigger bits are in rgucButtonsAndHat[1] */
+    if (HIDAPI_ReportFieldChanged(last_state, packet, 4, 2) || /* ucTriggerLeft and ucTriggerRight */
+        HIDAPI_ReportFieldChanged(last_state, packet, 8, 1)) {
+        if (packet->ucTriggerLeft == 0 && (packet->rgucButtonsAndHat[1] & 0x04)) {
+            axis = SDL_JOYSTICK_AXIS_MAX;
+        } else {
+            axis = ((int)packet->ucTriggerLeft * 257) - 32768;
+        }
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
+        if (packet->ucTriggerRight == 0 && (packet->rgucButtonsAndHat[1] & 0x08)) {
+            axis = SDL_JOYSTICK_AXIS_MAX;
+        } else {
+            axis = ((int)packet->ucTriggerRight * 257) - 32768;
+        }
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
     }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
-    if (packet->ucTriggerRight == 0 && (packet->rgucButtonsAndHat[1] & 0x08)) {
-        axis = SDL_JOYSTICK_AXIS_MAX;
-    } else {
-        axis = ((int)packet->ucTriggerRight * 257) - 32768;
+    if (HIDAPI_ReportFieldChanged(last_state, packet, 0, 4)) { /* ucLeftJoystickX to ucRightJoystickY */
+        axis = ((int)packet->ucLeftJoystickX * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
+        axis = ((int)packet->ucLeftJoystickY * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
+        axis = ((int)packet->ucRightJoystickX * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
+        axis = ((int)packet->ucRightJoystickY * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
     }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
-    axis = ((int)packet->ucLeftJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-    axis = ((int)packet->ucLeftJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
-    axis = ((int)packet->ucRightJoystickX * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-    axis = ((int)packet->ucRightJoystickY * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
 
     if (ctx->report_sensors) {
         Uint64 sensor_timestamp;
@@ -1412,6 +1422,7 @@ static void HIDAPI_DriverPS5_HandleStatePacket(SDL_Joystick *joystick, SDL_hid_d
     }
 
     SDL_memcpy(&ctx->last_state, packet, sizeof(ctx->last_state));
+    ctx->has_last_state = SDL_TRUE;
 }
 
 static void HIDAPI_DriverPS5_HandleStatePacketAlt(SDL_Joystick *joystick, SDL_hid_device *dev, SDL_DriverPS5_Context *ctx, PS5StatePacketAlt_t *packet, Uint64 timestamp)
@@ -1434,6 +1445,7 @@ static void HIDAPI_DriverPS5_HandleStatePacketAlt(SDL_Joystick *joystick, SDL_hi
     }
 
     SDL_memcpy(&ctx->last_state, packet, sizeof(ctx->last_state));
+    ctx->has_last_state = SDL_TRUE;
 }
 
 static SDL_bool VerifyCRC(Uint8 *data, int size)
@@ -38,6 +38,7 @@ typedef struct
     SDL_Joystick *joystick;
     int player_index;
     SDL_bool player_lights;
+    SDL_bool has_last_state;
     Uint8 last_state[USB_PACKET_LENGTH];
 } SDL_DriverXbox360_Context;
 
@@ -177,6 +178,7 @@ static SDL_bool HIDAPI_DriverXbox360_OpenJoystick(SDL_HIDAPI_Device *device, SDL
     SDL_AssertJoysticksLocked();
 
     ctx->joystick = joystick;
+    ctx->has_last_state = SDL_FALSE;
     SDL_zeroa(ctx->last_state);
 
     /* Initialize player index (needed for setting LEDs) */
@@ -307,26 +309,29 @@ static void HIDAPI_DriverXbox360_HandleStatePacket(SDL_Joystick *joystick, SDL_D
         SDL_SendJoystickButton(timestamp, joystick, SDL_GAMEPAD_BUTTON_NORTH, (data[3] & 0x80) ? SDL_PRESSED : SDL_RELEASED);
     }
 
-    axis = ((int)data[4] * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
-    axis = ((int)data[5] * 257) - 32768;
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
-    axis = SDL_Swap16LE(*(Sint16 *)(&data[6]));
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
-    axis = SDL_Swap16LE(*(Sint16 *)(&data[8]));
-    if (invert_y_axes) {
-        axis = ~axis;
-    }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
-    axis = SDL_Swap16LE(*(Sint16 *)(&data[10]));
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
-    axis = SDL_Swap16LE(*(Sint16 *)(&data[12]));
-    if (invert_y_axes) {
-        axis = ~axis;
+    if (HIDAPI_ReportFieldChanged(ctx->has_last_state ? ctx->last_state : NULL, data, 4, 10)) {
+        axis = ((int)data[4] * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFT_TRIGGER, axis);
+        axis = ((int)data[5] * 257) - 32768;
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, axis);
+        axis = SDL_Swap16LE(*(Sint16 *)(&data[6]));
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTX, axis);
+        axis = SDL_Swap16LE(*(Sint16 *)(&data[8]));
+        if (invert_y_axes) {
+            axis = ~axis;
+        }
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_LEFTY, axis);
+        axis = SDL_Swap16LE(*(Sint16 *)(&data[10]));
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTX, axis);
+        axis = SDL_Swap16LE(*(Sint16 *)(&data[12]));
+        if (invert_y_axes) {
+            axis = ~axis;
+        }
+        SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
     }
-    SDL_SendJoystickAxis(timestamp, joystick, SDL_GAMEPAD_AXIS_RIGHTY, axis);
 
     SDL_memcpy(ctx->last_state, data, SDL_min((size_t)size, sizeof(ctx->last_state)));
+    ctx->has_last_state = SDL_TRUE;
 }
 
 static SDL_bool HIDAPI_DriverXbox360_UpdateDevice(SDL_HIDAPI_Device *device)
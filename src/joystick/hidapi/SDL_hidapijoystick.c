@@ -137,6 +137,14 @@ void HIDAPI_DumpPacket(const char *prefix, const Uint8 *data, int size)
     SDL_free(buffer);
 }
 
+SDL_bool HIDAPI_ReportFieldChanged(const void *last_report, const void *report, size_t offset, size_t size)
+{
+    if (!last_report) {
+        return SDL_TRUE;
+    }
+    return SDL_memcmp((const Uint8 *)last_report + offset, (const Uint8 *)report + offset, size) != 0;
+}
+
 SDL_bool HIDAPI_SupportsPlaystationDetection(Uint16 vendor, Uint16 product)
 {
     /* If we already know the controller is a different type, don't try to detect it.
@@ -450,9 +458,14 @@ static void HIDAPI_SetupDeviceDriver(SDL_HIDAPI_Device *device, SDL_bool *remove
         /* We might have a device driver for this device, try opening it and see */
         if (device->num_children == 0) {
             SDL_hid_device *dev;
+            Uint64 now = SDL_GetTicksNS();
 
-            /* Wait a little bit for the device to initialize */
-            SDL_Delay(10);
+            /* Wait a little bit for the device to initialize.
+             * Devices that arrive together settle at the same time, so this only waits once for all of them.
+             */
+            if (now < device->settle_time) {
+                SDL_DelayNS(device->settle_time - now);
+            }
 
 #ifdef SDL_PLATFORM_ANDROID
             /* On Android we need to leave joysticks unlocked because it calls
@@ -913,11 +926,11 @@ static int HIDAPI_JoystickGetCount(void)
     return SDL_HIDAPI_numjoysticks;
 }
 
-static SDL_HIDAPI_Device *HIDAPI_AddDevice(const struct SDL_hid_device_info *info, int num_children, SDL_HIDAPI_Device **children)
+/* Create a device and add it to the list, without opening it */
+static SDL_HIDAPI_Device *HIDAPI_CreateDevice(const struct SDL_hid_device_info *info, int num_children, SDL_HIDAPI_Device **children)
 {
     SDL_HIDAPI_Device *device;
     SDL_HIDAPI_Device *curr, *last = NULL;
-    SDL_bool removed;
     Uint16 bus;
 
     SDL_AssertJoysticksLocked();
@@ -936,6 +949,7 @@ static SDL_HIDAPI_Device *HIDAPI_AddDevice(const struct SDL_hid_device_info *inf
         return NULL;
     }
     device->seen = SDL_TRUE;
+    device->settle_time = SDL_GetTicksNS() + SDL_MS_TO_NS(10);
     device->vendor_id = info->vendor_id;
     device->product_id = info->product_id;
     device->version = info->release_number;
@@ -997,8 +1011,14 @@ static SDL_HIDAPI_Device *HIDAPI_AddDevice(const struct SDL_hid_device_info *inf
     } else {
         SDL_HIDAPI_devices = device;
     }
+    return device;
+}
+
+/* Find a driver for a device created by HIDAPI_CreateDevice(), opening and initializing it */
+static SDL_HIDAPI_Device *HIDAPI_SetupDevice(SDL_HIDAPI_Device *device)
+{
+    SDL_bool removed = SDL_FALSE;
 
-    removed = SDL_FALSE;
     HIDAPI_SetupDeviceDriver(device, &removed);
     if (removed) {
         return NULL;
@@ -1011,6 +1031,15 @@ static SDL_HIDAPI_Device *HIDAPI_AddDevice(const struct SDL_hid_device_info *inf
     return device;
 }
 
+static SDL_HIDAPI_Device *HIDAPI_AddDevice(const struct SDL_hid_device_info *info, int num_children, SDL_HIDAPI_Device **children)
+{
+    SDL_HIDAPI_Device *device = HIDAPI_CreateDevice(info, num_children, children);
+    if (!device) {
+        return NULL;
+    }
+    return HIDAPI_SetupDevice(device);
+}
+
 static void HIDAPI_DelDevice(SDL_HIDAPI_Device *device)
 {
     SDL_HIDAPI_Device *curr, *last;
@@ -1131,6 +1160,8 @@ static void HIDAPI_UpdateDeviceList(void)
 {
     SDL_HIDAPI_Device *device;
     struct SDL_hid_device_info *devs, *info;
+    SDL_HIDAPI_Device **added = NULL;
+    int num_added = 0;
 
     SDL_LockJoysticks();
 
@@ -1161,13 +1192,32 @@ static void HIDAPI_UpdateDeviceList(void)
                         HIDAPI_SetDeviceSerialW(device, info->serial_number);
                     }
                 } else {
-                    HIDAPI_AddDevice(info, 0, NULL);
+                    /* Create all the new devices before setting any of them up, so they settle together */
+                    SDL_HIDAPI_Device **new_added = (SDL_HIDAPI_Device **)SDL_realloc(added, (num_added + 1) * sizeof(*added));
+                    if (new_added) {
+                        added = new_added;
+                        device = HIDAPI_CreateDevice(info, 0, NULL);
+                        if (device) {
+                            added[num_added++] = device;
+                        }
+                    }
                 }
             }
             SDL_hid_free_enumeration(devs);
         }
     }
 
+    for (int i = 0; i < num_added; ++i) {
+        /* Opening a device can let other threads in on Android, make sure it's still around */
+        for (device = SDL_HIDAPI_devices; device && device != added[i]; device = device->next) {
+            continue;
+        }
+        if (device) {
+            HIDAPI_SetupDevice(device);
+        }
+    }
+    SDL_free(added);
+
     /* Remove any devices that weren't seen or have been disconnected due to read errors */
 check_removed:
     device = SDL_HIDAPI_devices;
@@ -96,6 +96,9 @@ typedef struct SDL_HIDAPI_Device
     /* Used during scanning for device changes */
     SDL_bool seen;
 
+    /* The time the device has had to settle after arrival, before we open it */
+    Uint64 settle_time;
+
     /* Used to flag that the device is being updated */
     SDL_bool updating;
 
@@ -175,6 +178,11 @@ extern void HIDAPI_UpdateDeviceProperties(SDL_HIDAPI_Device *device);
 
 extern void HIDAPI_DumpPacket(const char *prefix, const Uint8 *data, int size);
 
+/* Compare a field of an input report with the previous report, so drivers can skip sending values that haven't changed.
+ * This returns SDL_TRUE if last_report is NULL, e.g. for the first report after the joystick is opened.
+ */
+extern SDL_bool HIDAPI_ReportFieldChanged(const void *last_report, const void *report, size_t offset, size_t size);
+
 extern SDL_bool HIDAPI_SupportsPlaystationDetection(Uint16 vendor, Uint16 product);
 
 extern float HIDAPI_RemapVal(float val, float val_min, float val_max, float output_min, float output_max);
@@ -461,7 +461,7 @@ int SDL_SendJoystickVirtualSensorDataInner(SDL_Joystick *joystick, SDL_SensorTyp
             return -1;
         }
         hwdata->sensor_events = sensor_events;
-        hwdata->max_sensor_events = hwdata->max_sensor_events;
+        hwdata->max_sensor_events = new_max_sensor_events;
     }
 
     VirtualSensorEvent *event = &hwdata->sensor_events[hwdata->num_sensor_events++];
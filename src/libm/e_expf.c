@@ -0,0 +1,85 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* expf(x) for builds without a C runtime.
+ *
+ * Method
+ *	Evaluated in double precision, which makes a short polynomial
+ *	enough for a float result accurate to < 1 ulp:
+ *	1. Reduce x to r = x - k*ln2, |r| <= ln2/2.
+ *	2. exp(r) ~ 1 + r + r^2/2! + ... + r^7/7!, the truncation error
+ *	   is below 2**-27 relative on the reduced range.
+ *	3. Scale by 2^k, k is within [-150, 129] so it is exact in double.
+ */
+
+#include "math_libm.h"
+#include "math_private.h"
+
+static const double
+half    = 5.00000000000000000000e-01,
+invln2  = 1.44269504088896338700e+00, /* 0x3ff71547, 0x652b82fe */
+ln2_hi  = 6.93147180369123816490e-01, /* 0x3fe62e42, 0xfee00000 */
+ln2_lo  = 1.90821492927058770002e-10, /* 0x3dea39ef, 0x35793c76 */
+E2 = 1.0 / 2.0,
+E3 = 1.0 / 6.0,
+E4 = 1.0 / 24.0,
+E5 = 1.0 / 120.0,
+E6 = 1.0 / 720.0,
+E7 = 1.0 / 5040.0;
+
+static const float
+huge = 1.0e+30f,
+tiny = 1.0e-30f,
+o_threshold =  8.9e+01f,	/* exp(x) overflows a float above ~88.72 */
+u_threshold = -1.04e+02f;	/* exp(x) is 0 as a float below ~-103.97 */
+
+/* e^x in double precision, for -104 <= x <= 89 */
+double attribute_hidden __kernel_expdf(double x)
+{
+	double fk, r, p, twopk;
+	int32_t k;
+
+	fk = x*invln2;
+	k  = (int32_t)(fk >= 0.0 ? fk+half : fk-half);
+	fk = (double)k;
+	r  = (x-fk*ln2_hi)-fk*ln2_lo;
+	p  = 1.0+r*(1.0+r*(E2+r*(E3+r*(E4+r*(E5+r*(E6+r*E7))))));
+	INSERT_WORDS(twopk,0x3ff00000+(k<<20),0);
+	return p*twopk;
+}
+
+float __ieee754_expf(float x)
+{
+	int32_t hx, ix;
+
+	GET_FLOAT_WORD(hx,x);
+	ix = hx&0x7fffffff;
+
+	if(ix>=0x7f800000) {
+	    if(ix>0x7f800000) return x+x;	/* NaN */
+	    return (hx<0) ? 0.0f : x;		/* exp(+-inf)={inf,0} */
+	}
+	if(x>o_threshold) return huge*huge;	/* overflow */
+	if(x<u_threshold) return tiny*tiny;	/* underflow */
+	if(ix<0x31800000) return 1.0f+x;	/* |x| < 2**-28 */
+	return (float)__kernel_expdf(x);
+}
@@ -0,0 +1,87 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* logf(x) for builds without a C runtime.
+ *
+ * Method
+ *	Evaluated in double precision, which makes a short series
+ *	enough for a float result accurate to < 1 ulp:
+ *	1. Write x = 2^k * m, sqrt(2)/2 < m <= sqrt(2).
+ *	2. With s = (m-1)/(m+1), log(m) = 2s + 2s^3/3 + 2s^5/5 + ...
+ *	   |s| <= 0.1716, so terms up to s^11 leave an error below 2**-33.
+ *	3. log(x) = k*ln2 + log(m).
+ */
+
+#include "math_libm.h"
+#include "math_private.h"
+
+static const double
+ln2 = 6.93147180559945286227e-01, /* 0x3fe62e42, 0xfefa39ef */
+L1 = 2.0 / 3.0,
+L2 = 2.0 / 5.0,
+L3 = 2.0 / 7.0,
+L4 = 2.0 / 9.0,
+L5 = 2.0 / 11.0;
+
+static const float
+two25 = 3.355443200e+07f,	/* 0x4c000000 */
+zero  = 0.0f;
+
+/* log(x) in double precision, for finite x > 0 */
+double attribute_hidden __kernel_logdf(float x)
+{
+	double f, s, z;
+	int32_t ix, k;
+
+	GET_FLOAT_WORD(ix,x);
+	k = 0;
+	if(ix<0x00800000) {		/* subnormal, scale up */
+	    k -= 25;
+	    x *= two25;
+	    GET_FLOAT_WORD(ix,x);
+	}
+	k += (ix>>23)-127;
+	ix &= 0x007fffff;
+	if(ix>0x3504f3) {		/* m > sqrt(2), use m/2 */
+	    ix |= 0x3f000000;
+	    k += 1;
+	} else {
+	    ix |= 0x3f800000;
+	}
+	SET_FLOAT_WORD(x,ix);
+	f = (double)x-1.0;
+	s = f/(2.0+f);
+	z = s*s;
+	return (double)k*ln2 + (2.0*s + s*z*(L1+z*(L2+z*(L3+z*(L4+z*L5)))));
+}
+
+float __ieee754_logf(float x)
+{
+	int32_t hx;
+
+	GET_FLOAT_WORD(hx,x);
+	if((hx&0x7fffffff)==0) return -two25/zero;	/* log(+-0)=-inf */
+	if(hx<0) return (x-x)/zero;			/* log(-#) = NaN */
+	if(hx>=0x7f800000) return x+x;			/* inf or NaN */
+	if(hx==0x3f800000) return 0.0f;			/* log(1) = +0 */
+	return (float)__kernel_logdf(x);
+}
@@ -0,0 +1,103 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* powf(x,y) for builds without a C runtime.
+ *
+ * Method
+ *	x^y = exp(y*log(x)), with log and exp evaluated in double
+ *	precision so that the float result is accurate to < 1 ulp.
+ *
+ * Special cases follow C99 Annex F:
+ *	1.  (anything) ** 0 is 1, 1 ** (anything) is 1
+ *	2.  (anything) ** NaN and NaN ** (anything) is NaN
+ *	3.  +-1 ** +-INF is 1
+ *	4.  |x|<1: x ** +INF is +0, x ** -INF is +INF
+ *	5.  |x|>1: x ** +INF is +INF, x ** -INF is +0
+ *	6.  +-0 ** (negative) is +-INF, +-0 ** (positive) is +-0,
+ *	    the sign is only kept for odd integer y
+ *	7.  +-INF ** (negative) is +-0, +-INF ** (positive) is +-INF,
+ *	    the sign is only kept for odd integer y
+ *	8.  (negative) ** (non-integer) is NaN
+ */
+
+#include "math_libm.h"
+#include "math_private.h"
+
+static const float
+one  = 1.0f,
+zero = 0.0f,
+huge = 1.0e+30f,
+tiny = 1.0e-30f;
+
+float __ieee754_powf(float x, float y)
+{
+	double t;
+	int32_t hx, hy, ix, iy;
+	int yisint;		/* 0: not an integer, 1: odd integer, 2: even integer */
+	float sign;
+
+	GET_FLOAT_WORD(hx,x);
+	GET_FLOAT_WORD(hy,y);
+	ix = hx&0x7fffffff;
+	iy = hy&0x7fffffff;
+
+	if(iy==0) return one;			/* y is +-0 */
+	if(hx==0x3f800000) return one;		/* x is +1 */
+	if(ix>0x7f800000 || iy>0x7f800000)	/* x or y is NaN */
+	    return x+y;
+
+	/* determine if y is an odd integer when x < 0 */
+	yisint = 0;
+	if(iy>=0x4b800000) {			/* |y| >= 2^24, even integer (or inf) */
+	    yisint = (iy==0x7f800000) ? 0 : 2;
+	} else {
+	    float ay = (hy<0) ? -y : y;
+	    int32_t j = (int32_t)ay;
+	    if((float)j==ay) yisint = 2-(j&1);
+	}
+
+	/* y is +-inf */
+	if(iy==0x7f800000) {
+	    if(ix==0x3f800000) return one;		/* (-1)**+-inf is 1 */
+	    if(ix>0x3f800000)				/* |x| > 1 */
+		return (hy>=0) ? y : zero;
+	    return (hy<0) ? -y : zero;			/* |x| < 1 */
+	}
+
+	sign = one;
+	if(hx<0) {
+	    if(yisint==0 && ix!=0 && ix!=0x7f800000)
+		return (x-x)/(x-x);			/* (x<0)**(non-int) is NaN */
+	    if(yisint==1) sign = -one;
+	}
+
+	/* x is +-0 or +-inf */
+	if(ix==0 || ix==0x7f800000) {
+	    float z = (ix==0) ? ((hy<0) ? one/zero : zero) : ((hy<0) ? zero : huge*huge);
+	    return sign*z;
+	}
+
+	t = (double)y*__kernel_logdf((hx<0) ? -x : x);
+	if(t>89.0) return sign*huge*huge;	/* overflow */
+	if(t<-104.0) return sign*tiny*tiny;	/* underflow */
+	return sign*(float)__kernel_expdf(t);
+}
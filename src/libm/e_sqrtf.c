@@ -0,0 +1,42 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* sqrtf(x) for builds without a C runtime.
+ *
+ * Uses the hardware square root when the compiler targets it, otherwise the
+ * double precision software square root, which rounds correctly to float
+ * since a double holds more than twice the bits of a float.
+ */
+
+#include "math_libm.h"
+#include "math_private.h"
+
+float __ieee754_sqrtf(float x)
+{
+#if defined(SDL_SSE_INTRINSICS) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+	return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(x)));
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+	return vget_lane_f32(vsqrt_f32(vdup_n_f32(x)), 0);
+#else
+	return (float)__ieee754_sqrt((double)x);
+#endif
+}
@@ -0,0 +1,44 @@
+#include "SDL_internal.h"
+/* k_cosf.c -- float version of k_cos.c
+ * Conversion to float by Ian Lance Taylor, Cygnus Support, ian@cygnus.com.
+ * Debugged and optimized by Bruce D. Evans.
+ */
+
+/*
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+/* __kernel_cosdf( x )
+ * kernel cos function on ~[-pi/4, pi/4], evaluated in double precision
+ * so that the float result is accurate to < 1 ulp.
+ *
+ * |cos(x) - c(x)| < 2**-34.1 (~[-5.37e-11, 5.295e-11]).
+ */
+
+#include "math_libm.h"
+#include "math_private.h"
+
+static const double
+one =  1.0,
+C0  = -4.99999997251031003120e-01, /* -0x1ffffffd0c5e81.0p-54 */
+C1  =  4.16666233237390631894e-02, /*  0x155553e1053a42.0p-57 */
+C2  = -1.38867637746099294692e-03, /* -0x16c087e80f1e27.0p-62 */
+C3  =  2.43904487962774090654e-05; /*  0x199342e0ee5069.0p-68 */
+
+float attribute_hidden __kernel_cosdf(double x)
+{
+	double r, w, z;
+
+	/* Try to optimize for parallel evaluation as in k_tanf.c. */
+	z = x*x;
+	w = z*z;
+	r = C2+z*C3;
+	return (float)(((one+z*C0) + w*C1) + (w*z)*r);
+}
@@ -0,0 +1,44 @@
+#include "SDL_internal.h"
+/* k_sinf.c -- float version of k_sin.c
+ * Conversion to float by Ian Lance Taylor, Cygnus Support, ian@cygnus.com.
+ * Optimized by Bruce D. Evans.
+ */
+
+/*
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+/* __kernel_sindf( x )
+ * kernel sin function on ~[-pi/4, pi/4], evaluated in double precision
+ * so that the float result is accurate to < 1 ulp.
+ *
+ * |sin(x)/x - s(x)| < 2**-37.5 (~[-4.89e-12, 4.824e-12]).
+ */
+
+#include "math_libm.h"
+#include "math_private.h"
+
+static const double
+S1 = -1.66666666416265235595e-01, /* -0x15555554cbac77.0p-55 */
+S2 =  8.33333293858894631756e-03, /*  0x111110896efbb2.0p-59 */
+S3 = -1.98393348360966317347e-04, /* -0x1a00f9e2cae774.0p-65 */
+S4 =  2.71831149398982190640e-06; /*  0x16cd878c3b46a7.0p-71 */
+
+float attribute_hidden __kernel_sindf(double x)
+{
+	double r, s, w, z;
+
+	/* Try to optimize for parallel evaluation as in k_tanf.c. */
+	z = x*x;
+	w = z*z;
+	r = S3+z*S4;
+	s = z*x;
+	return (float)((x + s*(S1+z*S2)) + s*w*r);
+}
@@ -30,7 +30,9 @@ extern double SDL_uclibc_atan(double x);
 extern double SDL_uclibc_atan2(double y, double x);
 extern double SDL_uclibc_copysign(double x, double y);
 extern double SDL_uclibc_cos(double x);
+extern float SDL_uclibc_cosf(float x);
 extern double SDL_uclibc_exp(double x);
+extern float SDL_uclibc_expf(float x);
 extern double SDL_uclibc_fabs(double x);
 extern double SDL_uclibc_floor(double x);
 extern double SDL_uclibc_fmod(double x, double y);
@@ -39,12 +41,16 @@ extern int SDL_uclibc_isinff(float x);
 extern int SDL_uclibc_isnan(double x);
 extern int SDL_uclibc_isnanf(float x);
 extern double SDL_uclibc_log(double x);
+extern float SDL_uclibc_logf(float x);
 extern double SDL_uclibc_log10(double x);
 extern double SDL_uclibc_modf(double x, double *y);
 extern double SDL_uclibc_pow(double x, double y);
+extern float SDL_uclibc_powf(float x, float y);
 extern double SDL_uclibc_scalbn(double x, int n);
 extern double SDL_uclibc_sin(double x);
+extern float SDL_uclibc_sinf(float x);
 extern double SDL_uclibc_sqrt(double x);
+extern float SDL_uclibc_sqrtf(float x);
 extern double SDL_uclibc_tan(double x);
 
 #endif /* math_libm_h_ */
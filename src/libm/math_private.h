@@ -35,7 +35,9 @@ typedef unsigned int u_int32_t;
 #define __ieee754_atan2 SDL_uclibc_atan2
 #define copysign        SDL_uclibc_copysign
 #define cos             SDL_uclibc_cos
+#define cosf            SDL_uclibc_cosf
 #define __ieee754_exp   SDL_uclibc_exp
+#define __ieee754_expf  SDL_uclibc_expf
 #define fabs            SDL_uclibc_fabs
 #define floor           SDL_uclibc_floor
 #define __ieee754_fmod  SDL_uclibc_fmod
@@ -48,13 +50,17 @@ typedef unsigned int u_int32_t;
 #undef __isnanf
 #define __isnanf        SDL_uclibc_isnanf
 #define __ieee754_log   SDL_uclibc_log
+#define __ieee754_logf  SDL_uclibc_logf
 #define __ieee754_log10 SDL_uclibc_log10
 #define modf            SDL_uclibc_modf
 #define __ieee754_pow   SDL_uclibc_pow
+#define __ieee754_powf  SDL_uclibc_powf
 #define scalbln         SDL_uclibc_scalbln
 #define scalbn          SDL_uclibc_scalbn
 #define sin             SDL_uclibc_sin
+#define sinf            SDL_uclibc_sinf
 #define __ieee754_sqrt  SDL_uclibc_sqrt
+#define __ieee754_sqrtf SDL_uclibc_sqrtf
 #define tan             SDL_uclibc_tan
 
 /* The original fdlibm code used statements like:
@@ -216,6 +222,7 @@ extern double __ieee754_jn(int, double) attribute_hidden;
 extern double __ieee754_yn(int, double) attribute_hidden;
 extern double __ieee754_remainder(double, double) attribute_hidden;
 extern int32_t __ieee754_rem_pio2(double, double *) attribute_hidden;
+extern int32_t __ieee754_rem_pio2f(float, double *) attribute_hidden;
 #if defined(_SCALB_INT)
 extern double __ieee754_scalb(double, int) attribute_hidden;
 #else
@@ -231,4 +238,10 @@ extern double __kernel_cos(double, double) attribute_hidden;
 extern double __kernel_tan(double, double, int) attribute_hidden;
 extern int32_t __kernel_rem_pio2(const double *, double *, int, int, const unsigned int, const int32_t *) attribute_hidden;
 
+/* single precision kernels, evaluated in double precision */
+extern float __kernel_sindf(double) attribute_hidden;
+extern float __kernel_cosdf(double) attribute_hidden;
+extern double __kernel_expdf(double) attribute_hidden;
+extern double __kernel_logdf(float) attribute_hidden;
+
 #endif /* _MATH_PRIVATE_H_ */
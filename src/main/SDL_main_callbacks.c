@@ -28,6 +28,12 @@ static SDL_AppQuit_func SDL_main_quit_callback;
 static SDL_AtomicInt apprc;  // use an atomic, since events might land from any thread and we don't want to wrap this all in a mutex. A CAS makes sure we only move from zero once.
 static void *SDL_main_appstate = NULL;
 
+// If SDL_HINT_MAIN_CALLBACK_EVENT_THREAD is set, SDL_AppEvent is called from this thread instead of the main thread.
+static SDL_Thread *SDL_main_event_thread = NULL;
+static SDL_Semaphore *SDL_main_event_sem = NULL;
+static SDL_AtomicInt SDL_main_event_pending;  // set when the event thread has been signaled but hasn't started draining yet.
+static SDL_AtomicInt SDL_main_event_thread_quit;
+
 // Return true if this event needs to be processed before returning from the event watcher
 static SDL_bool ShouldDispatchImmediately(SDL_Event *event)
 {
@@ -69,18 +75,76 @@ static void SDL_DispatchMainCallbackEvents(void)
     }
 }
 
+static void SDL_SignalMainCallbackEventThread(void)
+{
+    // Only wake the event thread once for any number of events that arrive before it runs
+    if (SDL_AtomicCompareAndSwap(&SDL_main_event_pending, 0, 1)) {
+        SDL_SignalSemaphore(SDL_main_event_sem);
+    }
+}
+
+static int SDLCALL SDL_MainCallbackEventThread(void *data)
+{
+    while (!SDL_AtomicGet(&SDL_main_event_thread_quit)) {
+        SDL_WaitSemaphore(SDL_main_event_sem);
+        SDL_AtomicSet(&SDL_main_event_pending, 0);
+        SDL_DispatchMainCallbackEvents();
+    }
+    return 0;
+}
+
 static SDL_bool SDLCALL SDL_MainCallbackEventWatcher(void *userdata, SDL_Event *event)
 {
     if (ShouldDispatchImmediately(event)) {
         // Make sure any currently queued events are processed then dispatch this before continuing
         SDL_DispatchMainCallbackEvents();
         SDL_DispatchMainCallbackEvent(event);
+    } else if (SDL_main_event_thread) {
+        // The watcher runs before the event is queued, so this may wake the
+        // event thread early. The main thread signals it again after pumping,
+        // so the event is picked up no later than the next iteration.
+        SDL_SignalMainCallbackEventThread();
     } else {
         // We'll process this event later from the main event queue
     }
     return SDL_TRUE;
 }
 
+static void SDL_StartMainCallbackEventThread(void)
+{
+    if (!SDL_GetHintBoolean(SDL_HINT_MAIN_CALLBACK_EVENT_THREAD, SDL_FALSE)) {
+        return;
+    }
+
+    SDL_main_event_sem = SDL_CreateSemaphore(0);
+    if (!SDL_main_event_sem) {
+        return;
+    }
+
+    SDL_AtomicSet(&SDL_main_event_pending, 0);
+    SDL_AtomicSet(&SDL_main_event_thread_quit, 0);
+    SDL_main_event_thread = SDL_CreateThread(SDL_MainCallbackEventThread, "SDLMainEvents", NULL);
+    if (!SDL_main_event_thread) {
+        // Fall back to dispatching events on the main thread
+        SDL_DestroySemaphore(SDL_main_event_sem);
+        SDL_main_event_sem = NULL;
+    }
+}
+
+static void SDL_StopMainCallbackEventThread(void)
+{
+    if (SDL_main_event_thread) {
+        SDL_AtomicSet(&SDL_main_event_thread_quit, 1);
+        SDL_SignalSemaphore(SDL_main_event_sem);
+        SDL_WaitThread(SDL_main_event_thread, NULL);
+        SDL_main_event_thread = NULL;
+    }
+    if (SDL_main_event_sem) {
+        SDL_DestroySemaphore(SDL_main_event_sem);
+        SDL_main_event_sem = NULL;
+    }
+}
+
 SDL_bool SDL_HasMainCallbacks(void)
 {
     if (SDL_main_iteration_callback) {
@@ -108,6 +172,8 @@ int SDL_InitMainCallbacks(int argc, char* argv[], SDL_AppInit_func appinit, SDL_
             SDL_AtomicSet(&apprc, -1);
             return -1;
         }
+
+        SDL_StartMainCallbackEventThread();
     }
 
     return SDL_AtomicGet(&apprc);
@@ -118,7 +184,11 @@ int SDL_IterateMainCallbacks(SDL_bool pump_events)
     if (pump_events) {
         SDL_PumpEvents();
     }
-    SDL_DispatchMainCallbackEvents();
+    if (SDL_main_event_thread) {
+        SDL_SignalMainCallbackEventThread();
+    } else {
+        SDL_DispatchMainCallbackEvents();
+    }
 
     int rc = SDL_AtomicGet(&apprc);
     if (rc == 0) {
@@ -133,6 +203,7 @@ int SDL_IterateMainCallbacks(SDL_bool pump_events)
 void SDL_QuitMainCallbacks(void)
 {
     SDL_DelEventWatch(SDL_MainCallbackEventWatcher, NULL);
+    SDL_StopMainCallbackEventThread();
     SDL_main_quit_callback(SDL_main_appstate);
     SDL_main_appstate = NULL;  // just in case.
 
@@ -25,15 +25,86 @@
 
 #ifndef SDL_PLATFORM_IOS
 
-static int callback_rate_increment = 0;
+typedef enum
+{
+    SDL_MAIN_CALLBACK_RATE_DEFAULT,   // run at 60Hz if there are no windows, otherwise as fast as the video subsystem allows
+    SDL_MAIN_CALLBACK_RATE_FIXED,     // run at callback_rate_increment, even if there are windows
+    SDL_MAIN_CALLBACK_RATE_DISPLAY,   // run at the refresh rate of the display the app is on
+    SDL_MAIN_CALLBACK_RATE_WAITEVENT  // run once each time new events arrive
+} SDL_MainCallbackRateMode;
+
+static SDL_MainCallbackRateMode callback_rate_mode = SDL_MAIN_CALLBACK_RATE_DEFAULT;
+static Uint64 callback_rate_increment = 0;
+
+static Uint64 GetRateIncrement(double rate)
+{
+    if (rate > 0.0) {
+        return (Uint64)(SDL_NS_PER_SECOND / rate);
+    }
+    return 0;
+}
 
 static void SDLCALL MainCallbackRateHintChanged(void *userdata, const char *name, const char *oldValue, const char *newValue)
 {
-    const int callback_rate = newValue ? SDL_atoi(newValue) : 60;
-    if (callback_rate > 0) {
-        callback_rate_increment = ((Uint64) 1000000000) / ((Uint64) callback_rate);
-    } else {
+    if (!newValue || !*newValue) {
+        callback_rate_mode = SDL_MAIN_CALLBACK_RATE_DEFAULT;
+        callback_rate_increment = GetRateIncrement(60.0);
+    } else if (SDL_strcasecmp(newValue, "display") == 0) {
+        callback_rate_mode = SDL_MAIN_CALLBACK_RATE_DISPLAY;
         callback_rate_increment = 0;
+    } else if (SDL_strcasecmp(newValue, "waitevent") == 0) {
+        callback_rate_mode = SDL_MAIN_CALLBACK_RATE_WAITEVENT;
+        callback_rate_increment = 0;
+    } else {
+        callback_rate_mode = SDL_MAIN_CALLBACK_RATE_FIXED;
+        callback_rate_increment = GetRateIncrement(SDL_atof(newValue));
+    }
+}
+
+static Uint64 GetDisplayRateIncrement(void)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+    SDL_DisplayID displayID = 0;
+    const SDL_DisplayMode *mode;
+    SDL_Window *window;
+
+    if (!_this) {
+        return GetRateIncrement(60.0);
+    }
+
+    for (window = _this->windows; window; window = window->next) {
+        if (!window->is_destroying) {
+            displayID = SDL_GetDisplayForWindow(window);
+            break;
+        }
+    }
+    if (!displayID) {
+        displayID = SDL_GetPrimaryDisplay();
+    }
+
+    mode = SDL_GetCurrentDisplayMode(displayID);
+    if (mode && mode->refresh_rate > 0.0f) {
+        return GetRateIncrement(mode->refresh_rate);
+    }
+    return GetRateIncrement(60.0);
+}
+
+static Uint64 GetNextRateIncrement(void)
+{
+    switch (callback_rate_mode) {
+    case SDL_MAIN_CALLBACK_RATE_DEFAULT:
+        // If there's no window, try to run at about 60fps. This makes this not
+        //  eat all the CPU in simple things like loopwave. If there's a window,
+        //  we run as fast as possible, which means we'll clamp to vsync in
+        //  common cases, and won't be restrained to vsync if the app is doing a
+        //  benchmark or doesn't want to be, based on how they've set up that window.
+        return SDL_HasWindows() ? 0 : callback_rate_increment;
+    case SDL_MAIN_CALLBACK_RATE_FIXED:
+        return callback_rate_increment;
+    case SDL_MAIN_CALLBACK_RATE_DISPLAY:
+        return GetDisplayRateIncrement();
+    default:
+        return 0;
     }
 }
 
@@ -43,9 +114,10 @@ int SDL_EnterAppMainCallbacks(int argc, char* argv[], SDL_AppInit_func appinit,
     if (rc == 0) {
         SDL_AddHintCallback(SDL_HINT_MAIN_CALLBACK_RATE, MainCallbackRateHintChanged, NULL);
 
-        Uint64 next_iteration = callback_rate_increment ? (SDL_GetTicksNS() + callback_rate_increment) : 0;
+        Uint64 next_iteration = 0;
 
-        while ((rc = SDL_IterateMainCallbacks(SDL_TRUE)) == 0) {
+        // In "waitevent" mode, SDL_WaitEvent() pumps events, so there's no need to do it again before iterating.
+        while ((rc = SDL_IterateMainCallbacks(callback_rate_mode != SDL_MAIN_CALLBACK_RATE_WAITEVENT)) == 0) {
             // !!! FIXME: this can be made more complicated if we decide to
             // !!! FIXME: optionally hand off callback responsibility to the
             // !!! FIXME: video subsystem (for example, if Wayland has a
@@ -53,23 +125,25 @@ int SDL_EnterAppMainCallbacks(int argc, char* argv[], SDL_AppInit_func appinit,
             // !!! FIXME: off to them here if/when the video subsystem becomes
             // !!! FIXME: initialized).
 
-            // !!! FIXME: maybe respect this hint even if there _is_ a window.
-            // if there's no window, try to run at about 60fps (or whatever rate
-            //  the hint requested). This makes this not eat all the CPU in
-            //  simple things like loopwave. If there's a window, we run as fast
-            //  as possible, which means we'll clamp to vsync in common cases,
-            //  and won't be restrained to vsync if the app is doing a benchmark
-            //  or doesn't want to be, based on how they've set up that window.
-            if ((callback_rate_increment == 0) || SDL_HasWindows()) {
+            if (callback_rate_mode == SDL_MAIN_CALLBACK_RATE_WAITEVENT) {
+                // Sleep until there's something new to handle. This doesn't
+                //  remove the event, it's dispatched on the next iteration.
+                SDL_WaitEvent(NULL);
+                next_iteration = 0;
+                continue;
+            }
+
+            const Uint64 increment = GetNextRateIncrement();
+            if (increment == 0) {
                 next_iteration = 0; // just clear the timer and run at the pace the video subsystem allows.
             } else {
                 const Uint64 now = SDL_GetTicksNS();
-                if (next_iteration > now) { // Running faster than the limit, sleep a little.
-                    SDL_DelayNS(next_iteration - now);
+                if (next_iteration > now) { // Running faster than the limit, sleep until the deadline.
+                    SDL_DelayUntilNS(next_iteration);
                 } else {
-                    next_iteration = now; // running behind (or just lost the window)...reset the timer.
+                    next_iteration = now; // running behind (or just started pacing)...reset the timer.
                 }
-                next_iteration += callback_rate_increment;
+                next_iteration += increment;
             }
         }
 
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 #include "SDL_syspower.h"
+#include "SDL_power_c.h"
+#include "../SDL_hints_c.h"
 
 /*
  * Returns SDL_TRUE if we have a definitive answer.
@@ -84,15 +86,47 @@ static SDL_GetPowerInfo_Impl implementations[] = {
 };
 #endif
 
-SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent)
+/* The last answer from the platform, so apps that poll every frame don't hit
+   sysfs, D-Bus or JNI each time. Guarded by SDL_power_lock. */
+static SDL_SpinLock SDL_power_lock;
+static Uint64 SDL_power_expiration; /* 0 if the cached values must be refreshed */
+static SDL_PowerState SDL_power_state;
+static int SDL_power_seconds;
+static int SDL_power_percent;
+
+static SDL_PowerState SDL_QueryPowerInfo(int *seconds, int *percent)
 {
 #ifndef SDL_POWER_DISABLED
     const int total = sizeof(implementations) / sizeof(implementations[0]);
     SDL_PowerState retval = SDL_POWERSTATE_UNKNOWN;
     int i;
+
+    for (i = 0; i < total; i++) {
+        if (implementations[i](&retval, seconds, percent)) {
+            return retval;
+        }
+    }
 #endif
 
+    /* nothing was definitive. */
+    *seconds = -1;
+    *percent = -1;
+    return SDL_POWERSTATE_UNKNOWN;
+}
+
+void SDL_InvalidatePowerInfo(void)
+{
+    SDL_LockSpinlock(&SDL_power_lock);
+    SDL_power_expiration = 0;
+    SDL_UnlockSpinlock(&SDL_power_lock);
+}
+
+SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent)
+{
+    SDL_PowerState retval;
+    Uint64 now, interval;
     int _seconds, _percent;
+
     /* Make these never NULL for platform-specific implementations. */
     if (!seconds) {
         seconds = &_seconds;
@@ -101,16 +135,29 @@ SDL_PowerState SDL_GetPowerInfo(int *seconds, int *percent)
         percent = &_percent;
     }
 
-#ifndef SDL_POWER_DISABLED
-    for (i = 0; i < total; i++) {
-        if (implementations[i](&retval, seconds, percent)) {
-            return retval;
-        }
+    now = SDL_GetTicksNS();
+
+    SDL_LockSpinlock(&SDL_power_lock);
+    if (SDL_power_expiration && now < SDL_power_expiration) {
+        retval = SDL_power_state;
+        *seconds = SDL_power_seconds;
+        *percent = SDL_power_percent;
+        SDL_UnlockSpinlock(&SDL_power_lock);
+        return retval;
     }
-#endif
+    SDL_UnlockSpinlock(&SDL_power_lock);
 
-    /* nothing was definitive. */
-    *seconds = -1;
-    *percent = -1;
-    return SDL_POWERSTATE_UNKNOWN;
+    /* Query outside the lock, the D-Bus round trip can take a while */
+    retval = SDL_QueryPowerInfo(seconds, percent);
+
+    interval = SDL_MS_TO_NS((Uint64)SDL_max(SDL_GetStringInteger(SDL_GetHint(SDL_HINT_POWER_INFO_REFRESH_INTERVAL), 1000), 0));
+    if (interval > 0) {
+        SDL_LockSpinlock(&SDL_power_lock);
+        SDL_power_state = retval;
+        SDL_power_seconds = *seconds;
+        SDL_power_percent = *percent;
+        SDL_power_expiration = now + interval;
+        SDL_UnlockSpinlock(&SDL_power_lock);
+    }
+    return retval;
 }
@@ -0,0 +1,170 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_dmabuf_c.h"
+
+#ifdef SDL_VIDEO_OPENGL_EGL
+#include <SDL3/SDL_egl.h>
+
+typedef void (EGLAPIENTRYP SDL_PFNGLEGLIMAGETARGETTEXTURE2DOESPROC)(unsigned int target, void *image);
+
+static const char *SDL_dmabuf_fd_props[] = {
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_FD_NUMBER,
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_FD_NUMBER,
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_FD_NUMBER
+};
+static const char *SDL_dmabuf_pitch_props[] = {
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_PITCH_NUMBER,
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_PITCH_NUMBER,
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_PITCH_NUMBER
+};
+static const char *SDL_dmabuf_offset_props[] = {
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_OFFSET_NUMBER,
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE1_OFFSET_NUMBER,
+    SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE2_OFFSET_NUMBER
+};
+
+static SDL_bool SDL_HasEGLExtension(const char *extensions, const char *name)
+{
+    const size_t len = SDL_strlen(name);
+    const char *ext = extensions;
+
+    while (ext && *ext) {
+        const char *found = SDL_strstr(ext, name);
+        if (!found) {
+            break;
+        }
+        if ((found == extensions || found[-1] == ' ') && (found[len] == ' ' || found[len] == '\0')) {
+            return SDL_TRUE;
+        }
+        ext = found + len;
+    }
+    return SDL_FALSE;
+}
+
+SDL_bool SDL_HasDMABUFTextureProperties(SDL_PropertiesID create_props)
+{
+    return SDL_HasProperty(create_props, SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_FD_NUMBER);
+}
+
+int SDL_BindDMABUFTexturePlane(SDL_PropertiesID create_props, int plane, Uint32 drm_format, int w, int h, unsigned int target)
+{
+    EGLDisplay display = (EGLDisplay)SDL_EGL_GetCurrentDisplay();
+    PFNEGLQUERYSTRINGPROC eglQueryStringFunc;
+    PFNEGLGETERRORPROC eglGetErrorFunc;
+    PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHRFunc;
+    PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHRFunc;
+    SDL_PFNGLEGLIMAGETARGETTEXTURE2DOESPROC glEGLImageTargetTexture2DOESFunc;
+    const char *extensions;
+    EGLImageKHR image;
+    EGLint attribs[32];
+    Uint64 modifier;
+    Sint64 fd, pitch, offset;
+    int i = 0;
+
+    if (plane < 0 || plane >= (int)SDL_arraysize(SDL_dmabuf_fd_props)) {
+        return SDL_InvalidParamError("plane");
+    }
+
+    if (display == EGL_NO_DISPLAY) {
+        return SDL_SetError("DMA-BUF textures need an OpenGL context created with EGL");
+    }
+
+    eglQueryStringFunc = (PFNEGLQUERYSTRINGPROC)SDL_EGL_GetProcAddress("eglQueryString");
+    eglGetErrorFunc = (PFNEGLGETERRORPROC)SDL_EGL_GetProcAddress("eglGetError");
+    eglCreateImageKHRFunc = (PFNEGLCREATEIMAGEKHRPROC)SDL_EGL_GetProcAddress("eglCreateImageKHR");
+    eglDestroyImageKHRFunc = (PFNEGLDESTROYIMAGEKHRPROC)SDL_EGL_GetProcAddress("eglDestroyImageKHR");
+    glEGLImageTargetTexture2DOESFunc = (SDL_PFNGLEGLIMAGETARGETTEXTURE2DOESPROC)SDL_GL_GetProcAddress("glEGLImageTargetTexture2DOES");
+    if (!eglQueryStringFunc || !eglGetErrorFunc || !eglCreateImageKHRFunc || !eglDestroyImageKHRFunc ||
+        !glEGLImageTargetTexture2DOESFunc) {
+        return SDL_SetError("DMA-BUF textures need EGL images and GL_OES_EGL_image");
+    }
+
+    extensions = eglQueryStringFunc(display, EGL_EXTENSIONS);
+    if (!SDL_HasEGLExtension(extensions, "EGL_EXT_image_dma_buf_import")) {
+        return SDL_SetError("DMA-BUF textures need EGL_EXT_image_dma_buf_import");
+    }
+
+    /* Chroma planes default to living in the same buffer as the luma plane */
+    fd = SDL_GetNumberProperty(create_props, SDL_dmabuf_fd_props[0], -1);
+    if (plane > 0) {
+        fd = SDL_GetNumberProperty(create_props, SDL_dmabuf_fd_props[plane], fd);
+    }
+    pitch = SDL_GetNumberProperty(create_props, SDL_dmabuf_pitch_props[plane], 0);
+    offset = SDL_GetNumberProperty(create_props, SDL_dmabuf_offset_props[plane], 0);
+    modifier = (Uint64)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_DMABUF_MODIFIER_NUMBER, (Sint64)0x00ffffffffffffffULL);
+
+    if (fd < 0) {
+        return SDL_SetError("Missing DMA-BUF file descriptor for plane %d", plane);
+    }
+    if (pitch <= 0 || offset < 0) {
+        return SDL_SetError("Invalid DMA-BUF pitch or offset for plane %d", plane);
+    }
+
+    attribs[i++] = EGL_LINUX_DRM_FOURCC_EXT;
+    attribs[i++] = (EGLint)drm_format;
+    attribs[i++] = EGL_WIDTH;
+    attribs[i++] = w;
+    attribs[i++] = EGL_HEIGHT;
+    attribs[i++] = h;
+    attribs[i++] = EGL_DMA_BUF_PLANE0_FD_EXT;
+    attribs[i++] = (EGLint)fd;
+    attribs[i++] = EGL_DMA_BUF_PLANE0_OFFSET_EXT;
+    attribs[i++] = (EGLint)offset;
+    attribs[i++] = EGL_DMA_BUF_PLANE0_PITCH_EXT;
+    attribs[i++] = (EGLint)pitch;
+    if (modifier != 0x00ffffffffffffffULL) {
+        if (!SDL_HasEGLExtension(extensions, "EGL_EXT_image_dma_buf_import_modifiers")) {
+            return SDL_SetError("DMA-BUF format modifiers need EGL_EXT_image_dma_buf_import_modifiers");
+        }
+        attribs[i++] = EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT;
+        attribs[i++] = (EGLint)(modifier & 0xFFFFFFFF);
+        attribs[i++] = EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT;
+        attribs[i++] = (EGLint)(modifier >> 32);
+    }
+    attribs[i++] = EGL_NONE;
+
+    image = eglCreateImageKHRFunc(display, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT, NULL, attribs);
+    if (image == EGL_NO_IMAGE_KHR) {
+        return SDL_SetError("Couldn't import DMA-BUF plane %d: EGL error 0x%x", plane, (unsigned int)eglGetErrorFunc());
+    }
+
+    /* The texture keeps the buffer alive, the image itself isn't needed anymore */
+    glEGLImageTargetTexture2DOESFunc(target, image);
+    eglDestroyImageKHRFunc(display, image);
+
+    return 0;
+}
+
+#else
+
+SDL_bool SDL_HasDMABUFTextureProperties(SDL_PropertiesID create_props)
+{
+    return SDL_HasProperty(create_props, SDL_PROP_TEXTURE_CREATE_DMABUF_PLANE0_FD_NUMBER);
+}
+
+int SDL_BindDMABUFTexturePlane(SDL_PropertiesID create_props, int plane, Uint32 drm_format, int w, int h, unsigned int target)
+{
+    return SDL_SetError("DMA-BUF textures need EGL support");
+}
+
+#endif /* SDL_VIDEO_OPENGL_EGL */
@@ -0,0 +1,47 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_dmabuf_c_h_
+#define SDL_dmabuf_c_h_
+
+#include "SDL_internal.h"
+
+/* Importing Linux DMA-BUF planes into OpenGL textures through EGL, for the
+   SDL_PROP_TEXTURE_CREATE_DMABUF_* texture creation properties */
+
+#define SDL_DRM_FOURCC(a, b, c, d) ((Uint32)(a) | ((Uint32)(b) << 8) | ((Uint32)(c) << 16) | ((Uint32)(d) << 24))
+
+#define SDL_DRM_FORMAT_R8       SDL_DRM_FOURCC('R', '8', ' ', ' ')
+#define SDL_DRM_FORMAT_GR88     SDL_DRM_FOURCC('G', 'R', '8', '8')
+#define SDL_DRM_FORMAT_ARGB8888 SDL_DRM_FOURCC('A', 'R', '2', '4')
+#define SDL_DRM_FORMAT_XRGB8888 SDL_DRM_FOURCC('X', 'R', '2', '4')
+#define SDL_DRM_FORMAT_ABGR8888 SDL_DRM_FOURCC('A', 'B', '2', '4')
+#define SDL_DRM_FORMAT_XBGR8888 SDL_DRM_FOURCC('X', 'B', '2', '4')
+
+/* Returns SDL_TRUE if the texture creation properties describe a DMA-BUF */
+extern SDL_bool SDL_HasDMABUFTextureProperties(SDL_PropertiesID create_props);
+
+/* Makes plane `plane` of the DMA-BUF the storage of the GL texture bound to
+   `target`, as a w x h image of the single plane DRM format `drm_format`.
+   The current GL context must have been created by SDL through EGL. */
+extern int SDL_BindDMABUFTexturePlane(SDL_PropertiesID create_props, int plane, Uint32 drm_format, int w, int h, unsigned int target);
+
+#endif /* SDL_dmabuf_c_h_ */
@@ -23,9 +23,12 @@
 /* The SDL 2D rendering system */
 
 #include "SDL_sysrender.h"
+#include "SDL_render_debug_font.h"
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
 #include "../video/SDL_video_c.h"
+#include "../SDL_hints_c.h"
+#include "../SDL_memorystats_c.h"
 
 #ifdef SDL_PLATFORM_ANDROID
 #include "../core/android/SDL_android.h"
@@ -47,6 +50,9 @@ this should probably be removed at some point in the future.  --ryan. */
 #define SDL_PROP_WINDOW_RENDERER_POINTER "SDL.internal.window.renderer"
 #define SDL_PROP_TEXTURE_PARENT_POINTER "SDL.internal.texture.parent"
 
+/* The number of presented frames a destroyed transient render target stays available for reuse */
+#define SDL_RENDER_TARGET_POOL_FRAMES 3
+
 #define CHECK_RENDERER_MAGIC_BUT_NOT_DESTROYED_FLAG(renderer, retval)   \
     if (!SDL_ObjectValid(renderer, SDL_OBJECT_TYPE_RENDERER)) {         \
         SDL_InvalidParamError("renderer");                              \
@@ -174,6 +180,18 @@ static float sRGBtoLinear(float v)
     return v <= 0.04045f ? (v / 12.92f) : SDL_powf(((v + 0.055f) / 1.055f), 2.4f);
 }
 
+static float sRGBtoLinearFast(float v)
+{
+    /* Most colors come from 8-bit values, so look those up instead of calling pow() */
+    if (v >= 0.0f && v <= 1.0f) {
+        const int index = (int)(v * 255.0f + 0.5f);
+        if ((float)index / 255.0f == v) {
+            return SDL_GetsRGBtoLinearTable()[index];
+        }
+    }
+    return sRGBtoLinear(v);
+}
+
 static float sRGBfromLinear(float v)
 {
     return v <= 0.0031308f ? (v * 12.92f) : (SDL_powf(v, 1.0f / 2.4f) * 1.055f - 0.055f);
@@ -196,9 +214,9 @@ SDL_bool SDL_RenderingLinearSpace(SDL_Renderer *renderer)
 
 void SDL_ConvertToLinear(SDL_FColor *color)
 {
-    color->r = sRGBtoLinear(color->r);
-    color->g = sRGBtoLinear(color->g);
-    color->b = sRGBtoLinear(color->b);
+    color->r = sRGBtoLinearFast(color->r);
+    color->g = sRGBtoLinearFast(color->g);
+    color->b = sRGBtoLinearFast(color->b);
 }
 
 void SDL_ConvertFromLinear(SDL_FColor *color)
@@ -308,20 +326,170 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static SDL_bool IsSameRenderState(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    SDL_assert(a->command == b->command);
+
+    switch (a->command) {
+    case SDL_RENDERCMD_SETVIEWPORT:
+        return SDL_memcmp(&a->data.viewport.rect, &b->data.viewport.rect, sizeof(a->data.viewport.rect)) == 0;
+    case SDL_RENDERCMD_SETCLIPRECT:
+        if (a->data.cliprect.enabled != b->data.cliprect.enabled) {
+            return SDL_FALSE;
+        }
+        return !a->data.cliprect.enabled ||
+               SDL_memcmp(&a->data.cliprect.rect, &b->data.cliprect.rect, sizeof(a->data.cliprect.rect)) == 0;
+    case SDL_RENDERCMD_SETDRAWCOLOR:
+        return a->data.color.color_scale == b->data.color.color_scale &&
+               SDL_memcmp(&a->data.color.color, &b->data.color.color, sizeof(a->data.color.color)) == 0;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Remove commands that can't change the output before handing the queue to the backend:
+   no-ops, draws with nothing to draw, state changes that are overridden before anything
+   is drawn, and state changes that set what is already in effect. State changes at the
+   end of the queue are left alone, so the backend state matches what was queued. */
+static int RemoveRedundantRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *pending[3] = { NULL, NULL, NULL };
+    SDL_RenderCommand *applied[3] = { NULL, NULL, NULL };
+    SDL_RenderCommand *cmd;
+    SDL_RenderCommand *prev = NULL;
+    SDL_RenderCommand *next;
+    int removed = 0;
+    int i;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_NO_OP:
+            break;
+
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            i = (int)cmd->command - (int)SDL_RENDERCMD_SETVIEWPORT;
+            if (pending[i]) {
+                pending[i]->command = SDL_RENDERCMD_NO_OP;
+            }
+            pending[i] = cmd;
+            break;
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            if (cmd->data.draw.count == 0) {
+                cmd->command = SDL_RENDERCMD_NO_OP;
+                break;
+            }
+            SDL_FALLTHROUGH;
+
+        default:
+            for (i = 0; i < SDL_arraysize(pending); ++i) {
+                if (pending[i]) {
+                    if (applied[i] && IsSameRenderState(applied[i], pending[i])) {
+                        pending[i]->command = SDL_RENDERCMD_NO_OP;
+                    } else {
+                        applied[i] = pending[i];
+                    }
+                    pending[i] = NULL;
+                }
+            }
+            break;
+        }
+    }
+
+    for (cmd = renderer->render_commands; cmd; cmd = next) {
+        next = cmd->next;
+        if (cmd->command != SDL_RENDERCMD_NO_OP) {
+            prev = cmd;
+            continue;
+        }
+
+        if (prev) {
+            prev->next = next;
+        } else {
+            renderer->render_commands = next;
+        }
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+        ++removed;
+    }
+    renderer->render_commands_tail = prev;
+
+    return removed;
+}
+
+static void UpdateRenderStats(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, int removed)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+    const size_t queued_bytes = renderer->vertex_data_used + renderer->index_data_used;
+    int queued = removed;
+
+    ++stats->flushes;
+    stats->vertex_bytes += queued_bytes;
+    stats->peak_vertex_bytes = SDL_max(stats->peak_vertex_bytes, queued_bytes);
+    renderer->queue_peak_vertex_bytes = SDL_max(renderer->queue_peak_vertex_bytes, renderer->vertex_data_used);
+    renderer->queue_peak_index_bytes = SDL_max(renderer->queue_peak_index_bytes, renderer->index_data_used);
+    while (cmd) {
+        ++queued;
+        switch (cmd->command) {
+        case SDL_RENDERCMD_NO_OP:
+            break;
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            ++stats->state_changes;
+            ++stats->commands;
+            break;
+        default:
+            ++stats->draw_commands;
+            ++stats->commands;
+            break;
+        }
+        cmd = cmd->next;
+    }
+    stats->peak_commands = SDL_max(stats->peak_commands, queued);
+    renderer->queue_peak_commands = SDL_max(renderer->queue_peak_commands, queued);
+}
+
+static void CompletePendingTextureUpdates(SDL_Renderer *renderer, SDL_Texture *texture);
+
 static int FlushRenderCommands(SDL_Renderer *renderer)
 {
+    Uint64 start;
+    int removed;
     int retval;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
 
     if (!renderer->render_commands) { /* nothing to do! */
         SDL_assert(renderer->vertex_data_used == 0);
+        CompletePendingTextureUpdates(renderer, NULL);
         return 0;
     }
 
+    removed = RemoveRedundantRenderCommands(renderer);
+    renderer->stats.redundant_commands += removed;
+
     DebugLogRenderCommands(renderer->render_commands);
 
-    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    UpdateRenderStats(renderer, renderer->render_commands, removed);
+
+    if (renderer->render_commands) {
+        SDL_TRACE_BEGIN("FlushRenderCommands");
+        SDL_TRACE_COUNTER("SDL_RenderVertexBytes", renderer->vertex_data_used);
+        start = SDL_GetTicksNS();
+        retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+        renderer->stats.flush_ns += SDL_GetTicksNS() - start;
+        SDL_TRACE_END();
+    } else {
+        retval = 0;
+    }
 
     /* Move the whole render command queue to the unused pool so we can reuse them next time. */
     if (renderer->render_commands_tail) {
@@ -331,11 +499,16 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
         renderer->render_commands = NULL;
     }
     renderer->vertex_data_used = 0;
+    renderer->index_data_used = 0;
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
     renderer->color_scale_queued = SDL_FALSE;
     renderer->viewport_queued = SDL_FALSE;
     renderer->cliprect_queued = SDL_FALSE;
+
+    /* The queued commands have run, so these can't affect them anymore */
+    CompletePendingTextureUpdates(renderer, NULL);
+
     return retval;
 }
 
@@ -349,6 +522,16 @@ static int FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
     return 0;
 }
 
+static int FlushRenderCommandsIfShaderNeeded(SDL_RenderShader *shader)
+{
+    SDL_Renderer *renderer = shader->renderer;
+    if (shader->last_command_generation == renderer->render_command_generation) {
+        /* the current command queue uses this shader, flush the queue now before it goes away */
+        return FlushRenderCommands(renderer);
+    }
+    return 0;
+}
+
 int SDL_FlushRenderer(SDL_Renderer *renderer)
 {
     if (FlushRenderCommands(renderer) == -1) {
@@ -381,6 +564,7 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
         }
         renderer->vertex_data = ptr;
         renderer->vertex_data_allocation = newsize;
+        ++renderer->stats.queue_allocations;
     }
 
     if (offset) {
@@ -392,6 +576,127 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes,
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
 
+void *SDL_AllocateRenderIndices(SDL_Renderer *renderer, const size_t numbytes, size_t *offset)
+{
+    const size_t needed = renderer->index_data_used + numbytes;
+    const size_t current_offset = renderer->index_data_used;
+
+    if (renderer->index_data_allocation < needed) {
+        const size_t current_allocation = renderer->index_data ? renderer->index_data_allocation : 1024;
+        size_t newsize = current_allocation * 2;
+        void *ptr;
+        while (newsize < needed) {
+            newsize *= 2;
+        }
+
+        ptr = SDL_realloc(renderer->index_data, newsize);
+
+        if (!ptr) {
+            return NULL;
+        }
+        renderer->index_data = ptr;
+        renderer->index_data_allocation = newsize;
+        ++renderer->stats.queue_allocations;
+    }
+
+    if (offset) {
+        *offset = current_offset;
+    }
+
+    renderer->index_data_used += numbytes;
+
+    return ((Uint8 *)renderer->index_data) + current_offset;
+}
+
+/* Resize a vertex or index array to the smallest power of two from 1024 that holds
+   numbytes, the way SDL_AllocateRenderVertices() grows it, or free it if numbytes is 0. */
+static int ResizeRenderQueueData(void **data, size_t *allocation, size_t numbytes)
+{
+    size_t newsize = 1024;
+    void *ptr;
+
+    if (numbytes == 0) {
+        SDL_free(*data);
+        *data = NULL;
+        *allocation = 0;
+        return 0;
+    }
+
+    while (newsize < numbytes) {
+        newsize *= 2;
+    }
+    if (*data && newsize == *allocation) {
+        return 0;
+    }
+
+    ptr = SDL_realloc(*data, newsize);
+    if (!ptr) {
+        return -1;
+    }
+    *data = ptr;
+    *allocation = newsize;
+    return 0;
+}
+
+static int ReserveRenderCommandQueue(SDL_Renderer *renderer, SDL_PropertiesID props)
+{
+    Sint64 commands = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_CREATE_COMMAND_RESERVE_NUMBER, 0);
+    Sint64 vertex_bytes = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_CREATE_VERTEX_RESERVE_NUMBER, 0);
+    Sint64 shrink_frames = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_CREATE_QUEUE_SHRINK_FRAMES_NUMBER, 0);
+
+    renderer->render_commands_reserve = (int)SDL_clamp(commands, 0, SDL_MAX_SINT32);
+    renderer->vertex_data_reserve = (size_t)SDL_clamp(vertex_bytes, 0, SDL_MAX_SINT32);
+    renderer->queue_shrink_frames = (int)SDL_clamp(shrink_frames, 0, SDL_MAX_SINT32);
+
+    while (renderer->render_commands_allocated < renderer->render_commands_reserve) {
+        SDL_RenderCommand *cmd = (SDL_RenderCommand *)SDL_calloc(1, sizeof(*cmd));
+        if (!cmd) {
+            return -1;
+        }
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+        ++renderer->render_commands_allocated;
+    }
+
+    if (renderer->vertex_data_reserve > 0) {
+        /* leave room for the alignment padding SDL_AllocateRenderVertices() asks for */
+        return ResizeRenderQueueData(&renderer->vertex_data, &renderer->vertex_data_allocation, renderer->vertex_data_reserve + 16);
+    }
+    return 0;
+}
+
+/* Free command queue memory that went unused for the last queue_shrink_frames frames.
+   This only runs between frames, when nothing is queued. */
+static void ShrinkRenderCommandQueue(SDL_Renderer *renderer)
+{
+    const int keep_commands = SDL_max(renderer->render_commands_reserve, renderer->queue_peak_commands);
+    const size_t keep_vertex_bytes = SDL_max(renderer->vertex_data_reserve, renderer->queue_peak_vertex_bytes);
+
+    if (++renderer->queue_shrink_frame_count < renderer->queue_shrink_frames) {
+        return;
+    }
+
+    while (renderer->render_commands_allocated > keep_commands && renderer->render_commands_pool) {
+        SDL_RenderCommand *cmd = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd->next;
+        SDL_free(cmd);
+        --renderer->render_commands_allocated;
+    }
+
+    /* Only shrink when the array is more than twice as big as needed, so it doesn't bounce */
+    if (renderer->vertex_data_allocation > 2 * (keep_vertex_bytes + 16)) {
+        ResizeRenderQueueData(&renderer->vertex_data, &renderer->vertex_data_allocation, keep_vertex_bytes ? keep_vertex_bytes + 16 : 0);
+    }
+    if (renderer->index_data_allocation > 2 * renderer->queue_peak_index_bytes) {
+        ResizeRenderQueueData(&renderer->index_data, &renderer->index_data_allocation, renderer->queue_peak_index_bytes);
+    }
+
+    renderer->queue_shrink_frame_count = 0;
+    renderer->queue_peak_commands = 0;
+    renderer->queue_peak_vertex_bytes = 0;
+    renderer->queue_peak_index_bytes = 0;
+}
+
 static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *retval = NULL;
@@ -406,6 +711,8 @@ static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
         if (!retval) {
             return NULL;
         }
+        ++renderer->render_commands_allocated;
+        ++renderer->stats.queue_allocations;
     }
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -573,11 +880,17 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
             cmd->command = cmdtype;
             cmd->data.draw.first = 0; /* render backend will fill this in. */
             cmd->data.draw.count = 0; /* render backend will fill this in. */
+            cmd->data.draw.first_index = 0;
+            cmd->data.draw.num_indices = 0;
             cmd->data.draw.color_scale = renderer->color_scale;
             cmd->data.draw.color = *color;
             cmd->data.draw.blend = blendMode;
             cmd->data.draw.texture = texture;
             cmd->data.draw.texture_address_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+            cmd->data.draw.shader = renderer->shader;
+            if (renderer->shader) {
+                renderer->shader->last_command_generation = renderer->render_command_generation;
+            }
         }
     }
     return cmd;
@@ -711,6 +1024,57 @@ static int QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
     return retval;
 }
 
+static SDL_bool CanMergeGeometryCommands(const SDL_RenderCommand *prev, const SDL_RenderCommand *cmd)
+{
+    if (prev->command != SDL_RENDERCMD_GEOMETRY ||
+        prev->data.draw.texture != cmd->data.draw.texture ||
+        prev->data.draw.blend != cmd->data.draw.blend ||
+        prev->data.draw.color_scale != cmd->data.draw.color_scale ||
+        prev->data.draw.texture_address_mode != cmd->data.draw.texture_address_mode ||
+        prev->data.draw.shader != cmd->data.draw.shader ||
+        prev->data.draw.num_indices != 0 || cmd->data.draw.num_indices != 0 ||
+        SDL_memcmp(&prev->data.draw.color, &cmd->data.draw.color, sizeof(cmd->data.draw.color)) != 0) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* If the geometry we just queued has the same state as the previous command and its
+   vertices landed directly after the previous command's vertices, fold it into that
+   command so the backend sees one long vertex run instead of many small draws. */
+static void MergeGeometryCommand(SDL_Renderer *renderer, SDL_RenderCommand *prev, SDL_RenderCommand *cmd, size_t vertex_data_start)
+{
+    size_t stride;
+
+    if (!prev || prev->next != cmd || cmd != renderer->render_commands_tail) {
+        return;  /* something else was queued between the two draws. */
+    }
+
+    /* backends that don't stage vertices in renderer->vertex_data can't be merged here. */
+    if (renderer->vertex_data_used == vertex_data_start || cmd->data.draw.first != vertex_data_start ||
+        cmd->data.draw.count == 0) {
+        return;
+    }
+
+    if (!CanMergeGeometryCommands(prev, cmd)) {
+        return;
+    }
+
+    /* the previous command's vertices must end exactly where these begin (no padding in between). */
+    stride = (renderer->vertex_data_used - vertex_data_start) / cmd->data.draw.count;
+    if (stride * cmd->data.draw.count != renderer->vertex_data_used - vertex_data_start ||
+        prev->data.draw.first + prev->data.draw.count * stride != cmd->data.draw.first) {
+        return;
+    }
+
+    prev->data.draw.count += cmd->data.draw.count;
+
+    prev->next = NULL;
+    renderer->render_commands_tail = prev;
+    cmd->next = renderer->render_commands_pool;
+    renderer->render_commands_pool = cmd;
+}
+
 static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                             const float *xy, int xy_stride,
                             const SDL_FColor *color, int color_stride,
@@ -720,6 +1084,8 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                             float scale_x, float scale_y, SDL_TextureAddressMode texture_address_mode)
 {
     SDL_RenderCommand *cmd;
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
+    const size_t vertex_data_start = renderer->vertex_data_used;
     int retval = -1;
     cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
     if (cmd) {
@@ -732,6 +1098,8 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          scale_x, scale_y);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->merge_geometry) {
+            MergeGeometryCommand(renderer, prev, cmd, vertex_data_start);
         }
     }
     return retval;
@@ -908,7 +1276,8 @@ static SDL_INLINE void VerifyDrawQueueFunctions(const SDL_Renderer *renderer)
 
 static SDL_RenderLineMethod SDL_GetRenderLineMethod(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_LINE_METHOD);
+    static SDL_CachedHint line_method_hint = SDL_CACHED_HINT(SDL_HINT_RENDER_LINE_METHOD);
+    const char *hint = SDL_GetCachedHint(&line_method_hint);
 
     int method = 0;
     if (hint) {
@@ -1081,6 +1450,12 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
         renderer->line_method = SDL_GetRenderLineMethod();
     }
 
+    renderer->merge_geometry = SDL_GetHintBoolean(SDL_HINT_RENDER_MERGE_GEOMETRY, SDL_FALSE);
+
+    if (ReserveRenderCommandQueue(renderer, props) < 0) {
+        goto error;
+    }
+
     renderer->SDR_white_point = 1.0f;
     renderer->HDR_headroom = 1.0f;
     renderer->color_scale = 1.0f;
@@ -1123,6 +1498,12 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
             SDL_SetRenderVSync(renderer, 1);
         }
     }
+    if (SDL_HasProperty(props, SDL_PROP_RENDERER_CREATE_PRESENT_MODE_NUMBER)) {
+        SDL_PresentMode present_mode = (SDL_PresentMode)SDL_GetNumberProperty(props, SDL_PROP_RENDERER_CREATE_PRESENT_MODE_NUMBER, SDL_PRESENTMODE_FIFO);
+        if (SDL_RenderSupportsPresentMode(renderer, present_mode)) {
+            SDL_SetRenderPresentMode(renderer, present_mode);
+        }
+    }
     SDL_CalculateSimulatedVSyncInterval(renderer, window);
 
     SDL_LogInfo(SDL_LOG_CATEGORY_RENDER,
@@ -1286,6 +1667,21 @@ static SDL_bool IsSupportedFormat(SDL_Renderer *renderer, SDL_PixelFormat format
     return SDL_FALSE;
 }
 
+/* Renderers with 10-bit or floating point texture formats decode PQ and scRGB input,
+ * convert primaries and tone map to the output headroom in their pixel shaders */
+static SDL_bool SupportsHDRTextures(SDL_Renderer *renderer)
+{
+    int i;
+
+    for (i = 0; i < renderer->num_texture_formats; ++i) {
+        if (SDL_ISPIXELFORMAT_10BIT(renderer->texture_formats[i]) ||
+            SDL_ISPIXELFORMAT_FLOAT(renderer->texture_formats[i])) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
 static Uint32 GetClosestSupportedFormat(SDL_Renderer *renderer, SDL_PixelFormat format)
 {
     int i;
@@ -1324,6 +1720,121 @@ static Uint32 GetClosestSupportedFormat(SDL_Renderer *renderer, SDL_PixelFormat
     return renderer->texture_formats[0];
 }
 
+static SDL_BlendMode GetDefaultTextureBlendMode(SDL_PixelFormat format)
+{
+    if (SDL_ISPIXELFORMAT_ALPHA(format) ||
+        (SDL_ISPIXELFORMAT_COMPRESSED(format) &&
+         format != SDL_PIXELFORMAT_BC4 && format != SDL_PIXELFORMAT_BC5 && format != SDL_PIXELFORMAT_ETC2_RGB8)) {
+        return SDL_BLENDMODE_BLEND;
+    }
+    return SDL_BLENDMODE_NONE;
+}
+
+/* Adds a newly created texture to the memory statistics, or removes one that's being destroyed */
+static void TrackTextureMemory(SDL_Texture *texture, SDL_bool add)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_MemoryStats *memory = &texture->memory;
+
+    if (add) {
+        size_t size;
+        int block_w, block_h, block_size;
+
+        memory->bytes = sizeof(*texture);
+        if (texture->pixels) {
+            memory->bytes += (Uint64)texture->pitch * texture->h;
+        }
+#if SDL_HAVE_YUV
+        if (texture->yuv && SDL_CalculateSurfaceSize(texture->format, texture->w, texture->h, &size, NULL, SDL_TRUE) == 0) {
+            memory->bytes += size;
+        }
+#endif
+
+        /* Textures with a native texture don't have any storage of their own in the backend */
+        memory->gpu_bytes = 0;
+        if (!texture->native) {
+            block_size = SDL_GetCompressedFormatBlockSize(texture->format, &block_w, &block_h);
+            if (block_size > 0) {
+                memory->gpu_bytes = (Uint64)((texture->w + block_w - 1) / block_w) * ((texture->h + block_h - 1) / block_h) * block_size;
+            } else if (SDL_CalculateSurfaceSize(texture->format, texture->w, texture->h, &size, NULL, SDL_TRUE) == 0) {
+                memory->gpu_bytes = size;
+            }
+            if (texture->mipmaps) {
+                /* A full chain of mipmaps adds about a third */
+                memory->gpu_bytes += memory->gpu_bytes / 3;
+            }
+        }
+        memory->count = 1;
+
+        renderer->memory_stats.bytes += memory->bytes;
+        renderer->memory_stats.gpu_bytes += memory->gpu_bytes;
+        renderer->memory_stats.count += 1;
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_TEXTURES, (Sint64)memory->bytes, (Sint64)memory->gpu_bytes, 1);
+    } else if (memory->count) {
+        renderer->memory_stats.bytes -= memory->bytes;
+        renderer->memory_stats.gpu_bytes -= memory->gpu_bytes;
+        renderer->memory_stats.count -= 1;
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_TEXTURES, -(Sint64)memory->bytes, -(Sint64)memory->gpu_bytes, -1);
+        SDL_zerop(memory);
+    }
+}
+
+static SDL_Texture *GetPooledRenderTarget(SDL_Renderer *renderer, SDL_PropertiesID props, SDL_PixelFormat format, SDL_Colorspace colorspace, int w, int h, SDL_bool mipmaps)
+{
+    SDL_Texture *texture;
+    SDL_Texture *prev = NULL;
+
+    for (texture = renderer->target_pool; texture; prev = texture, texture = texture->next) {
+        if (texture->format == format && texture->colorspace == colorspace &&
+            texture->w == w && texture->h == h && texture->mipmaps == mipmaps) {
+            break;
+        }
+    }
+    if (!texture) {
+        return NULL;
+    }
+
+    if (prev) {
+        prev->next = texture->next;
+    } else {
+        renderer->target_pool = texture->next;
+    }
+    texture->prev = NULL;
+    texture->next = renderer->textures;
+    if (renderer->textures) {
+        renderer->textures->prev = texture;
+    }
+    renderer->textures = texture;
+    SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, SDL_TRUE);
+
+    /* Reset the state to what a new texture would have */
+    SDL_SetTextureColorModFloat(texture, 1.0f, 1.0f, 1.0f);
+    SDL_SetTextureAlphaModFloat(texture, 1.0f);
+    SDL_SetTextureBlendMode(texture, GetDefaultTextureBlendMode(format));
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_LINEAR);
+    texture->view.viewport.x = 0;
+    texture->view.viewport.y = 0;
+    texture->view.viewport.w = -1;
+    texture->view.viewport.h = -1;
+    SDL_zero(texture->view.clip_rect);
+    texture->view.clipping_enabled = SDL_FALSE;
+    texture->view.scale.x = 1.0f;
+    texture->view.scale.y = 1.0f;
+    UpdatePixelViewport(renderer, &texture->view);
+    UpdatePixelClipRect(renderer, &texture->view);
+
+    texture->SDR_white_point = SDL_GetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT, SDL_GetDefaultSDRWhitePoint(texture->colorspace));
+    texture->HDR_headroom = SDL_GetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT, SDL_GetDefaultHDRHeadroom(texture->colorspace));
+    props = SDL_GetTextureProperties(texture);
+    SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_SDR_WHITE_POINT_FLOAT, texture->SDR_white_point);
+    if (texture->HDR_headroom > 0.0f) {
+        SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT, texture->HDR_headroom);
+    } else {
+        SDL_ClearProperty(props, SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT);
+    }
+    return texture;
+}
+
 SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
 {
     SDL_Texture *texture;
@@ -1331,8 +1842,10 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     SDL_TextureAccess access = (SDL_TextureAccess)SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC);
     int w = (int)SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, 0);
     int h = (int)SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, 0);
+    int layers = (int)SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_LAYERS_NUMBER, 1);
     SDL_Colorspace default_colorspace;
     SDL_bool texture_is_fourcc_and_target;
+    SDL_bool transient;
 
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
@@ -1349,10 +1862,32 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
             return NULL;
         }
     }
+    if (SDL_ISPIXELFORMAT_COMPRESSED(format)) {
+        /* There's no fallback conversion for compressed formats */
+        if (!IsSupportedFormat(renderer, format)) {
+            SDL_SetError("Texture format %s not supported by renderer", SDL_GetPixelFormatName(format));
+            return NULL;
+        }
+        if (access != SDL_TEXTUREACCESS_STATIC) {
+            SDL_SetError("Compressed textures must use SDL_TEXTUREACCESS_STATIC");
+            return NULL;
+        }
+    }
     if (w <= 0 || h <= 0) {
         SDL_SetError("Texture dimensions can't be 0");
         return NULL;
     }
+    if (layers < 1) {
+        SDL_InvalidParamError("layers");
+        return NULL;
+    }
+    if (layers > 1) {
+        if (h > SDL_MAX_SINT32 / layers) {
+            SDL_SetError("Texture dimensions are too large for %d layers", layers);
+            return NULL;
+        }
+        h *= layers;
+    }
     int max_texture_size = (int)SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
     if (max_texture_size && (w > max_texture_size || h > max_texture_size)) {
         SDL_SetError("Texture dimensions are limited to %dx%d", max_texture_size, max_texture_size);
@@ -1361,6 +1896,17 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
 
     default_colorspace = SDL_GetDefaultColorspaceForFormat(format);
 
+    transient = (access == SDL_TEXTUREACCESS_TARGET && layers == 1 && SDL_GetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_TRANSIENT_BOOLEAN, SDL_FALSE));
+    if (transient) {
+        texture = GetPooledRenderTarget(renderer, props, format,
+                                        (SDL_Colorspace)SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, default_colorspace),
+                                        w, h,
+                                        renderer->mipmaps_supported && SDL_GetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_MIPMAPS_BOOLEAN, SDL_FALSE));
+        if (texture) {
+            return texture;
+        }
+    }
+
     texture = (SDL_Texture *)SDL_calloc(1, sizeof(*texture));
     if (!texture) {
         return NULL;
@@ -1371,12 +1917,15 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     texture->access = access;
     texture->w = w;
     texture->h = h;
+    texture->layers = layers;
     texture->color.r = 1.0f;
     texture->color.g = 1.0f;
     texture->color.b = 1.0f;
     texture->color.a = 1.0f;
-    texture->blendMode = SDL_ISPIXELFORMAT_ALPHA(format) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE;
+    texture->blendMode = GetDefaultTextureBlendMode(format);
     texture->scaleMode = SDL_SCALEMODE_LINEAR;
+    texture->mipmaps = renderer->mipmaps_supported && SDL_GetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_MIPMAPS_BOOLEAN, SDL_FALSE);
+    texture->transient = transient;
     texture->view.pixel_w = w;
     texture->view.pixel_h = h;
     texture->view.viewport.w = -1;
@@ -1424,6 +1973,7 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
         SDL_SetNumberProperty(native_props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, texture->access);
         SDL_SetNumberProperty(native_props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, texture->w);
         SDL_SetNumberProperty(native_props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, texture->h);
+        SDL_SetBooleanProperty(native_props, SDL_PROP_TEXTURE_CREATE_MIPMAPS_BOOLEAN, texture->mipmaps);
 
         texture->native = SDL_CreateTextureWithProperties(renderer, native_props);
         SDL_DestroyProperties(native_props);
@@ -1475,10 +2025,15 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_ACCESS_NUMBER, texture->access);
     SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_WIDTH_NUMBER, texture->w);
     SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_HEIGHT_NUMBER, texture->h);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_LAYERS_NUMBER, texture->layers);
+    SDL_SetBooleanProperty(props, SDL_PROP_TEXTURE_MIPMAPS_BOOLEAN, texture->native ? texture->native->mipmaps : texture->mipmaps);
     SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_SDR_WHITE_POINT_FLOAT, texture->SDR_white_point);
     if (texture->HDR_headroom > 0.0f) {
         SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT, texture->HDR_headroom);
     }
+
+    TrackTextureMemory(texture, SDL_TRUE);
+
     return texture;
 }
 
@@ -1527,18 +2082,7 @@ static int SDL_UpdateTextureFromSurface(SDL_Texture *texture, SDL_Rect *rect, SD
     }
 
     surface_colorspace = SDL_GetSurfaceColorspace(surface);
-    texture_colorspace = surface_colorspace;
-
-    if (surface_colorspace == SDL_COLORSPACE_SRGB_LINEAR ||
-        SDL_COLORSPACETRANSFER(surface_colorspace) == SDL_TRANSFER_CHARACTERISTICS_PQ) {
-        if (SDL_ISPIXELFORMAT_FLOAT(tex_format)) {
-            texture_colorspace = SDL_COLORSPACE_SRGB_LINEAR;
-        } else if (SDL_ISPIXELFORMAT_10BIT(tex_format)) {
-            texture_colorspace = SDL_COLORSPACE_HDR10;
-        } else {
-            texture_colorspace = SDL_COLORSPACE_SRGB;
-        }
-    }
+    texture_colorspace = (SDL_Colorspace)SDL_GetNumberProperty(tex_props, SDL_PROP_TEXTURE_COLORSPACE_NUMBER, surface_colorspace);
 
     if (tex_format == surface->format && texture_colorspace == surface_colorspace) {
         if (SDL_ISPIXELFORMAT_ALPHA(surface->format) && SDL_SurfaceHasColorKey(surface)) {
@@ -1607,6 +2151,7 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
     SDL_PropertiesID props;
     SDL_Colorspace surface_colorspace = SDL_COLORSPACE_UNKNOWN;
     SDL_Colorspace texture_colorspace = SDL_COLORSPACE_UNKNOWN;
+    SDL_bool is_hdr, hdr_textures;
 
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
@@ -1632,7 +2177,12 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         }
     }
 
-    texture_colorspace = SDL_GetSurfaceColorspace(surface);
+    surface_colorspace = SDL_GetSurfaceColorspace(surface);
+    texture_colorspace = surface_colorspace;
+
+    is_hdr = (surface_colorspace == SDL_COLORSPACE_SRGB_LINEAR ||
+              SDL_COLORSPACETRANSFER(surface_colorspace) == SDL_TRANSFER_CHARACTERISTICS_PQ);
+    hdr_textures = (is_hdr && SupportsHDRTextures(renderer));
 
     /* Try to have the best pixel format for the texture */
     /* No alpha, but a colorkey => promote to alpha */
@@ -1662,8 +2212,11 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         }
     }
 
-    /* Look for 10-bit pixel formats if needed */
-    if (format == SDL_PIXELFORMAT_UNKNOWN && SDL_ISPIXELFORMAT_10BIT(surface->format)) {
+    /* Look for 10-bit pixel formats if needed, PQ content fits in 10 bits without conversion */
+    if (format == SDL_PIXELFORMAT_UNKNOWN &&
+        (SDL_ISPIXELFORMAT_10BIT(surface->format) ||
+         (hdr_textures && SDL_COLORSPACETRANSFER(surface_colorspace) == SDL_TRANSFER_CHARACTERISTICS_PQ &&
+          SDL_BYTESPERPIXEL(surface->format) <= 4 && !SDL_ISPIXELFORMAT_FLOAT(surface->format)))) {
         for (i = 0; i < renderer->num_texture_formats; ++i) {
             if (SDL_ISPIXELFORMAT_10BIT(renderer->texture_formats[i])) {
                 format = renderer->texture_formats[i];
@@ -1674,7 +2227,7 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
 
     /* Look for floating point pixel formats if needed */
     if (format == SDL_PIXELFORMAT_UNKNOWN &&
-        (SDL_ISPIXELFORMAT_10BIT(surface->format) || SDL_ISPIXELFORMAT_FLOAT(surface->format))) {
+        (SDL_ISPIXELFORMAT_10BIT(surface->format) || SDL_ISPIXELFORMAT_FLOAT(surface->format) || hdr_textures)) {
         for (i = 0; i < renderer->num_texture_formats; ++i) {
             if (SDL_ISPIXELFORMAT_FLOAT(renderer->texture_formats[i])) {
                 format = renderer->texture_formats[i];
@@ -1695,9 +2248,11 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         }
     }
 
-    if (surface_colorspace == SDL_COLORSPACE_SRGB_LINEAR ||
-        SDL_COLORSPACETRANSFER(surface_colorspace) == SDL_TRANSFER_CHARACTERISTICS_PQ) {
-        if (SDL_ISPIXELFORMAT_FLOAT(format)) {
+    if (is_hdr) {
+        if (hdr_textures && (format == surface->format || SDL_ISPIXELFORMAT_FLOAT(format))) {
+            /* Upload as-is, the pixel shaders decode, convert primaries and tone map it */
+            texture_colorspace = surface_colorspace;
+        } else if (SDL_ISPIXELFORMAT_FLOAT(format)) {
             texture_colorspace = SDL_COLORSPACE_SRGB_LINEAR;
         } else if (SDL_ISPIXELFORMAT_10BIT(format)) {
             texture_colorspace = SDL_COLORSPACE_HDR10;
@@ -1712,8 +2267,11 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
         SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_SDR_WHITE_POINT_FLOAT,
                              SDL_GetSurfaceSDRWhitePoint(surface, surface_colorspace));
     }
-    SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT,
-                         SDL_GetSurfaceHDRHeadroom(surface, surface_colorspace));
+    if (!is_hdr || texture_colorspace != SDL_COLORSPACE_SRGB) {
+        /* HDR content is tone mapped to SDR when converted to an sRGB texture */
+        SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_CREATE_HDR_HEADROOM_FLOAT,
+                             SDL_GetSurfaceHDRHeadroom(surface, surface_colorspace));
+    }
     SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, format);
     SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC);
     SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, surface->w);
@@ -1732,7 +2290,77 @@ SDL_Texture *SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *s
     return texture;
 }
 
-SDL_Renderer *SDL_GetRendererFromTexture(SDL_Texture *texture)
+typedef struct LoadBMPTextureData
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+} LoadBMPTextureData;
+
+static SDL_Surface *CreateBMPTextureSurface(int width, int height, SDL_PixelFormat format, void *userdata)
+{
+    LoadBMPTextureData *data = (LoadBMPTextureData *)userdata;
+
+    /* Decode straight into texture memory if the renderer takes the format as is,
+       otherwise load a surface and let SDL_CreateTextureFromSurface() convert it. */
+    if (!SDL_ISPIXELFORMAT_INDEXED(format) && IsSupportedFormat(data->renderer, format)) {
+        SDL_Texture *texture = SDL_CreateTexture(data->renderer, format, SDL_TEXTUREACCESS_STREAMING, width, height);
+        void *pixels;
+        int pitch;
+
+        if (texture && SDL_LockTexture(texture, NULL, &pixels, &pitch) == 0) {
+            SDL_Surface *surface = SDL_CreateSurfaceFrom(width, height, format, pixels, pitch);
+            if (surface) {
+                data->texture = texture;
+                return surface;
+            }
+            SDL_UnlockTexture(texture);
+        }
+        SDL_DestroyTexture(texture);
+    }
+    return SDL_CreateSurface(width, height, format);
+}
+
+SDL_Texture *SDL_LoadBMPTexture_IO(SDL_Renderer *renderer, SDL_IOStream *src, SDL_bool closeio)
+{
+    LoadBMPTextureData data;
+    SDL_Surface *surface;
+    SDL_Texture *texture;
+
+    if (!SDL_ObjectValid(renderer, SDL_OBJECT_TYPE_RENDERER)) {
+        SDL_InvalidParamError("renderer");
+        if (closeio && src) {
+            SDL_CloseIO(src);
+        }
+        return NULL;
+    }
+
+    data.renderer = renderer;
+    data.texture = NULL;
+    surface = SDL_LoadBMP_IO_Internal(src, closeio, CreateBMPTextureSurface, &data);
+    if (data.texture) {
+        SDL_UnlockTexture(data.texture);
+        if (!surface) {
+            SDL_DestroyTexture(data.texture);
+            return NULL;
+        }
+        SDL_DestroySurface(surface);
+        return data.texture;
+    }
+    if (!surface) {
+        return NULL;
+    }
+
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+SDL_Texture *SDL_LoadBMPTexture(SDL_Renderer *renderer, const char *file)
+{
+    return SDL_LoadBMPTexture_IO(renderer, SDL_IOFromFile(file, "rb"), SDL_TRUE);
+}
+
+SDL_Renderer *SDL_GetRendererFromTexture(SDL_Texture *texture)
 {
     CHECK_TEXTURE_MAGIC(texture, NULL);
 
@@ -1965,21 +2593,28 @@ int SDL_GetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode *scaleMode)
 }
 
 #if SDL_HAVE_YUV
+/* Grow rect out to whole chroma samples, so only the changed part of the
+   texture needs to be converted to RGB again */
+static void SDL_AlignYUVRect(SDL_Texture *texture, const SDL_Rect *rect, SDL_Rect *aligned)
+{
+    aligned->x = rect->x & ~1;
+    aligned->y = rect->y & ~1;
+    aligned->w = SDL_min(((rect->x + rect->w + 1) & ~1), texture->w) - aligned->x;
+    aligned->h = SDL_min(((rect->y + rect->h + 1) & ~1), texture->h) - aligned->y;
+}
+
 static int SDL_UpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
                                 const void *pixels, int pitch)
 {
     SDL_Texture *native = texture->native;
-    SDL_Rect full_rect;
+    SDL_Rect aligned_rect;
 
     if (SDL_SW_UpdateYUVTexture(texture->yuv, rect, pixels, pitch) < 0) {
         return -1;
     }
 
-    full_rect.x = 0;
-    full_rect.y = 0;
-    full_rect.w = texture->w;
-    full_rect.h = texture->h;
-    rect = &full_rect;
+    SDL_AlignYUVRect(texture, rect, &aligned_rect);
+    rect = &aligned_rect;
 
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         /* We can lock the texture and copy to it */
@@ -2051,6 +2686,140 @@ static int SDL_UpdateTextureNative(SDL_Texture *texture, const SDL_Rect *rect,
     return 0;
 }
 
+/* Compressed textures can only be updated in whole blocks, except at the right and bottom edges */
+static int ValidateCompressedTextureRect(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    int block_w, block_h;
+
+    if (SDL_GetCompressedFormatBlockSize(texture->format, &block_w, &block_h) == 0) {
+        return 0;
+    }
+    if ((rect->x % block_w) != 0 || (rect->y % block_h) != 0 ||
+        ((rect->w % block_w) != 0 && rect->x + rect->w != texture->w) ||
+        ((rect->h % block_h) != 0 && rect->y + rect->h != texture->h)) {
+        return SDL_SetError("Compressed texture updates must be aligned to %dx%d blocks", block_w, block_h);
+    }
+    return 0;
+}
+
+static int SDL_UpdateTextureInternal(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    if (rect->w == 0 || rect->h == 0) {
+        return 0; /* nothing to do. */
+#if SDL_HAVE_YUV
+    } else if (texture->yuv) {
+        return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
+#endif
+    } else if (texture->native) {
+        return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
+    } else {
+        SDL_Renderer *renderer = texture->renderer;
+        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+            return -1;
+        }
+        return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
+    }
+}
+
+static SDL_PendingTextureUpdate *RemovePendingTextureUpdate(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_PendingTextureUpdate *prev = NULL;
+    SDL_PendingTextureUpdate *update;
+
+    for (update = renderer->pending_updates; update; update = update->next) {
+        if (!texture || update->texture == texture) {
+            if (prev) {
+                prev->next = update->next;
+            } else {
+                renderer->pending_updates = update->next;
+            }
+            if (update == renderer->pending_updates_tail) {
+                renderer->pending_updates_tail = prev;
+            }
+            update->next = NULL;
+            --update->texture->pending_updates;
+            return update;
+        }
+        prev = update;
+    }
+    return NULL;
+}
+
+/* Run the pending updates for a texture, or all textures if texture is NULL, in the order they were scheduled */
+static void CompletePendingTextureUpdates(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_PendingTextureUpdate *update;
+    int count = 0;
+
+    if (texture) {
+        count = texture->pending_updates;
+    } else {
+        for (update = renderer->pending_updates; update; update = update->next) {
+            ++count;
+        }
+    }
+
+    /* Updates are taken off the list one at a time, since callbacks may schedule
+       new updates or destroy textures. New updates wait for the next flush. */
+    while (count-- > 0) {
+        int result;
+
+        update = RemovePendingTextureUpdate(renderer, texture);
+        if (!update) {
+            break;
+        }
+        result = SDL_UpdateTextureInternal(update->texture, &update->rect, update->pixels, update->pitch);
+        if (update->callback) {
+            update->callback(update->userdata, update->texture, result);
+        }
+        SDL_free(update);
+    }
+}
+
+static void CancelPendingTextureUpdates(SDL_Texture *texture)
+{
+    SDL_PendingTextureUpdate *update;
+
+    while (texture->pending_updates > 0) {
+        update = RemovePendingTextureUpdate(texture->renderer, texture);
+        if (!update) {
+            break;
+        }
+        if (update->callback) {
+            SDL_SetError("Texture was destroyed before it was updated");
+            update->callback(update->userdata, texture, -1);
+        }
+        SDL_free(update);
+    }
+}
+
+int SDL_UpdateTextureLayer(SDL_Texture *texture, int layer, const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    SDL_Rect layer_rect;
+    SDL_Rect real_rect;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (layer < 0 || layer >= texture->layers) {
+        return SDL_InvalidParamError("layer");
+    }
+
+    layer_rect.x = 0;
+    layer_rect.y = 0;
+    layer_rect.w = texture->w;
+    layer_rect.h = texture->h / texture->layers;
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, &layer_rect, &real_rect)) {
+            return 0;
+        }
+    } else {
+        real_rect = layer_rect;
+    }
+    real_rect.y += layer_rect.h * layer;
+
+    return SDL_UpdateTexture(texture, &real_rect, pixels, pitch);
+}
+
 int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
 {
     SDL_Rect real_rect;
@@ -2074,21 +2843,64 @@ int SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pi
         }
     }
 
-    if (real_rect.w == 0 || real_rect.h == 0) {
-        return 0; /* nothing to do. */
-#if SDL_HAVE_YUV
-    } else if (texture->yuv) {
-        return SDL_UpdateTextureYUV(texture, &real_rect, pixels, pitch);
-#endif
-    } else if (texture->native) {
-        return SDL_UpdateTextureNative(texture, &real_rect, pixels, pitch);
-    } else {
-        SDL_Renderer *renderer = texture->renderer;
-        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
-            return -1;
+    if (ValidateCompressedTextureRect(texture, &real_rect) < 0) {
+        return -1;
+    }
+
+    CompletePendingTextureUpdates(texture->renderer, texture);
+
+    return SDL_UpdateTextureInternal(texture, &real_rect, pixels, pitch);
+}
+
+int SDL_UpdateTextureAsync(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch, SDL_TextureUpdateCallback callback, void *userdata)
+{
+    SDL_Renderer *renderer;
+    SDL_PendingTextureUpdate *update;
+    SDL_Rect real_rect;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!pixels) {
+        return SDL_InvalidParamError("pixels");
+    }
+    if (!pitch) {
+        return SDL_InvalidParamError("pitch");
+    }
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
+            SDL_zero(real_rect);
         }
-        return renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch);
     }
+    if (ValidateCompressedTextureRect(texture, &real_rect) < 0) {
+        return -1;
+    }
+
+    update = (SDL_PendingTextureUpdate *)SDL_calloc(1, sizeof(*update));
+    if (!update) {
+        return -1;
+    }
+    update->texture = texture;
+    SDL_copyp(&update->rect, &real_rect);
+    update->pixels = pixels;
+    update->pitch = pitch;
+    update->callback = callback;
+    update->userdata = userdata;
+
+    renderer = texture->renderer;
+    if (renderer->pending_updates_tail) {
+        renderer->pending_updates_tail->next = update;
+    } else {
+        renderer->pending_updates = update;
+    }
+    renderer->pending_updates_tail = update;
+    ++texture->pending_updates;
+
+    return 0;
 }
 
 #if SDL_HAVE_YUV
@@ -2098,17 +2910,14 @@ static int SDL_UpdateTextureYUVPlanar(SDL_Texture *texture, const SDL_Rect *rect
                                       const Uint8 *Vplane, int Vpitch)
 {
     SDL_Texture *native = texture->native;
-    SDL_Rect full_rect;
+    SDL_Rect aligned_rect;
 
     if (SDL_SW_UpdateYUVTexturePlanar(texture->yuv, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch) < 0) {
         return -1;
     }
 
-    full_rect.x = 0;
-    full_rect.y = 0;
-    full_rect.w = texture->w;
-    full_rect.h = texture->h;
-    rect = &full_rect;
+    SDL_AlignYUVRect(texture, rect, &aligned_rect);
+    rect = &aligned_rect;
 
     if (!rect->w || !rect->h) {
         return 0; /* nothing to do. */
@@ -2148,17 +2957,14 @@ static int SDL_UpdateTextureNVPlanar(SDL_Texture *texture, const SDL_Rect *rect,
                                      const Uint8 *UVplane, int UVpitch)
 {
     SDL_Texture *native = texture->native;
-    SDL_Rect full_rect;
+    SDL_Rect aligned_rect;
 
     if (SDL_SW_UpdateNVTexturePlanar(texture->yuv, rect, Yplane, Ypitch, UVplane, UVpitch) < 0) {
         return -1;
     }
 
-    full_rect.x = 0;
-    full_rect.y = 0;
-    full_rect.w = texture->w;
-    full_rect.h = texture->h;
-    rect = &full_rect;
+    SDL_AlignYUVRect(texture, rect, &aligned_rect);
+    rect = &aligned_rect;
 
     if (!rect->w || !rect->h) {
         return 0; /* nothing to do. */
@@ -2242,6 +3048,8 @@ int SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect,
         return 0; /* nothing to do. */
     }
 
+    CompletePendingTextureUpdates(texture->renderer, texture);
+
     if (texture->yuv) {
         return SDL_UpdateTextureYUVPlanar(texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
     } else {
@@ -2302,6 +3110,8 @@ int SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect,
         return 0; /* nothing to do. */
     }
 
+    CompletePendingTextureUpdates(texture->renderer, texture);
+
     if (texture->yuv) {
         return SDL_UpdateTextureNVPlanar(texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch);
     } else {
@@ -2351,6 +3161,8 @@ int SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect, void **pixels, i
         return SDL_SetError("SDL_LockTexture(): texture must be streaming");
     }
 
+    CompletePendingTextureUpdates(texture->renderer, texture);
+
     if (!rect) {
         full_rect.x = 0;
         full_rect.y = 0;
@@ -3793,6 +4605,53 @@ int SDL_RenderFillRect(SDL_Renderer *renderer, const SDL_FRect *rect)
     return SDL_RenderFillRects(renderer, rect, 1);
 }
 
+/* Drop rects that are entirely outside the viewport and clip rect, since
+   they'd be clipped away anyway. Rects with a negative size are kept, some
+   backends draw them flipped. Returns the number of rects left. */
+static int CullRectsOutsideView(SDL_Renderer *renderer, SDL_FRect *rects, int count)
+{
+    SDL_FRect bounds;
+    SDL_bool *visible;
+    SDL_bool isstack;
+    int i, numvisible, numkept;
+
+    bounds.x = 0.0f;
+    bounds.y = 0.0f;
+    bounds.w = (float)renderer->view->pixel_viewport.w;
+    bounds.h = (float)renderer->view->pixel_viewport.h;
+    if (renderer->view->clipping_enabled) {
+        SDL_FRect clip_rect;
+
+        clip_rect.x = (float)renderer->view->pixel_clip_rect.x;
+        clip_rect.y = (float)renderer->view->pixel_clip_rect.y;
+        clip_rect.w = (float)renderer->view->pixel_clip_rect.w;
+        clip_rect.h = (float)renderer->view->pixel_clip_rect.h;
+        SDL_GetRectIntersectionFloat(&clip_rect, &bounds, &bounds);
+    }
+
+    visible = SDL_small_alloc(SDL_bool, count, &isstack);
+    if (!visible) {
+        SDL_ClearError();
+        return count;
+    }
+
+    numvisible = SDL_GetRectIntersectionsFloat(rects, count, &bounds, NULL, visible);
+    if (numvisible < 0 || numvisible == count) {
+        SDL_small_free(visible, isstack);
+        return count;
+    }
+
+    numkept = 0;
+    for (i = 0; i < count; ++i) {
+        if (visible[i] || rects[i].w < 0.0f || rects[i].h < 0.0f) {
+            rects[numkept++] = rects[i];
+        }
+    }
+    SDL_small_free(visible, isstack);
+
+    return numkept;
+}
+
 int SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 {
     SDL_FRect *frects;
@@ -3826,64 +4685,332 @@ int SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int coun
         frects[i].w = rects[i].w * renderer->view->scale.x;
         frects[i].h = rects[i].h * renderer->view->scale.y;
     }
+    count = CullRectsOutsideView(renderer, frects, count);
 
-    retval = QueueCmdFillRects(renderer, frects, count);
+    if (count > 0) {
+        retval = QueueCmdFillRects(renderer, frects, count);
+    } else {
+        retval = 0;
+    }
 
     SDL_small_free(frects, isstack);
 
     return retval;
 }
 
-static int SDL_RenderTextureInternal(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+/* Thick lines and circles are built in output pixels, with a fringe this wide that fades to transparent */
+#define AA_FRINGE_WIDTH 1.0f
+
+int SDL_RenderThickLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count, float thickness)
 {
-    int retval;
-    SDL_bool use_rendergeometry = (!renderer->QueueCopy);
+    SDL_bool isstack1;
+    SDL_bool isstack2;
+    SDL_bool isstack3;
+    float *xy;
+    SDL_FColor *colors;
+    int *indices;
+    int retval = -1;
 
-    if (use_rendergeometry) {
-        float xy[8];
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+    if (!points) {
+        return SDL_InvalidParamError("SDL_RenderThickLines(): points");
+    }
+    if (thickness <= 0.0f) {
+        return SDL_InvalidParamError("thickness");
+    }
+    if (count < 2) {
+        return 0;
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    /* Each segment is a quad across its width at each end: outer, inner, inner, outer
+     *
+     *    0----1----2----3
+     *    |  \ |  \ |  \ |
+     *    4----5----6----7
+     */
+    xy = SDL_small_alloc(float, 8 * 2 * (count - 1), &isstack1);
+    colors = SDL_small_alloc(SDL_FColor, 8 * (count - 1), &isstack2);
+    indices = SDL_small_alloc(int, 18 * (count - 1), &isstack3);
+
+    if (xy && colors && indices) {
+        const float scale_x = renderer->view->scale.x;
+        const float scale_y = renderer->view->scale.y;
+        const float width = thickness * (scale_x + scale_y) * 0.5f;
+        const float half_outer = (width * 0.5f) + (AA_FRINGE_WIDTH * 0.5f);
+        const float half_inner = SDL_max((width * 0.5f) - (AA_FRINGE_WIDTH * 0.5f), 0.0f);
+        const float offsets[4] = { -half_outer, -half_inner, half_inner, half_outer };
+        SDL_FColor inner_color = renderer->color;
+        SDL_FColor outer_color = renderer->color;
+        float *ptr_xy = xy;
+        SDL_FColor *ptr_colors = colors;
+        int *ptr_indices = indices;
         const int xy_stride = 2 * sizeof(float);
-        float uv[8];
-        const int uv_stride = 2 * sizeof(float);
-        const int num_vertices = 4;
-        const int *indices = renderer->rect_index_order;
-        const int num_indices = 6;
+        const int color_stride = sizeof(SDL_FColor);
+        int num_vertices = 0;
+        int num_indices = 0;
         const int size_indices = 4;
-        float minu, minv, maxu, maxv;
-        float minx, miny, maxx, maxy;
+        int i, j;
 
-        minu = srcrect->x / texture->w;
-        minv = srcrect->y / texture->h;
-        maxu = (srcrect->x + srcrect->w) / texture->w;
-        maxv = (srcrect->y + srcrect->h) / texture->h;
+        /* Lines thinner than the fringe fade out rather than getting thinner */
+        if (width < AA_FRINGE_WIDTH) {
+            inner_color.a *= width / AA_FRINGE_WIDTH;
+        }
+        outer_color.a = 0.0f;
 
-        minx = dstrect->x;
-        miny = dstrect->y;
-        maxx = dstrect->x + dstrect->w;
-        maxy = dstrect->y + dstrect->h;
+        for (i = 1; i < count; ++i) {
+            float px = points[i - 1].x * scale_x;
+            float py = points[i - 1].y * scale_y;
+            float qx = points[i].x * scale_x;
+            float qy = points[i].y * scale_y;
+            float dx = qx - px;
+            float dy = qy - py;
+            const float length = SDL_sqrtf(dx * dx + dy * dy);
 
-        uv[0] = minu;
-        uv[1] = minv;
-        uv[2] = maxu;
-        uv[3] = minv;
-        uv[4] = maxu;
-        uv[5] = maxv;
-        uv[6] = minu;
-        uv[7] = maxv;
+            if (length <= 0.0f) {
+                continue;
+            }
+            dx /= length;
+            dy /= length;
+
+            /* Square caps, so consecutive segments cover the joint between them */
+            px -= dx * width * 0.5f;
+            py -= dy * width * 0.5f;
+            qx += dx * width * 0.5f;
+            qy += dy * width * 0.5f;
+
+            for (j = 0; j < 4; ++j) {
+                *ptr_xy++ = px - dy * offsets[j];
+                *ptr_xy++ = py + dx * offsets[j];
+                *ptr_colors++ = (j == 0 || j == 3) ? outer_color : inner_color;
+            }
+            for (j = 0; j < 4; ++j) {
+                *ptr_xy++ = qx - dy * offsets[j];
+                *ptr_xy++ = qy + dx * offsets[j];
+                *ptr_colors++ = (j == 0 || j == 3) ? outer_color : inner_color;
+            }
+            for (j = 0; j < 3; ++j) {
+                *ptr_indices++ = num_vertices + j;
+                *ptr_indices++ = num_vertices + j + 1;
+                *ptr_indices++ = num_vertices + j + 5;
+                *ptr_indices++ = num_vertices + j;
+                *ptr_indices++ = num_vertices + j + 5;
+                *ptr_indices++ = num_vertices + j + 4;
+            }
+            num_vertices += 8;
+            num_indices += 18;
+        }
 
-        xy[0] = minx;
-        xy[1] = miny;
-        xy[2] = maxx;
-        xy[3] = miny;
-        xy[4] = maxx;
-        xy[5] = maxy;
-        xy[6] = minx;
-        xy[7] = maxy;
+        if (num_vertices > 0) {
+            retval = QueueCmdGeometry(renderer, NULL,
+                                      xy, xy_stride, colors, color_stride, NULL, 0,
+                                      num_vertices, indices, num_indices, size_indices,
+                                      1.0f, 1.0f, SDL_TEXTURE_ADDRESS_CLAMP);
+        } else {
+            retval = 0;
+        }
+    }
 
-        retval = QueueCmdGeometry(renderer, texture,
-                                  xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
-                                  num_vertices,
-                                  indices, num_indices, size_indices,
-                                  renderer->view->scale.x,
+    SDL_small_free(xy, isstack1);
+    SDL_small_free(colors, isstack2);
+    SDL_small_free(indices, isstack3);
+
+    return retval;
+}
+
+int SDL_RenderFillCircles(SDL_Renderer *renderer, const SDL_FPoint *centers, int count, float radius)
+{
+    SDL_bool isstack1;
+    SDL_bool isstack2;
+    SDL_bool isstack3;
+    SDL_bool isstack4;
+    float *xy;
+    SDL_FColor *colors;
+    int *indices;
+    float *directions;
+    float radius_px, inner_radius, outer_radius;
+    int num_segments;
+    int retval = -1;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+    if (!centers) {
+        return SDL_InvalidParamError("SDL_RenderFillCircles(): centers");
+    }
+    if (radius <= 0.0f) {
+        return SDL_InvalidParamError("radius");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    radius_px = radius * (renderer->view->scale.x + renderer->view->scale.y) * 0.5f;
+    inner_radius = SDL_max(radius_px - (AA_FRINGE_WIDTH * 0.5f), 0.0f);
+    outer_radius = radius_px + (AA_FRINGE_WIDTH * 0.5f);
+
+    /* Enough segments to keep the outline within a quarter pixel of a true circle */
+    if (outer_radius > 0.25f) {
+        num_segments = (int)SDL_ceilf(SDL_PI_F / SDL_acosf(1.0f - 0.25f / outer_radius));
+    } else {
+        num_segments = 0;
+    }
+    num_segments = SDL_clamp(num_segments, 8, 512);
+
+    /* Each circle is a center vertex, an inner ring of opaque vertices and an outer ring of transparent ones */
+    directions = SDL_small_alloc(float, 2 * num_segments, &isstack1);
+    xy = SDL_small_alloc(float, 2 * (1 + 2 * num_segments) * count, &isstack2);
+    colors = SDL_small_alloc(SDL_FColor, (1 + 2 * num_segments) * count, &isstack3);
+    indices = SDL_small_alloc(int, 9 * num_segments * count, &isstack4);
+
+    if (directions && xy && colors && indices) {
+        const float scale_x = renderer->view->scale.x;
+        const float scale_y = renderer->view->scale.y;
+        SDL_FColor inner_color = renderer->color;
+        SDL_FColor outer_color = renderer->color;
+        float *ptr_xy = xy;
+        SDL_FColor *ptr_colors = colors;
+        int *ptr_indices = indices;
+        const int xy_stride = 2 * sizeof(float);
+        const int color_stride = sizeof(SDL_FColor);
+        const int num_vertices = (1 + 2 * num_segments) * count;
+        const int num_indices = 9 * num_segments * count;
+        const int size_indices = 4;
+        int cur_index = 0;
+        int i, j;
+
+        /* Circles smaller than the fringe fade out rather than getting smaller */
+        if (radius_px * 2.0f < AA_FRINGE_WIDTH) {
+            inner_color.a *= (radius_px * 2.0f) / AA_FRINGE_WIDTH;
+        }
+        outer_color.a = 0.0f;
+
+        for (j = 0; j < num_segments; ++j) {
+            const float angle = (2.0f * SDL_PI_F * j) / num_segments;
+            directions[j * 2 + 0] = SDL_cosf(angle);
+            directions[j * 2 + 1] = SDL_sinf(angle);
+        }
+
+        for (i = 0; i < count; ++i) {
+            const float cx = centers[i].x * scale_x;
+            const float cy = centers[i].y * scale_y;
+
+            *ptr_xy++ = cx;
+            *ptr_xy++ = cy;
+            *ptr_colors++ = inner_color;
+            for (j = 0; j < num_segments; ++j) {
+                *ptr_xy++ = cx + directions[j * 2 + 0] * inner_radius;
+                *ptr_xy++ = cy + directions[j * 2 + 1] * inner_radius;
+                *ptr_colors++ = inner_color;
+            }
+            for (j = 0; j < num_segments; ++j) {
+                *ptr_xy++ = cx + directions[j * 2 + 0] * outer_radius;
+                *ptr_xy++ = cy + directions[j * 2 + 1] * outer_radius;
+                *ptr_colors++ = outer_color;
+            }
+
+            for (j = 0; j < num_segments; ++j) {
+                const int next = (j + 1) % num_segments;
+                const int inner = cur_index + 1;
+                const int outer = cur_index + 1 + num_segments;
+
+                *ptr_indices++ = cur_index;
+                *ptr_indices++ = inner + j;
+                *ptr_indices++ = inner + next;
+
+                *ptr_indices++ = inner + j;
+                *ptr_indices++ = outer + j;
+                *ptr_indices++ = outer + next;
+                *ptr_indices++ = inner + j;
+                *ptr_indices++ = outer + next;
+                *ptr_indices++ = inner + next;
+            }
+            cur_index += 1 + 2 * num_segments;
+        }
+
+        retval = QueueCmdGeometry(renderer, NULL,
+                                  xy, xy_stride, colors, color_stride, NULL, 0,
+                                  num_vertices, indices, num_indices, size_indices,
+                                  1.0f, 1.0f, SDL_TEXTURE_ADDRESS_CLAMP);
+    }
+
+    SDL_small_free(directions, isstack1);
+    SDL_small_free(xy, isstack2);
+    SDL_small_free(colors, isstack3);
+    SDL_small_free(indices, isstack4);
+
+    return retval;
+}
+
+static int SDL_RenderTextureInternal(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+{
+    int retval;
+    SDL_bool use_rendergeometry = (!renderer->QueueCopy);
+
+    if (use_rendergeometry) {
+        float xy[8];
+        const int xy_stride = 2 * sizeof(float);
+        float uv[8];
+        const int uv_stride = 2 * sizeof(float);
+        const int num_vertices = 4;
+        const int *indices = renderer->rect_index_order;
+        const int num_indices = 6;
+        const int size_indices = 4;
+        float minu, minv, maxu, maxv;
+        float minx, miny, maxx, maxy;
+
+        minu = srcrect->x / texture->w;
+        minv = srcrect->y / texture->h;
+        maxu = (srcrect->x + srcrect->w) / texture->w;
+        maxv = (srcrect->y + srcrect->h) / texture->h;
+
+        minx = dstrect->x;
+        miny = dstrect->y;
+        maxx = dstrect->x + dstrect->w;
+        maxy = dstrect->y + dstrect->h;
+
+        uv[0] = minu;
+        uv[1] = minv;
+        uv[2] = maxu;
+        uv[3] = minv;
+        uv[4] = maxu;
+        uv[5] = maxv;
+        uv[6] = minu;
+        uv[7] = maxv;
+
+        xy[0] = minx;
+        xy[1] = miny;
+        xy[2] = maxx;
+        xy[3] = miny;
+        xy[4] = maxx;
+        xy[5] = maxy;
+        xy[6] = minx;
+        xy[7] = maxy;
+
+        retval = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
+                                  num_vertices,
+                                  indices, num_indices, size_indices,
+                                  renderer->view->scale.x,
                                   renderer->view->scale.y, SDL_TEXTURE_ADDRESS_CLAMP);
     } else {
         SDL_FRect rect;
@@ -3898,6 +5025,106 @@ static int SDL_RenderTextureInternal(SDL_Renderer *renderer, SDL_Texture *textur
     return retval;
 }
 
+/* Queue a batch of copies from one texture, as a single geometry command when the backend draws copies with geometry */
+static int SDL_RenderTextureRects(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrects, const SDL_FRect *dstrects, int count)
+{
+    SDL_bool isstack1;
+    SDL_bool isstack2;
+    SDL_bool isstack3;
+    float *xy;
+    float *uv;
+    int *indices;
+    int retval = -1;
+    int i;
+
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (renderer->QueueCopy || count == 1) {
+        for (i = 0; i < count; ++i) {
+            if (SDL_RenderTextureInternal(renderer, texture, &srcrects[i], &dstrects[i]) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    xy = SDL_small_alloc(float, 4 * 2 * count, &isstack1);
+    uv = SDL_small_alloc(float, 4 * 2 * count, &isstack2);
+    indices = SDL_small_alloc(int, 6 * count, &isstack3);
+
+    if (xy && uv && indices) {
+        float *ptr_xy = xy;
+        float *ptr_uv = uv;
+        int *ptr_indices = indices;
+        const int xy_stride = 2 * sizeof(float);
+        const int uv_stride = 2 * sizeof(float);
+        const int num_vertices = 4 * count;
+        const int num_indices = 6 * count;
+        const int size_indices = 4;
+        const float texw = (float)texture->w;
+        const float texh = (float)texture->h;
+        int cur_index = 0;
+        const int *rect_index_order = renderer->rect_index_order;
+
+        for (i = 0; i < count; ++i) {
+            const SDL_FRect *src = &srcrects[i];
+            const SDL_FRect *dst = &dstrects[i];
+            float minu, minv, maxu, maxv;
+            float minx, miny, maxx, maxy;
+
+            minu = src->x / texw;
+            minv = src->y / texh;
+            maxu = (src->x + src->w) / texw;
+            maxv = (src->y + src->h) / texh;
+
+            minx = dst->x;
+            miny = dst->y;
+            maxx = dst->x + dst->w;
+            maxy = dst->y + dst->h;
+
+            *ptr_uv++ = minu;
+            *ptr_uv++ = minv;
+            *ptr_uv++ = maxu;
+            *ptr_uv++ = minv;
+            *ptr_uv++ = maxu;
+            *ptr_uv++ = maxv;
+            *ptr_uv++ = minu;
+            *ptr_uv++ = maxv;
+
+            *ptr_xy++ = minx;
+            *ptr_xy++ = miny;
+            *ptr_xy++ = maxx;
+            *ptr_xy++ = miny;
+            *ptr_xy++ = maxx;
+            *ptr_xy++ = maxy;
+            *ptr_xy++ = minx;
+            *ptr_xy++ = maxy;
+
+            *ptr_indices++ = cur_index + rect_index_order[0];
+            *ptr_indices++ = cur_index + rect_index_order[1];
+            *ptr_indices++ = cur_index + rect_index_order[2];
+            *ptr_indices++ = cur_index + rect_index_order[3];
+            *ptr_indices++ = cur_index + rect_index_order[4];
+            *ptr_indices++ = cur_index + rect_index_order[5];
+            cur_index += 4;
+        }
+
+        retval = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, &texture->color, 0 /* color_stride */, uv, uv_stride,
+                                  num_vertices,
+                                  indices, num_indices, size_indices,
+                                  renderer->view->scale.x,
+                                  renderer->view->scale.y, SDL_TEXTURE_ADDRESS_CLAMP);
+    }
+    SDL_small_free(xy, isstack1);
+    SDL_small_free(uv, isstack2);
+    SDL_small_free(indices, isstack3);
+
+    return retval;
+}
+
 int SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
 {
     SDL_FRect real_srcrect;
@@ -3944,6 +5171,42 @@ int SDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FR
     return SDL_RenderTextureInternal(renderer, texture, &real_srcrect, &real_dstrect);
 }
 
+/* Offset a rectangle within a layer into the texture, clipped to the layer */
+static SDL_bool GetTextureLayerRect(SDL_Texture *texture, int layer, const SDL_FRect *rect, SDL_FRect *result)
+{
+    SDL_FRect layer_rect;
+
+    layer_rect.x = 0.0f;
+    layer_rect.y = 0.0f;
+    layer_rect.w = (float)texture->w;
+    layer_rect.h = (float)(texture->h / texture->layers);
+    if (rect) {
+        if (!SDL_GetRectIntersectionFloat(rect, &layer_rect, result)) {
+            return SDL_FALSE;
+        }
+    } else {
+        *result = layer_rect;
+    }
+    result->y += layer_rect.h * layer;
+    return SDL_TRUE;
+}
+
+int SDL_RenderTextureLayer(SDL_Renderer *renderer, SDL_Texture *texture, int layer, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL_FRect real_srcrect;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (layer < 0 || layer >= texture->layers) {
+        return SDL_InvalidParamError("layer");
+    }
+
+    if (!GetTextureLayerRect(texture, layer, srcrect, &real_srcrect)) {
+        return 0;
+    }
+    return SDL_RenderTexture(renderer, texture, &real_srcrect, dstrect);
+}
+
 int SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
                       const SDL_FRect *srcrect, const SDL_FRect *dstrect,
                       const double angle, const SDL_FPoint *center, const SDL_FlipMode flip)
@@ -4148,6 +5411,27 @@ static int SDL_RenderTextureTiled_Wrap(SDL_Renderer *renderer, SDL_Texture *text
                             renderer->view->scale.y, SDL_TEXTURE_ADDRESS_WRAP);
 }
 
+/* Tiles are queued in batches of this many copies, to bound the temporary vertex storage */
+#define TILE_BATCH_SIZE 64
+
+typedef struct SDL_TileBatch
+{
+    SDL_FRect src[TILE_BATCH_SIZE];
+    SDL_FRect dst[TILE_BATCH_SIZE];
+    int count;
+} SDL_TileBatch;
+
+static int SDL_AddTileToBatch(SDL_Renderer *renderer, SDL_Texture *texture, SDL_TileBatch *batch, const SDL_FRect *src, const SDL_FRect *dst)
+{
+    batch->src[batch->count] = *src;
+    batch->dst[batch->count] = *dst;
+    if (++batch->count == TILE_BATCH_SIZE) {
+        batch->count = 0;
+        return SDL_RenderTextureRects(renderer, texture, batch->src, batch->dst, TILE_BATCH_SIZE);
+    }
+    return 0;
+}
+
 static int SDL_RenderTextureTiled_Iterate(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect)
 {
     float tile_width = srcrect->w * scale;
@@ -4162,6 +5446,9 @@ static int SDL_RenderTextureTiled_Iterate(SDL_Renderer *renderer, SDL_Texture *t
     int rows = (int)float_rows;
     int cols = (int)float_cols;
     SDL_FRect curr_src, curr_dst;
+    SDL_TileBatch batch;
+
+    batch.count = 0;
 
     SDL_copyp(&curr_src, srcrect);
     curr_dst.y = dstrect->y;
@@ -4170,7 +5457,7 @@ static int SDL_RenderTextureTiled_Iterate(SDL_Renderer *renderer, SDL_Texture *t
     for (int y = 0; y < rows; ++y) {
         curr_dst.x = dstrect->x;
         for (int x = 0; x < cols; ++x) {
-            if (SDL_RenderTextureInternal(renderer, texture, &curr_src, &curr_dst) < 0) {
+            if (SDL_AddTileToBatch(renderer, texture, &batch, &curr_src, &curr_dst) < 0) {
                 return -1;
             }
             curr_dst.x += curr_dst.w;
@@ -4178,7 +5465,7 @@ static int SDL_RenderTextureTiled_Iterate(SDL_Renderer *renderer, SDL_Texture *t
         if (remaining_dst_w > 0.0f) {
             curr_src.w = remaining_src_w;
             curr_dst.w = remaining_dst_w;
-            if (SDL_RenderTextureInternal(renderer, texture, &curr_src, &curr_dst) < 0) {
+            if (SDL_AddTileToBatch(renderer, texture, &batch, &curr_src, &curr_dst) < 0) {
                 return -1;
             }
             curr_src.w = srcrect->w;
@@ -4191,7 +5478,7 @@ static int SDL_RenderTextureTiled_Iterate(SDL_Renderer *renderer, SDL_Texture *t
         curr_dst.h = remaining_dst_h;
         curr_dst.x = dstrect->x;
         for (int x = 0; x < cols; ++x) {
-            if (SDL_RenderTextureInternal(renderer, texture, &curr_src, &curr_dst) < 0) {
+            if (SDL_AddTileToBatch(renderer, texture, &batch, &curr_src, &curr_dst) < 0) {
                 return -1;
             }
             curr_dst.x += curr_dst.w;
@@ -4199,12 +5486,12 @@ static int SDL_RenderTextureTiled_Iterate(SDL_Renderer *renderer, SDL_Texture *t
         if (remaining_dst_w > 0.0f) {
             curr_src.w = remaining_src_w;
             curr_dst.w = remaining_dst_w;
-            if (SDL_RenderTextureInternal(renderer, texture, &curr_src, &curr_dst) < 0) {
+            if (SDL_AddTileToBatch(renderer, texture, &batch, &curr_src, &curr_dst) < 0) {
                 return -1;
             }
         }
     }
-    return 0;
+    return SDL_RenderTextureRects(renderer, texture, batch.src, batch.dst, batch.count);
 }
 
 int SDL_RenderTextureTiled(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect)
@@ -4265,10 +5552,41 @@ int SDL_RenderTextureTiled(SDL_Renderer *renderer, SDL_Texture *texture, const S
     }
 }
 
+static void SDL_Add9GridPiece(SDL_Texture *texture, SDL_FRect *srcrects, SDL_FRect *dstrects, int *count, const SDL_FRect *src, const SDL_FRect *dst)
+{
+    SDL_FRect bounds;
+    SDL_FRect *real_src = &srcrects[*count];
+    SDL_FRect *real_dst = &dstrects[*count];
+    float scale_x, scale_y;
+
+    // Empty pieces are skipped, the same as SDL_RenderTexture() would
+    if (src->w <= 0.0f || src->h <= 0.0f || dst->w <= 0.0f || dst->h <= 0.0f) {
+        return;
+    }
+
+    // Clip the source to the texture, and trim the destination by the same amount
+    bounds.x = 0.0f;
+    bounds.y = 0.0f;
+    bounds.w = (float)texture->w;
+    bounds.h = (float)texture->h;
+    if (!SDL_GetRectIntersectionFloat(src, &bounds, real_src)) {
+        return;
+    }
+    scale_x = dst->w / src->w;
+    scale_y = dst->h / src->h;
+    real_dst->x = dst->x + (real_src->x - src->x) * scale_x;
+    real_dst->y = dst->y + (real_src->y - src->y) * scale_y;
+    real_dst->w = real_src->w * scale_x;
+    real_dst->h = real_src->h * scale_y;
+    ++*count;
+}
+
 int SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float left_width, float right_width, float top_height, float bottom_height, float scale, const SDL_FRect *dstrect)
 {
     SDL_FRect full_src, full_dst;
     SDL_FRect curr_src, curr_dst;
+    SDL_FRect srcrects[9], dstrects[9];
+    int count = 0;
     float dst_left_width;
     float dst_right_width;
     float dst_top_height;
@@ -4306,6 +5624,19 @@ int SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const S
         dst_bottom_height = (bottom_height * scale);
     }
 
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    texture->last_command_generation = renderer->render_command_generation;
+
     // Upper-left corner
     curr_src.x = srcrect->x;
     curr_src.y = srcrect->y;
@@ -4315,53 +5646,41 @@ int SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const S
     curr_dst.y = dstrect->y;
     curr_dst.w = dst_left_width;
     curr_dst.h = dst_top_height;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Upper-right corner
     curr_src.x = srcrect->x + srcrect->w - right_width;
     curr_src.w = right_width;
     curr_dst.x = dstrect->x + dstrect->w - dst_right_width;
     curr_dst.w = dst_right_width;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Lower-right corner
     curr_src.y = srcrect->y + srcrect->h - bottom_height;
     curr_dst.y = dstrect->y + dstrect->h - dst_bottom_height;
     curr_dst.h = dst_bottom_height;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Lower-left corner
     curr_src.x = srcrect->x;
     curr_src.w = left_width;
     curr_dst.x = dstrect->x;
     curr_dst.w = dst_left_width;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Left
     curr_src.y = srcrect->y + top_height;
     curr_src.h = srcrect->h - top_height - bottom_height;
     curr_dst.y = dstrect->y + dst_top_height;
     curr_dst.h = dstrect->h - dst_top_height - dst_bottom_height;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Right
     curr_src.x = srcrect->x + srcrect->w - right_width;
     curr_src.w = right_width;
     curr_dst.x = dstrect->x + dstrect->w - dst_right_width;
     curr_dst.w = dst_right_width;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Top
     curr_src.x = srcrect->x + left_width;
@@ -4372,17 +5691,13 @@ int SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const S
     curr_dst.y = dstrect->y;
     curr_dst.w = dstrect->w - dst_left_width - dst_right_width;
     curr_dst.h = dst_top_height;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Bottom
     curr_src.y = srcrect->y + srcrect->h - bottom_height;
     curr_dst.y = dstrect->y + dstrect->h - dst_bottom_height;
     curr_dst.h = dst_bottom_height;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
     // Center
     curr_src.x = srcrect->x + left_width;
@@ -4393,11 +5708,9 @@ int SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const S
     curr_dst.y = dstrect->y + dst_top_height;
     curr_dst.w = dstrect->w - dst_left_width - dst_right_width;
     curr_dst.h = dstrect->h - dst_top_height - dst_bottom_height;
-    if (SDL_RenderTexture(renderer, texture, &curr_src, &curr_dst) < 0) {
-        return -1;
-    }
+    SDL_Add9GridPiece(texture, srcrects, dstrects, &count, &curr_src, &curr_dst);
 
-    return 0;
+    return SDL_RenderTextureRects(renderer, texture, srcrects, dstrects, count);
 }
 
 int SDL_RenderGeometry(SDL_Renderer *renderer,
@@ -4906,75 +6219,783 @@ int SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                               renderer->view->scale.y, texture_address_mode);
 }
 
-SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+SDL_RenderShader *SDL_CreateRenderShader(SDL_Renderer *renderer, SDL_PropertiesID props)
 {
-    SDL_Rect real_rect;
-    SDL_Surface *surface;
+    SDL_RenderShader *shader;
 
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
-    if (!renderer->RenderReadPixels) {
+    if (!renderer->CreateShader) {
         SDL_Unsupported();
         return NULL;
     }
 
-    FlushRenderCommands(renderer); /* we need to render before we read the results. */
-
-    real_rect = renderer->view->pixel_viewport;
+    shader = (SDL_RenderShader *)SDL_calloc(1, sizeof(*shader));
+    if (!shader) {
+        return NULL;
+    }
+    shader->renderer = renderer;
 
-    if (rect) {
-        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
-            return NULL;
-        }
+    if (renderer->CreateShader(renderer, shader, props) < 0) {
+        SDL_free(shader);
+        return NULL;
     }
 
-    surface = renderer->RenderReadPixels(renderer, &real_rect);
-    if (surface) {
-        SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+    SDL_SetObjectValid(shader, SDL_OBJECT_TYPE_RENDER_SHADER, SDL_TRUE);
 
-        if (renderer->target) {
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, renderer->target->SDR_white_point);
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, renderer->target->HDR_headroom);
-        } else {
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, renderer->SDR_white_point);
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, renderer->HDR_headroom);
-        }
+    shader->next = renderer->shaders;
+    if (renderer->shaders) {
+        renderer->shaders->prev = shader;
     }
-    return surface;
+    renderer->shaders = shader;
+
+    return shader;
 }
 
-static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
+int SDL_SetRenderShader(SDL_Renderer *renderer, SDL_RenderShader *shader)
 {
-    SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(renderer->window), SDL_PROP_WINDOW_SHAPE_POINTER, NULL);
-    if (shape != renderer->shape_surface) {
-        if (renderer->shape_texture) {
-            SDL_DestroyTexture(renderer->shape_texture);
-            renderer->shape_texture = NULL;
-        }
-
-        if (shape) {
-            /* There's nothing we can do if this fails, so just keep on going */
-            renderer->shape_texture = SDL_CreateTextureFromSurface(renderer, shape);
+    CHECK_RENDERER_MAGIC(renderer, -1);
 
-            SDL_SetTextureBlendMode(renderer->shape_texture,
-                SDL_ComposeCustomBlendMode(
-                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
-                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+    if (shader) {
+        if (!SDL_ObjectValid(shader, SDL_OBJECT_TYPE_RENDER_SHADER)) {
+            return SDL_InvalidParamError("shader");
+        }
+        if (shader->renderer != renderer) {
+            return SDL_SetError("Shader was not created with this renderer");
         }
-        renderer->shape_surface = shape;
     }
 
-    if (renderer->shape_texture) {
-        SDL_RenderTexture(renderer, renderer->shape_texture, NULL, NULL);
-    }
+    renderer->shader = shader;
+    return 0;
 }
 
-static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
+void SDL_DestroyRenderShader(SDL_RenderShader *shader)
 {
-    Uint64 now, elapsed;
-    const Uint64 interval = renderer->simulate_vsync_interval_ns;
+    SDL_Renderer *renderer;
 
-    if (!interval) {
+    if (!SDL_ObjectValid(shader, SDL_OBJECT_TYPE_RENDER_SHADER)) {
+        return;
+    }
+
+    renderer = shader->renderer;
+
+    /* Queued draws may still use the shader */
+    if (!renderer->destroyed) {
+        FlushRenderCommandsIfShaderNeeded(shader);
+    }
+    if (renderer->shader == shader) {
+        renderer->shader = NULL;
+    }
+
+    if (shader->next) {
+        shader->next->prev = shader->prev;
+    }
+    if (shader->prev) {
+        shader->prev->next = shader->next;
+    } else {
+        renderer->shaders = shader->next;
+    }
+
+    SDL_SetObjectValid(shader, SDL_OBJECT_TYPE_RENDER_SHADER, SDL_FALSE);
+
+    if (renderer->DestroyShader) {
+        renderer->DestroyShader(renderer, shader);
+    }
+    SDL_free(shader);
+}
+
+/* Expand texture instances into quads, four vertices and six indices per instance. */
+static void GenerateInstanceGeometry(const SDL_TextureInstance *instances, int count, int texw, int texh,
+                                     const SDL_FColor *modulate, const int *rect_index_order, int index_base,
+                                     SDL_Vertex *vertices, int *indices)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        const SDL_TextureInstance *instance = &instances[i];
+        SDL_Vertex *verts = &vertices[i * 4];
+        int *ptr_indices = &indices[i * 6];
+        const float minx = instance->dstrect.x;
+        const float miny = instance->dstrect.y;
+        const float maxx = instance->dstrect.x + instance->dstrect.w;
+        const float maxy = instance->dstrect.y + instance->dstrect.h;
+        const float minu = instance->srcrect.x / texw;
+        const float minv = instance->srcrect.y / texh;
+        const float maxu = (instance->srcrect.x + instance->srcrect.w) / texw;
+        const float maxv = (instance->srcrect.y + instance->srcrect.h) / texh;
+        SDL_FColor color;
+        int j;
+
+        color.r = instance->color.r * modulate->r;
+        color.g = instance->color.g * modulate->g;
+        color.b = instance->color.b * modulate->b;
+        color.a = instance->color.a * modulate->a;
+
+        verts[0].position.x = minx;
+        verts[0].position.y = miny;
+        verts[0].tex_coord.x = minu;
+        verts[0].tex_coord.y = minv;
+        verts[1].position.x = maxx;
+        verts[1].position.y = miny;
+        verts[1].tex_coord.x = maxu;
+        verts[1].tex_coord.y = minv;
+        verts[2].position.x = maxx;
+        verts[2].position.y = maxy;
+        verts[2].tex_coord.x = maxu;
+        verts[2].tex_coord.y = maxv;
+        verts[3].position.x = minx;
+        verts[3].position.y = maxy;
+        verts[3].tex_coord.x = minu;
+        verts[3].tex_coord.y = maxv;
+
+        if (instance->angle != 0.0f) {
+            /* apply rotation with 2x2 matrix ( c -s )
+             *                                ( s  c ) */
+            const float radian_angle = (SDL_PI_F * instance->angle) / 180.0f;
+            const float s = SDL_sinf(radian_angle);
+            const float c = SDL_cosf(radian_angle);
+            const float centerx = minx + instance->dstrect.w / 2.0f;
+            const float centery = miny + instance->dstrect.h / 2.0f;
+
+            for (j = 0; j < 4; ++j) {
+                const float x = verts[j].position.x - centerx;
+                const float y = verts[j].position.y - centery;
+                verts[j].position.x = (c * x - s * y) + centerx;
+                verts[j].position.y = (s * x + c * y) + centery;
+            }
+        }
+
+        for (j = 0; j < 4; ++j) {
+            verts[j].color = color;
+        }
+
+        for (j = 0; j < 6; ++j) {
+            ptr_indices[j] = index_base + (i * 4) + rect_index_order[j];
+        }
+    }
+}
+
+int SDL_RenderTextureInstanced(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureInstance *instances, int count)
+{
+    SDL_Vertex *vertices;
+    int *indices;
+    SDL_bool isstack1;
+    SDL_bool isstack2;
+    int retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+    if (!instances) {
+        return SDL_InvalidParamError("instances");
+    }
+    /* The vertex buffer is the largest allocation, 4 vertices per instance */
+    if (count < 0 || count > (SDL_MAX_SINT32 / 6) ||
+        (size_t)count > SDL_SIZE_MAX / (4 * sizeof(SDL_Vertex))) {
+        return SDL_InvalidParamError("count");
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    vertices = SDL_small_alloc(SDL_Vertex, 4 * count, &isstack1);
+    indices = SDL_small_alloc(int, 6 * count, &isstack2);
+    if (!vertices || !indices) {
+        SDL_small_free(vertices, isstack1);
+        SDL_small_free(indices, isstack2);
+        return -1;
+    }
+
+    GenerateInstanceGeometry(instances, count, texture->w, texture->h, &texture->color,
+                             renderer->rect_index_order, 0, vertices, indices);
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+#if SDL_VIDEO_RENDER_SW
+    if (renderer->software) {
+        retval = SDL_SW_RenderGeometryRaw(renderer, texture,
+                                          &vertices->position.x, sizeof(*vertices),
+                                          &vertices->color, sizeof(*vertices),
+                                          &vertices->tex_coord.x, sizeof(*vertices),
+                                          4 * count, indices, 6 * count, sizeof(*indices));
+    } else
+#endif
+    {
+        retval = QueueCmdGeometry(renderer, texture,
+                                  &vertices->position.x, sizeof(*vertices),
+                                  &vertices->color, sizeof(*vertices),
+                                  &vertices->tex_coord.x, sizeof(*vertices),
+                                  4 * count, indices, 6 * count, sizeof(*indices),
+                                  renderer->view->scale.x,
+                                  renderer->view->scale.y, SDL_TEXTURE_ADDRESS_CLAMP);
+    }
+
+    SDL_small_free(vertices, isstack1);
+    SDL_small_free(indices, isstack2);
+    return retval;
+}
+
+/* The debug font atlas is a grid of glyphs, 16 to a row */
+#define DEBUG_FONT_ATLAS_COLUMNS 16
+#define DEBUG_FONT_ATLAS_ROWS ((SDL_DEBUG_FONT_NUM_GLYPHS + DEBUG_FONT_ATLAS_COLUMNS - 1) / DEBUG_FONT_ATLAS_COLUMNS)
+
+static SDL_Texture *GetDebugFontTexture(SDL_Renderer *renderer)
+{
+    const int w = DEBUG_FONT_ATLAS_COLUMNS * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    const int h = DEBUG_FONT_ATLAS_ROWS * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    SDL_Texture *texture;
+    Uint32 *pixels;
+    int glyph;
+
+    if (renderer->debug_font) {
+        return renderer->debug_font;
+    }
+
+    /* White pixels with alpha coverage, so the draw color can be applied as vertex color */
+    pixels = (Uint32 *)SDL_calloc((size_t)w * h, sizeof(*pixels));
+    if (!pixels) {
+        return NULL;
+    }
+    for (glyph = 0; glyph < SDL_DEBUG_FONT_NUM_GLYPHS; ++glyph) {
+        const Uint8 *rows = &SDL_RenderDebugTextFontData[glyph * 8];
+        Uint32 *dst = pixels + (glyph / DEBUG_FONT_ATLAS_COLUMNS) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE * w +
+                      (glyph % DEBUG_FONT_ATLAS_COLUMNS) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+        int iy, ix;
+
+        for (iy = 0; iy < 8; ++iy, dst += w) {
+            for (ix = 0; ix < 8; ++ix) {
+                if (rows[iy] & (1 << ix)) {
+                    dst[ix] = 0xFFFFFFFF;
+                }
+            }
+        }
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, w, h);
+    if (texture) {
+        if (SDL_UpdateTexture(texture, NULL, pixels, w * sizeof(*pixels)) < 0 ||
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND) < 0 ||
+            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST) < 0) {
+            SDL_DestroyTexture(texture);
+            texture = NULL;
+        }
+    }
+    SDL_free(pixels);
+
+    renderer->debug_font = texture;
+    return texture;
+}
+
+int SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *str)
+{
+    const float size = (float)SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    SDL_TextureInstance *instances;
+    SDL_Texture *texture;
+    SDL_bool isstack;
+    size_t len;
+    int count = 0;
+    int retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!str) {
+        return SDL_InvalidParamError("str");
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+#endif
+
+    len = SDL_strlen(str);
+    if (len == 0) {
+        return 0;
+    }
+    if (len > (size_t)(SDL_MAX_SINT32 / 6)) {
+        return SDL_InvalidParamError("str");
+    }
+
+    texture = GetDebugFontTexture(renderer);
+    if (!texture) {
+        return -1;
+    }
+
+    /* Every glyph takes at least one byte, so the string length bounds the instance count */
+    instances = SDL_small_alloc(SDL_TextureInstance, len, &isstack);
+    if (!instances) {
+        return -1;
+    }
+
+    while (len > 0) {
+        Uint32 ch = SDL_StepUTF8(&str, &len);
+
+        if (ch >= SDL_DEBUG_FONT_NUM_GLYPHS) {
+            ch = SDL_DEBUG_FONT_NUM_GLYPHS - 1;
+        }
+        if (ch != ' ') {
+            SDL_TextureInstance *instance = &instances[count++];
+
+            instance->srcrect.x = (float)((ch % DEBUG_FONT_ATLAS_COLUMNS) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+            instance->srcrect.y = (float)((ch / DEBUG_FONT_ATLAS_COLUMNS) * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+            instance->srcrect.w = size;
+            instance->srcrect.h = size;
+            instance->dstrect.x = x;
+            instance->dstrect.y = y;
+            instance->dstrect.w = size;
+            instance->dstrect.h = size;
+            instance->angle = 0.0f;
+            instance->color = renderer->color;
+        }
+        x += size;
+    }
+
+    retval = SDL_RenderTextureInstanced(renderer, texture, instances, count);
+
+    SDL_small_free(instances, isstack);
+    return retval;
+}
+
+/* A run of recorded triangles that can be queued with one SDL_RenderGeometryRaw() call */
+typedef struct SDL_RenderCommandListRun
+{
+    SDL_Texture *texture;
+    SDL_bool modulate;  /* apply the texture color mod at submit time */
+    int first_vertex;
+    int num_vertices;
+    int first_index;    /* indices are relative to first_vertex */
+    int num_indices;
+} SDL_RenderCommandListRun;
+
+struct SDL_RenderCommandList
+{
+    SDL_Vertex *vertices;
+    int num_vertices;
+    int max_vertices;
+    int *indices;
+    int num_indices;
+    int max_indices;
+    SDL_RenderCommandListRun *runs;
+    int num_runs;
+    int max_runs;
+};
+
+static int GrowRenderCommandListArray(void **array, int *max, int needed, size_t element_size)
+{
+    if (needed > *max) {
+        int newmax = SDL_max(*max * 2, 64);
+        void *ptr;
+        while (newmax < needed) {
+            newmax *= 2;
+        }
+        ptr = SDL_realloc(*array, newmax * element_size);
+        if (!ptr) {
+            return -1;
+        }
+        *array = ptr;
+        *max = newmax;
+    }
+    return 0;
+}
+
+/* Reserve space for a draw, merging it into the last run if the state matches. */
+static SDL_RenderCommandListRun *ReserveRenderCommandListRun(SDL_RenderCommandList *list, SDL_Texture *texture, SDL_bool modulate,
+                                                              int num_vertices, int num_indices)
+{
+    SDL_RenderCommandListRun *run;
+
+    if (num_vertices > (SDL_MAX_SINT32 - list->num_vertices) || num_indices > (SDL_MAX_SINT32 - list->num_indices)) {
+        SDL_SetError("Render command list is too large");
+        return NULL;
+    }
+
+    if (GrowRenderCommandListArray((void **)&list->vertices, &list->max_vertices, list->num_vertices + num_vertices, sizeof(*list->vertices)) < 0 ||
+        GrowRenderCommandListArray((void **)&list->indices, &list->max_indices, list->num_indices + num_indices, sizeof(*list->indices)) < 0) {
+        return NULL;
+    }
+
+    if (list->num_runs > 0) {
+        run = &list->runs[list->num_runs - 1];
+        if (run->texture == texture && run->modulate == modulate) {
+            return run;
+        }
+    }
+
+    if (GrowRenderCommandListArray((void **)&list->runs, &list->max_runs, list->num_runs + 1, sizeof(*list->runs)) < 0) {
+        return NULL;
+    }
+    run = &list->runs[list->num_runs++];
+    run->texture = texture;
+    run->modulate = modulate;
+    run->first_vertex = list->num_vertices;
+    run->num_vertices = 0;
+    run->first_index = list->num_indices;
+    run->num_indices = 0;
+    return run;
+}
+
+SDL_RenderCommandList *SDL_CreateRenderCommandList(void)
+{
+    return (SDL_RenderCommandList *)SDL_calloc(1, sizeof(SDL_RenderCommandList));
+}
+
+int SDL_RecordRenderGeometry(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices)
+{
+    SDL_RenderCommandListRun *run;
+    const int count = indices ? num_indices : num_vertices;
+    int i;
+
+    if (!list) {
+        return SDL_InvalidParamError("list");
+    }
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (count < 0 || count % 3 != 0) {
+        return SDL_InvalidParamError(indices ? "num_indices" : "num_vertices");
+    }
+    if (num_vertices < 3) {
+        return 0;
+    }
+
+    if (indices) {
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Values of 'indices' out of bounds");
+            }
+        }
+    }
+
+    run = ReserveRenderCommandListRun(list, texture, SDL_FALSE, num_vertices, count);
+    if (!run) {
+        return -1;
+    }
+
+    SDL_memcpy(&list->vertices[list->num_vertices], vertices, num_vertices * sizeof(*vertices));
+    for (i = 0; i < count; ++i) {
+        list->indices[list->num_indices + i] = run->num_vertices + (indices ? indices[i] : i);
+    }
+    list->num_vertices += num_vertices;
+    list->num_indices += count;
+    run->num_vertices += num_vertices;
+    run->num_indices += count;
+    return 0;
+}
+
+int SDL_RecordRenderTextureInstanced(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_TextureInstance *instances, int count)
+{
+    static const int rect_index_order[6] = { 0, 1, 2, 0, 2, 3 };
+    static const SDL_FColor no_modulate = { 1.0f, 1.0f, 1.0f, 1.0f };
+    SDL_RenderCommandListRun *run;
+
+    if (!list) {
+        return SDL_InvalidParamError("list");
+    }
+    if (!texture) {
+        return SDL_InvalidParamError("texture");
+    }
+    if (!instances) {
+        return SDL_InvalidParamError("instances");
+    }
+    if (count < 0 || count > (SDL_MAX_SINT32 / 6)) {
+        return SDL_InvalidParamError("count");
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    run = ReserveRenderCommandListRun(list, texture, SDL_TRUE, 4 * count, 6 * count);
+    if (!run) {
+        return -1;
+    }
+
+    GenerateInstanceGeometry(instances, count, texture->w, texture->h, &no_modulate, rect_index_order, run->num_vertices,
+                             &list->vertices[list->num_vertices], &list->indices[list->num_indices]);
+    list->num_vertices += 4 * count;
+    list->num_indices += 6 * count;
+    run->num_vertices += 4 * count;
+    run->num_indices += 6 * count;
+    return 0;
+}
+
+int SDL_SubmitRenderCommandList(SDL_Renderer *renderer, SDL_RenderCommandList *list)
+{
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!list) {
+        return SDL_InvalidParamError("list");
+    }
+
+    for (i = 0; i < list->num_runs; ++i) {
+        const SDL_RenderCommandListRun *run = &list->runs[i];
+        const SDL_Vertex *vertices = &list->vertices[run->first_vertex];
+        const SDL_FColor *color = &vertices->color;
+        int color_stride = sizeof(*vertices);
+        SDL_FColor *modulated = NULL;
+        SDL_bool isstack = SDL_FALSE;
+        int retval;
+
+        if (run->texture) {
+            CHECK_TEXTURE_MAGIC(run->texture, -1);
+        }
+
+        if (run->modulate) {
+            const SDL_FColor *mod = &run->texture->color;
+            if (mod->r != 1.0f || mod->g != 1.0f || mod->b != 1.0f || mod->a != 1.0f) {
+                int j;
+
+                modulated = SDL_small_alloc(SDL_FColor, run->num_vertices, &isstack);
+                if (!modulated) {
+                    return -1;
+                }
+                for (j = 0; j < run->num_vertices; ++j) {
+                    modulated[j].r = vertices[j].color.r * mod->r;
+                    modulated[j].g = vertices[j].color.g * mod->g;
+                    modulated[j].b = vertices[j].color.b * mod->b;
+                    modulated[j].a = vertices[j].color.a * mod->a;
+                }
+                color = modulated;
+                color_stride = sizeof(*modulated);
+            }
+        }
+
+        retval = SDL_RenderGeometryRaw(renderer, run->texture,
+                                       &vertices->position.x, sizeof(*vertices),
+                                       color, color_stride,
+                                       &vertices->tex_coord.x, sizeof(*vertices),
+                                       run->num_vertices,
+                                       &list->indices[run->first_index], run->num_indices, sizeof(int));
+        if (modulated) {
+            SDL_small_free(modulated, isstack);
+        }
+        if (retval < 0) {
+            return retval;
+        }
+    }
+    return 0;
+}
+
+void SDL_ClearRenderCommandList(SDL_RenderCommandList *list)
+{
+    if (list) {
+        list->num_vertices = 0;
+        list->num_indices = 0;
+        list->num_runs = 0;
+    }
+}
+
+void SDL_DestroyRenderCommandList(SDL_RenderCommandList *list)
+{
+    if (list) {
+        SDL_free(list->vertices);
+        SDL_free(list->indices);
+        SDL_free(list->runs);
+        SDL_free(list);
+    }
+}
+
+SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SDL_Rect real_rect;
+    SDL_Surface *surface;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->RenderReadPixels) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    FlushRenderCommands(renderer); /* we need to render before we read the results. */
+
+    real_rect = renderer->view->pixel_viewport;
+
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
+            return NULL;
+        }
+    }
+
+    surface = renderer->RenderReadPixels(renderer, &real_rect);
+    if (surface) {
+        SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+
+        if (renderer->target) {
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, renderer->target->SDR_white_point);
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, renderer->target->HDR_headroom);
+        } else {
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, renderer->SDR_white_point);
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, renderer->HDR_headroom);
+        }
+    }
+    return surface;
+}
+
+int SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_PixelFormat format, SDL_RenderReadPixelsCallback callback, void *userdata)
+{
+    SDL_PendingReadPixels *read;
+    SDL_Rect real_rect;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    if (!renderer->RenderReadPixelsAsync && !renderer->RenderReadPixels) {
+        return SDL_Unsupported();
+    }
+
+    FlushRenderCommands(renderer); /* the read has to come after everything queued so far */
+
+    real_rect = renderer->view->pixel_viewport;
+
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
+            return SDL_SetError("The rectangle is outside the viewport");
+        }
+    }
+
+    read = (SDL_PendingReadPixels *)SDL_calloc(1, sizeof(*read));
+    if (!read) {
+        return -1;
+    }
+    read->rect = real_rect;
+    read->format = format;
+    if (renderer->target) {
+        read->SDR_white_point = renderer->target->SDR_white_point;
+        read->HDR_headroom = renderer->target->HDR_headroom;
+    } else {
+        read->SDR_white_point = renderer->SDR_white_point;
+        read->HDR_headroom = renderer->HDR_headroom;
+    }
+    read->callback = callback;
+    read->userdata = userdata;
+
+    if (renderer->RenderReadPixelsAsync) {
+        if (renderer->RenderReadPixelsAsync(renderer, read) < 0) {
+            SDL_free(read);
+            return -1;
+        }
+    } else {
+        /* Read it now, the callback still happens on the next present */
+        read->surface = renderer->RenderReadPixels(renderer, &real_rect);
+        if (!read->surface) {
+            SDL_free(read);
+            return -1;
+        }
+    }
+
+    if (renderer->pending_reads_tail) {
+        renderer->pending_reads_tail->next = read;
+    } else {
+        renderer->pending_reads = read;
+    }
+    renderer->pending_reads_tail = read;
+
+    return 0;
+}
+
+/* Hand finished reads to their callbacks, stopping at the first one that isn't done unless wait is set */
+static void SDL_CompletePendingReads(SDL_Renderer *renderer, SDL_bool wait)
+{
+    while (renderer->pending_reads) {
+        SDL_PendingReadPixels *read = renderer->pending_reads;
+        SDL_Surface *surface;
+
+        if (!read->surface && renderer->GetReadPixelsResult) {
+            if (renderer->GetReadPixelsResult(renderer, read, wait) == 0) {
+                break;
+            }
+        }
+
+        /* Remove it first, the callback may request another read */
+        renderer->pending_reads = read->next;
+        if (!renderer->pending_reads) {
+            renderer->pending_reads_tail = NULL;
+        }
+
+        surface = read->surface;
+        if (surface) {
+            SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, read->SDR_white_point);
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, read->HDR_headroom);
+
+            if (read->format != SDL_PIXELFORMAT_UNKNOWN && read->format != surface->format) {
+                surface = SDL_ConvertSurface(read->surface, read->format);
+            }
+        }
+
+        read->callback(read->userdata, surface);
+
+        if (surface != read->surface) {
+            SDL_DestroySurface(surface);
+        }
+        SDL_DestroySurface(read->surface);
+        if (read->internal && renderer->DestroyReadPixels) {
+            renderer->DestroyReadPixels(renderer, read);
+        }
+        SDL_free(read);
+    }
+}
+
+static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
+{
+    SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(renderer->window), SDL_PROP_WINDOW_SHAPE_POINTER, NULL);
+    if (shape != renderer->shape_surface) {
+        if (renderer->shape_texture) {
+            SDL_DestroyTexture(renderer->shape_texture);
+            renderer->shape_texture = NULL;
+        }
+
+        if (shape) {
+            /* There's nothing we can do if this fails, so just keep on going */
+            renderer->shape_texture = SDL_CreateTextureFromSurface(renderer, shape);
+
+            SDL_SetTextureBlendMode(renderer->shape_texture,
+                SDL_ComposeCustomBlendMode(
+                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+        }
+        renderer->shape_surface = shape;
+    }
+
+    if (renderer->shape_texture) {
+        SDL_RenderTexture(renderer, renderer->shape_texture, NULL, NULL);
+    }
+}
+
+static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
+{
+    Uint64 now, elapsed;
+    const Uint64 interval = renderer->simulate_vsync_interval_ns;
+
+    if (!interval) {
         /* We can't do sub-ns delay, so just return here */
         return;
     }
@@ -4996,9 +7017,13 @@ static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
     }
 }
 
+static void TrimRenderTargetPool(SDL_Renderer *renderer, SDL_bool is_destroying);
+static void SDL_RestoreRenderWindowPresentMode(SDL_Renderer *renderer);
+
 int SDL_RenderPresent(SDL_Renderer *renderer)
 {
     SDL_bool presented = SDL_TRUE;
+    Uint64 start;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -5013,6 +7038,7 @@ int SDL_RenderPresent(SDL_Renderer *renderer)
 
     FlushRenderCommands(renderer); /* time to send everything to the GPU! */
 
+    start = SDL_GetTicksNS();
 #if DONT_DRAW_WHILE_HIDDEN
     /* Don't present while we're hidden */
     if (renderer->hidden) {
@@ -5022,6 +7048,24 @@ int SDL_RenderPresent(SDL_Renderer *renderer)
     if (renderer->RenderPresent(renderer) < 0) {
         presented = SDL_FALSE;
     }
+    renderer->stats.present_ns = SDL_GetTicksNS() - start;
+
+    if (renderer->pending_reads) {
+        SDL_CompletePendingReads(renderer, SDL_FALSE);
+    }
+
+    ++renderer->stats.frame;
+    renderer->stats.gpu_ns = renderer->gpu_frame_ns;
+    SDL_copyp(&renderer->last_stats, &renderer->stats);
+    SDL_zero(renderer->stats);
+    renderer->stats.frame = renderer->last_stats.frame;
+
+    if (renderer->target_pool) {
+        TrimRenderTargetPool(renderer, SDL_FALSE);
+    }
+    if (renderer->queue_shrink_frames > 0 && !renderer->render_commands) {
+        ShrinkRenderCommandQueue(renderer);
+    }
 
     if (renderer->logical_target) {
         SDL_SetRenderTargetInternal(renderer, renderer->logical_target);
@@ -5034,6 +7078,40 @@ int SDL_RenderPresent(SDL_Renderer *renderer)
     return 0;
 }
 
+int SDL_WaitForRenderFrame(SDL_Renderer *renderer, Sint32 timeoutMS)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->WaitFrame) {
+        return 0;
+    }
+    return renderer->WaitFrame(renderer, timeoutMS);
+}
+
+int SDL_GetRenderStats(SDL_Renderer *renderer, SDL_RenderStats *stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_copyp(stats, &renderer->last_stats);
+    return 0;
+}
+
+int SDL_GetRendererMemoryStats(SDL_Renderer *renderer, SDL_MemoryStats *stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_copyp(stats, &renderer->memory_stats);
+    return 0;
+}
+
 static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroying)
 {
     SDL_Renderer *renderer;
@@ -5063,6 +7141,8 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
         renderer->logical_target = NULL;
     }
 
+    CancelPendingTextureUpdates(texture);
+
     SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, SDL_FALSE);
 
     if (texture->next) {
@@ -5086,6 +7166,8 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
 
     renderer->DestroyTexture(renderer, texture);
 
+    TrackTextureMemory(texture, SDL_FALSE);
+
     SDL_DestroySurface(texture->locked_surface);
     texture->locked_surface = NULL;
 
@@ -5093,8 +7175,72 @@ static int SDL_DestroyTextureInternal(SDL_Texture *texture, SDL_bool is_destroyi
     return 0;
 }
 
+static void ReleaseRenderTargetToPool(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+
+    if (texture == renderer->target) {
+        SDL_SetRenderTargetInternal(renderer, NULL); /* implies command queue flush */
+    }
+
+    CancelPendingTextureUpdates(texture);
+
+    SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, SDL_FALSE);
+
+    if (texture->next) {
+        texture->next->prev = texture->prev;
+    }
+    if (texture->prev) {
+        texture->prev->next = texture->next;
+    } else {
+        renderer->textures = texture->next;
+    }
+
+    texture->prev = NULL;
+    texture->next = renderer->target_pool;
+    renderer->target_pool = texture;
+    texture->pooled_frame = renderer->stats.frame;
+}
+
+/* Destroy the pooled render targets that haven't been reused recently, or all of them */
+static void TrimRenderTargetPool(SDL_Renderer *renderer, SDL_bool is_destroying)
+{
+    SDL_Texture *texture = renderer->target_pool;
+    SDL_Texture *prev = NULL;
+
+    while (texture) {
+        SDL_Texture *next = texture->next;
+
+        if (is_destroying || renderer->stats.frame - texture->pooled_frame >= SDL_RENDER_TARGET_POOL_FRAMES) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                renderer->target_pool = next;
+            }
+
+            /* Put it back in the texture list so it can go through the normal cleanup */
+            texture->next = renderer->textures;
+            if (renderer->textures) {
+                renderer->textures->prev = texture;
+            }
+            renderer->textures = texture;
+            SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, SDL_TRUE);
+            SDL_DestroyTextureInternal(texture, is_destroying);
+        } else {
+            prev = texture;
+        }
+        texture = next;
+    }
+}
+
 void SDL_DestroyTexture(SDL_Texture *texture)
 {
+    CHECK_TEXTURE_MAGIC(texture,);
+
+    if (texture->transient && texture != texture->renderer->logical_target) {
+        ReleaseRenderTargetToPool(texture);
+        return;
+    }
     SDL_DestroyTextureInternal(texture, SDL_FALSE /* is_destroying */);
 }
 
@@ -5134,16 +7280,27 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         if (SDL_GetPointerProperty(props, SDL_PROP_WINDOW_RENDERER_POINTER, NULL) == renderer) {
             SDL_ClearProperty(props, SDL_PROP_WINDOW_RENDERER_POINTER);
         }
+        SDL_RestoreRenderWindowPresentMode(renderer);
     }
 
+    /* Nobody will present again, so wait for any reads that are still in flight */
+    SDL_CompletePendingReads(renderer, SDL_TRUE);
+
     SDL_DiscardAllCommands(renderer);
 
+    TrimRenderTargetPool(renderer, SDL_TRUE);
+
+    while (renderer->shaders) {
+        SDL_DestroyRenderShader(renderer->shaders);
+    }
+
     /* Free existing textures for this renderer */
     while (renderer->textures) {
         SDL_Texture *tex = renderer->textures;
         SDL_DestroyTextureInternal(renderer->textures, SDL_TRUE /* is_destroying */);
         SDL_assert(tex != renderer->textures); /* satisfy static analysis. */
     }
+    renderer->debug_font = NULL;
 
     /* Clean up renderer-specific resources */
     if (renderer->DestroyRenderer) {
@@ -5158,6 +7315,10 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_free(renderer->vertex_data);
         renderer->vertex_data = NULL;
     }
+    if (renderer->index_data) {
+        SDL_free(renderer->index_data);
+        renderer->index_data = NULL;
+    }
     if (renderer->texture_formats) {
         SDL_free(renderer->texture_formats);
         renderer->texture_formats = NULL;
@@ -5329,10 +7490,32 @@ SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode)
     return (SDL_BlendOperation)(((Uint32)blendMode >> 16) & 0xF);
 }
 
+static void SDL_RestoreRenderWindowPresentMode(SDL_Renderer *renderer)
+{
+    if (renderer->window_vrr) {
+        SDL_SetWindowPresentMode(renderer->window, renderer->saved_window_present_mode);
+        renderer->window_vrr = SDL_FALSE;
+    }
+}
+
+static SDL_PresentMode SDL_PresentModeForVSync(int vsync)
+{
+    switch (vsync) {
+    case SDL_RENDERER_VSYNC_DISABLED:
+        return SDL_PRESENTMODE_IMMEDIATE;
+    case SDL_RENDERER_VSYNC_ADAPTIVE:
+        return SDL_PRESENTMODE_FIFO_RELAXED;
+    default:
+        return SDL_PRESENTMODE_FIFO;
+    }
+}
+
 int SDL_SetRenderVSync(SDL_Renderer *renderer, int vsync)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    SDL_RestoreRenderWindowPresentMode(renderer);
+
     renderer->wanted_vsync = vsync ? SDL_TRUE : SDL_FALSE;
 
     /* for the software renderer, forward the call to the WindowTexture renderer */
@@ -5371,6 +7554,7 @@ int SDL_SetRenderVSync(SDL_Renderer *renderer, int vsync)
         }
     }
     SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_VSYNC_NUMBER, vsync);
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_PRESENT_MODE_NUMBER, SDL_PresentModeForVSync(vsync));
     return 0;
 }
 
@@ -5387,3 +7571,93 @@ int SDL_GetRenderVSync(SDL_Renderer *renderer, int *vsync)
     }
     return 0;
 }
+
+SDL_bool SDL_RenderSupportsPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    CHECK_RENDERER_MAGIC(renderer, SDL_FALSE);
+
+    if (mode == SDL_PRESENTMODE_FIFO) {
+        return SDL_TRUE;
+    }
+    if (mode == SDL_PRESENTMODE_VRR && renderer->window &&
+        SDL_WindowSupportsPresentMode(renderer->window, SDL_PRESENTMODE_VRR)) {
+        return SDL_TRUE;
+    }
+    if (renderer->SupportsPresentMode) {
+        return renderer->SupportsPresentMode(renderer, mode);
+    }
+
+    /* Renderers without finer control can turn vsync off, with whatever tearing results */
+    return (mode == SDL_PRESENTMODE_IMMEDIATE);
+}
+
+int SDL_SetRenderPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    SDL_bool window_vrr = SDL_FALSE;
+    int vsync;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!SDL_RenderSupportsPresentMode(renderer, mode)) {
+        return SDL_Unsupported();
+    }
+
+    switch (mode) {
+    case SDL_PRESENTMODE_FIFO_RELAXED:
+        vsync = SDL_RENDERER_VSYNC_ADAPTIVE;
+        break;
+    case SDL_PRESENTMODE_MAILBOX:
+    case SDL_PRESENTMODE_IMMEDIATE:
+        vsync = SDL_RENDERER_VSYNC_DISABLED;
+        break;
+    default:
+        vsync = 1;
+        break;
+    }
+
+    if (mode == SDL_PRESENTMODE_VRR && renderer->window &&
+        SDL_WindowSupportsPresentMode(renderer->window, SDL_PRESENTMODE_VRR)) {
+        /* The display handles VRR, the renderer keeps presenting at vblank */
+        window_vrr = SDL_TRUE;
+    }
+
+    if (renderer->SetPresentMode && !window_vrr) {
+        SDL_RestoreRenderWindowPresentMode(renderer);
+        if (renderer->SetPresentMode(renderer, mode) < 0) {
+            return -1;
+        }
+        renderer->wanted_vsync = (vsync != SDL_RENDERER_VSYNC_DISABLED);
+        renderer->simulate_vsync = SDL_FALSE;
+        SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_VSYNC_NUMBER, vsync);
+    } else if (SDL_SetRenderVSync(renderer, vsync) < 0) {
+        return -1;
+    }
+
+    if (window_vrr) {
+        SDL_PresentMode window_mode = SDL_PRESENTMODE_FIFO;
+
+        SDL_GetWindowPresentMode(renderer->window, &window_mode);
+        if (SDL_SetWindowPresentMode(renderer->window, SDL_PRESENTMODE_VRR) < 0) {
+            return -1;
+        }
+        renderer->saved_window_present_mode = window_mode;
+        renderer->window_vrr = (window_mode != SDL_PRESENTMODE_VRR);
+    }
+
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_PRESENT_MODE_NUMBER, mode);
+    return 0;
+}
+
+int SDL_GetRenderPresentMode(SDL_Renderer *renderer, SDL_PresentMode *mode)
+{
+    if (mode) {
+        *mode = SDL_PRESENTMODE_FIFO;
+    }
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (mode) {
+        *mode = (SDL_PresentMode)SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_PRESENT_MODE_NUMBER, SDL_PRESENTMODE_FIFO);
+    }
+    return 0;
+}
@@ -76,8 +76,11 @@ struct SDL_Texture
     SDL_TextureAccess access;   /**< The texture access mode */
     int w;                      /**< The width of the texture */
     int h;                      /**< The height of the texture */
+    int layers;                 /**< The number of layers stacked vertically, each h / layers high */
     SDL_BlendMode blendMode;    /**< The texture blend mode */
     SDL_ScaleMode scaleMode;    /**< The texture scale mode */
+    SDL_bool mipmaps;           /**< Whether the renderer keeps mipmaps, cleared by backends that can't */
+    SDL_bool transient;         /**< Whether this is a transient render target, recycled when destroyed */
     SDL_FColor color;           /**< Texture modulation values */
     SDL_RenderViewState view;   /**< Target texture view state */
 
@@ -92,6 +95,9 @@ struct SDL_Texture
     SDL_Surface *locked_surface; /**< Locked region exposed as a SDL surface */
 
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
+    int pending_updates;            /* number of SDL_UpdateTextureAsync() calls not done yet. */
+    Uint64 pooled_frame;            /* the frame a transient render target was returned to the pool. */
+    SDL_MemoryStats memory;         /* what this texture adds to the memory statistics, count is 0 until it's added. */
 
     SDL_PropertiesID props;
 
@@ -101,6 +107,19 @@ struct SDL_Texture
     SDL_Texture *next;
 };
 
+/* A custom fragment shader created by the render backend */
+struct SDL_RenderShader
+{
+    SDL_Renderer *renderer;
+
+    Uint32 last_command_generation; /* last command queue generation this shader was in. */
+
+    void *internal; /**< Driver specific shader representation */
+
+    SDL_RenderShader *prev;
+    SDL_RenderShader *next;
+};
+
 typedef enum
 {
     SDL_RENDERCMD_NO_OP,
@@ -135,11 +154,14 @@ typedef struct SDL_RenderCommand
         {
             size_t first;
             size_t count;
+            size_t first_index; /**< Byte offset of 16-bit indices in index_data, for indexed geometry */
+            size_t num_indices; /**< Number of indices, or 0 if the vertices are drawn in order */
             float color_scale;
             SDL_FColor color;
             SDL_BlendMode blend;
             SDL_Texture *texture;
             SDL_TextureAddressMode texture_address_mode;
+            SDL_RenderShader *shader; /**< Custom fragment shader, or NULL for the built-in shaders */
         } draw;
         struct
         {
@@ -164,6 +186,32 @@ typedef enum
     SDL_RENDERLINEMETHOD_GEOMETRY,
 } SDL_RenderLineMethod;
 
+/* A texture update scheduled with SDL_UpdateTextureAsync() */
+typedef struct SDL_PendingTextureUpdate
+{
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    const void *pixels;
+    int pitch;
+    SDL_TextureUpdateCallback callback;
+    void *userdata;
+    struct SDL_PendingTextureUpdate *next;
+} SDL_PendingTextureUpdate;
+
+/* A read scheduled with SDL_RenderReadPixelsAsync() */
+typedef struct SDL_PendingReadPixels
+{
+    SDL_Rect rect;
+    SDL_PixelFormat format;
+    float SDR_white_point;
+    float HDR_headroom;
+    SDL_RenderReadPixelsCallback callback;
+    void *userdata;
+    SDL_Surface *surface;   /* the pixels, once they've been read */
+    void *internal;         /* owned by the backend */
+    struct SDL_PendingReadPixels *next;
+} SDL_PendingReadPixels;
+
 /* Define the SDL renderer structure */
 struct SDL_Renderer
 {
@@ -189,6 +237,9 @@ struct SDL_Renderer
                          int num_vertices, const void *indices, int num_indices, int size_indices,
                          float scale_x, float scale_y);
 
+    int (*CreateShader)(SDL_Renderer *renderer, SDL_RenderShader *shader, SDL_PropertiesID create_props);
+    void (*DestroyShader)(SDL_Renderer *renderer, SDL_RenderShader *shader);
+
     void (*InvalidateCachedState)(SDL_Renderer *renderer);
     int (*RunCommandQueue)(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
     int (*UpdateTexture)(SDL_Renderer *renderer, SDL_Texture *texture,
@@ -211,12 +262,20 @@ struct SDL_Renderer
     void (*SetTextureScaleMode)(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode);
     int (*SetRenderTarget)(SDL_Renderer *renderer, SDL_Texture *texture);
     SDL_Surface *(*RenderReadPixels)(SDL_Renderer *renderer, const SDL_Rect *rect);
+    /* Queue a copy of read->rect behind the pending rendering. GetReadPixelsResult() returns 1 and sets
+       read->surface once the copy is done, 0 if it isn't done yet and wait is SDL_FALSE, or -1 on failure. */
+    int (*RenderReadPixelsAsync)(SDL_Renderer *renderer, SDL_PendingReadPixels *read);
+    int (*GetReadPixelsResult)(SDL_Renderer *renderer, SDL_PendingReadPixels *read, SDL_bool wait);
+    void (*DestroyReadPixels)(SDL_Renderer *renderer, SDL_PendingReadPixels *read);
     int (*RenderPresent)(SDL_Renderer *renderer);
+    int (*WaitFrame)(SDL_Renderer *renderer, Sint32 timeoutMS);
     void (*DestroyTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
 
     void (*DestroyRenderer)(SDL_Renderer *renderer);
 
     int (*SetVSync)(SDL_Renderer *renderer, int vsync);
+    SDL_bool (*SupportsPresentMode)(SDL_Renderer *renderer, SDL_PresentMode mode);
+    int (*SetPresentMode)(SDL_Renderer *renderer, SDL_PresentMode mode);
 
     void *(*GetMetalLayer)(SDL_Renderer *renderer);
     void *(*GetMetalCommandEncoder)(SDL_Renderer *renderer);
@@ -229,6 +288,14 @@ struct SDL_Renderer
     int num_texture_formats;
     SDL_bool software;
 
+    /* Whether the backend can keep mipmaps for textures */
+    SDL_bool mipmaps_supported;
+
+    /* Whether streaming textures lock into memory owned by the texture that
+       stays valid between locks, so it can be written outside of a lock and
+       uploaded by a later lock/unlock of the changed area */
+    SDL_bool persistent_lock_memory;
+
     /* The window associated with the renderer */
     SDL_Window *window;
     SDL_bool hidden;
@@ -239,6 +306,10 @@ struct SDL_Renderer
     Uint64 simulate_vsync_interval_ns;
     Uint64 last_present;
 
+    /* Set if SDL_PRESENTMODE_VRR changed the presentation mode of the window */
+    SDL_bool window_vrr;
+    SDL_PresentMode saved_window_present_mode;
+
     /* Support for logical output coordinates */
     SDL_Texture *logical_target;
     SDL_RendererLogicalPresentation logical_presentation_mode;
@@ -255,11 +326,24 @@ struct SDL_Renderer
     /* The method of drawing lines */
     SDL_RenderLineMethod line_method;
 
+    /* Whether compatible consecutive geometry commands are merged at queue time */
+    SDL_bool merge_geometry;
+
     /* List of triangle indices to draw rects */
     int rect_index_order[6];
 
     /* The list of textures */
     SDL_Texture *textures;
+
+    /* The list of custom shaders, and the one used for drawing */
+    SDL_RenderShader *shaders;
+    SDL_RenderShader *shader;
+
+    /* The glyph atlas used by SDL_RenderDebugText(), created on first use */
+    SDL_Texture *debug_font;
+
+    /* Destroyed transient render targets waiting to be reused, linked by their next pointer */
+    SDL_Texture *target_pool;
     SDL_Texture *target;
     SDL_Mutex *target_mutex;
 
@@ -290,6 +374,39 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Indices for geometry commands that backends draw indexed, reset with vertex_data */
+    void *index_data;
+    size_t index_data_used;
+    size_t index_data_allocation;
+
+    /* Command queue memory kept around between frames, and what to give back */
+    int render_commands_allocated;
+    int render_commands_reserve;
+    size_t vertex_data_reserve;
+    int queue_shrink_frames;
+    int queue_shrink_frame_count;
+    int queue_peak_commands;
+    size_t queue_peak_vertex_bytes;
+    size_t queue_peak_index_bytes;
+
+    /* Texture updates waiting for the next command queue flush */
+    SDL_PendingTextureUpdate *pending_updates;
+    SDL_PendingTextureUpdate *pending_updates_tail;
+
+    /* Reads waiting for the GPU, in the order they were requested */
+    SDL_PendingReadPixels *pending_reads;
+    SDL_PendingReadPixels *pending_reads_tail;
+
+    /* Statistics for the frame being built, and the last presented frame */
+    SDL_RenderStats stats;
+    SDL_RenderStats last_stats;
+
+    /* Memory held by the textures of this renderer */
+    SDL_MemoryStats memory_stats;
+
+    /* GPU time of the most recently measured frame, set by backends that support timer queries */
+    Uint64 gpu_frame_ns;
+
     /* Shaped window support */
     SDL_bool transparent_window;
     SDL_Surface *shape_surface;
@@ -352,6 +469,11 @@ extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode
    the next call, because it might be in an array that gets realloc()'d. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset);
 
+/* The same for index data, for drivers that keep geometry indexed instead of expanding the vertices.
+   The command's num_indices should be set when this is used, so the geometry isn't merged with
+   unindexed commands. Pointers returned here are only valid until the next call. */
+extern void *SDL_AllocateRenderIndices(SDL_Renderer *renderer, const size_t numbytes, size_t *offset);
+
 // Let the video subsystem destroy a renderer without making its pointer invalid.
 extern void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer);
 
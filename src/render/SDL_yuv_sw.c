@@ -341,55 +341,73 @@ int SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture *swdata, const SDL_Rect *srcrect,
                         int pitch)
 {
     int stretch;
+    int clipped;
 
     /* Make sure we're set up to display in the desired format */
-    if (target_format != swdata->target_format && swdata->display) {
-        SDL_DestroySurface(swdata->display);
-        swdata->display = NULL;
+    if (target_format != swdata->target_format) {
+        if (swdata->display) {
+            SDL_DestroySurface(swdata->display);
+            swdata->display = NULL;
+        }
+        if (swdata->stretch) {
+            SDL_DestroySurface(swdata->stretch);
+            swdata->stretch = NULL;
+        }
+        swdata->target_format = target_format;
+    }
+
+    clipped = (srcrect->x || srcrect->y || srcrect->w < swdata->w || srcrect->h < swdata->h);
+    stretch = ((srcrect->w != w) || (srcrect->h != h));
+
+    if (!clipped && !stretch) {
+        return SDL_ConvertPixels(swdata->w, swdata->h, swdata->format,
+                                 swdata->planes[0], swdata->pitches[0],
+                                 target_format, pixels, pitch);
     }
 
-    stretch = 0;
-    if (srcrect->x || srcrect->y || srcrect->w < swdata->w || srcrect->h < swdata->h) {
-        /* The source rectangle has been clipped.
-           Using a scratch surface is easier than adding clipped
-           source support to all the blitters, plus that would
-           slow them down in the general unclipped case.
-         */
-        stretch = 1;
-    } else if ((srcrect->w != w) || (srcrect->h != h)) {
-        stretch = 1;
+    /* Convert just the source rectangle, straight into the destination if
+       there's no scaling. This needs a direct conversion between the formats
+       and a rectangle aligned to the chroma samples, otherwise the whole
+       texture is converted into a scratch surface first. */
+    if (!stretch &&
+        SDL_ConvertPixels_YUVRect_to_RGB(swdata->w, swdata->h, srcrect,
+                                         swdata->format, SDL_COLORSPACE_UNKNOWN, swdata->planes[0], swdata->pitches[0],
+                                         target_format, SDL_COLORSPACE_UNKNOWN, pixels, pitch)) {
+        return 0;
     }
-    if (stretch) {
-        if (swdata->display) {
-            swdata->display->w = w;
-            swdata->display->h = h;
-            swdata->display->pixels = pixels;
-            swdata->display->pitch = pitch;
-        } else {
-            swdata->display = SDL_CreateSurfaceFrom(w, h, target_format, pixels, pitch);
-            if (!swdata->display) {
-                return -1;
-            }
+
+    if (swdata->display) {
+        swdata->display->w = w;
+        swdata->display->h = h;
+        swdata->display->pixels = pixels;
+        swdata->display->pitch = pitch;
+    } else {
+        swdata->display = SDL_CreateSurfaceFrom(w, h, target_format, pixels, pitch);
+        if (!swdata->display) {
+            return -1;
         }
+    }
+    if (!swdata->stretch) {
+        swdata->stretch = SDL_CreateSurface(swdata->w, swdata->h, target_format);
         if (!swdata->stretch) {
-            swdata->stretch = SDL_CreateSurface(swdata->w, swdata->h, target_format);
-            if (!swdata->stretch) {
-                return -1;
-            }
+            return -1;
         }
-        pixels = swdata->stretch->pixels;
-        pitch = swdata->stretch->pitch;
     }
+
+    if (SDL_ConvertPixels_YUVRect_to_RGB(swdata->w, swdata->h, srcrect,
+                                         swdata->format, SDL_COLORSPACE_UNKNOWN, swdata->planes[0], swdata->pitches[0],
+                                         target_format, SDL_COLORSPACE_UNKNOWN, swdata->stretch->pixels, swdata->stretch->pitch)) {
+        /* Only the source rectangle was converted, into the top left of the scratch surface */
+        SDL_Rect rect = { 0, 0, srcrect->w, srcrect->h };
+        return SDL_SoftStretch(swdata->stretch, &rect, swdata->display, NULL, SDL_SCALEMODE_NEAREST);
+    }
+
     if (SDL_ConvertPixels(swdata->w, swdata->h, swdata->format,
                           swdata->planes[0], swdata->pitches[0],
-                          target_format, pixels, pitch) < 0) {
+                          target_format, swdata->stretch->pixels, swdata->stretch->pitch) < 0) {
         return -1;
     }
-    if (stretch) {
-        SDL_Rect rect = *srcrect;
-        SDL_SoftStretch(swdata->stretch, &rect, swdata->display, NULL, SDL_SCALEMODE_NEAREST);
-    }
-    return 0;
+    return SDL_SoftStretch(swdata->stretch, srcrect, swdata->display, NULL, SDL_SCALEMODE_NEAREST);
 }
 
 void SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture *swdata)
@@ -32,7 +32,7 @@
 #include "../../video/SDL_pixels_c.h"
 
 #include <d3d11_1.h>
-#include <dxgi1_4.h>
+#include <dxgi1_5.h>
 #include <dxgidebug.h>
 
 #include "SDL_shaders_d3d11.h"
@@ -68,6 +68,13 @@ extern ISwapChainBackgroundPanelNative *WINRT_GlobalSwapChainBackgroundPanelNati
 /* !!! FIXME: vertex buffer bandwidth could be lower; only use UV coords when
    !!! FIXME:  textures are needed. */
 
+/* The vertex buffer is written as a ring with D3D11_MAP_WRITE_NO_OVERWRITE and
+   grows as needed. Shader constants use a ring as well, if the driver supports
+   binding constant buffer ranges, with one 256 byte slot per update. */
+#define SDL_D3D11_VERTEX_BUFFER_MIN_SIZE   (1024 * 1024)
+#define SDL_D3D11_CONSTANT_BUFFER_SIZE     (1024 * 1024)
+#define SDL_D3D11_CONSTANT_SLOT_SIZE       256
+
 /* Sampler types */
 typedef enum
 {
@@ -119,6 +126,8 @@ typedef struct
 typedef struct
 {
     ID3D11Buffer *constants;
+    UINT constantsOffset;
+    Uint32 constantsGeneration;
     PixelShaderConstants shader_constants;
 } PixelShaderState;
 
@@ -180,13 +189,19 @@ typedef struct
     ID3D11DeviceContext1 *d3dContext;
     IDXGISwapChain1 *swapChain;
     DXGI_SWAP_EFFECT swapEffect;
+    UINT swapFlags;
     UINT syncInterval;
     UINT presentFlags;
+    UINT maxFrameLatency;
+    HANDLE frameLatencyWaitableObject;
+    SDL_bool frameWaited;
+    SDL_bool supportsTearing;
     ID3D11RenderTargetView *mainRenderTargetView;
     ID3D11RenderTargetView *currentOffscreenRenderTargetView;
     ID3D11InputLayout *inputLayout;
-    ID3D11Buffer *vertexBuffers[8];
-    size_t vertexBufferSizes[8];
+    ID3D11Buffer *vertexBuffer;
+    size_t vertexBufferSize;
+    size_t vertexBufferOffset;
     ID3D11VertexShader *vertexShader;
     ID3D11PixelShader *pixelShaders[NUM_SHADERS];
     int blendModesCount;
@@ -202,6 +217,13 @@ typedef struct
     /* Vertex buffer constants */
     VertexShaderConstants vertexShaderConstantsData;
     ID3D11Buffer *vertexShaderConstants;
+    Uint32 vertexShaderConstantsGeneration;
+
+    /* Constant buffer ring, NULL if constant buffer offsetting isn't supported */
+    ID3D11Buffer *constantBuffer;
+    UINT constantBufferOffset;
+    Uint32 constantBufferGeneration;
+    SDL_bool constantBufferDiscard;
 
     /* Cached renderer properties */
     DXGI_MODE_ROTATION rotation;
@@ -219,7 +241,6 @@ typedef struct
     int currentViewportRotation;
     SDL_bool viewportDirty;
     Float4X4 identity;
-    int currentVertexBuffer;
 } D3D11_RenderData;
 
 /* Define D3D GUIDs here so we don't have to include uuid.lib.
@@ -237,6 +258,7 @@ typedef struct
 #endif
 
 static const GUID SDL_IID_IDXGIFactory2 = { 0x50c83a1c, 0xe072, 0x4c48, { 0x87, 0xb0, 0x36, 0x30, 0xfa, 0x36, 0xa6, 0xd0 } };
+static const GUID SDL_IID_IDXGIFactory5 = { 0x7632e1f5, 0xee65, 0x4dca, { 0x87, 0xfd, 0x84, 0xcd, 0x75, 0xf8, 0x83, 0x8d } };
 static const GUID SDL_IID_IDXGIDevice1 = { 0x77db970f, 0x6276, 0x48ba, { 0xba, 0x28, 0x07, 0x01, 0x43, 0xb4, 0x39, 0x2c } };
 #if defined(SDL_PLATFORM_WINRT) && NTDDI_VERSION > NTDDI_WIN8
 static const GUID SDL_IID_IDXGIDevice3 = { 0x6007896c, 0x3244, 0x4afd, { 0xbf, 0x18, 0xa6, 0xd3, 0xbe, 0xda, 0x50, 0x23 } };
@@ -353,6 +375,7 @@ static void D3D11_ReleaseAll(SDL_Renderer *renderer)
         }
 
         SAFE_RELEASE(data->vertexShaderConstants);
+        SAFE_RELEASE(data->constantBuffer);
         SAFE_RELEASE(data->clippedRasterizer);
         SAFE_RELEASE(data->mainRasterizer);
         for (i = 0; i < SDL_arraysize(data->samplers); ++i) {
@@ -374,12 +397,16 @@ static void D3D11_ReleaseAll(SDL_Renderer *renderer)
             SAFE_RELEASE(data->currentShaderState[i].constants);
         }
         SAFE_RELEASE(data->vertexShader);
-        for (i = 0; i < SDL_arraysize(data->vertexBuffers); ++i) {
-            SAFE_RELEASE(data->vertexBuffers[i]);
-        }
+        SAFE_RELEASE(data->vertexBuffer);
         SAFE_RELEASE(data->inputLayout);
         SAFE_RELEASE(data->mainRenderTargetView);
         SAFE_RELEASE(data->swapChain);
+        if (data->frameLatencyWaitableObject) {
+            CloseHandle(data->frameLatencyWaitableObject);
+            data->frameLatencyWaitableObject = NULL;
+        }
+        data->swapFlags = 0;
+        data->frameWaited = SDL_FALSE;
 
         SAFE_RELEASE(data->d3dContext);
         SAFE_RELEASE(data->d3dDevice);
@@ -392,6 +419,12 @@ static void D3D11_ReleaseAll(SDL_Renderer *renderer)
         data->currentRenderTargetView = NULL;
         data->currentRasterizerState = NULL;
         data->currentBlendState = NULL;
+        data->vertexBufferSize = 0;
+        data->vertexBufferOffset = 0;
+        data->vertexShaderConstantsGeneration = 0;
+        data->constantBufferOffset = 0;
+        data->constantBufferGeneration = 0;
+        data->constantBufferDiscard = SDL_FALSE;
         data->currentShader = SHADER_NONE;
         SDL_zero(data->currentShaderState);
         data->currentShaderResource = NULL;
@@ -549,6 +582,7 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
     };
 
     D3D11_BUFFER_DESC constantBufferDesc;
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options;
     D3D11_SAMPLER_DESC samplerDesc;
     D3D11_RASTERIZER_DESC rasterDesc;
 
@@ -628,6 +662,20 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
         goto done;
     }
 
+    /* Tearing is needed for immediate and variable refresh rate presentation with flip model swap chains */
+    {
+        IDXGIFactory5 *dxgiFactory5 = NULL;
+        BOOL allowTearing = FALSE;
+
+        if (SUCCEEDED(IDXGIFactory2_QueryInterface(data->dxgiFactory, &SDL_IID_IDXGIFactory5, (void **)&dxgiFactory5))) {
+            if (FAILED(IDXGIFactory5_CheckFeatureSupport(dxgiFactory5, DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing)))) {
+                allowTearing = FALSE;
+            }
+            SAFE_RELEASE(dxgiFactory5);
+        }
+        data->supportsTearing = allowTearing ? SDL_TRUE : SDL_FALSE;
+    }
+
     /* FIXME: Should we use the default adapter? */
     result = IDXGIFactory2_EnumAdapters(data->dxgiFactory, 0, &data->dxgiAdapter);
     if (FAILED(result)) {
@@ -689,7 +737,7 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
     /* Ensure that DXGI does not queue more than one frame at a time. This both reduces latency and
      * ensures that the application will only render after each VSync, minimizing power consumption.
      */
-    result = IDXGIDevice1_SetMaximumFrameLatency(dxgiDevice, 1);
+    result = IDXGIDevice1_SetMaximumFrameLatency(dxgiDevice, data->maxFrameLatency);
     if (FAILED(result)) {
         WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("IDXGIDevice1::SetMaximumFrameLatency"), result);
         goto done;
@@ -743,6 +791,29 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
         goto done;
     }
 
+    /* If the driver can bind part of a constant buffer, stream all shader constants through one ring */
+    SDL_zero(options);
+    if (SUCCEEDED(ID3D11Device_CheckFeatureSupport(data->d3dDevice, D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+        options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer) {
+        SDL_zero(constantBufferDesc);
+        constantBufferDesc.ByteWidth = SDL_D3D11_CONSTANT_BUFFER_SIZE;
+        constantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+        constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        constantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        result = ID3D11Device_CreateBuffer(data->d3dDevice,
+                                           &constantBufferDesc,
+                                           NULL,
+                                           &data->constantBuffer);
+        if (FAILED(result)) {
+            /* Not fatal, we'll use separate constant buffers instead */
+            data->constantBuffer = NULL;
+            result = S_OK;
+        }
+        data->constantBufferOffset = 0;
+        data->constantBufferGeneration = 1;
+        data->constantBufferDiscard = SDL_TRUE;
+    }
+
     /* Create samplers to use when drawing textures: */
     static struct
     {
@@ -904,6 +975,7 @@ static HRESULT D3D11_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     IUnknown *coreWindow = NULL;
     const BOOL usingXAML = FALSE;
 #endif
+    IDXGISwapChain2 *swapChain2 = NULL;
     IDXGISwapChain3 *swapChain3 = NULL;
     HRESULT result = S_OK;
 
@@ -950,6 +1022,19 @@ static HRESULT D3D11_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     }
 #endif
     swapChainDesc.Flags = 0;
+#if !SDL_WINAPI_FAMILY_PHONE
+    /* Flip model swap chains can hand out a waitable object that is signaled when
+     * DXGI is ready for the next frame, so the application can wait for it before
+     * sampling input instead of blocking in Present. This needs Windows 8.1, so if
+     * swap chain creation fails we try again without it.
+     */
+    if (swapChainDesc.SwapEffect == DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL && WIN_IsWindows8OrGreater()) {
+        swapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    }
+    if (swapChainDesc.SwapEffect == DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL && data->supportsTearing) {
+        swapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+    }
+#endif
 
     if (coreWindow) {
         result = IDXGIFactory2_CreateSwapChainForCoreWindow(data->dxgiFactory,
@@ -1000,6 +1085,16 @@ static HRESULT D3D11_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
                                                       NULL,
                                                       NULL, /* Allow on all displays. */
                                                       &data->swapChain);
+        if (FAILED(result) && (swapChainDesc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT)) {
+            swapChainDesc.Flags &= ~(DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT | DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING);
+            result = IDXGIFactory2_CreateSwapChainForHwnd(data->dxgiFactory,
+                                                          (IUnknown *)data->d3dDevice,
+                                                          hwnd,
+                                                          &swapChainDesc,
+                                                          NULL,
+                                                          NULL, /* Allow on all displays. */
+                                                          &data->swapChain);
+        }
         if (FAILED(result)) {
             WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("IDXGIFactory2::CreateSwapChainForHwnd"), result);
             goto done;
@@ -1012,6 +1107,24 @@ static HRESULT D3D11_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 #endif /* defined(SDL_PLATFORM_WIN32) || defined(SDL_PLATFORM_WINGDK) / else */
     }
     data->swapEffect = swapChainDesc.SwapEffect;
+    data->swapFlags = swapChainDesc.Flags;
+
+    if (data->swapFlags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) {
+        result = IDXGISwapChain1_QueryInterface(data->swapChain, &SDL_IID_IDXGISwapChain2, (void **)&swapChain2);
+        if (FAILED(result)) {
+            WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("IDXGISwapChain1::QueryInterface"), result);
+            goto done;
+        }
+
+        /* The device frame latency doesn't apply to waitable swap chains, so set it here */
+        result = IDXGISwapChain2_SetMaximumFrameLatency(swapChain2, data->maxFrameLatency);
+        if (FAILED(result)) {
+            WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("IDXGISwapChain2::SetMaximumFrameLatency"), result);
+            goto done;
+        }
+        data->frameLatencyWaitableObject = IDXGISwapChain2_GetFrameLatencyWaitableObject(swapChain2);
+        data->frameWaited = SDL_FALSE;
+    }
 
     if (SUCCEEDED(IDXGISwapChain1_QueryInterface(data->swapChain, &SDL_IID_IDXGISwapChain2, (void **)&swapChain3))) {
         UINT colorspace_support = 0;
@@ -1043,8 +1156,10 @@ static HRESULT D3D11_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     }
 
     SDL_SetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER, data->swapChain);
+    SDL_SetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_D3D11_FRAME_LATENCY_WAITABLE_POINTER, data->frameLatencyWaitableObject);
 
 done:
+    SAFE_RELEASE(swapChain2);
     SAFE_RELEASE(swapChain3);
     SAFE_RELEASE(coreWindow);
     return result;
@@ -1123,7 +1238,7 @@ static HRESULT D3D11_CreateWindowSizeDependentResources(SDL_Renderer *renderer)
                                               0,
                                               w, h,
                                               DXGI_FORMAT_UNKNOWN,
-                                              0);
+                                              data->swapFlags);
         if (result == DXGI_ERROR_DEVICE_REMOVED) {
             /* If the device was removed for any reason, a new device and swap chain will need to be created. */
             D3D11_HandleDeviceLost(renderer);
@@ -1336,6 +1451,19 @@ static int D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     if (GetTextureProperty(create_props, "d3d11.texture", &textureData->mainTexture) < 0) {
         return -1;
     }
+    if (!textureData->mainTexture) {
+        HANDLE shared_handle = (HANDLE)SDL_GetPointerProperty(create_props, SDL_PROP_TEXTURE_CREATE_D3D11_SHARED_HANDLE_POINTER, NULL);
+        if (shared_handle) {
+            /* NT handles need OpenSharedResource1(), legacy shared handles OpenSharedResource() */
+            result = ID3D11Device1_OpenSharedResource1(rendererData->d3dDevice, shared_handle, &SDL_IID_ID3D11Texture2D, (void **)&textureData->mainTexture);
+            if (FAILED(result)) {
+                result = ID3D11Device_OpenSharedResource(rendererData->d3dDevice, shared_handle, &SDL_IID_ID3D11Texture2D, (void **)&textureData->mainTexture);
+            }
+            if (FAILED(result)) {
+                return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::OpenSharedResource1"), result);
+            }
+        }
+    }
     if (!textureData->mainTexture) {
         result = ID3D11Device_CreateTexture2D(rendererData->d3dDevice,
                                               &textureDesc,
@@ -2042,68 +2170,109 @@ static int D3D11_UpdateVertexBuffer(SDL_Renderer *renderer,
                                     const void *vertexData, size_t dataSizeInBytes)
 {
     D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->internal;
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
     HRESULT result = S_OK;
-    const int vbidx = rendererData->currentVertexBuffer;
     const UINT stride = sizeof(VertexPositionColor);
-    const UINT offset = 0;
+    UINT offset;
 
     if (dataSizeInBytes == 0) {
         return 0; /* nothing to do. */
     }
 
-    if (rendererData->vertexBuffers[vbidx] && rendererData->vertexBufferSizes[vbidx] >= dataSizeInBytes) {
-        D3D11_MAPPED_SUBRESOURCE mappedResource;
-        result = ID3D11DeviceContext_Map(rendererData->d3dContext,
-                                         (ID3D11Resource *)rendererData->vertexBuffers[vbidx],
-                                         0,
-                                         D3D11_MAP_WRITE_DISCARD,
-                                         0,
-                                         &mappedResource);
-        if (FAILED(result)) {
-            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [vertex buffer]"), result);
-        }
-        SDL_memcpy(mappedResource.pData, vertexData, dataSizeInBytes);
-        ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->vertexBuffers[vbidx], 0);
-    } else {
-        D3D11_BUFFER_DESC vertexBufferDesc;
-        D3D11_SUBRESOURCE_DATA vertexBufferData;
-
-        SAFE_RELEASE(rendererData->vertexBuffers[vbidx]);
-
-        SDL_zero(vertexBufferDesc);
-        vertexBufferDesc.ByteWidth = (UINT)dataSizeInBytes;
-        vertexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-        vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vertexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-
-        SDL_zero(vertexBufferData);
-        vertexBufferData.pSysMem = vertexData;
-        vertexBufferData.SysMemPitch = 0;
-        vertexBufferData.SysMemSlicePitch = 0;
-
-        result = ID3D11Device_CreateBuffer(rendererData->d3dDevice,
-                                           &vertexBufferDesc,
-                                           &vertexBufferData,
-                                           &rendererData->vertexBuffers[vbidx]);
-        if (FAILED(result)) {
-            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateBuffer [vertex buffer]"), result);
+    if (rendererData->vertexBufferOffset + dataSizeInBytes > rendererData->vertexBufferSize) {
+        if (dataSizeInBytes > rendererData->vertexBufferSize) {
+            D3D11_BUFFER_DESC vertexBufferDesc;
+            size_t size = SDL_max(rendererData->vertexBufferSize, SDL_D3D11_VERTEX_BUFFER_MIN_SIZE);
+
+            while (size < dataSizeInBytes) {
+                size *= 2;
+            }
+
+            SAFE_RELEASE(rendererData->vertexBuffer);
+            rendererData->vertexBufferSize = 0;
+
+            SDL_zero(vertexBufferDesc);
+            vertexBufferDesc.ByteWidth = (UINT)size;
+            vertexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+            vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+            vertexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+            result = ID3D11Device_CreateBuffer(rendererData->d3dDevice,
+                                               &vertexBufferDesc,
+                                               NULL,
+                                               &rendererData->vertexBuffer);
+            if (FAILED(result)) {
+                return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateBuffer [vertex buffer]"), result);
+            }
+
+            rendererData->vertexBufferSize = size;
         }
 
-        rendererData->vertexBufferSizes[vbidx] = dataSizeInBytes;
+        /* Wrap around, the driver will give us fresh memory for the buffer */
+        rendererData->vertexBufferOffset = 0;
     }
+    if (rendererData->vertexBufferOffset == 0) {
+        mapType = D3D11_MAP_WRITE_DISCARD;
+    }
+
+    result = ID3D11DeviceContext_Map(rendererData->d3dContext,
+                                     (ID3D11Resource *)rendererData->vertexBuffer,
+                                     0,
+                                     mapType,
+                                     0,
+                                     &mappedResource);
+    if (FAILED(result)) {
+        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [vertex buffer]"), result);
+    }
+    SDL_memcpy((Uint8 *)mappedResource.pData + rendererData->vertexBufferOffset, vertexData, dataSizeInBytes);
+    ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->vertexBuffer, 0);
 
+    offset = (UINT)rendererData->vertexBufferOffset;
     ID3D11DeviceContext_IASetVertexBuffers(rendererData->d3dContext,
                                            0,
                                            1,
-                                           &rendererData->vertexBuffers[vbidx],
+                                           &rendererData->vertexBuffer,
                                            &stride,
                                            &offset);
 
-    rendererData->currentVertexBuffer++;
-    if (rendererData->currentVertexBuffer >= SDL_arraysize(rendererData->vertexBuffers)) {
-        rendererData->currentVertexBuffer = 0;
+    rendererData->vertexBufferOffset += dataSizeInBytes;
+
+    return 0;
+}
+
+/* Make sure the next count constant slots are available without wrapping */
+static void D3D11_ReserveConstants(D3D11_RenderData *rendererData, UINT count)
+{
+    if (rendererData->constantBufferOffset + count * SDL_D3D11_CONSTANT_SLOT_SIZE > SDL_D3D11_CONSTANT_BUFFER_SIZE) {
+        /* Anything written before the wrap is gone once we discard the buffer */
+        rendererData->constantBufferOffset = 0;
+        rendererData->constantBufferGeneration++;
+        rendererData->constantBufferDiscard = SDL_TRUE;
     }
+}
 
+static int D3D11_WriteConstants(D3D11_RenderData *rendererData, const void *constants, size_t size, UINT *firstConstant)
+{
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    HRESULT result;
+
+    result = ID3D11DeviceContext_Map(rendererData->d3dContext,
+                                     (ID3D11Resource *)rendererData->constantBuffer,
+                                     0,
+                                     rendererData->constantBufferDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+                                     0,
+                                     &mappedResource);
+    if (FAILED(result)) {
+        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [constant buffer]"), result);
+    }
+    SDL_memcpy((Uint8 *)mappedResource.pData + rendererData->constantBufferOffset, constants, size);
+    ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->constantBuffer, 0);
+
+    /* Offsets are given in shader constants, 16 bytes each */
+    *firstConstant = rendererData->constantBufferOffset / 16;
+    rendererData->constantBufferOffset += SDL_D3D11_CONSTANT_SLOT_SIZE;
+    rendererData->constantBufferDiscard = SDL_FALSE;
     return 0;
 }
 
@@ -2365,8 +2534,23 @@ static int D3D11_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *c
         shader_constants = &solid_constants;
     }
 
-    if (!shader_state->constants ||
-        SDL_memcmp(shader_constants, &shader_state->shader_constants, sizeof(*shader_constants)) != 0) {
+    if (rendererData->constantBuffer) {
+        /* Leave room for both the pixel and vertex shader constants */
+        D3D11_ReserveConstants(rendererData, 2);
+
+        if (shader_state->constantsGeneration != rendererData->constantBufferGeneration ||
+            SDL_memcmp(shader_constants, &shader_state->shader_constants, sizeof(*shader_constants)) != 0) {
+            if (D3D11_WriteConstants(rendererData, shader_constants, sizeof(*shader_constants), &shader_state->constantsOffset) < 0) {
+                return -1;
+            }
+            SDL_memcpy(&shader_state->shader_constants, shader_constants, sizeof(*shader_constants));
+            shader_state->constantsGeneration = rendererData->constantBufferGeneration;
+
+            /* Force the shader parameters to be re-set */
+            rendererData->currentShader = SHADER_NONE;
+        }
+    } else if (!shader_state->constants ||
+               SDL_memcmp(shader_constants, &shader_state->shader_constants, sizeof(*shader_constants)) != 0) {
         SAFE_RELEASE(shader_state->constants);
 
         D3D11_BUFFER_DESC desc;
@@ -2396,7 +2580,10 @@ static int D3D11_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *c
             }
         }
         ID3D11DeviceContext_PSSetShader(rendererData->d3dContext, rendererData->pixelShaders[shader], NULL, 0);
-        if (shader_state->constants) {
+        if (rendererData->constantBuffer) {
+            const UINT numConstants = SDL_D3D11_CONSTANT_SLOT_SIZE / 16;
+            ID3D11DeviceContext1_PSSetConstantBuffers1(rendererData->d3dContext, 0, 1, &rendererData->constantBuffer, &shader_state->constantsOffset, &numConstants);
+        } else if (shader_state->constants) {
             ID3D11DeviceContext_PSSetConstantBuffers(rendererData->d3dContext, 0, 1, &shader_state->constants);
         }
         rendererData->currentShader = shader;
@@ -2410,15 +2597,30 @@ static int D3D11_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *c
         rendererData->currentSampler = sampler;
     }
 
+    if (rendererData->constantBuffer &&
+        rendererData->vertexShaderConstantsGeneration != rendererData->constantBufferGeneration) {
+        updateSubresource = SDL_TRUE;
+    }
     if (updateSubresource == SDL_TRUE || SDL_memcmp(&rendererData->vertexShaderConstantsData.model, newmatrix, sizeof(*newmatrix)) != 0) {
         SDL_copyp(&rendererData->vertexShaderConstantsData.model, newmatrix);
-        ID3D11DeviceContext_UpdateSubresource(rendererData->d3dContext,
-                                              (ID3D11Resource *)rendererData->vertexShaderConstants,
-                                              0,
-                                              NULL,
-                                              &rendererData->vertexShaderConstantsData,
-                                              0,
-                                              0);
+        if (rendererData->constantBuffer) {
+            const UINT numConstants = SDL_D3D11_CONSTANT_SLOT_SIZE / 16;
+            UINT firstConstant;
+
+            if (D3D11_WriteConstants(rendererData, &rendererData->vertexShaderConstantsData, sizeof(rendererData->vertexShaderConstantsData), &firstConstant) < 0) {
+                return -1;
+            }
+            ID3D11DeviceContext1_VSSetConstantBuffers1(rendererData->d3dContext, 0, 1, &rendererData->constantBuffer, &firstConstant, &numConstants);
+            rendererData->vertexShaderConstantsGeneration = rendererData->constantBufferGeneration;
+        } else {
+            ID3D11DeviceContext_UpdateSubresource(rendererData->d3dContext,
+                                                  (ID3D11Resource *)rendererData->vertexShaderConstants,
+                                                  0,
+                                                  NULL,
+                                                  &rendererData->vertexShaderConstantsData,
+                                                  0,
+                                                  0);
+        }
     }
 
     return 0;
@@ -2736,6 +2938,13 @@ static int D3D11_RenderPresent(SDL_Renderer *renderer)
 
     SDL_zero(parameters);
 
+    /* If the application didn't wait for this frame, throttle here like a
+     * swap chain without a waitable object would */
+    if (data->frameLatencyWaitableObject && !data->frameWaited) {
+        WaitForSingleObjectEx(data->frameLatencyWaitableObject, 1000, TRUE);
+    }
+    data->frameWaited = SDL_FALSE;
+
 #if SDL_WINAPI_FAMILY_PHONE
     result = IDXGISwapChain_Present(data->swapChain, data->syncInterval, data->presentFlags);
 #else
@@ -2774,6 +2983,25 @@ static int D3D11_RenderPresent(SDL_Renderer *renderer)
     return 0;
 }
 
+static int D3D11_WaitFrame(SDL_Renderer *renderer, Sint32 timeoutMS)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
+    DWORD result;
+
+    if (!data->frameLatencyWaitableObject || data->frameWaited) {
+        return 0;
+    }
+
+    result = WaitForSingleObjectEx(data->frameLatencyWaitableObject, (timeoutMS < 0) ? INFINITE : (DWORD)timeoutMS, TRUE);
+    if (result == WAIT_TIMEOUT) {
+        return SDL_MUTEX_TIMEDOUT;
+    } else if (result == WAIT_FAILED) {
+        return WIN_SetError("WaitForSingleObjectEx()");
+    }
+    data->frameWaited = SDL_TRUE;
+    return 0;
+}
+
 static int D3D11_SetVSync(SDL_Renderer *renderer, const int vsync)
 {
     D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
@@ -2808,6 +3036,57 @@ static int D3D11_SetVSync(SDL_Renderer *renderer, const int vsync)
     return 0;
 }
 
+static SDL_bool D3D11_SupportsPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
+
+    switch (mode) {
+    case SDL_PRESENTMODE_FIFO:
+        return SDL_TRUE;
+#if !SDL_WINAPI_FAMILY_PHONE
+    case SDL_PRESENTMODE_MAILBOX:
+        /* Flip model swap chains replace the queued frame without tearing */
+        return (data->swapEffect == DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL);
+    case SDL_PRESENTMODE_IMMEDIATE:
+        /* Blit model swap chains tear, flip model ones need tearing support */
+        return (data->swapEffect != DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL) || (data->swapFlags & DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING);
+    case SDL_PRESENTMODE_VRR:
+        /* Variable refresh rate displays are driven by presenting with tearing allowed */
+        return (data->swapFlags & DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING) ? SDL_TRUE : SDL_FALSE;
+#endif
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static int D3D11_SetPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    D3D11_RenderData *data = (D3D11_RenderData *)renderer->internal;
+
+    switch (mode) {
+    case SDL_PRESENTMODE_FIFO:
+        data->syncInterval = 1;
+        data->presentFlags = 0;
+        break;
+    case SDL_PRESENTMODE_MAILBOX:
+        data->syncInterval = 0;
+        data->presentFlags = DXGI_PRESENT_DO_NOT_WAIT;
+        break;
+    case SDL_PRESENTMODE_IMMEDIATE:
+    case SDL_PRESENTMODE_VRR:
+        data->syncInterval = 0;
+        if (data->swapFlags & DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING) {
+            data->presentFlags = DXGI_PRESENT_ALLOW_TEARING;
+        } else {
+            data->presentFlags = DXGI_PRESENT_DO_NOT_WAIT;
+        }
+        break;
+    default:
+        return SDL_Unsupported();
+    }
+    return 0;
+}
+
 static int D3D11_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_PropertiesID create_props)
 {
     D3D11_RenderData *data;
@@ -2831,6 +3110,7 @@ static int D3D11_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
     }
 
     data->identity = MatrixIdentity();
+    data->maxFrameLatency = (UINT)SDL_clamp(SDL_GetNumberProperty(create_props, SDL_PROP_RENDERER_CREATE_D3D_MAX_FRAME_LATENCY_NUMBER, 1), 1, 16);
 
     renderer->WindowEvent = D3D11_WindowEvent;
     renderer->SupportsBlendMode = D3D11_SupportsBlendMode;
@@ -2853,9 +3133,12 @@ static int D3D11_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
     renderer->RunCommandQueue = D3D11_RunCommandQueue;
     renderer->RenderReadPixels = D3D11_RenderReadPixels;
     renderer->RenderPresent = D3D11_RenderPresent;
+    renderer->WaitFrame = D3D11_WaitFrame;
     renderer->DestroyTexture = D3D11_DestroyTexture;
     renderer->DestroyRenderer = D3D11_DestroyRenderer;
     renderer->SetVSync = D3D11_SetVSync;
+    renderer->SupportsPresentMode = D3D11_SupportsPresentMode;
+    renderer->SetPresentMode = D3D11_SetPresentMode;
     renderer->internal = data;
     D3D11_InvalidateCachedState(renderer);
 
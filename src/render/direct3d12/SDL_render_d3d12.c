@@ -23,9 +23,11 @@
 #if SDL_VIDEO_RENDER_D3D12
 
 #define SDL_D3D12_NUM_BUFFERS        2
+#define SDL_D3D12_FRAMES_IN_FLIGHT   2
 #define SDL_D3D12_NUM_VERTEX_BUFFERS 256
 #define SDL_D3D12_MAX_NUM_TEXTURES   16384
 #define SDL_D3D12_NUM_UPLOAD_BUFFERS 32
+#define SDL_D3D12_UPLOAD_RING_SIZE   (8 * 1024 * 1024)
 
 #include "../../core/windows/SDL_windows.h"
 #include "../../video/windows/SDL_windowswindow.h"
@@ -113,7 +115,7 @@ typedef struct
 } VertexPositionColor;
 
 /* Per-texture data */
-typedef struct
+typedef struct D3D12_TextureData
 {
     int w, h;
     ID3D12Resource *mainTexture;
@@ -148,6 +150,9 @@ typedef struct
     int pitch;
 #endif
     SDL_Rect lockedRect;
+
+    /* Textures are freed once the GPU is done with the frame that destroyed them */
+    struct D3D12_TextureData *nextToDestroy;
 } D3D12_TextureData;
 
 /* Pipeline State Object data */
@@ -169,6 +174,28 @@ typedef struct
     size_t size;
 } D3D12_VertexBuffer;
 
+/* A persistently mapped upload buffer that texture updates and vertex data are sub-allocated from.
+   It's emptied whenever the command list is reset, at which point the GPU has finished with it. */
+typedef struct
+{
+    ID3D12Resource *resource;
+    BYTE *data;
+    D3D12_GPU_VIRTUAL_ADDRESS gpuAddress;
+    UINT64 size;
+    UINT64 offset;
+} D3D12_UploadRing;
+
+/* Everything a frame uses that can only be recycled once the GPU has finished that frame */
+typedef struct
+{
+    ID3D12CommandAllocator *commandAllocator;
+    UINT64 fenceValue;
+    D3D12_UploadRing uploadRing;
+    ID3D12Resource *uploadBuffers[SDL_D3D12_NUM_UPLOAD_BUFFERS];
+    int currentUploadBuffer;
+    D3D12_TextureData *texturesToDestroy;
+} D3D12_FrameData;
+
 /* For SRV pool allocator */
 typedef struct
 {
@@ -188,6 +215,8 @@ typedef struct
     IDXGIAdapter4 *dxgiAdapter;
     IDXGIDebug *dxgiDebug;
     IDXGISwapChain4 *swapChain;
+    HANDLE frameLatencyWaitableObject;
+    SDL_bool frameWaited;
 #endif
     ID3D12Device1 *d3dDevice;
     ID3D12Debug *debugInterface;
@@ -197,6 +226,8 @@ typedef struct
     UINT swapFlags;
     UINT syncInterval;
     UINT presentFlags;
+    UINT maxFrameLatency;
+    SDL_bool supportsTearing;
     DXGI_FORMAT renderTargetFormat;
     SDL_bool pixelSizeChanged;
 
@@ -210,11 +241,14 @@ typedef struct
     UINT samplerDescriptorSize;
 
     /* Data needed per backbuffer */
-    ID3D12CommandAllocator *commandAllocators[SDL_D3D12_NUM_BUFFERS];
     ID3D12Resource *renderTargets[SDL_D3D12_NUM_BUFFERS];
     UINT64 fenceValue;
     int currentBackBufferIndex;
 
+    /* Data needed per frame in flight, the CPU can record one frame while the GPU works on the others */
+    D3D12_FrameData frames[SDL_D3D12_FRAMES_IN_FLIGHT];
+    int currentFrame;
+
     /* Fences */
     ID3D12Fence *fence;
     HANDLE fenceEvent;
@@ -226,12 +260,9 @@ typedef struct
     D3D12_PipelineState *currentPipelineState;
 
     D3D12_VertexBuffer vertexBuffers[SDL_D3D12_NUM_VERTEX_BUFFERS];
+    SDL_bool vertexBuffersInFlight;
     D3D12_CPU_DESCRIPTOR_HANDLE samplers[SDL_D3D12_NUM_SAMPLERS];
 
-    /* Data for staging/allocating textures */
-    ID3D12Resource *uploadBuffers[SDL_D3D12_NUM_UPLOAD_BUFFERS];
-    int currentUploadBuffer;
-
     /* Pool allocator to handle reusing SRV heap indices */
     D3D12_SRVPoolNode *srvPoolHead;
     D3D12_SRVPoolNode srvPoolNodes[SDL_D3D12_MAX_NUM_TEXTURES];
@@ -370,6 +401,40 @@ static DXGI_FORMAT SDLPixelFormatToDXGIMainResourceViewFormat(Uint32 format, Uin
 }
 
 static void D3D12_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture);
+static void D3D12_DestroyTextureData(D3D12_RenderData *rendererData, D3D12_TextureData *textureData);
+
+/* Recycles everything a frame used, the GPU must be done with that frame */
+static void D3D12_RecycleFrameData(D3D12_RenderData *data, D3D12_FrameData *frame)
+{
+    int i;
+
+    /* Release any upload buffers that were inflight */
+    for (i = 0; i < frame->currentUploadBuffer; ++i) {
+        D3D_SAFE_RELEASE(frame->uploadBuffers[i]);
+    }
+    frame->currentUploadBuffer = 0;
+    frame->uploadRing.offset = 0;
+
+    /* Free any textures that were destroyed while this frame was being recorded */
+    while (frame->texturesToDestroy) {
+        D3D12_TextureData *textureData = frame->texturesToDestroy;
+        frame->texturesToDestroy = textureData->nextToDestroy;
+        D3D12_DestroyTextureData(data, textureData);
+    }
+}
+
+static void D3D12_ReleaseFrameData(D3D12_RenderData *data, D3D12_FrameData *frame)
+{
+    D3D12_RecycleFrameData(data, frame);
+
+    D3D_SAFE_RELEASE(frame->commandAllocator);
+    if (frame->uploadRing.resource) {
+        ID3D12Resource_Unmap(frame->uploadRing.resource, 0, NULL);
+        D3D_SAFE_RELEASE(frame->uploadRing.resource);
+    }
+    SDL_zero(frame->uploadRing);
+    frame->fenceValue = 0;
+}
 
 static void D3D12_ReleaseAll(SDL_Renderer *renderer)
 {
@@ -393,6 +458,11 @@ static void D3D12_ReleaseAll(SDL_Renderer *renderer)
         D3D_SAFE_RELEASE(data->dxgiFactory);
         D3D_SAFE_RELEASE(data->dxgiAdapter);
         D3D_SAFE_RELEASE(data->swapChain);
+        if (data->frameLatencyWaitableObject) {
+            CloseHandle(data->frameLatencyWaitableObject);
+            data->frameLatencyWaitableObject = NULL;
+        }
+        data->frameWaited = SDL_FALSE;
 #endif
         D3D_SAFE_RELEASE(data->d3dDevice);
         D3D_SAFE_RELEASE(data->debugInterface);
@@ -405,10 +475,14 @@ static void D3D12_ReleaseAll(SDL_Renderer *renderer)
         D3D_SAFE_RELEASE(data->fence);
 
         for (i = 0; i < SDL_D3D12_NUM_BUFFERS; ++i) {
-            D3D_SAFE_RELEASE(data->commandAllocators[i]);
             D3D_SAFE_RELEASE(data->renderTargets[i]);
         }
 
+        for (i = 0; i < SDL_D3D12_FRAMES_IN_FLIGHT; ++i) {
+            D3D12_ReleaseFrameData(data, &data->frames[i]);
+        }
+        data->currentFrame = 0;
+
         if (data->pipelineStateCount > 0) {
             for (i = 0; i < data->pipelineStateCount; ++i) {
                 D3D_SAFE_RELEASE(data->pipelineStates[i].pipelineState);
@@ -426,6 +500,8 @@ static void D3D12_ReleaseAll(SDL_Renderer *renderer)
             data->vertexBuffers[i].size = 0;
         }
 
+        data->vertexBuffersInFlight = SDL_FALSE;
+
         data->swapEffect = (DXGI_SWAP_EFFECT)0;
         data->swapFlags = 0;
         data->currentRenderTargetView.ptr = 0;
@@ -482,6 +558,7 @@ static void D3D12_WaitForGPU(D3D12_RenderData *data)
         }
 
         data->fenceValue++;
+        data->vertexBuffersInFlight = SDL_FALSE;
     }
 }
 
@@ -519,14 +596,14 @@ static void D3D12_TransitionResource(D3D12_RenderData *data,
     }
 }
 
+/* The GPU must be done with the current frame before calling this */
 static void D3D12_ResetCommandList(D3D12_RenderData *data)
 {
-    int i;
     ID3D12DescriptorHeap *rootDescriptorHeaps[] = { data->srvDescriptorHeap, data->samplerDescriptorHeap };
-    ID3D12CommandAllocator *commandAllocator = data->commandAllocators[data->currentBackBufferIndex];
+    D3D12_FrameData *frame = &data->frames[data->currentFrame];
 
-    ID3D12CommandAllocator_Reset(commandAllocator);
-    ID3D12GraphicsCommandList2_Reset(data->commandList, commandAllocator, NULL);
+    ID3D12CommandAllocator_Reset(frame->commandAllocator);
+    ID3D12GraphicsCommandList2_Reset(data->commandList, frame->commandAllocator, NULL);
     data->currentPipelineState = NULL;
     data->currentVertexBuffer = 0;
     data->issueBatch = SDL_FALSE;
@@ -535,11 +612,7 @@ static void D3D12_ResetCommandList(D3D12_RenderData *data)
     data->currentRenderTargetView.ptr = 0;
     /* FIXME should we also clear currentSampler.ptr and currentRenderTargetView.ptr ? (and use D3D12_InvalidateCachedState() instead) */
 
-    /* Release any upload buffers that were inflight */
-    for (i = 0; i < data->currentUploadBuffer; ++i) {
-        D3D_SAFE_RELEASE(data->uploadBuffers[i]);
-    }
-    data->currentUploadBuffer = 0;
+    D3D12_RecycleFrameData(data, frame);
 
     ID3D12GraphicsCommandList2_SetDescriptorHeaps(data->commandList, 2, rootDescriptorHeaps);
 }
@@ -758,6 +831,85 @@ static HRESULT D3D12_CreateVertexBuffer(D3D12_RenderData *data, size_t vbidx, si
     return result;
 }
 
+static HRESULT D3D12_CreateUploadRing(D3D12_RenderData *data, D3D12_UploadRing *ring)
+{
+    D3D12_HEAP_PROPERTIES heapProps;
+    D3D12_RESOURCE_DESC bufferDesc;
+    D3D12_RANGE range;
+    HRESULT result;
+
+    SDL_zero(heapProps);
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+    heapProps.CreationNodeMask = 1;
+    heapProps.VisibleNodeMask = 1;
+
+    SDL_zero(bufferDesc);
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    bufferDesc.Width = SDL_D3D12_UPLOAD_RING_SIZE;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.SampleDesc.Quality = 0;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    bufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+    result = ID3D12Device1_CreateCommittedResource(data->d3dDevice,
+                      &heapProps,
+                      D3D12_HEAP_FLAG_NONE,
+                      &bufferDesc,
+                      D3D12_RESOURCE_STATE_GENERIC_READ,
+                      NULL,
+                      D3D_GUID(SDL_IID_ID3D12Resource),
+                      (void **)&ring->resource);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateCommittedResource [upload ring]"), result);
+        return result;
+    }
+
+    /* The CPU never reads from it, and upload heap resources can stay mapped */
+    range.Begin = 0;
+    range.End = 0;
+    result = ID3D12Resource_Map(ring->resource, 0, &range, (void **)&ring->data);
+    if (FAILED(result)) {
+        D3D_SAFE_RELEASE(ring->resource);
+        WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Resource::Map [upload ring]"), result);
+        return result;
+    }
+
+    ring->gpuAddress = ID3D12Resource_GetGPUVirtualAddress(ring->resource);
+    ring->size = SDL_D3D12_UPLOAD_RING_SIZE;
+    ring->offset = 0;
+
+    return result;
+}
+
+/* Returns SDL_FALSE if the request doesn't fit in the ring at all, in which case the caller needs its own buffer */
+static SDL_bool D3D12_AllocateUpload(D3D12_RenderData *data, UINT64 size, UINT64 alignment, UINT64 *offsetOut)
+{
+    D3D12_UploadRing *ring = &data->frames[data->currentFrame].uploadRing;
+    UINT64 offset;
+
+    if (!ring->resource || size > ring->size) {
+        return SDL_FALSE;
+    }
+
+    offset = (ring->offset + alignment - 1) & ~(alignment - 1);
+    if (offset + size > ring->size) {
+        /* Wait for the GPU to be done with everything in this frame's ring and start over */
+        if (FAILED(D3D12_IssueBatch(data))) {
+            return SDL_FALSE;
+        }
+        offset = 0;
+    }
+
+    ring->offset = offset + size;
+    *offsetOut = offset;
+    return SDL_TRUE;
+}
+
 /* Create resources that depend on the device. */
 static HRESULT D3D12_CreateDeviceResources(SDL_Renderer *renderer)
 {
@@ -884,6 +1036,15 @@ static HRESULT D3D12_CreateDeviceResources(SDL_Renderer *renderer)
         goto done;
     }
 
+    /* Tearing is needed for immediate and variable refresh rate presentation */
+    {
+        BOOL allowTearing = FALSE;
+        if (FAILED(IDXGIFactory6_CheckFeatureSupport(data->dxgiFactory, DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing)))) {
+            allowTearing = FALSE;
+        }
+        data->supportsTearing = allowTearing ? SDL_TRUE : SDL_FALSE;
+    }
+
     /* Prefer a high performance adapter if there are multiple choices */
     result = IDXGIFactory6_EnumAdapterByGpuPreference(data->dxgiFactory,
                       0,
@@ -1002,12 +1163,12 @@ static HRESULT D3D12_CreateDeviceResources(SDL_Renderer *renderer)
     rootDescriptorHeaps[1] = data->samplerDescriptorHeap;
     data->samplerDescriptorSize = ID3D12Device1_GetDescriptorHandleIncrementSize(d3dDevice, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
 
-    /* Create a command allocator for each back buffer */
-    for (i = 0; i < SDL_D3D12_NUM_BUFFERS; ++i) {
+    /* Create a command allocator for each frame in flight */
+    for (i = 0; i < SDL_D3D12_FRAMES_IN_FLIGHT; ++i) {
         result = ID3D12Device1_CreateCommandAllocator(data->d3dDevice,
                           D3D12_COMMAND_LIST_TYPE_DIRECT,
                           D3D_GUID(SDL_IID_ID3D12CommandAllocator),
-                          (void **)&data->commandAllocators[i]);
+                          (void **)&data->frames[i].commandAllocator);
         if (FAILED(result)) {
             WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateCommandAllocator"), result);
             goto done;
@@ -1018,7 +1179,7 @@ static HRESULT D3D12_CreateDeviceResources(SDL_Renderer *renderer)
     result = ID3D12Device1_CreateCommandList(data->d3dDevice,
                       0,
                       D3D12_COMMAND_LIST_TYPE_DIRECT,
-                      data->commandAllocators[0],
+                      data->frames[data->currentFrame].commandAllocator,
                       NULL,
                       D3D_GUID(SDL_IID_ID3D12GraphicsCommandList2),
                       (void **)&data->commandList);
@@ -1090,9 +1251,13 @@ static HRESULT D3D12_CreateDeviceResources(SDL_Renderer *renderer)
         }
     }
 
-    /* Create default vertex buffers  */
-    for (i = 0; i < SDL_D3D12_NUM_VERTEX_BUFFERS; ++i) {
-        D3D12_CreateVertexBuffer(data, i, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+    /* Create an upload ring per frame for texture updates and vertex data. Vertex buffers
+       of their own are only created for batches too big for the ring. */
+    for (i = 0; i < SDL_D3D12_FRAMES_IN_FLIGHT; ++i) {
+        result = D3D12_CreateUploadRing(data, &data->frames[i].uploadRing);
+        if (FAILED(result)) {
+            goto done;
+        }
     }
 
     /* Create samplers to use when drawing textures: */
@@ -1248,8 +1413,10 @@ static HRESULT D3D12_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         swapChainDesc.Scaling = DXGI_SCALING_STRETCH;
     }
     swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;               /* All Windows Store apps must use this SwapEffect. */
-    swapChainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT | /* To support SetMaximumFrameLatency */
-                          DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;                  /* To support presenting with allow tearing on */
+    swapChainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT; /* To support SetMaximumFrameLatency */
+    if (data->supportsTearing) {
+        swapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;            /* To support presenting with allow tearing on */
+    }
 
     HWND hwnd = (HWND)SDL_GetPointerProperty(SDL_GetWindowProperties(renderer->window), SDL_PROP_WINDOW_WIN32_HWND_POINTER, NULL);
     if (!hwnd) {
@@ -1278,14 +1445,17 @@ static HRESULT D3D12_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         goto done;
     }
 
-    /* Ensure that the swapchain does not queue more than one frame at a time. This both reduces latency
-     * and ensures that the application will only render after each VSync, minimizing power consumption.
+    /* Ensure that the swapchain does not queue more frames than the application asked for, one by
+     * default. This both reduces latency and ensures that the application will only render after
+     * each VSync, minimizing power consumption.
      */
-    result = IDXGISwapChain4_SetMaximumFrameLatency(data->swapChain, 1);
+    result = IDXGISwapChain4_SetMaximumFrameLatency(data->swapChain, data->maxFrameLatency);
     if (FAILED(result)) {
         WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("IDXGISwapChain4::SetMaximumFrameLatency"), result);
         goto done;
     }
+    data->frameLatencyWaitableObject = IDXGISwapChain4_GetFrameLatencyWaitableObject(data->swapChain);
+    data->frameWaited = SDL_FALSE;
 
     data->swapEffect = swapChainDesc.SwapEffect;
     data->swapFlags = swapChainDesc.Flags;
@@ -1318,6 +1488,7 @@ static HRESULT D3D12_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     }
 
     SDL_SetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_D3D12_SWAPCHAIN_POINTER, data->swapChain);
+    SDL_SetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_D3D12_FRAME_LATENCY_WAITABLE_POINTER, data->frameLatencyWaitableObject);
 
 done:
     D3D_SAFE_RELEASE(swapChain);
@@ -1532,9 +1703,8 @@ static SIZE_T D3D12_GetAvailableSRVIndex(SDL_Renderer *renderer)
     }
 }
 
-static void D3D12_FreeSRVIndex(SDL_Renderer *renderer, SIZE_T index)
+static void D3D12_FreeSRVIndex(D3D12_RenderData *rendererData, SIZE_T index)
 {
-    D3D12_RenderData *rendererData = (D3D12_RenderData *)renderer->internal;
     rendererData->srvPoolNodes[index].next = rendererData->srvPoolHead;
     rendererData->srvPoolHead = &rendererData->srvPoolNodes[index];
 }
@@ -1616,6 +1786,20 @@ static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     if (GetTextureProperty(create_props, "d3d12.texture", &textureData->mainTexture) < 0) {
         return -1;
     }
+    textureData->mainResourceState = D3D12_RESOURCE_STATE_COPY_DEST;
+#if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+    if (!textureData->mainTexture) {
+        HANDLE shared_handle = (HANDLE)SDL_GetPointerProperty(create_props, SDL_PROP_TEXTURE_CREATE_D3D12_SHARED_HANDLE_POINTER, NULL);
+        if (shared_handle) {
+            result = ID3D12Device1_OpenSharedHandle(rendererData->d3dDevice, shared_handle, D3D_GUID(SDL_IID_ID3D12Resource), (void **)&textureData->mainTexture);
+            if (FAILED(result)) {
+                return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::OpenSharedHandle"), result);
+            }
+            /* Shared resources are handed over in the common state */
+            textureData->mainResourceState = D3D12_RESOURCE_STATE_COMMON;
+        }
+    }
+#endif
     if (!textureData->mainTexture) {
         result = ID3D12Device1_CreateCommittedResource(rendererData->d3dDevice,
                           &heapProps,
@@ -1629,7 +1813,6 @@ static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
             return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateCommittedResource [texture]"), result);
         }
     }
-    textureData->mainResourceState = D3D12_RESOURCE_STATE_COPY_DEST;
     SDL_SetPointerProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_D3D12_TEXTURE_POINTER, textureData->mainTexture);
 #if SDL_HAVE_YUV
     if (texture->format == SDL_PIXELFORMAT_YV12 ||
@@ -1776,36 +1959,42 @@ static int D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     return 0;
 }
 
-static void D3D12_DestroyTexture(SDL_Renderer *renderer,
-                                 SDL_Texture *texture)
+static void D3D12_DestroyTextureData(D3D12_RenderData *rendererData, D3D12_TextureData *textureData)
 {
-    D3D12_RenderData *rendererData = (D3D12_RenderData *)renderer->internal;
-    D3D12_TextureData *textureData = (D3D12_TextureData *)texture->internal;
-
-    if (!textureData) {
-        return;
-    }
-
-    /* Because SDL_DestroyTexture might be called while the data is in-flight, we need to issue the batch first
-       Unfortunately, this means that deleting a lot of textures mid-frame will have poor performance. */
-    D3D12_IssueBatch(rendererData);
-
     D3D_SAFE_RELEASE(textureData->mainTexture);
     D3D_SAFE_RELEASE(textureData->stagingBuffer);
-    D3D12_FreeSRVIndex(renderer, textureData->mainSRVIndex);
+    D3D12_FreeSRVIndex(rendererData, textureData->mainSRVIndex);
 #if SDL_HAVE_YUV
     D3D_SAFE_RELEASE(textureData->mainTextureU);
     D3D_SAFE_RELEASE(textureData->mainTextureV);
     if (textureData->yuv) {
-        D3D12_FreeSRVIndex(renderer, textureData->mainSRVIndexU);
-        D3D12_FreeSRVIndex(renderer, textureData->mainSRVIndexV);
+        D3D12_FreeSRVIndex(rendererData, textureData->mainSRVIndexU);
+        D3D12_FreeSRVIndex(rendererData, textureData->mainSRVIndexV);
     }
     if (textureData->nv12) {
-        D3D12_FreeSRVIndex(renderer, textureData->mainSRVIndexNV);
+        D3D12_FreeSRVIndex(rendererData, textureData->mainSRVIndexNV);
     }
     SDL_free(textureData->pixels);
 #endif
     SDL_free(textureData);
+}
+
+static void D3D12_DestroyTexture(SDL_Renderer *renderer,
+                                 SDL_Texture *texture)
+{
+    D3D12_RenderData *rendererData = (D3D12_RenderData *)renderer->internal;
+    D3D12_TextureData *textureData = (D3D12_TextureData *)texture->internal;
+    D3D12_FrameData *frame;
+
+    if (!textureData) {
+        return;
+    }
+
+    /* SDL_DestroyTexture might be called while the texture is in-flight, so the resources
+       and SRV descriptors are kept until the GPU is done with the current frame. */
+    frame = &rendererData->frames[rendererData->currentFrame];
+    textureData->nextToDestroy = frame->texturesToDestroy;
+    frame->texturesToDestroy = textureData;
     texture->internal = NULL;
 }
 
@@ -1823,6 +2012,9 @@ static int D3D12_UpdateTextureInternal(D3D12_RenderData *rendererData, ID3D12Res
     D3D12_TEXTURE_COPY_LOCATION dstLocation;
     BYTE *textureMemory;
     ID3D12Resource *uploadBuffer;
+    UINT64 uploadOffset;
+    SDL_bool dedicatedUploadBuffer;
+    D3D12_FrameData *frame = &rendererData->frames[rendererData->currentFrame];
     UINT row, NumRows, RowPitch;
     UINT64 RowLength;
 
@@ -1861,33 +2053,41 @@ static int D3D12_UpdateTextureInternal(D3D12_RenderData *rendererData, ID3D12Res
              &uploadDesc.Width);
     RowPitch = placedTextureDesc.Footprint.RowPitch;
 
-    SDL_zero(heapProps);
-    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-    heapProps.CreationNodeMask = 1;
-    heapProps.VisibleNodeMask = 1;
+    if (D3D12_AllocateUpload(rendererData, uploadDesc.Width, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, &uploadOffset)) {
+        uploadBuffer = frame->uploadRing.resource;
+        textureMemory = frame->uploadRing.data + uploadOffset;
+        placedTextureDesc.Offset = uploadOffset;
+        dedicatedUploadBuffer = SDL_FALSE;
+    } else {
+        /* Too big for the upload ring, create an upload buffer just for this */
+        SDL_zero(heapProps);
+        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+        heapProps.CreationNodeMask = 1;
+        heapProps.VisibleNodeMask = 1;
 
-    /* Create the upload buffer */
-    result = ID3D12Device1_CreateCommittedResource(rendererData->d3dDevice,
-                      &heapProps,
-                      D3D12_HEAP_FLAG_NONE,
-                      &uploadDesc,
-                      D3D12_RESOURCE_STATE_GENERIC_READ,
-                      NULL,
-                      D3D_GUID(SDL_IID_ID3D12Resource),
-                      (void **)&rendererData->uploadBuffers[rendererData->currentUploadBuffer]);
-    if (FAILED(result)) {
-        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateCommittedResource [create upload buffer]"), result);
-    }
+        result = ID3D12Device1_CreateCommittedResource(rendererData->d3dDevice,
+                          &heapProps,
+                          D3D12_HEAP_FLAG_NONE,
+                          &uploadDesc,
+                          D3D12_RESOURCE_STATE_GENERIC_READ,
+                          NULL,
+                          D3D_GUID(SDL_IID_ID3D12Resource),
+                          (void **)&frame->uploadBuffers[frame->currentUploadBuffer]);
+        if (FAILED(result)) {
+            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateCommittedResource [create upload buffer]"), result);
+        }
 
-    /* Get a write-only pointer to data in the upload buffer: */
-    uploadBuffer = rendererData->uploadBuffers[rendererData->currentUploadBuffer];
-    result = ID3D12Resource_Map(uploadBuffer,
-                      0,
-                      NULL,
-                      (void **)&textureMemory);
-    if (FAILED(result)) {
-        D3D_SAFE_RELEASE(rendererData->uploadBuffers[rendererData->currentUploadBuffer]);
-        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Resource::Map [map staging texture]"), result);
+        /* Get a write-only pointer to data in the upload buffer: */
+        uploadBuffer = frame->uploadBuffers[frame->currentUploadBuffer];
+        result = ID3D12Resource_Map(uploadBuffer,
+                          0,
+                          NULL,
+                          (void **)&textureMemory);
+        if (FAILED(result)) {
+            D3D_SAFE_RELEASE(frame->uploadBuffers[frame->currentUploadBuffer]);
+            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Resource::Map [map staging texture]"), result);
+        }
+        dedicatedUploadBuffer = SDL_TRUE;
     }
 
     src = (const Uint8 *)pixels;
@@ -1909,8 +2109,10 @@ static int D3D12_UpdateTextureInternal(D3D12_RenderData *rendererData, ID3D12Res
         }
     }
 
-    /* Commit the changes back to the upload buffer: */
-    ID3D12Resource_Unmap(uploadBuffer, 0, NULL);
+    /* Commit the changes back to the upload buffer, the ring stays mapped */
+    if (dedicatedUploadBuffer) {
+        ID3D12Resource_Unmap(uploadBuffer, 0, NULL);
+    }
 
     /* Make sure the destination is in the correct resource state */
     D3D12_TransitionResource(rendererData, texture, *resourceState, D3D12_RESOURCE_STATE_COPY_DEST);
@@ -1922,7 +2124,7 @@ static int D3D12_UpdateTextureInternal(D3D12_RenderData *rendererData, ID3D12Res
     dstLocation.SubresourceIndex = plane;
 
     SDL_zero(srcLocation);
-    srcLocation.pResource = rendererData->uploadBuffers[rendererData->currentUploadBuffer];
+    srcLocation.pResource = uploadBuffer;
     srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
     srcLocation.PlacedFootprint = placedTextureDesc;
 
@@ -1938,10 +2140,12 @@ static int D3D12_UpdateTextureInternal(D3D12_RenderData *rendererData, ID3D12Res
     D3D12_TransitionResource(rendererData, texture, *resourceState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
     *resourceState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 
-    rendererData->currentUploadBuffer++;
-    /* If we've used up all the upload buffers, we need to issue the batch */
-    if (rendererData->currentUploadBuffer == SDL_D3D12_NUM_UPLOAD_BUFFERS) {
-        D3D12_IssueBatch(rendererData);
+    if (dedicatedUploadBuffer) {
+        frame->currentUploadBuffer++;
+        /* If we've used up all the upload buffers, we need to issue the batch */
+        if (frame->currentUploadBuffer == SDL_D3D12_NUM_UPLOAD_BUFFERS) {
+            D3D12_IssueBatch(rendererData);
+        }
     }
 
     return 0;
@@ -2135,7 +2339,7 @@ static int D3D12_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                       NULL,
                       (void **)&textureMemory);
     if (FAILED(result)) {
-        D3D_SAFE_RELEASE(rendererData->uploadBuffers[rendererData->currentUploadBuffer]);
+        D3D_SAFE_RELEASE(textureData->stagingBuffer);
         return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Resource::Map [map staging texture]"), result);
     }
 
@@ -2174,6 +2378,7 @@ static void D3D12_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     D3D12_PLACED_SUBRESOURCE_FOOTPRINT placedTextureDesc;
     D3D12_TEXTURE_COPY_LOCATION srcLocation;
     D3D12_TEXTURE_COPY_LOCATION dstLocation;
+    D3D12_FrameData *frame;
     int bpp;
 
     if (!textureData) {
@@ -2238,9 +2443,13 @@ static void D3D12_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     D3D12_TransitionResource(rendererData, textureData->mainTexture, textureData->mainResourceState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
     textureData->mainResourceState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 
-    /* Execute the command list before releasing the staging buffer */
-    D3D12_IssueBatch(rendererData);
-    D3D_SAFE_RELEASE(textureData->stagingBuffer);
+    /* The staging buffer is released with the frame's other upload buffers once the GPU is done with it */
+    frame = &rendererData->frames[rendererData->currentFrame];
+    frame->uploadBuffers[frame->currentUploadBuffer++] = textureData->stagingBuffer;
+    textureData->stagingBuffer = NULL;
+    if (frame->currentUploadBuffer == SDL_D3D12_NUM_UPLOAD_BUFFERS) {
+        D3D12_IssueBatch(rendererData);
+    }
 }
 
 static void D3D12_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode)
@@ -2386,6 +2595,7 @@ static int D3D12_UpdateVertexBuffer(SDL_Renderer *renderer,
     UINT8 *vertexBufferData = NULL;
     D3D12_RANGE range;
     ID3D12Resource *vertexBuffer;
+    UINT64 uploadOffset;
 
     range.Begin = 0;
     range.End = 0;
@@ -2401,6 +2611,26 @@ static int D3D12_UpdateVertexBuffer(SDL_Renderer *renderer,
         }
     }
 
+    /* Vertex data normally goes in the upload ring, so it doesn't need a Map() per batch */
+    if (D3D12_AllocateUpload(rendererData, dataSizeInBytes, 16, &uploadOffset)) {
+        D3D12_VERTEX_BUFFER_VIEW view;
+
+        D3D12_UploadRing *ring = &rendererData->frames[rendererData->currentFrame].uploadRing;
+
+        SDL_memcpy(ring->data + uploadOffset, vertexData, dataSizeInBytes);
+
+        view.BufferLocation = ring->gpuAddress + uploadOffset;
+        view.SizeInBytes = (UINT)dataSizeInBytes;
+        view.StrideInBytes = sizeof(VertexPositionColor);
+        ID3D12GraphicsCommandList2_IASetVertexBuffers(rendererData->commandList, 0, 1, &view);
+        return S_OK;
+    }
+
+    /* The dedicated vertex buffers are reused every frame, so a previous frame may still be reading them */
+    if (rendererData->vertexBuffersInFlight) {
+        D3D12_WaitForGPU(rendererData);
+    }
+
     /* If the existing vertex buffer isn't big enough, we need to recreate a big enough one */
     if (dataSizeInBytes > rendererData->vertexBuffers[vbidx].size) {
         D3D12_CreateVertexBuffer(rendererData, vbidx, dataSizeInBytes);
@@ -3121,6 +3351,13 @@ static int D3D12_RenderPresent(SDL_Renderer *renderer)
 #if defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES)
     result = D3D12_XBOX_PresentFrame(data->commandQueue, data->frameToken, data->renderTargets[data->currentBackBufferIndex]);
 #else
+    /* If the application didn't wait for this frame, throttle here so
+     * we don't queue more frames than the maximum frame latency allows */
+    if (data->frameLatencyWaitableObject && !data->frameWaited) {
+        WaitForSingleObjectEx(data->frameLatencyWaitableObject, 1000, TRUE);
+    }
+    data->frameWaited = SDL_FALSE;
+
     /* The application may optionally specify "dirty" or "scroll"
      * rects to improve efficiency in certain scenarios.
      */
@@ -3141,17 +3378,27 @@ static int D3D12_RenderPresent(SDL_Renderer *renderer)
         }
         return -1;
     } else {
-        /* Wait for the GPU and move to the next frame */
+        D3D12_FrameData *frame = &data->frames[data->currentFrame];
+
+        /* Mark the end of this frame on the GPU timeline */
         result = ID3D12CommandQueue_Signal(data->commandQueue, data->fence, data->fenceValue);
+        frame->fenceValue = data->fenceValue;
+        data->fenceValue++;
 
-        if (ID3D12Fence_GetCompletedValue(data->fence) < data->fenceValue) {
+        if (data->currentVertexBuffer > 0 || data->issueBatch) {
+            data->vertexBuffersInFlight = SDL_TRUE;
+        }
+
+        /* Move to the next frame, only waiting if the GPU is still working on the last frame that used it */
+        data->currentFrame = (data->currentFrame + 1) % SDL_D3D12_FRAMES_IN_FLIGHT;
+        frame = &data->frames[data->currentFrame];
+        if (ID3D12Fence_GetCompletedValue(data->fence) < frame->fenceValue) {
             result = ID3D12Fence_SetEventOnCompletion(data->fence,
-                              data->fenceValue,
+                              frame->fenceValue,
                               data->fenceEvent);
             WaitForSingleObjectEx(data->fenceEvent, INFINITE, FALSE);
         }
 
-        data->fenceValue++;
 #if defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES)
         data->currentBackBufferIndex++;
         data->currentBackBufferIndex %= SDL_D3D12_NUM_BUFFERS;
@@ -3173,6 +3420,36 @@ static int D3D12_RenderPresent(SDL_Renderer *renderer)
     }
 }
 
+#if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+static int D3D12_WaitFrame(SDL_Renderer *renderer, Sint32 timeoutMS)
+{
+    D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
+    DWORD result;
+
+    if (!data->frameLatencyWaitableObject || data->frameWaited) {
+        return 0;
+    }
+
+    result = WaitForSingleObjectEx(data->frameLatencyWaitableObject, (timeoutMS < 0) ? INFINITE : (DWORD)timeoutMS, TRUE);
+    if (result == WAIT_TIMEOUT) {
+        return SDL_MUTEX_TIMEDOUT;
+    } else if (result == WAIT_FAILED) {
+        return WIN_SetError("WaitForSingleObjectEx()");
+    }
+    data->frameWaited = SDL_TRUE;
+    return 0;
+}
+#endif
+
+static UINT D3D12_GetTearingPresentFlags(D3D12_RenderData *data)
+{
+#if defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES)
+    return DXGI_PRESENT_ALLOW_TEARING;
+#else
+    return data->supportsTearing ? DXGI_PRESENT_ALLOW_TEARING : 0;
+#endif
+}
+
 static int D3D12_SetVSync(SDL_Renderer *renderer, const int vsync)
 {
     D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
@@ -3186,7 +3463,55 @@ static int D3D12_SetVSync(SDL_Renderer *renderer, const int vsync)
         data->presentFlags = 0;
     } else {
         data->syncInterval = 0;
-        data->presentFlags = DXGI_PRESENT_ALLOW_TEARING;
+        data->presentFlags = D3D12_GetTearingPresentFlags(data);
+    }
+    return 0;
+}
+
+static SDL_bool D3D12_SupportsPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
+
+    switch (mode) {
+    case SDL_PRESENTMODE_FIFO:
+        return SDL_TRUE;
+#if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+    case SDL_PRESENTMODE_MAILBOX:
+        /* Flip model swap chains replace the queued frame without tearing */
+        return SDL_TRUE;
+    case SDL_PRESENTMODE_IMMEDIATE:
+    case SDL_PRESENTMODE_VRR:
+        /* Variable refresh rate displays are driven by presenting with tearing allowed */
+        return data->supportsTearing;
+#else
+    case SDL_PRESENTMODE_IMMEDIATE:
+        return SDL_TRUE;
+#endif
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static int D3D12_SetPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    D3D12_RenderData *data = (D3D12_RenderData *)renderer->internal;
+
+    switch (mode) {
+    case SDL_PRESENTMODE_FIFO:
+        data->syncInterval = 1;
+        data->presentFlags = 0;
+        break;
+    case SDL_PRESENTMODE_MAILBOX:
+        data->syncInterval = 0;
+        data->presentFlags = 0;
+        break;
+    case SDL_PRESENTMODE_IMMEDIATE:
+    case SDL_PRESENTMODE_VRR:
+        data->syncInterval = 0;
+        data->presentFlags = D3D12_GetTearingPresentFlags(data);
+        break;
+    default:
+        return SDL_Unsupported();
     }
     return 0;
 }
@@ -3219,6 +3544,7 @@ int D3D12_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Propert
     }
 
     data->identity = MatrixIdentity();
+    data->maxFrameLatency = (UINT)SDL_clamp(SDL_GetNumberProperty(create_props, SDL_PROP_RENDERER_CREATE_D3D_MAX_FRAME_LATENCY_NUMBER, 1), 1, 16);
 
     renderer->WindowEvent = D3D12_WindowEvent;
     renderer->SupportsBlendMode = D3D12_SupportsBlendMode;
@@ -3241,9 +3567,14 @@ int D3D12_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Propert
     renderer->RunCommandQueue = D3D12_RunCommandQueue;
     renderer->RenderReadPixels = D3D12_RenderReadPixels;
     renderer->RenderPresent = D3D12_RenderPresent;
+#if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+    renderer->WaitFrame = D3D12_WaitFrame;
+#endif
     renderer->DestroyTexture = D3D12_DestroyTexture;
     renderer->DestroyRenderer = D3D12_DestroyRenderer;
     renderer->SetVSync = D3D12_SetVSync;
+    renderer->SupportsPresentMode = D3D12_SupportsPresentMode;
+    renderer->SetPresentMode = D3D12_SetPresentMode;
     renderer->internal = data;
     D3D12_InvalidateCachedState(renderer);
 
@@ -69,6 +69,10 @@
 
 #define ALIGN_CONSTANTS(align, size) ((size + CONSTANT_ALIGN(align) - 1) & (~(CONSTANT_ALIGN(align) - 1)))
 
+/* Vertex data is streamed through one shared buffer per frame in flight */
+#define SDL_METAL_MAX_FRAMES_IN_FLIGHT 3
+#define SDL_METAL_VERTEX_BUFFER_MIN_SIZE (256 * 1024)
+
 static const size_t CONSTANTS_OFFSET_INVALID = 0xFFFFFFFF;
 static const size_t CONSTANTS_OFFSET_IDENTITY = 0;
 static const size_t CONSTANTS_OFFSET_HALF_PIXEL_TRANSFORM = ALIGN_CONSTANTS(16, CONSTANTS_OFFSET_IDENTITY + sizeof(float) * 16);
@@ -143,12 +147,18 @@ typedef struct METAL_ShaderPipelines
 @property(nonatomic, retain) NSMutableArray<id<MTLSamplerState>> *mtlsamplers;
 @property(nonatomic, retain) id<MTLBuffer> mtlbufconstants;
 @property(nonatomic, retain) id<MTLBuffer> mtlbufquadindices;
+@property(nonatomic, retain) NSMutableArray<id<MTLBuffer>> *mtlbufvertices;
+@property(nonatomic, retain) dispatch_semaphore_t mtlframesemaphore;
+@property(nonatomic, assign) int frameindex;
+@property(nonatomic, assign) size_t vertexoffset;
+@property(nonatomic, assign) BOOL framestarted;
 @property(nonatomic, assign) SDL_MetalView mtlview;
 @property(nonatomic, retain) CAMetalLayer *mtllayer;
 @property(nonatomic, retain) MTLRenderPassDescriptor *mtlpassdesc;
 @property(nonatomic, assign) METAL_ShaderPipelines *activepipelines;
 @property(nonatomic, assign) METAL_ShaderPipelines *allpipelines;
 @property(nonatomic, assign) int pipelinescount;
+@property(nonatomic, assign) BOOL discardtarget;
 @end
 
 @implementation SDL3METAL_RenderData
@@ -458,6 +468,12 @@ static SDL_bool METAL_ActivateRenderCommandEncoder(SDL_Renderer *renderer, MTLLo
         if (renderer->target != NULL) {
             SDL3METAL_TextureData *texdata = (__bridge SDL3METAL_TextureData *)renderer->target->internal;
             mtltexture = texdata.mtltexture;
+
+            /* Transient render targets don't keep their contents when they're set as the target again */
+            if (data.discardtarget && load == MTLLoadActionLoad) {
+                load = MTLLoadActionDontCare;
+            }
+            data.discardtarget = NO;
         } else {
             if (data.mtlbackbuffer == nil) {
                 /* The backbuffer's contents aren't guaranteed to persist after
@@ -1114,6 +1130,8 @@ static int METAL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
             data.mtlcmdbuffer = nil;
         }
 
+        data.discardtarget = (texture && texture->transient);
+
         /* We don't begin a new render pass right away - we delay it until an actual
          * draw or clear happens. That way we can use hardware clears when possible,
          * which are only available when beginning a new render pass. */
@@ -1322,6 +1340,7 @@ typedef struct
 {
     __unsafe_unretained id<MTLRenderPipelineState> pipeline;
     __unsafe_unretained id<MTLBuffer> vertex_buffer;
+    size_t vertex_offset;
     size_t constants_offset;
     SDL_Texture *texture;
     SDL_bool cliprect_dirty;
@@ -1411,7 +1430,7 @@ static SDL_bool SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *cm
         viewport.znear = 0.0;
         viewport.zfar = 1.0;
         [data.mtlcmdencoder setViewport:viewport];
-        [data.mtlcmdencoder setVertexBuffer:mtlbufvertex offset:statecache->projection_offset atIndex:2]; // projection
+        [data.mtlcmdencoder setVertexBuffer:mtlbufvertex offset:statecache->vertex_offset + statecache->projection_offset atIndex:2]; // projection
         statecache->viewport_dirty = SDL_FALSE;
     }
 
@@ -1461,10 +1480,8 @@ static SDL_bool SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *cm
 
     if (statecache->shader_constants_dirty ||
         SDL_memcmp(shader_constants, &statecache->shader_constants, sizeof(*shader_constants)) != 0) {
-        id<MTLBuffer> mtlbufconstants = [data.mtldevice newBufferWithLength:sizeof(*shader_constants) options:MTLResourceStorageModeShared];
-        mtlbufconstants.label = @"SDL shader constants data";
-        SDL_memcpy([mtlbufconstants contents], shader_constants, sizeof(*shader_constants));
-        [data.mtlcmdencoder setFragmentBuffer:mtlbufconstants offset:0 atIndex:0];
+        /* These are small enough to be copied into the command stream directly */
+        [data.mtlcmdencoder setFragmentBytes:shader_constants length:sizeof(*shader_constants) atIndex:0];
 
         SDL_memcpy(&statecache->shader_constants, shader_constants, sizeof(*shader_constants));
         statecache->shader_constants_dirty = SDL_FALSE;
@@ -1477,7 +1494,7 @@ static SDL_bool SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *cm
         statecache->constants_offset = constants_offset;
     }
 
-    [data.mtlcmdencoder setVertexBufferOffset:first atIndex:0]; /* position/texcoords */
+    [data.mtlcmdencoder setVertexBufferOffset:statecache->vertex_offset + first atIndex:0]; /* position/texcoords */
     return SDL_TRUE;
 }
 
@@ -1540,6 +1557,68 @@ static void METAL_InvalidateCachedState(SDL_Renderer *renderer)
     // METAL_DrawStateCache only exists during a run of METAL_RunCommandQueue, so there's nothing to invalidate!
 }
 
+/* Copy vertex data into this frame's vertex buffer, waiting for the GPU if
+ * all of the frames in flight are still using their buffers. */
+static id<MTLBuffer> METAL_AllocateVertices(SDL3METAL_RenderData *data, const void *vertices, size_t vertsize, size_t *offset)
+{
+    id<MTLBuffer> mtlbufvertex;
+    size_t start;
+
+    if (!data.framestarted) {
+        dispatch_semaphore_wait(data.mtlframesemaphore, DISPATCH_TIME_FOREVER);
+        data.framestarted = YES;
+        data.vertexoffset = 0;
+    }
+
+    /* Keep the offset aligned for the projection matrix, which is read as constant data */
+    start = ALIGN_CONSTANTS(16, data.vertexoffset);
+    mtlbufvertex = data.mtlbufvertices[data.frameindex];
+    if (start + vertsize > mtlbufvertex.length) {
+        /* Command buffers retain the buffers they use, so it's safe to replace this one */
+        NSUInteger length = SDL_max(mtlbufvertex.length * 2, SDL_METAL_VERTEX_BUFFER_MIN_SIZE);
+        while (length < vertsize) {
+            length *= 2;
+        }
+        mtlbufvertex = [data.mtldevice newBufferWithLength:length options:MTLResourceStorageModeShared];
+        if (mtlbufvertex == nil) {
+            return nil;
+        }
+        mtlbufvertex.label = @"SDL vertex data";
+        data.mtlbufvertices[data.frameindex] = mtlbufvertex;
+        start = 0;
+    }
+
+    SDL_memcpy((Uint8 *)[mtlbufvertex contents] + start, vertices, vertsize);
+    data.vertexoffset = start + vertsize;
+    *offset = start;
+    return mtlbufvertex;
+}
+
+/* Let the next frame in flight start, once the GPU is done with this one. */
+static void METAL_FinishFrame(SDL3METAL_RenderData *data, id<MTLCommandBuffer> cmdbuffer)
+{
+    if (data.framestarted) {
+        dispatch_semaphore_t semaphore = data.mtlframesemaphore;
+
+        /* Command buffers on a queue complete in order, so this runs after
+         * everything else that used this frame's vertex buffer. */
+        if (cmdbuffer == nil) {
+            cmdbuffer = [data.mtlcmdqueue commandBuffer];
+            [cmdbuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+              dispatch_semaphore_signal(semaphore);
+            }];
+            [cmdbuffer commit];
+        } else {
+            [cmdbuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+              dispatch_semaphore_signal(semaphore);
+            }];
+        }
+
+        data.framestarted = NO;
+        data.frameindex = (data.frameindex + 1) % SDL_METAL_MAX_FRAMES_IN_FLIGHT;
+    }
+}
+
 static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
     @autoreleasepool {
@@ -1557,7 +1636,6 @@ static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         statecache.viewport_dirty = SDL_TRUE;
         statecache.projection_offset = 0;
 
-        // !!! FIXME: have a ring of pre-made MTLBuffers we cycle through? How expensive is creation?
         if (vertsize > 0) {
             /* We can memcpy to a shared buffer from the CPU and read it from the GPU
              * without any extra copying. It's a bit slower on macOS to read shared
@@ -1565,9 +1643,10 @@ static int METAL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
              * cost of copying the data and the code's simpler. Apple's best
              * practices guide recommends this approach for streamed vertex data.
              */
-            mtlbufvertex = [data.mtldevice newBufferWithLength:vertsize options:MTLResourceStorageModeShared];
-            mtlbufvertex.label = @"SDL vertex data";
-            SDL_memcpy([mtlbufvertex contents], vertices, vertsize);
+            mtlbufvertex = METAL_AllocateVertices(data, vertices, vertsize, &statecache.vertex_offset);
+            if (mtlbufvertex == nil) {
+                return SDL_SetError("Failed to allocate vertex buffer");
+            }
 
             statecache.vertex_buffer = mtlbufvertex;
         }
@@ -1781,6 +1860,7 @@ static int METAL_RenderPresent(SDL_Renderer *renderer)
             [data.mtlcmdbuffer presentDrawable:data.mtlbackbuffer];
         }
 
+        METAL_FinishFrame(data, data.mtlcmdbuffer);
         [data.mtlcmdbuffer commit];
 
         data.mtlcmdencoder = nil;
@@ -1811,6 +1891,16 @@ static void METAL_DestroyRenderer(SDL_Renderer *renderer)
             if (data.mtlcmdencoder != nil) {
                 [data.mtlcmdencoder endEncoding];
             }
+            METAL_FinishFrame(data, data.mtlcmdbuffer);
+            [data.mtlcmdbuffer commit];
+
+            /* Wait for the frames in flight, the semaphore can't be released while it's in use */
+            for (int i = 0; i < SDL_METAL_MAX_FRAMES_IN_FLIGHT; ++i) {
+                dispatch_semaphore_wait(data.mtlframesemaphore, DISPATCH_TIME_FOREVER);
+            }
+            for (int i = 0; i < SDL_METAL_MAX_FRAMES_IN_FLIGHT; ++i) {
+                dispatch_semaphore_signal(data.mtlframesemaphore);
+            }
 
             DestroyAllPipelines(data.allpipelines, data.pipelinescount);
 
@@ -2137,6 +2227,16 @@ static int METAL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
         data.mtlbufquadindices = mtlbufquadindices;
         data.mtlbufquadindices.label = @"SDL quad index buffer";
 
+        data.mtlbufvertices = [[NSMutableArray<id<MTLBuffer>> alloc] init];
+        for (int i = 0; i < SDL_METAL_MAX_FRAMES_IN_FLIGHT; ++i) {
+            id<MTLBuffer> mtlbufvertex = [data.mtldevice newBufferWithLength:SDL_METAL_VERTEX_BUFFER_MIN_SIZE options:MTLResourceStorageModeShared];
+            mtlbufvertex.label = @"SDL vertex data";
+            [data.mtlbufvertices addObject:mtlbufvertex];
+        }
+        data.mtlframesemaphore = dispatch_semaphore_create(SDL_METAL_MAX_FRAMES_IN_FLIGHT);
+        data.frameindex = 0;
+        data.framestarted = NO;
+
         cmdbuffer = [data.mtlcmdqueue commandBuffer];
         blitcmd = [cmdbuffer blitCommandEncoder];
 
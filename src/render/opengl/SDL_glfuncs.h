@@ -114,7 +114,7 @@ SDL_PROC(void, glDisable, (GLenum cap))
 SDL_PROC(void, glDisableClientState, (GLenum array))
 SDL_PROC(void, glDrawArrays, (GLenum mode, GLint first, GLsizei count))
 SDL_PROC_UNUSED(void, glDrawBuffer, (GLenum mode))
-SDL_PROC_UNUSED(void, glDrawElements,
+SDL_PROC(void, glDrawElements,
                 (GLenum mode, GLsizei count, GLenum type,
                  const GLvoid *indices))
 SDL_PROC(void, glDrawPixels,
@@ -427,8 +427,7 @@ SDL_PROC(void, glTexImage2D,
          (GLenum target, GLint level, GLint internalformat, GLsizei width,
           GLsizei height, GLint border, GLenum format, GLenum type,
           const GLvoid *pixels))
-SDL_PROC_UNUSED(void, glTexParameterf,
-                (GLenum target, GLenum pname, GLfloat param))
+SDL_PROC(void, glTexParameterf, (GLenum target, GLenum pname, GLfloat param))
 SDL_PROC_UNUSED(void, glTexParameterfv,
                 (GLenum target, GLenum pname, const GLfloat *params))
 SDL_PROC(void, glTexParameteri, (GLenum target, GLenum pname, GLint param))
@@ -24,6 +24,7 @@
 #include "../../video/SDL_sysvideo.h" /* For SDL_RecreateWindow */
 #include <SDL3/SDL_opengl.h>
 #include "../SDL_sysrender.h"
+#include "../SDL_dmabuf_c.h"
 #include "SDL_shaders_gl.h"
 #include "../../video/SDL_pixels_c.h"
 
@@ -58,6 +59,14 @@ struct GL_FBOList
     GL_FBOList *next;
 };
 
+/* The number of frames that can be in flight while waiting for GPU timing results */
+#define GL_NUM_TIMER_QUERIES 4
+
+/* The persistently mapped vertex buffer is split into segments, each one
+   guarded by a fence so we never overwrite vertices the GPU is still using. */
+#define GL_NUM_VERTEX_SEGMENTS 4
+#define GL_VERTEX_SEGMENT_SIZE (1024 * 1024)
+
 typedef struct
 {
     SDL_bool viewport_dirty;
@@ -69,6 +78,7 @@ typedef struct
     SDL_BlendMode blend;
     GL_Shader shader;
     const float *shader_params;
+    SDL_RenderShader *custom_shader;
     SDL_bool cliprect_enabled_dirty;
     SDL_bool cliprect_enabled;
     SDL_bool cliprect_dirty;
@@ -118,6 +128,47 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    /* Mipmap support */
+    PFNGLGENERATEMIPMAPEXTPROC glGenerateMipmapEXT;
+    GLfloat max_anisotropy;
+
+    /* Compressed texture support */
+    PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D;
+    PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC glCompressedTexSubImage2D;
+
+    /* GPU frame timing support */
+    SDL_bool GL_ARB_timer_query_supported;
+    PFNGLGENQUERIESPROC glGenQueries;
+    PFNGLDELETEQUERIESPROC glDeleteQueries;
+    PFNGLBEGINQUERYPROC glBeginQuery;
+    PFNGLENDQUERYPROC glEndQuery;
+    PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+    PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+    GLuint timer_queries[GL_NUM_TIMER_QUERIES];
+    SDL_bool timer_query_pending[GL_NUM_TIMER_QUERIES];
+    int timer_query_index;
+    SDL_bool timer_query_active;
+
+    /* Persistently mapped vertex buffer support */
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERSTORAGEPROC glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+    GLuint vertex_buffer;
+    Uint8 *vertex_buffer_data;
+    size_t vertex_buffer_offset;
+    size_t vertex_segment;
+    GLsync vertex_fences[GL_NUM_VERTEX_SEGMENTS];
+
+    /* Indices of consecutive indexed draws, rebased so they can be drawn together */
+    Uint16 *index_scratch;
+    size_t index_scratch_count;
+
     /* Shader support */
     GL_ShaderContext *shaders;
 
@@ -128,6 +179,7 @@ typedef struct
 {
     GLuint texture;
     SDL_bool texture_external;
+    SDL_bool dmabuf;
     GLfloat texw;
     GLfloat texh;
     GLenum format;
@@ -137,6 +189,7 @@ typedef struct
     void *pixels;
     int pitch;
     SDL_Rect locked_rect;
+    SDL_bool mipmaps_dirty;
 
 #if SDL_HAVE_YUV
     /* YUV texture support */
@@ -433,12 +486,65 @@ static SDL_bool convert_format(Uint32 pixel_format, GLint *internalFormat, GLenu
         *type = GL_UNSIGNED_SHORT_8_8_APPLE;
         break;
 #endif
+    /* Compressed formats are uploaded with their internal format */
+    case SDL_PIXELFORMAT_BC1:
+        *internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        break;
+    case SDL_PIXELFORMAT_BC2:
+        *internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        break;
+    case SDL_PIXELFORMAT_BC3:
+        *internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        break;
+    case SDL_PIXELFORMAT_BC4:
+        *internalFormat = GL_COMPRESSED_RED_RGTC1;
+        break;
+    case SDL_PIXELFORMAT_BC5:
+        *internalFormat = GL_COMPRESSED_RG_RGTC2;
+        break;
+    case SDL_PIXELFORMAT_BC7:
+        *internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+        break;
+    case SDL_PIXELFORMAT_ETC2_RGB8:
+        *internalFormat = GL_COMPRESSED_RGB8_ETC2;
+        break;
+    case SDL_PIXELFORMAT_ETC2_RGBA8:
+        *internalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        break;
+    case SDL_PIXELFORMAT_ASTC_4X4:
+        *internalFormat = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        break;
     default:
         return SDL_FALSE;
     }
+    if (SDL_ISPIXELFORMAT_COMPRESSED(pixel_format)) {
+        *format = (GLenum)*internalFormat;
+        *type = GL_NONE;
+    }
     return SDL_TRUE;
 }
 
+static void GL_SetTextureFilter(GL_RenderData *renderdata, SDL_Texture *texture, SDL_ScaleMode scaleMode)
+{
+    const GLenum textype = renderdata->textype;
+    GLenum min_filter, mag_filter;
+
+    if (scaleMode == SDL_SCALEMODE_NEAREST) {
+        min_filter = GL_NEAREST;
+        mag_filter = GL_NEAREST;
+    } else {
+        min_filter = texture->mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+        mag_filter = GL_LINEAR;
+    }
+    renderdata->glTexParameteri(textype, GL_TEXTURE_MIN_FILTER, min_filter);
+    renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER, mag_filter);
+
+    if (texture->mipmaps && renderdata->max_anisotropy > 1.0f) {
+        const GLfloat anisotropy = (scaleMode == SDL_SCALEMODE_BEST) ? renderdata->max_anisotropy : 1.0f;
+        renderdata->glTexParameterf(textype, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+    }
+}
+
 static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     GL_RenderData *renderdata = (GL_RenderData *)renderer->internal;
@@ -448,6 +554,8 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
     GLenum format, type;
     int texture_w, texture_h;
     GLenum scaleMode;
+    SDL_bool dmabuf = SDL_HasDMABUFTextureProperties(create_props);
+    Uint32 drm_format = 0;
 
     GL_ActivateRenderer(renderer);
 
@@ -464,6 +572,39 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
                             SDL_GetPixelFormatName(texture->format));
     }
 
+    if (dmabuf) {
+        switch (texture->format) {
+        case SDL_PIXELFORMAT_ARGB8888:
+            drm_format = SDL_DRM_FORMAT_ARGB8888;
+            break;
+        case SDL_PIXELFORMAT_ABGR8888:
+            drm_format = SDL_DRM_FORMAT_ABGR8888;
+            break;
+        case SDL_PIXELFORMAT_XRGB8888:
+            drm_format = SDL_DRM_FORMAT_XRGB8888;
+            break;
+        case SDL_PIXELFORMAT_XBGR8888:
+            drm_format = SDL_DRM_FORMAT_XBGR8888;
+            break;
+        case SDL_PIXELFORMAT_IYUV:
+        case SDL_PIXELFORMAT_YV12:
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+            drm_format = SDL_DRM_FORMAT_R8;
+            break;
+        default:
+            return SDL_SetError("DMA-BUF textures can't have format %s", SDL_GetPixelFormatName(texture->format));
+        }
+        if (texture->access != SDL_TEXTUREACCESS_STATIC) {
+            return SDL_SetError("DMA-BUF textures must have SDL_TEXTUREACCESS_STATIC access");
+        }
+        /* EGL images can only back GL_TEXTURE_2D, without padding */
+        if (textype != GL_TEXTURE_2D || !renderdata->GL_ARB_texture_non_power_of_two_supported) {
+            return SDL_SetError("DMA-BUF textures need non power of two GL_TEXTURE_2D support");
+        }
+        texture->mipmaps = SDL_FALSE;
+    }
+
     data = (GL_TextureData *)SDL_calloc(1, sizeof(*data));
     if (!data) {
         return -1;
@@ -534,13 +675,19 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
     SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_OPENGL_TEX_W_FLOAT, data->texw);
     SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_OPENGL_TEX_H_FLOAT, data->texh);
 
+    /* Mipmaps need a full texture chain, so they aren't available for rectangle textures or multi-plane formats */
+    if (texture->mipmaps &&
+        (!renderdata->glGenerateMipmapEXT || textype != GL_TEXTURE_2D ||
+         SDL_ISPIXELFORMAT_FOURCC(texture->format))) {
+        texture->mipmaps = SDL_FALSE;
+    }
+
     data->format = format;
     data->formattype = type;
     scaleMode = (texture->scaleMode == SDL_SCALEMODE_NEAREST) ? GL_NEAREST : GL_LINEAR;
     renderdata->glEnable(textype);
     renderdata->glBindTexture(textype, data->texture);
-    renderdata->glTexParameteri(textype, GL_TEXTURE_MIN_FILTER, scaleMode);
-    renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER, scaleMode);
+    GL_SetTextureFilter(renderdata, texture, texture->scaleMode);
 #ifdef SDL_PLATFORM_MACOS
 #ifndef GL_TEXTURE_STORAGE_HINT_APPLE
 #define GL_TEXTURE_STORAGE_HINT_APPLE 0x85BC
@@ -568,10 +715,26 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
         renderdata->glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_FALSE);
     } else
 #endif
-    {
+    if (dmabuf) {
+        data->dmabuf = SDL_TRUE;
+        if (SDL_BindDMABUFTexturePlane(create_props, 0, drm_format, texture_w, texture_h, textype) < 0) {
+            renderdata->glDisable(textype);
+            return -1;
+        }
+    } else if (SDL_ISPIXELFORMAT_COMPRESSED(texture->format)) {
+        int block_w, block_h;
+        const int block_size = SDL_GetCompressedFormatBlockSize(texture->format, &block_w, &block_h);
+        const GLsizei size = ((texture_w + block_w - 1) / block_w) * ((texture_h + block_h - 1) / block_h) * block_size;
+
+        renderdata->glCompressedTexImage2D(textype, 0, internalFormat, texture_w,
+                                           texture_h, 0, size, NULL);
+    } else {
         renderdata->glTexImage2D(textype, 0, internalFormat, texture_w,
                                  texture_h, 0, format, type, NULL);
     }
+    if (texture->mipmaps) {
+        renderdata->glGenerateMipmapEXT(textype);
+    }
     renderdata->glDisable(textype);
     if (GL_CheckError("glTexImage2D()", renderer) < 0) {
         return -1;
@@ -600,8 +763,16 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
                                     scaleMode);
         renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER,
                                     scaleMode);
-        renderdata->glTexImage2D(textype, 0, internalFormat, (texture_w + 1) / 2,
-                                 (texture_h + 1) / 2, 0, format, type, NULL);
+        if (dmabuf) {
+            /* YV12 stores V before U */
+            if (SDL_BindDMABUFTexturePlane(create_props, (texture->format == SDL_PIXELFORMAT_YV12) ? 2 : 1, SDL_DRM_FORMAT_R8,
+                                           (texture_w + 1) / 2, (texture_h + 1) / 2, textype) < 0) {
+                return -1;
+            }
+        } else {
+            renderdata->glTexImage2D(textype, 0, internalFormat, (texture_w + 1) / 2,
+                                     (texture_h + 1) / 2, 0, format, type, NULL);
+        }
         SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_U_NUMBER, data->utexture);
 
         renderdata->glBindTexture(textype, data->vtexture);
@@ -609,8 +780,15 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
                                     scaleMode);
         renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER,
                                     scaleMode);
-        renderdata->glTexImage2D(textype, 0, internalFormat, (texture_w + 1) / 2,
-                                 (texture_h + 1) / 2, 0, format, type, NULL);
+        if (dmabuf) {
+            if (SDL_BindDMABUFTexturePlane(create_props, (texture->format == SDL_PIXELFORMAT_YV12) ? 1 : 2, SDL_DRM_FORMAT_R8,
+                                           (texture_w + 1) / 2, (texture_h + 1) / 2, textype) < 0) {
+                return -1;
+            }
+        } else {
+            renderdata->glTexImage2D(textype, 0, internalFormat, (texture_w + 1) / 2,
+                                     (texture_h + 1) / 2, 0, format, type, NULL);
+        }
         SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_V_NUMBER, data->vtexture);
     }
 
@@ -629,13 +807,22 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
                                     scaleMode);
         renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER,
                                     scaleMode);
-        renderdata->glTexImage2D(textype, 0, GL_LUMINANCE_ALPHA, (texture_w + 1) / 2,
-                                 (texture_h + 1) / 2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
+        if (dmabuf) {
+            if (SDL_BindDMABUFTexturePlane(create_props, 1, SDL_DRM_FORMAT_GR88,
+                                           (texture_w + 1) / 2, (texture_h + 1) / 2, textype) < 0) {
+                return -1;
+            }
+        } else {
+            renderdata->glTexImage2D(textype, 0, GL_LUMINANCE_ALPHA, (texture_w + 1) / 2,
+                                     (texture_h + 1) / 2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
+        }
         SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_UV_NUMBER, data->utexture);
     }
 #endif
 
-    if (texture->format == SDL_PIXELFORMAT_ABGR8888 || texture->format == SDL_PIXELFORMAT_ARGB8888) {
+    if (texture->format == SDL_PIXELFORMAT_ABGR8888 || texture->format == SDL_PIXELFORMAT_ARGB8888 ||
+        (SDL_ISPIXELFORMAT_COMPRESSED(texture->format) && texture->blendMode == SDL_BLENDMODE_BLEND)) {
+        /* Compressed formats with alpha default to blending */
         data->shader = SHADER_RGBA;
     } else {
         data->shader = SHADER_RGB;
@@ -646,13 +833,14 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
         if (data->yuv) {
             data->shader = SHADER_YUV;
         } else if (texture->format == SDL_PIXELFORMAT_NV12) {
-            if (SDL_GetHintBoolean("SDL_RENDER_OPENGL_NV12_RG_SHADER", SDL_FALSE)) {
+            /* The imported chroma plane has U and V in red and green */
+            if (data->dmabuf || SDL_GetHintBoolean("SDL_RENDER_OPENGL_NV12_RG_SHADER", SDL_FALSE)) {
                 data->shader = SHADER_NV12_RG;
             } else {
                 data->shader = SHADER_NV12_RA;
             }
         } else {
-            if (SDL_GetHintBoolean("SDL_RENDER_OPENGL_NV12_RG_SHADER", SDL_FALSE)) {
+            if (data->dmabuf || SDL_GetHintBoolean("SDL_RENDER_OPENGL_NV12_RG_SHADER", SDL_FALSE)) {
                 data->shader = SHADER_NV21_RG;
             } else {
                 data->shader = SHADER_NV21_RA;
@@ -668,6 +856,45 @@ static int GL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
     return GL_CheckError("", renderer);
 }
 
+static int GL_UpdateCompressedTexture(SDL_Renderer *renderer, SDL_Texture *texture,
+                                      const SDL_Rect *rect, const void *pixels, int pitch)
+{
+    GL_RenderData *renderdata = (GL_RenderData *)renderer->internal;
+    const GLenum textype = renderdata->textype;
+    GL_TextureData *data = (GL_TextureData *)texture->internal;
+    int block_w, block_h;
+    const int block_size = SDL_GetCompressedFormatBlockSize(texture->format, &block_w, &block_h);
+    const int row_size = ((rect->w + block_w - 1) / block_w) * block_size;
+    const int rows = (rect->h + block_h - 1) / block_h;
+    void *packed = NULL;
+
+    /* Compressed uploads have to be tightly packed */
+    if (pitch != row_size) {
+        const Uint8 *src = (const Uint8 *)pixels;
+        Uint8 *dst;
+        int i;
+
+        packed = SDL_malloc((size_t)rows * row_size);
+        if (!packed) {
+            return -1;
+        }
+        dst = (Uint8 *)packed;
+        for (i = 0; i < rows; ++i) {
+            SDL_memcpy(dst, src, row_size);
+            src += pitch;
+            dst += row_size;
+        }
+        pixels = packed;
+    }
+
+    renderdata->glBindTexture(textype, data->texture);
+    renderdata->glCompressedTexSubImage2D(textype, 0, rect->x, rect->y, rect->w, rect->h,
+                                          data->format, rows * row_size, pixels);
+    SDL_free(packed);
+
+    return GL_CheckError("glCompressedTexSubImage2D()", renderer);
+}
+
 static int GL_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                             const SDL_Rect *rect, const void *pixels, int pitch)
 {
@@ -678,16 +905,27 @@ static int GL_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 
     SDL_assert_release(texturebpp != 0); /* otherwise, division by zero later. */
 
+    if (data->dmabuf) {
+        return SDL_SetError("DMA-BUF textures can't be updated");
+    }
+
     GL_ActivateRenderer(renderer);
 
     renderdata->drawstate.texture = NULL; /* we trash this state. */
 
+    if (SDL_ISPIXELFORMAT_COMPRESSED(texture->format)) {
+        return GL_UpdateCompressedTexture(renderer, texture, rect, pixels, pitch);
+    }
+
     renderdata->glBindTexture(textype, data->texture);
     renderdata->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, (pitch / texturebpp));
     renderdata->glTexSubImage2D(textype, 0, rect->x, rect->y, rect->w,
                                 rect->h, data->format, data->formattype,
                                 pixels);
+    if (texture->mipmaps) {
+        data->mipmaps_dirty = SDL_TRUE;
+    }
 #if SDL_HAVE_YUV
     if (data->yuv) {
         renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, ((pitch + 1) / 2));
@@ -740,6 +978,10 @@ static int GL_UpdateTextureYUV(SDL_Renderer *renderer, SDL_Texture *texture,
     const GLenum textype = renderdata->textype;
     GL_TextureData *data = (GL_TextureData *)texture->internal;
 
+    if (data->dmabuf) {
+        return SDL_SetError("DMA-BUF textures can't be updated");
+    }
+
     GL_ActivateRenderer(renderer);
 
     renderdata->drawstate.texture = NULL; /* we trash this state. */
@@ -775,6 +1017,10 @@ static int GL_UpdateTextureNV(SDL_Renderer *renderer, SDL_Texture *texture,
     const GLenum textype = renderdata->textype;
     GL_TextureData *data = (GL_TextureData *)texture->internal;
 
+    if (data->dmabuf) {
+        return SDL_SetError("DMA-BUF textures can't be updated");
+    }
+
     GL_ActivateRenderer(renderer);
 
     renderdata->drawstate.texture = NULL; /* we trash this state. */
@@ -830,8 +1076,7 @@ static void GL_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture,
     GLenum glScaleMode = (scaleMode == SDL_SCALEMODE_NEAREST) ? GL_NEAREST : GL_LINEAR;
 
     renderdata->glBindTexture(textype, data->texture);
-    renderdata->glTexParameteri(textype, GL_TEXTURE_MIN_FILTER, glScaleMode);
-    renderdata->glTexParameteri(textype, GL_TEXTURE_MAG_FILTER, glScaleMode);
+    GL_SetTextureFilter(renderdata, texture, scaleMode);
 
 #if SDL_HAVE_YUV
     if (texture->format == SDL_PIXELFORMAT_YV12 ||
@@ -874,6 +1119,10 @@ static int GL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
     }
 
     texturedata = (GL_TextureData *)texture->internal;
+    if (texture->mipmaps) {
+        /* We don't know what will be drawn, so regenerate the mipmaps the next time it's used */
+        texturedata->mipmaps_dirty = SDL_TRUE;
+    }
     data->glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, texturedata->fbo->FBO);
     /* TODO: check if texture pixel format allows this operation */
     data->glFramebufferTexture2DEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, data->textype, texturedata->texture, 0);
@@ -963,6 +1212,28 @@ static int GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     size_t sz = 2 * sizeof(GLfloat) + 4 * sizeof(GLfloat) + (texture ? 2 : 0) * sizeof(GLfloat);
     const float color_scale = cmd->data.draw.color_scale;
 
+    size_indices = indices ? size_indices : 0;
+
+    /* Keep indexed geometry indexed when 16-bit indices can address it, instead of expanding every vertex */
+    if (size_indices && num_vertices <= 65536) {
+        Uint16 *idx = (Uint16 *)SDL_AllocateRenderIndices(renderer, num_indices * sizeof(Uint16), &cmd->data.draw.first_index);
+        if (!idx) {
+            return -1;
+        }
+        for (i = 0; i < num_indices; i++) {
+            if (size_indices == 4) {
+                idx[i] = (Uint16)((const Uint32 *)indices)[i];
+            } else if (size_indices == 2) {
+                idx[i] = ((const Uint16 *)indices)[i];
+            } else {
+                idx[i] = ((const Uint8 *)indices)[i];
+            }
+        }
+        cmd->data.draw.num_indices = num_indices;
+        count = num_vertices;
+        size_indices = 0;
+    }
+
     verts = (GLfloat *)SDL_AllocateRenderVertices(renderer, count * sz, 0, &cmd->data.draw.first);
     if (!verts) {
         return -1;
@@ -973,7 +1244,6 @@ static int GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     }
 
     cmd->data.draw.count = count;
-    size_indices = indices ? size_indices : 0;
 
     for (i = 0; i < count; i++) {
         int j;
@@ -1066,9 +1336,16 @@ static int SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const
         data->drawstate.blend = blend;
     }
 
-    if (data->shaders &&
-        (shader != data->drawstate.shader || shader_params != data->drawstate.shader_params)) {
+    if (cmd->data.draw.shader) {
+        if (cmd->data.draw.shader != data->drawstate.custom_shader) {
+            GL_SelectCustomShader(data->shaders, (GL_CustomShader *)cmd->data.draw.shader->internal);
+            data->drawstate.custom_shader = cmd->data.draw.shader;
+            data->drawstate.shader = SHADER_INVALID;
+        }
+    } else if (data->shaders &&
+               (data->drawstate.custom_shader || shader != data->drawstate.shader || shader_params != data->drawstate.shader_params)) {
         GL_SelectShader(data->shaders, shader, shader_params);
+        data->drawstate.custom_shader = NULL;
         data->drawstate.shader = shader;
         data->drawstate.shader_params = shader_params;
     }
@@ -1140,11 +1417,11 @@ static int SetTextureAddressMode(GL_RenderData *data, GLenum textype, SDL_Textur
 static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
 {
     SDL_Texture *texture = cmd->data.draw.texture;
-    const GL_TextureData *texturedata = (GL_TextureData *)texture->internal;
+    GL_TextureData *texturedata = (GL_TextureData *)texture->internal;
 
     SetDrawState(data, cmd, texturedata->shader, texturedata->shader_params);
 
-    if (texture != data->drawstate.texture) {
+    if (texture != data->drawstate.texture || texturedata->mipmaps_dirty) {
         const GLenum textype = data->textype;
 #if SDL_HAVE_YUV
         if (texturedata->yuv) {
@@ -1186,6 +1463,11 @@ static int SetCopyState(GL_RenderData *data, const SDL_RenderCommand *cmd)
             return -1;
         }
 
+        if (texturedata->mipmaps_dirty) {
+            data->glGenerateMipmapEXT(textype);
+            texturedata->mipmaps_dirty = SDL_FALSE;
+        }
+
         data->drawstate.texture = texture;
     }
 
@@ -1201,6 +1483,7 @@ static void GL_InvalidateCachedState(SDL_Renderer *renderer)
     cache->drawableh = 0;
     cache->blend = SDL_BLENDMODE_INVALID;
     cache->shader = SHADER_INVALID;
+    cache->custom_shader = NULL;
     cache->cliprect_enabled_dirty = SDL_TRUE;
     cache->cliprect_dirty = SDL_TRUE;
     cache->texturing_dirty = SDL_TRUE;
@@ -1211,15 +1494,96 @@ static void GL_InvalidateCachedState(SDL_Renderer *renderer)
     cache->clear_color_dirty = SDL_TRUE;
 }
 
+/* Copy the vertex data into the persistently mapped vertex buffer, if we have
+   one, and return the base to pass to the gl*Pointer() functions. */
+static const Uint8 *GL_UploadVertices(GL_RenderData *data, void *vertices, size_t vertsize)
+{
+    size_t offset = data->vertex_buffer_offset;
+    const size_t segment = data->vertex_segment;
+
+    if (!data->vertex_buffer || vertsize == 0 || vertsize > GL_VERTEX_SEGMENT_SIZE) {
+        /* Use client side arrays */
+        return (const Uint8 *)vertices;
+    }
+
+    if (offset + vertsize > (segment + 1) * GL_VERTEX_SEGMENT_SIZE) {
+        /* Move on to the next segment, once the GPU is done with it */
+        const size_t next = (segment + 1) % GL_NUM_VERTEX_SEGMENTS;
+
+        data->vertex_fences[segment] = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        if (data->vertex_fences[next]) {
+            while (data->glClientWaitSync(data->vertex_fences[next], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+                /* Keep waiting */
+            }
+            data->glDeleteSync(data->vertex_fences[next]);
+            data->vertex_fences[next] = NULL;
+        }
+        data->vertex_segment = next;
+        offset = next * GL_VERTEX_SEGMENT_SIZE;
+    }
+
+    SDL_memcpy(data->vertex_buffer_data + offset, vertices, vertsize);
+    data->vertex_buffer_offset = (offset + vertsize + 15) & ~15;
+
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_buffer);
+    return (const Uint8 *)(uintptr_t)offset;
+}
+
+/* Return the indices for a run of indexed geometry commands, relative to the first command's vertices */
+static const Uint16 *GL_GetCombinedIndices(SDL_Renderer *renderer, GL_RenderData *data, const SDL_RenderCommand *cmd, const SDL_RenderCommand *finalcmd, size_t num_indices)
+{
+    const Uint8 *indexbase = (const Uint8 *)renderer->index_data;
+    Uint16 *dst;
+    size_t base = 0;
+
+    if (cmd == finalcmd) {
+        return (const Uint16 *)(indexbase + cmd->data.draw.first_index);
+    }
+
+    if (data->index_scratch_count < num_indices) {
+        Uint16 *ptr = (Uint16 *)SDL_realloc(data->index_scratch, num_indices * sizeof(Uint16));
+        if (!ptr) {
+            return NULL;
+        }
+        data->index_scratch = ptr;
+        data->index_scratch_count = num_indices;
+    }
+
+    dst = data->index_scratch;
+    for (;;) {
+        const Uint16 *src = (const Uint16 *)(indexbase + cmd->data.draw.first_index);
+        size_t i;
+
+        for (i = 0; i < cmd->data.draw.num_indices; ++i) {
+            *dst++ = (Uint16)(src[i] + base);
+        }
+        base += cmd->data.draw.count;
+        if (cmd == finalcmd) {
+            break;
+        }
+        cmd = cmd->next;
+    }
+    return data->index_scratch;
+}
+
 static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
-    /* !!! FIXME: it'd be nice to use a vertex buffer instead of immediate mode... */
     GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    const Uint8 *vertexbase;
 
     if (GL_ActivateRenderer(renderer) < 0) {
         return -1;
     }
 
+    vertexbase = GL_UploadVertices(data, vertices, vertsize);
+
+    if (data->GL_ARB_timer_query_supported && !data->timer_query_active &&
+        !data->timer_query_pending[data->timer_query_index]) {
+        /* Time everything from the first flush of the frame until the swap */
+        data->glBeginQuery(GL_TIME_ELAPSED, data->timer_queries[data->timer_query_index]);
+        data->timer_query_active = SDL_TRUE;
+    }
+
     data->drawstate.target = renderer->target;
     if (!data->drawstate.target) {
         int w, h;
@@ -1329,7 +1693,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         {
             if (SetDrawState(data, cmd, SHADER_SOLID, NULL) == 0) {
                 size_t count = cmd->data.draw.count;
-                const GLfloat *verts = (GLfloat *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                const GLfloat *verts = (const GLfloat *)(vertexbase + cmd->data.draw.first);
 
                 /* SetDrawState handles glEnableClientState. */
                 data->glVertexPointer(2, GL_FLOAT, sizeof(float) * 2, verts);
@@ -1372,10 +1736,12 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                same texture, we can combine them all into a single draw call. */
             SDL_Texture *thistexture = cmd->data.draw.texture;
             SDL_BlendMode thisblend = cmd->data.draw.blend;
+            SDL_RenderShader *thisshader = cmd->data.draw.shader;
             const SDL_RenderCommandType thiscmdtype = cmd->command;
             SDL_RenderCommand *finalcmd = cmd;
             SDL_RenderCommand *nextcmd = cmd->next;
             size_t count = cmd->data.draw.count;
+            size_t num_indices = cmd->data.draw.num_indices;
             int ret;
             while (nextcmd) {
                 const SDL_RenderCommandType nextcmdtype = nextcmd->command;
@@ -1383,9 +1749,16 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     break; /* can't go any further on this draw call, different render command up next. */
                 } else if (nextcmd->data.draw.texture != thistexture || nextcmd->data.draw.blend != thisblend) {
                     break; /* can't go any further on this draw call, different texture/blendmode copy up next. */
+                } else if (nextcmd->data.draw.shader != thisshader) {
+                    break; /* can't go any further on this draw call, different custom shader up next. */
+                } else if ((nextcmd->data.draw.num_indices != 0) != (num_indices != 0)) {
+                    break; /* can't mix indexed and unindexed geometry in one draw call. */
+                } else if (num_indices && count + nextcmd->data.draw.count > 65536) {
+                    break; /* the combined vertices wouldn't be addressable with 16-bit indices. */
                 } else {
                     finalcmd = nextcmd; /* we can combine copy operations here. Mark this one as the furthest okay command. */
                     count += nextcmd->data.draw.count;
+                    num_indices += nextcmd->data.draw.num_indices;
                 }
                 nextcmd = nextcmd->next;
             }
@@ -1397,7 +1770,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             }
 
             if (ret == 0) {
-                const GLfloat *verts = (GLfloat *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                const GLfloat *verts = (const GLfloat *)(vertexbase + cmd->data.draw.first);
                 int op = GL_TRIANGLES; /* SDL_RENDERCMD_GEOMETRY */
                 if (thiscmdtype == SDL_RENDERCMD_DRAW_POINTS) {
                     op = GL_POINTS;
@@ -1418,7 +1791,14 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
                 }
 
-                data->glDrawArrays(op, 0, (GLsizei)count);
+                if (num_indices) {
+                    const Uint16 *idx = GL_GetCombinedIndices(renderer, data, cmd, finalcmd, num_indices);
+                    if (idx) {
+                        data->glDrawElements(op, (GLsizei)num_indices, GL_UNSIGNED_SHORT, idx);
+                    }
+                } else {
+                    data->glDrawArrays(op, 0, (GLsizei)count);
+                }
 
                 /* Restore previously set color when we're done. */
                 if (thiscmdtype != SDL_RENDERCMD_DRAW_POINTS) {
@@ -1455,6 +1835,9 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         data->glDisableClientState(GL_TEXTURE_COORD_ARRAY);
         data->drawstate.texture_array = SDL_FALSE;
     }
+    if (vertexbase != vertices) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
 
     return GL_CheckError("", renderer);
 }
@@ -1513,10 +1896,47 @@ static SDL_Surface *GL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
     return surface;
 }
 
+static void GL_UpdateFrameTime(SDL_Renderer *renderer)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    int i;
+
+    if (data->timer_query_active) {
+        data->glEndQuery(GL_TIME_ELAPSED);
+        data->timer_query_pending[data->timer_query_index] = SDL_TRUE;
+        data->timer_query_active = SDL_FALSE;
+        data->timer_query_index = (data->timer_query_index + 1) % GL_NUM_TIMER_QUERIES;
+    }
+
+    /* Collect finished queries, oldest first, without stalling the pipeline */
+    for (i = 0; i < GL_NUM_TIMER_QUERIES; ++i) {
+        const int index = (data->timer_query_index + i) % GL_NUM_TIMER_QUERIES;
+        GLint available = 0;
+        GLuint64 elapsed = 0;
+
+        if (!data->timer_query_pending[index]) {
+            continue;
+        }
+        data->glGetQueryObjectiv(data->timer_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        data->glGetQueryObjectui64v(data->timer_queries[index], GL_QUERY_RESULT, &elapsed);
+        data->timer_query_pending[index] = SDL_FALSE;
+        renderer->gpu_frame_ns = elapsed;
+    }
+}
+
 static int GL_RenderPresent(SDL_Renderer *renderer)
 {
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+
     GL_ActivateRenderer(renderer);
 
+    if (data->GL_ARB_timer_query_supported) {
+        GL_UpdateFrameTime(renderer);
+    }
+
     return SDL_GL_SwapWindow(renderer->window);
 }
 
@@ -1560,6 +1980,46 @@ static void GL_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     texture->internal = NULL;
 }
 
+static int GL_CreateShader(SDL_Renderer *renderer, SDL_RenderShader *shader, SDL_PropertiesID create_props)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    const char *source = SDL_GetStringProperty(create_props, SDL_PROP_RENDER_SHADER_CREATE_GLSL_FRAGMENT_STRING, NULL);
+
+    if (!data->shaders) {
+        return SDL_SetError("Custom shaders need GLSL support");
+    }
+    if (!source) {
+        return SDL_Unsupported();
+    }
+
+    if (GL_ActivateRenderer(renderer) < 0) {
+        return -1;
+    }
+
+    shader->internal = GL_CreateCustomShader(data->shaders, source);
+    if (!shader->internal) {
+        return -1;
+    }
+    /* compiling the shader changed the current program */
+    data->drawstate.shader = SHADER_INVALID;
+    data->drawstate.custom_shader = NULL;
+    return 0;
+}
+
+static void GL_DestroyShader(SDL_Renderer *renderer, SDL_RenderShader *shader)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->internal;
+
+    GL_ActivateRenderer(renderer);
+
+    if (data->drawstate.custom_shader == shader) {
+        data->drawstate.custom_shader = NULL;
+        data->drawstate.shader = SHADER_INVALID;
+    }
+    GL_DestroyCustomShader(data->shaders, (GL_CustomShader *)shader->internal);
+    shader->internal = NULL;
+}
+
 static void GL_DestroyRenderer(SDL_Renderer *renderer)
 {
     GL_RenderData *data = (GL_RenderData *)renderer->internal;
@@ -1590,8 +2050,27 @@ static void GL_DestroyRenderer(SDL_Renderer *renderer)
                 SDL_free(data->framebuffers);
                 data->framebuffers = nextnode;
             }
+            if (data->GL_ARB_timer_query_supported) {
+                if (data->timer_query_active) {
+                    data->glEndQuery(GL_TIME_ELAPSED);
+                }
+                data->glDeleteQueries(GL_NUM_TIMER_QUERIES, data->timer_queries);
+            }
+            if (data->vertex_buffer) {
+                int i;
+                for (i = 0; i < GL_NUM_VERTEX_SEGMENTS; ++i) {
+                    if (data->vertex_fences[i]) {
+                        data->glDeleteSync(data->vertex_fences[i]);
+                    }
+                }
+                data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_buffer);
+                data->glUnmapBuffer(GL_ARRAY_BUFFER);
+                data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+                data->glDeleteBuffers(1, &data->vertex_buffer);
+            }
             SDL_GL_DestroyContext(data->context);
         }
+        SDL_free(data->index_scratch);
         SDL_free(data);
     }
 }
@@ -1671,11 +2150,14 @@ static int GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pro
     renderer->UnlockTexture = GL_UnlockTexture;
     renderer->SetTextureScaleMode = GL_SetTextureScaleMode;
     renderer->SetRenderTarget = GL_SetRenderTarget;
+    renderer->persistent_lock_memory = SDL_TRUE;
     renderer->QueueSetViewport = GL_QueueNoOp;
     renderer->QueueSetDrawColor = GL_QueueNoOp;
     renderer->QueueDrawPoints = GL_QueueDrawPoints;
     renderer->QueueDrawLines = GL_QueueDrawLines;
     renderer->QueueGeometry = GL_QueueGeometry;
+    renderer->CreateShader = GL_CreateShader;
+    renderer->DestroyShader = GL_DestroyShader;
     renderer->InvalidateCachedState = GL_InvalidateCachedState;
     renderer->RunCommandQueue = GL_RunCommandQueue;
     renderer->RenderReadPixels = GL_RenderReadPixels;
@@ -1796,6 +2278,34 @@ static int GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pro
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_UYVY);
 #endif
 
+    /* Compressed textures are only supported with regular 2D textures */
+    if (data->textype == GL_TEXTURE_2D) {
+        data->glCompressedTexImage2D = (PFNGLCOMPRESSEDTEXIMAGE2DPROC)SDL_GL_GetProcAddress("glCompressedTexImage2D");
+        data->glCompressedTexSubImage2D = (PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)SDL_GL_GetProcAddress("glCompressedTexSubImage2D");
+    }
+    if (data->glCompressedTexImage2D && data->glCompressedTexSubImage2D) {
+        if (SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc")) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BC1);
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BC2);
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BC3);
+        }
+        if (SDL_GL_ExtensionSupported("GL_ARB_texture_compression_rgtc") ||
+            SDL_GL_ExtensionSupported("GL_EXT_texture_compression_rgtc")) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BC4);
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BC5);
+        }
+        if (SDL_GL_ExtensionSupported("GL_ARB_texture_compression_bptc")) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BC7);
+        }
+        if (SDL_GL_ExtensionSupported("GL_ARB_ES3_compatibility")) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_ETC2_RGB8);
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_ETC2_RGBA8);
+        }
+        if (SDL_GL_ExtensionSupported("GL_KHR_texture_compression_astc_ldr")) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_ASTC_4X4);
+        }
+    }
+
     renderer->rect_index_order[0] = 0;
     renderer->rect_index_order[1] = 1;
     renderer->rect_index_order[2] = 3;
@@ -1815,11 +2325,68 @@ static int GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pro
             SDL_GL_GetProcAddress("glBindFramebufferEXT");
         data->glCheckFramebufferStatusEXT = (PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC)
             SDL_GL_GetProcAddress("glCheckFramebufferStatusEXT");
+        data->glGenerateMipmapEXT = (PFNGLGENERATEMIPMAPEXTPROC)
+            SDL_GL_GetProcAddress("glGenerateMipmapEXT");
+        renderer->mipmaps_supported = (data->glGenerateMipmapEXT != NULL);
     } else {
         SDL_SetError("Can't create render targets, GL_EXT_framebuffer_object not available");
         goto error;
     }
 
+    /* Check for anisotropic filtering support, used by mipmapped textures */
+    if (SDL_GL_ExtensionSupported("GL_EXT_texture_filter_anisotropic")) {
+        data->glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &data->max_anisotropy);
+    }
+
+    /* Check for GPU timer support */
+    if (SDL_GL_ExtensionSupported("GL_ARB_timer_query")) {
+        data->glGenQueries = (PFNGLGENQUERIESPROC)SDL_GL_GetProcAddress("glGenQueries");
+        data->glDeleteQueries = (PFNGLDELETEQUERIESPROC)SDL_GL_GetProcAddress("glDeleteQueries");
+        data->glBeginQuery = (PFNGLBEGINQUERYPROC)SDL_GL_GetProcAddress("glBeginQuery");
+        data->glEndQuery = (PFNGLENDQUERYPROC)SDL_GL_GetProcAddress("glEndQuery");
+        data->glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)SDL_GL_GetProcAddress("glGetQueryObjectiv");
+        data->glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)SDL_GL_GetProcAddress("glGetQueryObjectui64v");
+        if (data->glGenQueries && data->glDeleteQueries && data->glBeginQuery &&
+            data->glEndQuery && data->glGetQueryObjectiv && data->glGetQueryObjectui64v) {
+            data->GL_ARB_timer_query_supported = SDL_TRUE;
+            data->glGenQueries(GL_NUM_TIMER_QUERIES, data->timer_queries);
+        }
+    }
+
+    /* Check for persistently mapped buffer support, used to stream vertex data */
+    if (SDL_GL_ExtensionSupported("GL_ARB_buffer_storage") &&
+        SDL_GL_ExtensionSupported("GL_ARB_map_buffer_range") &&
+        SDL_GL_ExtensionSupported("GL_ARB_sync") &&
+        SDL_GetHintBoolean(SDL_HINT_RENDER_OPENGL_BUFFER_STORAGE, SDL_TRUE)) {
+        data->glGenBuffers = (PFNGLGENBUFFERSPROC)SDL_GL_GetProcAddress("glGenBuffers");
+        data->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)SDL_GL_GetProcAddress("glDeleteBuffers");
+        data->glBindBuffer = (PFNGLBINDBUFFERPROC)SDL_GL_GetProcAddress("glBindBuffer");
+        data->glBufferStorage = (PFNGLBUFFERSTORAGEPROC)SDL_GL_GetProcAddress("glBufferStorage");
+        data->glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)SDL_GL_GetProcAddress("glUnmapBuffer");
+        data->glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glGenBuffers && data->glDeleteBuffers && data->glBindBuffer &&
+            data->glBufferStorage && data->glMapBufferRange && data->glUnmapBuffer &&
+            data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            const GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+            const GLsizeiptr size = GL_NUM_VERTEX_SEGMENTS * GL_VERTEX_SEGMENT_SIZE;
+
+            data->glGenBuffers(1, &data->vertex_buffer);
+            data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_buffer);
+            data->glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+            data->vertex_buffer_data = (Uint8 *)data->glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+            data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+            if (!data->vertex_buffer_data) {
+                /* Fall back to client side arrays */
+                data->glDeleteBuffers(1, &data->vertex_buffer);
+                data->vertex_buffer = 0;
+            }
+            GL_ClearErrors(renderer);
+        }
+    }
+
     /* Set up parameters for rendering */
     data->glMatrixMode(GL_MODELVIEW);
     data->glLoadIdentity();
@@ -363,17 +363,14 @@ static SDL_bool CompileShader(GL_ShaderContext *ctx, GLhandleARB shader, const c
     }
 }
 
-static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_ShaderData *data)
+static SDL_bool CompileShaderProgramSource(GL_ShaderContext *ctx, const char *vert_source, const char *frag_source, GL_ShaderData *data)
 {
     const int num_tmus_bound = 4;
     const char *vert_defines = "";
     const char *frag_defines = "";
     int i;
     GLint location;
-
-    if (index == SHADER_NONE) {
-        return SDL_TRUE;
-    }
+    GLint status;
 
     ctx->glGetError();
 
@@ -393,13 +390,13 @@ static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_Shader
 
     /* Create the vertex shader */
     data->vert_shader = ctx->glCreateShaderObjectARB(GL_VERTEX_SHADER_ARB);
-    if (!CompileShader(ctx, data->vert_shader, vert_defines, shader_source[index][0])) {
+    if (!CompileShader(ctx, data->vert_shader, vert_defines, vert_source)) {
         return SDL_FALSE;
     }
 
     /* Create the fragment shader */
     data->frag_shader = ctx->glCreateShaderObjectARB(GL_FRAGMENT_SHADER_ARB);
-    if (!CompileShader(ctx, data->frag_shader, frag_defines, shader_source[index][1])) {
+    if (!CompileShader(ctx, data->frag_shader, frag_defines, frag_source)) {
         return SDL_FALSE;
     }
 
@@ -407,6 +404,11 @@ static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_Shader
     ctx->glAttachObjectARB(data->program, data->vert_shader);
     ctx->glAttachObjectARB(data->program, data->frag_shader);
     ctx->glLinkProgramARB(data->program);
+    ctx->glGetObjectParameterivARB(data->program, GL_OBJECT_LINK_STATUS_ARB, &status);
+    if (status == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to link shader program");
+        return SDL_FALSE;
+    }
 
     /* Set up some uniform variables */
     ctx->glUseProgramObjectARB(data->program);
@@ -423,6 +425,14 @@ static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_Shader
     return ctx->glGetError() == GL_NO_ERROR;
 }
 
+static SDL_bool CompileShaderProgram(GL_ShaderContext *ctx, int index, GL_ShaderData *data)
+{
+    if (index == SHADER_NONE) {
+        return SDL_TRUE;
+    }
+    return CompileShaderProgramSource(ctx, shader_source[index][0], shader_source[index][1], data);
+}
+
 static void DestroyShaderProgram(GL_ShaderContext *ctx, GL_ShaderData *data)
 {
     ctx->glDeleteObjectARB(data->vert_shader);
@@ -533,6 +543,39 @@ void GL_SelectShader(GL_ShaderContext *ctx, GL_Shader shader, const float *shade
     }
 }
 
+struct GL_CustomShader
+{
+    GL_ShaderData data;
+};
+
+GL_CustomShader *GL_CreateCustomShader(GL_ShaderContext *ctx, const char *frag_source)
+{
+    GL_CustomShader *shader = (GL_CustomShader *)SDL_calloc(1, sizeof(*shader));
+    if (!shader) {
+        return NULL;
+    }
+
+    /* Custom shaders share the texture vertex shader, so they get v_color and v_texCoord */
+    if (!CompileShaderProgramSource(ctx, TEXTURE_VERTEX_SHADER, frag_source, &shader->data)) {
+        DestroyShaderProgram(ctx, &shader->data);
+        SDL_free(shader);
+        SDL_SetError("Couldn't compile custom shader");
+        return NULL;
+    }
+    return shader;
+}
+
+void GL_SelectCustomShader(GL_ShaderContext *ctx, GL_CustomShader *shader)
+{
+    ctx->glUseProgramObjectARB(shader->data.program);
+}
+
+void GL_DestroyCustomShader(GL_ShaderContext *ctx, GL_CustomShader *shader)
+{
+    DestroyShaderProgram(ctx, &shader->data);
+    SDL_free(shader);
+}
+
 void GL_DestroyShaderContext(GL_ShaderContext *ctx)
 {
     int i;
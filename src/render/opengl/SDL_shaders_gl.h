@@ -49,4 +49,10 @@ extern GL_ShaderContext *GL_CreateShaderContext(void);
 extern void GL_SelectShader(GL_ShaderContext *ctx, GL_Shader shader, const float *shader_params);
 extern void GL_DestroyShaderContext(GL_ShaderContext *ctx);
 
+typedef struct GL_CustomShader GL_CustomShader;
+
+extern GL_CustomShader *GL_CreateCustomShader(GL_ShaderContext *ctx, const char *frag_source);
+extern void GL_SelectCustomShader(GL_ShaderContext *ctx, GL_CustomShader *shader);
+extern void GL_DestroyCustomShader(GL_ShaderContext *ctx, GL_CustomShader *shader);
+
 #endif /* SDL_shaders_gl_h_ */
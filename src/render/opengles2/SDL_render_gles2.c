@@ -25,6 +25,7 @@
 #include "../../video/SDL_sysvideo.h" /* For SDL_RecreateWindow */
 #include <SDL3/SDL_opengles2.h>
 #include "../SDL_sysrender.h"
+#include "../SDL_dmabuf_c.h"
 #include "../../video/SDL_blit.h"
 #include "../../video/SDL_pixels_c.h"
 #include "SDL_shaders_gles2.h"
@@ -40,6 +41,24 @@
 #define USE_VERTEX_BUFFER_OBJECTS 0
 #endif
 
+/* On drivers that can map buffer ranges (OpenGL ES 3.0, or GL_EXT_map_buffer_range),
+   vertex data is streamed through a single large VBO used as a ring buffer instead.
+   Each flush writes into the next free range with an unsynchronized mapping, and the
+   buffer is orphaned when it wraps, so we never stall waiting for the GPU to finish
+   with data it's still drawing. WebGL can't map buffers, so this is never used there. */
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+
+#define GLES2_STREAM_BUFFER_MIN_SIZE (1024 * 1024)
+#define GLES2_STREAM_BUFFER_ALIGNMENT 16
+
 /* To prevent unnecessary window recreation,
  * these should match the defaults selected in SDL_GL_ResetAttributes
  */
@@ -63,15 +82,19 @@ typedef struct GLES2_TextureData
 {
     GLuint texture;
     SDL_bool texture_external;
+    SDL_bool dmabuf;
     GLenum texture_type;
     GLenum pixel_format;
     GLenum pixel_type;
     void *pixel_data;
     int pitch;
+    SDL_Rect locked_rect;
+    SDL_bool mipmaps_dirty;
 #if SDL_HAVE_YUV
     /* YUV texture support */
     SDL_bool yuv;
     SDL_bool nv12;
+    SDL_bool nv12_rg; /* The UV plane is GL_RG-like instead of GL_LUMINANCE_ALPHA */
     GLuint texture_v;
     GLuint texture_v_external;
     GLuint texture_u;
@@ -138,6 +161,8 @@ typedef enum
     GLES2_IMAGESOURCE_TEXTURE_YUV,
     GLES2_IMAGESOURCE_TEXTURE_NV12,
     GLES2_IMAGESOURCE_TEXTURE_NV21,
+    GLES2_IMAGESOURCE_TEXTURE_NV12_RG,
+    GLES2_IMAGESOURCE_TEXTURE_NV21_RG,
     GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES
 } GLES2_ImageSource;
 
@@ -170,6 +195,7 @@ typedef struct GLES2_RenderData
     SDL_bool debug_enabled;
 
     SDL_bool GL_EXT_blend_minmax_supported;
+    SDL_bool GL_EXT_shader_framebuffer_fetch_supported;
 
 #define SDL_PROC(ret, func, params) ret (APIENTRY *func) params;
 #include "SDL_gles2funcs.h"
@@ -177,7 +203,7 @@ typedef struct GLES2_RenderData
     GLES2_FBOList *framebuffers;
     GLuint window_framebuffer;
 
-    GLuint shader_id_cache[GLES2_SHADER_COUNT];
+    GLuint shader_id_cache[GLES2_SHADER_BLEND_COUNT][GLES2_SHADER_COUNT];
 
     GLES2_ProgramCache program_cache;
     Uint8 clear_r, clear_g, clear_b, clear_a;
@@ -188,6 +214,19 @@ typedef struct GLES2_RenderData
     int current_vertex_buffer;
 #endif
 
+    /* Streaming vertex ring buffer, if the driver can map buffer ranges */
+    void *(APIENTRY *glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+    GLboolean (APIENTRY *glUnmapBuffer)(GLenum);
+    GLuint stream_buffer;
+    size_t stream_buffer_size;
+    size_t stream_buffer_offset;
+
+    /* Mipmaps on non-power-of-two textures need OpenGL ES 3.0 or GL_OES_texture_npot */
+    SDL_bool npot_mipmaps_supported;
+
+    /* Used to skip loading the previous contents of transient render targets */
+    void (APIENTRY *glInvalidateFramebuffer)(GLenum, GLsizei, const GLenum *);
+
     GLES2_DrawStateCache drawstate;
     GLES2_ShaderIncludeType texcoord_precision_hint;
 } GLES2_RenderData;
@@ -282,6 +321,71 @@ static int GLES2_LoadFunctions(GLES2_RenderData *data)
     return 0;
 }
 
+static void GLES2_LoadStreamFunctions(GLES2_RenderData *data)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    const char *version = (const char *)data->glGetString(GL_VERSION);
+    int major = 0;
+
+    if (version && SDL_sscanf(version, "OpenGL ES %d", &major) == 1 && major >= 3) {
+        data->glMapBufferRange = (void *(APIENTRY *)(GLenum, GLintptr, GLsizeiptr, GLbitfield))SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glUnmapBuffer = (GLboolean (APIENTRY *)(GLenum))SDL_GL_GetProcAddress("glUnmapBuffer");
+    } else if (SDL_GL_ExtensionSupported("GL_EXT_map_buffer_range") && SDL_GL_ExtensionSupported("GL_OES_mapbuffer")) {
+        data->glMapBufferRange = (void *(APIENTRY *)(GLenum, GLintptr, GLsizeiptr, GLbitfield))SDL_GL_GetProcAddress("glMapBufferRangeEXT");
+        data->glUnmapBuffer = (GLboolean (APIENTRY *)(GLenum))SDL_GL_GetProcAddress("glUnmapBufferOES");
+    }
+
+    if (!data->glMapBufferRange || !data->glUnmapBuffer) {
+        data->glMapBufferRange = NULL;
+        data->glUnmapBuffer = NULL;
+        return;
+    }
+
+    data->glGenBuffers(1, &data->stream_buffer);
+#endif
+}
+
+/* Copy this flush's vertices into the next free range of the stream buffer.
+   On success, *offset is where they landed, for use as the attrib pointer base. */
+static int GLES2_UploadStreamVertices(GLES2_RenderData *data, const void *vertices, size_t vertsize, size_t *offset)
+{
+    void *ptr;
+
+    data->glBindBuffer(GL_ARRAY_BUFFER, data->stream_buffer);
+
+    if (vertsize > data->stream_buffer_size) {
+        size_t newsize = SDL_max(data->stream_buffer_size, GLES2_STREAM_BUFFER_MIN_SIZE);
+        while (newsize < vertsize) {
+            newsize *= 2;
+        }
+        data->glBufferData(GL_ARRAY_BUFFER, newsize, NULL, GL_STREAM_DRAW);
+        data->stream_buffer_size = newsize;
+        data->stream_buffer_offset = 0;
+    } else if ((data->stream_buffer_offset + vertsize) > data->stream_buffer_size) {
+        /* orphan the old storage; the driver keeps it alive until the GPU is done with it. */
+        data->glBufferData(GL_ARRAY_BUFFER, data->stream_buffer_size, NULL, GL_STREAM_DRAW);
+        data->stream_buffer_offset = 0;
+    }
+
+    ptr = data->glMapBufferRange(GL_ARRAY_BUFFER, data->stream_buffer_offset, vertsize,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!ptr) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return -1;
+    }
+    SDL_memcpy(ptr, vertices, vertsize);
+    if (!data->glUnmapBuffer(GL_ARRAY_BUFFER)) {
+        /* the buffer contents were lost, the driver wants us to upload again. */
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return -1;
+    }
+
+    *offset = data->stream_buffer_offset;
+    data->stream_buffer_offset += vertsize;
+    data->stream_buffer_offset = (data->stream_buffer_offset + (GLES2_STREAM_BUFFER_ALIGNMENT - 1)) & ~(size_t)(GLES2_STREAM_BUFFER_ALIGNMENT - 1);
+    return 0;
+}
+
 static GLES2_FBOList *GLES2_GetFBO(GLES2_RenderData *data, Uint32 w, Uint32 h)
 {
     GLES2_FBOList *result = data->framebuffers;
@@ -373,6 +477,25 @@ static GLenum GetBlendEquation(SDL_BlendOperation operation)
     }
 }
 
+/* Blend operations that fixed function blending can't do, done in the fragment shader instead */
+static GLES2_ShaderBlendType GetShaderBlendType(SDL_BlendMode blendMode)
+{
+    if (blendMode == SDL_BLENDMODE_NONE) {
+        return GLES2_SHADER_BLEND_NONE;
+    }
+
+    switch (SDL_GetBlendModeColorOperation(blendMode)) {
+    case SDL_BLENDOPERATION_MULTIPLY:
+        return GLES2_SHADER_BLEND_MULTIPLY;
+    case SDL_BLENDOPERATION_SCREEN:
+        return GLES2_SHADER_BLEND_SCREEN;
+    case SDL_BLENDOPERATION_OVERLAY:
+        return GLES2_SHADER_BLEND_OVERLAY;
+    default:
+        return GLES2_SHADER_BLEND_NONE;
+    }
+}
+
 static SDL_bool GLES2_SupportsBlendMode(SDL_Renderer *renderer, SDL_BlendMode blendMode)
 {
     GLES2_RenderData *data = (GLES2_RenderData *)renderer->internal;
@@ -384,6 +507,11 @@ static SDL_bool GLES2_SupportsBlendMode(SDL_Renderer *renderer, SDL_BlendMode bl
     SDL_BlendFactor dstAlphaFactor = SDL_GetBlendModeDstAlphaFactor(blendMode);
     SDL_BlendOperation alphaOperation = SDL_GetBlendModeAlphaOperation(blendMode);
 
+    if (GetShaderBlendType(blendMode) != GLES2_SHADER_BLEND_NONE) {
+        /* The factors and alpha operation are ignored, the shader reads the render target */
+        return data->GL_EXT_shader_framebuffer_fetch_supported;
+    }
+
     if (GetBlendFunc(srcColorFactor) == GL_INVALID_ENUM ||
         GetBlendFunc(srcAlphaFactor) == GL_INVALID_ENUM ||
         GetBlendEquation(colorOperation) == GL_INVALID_ENUM ||
@@ -499,12 +627,12 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuin
     return entry;
 }
 
-static GLuint GLES2_CacheShader(GLES2_RenderData *data, GLES2_ShaderType type, GLenum shader_type)
+static GLuint GLES2_CacheShader(GLES2_RenderData *data, GLES2_ShaderType type, GLES2_ShaderBlendType blend, GLenum shader_type)
 {
     GLuint id = 0;
     GLint compileSuccessful = GL_FALSE;
     int attempt, num_src;
-    const GLchar *shader_src_list[3];
+    const GLchar *shader_src_list[6];
     const GLchar *shader_body = GLES2_GetShader(type);
 
     if (!shader_body) {
@@ -518,15 +646,23 @@ static GLuint GLES2_CacheShader(GLES2_RenderData *data, GLES2_ShaderType type, G
         shader_src_list[num_src++] = GLES2_GetShaderPrologue(type);
 
         if (shader_type == GL_FRAGMENT_SHADER) {
+            shader_src_list[num_src++] = GLES2_GetShaderBlendPrologue(blend);
             if (attempt == 0) {
                 shader_src_list[num_src++] = GLES2_GetShaderInclude(data->texcoord_precision_hint);
             } else {
                 shader_src_list[num_src++] = GLES2_GetShaderInclude(GLES2_SHADER_FRAGMENT_INCLUDE_UNDEF_PRECISION);
             }
+            if (blend != GLES2_SHADER_BLEND_NONE) {
+                shader_src_list[num_src++] = "#define main SDL_ShadedColor\n";
+            }
         }
 
         shader_src_list[num_src++] = shader_body;
 
+        if (shader_type == GL_FRAGMENT_SHADER) {
+            shader_src_list[num_src++] = GLES2_GetShaderBlendEpilogue(blend);
+        }
+
         SDL_assert(num_src <= SDL_arraysize(shader_src_list));
 
 #ifdef DEBUG_PRINT_SHADERS
@@ -574,7 +710,7 @@ static GLuint GLES2_CacheShader(GLES2_RenderData *data, GLES2_ShaderType type, G
     }
 
     /* Cache */
-    data->shader_id_cache[(Uint32)type] = id;
+    data->shader_id_cache[blend][(Uint32)type] = id;
 
     return id;
 }
@@ -593,14 +729,14 @@ static int GLES2_CacheShaders(GLES2_RenderData *data)
         } else {
             shader_type = GL_FRAGMENT_SHADER;
         }
-        if (!GLES2_CacheShader(data, (GLES2_ShaderType)shader, shader_type)) {
+        if (!GLES2_CacheShader(data, (GLES2_ShaderType)shader, GLES2_SHADER_BLEND_NONE, shader_type)) {
             return -1;
         }
     }
     return 0;
 }
 
-static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source, SDL_Colorspace colorspace)
+static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source, SDL_Colorspace colorspace, GLES2_ShaderBlendType blend)
 {
     GLuint vertex;
     GLuint fragment;
@@ -659,6 +795,19 @@ static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source,
             goto fault;
         }
         break;
+    case GLES2_IMAGESOURCE_TEXTURE_NV12_RG:
+    case GLES2_IMAGESOURCE_TEXTURE_NV21_RG:
+        if (source == GLES2_IMAGESOURCE_TEXTURE_NV12_RG) {
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_NV12_RG;
+        } else {
+            ftype = GLES2_SHADER_FRAGMENT_TEXTURE_NV21_RG;
+        }
+        shader_params = SDL_GetYCbCRtoRGBConversionMatrix(colorspace, 0, 0, 8);
+        if (!shader_params) {
+            SDL_SetError("Unsupported YUV colorspace");
+            goto fault;
+        }
+        break;
 #endif /* SDL_HAVE_YUV */
     case GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES:
         ftype = GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES;
@@ -668,17 +817,17 @@ static int GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source,
     }
 
     /* Load the requested shaders */
-    vertex = data->shader_id_cache[(Uint32)vtype];
+    vertex = data->shader_id_cache[GLES2_SHADER_BLEND_NONE][(Uint32)vtype];
     if (!vertex) {
-        vertex = GLES2_CacheShader(data, vtype, GL_VERTEX_SHADER);
+        vertex = GLES2_CacheShader(data, vtype, GLES2_SHADER_BLEND_NONE, GL_VERTEX_SHADER);
         if (!vertex) {
             goto fault;
         }
     }
 
-    fragment = data->shader_id_cache[(Uint32)ftype];
+    fragment = data->shader_id_cache[blend][(Uint32)ftype];
     if (!fragment) {
-        fragment = GLES2_CacheShader(data, ftype, GL_FRAGMENT_SHADER);
+        fragment = GLES2_CacheShader(data, ftype, blend, GL_FRAGMENT_SHADER);
         if (!fragment) {
             goto fault;
         }
@@ -992,7 +1141,7 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
         data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)&verts->tex_coord);
     }
 
-    if (GLES2_SelectProgram(data, imgsrc, texture ? texture->colorspace : SDL_COLORSPACE_SRGB) < 0) {
+    if (GLES2_SelectProgram(data, imgsrc, texture ? texture->colorspace : SDL_COLORSPACE_SRGB, GetShaderBlendType(blend)) < 0) {
         return -1;
     }
 
@@ -1006,7 +1155,7 @@ static int SetDrawState(GLES2_RenderData *data, const SDL_RenderCommand *cmd, co
     }
 
     if (blend != data->drawstate.blend) {
-        if (blend == SDL_BLENDMODE_NONE) {
+        if (blend == SDL_BLENDMODE_NONE || GetShaderBlendType(blend) != GLES2_SHADER_BLEND_NONE) {
             data->glDisable(GL_BLEND);
         } else {
             data->glEnable(GL_BLEND);
@@ -1121,10 +1270,10 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_YUV;
                 break;
             case SDL_PIXELFORMAT_NV12:
-                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV12;
+                sourceType = ((GLES2_TextureData *)texture->internal)->nv12_rg ? GLES2_IMAGESOURCE_TEXTURE_NV12_RG : GLES2_IMAGESOURCE_TEXTURE_NV12;
                 break;
             case SDL_PIXELFORMAT_NV21:
-                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
+                sourceType = ((GLES2_TextureData *)texture->internal)->nv12_rg ? GLES2_IMAGESOURCE_TEXTURE_NV21_RG : GLES2_IMAGESOURCE_TEXTURE_NV21;
                 break;
 #endif
             case SDL_PIXELFORMAT_EXTERNAL_OES:
@@ -1156,10 +1305,10 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
             sourceType = GLES2_IMAGESOURCE_TEXTURE_YUV;
             break;
         case SDL_PIXELFORMAT_NV12:
-            sourceType = GLES2_IMAGESOURCE_TEXTURE_NV12;
+            sourceType = ((GLES2_TextureData *)texture->internal)->nv12_rg ? GLES2_IMAGESOURCE_TEXTURE_NV12_RG : GLES2_IMAGESOURCE_TEXTURE_NV12;
             break;
         case SDL_PIXELFORMAT_NV21:
-            sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
+            sourceType = ((GLES2_TextureData *)texture->internal)->nv12_rg ? GLES2_IMAGESOURCE_TEXTURE_NV21_RG : GLES2_IMAGESOURCE_TEXTURE_NV21;
             break;
 #endif
         case SDL_PIXELFORMAT_EXTERNAL_OES:
@@ -1172,7 +1321,7 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
 
     ret = SetDrawState(data, cmd, sourceType, vertices);
 
-    if (texture != data->drawstate.texture) {
+    if (texture != data->drawstate.texture || ((GLES2_TextureData *)texture->internal)->mipmaps_dirty) {
         GLES2_TextureData *tdata = (GLES2_TextureData *)texture->internal;
 #if SDL_HAVE_YUV
         if (tdata->yuv) {
@@ -1208,6 +1357,11 @@ static int SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, vo
             return -1;
         }
 
+        if (tdata->mipmaps_dirty) {
+            data->glGenerateMipmap(tdata->texture_type);
+            tdata->mipmaps_dirty = SDL_FALSE;
+        }
+
         data->drawstate.texture = texture;
     }
 
@@ -1237,6 +1391,8 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
 #if USE_VERTEX_BUFFER_OBJECTS
     const int vboidx = data->current_vertex_buffer;
     const GLuint vbo = data->vertex_buffers[vboidx];
+#else
+    SDL_bool streamed = SDL_FALSE;
 #endif
 
     if (GLES2_ActivateRenderer(renderer) < 0) {
@@ -1271,6 +1427,14 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         data->current_vertex_buffer = 0;
     }
     vertices = NULL; /* attrib pointers will be offsets into the VBO. */
+#else
+    if (data->stream_buffer && vertsize > 0) {
+        size_t offset = 0;
+        if (GLES2_UploadStreamVertices(data, vertices, vertsize, &offset) == 0) {
+            vertices = (void *)(uintptr_t)offset; /* attrib pointers will be offsets into the VBO. */
+            streamed = SDL_TRUE;
+        }
+    }
 #endif
 
     while (cmd) {
@@ -1428,6 +1592,13 @@ static int GLES2_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
         cmd = cmd->next;
     }
 
+#if !USE_VERTEX_BUFFER_OBJECTS
+    /* Don't leave the stream buffer bound, other GL code may use client side arrays */
+    if (streamed) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+#endif
+
     return GL_CheckError("", renderer);
 }
 
@@ -1440,11 +1611,13 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
         GLES2_ActivateRenderer(renderer);
 
         {
-            int i;
-            for (i = 0; i < GLES2_SHADER_COUNT; i++) {
-                GLuint id = data->shader_id_cache[i];
-                if (id) {
-                    data->glDeleteShader(id);
+            int i, j;
+            for (i = 0; i < GLES2_SHADER_BLEND_COUNT; i++) {
+                for (j = 0; j < GLES2_SHADER_COUNT; j++) {
+                    GLuint id = data->shader_id_cache[i][j];
+                    if (id) {
+                        data->glDeleteShader(id);
+                    }
                 }
             }
         }
@@ -1474,6 +1647,11 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
             GL_CheckError("", renderer);
 #endif
 
+            if (data->stream_buffer) {
+                data->glDeleteBuffers(1, &data->stream_buffer);
+                GL_CheckError("", renderer);
+            }
+
             SDL_GL_DestroyContext(data->context);
         }
 
@@ -1481,6 +1659,21 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
     }
 }
 
+static void GLES2_SetTextureFilter(GLES2_RenderData *renderdata, SDL_Texture *texture, GLenum texture_type, SDL_ScaleMode scaleMode)
+{
+    GLenum min_filter, mag_filter;
+
+    if (scaleMode == SDL_SCALEMODE_NEAREST) {
+        min_filter = GL_NEAREST;
+        mag_filter = GL_NEAREST;
+    } else {
+        min_filter = texture->mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+        mag_filter = GL_LINEAR;
+    }
+    renderdata->glTexParameteri(texture_type, GL_TEXTURE_MIN_FILTER, min_filter);
+    renderdata->glTexParameteri(texture_type, GL_TEXTURE_MAG_FILTER, mag_filter);
+}
+
 static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     GLES2_RenderData *renderdata = (GLES2_RenderData *)renderer->internal;
@@ -1488,6 +1681,8 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     GLenum format;
     GLenum type;
     GLenum scaleMode;
+    SDL_bool dmabuf = SDL_HasDMABUFTextureProperties(create_props);
+    Uint32 drm_format = 0;
 
     GLES2_ActivateRenderer(renderer);
 
@@ -1501,6 +1696,8 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     case SDL_PIXELFORMAT_RGBX32:
         format = GL_RGBA;
         type = GL_UNSIGNED_BYTE;
+        /* Imported in memory order, like GL_RGBA uploads, the shaders do the swizzling */
+        drm_format = SDL_ISPIXELFORMAT_ALPHA(texture->format) ? SDL_DRM_FORMAT_ABGR8888 : SDL_DRM_FORMAT_XBGR8888;
         break;
 #if SDL_HAVE_YUV
     case SDL_PIXELFORMAT_IYUV:
@@ -1509,6 +1706,7 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     case SDL_PIXELFORMAT_NV21:
         format = GL_LUMINANCE;
         type = GL_UNSIGNED_BYTE;
+        drm_format = SDL_DRM_FORMAT_R8;
         break;
 #endif
 #ifdef GL_TEXTURE_EXTERNAL_OES
@@ -1526,6 +1724,16 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         return SDL_SetError("Unsupported texture access for SDL_PIXELFORMAT_EXTERNAL_OES");
     }
 
+    if (dmabuf) {
+        if (!drm_format) {
+            return SDL_SetError("DMA-BUF textures can't have format %s", SDL_GetPixelFormatName(texture->format));
+        }
+        if (texture->access != SDL_TEXTUREACCESS_STATIC) {
+            return SDL_SetError("DMA-BUF textures must have SDL_TEXTUREACCESS_STATIC access");
+        }
+        texture->mipmaps = SDL_FALSE;
+    }
+
     /* Allocate a texture struct */
     data = (GLES2_TextureData *)SDL_calloc(1, sizeof(GLES2_TextureData));
     if (!data) {
@@ -1547,6 +1755,14 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
 #endif
     scaleMode = (texture->scaleMode == SDL_SCALEMODE_NEAREST) ? GL_NEAREST : GL_LINEAR;
 
+    /* Mipmaps need a full texture chain, so they aren't available for multi-plane formats */
+    if (texture->mipmaps &&
+        (SDL_ISPIXELFORMAT_FOURCC(texture->format) ||
+         (!renderdata->npot_mipmaps_supported &&
+          (SDL_powerof2(texture->w) != texture->w || SDL_powerof2(texture->h) != texture->h)))) {
+        texture->mipmaps = SDL_FALSE;
+    }
+
     /* Allocate a blob for image renderdata */
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         size_t size;
@@ -1586,7 +1802,15 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         renderdata->glBindTexture(data->texture_type, data->texture_v);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
-        renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+        if (dmabuf) {
+            /* YV12 stores V before U */
+            if (SDL_BindDMABUFTexturePlane(create_props, (texture->format == SDL_PIXELFORMAT_YV12) ? 1 : 2, SDL_DRM_FORMAT_R8,
+                                           (texture->w + 1) / 2, (texture->h + 1) / 2, data->texture_type) < 0) {
+                return -1;
+            }
+        } else {
+            renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+        }
         SDL_SetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_V_NUMBER, data->texture_v);
 
         data->texture_u = (GLuint)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_OPENGLES2_TEXTURE_U_NUMBER, 0);
@@ -1602,7 +1826,14 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         renderdata->glBindTexture(data->texture_type, data->texture_u);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
-        renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+        if (dmabuf) {
+            if (SDL_BindDMABUFTexturePlane(create_props, (texture->format == SDL_PIXELFORMAT_YV12) ? 2 : 1, SDL_DRM_FORMAT_R8,
+                                           (texture->w + 1) / 2, (texture->h + 1) / 2, data->texture_type) < 0) {
+                return -1;
+            }
+        } else {
+            renderdata->glTexImage2D(data->texture_type, 0, format, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, format, type, NULL);
+        }
         if (GL_CheckError("glTexImage2D()", renderer) < 0) {
             return -1;
         }
@@ -1625,7 +1856,16 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
         renderdata->glBindTexture(data->texture_type, data->texture_u);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
-        renderdata->glTexImage2D(data->texture_type, 0, GL_LUMINANCE_ALPHA, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
+        if (dmabuf) {
+            /* The imported chroma plane has U and V in red and green */
+            if (SDL_BindDMABUFTexturePlane(create_props, 1, SDL_DRM_FORMAT_GR88,
+                                           (texture->w + 1) / 2, (texture->h + 1) / 2, data->texture_type) < 0) {
+                return -1;
+            }
+            data->nv12_rg = SDL_TRUE;
+        } else {
+            renderdata->glTexImage2D(data->texture_type, 0, GL_LUMINANCE_ALPHA, (texture->w + 1) / 2, (texture->h + 1) / 2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
+        }
         if (GL_CheckError("glTexImage2D()", renderer) < 0) {
             return -1;
         }
@@ -1649,14 +1889,24 @@ static int GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL
     texture->internal = data;
     renderdata->glActiveTexture(GL_TEXTURE0);
     renderdata->glBindTexture(data->texture_type, data->texture);
-    renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
-    renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
-    if (texture->format != SDL_PIXELFORMAT_EXTERNAL_OES) {
+    GLES2_SetTextureFilter(renderdata, texture, data->texture_type, texture->scaleMode);
+    if (dmabuf) {
+        data->dmabuf = SDL_TRUE;
+        if (SDL_BindDMABUFTexturePlane(create_props, 0, drm_format, texture->w, texture->h, data->texture_type) < 0) {
+            return -1;
+        }
+        if (GL_CheckError("glEGLImageTargetTexture2DOES()", renderer) < 0) {
+            return -1;
+        }
+    } else if (texture->format != SDL_PIXELFORMAT_EXTERNAL_OES) {
         renderdata->glTexImage2D(data->texture_type, 0, format, texture->w, texture->h, 0, format, type, NULL);
         if (GL_CheckError("glTexImage2D()", renderer) < 0) {
             return -1;
         }
     }
+    if (texture->mipmaps) {
+        renderdata->glGenerateMipmap(data->texture_type);
+    }
     SDL_SetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_NUMBER, data->texture);
     SDL_SetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_TARGET_NUMBER, data->texture_type);
 
@@ -1710,6 +1960,10 @@ static int GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, con
     GLES2_RenderData *data = (GLES2_RenderData *)renderer->internal;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->internal;
 
+    if (tdata->dmabuf) {
+        return SDL_SetError("DMA-BUF textures can't be updated");
+    }
+
     GLES2_ActivateRenderer(renderer);
 
     /* Bail out if we're supposed to update an empty rectangle */
@@ -1729,6 +1983,9 @@ static int GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, con
                         tdata->pixel_format,
                         tdata->pixel_type,
                         pixels, pitch, SDL_BYTESPERPIXEL(texture->format));
+    if (texture->mipmaps) {
+        tdata->mipmaps_dirty = SDL_TRUE;
+    }
 
 #if SDL_HAVE_YUV
     if (tdata->yuv) {
@@ -1791,6 +2048,10 @@ static int GLES2_UpdateTextureYUV(SDL_Renderer *renderer, SDL_Texture *texture,
     GLES2_RenderData *data = (GLES2_RenderData *)renderer->internal;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->internal;
 
+    if (tdata->dmabuf) {
+        return SDL_SetError("DMA-BUF textures can't be updated");
+    }
+
     GLES2_ActivateRenderer(renderer);
 
     /* Bail out if we're supposed to update an empty rectangle */
@@ -1841,6 +2102,10 @@ static int GLES2_UpdateTextureNV(SDL_Renderer *renderer, SDL_Texture *texture,
     GLES2_RenderData *data = (GLES2_RenderData *)renderer->internal;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->internal;
 
+    if (tdata->dmabuf) {
+        return SDL_SetError("DMA-BUF textures can't be updated");
+    }
+
     GLES2_ActivateRenderer(renderer);
 
     /* Bail out if we're supposed to update an empty rectangle */
@@ -1884,6 +2149,7 @@ static int GLES2_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture, const
               (tdata->pitch * rect->y) +
               (rect->x * SDL_BYTESPERPIXEL(texture->format));
     *pitch = tdata->pitch;
+    tdata->locked_rect = *rect;
 
     return 0;
 }
@@ -1891,14 +2157,27 @@ static int GLES2_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture, const
 static void GLES2_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->internal;
-    SDL_Rect rect;
-
-    /* We do whole texture updates, at least for now */
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = texture->w;
-    rect.h = texture->h;
-    GLES2_UpdateTexture(renderer, texture, &rect, tdata->pixel_data, tdata->pitch);
+    const SDL_Rect *rect = &tdata->locked_rect;
+    const void *pixels;
+
+#if SDL_HAVE_YUV
+    if (tdata->yuv || tdata->nv12) {
+        SDL_Rect full_rect;
+
+        /* The planes follow each other in pixel_data, update them whole */
+        full_rect.x = 0;
+        full_rect.y = 0;
+        full_rect.w = texture->w;
+        full_rect.h = texture->h;
+        GLES2_UpdateTexture(renderer, texture, &full_rect, tdata->pixel_data, tdata->pitch);
+        return;
+    }
+#endif
+
+    pixels = (const Uint8 *)tdata->pixel_data +
+             (tdata->pitch * rect->y) +
+             (rect->x * SDL_BYTESPERPIXEL(texture->format));
+    GLES2_UpdateTexture(renderer, texture, rect, pixels, tdata->pitch);
 }
 
 static void GLES2_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode)
@@ -1928,8 +2207,7 @@ static void GLES2_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *textu
 
     renderdata->glActiveTexture(GL_TEXTURE0);
     renderdata->glBindTexture(data->texture_type, data->texture);
-    renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, glScaleMode);
-    renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, glScaleMode);
+    GLES2_SetTextureFilter(renderdata, texture, data->texture_type, scaleMode);
 }
 
 static int GLES2_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
@@ -1944,6 +2222,10 @@ static int GLES2_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         data->glBindFramebuffer(GL_FRAMEBUFFER, data->window_framebuffer);
     } else {
         texturedata = (GLES2_TextureData *)texture->internal;
+        if (texture->mipmaps) {
+            /* We don't know what will be drawn, so regenerate the mipmaps the next time it's used */
+            texturedata->mipmaps_dirty = SDL_TRUE;
+        }
         data->glBindFramebuffer(GL_FRAMEBUFFER, texturedata->fbo->FBO);
         /* TODO: check if texture pixel format allows this operation */
         data->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texturedata->texture_type, texturedata->texture, 0);
@@ -1952,6 +2234,11 @@ static int GLES2_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         if (status != GL_FRAMEBUFFER_COMPLETE) {
             return SDL_SetError("glFramebufferTexture2D() failed");
         }
+        if (texture->transient && data->glInvalidateFramebuffer) {
+            /* The previous contents are undefined, so tile-based GPUs don't need to load them */
+            const GLenum attachment = GL_COLOR_ATTACHMENT0;
+            data->glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &attachment);
+        }
     }
     return 0;
 }
@@ -2157,8 +2444,26 @@ static int GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
 #if USE_VERTEX_BUFFER_OBJECTS
     /* we keep a few of these and cycle through them, so data can live for a few frames. */
     data->glGenBuffers(SDL_arraysize(data->vertex_buffers), data->vertex_buffers);
+#else
+    GLES2_LoadStreamFunctions(data);
 #endif
 
+    {
+        const char *version = (const char *)data->glGetString(GL_VERSION);
+        int version_major = 0;
+
+        if ((version && SDL_sscanf(version, "OpenGL ES %d", &version_major) == 1 && version_major >= 3) ||
+            SDL_GL_ExtensionSupported("GL_OES_texture_npot")) {
+            data->npot_mipmaps_supported = SDL_TRUE;
+        }
+
+        if (version_major >= 3) {
+            data->glInvalidateFramebuffer = (void (APIENTRY *)(GLenum, GLsizei, const GLenum *))SDL_GL_GetProcAddress("glInvalidateFramebuffer");
+        } else if (SDL_GL_ExtensionSupported("GL_EXT_discard_framebuffer")) {
+            data->glInvalidateFramebuffer = (void (APIENTRY *)(GLenum, GLsizei, const GLenum *))SDL_GL_GetProcAddress("glDiscardFramebufferEXT");
+        }
+    }
+
     data->framebuffers = NULL;
     data->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &window_framebuffer);
     data->window_framebuffer = (GLuint)window_framebuffer;
@@ -2176,6 +2481,8 @@ static int GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
     renderer->UnlockTexture = GLES2_UnlockTexture;
     renderer->SetTextureScaleMode = GLES2_SetTextureScaleMode;
     renderer->SetRenderTarget = GLES2_SetRenderTarget;
+    renderer->mipmaps_supported = SDL_TRUE;
+    renderer->persistent_lock_memory = SDL_TRUE;
     renderer->QueueSetViewport = GLES2_QueueNoOp;
     renderer->QueueSetDrawColor = GLES2_QueueNoOp;
     renderer->QueueDrawPoints = GLES2_QueueDrawPoints;
@@ -2195,7 +2502,7 @@ static int GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV21);
 #endif
 #ifdef GL_TEXTURE_EXTERNAL_OES
-    if (GLES2_CacheShader(data, GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES, GL_FRAGMENT_SHADER)) {
+    if (GLES2_CacheShader(data, GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES, GLES2_SHADER_BLEND_NONE, GL_FRAGMENT_SHADER)) {
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_EXTERNAL_OES);
     }
 #endif
@@ -2210,6 +2517,9 @@ static int GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_
     if (SDL_GL_ExtensionSupported("GL_EXT_blend_minmax")) {
         data->GL_EXT_blend_minmax_supported = SDL_TRUE;
     }
+    if (SDL_GL_ExtensionSupported("GL_EXT_shader_framebuffer_fetch")) {
+        data->GL_EXT_shader_framebuffer_fetch_supported = SDL_TRUE;
+    }
 
     /* Set up parameters for rendering */
     data->glActiveTexture(GL_TEXTURE0);
@@ -300,6 +300,53 @@ static const char GLES2_Fragment_TextureExternalOES[] =         \
 "}\n"                                                           \
 ;
 
+/* Blend operations that read the render target with framebuffer fetch.
+   The shader body is compiled with main renamed, and the epilogue blends its
+   output over the destination like SDL_BLENDMODE_BLEND, with SDL_Blend()
+   applied to the color. */
+static const char GLES2_Fragment_Blend_Prologue[] =             \
+"#extension GL_EXT_shader_framebuffer_fetch : require\n"        \
+"\n"                                                            \
+;
+
+#define GLES2_FRAGMENT_BLEND_MAIN                               \
+"\n"                                                            \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    SDL_ShadedColor();\n"                                      \
+"    mediump vec4 src = gl_FragColor;\n"                        \
+"    mediump vec4 dst = gl_LastFragData[0];\n"                  \
+"    gl_FragColor.rgb = mix(dst.rgb, SDL_Blend(src.rgb, dst.rgb), src.a);\n" \
+"    gl_FragColor.a = src.a + dst.a * (1.0 - src.a);\n"         \
+"}\n"                                                           \
+
+static const char GLES2_Fragment_Blend_Multiply[] =             \
+"#undef main\n"                                                 \
+"mediump vec3 SDL_Blend(mediump vec3 s, mediump vec3 d)\n"      \
+"{\n"                                                           \
+"    return s * d;\n"                                           \
+"}\n"                                                           \
+GLES2_FRAGMENT_BLEND_MAIN                                       \
+;
+
+static const char GLES2_Fragment_Blend_Screen[] =               \
+"#undef main\n"                                                 \
+"mediump vec3 SDL_Blend(mediump vec3 s, mediump vec3 d)\n"      \
+"{\n"                                                           \
+"    return s + d - s * d;\n"                                   \
+"}\n"                                                           \
+GLES2_FRAGMENT_BLEND_MAIN                                       \
+;
+
+static const char GLES2_Fragment_Blend_Overlay[] =              \
+"#undef main\n"                                                 \
+"mediump vec3 SDL_Blend(mediump vec3 s, mediump vec3 d)\n"      \
+"{\n"                                                           \
+"    return mix(2.0 * s * d, 1.0 - 2.0 * (1.0 - s) * (1.0 - d), step(0.5, d));\n" \
+"}\n"                                                           \
+GLES2_FRAGMENT_BLEND_MAIN                                       \
+;
+
 /* *INDENT-ON* */ /* clang-format on */
 
 /*************************************************************************************************
@@ -316,6 +363,28 @@ const char *GLES2_GetShaderPrologue(GLES2_ShaderType type)
     }
 }
 
+const char *GLES2_GetShaderBlendPrologue(GLES2_ShaderBlendType blend)
+{
+    if (blend == GLES2_SHADER_BLEND_NONE) {
+        return "";
+    }
+    return GLES2_Fragment_Blend_Prologue;
+}
+
+const char *GLES2_GetShaderBlendEpilogue(GLES2_ShaderBlendType blend)
+{
+    switch (blend) {
+    case GLES2_SHADER_BLEND_MULTIPLY:
+        return GLES2_Fragment_Blend_Multiply;
+    case GLES2_SHADER_BLEND_SCREEN:
+        return GLES2_Fragment_Blend_Screen;
+    case GLES2_SHADER_BLEND_OVERLAY:
+        return GLES2_Fragment_Blend_Overlay;
+    default:
+        return "";
+    }
+}
+
 const char *GLES2_GetShaderInclude(GLES2_ShaderIncludeType type)
 {
     switch (type) {
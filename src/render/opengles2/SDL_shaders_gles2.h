@@ -55,7 +55,19 @@ typedef enum
     GLES2_SHADER_COUNT
 } GLES2_ShaderType;
 
+/* Blend operations done in the fragment shader with EXT_shader_framebuffer_fetch */
+typedef enum
+{
+    GLES2_SHADER_BLEND_NONE = 0,
+    GLES2_SHADER_BLEND_MULTIPLY,
+    GLES2_SHADER_BLEND_SCREEN,
+    GLES2_SHADER_BLEND_OVERLAY,
+    GLES2_SHADER_BLEND_COUNT
+} GLES2_ShaderBlendType;
+
 extern const char *GLES2_GetShaderPrologue(GLES2_ShaderType type);
+extern const char *GLES2_GetShaderBlendPrologue(GLES2_ShaderBlendType blend);
+extern const char *GLES2_GetShaderBlendEpilogue(GLES2_ShaderBlendType blend);
 extern const char *GLES2_GetShaderInclude(GLES2_ShaderIncludeType type);
 extern const char *GLES2_GetShader(GLES2_ShaderType type);
 extern GLES2_ShaderIncludeType GLES2_GetTexCoordPrecisionEnumFromHint(void);
@@ -33,6 +33,7 @@
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
+#include "../../video/SDL_blit.h"
 #include "../../video/SDL_pixels_c.h"
 
 /* SDL surface based renderer implementation */
@@ -41,16 +42,127 @@ typedef struct
 {
     const SDL_Rect *viewport;
     const SDL_Rect *cliprect;
+    const SDL_Rect *band;
     SDL_bool surface_cliprect_dirty;
     SDL_Color color;
 } SW_DrawStateCache;
 
+/* A texture surface used while rendering one band, see SW_RenderBand() */
+typedef struct
+{
+    SDL_Texture *texture;
+    SDL_Surface *surface;
+} SW_BandTexture;
+
+typedef struct
+{
+    SDL_Rect rect;
+    SW_BandTexture *textures;
+    int num_textures;
+    int max_textures;
+} SW_Band;
+
+typedef struct
+{
+    SDL_Renderer *renderer;
+    SDL_Surface *surface;
+    SDL_RenderCommand *cmd;
+    void *vertices;
+    SDL_AtomicInt failed;
+} SW_BandJob;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* With threaded presentation, window is one of the back buffers and the
+       presenter thread copies finished frames to the real window surface. */
+    SDL_bool threaded_present;
+    SDL_Window *present_window;
+    SDL_Surface *back_buffers[2];
+    int back_buffer;
+    SDL_Thread *present_thread;
+    SDL_Mutex *present_lock;
+    SDL_Condition *present_cond;
+    SDL_Surface *present_surface; /* the frame handed to the presenter thread, NULL when it's idle */
+    SDL_Surface *present_target;  /* the window surface it's copied to */
+    int present_result;
+    char *present_error;
+    SDL_bool present_quit;
 } SW_RenderData;
 
+static int SDLCALL SW_PresentThread(void *userdata)
+{
+    SW_RenderData *data = (SW_RenderData *)userdata;
+
+    SDL_LockMutex(data->present_lock);
+    for (;;) {
+        int result;
+
+        while (!data->present_surface && !data->present_quit) {
+            SDL_WaitCondition(data->present_cond, data->present_lock);
+        }
+        if (!data->present_surface) {
+            break;
+        }
+        SDL_UnlockMutex(data->present_lock);
+
+        if (SDL_BlitSurface(data->present_surface, NULL, data->present_target, NULL) < 0) {
+            result = -1;
+        } else {
+            result = SDL_UpdateWindowSurface(data->present_window);
+        }
+
+        SDL_LockMutex(data->present_lock);
+        data->present_result = result;
+        SDL_free(data->present_error);
+        data->present_error = (result < 0) ? SDL_strdup(SDL_GetError()) : NULL;
+        data->present_surface = NULL;
+        SDL_BroadcastCondition(data->present_cond);
+    }
+    SDL_UnlockMutex(data->present_lock);
+    return 0;
+}
+
+/* Wait for the presenter thread to finish the frame it's working on, and return its result */
+static int SW_WaitForPresent(SW_RenderData *data)
+{
+    int result;
+
+    if (!data->present_thread) {
+        return 0;
+    }
+
+    SDL_LockMutex(data->present_lock);
+    while (data->present_surface) {
+        SDL_WaitCondition(data->present_cond, data->present_lock);
+    }
+    result = data->present_result;
+    if (result < 0) {
+        SDL_SetError("%s", data->present_error ? data->present_error : "Couldn't present frame");
+    }
+    data->present_result = 0;
+    SDL_UnlockMutex(data->present_lock);
+    return result;
+}
+
+/* Get a back buffer matching the size and format of the window surface */
+static SDL_Surface *SW_GetBackBuffer(SW_RenderData *data, const SDL_Surface *window_surface, int index)
+{
+    SDL_Surface *surface = data->back_buffers[index];
+
+    if (!surface || surface->w != window_surface->w || surface->h != window_surface->h || surface->format != window_surface->format) {
+        SDL_DestroySurface(surface);
+        surface = SDL_CreateSurface(window_surface->w, window_surface->h, window_surface->format);
+        if (surface) {
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+        }
+        data->back_buffers[index] = surface;
+    }
+    return surface;
+}
+
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
 {
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
@@ -59,7 +171,15 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         data->surface = data->window;
     }
     if (!data->surface) {
-        SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
+        SDL_Surface *surface;
+
+        /* The presenter thread may still be using the old window surface */
+        SW_WaitForPresent(data);
+
+        surface = SDL_GetWindowSurface(renderer->window);
+        if (surface && data->threaded_present) {
+            surface = SW_GetBackBuffer(data, surface, data->back_buffer);
+        }
         if (surface) {
             data->surface = data->window = surface;
         }
@@ -99,6 +219,94 @@ static int SW_GetOutputSize(SDL_Renderer *renderer, int *w, int *h)
     return SDL_SetError("Software renderer doesn't have an output surface");
 }
 
+/* Mipmap levels are kept as the alternate images of the texture surface, each half the size of the previous one */
+static int SW_UpdateMipmaps(SDL_Surface *surface)
+{
+    SDL_Surface *prev = surface;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    int level = 0;
+    int retval = 0;
+
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+    SDL_GetSurfaceColorMod(surface, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(surface, &a);
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorMod(surface, 255, 255, 255);
+    SDL_SetSurfaceAlphaMod(surface, 255);
+
+    while (prev->w > 1 || prev->h > 1) {
+        SDL_Surface *mip;
+
+        if (level < surface->internal->num_images) {
+            mip = surface->internal->images[level];
+        } else {
+            mip = SDL_CreateSurface(SDL_max(prev->w / 2, 1), SDL_max(prev->h / 2, 1), surface->format);
+            if (!mip) {
+                retval = -1;
+                break;
+            }
+            SDL_SetSurfaceBlendMode(mip, SDL_BLENDMODE_NONE);
+            if (SDL_AddSurfaceAlternateImage(surface, mip) < 0) {
+                SDL_DestroySurface(mip);
+                retval = -1;
+                break;
+            }
+            SDL_DestroySurface(mip); /* the surface holds a reference now */
+        }
+
+        /* Exactly halving with bilinear filtering averages each 2x2 block of the previous level */
+        if (SDL_BlitSurfaceScaled(prev, NULL, mip, NULL, SDL_SCALEMODE_LINEAR) < 0) {
+            retval = -1;
+            break;
+        }
+        prev = mip;
+        ++level;
+    }
+
+    SDL_SetSurfaceBlendMode(surface, blendMode);
+    SDL_SetSurfaceColorMod(surface, r, g, b);
+    SDL_SetSurfaceAlphaMod(surface, a);
+    return retval;
+}
+
+/* Pick the smallest mipmap level that is still at least as large as the destination, adjusting srcrect to match */
+static SDL_Surface *SW_GetMipmapForCopy(SDL_Texture *texture, SDL_Rect *srcrect, const SDL_Rect *dstrect)
+{
+    SDL_Surface *surface = (SDL_Surface *)texture->internal;
+    SDL_Surface *mip;
+    Uint8 r, g, b, a;
+    SDL_BlendMode blendMode;
+    int level = 0;
+
+    if (!texture->mipmaps || texture->scaleMode == SDL_SCALEMODE_NEAREST) {
+        return surface;
+    }
+
+    while (level < surface->internal->num_images &&
+           (srcrect->w >> (level + 1)) >= dstrect->w &&
+           (srcrect->h >> (level + 1)) >= dstrect->h) {
+        ++level;
+    }
+    if (level == 0) {
+        return surface;
+    }
+
+    mip = surface->internal->images[level - 1];
+    srcrect->x >>= level;
+    srcrect->y >>= level;
+    srcrect->w = SDL_max(srcrect->w >> level, 1);
+    srcrect->h = SDL_max(srcrect->h >> level, 1);
+
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+    SDL_GetSurfaceColorMod(surface, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(surface, &a);
+    SDL_SetSurfaceBlendMode(mip, blendMode);
+    SDL_SetSurfaceColorMod(mip, r, g, b);
+    SDL_SetSurfaceAlphaMod(mip, a);
+    return mip;
+}
+
 static int SW_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     SDL_Surface *surface = SDL_CreateSurface(texture->w, texture->h, texture->format);
@@ -119,10 +327,13 @@ static int SW_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
     /* Only RLE encode textures without an alpha channel since the RLE coder
      * discards the color values of pixels with an alpha value of zero.
      */
-    if (texture->access == SDL_TEXTUREACCESS_STATIC && !SDL_ISPIXELFORMAT_ALPHA(surface->format)) {
+    if (texture->access == SDL_TEXTUREACCESS_STATIC && !SDL_ISPIXELFORMAT_ALPHA(surface->format) && !texture->mipmaps) {
         SDL_SetSurfaceRLE(surface, 1);
     }
 
+    if (texture->mipmaps) {
+        return SW_UpdateMipmaps(surface);
+    }
     return 0;
 }
 
@@ -152,6 +363,9 @@ static int SW_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
     if (SDL_MUSTLOCK(surface)) {
         SDL_UnlockSurface(surface);
     }
+    if (texture->mipmaps) {
+        return SW_UpdateMipmaps(surface);
+    }
     return 0;
 }
 
@@ -169,6 +383,9 @@ static int SW_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 
 static void SW_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    if (texture->mipmaps) {
+        SW_UpdateMipmaps((SDL_Surface *)texture->internal);
+    }
 }
 
 static void SW_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode)
@@ -179,6 +396,11 @@ static int SW_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
 
+    /* Only mipmapped textures have alternate images, update them now that we're done drawing */
+    if (data->surface != data->window && SDL_SurfaceHasAlternateImages(data->surface)) {
+        SW_UpdateMipmaps(data->surface);
+    }
+
     if (texture) {
         data->surface = (SDL_Surface *)texture->internal;
     } else {
@@ -620,15 +842,13 @@ static int SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     return 0;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate, SDL_Surface *surface)
 {
     const Uint8 r = drawstate->color.r;
     const Uint8 g = drawstate->color.g;
     const Uint8 b = drawstate->color.b;
     const Uint8 a = drawstate->color.a;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *)texture->internal;
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
     const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -650,17 +870,24 @@ static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
         const SDL_Rect *cliprect = drawstate->cliprect;
         SDL_assert_release(viewport != NULL); /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
 
+        SDL_Rect clip_rect;
+
         if (cliprect && viewport) {
-            SDL_Rect clip_rect;
             clip_rect.x = cliprect->x + viewport->x;
             clip_rect.y = cliprect->y + viewport->y;
             clip_rect.w = cliprect->w;
             clip_rect.h = cliprect->h;
             SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
-            SDL_SetSurfaceClipRect(surface, &clip_rect);
         } else {
-            SDL_SetSurfaceClipRect(surface, drawstate->viewport);
+            clip_rect = *viewport;
+        }
+        if (drawstate->band) {
+            /* Only draw within the band we're rendering */
+            if (!SDL_GetRectIntersection(drawstate->band, &clip_rect, &clip_rect)) {
+                clip_rect.w = clip_rect.h = 0;
+            }
         }
+        SDL_SetSurfaceClipRect(surface, &clip_rect);
         drawstate->surface_cliprect_dirty = SDL_FALSE;
     }
 }
@@ -671,15 +898,57 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
 }
 
 
-static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+/* Wrap a surface's pixels in a new surface, so each band has its own blit state */
+static SDL_Surface *SW_CreateBandSurface(SDL_Surface *surface)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    SDL_Surface *band_surface = SDL_CreateSurfaceFrom(surface->w, surface->h, surface->format, surface->pixels, surface->pitch);
+    if (!band_surface) {
+        return NULL;
+    }
 
-    if (!SDL_SurfaceValid(surface)) {
-        return -1;
+    band_surface->internal->colorspace = surface->internal->colorspace;
+    if (surface->internal->props) {
+        SDL_CopyProperties(surface->internal->props, SDL_GetSurfaceProperties(band_surface));
+    }
+    return band_surface;
+}
+
+static SDL_Surface *SW_GetBandTexture(SW_Band *band, SDL_Texture *texture)
+{
+    SDL_Surface *surface;
+    int i;
+
+    for (i = 0; i < band->num_textures; ++i) {
+        if (band->textures[i].texture == texture) {
+            return band->textures[i].surface;
+        }
     }
 
+    if (band->num_textures == band->max_textures) {
+        int max_textures = band->max_textures ? 2 * band->max_textures : 4;
+        SW_BandTexture *textures = (SW_BandTexture *)SDL_realloc(band->textures, max_textures * sizeof(*textures));
+        if (!textures) {
+            return NULL;
+        }
+        band->textures = textures;
+        band->max_textures = max_textures;
+    }
+
+    surface = SW_CreateBandSurface((SDL_Surface *)texture->internal);
+    if (!surface) {
+        return NULL;
+    }
+    band->textures[band->num_textures].texture = texture;
+    band->textures[band->num_textures].surface = surface;
+    ++band->num_textures;
+    return surface;
+}
+
+static int SW_RenderCommands(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, SW_Band *band)
+{
+    SW_DrawStateCache drawstate;
+
+    drawstate.band = band ? &band->rect : NULL;
     drawstate.viewport = NULL;
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = SDL_TRUE;
@@ -720,7 +989,7 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const Uint8 b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
             const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
             /* By definition the clear ignores the clip rect */
-            SDL_SetSurfaceClipRect(surface, NULL);
+            SDL_SetSurfaceClipRect(surface, band ? &band->rect : NULL);
             SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             drawstate.surface_cliprect_dirty = SDL_TRUE;
             break;
@@ -737,15 +1006,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const SDL_BlendMode blend = cmd->data.draw.blend;
             SetDrawState(surface, &drawstate);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             } else {
@@ -765,15 +1025,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const SDL_BlendMode blend = cmd->data.draw.blend;
             SetDrawState(surface, &drawstate);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             } else {
@@ -793,15 +1044,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             const SDL_BlendMode blend = cmd->data.draw.blend;
             SetDrawState(surface, &drawstate);
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             } else {
@@ -813,19 +1055,23 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         case SDL_RENDERCMD_COPY:
         {
             SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_Rect *srcrect = verts;
+            SDL_Rect *srcrect = verts;
             SDL_Rect *dstrect = verts + 1;
             SDL_Texture *texture = cmd->data.draw.texture;
-            SDL_Surface *src = (SDL_Surface *)texture->internal;
+            SDL_Surface *src;
 
             SetDrawState(surface, &drawstate);
 
-            PrepTextureForCopy(cmd, &drawstate);
-
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
+            if (band) {
+                /* Blit from a private copy of the texture header, other bands share the pixels */
+                src = SW_GetBandTexture(band, texture);
+                if (!src) {
+                    break;
+                }
+                PrepTextureForCopy(cmd, &drawstate, src);
+            } else {
+                PrepTextureForCopy(cmd, &drawstate, (SDL_Surface *)texture->internal);
+                src = SW_GetMipmapForCopy(texture, srcrect, dstrect);
             }
 
             if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
@@ -879,13 +1125,7 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         {
             CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
             SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd, &drawstate);
-
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
-            }
+            PrepTextureForCopy(cmd, &drawstate, (SDL_Surface *)cmd->data.draw.texture->internal);
 
             SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                             &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
@@ -908,19 +1148,7 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
 
                 GeometryCopyData *ptr = (GeometryCopyData *)verts;
 
-                PrepTextureForCopy(cmd, &drawstate);
-
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
+                PrepTextureForCopy(cmd, &drawstate, src);
 
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_BlitTriangle(
@@ -934,18 +1162,6 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             } else {
                 GeometryFillData *ptr = (GeometryFillData *)verts;
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
-
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                 }
@@ -963,6 +1179,209 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
     return 0;
 }
 
+/* Offset all the draw commands by their viewport, so they can be replayed once per band */
+static void SW_ApplyViewports(SDL_RenderCommand *cmd, void *vertices)
+{
+    const SDL_Rect *viewport = NULL;
+    int i;
+
+    for (; cmd; cmd = cmd->next) {
+        const int count = (int)cmd->data.draw.count;
+        void *verts;
+
+        if (cmd->command == SDL_RENDERCMD_SETVIEWPORT) {
+            viewport = &cmd->data.viewport.rect;
+            continue;
+        }
+        if (!viewport || (!viewport->x && !viewport->y)) {
+            continue;
+        }
+
+        verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+        switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        {
+            SDL_Point *points = (SDL_Point *)verts;
+            for (i = 0; i < count; i++) {
+                points[i].x += viewport->x;
+                points[i].y += viewport->y;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS:
+        {
+            SDL_Rect *rects = (SDL_Rect *)verts;
+            for (i = 0; i < count; i++) {
+                rects[i].x += viewport->x;
+                rects[i].y += viewport->y;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY:
+        {
+            SDL_Rect *dstrect = (SDL_Rect *)verts + 1;
+            dstrect->x += viewport->x;
+            dstrect->y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX:
+        {
+            CopyExData *copydata = (CopyExData *)verts;
+            copydata->dstrect.x += viewport->x;
+            copydata->dstrect.y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY:
+        {
+            SDL_Point vp;
+            vp.x = viewport->x;
+            vp.y = viewport->y;
+            trianglepoint_2_fixedpoint(&vp);
+            if (cmd->data.draw.texture) {
+                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            } else {
+                GeometryFillData *ptr = (GeometryFillData *)verts;
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+/* Splitting a command list into bands is only safe when every command
+ * produces exactly the same pixels when clipped to a band as it does when
+ * drawn in one pass, and touches nothing but its own part of the target.
+ *
+ * Lines are clipped by moving their endpoints, scaled copies round their
+ * source positions from the clipped destination, rotated copies go through
+ * temporary surfaces and textured geometry adjusts its texture coordinates
+ * in place, so those are all drawn serially.
+ */
+static SDL_bool SW_CanRenderInBands(SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    if (SDL_GetBlitThreadCount() <= 1) {
+        return SDL_FALSE;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(surface->format) || SDL_MUSTLOCK(surface) || !surface->pixels) {
+        return SDL_FALSE;
+    }
+
+    for (; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_CLEAR:
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_NO_OP:
+            break;
+
+        case SDL_RENDERCMD_COPY:
+        {
+            const SDL_Rect *verts = (const SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            const SDL_Rect *srcrect = verts;
+            const SDL_Rect *dstrect = verts + 1;
+            const SDL_Surface *src = (const SDL_Surface *)cmd->data.draw.texture->internal;
+
+            if (srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+                return SDL_FALSE;
+            }
+            if (!src->pixels || SDL_ISPIXELFORMAT_INDEXED(src->format) ||
+                (src->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL)) {
+                return SDL_FALSE;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY:
+            if (cmd->data.draw.texture) {
+                return SDL_FALSE;
+            }
+            break;
+
+        default:
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static void SW_RenderBand(void *userdata, int y0, int y1)
+{
+    SW_BandJob *job = (SW_BandJob *)userdata;
+    SDL_Surface *surface;
+    SW_Band band;
+    int i;
+
+    surface = SW_CreateBandSurface(job->surface);
+    if (!surface) {
+        SDL_AtomicSet(&job->failed, 1);
+        return;
+    }
+
+    band.rect.x = 0;
+    band.rect.y = y0;
+    band.rect.w = surface->w;
+    band.rect.h = y1 - y0;
+    band.textures = NULL;
+    band.num_textures = 0;
+    band.max_textures = 0;
+
+    SW_RenderCommands(job->renderer, surface, job->cmd, job->vertices, &band);
+
+    for (i = 0; i < band.num_textures; ++i) {
+        SDL_DestroySurface(band.textures[i].surface);
+    }
+    SDL_free(band.textures);
+    SDL_DestroySurface(surface);
+}
+
+static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+
+    if (!SDL_SurfaceValid(surface)) {
+        return -1;
+    }
+
+    SW_ApplyViewports(cmd, vertices);
+
+    if (SW_CanRenderInBands(surface, cmd, vertices)) {
+        SW_BandJob job;
+
+        job.renderer = renderer;
+        job.surface = surface;
+        job.cmd = cmd;
+        job.vertices = vertices;
+        SDL_AtomicSet(&job.failed, 0);
+        SDL_RunBlitBands(surface->w, surface->h, SW_RenderBand, &job);
+        if (SDL_AtomicGet(&job.failed)) {
+            return SDL_OutOfMemory();
+        }
+        return 0;
+    }
+
+    return SW_RenderCommands(renderer, surface, cmd, vertices, NULL);
+}
+
 static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
@@ -989,13 +1408,66 @@ static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
     return SDL_DuplicatePixels(rect->w, rect->h, surface->format, SDL_COLORSPACE_SRGB, pixels, surface->pitch);
 }
 
+static int SW_QueuePresent(SDL_Renderer *renderer)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    const SDL_bool drawing_to_window = (data->surface == data->window);
+    SDL_Surface *frame = SW_ActivateRenderer(renderer);
+    SDL_Surface *window_surface;
+    int result;
+
+    if (!frame) {
+        return -1;
+    }
+    if (!drawing_to_window) {
+        frame = data->window;
+    }
+
+    result = SW_WaitForPresent(data);
+
+    /* Only touch the window surface here, while the presenter thread is idle */
+    window_surface = SDL_GetWindowSurface(renderer->window);
+    if (!window_surface) {
+        return -1;
+    }
+    if (window_surface->w != frame->w || window_surface->h != frame->h) {
+        /* The window was resized after this frame was drawn, skip it */
+        data->window = NULL;
+        if (drawing_to_window) {
+            data->surface = NULL;
+        }
+        return result;
+    }
+
+    SDL_LockMutex(data->present_lock);
+    data->present_surface = frame;
+    data->present_target = window_surface;
+    SDL_SignalCondition(data->present_cond);
+    SDL_UnlockMutex(data->present_lock);
+
+    /* Render the next frame into the other back buffer while this one is presented */
+    data->back_buffer = !data->back_buffer;
+    data->window = SW_GetBackBuffer(data, window_surface, data->back_buffer);
+    if (drawing_to_window) {
+        data->surface = data->window;
+    }
+    if (!data->window) {
+        return -1;
+    }
+    return result;
+}
+
 static int SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Window *window = renderer->window;
 
     if (!window) {
         return -1;
     }
+    if (data->threaded_present) {
+        return SW_QueuePresent(renderer);
+    }
     return SDL_UpdateWindowSurface(window);
 }
 
@@ -1011,6 +1483,19 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     SDL_Window *window = renderer->window;
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
 
+    if (data->present_thread) {
+        SDL_LockMutex(data->present_lock);
+        data->present_quit = SDL_TRUE;
+        SDL_SignalCondition(data->present_cond);
+        SDL_UnlockMutex(data->present_lock);
+        SDL_WaitThread(data->present_thread, NULL);
+    }
+    SDL_DestroyCondition(data->present_cond);
+    SDL_DestroyMutex(data->present_lock);
+    SDL_free(data->present_error);
+    SDL_DestroySurface(data->back_buffers[0]);
+    SDL_DestroySurface(data->back_buffers[1]);
+
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
@@ -1137,6 +1622,8 @@ int SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, SD
     renderer->UnlockTexture = SW_UnlockTexture;
     renderer->SetTextureScaleMode = SW_SetTextureScaleMode;
     renderer->SetRenderTarget = SW_SetRenderTarget;
+    renderer->mipmaps_supported = SDL_TRUE;
+    renderer->persistent_lock_memory = SDL_TRUE;
     renderer->QueueSetViewport = SW_QueueNoOp;
     renderer->QueueSetDrawColor = SW_QueueNoOp;
     renderer->QueueDrawPoints = SW_QueueDrawPoints;
@@ -1192,7 +1679,30 @@ static int SW_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pro
         return -1;
     }
 
-    return SW_CreateRendererForSurface(renderer, surface, create_props);
+    if (SW_CreateRendererForSurface(renderer, surface, create_props) < 0) {
+        return -1;
+    }
+
+    if (SDL_GetBooleanProperty(create_props, SDL_PROP_RENDERER_CREATE_SOFTWARE_THREADED_PRESENT_BOOLEAN, SDL_FALSE)) {
+        SW_RenderData *data = (SW_RenderData *)renderer->internal;
+
+        data->present_window = window;
+        data->present_lock = SDL_CreateMutex();
+        data->present_cond = SDL_CreateCondition();
+        if (!data->present_lock || !data->present_cond) {
+            return -1;
+        }
+        data->surface = data->window = SW_GetBackBuffer(data, surface, 0);
+        if (!data->surface) {
+            return -1;
+        }
+        data->present_thread = SDL_CreateThread(SW_PresentThread, "SDLSWPresent", data);
+        if (!data->present_thread) {
+            return -1;
+        }
+        data->threaded_present = SDL_TRUE;
+    }
+    return 0;
 }
 
 SDL_RenderDriver SW_RenderDriver = {
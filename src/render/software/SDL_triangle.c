@@ -163,27 +163,148 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
 /* Triangle rendering, using Barycentric coordinates (w0, w1, w2)
  *
  * The cross product isn't computed from scratch at each iteration,
- * but optimized using constant step increments
+ * but optimized using constant step increments.
  *
+ * Each row is clipped to the span of pixels inside the triangle before
+ * it is drawn, and the colors and texture coordinates are interpolated
+ * incrementally along the span instead of dividing by the area at
+ * every pixel.
  */
 
-#define TRIANGLE_BEGIN_LOOP                                                        \
+/* Narrow [*x0, *x1) to the pixels where w + x * step >= 0 */
+static void triangle_clip_span(Sint64 w, int step, int *x0, int *x1)
+{
+    if (step > 0) {
+        if (w < 0) {
+            Sint64 x = (-w + step - 1) / step;
+            if (x > *x0) {
+                *x0 = (x < *x1) ? (int)x : *x1;
+            }
+        }
+    } else if (step < 0) {
+        if (w < 0) {
+            *x1 = *x0;
+        } else {
+            Sint64 x = w / -step + 1;
+            if (x < *x1) {
+                *x1 = (int)x;
+            }
+        }
+    } else if (w < 0) {
+        *x1 = *x0;
+    }
+}
+
+/* n / d, rounded down */
+static Sint64 triangle_floor_div(Sint64 n, Sint64 d)
+{
+    Sint64 q = n / d;
+    if (n % d != 0 && n < 0) {
+        --q;
+    }
+    return q;
+}
+
+/* The value of (w0 * k0 + w1 * k1 + w2 * k2 + k) / area, stepped one pixel at a time.
+ * The quotient and remainder are tracked separately so the result is exactly the same
+ * as doing the division at every pixel.
+ */
+typedef struct
+{
+    Sint64 k0, k1, k2, k;
+    Sint64 quot, rem;
+    Sint64 dquot, drem;
+} TriangleInterp;
+
+enum
+{
+    TRIANGLE_INTERP_R,
+    TRIANGLE_INTERP_G,
+    TRIANGLE_INTERP_B,
+    TRIANGLE_INTERP_A,
+    TRIANGLE_INTERP_U,
+    TRIANGLE_INTERP_V,
+    TRIANGLE_INTERP_COUNT
+};
+
+static void TriangleInterp_Setup(TriangleInterp *interp, Sint64 k0, Sint64 k1, Sint64 k2, Sint64 k,
+                                 int step_w0, int step_w1, int step_w2, Sint64 area)
+{
+    const Sint64 dn = step_w0 * k0 + step_w1 * k1 + step_w2 * k2;
+
+    interp->k0 = k0;
+    interp->k1 = k1;
+    interp->k2 = k2;
+    interp->k = k;
+    interp->dquot = triangle_floor_div(dn, area);
+    interp->drem = dn - interp->dquot * area;
+}
+
+static void TriangleInterp_Start(TriangleInterp *interp, Sint64 w0, Sint64 w1, Sint64 w2, Sint64 area)
+{
+    const Sint64 n = w0 * interp->k0 + w1 * interp->k1 + w2 * interp->k2 + interp->k;
+
+    interp->quot = triangle_floor_div(n, area);
+    interp->rem = n - interp->quot * area;
+}
+
+/* Returns the value at the current pixel and moves on to the next one */
+SDL_FORCE_INLINE Sint64 TriangleInterp_Next(TriangleInterp *interp, Sint64 area)
+{
+    Sint64 value = interp->quot;
+
+    /* round towards zero, like the division this replaces */
+    if (value < 0 && interp->rem != 0) {
+        ++value;
+    }
+
+    interp->quot += interp->dquot;
+    interp->rem += interp->drem;
+    if (interp->rem >= area) {
+        interp->rem -= area;
+        ++interp->quot;
+    }
+    return value;
+}
+
+#define TRIANGLE_BEGIN_SPANS                                                       \
     {                                                                              \
-        int x, y;                                                                  \
+        int y;                                                                     \
         for (y = 0; y < dstrect.h; y++) {                                          \
-            /* y start */                                                          \
-            Sint64 w0 = w0_row;                                                    \
-            Sint64 w1 = w1_row;                                                    \
-            Sint64 w2 = w2_row;                                                    \
-            for (x = 0; x < dstrect.w; x++) {                                      \
-                /* In triangle */                                                  \
-                if (w0 + bias_w0 >= 0 && w1 + bias_w1 >= 0 && w2 + bias_w2 >= 0) { \
-                    Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
+            int x0 = 0, x1 = dstrect.w;                                            \
+            triangle_clip_span((Sint64)w0_row + bias_w0, d2d1_y, &x0, &x1);        \
+            triangle_clip_span((Sint64)w1_row + bias_w1, d0d2_y, &x0, &x1);        \
+            triangle_clip_span((Sint64)w2_row + bias_w2, d1d0_y, &x0, &x1);        \
+            if (x0 < x1) {
+
+#define TRIANGLE_END_SPANS \
+    }                      \
+    /* y += 1 */           \
+    w0_row += d1d2_x;      \
+    w1_row += d2d0_x;      \
+    w2_row += d0d1_x;      \
+    dst_ptr += dst_pitch;  \
+    }                      \
+    }
+
+#define TRIANGLE_BEGIN_LOOP                                                        \
+    TRIANGLE_BEGIN_SPANS                                                           \
+    {                                                                              \
+        int x, i;                                                                  \
+        /* x start */                                                              \
+        const Sint64 w0 = w0_row + (Sint64)x0 * d2d1_y;                            \
+        const Sint64 w1 = w1_row + (Sint64)x0 * d0d2_y;                            \
+        const Sint64 w2 = w2_row + (Sint64)x0 * d1d0_y;                            \
+        for (i = interp_first; i < interp_last; i++) {                             \
+            TriangleInterp_Start(&interps[i], w0, w1, w2, area);                   \
+        }                                                                          \
+        for (x = x0; x < x1; x++) {                                                \
+            Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
 
 /* Use 64 bits precision to prevent overflow when interpolating color / texture with wide triangles */
 #define TRIANGLE_GET_TEXTCOORD                                                          \
-    int srcx = (int)(((Sint64)w0 * s2s0_x + (Sint64)w1 * s2s1_x + s2_x_area.x) / area); \
-    int srcy = (int)(((Sint64)w0 * s2s0_y + (Sint64)w1 * s2s1_y + s2_x_area.y) / area); \
+    int srcx = (int)TriangleInterp_Next(&interps[TRIANGLE_INTERP_U], area);             \
+    int srcy = (int)TriangleInterp_Next(&interps[TRIANGLE_INTERP_V], area);             \
     if (texture_address_mode == SDL_TEXTURE_ADDRESS_WRAP) {                             \
         srcx %= src_surface->w;                                                         \
         if (srcx < 0) {                                                                 \
@@ -196,32 +317,42 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     }
 
 #define TRIANGLE_GET_MAPPED_COLOR                                                      \
-    Uint8 r = (Uint8)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    Uint8 g = (Uint8)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    Uint8 b = (Uint8)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    Uint8 a = (Uint8)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area); \
+    Uint8 r = (Uint8)TriangleInterp_Next(&interps[TRIANGLE_INTERP_R], area);           \
+    Uint8 g = (Uint8)TriangleInterp_Next(&interps[TRIANGLE_INTERP_G], area);           \
+    Uint8 b = (Uint8)TriangleInterp_Next(&interps[TRIANGLE_INTERP_B], area);           \
+    Uint8 a = (Uint8)TriangleInterp_Next(&interps[TRIANGLE_INTERP_A], area);           \
     Uint32 color = SDL_MapRGBA(format, palette, r, g, b, a);
 
 #define TRIANGLE_GET_COLOR                                                             \
-    int r = (int)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    int g = (int)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    int b = (int)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    int a = (int)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area);
+    int r = (int)TriangleInterp_Next(&interps[TRIANGLE_INTERP_R], area);               \
+    int g = (int)TriangleInterp_Next(&interps[TRIANGLE_INTERP_G], area);               \
+    int b = (int)TriangleInterp_Next(&interps[TRIANGLE_INTERP_B], area);               \
+    int a = (int)TriangleInterp_Next(&interps[TRIANGLE_INTERP_A], area);
 
 #define TRIANGLE_END_LOOP \
     }                     \
-    /* x += 1 */          \
-    w0 += d2d1_y;         \
-    w1 += d0d2_y;         \
-    w2 += d1d0_y;         \
     }                     \
-    /* y += 1 */          \
-    w0_row += d1d2_x;     \
-    w1_row += d2d0_x;     \
-    w2_row += d0d1_x;     \
-    dst_ptr += dst_pitch; \
-    }                     \
-    }
+    TRIANGLE_END_SPANS
+
+/* Set up the color interpolation for the TRIANGLE_GET_*COLOR macros */
+#define TRIANGLE_SETUP_COLORS                                                                                 \
+    TriangleInterp_Setup(&interps[TRIANGLE_INTERP_R], c0.r, c1.r, c2.r, 0, d2d1_y, d0d2_y, d1d0_y, area); \
+    TriangleInterp_Setup(&interps[TRIANGLE_INTERP_G], c0.g, c1.g, c2.g, 0, d2d1_y, d0d2_y, d1d0_y, area); \
+    TriangleInterp_Setup(&interps[TRIANGLE_INTERP_B], c0.b, c1.b, c2.b, 0, d2d1_y, d0d2_y, d1d0_y, area); \
+    TriangleInterp_Setup(&interps[TRIANGLE_INTERP_A], c0.a, c1.a, c2.a, 0, d2d1_y, d0d2_y, d1d0_y, area);
+
+/* Set up the texture coordinate interpolation for the TRIANGLE_GET_TEXTCOORD macro */
+#define TRIANGLE_SETUP_TEXTCOORDS                                                                                     \
+    TriangleInterp_Setup(&interps[TRIANGLE_INTERP_U], s2s0_x, s2s1_x, 0, s2_x_area.x, d2d1_y, d0d2_y, d1d0_y, area); \
+    TriangleInterp_Setup(&interps[TRIANGLE_INTERP_V], s2s0_y, s2s1_y, 0, s2_x_area.y, d2d1_y, d0d2_y, d1d0_y, area);
+
+/* 32-bit formats with 8-bit channels, which can be packed and unpacked with plain shifts */
+static SDL_bool is_8888_format(const SDL_PixelFormatDetails *pf)
+{
+    return pf->bytes_per_pixel == 4 &&
+           pf->Rbits == 8 && pf->Gbits == 8 && pf->Bbits == 8 &&
+           (pf->Abits == 8 || pf->Abits == 0);
+}
 
 int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
@@ -243,6 +374,9 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
 
     SDL_bool is_uniform;
 
+    TriangleInterp interps[TRIANGLE_INTERP_COUNT];
+    int interp_first = 0, interp_last = 0;
+
     SDL_Surface *tmp = NULL;
 
     if (!SDL_SurfaceValid(dst)) {
@@ -375,11 +509,11 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
         }
 
         if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPANS
             {
-                *(Uint32 *)dptr = color;
+                SDL_memset4(dst_ptr + x0 * 4, color, x1 - x0);
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPANS
         } else if (dstbpp == 3) {
             TRIANGLE_BEGIN_LOOP
             {
@@ -396,15 +530,19 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
             }
             TRIANGLE_END_LOOP
         } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPANS
             {
-                *dptr = (Uint8)color;
+                SDL_memset(dst_ptr + x0, (Uint8)color, x1 - x0);
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPANS
         }
     } else {
         const SDL_PixelFormatDetails *format;
         SDL_Palette *palette;
+
+        TRIANGLE_SETUP_COLORS
+        interp_first = TRIANGLE_INTERP_R;
+        interp_last = TRIANGLE_INTERP_A + 1;
         if (tmp) {
             format = tmp->internal->format;
             palette = tmp->internal->palette;
@@ -412,7 +550,19 @@ int SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poin
             format = dst->internal->format;
             palette = dst->internal->palette;
         }
-        if (dstbpp == 4) {
+        if (is_8888_format(format)) {
+            const Uint32 Rshift = format->Rshift;
+            const Uint32 Gshift = format->Gshift;
+            const Uint32 Bshift = format->Bshift;
+            const Uint32 Ashift = format->Ashift;
+            const Uint32 Amask = format->Amask;
+            TRIANGLE_BEGIN_LOOP
+            {
+                TRIANGLE_GET_COLOR
+                *(Uint32 *)dptr = ((Uint32)r << Rshift) | ((Uint32)g << Gshift) | ((Uint32)b << Bshift) | (((Uint32)a << Ashift) & Amask);
+            }
+            TRIANGLE_END_LOOP
+        } else if (dstbpp == 4) {
             TRIANGLE_BEGIN_LOOP
             {
                 TRIANGLE_GET_MAPPED_COLOR
@@ -498,6 +648,9 @@ int SDL_SW_BlitTriangle(
 
     SDL_bool has_modulation;
 
+    TriangleInterp interps[TRIANGLE_INTERP_COUNT];
+    int interp_first = TRIANGLE_INTERP_U, interp_last = TRIANGLE_INTERP_V + 1;
+
     if (!SDL_SurfaceValid(src)) {
         return SDL_InvalidParamError("src");
     }
@@ -659,6 +812,8 @@ int SDL_SW_BlitTriangle(
         goto end;
     }
 
+    TRIANGLE_SETUP_TEXTCOORDS
+
     if (blend != SDL_BLENDMODE_NONE || src->format != dst->format || has_modulation || !is_uniform) {
         /* Use SDL_BlitTriangle_Slow */
 
@@ -812,16 +967,41 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
     Uint8 *dst_ptr = info->dst;
     int dst_pitch = info->dst_pitch;
 
+    TriangleInterp interps[TRIANGLE_INTERP_COUNT];
+    int interp_first = TRIANGLE_INTERP_U, interp_last = TRIANGLE_INTERP_V + 1;
+
+    const SDL_bool src_8888 = is_8888_format(src_fmt);
+    const SDL_bool dst_8888 = is_8888_format(dst_fmt);
+
     srcfmt_val = detect_format(src_fmt);
     dstfmt_val = detect_format(dst_fmt);
 
+    TRIANGLE_SETUP_TEXTCOORDS
+    if (!is_uniform) {
+        TRIANGLE_SETUP_COLORS
+        interp_first = TRIANGLE_INTERP_R;
+    }
+
     TRIANGLE_BEGIN_LOOP
     {
         Uint8 *src;
         Uint8 *dst = dptr;
         TRIANGLE_GET_TEXTCOORD
+        if (!is_uniform) {
+            TRIANGLE_GET_COLOR
+            modulateR = r;
+            modulateG = g;
+            modulateB = b;
+            modulateA = a;
+        }
         src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
-        if (FORMAT_HAS_ALPHA(srcfmt_val)) {
+        if (src_8888) {
+            srcpixel = *((Uint32 *)(src));
+            srcR = (srcpixel >> src_fmt->Rshift) & 0xFF;
+            srcG = (srcpixel >> src_fmt->Gshift) & 0xFF;
+            srcB = (srcpixel >> src_fmt->Bshift) & 0xFF;
+            srcA = src_fmt->Amask ? ((srcpixel >> src_fmt->Ashift) & 0xFF) : 0xFF;
+        } else if (FORMAT_HAS_ALPHA(srcfmt_val)) {
             DISEMBLE_RGBA(src, srcbpp, src_fmt, srcpixel, srcR, srcG, srcB, srcA);
         } else if (FORMAT_HAS_NO_ALPHA(srcfmt_val)) {
             DISEMBLE_RGB(src, srcbpp, src_fmt, srcpixel, srcR, srcG, srcB);
@@ -842,7 +1022,13 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
             }
         }
         if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
-            if (FORMAT_HAS_ALPHA(dstfmt_val)) {
+            if (dst_8888) {
+                dstpixel = *((Uint32 *)(dst));
+                dstR = (dstpixel >> dst_fmt->Rshift) & 0xFF;
+                dstG = (dstpixel >> dst_fmt->Gshift) & 0xFF;
+                dstB = (dstpixel >> dst_fmt->Bshift) & 0xFF;
+                dstA = dst_fmt->Amask ? ((dstpixel >> dst_fmt->Ashift) & 0xFF) : 0xFF;
+            } else if (FORMAT_HAS_ALPHA(dstfmt_val)) {
                 DISEMBLE_RGBA(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG, dstB, dstA);
             } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
                 DISEMBLE_RGB(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG, dstB);
@@ -857,14 +1043,6 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
             dstR = dstG = dstB = dstA = 0;
         }
 
-        if (!is_uniform) {
-            TRIANGLE_GET_COLOR
-            modulateR = r;
-            modulateG = g;
-            modulateB = b;
-            modulateA = a;
-        }
-
         if (flags & SDL_COPY_MODULATE_COLOR) {
             srcR = (srcR * modulateR) / 255;
             srcG = (srcG * modulateG) / 255;
@@ -928,7 +1106,13 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
             }
             break;
         }
-        if (FORMAT_HAS_ALPHA(dstfmt_val)) {
+        if (dst_8888) {
+            dstpixel = (dstR << dst_fmt->Rshift) | (dstG << dst_fmt->Gshift) | (dstB << dst_fmt->Bshift);
+            if (dst_fmt->Amask) {
+                dstpixel |= (dstA << dst_fmt->Ashift);
+            }
+            *(Uint32 *)dst = dstpixel;
+        } else if (FORMAT_HAS_ALPHA(dstfmt_val)) {
             ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, dstR, dstG, dstB, dstA);
         } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
             ASSEMBLE_RGB(dst, dstbpp, dst_fmt, dstR, dstG, dstB);
@@ -23,11 +23,14 @@
 #if SDL_VIDEO_RENDER_VULKAN
 
 #define SDL_VULKAN_FRAME_QUEUE_DEPTH            2
+#define SDL_VULKAN_MAX_FRAMES_IN_FLIGHT         8
 #define SDL_VULKAN_NUM_VERTEX_BUFFERS           256
 #define SDL_VULKAN_VERTEX_BUFFER_DEFAULT_SIZE   65536
 #define SDL_VULKAN_CONSTANT_BUFFER_DEFAULT_SIZE 65536
 #define SDL_VULKAN_NUM_UPLOAD_BUFFERS           32
+#define SDL_VULKAN_NUM_READBACK_BUFFERS         4
 #define SDL_VULKAN_MAX_DESCRIPTOR_SETS          4096
+#define SDL_VULKAN_MEMORY_BLOCK_SIZE            (32 * 1024 * 1024)
 
 #define SDL_VULKAN_VALIDATION_LAYER_NAME        "VK_LAYER_KHRONOS_validation"
 
@@ -37,6 +40,7 @@
 #include "../SDL_sysrender.h"
 #include "../SDL_d3dmath.h"
 #include "../../video/SDL_pixels_c.h"
+#include "../../SDL_hashtable.h"
 #include "SDL_shaders_vulkan.h"
 
 extern const char *SDL_Vulkan_GetResultString(VkResult result);
@@ -71,6 +75,7 @@ extern const char *SDL_Vulkan_GetResultString(VkResult result);
     VULKAN_DEVICE_FUNCTION(vkCreateGraphicsPipelines)                   \
     VULKAN_DEVICE_FUNCTION(vkCreateImage)                               \
     VULKAN_DEVICE_FUNCTION(vkCreateImageView)                           \
+    VULKAN_DEVICE_FUNCTION(vkCreatePipelineCache)                       \
     VULKAN_DEVICE_FUNCTION(vkCreatePipelineLayout)                      \
     VULKAN_DEVICE_FUNCTION(vkCreateRenderPass)                          \
     VULKAN_DEVICE_FUNCTION(vkCreateSampler)                             \
@@ -87,6 +92,7 @@ extern const char *SDL_Vulkan_GetResultString(VkResult result);
     VULKAN_DEVICE_FUNCTION(vkDestroyImage)                              \
     VULKAN_DEVICE_FUNCTION(vkDestroyImageView)                          \
     VULKAN_DEVICE_FUNCTION(vkDestroyPipeline)                           \
+    VULKAN_DEVICE_FUNCTION(vkDestroyPipelineCache)                      \
     VULKAN_DEVICE_FUNCTION(vkDestroyPipelineLayout)                     \
     VULKAN_DEVICE_FUNCTION(vkDestroyRenderPass)                         \
     VULKAN_DEVICE_FUNCTION(vkDestroySampler)                            \
@@ -101,6 +107,7 @@ extern const char *SDL_Vulkan_GetResultString(VkResult result);
     VULKAN_DEVICE_FUNCTION(vkGetImageMemoryRequirements)                \
     VULKAN_DEVICE_FUNCTION(vkGetDeviceQueue)                            \
     VULKAN_DEVICE_FUNCTION(vkGetFenceStatus)                            \
+    VULKAN_DEVICE_FUNCTION(vkGetPipelineCacheData)                      \
     VULKAN_DEVICE_FUNCTION(vkGetSwapchainImagesKHR)                     \
     VULKAN_DEVICE_FUNCTION(vkMapMemory)                                 \
     VULKAN_DEVICE_FUNCTION(vkQueuePresentKHR)                           \
@@ -215,29 +222,71 @@ typedef struct
     SDL_FColor color;
 } VertexPositionColor;
 
-/* Vulkan Buffer */
+/* A free range within a memory block */
+typedef struct
+{
+    VkDeviceSize offset;
+    VkDeviceSize size;
+} VULKAN_MemoryRange;
+
+/* A large VkDeviceMemory allocation that buffers or images are placed in */
+typedef struct VULKAN_MemoryBlock
+{
+    VkDeviceMemory deviceMemory;
+    VkDeviceSize size;
+    VkDeviceSize used;
+    uint32_t memoryTypeIndex;
+    SDL_bool optimal;           /* holds optimal tiling images, kept apart from buffers for bufferImageGranularity */
+    void *mappedPtr;            /* host visible blocks stay mapped for their whole lifetime */
+    int allocationCount;
+    VULKAN_MemoryRange *freeRanges; /* sorted by offset, with neighbouring ranges always merged */
+    int freeRangeCount;
+    int freeRangeCapacity;
+    struct VULKAN_MemoryBlock *next;
+} VULKAN_MemoryBlock;
+
+/* Memory bound to a buffer or image */
 typedef struct
 {
     VkDeviceMemory deviceMemory;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    void *mappedPtr;
+    VULKAN_MemoryBlock *block;  /* NULL for a dedicated allocation */
+} VULKAN_Allocation;
+
+/* Vulkan Buffer */
+typedef struct
+{
+    VULKAN_Allocation allocation;
     VkBuffer buffer;
     VkDeviceSize size;
     void *mappedBufferPtr;
 
 } VULKAN_Buffer;
 
+/* An asynchronous read, done once the submission it was recorded in has completed */
+typedef struct
+{
+    VULKAN_Buffer buffer;
+    Uint64 serial;
+    VkFormat format;
+    SDL_Colorspace colorspace;
+} VULKAN_ReadPixels;
+
 /* Vulkan image */
 typedef struct
 {
     SDL_bool allocatedImage;
     VkImage image;
     VkImageView imageView;
-    VkDeviceMemory deviceMemory;
+    VULKAN_Allocation allocation;
     VkImageLayout imageLayout;
     VkFormat format;
 } VULKAN_Image;
 
 /* Per-texture data */
-typedef struct
+typedef struct VULKAN_TextureData
 {
     VULKAN_Image mainImage;
     VkRenderPass mainRenderpasses[SDL_VULKAN_NUM_RENDERPASSES];
@@ -258,6 +307,8 @@ typedef struct
     /* Pipeline layout with immutable sampler descriptor set layout */
     VkPipelineLayout pipelineLayoutYcbcr;
 
+    /* Next texture waiting for the GPU to finish with it before it's freed */
+    struct VULKAN_TextureData *nextToDestroy;
 } VULKAN_TextureData;
 
 /* Pipeline State Object data */
@@ -278,6 +329,31 @@ typedef struct
     VkBuffer vertexBuffer;
 } VULKAN_DrawStateCache;
 
+/* Everything that goes into a descriptor set, the constant buffer offset is dynamic */
+typedef struct
+{
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkSampler sampler;
+    VkImageView imageView;
+    VkBuffer constantBuffer;
+} VULKAN_DescriptorSetKey;
+
+typedef struct
+{
+    VULKAN_DescriptorSetKey key;
+    VkDescriptorSet descriptorSet;
+} VULKAN_CachedDescriptorSet;
+
+/* The descriptor sets of a frame in flight. They are kept across frames and only thrown away, along with
+   the pools they came from, when a texture is destroyed since a set may refer to its image view. */
+typedef struct
+{
+    SDL_HashTable *sets;
+    uint32_t poolIndex;
+    uint32_t setIndex;
+    SDL_bool invalid;
+} VULKAN_DescriptorSetCache;
+
 /* Private renderer data */
 typedef struct
 {
@@ -306,6 +382,8 @@ typedef struct
     VkSurfaceFormatKHR *surfaceFormats;
     SDL_bool recreateSwapchain;
     int vsync;
+    SDL_bool hasRequestedPresentMode;
+    VkPresentModeKHR requestedPresentMode;
 
     VkFramebuffer *framebuffers;
     VkRenderPass renderPasses[SDL_VULKAN_NUM_RENDERPASSES];
@@ -317,7 +395,7 @@ typedef struct
     VkPipelineLayout pipelineLayout;
 
     /* Vertex buffer data */
-    VULKAN_Buffer vertexBuffers[SDL_VULKAN_NUM_VERTEX_BUFFERS];
+    VULKAN_Buffer (*vertexBuffers)[SDL_VULKAN_NUM_VERTEX_BUFFERS];  /* per frame in flight */
     VertexShaderConstants vertexShaderConstantsData;
 
     /* Data for staging/allocating textures */
@@ -333,12 +411,22 @@ typedef struct
     VkSampler samplers[SDL_VULKAN_NUM_SAMPLERS];
     VkDescriptorPool **descriptorPools;
     uint32_t *numDescriptorPools;
-    uint32_t currentDescriptorPoolIndex;
-    uint32_t currentDescriptorSetIndex;
+    VULKAN_DescriptorSetCache *descriptorSetCaches;
+    VkDescriptorSet currentDescriptorSet;
+    uint32_t currentDescriptorSetOffset;
+    VkPipelineLayout currentDescriptorSetPipelineLayout;
 
     int pipelineStateCount;
     VULKAN_PipelineState *pipelineStates;
     VULKAN_PipelineState *currentPipelineState;
+    VkPipelineCache pipelineCache;
+    char *pipelineCacheFile;
+
+    /* Device memory sub-allocation */
+    VULKAN_MemoryBlock *memoryBlocks;
+    Uint64 memoryReserved;
+    Uint64 memoryUsed;
+    int memoryAllocationCount;
 
     SDL_bool supportsEXTSwapchainColorspace;
     SDL_bool supportsKHRGetPhysicalDeviceProperties2;
@@ -357,6 +445,20 @@ typedef struct
     VkSemaphore currentImageAvailableSemaphore;
     uint32_t currentSwapchainImageIndex;
 
+    /* Command buffers, fences, descriptor pools, upload, vertex and constant buffers are per frame in flight */
+    uint32_t requestedFramesInFlight;
+    uint32_t framesInFlight;
+    VULKAN_TextureData **texturesToDestroy;
+
+    /* Submission counts, so we know when asynchronous reads have finished */
+    Uint64 submitSerial;
+    Uint64 completedSerial;
+    Uint64 frameSerials[SDL_VULKAN_MAX_FRAMES_IN_FLIGHT];
+
+    /* Staging buffers left over from asynchronous reads, kept for reuse */
+    VULKAN_Buffer readbackBuffers[SDL_VULKAN_NUM_READBACK_BUFFERS];
+    int numReadbackBuffers;
+
     VkPipelineStageFlags *waitDestStageMasks;
     VkSemaphore *waitRenderSemaphores;
     uint32_t waitRenderSemaphoreCount;
@@ -383,6 +485,7 @@ static SDL_PixelFormat VULKAN_VkFormatToSDLPixelFormat(VkFormat vkFormat)
 {
     switch (vkFormat) {
     case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
         return SDL_PIXELFORMAT_ARGB8888;
     case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
         return SDL_PIXELFORMAT_XBGR2101010;
@@ -393,6 +496,17 @@ static SDL_PixelFormat VULKAN_VkFormatToSDLPixelFormat(VkFormat vkFormat)
     }
 }
 
+static SDL_bool VULKAN_VkFormatIsSRGB(VkFormat vkFormat)
+{
+    switch (vkFormat) {
+    case VK_FORMAT_B8G8R8A8_SRGB:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
 static int VULKAN_VkFormatGetNumPlanes(VkFormat vkFormat)
 {
     switch (vkFormat) {
@@ -426,6 +540,21 @@ static VkDeviceSize VULKAN_GetBytesPerPixel(VkFormat vkFormat)
     }
 }
 
+/* Bytes per texel of a single plane of a multi-planar format */
+static VkDeviceSize VULKAN_GetPlaneBytesPerPixel(VkFormat vkFormat, int plane)
+{
+    switch (vkFormat) {
+    case VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM:
+        return 1;
+    case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
+        return (plane == 0) ? 1 : 2;
+    case VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16:
+        return (plane == 0) ? 2 : 4;
+    default:
+        return VULKAN_GetBytesPerPixel(vkFormat);
+    }
+}
+
 static VkFormat SDLPixelFormatToVkTextureFormat(Uint32 format, Uint32 colorspace)
 {
     switch (format) {
@@ -458,11 +587,15 @@ static VkFormat SDLPixelFormatToVkTextureFormat(Uint32 format, Uint32 colorspace
 
 static void VULKAN_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture);
 static void VULKAN_DestroyBuffer(VULKAN_RenderData *rendererData, VULKAN_Buffer *vulkanBuffer);
+static void VULKAN_DestroyMemoryBlock(VULKAN_RenderData *rendererData, VULKAN_MemoryBlock *block);
 static void VULKAN_DestroyImage(VULKAN_RenderData *rendererData, VULKAN_Image *vulkanImage);
 static void VULKAN_ResetCommandList(VULKAN_RenderData *rendererData);
+static void VULKAN_DestroyPendingTextures(VULKAN_RenderData *rendererData, uint32_t frame);
 static SDL_bool VULKAN_FindMemoryTypeIndex(VULKAN_RenderData *rendererData, uint32_t typeBits, VkMemoryPropertyFlags requiredFlags, VkMemoryPropertyFlags desiredFlags, uint32_t *memoryTypeIndexOut);
 static VkResult VULKAN_CreateWindowSizeDependentResources(SDL_Renderer *renderer);
 static VkDescriptorPool VULKAN_AllocateDescriptorPool(VULKAN_RenderData *rendererData);
+static VkResult VULKAN_CreateDescriptorSetCaches(VULKAN_RenderData *rendererData);
+static void VULKAN_DestroyDescriptorSetCaches(VULKAN_RenderData *rendererData);
 static VkResult VULKAN_CreateDescriptorSetAndPipelineLayout(VULKAN_RenderData *rendererData, VkSampler samplerYcbcr, VkDescriptorSetLayout *descriptorSetLayoutOut, VkPipelineLayout *pipelineLayoutOut);
 
 static void VULKAN_DestroyAll(SDL_Renderer *renderer)
@@ -501,7 +634,7 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         rendererData->swapchain = VK_NULL_HANDLE;
     }
     if (rendererData->fences != NULL) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
             if (rendererData->fences[i] != VK_NULL_HANDLE) {
                 vkDestroyFence(rendererData->device, rendererData->fences[i], NULL);
                 rendererData->fences[i] = VK_NULL_HANDLE;
@@ -538,10 +671,15 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
             rendererData->samplers[i] = VK_NULL_HANDLE;
         }
     }
-    for (uint32_t i = 0; i < SDL_arraysize(rendererData->vertexBuffers); i++ ) {
-        VULKAN_DestroyBuffer(rendererData, &rendererData->vertexBuffers[i]);
+    if (rendererData->vertexBuffers) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
+            for (uint32_t j = 0; j < SDL_VULKAN_NUM_VERTEX_BUFFERS; j++) {
+                VULKAN_DestroyBuffer(rendererData, &rendererData->vertexBuffers[i][j]);
+            }
+        }
+        SDL_free(rendererData->vertexBuffers);
+        rendererData->vertexBuffers = NULL;
     }
-    SDL_memset(rendererData->vertexBuffers, 0, sizeof(rendererData->vertexBuffers));
     for (uint32_t i = 0; i < SDL_VULKAN_NUM_RENDERPASSES; i++) {
         if (rendererData->renderPasses[i] != VK_NULL_HANDLE) {
             vkDestroyRenderPass(rendererData->device, rendererData->renderPasses[i], NULL);
@@ -549,7 +687,7 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         }
     }
     if (rendererData->imageAvailableSemaphores) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             if (rendererData->imageAvailableSemaphores[i] != VK_NULL_HANDLE) {
                 vkDestroySemaphore(rendererData->device, rendererData->imageAvailableSemaphores[i], NULL);
             }
@@ -558,7 +696,7 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         rendererData->imageAvailableSemaphores = NULL;
     }
     if (rendererData->renderingFinishedSemaphores) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             if (rendererData->renderingFinishedSemaphores[i] != VK_NULL_HANDLE) {
                 vkDestroySemaphore(rendererData->device, rendererData->renderingFinishedSemaphores[i], NULL);
             }
@@ -568,16 +706,17 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
     }
     if (rendererData->commandPool) {
         if (rendererData->commandBuffers) {
-            vkFreeCommandBuffers(rendererData->device, rendererData->commandPool, rendererData->swapchainImageCount, rendererData->commandBuffers);
+            vkFreeCommandBuffers(rendererData->device, rendererData->commandPool, rendererData->framesInFlight, rendererData->commandBuffers);
             SDL_free(rendererData->commandBuffers);
             rendererData->commandBuffers = NULL;
         }
         vkDestroyCommandPool(rendererData->device, rendererData->commandPool, NULL);
         rendererData->commandPool = VK_NULL_HANDLE;
     }
+    VULKAN_DestroyDescriptorSetCaches(rendererData);
     if (rendererData->descriptorPools) {
         SDL_assert(rendererData->numDescriptorPools);
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
             for (uint32_t j = 0; j < rendererData->numDescriptorPools[i]; j++) {
                 if (rendererData->descriptorPools[i][j] != VK_NULL_HANDLE) {
                     vkDestroyDescriptorPool(rendererData->device, rendererData->descriptorPools[i][j], NULL);
@@ -611,9 +750,15 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
     }
     SDL_free(rendererData->pipelineStates);
     rendererData->pipelineStateCount = 0;
+    if (rendererData->pipelineCache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(rendererData->device, rendererData->pipelineCache, NULL);
+        rendererData->pipelineCache = VK_NULL_HANDLE;
+    }
+    SDL_free(rendererData->pipelineCacheFile);
+    rendererData->pipelineCacheFile = NULL;
 
     if (rendererData->currentUploadBuffer) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             for (int j = 0; j < rendererData->currentUploadBuffer[i]; ++j) {
                 VULKAN_DestroyBuffer(rendererData, &rendererData->uploadBuffers[i][j]);
             }
@@ -625,7 +770,7 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
 
     if (rendererData->constantBuffers) {
         SDL_assert(rendererData->numConstantBuffers);
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             for (uint32_t j = 0; j < rendererData->numConstantBuffers[i]; j++) {
                 VULKAN_DestroyBuffer(rendererData, &rendererData->constantBuffers[i][j]);
             }
@@ -636,6 +781,18 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         rendererData->constantBuffers = NULL;
     }
 
+    SDL_free(rendererData->texturesToDestroy);
+    rendererData->texturesToDestroy = NULL;
+
+    for (int i = 0; i < rendererData->numReadbackBuffers; ++i) {
+        VULKAN_DestroyBuffer(rendererData, &rendererData->readbackBuffers[i]);
+    }
+    rendererData->numReadbackBuffers = 0;
+
+    while (rendererData->memoryBlocks) {
+        VULKAN_DestroyMemoryBlock(rendererData, rendererData->memoryBlocks);
+    }
+
     if (rendererData->device != VK_NULL_HANDLE && !rendererData->device_external) {
         vkDestroyDevice(rendererData->device, NULL);
         rendererData->device = VK_NULL_HANDLE;
@@ -650,16 +807,295 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
     }
 }
 
+static VkDeviceSize VULKAN_GetMemoryBlockSize(VULKAN_RenderData *rendererData, uint32_t memoryTypeIndex)
+{
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = &rendererData->physicalDeviceMemoryProperties;
+    const VkDeviceSize heapSize = memoryProperties->memoryHeaps[memoryProperties->memoryTypes[memoryTypeIndex].heapIndex].size;
+
+    /* Keep blocks small on small heaps, like host visible VRAM without resizable BAR */
+    return SDL_min(SDL_VULKAN_MEMORY_BLOCK_SIZE, heapSize / 8);
+}
+
+static VkResult VULKAN_AllocateDeviceMemory(VULKAN_RenderData *rendererData, VkDeviceSize size, uint32_t memoryTypeIndex, VkDeviceMemory *memoryOut, void **mappedOut)
+{
+    VkMemoryAllocateInfo memoryAllocateInfo = { 0 };
+    VkResult result;
+
+    *mappedOut = NULL;
+
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.allocationSize = size;
+    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+    result = vkAllocateMemory(rendererData->device, &memoryAllocateInfo, NULL, memoryOut);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkAllocateMemory(): %s\n", SDL_Vulkan_GetResultString(result));
+        return result;
+    }
+
+    if (rendererData->physicalDeviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        result = vkMapMemory(rendererData->device, *memoryOut, 0, VK_WHOLE_SIZE, 0, mappedOut);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkMapMemory(): %s\n", SDL_Vulkan_GetResultString(result));
+            vkFreeMemory(rendererData->device, *memoryOut, NULL);
+            *memoryOut = VK_NULL_HANDLE;
+            return result;
+        }
+    }
+
+    rendererData->memoryReserved += size;
+    ++rendererData->memoryAllocationCount;
+    return VK_SUCCESS;
+}
+
+static void VULKAN_FreeDeviceMemory(VULKAN_RenderData *rendererData, VkDeviceMemory memory, VkDeviceSize size)
+{
+    /* Freeing the memory also unmaps it */
+    vkFreeMemory(rendererData->device, memory, NULL);
+    rendererData->memoryReserved -= size;
+    --rendererData->memoryAllocationCount;
+}
+
+static void VULKAN_DestroyMemoryBlock(VULKAN_RenderData *rendererData, VULKAN_MemoryBlock *block)
+{
+    VULKAN_MemoryBlock **prev;
+
+    for (prev = &rendererData->memoryBlocks; *prev; prev = &(*prev)->next) {
+        if (*prev == block) {
+            *prev = block->next;
+            break;
+        }
+    }
+    VULKAN_FreeDeviceMemory(rendererData, block->deviceMemory, block->size);
+    SDL_free(block->freeRanges);
+    SDL_free(block);
+}
+
+static VULKAN_MemoryBlock *VULKAN_CreateMemoryBlock(VULKAN_RenderData *rendererData, uint32_t memoryTypeIndex, SDL_bool optimal)
+{
+    VULKAN_MemoryBlock *block = (VULKAN_MemoryBlock *)SDL_calloc(1, sizeof(*block));
+    if (!block) {
+        return NULL;
+    }
+
+    block->size = VULKAN_GetMemoryBlockSize(rendererData, memoryTypeIndex);
+    block->memoryTypeIndex = memoryTypeIndex;
+    block->optimal = optimal;
+    block->freeRangeCapacity = 4;
+    block->freeRanges = (VULKAN_MemoryRange *)SDL_malloc(block->freeRangeCapacity * sizeof(*block->freeRanges));
+    if (!block->freeRanges) {
+        SDL_free(block);
+        return NULL;
+    }
+    block->freeRanges[0].offset = 0;
+    block->freeRanges[0].size = block->size;
+    block->freeRangeCount = 1;
+
+    if (VULKAN_AllocateDeviceMemory(rendererData, block->size, memoryTypeIndex, &block->deviceMemory, &block->mappedPtr) != VK_SUCCESS) {
+        SDL_free(block->freeRanges);
+        SDL_free(block);
+        return NULL;
+    }
+
+    block->next = rendererData->memoryBlocks;
+    rendererData->memoryBlocks = block;
+    return block;
+}
+
+/* Carve an aligned range out of the first free range big enough for it */
+static SDL_bool VULKAN_SubAllocateMemory(VULKAN_MemoryBlock *block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize *offsetOut)
+{
+    int i;
+
+    /* Free ranges are always separated by allocations, so there are at most allocationCount + 1 of them.
+       Reserving that much here means freeing never has to allocate. */
+    if (block->freeRangeCapacity < block->allocationCount + 2) {
+        int capacity = block->freeRangeCapacity * 2;
+        VULKAN_MemoryRange *ranges = (VULKAN_MemoryRange *)SDL_realloc(block->freeRanges, capacity * sizeof(*ranges));
+        if (!ranges) {
+            return SDL_FALSE;
+        }
+        block->freeRanges = ranges;
+        block->freeRangeCapacity = capacity;
+    }
+
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    for (i = 0; i < block->freeRangeCount; ++i) {
+        VULKAN_MemoryRange *range = &block->freeRanges[i];
+        const VkDeviceSize rangeEnd = range->offset + range->size;
+        const VkDeviceSize start = (range->offset + alignment - 1) & ~(alignment - 1);
+        const VkDeviceSize end = start + size;
+
+        if (end > rangeEnd) {
+            continue;
+        }
+
+        if (start > range->offset && end < rangeEnd) {
+            /* Split the range around the allocation */
+            SDL_memmove(&block->freeRanges[i + 2], &block->freeRanges[i + 1], (block->freeRangeCount - i - 1) * sizeof(*range));
+            range->size = start - range->offset;
+            block->freeRanges[i + 1].offset = end;
+            block->freeRanges[i + 1].size = rangeEnd - end;
+            ++block->freeRangeCount;
+        } else if (start > range->offset) {
+            range->size = start - range->offset;
+        } else if (end < rangeEnd) {
+            range->offset = end;
+            range->size = rangeEnd - end;
+        } else {
+            SDL_memmove(&block->freeRanges[i], &block->freeRanges[i + 1], (block->freeRangeCount - i - 1) * sizeof(*range));
+            --block->freeRangeCount;
+        }
+        *offsetOut = start;
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+static void VULKAN_SubFreeMemory(VULKAN_MemoryBlock *block, VkDeviceSize offset, VkDeviceSize size)
+{
+    VULKAN_MemoryRange *ranges = block->freeRanges;
+    int i;
+
+    for (i = 0; i < block->freeRangeCount; ++i) {
+        if (ranges[i].offset > offset) {
+            break;
+        }
+    }
+
+    const SDL_bool mergePrev = (i > 0 && ranges[i - 1].offset + ranges[i - 1].size == offset);
+    const SDL_bool mergeNext = (i < block->freeRangeCount && offset + size == ranges[i].offset);
+    if (mergePrev && mergeNext) {
+        ranges[i - 1].size += size + ranges[i].size;
+        SDL_memmove(&ranges[i], &ranges[i + 1], (block->freeRangeCount - i - 1) * sizeof(*ranges));
+        --block->freeRangeCount;
+    } else if (mergePrev) {
+        ranges[i - 1].size += size;
+    } else if (mergeNext) {
+        ranges[i].offset = offset;
+        ranges[i].size += size;
+    } else {
+        SDL_assert(block->freeRangeCount < block->freeRangeCapacity);
+        SDL_memmove(&ranges[i + 1], &ranges[i], (block->freeRangeCount - i) * sizeof(*ranges));
+        ranges[i].offset = offset;
+        ranges[i].size = size;
+        ++block->freeRangeCount;
+    }
+}
+
+static VkResult VULKAN_AllocateMemory(VULKAN_RenderData *rendererData, const VkMemoryRequirements *memoryRequirements, uint32_t memoryTypeIndex, SDL_bool optimal, VULKAN_Allocation *allocationOut)
+{
+    VULKAN_MemoryBlock *block;
+    VkDeviceSize offset = 0;
+
+    SDL_zerop(allocationOut);
+
+    /* Big images get memory of their own, sharing a block with them would waste most of it */
+    if (memoryRequirements->size > VULKAN_GetMemoryBlockSize(rendererData, memoryTypeIndex) / 2) {
+        VkResult result = VULKAN_AllocateDeviceMemory(rendererData, memoryRequirements->size, memoryTypeIndex, &allocationOut->deviceMemory, &allocationOut->mappedPtr);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        allocationOut->size = memoryRequirements->size;
+        rendererData->memoryUsed += allocationOut->size;
+        return VK_SUCCESS;
+    }
+
+    for (block = rendererData->memoryBlocks; block; block = block->next) {
+        if (block->memoryTypeIndex == memoryTypeIndex && block->optimal == optimal &&
+            block->size - block->used >= memoryRequirements->size &&
+            VULKAN_SubAllocateMemory(block, memoryRequirements->size, memoryRequirements->alignment, &offset)) {
+            break;
+        }
+    }
+    if (!block) {
+        block = VULKAN_CreateMemoryBlock(rendererData, memoryTypeIndex, optimal);
+        if (!block) {
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+        if (!VULKAN_SubAllocateMemory(block, memoryRequirements->size, memoryRequirements->alignment, &offset)) {
+            VULKAN_DestroyMemoryBlock(rendererData, block);
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    ++block->allocationCount;
+    block->used += memoryRequirements->size;
+    rendererData->memoryUsed += memoryRequirements->size;
+
+    allocationOut->deviceMemory = block->deviceMemory;
+    allocationOut->offset = offset;
+    allocationOut->size = memoryRequirements->size;
+    allocationOut->mappedPtr = block->mappedPtr ? (Uint8 *)block->mappedPtr + offset : NULL;
+    allocationOut->block = block;
+    return VK_SUCCESS;
+}
+
+static void VULKAN_FreeMemory(VULKAN_RenderData *rendererData, VULKAN_Allocation *allocation)
+{
+    VULKAN_MemoryBlock *block = allocation->block;
+
+    if (allocation->deviceMemory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    rendererData->memoryUsed -= allocation->size;
+    if (!block) {
+        VULKAN_FreeDeviceMemory(rendererData, allocation->deviceMemory, allocation->size);
+    } else {
+        VULKAN_SubFreeMemory(block, allocation->offset, allocation->size);
+        block->used -= allocation->size;
+        --block->allocationCount;
+
+        if (block->allocationCount == 0) {
+            /* Keep one empty block of each kind around, so buffers that come and go every frame don't thrash */
+            VULKAN_MemoryBlock *other;
+            for (other = rendererData->memoryBlocks; other; other = other->next) {
+                if (other != block && other->allocationCount == 0 &&
+                    other->memoryTypeIndex == block->memoryTypeIndex && other->optimal == block->optimal) {
+                    VULKAN_DestroyMemoryBlock(rendererData, block);
+                    break;
+                }
+            }
+        }
+    }
+    SDL_zerop(allocation);
+}
+
+static void VULKAN_UpdateMemoryProperties(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    VkDeviceSize totalFree = 0, largestFree = 0;
+    VULKAN_MemoryBlock *block;
+    Sint64 fragmentation = 0;
+    int i;
+
+    for (block = rendererData->memoryBlocks; block; block = block->next) {
+        for (i = 0; i < block->freeRangeCount; ++i) {
+            totalFree += block->freeRanges[i].size;
+            largestFree = SDL_max(largestFree, block->freeRanges[i].size);
+        }
+    }
+    if (totalFree > 0) {
+        fragmentation = (Sint64)(100 - (largestFree * 100) / totalFree);
+    }
+
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_VULKAN_MEMORY_RESERVED_NUMBER, (Sint64)rendererData->memoryReserved);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_VULKAN_MEMORY_USED_NUMBER, (Sint64)rendererData->memoryUsed);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_VULKAN_MEMORY_ALLOCATION_COUNT_NUMBER, rendererData->memoryAllocationCount);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_VULKAN_MEMORY_FRAGMENTATION_NUMBER, fragmentation);
+}
+
 static void VULKAN_DestroyBuffer(VULKAN_RenderData *rendererData, VULKAN_Buffer *vulkanBuffer)
 {
     if (vulkanBuffer->buffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(rendererData->device, vulkanBuffer->buffer, NULL);
         vulkanBuffer->buffer = VK_NULL_HANDLE;
     }
-    if (vulkanBuffer->deviceMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(rendererData->device, vulkanBuffer->deviceMemory, NULL);
-        vulkanBuffer->deviceMemory = VK_NULL_HANDLE;
-    }
+    VULKAN_FreeMemory(rendererData, &vulkanBuffer->allocation);
     SDL_memset(vulkanBuffer, 0, sizeof(VULKAN_Buffer));
 }
 
@@ -691,28 +1127,24 @@ static VkResult VULKAN_AllocateBuffer(VULKAN_RenderData *rendererData, VkDeviceS
         return VK_ERROR_UNKNOWN;;
     }
 
-    VkMemoryAllocateInfo memoryAllocateInfo = { 0 };
-    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    memoryAllocateInfo.allocationSize = memoryRequirements.size;
-    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
-    result = vkAllocateMemory(rendererData->device, &memoryAllocateInfo, NULL, &bufferOut->deviceMemory);
+    result = VULKAN_AllocateMemory(rendererData, &memoryRequirements, memoryTypeIndex, SDL_FALSE, &bufferOut->allocation);
     if (result != VK_SUCCESS) {
         VULKAN_DestroyBuffer(rendererData, bufferOut);
-        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkAllocateMemory(): %s\n", SDL_Vulkan_GetResultString(result));
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "VULKAN_AllocateMemory(): %s\n", SDL_Vulkan_GetResultString(result));
         return result;
     }
-    result = vkBindBufferMemory(rendererData->device, bufferOut->buffer, bufferOut->deviceMemory, 0);
+    result = vkBindBufferMemory(rendererData->device, bufferOut->buffer, bufferOut->allocation.deviceMemory, bufferOut->allocation.offset);
     if (result != VK_SUCCESS) {
         VULKAN_DestroyBuffer(rendererData, bufferOut);
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkBindBufferMemory(): %s\n", SDL_Vulkan_GetResultString(result));
         return result;
     }
 
-    result = vkMapMemory(rendererData->device, bufferOut->deviceMemory, 0, size, 0, &bufferOut->mappedBufferPtr);
-    if (result != VK_SUCCESS) {
+    bufferOut->mappedBufferPtr = bufferOut->allocation.mappedPtr;
+    if (!bufferOut->mappedBufferPtr) {
         VULKAN_DestroyBuffer(rendererData, bufferOut);
-        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkMapMemory(): %s\n", SDL_Vulkan_GetResultString(result));
-        return result;
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Buffer memory isn't host visible\n");
+        return VK_ERROR_MEMORY_MAP_FAILED;
     }
     bufferOut->size = size;
     return result;
@@ -731,11 +1163,8 @@ static void VULKAN_DestroyImage(VULKAN_RenderData *rendererData, VULKAN_Image *v
         vulkanImage->image = VK_NULL_HANDLE;
     }
 
-    if (vulkanImage->deviceMemory != VK_NULL_HANDLE) {
-        if (vulkanImage->allocatedImage) {
-            vkFreeMemory(rendererData->device, vulkanImage->deviceMemory, NULL);
-        }
-        vulkanImage->deviceMemory = VK_NULL_HANDLE;
+    if (vulkanImage->allocatedImage) {
+        VULKAN_FreeMemory(rendererData, &vulkanImage->allocation);
     }
     SDL_memset(vulkanImage, 0, sizeof(VULKAN_Image));
 }
@@ -791,17 +1220,13 @@ static VkResult VULKAN_AllocateImage(VULKAN_RenderData *rendererData, SDL_Proper
             return VK_ERROR_UNKNOWN;
         }
 
-        VkMemoryAllocateInfo memoryAllocateInfo = { 0 };
-        memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        memoryAllocateInfo.allocationSize = memoryRequirements.size;
-        memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
-        result = vkAllocateMemory(rendererData->device, &memoryAllocateInfo, NULL, &imageOut->deviceMemory);
+        result = VULKAN_AllocateMemory(rendererData, &memoryRequirements, memoryTypeIndex, SDL_TRUE, &imageOut->allocation);
         if (result != VK_SUCCESS) {
             VULKAN_DestroyImage(rendererData, imageOut);
-            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkAllocateMemory(): %s\n", SDL_Vulkan_GetResultString(result));
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "VULKAN_AllocateMemory(): %s\n", SDL_Vulkan_GetResultString(result));
             return result;
         }
-        result = vkBindImageMemory(rendererData->device, imageOut->image, imageOut->deviceMemory, 0);
+        result = vkBindImageMemory(rendererData->device, imageOut->image, imageOut->allocation.deviceMemory, imageOut->allocation.offset);
         if (result != VK_SUCCESS) {
             VULKAN_DestroyImage(rendererData, imageOut);
             SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkBindImageMemory(): %s\n", SDL_Vulkan_GetResultString(result));
@@ -953,7 +1378,7 @@ static void VULKAN_EnsureCommandBuffer(VULKAN_RenderData *rendererData)
                 rendererData->swapchainImages[rendererData->currentSwapchainImageIndex],
                 &rendererData->swapchainImageLayouts[rendererData->currentSwapchainImageIndex]);
         }
-        else if (rendererData->swapchainImageLayouts[rendererData->currentCommandBufferIndex] != VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
+        else if (rendererData->swapchainImageLayouts[rendererData->currentSwapchainImageIndex] != VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
             VULKAN_RecordPipelineImageBarrier(rendererData,
                 VK_ACCESS_COLOR_ATTACHMENT_READ_BIT,
                 VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
@@ -992,15 +1417,15 @@ static SDL_bool VULKAN_ActivateCommandBuffer(SDL_Renderer *renderer, VkAttachmen
 static void VULKAN_WaitForGPU(VULKAN_RenderData *rendererData)
 {
     vkQueueWaitIdle(rendererData->graphicsQueue);
+    rendererData->completedSerial = rendererData->submitSerial;
 }
 
 
 static void VULKAN_ResetCommandList(VULKAN_RenderData *rendererData)
 {
+    VULKAN_DescriptorSetCache *descriptorSetCache = &rendererData->descriptorSetCaches[rendererData->currentCommandBufferIndex];
+
     vkResetCommandBuffer(rendererData->currentCommandBuffer, 0);
-    for (uint32_t i = 0; i < rendererData->numDescriptorPools[rendererData->currentCommandBufferIndex]; i++) {
-        vkResetDescriptorPool(rendererData->device, rendererData->descriptorPools[rendererData->currentCommandBufferIndex][i], 0);
-    }
 
     VkCommandBufferBeginInfo beginInfo = { 0 };
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -1011,16 +1436,29 @@ static void VULKAN_ResetCommandList(VULKAN_RenderData *rendererData)
     rendererData->currentVertexBuffer = 0;
     rendererData->issueBatch = SDL_FALSE;
     rendererData->cliprectDirty = SDL_TRUE;
-    rendererData->currentDescriptorSetIndex = 0;
-    rendererData->currentDescriptorPoolIndex = 0;
+    rendererData->currentDescriptorSet = VK_NULL_HANDLE;
+    rendererData->currentDescriptorSetPipelineLayout = VK_NULL_HANDLE;
     rendererData->currentConstantBufferOffset = -1;
     rendererData->currentConstantBufferIndex = 0;
 
-    /* Release any upload buffers that were inflight */
+    /* Release any textures and upload buffers that were inflight */
+    VULKAN_DestroyPendingTextures(rendererData, rendererData->currentCommandBufferIndex);
     for (int i = 0; i < rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex]; ++i) {
         VULKAN_DestroyBuffer(rendererData, &rendererData->uploadBuffers[rendererData->currentCommandBufferIndex][i]);
     }
     rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex] = 0;
+
+    /* Destroying textures above may have left descriptor sets pointing at them. This frame's
+       work is done, so the sets can be thrown away now. */
+    if (descriptorSetCache->invalid) {
+        for (uint32_t i = 0; i < rendererData->numDescriptorPools[rendererData->currentCommandBufferIndex]; i++) {
+            vkResetDescriptorPool(rendererData->device, rendererData->descriptorPools[rendererData->currentCommandBufferIndex][i], 0);
+        }
+        SDL_EmptyHashTable(descriptorSetCache->sets);
+        descriptorSetCache->poolIndex = 0;
+        descriptorSetCache->setIndex = 0;
+        descriptorSetCache->invalid = SDL_FALSE;
+    }
 }
 
 static VkResult VULKAN_IssueBatch(VULKAN_RenderData *rendererData)
@@ -1063,6 +1501,7 @@ static VkResult VULKAN_IssueBatch(VULKAN_RenderData *rendererData)
 
     result = vkQueueSubmit(rendererData->graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
     rendererData->currentImageAvailableSemaphore = VK_NULL_HANDLE;
+    ++rendererData->submitSerial;
 
     VULKAN_WaitForGPU(rendererData);
 
@@ -1071,12 +1510,52 @@ static VkResult VULKAN_IssueBatch(VULKAN_RenderData *rendererData)
     return result;
 }
 
+static void VULKAN_SavePipelineCache(VULKAN_RenderData *rendererData)
+{
+    SDL_IOStream *io;
+    size_t size = 0;
+    void *data;
+    VkResult result;
+
+    if (rendererData->pipelineCache == VK_NULL_HANDLE || !rendererData->pipelineCacheFile) {
+        return;
+    }
+
+    result = vkGetPipelineCacheData(rendererData->device, rendererData->pipelineCache, &size, NULL);
+    if (result != VK_SUCCESS || size == 0) {
+        return;
+    }
+    data = SDL_malloc(size);
+    if (!data) {
+        return;
+    }
+    result = vkGetPipelineCacheData(rendererData->device, rendererData->pipelineCache, &size, data);
+    if (result == VK_SUCCESS) {
+        io = SDL_IOFromFile(rendererData->pipelineCacheFile, "wb");
+        if (io) {
+            if (SDL_WriteIO(io, data, size) != size) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Couldn't write pipeline cache %s: %s", rendererData->pipelineCacheFile, SDL_GetError());
+            }
+            SDL_CloseIO(io);
+        }
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkGetPipelineCacheData(): %s\n", SDL_Vulkan_GetResultString(result));
+    }
+    SDL_free(data);
+}
+
 static void VULKAN_DestroyRenderer(SDL_Renderer *renderer)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     if (rendererData) {
         if (rendererData->device != VK_NULL_HANDLE) {
             vkDeviceWaitIdle(rendererData->device);
+            if (rendererData->texturesToDestroy) {
+                for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
+                    VULKAN_DestroyPendingTextures(rendererData, i);
+                }
+            }
+            VULKAN_SavePipelineCache(rendererData);
             VULKAN_DestroyAll(renderer);
         }
         SDL_free(rendererData);
@@ -1131,7 +1610,7 @@ static VkBlendOp GetBlendOp(SDL_BlendOperation operation)
 
 
 static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
-    VULKAN_Shader shader, VkPipelineLayout pipelineLayout, VkDescriptorSetLayout descriptorSetLayout, SDL_BlendMode blendMode, VkPrimitiveTopology topology, VkFormat format)
+    VULKAN_Shader shader, VkPipelineLayout pipelineLayout, VkDescriptorSetLayout descriptorSetLayout, SDL_BlendMode blendMode, VkPrimitiveTopology topology, VkFormat format, VkRenderPass renderPass)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     VULKAN_PipelineState *pipelineStates;
@@ -1254,11 +1733,11 @@ static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
 
     /* Renderpass / layout */
-    pipelineCreateInfo.renderPass = rendererData->currentRenderPass;
+    pipelineCreateInfo.renderPass = renderPass;
     pipelineCreateInfo.subpass = 0;
     pipelineCreateInfo.layout = pipelineLayout;
 
-    result = vkCreateGraphicsPipelines(rendererData->device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, NULL, &pipeline);
+    result = vkCreateGraphicsPipelines(rendererData->device, rendererData->pipelineCache, 1, &pipelineCreateInfo, NULL, &pipeline);
     if (result != VK_SUCCESS) {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkCreateGraphicsPipelines(): %s\n", SDL_Vulkan_GetResultString(result));
         return NULL;
@@ -1278,6 +1757,105 @@ static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
     return &pipelineStates[rendererData->pipelineStateCount - 1];
 }
 
+static SDL_bool VULKAN_IsPipelineCacheCompatible(VULKAN_RenderData *rendererData, const void *data, size_t size)
+{
+    const VkPhysicalDeviceProperties *properties = &rendererData->physicalDeviceProperties;
+    VkPipelineCacheHeaderVersionOne header;
+
+    /* Drivers are supposed to reject data from another device, but some don't, so check the header ourselves */
+    if (size < sizeof(header)) {
+        return SDL_FALSE;
+    }
+    SDL_memcpy(&header, data, sizeof(header));
+    if (header.headerSize < sizeof(header) || header.headerSize > size ||
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header.vendorID != properties->vendorID ||
+        header.deviceID != properties->deviceID ||
+        SDL_memcmp(header.pipelineCacheUUID, properties->pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static void VULKAN_CreatePipelineCache(VULKAN_RenderData *rendererData, const char *file)
+{
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo = { 0 };
+    void *data = NULL;
+    size_t size = 0;
+    VkResult result;
+
+    if (file) {
+        rendererData->pipelineCacheFile = SDL_strdup(file);
+        data = SDL_LoadFile(file, &size);
+        if (data && !VULKAN_IsPipelineCacheCompatible(rendererData, data, size)) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Ignoring pipeline cache %s from a different device or driver", file);
+            SDL_free(data);
+            data = NULL;
+            size = 0;
+        }
+    }
+
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize = size;
+    pipelineCacheCreateInfo.pInitialData = data;
+    result = vkCreatePipelineCache(rendererData->device, &pipelineCacheCreateInfo, NULL, &rendererData->pipelineCache);
+    if (result != VK_SUCCESS && data) {
+        /* Try again without the old data */
+        pipelineCacheCreateInfo.initialDataSize = 0;
+        pipelineCacheCreateInfo.pInitialData = NULL;
+        result = vkCreatePipelineCache(rendererData->device, &pipelineCacheCreateInfo, NULL, &rendererData->pipelineCache);
+    }
+    if (result != VK_SUCCESS) {
+        /* Pipelines still work without a cache, they're just slower to create */
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkCreatePipelineCache(): %s\n", SDL_Vulkan_GetResultString(result));
+        rendererData->pipelineCache = VK_NULL_HANDLE;
+    }
+    SDL_free(data);
+}
+
+/* Create the pipeline states for the standard blend modes up front, so the first frames don't stall creating them */
+static void VULKAN_PrewarmPipelineStates(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    static const SDL_BlendMode defaultBlendModes[] = {
+        SDL_BLENDMODE_NONE,
+        SDL_BLENDMODE_BLEND,
+        SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+        SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_ADD_PREMULTIPLIED,
+        SDL_BLENDMODE_MOD,
+        SDL_BLENDMODE_MUL
+    };
+    static const VkPrimitiveTopology topologies[] = {
+        VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+        VK_PRIMITIVE_TOPOLOGY_LINE_STRIP,
+        VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST
+    };
+    const VkFormat format = rendererData->surfaceFormat.format;
+    /* The load and clear render passes are compatible, so pipelines made with one work with both */
+    const VkRenderPass renderPass = rendererData->renderPasses[SDL_VULKAN_RENDERPASS_LOAD];
+    int i, j, k;
+
+    if (renderPass == VK_NULL_HANDLE) {
+        return;
+    }
+
+    for (i = 0; i < NUM_SHADERS; ++i) {
+        for (j = 0; j < SDL_arraysize(defaultBlendModes); ++j) {
+            for (k = 0; k < SDL_arraysize(topologies); ++k) {
+                /* Only solid primitives are drawn as points and lines */
+                if (i != SHADER_SOLID && topologies[k] != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST) {
+                    continue;
+                }
+                if (!VULKAN_CreatePipelineState(renderer, (VULKAN_Shader)i, rendererData->pipelineLayout, rendererData->descriptorSetLayout,
+                                                defaultBlendModes[j], topologies[k], format, renderPass)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
 static SDL_bool VULKAN_FindMemoryTypeIndex(VULKAN_RenderData *rendererData, uint32_t typeBits, VkMemoryPropertyFlags requiredFlags, VkMemoryPropertyFlags desiredFlags, uint32_t *memoryTypeIndexOut)
 {
     uint32_t memoryTypeIndex = 0;
@@ -1316,14 +1894,16 @@ static VkResult VULKAN_CreateVertexBuffer(VULKAN_RenderData *rendererData, size_
 {
     VkResult result;
 
-    VULKAN_DestroyBuffer(rendererData, &rendererData->vertexBuffers[vbidx]);
+    VULKAN_Buffer *vertexBuffer = &rendererData->vertexBuffers[rendererData->currentCommandBufferIndex][vbidx];
+
+    VULKAN_DestroyBuffer(rendererData, vertexBuffer);
 
     result = VULKAN_AllocateBuffer(rendererData, size,
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        &rendererData->vertexBuffers[vbidx]);
+        vertexBuffer);
     if (result != VK_SUCCESS) {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "VULKAN_AllocateBuffer(): %s\n", SDL_Vulkan_GetResultString(result));
         return result;
@@ -1710,12 +2290,15 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         return VK_ERROR_UNKNOWN;
     }
 
-    /* Check for colorspace extension */
+    /* Check for colorspace extension
+     * Linear output can fall back to an sRGB swapchain, which the hardware encodes for us
+     */
     rendererData->supportsEXTSwapchainColorspace = VK_FALSE;
     if (renderer->output_colorspace == SDL_COLORSPACE_SRGB_LINEAR ||
         renderer->output_colorspace == SDL_COLORSPACE_HDR10) {
         rendererData->supportsEXTSwapchainColorspace = VULKAN_InstanceExtensionFound(rendererData, VK_EXT_SWAPCHAIN_COLOR_SPACE_EXTENSION_NAME);
-        if (!rendererData->supportsEXTSwapchainColorspace) {
+        if (!rendererData->supportsEXTSwapchainColorspace &&
+            renderer->output_colorspace == SDL_COLORSPACE_HDR10) {
             SDL_SetError("[Vulkan] Using HDR output but %s not supported", VK_EXT_SWAPCHAIN_COLOR_SPACE_EXTENSION_NAME);
             return VK_ERROR_UNKNOWN;
         }
@@ -1783,6 +2366,7 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
     /* Choose Vulkan physical device */
     rendererData->physicalDevice = (VkPhysicalDevice)SDL_GetPointerProperty(create_props, SDL_PROP_RENDERER_CREATE_VULKAN_PHYSICAL_DEVICE_POINTER, NULL);
     if (rendererData->physicalDevice) {
+        vkGetPhysicalDeviceProperties(rendererData->physicalDevice, &rendererData->physicalDeviceProperties);
         vkGetPhysicalDeviceMemoryProperties(rendererData->physicalDevice, &rendererData->physicalDeviceMemoryProperties);
         vkGetPhysicalDeviceFeatures(rendererData->physicalDevice, &rendererData->physicalDeviceFeatures);
     } else {
@@ -1863,6 +2447,9 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         rendererData->presentQueue = rendererData->graphicsQueue;
     }
 
+    /* Create the pipeline cache, seeded from disk if we have a cache file */
+    VULKAN_CreatePipelineCache(rendererData, SDL_GetStringProperty(create_props, SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_FILE_STRING, NULL));
+
     /* Create command pool/command buffers */
     VkCommandPoolCreateInfo commandPoolCreateInfo = { 0 };
     commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -1909,11 +2496,6 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         return result;
     }
 
-    /* Create default vertex buffers  */
-    for (uint32_t i = 0; i < SDL_VULKAN_NUM_VERTEX_BUFFERS; ++i) {
-        VULKAN_CreateVertexBuffer(rendererData, i, SDL_VULKAN_VERTEX_BUFFER_DEFAULT_SIZE);
-    }
-
     /* Create samplers */
     {
         static struct
@@ -2047,6 +2629,41 @@ static VkResult VULKAN_CreateFramebuffersAndRenderPasses(SDL_Renderer *renderer,
     return result;
 }
 
+static SDL_bool VULKAN_SurfaceHasPresentMode(VULKAN_RenderData *rendererData, VkPresentModeKHR presentMode)
+{
+    VkPresentModeKHR *presentModes;
+    uint32_t presentModeCount = 0;
+    SDL_bool found = SDL_FALSE;
+    VkResult result;
+
+    if (presentMode == VK_PRESENT_MODE_FIFO_KHR) {
+        return SDL_TRUE;
+    }
+    if (!rendererData->surface) {
+        return SDL_FALSE;
+    }
+
+    result = vkGetPhysicalDeviceSurfacePresentModesKHR(rendererData->physicalDevice, rendererData->surface, &presentModeCount, NULL);
+    if (result != VK_SUCCESS || presentModeCount == 0) {
+        return SDL_FALSE;
+    }
+    presentModes = (VkPresentModeKHR *)SDL_calloc(presentModeCount, sizeof(VkPresentModeKHR));
+    if (!presentModes) {
+        return SDL_FALSE;
+    }
+    result = vkGetPhysicalDeviceSurfacePresentModesKHR(rendererData->physicalDevice, rendererData->surface, &presentModeCount, presentModes);
+    if (result == VK_SUCCESS) {
+        for (uint32_t i = 0; i < presentModeCount; i++) {
+            if (presentModes[i] == presentMode) {
+                found = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    SDL_free(presentModes);
+    return found;
+}
+
 static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
@@ -2065,9 +2682,16 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 
     VkFormat desiredFormat = VK_FORMAT_B8G8R8A8_UNORM;
     VkColorSpaceKHR desiredColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    /* If linear output isn't available, an sRGB swapchain lets the hardware encode our linear output */
+    VkFormat fallbackFormat = VK_FORMAT_UNDEFINED;
     if (renderer->output_colorspace == SDL_COLORSPACE_SRGB_LINEAR) {
-        desiredFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
-        desiredColorSpace = VK_COLOR_SPACE_EXTENDED_SRGB_LINEAR_EXT;
+        if (rendererData->supportsEXTSwapchainColorspace) {
+            desiredFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+            desiredColorSpace = VK_COLOR_SPACE_EXTENDED_SRGB_LINEAR_EXT;
+            fallbackFormat = VK_FORMAT_B8G8R8A8_SRGB;
+        } else {
+            desiredFormat = VK_FORMAT_B8G8R8A8_SRGB;
+        }
     }
     else if (renderer->output_colorspace == SDL_COLORSPACE_HDR10) {
         desiredFormat = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
@@ -2078,8 +2702,9 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         (rendererData->surfaceFormats[0].format == VK_FORMAT_UNDEFINED)) {
         // aren't any preferred formats, so we pick
         rendererData->surfaceFormat.colorSpace = VK_COLORSPACE_SRGB_NONLINEAR_KHR;
-        rendererData->surfaceFormat.format = desiredFormat;
+        rendererData->surfaceFormat.format = (fallbackFormat != VK_FORMAT_UNDEFINED) ? fallbackFormat : desiredFormat;
     } else {
+        SDL_bool found = SDL_FALSE;
         rendererData->surfaceFormat = rendererData->surfaceFormats[0];
         rendererData->surfaceFormat.colorSpace = rendererData->surfaceFormats[0].colorSpace;
         for (uint32_t i = 0; i < rendererData->surfaceFormatsCount; i++) {
@@ -2087,9 +2712,19 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
                 rendererData->surfaceFormats[i].colorSpace == desiredColorSpace) {
                 rendererData->surfaceFormat.colorSpace = rendererData->surfaceFormats[i].colorSpace;
                 rendererData->surfaceFormat = rendererData->surfaceFormats[i];
+                found = SDL_TRUE;
                 break;
             }
         }
+        if (!found && fallbackFormat != VK_FORMAT_UNDEFINED) {
+            for (uint32_t i = 0; i < rendererData->surfaceFormatsCount; i++) {
+                if (rendererData->surfaceFormats[i].format == fallbackFormat &&
+                    rendererData->surfaceFormats[i].colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+                    rendererData->surfaceFormat = rendererData->surfaceFormats[i];
+                    break;
+                }
+            }
+        }
     }
 
     rendererData->swapchainSize.width = SDL_clamp((uint32_t)w,
@@ -2107,7 +2742,11 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 
     /* Choose a present mode. If vsync is requested, then use VK_PRESENT_MODE_FIFO_KHR which is guaranteed to be supported */
     VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
-    if (rendererData->vsync <= 0) {
+    if (rendererData->hasRequestedPresentMode) {
+        if (VULKAN_SurfaceHasPresentMode(rendererData, rendererData->requestedPresentMode)) {
+            presentMode = rendererData->requestedPresentMode;
+        }
+    } else if (rendererData->vsync <= 0) {
         uint32_t presentModeCount = 0;
         result = vkGetPhysicalDeviceSurfacePresentModesKHR(rendererData->physicalDevice, rendererData->surface, &presentModeCount, NULL);
         if (result != VK_SUCCESS) {
@@ -2241,18 +2880,28 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 
     }
 
+    /* The number of frames in flight is fixed once it's chosen, so the per-frame arrays keep their size.
+       It's never more than the swapchain image count, which applications use to size their semaphore rings. */
+    if (rendererData->framesInFlight == 0) {
+        rendererData->framesInFlight = rendererData->swapchainImageCount;
+        if (rendererData->requestedFramesInFlight > 0) {
+            rendererData->framesInFlight = SDL_min(rendererData->requestedFramesInFlight, rendererData->framesInFlight);
+        }
+        rendererData->framesInFlight = SDL_clamp(rendererData->framesInFlight, 1, SDL_VULKAN_MAX_FRAMES_IN_FLIGHT);
+    }
+
     VkCommandBufferAllocateInfo commandBufferAllocateInfo = { 0 };
     commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     commandBufferAllocateInfo.commandPool = rendererData->commandPool;
     commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    commandBufferAllocateInfo.commandBufferCount = rendererData->swapchainImageCount;
+    commandBufferAllocateInfo.commandBufferCount = rendererData->framesInFlight;
     if (rendererData->commandBuffers != NULL) {
         vkResetCommandPool(rendererData->device, rendererData->commandPool, 0);
         SDL_free(rendererData->commandBuffers);
         rendererData->currentCommandBuffer = VK_NULL_HANDLE;
         rendererData->currentCommandBufferIndex = 0;
     }
-    rendererData->commandBuffers = (VkCommandBuffer *)SDL_calloc(rendererData->swapchainImageCount, sizeof(VkCommandBuffer));
+    rendererData->commandBuffers = (VkCommandBuffer *)SDL_calloc(rendererData->framesInFlight, sizeof(VkCommandBuffer));
     result = vkAllocateCommandBuffers(rendererData->device, &commandBufferAllocateInfo, rendererData->commandBuffers);
     if (result != VK_SUCCESS) {
         VULKAN_DestroyAll(renderer);
@@ -2262,15 +2911,15 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 
     /* Create fences */
     if (rendererData->fences) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
             if (rendererData->fences[i] != VK_NULL_HANDLE) {
                 vkDestroyFence(rendererData->device, rendererData->fences[i], NULL);
             }
         }
         SDL_free(rendererData->fences);
     }
-    rendererData->fences = (VkFence *)SDL_calloc(rendererData->swapchainImageCount, sizeof(VkFence));
-    for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+    rendererData->fences = (VkFence *)SDL_calloc(rendererData->framesInFlight, sizeof(VkFence));
+    for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
         VkFenceCreateInfo fenceCreateInfo = { 0 };
         fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
@@ -2313,9 +2962,10 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     }
 
     /* Create descriptor pools - start by allocating one per swapchain image, let it grow if more are needed */
+    VULKAN_DestroyDescriptorSetCaches(rendererData);
     if (rendererData->descriptorPools) {
         SDL_assert(rendererData->numDescriptorPools);
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
             for (uint32_t j = 0; j < rendererData->numDescriptorPools[i]; j++) {
                 if (rendererData->descriptorPools[i][j] != VK_NULL_HANDLE) {
                     vkDestroyDescriptorPool(rendererData->device, rendererData->descriptorPools[i][j], NULL);
@@ -2326,9 +2976,9 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         SDL_free(rendererData->descriptorPools);
         SDL_free(rendererData->numDescriptorPools);
     }
-    rendererData->descriptorPools = (VkDescriptorPool **)SDL_calloc(rendererData->swapchainImageCount, sizeof(VkDescriptorPool*));
-    rendererData->numDescriptorPools = (uint32_t *)SDL_calloc(rendererData->swapchainImageCount, sizeof(uint32_t));
-    for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+    rendererData->descriptorPools = (VkDescriptorPool **)SDL_calloc(rendererData->framesInFlight, sizeof(VkDescriptorPool*));
+    rendererData->numDescriptorPools = (uint32_t *)SDL_calloc(rendererData->framesInFlight, sizeof(uint32_t));
+    for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
         /* Start by just allocating one pool, it will grow if needed */
         rendererData->numDescriptorPools[i] = 1;
         rendererData->descriptorPools[i] = (VkDescriptorPool *)SDL_calloc(1, sizeof(VkDescriptorPool));
@@ -2338,10 +2988,15 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
             return result;
         }
     }
+    result = VULKAN_CreateDescriptorSetCaches(rendererData);
+    if (result != VK_SUCCESS) {
+        VULKAN_DestroyAll(renderer);
+        return result;
+    }
 
     /* Create semaphores */
     if (rendererData->imageAvailableSemaphores) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             if (rendererData->imageAvailableSemaphores[i] != VK_NULL_HANDLE) {
                 vkDestroySemaphore(rendererData->device, rendererData->imageAvailableSemaphores[i], NULL);
             }
@@ -2349,16 +3004,16 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         SDL_free(rendererData->imageAvailableSemaphores);
     }
     if (rendererData->renderingFinishedSemaphores) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             if (rendererData->renderingFinishedSemaphores[i] != VK_NULL_HANDLE) {
                 vkDestroySemaphore(rendererData->device, rendererData->renderingFinishedSemaphores[i], NULL);
             }
         }
         SDL_free(rendererData->renderingFinishedSemaphores);
     }
-    rendererData->imageAvailableSemaphores = (VkSemaphore *)SDL_calloc(sizeof(VkSemaphore), rendererData->swapchainImageCount);
-    rendererData->renderingFinishedSemaphores = (VkSemaphore *)SDL_calloc(sizeof(VkSemaphore), rendererData->swapchainImageCount);
-    for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+    rendererData->imageAvailableSemaphores = (VkSemaphore *)SDL_calloc(sizeof(VkSemaphore), rendererData->framesInFlight);
+    rendererData->renderingFinishedSemaphores = (VkSemaphore *)SDL_calloc(sizeof(VkSemaphore), rendererData->framesInFlight);
+    for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
         rendererData->imageAvailableSemaphores[i] = VULKAN_CreateSemaphore(rendererData);
         if (rendererData->imageAvailableSemaphores[i] == VK_NULL_HANDLE) {
             VULKAN_DestroyAll(renderer);
@@ -2373,7 +3028,7 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
 
     /* Upload buffers */
     if (rendererData->uploadBuffers) {
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
             for (uint32_t j = 0; j < SDL_VULKAN_NUM_UPLOAD_BUFFERS; j++) {
                 VULKAN_DestroyBuffer(rendererData, &rendererData->uploadBuffers[i][j]);
             }
@@ -2381,17 +3036,17 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         }
         SDL_free(rendererData->uploadBuffers);
     }
-    rendererData->uploadBuffers = (VULKAN_Buffer **)SDL_calloc(rendererData->swapchainImageCount, sizeof(VULKAN_Buffer*));
-    for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+    rendererData->uploadBuffers = (VULKAN_Buffer **)SDL_calloc(rendererData->framesInFlight, sizeof(VULKAN_Buffer*));
+    for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
         rendererData->uploadBuffers[i] = (VULKAN_Buffer *)SDL_calloc(SDL_VULKAN_NUM_UPLOAD_BUFFERS, sizeof(VULKAN_Buffer));
     }
     SDL_free(rendererData->currentUploadBuffer);
-    rendererData->currentUploadBuffer = (int *)SDL_calloc(rendererData->swapchainImageCount, sizeof(int));
+    rendererData->currentUploadBuffer = (int *)SDL_calloc(rendererData->framesInFlight, sizeof(int));
 
     /* Constant buffers */
     if (rendererData->constantBuffers) {
         SDL_assert(rendererData->numConstantBuffers);
-        for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
             for (uint32_t j = 0; j < rendererData->numConstantBuffers[i]; j++) {
                 VULKAN_DestroyBuffer(rendererData, &rendererData->constantBuffers[i][j]);
             }
@@ -2401,9 +3056,9 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
         SDL_free(rendererData->numConstantBuffers);
         rendererData->constantBuffers = NULL;
     }
-    rendererData->constantBuffers = (VULKAN_Buffer **)SDL_calloc(rendererData->swapchainImageCount, sizeof(VULKAN_Buffer*));
-    rendererData->numConstantBuffers = (uint32_t *)SDL_calloc(rendererData->swapchainImageCount, sizeof(uint32_t));
-    for (uint32_t i = 0; i < rendererData->swapchainImageCount; i++) {
+    rendererData->constantBuffers = (VULKAN_Buffer **)SDL_calloc(rendererData->framesInFlight, sizeof(VULKAN_Buffer*));
+    rendererData->numConstantBuffers = (uint32_t *)SDL_calloc(rendererData->framesInFlight, sizeof(uint32_t));
+    for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
         /* Start with just allocating one, will grow if needed */
         rendererData->numConstantBuffers[i] = 1;
         rendererData->constantBuffers[i] = (VULKAN_Buffer *)SDL_calloc(1, sizeof(VULKAN_Buffer));
@@ -2423,10 +3078,27 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     rendererData->currentConstantBufferOffset = -1;
     rendererData->currentConstantBufferIndex = 0;
 
+    /* Vertex buffers are created as they're needed */
+    if (!rendererData->vertexBuffers) {
+        rendererData->vertexBuffers = (VULKAN_Buffer (*)[SDL_VULKAN_NUM_VERTEX_BUFFERS])SDL_calloc(rendererData->framesInFlight, sizeof(*rendererData->vertexBuffers));
+        if (!rendererData->vertexBuffers) {
+            VULKAN_DestroyAll(renderer);
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+    if (!rendererData->texturesToDestroy) {
+        rendererData->texturesToDestroy = (VULKAN_TextureData **)SDL_calloc(rendererData->framesInFlight, sizeof(*rendererData->texturesToDestroy));
+        if (!rendererData->texturesToDestroy) {
+            VULKAN_DestroyAll(renderer);
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+
     VULKAN_AcquireNextSwapchainImage(renderer);
 
     SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
     SDL_SetNumberProperty(props, SDL_PROP_RENDERER_VULKAN_SWAPCHAIN_IMAGE_COUNT_NUMBER, rendererData->swapchainImageCount);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_VULKAN_FRAMES_IN_FLIGHT_NUMBER, rendererData->framesInFlight);
 
     return result;
 }
@@ -2677,21 +3349,14 @@ static int VULKAN_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
     return result;
 }
 
-static void VULKAN_DestroyTexture(SDL_Renderer *renderer,
-                                 SDL_Texture *texture)
+static void VULKAN_DestroyTextureData(VULKAN_RenderData *rendererData, VULKAN_TextureData *textureData)
 {
-    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
-    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->internal;
-
-    if (!textureData) {
-        return;
+    if (rendererData->descriptorSetCaches) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; ++i) {
+            rendererData->descriptorSetCaches[i].invalid = SDL_TRUE;
+        }
     }
 
-    /* Because SDL_DestroyTexture might be called while the data is in-flight, we need to issue the batch first
-       Unfortunately, this means that deleting a lot of textures mid-frame will have poor performance. */
-    VULKAN_IssueBatch(rendererData);
-    VULKAN_WaitForGPU(rendererData);
-
     VULKAN_DestroyImage(rendererData, &textureData->mainImage);
 
 #if SDL_HAVE_YUV
@@ -2726,18 +3391,132 @@ static void VULKAN_DestroyTexture(SDL_Renderer *renderer,
     }
 
     SDL_free(textureData);
+}
+
+/* Free the textures destroyed while recording this frame, called once the GPU is done with it */
+static void VULKAN_DestroyPendingTextures(VULKAN_RenderData *rendererData, uint32_t frame)
+{
+    while (rendererData->texturesToDestroy[frame]) {
+        VULKAN_TextureData *textureData = rendererData->texturesToDestroy[frame];
+        rendererData->texturesToDestroy[frame] = textureData->nextToDestroy;
+        VULKAN_DestroyTextureData(rendererData, textureData);
+    }
+}
+
+static void VULKAN_DestroyTexture(SDL_Renderer *renderer,
+                                 SDL_Texture *texture)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->internal;
+
+    if (!textureData) {
+        return;
+    }
     texture->internal = NULL;
+
+    if (!rendererData->commandBuffers || !rendererData->texturesToDestroy) {
+        VULKAN_WaitForGPU(rendererData);
+        VULKAN_DestroyTextureData(rendererData, textureData);
+        return;
+    }
+
+    /* The texture might still be in use by this frame or earlier ones, so free it when this frame's resources
+       are next recycled. The command buffer has to be started first, so that's after this frame is submitted. */
+    VULKAN_EnsureCommandBuffer(rendererData);
+    textureData->nextToDestroy = rendererData->texturesToDestroy[rendererData->currentCommandBufferIndex];
+    rendererData->texturesToDestroy[rendererData->currentCommandBufferIndex] = textureData;
 }
 
-static VkResult VULKAN_UpdateTextureInternal(VULKAN_RenderData *rendererData, VkImage image, VkFormat format, int plane, int x, int y, int w, int h, const void *pixels, int pitch, VkImageLayout *imageLayout)
+/* One rectangle of one plane of a texture update */
+typedef struct
 {
-    VkDeviceSize pixelSize = VULKAN_GetBytesPerPixel(format);
-    VkDeviceSize length = w * pixelSize;
-    VkDeviceSize uploadBufferSize = length * h;
-    const Uint8 *src;
+    int x, y, w, h;
+    const void *pixels;
+    int pitch;
+} VULKAN_PlaneUpload;
+
+/* Split contiguous pixel data into its planes, laid out the way SDL_UpdateTexture() and SDL_LockTexture() expect */
+static int VULKAN_GetTexturePlanes(VkFormat format, const SDL_Rect *rect, const void *pixels, int pitch, VULKAN_PlaneUpload *planes, size_t *totalSize)
+{
+    int numPlanes = VULKAN_VkFormatGetNumPlanes(format);
+    size_t offset = (size_t)rect->h * pitch;
+
+    planes[0].x = rect->x;
+    planes[0].y = rect->y;
+    planes[0].w = rect->w;
+    planes[0].h = rect->h;
+    planes[0].pixels = pixels;
+    planes[0].pitch = pitch;
+
+#if SDL_HAVE_YUV
+    if (numPlanes > 1) {
+        int chromaPitch;
+
+        if (numPlanes == 3) {
+            chromaPitch = (pitch + 1) / 2;
+        } else if (format == VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16) {
+            chromaPitch = (pitch + 3) & ~3;
+        } else {
+            chromaPitch = (pitch + 1) & ~1;
+        }
+
+        for (int plane = 1; plane < numPlanes; ++plane) {
+            planes[plane].x = rect->x / 2;
+            planes[plane].y = rect->y / 2;
+            planes[plane].w = (rect->w + 1) / 2;
+            planes[plane].h = (rect->h + 1) / 2;
+            planes[plane].pixels = pixels ? (const Uint8 *)pixels + offset : NULL;
+            planes[plane].pitch = chromaPitch;
+            offset += (size_t)planes[plane].h * chromaPitch;
+        }
+    }
+#endif
+    if (totalSize) {
+        *totalSize = offset;
+    }
+    return numPlanes;
+}
+
+/* Upload all the planes through a single staging buffer, with one copy command and one pair of barriers */
+static VkResult VULKAN_UpdateTextureInternal(VULKAN_RenderData *rendererData, VULKAN_Image *image, const VULKAN_PlaneUpload *planes, int numPlanes)
+{
+    VkBufferImageCopy regions[3];
+    VkDeviceSize uploadBufferSize = 0;
     Uint8 *dst;
     VkResult result;
-    int planeCount = VULKAN_VkFormatGetNumPlanes(format);
+    int plane;
+
+    SDL_assert(numPlanes <= (int)SDL_arraysize(regions));
+
+    for (plane = 0; plane < numPlanes; ++plane) {
+        VkDeviceSize length = planes[plane].w * VULKAN_GetPlaneBytesPerPixel(image->format, plane);
+        if (length > (VkDeviceSize)planes[plane].pitch) {
+            length = planes[plane].pitch;
+        }
+
+        /* Plane offsets need to be a multiple of the plane's texel size, and 4 covers all of ours */
+        uploadBufferSize = (uploadBufferSize + 3) & ~(VkDeviceSize)3;
+
+        regions[plane].bufferOffset = uploadBufferSize;
+        regions[plane].bufferRowLength = 0;
+        regions[plane].bufferImageHeight = 0;
+        regions[plane].imageSubresource.baseArrayLayer = 0;
+        regions[plane].imageSubresource.layerCount = 1;
+        regions[plane].imageSubresource.mipLevel = 0;
+        if (numPlanes <= 1) {
+            regions[plane].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        } else {
+            regions[plane].imageSubresource.aspectMask = VK_IMAGE_ASPECT_PLANE_0_BIT << plane;
+        }
+        regions[plane].imageOffset.x = planes[plane].x;
+        regions[plane].imageOffset.y = planes[plane].y;
+        regions[plane].imageOffset.z = 0;
+        regions[plane].imageExtent.width = planes[plane].w;
+        regions[plane].imageExtent.height = planes[plane].h;
+        regions[plane].imageExtent.depth = 1;
+
+        uploadBufferSize += length * planes[plane].h;
+    }
 
     VULKAN_EnsureCommandBuffer(rendererData);
 
@@ -2754,18 +3533,23 @@ static VkResult VULKAN_UpdateTextureInternal(VULKAN_RenderData *rendererData, Vk
         return result;
     }
 
-    src = (const Uint8 *)pixels;
-    dst = (Uint8 *)uploadBuffer->mappedBufferPtr;
-    if (length == (VkDeviceSize)pitch) {
-        SDL_memcpy(dst, src, (size_t)length * h);
-    } else {
-        if (length > (VkDeviceSize)pitch) {
-            length = pitch;
-        }
-        for (VkDeviceSize row = h; row--; ) {
-            SDL_memcpy(dst, src, (size_t)length);
-            src += pitch;
-            dst += length;
+    for (plane = 0; plane < numPlanes; ++plane) {
+        const Uint8 *src = (const Uint8 *)planes[plane].pixels;
+        const int pitch = planes[plane].pitch;
+        VkDeviceSize length = planes[plane].w * VULKAN_GetPlaneBytesPerPixel(image->format, plane);
+
+        dst = (Uint8 *)uploadBuffer->mappedBufferPtr + regions[plane].bufferOffset;
+        if (length == (VkDeviceSize)pitch) {
+            SDL_memcpy(dst, src, (size_t)length * planes[plane].h);
+        } else {
+            if (length > (VkDeviceSize)pitch) {
+                length = pitch;
+            }
+            for (int row = planes[plane].h; row--; ) {
+                SDL_memcpy(dst, src, (size_t)length);
+                src += pitch;
+                dst += length;
+            }
         }
     }
 
@@ -2776,30 +3560,10 @@ static VkResult VULKAN_UpdateTextureInternal(VULKAN_RenderData *rendererData, Vk
         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
         VK_PIPELINE_STAGE_TRANSFER_BIT,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        image,
-        imageLayout);
+        image->image,
+        &image->imageLayout);
 
-    VkBufferImageCopy region;
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageSubresource.mipLevel = 0;
-    if (planeCount <= 1) {
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    }
-    else {
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_PLANE_0_BIT << plane;
-    }
-    region.imageOffset.x = x;
-    region.imageOffset.y = y;
-    region.imageOffset.z = 0;
-    region.imageExtent.width = w;
-    region.imageExtent.height = h;
-    region.imageExtent.depth = 1;
-
-    vkCmdCopyBufferToImage(rendererData->currentCommandBuffer, uploadBuffer->buffer, image, *imageLayout, 1, &region);
+    vkCmdCopyBufferToImage(rendererData->currentCommandBuffer, uploadBuffer->buffer, image->image, image->imageLayout, numPlanes, regions);
 
     /* Transition the texture to be shader accessible */
     VULKAN_RecordPipelineImageBarrier(rendererData,
@@ -2808,8 +3572,8 @@ static VkResult VULKAN_UpdateTextureInternal(VULKAN_RenderData *rendererData, Vk
         VK_PIPELINE_STAGE_TRANSFER_BIT,
         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        image,
-        imageLayout);
+        image->image,
+        &image->imageLayout);
 
     rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex]++;
 
@@ -2828,43 +3592,17 @@ static int VULKAN_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->internal;
+    VULKAN_PlaneUpload planes[3];
+    int numPlanes;
 
     if (!textureData) {
         return SDL_SetError("Texture is not currently available");
     }
 
-    if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 0, rect->x, rect->y, rect->w, rect->h, srcPixels, srcPitch, &textureData->mainImage.imageLayout) < 0) {
+    numPlanes = VULKAN_GetTexturePlanes(textureData->mainImage.format, rect, srcPixels, srcPitch, planes, NULL);
+    if (VULKAN_UpdateTextureInternal(rendererData, &textureData->mainImage, planes, numPlanes) < 0) {
         return -1;
     }
-#if SDL_HAVE_YUV
-    Uint32 numPlanes = VULKAN_VkFormatGetNumPlanes(textureData->mainImage.format);
-    /* Skip to the correct offset into the next texture */
-    srcPixels = (const void *)((const Uint8 *)srcPixels + rect->h * srcPitch);
-    // YUV data
-    if (numPlanes == 3) {
-        for (Uint32 plane = 1; plane < numPlanes; plane++) {
-            if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, plane, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, srcPixels, (srcPitch + 1) / 2, &textureData->mainImage.imageLayout) < 0) {
-                return -1;
-            }
-
-            /* Skip to the correct offset into the next texture */
-            srcPixels = (const void *)((const Uint8 *)srcPixels + ((rect->h + 1) / 2) * ((srcPitch + 1) / 2));
-        }
-    }
-    // NV12/NV21 data
-    else if (numPlanes == 2)
-    {
-        if (texture->format == SDL_PIXELFORMAT_P010) {
-            srcPitch = (srcPitch + 3) & ~3;
-        } else {
-            srcPitch = (srcPitch + 1) & ~1;
-        }
-
-        if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 1, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, srcPixels, srcPitch, &textureData->mainImage.imageLayout) < 0) {
-            return -1;
-        }
-    }
-#endif
     return 0;
 }
 
@@ -2877,18 +3615,18 @@ static int VULKAN_UpdateTextureYUV(SDL_Renderer *renderer, SDL_Texture *texture,
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->internal;
+    VULKAN_PlaneUpload planes[3];
 
     if (!textureData) {
         return SDL_SetError("Texture is not currently available");
     }
 
-    if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 0, rect->x, rect->y, rect->w, rect->h, Yplane, Ypitch, &textureData->mainImage.imageLayout) < 0) {
-        return -1;
-    }
-    if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 1, rect->x / 2, rect->y / 2, rect->w / 2, rect->h / 2, Uplane, Upitch, &textureData->mainImage.imageLayout) < 0) {
-        return -1;
-    }
-    if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 2, rect->x / 2, rect->y / 2, rect->w / 2, rect->h / 2, Vplane, Vpitch, &textureData->mainImage.imageLayout) < 0) {
+    VULKAN_GetTexturePlanes(textureData->mainImage.format, rect, Yplane, Ypitch, planes, NULL);
+    planes[1].pixels = Uplane;
+    planes[1].pitch = Upitch;
+    planes[2].pixels = Vplane;
+    planes[2].pitch = Vpitch;
+    if (VULKAN_UpdateTextureInternal(rendererData, &textureData->mainImage, planes, 3) < 0) {
         return -1;
     }
     return 0;
@@ -2901,16 +3639,16 @@ static int VULKAN_UpdateTextureNV(SDL_Renderer *renderer, SDL_Texture *texture,
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->internal;
+    VULKAN_PlaneUpload planes[3];
 
     if (!textureData) {
         return SDL_SetError("Texture is not currently available");
     }
 
-    if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 0, rect->x, rect->y, rect->w, rect->h, Yplane, Ypitch, &textureData->mainImage.imageLayout) < 0) {
-        return -1;
-    }
-
-    if (VULKAN_UpdateTextureInternal(rendererData, textureData->mainImage.image, textureData->mainImage.format, 1, rect->x / 2, rect->y / 2, (rect->w + 1) / 2, (rect->h + 1) / 2, UVplane, UVpitch, &textureData->mainImage.imageLayout) < 0) {
+    VULKAN_GetTexturePlanes(textureData->mainImage.format, rect, Yplane, Ypitch, planes, NULL);
+    planes[1].pixels = UVplane;
+    planes[1].pitch = UVpitch;
+    if (VULKAN_UpdateTextureInternal(rendererData, &textureData->mainImage, planes, 2) < 0) {
         return -1;
     }
     return 0;
@@ -2931,9 +3669,11 @@ static int VULKAN_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
         return SDL_SetError("texture is already locked");
     }
 
-    VkDeviceSize pixelSize = VULKAN_GetBytesPerPixel(textureData->mainImage.format);
+    VkDeviceSize pixelSize = VULKAN_GetPlaneBytesPerPixel(textureData->mainImage.format, 0);
     VkDeviceSize length = rect->w * pixelSize;
-    VkDeviceSize stagingBufferSize = length * rect->h;
+    size_t stagingBufferSize;
+    VULKAN_PlaneUpload planes[3];
+    VULKAN_GetTexturePlanes(textureData->mainImage.format, rect, NULL, (int)length, planes, &stagingBufferSize);
     result = VULKAN_AllocateBuffer(rendererData,
         stagingBufferSize,
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
@@ -2963,11 +3703,45 @@ static void VULKAN_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     VULKAN_TextureData *textureData = (VULKAN_TextureData *)texture->internal;
+    VkBufferImageCopy regions[3];
+    VULKAN_PlaneUpload planes[3];
+    int numPlanes;
 
     if (!textureData) {
         return;
     }
 
+    const Uint8 *mapped = (const Uint8 *)textureData->stagingBuffer.mappedBufferPtr;
+    const int pitch = (int)(textureData->lockedRect.w * VULKAN_GetPlaneBytesPerPixel(textureData->mainImage.format, 0));
+    numPlanes = VULKAN_GetTexturePlanes(textureData->mainImage.format, &textureData->lockedRect, mapped, pitch, planes, NULL);
+
+    for (int plane = 0; plane < numPlanes; ++plane) {
+        regions[plane].bufferOffset = (const Uint8 *)planes[plane].pixels - mapped;
+        if (regions[plane].bufferOffset & 3) {
+            /* The planes are packed the way the application expects, but this one is misaligned for a copy,
+               so repack all of them into an upload buffer instead. */
+            VULKAN_UpdateTextureInternal(rendererData, &textureData->mainImage, planes, numPlanes);
+            VULKAN_DestroyBuffer(rendererData, &textureData->stagingBuffer);
+            return;
+        }
+        regions[plane].bufferRowLength = 0;
+        regions[plane].bufferImageHeight = 0;
+        regions[plane].imageSubresource.baseArrayLayer = 0;
+        regions[plane].imageSubresource.layerCount = 1;
+        regions[plane].imageSubresource.mipLevel = 0;
+        if (numPlanes <= 1) {
+            regions[plane].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        } else {
+            regions[plane].imageSubresource.aspectMask = VK_IMAGE_ASPECT_PLANE_0_BIT << plane;
+        }
+        regions[plane].imageOffset.x = planes[plane].x;
+        regions[plane].imageOffset.y = planes[plane].y;
+        regions[plane].imageOffset.z = 0;
+        regions[plane].imageExtent.width = planes[plane].w;
+        regions[plane].imageExtent.height = planes[plane].h;
+        regions[plane].imageExtent.depth = 1;
+    }
+
     VULKAN_EnsureCommandBuffer(rendererData);
 
      /* Make sure the destination is in the correct resource state */
@@ -2980,21 +3754,7 @@ static void VULKAN_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         textureData->mainImage.image,
         &textureData->mainImage.imageLayout);
 
-    VkBufferImageCopy region;
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageOffset.x = textureData->lockedRect.x;
-    region.imageOffset.y = textureData->lockedRect.y;
-    region.imageOffset.z = 0;
-    region.imageExtent.width = textureData->lockedRect.w;
-    region.imageExtent.height = textureData->lockedRect.h;
-    region.imageExtent.depth = 1;
-    vkCmdCopyBufferToImage(rendererData->currentCommandBuffer, textureData->stagingBuffer.buffer, textureData->mainImage.image, textureData->mainImage.imageLayout, 1, &region);
+    vkCmdCopyBufferToImage(rendererData->currentCommandBuffer, textureData->stagingBuffer.buffer, textureData->mainImage.image, textureData->mainImage.imageLayout, numPlanes, regions);
 
     /* Transition the texture to be shader accessible */
     VULKAN_RecordPipelineImageBarrier(rendererData,
@@ -3006,10 +3766,15 @@ static void VULKAN_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         textureData->mainImage.image,
         &textureData->mainImage.imageLayout);
 
-    /* Execute the command list before releasing the staging buffer */
-    VULKAN_IssueBatch(rendererData);
+    /* The staging buffer is released with the other upload buffers once the GPU is done with this frame */
+    rendererData->uploadBuffers[rendererData->currentCommandBufferIndex][rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex]] = textureData->stagingBuffer;
+    SDL_zero(textureData->stagingBuffer);
+    rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex]++;
 
-    VULKAN_DestroyBuffer(rendererData, &textureData->stagingBuffer);
+    /* If we've used up all the upload buffers, we need to issue the batch */
+    if (rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex] == SDL_VULKAN_NUM_UPLOAD_BUFFERS) {
+        VULKAN_IssueBatch(rendererData);
+    }
 }
 
 static void VULKAN_SetTextureScaleMode(SDL_Renderer *renderer, SDL_Texture *texture, SDL_ScaleMode scaleMode)
@@ -3065,6 +3830,25 @@ static int VULKAN_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
     return 0;
 }
 
+static SDL_bool VULKAN_RenderingLinearSpace(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VkFormat format;
+
+    if (renderer->target) {
+        VULKAN_TextureData *textureData = (VULKAN_TextureData *)renderer->target->internal;
+        format = textureData->mainImage.format;
+    } else {
+        format = rendererData->surfaceFormat.format;
+    }
+
+    /* The hardware encodes writes to sRGB formats, so we need to output linear values */
+    if (VULKAN_VkFormatIsSRGB(format)) {
+        return SDL_TRUE;
+    }
+    return SDL_RenderingLinearSpace(renderer);
+}
+
 static int VULKAN_QueueNoOp(SDL_Renderer *renderer, SDL_RenderCommand *cmd)
 {
     return 0; /* nothing to do in this backend. */
@@ -3074,7 +3858,7 @@ static int VULKAN_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd
 {
     VertexPositionColor *verts = (VertexPositionColor *)SDL_AllocateRenderVertices(renderer, count * sizeof(VertexPositionColor), 0, &cmd->data.draw.first);
     int i;
-    SDL_bool convert_color = SDL_RenderingLinearSpace(renderer);
+    SDL_bool convert_color = VULKAN_RenderingLinearSpace(renderer);
 
     if (!verts) {
         return -1;
@@ -3103,7 +3887,7 @@ static int VULKAN_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     int i;
     int count = indices ? num_indices : num_vertices;
     VertexPositionColor *verts = (VertexPositionColor *)SDL_AllocateRenderVertices(renderer, count * sizeof(VertexPositionColor), 0, &cmd->data.draw.first);
-    SDL_bool convert_color = SDL_RenderingLinearSpace(renderer);
+    SDL_bool convert_color = VULKAN_RenderingLinearSpace(renderer);
     VULKAN_TextureData *textureData = texture ? (VULKAN_TextureData *)texture->internal : NULL;
     float u_scale = textureData ? (float)texture->w / textureData->width : 0.0f;
     float v_scale = textureData ? (float)texture->h / textureData->height : 0.0f;
@@ -3168,14 +3952,16 @@ static SDL_bool VULKAN_UpdateVertexBuffer(SDL_Renderer *renderer,
             return SDL_FALSE;
         }
     }
-    /* If the existing vertex buffer isn't big enough, we need to recreate a big enough one */
-    if (dataSizeInBytes > rendererData->vertexBuffers[vbidx].size) {
-        VULKAN_IssueBatch(rendererData);
-        VULKAN_WaitForGPU(rendererData);
-        VULKAN_CreateVertexBuffer(rendererData, vbidx, dataSizeInBytes);
+    /* If the existing vertex buffer isn't big enough, we need to recreate a big enough one.
+       Vertex buffers belong to a frame in flight and the GPU is done with this frame's, so there's no need to wait. */
+    vertexBuffer = &rendererData->vertexBuffers[rendererData->currentCommandBufferIndex][vbidx];
+    if (dataSizeInBytes > vertexBuffer->size) {
+        if (VULKAN_CreateVertexBuffer(rendererData, vbidx, SDL_max(dataSizeInBytes, SDL_VULKAN_VERTEX_BUFFER_DEFAULT_SIZE)) != VK_SUCCESS) {
+            SDL_SetError("[Vulkan] Couldn't create vertex buffer");
+            return SDL_FALSE;
+        }
     }
 
-    vertexBuffer = &rendererData->vertexBuffers[vbidx];
     SDL_memcpy(vertexBuffer->mappedBufferPtr, vertexData, dataSizeInBytes);
 
     stateCache->vertexBuffer = vertexBuffer->buffer;
@@ -3262,7 +4048,7 @@ static void VULKAN_SetupShaderConstants(SDL_Renderer *renderer, const SDL_Render
 
     SDL_zerop(constants);
 
-    constants->scRGB_output = (float)SDL_RenderingLinearSpace(renderer);
+    constants->scRGB_output = (float)VULKAN_RenderingLinearSpace(renderer);
     constants->color_scale = cmd->data.draw.color_scale;
 
     if (texture) {
@@ -3316,7 +4102,7 @@ static VkDescriptorPool VULKAN_AllocateDescriptorPool(VULKAN_RenderData *rendere
     descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
     descriptorPoolSizes[2].descriptorCount = SDL_VULKAN_MAX_DESCRIPTOR_SETS;
-    descriptorPoolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorPoolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { 0 };
     descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -3345,7 +4131,7 @@ static VkResult VULKAN_CreateDescriptorSetAndPipelineLayout(VULKAN_RenderData *r
     /* PixelShaderConstants */
     layoutBindings[0].binding = 1;
     layoutBindings[0].descriptorCount = 1;
-    layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     layoutBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     layoutBindings[0].pImmutableSamplers = NULL;
 
@@ -3384,11 +4170,65 @@ static VkResult VULKAN_CreateDescriptorSetAndPipelineLayout(VULKAN_RenderData *r
     return result;
 }
 
+static Uint32 VULKAN_HashDescriptorSetKey(const void *key, void *data)
+{
+    return SDL_crc32(0, key, sizeof(VULKAN_DescriptorSetKey));
+}
+
+static SDL_bool VULKAN_DescriptorSetKeyMatch(const void *a, const void *b, void *data)
+{
+    return SDL_memcmp(a, b, sizeof(VULKAN_DescriptorSetKey)) == 0;
+}
+
+static VkResult VULKAN_CreateDescriptorSetCaches(VULKAN_RenderData *rendererData)
+{
+    rendererData->descriptorSetCaches = (VULKAN_DescriptorSetCache *)SDL_calloc(rendererData->framesInFlight, sizeof(VULKAN_DescriptorSetCache));
+    if (!rendererData->descriptorSetCaches) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
+        rendererData->descriptorSetCaches[i].sets = SDL_CreateHashTable(NULL, 256, VULKAN_HashDescriptorSetKey, VULKAN_DescriptorSetKeyMatch, SDL_NukeFreeValue, SDL_FALSE);
+        if (!rendererData->descriptorSetCaches[i].sets) {
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+static void VULKAN_DestroyDescriptorSetCaches(VULKAN_RenderData *rendererData)
+{
+    if (rendererData->descriptorSetCaches) {
+        for (uint32_t i = 0; i < rendererData->framesInFlight; i++) {
+            if (rendererData->descriptorSetCaches[i].sets) {
+                SDL_DestroyHashTable(rendererData->descriptorSetCaches[i].sets);
+            }
+        }
+        SDL_free(rendererData->descriptorSetCaches);
+        rendererData->descriptorSetCaches = NULL;
+    }
+}
+
 static VkDescriptorSet VULKAN_AllocateDescriptorSet(SDL_Renderer *renderer, VULKAN_Shader shader, VkDescriptorSetLayout descriptorSetLayout,
-    VkSampler sampler, VkBuffer constantBuffer, VkDeviceSize constantBufferOffset, VkImageView imageView)
+    VkSampler sampler, VkBuffer constantBuffer, VkImageView imageView)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
-    uint32_t currentDescriptorPoolIndex = rendererData->currentDescriptorPoolIndex;
+    VULKAN_DescriptorSetCache *descriptorSetCache = &rendererData->descriptorSetCaches[rendererData->currentCommandBufferIndex];
+    VULKAN_DescriptorSetKey key;
+    const void *cached;
+
+    /* Reuse a set from an earlier draw, or an earlier frame, if the bindings are the same */
+    SDL_zero(key);
+    key.descriptorSetLayout = descriptorSetLayout;
+    key.constantBuffer = constantBuffer;
+    if (sampler != VK_NULL_HANDLE && imageView != VK_NULL_HANDLE) {
+        key.sampler = sampler;
+        key.imageView = imageView;
+    }
+    if (SDL_FindInHashTable(descriptorSetCache->sets, &key, &cached)) {
+        return ((const VULKAN_CachedDescriptorSet *)cached)->descriptorSet;
+    }
+
+    uint32_t currentDescriptorPoolIndex = descriptorSetCache->poolIndex;
     VkDescriptorPool descriptorPool = rendererData->descriptorPools[rendererData->currentCommandBufferIndex][currentDescriptorPoolIndex];
 
     VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { 0 };
@@ -3398,7 +4238,7 @@ static VkDescriptorSet VULKAN_AllocateDescriptorSet(SDL_Renderer *renderer, VULK
     descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
 
     VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
-    VkResult result = (rendererData->currentDescriptorSetIndex >= SDL_VULKAN_MAX_DESCRIPTOR_SETS) ? VK_ERROR_OUT_OF_DEVICE_MEMORY : VK_SUCCESS;
+    VkResult result = (descriptorSetCache->setIndex >= SDL_VULKAN_MAX_DESCRIPTOR_SETS) ? VK_ERROR_OUT_OF_DEVICE_MEMORY : VK_SUCCESS;
     if (result == VK_SUCCESS) {
         result = vkAllocateDescriptorSets(rendererData->device, &descriptorSetAllocateInfo, &descriptorSet);
     }
@@ -3414,8 +4254,8 @@ static VkDescriptorSet VULKAN_AllocateDescriptorSet(SDL_Renderer *renderer, VULK
                 SDL_SetError("[Vulkan] Unable to allocate descriptor set");
                 return VK_NULL_HANDLE;
             }
-            rendererData->currentDescriptorPoolIndex = currentDescriptorPoolIndex;
-            rendererData->currentDescriptorSetIndex = 0;
+            descriptorSetCache->poolIndex = currentDescriptorPoolIndex;
+            descriptorSetCache->setIndex = 0;
 
         }
         /* We are out of pools, create a new one */
@@ -3430,18 +4270,18 @@ static VkDescriptorSet VULKAN_AllocateDescriptorSet(SDL_Renderer *renderer, VULK
                                                             sizeof(VkDescriptorPool) * rendererData->numDescriptorPools[rendererData->currentCommandBufferIndex]);
             descriptorPools[rendererData->numDescriptorPools[rendererData->currentCommandBufferIndex] - 1] = descriptorPool;
             rendererData->descriptorPools[rendererData->currentCommandBufferIndex] = descriptorPools;
-            rendererData->currentDescriptorPoolIndex = currentDescriptorPoolIndex;
-            rendererData->currentDescriptorSetIndex = 0;
+            descriptorSetCache->poolIndex = currentDescriptorPoolIndex;
+            descriptorSetCache->setIndex = 0;
 
             /* Call recursively to allocate from the new pool */
-            return VULKAN_AllocateDescriptorSet(renderer, shader, descriptorSetLayout, sampler, constantBuffer, constantBufferOffset, imageView);
+            return VULKAN_AllocateDescriptorSet(renderer, shader, descriptorSetLayout, sampler, constantBuffer, imageView);
         }
     }
-    rendererData->currentDescriptorSetIndex++;
+    descriptorSetCache->setIndex++;
     VkDescriptorImageInfo combinedImageSamplerDescriptor = { 0 };
     VkDescriptorBufferInfo bufferDescriptor = { 0 };
     bufferDescriptor.buffer = constantBuffer;
-    bufferDescriptor.offset = constantBufferOffset;
+    bufferDescriptor.offset = 0;
     bufferDescriptor.range = sizeof(PixelShaderConstants);
 
     VkWriteDescriptorSet descriptorWrites[2];
@@ -3453,7 +4293,7 @@ static VkDescriptorSet VULKAN_AllocateDescriptorSet(SDL_Renderer *renderer, VULK
     descriptorWrites[0].dstBinding = 1;
     descriptorWrites[0].dstArrayElement = 0;
     descriptorWrites[0].descriptorCount = 1;
-    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites[0].pBufferInfo = &bufferDescriptor;
 
     if (sampler != VK_NULL_HANDLE && imageView != VK_NULL_HANDLE) {
@@ -3476,6 +4316,16 @@ static VkDescriptorSet VULKAN_AllocateDescriptorSet(SDL_Renderer *renderer, VULK
 
     vkUpdateDescriptorSets(rendererData->device, descriptorCount, descriptorWrites, 0, NULL);
 
+    /* If this fails the set just isn't reused */
+    VULKAN_CachedDescriptorSet *entry = (VULKAN_CachedDescriptorSet *)SDL_malloc(sizeof(*entry));
+    if (entry) {
+        entry->key = key;
+        entry->descriptorSet = descriptorSet;
+        if (!SDL_InsertIntoHashTable(descriptorSetCache->sets, &entry->key, entry)) {
+            SDL_free(entry);
+        }
+    }
+
     return descriptorSet;
 }
 
@@ -3523,7 +4373,7 @@ static SDL_bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderComm
 
         /* If we didn't find a match, create a new one -- it must mean the blend mode is non-standard */
         if (!rendererData->currentPipelineState) {
-            rendererData->currentPipelineState = VULKAN_CreatePipelineState(renderer, shader, pipelineLayout, descriptorSetLayout, blendMode, topology, format);
+            rendererData->currentPipelineState = VULKAN_CreatePipelineState(renderer, shader, pipelineLayout, descriptorSetLayout, blendMode, topology, format, rendererData->currentRenderPass);
         }
 
         if (!rendererData->currentPipelineState) {
@@ -3615,14 +4465,23 @@ static SDL_bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderComm
     }
 
     /* Allocate/update descriptor set with the bindings */
-    descriptorSet = VULKAN_AllocateDescriptorSet(renderer, shader, descriptorSetLayout, sampler, constantBuffer, constantBufferOffset, imageView);
+    descriptorSet = VULKAN_AllocateDescriptorSet(renderer, shader, descriptorSetLayout, sampler, constantBuffer, imageView);
     if (descriptorSet == VK_NULL_HANDLE) {
         return SDL_FALSE;
     }
 
-    /* Bind the descriptor set with the sampler/UBO/image views */
-    vkCmdBindDescriptorSets(rendererData->currentCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rendererData->currentPipelineState->pipelineLayout,
-            0, 1, &descriptorSet, 0, NULL);
+    /* Bind the descriptor set with the sampler/UBO/image views, unless the last draw already did */
+    if (descriptorSet != rendererData->currentDescriptorSet ||
+        (uint32_t)constantBufferOffset != rendererData->currentDescriptorSetOffset ||
+        rendererData->currentPipelineState->pipelineLayout != rendererData->currentDescriptorSetPipelineLayout) {
+        uint32_t dynamicOffset = (uint32_t)constantBufferOffset;
+
+        vkCmdBindDescriptorSets(rendererData->currentCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rendererData->currentPipelineState->pipelineLayout,
+                0, 1, &descriptorSet, 1, &dynamicOffset);
+        rendererData->currentDescriptorSet = descriptorSet;
+        rendererData->currentDescriptorSetOffset = dynamicOffset;
+        rendererData->currentDescriptorSetPipelineLayout = rendererData->currentPipelineState->pipelineLayout;
+    }
 
     return SDL_TRUE;
 }
@@ -3758,7 +4617,7 @@ static int VULKAN_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd
 
         case SDL_RENDERCMD_CLEAR:
         {
-            SDL_bool convert_color = SDL_RenderingLinearSpace(renderer);
+            SDL_bool convert_color = VULKAN_RenderingLinearSpace(renderer);
             SDL_FColor color = cmd->data.color.color;
             if (convert_color) {
                 SDL_ConvertToLinear(&color);
@@ -3836,17 +4695,32 @@ static int VULKAN_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd
     return 0;
 }
 
-static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+static VkFormat VULKAN_GetReadPixelsFormat(VULKAN_RenderData *rendererData)
+{
+    if (rendererData->textureRenderTarget) {
+        return rendererData->textureRenderTarget->mainImage.format;
+    } else {
+        return rendererData->surfaceFormat.format;
+    }
+}
+
+static SDL_Colorspace VULKAN_GetReadPixelsColorspace(SDL_Renderer *renderer, VkFormat vkFormat)
+{
+    if (renderer->target) {
+        return renderer->target->colorspace;
+    }
+    if (VULKAN_VkFormatIsSRGB(vkFormat)) {
+        /* The linear output was encoded to sRGB as it was written */
+        return SDL_COLORSPACE_SRGB;
+    }
+    return renderer->output_colorspace;
+}
+
+/* Record a copy of the current render target into the buffer, tightly packed */
+static void VULKAN_RecordReadPixels(VULKAN_RenderData *rendererData, const SDL_Rect *rect, VkBuffer buffer)
 {
-    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     VkImage backBuffer;
     VkImageLayout *imageLayout;
-    VULKAN_Buffer readbackBuffer;
-    VkDeviceSize pixelSize;
-    VkDeviceSize length;
-    VkDeviceSize readbackBufferSize;
-    VkFormat vkFormat;
-    SDL_Surface *output;
 
     VULKAN_EnsureCommandBuffer(rendererData);
 
@@ -3859,27 +4733,11 @@ static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
     if (rendererData->textureRenderTarget) {
         backBuffer = rendererData->textureRenderTarget->mainImage.image;
         imageLayout = &rendererData->textureRenderTarget->mainImage.imageLayout;
-        vkFormat = rendererData->textureRenderTarget->mainImage.format;
     } else {
         backBuffer = rendererData->swapchainImages[rendererData->currentSwapchainImageIndex];
         imageLayout = &rendererData->swapchainImageLayouts[rendererData->currentSwapchainImageIndex];
-        vkFormat = rendererData->surfaceFormat.format;
-    }
-
-    pixelSize = VULKAN_GetBytesPerPixel(vkFormat);
-    length = rect->w * pixelSize;
-    readbackBufferSize = length * rect->h;
-    if (VULKAN_AllocateBuffer(rendererData, readbackBufferSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        &readbackBuffer) != VK_SUCCESS) {
-        SDL_SetError("[Vulkan] Failed to allocate buffer for readback");
-        return NULL;
     }
 
-
     /* Make sure the source is in the correct resource state */
     VULKAN_RecordPipelineImageBarrier(rendererData,
         VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
@@ -3905,13 +4763,10 @@ static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
     region.imageExtent.width = rect->w;
     region.imageExtent.height = rect->h;
     region.imageExtent.depth = 1;
-    vkCmdCopyImageToBuffer(rendererData->currentCommandBuffer, backBuffer, *imageLayout, readbackBuffer.buffer, 1, &region);
-
-    /* We need to issue the command list for the copy to finish */
-    VULKAN_IssueBatch(rendererData);
+    vkCmdCopyImageToBuffer(rendererData->currentCommandBuffer, backBuffer, *imageLayout, buffer, 1, &region);
 
     /* Transition the render target back to a render target */
-     VULKAN_RecordPipelineImageBarrier(rendererData,
+    VULKAN_RecordPipelineImageBarrier(rendererData,
         VK_ACCESS_TRANSFER_WRITE_BIT,
         VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
         VK_PIPELINE_STAGE_TRANSFER_BIT,
@@ -3919,11 +4774,41 @@ static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
         backBuffer,
         imageLayout);
+}
+
+static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_Buffer readbackBuffer;
+    VkDeviceSize pixelSize;
+    VkDeviceSize length;
+    VkDeviceSize readbackBufferSize;
+    VkFormat vkFormat;
+    SDL_Surface *output;
+
+    vkFormat = VULKAN_GetReadPixelsFormat(rendererData);
+    pixelSize = VULKAN_GetBytesPerPixel(vkFormat);
+    length = rect->w * pixelSize;
+    readbackBufferSize = length * rect->h;
+    if (VULKAN_AllocateBuffer(rendererData, readbackBufferSize,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &readbackBuffer) != VK_SUCCESS) {
+        SDL_SetError("[Vulkan] Failed to allocate buffer for readback");
+        return NULL;
+    }
+
+    VULKAN_RecordReadPixels(rendererData, rect, readbackBuffer.buffer);
+
+    /* We need to issue the command list for the copy to finish */
+    VULKAN_IssueBatch(rendererData);
 
     output = SDL_DuplicatePixels(
         rect->w, rect->h,
         VULKAN_VkFormatToSDLPixelFormat(vkFormat),
-        renderer->target ? renderer->target->colorspace : renderer->output_colorspace,
+        VULKAN_GetReadPixelsColorspace(renderer, vkFormat),
         readbackBuffer.mappedBufferPtr,
         (int)length);
 
@@ -3932,6 +4817,98 @@ static SDL_Surface* VULKAN_RenderReadPixels(SDL_Renderer *renderer, const SDL_Re
     return output;
 }
 
+static VkResult VULKAN_AcquireReadbackBuffer(VULKAN_RenderData *rendererData, VkDeviceSize size, VULKAN_Buffer *bufferOut)
+{
+    for (int i = 0; i < rendererData->numReadbackBuffers; ++i) {
+        if (rendererData->readbackBuffers[i].size >= size) {
+            *bufferOut = rendererData->readbackBuffers[i];
+            rendererData->readbackBuffers[i] = rendererData->readbackBuffers[--rendererData->numReadbackBuffers];
+            return VK_SUCCESS;
+        }
+    }
+
+    /* The CPU reads these, so prefer cached memory */
+    return VULKAN_AllocateBuffer(rendererData, size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        bufferOut);
+}
+
+static void VULKAN_ReleaseReadbackBuffer(VULKAN_RenderData *rendererData, VULKAN_Buffer *buffer)
+{
+    if (rendererData->numReadbackBuffers < SDL_VULKAN_NUM_READBACK_BUFFERS) {
+        rendererData->readbackBuffers[rendererData->numReadbackBuffers++] = *buffer;
+    } else {
+        VULKAN_DestroyBuffer(rendererData, buffer);
+    }
+}
+
+static int VULKAN_RenderReadPixelsAsync(SDL_Renderer *renderer, SDL_PendingReadPixels *read)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_ReadPixels *readData;
+    VkDeviceSize length;
+
+    readData = (VULKAN_ReadPixels *)SDL_calloc(1, sizeof(*readData));
+    if (!readData) {
+        return -1;
+    }
+    readData->format = VULKAN_GetReadPixelsFormat(rendererData);
+    readData->colorspace = VULKAN_GetReadPixelsColorspace(renderer, readData->format);
+
+    length = read->rect.w * VULKAN_GetBytesPerPixel(readData->format);
+    if (VULKAN_AcquireReadbackBuffer(rendererData, length * read->rect.h, &readData->buffer) != VK_SUCCESS) {
+        SDL_free(readData);
+        return SDL_SetError("[Vulkan] Failed to allocate buffer for readback");
+    }
+
+    /* The copy goes out with the rest of this frame, instead of being submitted and waited for */
+    VULKAN_RecordReadPixels(rendererData, &read->rect, readData->buffer.buffer);
+    readData->serial = rendererData->submitSerial;
+
+    read->internal = readData;
+    return 0;
+}
+
+static int VULKAN_GetReadPixelsResult(SDL_Renderer *renderer, SDL_PendingReadPixels *read, SDL_bool wait)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_ReadPixels *readData = (VULKAN_ReadPixels *)read->internal;
+
+    if (rendererData->completedSerial <= readData->serial) {
+        if (!wait) {
+            return 0;
+        }
+        if (readData->serial == rendererData->submitSerial) {
+            /* The copy is still in the command buffer being recorded */
+            VULKAN_IssueBatch(rendererData);
+        } else {
+            VULKAN_WaitForGPU(rendererData);
+        }
+    }
+
+    read->surface = SDL_DuplicatePixels(
+        read->rect.w, read->rect.h,
+        VULKAN_VkFormatToSDLPixelFormat(readData->format),
+        readData->colorspace,
+        readData->buffer.mappedBufferPtr,
+        (int)(read->rect.w * VULKAN_GetBytesPerPixel(readData->format)));
+
+    return read->surface ? 1 : -1;
+}
+
+static void VULKAN_DestroyReadPixels(SDL_Renderer *renderer, SDL_PendingReadPixels *read)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_ReadPixels *readData = (VULKAN_ReadPixels *)read->internal;
+
+    VULKAN_ReleaseReadbackBuffer(rendererData, &readData->buffer);
+    SDL_free(readData);
+    read->internal = NULL;
+}
+
 static int VULKAN_AddVulkanRenderSemaphores(SDL_Renderer *renderer, Uint32 wait_stage_mask, Sint64 wait_semaphore, Sint64 signal_semaphore)
 {
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
@@ -4036,6 +5013,7 @@ static int VULKAN_RenderPresent(SDL_Renderer *renderer)
         }
         rendererData->currentCommandBuffer = VK_NULL_HANDLE;
         rendererData->currentImageAvailableSemaphore = VK_NULL_HANDLE;
+        rendererData->frameSerials[rendererData->currentCommandBufferIndex] = ++rendererData->submitSerial;
 
 
         VkPresentInfoKHR presentInfo = { 0 };
@@ -4051,7 +5029,7 @@ static int VULKAN_RenderPresent(SDL_Renderer *renderer)
             return -1;
         }
 
-        rendererData->currentCommandBufferIndex = ( rendererData->currentCommandBufferIndex + 1 ) % rendererData->swapchainImageCount;
+        rendererData->currentCommandBufferIndex = ( rendererData->currentCommandBufferIndex + 1 ) % rendererData->framesInFlight;
 
         /* Wait for previous time this command buffer was submitted, will be N frames ago */
         result = vkWaitForFences(rendererData->device, 1, &rendererData->fences[rendererData->currentCommandBufferIndex], VK_TRUE, UINT64_MAX);
@@ -4059,10 +5037,13 @@ static int VULKAN_RenderPresent(SDL_Renderer *renderer)
             SDL_LogError(SDL_LOG_CATEGORY_RENDER, "vkWaitForFences(): %s\n", SDL_Vulkan_GetResultString(result));
             return -1;
         }
+        rendererData->completedSerial = SDL_max(rendererData->completedSerial, rendererData->frameSerials[rendererData->currentCommandBufferIndex]);
 
         VULKAN_AcquireNextSwapchainImage(renderer);
     }
 
+    VULKAN_UpdateMemoryProperties(renderer);
+
     return 0;
 }
 
@@ -4079,8 +5060,57 @@ static int VULKAN_SetVSync(SDL_Renderer *renderer, const int vsync)
     default:
         return SDL_Unsupported();
     }
-    if (vsync != rendererData->vsync) {
+    if (vsync != rendererData->vsync || rendererData->hasRequestedPresentMode) {
         rendererData->vsync = vsync;
+        rendererData->hasRequestedPresentMode = SDL_FALSE;
+        rendererData->recreateSwapchain = SDL_TRUE;
+    }
+    return 0;
+}
+
+static SDL_bool VULKAN_GetVkPresentMode(SDL_PresentMode mode, VkPresentModeKHR *vkPresentMode)
+{
+    switch (mode) {
+    case SDL_PRESENTMODE_FIFO:
+        *vkPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+        return SDL_TRUE;
+    case SDL_PRESENTMODE_FIFO_RELAXED:
+        *vkPresentMode = VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        return SDL_TRUE;
+    case SDL_PRESENTMODE_MAILBOX:
+        *vkPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+        return SDL_TRUE;
+    case SDL_PRESENTMODE_IMMEDIATE:
+        *vkPresentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+        return SDL_TRUE;
+    default:
+        /* Vulkan has no present mode for VRR, that's up to the display */
+        return SDL_FALSE;
+    }
+}
+
+static SDL_bool VULKAN_SupportsPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VkPresentModeKHR vkPresentMode;
+
+    if (!VULKAN_GetVkPresentMode(mode, &vkPresentMode)) {
+        return SDL_FALSE;
+    }
+    return VULKAN_SurfaceHasPresentMode(rendererData, vkPresentMode);
+}
+
+static int VULKAN_SetPresentMode(SDL_Renderer *renderer, SDL_PresentMode mode)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VkPresentModeKHR vkPresentMode;
+
+    if (!VULKAN_GetVkPresentMode(mode, &vkPresentMode)) {
+        return SDL_Unsupported();
+    }
+    if (!rendererData->hasRequestedPresentMode || vkPresentMode != rendererData->requestedPresentMode) {
+        rendererData->hasRequestedPresentMode = SDL_TRUE;
+        rendererData->requestedPresentMode = vkPresentMode;
         rendererData->recreateSwapchain = SDL_TRUE;
     }
     return 0;
@@ -4104,6 +5134,7 @@ static int VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
     }
 
     rendererData->identity = MatrixIdentity();
+    rendererData->requestedFramesInFlight = (uint32_t)SDL_clamp(SDL_GetNumberProperty(create_props, SDL_PROP_RENDERER_CREATE_VULKAN_FRAMES_IN_FLIGHT_NUMBER, 0), 0, SDL_VULKAN_MAX_FRAMES_IN_FLIGHT);
     rendererData->identitySwizzle.r = VK_COMPONENT_SWIZZLE_IDENTITY;
     rendererData->identitySwizzle.g = VK_COMPONENT_SWIZZLE_IDENTITY;
     rendererData->identitySwizzle.b = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -4129,11 +5160,16 @@ static int VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
     renderer->InvalidateCachedState = VULKAN_InvalidateCachedState;
     renderer->RunCommandQueue = VULKAN_RunCommandQueue;
     renderer->RenderReadPixels = VULKAN_RenderReadPixels;
+    renderer->RenderReadPixelsAsync = VULKAN_RenderReadPixelsAsync;
+    renderer->GetReadPixelsResult = VULKAN_GetReadPixelsResult;
+    renderer->DestroyReadPixels = VULKAN_DestroyReadPixels;
     renderer->AddVulkanRenderSemaphores = VULKAN_AddVulkanRenderSemaphores;
     renderer->RenderPresent = VULKAN_RenderPresent;
     renderer->DestroyTexture = VULKAN_DestroyTexture;
     renderer->DestroyRenderer = VULKAN_DestroyRenderer;
     renderer->SetVSync = VULKAN_SetVSync;
+    renderer->SupportsPresentMode = VULKAN_SupportsPresentMode;
+    renderer->SetPresentMode = VULKAN_SetPresentMode;
     renderer->internal = rendererData;
     VULKAN_InvalidateCachedState(renderer);
 
@@ -4156,6 +5192,11 @@ static int VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
         return -1;
     }
 
+    if (SDL_GetBooleanProperty(create_props, SDL_PROP_RENDERER_CREATE_VULKAN_PREWARM_PIPELINES_BOOLEAN, SDL_FALSE)) {
+        VULKAN_PrewarmPipelineStates(renderer);
+    }
+    VULKAN_UpdateMemoryProperties(renderer);
+
 #if SDL_HAVE_YUV
     if (rendererData->supportsKHRSamplerYCbCrConversion) {
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YV12);
@@ -41,12 +41,56 @@ static Uint16 crc16_for_byte(Uint8 r)
     return crc;
 }
 
+/* crc16_table[0] is the usual byte table, and crc16_table[k] advances a
+   byte through k more zero bytes, for slicing-by-8. */
+static Uint16 crc16_table[8][256];
+static SDL_AtomicInt crc16_table_ready;
+static SDL_SpinLock crc16_table_lock;
+
+static void crc16_init_table(void)
+{
+    int i, k;
+
+    if (SDL_AtomicGet(&crc16_table_ready)) {
+        return;
+    }
+
+    SDL_LockSpinlock(&crc16_table_lock);
+    if (!SDL_AtomicGet(&crc16_table_ready)) {
+        for (i = 0; i < 256; ++i) {
+            crc16_table[0][i] = crc16_for_byte((Uint8)i);
+        }
+        for (k = 1; k < 8; ++k) {
+            for (i = 0; i < 256; ++i) {
+                const Uint16 prev = crc16_table[k - 1][i];
+                crc16_table[k][i] = (prev >> 8) ^ crc16_table[0][prev & 0xFF];
+            }
+        }
+        SDL_AtomicSet(&crc16_table_ready, 1);
+    }
+    SDL_UnlockSpinlock(&crc16_table_lock);
+}
+
 Uint16 SDL_crc16(Uint16 crc, const void *data, size_t len)
 {
-    /* As an optimization we can precalculate a 256 entry table for each byte */
-    size_t i;
-    for (i = 0; i < len; ++i) {
-        crc = crc16_for_byte((Uint8)crc ^ ((const Uint8 *)data)[i]) ^ crc >> 8;
+    const Uint8 *bytes = (const Uint8 *)data;
+
+    crc16_init_table();
+
+    while (len >= 8) {
+        crc = crc16_table[7][bytes[0] ^ (crc & 0xFF)] ^
+              crc16_table[6][bytes[1] ^ (crc >> 8)] ^
+              crc16_table[5][bytes[2]] ^
+              crc16_table[4][bytes[3]] ^
+              crc16_table[3][bytes[4]] ^
+              crc16_table[2][bytes[5]] ^
+              crc16_table[1][bytes[6]] ^
+              crc16_table[0][bytes[7]];
+        bytes += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = crc16_table[0][(Uint8)crc ^ *bytes++] ^ crc >> 8;
     }
     return crc;
 }
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
 /* Public domain CRC implementation adapted from:
    http://home.thep.lu.se/~bjorn/crc/crc32_simple.c
 
@@ -30,21 +32,197 @@
    There is code that relies on this in the joystick code
 */
 
-static Uint32 crc32_for_byte(Uint32 r)
+#if defined(__ARM_FEATURE_CRC32) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SDL_CRC32_ARMV8
+#include <arm_acle.h>
+#endif
+
+#if defined(SDL_SSE4_1_INTRINSICS) && (defined(SDL_HAS_TARGET_ATTRIBS) || defined(_MSC_VER))
+#define SDL_CRC32_PCLMUL
+#include <wmmintrin.h>
+#endif
+
+#ifndef SDL_CRC32_ARMV8
+
+/* The original implementation folded the pre and post inversion of the
+   standard reflected CRC-32 into its byte table, so the code below runs
+   the textbook algorithm on the inverted value and gets the same results.
+
+   crc32_table[0] is the usual byte table, and crc32_table[k] advances a
+   byte through k more zero bytes, for slicing-by-8. */
+static Uint32 crc32_table[8][256];
+static SDL_AtomicInt crc32_table_ready;
+static SDL_SpinLock crc32_table_lock;
+
+static void crc32_init_table(void)
 {
-    int i;
-    for (i = 0; i < 8; ++i) {
-        r = (r & 1 ? 0 : (Uint32)0xEDB88320L) ^ r >> 1;
+    int i, k;
+
+    if (SDL_AtomicGet(&crc32_table_ready)) {
+        return;
     }
-    return r ^ (Uint32)0xFF000000L;
+
+    SDL_LockSpinlock(&crc32_table_lock);
+    if (!SDL_AtomicGet(&crc32_table_ready)) {
+        for (i = 0; i < 256; ++i) {
+            Uint32 r = (Uint32)i;
+            for (k = 0; k < 8; ++k) {
+                r = (r & 1 ? (Uint32)0xEDB88320L : 0) ^ r >> 1;
+            }
+            crc32_table[0][i] = r;
+        }
+        for (k = 1; k < 8; ++k) {
+            for (i = 0; i < 256; ++i) {
+                const Uint32 prev = crc32_table[k - 1][i];
+                crc32_table[k][i] = (prev >> 8) ^ crc32_table[0][prev & 0xFF];
+            }
+        }
+        SDL_AtomicSet(&crc32_table_ready, 1);
+    }
+    SDL_UnlockSpinlock(&crc32_table_lock);
 }
 
-Uint32 SDL_crc32(Uint32 crc, const void *data, size_t len)
+static Uint32 crc32_slice8(Uint32 crc, const Uint8 *data, size_t len)
 {
-    /* As an optimization we can precalculate a 256 entry table for each byte */
-    size_t i;
-    for (i = 0; i < len; ++i) {
-        crc = crc32_for_byte((Uint8)crc ^ ((const Uint8 *)data)[i]) ^ crc >> 8;
+    while (len >= 8) {
+        const Uint32 lo = crc ^ ((Uint32)data[0] | ((Uint32)data[1] << 8) | ((Uint32)data[2] << 16) | ((Uint32)data[3] << 24));
+        crc = crc32_table[7][lo & 0xFF] ^
+              crc32_table[6][(lo >> 8) & 0xFF] ^
+              crc32_table[5][(lo >> 16) & 0xFF] ^
+              crc32_table[4][lo >> 24] ^
+              crc32_table[3][data[4]] ^
+              crc32_table[2][data[5]] ^
+              crc32_table[1][data[6]] ^
+              crc32_table[0][data[7]];
+        data += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = crc32_table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#else
+
+static Uint32 crc32_armv8(Uint32 crc, const Uint8 *data, size_t len)
+{
+    while (len && ((uintptr_t)data & 7)) {
+        crc = __crc32b(crc, *data++);
+        --len;
+    }
+    while (len >= 8) {
+        Uint64 value;
+        SDL_memcpy(&value, data, sizeof(value));
+        crc = __crc32d(crc, SDL_Swap64LE(value));
+        data += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = __crc32b(crc, *data++);
     }
     return crc;
 }
+#endif /* !SDL_CRC32_ARMV8 */
+
+#ifdef SDL_CRC32_PCLMUL
+/* Folding with carry-less multiplication, from Intel's paper "Fast CRC
+   Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+   This needs at least 64 bytes and a multiple of 16 bytes. */
+static Uint32 SDL_TARGETING("pclmul,sse4.1") crc32_pclmul(Uint32 crc, const Uint8 *data, size_t len)
+{
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    data += 64;
+    len -= 64;
+
+    /* Fold 64 bytes at a time */
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(data + 0x30)));
+        data += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one */
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold any remaining 16 byte blocks */
+    while (len >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)data)), x5);
+        data += 16;
+        len -= 16;
+    }
+
+    /* Fold 128 bits down to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction down to 32 bits */
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (Uint32)_mm_extract_epi32(x1, 1);
+}
+#endif /* SDL_CRC32_PCLMUL */
+
+Uint32 SDL_crc32(Uint32 crc, const void *data, size_t len)
+{
+    const Uint8 *bytes = (const Uint8 *)data;
+
+    crc = ~crc;
+
+#ifdef SDL_CRC32_ARMV8
+    crc = crc32_armv8(crc, bytes, len);
+    return ~crc;
+#else
+#ifdef SDL_CRC32_PCLMUL
+    if (len >= 64 && SDL_HasPCLMUL() && SDL_HasSSE41()) {
+        const size_t chunk = len & ~(size_t)15;
+        crc = crc32_pclmul(crc, bytes, chunk);
+        bytes += chunk;
+        len -= chunk;
+    }
+#endif
+    crc32_init_table();
+    crc = crc32_slice8(crc, bytes, len);
+    return ~crc;
+#endif
+}
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_sysstdlib.h"
+
 /* This file contains portable iconv functions for SDL */
 
 #if defined(HAVE_ICONV) && defined(HAVE_ICONV_H)
@@ -787,6 +789,63 @@ int SDL_iconv_close(SDL_iconv_t cd)
 
 #endif /* !HAVE_ICONV */
 
+/* Encodings that represent 7-bit ASCII as a single fixed-width code unit,
+   without a byte order marker, so ASCII runs can be widened directly. */
+static const struct
+{
+    const char *name;
+    Uint8 width;
+    SDL_bool big_endian;
+} ascii_encodings[] = {
+    /* *INDENT-OFF* */ /* clang-format off */
+    { "ASCII", 1, SDL_FALSE },
+    { "US-ASCII", 1, SDL_FALSE },
+    { "UTF8", 1, SDL_FALSE },
+    { "UTF-8", 1, SDL_FALSE },
+    { "UTF16BE", 2, SDL_TRUE },
+    { "UTF-16BE", 2, SDL_TRUE },
+    { "UTF16LE", 2, SDL_FALSE },
+    { "UTF-16LE", 2, SDL_FALSE },
+    { "UCS-2BE", 2, SDL_TRUE },
+    { "UCS-2LE", 2, SDL_FALSE },
+    { "UTF32BE", 4, SDL_TRUE },
+    { "UTF-32BE", 4, SDL_TRUE },
+    { "UTF32LE", 4, SDL_FALSE },
+    { "UTF-32LE", 4, SDL_FALSE },
+    { "UCS-4BE", 4, SDL_TRUE },
+    { "UCS-4LE", 4, SDL_FALSE },
+    /* *INDENT-ON* */ /* clang-format on */
+};
+
+static size_t SDL_GetASCIIEncodingWidth(const char *code, SDL_bool *big_endian)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(ascii_encodings); ++i) {
+        if (SDL_strcasecmp(code, ascii_encodings[i].name) == 0) {
+            *big_endian = ascii_encodings[i].big_endian;
+            return ascii_encodings[i].width;
+        }
+    }
+    return 0;
+}
+
+static void SDL_WidenASCII(char *dst, const char *src, size_t len, size_t width, SDL_bool big_endian)
+{
+    const size_t offset = big_endian ? (width - 1) : 0;
+    size_t i;
+
+    if (width == 1) {
+        SDL_memcpy(dst, src, len);
+        return;
+    }
+
+    SDL_memset(dst, 0, len * width);
+    for (i = 0; i < len; ++i) {
+        dst[i * width + offset] = src[i];
+    }
+}
+
 char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft)
 {
     SDL_iconv_t cd;
@@ -795,6 +854,8 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
     char *outbuf;
     size_t outbytesleft;
     size_t retCode = 0;
+    size_t ascii, ascii_width;
+    SDL_bool big_endian = SDL_FALSE;
 
     if (!tocode || !*tocode) {
         tocode = "UTF-8";
@@ -807,7 +868,17 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
         return NULL;
     }
 
-    stringsize = inbytesleft;
+    /* Most text is largely ASCII, convert the leading run of it ourselves */
+    ascii = 0;
+    ascii_width = 0;
+    if (SDL_GetASCIIEncodingWidth(fromcode, &big_endian) == 1) {
+        ascii_width = SDL_GetASCIIEncodingWidth(tocode, &big_endian);
+        if (ascii_width) {
+            ascii = SDL_ScanASCII(inbuf, inbytesleft);
+        }
+    }
+
+    stringsize = inbytesleft + ascii * (ascii_width - 1);
     string = (char *)SDL_malloc(stringsize + sizeof(Uint32));
     if (!string) {
         SDL_iconv_close(cd);
@@ -817,6 +888,14 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
     outbytesleft = stringsize;
     SDL_memset(outbuf, 0, sizeof(Uint32));
 
+    if (ascii) {
+        SDL_WidenASCII(outbuf, inbuf, ascii, ascii_width, big_endian);
+        inbuf += ascii;
+        inbytesleft -= ascii;
+        outbuf += ascii * ascii_width;
+        outbytesleft -= ascii * ascii_width;
+    }
+
     while (inbytesleft > 0) {
         const size_t oldinbytesleft = inbytesleft;
         retCode = SDL_iconv(cd, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "../thread/SDL_thread_c.h"
+
 /* This file contains portable memory management functions for SDL */
 
 #ifndef HAVE_MALLOC
@@ -5189,11 +5191,165 @@ static void* SDLCALL real_malloc(size_t s) { return malloc(s); }
 static void* SDLCALL real_calloc(size_t n, size_t s) { return calloc(n, s); }
 static void* SDLCALL real_realloc(void *p, size_t s) { return realloc(p,s); }
 static void  SDLCALL real_free(void *p) { free(p); }
+void SDL_EnableMemoryCache(void)
+{
+}
+
+void SDL_FlushMemoryCache(void)
+{
+}
+#elif defined(SDL_THREAD_LOCAL)
+/* dlmalloc takes a global lock for every call, so each thread keeps a few
+   freed small blocks around and reuses them without touching the heap.
+   Only threads that SDL flushes before they exit keep a cache, other
+   threads would leak it since there's no portable thread exit hook. */
+#define SDL_MEMORY_CACHE_CLASSES    8
+#define SDL_MEMORY_CACHE_DEPTH      32
+
+static const size_t SDL_memory_cache_sizes[SDL_MEMORY_CACHE_CLASSES] = {
+    16, 32, 48, 64, 96, 128, 192, 256
+};
+
+typedef struct SDL_CachedBlock
+{
+    struct SDL_CachedBlock *next;
+} SDL_CachedBlock;
+
+typedef struct SDL_MemoryCache
+{
+    SDL_CachedBlock *blocks[SDL_MEMORY_CACHE_CLASSES];
+    int count[SDL_MEMORY_CACHE_CLASSES];
+    SDL_bool enabled;
+} SDL_MemoryCache;
+
+static SDL_THREAD_LOCAL SDL_MemoryCache SDL_memory_cache;
+
+/* The smallest class that can hold an allocation of this size */
+static int SDL_GetMemoryCacheClass(size_t size)
+{
+    int i;
+
+    for (i = 0; i < SDL_MEMORY_CACHE_CLASSES; ++i) {
+        if (size <= SDL_memory_cache_sizes[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* The largest class a freed block of this usable size can serve */
+static int SDL_GetFreedMemoryCacheClass(size_t usable)
+{
+    int i;
+
+    if (usable > SDL_memory_cache_sizes[SDL_MEMORY_CACHE_CLASSES - 1] + SDL_memory_cache_sizes[0]) {
+        return -1;  /* too big, caching it would waste memory */
+    }
+    for (i = SDL_MEMORY_CACHE_CLASSES - 1; i >= 0; --i) {
+        if (usable >= SDL_memory_cache_sizes[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void* SDLCALL real_malloc(size_t size)
+{
+    const int c = SDL_GetMemoryCacheClass(size);
+
+    if (c >= 0) {
+        SDL_MemoryCache *cache = &SDL_memory_cache;
+        SDL_CachedBlock *block = cache->blocks[c];
+        if (block) {
+            cache->blocks[c] = block->next;
+            --cache->count[c];
+            return block;
+        }
+        /* Round up so the block goes back into the same class when it's freed */
+        return dlmalloc(SDL_memory_cache_sizes[c]);
+    }
+    return dlmalloc(size);
+}
+
+static void* SDLCALL real_calloc(size_t n, size_t s)
+{
+    size_t size;
+    void *mem;
+
+    if (SDL_size_mul_overflow(n, s, &size) != 0 || SDL_GetMemoryCacheClass(size) < 0) {
+        return dlcalloc(n, s);
+    }
+    mem = real_malloc(size);
+    if (mem) {
+        SDL_memset(mem, 0, size);
+    }
+    return mem;
+}
+
+static void* SDLCALL real_realloc(void *p, size_t s)
+{
+    if (!p) {
+        return real_malloc(s);
+    }
+    return dlrealloc(p, s);
+}
+
+static void SDLCALL real_free(void *p)
+{
+    int c;
+
+    if (!p) {
+        return;
+    }
+
+    c = SDL_GetFreedMemoryCacheClass(dlmalloc_usable_size(p));
+    if (c >= 0) {
+        SDL_MemoryCache *cache = &SDL_memory_cache;
+        if (cache->enabled && cache->count[c] < SDL_MEMORY_CACHE_DEPTH) {
+            SDL_CachedBlock *block = (SDL_CachedBlock *)p;
+            block->next = cache->blocks[c];
+            cache->blocks[c] = block;
+            ++cache->count[c];
+            return;
+        }
+    }
+    dlfree(p);
+}
+
+void SDL_EnableMemoryCache(void)
+{
+    SDL_memory_cache.enabled = SDL_TRUE;
+}
+
+void SDL_FlushMemoryCache(void)
+{
+    SDL_MemoryCache *cache = &SDL_memory_cache;
+    int i;
+
+    /* Anything freed after this goes straight back to the heap */
+    cache->enabled = SDL_FALSE;
+    for (i = 0; i < SDL_MEMORY_CACHE_CLASSES; ++i) {
+        while (cache->blocks[i]) {
+            SDL_CachedBlock *block = cache->blocks[i];
+            cache->blocks[i] = block->next;
+            dlfree(block);
+        }
+        cache->count[i] = 0;
+    }
+}
 #else
 #define real_malloc dlmalloc
 #define real_calloc dlcalloc
 #define real_realloc dlrealloc
 #define real_free dlfree
+
+void SDL_EnableMemoryCache(void)
+{
+}
+
+void SDL_FlushMemoryCache(void)
+{
+}
 #endif
 
 /* Memory functions used by SDL that can be replaced by the application */
@@ -5340,3 +5496,117 @@ void SDL_free(void *ptr)
     s_mem.free_func(ptr);
     (void)SDL_AtomicDecRef(&s_mem.num_allocations);
 }
+
+/* The default size of the blocks memory arenas allocate from */
+#define SDL_MEMORY_ARENA_BLOCK_SIZE (64 * 1024)
+
+/* Arena allocations are aligned like malloc() */
+#define SDL_MEMORY_ARENA_ALIGNMENT  (2 * sizeof(void *))
+
+typedef struct SDL_MemoryArenaBlock
+{
+    struct SDL_MemoryArenaBlock *next;
+    size_t size;
+    size_t used;
+    void *padding;  /* keeps the data after the header aligned */
+} SDL_MemoryArenaBlock;
+
+struct SDL_MemoryArena
+{
+    SDL_MemoryArenaBlock *blocks;
+    SDL_MemoryArenaBlock *current;
+    size_t block_size;
+};
+
+SDL_MemoryArena *SDL_CreateMemoryArena(size_t block_size)
+{
+    SDL_MemoryArena *arena = (SDL_MemoryArena *)SDL_calloc(1, sizeof(*arena));
+    if (!arena) {
+        return NULL;
+    }
+    arena->block_size = block_size ? block_size : SDL_MEMORY_ARENA_BLOCK_SIZE;
+    return arena;
+}
+
+void *SDL_AllocateArenaMemory(SDL_MemoryArena *arena, size_t size)
+{
+    SDL_MemoryArenaBlock *block, *last;
+    size_t block_size;
+    void *mem;
+
+    if (!arena) {
+        SDL_InvalidParamError("arena");
+        return NULL;
+    }
+
+    if (!size) {
+        size = 1;
+    }
+    if (SDL_size_add_overflow(size, SDL_MEMORY_ARENA_ALIGNMENT - 1, &size) != 0) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    size &= ~(SDL_MEMORY_ARENA_ALIGNMENT - 1);
+
+    /* Use the current block, or a block left over from before the last reset */
+    last = NULL;
+    for (block = arena->current; block; block = block->next) {
+        if (size <= block->size - block->used) {
+            break;
+        }
+        last = block;
+    }
+
+    if (!block) {
+        block_size = SDL_max(size, arena->block_size);
+        if (SDL_size_add_overflow(block_size, sizeof(*block), &block_size) != 0) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        block = (SDL_MemoryArenaBlock *)SDL_malloc(block_size);
+        if (!block) {
+            return NULL;
+        }
+        block->next = NULL;
+        block->size = block_size - sizeof(*block);
+        block->used = 0;
+        if (last) {
+            last->next = block;
+        } else {
+            arena->blocks = block;
+        }
+    }
+    arena->current = block;
+
+    mem = (Uint8 *)(block + 1) + block->used;
+    block->used += size;
+    return mem;
+}
+
+void SDL_ResetMemoryArena(SDL_MemoryArena *arena)
+{
+    SDL_MemoryArenaBlock *block;
+
+    if (!arena) {
+        return;
+    }
+
+    for (block = arena->blocks; block; block = block->next) {
+        block->used = 0;
+    }
+    arena->current = arena->blocks;
+}
+
+void SDL_DestroyMemoryArena(SDL_MemoryArena *arena)
+{
+    if (!arena) {
+        return;
+    }
+
+    while (arena->blocks) {
+        SDL_MemoryArenaBlock *block = arena->blocks;
+        arena->blocks = block->next;
+        SDL_free(block);
+    }
+    SDL_free(arena);
+}
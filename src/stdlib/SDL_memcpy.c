@@ -20,6 +20,16 @@
 */
 #include "SDL_internal.h"
 
+/* Without a C runtime, use vector copies where the target always has them.
+   There's no runtime dispatch here, since the CPU detection code copies
+   memory itself. */
+#if !(defined(__GNUC__) && (defined(HAVE_LIBC) && HAVE_LIBC)) && !defined(HAVE_MEMCPY) && !defined(HAVE_BCOPY)
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_MEMCPY_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SDL_MEMCPY_NEON
+#endif
+#endif
 
 #ifdef SDL_memcpy
 #undef SDL_memcpy
@@ -40,31 +50,98 @@ void *SDL_memcpy(SDL_OUT_BYTECAP(len) void *dst, SDL_IN_BYTECAP(len) const void
     bcopy(src, dst, len);
     return dst;
 #else
+    Uint8 *dstp1 = (Uint8 *)dst;
+    const Uint8 *srcp1 = (const Uint8 *)src;
+
+#if defined(SDL_MEMCPY_SSE2)
+    if (len >= 64) {
+        __m128i a, b, c, d;
+
+        /* Align the destination, the source can stay unaligned */
+        while ((uintptr_t)dstp1 & 15) {
+            *dstp1++ = *srcp1++;
+            --len;
+        }
+
+        if (len >= SDL_NONTEMPORAL_THRESHOLD) {
+            while (len >= 64) {
+                a = _mm_loadu_si128((const __m128i *)(srcp1 + 0));
+                b = _mm_loadu_si128((const __m128i *)(srcp1 + 16));
+                c = _mm_loadu_si128((const __m128i *)(srcp1 + 32));
+                d = _mm_loadu_si128((const __m128i *)(srcp1 + 48));
+                _mm_stream_si128((__m128i *)(dstp1 + 0), a);
+                _mm_stream_si128((__m128i *)(dstp1 + 16), b);
+                _mm_stream_si128((__m128i *)(dstp1 + 32), c);
+                _mm_stream_si128((__m128i *)(dstp1 + 48), d);
+                srcp1 += 64;
+                dstp1 += 64;
+                len -= 64;
+            }
+            _mm_sfence();
+        } else {
+            while (len >= 64) {
+                a = _mm_loadu_si128((const __m128i *)(srcp1 + 0));
+                b = _mm_loadu_si128((const __m128i *)(srcp1 + 16));
+                c = _mm_loadu_si128((const __m128i *)(srcp1 + 32));
+                d = _mm_loadu_si128((const __m128i *)(srcp1 + 48));
+                _mm_store_si128((__m128i *)(dstp1 + 0), a);
+                _mm_store_si128((__m128i *)(dstp1 + 16), b);
+                _mm_store_si128((__m128i *)(dstp1 + 32), c);
+                _mm_store_si128((__m128i *)(dstp1 + 48), d);
+                srcp1 += 64;
+                dstp1 += 64;
+                len -= 64;
+            }
+        }
+        while (len >= 16) {
+            _mm_store_si128((__m128i *)dstp1, _mm_loadu_si128((const __m128i *)srcp1));
+            srcp1 += 16;
+            dstp1 += 16;
+            len -= 16;
+        }
+    }
+#elif defined(SDL_MEMCPY_NEON)
+    while (len >= 64) {
+        const uint8x16_t a = vld1q_u8(srcp1 + 0);
+        const uint8x16_t b = vld1q_u8(srcp1 + 16);
+        const uint8x16_t c = vld1q_u8(srcp1 + 32);
+        const uint8x16_t d = vld1q_u8(srcp1 + 48);
+        vst1q_u8(dstp1 + 0, a);
+        vst1q_u8(dstp1 + 16, b);
+        vst1q_u8(dstp1 + 32, c);
+        vst1q_u8(dstp1 + 48, d);
+        srcp1 += 64;
+        dstp1 += 64;
+        len -= 64;
+    }
+    while (len >= 16) {
+        vst1q_u8(dstp1, vld1q_u8(srcp1));
+        srcp1 += 16;
+        dstp1 += 16;
+        len -= 16;
+    }
+#endif
+
     /* GCC 4.9.0 with -O3 will generate movaps instructions with the loop
        using Uint32* pointers, so we need to make sure the pointers are
        aligned before we loop using them.
      */
-    if (((uintptr_t)src & 0x3) || ((uintptr_t)dst & 0x3)) {
+    if (((uintptr_t)srcp1 & 0x3) || ((uintptr_t)dstp1 & 0x3)) {
         /* Do an unaligned byte copy */
-        Uint8 *srcp1 = (Uint8 *)src;
-        Uint8 *dstp1 = (Uint8 *)dst;
-
         while (len--) {
             *dstp1++ = *srcp1++;
         }
     } else {
         size_t left = (len % 4);
-        Uint32 *srcp4, *dstp4;
-        Uint8 *srcp1, *dstp1;
+        Uint32 *dstp4 = (Uint32 *)dstp1;
+        const Uint32 *srcp4 = (const Uint32 *)srcp1;
 
-        srcp4 = (Uint32 *)src;
-        dstp4 = (Uint32 *)dst;
         len /= 4;
         while (len--) {
             *dstp4++ = *srcp4++;
         }
 
-        srcp1 = (Uint8 *)srcp4;
+        srcp1 = (const Uint8 *)srcp4;
         dstp1 = (Uint8 *)dstp4;
         switch (left) {
         case 3:
@@ -20,6 +20,14 @@
 */
 #include "SDL_internal.h"
 
+/* Without a C runtime, use vector stores where the target always has them */
+#if !(defined(__GNUC__) && (defined(HAVE_LIBC) && HAVE_LIBC)) && !defined(HAVE_MEMSET)
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_MEMSET_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SDL_MEMSET_NEON
+#endif
+#endif
 
 #ifdef SDL_memset
 #undef SDL_memset
@@ -55,6 +63,52 @@ void *SDL_memset(SDL_OUT_BYTECAP(len) void *dst, int c, size_t len)
         }
     }
 
+#if defined(SDL_MEMSET_SSE2)
+    if (len >= 64) {
+        const __m128i value16 = _mm_set1_epi8((char)value1);
+
+        while ((uintptr_t)dstp1 & 15) {
+            *dstp1++ = value1;
+            --len;
+        }
+
+        if (len >= SDL_NONTEMPORAL_THRESHOLD) {
+            while (len >= 64) {
+                _mm_stream_si128((__m128i *)(dstp1 + 0), value16);
+                _mm_stream_si128((__m128i *)(dstp1 + 16), value16);
+                _mm_stream_si128((__m128i *)(dstp1 + 32), value16);
+                _mm_stream_si128((__m128i *)(dstp1 + 48), value16);
+                dstp1 += 64;
+                len -= 64;
+            }
+            _mm_sfence();
+        }
+        while (len >= 16) {
+            _mm_store_si128((__m128i *)dstp1, value16);
+            dstp1 += 16;
+            len -= 16;
+        }
+    }
+#elif defined(SDL_MEMSET_NEON)
+    if (len >= 16) {
+        const uint8x16_t value16 = vdupq_n_u8(value1);
+
+        while (len >= 64) {
+            vst1q_u8(dstp1 + 0, value16);
+            vst1q_u8(dstp1 + 16, value16);
+            vst1q_u8(dstp1 + 32, value16);
+            vst1q_u8(dstp1 + 48, value16);
+            dstp1 += 64;
+            len -= 64;
+        }
+        while (len >= 16) {
+            vst1q_u8(dstp1, value16);
+            dstp1 += 16;
+            len -= 16;
+        }
+    }
+#endif
+
     value4 = ((Uint32)c | ((Uint32)c << 8) | ((Uint32)c << 16) | ((Uint32)c << 24));
     dstp4 = (Uint32 *)dstp1;
     left = (len % 4);
@@ -181,16 +181,29 @@ static char _ID[]="<qsort.c gjm WITH CHANGES FOR SDL3 1.16 2021-02-20>";
  */
 #define PIVOT_THRESHOLD 40
 
-typedef struct { char * first; char * last; } stack_entry;
-#define pushLeft {stack[stacktop].first=ffirst;stack[stacktop++].last=last;}
-#define pushRight {stack[stacktop].first=first;stack[stacktop++].last=llast;}
+/* BEGIN SDL CHANGE ... each stack entry remembers how many more levels of
+   partitioning its subarray may use before it is finished off with a
+   heapsort instead, so the worst case is O(n log n). */
+typedef struct { char * first; char * last; int depth; } stack_entry;
+#define pushLeft {stack[stacktop].first=ffirst;stack[stacktop].depth=depth;stack[stacktop++].last=last;}
+#define pushRight {stack[stacktop].first=first;stack[stacktop].depth=depth;stack[stacktop++].last=llast;}
 #define doLeft {first=ffirst;llast=last;continue;}
 #define doRight {ffirst=first;last=llast;continue;}
 #define pop {if (--stacktop<0) break;\
   first=ffirst=stack[stacktop].first;\
   last=llast=stack[stacktop].last;\
+  depth=stack[stacktop].depth;\
   continue;}
 
+/* Give up on partitioning a subarray once it has been through about
+   twice as many levels as a balanced sort would need. */
+#define Introspect(sz) \
+  if (depth--<=0) {				\
+    heapsort_r(first,(size_t)(last-first)/sz+1,sz,compare,userdata);\
+    pop					\
+  }
+/* END SDL CHANGE */
+
 /* Some comments on the implementation.
  * 1. When we finish partitioning the array into "low"
  *    and "high", we forget entirely about short subarrays,
@@ -399,6 +412,44 @@ fprintf(stderr,"-> %d %d %d @ %p %p %p\n",*(int*)m1,*(int*)m2,*(int*)m3, m1,m2,m
          : (compare(userdata,m1,m3)<0 ? m1 : (compare(userdata,m2,m3)<0 ? m3 : m2));
 }
 
+/* BEGIN SDL CHANGE ... heapsort fallback for subarrays that partition badly. */
+static int max_depth(size_t nmemb) {
+  int depth=0;
+  while (nmemb>1) { nmemb>>=1; depth+=2; }
+  return depth;
+}
+
+static void heap_swap(char *a, char *b, size_t size) {
+  if ((((uintptr_t)a|(uintptr_t)b|size)&(WORD_BYTES-1))==0) {
+    SWAP_aligned(a,b);
+  } else {
+    SWAP_nonaligned(a,b);
+  }
+}
+
+static void heap_sift_down(char *base, size_t root, size_t nmemb, size_t size,
+                           int (SDLCALL * compare)(void *, const void *, const void *), void *userdata) {
+  size_t child;
+  while ((child=2*root+1)<nmemb) {
+    if (child+1<nmemb && compare(userdata,base+child*size,base+(child+1)*size)<0) ++child;
+    if (compare(userdata,base+root*size,base+child*size)>=0) break;
+    heap_swap(base+root*size,base+child*size,size);
+    root=child;
+  }
+}
+
+static void heapsort_r(char *base, size_t nmemb, size_t size,
+                       int (SDLCALL * compare)(void *, const void *, const void *), void *userdata) {
+  size_t i;
+  if (nmemb<2) return;
+  for (i=nmemb/2;i-->0;) heap_sift_down(base,i,nmemb,size,compare,userdata);
+  for (i=nmemb-1;i>0;--i) {
+    heap_swap(base,base+i*size,size);
+    heap_sift_down(base,0,i,size,compare,userdata);
+  }
+}
+/* END SDL CHANGE */
+
 /* ---------------------------------------------------------------------- */
 
 static void qsort_r_nonaligned(void *base, size_t nmemb, size_t size,
@@ -406,6 +457,7 @@ static void qsort_r_nonaligned(void *base, size_t nmemb, size_t size,
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
+  int depth=max_depth(nmemb);
   char *first,*last;
   char *pivot=malloc(size);
   size_t trunc=TRUNC_nonaligned*size;
@@ -416,6 +468,7 @@ static void qsort_r_nonaligned(void *base, size_t nmemb, size_t size,
   if ((size_t)(last-first)>=trunc) {
     char *ffirst=first, *llast=last;
     while (1) {
+      Introspect(size);
       /* Select pivot */
       { char * mid=first+size*((last-first)/size >> 1);
         Pivot(SWAP_nonaligned,size);
@@ -437,6 +490,7 @@ static void qsort_r_aligned(void *base, size_t nmemb, size_t size,
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
+  int depth=max_depth(nmemb);
   char *first,*last;
   char *pivot=malloc(size);
   size_t trunc=TRUNC_aligned*size;
@@ -447,6 +501,7 @@ static void qsort_r_aligned(void *base, size_t nmemb, size_t size,
   if ((size_t)(last-first)>=trunc) {
     char *ffirst=first,*llast=last;
     while (1) {
+      Introspect(size);
       /* Select pivot */
       { char * mid=first+size*((last-first)/size >> 1);
         Pivot(SWAP_aligned,size);
@@ -468,6 +523,7 @@ static void qsort_r_words(void *base, size_t nmemb,
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
+  int depth=max_depth(nmemb);
   char *first,*last;
   char *pivot=malloc(WORD_BYTES);
   assert(pivot != NULL);
@@ -482,6 +538,7 @@ fprintf(stderr,"Doing %d:%d: ",
         (first-(char*)base)/WORD_BYTES,
         (last-(char*)base)/WORD_BYTES);
 #endif
+      Introspect(WORD_BYTES);
       /* Select pivot */
       { char * mid=first+WORD_BYTES*((last-first) / (2*WORD_BYTES));
         Pivot(SWAP_words,WORD_BYTES);
@@ -572,3 +629,117 @@ void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size,
     return SDL_bsearch_r(key, base, nmemb, size, qsort_non_r_bridge, compare);
 }
 
+
+// LSD radix sort, one byte per pass. The keys are decoded into a separate
+// array up front so each pass only reads the element it moves.
+static int SDL_RadixSort(void *base, size_t nmemb, size_t size, size_t key_offset, size_t key_size, SDL_RadixKeyType type)
+{
+    const Uint64 sign_bit = (Uint64)1 << (key_size * 8 - 1);
+    const size_t passes = key_size;
+    size_t (*counts)[256];
+    Uint64 *keys, *keys_out;
+    Uint8 *elements, *elements_out;
+    Uint8 *scratch;
+    size_t scratch_size, keys_size;
+    size_t i, pass;
+
+    if (!base && nmemb > 0) {
+        return SDL_InvalidParamError("base");
+    }
+    if (key_offset > size || size - key_offset < key_size) {
+        return SDL_InvalidParamError("key_offset");
+    }
+    if (type != SDL_RADIX_KEY_UNSIGNED && type != SDL_RADIX_KEY_SIGNED && type != SDL_RADIX_KEY_FLOAT) {
+        return SDL_InvalidParamError("type");
+    }
+    if (nmemb <= 1) {
+        return 0;
+    }
+
+    if (SDL_size_mul_overflow(nmemb, 2 * sizeof(Uint64), &keys_size) != 0 ||
+        SDL_size_mul_overflow(nmemb, size, &scratch_size) != 0 ||
+        SDL_size_add_overflow(scratch_size, keys_size, &scratch_size) != 0 ||
+        SDL_size_add_overflow(scratch_size, passes * sizeof(*counts), &scratch_size) != 0) {
+        return SDL_OutOfMemory();
+    }
+    scratch = (Uint8 *)SDL_calloc(1, scratch_size);
+    if (!scratch) {
+        return -1;
+    }
+    keys = (Uint64 *)scratch;
+    keys_out = keys + nmemb;
+    counts = (size_t (*)[256])(keys_out + nmemb);
+    elements = (Uint8 *)base;
+    elements_out = (Uint8 *)(counts + passes);
+
+    // Map every key type onto unsigned ordering and count all the digits in one go
+    for (i = 0; i < nmemb; ++i) {
+        Uint64 key;
+        if (key_size == sizeof(Uint32)) {
+            Uint32 key32;
+            memcpy(&key32, elements + i * size + key_offset, sizeof(key32));
+            key = key32;
+        } else {
+            memcpy(&key, elements + i * size + key_offset, sizeof(key));
+        }
+        if (type == SDL_RADIX_KEY_SIGNED) {
+            key ^= sign_bit;
+        } else if (type == SDL_RADIX_KEY_FLOAT) {
+            key = (key & sign_bit) ? (~key & (sign_bit | (sign_bit - 1))) : (key ^ sign_bit);
+        }
+        keys[i] = key;
+        for (pass = 0; pass < passes; ++pass) {
+            ++counts[pass][(key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    for (pass = 0; pass < passes; ++pass) {
+        const unsigned int shift = (unsigned int)(pass * 8);
+        size_t *count = counts[pass];
+        size_t offset = 0;
+
+        // Every key has the same digit here, so this pass wouldn't move anything
+        if (count[keys[0] >> shift & 0xFF] == nmemb) {
+            continue;
+        }
+
+        for (i = 0; i < 256; ++i) {
+            const size_t n = count[i];
+            count[i] = offset;
+            offset += n;
+        }
+
+        for (i = 0; i < nmemb; ++i) {
+            const Uint64 key = keys[i];
+            const size_t dst = count[key >> shift & 0xFF]++;
+            keys_out[dst] = key;
+            memcpy(elements_out + dst * size, elements + i * size, size);
+        }
+
+        {
+            Uint64 *keys_tmp = keys;
+            Uint8 *elements_tmp = elements;
+            keys = keys_out;
+            keys_out = keys_tmp;
+            elements = elements_out;
+            elements_out = elements_tmp;
+        }
+    }
+
+    if (elements != (Uint8 *)base) {
+        memcpy(base, elements, nmemb * size);
+    }
+    SDL_free(scratch);
+
+    return 0;
+}
+
+int SDL_RadixSort32(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_RadixKeyType type)
+{
+    return SDL_RadixSort(base, nmemb, size, key_offset, sizeof(Uint32), type);
+}
+
+int SDL_RadixSort64(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_RadixKeyType type)
+{
+    return SDL_RadixSort(base, nmemb, size, key_offset, sizeof(Uint64), type);
+}
@@ -174,7 +174,7 @@ float SDL_cosf(float x)
 #ifdef HAVE_COSF
     return cosf(x);
 #else
-    return (float)SDL_cos((double)x);
+    return SDL_uclibc_cosf(x);
 #endif
 }
 
@@ -192,7 +192,7 @@ float SDL_expf(float x)
 #ifdef HAVE_EXPF
     return expf(x);
 #else
-    return (float)SDL_exp((double)x);
+    return SDL_uclibc_expf(x);
 #endif
 }
 
@@ -326,7 +326,7 @@ float SDL_logf(float x)
 #ifdef HAVE_LOGF
     return logf(x);
 #else
-    return (float)SDL_log((double)x);
+    return SDL_uclibc_logf(x);
 #endif
 }
 
@@ -383,7 +383,7 @@ float SDL_powf(float x, float y)
 #ifdef HAVE_POWF
     return powf(x, y);
 #else
-    return (float)SDL_pow((double)x, (double)y);
+    return SDL_uclibc_powf(x, y);
 #endif
 }
 
@@ -465,7 +465,7 @@ float SDL_sinf(float x)
 #ifdef HAVE_SINF
     return sinf(x);
 #else
-    return (float)SDL_sin((double)x);
+    return SDL_uclibc_sinf(x);
 #endif
 }
 
@@ -483,7 +483,7 @@ float SDL_sqrtf(float x)
 #ifdef HAVE_SQRTF
     return sqrtf(x);
 #else
-    return (float)SDL_sqrt((double)x);
+    return SDL_uclibc_sqrtf(x);
 #endif
 }
 
@@ -153,6 +153,52 @@ int SDL_CaseFoldUnicode(const Uint32 from, Uint32 *to)
     return 1;
 }
 
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_SCAN_ASCII_SSE2  // always available on this target, no need for a runtime check.
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SDL_SCAN_ASCII_NEON
+#endif
+
+size_t SDL_ScanASCII(const char *str, size_t len)
+{
+    const Uint8 *start = (const Uint8 *) str;
+    const Uint8 *s = start;
+
+#if defined(SDL_SCAN_ASCII_SSE2)
+    while (len >= 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *) s)) != 0) {
+            break;
+        }
+        s += 16;
+        len -= 16;
+    }
+#elif defined(SDL_SCAN_ASCII_NEON)
+    while (len >= 16) {
+        if (vmaxvq_u8(vld1q_u8(s)) >= 0x80) {
+            break;
+        }
+        s += 16;
+        len -= 16;
+    }
+#else
+    while (len >= sizeof(Uint64)) {
+        Uint64 word;
+        SDL_memcpy(&word, s, sizeof(word));
+        if (word & 0x8080808080808080ull) {
+            break;
+        }
+        s += sizeof(word);
+        len -= sizeof(word);
+    }
+#endif
+
+    while (len && *s < 0x80) {
+        ++s;
+        --len;
+    }
+    return (size_t) (s - start);
+}
+
 #define UNICODE_STRCASECMP(bits, slen1, slen2, update_slen1, update_slen2) \
     Uint32 folded1[3], folded2[3]; \
     int head1 = 0, tail1 = 0, head2 = 0, tail2 = 0; \
@@ -892,7 +938,15 @@ size_t SDL_utf8strlcpy(SDL_OUT_Z_CAP(dst_bytes) char *dst, const char *src, size
 size_t SDL_utf8strlen(const char *str)
 {
     size_t retval = 0;
-    while (SDL_StepUTF8(&str, NULL)) {
+    while (SDL_TRUE) {
+        // ASCII is one codepoint per byte, don't bother decoding it.
+        while ((Uint8) (*str - 1) < 0x7F) {
+            ++str;
+            ++retval;
+        }
+        if (!SDL_StepUTF8(&str, NULL)) {
+            break;
+        }
         retval++;
     }
     return retval;
@@ -901,7 +955,21 @@ size_t SDL_utf8strlen(const char *str)
 size_t SDL_utf8strnlen(const char *str, size_t bytes)
 {
     size_t retval = 0;
-    while (SDL_StepUTF8(&str, &bytes)) {
+    while (SDL_TRUE) {
+        // ASCII is one codepoint per byte, but the run might hold the null terminator.
+        const size_t ascii = SDL_ScanASCII(str, bytes);
+        if (ascii) {
+            const size_t len = SDL_strnlen(str, ascii);
+            retval += len;
+            if (len < ascii) {
+                break;
+            }
+            str += ascii;
+            bytes -= ascii;
+        }
+        if (!SDL_StepUTF8(&str, &bytes)) {
+            break;
+        }
         retval++;
     }
     return retval;
@@ -1341,15 +1409,35 @@ int SDL_strncmp(const char *str1, const char *str2, size_t maxlen)
 #endif /* HAVE_STRNCMP */
 }
 
+// ASCII only ever folds to ASCII, so matching runs of it can be compared a byte at a time.
+#define ASCII_FOLD(c) ((((c) >= 'A') && ((c) <= 'Z')) ? ((c) + ('a' - 'A')) : (c))
+#define ASCII_STRCASECMP(maxlen) \
+    while ((maxlen) && ((((Uint8) *str1) | ((Uint8) *str2)) < 0x80)) { \
+        const int a = ASCII_FOLD((int) (Uint8) *str1); \
+        const int b = ASCII_FOLD((int) (Uint8) *str2); \
+        if (a != b) { \
+            return (a < b) ? -1 : 1; \
+        } else if (a == 0) { \
+            return 0; \
+        } \
+        ++str1; \
+        ++str2; \
+        --(maxlen); \
+    }
+
 int SDL_strcasecmp(const char *str1, const char *str2)
 {
+    size_t maxlen = SDL_SIZE_MAX;
+    ASCII_STRCASECMP(maxlen);
     UNICODE_STRCASECMP(8, 4, 4, (void) str1start, (void) str2start);  // always NULL-terminated, no need to adjust lengths.
 }
 
 int SDL_strncasecmp(const char *str1, const char *str2, size_t maxlen)
 {
-    size_t slen1 = maxlen;
-    size_t slen2 = maxlen;
+    size_t slen1, slen2;
+    ASCII_STRCASECMP(maxlen);
+    slen1 = maxlen;
+    slen2 = maxlen;
     UNICODE_STRCASECMP(8, slen1, slen2, slen1 -= (size_t) (str1 - ((const char *) str1start)), slen2 -= (size_t) (str2 - ((const char *) str2start)));
 }
 
@@ -28,5 +28,8 @@
 // this expects `from` to be a Unicode codepoint, and `to` to point to AT LEAST THREE Uint32s.
 int SDL_CaseFoldUnicode(const Uint32 from, Uint32 *to);
 
+// returns how many of the first `len` bytes of `str` are 7-bit ASCII (the null terminator counts).
+size_t SDL_ScanASCII(const char *str, size_t len);
+
 #endif
 
@@ -0,0 +1,591 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#include "SDL_sysstorage.h"
+#include "../SDL_hashtable.h"
+
+/* Read-only storage over a single ZIP archive. The central directory is read
+   once when the archive is opened, and every path in it goes into a hash
+   table, so looking up, enumerating and reading files never touch the host
+   filesystem beyond the archive itself. The archive is memory-mapped where
+   the platform allows it, so reads are a copy out of the mapping. */
+
+#define ZIP_LOCAL_HEADER_SIG        0x04034b50
+#define ZIP_CENTRAL_HEADER_SIG      0x02014b50
+#define ZIP_END_SIG                 0x06054b50
+#define ZIP64_END_SIG               0x06064b50
+#define ZIP64_END_LOCATOR_SIG       0x07064b50
+
+#define ZIP_LOCAL_HEADER_SIZE       30
+#define ZIP_CENTRAL_HEADER_SIZE     46
+#define ZIP_END_SIZE                22
+#define ZIP64_END_SIZE              56
+#define ZIP64_END_LOCATOR_SIZE      20
+#define ZIP_MAX_COMMENT             0xFFFF
+
+#define ZIP_FLAG_ENCRYPTED          0x0001
+#define ZIP_METHOD_STORED           0
+#define ZIP64_EXTRA_ID              0x0001
+
+#define ARCHIVE_NO_ENTRY            -1
+
+typedef struct ArchiveEntry
+{
+    char *path;             /* full path in the archive, without a trailing '/' */
+    size_t name_offset;     /* where the last component of path starts */
+    SDL_PathType type;
+    Uint64 size;
+    Uint64 compressed_size;
+    Uint64 header_offset;   /* offset of the local file header */
+    Uint16 method;
+    Uint16 flags;
+    SDL_Time modify_time;
+    int first_child;
+    int next_sibling;
+} ArchiveEntry;
+
+typedef struct ArchiveStorage
+{
+    SDL_IOStream *io;
+    const Uint8 *mapping;   /* the whole archive, if it could be mapped */
+    Uint64 archive_size;
+    SDL_Mutex *lock;        /* serializes reads through io when there's no mapping */
+    ArchiveEntry *entries;  /* entries[0] is the root directory */
+    int num_entries;
+    int max_entries;
+    SDL_HashTable *index;   /* path -> entry index */
+} ArchiveStorage;
+
+static Uint16 ARCHIVE_Read16(const Uint8 *ptr)
+{
+    return (Uint16)(ptr[0] | (ptr[1] << 8));
+}
+
+static Uint32 ARCHIVE_Read32(const Uint8 *ptr)
+{
+    return ((Uint32)ptr[0]) | ((Uint32)ptr[1] << 8) | ((Uint32)ptr[2] << 16) | ((Uint32)ptr[3] << 24);
+}
+
+static Uint64 ARCHIVE_Read64(const Uint8 *ptr)
+{
+    return ((Uint64)ARCHIVE_Read32(ptr)) | ((Uint64)ARCHIVE_Read32(ptr + 4) << 32);
+}
+
+static int ARCHIVE_ReadAt(ArchiveStorage *archive, Uint64 offset, void *destination, Uint64 length)
+{
+    int result = 0;
+
+    if (offset > archive->archive_size || length > (archive->archive_size - offset)) {
+        return SDL_SetError("Archive is truncated");
+    }
+    if (length > SDL_SIZE_MAX) {
+        return SDL_SetError("Read size exceeds SDL_SIZE_MAX");
+    }
+
+    if (archive->mapping) {
+        SDL_memcpy(destination, archive->mapping + offset, (size_t)length);
+        return 0;
+    }
+
+    SDL_LockMutex(archive->lock);
+    if (SDL_SeekIO(archive->io, (Sint64)offset, SDL_IO_SEEK_SET) < 0 ||
+        SDL_ReadIO(archive->io, destination, (size_t)length) != length) {
+        result = -1;
+    }
+    SDL_UnlockMutex(archive->lock);
+
+    return result;
+}
+
+static SDL_Time ARCHIVE_ConvertDOSTime(Uint16 dos_time, Uint16 dos_date)
+{
+    SDL_DateTime dt;
+    SDL_Time result = 0;
+
+    if (dos_date == 0) {
+        return 0;
+    }
+
+    SDL_zero(dt);
+    dt.year = 1980 + (dos_date >> 9);
+    dt.month = (dos_date >> 5) & 0x0F;
+    dt.day = dos_date & 0x1F;
+    dt.hour = dos_time >> 11;
+    dt.minute = (dos_time >> 5) & 0x3F;
+    dt.second = (dos_time & 0x1F) * 2;
+    if (SDL_DateTimeToTime(&dt, &result) < 0) {
+        result = 0;
+    }
+    return result;
+}
+
+/* Strip the leading and trailing slashes and any "./" from an application path */
+static const char *ARCHIVE_NormalizePath(const char *path, size_t *length)
+{
+    size_t len;
+
+    for (;;) {
+        if (*path == '/') {
+            ++path;
+        } else if (path[0] == '.' && (path[1] == '/' || path[1] == '\0')) {
+            ++path;
+        } else {
+            break;
+        }
+    }
+
+    len = SDL_strlen(path);
+    while (len > 0 && path[len - 1] == '/') {
+        --len;
+    }
+    *length = len;
+    return path;
+}
+
+static ArchiveEntry *ARCHIVE_FindEntry(ArchiveStorage *archive, const char *path)
+{
+    const void *value;
+    size_t len;
+    char *key;
+    SDL_bool isstack;
+    SDL_bool found;
+
+    path = ARCHIVE_NormalizePath(path, &len);
+    if (path[len] == '\0') {
+        found = SDL_FindInHashTable(archive->index, path, &value);
+    } else {
+        key = SDL_small_alloc(char, len + 1, &isstack);
+        if (!key) {
+            return NULL;
+        }
+        SDL_memcpy(key, path, len);
+        key[len] = '\0';
+        found = SDL_FindInHashTable(archive->index, key, &value);
+        SDL_small_free(key, isstack);
+    }
+
+    if (!found) {
+        SDL_SetError("Path not found in archive");
+        return NULL;
+    }
+    return &archive->entries[(uintptr_t)value];
+}
+
+/* Add an entry for the path, and for any of its parents that aren't in the
+   archive yet. Returns the index of the entry, or ARCHIVE_NO_ENTRY on
+   failure. `path` is modified temporarily while walking its parents. */
+static int ARCHIVE_AddEntry(ArchiveStorage *archive, char *path, size_t len, SDL_PathType type)
+{
+    const void *value;
+    ArchiveEntry *entry;
+    int index, parent = 0;
+    char saved = path[len];
+    size_t name_offset = 0;
+    size_t i;
+
+    path[len] = '\0';
+    if (SDL_FindInHashTable(archive->index, path, &value)) {
+        path[len] = saved;
+        return (int)(uintptr_t)value;
+    }
+
+    /* Make sure the parent directory exists first */
+    for (i = len; i > 0; --i) {
+        if (path[i - 1] == '/') {
+            name_offset = i;
+            break;
+        }
+    }
+    if (name_offset > 0) {
+        parent = ARCHIVE_AddEntry(archive, path, name_offset - 1, SDL_PATHTYPE_DIRECTORY);
+        if (parent == ARCHIVE_NO_ENTRY) {
+            path[len] = saved;
+            return ARCHIVE_NO_ENTRY;
+        }
+    } else if (len == 0) {
+        parent = ARCHIVE_NO_ENTRY;  /* this is the root */
+    }
+
+    if (archive->num_entries == archive->max_entries) {
+        int max_entries = archive->max_entries ? archive->max_entries * 2 : 64;
+        ArchiveEntry *entries = (ArchiveEntry *)SDL_realloc(archive->entries, max_entries * sizeof(*entries));
+        if (!entries) {
+            path[len] = saved;
+            return ARCHIVE_NO_ENTRY;
+        }
+        archive->entries = entries;
+        archive->max_entries = max_entries;
+    }
+
+    index = archive->num_entries;
+    entry = &archive->entries[index];
+    SDL_zerop(entry);
+    entry->path = SDL_strdup(path);
+    path[len] = saved;
+    if (!entry->path) {
+        return ARCHIVE_NO_ENTRY;
+    }
+    entry->name_offset = name_offset;
+    entry->type = type;
+    entry->first_child = ARCHIVE_NO_ENTRY;
+    entry->next_sibling = ARCHIVE_NO_ENTRY;
+
+    if (!SDL_InsertIntoHashTable(archive->index, entry->path, (const void *)(uintptr_t)index)) {
+        SDL_free(entry->path);
+        return ARCHIVE_NO_ENTRY;
+    }
+    ++archive->num_entries;
+
+    if (parent != ARCHIVE_NO_ENTRY) {
+        entry->next_sibling = archive->entries[parent].first_child;
+        archive->entries[parent].first_child = index;
+    }
+    return index;
+}
+
+static int ARCHIVE_FindCentralDirectory(ArchiveStorage *archive, Uint64 *cd_offset, Uint64 *cd_size, Uint64 *cd_entries)
+{
+    Uint8 *tail;
+    Uint64 tail_size = SDL_min(archive->archive_size, ZIP_END_SIZE + ZIP_MAX_COMMENT);
+    Uint64 tail_offset = archive->archive_size - tail_size;
+    Uint64 end_offset = 0;
+    SDL_bool found = SDL_FALSE;
+    Sint64 i;
+
+    if (archive->archive_size < ZIP_END_SIZE) {
+        return SDL_SetError("Not a ZIP archive");
+    }
+
+    tail = (Uint8 *)SDL_malloc((size_t)tail_size);
+    if (!tail) {
+        return -1;
+    }
+    if (ARCHIVE_ReadAt(archive, tail_offset, tail, tail_size) < 0) {
+        SDL_free(tail);
+        return -1;
+    }
+
+    /* The end record is followed by a comment of unknown length, so search back for it */
+    for (i = (Sint64)(tail_size - ZIP_END_SIZE); i >= 0; --i) {
+        if (ARCHIVE_Read32(tail + i) == ZIP_END_SIG) {
+            const Uint8 *end = tail + i;
+            end_offset = tail_offset + (Uint64)i;
+            *cd_entries = ARCHIVE_Read16(end + 10);
+            *cd_size = ARCHIVE_Read32(end + 12);
+            *cd_offset = ARCHIVE_Read32(end + 16);
+            found = SDL_TRUE;
+            break;
+        }
+    }
+    SDL_free(tail);
+
+    if (!found) {
+        return SDL_SetError("Not a ZIP archive");
+    }
+
+    if (*cd_entries == 0xFFFF || *cd_size == 0xFFFFFFFF || *cd_offset == 0xFFFFFFFF) {
+        Uint8 locator[ZIP64_END_LOCATOR_SIZE];
+        Uint8 end64[ZIP64_END_SIZE];
+
+        if (end_offset < ZIP64_END_LOCATOR_SIZE ||
+            ARCHIVE_ReadAt(archive, end_offset - ZIP64_END_LOCATOR_SIZE, locator, sizeof(locator)) < 0 ||
+            ARCHIVE_Read32(locator) != ZIP64_END_LOCATOR_SIG ||
+            ARCHIVE_ReadAt(archive, ARCHIVE_Read64(locator + 8), end64, sizeof(end64)) < 0 ||
+            ARCHIVE_Read32(end64) != ZIP64_END_SIG) {
+            return SDL_SetError("Corrupt ZIP64 archive");
+        }
+        *cd_entries = ARCHIVE_Read64(end64 + 32);
+        *cd_size = ARCHIVE_Read64(end64 + 40);
+        *cd_offset = ARCHIVE_Read64(end64 + 48);
+    }
+    return 0;
+}
+
+static int ARCHIVE_ReadCentralDirectory(ArchiveStorage *archive)
+{
+    Uint64 cd_offset = 0, cd_size = 0, cd_entries = 0, n;
+    Uint8 *cd, *ptr, *end;
+    char root[1] = { '\0' };
+    int result = 0;
+
+    if (ARCHIVE_FindCentralDirectory(archive, &cd_offset, &cd_size, &cd_entries) < 0) {
+        return -1;
+    }
+
+    if (ARCHIVE_AddEntry(archive, root, 0, SDL_PATHTYPE_DIRECTORY) == ARCHIVE_NO_ENTRY) {
+        return -1;
+    }
+
+    if (cd_size > SDL_SIZE_MAX) {
+        return SDL_SetError("ZIP central directory is too large");
+    }
+    cd = (Uint8 *)SDL_malloc((size_t)cd_size + 1);
+    if (!cd) {
+        return -1;
+    }
+    if (ARCHIVE_ReadAt(archive, cd_offset, cd, cd_size) < 0) {
+        SDL_free(cd);
+        return -1;
+    }
+
+    ptr = cd;
+    end = cd + cd_size;
+    for (n = 0; n < cd_entries; ++n) {
+        Uint16 name_length, extra_length, comment_length;
+        Uint64 size, compressed_size, header_offset;
+        const Uint8 *extra;
+        char *name;
+        size_t len;
+        SDL_PathType type;
+        int index;
+
+        if ((size_t)(end - ptr) < ZIP_CENTRAL_HEADER_SIZE || ARCHIVE_Read32(ptr) != ZIP_CENTRAL_HEADER_SIG) {
+            result = SDL_SetError("Corrupt ZIP central directory");
+            break;
+        }
+
+        name_length = ARCHIVE_Read16(ptr + 28);
+        extra_length = ARCHIVE_Read16(ptr + 30);
+        comment_length = ARCHIVE_Read16(ptr + 32);
+        if ((size_t)(end - ptr) < (size_t)ZIP_CENTRAL_HEADER_SIZE + name_length + extra_length + comment_length) {
+            result = SDL_SetError("Corrupt ZIP central directory");
+            break;
+        }
+        compressed_size = ARCHIVE_Read32(ptr + 20);
+        size = ARCHIVE_Read32(ptr + 24);
+        header_offset = ARCHIVE_Read32(ptr + 42);
+        name = (char *)ptr + ZIP_CENTRAL_HEADER_SIZE;
+        extra = ptr + ZIP_CENTRAL_HEADER_SIZE + name_length;
+
+        /* Values too big for the header are in the ZIP64 extra field, in this order */
+        if (size == 0xFFFFFFFF || compressed_size == 0xFFFFFFFF || header_offset == 0xFFFFFFFF) {
+            const Uint8 *extra_end = extra + extra_length;
+            while ((extra_end - extra) >= 4) {
+                Uint16 id = ARCHIVE_Read16(extra);
+                Uint16 field_length = ARCHIVE_Read16(extra + 2);
+                const Uint8 *field = extra + 4;
+                const Uint8 *field_end = field + field_length;
+                if (field_end > extra_end) {
+                    break;
+                }
+                if (id == ZIP64_EXTRA_ID) {
+                    if (size == 0xFFFFFFFF && (field_end - field) >= 8) {
+                        size = ARCHIVE_Read64(field);
+                        field += 8;
+                    }
+                    if (compressed_size == 0xFFFFFFFF && (field_end - field) >= 8) {
+                        compressed_size = ARCHIVE_Read64(field);
+                        field += 8;
+                    }
+                    if (header_offset == 0xFFFFFFFF && (field_end - field) >= 8) {
+                        header_offset = ARCHIVE_Read64(field);
+                    }
+                    break;
+                }
+                extra = field_end;
+            }
+        }
+
+        len = name_length;
+        type = SDL_PATHTYPE_FILE;
+        if (len > 0 && name[len - 1] == '/') {
+            type = SDL_PATHTYPE_DIRECTORY;
+        }
+        while (len > 0 && name[len - 1] == '/') {
+            --len;
+        }
+
+        /* The central directory buffer has room past the end for a terminator */
+        index = ARCHIVE_AddEntry(archive, name, len, type);
+        if (index == ARCHIVE_NO_ENTRY) {
+            result = -1;
+            break;
+        }
+        if (type == SDL_PATHTYPE_FILE && archive->entries[index].type == SDL_PATHTYPE_FILE) {
+            ArchiveEntry *entry = &archive->entries[index];
+            entry->size = size;
+            entry->compressed_size = compressed_size;
+            entry->header_offset = header_offset;
+            entry->method = ARCHIVE_Read16(ptr + 10);
+            entry->flags = ARCHIVE_Read16(ptr + 8);
+            entry->modify_time = ARCHIVE_ConvertDOSTime(ARCHIVE_Read16(ptr + 12), ARCHIVE_Read16(ptr + 14));
+        }
+
+        ptr += ZIP_CENTRAL_HEADER_SIZE + name_length + extra_length + comment_length;
+    }
+
+    SDL_free(cd);
+    return result;
+}
+
+static int ARCHIVE_CloseStorage(void *userdata)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    int i;
+
+    SDL_DestroyHashTable(archive->index);
+    for (i = 0; i < archive->num_entries; ++i) {
+        SDL_free(archive->entries[i].path);
+    }
+    SDL_free(archive->entries);
+    SDL_CloseIO(archive->io);
+    SDL_DestroyMutex(archive->lock);
+    SDL_free(archive);
+    return 0;
+}
+
+static int ARCHIVE_EnumerateStorageDirectory(void *userdata, const char *path, SDL_EnumerateDirectoryCallback callback, void *callback_userdata)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    ArchiveEntry *dir = ARCHIVE_FindEntry(archive, path);
+    int retval = 1;
+    int child;
+
+    if (!dir) {
+        return -1;
+    }
+    if (dir->type != SDL_PATHTYPE_DIRECTORY) {
+        return SDL_SetError("Can't open directory: not a directory");
+    }
+
+    for (child = dir->first_child; retval == 1 && child != ARCHIVE_NO_ENTRY; child = archive->entries[child].next_sibling) {
+        const ArchiveEntry *entry = &archive->entries[child];
+        retval = callback(callback_userdata, path, entry->path + entry->name_offset);
+    }
+    return (retval < 0) ? -1 : 0;
+}
+
+static int ARCHIVE_GetStoragePathInfo(void *userdata, const char *path, SDL_PathInfo *info)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    ArchiveEntry *entry = ARCHIVE_FindEntry(archive, path);
+
+    if (!entry) {
+        return -1;
+    }
+    info->type = entry->type;
+    info->size = entry->size;
+    info->create_time = entry->modify_time;
+    info->modify_time = entry->modify_time;
+    info->access_time = entry->modify_time;
+    return 0;
+}
+
+static int ARCHIVE_ReadStorageFile(void *userdata, const char *path, void *destination, Uint64 length)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    ArchiveEntry *entry = ARCHIVE_FindEntry(archive, path);
+    Uint8 header[ZIP_LOCAL_HEADER_SIZE];
+    Uint64 data_offset;
+
+    if (!entry) {
+        return -1;
+    }
+    if (entry->type != SDL_PATHTYPE_FILE) {
+        return SDL_SetError("Can't read a directory");
+    }
+    if (entry->flags & ZIP_FLAG_ENCRYPTED) {
+        return SDL_SetError("Encrypted archive entries are not supported");
+    }
+    if (entry->method != ZIP_METHOD_STORED) {
+        return SDL_SetError("Compressed archive entries are not supported");
+    }
+    if (length > entry->size) {
+        return SDL_SetError("Read size exceeds file size");
+    }
+
+    /* The local header can have a different extra field than the central one */
+    if (ARCHIVE_ReadAt(archive, entry->header_offset, header, sizeof(header)) < 0) {
+        return -1;
+    }
+    if (ARCHIVE_Read32(header) != ZIP_LOCAL_HEADER_SIG) {
+        return SDL_SetError("Corrupt ZIP local header");
+    }
+    data_offset = entry->header_offset + ZIP_LOCAL_HEADER_SIZE + ARCHIVE_Read16(header + 26) + ARCHIVE_Read16(header + 28);
+
+    return ARCHIVE_ReadAt(archive, data_offset, destination, length);
+}
+
+static const SDL_StorageInterface ARCHIVE_iface = {
+    ARCHIVE_CloseStorage,
+    NULL,   /* ready */
+    ARCHIVE_EnumerateStorageDirectory,
+    ARCHIVE_GetStoragePathInfo,
+    ARCHIVE_ReadStorageFile,
+    NULL,   /* write_file */
+    NULL,   /* mkdir */
+    NULL,   /* remove */
+    NULL,   /* rename */
+    NULL,   /* copy */
+    NULL,   /* space_remaining */
+    NULL    /* write_file_range */
+};
+
+SDL_Storage *ARCHIVE_OpenStorage(const char *path)
+{
+    ArchiveStorage *archive;
+    SDL_Storage *result;
+    Sint64 size;
+
+    if (!path) {
+        SDL_InvalidParamError("path");
+        return NULL;
+    }
+
+    archive = (ArchiveStorage *)SDL_calloc(1, sizeof(*archive));
+    if (!archive) {
+        return NULL;
+    }
+
+    archive->io = SDL_IOFromMappedFile(path, SDL_IO_ACCESS_RANDOM);
+    if (archive->io) {
+        archive->mapping = (const Uint8 *)SDL_GetPointerProperty(SDL_GetIOProperties(archive->io), SDL_PROP_IOSTREAM_MAPPED_MEMORY_POINTER, NULL);
+    } else {
+        archive->io = SDL_IOFromFile(path, "rb");
+    }
+    archive->lock = SDL_CreateMutex();
+    archive->index = SDL_CreateHashTable(NULL, 256, SDL_HashString, SDL_KeyMatchString, NULL, SDL_FALSE);
+    if (!archive->io || !archive->lock || !archive->index) {
+        goto failed;
+    }
+
+    size = SDL_GetIOSize(archive->io);
+    if (size < 0) {
+        goto failed;
+    }
+    archive->archive_size = (Uint64)size;
+
+    if (ARCHIVE_ReadCentralDirectory(archive) < 0) {
+        goto failed;
+    }
+
+    result = SDL_OpenStorage(&ARCHIVE_iface, archive);
+    if (!result) {
+        goto failed;
+    }
+    return result;
+
+failed:
+    ARCHIVE_CloseStorage(archive);
+    return NULL;
+}
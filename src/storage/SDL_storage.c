@@ -39,10 +39,18 @@ static UserStorageBootStrap *userbootstrap[] = {
     NULL
 };
 
+/* Writes in a transaction go to a file next to the real one with this
+   suffix, and are renamed over it when the transaction is committed. */
+#define STORAGE_PENDING_SUFFIX ".sdlpending"
+
 struct SDL_Storage
 {
     SDL_StorageInterface iface;
     void *userdata;
+    SDL_bool in_transaction;
+    char **pending;     /* paths written since SDL_BeginStorageTransaction() */
+    int num_pending;
+    int max_pending;
 };
 
 #define CHECK_STORAGE_MAGIC()                             \
@@ -56,6 +64,61 @@ struct SDL_Storage
         return retval;                             \
     }
 
+static char *GetPendingStoragePath(const char *path)
+{
+    char *result = NULL;
+    if (SDL_asprintf(&result, "%s" STORAGE_PENDING_SUFFIX, path) < 0) {
+        return NULL;
+    }
+    return result;
+}
+
+static int FindPendingStorageWrite(SDL_Storage *storage, const char *path)
+{
+    int i;
+    for (i = 0; i < storage->num_pending; ++i) {
+        if (SDL_strcmp(storage->pending[i], path) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int AddPendingStorageWrite(SDL_Storage *storage, const char *path)
+{
+    char *copy;
+
+    if (storage->num_pending == storage->max_pending) {
+        int max_pending = storage->max_pending ? storage->max_pending * 2 : 16;
+        char **pending = (char **)SDL_realloc(storage->pending, max_pending * sizeof(*pending));
+        if (!pending) {
+            return -1;
+        }
+        storage->pending = pending;
+        storage->max_pending = max_pending;
+    }
+
+    copy = SDL_strdup(path);
+    if (!copy) {
+        return -1;
+    }
+    storage->pending[storage->num_pending++] = copy;
+    return 0;
+}
+
+static void FreePendingStorageWrites(SDL_Storage *storage)
+{
+    int i;
+    for (i = 0; i < storage->num_pending; ++i) {
+        SDL_free(storage->pending[i]);
+    }
+    SDL_free(storage->pending);
+    storage->pending = NULL;
+    storage->num_pending = 0;
+    storage->max_pending = 0;
+    storage->in_transaction = SDL_FALSE;
+}
+
 SDL_Storage *SDL_OpenTitleStorage(const char *override, SDL_PropertiesID props)
 {
     SDL_Storage *storage = NULL;
@@ -145,6 +208,11 @@ SDL_Storage *SDL_OpenFileStorage(const char *path)
     return GENERIC_OpenFileStorage(path);
 }
 
+SDL_Storage *SDL_OpenArchiveStorage(const char *path)
+{
+    return ARCHIVE_OpenStorage(path);
+}
+
 SDL_Storage *SDL_OpenStorage(const SDL_StorageInterface *iface, void *userdata)
 {
     SDL_Storage *storage;
@@ -168,6 +236,9 @@ int SDL_CloseStorage(SDL_Storage *storage)
 
     CHECK_STORAGE_MAGIC()
 
+    if (storage->in_transaction) {
+        SDL_RollbackStorageTransaction(storage);
+    }
     if (storage->iface.close) {
         retval = storage->iface.close(storage->userdata);
     }
@@ -225,9 +296,138 @@ int SDL_WriteStorageFile(SDL_Storage *storage, const char *path, const void *sou
         return SDL_Unsupported();
     }
 
+    if (storage->in_transaction) {
+        char *pending_path = GetPendingStoragePath(path);
+        int retval;
+
+        if (!pending_path) {
+            return -1;
+        }
+        retval = storage->iface.write_file(storage->userdata, pending_path, source, length);
+        if (retval == 0 && FindPendingStorageWrite(storage, path) < 0 && AddPendingStorageWrite(storage, path) < 0) {
+            storage->iface.remove(storage->userdata, pending_path);
+            retval = -1;
+        }
+        SDL_free(pending_path);
+        return retval;
+    }
+
     return storage->iface.write_file(storage->userdata, path, source, length);
 }
 
+int SDL_WriteStorageFileRange(SDL_Storage *storage, const char *path, Uint64 offset, const void *source, Uint64 length)
+{
+    CHECK_STORAGE_MAGIC()
+
+    if (!path) {
+        return SDL_InvalidParamError("path");
+    }
+
+    if (!storage->iface.write_file_range) {
+        return SDL_Unsupported();
+    }
+
+    if (storage->in_transaction) {
+        char *pending_path = GetPendingStoragePath(path);
+        int retval = 0;
+
+        if (!pending_path) {
+            return -1;
+        }
+
+        /* The first change to a file in a transaction starts from a copy of it */
+        if (FindPendingStorageWrite(storage, path) < 0) {
+            SDL_PathInfo info;
+            if (storage->iface.info && storage->iface.info(storage->userdata, path, &info) == 0) {
+                if (!storage->iface.copy) {
+                    retval = SDL_Unsupported();
+                } else {
+                    retval = storage->iface.copy(storage->userdata, path, pending_path);
+                }
+            }
+            if (retval == 0 && AddPendingStorageWrite(storage, path) < 0) {
+                storage->iface.remove(storage->userdata, pending_path);
+                retval = -1;
+            }
+        }
+        if (retval == 0) {
+            retval = storage->iface.write_file_range(storage->userdata, pending_path, offset, source, length);
+        }
+        SDL_free(pending_path);
+        return retval;
+    }
+
+    return storage->iface.write_file_range(storage->userdata, path, offset, source, length);
+}
+
+int SDL_BeginStorageTransaction(SDL_Storage *storage)
+{
+    CHECK_STORAGE_MAGIC()
+
+    if (!storage->iface.write_file || !storage->iface.rename || !storage->iface.remove) {
+        return SDL_Unsupported();
+    }
+    if (storage->in_transaction) {
+        return SDL_SetError("A storage transaction is already in progress");
+    }
+
+    storage->in_transaction = SDL_TRUE;
+    return 0;
+}
+
+int SDL_CommitStorageTransaction(SDL_Storage *storage)
+{
+    int retval = 0;
+    int i;
+
+    CHECK_STORAGE_MAGIC()
+
+    if (!storage->in_transaction) {
+        return SDL_SetError("No storage transaction is in progress");
+    }
+
+    for (i = 0; i < storage->num_pending; ++i) {
+        char *pending_path = GetPendingStoragePath(storage->pending[i]);
+        if (!pending_path) {
+            retval = -1;
+        } else if (retval == 0) {
+            if (storage->iface.rename(storage->userdata, pending_path, storage->pending[i]) < 0) {
+                storage->iface.remove(storage->userdata, pending_path);
+                retval = -1;
+            }
+        } else {
+            /* Something already failed, throw away the rest */
+            storage->iface.remove(storage->userdata, pending_path);
+        }
+        SDL_free(pending_path);
+    }
+    FreePendingStorageWrites(storage);
+
+    return retval;
+}
+
+int SDL_RollbackStorageTransaction(SDL_Storage *storage)
+{
+    int i;
+
+    CHECK_STORAGE_MAGIC()
+
+    if (!storage->in_transaction) {
+        return SDL_SetError("No storage transaction is in progress");
+    }
+
+    for (i = 0; i < storage->num_pending; ++i) {
+        char *pending_path = GetPendingStoragePath(storage->pending[i]);
+        if (pending_path) {
+            storage->iface.remove(storage->userdata, pending_path);
+            SDL_free(pending_path);
+        }
+    }
+    FreePendingStorageWrites(storage);
+
+    return 0;
+}
+
 int SDL_CreateStorageDirectory(SDL_Storage *storage, const char *path)
 {
     CHECK_STORAGE_MAGIC()
@@ -348,9 +548,24 @@ static int GlobStorageDirectoryGetPathInfo(const char *path, SDL_PathInfo *info,
     return SDL_GetStoragePathInfo((SDL_Storage *) userdata, path, info);
 }
 
-static int GlobStorageDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
+typedef struct GlobStorageDirectoryData
+{
+    SDL_SYS_EnumerateDirectoryCallback cb;
+    void *cbuserdata;
+} GlobStorageDirectoryData;
+
+static int SDLCALL GlobStorageDirectoryCallback(void *userdata, const char *dirname, const char *fname)
+{
+    GlobStorageDirectoryData *data = (GlobStorageDirectoryData *) userdata;
+    return data->cb(data->cbuserdata, dirname, fname, SDL_PATHTYPE_NONE);  // storage doesn't report types while enumerating.
+}
+
+static int GlobStorageDirectoryEnumerator(const char *path, SDL_SYS_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
 {
-    return SDL_EnumerateStorageDirectory((SDL_Storage *) userdata, path, cb, cbuserdata);
+    GlobStorageDirectoryData data;
+    data.cb = cb;
+    data.cbuserdata = cbuserdata;
+    return SDL_EnumerateStorageDirectory((SDL_Storage *) userdata, path, GlobStorageDirectoryCallback, &data);
 }
 
 char **SDL_GlobStorageDirectory(SDL_Storage *storage, const char *path, const char *pattern, SDL_GlobFlags flags, int *count)
@@ -47,5 +47,6 @@ extern UserStorageBootStrap GENERIC_userbootstrap;
 extern UserStorageBootStrap STEAM_userbootstrap;
 
 extern SDL_Storage *GENERIC_OpenFileStorage(const char *path);
+extern SDL_Storage *ARCHIVE_OpenStorage(const char *path);
 
 #endif /* SDL_sysstorage_h_ */
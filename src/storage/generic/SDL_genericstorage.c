@@ -118,6 +118,38 @@ static int GENERIC_WriteStorageFile(void *userdata, const char *path, const void
     return result;
 }
 
+static int GENERIC_WriteStorageFileRange(void *userdata, const char *path, Uint64 offset, const void *source, Uint64 length)
+{
+    int result = -1;
+
+    if (length > SDL_SIZE_MAX) {
+        return SDL_SetError("Write size exceeds SDL_SIZE_MAX");
+    }
+    if (offset > SDL_MAX_SINT64) {
+        return SDL_SetError("Write offset exceeds SDL_MAX_SINT64");
+    }
+
+    char *fullpath = GENERIC_INTERNAL_CreateFullPath((char *)userdata, path);
+    if (fullpath) {
+        SDL_IOStream *stream = SDL_IOFromFile(fullpath, "r+b");
+        if (!stream) {
+            stream = SDL_IOFromFile(fullpath, "wb");
+        }
+
+        if (stream) {
+            if (SDL_SeekIO(stream, (Sint64)offset, SDL_IO_SEEK_SET) >= 0 &&
+                SDL_WriteIO(stream, source, (size_t)length) == length) {
+                result = 0;
+            }
+            if (SDL_CloseIO(stream) < 0) {
+                result = -1;
+            }
+        }
+        SDL_free(fullpath);
+    }
+    return result;
+}
+
 static int GENERIC_CreateStorageDirectory(void *userdata, const char *path)
 {
     /* TODO: Recursively create subdirectories with SDL_CreateDirectory */
@@ -192,7 +224,8 @@ static const SDL_StorageInterface GENERIC_title_iface = {
     NULL,   /* remove */
     NULL,   /* rename */
     NULL,   /* copy */
-    NULL    /* space_remaining */
+    NULL,   /* space_remaining */
+    NULL    /* write_file_range */
 };
 
 static SDL_Storage *GENERIC_Title_Create(const char *override, SDL_PropertiesID props)
@@ -234,7 +267,8 @@ static const SDL_StorageInterface GENERIC_user_iface = {
     GENERIC_RemoveStoragePath,
     GENERIC_RenameStoragePath,
     GENERIC_CopyStorageFile,
-    GENERIC_GetStorageSpaceRemaining
+    GENERIC_GetStorageSpaceRemaining,
+    GENERIC_WriteStorageFileRange
 };
 
 static SDL_Storage *GENERIC_User_Create(const char *org, const char *app, SDL_PropertiesID props)
@@ -269,7 +303,8 @@ static const SDL_StorageInterface GENERIC_file_iface = {
     GENERIC_RemoveStoragePath,
     GENERIC_RenameStoragePath,
     GENERIC_CopyStorageFile,
-    GENERIC_GetStorageSpaceRemaining
+    GENERIC_GetStorageSpaceRemaining,
+    GENERIC_WriteStorageFileRange
 };
 
 SDL_Storage *GENERIC_OpenFileStorage(const char *path)
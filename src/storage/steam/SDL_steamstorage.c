@@ -141,7 +141,8 @@ static const SDL_StorageInterface STEAM_user_iface = {
     NULL,   /* remove */
     NULL,   /* rename */
     NULL,   /* copy */
-    STEAM_GetStorageSpaceRemaining
+    STEAM_GetStorageSpaceRemaining,
+    NULL    /* write_file_range */
 };
 
 static SDL_Storage *STEAM_User_Create(const char *org, const char *app, SDL_PropertiesID props)
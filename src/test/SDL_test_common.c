@@ -20,8 +20,17 @@
 */
 
 /* Ported from original test/common.c file. */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for sched_setaffinity() */
+#endif
 #include <SDL3/SDL_test.h>
 
+#ifdef SDL_PLATFORM_LINUX
+#include <sched.h>
+#elif defined(SDL_PLATFORM_WIN32)
+#include <windows.h>
+#endif
+
 #define SDL_MAIN_NOIMPL
 #define SDL_MAIN_USE_CALLBACKS
 #include <SDL3/SDL_main.h>
@@ -30,6 +39,11 @@ static const char *common_usage[] = {
     "[-h | --help]",
     "[--trackmem]",
     "[--randmem]",
+    "[--profilemem]",
+    "[--load-threads N]",
+    "[--load-duty PERCENT]",
+    "[--load-pin]",
+    "[--load-audio N]",
     "[--log all|error|system|audio|video|render|input]",
 };
 
@@ -104,6 +118,8 @@ SDLTest_CommonState *SDLTest_CommonCreateState(char **argv, SDL_InitFlags flags)
             SDLTest_TrackAllocations();
         } else if (SDL_strcasecmp(argv[i], "--randmem") == 0) {
             SDLTest_RandFillAllocations();
+        } else if (SDL_strcasecmp(argv[i], "--profilemem") == 0) {
+            SDLTest_ProfileAllocations();
         }
     }
 
@@ -127,6 +143,7 @@ SDLTest_CommonState *SDLTest_CommonCreateState(char **argv, SDL_InitFlags flags)
     state->audio_freq = 22050;
     state->audio_format = SDL_AUDIO_S16;
     state->audio_channels = 2;
+    state->load_duty = 100;
 
     /* Set some very sane GL defaults */
     state->gl_red_size = 8;
@@ -153,6 +170,7 @@ SDLTest_CommonState *SDLTest_CommonCreateState(char **argv, SDL_InitFlags flags)
 
 void SDLTest_CommonDestroyState(SDLTest_CommonState *state) {
     SDL_free(state);
+    SDLTest_LogAllocationProfile();
     SDLTest_LogAllocations();
 }
 
@@ -181,6 +199,47 @@ int SDLTest_CommonArg(SDLTest_CommonState *state, int index)
         /* Already handled in SDLTest_CommonCreateState() */
         return 1;
     }
+    if (SDL_strcasecmp(argv[index], "--profilemem") == 0) {
+        /* Already handled in SDLTest_CommonCreateState() */
+        return 1;
+    }
+    if (SDL_strcasecmp(argv[index], "--load-threads") == 0) {
+        ++index;
+        if (!argv[index]) {
+            return -1;
+        }
+        state->load_threads = SDL_atoi(argv[index]);
+        if (state->load_threads < 0) {
+            return -1;
+        }
+        return 2;
+    }
+    if (SDL_strcasecmp(argv[index], "--load-duty") == 0) {
+        ++index;
+        if (!argv[index]) {
+            return -1;
+        }
+        state->load_duty = SDL_atoi(argv[index]);
+        if (state->load_duty < 1 || state->load_duty > 100) {
+            return -1;
+        }
+        return 2;
+    }
+    if (SDL_strcasecmp(argv[index], "--load-pin") == 0) {
+        state->load_pin_threads = SDL_TRUE;
+        return 1;
+    }
+    if (SDL_strcasecmp(argv[index], "--load-audio") == 0) {
+        ++index;
+        if (!argv[index]) {
+            return -1;
+        }
+        state->load_audio_streams = SDL_atoi(argv[index]);
+        if (state->load_audio_streams < 0) {
+            return -1;
+        }
+        return 2;
+    }
     if (SDL_strcasecmp(argv[index], "--log") == 0) {
         ++index;
         if (!argv[index]) {
@@ -1143,6 +1202,204 @@ static SDL_HitTestResult SDLCALL SDLTest_ExampleHitTestCallback(SDL_Window *win,
     return SDL_HITTEST_NORMAL;
 }
 
+/* Background load: busy threads and audio streams that compete with the test for CPU, memory and SDL's locks */
+
+typedef struct
+{
+    int index;
+    int duty;
+    SDL_bool pin;
+} SDLTest_LoadThreadInfo;
+
+typedef struct
+{
+    SDL_AudioStream *stream;
+    float step;
+    int phase;
+} SDLTest_LoadAudioStream;
+
+#define LOAD_PERIOD_NS       (10 * SDL_NS_PER_MS)
+#define LOAD_WORKING_SET     (256 * 1024)
+
+static SDL_AtomicInt load_quit;
+static SDL_Thread **load_threads = NULL;
+static SDLTest_LoadThreadInfo *load_thread_info = NULL;
+static int num_load_threads = 0;
+static SDL_AudioDeviceID load_audio_device = 0;
+static SDLTest_LoadAudioStream *load_audio_streams = NULL;
+static int num_load_audio_streams = 0;
+
+static void PinCurrentThread(int index)
+{
+    const int cpu = index % SDL_GetCPUCount();
+#ifdef SDL_PLATFORM_LINUX
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+        SDL_Log("Couldn't pin load thread %d to CPU %d", index, cpu);
+    }
+#elif defined(SDL_PLATFORM_WIN32)
+    if (!SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu)) {
+        SDL_Log("Couldn't pin load thread %d to CPU %d", index, cpu);
+    }
+#else
+    SDL_Log("Pinning load thread %d to CPU %d isn't supported on this platform", index, cpu);
+#endif
+}
+
+static int SDLCALL LoadThread(void *data)
+{
+    const SDLTest_LoadThreadInfo *info = (const SDLTest_LoadThreadInfo *)data;
+    const Uint64 busy_ns = (LOAD_PERIOD_NS * info->duty) / 100;
+    Uint32 *working_set;
+    Uint32 seed = (Uint32)info->index * 2654435761u;
+    size_t pos = 0;
+
+    if (info->pin) {
+        PinCurrentThread(info->index);
+    }
+
+    working_set = (Uint32 *)SDL_calloc(LOAD_WORKING_SET / sizeof(Uint32), sizeof(Uint32));
+    if (!working_set) {
+        return -1;
+    }
+
+    while (!SDL_AtomicGet(&load_quit)) {
+        const Uint64 period_start = SDL_GetTicksNS();
+
+        while ((SDL_GetTicksNS() - period_start) < busy_ns) {
+            void *block;
+            int i;
+
+            /* Some arithmetic, some cache misses and some allocator traffic */
+            for (i = 0; i < 1024; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                pos = (pos + (seed >> 8)) % (LOAD_WORKING_SET / sizeof(Uint32));
+                working_set[pos] += seed;
+            }
+            block = SDL_malloc(64 + (seed & 1023));
+            SDL_free(block);
+        }
+        if (busy_ns < LOAD_PERIOD_NS) {
+            SDL_DelayNS(LOAD_PERIOD_NS - (SDL_GetTicksNS() - period_start) % LOAD_PERIOD_NS);
+        }
+    }
+
+    SDL_free(working_set);
+    return 0;
+}
+
+static void SDLCALL LoadAudioCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    SDLTest_LoadAudioStream *load = (SDLTest_LoadAudioStream *)userdata;
+    float samples[512];
+    int frames = additional_amount / (int)(2 * sizeof(float));
+
+    (void)total_amount;
+    while (frames > 0) {
+        const int count = SDL_min(frames, (int)SDL_arraysize(samples) / 2);
+        int i;
+
+        for (i = 0; i < count; ++i) {
+            samples[i * 2] = samples[i * 2 + 1] = SDL_sinf((float)load->phase++ * load->step);
+        }
+        load->phase %= 44100;
+        SDL_PutAudioStreamData(stream, samples, count * 2 * sizeof(float));
+        frames -= count;
+    }
+}
+
+static SDL_bool StartBackgroundLoad(SDLTest_CommonState *state)
+{
+    int i;
+
+    SDL_AtomicSet(&load_quit, 0);
+
+    if (state->load_threads > 0) {
+        load_threads = (SDL_Thread **)SDL_calloc(state->load_threads, sizeof(*load_threads));
+        load_thread_info = (SDLTest_LoadThreadInfo *)SDL_calloc(state->load_threads, sizeof(*load_thread_info));
+        if (!load_threads || !load_thread_info) {
+            return SDL_FALSE;
+        }
+        for (i = 0; i < state->load_threads; ++i) {
+            load_thread_info[i].index = i;
+            load_thread_info[i].duty = state->load_duty;
+            load_thread_info[i].pin = state->load_pin_threads;
+            load_threads[i] = SDL_CreateThread(LoadThread, "SDLTestLoad", &load_thread_info[i]);
+            if (!load_threads[i]) {
+                SDL_Log("Couldn't create load thread: %s\n", SDL_GetError());
+                return SDL_FALSE;
+            }
+            ++num_load_threads;
+        }
+        SDL_Log("Running %d background load threads at %d%% duty%s\n", num_load_threads, state->load_duty,
+                state->load_pin_threads ? ", pinned" : "");
+    }
+
+    if (state->load_audio_streams > 0) {
+        /* 44.1kHz sources, so the mixer has to resample like a real game would */
+        const SDL_AudioSpec spec = { SDL_AUDIO_F32, 2, 44100 };
+
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+            SDL_Log("Couldn't initialize audio for background load: %s\n", SDL_GetError());
+            return SDL_FALSE;
+        }
+        load_audio_device = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+        if (!load_audio_device) {
+            SDL_Log("Couldn't open audio for background load: %s\n", SDL_GetError());
+            return SDL_FALSE;
+        }
+        load_audio_streams = (SDLTest_LoadAudioStream *)SDL_calloc(state->load_audio_streams, sizeof(*load_audio_streams));
+        if (!load_audio_streams) {
+            return SDL_FALSE;
+        }
+        for (i = 0; i < state->load_audio_streams; ++i) {
+            SDLTest_LoadAudioStream *load = &load_audio_streams[i];
+
+            load->stream = SDL_CreateAudioStream(&spec, NULL);
+            if (!load->stream) {
+                SDL_Log("Couldn't create audio stream for background load: %s\n", SDL_GetError());
+                return SDL_FALSE;
+            }
+            ++num_load_audio_streams;
+            load->step = (2.0f * SDL_PI_F * (220.0f + (float)(i % 16) * 55.0f)) / spec.freq;
+            SDL_SetAudioStreamGain(load->stream, 0.01f);
+            SDL_SetAudioStreamGetCallback(load->stream, LoadAudioCallback, load);
+            SDL_BindAudioStream(load_audio_device, load->stream);
+        }
+        SDL_Log("Playing %d background audio streams\n", num_load_audio_streams);
+    }
+    return SDL_TRUE;
+}
+
+static void StopBackgroundLoad(void)
+{
+    int i;
+
+    SDL_AtomicSet(&load_quit, 1);
+    for (i = 0; i < num_load_threads; ++i) {
+        SDL_WaitThread(load_threads[i], NULL);
+    }
+    SDL_free(load_threads);
+    SDL_free(load_thread_info);
+    load_threads = NULL;
+    load_thread_info = NULL;
+    num_load_threads = 0;
+
+    for (i = 0; i < num_load_audio_streams; ++i) {
+        SDL_DestroyAudioStream(load_audio_streams[i].stream);
+    }
+    SDL_free(load_audio_streams);
+    load_audio_streams = NULL;
+    num_load_audio_streams = 0;
+    if (load_audio_device) {
+        SDL_CloseAudioDevice(load_audio_device);
+        load_audio_device = 0;
+    }
+}
+
 SDL_bool SDLTest_CommonInit(SDLTest_CommonState *state)
 {
     int i, j, m, n, w, h;
@@ -1489,6 +1746,10 @@ SDL_bool SDLTest_CommonInit(SDLTest_CommonState *state)
         SDL_InitSubSystem(SDL_INIT_CAMERA);
     }
 
+    if (!StartBackgroundLoad(state)) {
+        return SDL_FALSE;
+    }
+
     return SDL_TRUE;
 }
 
@@ -2503,6 +2764,8 @@ void SDLTest_CommonQuit(SDLTest_CommonState *state)
     common_usage_audio = NULL;
     common_usage_videoaudio = NULL;
 
+    StopBackgroundLoad();
+
     if (state->targets) {
         for (i = 0; i < state->num_windows; ++i) {
             if (state->targets[i]) {
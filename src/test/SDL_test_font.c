@@ -3356,6 +3356,11 @@ int SDLTest_DrawString(SDL_Renderer *renderer, float x, float y, const char *s)
     float cury = y;
     size_t len = SDL_strlen(s);
 
+    /* The renderer's debug text uses this font from a single atlas texture, which is much faster */
+    if (charWidth == SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE) {
+        return SDL_RenderDebugText(renderer, x, y, s);
+    }
+
     while (len > 0 && !result) {
         int advance = 0;
         Uint32 ch = UTF8_getch(s, len, &advance);
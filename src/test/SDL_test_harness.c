@@ -354,6 +354,257 @@ static float GetClock(void)
     return currentClock;
 }
 
+/* ! A named benchmark result, from this run or from a baseline file */
+typedef struct SDLTest_BenchmarkRecord {
+    char *name;
+    SDLTest_BenchmarkResult result;
+} SDLTest_BenchmarkRecord;
+
+/* ! Benchmark settings and results, see SDLTest_SetBenchmarkOptions() */
+static char *SDLTest_BenchmarkOutputFile = NULL;
+static float SDLTest_BenchmarkMaxRegression = 0.0f;
+static SDLTest_BenchmarkRecord *SDLTest_BenchmarkBaseline = NULL;
+static int SDLTest_BenchmarkBaselineCount = 0;
+static SDLTest_BenchmarkRecord *SDLTest_BenchmarkResults = NULL;
+static int SDLTest_BenchmarkResultCount = 0;
+
+static void SDLTest_FreeBenchmarkRecords(SDLTest_BenchmarkRecord **records, int *count)
+{
+    int i;
+
+    for (i = 0; i < *count; i++) {
+        SDL_free((*records)[i].name);
+    }
+    SDL_free(*records);
+    *records = NULL;
+    *count = 0;
+}
+
+static SDL_bool SDLTest_AddBenchmarkRecord(SDLTest_BenchmarkRecord **records, int *count, const char *name, const SDLTest_BenchmarkResult *result)
+{
+    SDLTest_BenchmarkRecord *newRecords;
+    char *newName;
+    char *c;
+
+    newName = SDL_strdup(name);
+    if (!newName) {
+        return SDL_FALSE;
+    }
+
+    /* Keep names usable as JSON strings without escaping */
+    for (c = newName; *c; c++) {
+        if (*c == '"' || *c == '\\' || (unsigned char)*c < 0x20) {
+            *c = '_';
+        }
+    }
+
+    newRecords = (SDLTest_BenchmarkRecord *)SDL_realloc(*records, (*count + 1) * sizeof(SDLTest_BenchmarkRecord));
+    if (!newRecords) {
+        SDL_free(newName);
+        return SDL_FALSE;
+    }
+    newRecords[*count].name = newName;
+    newRecords[*count].result = *result;
+    *records = newRecords;
+    (*count)++;
+    return SDL_TRUE;
+}
+
+/* Reads back the "name" and "median_ns" of each benchmark written by SDLTest_WriteBenchmarkResults() */
+static int SDLTest_LoadBenchmarkBaseline(const char *file)
+{
+    char *data;
+    const char *pos;
+    const char *nameEnd;
+    const char *median;
+    char name[256];
+    size_t length;
+    SDLTest_BenchmarkResult result;
+
+    data = (char *)SDL_LoadFile(file, NULL);
+    if (!data) {
+        SDLTest_LogError("Unable to load benchmark baseline '%s': %s", file, SDL_GetError());
+        return -1;
+    }
+
+    pos = data;
+    while ((pos = SDL_strstr(pos, "\"name\": \"")) != NULL) {
+        pos += SDL_strlen("\"name\": \"");
+        nameEnd = SDL_strchr(pos, '"');
+        if (!nameEnd) {
+            break;
+        }
+        length = SDL_min((size_t)(nameEnd - pos), sizeof(name) - 1);
+        SDL_memcpy(name, pos, length);
+        name[length] = '\0';
+        pos = nameEnd;
+
+        median = SDL_strstr(pos, "\"median_ns\": ");
+        if (!median) {
+            break;
+        }
+        SDL_zero(result);
+        result.medianNS = SDL_strtoull(median + SDL_strlen("\"median_ns\": "), NULL, 10);
+        if (!SDLTest_AddBenchmarkRecord(&SDLTest_BenchmarkBaseline, &SDLTest_BenchmarkBaselineCount, name, &result)) {
+            SDL_free(data);
+            return -1;
+        }
+    }
+
+    SDL_free(data);
+    SDLTest_Log("Loaded %d benchmark baseline(s) from '%s'", SDLTest_BenchmarkBaselineCount, file);
+    return 0;
+}
+
+static int SDLTest_WriteBenchmarkResults(void)
+{
+    SDL_IOStream *io;
+    int i;
+
+    if (!SDLTest_BenchmarkOutputFile || SDLTest_BenchmarkResultCount == 0) {
+        return 0;
+    }
+
+    io = SDL_IOFromFile(SDLTest_BenchmarkOutputFile, "w");
+    if (!io) {
+        SDLTest_LogError("Unable to write benchmark results to '%s': %s", SDLTest_BenchmarkOutputFile, SDL_GetError());
+        return -1;
+    }
+
+    SDL_IOprintf(io, "{\n  \"benchmarks\": [\n");
+    for (i = 0; i < SDLTest_BenchmarkResultCount; i++) {
+        const SDLTest_BenchmarkRecord *record = &SDLTest_BenchmarkResults[i];
+        SDL_IOprintf(io, "    { \"name\": \"%s\", \"iterations\": %d, \"min_ns\": %" SDL_PRIu64 ", \"median_ns\": %" SDL_PRIu64 ", \"p99_ns\": %" SDL_PRIu64 ", \"bytes_per_second\": %.1f, \"items_per_second\": %.1f }%s\n",
+                     record->name, record->result.iterations, record->result.minNS, record->result.medianNS, record->result.p99NS,
+                     record->result.bytesPerSecond, record->result.itemsPerSecond, (i + 1 < SDLTest_BenchmarkResultCount) ? "," : "");
+    }
+    SDL_IOprintf(io, "  ]\n}\n");
+
+    if (SDL_CloseIO(io) < 0) {
+        SDLTest_LogError("Unable to write benchmark results to '%s': %s", SDLTest_BenchmarkOutputFile, SDL_GetError());
+        return -1;
+    }
+
+    SDLTest_Log("Wrote %d benchmark result(s) to '%s'", SDLTest_BenchmarkResultCount, SDLTest_BenchmarkOutputFile);
+    return 0;
+}
+
+/**
+ * Set where benchmark results go for the following SDLTest_RunSuites calls.
+ *
+ * \param outputFile File to write results to, or NULL.
+ * \param baselineFile Results to compare against, or NULL.
+ * \param maxRegression Allowed slowdown against the baseline, as a fraction.
+ *
+ * \returns 0 on success, -1 if the baseline couldn't be loaded.
+ */
+int SDLTest_SetBenchmarkOptions(const char *outputFile, const char *baselineFile, float maxRegression)
+{
+    SDL_free(SDLTest_BenchmarkOutputFile);
+    SDLTest_BenchmarkOutputFile = outputFile ? SDL_strdup(outputFile) : NULL;
+    SDLTest_BenchmarkMaxRegression = SDL_max(maxRegression, 0.0f);
+
+    SDLTest_FreeBenchmarkRecords(&SDLTest_BenchmarkBaseline, &SDLTest_BenchmarkBaselineCount);
+    if (baselineFile) {
+        return SDLTest_LoadBenchmarkBaseline(baselineFile);
+    }
+    return 0;
+}
+
+static int SDLCALL SDLTest_CompareBenchmarkTimes(const void *a, const void *b)
+{
+    const Uint64 left = *(const Uint64 *)a;
+    const Uint64 right = *(const Uint64 *)b;
+    return (left < right) ? -1 : (left > right) ? 1 : 0;
+}
+
+/**
+ * Time a benchmark body from inside a test case.
+ *
+ * \param name Unique name of the benchmark, used to match it against the baseline.
+ * \param benchmark The body to time.
+ * \param arg Passed to the body.
+ * \param warmupIterations Number of untimed runs first.
+ * \param iterations Number of timed runs.
+ * \param bytesPerIteration Bytes processed by one run, for throughput, or 0.
+ * \param itemsPerIteration Items processed by one run, for throughput, or 0.
+ * \param result Filled in with the statistics, can be NULL.
+ *
+ * \returns TEST_COMPLETED, or TEST_ABORTED if the benchmark couldn't be run.
+ */
+int SDLTest_RunBenchmark(const char *name, SDLTest_BenchmarkFp benchmark, void *arg, int warmupIterations, int iterations, Uint64 bytesPerIteration, Uint64 itemsPerIteration, SDLTest_BenchmarkResult *result)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    SDLTest_BenchmarkResult stats;
+    Uint64 *times;
+    double seconds;
+    int i;
+
+    if (!name || !benchmark) {
+        SDLTest_LogError("Invalid benchmark");
+        return TEST_ABORTED;
+    }
+
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    times = (Uint64 *)SDL_malloc(iterations * sizeof(Uint64));
+    if (!times) {
+        SDLTest_LogError("Unable to allocate benchmark timings");
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < warmupIterations; i++) {
+        benchmark(arg);
+    }
+
+    for (i = 0; i < iterations; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        benchmark(arg);
+        times[i] = ((SDL_GetPerformanceCounter() - start) * SDL_NS_PER_SECOND) / frequency;
+    }
+
+    SDL_qsort(times, iterations, sizeof(Uint64), SDLTest_CompareBenchmarkTimes);
+
+    SDL_zero(stats);
+    stats.iterations = iterations;
+    stats.minNS = times[0];
+    stats.medianNS = times[iterations / 2];
+    stats.p99NS = times[SDL_min(iterations - 1, (iterations * 99) / 100)];
+    SDL_free(times);
+
+    seconds = (double)SDL_max(stats.medianNS, 1) / SDL_NS_PER_SECOND;
+    stats.bytesPerSecond = (double)bytesPerIteration / seconds;
+    stats.itemsPerSecond = (double)itemsPerIteration / seconds;
+
+    SDLTest_Log("Benchmark '%s': %d iterations, min %" SDL_PRIu64 " ns, median %" SDL_PRIu64 " ns, p99 %" SDL_PRIu64 " ns, %.1f bytes/s, %.1f items/s",
+                name, stats.iterations, stats.minNS, stats.medianNS, stats.p99NS, stats.bytesPerSecond, stats.itemsPerSecond);
+
+    if (!SDLTest_AddBenchmarkRecord(&SDLTest_BenchmarkResults, &SDLTest_BenchmarkResultCount, name, &stats)) {
+        SDLTest_LogError("Unable to record benchmark '%s'", name);
+        return TEST_ABORTED;
+    }
+
+    /* Compare against the baseline by the recorded (sanitized) name */
+    name = SDLTest_BenchmarkResults[SDLTest_BenchmarkResultCount - 1].name;
+    for (i = 0; i < SDLTest_BenchmarkBaselineCount; i++) {
+        const SDLTest_BenchmarkRecord *baseline = &SDLTest_BenchmarkBaseline[i];
+        if (SDL_strcmp(baseline->name, name) == 0) {
+            const double limit = (double)baseline->result.medianNS * (1.0 + SDLTest_BenchmarkMaxRegression);
+            SDLTest_AssertCheck((double)stats.medianNS <= limit,
+                                "Benchmark '%s' median %" SDL_PRIu64 " ns should be no more than %.0f ns (baseline %" SDL_PRIu64 " ns + %.0f%%)",
+                                name, stats.medianNS, limit, baseline->result.medianNS, SDLTest_BenchmarkMaxRegression * 100.0f);
+            break;
+        }
+    }
+
+    if (result) {
+        *result = stats;
+    }
+    return TEST_COMPLETED;
+}
+
 /**
  * Execute a test suite using the given run seed and execution key.
  *
@@ -785,6 +1036,12 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     }
     SDL_free((void *)failedTests);
 
+    /* Write out and reset the benchmark results of this run */
+    if (SDLTest_WriteBenchmarkResults() < 0) {
+        runResult = 1;
+    }
+    SDLTest_FreeBenchmarkRecords(&SDLTest_BenchmarkResults, &SDLTest_BenchmarkResultCount);
+
     SDLTest_Log("Exit code: %d", runResult);
     return runResult;
 }
@@ -51,11 +51,28 @@ __declspec(dllimport) USHORT WINAPI RtlCaptureStackBackTrace(ULONG FramesToSkip,
 
 #define MAXIMUM_TRACKED_STACK_DEPTH 32
 
+/* Allocation lifetimes are bucketed by powers of ten, from <1us to >=1s */
+#define NUM_LIFETIME_BUCKETS 8
+
+typedef struct SDL_allocation_callsite
+{
+    Uint64 stack[MAXIMUM_TRACKED_STACK_DEPTH];
+    CrcUint32 hash;
+    Uint64 count;
+    Uint64 bytes;
+    Uint64 live_count;
+    Uint64 live_bytes;
+    Uint64 lifetimes[NUM_LIFETIME_BUCKETS];
+    struct SDL_allocation_callsite *next;
+} SDL_allocation_callsite;
+
 typedef struct SDL_tracked_allocation
 {
     void *mem;
     size_t size;
     Uint64 stack[MAXIMUM_TRACKED_STACK_DEPTH];
+    Uint64 timestamp;
+    SDL_allocation_callsite *callsite;
     struct SDL_tracked_allocation *next;
 } SDL_tracked_allocation;
 
@@ -67,6 +84,11 @@ static SDL_free_func SDL_free_orig = NULL;
 static int s_previous_allocations = 0;
 static SDL_tracked_allocation *s_tracked_allocations[256];
 static SDL_bool s_randfill_allocations = SDL_FALSE;
+static SDL_bool s_profile_allocations = SDL_FALSE;
+static SDL_allocation_callsite *s_allocation_callsites[256];
+static Uint64 s_performance_frequency = 0;
+static int s_frame_allocations = 0;
+static Uint64 s_frame_allocated_bytes = 0;
 static SDL_AtomicInt s_lock;
 
 #define LOCK_ALLOCATOR()                               \
@@ -87,6 +109,45 @@ static unsigned int get_allocation_bucket(void *mem)
     return index;
 }
 
+/* This should be called with the allocator lock held */
+static SDL_allocation_callsite *SDL_GetAllocationCallsite(const Uint64 *stack)
+{
+    SDL_allocation_callsite *callsite;
+    CrcUint32 hash;
+    unsigned int index;
+
+    SDLTest_Crc32Calc(&s_crc32_context, (CrcUint8 *)stack, MAXIMUM_TRACKED_STACK_DEPTH * sizeof(*stack), &hash);
+    index = (hash & (SDL_arraysize(s_allocation_callsites) - 1));
+    for (callsite = s_allocation_callsites[index]; callsite; callsite = callsite->next) {
+        if (callsite->hash == hash && SDL_memcmp(callsite->stack, stack, sizeof(callsite->stack)) == 0) {
+            return callsite;
+        }
+    }
+
+    callsite = (SDL_allocation_callsite *)SDL_calloc_orig(1, sizeof(*callsite));
+    if (!callsite) {
+        return NULL;
+    }
+    SDL_memcpy(callsite->stack, stack, sizeof(callsite->stack));
+    callsite->hash = hash;
+    callsite->next = s_allocation_callsites[index];
+    s_allocation_callsites[index] = callsite;
+    return callsite;
+}
+
+static int get_lifetime_bucket(Uint64 elapsed)
+{
+    Uint64 us = (elapsed * 1000000) / s_performance_frequency;
+    Uint64 threshold = 1;
+    int bucket = 0;
+
+    while (bucket < (NUM_LIFETIME_BUCKETS - 1) && us >= threshold) {
+        threshold *= 10;
+        ++bucket;
+    }
+    return bucket;
+}
+
 static SDL_tracked_allocation* SDL_GetTrackedAllocation(void *mem)
 {
     SDL_tracked_allocation *entry;
@@ -170,6 +231,21 @@ static void SDL_TrackAllocation(void *mem, size_t size)
     }
 #endif /* HAVE_LIBUNWIND_H */
 
+    entry->timestamp = 0;
+    entry->callsite = NULL;
+    if (s_profile_allocations) {
+        entry->timestamp = SDL_GetPerformanceCounter();
+        entry->callsite = SDL_GetAllocationCallsite(entry->stack);
+        if (entry->callsite) {
+            entry->callsite->count += 1;
+            entry->callsite->bytes += size;
+            entry->callsite->live_count += 1;
+            entry->callsite->live_bytes += size;
+        }
+    }
+    ++s_frame_allocations;
+    s_frame_allocated_bytes += size;
+
     entry->next = s_tracked_allocations[index];
     s_tracked_allocations[index] = entry;
     UNLOCK_ALLOCATOR();
@@ -189,6 +265,13 @@ static void SDL_UntrackAllocation(void *mem)
             } else {
                 s_tracked_allocations[index] = entry->next;
             }
+            if (entry->callsite) {
+                SDL_allocation_callsite *callsite = entry->callsite;
+
+                callsite->live_count -= 1;
+                callsite->live_bytes -= entry->size;
+                callsite->lifetimes[get_lifetime_bucket(SDL_GetPerformanceCounter() - entry->timestamp)] += 1;
+            }
             SDL_free_orig(entry);
             UNLOCK_ALLOCATOR();
             return;
@@ -322,6 +405,84 @@ void SDLTest_RandFillAllocations(void)
     s_randfill_allocations = SDL_TRUE;
 }
 
+void SDLTest_ProfileAllocations(void)
+{
+    SDLTest_TrackAllocations();
+
+    if (!s_performance_frequency) {
+        s_performance_frequency = SDL_GetPerformanceFrequency();
+    }
+    s_profile_allocations = SDL_TRUE;
+}
+
+void SDLTest_GetFrameAllocations(int *count, Uint64 *bytes)
+{
+    LOCK_ALLOCATOR();
+    if (count) {
+        *count = s_frame_allocations;
+    }
+    if (bytes) {
+        *bytes = s_frame_allocated_bytes;
+    }
+    UNLOCK_ALLOCATOR();
+}
+
+void SDLTest_ResetFrameAllocations(void)
+{
+    LOCK_ALLOCATOR();
+    s_frame_allocations = 0;
+    s_frame_allocated_bytes = 0;
+    UNLOCK_ALLOCATOR();
+}
+
+static void get_stack_entry_description(Uint64 pc, char *description, size_t maxlen)
+{
+    SDL_strlcpy(description, "???", maxlen);
+#ifdef HAVE_LIBUNWIND_H
+    {
+#ifdef unw_get_proc_name_by_ip
+        unw_word_t offset = 0;
+        char name[256] = "???";
+        unw_get_proc_name_by_ip(unw_local_addr_space, pc, name, sizeof(name), &offset, NULL);
+        (void)SDL_snprintf(description, maxlen, "%s+0x%llx", name, (long long unsigned int)offset);
+#endif
+    }
+#elif defined(SDL_PLATFORM_WIN32)
+    {
+        DWORD64 dwDisplacement = 0;
+        char symbol_buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
+        PSYMBOL_INFO pSymbol = (PSYMBOL_INFO)symbol_buffer;
+        DWORD lineColumn = 0;
+        pSymbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        pSymbol->MaxNameLen = MAX_SYM_NAME;
+        IMAGEHLP_LINE64 dbg_line;
+        dbg_line.SizeOfStruct = sizeof(dbg_line);
+        dbg_line.FileName = "";
+        dbg_line.LineNumber = 0;
+
+        if (dyn_dbghelp.module) {
+            if (!dyn_dbghelp.pSymFromAddr(GetCurrentProcess(), pc, &dwDisplacement, pSymbol)) {
+                SDL_strlcpy(pSymbol->Name, "???", MAX_SYM_NAME);
+                dwDisplacement = 0;
+            }
+            dyn_dbghelp.pSymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)pc, &lineColumn, &dbg_line);
+        }
+        SDL_snprintf(description, maxlen, "%s+0x%I64x %s:%u", pSymbol->Name, dwDisplacement, dbg_line.FileName, (Uint32)dbg_line.LineNumber);
+    }
+#else
+    (void)pc;
+#endif
+}
+
+#define ADD_LINE()                                         \
+    message_size += (SDL_strlen(line) + 1);                \
+    tmp = (char *)SDL_realloc_orig(message, message_size); \
+    if (!tmp) {                                            \
+        return;                                            \
+    }                                                      \
+    message = tmp;                                         \
+    SDL_strlcat(message, line, message_size)
+
 void SDLTest_LogAllocations(void)
 {
     char *message = NULL;
@@ -341,15 +502,6 @@ void SDLTest_LogAllocations(void)
     }
     *message = 0;
 
-#define ADD_LINE()                                         \
-    message_size += (SDL_strlen(line) + 1);                \
-    tmp = (char *)SDL_realloc_orig(message, message_size); \
-    if (!tmp) {                                            \
-        return;                                            \
-    }                                                      \
-    message = tmp;                                         \
-    SDL_strlcat(message, line, message_size)
-
     SDL_strlcpy(line, "Memory allocations:\n", sizeof(line));
     ADD_LINE();
 
@@ -361,43 +513,12 @@ void SDLTest_LogAllocations(void)
             ADD_LINE();
             /* Start at stack index 1 to skip our tracking functions */
             for (stack_index = 1; stack_index < SDL_arraysize(entry->stack); ++stack_index) {
-                char stack_entry_description[256] = "???";
+                char stack_entry_description[256];
 
                 if (!entry->stack[stack_index]) {
                     break;
                 }
-#ifdef HAVE_LIBUNWIND_H
-                {
-#ifdef unw_get_proc_name_by_ip
-                    unw_word_t offset = 0;
-                    char name[256] = "???";
-                    unw_get_proc_name_by_ip(unw_local_addr_space, entry->stack[stack_index], name, sizeof(name), &offset, NULL);
-                    (void)SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s+0x%llx", name, (long long unsigned int)offset);
-#endif
-                }
-#elif defined(SDL_PLATFORM_WIN32)
-                {
-                    DWORD64 dwDisplacement = 0;
-                    char symbol_buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
-                    PSYMBOL_INFO pSymbol = (PSYMBOL_INFO)symbol_buffer;
-                    DWORD lineColumn = 0;
-                    pSymbol->SizeOfStruct = sizeof(SYMBOL_INFO);
-                    pSymbol->MaxNameLen = MAX_SYM_NAME;
-                    IMAGEHLP_LINE64 dbg_line;
-                    dbg_line.SizeOfStruct = sizeof(dbg_line);
-                    dbg_line.FileName = "";
-                    dbg_line.LineNumber = 0;
-
-                    if (dyn_dbghelp.module) {
-                        if (!dyn_dbghelp.pSymFromAddr(GetCurrentProcess(), entry->stack[stack_index], &dwDisplacement, pSymbol)) {
-                            SDL_strlcpy(pSymbol->Name, "???", MAX_SYM_NAME);
-                            dwDisplacement = 0;
-                        }
-                        dyn_dbghelp.pSymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)entry->stack[stack_index], &lineColumn, &dbg_line);
-                    }
-                    SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s+0x%I64x %s:%u", pSymbol->Name, dwDisplacement, dbg_line.FileName, (Uint32)dbg_line.LineNumber);
-                }
-#endif
+                get_stack_entry_description(entry->stack[stack_index], stack_entry_description, sizeof(stack_entry_description));
                 (void)SDL_snprintf(line, sizeof(line), "\t0x%" SDL_PRIx64 ": %s\n", entry->stack[stack_index], stack_entry_description);
 
                 ADD_LINE();
@@ -408,7 +529,109 @@ void SDLTest_LogAllocations(void)
     }
     (void)SDL_snprintf(line, sizeof(line), "Total: %.2f Kb in %d allocations\n", total_allocated / 1024.0, count);
     ADD_LINE();
-#undef ADD_LINE
 
     SDL_Log("%s", message);
 }
+
+static int SDLCALL compare_callsites(const void *a, const void *b)
+{
+    const SDL_allocation_callsite *A = *(const SDL_allocation_callsite * const *)a;
+    const SDL_allocation_callsite *B = *(const SDL_allocation_callsite * const *)b;
+
+    if (A->count != B->count) {
+        return (A->count > B->count) ? -1 : 1;
+    }
+    if (A->bytes != B->bytes) {
+        return (A->bytes > B->bytes) ? -1 : 1;
+    }
+    return 0;
+}
+
+void SDLTest_LogAllocationProfile(void)
+{
+    static const char *lifetime_names[NUM_LIFETIME_BUCKETS] = {
+        "<1us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s"
+    };
+    char *message = NULL;
+    size_t message_size = 0;
+    char line[256], *tmp;
+    SDL_allocation_callsite *callsite, **callsites;
+    int index, count, bucket, stack_index;
+    Uint64 total_count, total_bytes;
+
+    if (!s_profile_allocations) {
+        return;
+    }
+
+    LOCK_ALLOCATOR();
+    count = 0;
+    for (index = 0; index < SDL_arraysize(s_allocation_callsites); ++index) {
+        for (callsite = s_allocation_callsites[index]; callsite; callsite = callsite->next) {
+            ++count;
+        }
+    }
+    callsites = (SDL_allocation_callsite **)SDL_malloc_orig((count + 1) * sizeof(*callsites));
+    if (!callsites) {
+        UNLOCK_ALLOCATOR();
+        return;
+    }
+    count = 0;
+    for (index = 0; index < SDL_arraysize(s_allocation_callsites); ++index) {
+        for (callsite = s_allocation_callsites[index]; callsite; callsite = callsite->next) {
+            callsites[count++] = callsite;
+        }
+    }
+    UNLOCK_ALLOCATOR();
+
+    /* The counters may keep changing while we log, which is fine for a profile */
+    SDL_qsort(callsites, count, sizeof(*callsites), compare_callsites);
+
+    message = SDL_realloc_orig(NULL, 1);
+    if (!message) {
+        SDL_free_orig(callsites);
+        return;
+    }
+    *message = 0;
+
+    SDL_strlcpy(line, "Memory allocation profile:\n", sizeof(line));
+    ADD_LINE();
+
+    total_count = 0;
+    total_bytes = 0;
+    for (index = 0; index < count; ++index) {
+        callsite = callsites[index];
+
+        (void)SDL_snprintf(line, sizeof(line), "Callsite %d: %" SDL_PRIu64 " allocations, %.2f Kb total, %" SDL_PRIu64 " live (%.2f Kb)\n",
+                           index, callsite->count, callsite->bytes / 1024.0, callsite->live_count, callsite->live_bytes / 1024.0);
+        ADD_LINE();
+
+        SDL_strlcpy(line, "\tLifetimes:", sizeof(line));
+        for (bucket = 0; bucket < NUM_LIFETIME_BUCKETS; ++bucket) {
+            size_t length = SDL_strlen(line);
+            (void)SDL_snprintf(line + length, sizeof(line) - length, " %s:%" SDL_PRIu64, lifetime_names[bucket], callsite->lifetimes[bucket]);
+        }
+        SDL_strlcat(line, "\n", sizeof(line));
+        ADD_LINE();
+
+        /* Start at stack index 1 to skip our tracking functions */
+        for (stack_index = 1; stack_index < SDL_arraysize(callsite->stack); ++stack_index) {
+            char stack_entry_description[256];
+
+            if (!callsite->stack[stack_index]) {
+                break;
+            }
+            get_stack_entry_description(callsite->stack[stack_index], stack_entry_description, sizeof(stack_entry_description));
+            (void)SDL_snprintf(line, sizeof(line), "\t0x%" SDL_PRIx64 ": %s\n", callsite->stack[stack_index], stack_entry_description);
+            ADD_LINE();
+        }
+        total_count += callsite->count;
+        total_bytes += callsite->bytes;
+    }
+    (void)SDL_snprintf(line, sizeof(line), "Total: %.2f Kb in %" SDL_PRIu64 " allocations from %d callsites\n", total_bytes / 1024.0, total_count, count);
+    ADD_LINE();
+
+    SDL_free_orig(callsites);
+
+    SDL_Log("%s", message);
+}
+#undef ADD_LINE
@@ -0,0 +1,316 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_thread_c.h"
+
+/**
+ * Blocking on the value of an atomic variable
+ * There are three implementations available based on:
+ * - futex. Linux and Android. (futex)
+ * - WaitOnAddress. Requires Windows 8 or newer, chosen at runtime. (atom)
+ * - A hashed table of mutexes and condition variables. (generic)
+ */
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#define SDL_ADDRESSWAIT_FUTEX
+#elif defined(SDL_PLATFORM_WINDOWS) && !SDL_WINAPI_FAMILY_PHONE
+#define SDL_ADDRESSWAIT_ATOM
+#endif
+
+#ifdef SDL_ADDRESSWAIT_FUTEX
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+int SDL_WaitAtomicIntTimeoutNS(SDL_AtomicInt *a, int value, Sint64 timeoutNS)
+{
+    struct timespec timeout;
+    long rc;
+
+    if (!a) {
+        return SDL_InvalidParamError("a");
+    }
+
+    if (timeoutNS >= 0) {
+        timeout.tv_sec = (time_t)(timeoutNS / SDL_NS_PER_SECOND);
+        timeout.tv_nsec = (long)(timeoutNS % SDL_NS_PER_SECOND);
+    }
+    rc = syscall(SYS_futex, &a->value, FUTEX_WAIT_PRIVATE, value, (timeoutNS >= 0) ? &timeout : NULL, NULL, 0);
+    if (rc < 0) {
+        switch (errno) {
+        case EAGAIN: /* the value had already changed */
+        case EINTR:
+            break;
+        case ETIMEDOUT:
+            return SDL_MUTEX_TIMEDOUT;
+        default:
+            return SDL_SetError("futex() failed");
+        }
+    }
+    return 0;
+}
+
+void SDL_SignalAtomicInt(SDL_AtomicInt *a)
+{
+    if (a) {
+        syscall(SYS_futex, &a->value, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+void SDL_BroadcastAtomicInt(SDL_AtomicInt *a)
+{
+    if (a) {
+        syscall(SYS_futex, &a->value, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+void SDL_QuitAddressWait(void)
+{
+}
+
+#else /* !SDL_ADDRESSWAIT_FUTEX */
+
+/**
+ * Generic implementation
+ *
+ * Waiters on addresses that hash to the same bucket share a condition
+ * variable, so wakeups always go to the whole bucket and the woken threads
+ * sort out among themselves whether their value changed.
+ */
+
+#define SDL_ADDRESSWAIT_BUCKETS 64
+
+typedef struct SDL_AddressWaitBucket
+{
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_AtomicInt waiters;
+} SDL_AddressWaitBucket;
+
+static SDL_AddressWaitBucket SDL_address_wait_buckets[SDL_ADDRESSWAIT_BUCKETS];
+static SDL_SpinLock SDL_address_wait_lock;
+
+static SDL_AddressWaitBucket *SDL_GetAddressWaitBucket(SDL_AtomicInt *a)
+{
+    const uintptr_t hash = ((uintptr_t)a >> 2) * 0x9E3779B9u;
+    return &SDL_address_wait_buckets[(hash >> 8) % SDL_ADDRESSWAIT_BUCKETS];
+}
+
+static SDL_bool SDL_InitAddressWaitBucket(SDL_AddressWaitBucket *bucket)
+{
+    SDL_bool retval;
+
+    if (SDL_AtomicGetPtr((void **)&bucket->cond)) {
+        return SDL_TRUE;
+    }
+
+    SDL_LockSpinlock(&SDL_address_wait_lock);
+    if (!bucket->lock) {
+        bucket->lock = SDL_CreateMutex();
+    }
+    if (bucket->lock && !bucket->cond) {
+        SDL_AtomicSetPtr((void **)&bucket->cond, SDL_CreateCondition());
+    }
+    retval = (bucket->cond != NULL);
+    SDL_UnlockSpinlock(&SDL_address_wait_lock);
+
+    return retval;
+}
+
+static int SDL_WaitAtomicIntTimeoutNS_generic(SDL_AtomicInt *a, int value, Sint64 timeoutNS)
+{
+    SDL_AddressWaitBucket *bucket = SDL_GetAddressWaitBucket(a);
+    int retval = 0;
+
+    if (!SDL_InitAddressWaitBucket(bucket)) {
+        return -1;
+    }
+
+    SDL_LockMutex(bucket->lock);
+    SDL_AtomicIncRef(&bucket->waiters);
+    if (SDL_AtomicGet(a) == value) {
+        retval = SDL_WaitConditionTimeoutNS(bucket->cond, bucket->lock, timeoutNS);
+    }
+    SDL_AtomicAdd(&bucket->waiters, -1);
+    SDL_UnlockMutex(bucket->lock);
+
+    return retval;
+}
+
+static void SDL_WakeAtomicInt_generic(SDL_AtomicInt *a)
+{
+    SDL_AddressWaitBucket *bucket = SDL_GetAddressWaitBucket(a);
+
+    /* The waiter bumps the count before it checks the value, so if we don't
+       see it here it will see the value the caller already changed. */
+    if (SDL_AtomicGet(&bucket->waiters) > 0) {
+        SDL_LockMutex(bucket->lock);
+        SDL_BroadcastCondition(bucket->cond);
+        SDL_UnlockMutex(bucket->lock);
+    }
+}
+
+#ifdef SDL_ADDRESSWAIT_ATOM
+
+#include "../core/windows/SDL_windows.h"
+
+/**
+ * WaitOnAddress implementation
+ */
+
+#ifdef SDL_PLATFORM_WINRT
+/* Functions are guaranteed to be available */
+#define pWaitOnAddress       WaitOnAddress
+#define pWakeByAddressSingle WakeByAddressSingle
+#define pWakeByAddressAll    WakeByAddressAll
+#else
+typedef BOOL(WINAPI *pfnWaitOnAddress)(volatile VOID *, PVOID, SIZE_T, DWORD);
+typedef VOID(WINAPI *pfnWakeByAddressSingle)(PVOID);
+typedef VOID(WINAPI *pfnWakeByAddressAll)(PVOID);
+
+static pfnWaitOnAddress pWaitOnAddress = NULL;
+static pfnWakeByAddressSingle pWakeByAddressSingle = NULL;
+static pfnWakeByAddressAll pWakeByAddressAll = NULL;
+static SDL_AtomicInt SDL_address_wait_impl; /* 0: not chosen yet, 1: WaitOnAddress, 2: generic */
+#endif
+
+static SDL_bool SDL_HaveWaitOnAddress(void)
+{
+#ifdef SDL_PLATFORM_WINRT
+    return SDL_TRUE;
+#else
+    int impl = SDL_AtomicGet(&SDL_address_wait_impl);
+    if (impl == 0) {
+        HMODULE synch120 = GetModuleHandle(TEXT("api-ms-win-core-synch-l1-2-0.dll"));
+        impl = 2;
+        if (synch120) {
+            /* Try to load required functions provided by Win 8 or newer */
+            pWaitOnAddress = (pfnWaitOnAddress)GetProcAddress(synch120, "WaitOnAddress");
+            pWakeByAddressSingle = (pfnWakeByAddressSingle)GetProcAddress(synch120, "WakeByAddressSingle");
+            pWakeByAddressAll = (pfnWakeByAddressAll)GetProcAddress(synch120, "WakeByAddressAll");
+            if (pWaitOnAddress && pWakeByAddressSingle && pWakeByAddressAll) {
+                impl = 1;
+            }
+        }
+        SDL_AtomicSet(&SDL_address_wait_impl, impl);
+    }
+    return (impl == 1);
+#endif
+}
+
+int SDL_WaitAtomicIntTimeoutNS(SDL_AtomicInt *a, int value, Sint64 timeoutNS)
+{
+    DWORD timeout;
+
+    if (!a) {
+        return SDL_InvalidParamError("a");
+    }
+    if (!SDL_HaveWaitOnAddress()) {
+        return SDL_WaitAtomicIntTimeoutNS_generic(a, value, timeoutNS);
+    }
+
+    if (timeoutNS < 0) {
+        timeout = INFINITE;
+    } else {
+        timeout = (DWORD)SDL_NS_TO_MS(timeoutNS);
+    }
+    if (pWaitOnAddress(&a->value, &value, sizeof(a->value), timeout) == FALSE) {
+        if (GetLastError() == ERROR_TIMEOUT) {
+            return SDL_MUTEX_TIMEDOUT;
+        }
+        return SDL_SetError("WaitOnAddress() failed");
+    }
+    return 0;
+}
+
+void SDL_SignalAtomicInt(SDL_AtomicInt *a)
+{
+    if (!a) {
+        return;
+    }
+    if (SDL_HaveWaitOnAddress()) {
+        pWakeByAddressSingle(&a->value);
+    } else {
+        SDL_WakeAtomicInt_generic(a);
+    }
+}
+
+void SDL_BroadcastAtomicInt(SDL_AtomicInt *a)
+{
+    if (!a) {
+        return;
+    }
+    if (SDL_HaveWaitOnAddress()) {
+        pWakeByAddressAll(&a->value);
+    } else {
+        SDL_WakeAtomicInt_generic(a);
+    }
+}
+
+#else /* !SDL_ADDRESSWAIT_ATOM */
+
+int SDL_WaitAtomicIntTimeoutNS(SDL_AtomicInt *a, int value, Sint64 timeoutNS)
+{
+    if (!a) {
+        return SDL_InvalidParamError("a");
+    }
+    return SDL_WaitAtomicIntTimeoutNS_generic(a, value, timeoutNS);
+}
+
+void SDL_SignalAtomicInt(SDL_AtomicInt *a)
+{
+    if (a) {
+        SDL_WakeAtomicInt_generic(a);
+    }
+}
+
+void SDL_BroadcastAtomicInt(SDL_AtomicInt *a)
+{
+    if (a) {
+        SDL_WakeAtomicInt_generic(a);
+    }
+}
+
+#endif /* SDL_ADDRESSWAIT_ATOM */
+
+void SDL_QuitAddressWait(void)
+{
+    int i;
+
+    for (i = 0; i < SDL_ADDRESSWAIT_BUCKETS; ++i) {
+        SDL_AddressWaitBucket *bucket = &SDL_address_wait_buckets[i];
+        if (bucket->cond) {
+            SDL_DestroyCondition(bucket->cond);
+            bucket->cond = NULL;
+        }
+        if (bucket->lock) {
+            SDL_DestroyMutex(bucket->lock);
+            bucket->lock = NULL;
+        }
+    }
+}
+
+#endif /* SDL_ADDRESSWAIT_FUTEX */
@@ -46,6 +46,12 @@ extern void SDL_SYS_SetupThread(const char *name);
 /* This function sets the current thread priority */
 extern int SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority);
 
+/* This function restricts the current thread to the CPUs set in mask */
+extern int SDL_SYS_SetThreadAffinity(Uint64 mask);
+
+/* This sets the current thread priority for threads SDL runs for devices */
+extern int SDL_SetDeviceThreadPriority(SDL_ThreadPriority priority);
+
 /* This function waits for the thread to finish and frees any data
    allocated by SDL_SYS_CreateThread()
  */
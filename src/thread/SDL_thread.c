@@ -26,11 +26,40 @@
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
 
+#if defined(SDL_PLATFORM_LINUX) && !defined(SDL_THREADS_DISABLED)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 /* The storage is local to the thread, but the IDs are global for the process */
 
 static SDL_AtomicInt SDL_tls_allocated;
 static SDL_AtomicInt SDL_tls_id;
 
+#ifdef SDL_THREAD_LOCAL
+static SDL_THREAD_LOCAL SDL_TLSData *SDL_tls_storage;
+#endif
+
+static SDL_TLSData *SDL_GetTLSStorage(void)
+{
+#ifdef SDL_THREAD_LOCAL
+    return SDL_tls_storage;
+#else
+    return SDL_SYS_GetTLSData();
+#endif
+}
+
+static int SDL_SetTLSStorage(SDL_TLSData *storage)
+{
+#ifdef SDL_THREAD_LOCAL
+    SDL_tls_storage = storage;
+    return 0;
+#else
+    return SDL_SYS_SetTLSData(storage);
+#endif
+}
+
 void SDL_InitTLSData(void)
 {
     SDL_SYS_InitTLSData();
@@ -47,7 +76,7 @@ void *SDL_GetTLS(SDL_TLSID *id)
     }
 
     storage_index = SDL_AtomicGet(id) - 1;
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSStorage();
     if (!storage || storage_index < 0 || storage_index >= storage->limit) {
         return NULL;
     }
@@ -83,7 +112,7 @@ int SDL_SetTLS(SDL_TLSID *id, const void *value, SDL_TLSDestructorCallback destr
     }
 
     /* Get the storage for the current thread */
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSStorage();
     if (!storage || storage_index >= storage->limit) {
         unsigned int i, oldlimit, newlimit;
         SDL_TLSData *new_storage;
@@ -100,7 +129,7 @@ int SDL_SetTLS(SDL_TLSID *id, const void *value, SDL_TLSDestructorCallback destr
             storage->array[i].data = NULL;
             storage->array[i].destructor = NULL;
         }
-        if (SDL_SYS_SetTLSData(storage) != 0) {
+        if (SDL_SetTLSStorage(storage) != 0) {
             SDL_free(storage);
             return -1;
         }
@@ -117,7 +146,7 @@ void SDL_CleanupTLS(void)
     SDL_TLSData *storage;
 
     /* Cleanup the storage for the current thread */
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSStorage();
     if (storage) {
         int i;
         for (i = 0; i < storage->limit; ++i) {
@@ -125,10 +154,12 @@ void SDL_CleanupTLS(void)
                 storage->array[i].destructor(storage->array[i].data);
             }
         }
-        SDL_SYS_SetTLSData(NULL);
+        SDL_SetTLSStorage(NULL);
         SDL_free(storage);
         (void)SDL_AtomicDecRef(&SDL_tls_allocated);
     }
+
+    SDL_FlushMemoryCache();
 }
 
 void SDL_QuitTLSData(void)
@@ -145,9 +176,11 @@ void SDL_QuitTLSData(void)
 /* This is a generic implementation of thread-local storage which doesn't
    require additional OS support.
 
-   It is not especially efficient and doesn't clean up thread-local storage
-   as threads exit.  If there is a real OS that doesn't support thread-local
-   storage this implementation should be improved to be production quality.
+   Each thread that has stored something gets an entry in a list that is
+   only ever pushed to, so looking up the storage doesn't take a lock. The
+   entries aren't freed until SDL_Quit(); a thread that clears its storage
+   keeps its entry, and a later thread that gets the same ID reuses it. It
+   doesn't clean up thread-local storage as threads exit.
 */
 
 typedef struct SDL_TLSEntry
@@ -157,96 +190,73 @@ typedef struct SDL_TLSEntry
     struct SDL_TLSEntry *next;
 } SDL_TLSEntry;
 
-static SDL_Mutex *SDL_generic_TLS_mutex;
 static SDL_TLSEntry *SDL_generic_TLS;
 
 void SDL_Generic_InitTLSData(void)
 {
-    if (!SDL_generic_TLS_mutex) {
-        SDL_generic_TLS_mutex = SDL_CreateMutex();
-    }
 }
 
-SDL_TLSData *SDL_Generic_GetTLSData(void)
+static SDL_TLSEntry *SDL_Generic_FindTLSEntry(SDL_ThreadID thread)
 {
-    SDL_ThreadID thread = SDL_GetCurrentThreadID();
     SDL_TLSEntry *entry;
-    SDL_TLSData *storage = NULL;
 
-    SDL_LockMutex(SDL_generic_TLS_mutex);
-    for (entry = SDL_generic_TLS; entry; entry = entry->next) {
+    /* Entries are complete before they are published and are never unlinked */
+    for (entry = (SDL_TLSEntry *)SDL_AtomicGetPtr((void **)&SDL_generic_TLS); entry; entry = entry->next) {
         if (entry->thread == thread) {
-            storage = entry->storage;
-            break;
+            return entry;
         }
     }
-    SDL_UnlockMutex(SDL_generic_TLS_mutex);
+    return NULL;
+}
 
-    return storage;
+SDL_TLSData *SDL_Generic_GetTLSData(void)
+{
+    SDL_TLSEntry *entry = SDL_Generic_FindTLSEntry(SDL_GetCurrentThreadID());
+
+    return entry ? entry->storage : NULL;
 }
 
 int SDL_Generic_SetTLSData(SDL_TLSData *data)
 {
     SDL_ThreadID thread = SDL_GetCurrentThreadID();
-    SDL_TLSEntry *prev, *entry;
-    int retval = 0;
+    SDL_TLSEntry *entry;
 
-    SDL_LockMutex(SDL_generic_TLS_mutex);
-    prev = NULL;
-    for (entry = SDL_generic_TLS; entry; entry = entry->next) {
-        if (entry->thread == thread) {
-            if (data) {
-                entry->storage = data;
-            } else {
-                if (prev) {
-                    prev->next = entry->next;
-                } else {
-                    SDL_generic_TLS = entry->next;
-                }
-                SDL_free(entry);
-            }
-            break;
-        }
-        prev = entry;
-    }
-    if (!entry && data) {
-        entry = (SDL_TLSEntry *)SDL_malloc(sizeof(*entry));
-        if (entry) {
-            entry->thread = thread;
-            entry->storage = data;
-            entry->next = SDL_generic_TLS;
-            SDL_generic_TLS = entry;
-        } else {
-            retval = -1;
-        }
+    /* Only the owning thread ever touches the storage in its entry */
+    entry = SDL_Generic_FindTLSEntry(thread);
+    if (entry) {
+        entry->storage = data;
+        return 0;
     }
-    SDL_UnlockMutex(SDL_generic_TLS_mutex);
+    if (!data) {
+        return 0;
+    }
+
+    entry = (SDL_TLSEntry *)SDL_malloc(sizeof(*entry));
+    if (!entry) {
+        return -1;
+    }
+    entry->thread = thread;
+    entry->storage = data;
+    do {
+        entry->next = (SDL_TLSEntry *)SDL_AtomicGetPtr((void **)&SDL_generic_TLS);
+    } while (!SDL_AtomicCompareAndSwapPointer((void **)&SDL_generic_TLS, entry->next, entry));
 
-    return retval;
+    return 0;
 }
 
 void SDL_Generic_QuitTLSData(void)
 {
     SDL_TLSEntry *entry;
 
-    /* This should have been cleaned up by the time we get here */
-    SDL_assert(!SDL_generic_TLS);
-    if (SDL_generic_TLS) {
-        SDL_LockMutex(SDL_generic_TLS_mutex);
-        for (entry = SDL_generic_TLS; entry; ) {
-            SDL_TLSEntry *next = entry->next;
-            SDL_free(entry->storage);
-            SDL_free(entry);
-            entry = next;
-        }
-        SDL_generic_TLS = NULL;
-        SDL_UnlockMutex(SDL_generic_TLS_mutex);
-    }
-
-    if (SDL_generic_TLS_mutex) {
-        SDL_DestroyMutex(SDL_generic_TLS_mutex);
-        SDL_generic_TLS_mutex = NULL;
+    for (entry = SDL_generic_TLS; entry; ) {
+        SDL_TLSEntry *next = entry->next;
+        /* This should have been cleaned up by the time we get here */
+        SDL_assert(!entry->storage);
+        SDL_free(entry->storage);
+        SDL_free(entry);
+        entry = next;
     }
+    SDL_generic_TLS = NULL;
 }
 
 /* Non-thread-safe global error variable */
@@ -260,10 +270,22 @@ static SDL_error *SDL_GetStaticErrBuf(void)
 }
 
 #ifndef SDL_THREADS_DISABLED
+#ifdef SDL_THREAD_LOCAL
+/* A copy of this thread's TLS error buffer pointer, so finding it is a single load */
+static SDL_THREAD_LOCAL SDL_error *SDL_errbuf;
+#endif
+
+/* This is called on the thread that owns the buffer, when its TLS is cleaned up */
 static void SDLCALL SDL_FreeErrBuf(void *data)
 {
     SDL_error *errbuf = (SDL_error *)data;
 
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_errbuf == errbuf) {
+        SDL_errbuf = NULL;
+    }
+#endif
+
     if (errbuf->str) {
         errbuf->free_func(errbuf->str);
     }
@@ -280,6 +302,13 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
     static SDL_TLSID tls_errbuf;
     SDL_error *errbuf;
 
+#ifdef SDL_THREAD_LOCAL
+    errbuf = SDL_errbuf;
+    if (errbuf) {
+        return errbuf;
+    }
+#endif
+
     errbuf = (SDL_error *)SDL_GetTLS(&tls_errbuf);
     if (!errbuf) {
         if (!create) {
@@ -300,8 +329,14 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
         SDL_zerop(errbuf);
         errbuf->realloc_func = realloc_func;
         errbuf->free_func = free_func;
-        SDL_SetTLS(&tls_errbuf, errbuf, SDL_FreeErrBuf);
+        if (SDL_SetTLS(&tls_errbuf, errbuf, SDL_FreeErrBuf) < 0) {
+            free_func(errbuf);
+            return SDL_GetStaticErrBuf();
+        }
     }
+#ifdef SDL_THREAD_LOCAL
+    SDL_errbuf = errbuf;
+#endif
     return errbuf;
 #endif /* SDL_THREADS_DISABLED */
 }
@@ -316,9 +351,19 @@ void SDL_RunThread(SDL_Thread *thread)
     /* Perform any system-dependent setup - this function may not fail */
     SDL_SYS_SetupThread(thread->name);
 
+    /* The affinity is a placement request, the thread runs either way */
+    if (thread->affinity_mask && SDL_SYS_SetThreadAffinity(thread->affinity_mask) < 0) {
+        SDL_ClearError();
+    }
+
     /* Get the thread id */
     thread->threadid = SDL_GetCurrentThreadID();
 
+    SDL_TRACE_THREAD_NAME(thread->name);
+
+    /* SDL_CleanupTLS() flushes the memory cache when the function returns */
+    SDL_EnableMemoryCache();
+
     /* Run the function */
     *statusloc = userfunc(userdata);
 
@@ -331,6 +376,7 @@ void SDL_RunThread(SDL_Thread *thread)
         if (SDL_AtomicCompareAndSwap(&thread->state, SDL_THREAD_STATE_DETACHED, SDL_THREAD_STATE_CLEANED)) {
             SDL_free(thread->name); /* Can't free later, we've already cleaned up TLS */
             SDL_free(thread);
+            SDL_FlushMemoryCache();
         }
     }
 }
@@ -351,6 +397,12 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     const char *name = SDL_GetStringProperty(props, SDL_PROP_THREAD_CREATE_NAME_STRING, NULL);
     const size_t stacksize = (size_t) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER, 0);
     void *userdata = SDL_GetPointerProperty(props, SDL_PROP_THREAD_CREATE_USERDATA_POINTER, NULL);
+    Uint64 affinity_mask = (Uint64) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_AFFINITY_MASK_NUMBER, 0);
+    const SDL_CPUCoreType core_type = (SDL_CPUCoreType) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER, SDL_CPU_CORE_TYPE_ANY);
+
+    if (!affinity_mask && core_type != SDL_CPU_CORE_TYPE_ANY) {
+        affinity_mask = SDL_GetCPUCoreMask(core_type);
+    }
 
     if (!fn) {
         SDL_SetError("Thread entry function is NULL");
@@ -378,6 +430,7 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     thread->userfunc = fn;
     thread->userdata = userdata;
     thread->stacksize = stacksize;
+    thread->affinity_mask = affinity_mask;
 
     // Create the thread and go!
     if (SDL_SYS_CreateThread(thread, pfnBeginThread, pfnEndThread) < 0) {
@@ -444,6 +497,31 @@ int SDL_SetThreadPriority(SDL_ThreadPriority priority)
     return SDL_SYS_SetThreadPriority(priority);
 }
 
+int SDL_SetDeviceThreadPriority(SDL_ThreadPriority priority)
+{
+    /* Keep deadline-driven threads off the efficiency cores of hybrid processors */
+    if (priority >= SDL_THREAD_PRIORITY_HIGH &&
+        SDL_GetHintBoolean(SDL_HINT_THREAD_DEVICE_REALTIME, SDL_FALSE) &&
+        SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_EFFICIENCY) > 0) {
+        const Uint64 mask = SDL_GetCPUCoreMask(SDL_CPU_CORE_TYPE_PERFORMANCE);
+        if (mask && SDL_SYS_SetThreadAffinity(mask) < 0) {
+            SDL_ClearError();
+        }
+    }
+
+#if defined(SDL_PLATFORM_LINUX) && !defined(SDL_THREADS_DISABLED)
+    if (priority >= SDL_THREAD_PRIORITY_HIGH &&
+        SDL_GetHintBoolean(SDL_HINT_THREAD_DEVICE_REALTIME, SDL_FALSE)) {
+        const pid_t tid = (pid_t)syscall(SYS_gettid);
+        if (SDL_SetLinuxThreadPriorityAndPolicy(tid, priority, SCHED_RR) == 0) {
+            return 0;
+        }
+        SDL_ClearError();
+    }
+#endif
+    return SDL_SetThreadPriority(priority);
+}
+
 void SDL_WaitThread(SDL_Thread *thread, int *status)
 {
     if (thread) {
@@ -516,3 +594,20 @@ int SDL_WaitConditionTimeout(SDL_Condition *cond, SDL_Mutex *mutex, Sint32 timeo
     }
     return SDL_WaitConditionTimeoutNS(cond, mutex, timeoutNS);
 }
+
+int SDL_WaitAtomicInt(SDL_AtomicInt *a, int value)
+{
+    return SDL_WaitAtomicIntTimeoutNS(a, value, -1);
+}
+
+int SDL_WaitAtomicIntTimeout(SDL_AtomicInt *a, int value, Sint32 timeoutMS)
+{
+    Sint64 timeoutNS;
+
+    if (timeoutMS >= 0) {
+        timeoutNS = SDL_MS_TO_NS(timeoutMS);
+    } else {
+        timeoutNS = -1;
+    }
+    return SDL_WaitAtomicIntTimeoutNS(a, value, timeoutNS);
+}
@@ -66,6 +66,7 @@ struct SDL_Thread
     SDL_error errbuf;
     char *name;
     size_t stacksize; /* 0 for default, >0 for user-specified stack size. */
+    Uint64 affinity_mask; /* 0 for any CPU, otherwise the CPUs the thread may run on. */
     int(SDLCALL *userfunc)(void *);
     void *userdata;
     void *data;
@@ -89,9 +90,24 @@ typedef struct
 /* This is how many TLS entries we allocate at once */
 #define TLS_ALLOC_CHUNKSIZE 4
 
+/* Where the compiler's thread-local storage is known to work, the TLS array
+   lives in a thread-local variable and SDL_GetTLS() doesn't need to call
+   into the system at all. */
+#if defined(_MSC_VER)
+#define SDL_THREAD_LOCAL __declspec(thread)
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID) || defined(SDL_PLATFORM_WIN32) || \
+     defined(SDL_PLATFORM_MACOS) || defined(SDL_PLATFORM_FREEBSD) || defined(SDL_PLATFORM_NETBSD) || \
+     defined(SDL_PLATFORM_OPENBSD))
+#define SDL_THREAD_LOCAL __thread
+#endif
+
 extern void SDL_InitTLSData(void);
 extern void SDL_QuitTLSData(void);
 
+/* Frees the condition variables used by the generic SDL_WaitAtomicInt() */
+extern void SDL_QuitAddressWait(void);
+
 /* Generic TLS support.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
@@ -0,0 +1,510 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* A work-stealing thread pool.
+
+   Every worker owns a fixed size Chase-Lev deque: the owner pushes and pops
+   jobs at the bottom without taking a lock, while idle workers steal from
+   the top with a compare-and-swap. Jobs started from threads that aren't
+   workers of the pool, or that don't fit in the worker's deque, go on a
+   shared queue protected by the pool lock.
+ */
+
+#define SDL_JOB_DEQUE_SIZE 1024 /* must be a power of two */
+#define SDL_JOB_DEQUE_MASK (SDL_JOB_DEQUE_SIZE - 1)
+
+typedef struct SDL_JobLink
+{
+    SDL_Job *job;
+    struct SDL_JobLink *next;
+} SDL_JobLink;
+
+struct SDL_Job
+{
+    SDL_ThreadPool *pool;
+    SDL_JobFunction callback;
+    void *userdata;
+    SDL_AtomicInt refcount;   /* one for the caller's handle, one until the job has run */
+    SDL_AtomicInt blockers;   /* unfinished dependencies, plus one until SDL_RunJob() */
+    SDL_AtomicInt done;
+    SDL_bool started;
+    SDL_JobLink *dependents;  /* protected by pool->dependency_lock */
+    SDL_Job *next;            /* link in the shared queue */
+};
+
+typedef struct SDL_JobDeque
+{
+    SDL_AtomicInt top;
+    SDL_AtomicInt bottom;
+    void *jobs[SDL_JOB_DEQUE_SIZE];
+} SDL_JobDeque;
+
+typedef struct SDL_ThreadPoolWorker
+{
+    SDL_ThreadPool *pool;
+    SDL_Thread *thread;
+    Uint32 random;
+    SDL_JobDeque deque;
+} SDL_ThreadPoolWorker;
+
+struct SDL_ThreadPool
+{
+    SDL_ThreadPoolWorker *workers;
+    int num_workers;
+    SDL_ThreadPriority priority;
+    SDL_Mutex *lock;
+    SDL_Condition *wake_cond;
+    SDL_Condition *done_cond;
+    SDL_Job *queue_head;      /* protected by lock */
+    SDL_Job *queue_tail;      /* protected by lock */
+    SDL_AtomicInt queued;     /* jobs sitting in any queue */
+    SDL_AtomicInt outstanding; /* jobs started that haven't finished */
+    SDL_AtomicInt sleeping;   /* workers waiting on wake_cond */
+    SDL_AtomicInt waiting;    /* threads waiting on done_cond */
+    SDL_AtomicInt quit;
+    SDL_SpinLock dependency_lock;
+};
+
+static SDL_TLSID SDL_thread_pool_worker;
+
+/* Called only by the owning worker */
+static SDL_bool SDL_PushJobDeque(SDL_JobDeque *deque, SDL_Job *job)
+{
+    const Uint32 bottom = (Uint32)SDL_AtomicGet(&deque->bottom);
+    const Uint32 top = (Uint32)SDL_AtomicGet(&deque->top);
+
+    if ((bottom - top) >= SDL_JOB_DEQUE_SIZE) {
+        return SDL_FALSE;
+    }
+    SDL_AtomicSetPtr(&deque->jobs[bottom & SDL_JOB_DEQUE_MASK], job);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&deque->bottom, (int)(bottom + 1));
+    return SDL_TRUE;
+}
+
+/* Called only by the owning worker */
+static SDL_Job *SDL_PopJobDeque(SDL_JobDeque *deque)
+{
+    const Uint32 bottom = (Uint32)SDL_AtomicAdd(&deque->bottom, -1) - 1;
+    const Uint32 top = (Uint32)SDL_AtomicGet(&deque->top);
+    SDL_Job *job;
+
+    if ((Sint32)(bottom - top) < 0) {
+        /* The deque was empty */
+        SDL_AtomicSet(&deque->bottom, (int)(bottom + 1));
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_AtomicGetPtr(&deque->jobs[bottom & SDL_JOB_DEQUE_MASK]);
+    if (bottom != top) {
+        return job;
+    }
+
+    /* This was the last job, race any thieves for it */
+    if (!SDL_AtomicCompareAndSwap(&deque->top, (int)top, (int)(top + 1))) {
+        job = NULL;
+    }
+    SDL_AtomicSet(&deque->bottom, (int)(bottom + 1));
+    return job;
+}
+
+/* Called by any thread */
+static SDL_Job *SDL_StealJobDeque(SDL_JobDeque *deque)
+{
+    const Uint32 top = (Uint32)SDL_AtomicGet(&deque->top);
+    const Uint32 bottom = (Uint32)SDL_AtomicGet(&deque->bottom);
+    SDL_Job *job;
+
+    if ((Sint32)(bottom - top) <= 0) {
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_AtomicGetPtr(&deque->jobs[top & SDL_JOB_DEQUE_MASK]);
+    if (!SDL_AtomicCompareAndSwap(&deque->top, (int)top, (int)(top + 1))) {
+        return NULL; /* Somebody else got it first */
+    }
+    return job;
+}
+
+static void SDL_ReleaseJob(SDL_Job *job)
+{
+    if (SDL_AtomicDecRef(&job->refcount)) {
+        SDL_free(job);
+    }
+}
+
+static void SDL_ScheduleJob(SDL_Job *job)
+{
+    SDL_ThreadPool *pool = job->pool;
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *)SDL_GetTLS(&SDL_thread_pool_worker);
+
+    if (!worker || worker->pool != pool || !SDL_PushJobDeque(&worker->deque, job)) {
+        SDL_LockMutex(pool->lock);
+        job->next = NULL;
+        if (pool->queue_tail) {
+            pool->queue_tail->next = job;
+        } else {
+            pool->queue_head = job;
+        }
+        pool->queue_tail = job;
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    SDL_AtomicIncRef(&pool->queued);
+    if (SDL_AtomicGet(&pool->sleeping) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_SignalCondition(pool->wake_cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static SDL_Job *SDL_TakeJob(SDL_ThreadPoolWorker *worker)
+{
+    SDL_ThreadPool *pool = worker->pool;
+    SDL_Job *job;
+    int i, victim;
+
+    job = SDL_PopJobDeque(&worker->deque);
+
+    if (!job && SDL_AtomicGetPtr((void **)&pool->queue_head)) {
+        SDL_LockMutex(pool->lock);
+        job = pool->queue_head;
+        if (job) {
+            pool->queue_head = job->next;
+            if (!pool->queue_head) {
+                pool->queue_tail = NULL;
+            }
+        }
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    if (!job && pool->num_workers > 1) {
+        /* Start stealing at a random worker so thieves don't all pile onto the same deque */
+        worker->random ^= worker->random << 13;
+        worker->random ^= worker->random >> 17;
+        worker->random ^= worker->random << 5;
+        victim = (int)(worker->random % (Uint32)pool->num_workers);
+        for (i = 0; i < pool->num_workers && !job; ++i, victim = (victim + 1) % pool->num_workers) {
+            if (&pool->workers[victim] != worker) {
+                job = SDL_StealJobDeque(&pool->workers[victim].deque);
+            }
+        }
+    }
+
+    if (job) {
+        SDL_AtomicDecRef(&pool->queued);
+    }
+    return job;
+}
+
+static void SDL_ExecuteJob(SDL_Job *job)
+{
+    SDL_ThreadPool *pool = job->pool;
+    SDL_JobLink *link;
+
+    job->callback(job->userdata);
+
+    SDL_LockSpinlock(&pool->dependency_lock);
+    SDL_AtomicIncRef(&job->done);
+    link = job->dependents;
+    job->dependents = NULL;
+    SDL_UnlockSpinlock(&pool->dependency_lock);
+
+    while (link) {
+        SDL_JobLink *next = link->next;
+        if (SDL_AtomicDecRef(&link->job->blockers)) {
+            SDL_ScheduleJob(link->job);
+        }
+        SDL_free(link);
+        link = next;
+    }
+
+    SDL_AtomicDecRef(&pool->outstanding);
+    if (SDL_AtomicGet(&pool->waiting) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_BroadcastCondition(pool->done_cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    SDL_ReleaseJob(job);
+}
+
+static int SDLCALL SDL_ThreadPoolWorkerThread(void *data)
+{
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *)data;
+    SDL_ThreadPool *pool = worker->pool;
+
+    SDL_SetTLS(&SDL_thread_pool_worker, worker, NULL);
+    SDL_SetThreadPriority(pool->priority);
+
+    while (!SDL_AtomicGet(&pool->quit)) {
+        SDL_Job *job = SDL_TakeJob(worker);
+        if (job) {
+            SDL_ExecuteJob(job);
+        } else if (SDL_AtomicGet(&pool->queued) > 0) {
+            /* Another thread is in the middle of handing off a job */
+            SDL_CPUPauseInstruction();
+        } else {
+            SDL_LockMutex(pool->lock);
+            SDL_AtomicIncRef(&pool->sleeping);
+            while (!SDL_AtomicGet(&pool->quit) && SDL_AtomicGet(&pool->queued) <= 0) {
+                SDL_WaitCondition(pool->wake_cond, pool->lock);
+            }
+            SDL_AtomicDecRef(&pool->sleeping);
+            SDL_UnlockMutex(pool->lock);
+        }
+    }
+    return 0;
+}
+
+static void SDL_StopThreadPoolWorkers(SDL_ThreadPool *pool)
+{
+    int i;
+
+    SDL_LockMutex(pool->lock);
+    SDL_AtomicSet(&pool->quit, 1);
+    SDL_BroadcastCondition(pool->wake_cond);
+    SDL_UnlockMutex(pool->lock);
+
+    for (i = 0; i < pool->num_workers; ++i) {
+        SDL_WaitThread(pool->workers[i].thread, NULL);
+        pool->workers[i].thread = NULL;
+    }
+}
+
+static void SDL_FreeThreadPool(SDL_ThreadPool *pool)
+{
+    SDL_DestroyCondition(pool->done_cond);
+    SDL_DestroyCondition(pool->wake_cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool->workers);
+    SDL_free(pool);
+}
+
+SDL_ThreadPool *SDL_CreateThreadPool(int num_threads, SDL_ThreadPriority priority)
+{
+    SDL_ThreadPool *pool;
+    int i;
+
+    if (num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_max(SDL_GetCPUCount(), 1);
+    }
+
+    pool = (SDL_ThreadPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->priority = priority;
+    pool->workers = (SDL_ThreadPoolWorker *)SDL_calloc(num_threads, sizeof(*pool->workers));
+    pool->lock = SDL_CreateMutex();
+    pool->wake_cond = SDL_CreateCondition();
+    pool->done_cond = SDL_CreateCondition();
+    if (!pool->workers || !pool->lock || !pool->wake_cond || !pool->done_cond) {
+        SDL_FreeThreadPool(pool);
+        return NULL;
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        SDL_ThreadPoolWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->random = (Uint32)(i + 1) * 0x9E3779B9u;
+        worker->thread = SDL_CreateThread(SDL_ThreadPoolWorkerThread, "SDLPoolWorker", worker);
+        if (!worker->thread) {
+            break;
+        }
+    }
+    pool->num_workers = i;
+
+    if (pool->num_workers < num_threads) {
+        SDL_StopThreadPoolWorkers(pool);
+        SDL_FreeThreadPool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+static SDL_Job *SDL_CreateJobInternal(SDL_ThreadPool *pool, SDL_JobFunction callback, void *userdata, int refcount)
+{
+    SDL_Job *job;
+
+    if (!pool) {
+        SDL_InvalidParamError("pool");
+        return NULL;
+    }
+    if (!callback) {
+        SDL_InvalidParamError("callback");
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_calloc(1, sizeof(*job));
+    if (!job) {
+        return NULL;
+    }
+    job->pool = pool;
+    job->callback = callback;
+    job->userdata = userdata;
+    SDL_AtomicSet(&job->refcount, refcount);
+    SDL_AtomicSet(&job->blockers, 1);
+    return job;
+}
+
+int SDL_SubmitJob(SDL_ThreadPool *pool, SDL_JobFunction callback, void *userdata)
+{
+    SDL_Job *job = SDL_CreateJobInternal(pool, callback, userdata, 1);
+    if (!job) {
+        return -1;
+    }
+    return SDL_RunJob(job);
+}
+
+SDL_Job *SDL_CreateJob(SDL_ThreadPool *pool, SDL_JobFunction callback, void *userdata)
+{
+    return SDL_CreateJobInternal(pool, callback, userdata, 2);
+}
+
+int SDL_AddJobDependency(SDL_Job *job, SDL_Job *dependency)
+{
+    SDL_ThreadPool *pool;
+    SDL_JobLink *link;
+
+    if (!job) {
+        return SDL_InvalidParamError("job");
+    }
+    if (!dependency || dependency == job) {
+        return SDL_InvalidParamError("dependency");
+    }
+    if (job->started) {
+        return SDL_SetError("Job has already been started");
+    }
+    pool = job->pool;
+    if (dependency->pool != pool) {
+        return SDL_SetError("Jobs belong to different thread pools");
+    }
+
+    link = (SDL_JobLink *)SDL_malloc(sizeof(*link));
+    if (!link) {
+        return -1;
+    }
+
+    SDL_LockSpinlock(&pool->dependency_lock);
+    if (!SDL_AtomicGet(&dependency->done)) {
+        link->job = job;
+        link->next = dependency->dependents;
+        dependency->dependents = link;
+        SDL_AtomicIncRef(&job->blockers);
+        link = NULL;
+    }
+    SDL_UnlockSpinlock(&pool->dependency_lock);
+
+    SDL_free(link); /* the dependency had already finished */
+    return 0;
+}
+
+int SDL_RunJob(SDL_Job *job)
+{
+    if (!job) {
+        return SDL_InvalidParamError("job");
+    }
+    if (job->started) {
+        return SDL_SetError("Job has already been started");
+    }
+    job->started = SDL_TRUE;
+
+    SDL_AtomicIncRef(&job->pool->outstanding);
+    if (SDL_AtomicDecRef(&job->blockers)) {
+        SDL_ScheduleJob(job);
+    }
+    return 0;
+}
+
+void SDL_WaitJob(SDL_Job *job)
+{
+    SDL_ThreadPool *pool;
+    SDL_ThreadPoolWorker *worker;
+
+    if (!job) {
+        return;
+    }
+    if (!job->started) {
+        SDL_RunJob(job);
+    }
+
+    pool = job->pool;
+    worker = (SDL_ThreadPoolWorker *)SDL_GetTLS(&SDL_thread_pool_worker);
+    if (worker && worker->pool == pool) {
+        /* Help out with other jobs rather than tying up a worker */
+        while (!SDL_AtomicGet(&job->done)) {
+            SDL_Job *other = SDL_TakeJob(worker);
+            if (other) {
+                SDL_ExecuteJob(other);
+            } else {
+                SDL_LockMutex(pool->lock);
+                SDL_AtomicIncRef(&pool->waiting);
+                if (!SDL_AtomicGet(&job->done)) {
+                    SDL_WaitConditionTimeout(pool->done_cond, pool->lock, 1);
+                }
+                SDL_AtomicDecRef(&pool->waiting);
+                SDL_UnlockMutex(pool->lock);
+            }
+        }
+    } else {
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->waiting);
+        while (!SDL_AtomicGet(&job->done)) {
+            SDL_WaitCondition(pool->done_cond, pool->lock);
+        }
+        SDL_AtomicDecRef(&pool->waiting);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    SDL_ReleaseJob(job);
+}
+
+void SDL_WaitThreadPool(SDL_ThreadPool *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+    SDL_AtomicIncRef(&pool->waiting);
+    while (SDL_AtomicGet(&pool->outstanding) > 0) {
+        SDL_WaitCondition(pool->done_cond, pool->lock);
+    }
+    SDL_AtomicDecRef(&pool->waiting);
+    SDL_UnlockMutex(pool->lock);
+}
+
+void SDL_DestroyThreadPool(SDL_ThreadPool *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    SDL_WaitThreadPool(pool);
+    SDL_StopThreadPoolWorkers(pool);
+    SDL_FreeThreadPool(pool);
+}
@@ -72,6 +72,11 @@ SDL_ThreadID SDL_GetCurrentThreadID(void)
     return (SDL_ThreadID)sceKernelGetThreadId();
 }
 
+int SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+    return SDL_Unsupported();
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     sceKernelWaitThreadEnd(thread->handle, NULL);
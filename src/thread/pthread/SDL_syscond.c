@@ -28,6 +28,81 @@
 
 #include "SDL_sysmutex_c.h"
 
+#ifdef SDL_THREAD_FUTEX_MUTEX
+
+/* Waiters sleep on a sequence number that every signal bumps, so a signal
+   that lands between unlocking the mutex and going to sleep isn't lost. */
+struct SDL_Condition
+{
+    SDL_AtomicInt sequence;
+    SDL_AtomicInt waiters;
+};
+
+/* Create a condition variable */
+SDL_Condition *SDL_CreateCondition(void)
+{
+    return (SDL_Condition *)SDL_calloc(1, sizeof(SDL_Condition));
+}
+
+/* Destroy a condition variable */
+void SDL_DestroyCondition(SDL_Condition *cond)
+{
+    SDL_free(cond);
+}
+
+/* Restart one of the threads that are waiting on the condition variable */
+int SDL_SignalCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    SDL_AtomicAdd(&cond->sequence, 1);
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_SignalAtomicInt(&cond->sequence);
+    }
+    return 0;
+}
+
+/* Restart all threads that are waiting on the condition variable */
+int SDL_BroadcastCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    SDL_AtomicAdd(&cond->sequence, 1);
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_BroadcastAtomicInt(&cond->sequence);
+    }
+    return 0;
+}
+
+int SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS)
+{
+    int sequence;
+    int retval;
+
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+    if (!mutex) {
+        return SDL_InvalidParamError("mutex");
+    }
+
+    SDL_AtomicIncRef(&cond->waiters);
+    sequence = SDL_AtomicGet(&cond->sequence);
+
+    SDL_UnlockMutex(mutex);
+    retval = SDL_WaitAtomicIntTimeoutNS(&cond->sequence, sequence, timeoutNS);
+    SDL_LockMutex(mutex);
+
+    SDL_AtomicAdd(&cond->waiters, -1);
+    return retval;
+}
+
+#else
+
 struct SDL_Condition
 {
     pthread_cond_t cond;
@@ -141,3 +216,5 @@ tryagain:
     }
     return retval;
 }
+
+#endif // SDL_THREAD_FUTEX_MUTEX
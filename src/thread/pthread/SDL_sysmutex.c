@@ -25,6 +25,103 @@
 
 #include "SDL_sysmutex_c.h"
 
+#ifdef SDL_THREAD_FUTEX_MUTEX
+
+/* How many times to retry a contended lock before sleeping in the kernel */
+#define SDL_MUTEX_SPIN_COUNT 100
+
+SDL_Mutex *SDL_CreateMutex(void)
+{
+    /* Zero is the unlocked state, so there's nothing else to set up */
+    return (SDL_Mutex *)SDL_calloc(1, sizeof(SDL_Mutex));
+}
+
+void SDL_DestroyMutex(SDL_Mutex *mutex)
+{
+    SDL_free(mutex);
+}
+
+void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex != NULL) {
+        const SDL_ThreadID this_thread = SDL_GetCurrentThreadID();
+        int spins;
+
+        if (mutex->owner == this_thread) {
+            ++mutex->recursive;
+            return;
+        }
+
+        if (!SDL_AtomicCompareAndSwap(&mutex->state, 0, 1)) {
+            /* Short critical sections are usually over before a trip into the kernel would be */
+            for (spins = 0; spins < SDL_MUTEX_SPIN_COUNT; ++spins) {
+                SDL_CPUPauseInstruction();
+                if (SDL_AtomicGet(&mutex->state) == 0 && SDL_AtomicCompareAndSwap(&mutex->state, 0, 1)) {
+                    break;
+                }
+            }
+            if (spins == SDL_MUTEX_SPIN_COUNT) {
+                /* Mark the lock as contended so the owner wakes us up when it unlocks */
+                while (SDL_AtomicSet(&mutex->state, 2) != 0) {
+                    SDL_WaitAtomicIntTimeoutNS(&mutex->state, 2, -1);
+                }
+            }
+        }
+
+        /* The order of operations is important.
+           We set the locking thread id after we obtain the lock
+           so unlocks from other threads will fail.
+         */
+        mutex->owner = this_thread;
+        mutex->recursive = 0;
+    }
+}
+
+int SDL_TryLockMutex(SDL_Mutex *mutex)
+{
+    int retval = 0;
+
+    if (mutex) {
+        const SDL_ThreadID this_thread = SDL_GetCurrentThreadID();
+        if (mutex->owner == this_thread) {
+            ++mutex->recursive;
+        } else if (SDL_AtomicCompareAndSwap(&mutex->state, 0, 1)) {
+            mutex->owner = this_thread;
+            mutex->recursive = 0;
+        } else {
+            retval = SDL_MUTEX_TIMEDOUT;
+        }
+    }
+
+    return retval;
+}
+
+void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex != NULL) {
+        // We can only unlock the mutex if we own it
+        if (mutex->owner == SDL_GetCurrentThreadID()) {
+            if (mutex->recursive) {
+                --mutex->recursive;
+            } else {
+                /* The order of operations is important.
+                   First reset the owner so another thread doesn't lock
+                   the mutex and set the ownership before we reset it,
+                   then release the lock and wake a waiter if there are any.
+                 */
+                mutex->owner = 0;
+                if (SDL_AtomicSet(&mutex->state, 0) == 2) {
+                    SDL_SignalAtomicInt(&mutex->state);
+                }
+            }
+        } else {
+            SDL_SetError("mutex not owned by this thread");
+        }
+    }
+}
+
+#else
+
 SDL_Mutex *SDL_CreateMutex(void)
 {
     SDL_Mutex *mutex;
@@ -152,3 +249,4 @@ void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang do
     }
 }
 
+#endif // SDL_THREAD_FUTEX_MUTEX
@@ -23,18 +23,32 @@
 #ifndef SDL_mutex_c_h_
 #define SDL_mutex_c_h_
 
-#if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
+/* On Linux the mutex and condition variable are built directly on futex,
+   which lets an uncontended lock stay in user space and spin briefly
+   before sleeping. */
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#define SDL_THREAD_FUTEX_MUTEX
+#endif
+
+#if !defined(SDL_THREAD_FUTEX_MUTEX) && \
+    !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
     defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
 #define FAKE_RECURSIVE_MUTEX
 #endif
 
 struct SDL_Mutex
 {
+#ifdef SDL_THREAD_FUTEX_MUTEX
+    SDL_AtomicInt state; /* 0: unlocked, 1: locked, 2: locked and there may be waiters */
+    int recursive;
+    SDL_ThreadID owner;
+#else
     pthread_mutex_t id;
 #ifdef FAKE_RECURSIVE_MUTEX
     int recursive;
     pthread_t owner;
 #endif
+#endif
 };
 
 #endif /* SDL_mutex_c_h_ */
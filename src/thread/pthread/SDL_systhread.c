@@ -274,6 +274,27 @@ int SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
 #endif /* #if SDL_PLATFORM_RISCOS */
 }
 
+int SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    cpu_set_t set;
+    int cpu;
+
+    CPU_ZERO(&set);
+    for (cpu = 0; cpu < 64; ++cpu) {
+        if (mask & ((Uint64)1 << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        return SDL_SetError("sched_setaffinity() failed");
+    }
+    return 0;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     pthread_join(thread->handle, 0);
@@ -97,6 +97,12 @@ SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
 #endif
 }
 
+extern "C" int
+SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+    return SDL_Unsupported();
+}
+
 extern "C" void
 SDL_SYS_WaitThread(SDL_Thread *thread)
 {
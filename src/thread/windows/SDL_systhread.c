@@ -180,6 +180,14 @@ int SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
     return 0;
 }
 
+int SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+    if (!SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)mask)) {
+        return WIN_SetError("SetThreadAffinityMask()");
+    }
+    return 0;
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     WaitForSingleObjectEx(thread->handle, INFINITE, FALSE);
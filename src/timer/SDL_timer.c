@@ -22,6 +22,7 @@
 
 #include "SDL_timer_c.h"
 #include "../thread/SDL_systhread.h"
+#include "../SDL_hashtable.h"
 
 /* #define DEBUG_TIMERS */
 
@@ -35,23 +36,36 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint32 sequence;
     SDL_AtomicInt canceled;
+    SDL_PropertiesID props; /* protected by SDL_TimerData::lock, the timer thread reads it */
+    Uint64 fired;       /* protected by SDL_TimerData::lock */
+    Uint64 late;        /* protected by SDL_TimerData::lock */
+    Uint64 max_late;    /* protected by SDL_TimerData::lock */
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
+/* Timer callbacks are run by worker threads if SDL_HINT_TIMER_DISPATCH_THREADS is set */
+#define SDL_MAX_TIMER_WORKERS 64
 
-/* The timers are kept in a sorted list */
-typedef struct
+struct SDL_TimerData;
+
+typedef struct SDL_TimerWorkQueue
+{
+    struct SDL_TimerData *data;
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_Timer *head;
+    SDL_Timer *tail;
+    SDL_bool quit;
+} SDL_TimerWorkQueue;
+
+/* The timers are kept in a binary min-heap ordered by scheduling time */
+typedef struct SDL_TimerData
 {
     /* Data used by the main thread */
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -64,8 +78,17 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Timers handed from the timer thread to the workers, the last worker runs the serialized ones */
+    SDL_Thread **workers;
+    int num_workers;
+    SDL_TimerWorkQueue pool;
+    SDL_TimerWorkQueue serial;
+
+    /* Heap of timers - this is only touched by the timer thread */
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint32 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -76,24 +99,162 @@ static SDL_TimerData SDL_timer_data;
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+/* Timers scheduled for the same time fire in the order they were added */
+static SDL_bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
+{
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return (Sint32)(a->sequence - b->sequence) < 0;
+}
+
+static SDL_bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    int i;
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? (data->max_timers * 2) : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return SDL_FALSE;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->sequence = data->sequence++;
+
+    /* Sift the new timer up from the bottom of the heap */
+    for (i = data->num_timers++; i > 0; i = (i - 1) / 2) {
+        SDL_Timer *parent = data->timers[(i - 1) / 2];
+        if (!SDL_TimerBefore(timer, parent)) {
+            break;
+        }
+        data->timers[i] = parent;
+    }
+    data->timers[i] = timer;
+    return SDL_TRUE;
+}
+
+static void SDL_RemoveFirstTimerInternal(SDL_TimerData *data)
+{
+    SDL_Timer *last;
+    int i, child;
+
+    SDL_assert(data->num_timers > 0);
+
+    /* Sift the last timer down from the top of the heap */
+    last = data->timers[--data->num_timers];
+    for (i = 0; (child = (2 * i) + 1) < data->num_timers; i = child) {
+        if (child + 1 < data->num_timers && SDL_TimerBefore(data->timers[child + 1], data->timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(data->timers[child], last)) {
             break;
         }
+        data->timers[i] = data->timers[child];
+    }
+    data->timers[i] = last;
+}
+
+/* Run the timer callback and return the new interval, or 0 to stop the timer */
+static Uint64 SDL_CallTimer(SDL_TimerData *data, SDL_Timer *timer)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    const Uint64 late = (now > timer->scheduled) ? (now - timer->scheduled) : 0;
+
+    SDL_LockSpinlock(&data->lock);
+    ++timer->fired;
+    timer->late = late;
+    if (late > timer->max_late) {
+        timer->max_late = late;
+    }
+    SDL_UnlockSpinlock(&data->lock);
+
+    if (timer->callback_ms) {
+        return SDL_MS_TO_NS(timer->callback_ms(timer->userdata, timer->timerID, (Uint32)SDL_NS_TO_MS(timer->interval)));
+    } else {
+        return timer->callback_ns(timer->userdata, timer->timerID, timer->interval);
     }
+}
+
+static SDL_bool SDL_IsTimerSerialized(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_PropertiesID props;
+
+    /* The properties are created on demand by SDL_GetTimerProperties() on other threads */
+    SDL_LockSpinlock(&data->lock);
+    props = timer->props;
+    SDL_UnlockSpinlock(&data->lock);
+
+    return props && SDL_GetBooleanProperty(props, SDL_PROP_TIMER_SERIALIZED_BOOLEAN, SDL_FALSE);
+}
+
+/* Hand a due timer to a worker thread -- called by the timer thread */
+static void SDL_DispatchTimer(SDL_TimerWorkQueue *queue, SDL_Timer *timer)
+{
+    timer->next = NULL;
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
+    SDL_LockMutex(queue->lock);
+    if (queue->tail) {
+        queue->tail->next = timer;
     } else {
-        data->timers = timer;
+        queue->head = timer;
     }
-    timer->next = curr;
+    queue->tail = timer;
+    SDL_SignalCondition(queue->cond);
+    SDL_UnlockMutex(queue->lock);
+}
+
+static int SDLCALL SDL_TimerWorkerThread(void *_queue)
+{
+    SDL_TimerWorkQueue *queue = (SDL_TimerWorkQueue *)_queue;
+    SDL_TimerData *data = queue->data;
+    SDL_Timer *timer;
+    Uint64 tick, interval;
+
+    for (;;) {
+        SDL_LockMutex(queue->lock);
+        while (!queue->head && !queue->quit) {
+            SDL_WaitCondition(queue->cond, queue->lock);
+        }
+        if (queue->quit) {
+            SDL_UnlockMutex(queue->lock);
+            break;
+        }
+        timer = queue->head;
+        queue->head = timer->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+        SDL_UnlockMutex(queue->lock);
+
+        tick = SDL_GetTicksNS();
+        if (SDL_AtomicGet(&timer->canceled)) {
+            interval = 0;
+        } else {
+            interval = SDL_CallTimer(data, timer);
+        }
+
+        /* Give the timer back to the timer thread, or retire it */
+        SDL_LockSpinlock(&data->lock);
+        if (interval > 0) {
+            timer->interval = interval;
+            timer->scheduled = tick + interval;
+            timer->next = data->pending;
+            data->pending = timer;
+        } else {
+            SDL_AtomicSet(&timer->canceled, 1);
+            timer->next = data->freelist;
+            data->freelist = timer;
+        }
+        SDL_UnlockSpinlock(&data->lock);
+
+        if (interval > 0) {
+            SDL_SignalSemaphore(data->sem);
+        }
+    }
+    return 0;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -126,11 +287,17 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_UnlockSpinlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        /* Sort the pending timers into our heap */
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                /* Out of memory, try again next time around */
+                SDL_LockSpinlock(&data->lock);
+                current->next = data->pending;
+                data->pending = current;
+                SDL_UnlockSpinlock(&data->lock);
+            }
         }
         freelist_head = NULL;
         freelist_tail = NULL;
@@ -146,8 +313,8 @@ static int SDLCALL SDL_TimerThread(void *_data)
         tick = SDL_GetTicksNS();
 
         /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
                 /* Scheduled for the future, wait a bit */
@@ -156,20 +323,20 @@ static int SDLCALL SDL_TimerThread(void *_data)
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
+            SDL_RemoveFirstTimerInternal(data);
 
             if (SDL_AtomicGet(&current->canceled)) {
                 interval = 0;
+            } else if (data->num_workers > 0) {
+                /* A worker will reschedule it when the callback returns */
+                SDL_DispatchTimer(SDL_IsTimerSerialized(data, current) ? &data->serial : &data->pool, current);
+                continue;
             } else {
-                if (current->callback_ms) {
-                    interval = SDL_MS_TO_NS(current->callback_ms(current->userdata, current->timerID, (Uint32)SDL_NS_TO_MS(current->interval)));
-                } else {
-                    interval = current->callback_ns(current->userdata, current->timerID, current->interval);
-                }
+                interval = SDL_CallTimer(data, current);
             }
 
             if (interval > 0) {
-                /* Reschedule this timer */
+                /* Reschedule this timer, there's always room since we just removed it */
                 current->interval = interval;
                 current->scheduled = tick + interval;
                 SDL_AddTimerInternal(data, current);
@@ -205,25 +372,138 @@ static int SDLCALL SDL_TimerThread(void *_data)
     return 0;
 }
 
+static int SDL_InitTimerWorkQueue(SDL_TimerData *data, SDL_TimerWorkQueue *queue)
+{
+    queue->data = data;
+    queue->lock = SDL_CreateMutex();
+    queue->cond = SDL_CreateCondition();
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->quit = SDL_FALSE;
+    if (!queue->lock || !queue->cond) {
+        return -1;
+    }
+    return 0;
+}
+
+static void SDL_QuitTimerWorkQueue(SDL_TimerData *data, SDL_TimerWorkQueue *queue)
+{
+    SDL_Timer *timer;
+
+    /* Anything that was still waiting for a worker goes with the rest of the timers */
+    while (queue->head) {
+        timer = queue->head;
+        queue->head = timer->next;
+        timer->next = data->freelist;
+        data->freelist = timer;
+    }
+    queue->tail = NULL;
+
+    SDL_DestroyCondition(queue->cond);
+    queue->cond = NULL;
+    SDL_DestroyMutex(queue->lock);
+    queue->lock = NULL;
+}
+
+static void SDL_StopTimerWorkQueue(SDL_TimerWorkQueue *queue)
+{
+    if (queue->lock) {
+        SDL_LockMutex(queue->lock);
+        queue->quit = SDL_TRUE;
+        SDL_BroadcastCondition(queue->cond);
+        SDL_UnlockMutex(queue->lock);
+    }
+}
+
+static int SDL_StartTimerWorkers(SDL_TimerData *data, int num_workers)
+{
+    int i;
+
+    if (SDL_InitTimerWorkQueue(data, &data->pool) < 0 ||
+        SDL_InitTimerWorkQueue(data, &data->serial) < 0) {
+        return -1;
+    }
+
+    data->workers = (SDL_Thread **)SDL_calloc(num_workers + 1, sizeof(*data->workers));
+    if (!data->workers) {
+        return -1;
+    }
+    data->num_workers = num_workers;
+
+    for (i = 0; i <= num_workers; ++i) {
+        char name[64];
+
+        if (i < num_workers) {
+            SDL_snprintf(name, sizeof(name), "SDLTimerWorker%d", i);
+            data->workers[i] = SDL_CreateThread(SDL_TimerWorkerThread, name, &data->pool);
+        } else {
+            data->workers[i] = SDL_CreateThread(SDL_TimerWorkerThread, "SDLTimerSerial", &data->serial);
+        }
+        if (!data->workers[i]) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void SDL_StopTimerWorkers(SDL_TimerData *data)
+{
+    int i;
+
+    SDL_StopTimerWorkQueue(&data->pool);
+    SDL_StopTimerWorkQueue(&data->serial);
+    if (data->workers) {
+        for (i = 0; i <= data->num_workers; ++i) {
+            SDL_WaitThread(data->workers[i], NULL);
+        }
+    }
+    SDL_free(data->workers);
+    data->workers = NULL;
+    data->num_workers = 0;
+
+    SDL_QuitTimerWorkQueue(data, &data->pool);
+    SDL_QuitTimerWorkQueue(data, &data->serial);
+}
+
 int SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
 
     if (!SDL_AtomicGet(&data->active)) {
         const char *name = "SDLTimer";
+        const char *hint;
+        int num_workers;
         data->timermap_lock = SDL_CreateMutex();
         if (!data->timermap_lock) {
             return -1;
         }
 
+        data->timermap = SDL_CreateHashTable(NULL, 256, SDL_HashID, SDL_KeyMatchID, NULL, SDL_FALSE);
+        if (!data->timermap) {
+            SDL_DestroyMutex(data->timermap_lock);
+            return -1;
+        }
+
         data->sem = SDL_CreateSemaphore(0);
         if (!data->sem) {
+            SDL_DestroyHashTable(data->timermap);
+            data->timermap = NULL;
             SDL_DestroyMutex(data->timermap_lock);
             return -1;
         }
 
         SDL_AtomicSet(&data->active, 1);
 
+        /* Start the workers first, the timer thread checks for them without locking */
+        hint = SDL_GetHint(SDL_HINT_TIMER_DISPATCH_THREADS);
+        num_workers = hint ? SDL_clamp(SDL_atoi(hint), 0, SDL_MAX_TIMER_WORKERS) : 0;
+        if (num_workers > 0) {
+            if (SDL_StartTimerWorkers(data, num_workers) < 0) {
+                SDL_QuitTimers();
+                return -1;
+            }
+        }
+
         /* Timer threads use a callback into the app, so we can't set a limited stack size here. */
         data->thread = SDL_CreateThread(SDL_TimerThread, name, data);
         if (!data->thread) {
@@ -238,7 +518,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCompareAndSwap(&data->active, 1, 0)) { /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -247,26 +527,34 @@ void SDL_QuitTimers(void)
             SDL_WaitThread(data->thread, NULL);
             data->thread = NULL;
         }
+        SDL_StopTimerWorkers(data);
 
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
+        for (i = 0; i < data->num_timers; ++i) {
+            SDL_DestroyProperties(data->timers[i]->props);
+            SDL_free(data->timers[i]);
+        }
+        SDL_free(data->timers);
+        data->timers = NULL;
+        data->num_timers = 0;
+        data->max_timers = 0;
+        while (data->pending) {
+            timer = data->pending;
+            data->pending = timer->next;
+            SDL_DestroyProperties(timer->props);
             SDL_free(timer);
         }
         while (data->freelist) {
             timer = data->freelist;
             data->freelist = timer->next;
+            SDL_DestroyProperties(timer->props);
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
-        }
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
@@ -277,7 +565,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_bool added;
 
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -299,13 +587,21 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     SDL_UnlockSpinlock(&data->lock);
 
     if (timer) {
-        SDL_RemoveTimer(timer->timerID);
+        /* The old ID may still be mapped if the callback stopped the timer, forget it without setting an error */
+        SDL_LockMutex(data->timermap_lock);
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID);
+        SDL_UnlockMutex(data->timermap_lock);
+        SDL_DestroyProperties(timer->props);
     } else {
         timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
         if (!timer) {
             return 0;
         }
     }
+    timer->props = 0;
+    timer->fired = 0;
+    timer->late = 0;
+    timer->max_late = 0;
     timer->timerID = SDL_GetNextObjectID();
     timer->callback_ms = callback_ms;
     timer->callback_ns = callback_ns;
@@ -314,18 +610,13 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_AtomicSet(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer);
+    SDL_UnlockMutex(data->timermap_lock);
+    if (!added) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
     SDL_LockSpinlock(&data->lock);
@@ -336,7 +627,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     /* Wake up the timer thread if necessary */
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
@@ -352,7 +643,7 @@ SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *
 int SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    const void *value = NULL;
     SDL_bool canceled = SDL_FALSE;
 
     if (!id) {
@@ -361,26 +652,17 @@ int SDL_RemoveTimer(SDL_TimerID id)
 
     /* Find the timer */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
-    }
-    SDL_UnlockMutex(data->timermap_lock);
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, &value)) {
+        SDL_Timer *timer = (SDL_Timer *)value;
 
-    if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
+        if (!SDL_AtomicGet(&timer->canceled)) {
+            SDL_AtomicSet(&timer->canceled, 1);
             canceled = SDL_TRUE;
         }
-        SDL_free(entry);
     }
+    SDL_UnlockMutex(data->timermap_lock);
+
     if (canceled) {
         return 0;
     } else {
@@ -388,6 +670,51 @@ int SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+SDL_PropertiesID SDL_GetTimerProperties(SDL_TimerID id)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    const void *value = NULL;
+    SDL_PropertiesID props = 0;
+
+    if (!id) {
+        SDL_InvalidParamError("id");
+        return 0;
+    }
+
+    SDL_LockMutex(data->timermap_lock);
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, &value)) {
+        SDL_Timer *timer = (SDL_Timer *)value;
+        Uint64 fired, late, max_late;
+
+        SDL_PropertiesID new_props = 0;
+
+        if (!timer->props) {
+            new_props = SDL_CreateProperties();
+        }
+
+        SDL_LockSpinlock(&data->lock);
+        if (new_props) {
+            timer->props = new_props;
+        }
+        props = timer->props;
+        fired = timer->fired;
+        late = timer->late;
+        max_late = timer->max_late;
+        SDL_UnlockSpinlock(&data->lock);
+
+        if (props) {
+            SDL_SetNumberProperty(props, SDL_PROP_TIMER_FIRED_NUMBER, (Sint64)fired);
+            SDL_SetNumberProperty(props, SDL_PROP_TIMER_LATE_NS_NUMBER, (Sint64)late);
+            SDL_SetNumberProperty(props, SDL_PROP_TIMER_MAX_LATE_NS_NUMBER, (Sint64)max_late);
+        }
+    } else {
+        SDL_SetError("Timer not found");
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    return props;
+}
+
 #else
 
 #include <emscripten/emscripten.h>
@@ -514,6 +841,12 @@ int SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+SDL_PropertiesID SDL_GetTimerProperties(SDL_TimerID id)
+{
+    SDL_Unsupported();
+    return 0;
+}
+
 #endif /* !defined(SDL_PLATFORM_EMSCRIPTEN) || !SDL_THREADS_DISABLED */
 
 static Uint64 tick_start;
@@ -646,23 +979,50 @@ void SDL_Delay(Uint32 ms)
     SDL_SYS_DelayNS(SDL_MS_TO_NS(ms));
 }
 
-void SDL_DelayNS(Uint64 ns)
+/* How long before a deadline we stop sleeping and start spinning. This
+   tracks how late the OS has been waking us up, jumping up quickly when a
+   sleep overshoots and decaying slowly back down when sleeps are accurate. */
+#define SDL_DELAY_MIN_SPIN_NS   (20 * SDL_NS_PER_US)
+#define SDL_DELAY_MAX_SPIN_NS   (4 * SDL_NS_PER_MS)
+static SDL_AtomicInt delay_spin_ns = { (int)SDL_NS_PER_MS };
+
+static void SDL_UpdateDelaySpin(Uint64 requested, Uint64 elapsed)
+{
+    Uint64 spin = (Uint64)SDL_AtomicGet(&delay_spin_ns);
+    Uint64 overshoot = (elapsed > requested) ? (elapsed - requested) : 0;
+
+    if (overshoot >= spin) {
+        spin = overshoot + overshoot / 4;
+    } else {
+        spin -= (spin - overshoot) / 8;
+    }
+    spin = SDL_clamp(spin, SDL_DELAY_MIN_SPIN_NS, SDL_DELAY_MAX_SPIN_NS);
+    SDL_AtomicSet(&delay_spin_ns, (int)spin);
+}
+
+void SDL_DelayUntilNS(Uint64 ns)
 {
     Uint64 current_value = SDL_GetTicksNS();
-    Uint64 target_value = current_value + ns;
-
-    // Sleep for a short number of cycles
-    // We'll use 1 ms as a scheduling timeslice, it's a good value for modern operating systems
-    const int SCHEDULING_TIMESLICE_NS = 1 * SDL_NS_PER_MS;
-    while (current_value < target_value) {
-        Uint64 remaining_ns = (target_value - current_value);
-        if (remaining_ns > (SCHEDULING_TIMESLICE_NS + SDL_NS_PER_US)) {
-            // Sleep for a short time, less than the scheduling timeslice
-            SDL_SYS_DelayNS(SCHEDULING_TIMESLICE_NS - SDL_NS_PER_US);
+
+    while (current_value < ns) {
+        Uint64 remaining_ns = (ns - current_value);
+        Uint64 spin_ns = (Uint64)SDL_AtomicGet(&delay_spin_ns);
+        if (remaining_ns > spin_ns) {
+            // Let the OS sleep until just before the deadline
+            Uint64 sleep_ns = (remaining_ns - spin_ns);
+            Uint64 start_value = current_value;
+            SDL_SYS_DelayNS(sleep_ns);
+            current_value = SDL_GetTicksNS();
+            SDL_UpdateDelaySpin(sleep_ns, current_value - start_value);
         } else {
             // Spin for any remaining time
             SDL_CPUPauseInstruction();
+            current_value = SDL_GetTicksNS();
         }
-        current_value = SDL_GetTicksNS();
     }
 }
+
+void SDL_DelayNS(Uint64 ns)
+{
+    SDL_DelayUntilNS(SDL_GetTicksNS() + ns);
+}
@@ -44,7 +44,7 @@
    Also added macOS Monotonic clock support
    Based on work in https://github.com/ThomasHabets/monotonic_clock
  */
-#if defined(HAVE_NANOSLEEP) || defined(HAVE_CLOCK_GETTIME)
+#if defined(HAVE_NANOSLEEP) || defined(HAVE_CLOCK_GETTIME) || defined(HAVE_CLOCK_NANOSLEEP)
 #include <time.h>
 #endif
 #ifdef SDL_PLATFORM_APPLE
@@ -154,6 +154,30 @@ void SDL_SYS_DelayNS(Uint64 ns)
     }
 #endif
 
+#ifdef HAVE_CLOCK_NANOSLEEP
+    /* Sleep until an absolute deadline, so being interrupted by a signal
+       doesn't accumulate rounding error in the remaining time */
+    {
+        struct timespec deadline;
+
+        if (clock_gettime(CLOCK_MONOTONIC, &deadline) == 0) {
+            deadline.tv_sec += (time_t)(ns / SDL_NS_PER_SECOND);
+            deadline.tv_nsec += (long)(ns % SDL_NS_PER_SECOND);
+            if (deadline.tv_nsec >= SDL_NS_PER_SECOND) {
+                deadline.tv_nsec -= SDL_NS_PER_SECOND;
+                ++deadline.tv_sec;
+            }
+            do {
+                was_error = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+            } while (was_error == EINTR);
+
+            if (was_error == 0) {
+                return;
+            }
+        }
+    }
+#endif
+
     /* Set the timeout interval */
 #ifdef HAVE_NANOSLEEP
     remaining.tv_sec = (time_t)(ns / SDL_NS_PER_SECOND);
@@ -604,17 +604,132 @@ done:
         dst = (Uint16)(d | d >> 16);       \
     } while (0)
 
+/*
+ * The translucent pixels of a run are blended a span at a time. The vector
+ * versions do the same arithmetic as BLIT_TRANSL_888, including how the
+ * red and blue products share a 32-bit word, so they give identical results.
+ */
+typedef void (*SDL_RLEBlendSpanFunc)(const Uint32 *src, void *dst, int n);
+
+static void BlendSpan565(const Uint32 *src, void *dst, int n)
+{
+    Uint16 *dstpx = (Uint16 *)dst;
+    int i;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_565(src[i], dstpx[i]);
+    }
+}
+
+static void BlendSpan555(const Uint32 *src, void *dst, int n)
+{
+    Uint16 *dstpx = (Uint16 *)dst;
+    int i;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_555(src[i], dstpx[i]);
+    }
+}
+
+static void BlendSpan888(const Uint32 *src, void *dst, int n)
+{
+    Uint32 *dstpx = (Uint32 *)dst;
+    int i;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888(src[i], dstpx[i]);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Multiply 32-bit lanes by a factor below 65536, keeping the low 32 bits of the product */
+#define MUL32_SSE2(v, f16) \
+    _mm_add_epi32(_mm_mullo_epi16(v, f16), _mm_slli_epi32(_mm_mulhi_epu16(v, f16), 16))
+
+static void SDL_TARGETING("sse2") BlendSpan888_SSE2(const Uint32 *src, void *dst, int n)
+{
+    const __m128i mask_rb = _mm_set1_epi32(0x00ff00ff);
+    const __m128i mask_g = _mm_set1_epi32(0x0000ff00);
+    const __m128i opaque = _mm_set1_epi32((int)0xff000000);
+    Uint32 *dstpx = (Uint32 *)dst;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i vs = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i vd = _mm_loadu_si128((const __m128i *)(dstpx + i));
+        __m128i alpha = _mm_srli_epi32(vs, 24);
+        __m128i alpha16 = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        __m128i s1 = _mm_and_si128(vs, mask_rb);
+        __m128i d1 = _mm_and_si128(vd, mask_rb);
+        __m128i s2 = _mm_and_si128(vs, mask_g);
+        __m128i d2 = _mm_and_si128(vd, mask_g);
+
+        d1 = _mm_add_epi32(d1, _mm_srli_epi32(MUL32_SSE2(_mm_sub_epi32(s1, d1), alpha16), 8));
+        d2 = _mm_add_epi32(d2, _mm_srli_epi32(MUL32_SSE2(_mm_sub_epi32(s2, d2), alpha16), 8));
+        d1 = _mm_or_si128(_mm_and_si128(d1, mask_rb), _mm_and_si128(d2, mask_g));
+        _mm_storeu_si128((__m128i *)(dstpx + i), _mm_or_si128(d1, opaque));
+    }
+    BlendSpan888(src + i, dstpx + i, n - i);
+}
+#undef MUL32_SSE2
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void BlendSpan888_NEON(const Uint32 *src, void *dst, int n)
+{
+    const uint32x4_t mask_rb = vdupq_n_u32(0x00ff00ff);
+    const uint32x4_t mask_g = vdupq_n_u32(0x0000ff00);
+    const uint32x4_t opaque = vdupq_n_u32(0xff000000);
+    Uint32 *dstpx = (Uint32 *)dst;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        uint32x4_t vs = vld1q_u32(src + i);
+        uint32x4_t vd = vld1q_u32(dstpx + i);
+        uint32x4_t alpha = vshrq_n_u32(vs, 24);
+        uint32x4_t s1 = vandq_u32(vs, mask_rb);
+        uint32x4_t d1 = vandq_u32(vd, mask_rb);
+        uint32x4_t s2 = vandq_u32(vs, mask_g);
+        uint32x4_t d2 = vandq_u32(vd, mask_g);
+
+        d1 = vaddq_u32(d1, vshrq_n_u32(vmulq_u32(vsubq_u32(s1, d1), alpha), 8));
+        d2 = vaddq_u32(d2, vshrq_n_u32(vmulq_u32(vsubq_u32(s2, d2), alpha), 8));
+        d1 = vorrq_u32(vandq_u32(d1, mask_rb), vandq_u32(d2, mask_g));
+        vst1q_u32(dstpx + i, vorrq_u32(d1, opaque));
+    }
+    BlendSpan888(src + i, dstpx + i, n - i);
+}
+#endif
+
+static SDL_RLEBlendSpanFunc GetBlendSpanFunc(const SDL_PixelFormatDetails *df)
+{
+    if (df->bytes_per_pixel == 2) {
+        if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
+            return BlendSpan565;
+        }
+        return BlendSpan555;
+    }
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return BlendSpan888_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return BlendSpan888_NEON;
+    }
+#endif
+    return BlendSpan888;
+}
+
 /* blit a pixel-alpha RLE surface clipped at the right and/or left edges */
 static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                              Uint8 *dstbuf, const SDL_Rect *srcrect)
 {
     const SDL_PixelFormatDetails *df = surf_dst->internal->format;
+    SDL_RLEBlendSpanFunc blend_span = GetBlendSpanFunc(df);
     /*
      * clipped blitter: Ptype is the destination pixel type,
-     * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * Ctype the opaque count type.
      */
-#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
+#define RLEALPHACLIPBLIT(Ptype, Ctype)                                    \
     do {                                                                  \
         int linecount = srcrect->h;                                       \
         int left = srcrect->x;                                            \
@@ -667,13 +782,9 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     }                                                     \
                     if (crun > right - cofs)                              \
                         crun = right - cofs;                              \
-                    if (crun > 0) {                                       \
-                        Ptype *dst = (Ptype *)dstbuf + cofs;              \
-                        Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
-                    }                                                     \
+                    if (crun > 0)                                         \
+                        blend_span((Uint32 *)srcbuf + (cofs - ofs),       \
+                                   (Ptype *)dstbuf + cofs, crun);         \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
                 }                                                         \
@@ -684,14 +795,10 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
 
     switch (df->bytes_per_pixel) {
     case 2:
-        if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
-        } else {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
-        }
+        RLEALPHACLIPBLIT(Uint16, Uint8);
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16);
         break;
     }
 }
@@ -780,12 +887,13 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
         RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
     } else {
 
+        SDL_RLEBlendSpanFunc blend_span = GetBlendSpanFunc(df);
+
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
-         * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * Ctype the opaque count type.
          */
-#define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
+#define RLEALPHABLIT(Ptype, Ctype)                                   \
     do {                                                             \
         int linecount = srcrect->h;                                  \
         do {                                                         \
@@ -815,14 +923,9 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
                 run = ((Uint16 *)srcbuf)[1];                         \
                 srcbuf += 4;                                         \
                 if (run) {                                           \
-                    Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    blend_span((Uint32 *)srcbuf,                     \
+                               (Ptype *)dstbuf + ofs, (int)run);     \
+                    srcbuf += run * 4;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -832,14 +935,10 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
 
         switch (df->bytes_per_pixel) {
         case 2:
-            if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
-            } else {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
-            }
+            RLEALPHABLIT(Uint16, Uint8);
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16);
             break;
         }
     }
@@ -982,6 +1081,23 @@ static int uncopy_32(Uint32 *dst, const void *src, int n,
     return n * 4;
 }
 
+/*
+ * Free the pixels of a surface that has been encoded, unless the application
+ * owns them or asked to keep them, in which case they stay valid and
+ * SDL_UnRLESurface() doesn't need to decode anything.
+ */
+static void RLEReleasePixels(SDL_Surface *surface)
+{
+    if (surface->flags & SDL_SURFACE_PREALLOCATED) {
+        return;
+    }
+    if (SDL_GetBooleanProperty(surface->internal->props, SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN, SDL_FALSE)) {
+        return;
+    }
+
+    SDL_FreeSurfacePixels(surface);
+}
+
 #define ISOPAQUE(pixel, fmt) ((((pixel)&fmt->Amask) >> fmt->Ashift) == 255)
 
 #define ISTRANSL(pixel, fmt) \
@@ -1178,15 +1294,7 @@ static int RLEAlphaSurface(SDL_Surface *surface)
 #undef ADD_TRANSL_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
-    }
+    RLEReleasePixels(surface);
 
     /* reallocate the buffer to release unused memory */
     {
@@ -1345,15 +1453,7 @@ static int RLEColorkeySurface(SDL_Surface *surface)
 #undef ADD_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
-    }
+    RLEReleasePixels(surface);
 
     /* reallocate the buffer to release unused memory */
     {
@@ -1460,13 +1560,11 @@ static SDL_bool UnRLEAlpha(SDL_Surface *surface)
         return SDL_FALSE;
     }
 
-    surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
-    if (!surface->pixels) {
+    if (SDL_AllocSurfacePixels(surface, 0) < 0) {
         return SDL_FALSE;
     }
-    surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
     /* fill background with transparent pixels */
-    SDL_memset(surface->pixels, 0, (size_t)surface->h * surface->pitch);
+    SDL_memset(surface->pixels, 0, size);
 
     dst = (Uint32 *)surface->pixels;
     srcbuf = (Uint8 *)surface->internal->map.data + sizeof(SDL_PixelFormat);
@@ -1521,24 +1619,16 @@ void SDL_UnRLESurface(SDL_Surface *surface, SDL_bool recode)
     if (surface->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
         surface->internal->flags &= ~SDL_INTERNAL_SURFACE_RLEACCEL;
 
-        if (recode && !(surface->flags & SDL_SURFACE_PREALLOCATED)) {
+        if (recode && !surface->pixels) {
             if (surface->internal->map.info.flags & SDL_COPY_RLE_COLORKEY) {
                 SDL_Rect full;
-                size_t size;
 
                 /* re-create the original surface */
-                if (SDL_size_mul_overflow(surface->h, surface->pitch, &size)) {
-                    /* Memory corruption? */
-                    surface->internal->flags |= SDL_INTERNAL_SURFACE_RLEACCEL;
-                    return;
-                }
-                surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
-                if (!surface->pixels) {
+                if (SDL_AllocSurfacePixels(surface, 0) < 0) {
                     /* Oh crap... */
                     surface->internal->flags |= SDL_INTERNAL_SURFACE_RLEACCEL;
                     return;
                 }
-                surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
 
                 /* fill it with the background color */
                 SDL_FillSurfaceRect(surface, NULL, surface->internal->map.info.colorkey);
@@ -28,6 +28,205 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
+/* Large blits can be split into bands of rows, which are run in parallel by
+ * a small pool of worker threads when SDL_HINT_SURFACE_BLIT_THREADS is set.
+ */
+#define SDL_BLIT_THREADS_MAX       16
+#define SDL_BLIT_THREADS_MIN_PIXELS (256 * 256)
+#define SDL_BLIT_THREADS_MIN_ROWS  16
+
+static struct
+{
+    SDL_AtomicInt busy;
+    SDL_Mutex *lock;
+    SDL_Condition *work_available;
+    SDL_Condition *work_done;
+    SDL_Thread *threads[SDL_BLIT_THREADS_MAX - 1];
+    int num_threads;
+    SDL_bool quit;
+
+    /* The band job currently running, protected by the lock */
+    SDL_BlitBandFunc func;
+    void *userdata;
+    int rows;
+    int num_bands;
+    int next_band;
+    int bands_done;
+} SDL_blit_threads;
+
+int SDL_GetBlitThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+    int count = 1;
+
+    if (hint && *hint) {
+        count = SDL_atoi(hint);
+        if (count <= 0) {
+            count = SDL_GetCPUCount();
+        }
+    }
+    return SDL_clamp(count, 1, SDL_BLIT_THREADS_MAX);
+}
+
+/* Runs the next band of the current job, called with the pool lock held */
+static SDL_bool SDL_RunNextBlitBand(void)
+{
+    SDL_BlitBandFunc func = SDL_blit_threads.func;
+    void *userdata = SDL_blit_threads.userdata;
+    int band, y0, y1;
+
+    if (SDL_blit_threads.next_band >= SDL_blit_threads.num_bands) {
+        return SDL_FALSE;
+    }
+    band = SDL_blit_threads.next_band++;
+    y0 = (int)(((Sint64)SDL_blit_threads.rows * band) / SDL_blit_threads.num_bands);
+    y1 = (int)(((Sint64)SDL_blit_threads.rows * (band + 1)) / SDL_blit_threads.num_bands);
+
+    SDL_UnlockMutex(SDL_blit_threads.lock);
+    func(userdata, y0, y1);
+    SDL_LockMutex(SDL_blit_threads.lock);
+
+    if (++SDL_blit_threads.bands_done == SDL_blit_threads.num_bands) {
+        SDL_SignalCondition(SDL_blit_threads.work_done);
+    }
+    return SDL_TRUE;
+}
+
+static int SDLCALL SDL_BlitThread(void *unused)
+{
+    SDL_LockMutex(SDL_blit_threads.lock);
+    while (!SDL_blit_threads.quit) {
+        if (!SDL_RunNextBlitBand()) {
+            SDL_WaitCondition(SDL_blit_threads.work_available, SDL_blit_threads.lock);
+        }
+    }
+    SDL_UnlockMutex(SDL_blit_threads.lock);
+    return 0;
+}
+
+static void SDL_StopBlitThreads(void)
+{
+    int i;
+
+    if (SDL_blit_threads.num_threads == 0) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_blit_threads.lock);
+    SDL_blit_threads.quit = SDL_TRUE;
+    SDL_BroadcastCondition(SDL_blit_threads.work_available);
+    SDL_UnlockMutex(SDL_blit_threads.lock);
+
+    for (i = 0; i < SDL_blit_threads.num_threads; ++i) {
+        SDL_WaitThread(SDL_blit_threads.threads[i], NULL);
+        SDL_blit_threads.threads[i] = NULL;
+    }
+    SDL_blit_threads.num_threads = 0;
+    SDL_blit_threads.quit = SDL_FALSE;
+}
+
+/* Makes sure there are count - 1 worker threads, called by the pool owner */
+static SDL_bool SDL_StartBlitThreads(int count)
+{
+    if (SDL_blit_threads.num_threads == count - 1) {
+        return SDL_TRUE;
+    }
+    SDL_StopBlitThreads();
+
+    if (!SDL_blit_threads.lock) {
+        SDL_blit_threads.lock = SDL_CreateMutex();
+        SDL_blit_threads.work_available = SDL_CreateCondition();
+        SDL_blit_threads.work_done = SDL_CreateCondition();
+        if (!SDL_blit_threads.lock || !SDL_blit_threads.work_available || !SDL_blit_threads.work_done) {
+            SDL_QuitBlitThreads();
+            return SDL_FALSE;
+        }
+    }
+
+    while (SDL_blit_threads.num_threads < count - 1) {
+        SDL_Thread *thread = SDL_CreateThread(SDL_BlitThread, "SDLBlit", NULL);
+        if (!thread) {
+            break;
+        }
+        SDL_blit_threads.threads[SDL_blit_threads.num_threads++] = thread;
+    }
+    return (SDL_blit_threads.num_threads > 0);
+}
+
+void SDL_RunBlitBands(int w, int h, SDL_BlitBandFunc func, void *userdata)
+{
+    int count;
+
+    if ((Sint64)w * h < SDL_BLIT_THREADS_MIN_PIXELS || h < 2 * SDL_BLIT_THREADS_MIN_ROWS ||
+        (count = SDL_GetBlitThreadCount()) <= 1 ||
+        !SDL_AtomicCompareAndSwap(&SDL_blit_threads.busy, 0, 1)) {
+        /* Small blit, threading disabled, or the pool is in use by another blit */
+        func(userdata, 0, h);
+        return;
+    }
+
+    if (SDL_StartBlitThreads(count)) {
+        SDL_LockMutex(SDL_blit_threads.lock);
+        SDL_blit_threads.func = func;
+        SDL_blit_threads.userdata = userdata;
+        SDL_blit_threads.rows = h;
+        SDL_blit_threads.num_bands = SDL_min(2 * (SDL_blit_threads.num_threads + 1), h / SDL_BLIT_THREADS_MIN_ROWS);
+        SDL_blit_threads.next_band = 0;
+        SDL_blit_threads.bands_done = 0;
+        SDL_BroadcastCondition(SDL_blit_threads.work_available);
+
+        while (SDL_RunNextBlitBand()) {
+            /* Help out until all the bands have been claimed */
+        }
+        while (SDL_blit_threads.bands_done < SDL_blit_threads.num_bands) {
+            SDL_WaitCondition(SDL_blit_threads.work_done, SDL_blit_threads.lock);
+        }
+        SDL_blit_threads.func = NULL;
+        SDL_blit_threads.userdata = NULL;
+        SDL_UnlockMutex(SDL_blit_threads.lock);
+    } else {
+        func(userdata, 0, h);
+    }
+
+    SDL_AtomicSet(&SDL_blit_threads.busy, 0);
+}
+
+void SDL_QuitBlitThreads(void)
+{
+    SDL_StopBlitThreads();
+
+    if (SDL_blit_threads.lock) {
+        SDL_DestroyMutex(SDL_blit_threads.lock);
+        SDL_blit_threads.lock = NULL;
+    }
+    if (SDL_blit_threads.work_available) {
+        SDL_DestroyCondition(SDL_blit_threads.work_available);
+        SDL_blit_threads.work_available = NULL;
+    }
+    if (SDL_blit_threads.work_done) {
+        SDL_DestroyCondition(SDL_blit_threads.work_done);
+        SDL_blit_threads.work_done = NULL;
+    }
+}
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    const SDL_BlitInfo *info;
+} SDL_SoftBlitBands;
+
+static void SDL_SoftBlitBand(void *userdata, int y0, int y1)
+{
+    const SDL_SoftBlitBands *bands = (const SDL_SoftBlitBands *)userdata;
+    SDL_BlitInfo info = *bands->info;
+
+    info.src += (size_t)y0 * info.src_pitch;
+    info.src_h = y1 - y0;
+    info.dst += (size_t)y0 * info.dst_pitch;
+    info.dst_h = y1 - y0;
+    bands->blit(&info);
+}
+
 /* The general purpose software blit routine */
 static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
                                 SDL_Surface *dst, const SDL_Rect *dstrect)
@@ -82,8 +281,18 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
             info->dst_pitch - info->dst_w * info->dst_fmt->bytes_per_pixel;
         RunBlit = (SDL_BlitFunc)src->internal->map.data;
 
-        /* Run the actual software blit */
-        RunBlit(info);
+        /* Run the actual software blit, in bands when it's large and
+           the rows are independent of each other */
+        if (srcrect->w == dstrect->w && srcrect->h == dstrect->h &&
+            src->pixels != dst->pixels) {
+            SDL_SoftBlitBands bands;
+
+            bands.blit = RunBlit;
+            bands.info = info;
+            SDL_RunBlitBands(info->dst_w, info->dst_h, SDL_SoftBlitBand, &bands);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -140,6 +349,15 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
         if (SDL_HasSSE2()) {
             features |= SDL_CPU_SSE2;
         }
+        if (SDL_HasSSE41()) {
+            features |= SDL_CPU_SSE4_1;
+        }
+        if (SDL_HasAVX2()) {
+            features |= SDL_CPU_AVX2;
+        }
+        if (SDL_HasNEON()) {
+            features |= SDL_CPU_NEON;
+        }
         if (SDL_HasAltiVec()) {
             if (SDL_UseAltivecPrefetch()) {
                 features |= SDL_CPU_ALTIVEC_PREFETCH;
@@ -176,50 +394,39 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
 #endif /* SDL_HAVE_BLIT_AUTO */
 
 /* Figure out which of many blit routines to set up on a surface */
-int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
+/* Blitter choices only depend on the formats, colorspaces and copy flags,
+ * and a few details of the mapping, so they're cached for all surfaces to
+ * share. Lookup tables depend on the palette contents and stay in the map.
+ */
+#define SDL_BLIT_FUNC_CACHE_SIZE 64
+
+#define SDL_BLIT_KEY_IDENTITY    0x80000000
+#define SDL_BLIT_KEY_SRC_PALETTE 0x40000000
+#define SDL_BLIT_KEY_DST_PALETTE 0x20000000
+#define SDL_BLIT_KEY_OPAQUE      0x10000000
+
+typedef struct SDL_BlitFuncCacheEntry
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    SDL_Colorspace src_colorspace;
+    SDL_Colorspace dst_colorspace;
+    Uint32 flags;
+    SDL_BlitFunc blit;
+} SDL_BlitFuncCacheEntry;
+
+static SDL_BlitFuncCacheEntry SDL_blit_func_cache[SDL_BLIT_FUNC_CACHE_SIZE];
+static SDL_SpinLock SDL_blit_func_cache_lock;
+
+static SDL_BlitFunc SDL_ChooseBlitUncached(SDL_Surface *surface, SDL_Surface *dst, SDL_Colorspace src_colorspace, SDL_Colorspace dst_colorspace)
 {
     SDL_BlitFunc blit = NULL;
     SDL_BlitMap *map = &surface->internal->map;
-    SDL_Colorspace src_colorspace = surface->internal->colorspace;
-    SDL_Colorspace dst_colorspace = dst->internal->colorspace;
-
-    /* We don't currently support blitting to < 8 bpp surfaces */
-    if (SDL_BITSPERPIXEL(dst->format) < 8) {
-        SDL_InvalidateMap(map);
-        return SDL_SetError("Blit combination not supported");
-    }
-
-#if SDL_HAVE_RLE
-    /* Clean everything out to start */
-    if (surface->flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
-        SDL_UnRLESurface(surface, SDL_TRUE);
-    }
-#endif
-
-    map->blit = SDL_SoftBlit;
-    map->info.src_surface = surface;
-    map->info.src_fmt = surface->internal->format;
-    map->info.src_pal = surface->internal->palette;
-    map->info.dst_surface = dst;
-    map->info.dst_fmt = dst->internal->format;
-    map->info.dst_pal = dst->internal->palette;
-
-#if SDL_HAVE_RLE
-    /* See if we can do RLE acceleration */
-    if (map->info.flags & SDL_COPY_RLE_DESIRED) {
-        if (SDL_RLESurface(surface) == 0) {
-            return 0;
-        }
-    }
-#endif
 
-    /* Choose a standard blit function */
-    if (!blit) {
-        if (src_colorspace != dst_colorspace ||
-            SDL_BYTESPERPIXEL(surface->format) > 4 ||
-            SDL_BYTESPERPIXEL(dst->format) > 4) {
-            blit = SDL_Blit_Slow_Float;
-        }
+    if (src_colorspace != dst_colorspace ||
+        SDL_BYTESPERPIXEL(surface->format) > 4 ||
+        SDL_BYTESPERPIXEL(dst->format) > 4) {
+        blit = SDL_Blit_Slow_Float;
     }
     if (!blit) {
         if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
@@ -278,8 +485,110 @@ int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
             blit = SDL_Blit_Slow;
         }
     }
+
+    return blit;
+}
+
+static SDL_BlitFunc SDL_ChooseBlit(SDL_Surface *surface, SDL_Surface *dst, SDL_Colorspace src_colorspace, SDL_Colorspace dst_colorspace)
+{
+    SDL_BlitMap *map = &surface->internal->map;
+    SDL_BlitFuncCacheEntry key;
+    SDL_BlitFuncCacheEntry *entry;
+    Uint32 hash;
+
+    key.src_format = surface->format;
+    key.dst_format = dst->format;
+    key.src_colorspace = src_colorspace;
+    key.dst_colorspace = dst_colorspace;
+    key.flags = (map->info.flags & ~SDL_COPY_RLE_MASK);
+    if (map->identity) {
+        key.flags |= SDL_BLIT_KEY_IDENTITY;
+    }
+    if (map->info.src_pal) {
+        key.flags |= SDL_BLIT_KEY_SRC_PALETTE;
+    }
+    if (map->info.dst_pal) {
+        key.flags |= SDL_BLIT_KEY_DST_PALETTE;
+    }
+    if (map->info.a == 255) {
+        key.flags |= SDL_BLIT_KEY_OPAQUE;
+    }
+
+    hash = ((Uint32)key.src_format * 31 + (Uint32)key.dst_format) * 31 + key.flags;
+    hash ^= (hash >> 16);
+    hash ^= ((Uint32)key.src_colorspace ^ (Uint32)key.dst_colorspace);
+    entry = &SDL_blit_func_cache[hash % SDL_BLIT_FUNC_CACHE_SIZE];
+
+    SDL_LockSpinlock(&SDL_blit_func_cache_lock);
+    if (entry->blit &&
+        entry->src_format == key.src_format &&
+        entry->dst_format == key.dst_format &&
+        entry->src_colorspace == key.src_colorspace &&
+        entry->dst_colorspace == key.dst_colorspace &&
+        entry->flags == key.flags) {
+        key.blit = entry->blit;
+        SDL_UnlockSpinlock(&SDL_blit_func_cache_lock);
+        return key.blit;
+    }
+    SDL_UnlockSpinlock(&SDL_blit_func_cache_lock);
+
+    key.blit = SDL_ChooseBlitUncached(surface, dst, src_colorspace, dst_colorspace);
+    if (key.blit) {
+        SDL_LockSpinlock(&SDL_blit_func_cache_lock);
+        *entry = key;
+        SDL_UnlockSpinlock(&SDL_blit_func_cache_lock);
+    }
+    return key.blit;
+}
+
+int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
+{
+    SDL_BlitFunc blit;
+    SDL_BlitMap *map = &surface->internal->map;
+    SDL_Colorspace src_colorspace = surface->internal->colorspace;
+    SDL_Colorspace dst_colorspace = dst->internal->colorspace;
+
+    /* We don't currently support blitting to < 8 bpp surfaces */
+    if (SDL_BITSPERPIXEL(dst->format) < 8) {
+        SDL_InvalidateMap(map);
+        return SDL_SetError("Blit combination not supported");
+    }
+
+#if SDL_HAVE_RLE
+    /* Clean everything out to start */
+    if (surface->flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+        SDL_UnRLESurface(surface, SDL_TRUE);
+    }
+#endif
+
+    map->blit = SDL_SoftBlit;
+    map->info.src_surface = surface;
+    map->info.src_fmt = surface->internal->format;
+    map->info.src_pal = surface->internal->palette;
+    map->info.dst_surface = dst;
+    map->info.dst_fmt = dst->internal->format;
+    map->info.dst_pal = dst->internal->palette;
+
+#if SDL_HAVE_RLE
+    /* See if we can do RLE acceleration */
+    if (map->info.flags & SDL_COPY_RLE_DESIRED) {
+        if (SDL_RLESurface(surface) == 0) {
+            return 0;
+        }
+    }
+#endif
+
+    /* Choose a standard blit function */
+    blit = SDL_ChooseBlit(surface, dst, src_colorspace, dst_colorspace);
     map->data = (void *)blit;
 
+    /* Let benchmarks and developers see which combinations have no fast path */
+    if (blit == SDL_Blit_Slow || blit == SDL_Blit_Slow_Float) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Blit from %s to %s with flags 0x%x uses %s",
+                     SDL_GetPixelFormatName(surface->format), SDL_GetPixelFormatName(dst->format), map->info.flags,
+                     (blit == SDL_Blit_Slow) ? "SDL_Blit_Slow" : "SDL_Blit_Slow_Float");
+    }
+
     /* Make sure we have a blit function */
     if (!blit) {
         SDL_InvalidateMap(map);
@@ -52,6 +52,9 @@ extern const Uint16 SDL_expand_byte_10[];
 #define SDL_CPU_SSE2               0x00000004
 #define SDL_CPU_ALTIVEC_PREFETCH   0x00000008
 #define SDL_CPU_ALTIVEC_NOPREFETCH 0x00000010
+#define SDL_CPU_SSE4_1             0x00000020
+#define SDL_CPU_AVX2               0x00000040
+#define SDL_CPU_NEON               0x00000080
 
 typedef struct
 {
@@ -102,8 +105,13 @@ typedef struct SDL_BlitMap
     Uint32 src_palette_version;
 } SDL_BlitMap;
 
+typedef void (*SDL_BlitBandFunc)(void *userdata, int y0, int y1);
+
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst);
+extern int SDL_GetBlitThreadCount(void);
+extern void SDL_RunBlitBands(int w, int h, SDL_BlitBandFunc func, void *userdata);
+extern void SDL_QuitBlitThreads(void);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
@@ -2945,6 +2945,276 @@ static void BlitNtoNKeyCopyAlpha(SDL_BlitInfo *info)
     }
 }
 
+/* Colorkey blits between 4 byte formats with the same RGB layout write
+ * (src & keep) | set for each pixel that doesn't match the key, the same
+ * as the fast paths in BlitNtoNKey() and BlitNtoNKeyCopyAlpha().
+ */
+static SDL_bool CanBlit4to4KeyMasked(const SDL_PixelFormatDetails *srcfmt, const SDL_PixelFormatDetails *dstfmt)
+{
+    if (srcfmt->bytes_per_pixel != 4 || dstfmt->bytes_per_pixel != 4 ||
+        SDL_ISPIXELFORMAT_10BIT(srcfmt->format) || SDL_ISPIXELFORMAT_10BIT(dstfmt->format) ||
+        srcfmt->Rmask != dstfmt->Rmask || srcfmt->Gmask != dstfmt->Gmask || srcfmt->Bmask != dstfmt->Bmask) {
+        return SDL_FALSE;
+    }
+    if (srcfmt->Amask && dstfmt->Amask && srcfmt->format != dstfmt->format) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static void GetBlit4to4KeyMasks(const SDL_BlitInfo *info, Uint32 *keep, Uint32 *set)
+{
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+
+    if (srcfmt->Amask && dstfmt->Amask) {
+        /* Same format, copy alpha */
+        *keep = ~0u;
+        *set = 0;
+    } else if (dstfmt->Amask) {
+        /* RGB->RGBA, SET_ALPHA */
+        *keep = ~0u;
+        *set = ((Uint32)info->a) << dstfmt->Ashift;
+    } else {
+        /* RGBA->RGB, NO_ALPHA */
+        *keep = srcfmt->Rmask | srcfmt->Gmask | srcfmt->Bmask;
+        *set = 0;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") Blit2to2KeySSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip / 2;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip / 2;
+    Uint16 rgbmask = (Uint16)~info->src_fmt->Amask;
+    Uint16 ckey = (Uint16)(info->colorkey & rgbmask);
+    const __m128i vrgbmask = _mm_set1_epi16((short)rgbmask);
+    const __m128i vckey = _mm_set1_epi16((short)ckey);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m128i s = _mm_loadu_si128((const __m128i *)srcp);
+            const __m128i d = _mm_loadu_si128((const __m128i *)dstp);
+            const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(s, vrgbmask), vckey);
+            _mm_storeu_si128((__m128i *)dstp, _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, s)));
+            srcp += 8;
+            dstp += 8;
+        }
+        for (; n > 0; --n) {
+            if ((*srcp & rgbmask) != ckey) {
+                *dstp = *srcp;
+            }
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+static void SDL_TARGETING("sse2") Blit4to4KeySSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *)info->src;
+    int srcskip = info->src_skip / 4;
+    Uint32 *dstp = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    Uint32 rgbmask = ~info->src_fmt->Amask;
+    Uint32 ckey = info->colorkey & rgbmask;
+    Uint32 keep, set;
+    __m128i vrgbmask, vckey, vkeep, vset;
+
+    GetBlit4to4KeyMasks(info, &keep, &set);
+    vrgbmask = _mm_set1_epi32((int)rgbmask);
+    vckey = _mm_set1_epi32((int)ckey);
+    vkeep = _mm_set1_epi32((int)keep);
+    vset = _mm_set1_epi32((int)set);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *)srcp);
+            const __m128i d = _mm_loadu_si128((const __m128i *)dstp);
+            const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(s, vrgbmask), vckey);
+            const __m128i pixel = _mm_or_si128(_mm_and_si128(s, vkeep), vset);
+            _mm_storeu_si128((__m128i *)dstp, _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, pixel)));
+            srcp += 4;
+            dstp += 4;
+        }
+        for (; n > 0; --n) {
+            if ((*srcp & rgbmask) != ckey) {
+                *dstp = (*srcp & keep) | set;
+            }
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif
+
+/* FIXME: SDL doesn't have SSSE3 detection, so use the next one up */
+#if defined(SDL_SSE4_1_INTRINSICS) && HAVE_FAST_WRITE_INT8
+/* The permutation paths of BlitNtoNKey() and BlitNtoNKeyCopyAlpha() */
+static void SDL_TARGETING("ssse3") Blit4to4KeySwizzleSSSE3(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    Uint32 rgbmask = ~srcfmt->Amask;
+    Uint32 ckey = info->colorkey & rgbmask;
+    SDL_bool copy_alpha = (srcfmt->Amask && dstfmt->Amask);
+    Uint8 alpha = dstfmt->Amask ? info->a : 0;
+    int p[4], alpha_channel, i;
+    Uint8 control[16], keep[16], set[16];
+    __m128i vrgbmask, vckey, vcontrol, vkeep, vset;
+
+    get_permutation(srcfmt, dstfmt, &p[0], &p[1], &p[2], &p[3], &alpha_channel);
+    for (i = 0; i < 16; ++i) {
+        const int channel = (i % 4);
+        control[i] = (Uint8)((i & ~3) + p[channel]);
+        if (!copy_alpha && channel == alpha_channel) {
+            keep[i] = 0x00;
+            set[i] = alpha;
+        } else {
+            keep[i] = 0xFF;
+            set[i] = 0x00;
+        }
+    }
+    vrgbmask = _mm_set1_epi32((int)rgbmask);
+    vckey = _mm_set1_epi32((int)ckey);
+    vcontrol = _mm_loadu_si128((const __m128i *)control);
+    vkeep = _mm_loadu_si128((const __m128i *)keep);
+    vset = _mm_loadu_si128((const __m128i *)set);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *)src);
+            const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+            const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(s, vrgbmask), vckey);
+            const __m128i pixel = _mm_or_si128(_mm_and_si128(_mm_shuffle_epi8(s, vcontrol), vkeep), vset);
+            _mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, pixel)));
+            src += 16;
+            dst += 16;
+        }
+        for (; n > 0; --n) {
+            Uint32 *src32 = (Uint32 *)src;
+            if ((*src32 & rgbmask) != ckey) {
+                dst[0] = src[p[0]];
+                dst[1] = src[p[1]];
+                dst[2] = src[p[2]];
+                dst[3] = src[p[3]];
+                if (!copy_alpha) {
+                    dst[alpha_channel] = alpha;
+                }
+            }
+            src += 4;
+            dst += 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void Blit2to2KeyNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip / 2;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip / 2;
+    Uint16 rgbmask = (Uint16)~info->src_fmt->Amask;
+    Uint16 ckey = (Uint16)(info->colorkey & rgbmask);
+    const uint16x8_t vrgbmask = vdupq_n_u16(rgbmask);
+    const uint16x8_t vckey = vdupq_n_u16(ckey);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const uint16x8_t s = vld1q_u16(srcp);
+            const uint16x8_t d = vld1q_u16(dstp);
+            const uint16x8_t keyed = vceqq_u16(vandq_u16(s, vrgbmask), vckey);
+            vst1q_u16(dstp, vbslq_u16(keyed, d, s));
+            srcp += 8;
+            dstp += 8;
+        }
+        for (; n > 0; --n) {
+            if ((*srcp & rgbmask) != ckey) {
+                *dstp = *srcp;
+            }
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+static void Blit4to4KeyNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *)info->src;
+    int srcskip = info->src_skip / 4;
+    Uint32 *dstp = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    Uint32 rgbmask = ~info->src_fmt->Amask;
+    Uint32 ckey = info->colorkey & rgbmask;
+    Uint32 keep, set;
+    uint32x4_t vrgbmask, vckey, vkeep, vset;
+
+    GetBlit4to4KeyMasks(info, &keep, &set);
+    vrgbmask = vdupq_n_u32(rgbmask);
+    vckey = vdupq_n_u32(ckey);
+    vkeep = vdupq_n_u32(keep);
+    vset = vdupq_n_u32(set);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const uint32x4_t s = vld1q_u32(srcp);
+            const uint32x4_t d = vld1q_u32(dstp);
+            const uint32x4_t keyed = vceqq_u32(vandq_u32(s, vrgbmask), vckey);
+            const uint32x4_t pixel = vorrq_u32(vandq_u32(s, vkeep), vset);
+            vst1q_u32(dstp, vbslq_u32(keyed, d, pixel));
+            srcp += 4;
+            dstp += 4;
+        }
+        for (; n > 0; --n) {
+            if ((*srcp & rgbmask) != ckey) {
+                *dstp = (*srcp & keep) | set;
+            }
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif
+
 /* Special optimized blit for ARGB 2-10-10-10 --> RGBA */
 static void Blit2101010toN(SDL_BlitInfo *info)
 {
@@ -3417,10 +3687,40 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
            If a particular case turns out to be useful we'll add it. */
 
         if (srcfmt->bytes_per_pixel == 2 && surface->internal->map.identity != 0) {
+#ifdef SDL_SSE2_INTRINSICS
+            if (SDL_HasSSE2()) {
+                return Blit2to2KeySSE2;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                return Blit2to2KeyNEON;
+            }
+#endif
             return Blit2to2Key;
         } else if (dstfmt->bytes_per_pixel == 1) {
             return BlitNto1Key;
         } else {
+            if (CanBlit4to4KeyMasked(srcfmt, dstfmt)) {
+#ifdef SDL_SSE2_INTRINSICS
+                if (SDL_HasSSE2()) {
+                    return Blit4to4KeySSE2;
+                }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+                if (SDL_HasNEON()) {
+                    return Blit4to4KeyNEON;
+                }
+#endif
+            }
+#if defined(SDL_SSE4_1_INTRINSICS) && HAVE_FAST_WRITE_INT8
+            if (srcfmt->bytes_per_pixel == 4 && dstfmt->bytes_per_pixel == 4 &&
+                !SDL_ISPIXELFORMAT_10BIT(srcfmt->format) && !SDL_ISPIXELFORMAT_10BIT(dstfmt->format) &&
+                (!(srcfmt->Amask && dstfmt->Amask) || srcfmt->format != dstfmt->format) &&
+                SDL_HasSSE41()) {
+                return Blit4to4KeySwizzleSSSE3;
+            }
+#endif
 #ifdef SDL_ALTIVEC_BLITTERS
             if ((srcfmt->bytes_per_pixel == 4) && (dstfmt->bytes_per_pixel == 4) && SDL_HasAltiVec()) {
                 return Blit32to32KeyAltivec;
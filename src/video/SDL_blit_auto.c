@@ -29,6 +29,120 @@
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
 
+/* The vectorized blitters below implement the modulate and SDL_COPY_BLEND
+ * paths of the generated blitters, producing exactly the same results.
+ * The source pixels are first swizzled into the destination channel order,
+ * which always has alpha (or the unused channel) in the top byte.
+ */
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_Blit_MultDiv255_AVX2(__m256i a, __m256i b)
+{
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(1));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_Blit_ModulateBlend_AVX2(__m256i src, __m256i dst, __m256i modulate, int flags)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i v255 = _mm256_set1_epi16(0xFF);
+    __m256i s_lo = _mm256_unpacklo_epi8(src, zero);
+    __m256i s_hi = _mm256_unpackhi_epi8(src, zero);
+
+    if (flags & SDL_COPY_MODULATE_MASK) {
+        s_lo = SDL_Blit_MultDiv255_AVX2(s_lo, modulate);
+        s_hi = SDL_Blit_MultDiv255_AVX2(s_hi, modulate);
+    }
+    if (flags & SDL_COPY_BLEND) {
+        const __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+        const __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+        __m256i d_lo = _mm256_unpacklo_epi8(dst, zero);
+        __m256i d_hi = _mm256_unpackhi_epi8(dst, zero);
+
+        /* Premultiply the color channels, leaving alpha unchanged */
+        s_lo = SDL_Blit_MultDiv255_AVX2(s_lo, _mm256_blend_epi16(a_lo, v255, 0x88));
+        s_hi = SDL_Blit_MultDiv255_AVX2(s_hi, _mm256_blend_epi16(a_hi, v255, 0x88));
+        d_lo = _mm256_add_epi16(SDL_Blit_MultDiv255_AVX2(d_lo, _mm256_sub_epi16(v255, a_lo)), s_lo);
+        d_hi = _mm256_add_epi16(SDL_Blit_MultDiv255_AVX2(d_hi, _mm256_sub_epi16(v255, a_hi)), s_hi);
+        return _mm256_packus_epi16(d_lo, d_hi);
+    }
+    return _mm256_packus_epi16(s_lo, s_hi);
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1") SDL_Blit_MultDiv255_SSE41(__m128i a, __m128i b)
+{
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1") SDL_Blit_ModulateBlend_SSE41(__m128i src, __m128i dst, __m128i modulate, int flags)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(0xFF);
+    __m128i s_lo = _mm_unpacklo_epi8(src, zero);
+    __m128i s_hi = _mm_unpackhi_epi8(src, zero);
+
+    if (flags & SDL_COPY_MODULATE_MASK) {
+        s_lo = SDL_Blit_MultDiv255_SSE41(s_lo, modulate);
+        s_hi = SDL_Blit_MultDiv255_SSE41(s_hi, modulate);
+    }
+    if (flags & SDL_COPY_BLEND) {
+        const __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+        const __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+        __m128i d_lo = _mm_unpacklo_epi8(dst, zero);
+        __m128i d_hi = _mm_unpackhi_epi8(dst, zero);
+
+        /* Premultiply the color channels, leaving alpha unchanged */
+        s_lo = SDL_Blit_MultDiv255_SSE41(s_lo, _mm_blend_epi16(a_lo, v255, 0x88));
+        s_hi = SDL_Blit_MultDiv255_SSE41(s_hi, _mm_blend_epi16(a_hi, v255, 0x88));
+        d_lo = _mm_add_epi16(SDL_Blit_MultDiv255_SSE41(d_lo, _mm_sub_epi16(v255, a_lo)), s_lo);
+        d_hi = _mm_add_epi16(SDL_Blit_MultDiv255_SSE41(d_hi, _mm_sub_epi16(v255, a_hi)), s_hi);
+        return _mm_packus_epi16(d_lo, d_hi);
+    }
+    return _mm_packus_epi16(s_lo, s_hi);
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static SDL_INLINE uint8x16_t SDL_Blit_MultDiv255_NEON(uint8x16_t a, uint8x16_t b)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(a), vget_low_u8(b)), one);
+    uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(a), vget_high_u8(b)), one);
+
+    lo = vaddq_u16(lo, vshrq_n_u16(lo, 8));
+    hi = vaddq_u16(hi, vshrq_n_u16(hi, 8));
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+/* Blends 16 pixels, deinterleaved into planes by vld4q_u8() */
+static SDL_INLINE void SDL_Blit_ModulateBlend_NEON(uint8x16_t *dstR, uint8x16_t *dstG, uint8x16_t *dstB, uint8x16_t *dstA,
+                                                   uint8x16_t srcR, uint8x16_t srcG, uint8x16_t srcB, uint8x16_t srcA,
+                                                   const uint8x16_t *modulate, int flags)
+{
+    if (flags & SDL_COPY_MODULATE_MASK) {
+        srcR = SDL_Blit_MultDiv255_NEON(srcR, modulate[0]);
+        srcG = SDL_Blit_MultDiv255_NEON(srcG, modulate[1]);
+        srcB = SDL_Blit_MultDiv255_NEON(srcB, modulate[2]);
+        srcA = SDL_Blit_MultDiv255_NEON(srcA, modulate[3]);
+    }
+    if (flags & SDL_COPY_BLEND) {
+        const uint8x16_t invA = vsubq_u8(vdupq_n_u8(0xFF), srcA);
+
+        *dstR = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstR, invA), SDL_Blit_MultDiv255_NEON(srcR, srcA));
+        *dstG = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstG, invA), SDL_Blit_MultDiv255_NEON(srcG, srcA));
+        *dstB = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstB, invA), SDL_Blit_MultDiv255_NEON(srcB, srcA));
+        *dstA = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstA, invA), srcA);
+    } else {
+        *dstR = srcR;
+        *dstG = srcG;
+        *dstB = srcB;
+        *dstA = srcA;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
+
 static void SDL_Blit_XRGB8888_XRGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint64 srcy, srcx;
@@ -448,6 +562,149 @@ static void SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0, -128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XRGB8888_XBGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -872,6 +1129,149 @@ static void SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2, -128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XRGB8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -1313,6 +1713,146 @@ static void SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0, -128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XRGB8888_ABGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -1756,6 +2296,146 @@ static void SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2, -128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XBGR8888_XRGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -2180,6 +2860,149 @@ static void SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2, -128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XBGR8888_XBGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint64 srcy, srcx;
@@ -2599,6 +3422,149 @@ static void SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0, -128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XBGR8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -3042,6 +4008,146 @@ static void SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2, -128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(-128, 12, 13, 14, -128, 8, 9, 10, -128, 4, 5, 6, -128, 0, 1, 2);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_XBGR8888_ABGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -3483,6 +4589,146 @@ static void SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0, -128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m256i fill = _mm256_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), fill), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(-128, 14, 13, 12, -128, 10, 9, 8, -128, 6, 5, 4, -128, 2, 1, 0);
+    const __m128i fill = _mm_set1_epi32((int)0xFF000000);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), fill), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], vdupq_n_u8(0xFF),
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_ARGB8888_XRGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -3951,15 +5197,156 @@ static void SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
                 }
                 break;
             }
-            dstpixel = (dstR << 16) | (dstG << 8) | dstB;
-            *dst = dstpixel;
-            posx += incx;
-            ++dst;
+            dstpixel = (dstR << 16) | (dstG << 8) | dstB;
+            *dst = dstpixel;
+            posx += incx;
+            ++dst;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], s.val[3],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
         }
-        posy += incy;
+        info->src += info->src_pitch;
         info->dst += info->dst_pitch;
     }
 }
+#endif
 
 static void SDL_Blit_ARGB8888_XBGR8888_Scale(SDL_BlitInfo *info)
 {
@@ -4441,6 +5828,147 @@ static void SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2, 15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], s.val[3],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_ARGB8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint64 srcy, srcx;
@@ -4944,6 +6472,144 @@ static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], s.val[3],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_ARGB8888_ABGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -5452,6 +7118,144 @@ static void SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2, 15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[2], s.val[1], s.val[0], s.val[3],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_RGBA8888_XRGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -5930,6 +7734,147 @@ static void SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1, 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[3], s.val[2], s.val[1], s.val[0],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_RGBA8888_XBGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -6400,15 +8345,156 @@ static void SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
                 }
                 break;
             }
-            dstpixel = (dstB << 16) | (dstG << 8) | dstR;
-            *dst = dstpixel;
-            posx += incx;
-            ++dst;
+            dstpixel = (dstB << 16) | (dstG << 8) | dstR;
+            *dst = dstpixel;
+            posx += incx;
+            ++dst;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[3], s.val[2], s.val[1], s.val[0],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
         }
-        posy += incy;
+        info->src += info->src_pitch;
         info->dst += info->dst_pitch;
     }
 }
+#endif
 
 static void SDL_Blit_RGBA8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
@@ -6916,6 +9002,144 @@ static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1, 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[3], s.val[2], s.val[1], s.val[0],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_RGBA8888_ABGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -7424,6 +9648,144 @@ static void SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[3], s.val[2], s.val[1], s.val[0],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_ABGR8888_XRGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -7904,6 +10266,147 @@ static void SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2, 15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], s.val[3],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_ABGR8888_XBGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -8382,6 +10885,147 @@ static void SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], s.val[3],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_ABGR8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -8880,15 +11524,153 @@ static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
                 }
                 break;
             }
-            dstpixel = (dstA << 24) | (dstR << 16) | (dstG << 8) | dstB;
-            *dst = dstpixel;
-            posx += incx;
-            ++dst;
+            dstpixel = (dstA << 24) | (dstR << 16) | (dstG << 8) | dstB;
+            *dst = dstpixel;
+            posx += incx;
+            ++dst;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2, 15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(15, 12, 13, 14, 11, 8, 9, 10, 7, 4, 5, 6, 3, 0, 1, 2);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], s.val[3],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
         }
-        posy += incy;
+        info->src += info->src_pitch;
         info->dst += info->dst_pitch;
     }
 }
+#endif
 
 static void SDL_Blit_ABGR8888_ABGR8888_Scale(SDL_BlitInfo *info)
 {
@@ -9393,6 +12175,144 @@ static void SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[0], s.val[1], s.val[2], s.val[3],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_BGRA8888_XRGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -9873,6 +12793,147 @@ static void SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[1], s.val[2], s.val[3], s.val[0],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_BGRA8888_XBGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -10351,6 +13412,147 @@ static void SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1, 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    const __m256i keep = _mm256_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, _mm256_and_si256(pixels, keep));
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    const __m128i keep = _mm_set1_epi32(0x00FFFFFF);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, _mm_and_si128(pixels, keep));
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[1], s.val[2], s.val[3], s.val[0],
+                                        modulate, flags);
+            d.val[3] = vdupq_n_u8(0);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_BGRA8888_ARGB8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -10859,6 +14061,144 @@ static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m256i shuffle = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[2], &d.val[1], &d.val[0], &d.val[3],
+                                        s.val[1], s.val[2], s.val[3], s.val[0],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 static void SDL_Blit_BGRA8888_ABGR8888_Scale(SDL_BlitInfo *info)
 {
     Uint32 pixel;
@@ -11365,7 +14705,154 @@ static void SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_AVX2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m256i modulate = _mm256_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m256i shuffle = _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1, 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    Uint32 srcbuf[8], dstbuf[8];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m256i pixels;
+
+            if (n < 8) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm256_loadu_si256((const __m256i *)s);
+            pixels = SDL_Blit_ModulateBlend_AVX2(_mm256_shuffle_epi8(pixels, shuffle), _mm256_loadu_si256((const __m256i *)d), modulate, flags);
+            _mm256_storeu_si256((__m256i *)d, pixels);
+            if (n < 8) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_SSE41(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i shuffle = _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    Uint32 srcbuf[4], dstbuf[4];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            __m128i pixels;
+
+            if (n < 4) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = _mm_loadu_si128((const __m128i *)s);
+            pixels = SDL_Blit_ModulateBlend_SSE41(_mm_shuffle_epi8(pixels, shuffle), _mm_loadu_si128((const __m128i *)d), modulate, flags);
+            _mm_storeu_si128((__m128i *)d, pixels);
+            if (n < 4) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static void SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[16], dstbuf[16];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < 16) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON(&d.val[0], &d.val[1], &d.val[2], &d.val[3],
+                                        s.val[1], s.val[2], s.val[3], s.val[0],
+                                        modulate, flags);
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < 16) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XRGB8888_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_XRGB8888_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XRGB8888_Blend_Scale },
@@ -11373,6 +14860,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XRGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XRGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XBGR8888_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_XBGR8888_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XBGR8888_Blend_Scale },
@@ -11380,6 +14876,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XBGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_XBGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ARGB8888_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_ARGB8888_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ARGB8888_Blend_Scale },
@@ -11387,6 +14892,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ARGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ABGR8888_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_ABGR8888_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ABGR8888_Blend_Scale },
@@ -11394,6 +14908,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ABGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XRGB8888_ABGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XRGB8888_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_XRGB8888_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XRGB8888_Blend_Scale },
@@ -11401,6 +14924,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XRGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XRGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XBGR8888_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_XBGR8888_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XBGR8888_Blend_Scale },
@@ -11408,6 +14940,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XBGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_XBGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ARGB8888_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_ARGB8888_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ARGB8888_Blend_Scale },
@@ -11415,6 +14956,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ARGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ABGR8888_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_ABGR8888_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ABGR8888_Blend_Scale },
@@ -11422,6 +14972,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ABGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_XBGR8888_ABGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XRGB8888_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_XRGB8888_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XRGB8888_Blend_Scale },
@@ -11429,6 +14988,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XRGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XRGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XBGR8888_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_XBGR8888_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XBGR8888_Blend_Scale },
@@ -11436,6 +15004,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XBGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_XBGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale },
@@ -11443,6 +15020,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ABGR8888_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_ABGR8888_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ABGR8888_Blend_Scale },
@@ -11450,6 +15036,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ABGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ARGB8888_ABGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XRGB8888_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_XRGB8888_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XRGB8888_Blend_Scale },
@@ -11457,6 +15052,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XRGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XRGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XBGR8888_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_XBGR8888_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XBGR8888_Blend_Scale },
@@ -11464,6 +15068,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XBGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_XBGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale },
@@ -11471,6 +15084,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ABGR8888_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_ABGR8888_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ABGR8888_Blend_Scale },
@@ -11478,6 +15100,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ABGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGBA8888_ABGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XRGB8888_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_XRGB8888_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XRGB8888_Blend_Scale },
@@ -11485,6 +15116,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XRGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XRGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XBGR8888_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_XBGR8888_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XBGR8888_Blend_Scale },
@@ -11492,6 +15132,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XBGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_XBGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale },
@@ -11499,6 +15148,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ABGR8888_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_ABGR8888_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ABGR8888_Blend_Scale },
@@ -11506,6 +15164,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ABGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_ABGR8888_ABGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XRGB8888_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_XRGB8888_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XRGB8888_Blend_Scale },
@@ -11513,6 +15180,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XRGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XRGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XBGR8888_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_XBGR8888_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XBGR8888_Blend_Scale },
@@ -11520,6 +15196,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XBGR8888_Modulate_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XBGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_XBGR8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale },
@@ -11527,6 +15212,15 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale },
+#ifdef SDL_AVX2_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_AVX2, SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_AVX2 },
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_SSE4_1, SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_SSE41 },
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), SDL_CPU_NEON, SDL_Blit_BGRA8888_ABGR8888_Modulate_Blend_NEON },
+#endif
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ABGR8888_Scale },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK), SDL_CPU_ANY, SDL_Blit_BGRA8888_ABGR8888_Blend },
     { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ABGR8888, (SDL_COPY_BLEND_MASK | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_BGRA8888_ABGR8888_Blend_Scale },
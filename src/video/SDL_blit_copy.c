@@ -90,7 +90,8 @@ void SDL_BlitCopy(SDL_BlitInfo *info)
     }
 
 #ifdef SDL_SSE_INTRINSICS
-    if (SDL_HasSSE() &&
+    /* Streaming stores only pay off when the copy wouldn't fit in the cache anyway */
+    if ((size_t)w * h >= SDL_NONTEMPORAL_THRESHOLD && SDL_HasSSE() &&
         !((uintptr_t)src & 15) && !(srcskip & 15) &&
         !((uintptr_t)dst & 15) && !(dstskip & 15)) {
         while (h--) {
@@ -98,6 +99,7 @@ void SDL_BlitCopy(SDL_BlitInfo *info)
             src += srcskip;
             dst += dstskip;
         }
+        _mm_sfence();
         return;
     }
 #endif
@@ -415,8 +415,30 @@ static Uint16 float_to_half(float a)
     return ir;
 }
 
+/* Integer pixel data with a transfer function can be linearized with a lookup table */
+static const float *GetTransferTable(SlowBlitPixelAccess access, SDL_Colorspace colorspace)
+{
+    switch (SDL_COLORSPACETRANSFER(colorspace)) {
+    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+        if (access == SlowBlitPixelAccess_Index8 ||
+            access == SlowBlitPixelAccess_RGB ||
+            access == SlowBlitPixelAccess_RGBA) {
+            return SDL_GetsRGBtoLinearTable();
+        }
+        break;
+    case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        if (access == SlowBlitPixelAccess_10Bit) {
+            return SDL_GetPQtoNitsTable();
+        }
+        break;
+    default:
+        break;
+    }
+    return NULL;
+}
+
 static void ReadFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, SDL_Colorspace colorspace, float SDR_white_point,
-                           float *outR, float *outG, float *outB, float *outA)
+                           const float *transfer_table, float *outR, float *outG, float *outB, float *outA)
 {
     Uint32 pixel;
     Uint32 R, G, B, A;
@@ -425,28 +447,58 @@ static void ReadFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_
 
     switch (access) {
     case SlowBlitPixelAccess_Index8:
-        pixel = *pixels;
-        fR = (float)pal->colors[pixel].r / 255.0f;
-        fG = (float)pal->colors[pixel].g / 255.0f;
-        fB = (float)pal->colors[pixel].b / 255.0f;
-        fA = (float)pal->colors[pixel].a / 255.0f;
-        break;
     case SlowBlitPixelAccess_RGB:
-        DISEMBLE_RGB(pixels, fmt->bytes_per_pixel, fmt, pixel, R, G, B);
-        fR = (float)R / 255.0f;
-        fG = (float)G / 255.0f;
-        fB = (float)B / 255.0f;
-        fA = 1.0f;
-        break;
     case SlowBlitPixelAccess_RGBA:
-        DISEMBLE_RGBA(pixels, fmt->bytes_per_pixel, fmt, pixel, R, G, B, A);
+        if (access == SlowBlitPixelAccess_Index8) {
+            pixel = *pixels;
+            R = pal->colors[pixel].r;
+            G = pal->colors[pixel].g;
+            B = pal->colors[pixel].b;
+            A = pal->colors[pixel].a;
+        } else if (access == SlowBlitPixelAccess_RGB) {
+            DISEMBLE_RGB(pixels, fmt->bytes_per_pixel, fmt, pixel, R, G, B);
+            A = 255;
+        } else {
+            DISEMBLE_RGBA(pixels, fmt->bytes_per_pixel, fmt, pixel, R, G, B, A);
+        }
+        fA = (float)A / 255.0f;
+        if (transfer_table) {
+            *outR = transfer_table[R];
+            *outG = transfer_table[G];
+            *outB = transfer_table[B];
+            *outA = fA;
+            return;
+        }
         fR = (float)R / 255.0f;
         fG = (float)G / 255.0f;
         fB = (float)B / 255.0f;
-        fA = (float)A / 255.0f;
         break;
     case SlowBlitPixelAccess_10Bit:
         pixel = *((Uint32 *)pixels);
+        if (transfer_table) {
+            switch (fmt->format) {
+            case SDL_PIXELFORMAT_XRGB2101010:
+            case SDL_PIXELFORMAT_ARGB2101010:
+                R = (pixel >> 20) & 0x3FF;
+                B = (pixel >> 0) & 0x3FF;
+                break;
+            default:
+                R = (pixel >> 0) & 0x3FF;
+                B = (pixel >> 20) & 0x3FF;
+                break;
+            }
+            G = (pixel >> 10) & 0x3FF;
+            if (SDL_ISPIXELFORMAT_ALPHA(fmt->format)) {
+                fA = (float)(pixel >> 30) / 3.0f;
+            } else {
+                fA = 1.0f;
+            }
+            *outR = transfer_table[R] / SDR_white_point;
+            *outG = transfer_table[G] / SDR_white_point;
+            *outB = transfer_table[B] / SDR_white_point;
+            *outA = fA;
+            return;
+        }
         switch (fmt->format) {
         case SDL_PIXELFORMAT_XRGB2101010:
             RGBAFLOAT_FROM_ARGB2101010(pixel, fR, fG, fB, fA);
@@ -803,6 +855,260 @@ static void ApplyTonemap(SDL_TonemapContext *ctx, float *r, float *g, float *b)
     }
 }
 
+/* Straight conversions between the common SDR and HDR formats are done a row
+ * at a time, with the format and colorspace decisions made once per blit
+ * instead of once per pixel.
+ */
+typedef enum
+{
+    FloatRow_Generic,
+    FloatRow_sRGB8,     /* 32-bit 8888 with the sRGB transfer function */
+    FloatRow_PQ10,      /* 32-bit 2101010 with the PQ transfer function */
+    FloatRow_Float16,   /* half float with a linear transfer function */
+    FloatRow_Float32    /* float with a linear transfer function */
+} FloatRowType;
+
+typedef struct
+{
+    FloatRowType type;
+    SlowBlitPixelAccess access;
+    const SDL_PixelFormatDetails *fmt;
+    const SDL_Palette *pal;
+    SDL_Colorspace colorspace;
+    float white_point;
+    const float *transfer_table;
+    int channels;
+    int offset[4]; /* component index of R, G, B and A, A is -1 if there isn't one */
+} FloatRowFormat;
+
+static void SetupFloatRowFormat(FloatRowFormat *row, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal,
+                                SDL_Colorspace colorspace, float white_point, const float *transfer_table)
+{
+    const SDL_TransferCharacteristics transfer = SDL_COLORSPACETRANSFER(colorspace);
+
+    SDL_zerop(row);
+    row->type = FloatRow_Generic;
+    row->access = access;
+    row->fmt = fmt;
+    row->pal = pal;
+    row->colorspace = colorspace;
+    row->white_point = white_point;
+    row->transfer_table = transfer_table;
+
+    switch (access) {
+    case SlowBlitPixelAccess_RGB:
+    case SlowBlitPixelAccess_RGBA:
+        if (transfer == SDL_TRANSFER_CHARACTERISTICS_SRGB && fmt->bytes_per_pixel == 4 &&
+            fmt->Rbits == 8 && fmt->Gbits == 8 && fmt->Bbits == 8 && (fmt->Abits == 8 || fmt->Abits == 0)) {
+            row->type = FloatRow_sRGB8;
+        }
+        break;
+    case SlowBlitPixelAccess_10Bit:
+        if (transfer == SDL_TRANSFER_CHARACTERISTICS_PQ) {
+            row->type = FloatRow_PQ10;
+        }
+        break;
+    case SlowBlitPixelAccess_Large:
+        if (transfer != SDL_TRANSFER_CHARACTERISTICS_LINEAR) {
+            break;
+        }
+        switch (SDL_PIXELTYPE(fmt->format)) {
+        case SDL_PIXELTYPE_ARRAYF16:
+            row->type = FloatRow_Float16;
+            row->channels = fmt->bytes_per_pixel / 2;
+            break;
+        case SDL_PIXELTYPE_ARRAYF32:
+            row->type = FloatRow_Float32;
+            row->channels = fmt->bytes_per_pixel / 4;
+            break;
+        default:
+            return;
+        }
+        switch (SDL_PIXELORDER(fmt->format)) {
+        case SDL_ARRAYORDER_RGB:
+        case SDL_ARRAYORDER_RGBA:
+            row->offset[0] = 0;
+            row->offset[1] = 1;
+            row->offset[2] = 2;
+            row->offset[3] = 3;
+            break;
+        case SDL_ARRAYORDER_ARGB:
+            row->offset[0] = 1;
+            row->offset[1] = 2;
+            row->offset[2] = 3;
+            row->offset[3] = 0;
+            break;
+        case SDL_ARRAYORDER_BGR:
+        case SDL_ARRAYORDER_BGRA:
+            row->offset[0] = 2;
+            row->offset[1] = 1;
+            row->offset[2] = 0;
+            row->offset[3] = 3;
+            break;
+        case SDL_ARRAYORDER_ABGR:
+            row->offset[0] = 3;
+            row->offset[1] = 2;
+            row->offset[2] = 1;
+            row->offset[3] = 0;
+            break;
+        default:
+            row->type = FloatRow_Generic;
+            return;
+        }
+        if (row->channels == 3) {
+            row->offset[3] = -1;
+        } else if (row->channels != 4) {
+            row->type = FloatRow_Generic;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* Reads a row of pixels as linear RGBA, in the same units as ReadFloatPixel() */
+static void ReadFloatRow(const FloatRowFormat *row, const Uint8 *src, int width, float *rgba)
+{
+    const SDL_PixelFormatDetails *fmt = row->fmt;
+    const float *table = row->transfer_table;
+    int i;
+
+    switch (row->type) {
+    case FloatRow_sRGB8:
+    {
+        const Uint32 *pixels = (const Uint32 *)src;
+        const SDL_bool has_alpha = (row->access == SlowBlitPixelAccess_RGBA);
+        for (i = 0; i < width; ++i, rgba += 4) {
+            const Uint32 pixel = pixels[i];
+            rgba[0] = table[(pixel >> fmt->Rshift) & 0xFF];
+            rgba[1] = table[(pixel >> fmt->Gshift) & 0xFF];
+            rgba[2] = table[(pixel >> fmt->Bshift) & 0xFF];
+            rgba[3] = has_alpha ? (float)((pixel >> fmt->Ashift) & 0xFF) / 255.0f : 1.0f;
+        }
+        break;
+    }
+    case FloatRow_PQ10:
+    {
+        const Uint32 *pixels = (const Uint32 *)src;
+        const SDL_bool has_alpha = SDL_ISPIXELFORMAT_ALPHA(fmt->format);
+        const float white_point = row->white_point;
+        int rshift, bshift;
+        if (fmt->format == SDL_PIXELFORMAT_XRGB2101010 || fmt->format == SDL_PIXELFORMAT_ARGB2101010) {
+            rshift = 20;
+            bshift = 0;
+        } else {
+            rshift = 0;
+            bshift = 20;
+        }
+        for (i = 0; i < width; ++i, rgba += 4) {
+            const Uint32 pixel = pixels[i];
+            rgba[0] = table[(pixel >> rshift) & 0x3FF] / white_point;
+            rgba[1] = table[(pixel >> 10) & 0x3FF] / white_point;
+            rgba[2] = table[(pixel >> bshift) & 0x3FF] / white_point;
+            rgba[3] = has_alpha ? (float)(pixel >> 30) / 3.0f : 1.0f;
+        }
+        break;
+    }
+    case FloatRow_Float16:
+    case FloatRow_Float32:
+    {
+        const float white_point = row->white_point;
+        const int channels = row->channels;
+        const int r = row->offset[0], g = row->offset[1], b = row->offset[2], a = row->offset[3];
+        if (row->type == FloatRow_Float16) {
+            const Uint16 *pixels = (const Uint16 *)src;
+            for (i = 0; i < width; ++i, rgba += 4, pixels += channels) {
+                rgba[0] = half_to_float(pixels[r]) / white_point;
+                rgba[1] = half_to_float(pixels[g]) / white_point;
+                rgba[2] = half_to_float(pixels[b]) / white_point;
+                rgba[3] = (a >= 0) ? half_to_float(pixels[a]) : 1.0f;
+            }
+        } else {
+            const float *pixels = (const float *)src;
+            for (i = 0; i < width; ++i, rgba += 4, pixels += channels) {
+                rgba[0] = pixels[r] / white_point;
+                rgba[1] = pixels[g] / white_point;
+                rgba[2] = pixels[b] / white_point;
+                rgba[3] = (a >= 0) ? pixels[a] : 1.0f;
+            }
+        }
+        break;
+    }
+    default:
+    {
+        const int bpp = fmt->bytes_per_pixel;
+        for (i = 0; i < width; ++i, rgba += 4, src += bpp) {
+            ReadFloatPixel((Uint8 *)src, row->access, fmt, row->pal, row->colorspace, row->white_point, table, &rgba[0], &rgba[1], &rgba[2], &rgba[3]);
+        }
+        break;
+    }
+    }
+}
+
+/* Writes a row of linear RGBA pixels, the same way as WriteFloatPixel() */
+static void WriteFloatRow(const FloatRowFormat *row, Uint8 *table, const float *rgba, int width, Uint8 *dst)
+{
+    const SDL_PixelFormatDetails *fmt = row->fmt;
+    int i;
+
+    switch (row->type) {
+    case FloatRow_sRGB8:
+    {
+        Uint32 *pixels = (Uint32 *)dst;
+        const SDL_bool has_alpha = (row->access == SlowBlitPixelAccess_RGBA);
+        for (i = 0; i < width; ++i, rgba += 4) {
+            Uint32 pixel = ((Uint32)SDL_sRGB8fromLinear(rgba[0]) << fmt->Rshift) |
+                           ((Uint32)SDL_sRGB8fromLinear(rgba[1]) << fmt->Gshift) |
+                           ((Uint32)SDL_sRGB8fromLinear(rgba[2]) << fmt->Bshift);
+            if (has_alpha) {
+                pixel |= (Uint32)SDL_roundf(SDL_clamp(rgba[3], 0.0f, 1.0f) * 255.0f) << fmt->Ashift;
+            } else {
+                pixel |= fmt->Amask;
+            }
+            pixels[i] = pixel;
+        }
+        break;
+    }
+    case FloatRow_Float16:
+    case FloatRow_Float32:
+    {
+        const float white_point = row->white_point;
+        const int channels = row->channels;
+        const int r = row->offset[0], g = row->offset[1], b = row->offset[2], a = row->offset[3];
+        if (row->type == FloatRow_Float16) {
+            Uint16 *pixels = (Uint16 *)dst;
+            for (i = 0; i < width; ++i, rgba += 4, pixels += channels) {
+                pixels[r] = float_to_half(rgba[0] * white_point);
+                pixels[g] = float_to_half(rgba[1] * white_point);
+                pixels[b] = float_to_half(rgba[2] * white_point);
+                if (a >= 0) {
+                    pixels[a] = float_to_half(rgba[3]);
+                }
+            }
+        } else {
+            float *pixels = (float *)dst;
+            for (i = 0; i < width; ++i, rgba += 4, pixels += channels) {
+                pixels[r] = rgba[0] * white_point;
+                pixels[g] = rgba[1] * white_point;
+                pixels[b] = rgba[2] * white_point;
+                if (a >= 0) {
+                    pixels[a] = rgba[3];
+                }
+            }
+        }
+        break;
+    }
+    default:
+    {
+        const int bpp = fmt->bytes_per_pixel;
+        for (i = 0; i < width; ++i, rgba += 4, dst += bpp) {
+            WriteFloatPixel(dst, row->access, fmt, table, row->colorspace, row->white_point, rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+        break;
+    }
+    }
+}
+
 /* The SECOND TRUE BLITTER
  * This one is even slower than the first, but also handles large pixel formats and colorspace conversion
  */
@@ -836,6 +1142,8 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     float dst_headroom;
     float src_headroom;
     SDL_TonemapContext tonemap;
+    const float *src_transfer_table;
+    const float *dst_transfer_table;
 
     src_colorspace = info->src_surface->internal->colorspace;
     dst_colorspace = info->dst_surface->internal->colorspace;
@@ -886,6 +1194,42 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
 
     src_access = GetPixelAccessMethod(src_fmt->format);
     dst_access = GetPixelAccessMethod(dst_fmt->format);
+    src_transfer_table = GetTransferTable(src_access, src_colorspace);
+    dst_transfer_table = GetTransferTable(dst_access, dst_colorspace);
+
+    if (!(flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) &&
+        info->src_w == info->dst_w && info->src_h == info->dst_h) {
+        /* This is a straight conversion, which we can do a row at a time */
+        float *rgba = (float *)SDL_malloc(info->dst_w * 4 * sizeof(float));
+        if (rgba) {
+            FloatRowFormat src_row, dst_row;
+
+            SetupFloatRowFormat(&src_row, src_access, src_fmt, src_pal, src_colorspace, src_white_point, src_transfer_table);
+            SetupFloatRowFormat(&dst_row, dst_access, dst_fmt, dst_pal, dst_colorspace, dst_white_point, dst_transfer_table);
+
+            while (info->dst_h--) {
+                ReadFloatRow(&src_row, info->src, info->dst_w, rgba);
+                if (tonemap.op || color_primaries_matrix) {
+                    float *pixel = rgba;
+                    int n;
+                    for (n = info->dst_w; n--; pixel += 4) {
+                        if (tonemap.op) {
+                            ApplyTonemap(&tonemap, &pixel[0], &pixel[1], &pixel[2]);
+                        }
+                        if (color_primaries_matrix) {
+                            SDL_ConvertColorPrimaries(&pixel[0], &pixel[1], &pixel[2], color_primaries_matrix);
+                        }
+                    }
+                }
+                WriteFloatRow(&dst_row, info->table, rgba, info->dst_w, info->dst);
+
+                info->src += info->src_pitch;
+                info->dst += info->dst_pitch;
+            }
+            SDL_free(rgba);
+            return;
+        }
+    }
 
     incy = ((Uint64)info->src_h << 16) / info->dst_h;
     incx = ((Uint64)info->src_w << 16) / info->dst_w;
@@ -901,7 +1245,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
             srcx = posx >> 16;
             src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
 
-            ReadFloatPixel(src, src_access, src_fmt, src_pal, src_colorspace, src_white_point, &srcR, &srcG, &srcB, &srcA);
+            ReadFloatPixel(src, src_access, src_fmt, src_pal, src_colorspace, src_white_point, src_transfer_table, &srcR, &srcG, &srcB, &srcA);
 
             if (tonemap.op) {
                 ApplyTonemap(&tonemap, &srcR, &srcG, &srcB);
@@ -915,7 +1259,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
                 /* colorkey isn't supported */
             }
             if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
-                ReadFloatPixel(dst, dst_access, dst_fmt, dst_pal, dst_colorspace, dst_white_point, &dstR, &dstG, &dstB, &dstA);
+                ReadFloatPixel(dst, dst_access, dst_fmt, dst_pal, dst_colorspace, dst_white_point, dst_transfer_table, &dstR, &dstG, &dstB, &dstA);
             } else {
                 /* don't care */
                 dstR = dstG = dstB = dstA = 0.0f;
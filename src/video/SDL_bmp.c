@@ -33,6 +33,7 @@
 */
 
 #include "SDL_pixels_c.h"
+#include "SDL_video_c.h"
 
 #define SAVE_32BIT_BMP
 
@@ -193,11 +194,12 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
-SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
+SDL_Surface *SDL_LoadBMP_IO_Internal(SDL_IOStream *src, SDL_bool closeio, SDL_LoadBMPCreateSurfaceFunc create, void *userdata)
 {
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset = 0;
-    int i, pad;
+    int i;
+    size_t bmpPitch;
     SDL_Surface *surface;
     Uint32 Rmask = 0;
     Uint32 Gmask = 0;
@@ -430,7 +432,11 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
 
         /* Get the pixel format */
         format = SDL_GetPixelFormatForMasks(biBitCount, Rmask, Gmask, Bmask, Amask);
-        surface = SDL_CreateSurface(biWidth, biHeight, format);
+        if (create) {
+            surface = create(biWidth, biHeight, format, userdata);
+        } else {
+            surface = SDL_CreateSurface(biWidth, biHeight, format);
+        }
 
         if (!surface) {
             goto done;
@@ -506,18 +512,38 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
         }
         goto done;
     }
+    /* Rows in the file are padded to 4 bytes, which is usually the pitch of
+       the surface too, so read the whole image at once when we can */
+    bmpPitch = (((size_t)surface->w * ((biBitCount == 15) ? 16 : biBitCount) + 31) / 32) * 4;
     top = (Uint8 *)surface->pixels;
-    end = (Uint8 *)surface->pixels + (surface->h * surface->pitch);
-    pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
-    if (topDown) {
-        bits = top;
-    } else {
-        bits = end - surface->pitch;
-    }
-    while (bits >= top && bits < end) {
-        if (SDL_ReadIO(src, bits, surface->pitch) != (size_t)surface->pitch) {
+    end = (Uint8 *)surface->pixels + ((size_t)surface->h * surface->pitch);
+    if (bmpPitch == (size_t)surface->pitch) {
+        const size_t size = (size_t)surface->h * surface->pitch;
+        if (SDL_ReadIO(src, top, size) != size) {
             goto done;
         }
+        if (!topDown) {
+            SDL_FlipSurface(surface, SDL_FLIP_VERTICAL);
+        }
+    } else {
+        if (topDown) {
+            bits = top;
+        } else {
+            bits = end - surface->pitch;
+        }
+        while (bits >= top && bits < end) {
+            if (SDL_ReadIO(src, bits, bmpPitch) != bmpPitch) {
+                goto done;
+            }
+            if (topDown) {
+                bits += surface->pitch;
+            } else {
+                bits -= surface->pitch;
+            }
+        }
+    }
+
+    for (bits = top; bits < end; bits += surface->pitch) {
         if (biBitCount == 8 && surface->internal->palette && biClrUsed < (1u << biBitCount)) {
             for (i = 0; i < surface->w; ++i) {
                 if (bits[i] >= biClrUsed) {
@@ -550,21 +576,6 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
         }
         }
 #endif
-
-        /* Skip padding bytes, ugh */
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                if (!SDL_ReadU8(src, &padbyte)) {
-                    goto done;
-                }
-            }
-        }
-        if (topDown) {
-            bits += surface->pitch;
-        } else {
-            bits -= surface->pitch;
-        }
     }
     if (correctAlpha) {
         CorrectAlphaChannel(surface);
@@ -586,6 +597,11 @@ done:
     return surface;
 }
 
+SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, SDL_bool closeio)
+{
+    return SDL_LoadBMP_IO_Internal(src, closeio, NULL, NULL);
+}
+
 SDL_Surface *SDL_LoadBMP(const char *file)
 {
     return SDL_LoadBMP_IO(SDL_IOFromFile(file, "rb"), 1);
@@ -819,18 +835,17 @@ int SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, SDL_bool closeio)
         bits = (Uint8 *)intermediate_surface->pixels + (intermediate_surface->h * intermediate_surface->pitch);
         pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
         while (bits > (Uint8 *)intermediate_surface->pixels) {
+            Uint8 padbytes[3] = { 0, 0, 0 };
+            SDL_IOVec row[2];
+
             bits -= intermediate_surface->pitch;
-            if (SDL_WriteIO(dst, bits, bw) != bw) {
+            row[0].ptr = bits;
+            row[0].size = bw;
+            row[1].ptr = padbytes;
+            row[1].size = (size_t)pad;
+            if (SDL_WriteIOV(dst, row, SDL_arraysize(row)) != (bw + pad)) {
                 goto done;
             }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    if (!SDL_WriteU8(dst, padbyte)) {
-                        goto done;
-                    }
-                }
-            }
         }
 
         /* Write the BMP file size */
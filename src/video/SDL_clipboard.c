@@ -197,6 +197,140 @@ void *SDL_GetClipboardData(const char *mime_type, size_t *size)
     }
 }
 
+/* A read-only stream over a clipboard buffer that is freed with SDL_free() when the stream is closed */
+typedef struct SDL_ClipboardBufferStream
+{
+    Uint8 *data;
+    size_t size;
+    size_t pos;
+} SDL_ClipboardBufferStream;
+
+static Sint64 SDLCALL ClipboardBuffer_size(void *userdata)
+{
+    SDL_ClipboardBufferStream *stream = (SDL_ClipboardBufferStream *)userdata;
+    return (Sint64)stream->size;
+}
+
+static Sint64 SDLCALL ClipboardBuffer_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    SDL_ClipboardBufferStream *stream = (SDL_ClipboardBufferStream *)userdata;
+    Sint64 pos;
+
+    switch (whence) {
+    case SDL_IO_SEEK_SET:
+        pos = offset;
+        break;
+    case SDL_IO_SEEK_CUR:
+        pos = (Sint64)stream->pos + offset;
+        break;
+    case SDL_IO_SEEK_END:
+        pos = (Sint64)stream->size + offset;
+        break;
+    default:
+        return SDL_SetError("Unknown value for 'whence'");
+    }
+    stream->pos = (size_t)SDL_clamp(pos, 0, (Sint64)stream->size);
+    return (Sint64)stream->pos;
+}
+
+static size_t SDLCALL ClipboardBuffer_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    SDL_ClipboardBufferStream *stream = (SDL_ClipboardBufferStream *)userdata;
+    const size_t amount = SDL_min(size, stream->size - stream->pos);
+
+    SDL_memcpy(ptr, stream->data + stream->pos, amount);
+    stream->pos += amount;
+    if (amount < size) {
+        *status = SDL_IO_STATUS_EOF;
+    }
+    return amount;
+}
+
+static int SDLCALL ClipboardBuffer_close(void *userdata)
+{
+    SDL_ClipboardBufferStream *stream = (SDL_ClipboardBufferStream *)userdata;
+    SDL_free(stream->data);
+    SDL_free(stream);
+    return 0;
+}
+
+SDL_IOStream *SDL_IOFromClipboardBuffer(void *data, size_t size)
+{
+    SDL_ClipboardBufferStream *stream;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *io;
+
+    stream = (SDL_ClipboardBufferStream *)SDL_malloc(sizeof(*stream));
+    if (!stream) {
+        SDL_free(data);
+        return NULL;
+    }
+    stream->data = (Uint8 *)data;
+    stream->size = size;
+    stream->pos = 0;
+
+    SDL_zero(iface);
+    iface.size = ClipboardBuffer_size;
+    iface.seek = ClipboardBuffer_seek;
+    iface.read = ClipboardBuffer_read;
+    iface.close = ClipboardBuffer_close;
+
+    io = SDL_OpenIO(&iface, stream);
+    if (!io) {
+        ClipboardBuffer_close(stream);
+    }
+    return io;
+}
+
+SDL_IOStream *SDL_OpenInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type)
+{
+    if (_this->clipboard_callback) {
+        size_t size = 0;
+        const void *provided_data = _this->clipboard_callback(_this->clipboard_userdata, mime_type, &size);
+        if (provided_data && size > 0) {
+            /* Read straight from the application's buffer, it stays valid until the clipboard changes */
+            return SDL_IOFromConstMem(provided_data, size);
+        }
+    }
+    SDL_SetError("No clipboard data for %s", mime_type);
+    return NULL;
+}
+
+SDL_IOStream *SDL_OpenClipboardData(const char *mime_type)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+    void *data;
+    size_t size = 0;
+
+    if (!_this) {
+        SDL_SetError("Video subsystem must be initialized to get clipboard data");
+        return NULL;
+    }
+
+    if (!mime_type) {
+        SDL_InvalidParamError("mime_type");
+        return NULL;
+    }
+
+    if (_this->OpenClipboardData) {
+        return _this->OpenClipboardData(_this, mime_type);
+    }
+    if (!_this->GetClipboardData && !_this->GetClipboardText) {
+        return SDL_OpenInternalClipboardData(_this, mime_type);
+    }
+
+    /* The backend can only hand over the whole thing */
+    data = SDL_GetClipboardData(mime_type, &size);
+    if (!data) {
+        SDL_SetError("No clipboard data for %s", mime_type);
+        return NULL;
+    }
+    if (size == 0 && SDL_IsTextMimeType(mime_type)) {
+        size = SDL_strlen((const char *)data);
+    }
+    return SDL_IOFromClipboardBuffer(data, size);
+}
+
 SDL_bool SDL_HasInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type)
 {
     size_t i;
@@ -35,6 +35,10 @@ extern void SDL_CancelClipboardData(Uint32 sequence);
 /* Call the clipboard callback for application data */
 extern void *SDL_GetInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t *size);
 extern SDL_bool SDL_HasInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type);
+extern SDL_IOStream *SDL_OpenInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type);
+
+/* Wrap a buffer from SDL_malloc() in a read-only stream that frees it when closed */
+extern SDL_IOStream *SDL_IOFromClipboardBuffer(void *data, size_t size);
 
 /* General purpose clipboard text callback */
 const void * SDLCALL SDL_ClipboardTextCallback(void *userdata, const char *mime_type, size_t *size);
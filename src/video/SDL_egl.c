@@ -118,6 +118,10 @@
 #define EGL_PLATFORM_DEVICE_EXT 0x0
 #endif
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
 #ifdef SDL_VIDEO_OPENGL
 typedef void (APIENTRY* PFNGLGETINTEGERVPROC) (GLenum pname, GLint * params);
 #endif
@@ -450,6 +454,7 @@ static int SDL_EGL_LoadLibraryInternal(SDL_VideoDevice *_this, const char *egl_p
     LOAD_FUNC(PFNEGLBINDAPIPROC, eglBindAPI);
     LOAD_FUNC(PFNEGLGETERRORPROC, eglGetError);
     LOAD_FUNC_EGLEXT(PFNEGLQUERYDEVICESEXTPROC, eglQueryDevicesEXT);
+    LOAD_FUNC_EGLEXT(PFNEGLQUERYDEVICESTRINGEXTPROC, eglQueryDeviceStringEXT);
     LOAD_FUNC_EGLEXT(PFNEGLGETPLATFORMDISPLAYEXTPROC, eglGetPlatformDisplayEXT);
     /* Atomic functions */
     LOAD_FUNC_EGLEXT(PFNEGLCREATESYNCKHRPROC, eglCreateSyncKHR);
@@ -583,6 +588,39 @@ int SDL_EGL_LoadLibrary(SDL_VideoDevice *_this, const char *egl_path, NativeDisp
    valid available GPU for EGL to use.
 */
 
+/* Returns SDL_TRUE if the device is a software rasterizer, like Mesa's llvmpipe */
+static SDL_bool SDL_EGL_IsSoftwareDevice(SDL_VideoDevice *_this, void *egl_device)
+{
+    const char *extensions;
+
+    if (!_this->egl_data->eglQueryDeviceStringEXT) {
+        return SDL_FALSE;
+    }
+
+    extensions = _this->egl_data->eglQueryDeviceStringEXT(egl_device, EGL_EXTENSIONS);
+    if (extensions && SDL_strstr(extensions, "EGL_MESA_device_software")) {
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+static SDL_bool SDL_EGL_InitializeOffscreenDisplay(SDL_VideoDevice *_this, EGLenum platform, void *native_display)
+{
+    EGLDisplay attempted_egl_display = _this->egl_data->eglGetPlatformDisplayEXT(platform, native_display, NULL);
+
+    if (attempted_egl_display == EGL_NO_DISPLAY) {
+        return SDL_FALSE;
+    }
+
+    if (_this->egl_data->eglInitialize(attempted_egl_display, NULL, NULL) != EGL_TRUE) {
+        _this->egl_data->eglTerminate(attempted_egl_display);
+        return SDL_FALSE;
+    }
+
+    _this->egl_data->egl_display = attempted_egl_display;
+    return SDL_TRUE;
+}
+
 int SDL_EGL_InitializeOffscreen(SDL_VideoDevice *_this, int device)
 {
     void *egl_devices[SDL_EGL_MAX_DEVICES];
@@ -594,20 +632,21 @@ int SDL_EGL_InitializeOffscreen(SDL_VideoDevice *_this, int device)
     }
 
     /* Check for all extensions that are optional until used and fail if any is missing */
-    if (!_this->egl_data->eglQueryDevicesEXT) {
-        return SDL_SetError("eglQueryDevicesEXT is missing (EXT_device_enumeration not supported by the drivers?)");
-    }
-
     if (!_this->egl_data->eglGetPlatformDisplayEXT) {
         return SDL_SetError("eglGetPlatformDisplayEXT is missing (EXT_platform_base not supported by the drivers?)");
     }
 
-    if (_this->egl_data->eglQueryDevicesEXT(SDL_EGL_MAX_DEVICES, egl_devices, &num_egl_devices) != EGL_TRUE) {
-        return SDL_SetError("eglQueryDevicesEXT() failed");
+    if (_this->egl_data->eglQueryDevicesEXT &&
+        _this->egl_data->eglQueryDevicesEXT(SDL_EGL_MAX_DEVICES, egl_devices, &num_egl_devices) != EGL_TRUE) {
+        num_egl_devices = 0;
     }
 
     egl_device_hint = SDL_GetHint("SDL_HINT_EGL_DEVICE");
     if (egl_device_hint) {
+        if (!_this->egl_data->eglQueryDevicesEXT) {
+            return SDL_SetError("eglQueryDevicesEXT is missing (EXT_device_enumeration not supported by the drivers?)");
+        }
+
         device = SDL_atoi(egl_device_hint);
 
         if (device >= num_egl_devices) {
@@ -624,28 +663,30 @@ int SDL_EGL_InitializeOffscreen(SDL_VideoDevice *_this, int device)
             return SDL_SetError("Could not initialize EGL");
         }
     } else {
-        int i;
+        int i, pass;
         SDL_bool found = SDL_FALSE;
-        EGLDisplay attempted_egl_display;
 
-        /* If no hint is provided lets look for the first device/display that will allow us to eglInit */
-        for (i = 0; i < num_egl_devices; i++) {
-            attempted_egl_display = _this->egl_data->eglGetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, egl_devices[i], NULL);
+        /* If no hint is provided lets look for the first device/display that will allow us to eglInit.
+           Hardware devices are tried first, so headless machines with a GPU don't end up on llvmpipe. */
+        for (pass = 0; pass < 2 && !found; ++pass) {
+            const SDL_bool want_software = (pass == 1);
 
-            if (attempted_egl_display == EGL_NO_DISPLAY) {
-                continue;
-            }
+            for (i = 0; i < num_egl_devices; i++) {
+                if (SDL_EGL_IsSoftwareDevice(_this, egl_devices[i]) != want_software) {
+                    continue;
+                }
 
-            if (_this->egl_data->eglInitialize(attempted_egl_display, NULL, NULL) != EGL_TRUE) {
-                _this->egl_data->eglTerminate(attempted_egl_display);
-                continue;
+                if (SDL_EGL_InitializeOffscreenDisplay(_this, EGL_PLATFORM_DEVICE_EXT, egl_devices[i])) {
+                    /* We did not fail, we'll pick this one! */
+                    found = SDL_TRUE;
+                    break;
+                }
             }
+        }
 
-            /* We did not fail, we'll pick this one! */
-            _this->egl_data->egl_display = attempted_egl_display;
-            found = SDL_TRUE;
-
-            break;
+        /* Mesa can also render without any device or window system, if device enumeration isn't available */
+        if (!found && SDL_EGL_HasExtension(_this, SDL_EGL_CLIENT_EXTENSION, "EGL_MESA_platform_surfaceless")) {
+            found = SDL_EGL_InitializeOffscreenDisplay(_this, EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY);
         }
 
         if (!found) {
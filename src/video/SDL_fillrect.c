@@ -250,7 +250,8 @@ int SDL_FillSurfaceRect(SDL_Surface *dst, const SDL_Rect *rect, Uint32 color)
 int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
                   Uint32 color)
 {
-    SDL_Rect clipped;
+    SDL_Rect *clipped;
+    SDL_bool isstack;
     Uint8 *pixels;
     const SDL_Rect *rect;
     void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
@@ -283,6 +284,7 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
             if (r->x == 0 && r->y == 0 && r->w == dst->w && r->h == dst->h) {
                 if (SDL_BITSPERPIXEL(dst->format) == 4) {
                     Uint8 b = (((Uint8)color << 4) | (Uint8)color);
+                    SDL_AddSurfaceDamage(dst, NULL);
                     SDL_memset(dst->pixels, b, (size_t)dst->h * dst->pitch);
                     return 1;
                 }
@@ -344,19 +346,31 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         }
     }
 
-    for (i = 0; i < count; ++i) {
-        rect = &rects[i];
-        /* Perform clipping */
-        if (!SDL_GetRectIntersection(rect, &dst->internal->clip_rect, &clipped)) {
-            continue;
-        }
-        rect = &clipped;
+    if (count <= 0) {
+        return 0;
+    }
+
+    /* Perform clipping, all at once */
+    clipped = SDL_small_alloc(SDL_Rect, count, &isstack);
+    if (!clipped) {
+        return -1;
+    }
+    if (SDL_GetRectIntersections(rects, count, &dst->internal->clip_rect, clipped, NULL) > 0) {
+        for (i = 0; i < count; ++i) {
+            rect = &clipped[i];
+            if (!rect->w) {
+                continue;
+            }
 
-        pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
-                 rect->x * SDL_BYTESPERPIXEL(dst->format);
+            SDL_AddSurfaceDamage(dst, rect);
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+            pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
+                     rect->x * SDL_BYTESPERPIXEL(dst->format);
+
+            fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        }
     }
+    SDL_small_free(clipped, isstack);
 
     /* We're done! */
     return 0;
@@ -158,6 +158,15 @@ const char *SDL_GetPixelFormatName(SDL_PixelFormat format)
         CASE(SDL_PIXELFORMAT_NV21)
         CASE(SDL_PIXELFORMAT_P010)
         CASE(SDL_PIXELFORMAT_EXTERNAL_OES)
+        CASE(SDL_PIXELFORMAT_BC1)
+        CASE(SDL_PIXELFORMAT_BC2)
+        CASE(SDL_PIXELFORMAT_BC3)
+        CASE(SDL_PIXELFORMAT_BC4)
+        CASE(SDL_PIXELFORMAT_BC5)
+        CASE(SDL_PIXELFORMAT_BC7)
+        CASE(SDL_PIXELFORMAT_ETC2_RGB8)
+        CASE(SDL_PIXELFORMAT_ETC2_RGBA8)
+        CASE(SDL_PIXELFORMAT_ASTC_4X4)
 
     default:
         return "SDL_PIXELFORMAT_UNKNOWN";
@@ -699,9 +708,36 @@ void SDL_QuitPixelFormatDetails(void)
     }
 }
 
+int SDL_GetCompressedFormatBlockSize(SDL_PixelFormat format, int *block_w, int *block_h)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_BC1:
+    case SDL_PIXELFORMAT_BC4:
+    case SDL_PIXELFORMAT_ETC2_RGB8:
+        *block_w = 4;
+        *block_h = 4;
+        return 8;
+    case SDL_PIXELFORMAT_BC2:
+    case SDL_PIXELFORMAT_BC3:
+    case SDL_PIXELFORMAT_BC5:
+    case SDL_PIXELFORMAT_BC7:
+    case SDL_PIXELFORMAT_ETC2_RGBA8:
+    case SDL_PIXELFORMAT_ASTC_4X4:
+        *block_w = 4;
+        *block_h = 4;
+        return 16;
+    default:
+        *block_w = 1;
+        *block_h = 1;
+        return 0;
+    }
+}
+
 SDL_Colorspace SDL_GetDefaultColorspaceForFormat(SDL_PixelFormat format)
 {
-    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+    if (SDL_ISPIXELFORMAT_COMPRESSED(format)) {
+        return SDL_COLORSPACE_SRGB;
+    } else if (SDL_ISPIXELFORMAT_FOURCC(format)) {
         if (format == SDL_PIXELFORMAT_P010) {
             return SDL_COLORSPACE_HDR10;
         } else {
@@ -763,6 +799,94 @@ float SDL_PQfromNits(float v)
     return SDL_powf(num / den, m2);
 }
 
+/* Lookup tables for the transfer functions of integer pixel data.
+ * These are filled in the first time they're used, and since they always
+ * get the same values, racing threads are harmless.
+ */
+static float SDL_sRGBtoLinear_table[256];
+static SDL_bool SDL_sRGBtoLinear_table_ready;
+static float SDL_PQtoNits_table[1024];
+static SDL_bool SDL_PQtoNits_table_ready;
+
+/* Returns SDL_sRGBtoLinear(i / 255.0f) for each 8-bit value i */
+const float *SDL_GetsRGBtoLinearTable(void)
+{
+    if (!SDL_sRGBtoLinear_table_ready) {
+        int i;
+
+        for (i = 0; i < SDL_arraysize(SDL_sRGBtoLinear_table); ++i) {
+            SDL_sRGBtoLinear_table[i] = SDL_sRGBtoLinear((float)i / 255.0f);
+        }
+        SDL_MemoryBarrierRelease();
+        SDL_sRGBtoLinear_table_ready = SDL_TRUE;
+    } else {
+        SDL_MemoryBarrierAcquire();
+    }
+    return SDL_sRGBtoLinear_table;
+}
+
+/* Returns SDL_PQtoNits(i / 1023.0f) for each 10-bit value i */
+const float *SDL_GetPQtoNitsTable(void)
+{
+    if (!SDL_PQtoNits_table_ready) {
+        int i;
+
+        for (i = 0; i < SDL_arraysize(SDL_PQtoNits_table); ++i) {
+            SDL_PQtoNits_table[i] = SDL_PQtoNits((float)i / 1023.0f);
+        }
+        SDL_MemoryBarrierRelease();
+        SDL_PQtoNits_table_ready = SDL_TRUE;
+    } else {
+        SDL_MemoryBarrierAcquire();
+    }
+    return SDL_PQtoNits_table;
+}
+
+/* Linear values where each 8-bit sRGB value rounds up to the next one, and
+ * a coarse index into them so only a step or two of searching is needed.
+ */
+#define SDL_SRGB8_INDEX_SIZE 4096
+static float SDL_sRGB8_thresholds[255];
+static Uint8 SDL_sRGB8_index[SDL_SRGB8_INDEX_SIZE + 1];
+static SDL_bool SDL_sRGB8_tables_ready;
+
+/* Returns SDL_roundf(SDL_sRGBfromLinear(v) * 255.0f), clamped to 0-255, without calling pow() */
+Uint8 SDL_sRGB8fromLinear(float v)
+{
+    int i;
+
+    if (!SDL_sRGB8_tables_ready) {
+        int value = 0;
+
+        for (i = 0; i < SDL_arraysize(SDL_sRGB8_thresholds); ++i) {
+            SDL_sRGB8_thresholds[i] = SDL_sRGBtoLinear(((float)i + 0.5f) / 255.0f);
+        }
+        for (i = 0; i <= SDL_SRGB8_INDEX_SIZE; ++i) {
+            const float linear = (float)i / SDL_SRGB8_INDEX_SIZE;
+            while (value < 255 && linear >= SDL_sRGB8_thresholds[value]) {
+                ++value;
+            }
+            SDL_sRGB8_index[i] = (Uint8)value;
+        }
+        SDL_MemoryBarrierRelease();
+        SDL_sRGB8_tables_ready = SDL_TRUE;
+    } else {
+        SDL_MemoryBarrierAcquire();
+    }
+
+    if (!(v > 0.0f)) {
+        return 0;
+    }
+    if (v >= 1.0f) {
+        return 255;
+    }
+    i = SDL_sRGB8_index[(int)(v * SDL_SRGB8_INDEX_SIZE)];
+    while (i < 255 && v >= SDL_sRGB8_thresholds[i]) {
+        ++i;
+    }
+    return (Uint8)i;
+}
+
 /* This is a helpful tool for deriving these:
  * https://kdashg.github.io/misc/colors/from-coeffs.html
  */
@@ -1007,6 +1131,253 @@ void SDL_ConvertColorPrimaries(float *fR, float *fG, float *fB, const float *mat
     *fB = matrix[2 * 3 + 0] * v[0] + matrix[2 * 3 + 1] * v[1] + matrix[2 * 3 + 2] * v[2];
 }
 
+/*
+ * Palettes created with SDL_CreatePalette() get a lookup table for SDL_FindColor()
+ *
+ * The RGB cube is split into cells, and for each cell we keep the list of
+ * palette entries that could be the nearest match for any color in it. The
+ * nearest entry has a distance to the cell no greater than the smallest
+ * distance to the far corner of the cell of any entry, so searching that
+ * list gives exactly the same result as searching the whole palette.
+ *
+ * The cell lists are built the first time they're needed, and thrown away
+ * when the palette version changes.
+ */
+#define PALETTE_CACHE_MIN_COLORS 16
+#define PALETTE_CACHE_BITS       5
+#define PALETTE_CACHE_SIZE       (1 << PALETTE_CACHE_BITS)
+#define PALETTE_CACHE_SHIFT      (8 - PALETTE_CACHE_BITS)
+#define PALETTE_CACHE_CELL_WIDTH (1 << PALETTE_CACHE_SHIFT)
+
+typedef struct SDL_PaletteCache
+{
+    Uint32 version;
+    int ncolors;
+    Uint32 *cells; /* 0 if the cell hasn't been built yet, otherwise (offset << 9) | count */
+    Uint8 *candidates;
+    Uint32 num_candidates;
+    Uint32 max_candidates;
+} SDL_PaletteCache;
+
+static SDL_HashTable *SDL_palette_caches;
+static SDL_Mutex *SDL_palette_caches_lock;
+
+static Uint32 SDL_HashPalette(const void *key, void *unused)
+{
+    return (Uint32)((uintptr_t)key >> 4);
+}
+
+static SDL_bool SDL_KeyMatchPalette(const void *a, const void *b, void *unused)
+{
+    return (a == b);
+}
+
+static void SDL_NukePaletteCache(const void *key, const void *value, void *unused)
+{
+    SDL_PaletteCache *cache = (SDL_PaletteCache *)value;
+
+    SDL_free(cache->cells);
+    SDL_free(cache->candidates);
+    SDL_free(cache);
+}
+
+static void SDL_AddPaletteCache(SDL_Palette *palette)
+{
+    SDL_PaletteCache *cache;
+
+    if (palette->ncolors <= PALETTE_CACHE_MIN_COLORS || palette->ncolors > 256) {
+        /* A linear search is fast enough, or the palette is too big to index */
+        return;
+    }
+
+    if (!SDL_palette_caches_lock) {
+        SDL_palette_caches_lock = SDL_CreateMutex();
+    }
+
+    SDL_LockMutex(SDL_palette_caches_lock);
+
+    if (!SDL_palette_caches) {
+        SDL_palette_caches = SDL_CreateHashTable(NULL, 16, SDL_HashPalette, SDL_KeyMatchPalette, SDL_NukePaletteCache, SDL_FALSE);
+    }
+
+    /* This is optional, if anything fails the palette is searched linearly */
+    cache = (SDL_PaletteCache *)SDL_calloc(1, sizeof(*cache));
+    if (cache && !SDL_InsertIntoHashTable(SDL_palette_caches, palette, cache)) {
+        SDL_free(cache);
+    }
+
+    SDL_UnlockMutex(SDL_palette_caches_lock);
+}
+
+static void SDL_RemovePaletteCache(SDL_Palette *palette)
+{
+    if (!SDL_palette_caches) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_palette_caches_lock);
+    SDL_RemoveFromHashTable(SDL_palette_caches, palette);
+    SDL_UnlockMutex(SDL_palette_caches_lock);
+}
+
+void SDL_QuitPaletteCaches(void)
+{
+    if (SDL_palette_caches) {
+        SDL_DestroyHashTable(SDL_palette_caches);
+        SDL_palette_caches = NULL;
+    }
+    if (SDL_palette_caches_lock) {
+        SDL_DestroyMutex(SDL_palette_caches_lock);
+        SDL_palette_caches_lock = NULL;
+    }
+}
+
+/* Returns the cell encoding for the list of candidates, or 0 on failure */
+static Uint32 SDL_BuildPaletteCacheCell(const SDL_Palette *pal, SDL_PaletteCache *cache, int cell)
+{
+    const int rmin = ((cell >> (2 * PALETTE_CACHE_BITS)) & (PALETTE_CACHE_SIZE - 1)) << PALETTE_CACHE_SHIFT;
+    const int gmin = ((cell >> PALETTE_CACHE_BITS) & (PALETTE_CACHE_SIZE - 1)) << PALETTE_CACHE_SHIFT;
+    const int bmin = (cell & (PALETTE_CACHE_SIZE - 1)) << PALETTE_CACHE_SHIFT;
+    const int mins[3] = { rmin, gmin, bmin };
+    unsigned int mindist[256];
+    unsigned int minmaxdist = ~0U;
+    Uint32 offset, count;
+    int i, c;
+
+    for (i = 0; i < pal->ncolors; ++i) {
+        const SDL_Color *color = &pal->colors[i];
+        const int values[3] = { color->r, color->g, color->b };
+        const int ad = color->a - SDL_ALPHA_OPAQUE;
+        unsigned int dmin = ad * ad;
+        unsigned int dmax = dmin;
+
+        for (c = 0; c < 3; ++c) {
+            const int lo = mins[c];
+            const int hi = mins[c] + PALETTE_CACHE_CELL_WIDTH - 1;
+            const int v = values[c];
+            int near_d, far_d;
+
+            if (v < lo) {
+                near_d = lo - v;
+                far_d = hi - v;
+            } else if (v > hi) {
+                near_d = v - hi;
+                far_d = v - lo;
+            } else {
+                near_d = 0;
+                far_d = SDL_max(v - lo, hi - v);
+            }
+            dmin += near_d * near_d;
+            dmax += far_d * far_d;
+        }
+        mindist[i] = dmin;
+        if (dmax < minmaxdist) {
+            minmaxdist = dmax;
+        }
+    }
+
+    count = 0;
+    for (i = 0; i < pal->ncolors; ++i) {
+        if (mindist[i] <= minmaxdist) {
+            ++count;
+        }
+    }
+
+    if (cache->num_candidates + count > cache->max_candidates) {
+        Uint32 max_candidates = SDL_max(cache->max_candidates * 2, cache->num_candidates + count);
+        Uint8 *candidates = (Uint8 *)SDL_realloc(cache->candidates, max_candidates);
+        if (!candidates) {
+            return 0;
+        }
+        cache->candidates = candidates;
+        cache->max_candidates = max_candidates;
+    }
+
+    offset = cache->num_candidates;
+    for (i = 0; i < pal->ncolors; ++i) {
+        if (mindist[i] <= minmaxdist) {
+            cache->candidates[cache->num_candidates++] = (Uint8)i;
+        }
+    }
+    return (offset << 9) | count;
+}
+
+/* Returns the nearest opaque color, or -1 if the palette doesn't have a lookup table */
+static int SDL_FindColorCached(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b)
+{
+    SDL_PaletteCache *cache;
+    int cell;
+    Uint32 entry;
+    int pixel = -1;
+
+    if (!SDL_palette_caches) {
+        return -1;
+    }
+
+    SDL_LockMutex(SDL_palette_caches_lock);
+
+    if (!SDL_FindInHashTable(SDL_palette_caches, pal, (const void **)&cache)) {
+        goto done;
+    }
+
+    if (!cache->cells) {
+        cache->cells = (Uint32 *)SDL_calloc(PALETTE_CACHE_SIZE * PALETTE_CACHE_SIZE * PALETTE_CACHE_SIZE, sizeof(*cache->cells));
+        if (!cache->cells) {
+            goto done;
+        }
+        cache->version = pal->version;
+        cache->ncolors = pal->ncolors;
+    } else if (cache->version != pal->version || cache->ncolors != pal->ncolors) {
+        SDL_memset(cache->cells, 0, PALETTE_CACHE_SIZE * PALETTE_CACHE_SIZE * PALETTE_CACHE_SIZE * sizeof(*cache->cells));
+        cache->num_candidates = 0;
+        cache->version = pal->version;
+        cache->ncolors = pal->ncolors;
+    }
+
+    cell = ((r >> PALETTE_CACHE_SHIFT) << (2 * PALETTE_CACHE_BITS)) |
+           ((g >> PALETTE_CACHE_SHIFT) << PALETTE_CACHE_BITS) |
+           (b >> PALETTE_CACHE_SHIFT);
+    entry = cache->cells[cell];
+    if (!entry) {
+        entry = SDL_BuildPaletteCacheCell(pal, cache, cell);
+        if (!entry) {
+            goto done;
+        }
+        cache->cells[cell] = entry;
+    }
+
+    {
+        /* The same search as SDL_FindColor(), over the candidates in palette order */
+        const Uint8 *candidates = &cache->candidates[entry >> 9];
+        Uint32 count = (entry & 0x1FF);
+        unsigned int smallest = ~0U;
+        unsigned int distance;
+        int rd, gd, bd, ad;
+        Uint32 i;
+
+        for (i = 0; i < count; ++i) {
+            const SDL_Color *color = &pal->colors[candidates[i]];
+            rd = color->r - r;
+            gd = color->g - g;
+            bd = color->b - b;
+            ad = color->a - SDL_ALPHA_OPAQUE;
+            distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+            if (distance < smallest) {
+                pixel = candidates[i];
+                if (distance == 0) { /* Perfect match! */
+                    break;
+                }
+                smallest = distance;
+            }
+        }
+    }
+
+done:
+    SDL_UnlockMutex(SDL_palette_caches_lock);
+
+    return pixel;
+}
+
 SDL_Palette *SDL_CreatePalette(int ncolors)
 {
     SDL_Palette *palette;
@@ -1032,6 +1403,8 @@ SDL_Palette *SDL_CreatePalette(int ncolors)
 
     SDL_memset(palette->colors, 0xFF, ncolors * sizeof(*palette->colors));
 
+    SDL_AddPaletteCache(palette);
+
     return palette;
 }
 
@@ -1069,6 +1442,7 @@ void SDL_DestroyPalette(SDL_Palette *palette)
     if (--palette->refcount > 0) {
         return;
     }
+    SDL_RemovePaletteCache(palette);
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -1113,6 +1487,13 @@ Uint8 SDL_FindColor(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     int i;
     Uint8 pixel = 0;
 
+    if (a == SDL_ALPHA_OPAQUE) {
+        int cached = SDL_FindColorCached(pal, r, g, b);
+        if (cached >= 0) {
+            return (Uint8)cached;
+        }
+    }
+
     smallest = ~0U;
     for (i = 0; i < pal->ncolors; ++i) {
         rd = pal->colors[i].r - r;
@@ -1341,6 +1722,255 @@ void SDL_GetRGBA(Uint32 pixel, const SDL_PixelFormatDetails *format, const SDL_P
     }
 }
 
+/* 8888 formats are a byte shuffle between SDL_Color and the pixel bytes.
+ * Builds the source byte for each byte of the output, or -1 if it should
+ * be filled in with fill.
+ */
+static SDL_bool SDL_GetPixelShuffle8888(const SDL_PixelFormatDetails *format, SDL_bool to_pixels, int shuffle[4])
+{
+    int i;
+
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN ||
+        format->bytes_per_pixel != 4 ||
+        SDL_ISPIXELFORMAT_INDEXED(format->format) ||
+        SDL_ISPIXELFORMAT_10BIT(format->format) ||
+        format->Rbits != 8 || format->Gbits != 8 || format->Bbits != 8 ||
+        (format->Abits != 0 && format->Abits != 8) ||
+        (format->Rshift % 8) != 0 || (format->Gshift % 8) != 0 ||
+        (format->Bshift % 8) != 0 || (format->Ashift % 8) != 0) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < 4; ++i) {
+        shuffle[i] = -1;
+    }
+    if (to_pixels) {
+        shuffle[format->Rshift / 8] = 0;
+        shuffle[format->Gshift / 8] = 1;
+        shuffle[format->Bshift / 8] = 2;
+        if (format->Amask) {
+            shuffle[format->Ashift / 8] = 3;
+        }
+    } else {
+        shuffle[0] = format->Rshift / 8;
+        shuffle[1] = format->Gshift / 8;
+        shuffle[2] = format->Bshift / 8;
+        if (format->Amask) {
+            shuffle[3] = format->Ashift / 8;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static void SDL_Shuffle8888_Scalar(const Uint8 *src, Uint8 *dst, int count, const int shuffle[4], Uint8 fill)
+{
+    int i, j;
+
+    for (i = 0; i < count; ++i) {
+        for (j = 0; j < 4; ++j) {
+            dst[j] = (shuffle[j] < 0) ? fill : src[shuffle[j]];
+        }
+        src += 4;
+        dst += 4;
+    }
+}
+
+// FIXME: SDL doesn't have SSSE3 detection, so use the next one up
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("ssse3") SDL_Shuffle8888_SSSE3(const Uint8 *src, Uint8 *dst, int count, const int shuffle[4], Uint8 fill)
+{
+    Uint8 control[16];
+    Uint8 fills[16];
+    __m128i mask, fill_mask;
+    int i, j;
+
+    for (i = 0; i < 16; ++i) {
+        j = shuffle[i % 4];
+        control[i] = (j < 0) ? 0x80 : (Uint8)((i & ~3) + j);
+        fills[i] = (j < 0) ? fill : 0;
+    }
+    mask = _mm_loadu_si128((const __m128i *)control);
+    fill_mask = _mm_loadu_si128((const __m128i *)fills);
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        v = _mm_or_si128(_mm_shuffle_epi8(v, mask), fill_mask);
+        _mm_storeu_si128((__m128i *)dst, v);
+        src += 16;
+        dst += 16;
+    }
+    SDL_Shuffle8888_Scalar(src, dst, count - i, shuffle, fill);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_Shuffle8888_NEON(const Uint8 *src, Uint8 *dst, int count, const int shuffle[4], Uint8 fill)
+{
+    int i, j;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        const uint8x16x4_t in = vld4q_u8(src);
+        uint8x16x4_t out;
+
+        for (j = 0; j < 4; ++j) {
+            out.val[j] = (shuffle[j] < 0) ? vdupq_n_u8(fill) : in.val[shuffle[j]];
+        }
+        vst4q_u8(dst, out);
+        src += 64;
+        dst += 64;
+    }
+    SDL_Shuffle8888_Scalar(src, dst, count - i, shuffle, fill);
+}
+#endif
+
+static void SDL_Shuffle8888(const Uint8 *src, Uint8 *dst, int count, const int shuffle[4], Uint8 fill)
+{
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        SDL_Shuffle8888_SSSE3(src, dst, count, shuffle, fill);
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SDL_Shuffle8888_NEON(src, dst, count, shuffle, fill);
+        return;
+    }
+#endif
+    SDL_Shuffle8888_Scalar(src, dst, count, shuffle, fill);
+}
+
+/* Pixels are stored like SDL_WriteSurfacePixel() does, in the low bytes of the value */
+static void SDL_StorePixel(Uint8 *p, Uint32 pixel, int bytes_per_pixel)
+{
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    SDL_memcpy(p, ((Uint8 *)&pixel) + (sizeof(pixel) - bytes_per_pixel), bytes_per_pixel);
+#else
+    SDL_memcpy(p, &pixel, bytes_per_pixel);
+#endif
+}
+
+static Uint32 SDL_LoadPixel(const Uint8 *p, int bytes_per_pixel)
+{
+    Uint32 pixel = 0;
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    SDL_memcpy(((Uint8 *)&pixel) + (sizeof(pixel) - bytes_per_pixel), p, bytes_per_pixel);
+#else
+    SDL_memcpy(&pixel, p, bytes_per_pixel);
+#endif
+    return pixel;
+}
+
+int SDL_MapRGBAArray(const SDL_PixelFormatDetails *format, const SDL_Palette *palette, const SDL_Color *colors, void *pixels, int count)
+{
+    Uint8 *dst = (Uint8 *)pixels;
+    const int bpp = format ? format->bytes_per_pixel : 0;
+    int shuffle[4];
+    int i;
+
+    if (!format) {
+        return SDL_InvalidParamError("format");
+    } else if (!colors) {
+        return SDL_InvalidParamError("colors");
+    } else if (!pixels) {
+        return SDL_InvalidParamError("pixels");
+    } else if (count < 0) {
+        return SDL_InvalidParamError("count");
+    } else if (bpp > 4 || SDL_ISPIXELFORMAT_FOURCC(format->format)) {
+        return SDL_SetError("Unsupported pixel format");
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+        if (!palette) {
+            return SDL_InvalidParamError("palette");
+        }
+        for (i = 0; i < count; ++i) {
+            dst[i] = SDL_FindColor(palette, colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+        }
+    } else if (SDL_GetPixelShuffle8888(format, SDL_TRUE, shuffle)) {
+        SDL_Shuffle8888((const Uint8 *)colors, dst, count, shuffle, 0);
+    } else if (SDL_ISPIXELFORMAT_10BIT(format->format)) {
+        const Uint32 Aloss = 8 - format->Abits;
+        for (i = 0; i < count; ++i, dst += bpp) {
+            const SDL_Color *color = &colors[i];
+            SDL_StorePixel(dst, (((Uint32)SDL_expand_byte_10[color->r]) << format->Rshift) |
+                                (((Uint32)SDL_expand_byte_10[color->g]) << format->Gshift) |
+                                (((Uint32)SDL_expand_byte_10[color->b]) << format->Bshift) |
+                                ((((Uint32)(color->a >> Aloss)) << format->Ashift) & format->Amask), bpp);
+        }
+    } else {
+        const Uint32 Rloss = 8 - format->Rbits;
+        const Uint32 Gloss = 8 - format->Gbits;
+        const Uint32 Bloss = 8 - format->Bbits;
+        const Uint32 Aloss = 8 - format->Abits;
+        for (i = 0; i < count; ++i, dst += bpp) {
+            const SDL_Color *color = &colors[i];
+            SDL_StorePixel(dst, ((Uint32)(color->r >> Rloss)) << format->Rshift |
+                                ((Uint32)(color->g >> Gloss)) << format->Gshift |
+                                ((Uint32)(color->b >> Bloss)) << format->Bshift |
+                                ((((Uint32)(color->a >> Aloss)) << format->Ashift) & format->Amask), bpp);
+        }
+    }
+    return 0;
+}
+
+int SDL_GetRGBAArray(const void *pixels, const SDL_PixelFormatDetails *format, const SDL_Palette *palette, SDL_Color *colors, int count)
+{
+    const Uint8 *src = (const Uint8 *)pixels;
+    const int bpp = format ? format->bytes_per_pixel : 0;
+    int shuffle[4];
+    int i;
+
+    if (!pixels) {
+        return SDL_InvalidParamError("pixels");
+    } else if (!format) {
+        return SDL_InvalidParamError("format");
+    } else if (!colors) {
+        return SDL_InvalidParamError("colors");
+    } else if (count < 0) {
+        return SDL_InvalidParamError("count");
+    } else if (bpp > 4 || SDL_ISPIXELFORMAT_FOURCC(format->format)) {
+        return SDL_SetError("Unsupported pixel format");
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+        for (i = 0; i < count; ++i) {
+            if (palette && src[i] < palette->ncolors) {
+                colors[i] = palette->colors[src[i]];
+            } else {
+                SDL_zero(colors[i]);
+            }
+        }
+    } else if (SDL_GetPixelShuffle8888(format, SDL_FALSE, shuffle)) {
+        SDL_Shuffle8888(src, (Uint8 *)colors, count, shuffle, SDL_ALPHA_OPAQUE);
+    } else if (SDL_ISPIXELFORMAT_10BIT(format->format)) {
+        const Uint8 *Aexpand = SDL_expand_byte[format->Abits];
+        for (i = 0; i < count; ++i, src += bpp) {
+            const Uint32 pixel = SDL_LoadPixel(src, bpp);
+            SDL_Color *color = &colors[i];
+            color->r = (Uint8)(((pixel & format->Rmask) >> format->Rshift) >> 2);
+            color->g = (Uint8)(((pixel & format->Gmask) >> format->Gshift) >> 2);
+            color->b = (Uint8)(((pixel & format->Bmask) >> format->Bshift) >> 2);
+            color->a = Aexpand[(pixel & format->Amask) >> format->Ashift];
+        }
+    } else {
+        const Uint8 *Rexpand = SDL_expand_byte[format->Rbits];
+        const Uint8 *Gexpand = SDL_expand_byte[format->Gbits];
+        const Uint8 *Bexpand = SDL_expand_byte[format->Bbits];
+        const Uint8 *Aexpand = SDL_expand_byte[format->Abits];
+        for (i = 0; i < count; ++i, src += bpp) {
+            const Uint32 pixel = SDL_LoadPixel(src, bpp);
+            SDL_Color *color = &colors[i];
+            color->r = Rexpand[(pixel & format->Rmask) >> format->Rshift];
+            color->g = Gexpand[(pixel & format->Gmask) >> format->Gshift];
+            color->b = Bexpand[(pixel & format->Bmask) >> format->Bshift];
+            color->a = Aexpand[(pixel & format->Amask) >> format->Ashift];
+        }
+    }
+    return 0;
+}
+
 /* Map from Palette to Palette */
 static Uint8 *Map1to1(const SDL_Palette *src, const SDL_Palette *dst, int *identical)
 {
@@ -1401,6 +2031,78 @@ static Uint8 *Map1toN(const SDL_Palette *pal, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod
     return map;
 }
 
+/* Converting many small paletted surfaces, like glyphs and icons, would
+ * rebuild the same table over and over, so the most recent ones are kept.
+ * They're matched on the palette colors rather than the palette itself,
+ * since palettes are sometimes modified in place without a version change.
+ */
+#define SDL_MAP1TON_CACHE_SIZE 8
+
+typedef struct SDL_Map1toNCacheEntry
+{
+    SDL_PixelFormat format;
+    Uint32 mod;
+    int ncolors;
+    Uint32 hash;
+    SDL_Color colors[256];
+    Uint8 map[256 * 4];
+} SDL_Map1toNCacheEntry;
+
+static SDL_Map1toNCacheEntry SDL_map1toN_cache[SDL_MAP1TON_CACHE_SIZE];
+static int SDL_map1toN_cache_next;
+static SDL_SpinLock SDL_map1toN_cache_lock;
+
+static Uint8 *Map1toNCached(const SDL_Palette *pal, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod, const SDL_PixelFormatDetails *dst)
+{
+    const Uint32 mod = ((Uint32)Rmod << 24) | ((Uint32)Gmod << 16) | ((Uint32)Bmod << 8) | Amod;
+    SDL_Map1toNCacheEntry *entry;
+    Uint32 hash = 2166136261u;
+    Uint8 *map;
+    size_t maplen;
+    int i;
+
+    if (!pal || pal->ncolors > 256) {
+        return Map1toN(pal, Rmod, Gmod, Bmod, Amod, dst);
+    }
+
+    for (i = 0; i < pal->ncolors; ++i) {
+        const SDL_Color *color = &pal->colors[i];
+        hash = (hash ^ (((Uint32)color->r << 24) | ((Uint32)color->g << 16) | ((Uint32)color->b << 8) | color->a)) * 16777619u;
+    }
+    maplen = 256 * (size_t)((SDL_BYTESPERPIXEL(dst->format) == 3) ? 4 : SDL_BYTESPERPIXEL(dst->format));
+
+    SDL_LockSpinlock(&SDL_map1toN_cache_lock);
+    for (i = 0; i < SDL_MAP1TON_CACHE_SIZE; ++i) {
+        entry = &SDL_map1toN_cache[i];
+        if (entry->hash == hash && entry->format == dst->format && entry->mod == mod &&
+            entry->ncolors == pal->ncolors &&
+            SDL_memcmp(entry->colors, pal->colors, pal->ncolors * sizeof(*pal->colors)) == 0) {
+            map = (Uint8 *)SDL_malloc(maplen);
+            if (map) {
+                SDL_memcpy(map, entry->map, maplen);
+            }
+            SDL_UnlockSpinlock(&SDL_map1toN_cache_lock);
+            return map;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_map1toN_cache_lock);
+
+    map = Map1toN(pal, Rmod, Gmod, Bmod, Amod, dst);
+    if (map) {
+        SDL_LockSpinlock(&SDL_map1toN_cache_lock);
+        entry = &SDL_map1toN_cache[SDL_map1toN_cache_next];
+        SDL_map1toN_cache_next = (SDL_map1toN_cache_next + 1) % SDL_MAP1TON_CACHE_SIZE;
+        entry->format = dst->format;
+        entry->mod = mod;
+        entry->ncolors = pal->ncolors;
+        entry->hash = hash;
+        SDL_memcpy(entry->colors, pal->colors, pal->ncolors * sizeof(*pal->colors));
+        SDL_memcpy(entry->map, map, maplen);
+        SDL_UnlockSpinlock(&SDL_map1toN_cache_lock);
+    }
+    return map;
+}
+
 /* Map from BitField to Dithered-Palette to Palette */
 static Uint8 *MapNto1(const SDL_PixelFormatDetails *src, const SDL_Palette *pal, int *identical)
 {
@@ -1495,7 +2197,7 @@ int SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
         } else {
             /* Palette --> BitField */
             map->info.table =
-                Map1toN(srcpal, src->internal->map.info.r, src->internal->map.info.g,
+                Map1toNCached(srcpal, src->internal->map.info.r, src->internal->map.info.g,
                         src->internal->map.info.b, src->internal->map.info.a, dstfmt);
             if (!map->info.table) {
                 return -1;
@@ -31,13 +31,18 @@
 /* Pixel format functions */
 extern int SDL_CalculateSurfaceSize(SDL_PixelFormat format, int width, int height, size_t *size, size_t *pitch, SDL_bool minimalPitch);
 extern SDL_Colorspace SDL_GetDefaultColorspaceForFormat(SDL_PixelFormat pixel_format);
+extern int SDL_GetCompressedFormatBlockSize(SDL_PixelFormat format, int *block_w, int *block_h);
 extern void SDL_QuitPixelFormatDetails(void);
+extern void SDL_QuitPaletteCaches(void);
 
 /* Colorspace conversion functions */
 extern float SDL_sRGBtoLinear(float v);
 extern float SDL_sRGBfromLinear(float v);
 extern float SDL_PQtoNits(float v);
 extern float SDL_PQfromNits(float v);
+extern const float *SDL_GetsRGBtoLinearTable(void);
+extern const float *SDL_GetPQtoNitsTable(void);
+extern Uint8 SDL_sRGB8fromLinear(float v);
 extern const float *SDL_GetYCbCRtoRGBConversionMatrix(SDL_Colorspace colorspace, int w, int h, int bits_per_pixel);
 extern const float *SDL_GetColorPrimariesConversionMatrix(SDL_ColorPrimaries src, SDL_ColorPrimaries dst);
 extern void SDL_ConvertColorPrimaries(float *fR, float *fG, float *fB, const float *matrix);
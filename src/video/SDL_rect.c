@@ -84,6 +84,88 @@ SDL_bool SDL_GetSpanEnclosingRect(int width, int height,
 #define CODE_LEFT   4
 #define CODE_RIGHT  8
 
+/* Batched intersection with one clip rect, one rect per vector as x, y, w, h.
+   These follow the scalar code in SDL_rect_impl.h exactly, including which
+   rects are rejected as possibly overflowing. */
+#ifdef SDL_SSE4_1_INTRINSICS
+static int SDL_TARGETING("sse4.1") SDL_GetRectIntersectionsSSE41(const SDL_Rect *rects, int count, const SDL_Rect *clip, SDL_Rect *results, SDL_bool *visible)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo_mask = _mm_set_epi32(0, 0, -1, -1);
+    const __m128i hi_mask = _mm_set_epi32(-1, -1, 0, 0);
+    const __m128i lo_limit = _mm_set_epi32(0, 0, SDL_MIN_SINT32 / 2, SDL_MIN_SINT32 / 2);
+    const __m128i hi_limit = _mm_set1_epi32(SDL_MAX_SINT32 / 2);
+    const __m128i c = _mm_set_epi32(clip->y + clip->h, clip->x + clip->w, clip->y, clip->x);
+    int i, numvisible = 0;
+
+    for (i = 0; i < count; ++i) {
+        const __m128i r = _mm_loadu_si128((const __m128i *)&rects[i]);
+        /* x, y, x + w, y + h */
+        const __m128i r2 = _mm_add_epi32(r, _mm_and_si128(_mm_shuffle_epi32(r, _MM_SHUFFLE(1, 0, 1, 0)), hi_mask));
+        /* max of the mins, min of the maxes */
+        const __m128i t = _mm_blend_epi16(_mm_max_epi32(r2, c), _mm_min_epi32(r2, c), 0xF0);
+        __m128i result = _mm_sub_epi32(t, _mm_and_si128(_mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 1, 0)), hi_mask));
+        /* x and y in range, input and result w and h in range and positive */
+        const __m128i ok = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(r, lo_limit), _mm_cmplt_epi32(r, hi_limit)),
+                                         _mm_or_si128(_mm_cmpgt_epi32(result, zero), lo_mask));
+        const SDL_bool isvisible = (_mm_movemask_ps(_mm_castsi128_ps(ok)) == 0xF);
+
+        if (isvisible) {
+            ++numvisible;
+        } else {
+            result = _mm_unpacklo_epi64(r, zero);
+        }
+        if (results) {
+            _mm_storeu_si128((__m128i *)&results[i], result);
+        }
+        if (visible) {
+            visible[i] = isvisible;
+        }
+    }
+    return numvisible;
+}
+#define SDL_INTERSECTRECTS_SSE     SDL_GetRectIntersectionsSSE41
+#define SDL_INTERSECTRECTS_HAS_SSE SDL_HasSSE41
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_GetRectIntersectionsNEON(const SDL_Rect *rects, int count, const SDL_Rect *clip, SDL_Rect *results, SDL_bool *visible)
+{
+    const int32x2_t zero = vdup_n_s32(0);
+    const int32_t lo_limit_values[4] = { SDL_MIN_SINT32 / 2, SDL_MIN_SINT32 / 2, 0, 0 };
+    const int32_t clip_values[4] = { clip->x, clip->y, clip->x + clip->w, clip->y + clip->h };
+    const int32x4_t lo_limit = vld1q_s32(lo_limit_values);
+    const int32x4_t hi_limit = vdupq_n_s32(SDL_MAX_SINT32 / 2);
+    const int32x4_t c = vld1q_s32(clip_values);
+    int i, numvisible = 0;
+
+    for (i = 0; i < count; ++i) {
+        const int32x4_t r = vld1q_s32((const int32_t *)&rects[i]);
+        const int32x4_t r2 = vaddq_s32(r, vcombine_s32(zero, vget_low_s32(r)));
+        const int32x4_t t = vcombine_s32(vget_low_s32(vmaxq_s32(r2, c)), vget_high_s32(vminq_s32(r2, c)));
+        int32x4_t result = vsubq_s32(t, vcombine_s32(zero, vget_low_s32(t)));
+        const uint32x4_t ok = vandq_u32(vandq_u32(vcgtq_s32(r, lo_limit), vcltq_s32(r, hi_limit)),
+                                        vcombine_u32(vdup_n_u32(~0u), vcgt_s32(vget_high_s32(result), zero)));
+        const uint32x2_t ok2 = vand_u32(vget_low_u32(ok), vget_high_u32(ok));
+        const SDL_bool isvisible = ((vget_lane_u32(ok2, 0) & vget_lane_u32(ok2, 1)) != 0);
+
+        if (isvisible) {
+            ++numvisible;
+        } else {
+            result = vcombine_s32(vget_low_s32(r), zero);
+        }
+        if (results) {
+            vst1q_s32((int32_t *)&results[i], result);
+        }
+        if (visible) {
+            visible[i] = isvisible;
+        }
+    }
+    return numvisible;
+}
+#define SDL_INTERSECTRECTS_NEON SDL_GetRectIntersectionsNEON
+#endif
+
 /* Same code twice, for float and int versions... */
 #define RECTTYPE                 SDL_Rect
 #define POINTTYPE                SDL_Point
@@ -98,8 +180,87 @@ SDL_bool SDL_GetSpanEnclosingRect(int width, int height,
 #define SDL_UNIONRECT            SDL_GetRectUnion
 #define SDL_ENCLOSEPOINTS        SDL_GetRectEnclosingPoints
 #define SDL_INTERSECTRECTANDLINE SDL_GetRectAndLineIntersection
+#define SDL_INTERSECTRECTS       SDL_GetRectIntersections
+#define SDL_INTERSECTRECTS_SCALAR SDL_GetRectIntersectionsScalar
 #include "SDL_rect_impl.h"
 
+#ifdef SDL_SSE_INTRINSICS
+static int SDL_TARGETING("sse") SDL_GetRectIntersectionsFloatSSE(const SDL_FRect *rects, int count, const SDL_FRect *clip, SDL_FRect *results, SDL_bool *visible)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 lo_limit = _mm_set1_ps((float)(SDL_MIN_SINT32 / 2));
+    const __m128 hi_limit = _mm_set1_ps((float)(SDL_MAX_SINT32 / 2));
+    const __m128 c = _mm_set_ps(clip->y + clip->h, clip->x + clip->w, clip->y, clip->x);
+    int i, numvisible = 0;
+
+    for (i = 0; i < count; ++i) {
+        const __m128 r = _mm_loadu_ps(&rects[i].x);
+        /* x, y, x + w, y + h */
+        const __m128 r2 = _mm_add_ps(r, _mm_movelh_ps(zero, r));
+        /* max of the mins, min of the maxes, with the same operand order as the scalar code */
+        const __m128 t = _mm_shuffle_ps(_mm_max_ps(c, r2), _mm_min_ps(c, r2), _MM_SHUFFLE(3, 2, 1, 0));
+        __m128 result = _mm_sub_ps(t, _mm_movelh_ps(zero, t));
+        /* The scalar code only rejects x and y outside the limits, and w and h above the limit or negative */
+        const __m128 bad = _mm_or_ps(_mm_or_ps(_mm_shuffle_ps(_mm_cmple_ps(r, lo_limit), _mm_cmplt_ps(r, zero), _MM_SHUFFLE(3, 2, 1, 0)), _mm_cmpge_ps(r, hi_limit)),
+                                     _mm_shuffle_ps(zero, _mm_cmplt_ps(result, zero), _MM_SHUFFLE(3, 2, 1, 0)));
+        const SDL_bool isvisible = (_mm_movemask_ps(bad) == 0);
+
+        if (isvisible) {
+            ++numvisible;
+        } else {
+            result = _mm_movelh_ps(r, zero);
+        }
+        if (results) {
+            _mm_storeu_ps(&results[i].x, result);
+        }
+        if (visible) {
+            visible[i] = isvisible;
+        }
+    }
+    return numvisible;
+}
+#define SDL_INTERSECTRECTS_SSE     SDL_GetRectIntersectionsFloatSSE
+#define SDL_INTERSECTRECTS_HAS_SSE SDL_HasSSE
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_GetRectIntersectionsFloatNEON(const SDL_FRect *rects, int count, const SDL_FRect *clip, SDL_FRect *results, SDL_bool *visible)
+{
+    const float32x2_t zero = vdup_n_f32(0.0f);
+    const float32x4_t lo_limit = vdupq_n_f32((float)(SDL_MIN_SINT32 / 2));
+    const float32x4_t hi_limit = vdupq_n_f32((float)(SDL_MAX_SINT32 / 2));
+    const float clip_values[4] = { clip->x, clip->y, clip->x + clip->w, clip->y + clip->h };
+    const float32x4_t c = vld1q_f32(clip_values);
+    int i, numvisible = 0;
+
+    for (i = 0; i < count; ++i) {
+        const float32x4_t r = vld1q_f32(&rects[i].x);
+        const float32x4_t r2 = vaddq_f32(r, vcombine_f32(zero, vget_low_f32(r)));
+        const float32x4_t t = vcombine_f32(vget_low_f32(vmaxq_f32(r2, c)), vget_high_f32(vminq_f32(r2, c)));
+        float32x4_t result = vsubq_f32(t, vcombine_f32(zero, vget_low_f32(t)));
+        const uint32x4_t bad = vorrq_u32(vorrq_u32(vcombine_u32(vget_low_u32(vcleq_f32(r, lo_limit)), vclt_f32(vget_high_f32(r), zero)),
+                                                   vcgeq_f32(r, hi_limit)),
+                                         vcombine_u32(vdup_n_u32(0), vclt_f32(vget_high_f32(result), zero)));
+        const uint32x2_t bad2 = vorr_u32(vget_low_u32(bad), vget_high_u32(bad));
+        const SDL_bool isvisible = ((vget_lane_u32(bad2, 0) | vget_lane_u32(bad2, 1)) == 0);
+
+        if (isvisible) {
+            ++numvisible;
+        } else {
+            result = vcombine_f32(vget_low_f32(r), zero);
+        }
+        if (results) {
+            vst1q_f32(&results[i].x, result);
+        }
+        if (visible) {
+            visible[i] = isvisible;
+        }
+    }
+    return numvisible;
+}
+#define SDL_INTERSECTRECTS_NEON SDL_GetRectIntersectionsFloatNEON
+#endif
+
 #define RECTTYPE                 SDL_FRect
 #define POINTTYPE                SDL_FPoint
 #define SCALARTYPE               float
@@ -113,4 +274,6 @@ SDL_bool SDL_GetSpanEnclosingRect(int width, int height,
 #define SDL_UNIONRECT            SDL_GetRectUnionFloat
 #define SDL_ENCLOSEPOINTS        SDL_GetRectEnclosingPointsFloat
 #define SDL_INTERSECTRECTANDLINE SDL_GetRectAndLineIntersectionFloat
+#define SDL_INTERSECTRECTS       SDL_GetRectIntersectionsFloat
+#define SDL_INTERSECTRECTS_SCALAR SDL_GetRectIntersectionsFloatScalar
 #include "SDL_rect_impl.h"
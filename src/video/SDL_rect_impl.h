@@ -137,6 +137,94 @@ SDL_bool SDL_INTERSECTRECT(const RECTTYPE *A, const RECTTYPE *B, RECTTYPE *resul
     return !SDL_RECTEMPTY(result);
 }
 
+static int SDL_INTERSECTRECTS_SCALAR(const RECTTYPE *rects, int count, const RECTTYPE *clip, RECTTYPE *results, SDL_bool *visible)
+{
+    const SCALARTYPE clipmaxx = clip->x + clip->w;
+    const SCALARTYPE clipmaxy = clip->y + clip->h;
+    int i, numvisible = 0;
+
+    for (i = 0; i < count; ++i) {
+        const RECTTYPE *rect = &rects[i];
+        SCALARTYPE Amin, Amax;
+        RECTTYPE result;
+        SDL_bool isvisible;
+
+        if (SDL_RECT_CAN_OVERFLOW(rect) || SDL_RECTEMPTY(rect)) {
+            result.x = rect->x;
+            result.y = rect->y;
+            result.w = 0;
+            result.h = 0;
+            isvisible = SDL_FALSE;
+        } else {
+            Amin = rect->x;
+            Amax = Amin + rect->w;
+            if (clip->x > Amin) {
+                Amin = clip->x;
+            }
+            if (clipmaxx < Amax) {
+                Amax = clipmaxx;
+            }
+            result.x = Amin;
+            result.w = Amax - Amin;
+
+            Amin = rect->y;
+            Amax = Amin + rect->h;
+            if (clip->y > Amin) {
+                Amin = clip->y;
+            }
+            if (clipmaxy < Amax) {
+                Amax = clipmaxy;
+            }
+            result.y = Amin;
+            result.h = Amax - Amin;
+
+            isvisible = !SDL_RECTEMPTY(&result);
+            if (!isvisible) {
+                result.x = rect->x;
+                result.y = rect->y;
+                result.w = 0;
+                result.h = 0;
+            }
+        }
+
+        if (results) {
+            results[i] = result;
+        }
+        if (visible) {
+            visible[i] = isvisible;
+        }
+        if (isvisible) {
+            ++numvisible;
+        }
+    }
+    return numvisible;
+}
+
+int SDL_INTERSECTRECTS(const RECTTYPE *rects, int count, const RECTTYPE *clip, RECTTYPE *results, SDL_bool *visible)
+{
+    if (!rects) {
+        return SDL_InvalidParamError("rects");
+    } else if (count < 0) {
+        return SDL_InvalidParamError("count");
+    } else if (!clip) {
+        return SDL_InvalidParamError("clip");
+    } else if (SDL_RECT_CAN_OVERFLOW(clip)) {
+        return SDL_SetError("Potential rect math overflow");
+    }
+
+#ifdef SDL_INTERSECTRECTS_SSE
+    if (SDL_INTERSECTRECTS_HAS_SSE()) {
+        return SDL_INTERSECTRECTS_SSE(rects, count, clip, results, visible);
+    }
+#endif
+#ifdef SDL_INTERSECTRECTS_NEON
+    if (SDL_HasNEON()) {
+        return SDL_INTERSECTRECTS_NEON(rects, count, clip, results, visible);
+    }
+#endif
+    return SDL_INTERSECTRECTS_SCALAR(rects, count, clip, results, visible);
+}
+
 int SDL_UNIONRECT(const RECTTYPE *A, const RECTTYPE *B, RECTTYPE *result)
 {
     SCALARTYPE Amin, Amax, Bmin, Bmax;
@@ -465,3 +553,8 @@ SDL_bool SDL_INTERSECTRECTANDLINE(const RECTTYPE *rect, SCALARTYPE *X1, SCALARTY
 #undef SDL_UNIONRECT
 #undef SDL_ENCLOSEPOINTS
 #undef SDL_INTERSECTRECTANDLINE
+#undef SDL_INTERSECTRECTS
+#undef SDL_INTERSECTRECTS_SCALAR
+#undef SDL_INTERSECTRECTS_SSE
+#undef SDL_INTERSECTRECTS_HAS_SSE
+#undef SDL_INTERSECTRECTS_NEON
@@ -24,6 +24,28 @@
 
 static int SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static int SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static int SDL_LowerSoftStretchArea(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+
+/* Scales the destination rows [dst_y0, dst_y1) of a stretch */
+typedef int (*SDL_StretchFunc)(const Uint32 *src, int src_w, int src_h, int src_pitch,
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1);
+
+typedef struct
+{
+    SDL_StretchFunc func;
+    const Uint32 *src;
+    int src_w, src_h, src_pitch;
+    Uint32 *dst;
+    int dst_w, dst_h, dst_pitch;
+} SDL_StretchBands;
+
+static void SDL_StretchBand(void *userdata, int y0, int y1)
+{
+    const SDL_StretchBands *bands = (const SDL_StretchBands *)userdata;
+
+    bands->func(bands->src, bands->src_w, bands->src_h, bands->src_pitch,
+                bands->dst, bands->dst_w, bands->dst_h, bands->dst_pitch, y0, y1);
+}
 
 int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
                     SDL_Surface *dst, const SDL_Rect *dstrect,
@@ -87,10 +109,6 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
     }
 
     if (scaleMode != SDL_SCALEMODE_NEAREST) {
-        scaleMode = SDL_SCALEMODE_LINEAR;
-    }
-
-    if (scaleMode == SDL_SCALEMODE_LINEAR) {
         if (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010) {
             return SDL_SetError("Wrong format");
         }
@@ -155,6 +173,9 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
 
     if (scaleMode == SDL_SCALEMODE_NEAREST) {
         ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
+    } else if (scaleMode == SDL_SCALEMODE_BEST &&
+               (dstrect->w < srcrect->w || dstrect->h < srcrect->h)) {
+        ret = SDL_LowerSoftStretchArea(src, srcrect, dst, dstrect);
     } else {
         ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
     }
@@ -198,7 +219,9 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
     left_pad_w_init = left_pad_w;                                                     \
     right_pad_w_init = right_pad_w;                                                   \
     dst_gap = dst_pitch - 4 * dst_w;                                                  \
-    middle_init = dst_w - left_pad_w - right_pad_w;
+    middle_init = dst_w - left_pad_w - right_pad_w;                                   \
+    fp_sum_h += (Sint64)dst_y0 * fp_step_h;                                           \
+    dst = (Uint32 *)((Uint8 *)dst + (size_t)dst_y0 * dst_pitch);
 
 #define BILINEAR___HEIGHT                                              \
     int index_h, frac_h0, frac_h1, middle;                             \
@@ -326,11 +349,11 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
 }
 
 static int scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch,
-                     Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                     Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
 
         BILINEAR___HEIGHT
 
@@ -401,12 +424,8 @@ static void SDL_TARGETING("sse2") printf_128(const char *str, __m128i var)
 
 static SDL_INLINE int hasSSE2(void)
 {
-    static int val = -1;
-    if (val != -1) {
-        return val;
-    }
-    val = SDL_HasSSE2();
-    return val;
+    /* The CPU features are cached, and this follows SDL_HINT_CPU_FEATURE_MASK across SDL_Init() */
+    return SDL_HasSSE2();
 }
 
 static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32 *s0, const Uint32 *s1, int frac_w, __m128i v_frac_h0, __m128i v_frac_h1, Uint32 *dst, __m128i zero)
@@ -446,11 +465,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -570,12 +589,7 @@ static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int
 
 static SDL_INLINE int hasNEON(void)
 {
-    static int val = -1;
-    if (val != -1) {
-        return val;
-    }
-    val = SDL_HasNEON();
-    return val;
+    return SDL_HasNEON();
 }
 
 static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1, int frac_w, uint8x8_t v_frac_h0, uint8x8_t v_frac_h1, Uint32 *dst)
@@ -610,11 +624,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -831,32 +845,311 @@ static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch
 int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
                                SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    int ret = -1;
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
-    int src_pitch = s->pitch;
-    int dst_pitch = d->pitch;
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
+    SDL_StretchBands bands;
+
+    bands.func = NULL;
+    bands.src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * s->pitch);
+    bands.src_w = srcrect->w;
+    bands.src_h = srcrect->h;
+    bands.src_pitch = s->pitch;
+    bands.dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * d->pitch);
+    bands.dst_w = dstrect->w;
+    bands.dst_h = dstrect->h;
+    bands.dst_pitch = d->pitch;
 
 #ifdef SDL_NEON_INTRINSICS
-    if (ret == -1 && hasNEON()) {
-        ret = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (!bands.func && hasNEON()) {
+        bands.func = scale_mat_NEON;
     }
 #endif
 
 #ifdef SDL_SSE2_INTRINSICS
-    if (ret == -1 && hasSSE2()) {
-        ret = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (!bands.func && hasSSE2()) {
+        bands.func = scale_mat_SSE;
     }
 #endif
 
-    if (ret == -1) {
-        ret = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (!bands.func) {
+        bands.func = scale_mat;
+    }
+
+    SDL_RunBlitBands(bands.dst_w, bands.dst_h, SDL_StretchBand, &bands);
+    return 0;
+}
+
+/* The filter weights for SDL_SCALEMODE_BEST are fixed point, summing to 1.0 */
+#define FILTER_BITS 14
+#define FILTER_ONE  (1 << FILTER_BITS)
+
+/* A separable filter, with the same number of taps for every destination pixel */
+typedef struct
+{
+    int taps;
+    int *first; /* the first source pixel for each destination pixel */
+    Sint16 *weights; /* taps weights for each destination pixel */
+} SDL_ScaleFilter;
+
+static void free_scale_filter(SDL_ScaleFilter *filter)
+{
+    SDL_free(filter->first);
+    filter->first = NULL;
+    SDL_free(filter->weights);
+    filter->weights = NULL;
+}
+
+/* Area averaging when reducing, and a tent filter matching bilinear scaling
+   when enlarging, with the weights for each destination pixel computed once */
+static int build_scale_filter(int src_nb, int dst_nb, SDL_ScaleFilter *filter)
+{
+    const double scale = (double)src_nb / dst_nb;
+    int i, k;
+
+    if (src_nb > dst_nb) {
+        filter->taps = (int)SDL_ceil(scale) + 1;
+    } else {
+        filter->taps = 2;
+    }
+    filter->taps = SDL_min(filter->taps, src_nb);
+    filter->first = (int *)SDL_malloc(dst_nb * sizeof(*filter->first));
+    filter->weights = (Sint16 *)SDL_calloc((size_t)dst_nb * filter->taps, sizeof(*filter->weights));
+    if (!filter->first || !filter->weights) {
+        free_scale_filter(filter);
+        return -1;
     }
 
+    for (i = 0; i < dst_nb; i++) {
+        double weights[2], *area = NULL;
+        int start, count, total, largest;
+        Sint16 *w = &filter->weights[i * filter->taps];
+
+        if (src_nb > dst_nb) {
+            const double x0 = i * scale;
+            const double x1 = x0 + scale;
+
+            start = (int)SDL_floor(x0);
+            count = SDL_min((int)SDL_ceil(x1), src_nb) - start;
+            area = (double *)SDL_stack_alloc(double, count);
+            if (!area) {
+                free_scale_filter(filter);
+                return -1;
+            }
+            for (k = 0; k < count; k++) {
+                const double lo = SDL_max(x0, (double)(start + k));
+                const double hi = SDL_min(x1, (double)(start + k + 1));
+                area[k] = (hi - lo) / scale;
+            }
+        } else {
+            const double center = (i + 0.5) * scale - 0.5;
+
+            start = (int)SDL_floor(center);
+            weights[1] = center - start;
+            weights[0] = 1.0 - weights[1];
+            count = 2;
+            if (start < 0) {
+                start = 0;
+                weights[0] = 1.0;
+                weights[1] = 0.0;
+            } else if (start >= src_nb - 1) {
+                start = src_nb - 1;
+                weights[0] = 1.0;
+                weights[1] = 0.0;
+            }
+            if (start + count > src_nb) {
+                count = src_nb - start;
+            }
+            area = weights;
+        }
+
+        /* Keep every tap inside the source */
+        filter->first[i] = SDL_min(start, src_nb - filter->taps);
+        w += start - filter->first[i];
+
+        total = 0;
+        largest = 0;
+        for (k = 0; k < count; k++) {
+            w[k] = (Sint16)SDL_lround(area[k] * FILTER_ONE);
+            total += w[k];
+            if (w[k] > w[largest]) {
+                largest = k;
+            }
+        }
+        /* Make sure that the weights sum to 1.0 exactly */
+        w[largest] += (Sint16)(FILTER_ONE - total);
+
+        if (area != weights) {
+            SDL_stack_free(area);
+        }
+    }
+    return 0;
+}
+
+static SDL_INLINE Uint32 filter_pixel(const Uint32 *src, int stride, const Sint16 *w, int taps)
+{
+    Uint32 sum[4] = { FILTER_ONE / 2, FILTER_ONE / 2, FILTER_ONE / 2, FILTER_ONE / 2 };
+    int k;
+
+    for (k = 0; k < taps; k++) {
+        const color_t *c = (const color_t *)(src + k * stride);
+        sum[0] += c->a * w[k];
+        sum[1] += c->b * w[k];
+        sum[2] += c->c * w[k];
+        sum[3] += c->d * w[k];
+    }
+    {
+        Uint32 result;
+        color_t *c = (color_t *)&result;
+        c->a = (Uint8)(sum[0] >> FILTER_BITS);
+        c->b = (Uint8)(sum[1] >> FILTER_BITS);
+        c->c = (Uint8)(sum[2] >> FILTER_BITS);
+        c->d = (Uint8)(sum[3] >> FILTER_BITS);
+        return result;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Filters one pixel from pairs of taps, which _mm_madd_epi16 multiplies and adds in one step */
+static SDL_INLINE Uint32 SDL_TARGETING("sse2") filter_pixel_SSE(const Uint32 *src, int stride, const Sint16 *w, int taps)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = _mm_set1_epi32(FILTER_ONE / 2);
+    int k;
+
+    for (k = 0; k + 1 < taps; k += 2) {
+        __m128i p0 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(src[k * stride]), zero);
+        __m128i p1 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(src[(k + 1) * stride]), zero);
+        __m128i weights = _mm_set1_epi32((int)(((Uint32)(Uint16)w[k + 1] << 16) | (Uint16)w[k]));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(p0, p1), weights));
+    }
+    if (k < taps) {
+        __m128i p0 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(src[k * stride]), zero);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(p0, zero), _mm_set1_epi32((Uint16)w[k])));
+    }
+    sum = _mm_srli_epi32(sum, FILTER_BITS);
+    sum = _mm_packs_epi32(sum, sum);
+    return (Uint32)_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+}
+
+/* Filters four neighboring pixels vertically at once */
+static SDL_INLINE void SDL_TARGETING("sse2") filter_column4_SSE(const Uint32 *src, int stride, const Sint16 *w, int taps, Uint32 *dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum0 = _mm_set1_epi32(FILTER_ONE / 2);
+    __m128i sum1 = sum0, sum2 = sum0, sum3 = sum0;
+    int k;
+
+    for (k = 0; k < taps; k += 2) {
+        const __m128i r0 = _mm_loadu_si128((const __m128i *)(src + k * stride));
+        const __m128i r1 = (k + 1 < taps) ? _mm_loadu_si128((const __m128i *)(src + (k + 1) * stride)) : zero;
+        const __m128i weights = _mm_set1_epi32((int)(((Uint32)(Uint16)((k + 1 < taps) ? w[k + 1] : 0) << 16) | (Uint16)w[k]));
+        const __m128i r0_lo = _mm_unpacklo_epi8(r0, zero);
+        const __m128i r0_hi = _mm_unpackhi_epi8(r0, zero);
+        const __m128i r1_lo = _mm_unpacklo_epi8(r1, zero);
+        const __m128i r1_hi = _mm_unpackhi_epi8(r1, zero);
+
+        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi16(r0_lo, r1_lo), weights));
+        sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi16(r0_lo, r1_lo), weights));
+        sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(_mm_unpacklo_epi16(r0_hi, r1_hi), weights));
+        sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(_mm_unpackhi_epi16(r0_hi, r1_hi), weights));
+    }
+    sum0 = _mm_packs_epi32(_mm_srli_epi32(sum0, FILTER_BITS), _mm_srli_epi32(sum1, FILTER_BITS));
+    sum2 = _mm_packs_epi32(_mm_srli_epi32(sum2, FILTER_BITS), _mm_srli_epi32(sum3, FILTER_BITS));
+    _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(sum0, sum2));
+}
+#endif
+
+typedef struct
+{
+    SDL_ScaleFilter filter_w;
+    SDL_ScaleFilter filter_h;
+    const Uint32 *src;
+    int src_pitch;
+    Uint32 *tmp; /* dst_w x src_h, the result of the horizontal pass */
+    Uint32 *dst;
+    int dst_w;
+    int dst_pitch;
+    SDL_bool use_sse2;
+} SDL_AreaScale;
+
+static void scale_area_horizontal(void *userdata, int y0, int y1)
+{
+    const SDL_AreaScale *scale = (const SDL_AreaScale *)userdata;
+    const SDL_ScaleFilter *filter = &scale->filter_w;
+    int x, y;
+
+    for (y = y0; y < y1; y++) {
+        const Uint32 *src = (const Uint32 *)((const Uint8 *)scale->src + (size_t)y * scale->src_pitch);
+        Uint32 *tmp = scale->tmp + (size_t)y * scale->dst_w;
+        const Sint16 *w = filter->weights;
+
+        for (x = 0; x < scale->dst_w; x++, w += filter->taps) {
+#ifdef SDL_SSE2_INTRINSICS
+            if (scale->use_sse2) {
+                tmp[x] = filter_pixel_SSE(src + filter->first[x], 1, w, filter->taps);
+                continue;
+            }
+#endif
+            tmp[x] = filter_pixel(src + filter->first[x], 1, w, filter->taps);
+        }
+    }
+}
+
+static void scale_area_vertical(void *userdata, int y0, int y1)
+{
+    const SDL_AreaScale *scale = (const SDL_AreaScale *)userdata;
+    const SDL_ScaleFilter *filter = &scale->filter_h;
+    int x, y;
+
+    for (y = y0; y < y1; y++) {
+        const Uint32 *tmp = scale->tmp + (size_t)filter->first[y] * scale->dst_w;
+        Uint32 *dst = (Uint32 *)((Uint8 *)scale->dst + (size_t)y * scale->dst_pitch);
+        const Sint16 *w = &filter->weights[y * filter->taps];
+
+        x = 0;
+#ifdef SDL_SSE2_INTRINSICS
+        if (scale->use_sse2) {
+            for (; x + 4 <= scale->dst_w; x += 4) {
+                filter_column4_SSE(tmp + x, scale->dst_w, w, filter->taps, dst + x);
+            }
+        }
+#endif
+        for (; x < scale->dst_w; x++) {
+            dst[x] = filter_pixel(tmp + x, scale->dst_w, w, filter->taps);
+        }
+    }
+}
+
+static int SDL_LowerSoftStretchArea(SDL_Surface *s, const SDL_Rect *srcrect,
+                                    SDL_Surface *d, const SDL_Rect *dstrect)
+{
+    SDL_AreaScale scale;
+    int ret = -1;
+
+    SDL_zero(scale);
+    if (build_scale_filter(srcrect->w, dstrect->w, &scale.filter_w) < 0 ||
+        build_scale_filter(srcrect->h, dstrect->h, &scale.filter_h) < 0) {
+        goto done;
+    }
+    scale.tmp = (Uint32 *)SDL_malloc((size_t)dstrect->w * srcrect->h * sizeof(Uint32));
+    if (!scale.tmp) {
+        goto done;
+    }
+    scale.src = (const Uint32 *)((const Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * s->pitch);
+    scale.src_pitch = s->pitch;
+    scale.dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * d->pitch);
+    scale.dst_w = dstrect->w;
+    scale.dst_pitch = d->pitch;
+#ifdef SDL_SSE2_INTRINSICS
+    scale.use_sse2 = hasSSE2() ? SDL_TRUE : SDL_FALSE;
+#endif
+
+    SDL_RunBlitBands(dstrect->w, srcrect->h, scale_area_horizontal, &scale);
+    SDL_RunBlitBands(dstrect->w, dstrect->h, scale_area_vertical, &scale);
+    ret = 0;
+
+done:
+    SDL_free(scale.tmp);
+    free_scale_filter(&scale.filter_w);
+    free_scale_filter(&scale.filter_h);
     return ret;
 }
 
@@ -870,7 +1163,8 @@ int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     incy = ((Uint64)src_h << 16) / dst_h; \
     incx = ((Uint64)src_w << 16) / dst_w; \
     dst_gap = dst_pitch - bpp * dst_w;    \
-    posy = incy / 2;
+    posy = incy / 2 + dst_y0 * incy;      \
+    dst = (Uint32 *)((Uint8 *)dst + (size_t)dst_y0 * dst_pitch);
 
 #define SDL_SCALE_NEAREST__HEIGHT                                         \
     srcy = (posy >> 16);                                                  \
@@ -880,11 +1174,11 @@ int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     n = dst_w;
 
 static int scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     Uint32 bpp = 1;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -900,11 +1194,11 @@ static int scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int
 }
 
 static int scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     Uint32 bpp = 2;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint16 *src;
@@ -920,11 +1214,11 @@ static int scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int
 }
 
 static int scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     Uint32 bpp = 3;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -942,11 +1236,11 @@ static int scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int
 }
 
 static int scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int dst_y0, int dst_y1)
 {
     Uint32 bpp = 4;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = dst_y0; i < dst_y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint32 *src;
@@ -964,24 +1258,27 @@ static int scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int
 int SDL_LowerSoftStretchNearest(SDL_Surface *s, const SDL_Rect *srcrect,
                                 SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
-    int src_pitch = s->pitch;
-    int dst_pitch = d->pitch;
+    SDL_StretchBands bands;
     int bpp = SDL_BYTESPERPIXEL(d->format);
 
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
-
     if (bpp == 4) {
-        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        bands.func = scale_mat_nearest_4;
     } else if (bpp == 3) {
-        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        bands.func = scale_mat_nearest_3;
     } else if (bpp == 2) {
-        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        bands.func = scale_mat_nearest_2;
     } else {
-        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        bands.func = scale_mat_nearest_1;
     }
+    bands.src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * s->pitch);
+    bands.src_w = srcrect->w;
+    bands.src_h = srcrect->h;
+    bands.src_pitch = s->pitch;
+    bands.dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * d->pitch);
+    bands.dst_w = dstrect->w;
+    bands.dst_h = dstrect->h;
+    bands.dst_pitch = d->pitch;
+
+    SDL_RunBlitBands(bands.dst_w, bands.dst_h, SDL_StretchBand, &bands);
+    return 0;
 }
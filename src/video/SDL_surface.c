@@ -27,6 +27,7 @@
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
 #include "../render/SDL_sysrender.h"
+#include "../SDL_memorystats_c.h"
 
 #include "SDL_surface_c.h"
 
@@ -46,7 +47,8 @@ SDL_bool SDL_SurfaceValid(SDL_Surface *surface)
 
 void SDL_UpdateSurfaceLockFlag(SDL_Surface *surface)
 {
-    if (SDL_SurfaceHasRLE(surface)) {
+    if (SDL_SurfaceHasRLE(surface) ||
+        (surface->internal->parent && SDL_MUSTLOCK(surface->internal->parent))) {
         surface->flags |= SDL_SURFACE_LOCK_NEEDED;
     } else {
         surface->flags &= ~SDL_SURFACE_LOCK_NEEDED;
@@ -57,9 +59,11 @@ void SDL_UpdateSurfaceLockFlag(SDL_Surface *surface)
  * Calculate the pad-aligned scanline width of a surface.
  * Return SDL_SIZE_MAX on overflow.
  *
+ * An alignment of 0 selects the default pitch alignment, 1 the minimal pitch.
+ *
  * for FOURCC, use SDL_CalculateYUVSize()
  */
-static int SDL_CalculateRGBSize(Uint32 format, size_t width, size_t height, size_t *size, size_t *pitch, SDL_bool minimal)
+static int SDL_CalculateRGBSize(Uint32 format, size_t width, size_t height, size_t *size, size_t *pitch, size_t alignment)
 {
     if (SDL_BITSPERPIXEL(format) >= 8) {
         if (SDL_size_mul_overflow(width, SDL_BYTESPERPIXEL(format), pitch)) {
@@ -74,12 +78,15 @@ static int SDL_CalculateRGBSize(Uint32 format, size_t width, size_t height, size
         }
         *pitch /= 8;
     }
-    if (!minimal) {
+    if (alignment == 0) {
         /* 4-byte aligning for speed */
-        if (SDL_size_add_overflow(*pitch, 3, pitch)) {
+        alignment = 4;
+    }
+    if (alignment > 1) {
+        if (SDL_size_add_overflow(*pitch, alignment - 1, pitch)) {
             return SDL_SetError("aligning pitch would overflow");
         }
-        *pitch &= ~3;
+        *pitch &= ~(alignment - 1);
     }
 
     if (SDL_size_mul_overflow(height, *pitch, size)) {
@@ -107,7 +114,7 @@ int SDL_CalculateSurfaceSize(SDL_PixelFormat format, int width, int height, size
             return -1;
         }
     } else {
-        if (SDL_CalculateRGBSize(format, width, height, &sz, &p, minimalPitch) < 0) {
+        if (SDL_CalculateRGBSize(format, width, height, &sz, &p, minimalPitch ? 1 : 0) < 0) {
             /* Overflow... */
             return -1;
         }
@@ -124,6 +131,162 @@ int SDL_CalculateSurfaceSize(SDL_PixelFormat format, int width, int height, size
     return 0;
 }
 
+/*
+ * Pixel buffers of released surfaces are kept in size classes, four per
+ * power of two, so that code creating and destroying lots of temporary
+ * surfaces doesn't go through the allocator every time.
+ */
+#define SDL_SURFACE_POOL_MIN_SIZE   256
+#define SDL_SURFACE_POOL_MAX_SIZE   (4 * 1024 * 1024)
+#define SDL_SURFACE_POOL_CLASSES    (4 * 14)
+#define SDL_SURFACE_POOL_DEPTH      4
+#define SDL_SURFACE_POOL_LIMIT      (16 * 1024 * 1024)
+
+typedef struct SDL_SurfacePoolClass
+{
+    int count;
+    void *buffers[SDL_SURFACE_POOL_DEPTH];
+} SDL_SurfacePoolClass;
+
+static SDL_SpinLock SDL_surface_pool_lock;
+static SDL_SurfacePoolClass SDL_surface_pool[SDL_SURFACE_POOL_CLASSES];
+static size_t SDL_surface_pool_bytes;
+
+static int SDL_GetSurfacePoolClass(size_t size, size_t *class_size)
+{
+    size_t octave = SDL_SURFACE_POOL_MIN_SIZE;
+    int index = 0;
+    int i;
+
+    if (size <= SDL_SURFACE_POOL_MIN_SIZE || size > SDL_SURFACE_POOL_MAX_SIZE) {
+        return -1;
+    }
+
+    while (size > octave * 2) {
+        octave *= 2;
+        index += 4;
+    }
+    for (i = 1; i < 4; ++i) {
+        if (size <= octave + i * (octave / 4)) {
+            break;
+        }
+    }
+    SDL_assert(index + i - 1 < SDL_SURFACE_POOL_CLASSES);
+    *class_size = octave + i * (octave / 4);
+    return index + i - 1;
+}
+
+static size_t SDL_GetSurfacePixelsAlignment(void)
+{
+    return SDL_max(SDL_GetSIMDAlignment(), SDL_SURFACE_PIXELS_ALIGNMENT);
+}
+
+int SDL_AllocSurfacePixels(SDL_Surface *surface, size_t alignment)
+{
+    size_t size, class_size;
+    int index;
+    void *pixels = NULL;
+
+    if (SDL_size_mul_overflow(surface->h, surface->pitch, &size)) {
+        return SDL_SetError("height * pitch would overflow");
+    }
+
+    if (alignment <= SDL_GetSurfacePixelsAlignment()) {
+        alignment = SDL_GetSurfacePixelsAlignment();
+
+        index = SDL_GetSurfacePoolClass(size, &class_size);
+        if (index >= 0) {
+            SDL_SurfacePoolClass *pool = &SDL_surface_pool[index];
+
+            SDL_LockSpinlock(&SDL_surface_pool_lock);
+            if (pool->count > 0) {
+                pixels = pool->buffers[--pool->count];
+                SDL_surface_pool_bytes -= class_size;
+            }
+            SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+            if (!pixels) {
+                pixels = SDL_aligned_alloc(alignment, class_size);
+                if (pixels) {
+                    SDL_TrackMemory(SDL_MEMORY_CATEGORY_SURFACES, (Sint64)class_size, 0, 0);
+                }
+            }
+            if (pixels) {
+                surface->internal->flags |= SDL_INTERNAL_SURFACE_POOLED;
+            }
+        }
+    }
+    if (!pixels) {
+        pixels = SDL_aligned_alloc(alignment, size);
+        if (!pixels) {
+            return -1;
+        }
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_SURFACES, (Sint64)size, 0, 0);
+    }
+    surface->pixels = pixels;
+    surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
+    return 0;
+}
+
+void SDL_FreeSurfacePixels(SDL_Surface *surface)
+{
+    /* Pooled buffers are still held by SDL, so they stay in the memory statistics until they're freed */
+    size_t size = (size_t)surface->h * surface->pitch;
+
+    if (surface->internal->flags & SDL_INTERNAL_SURFACE_POOLED) {
+        size_t class_size = 0;
+        int index = SDL_GetSurfacePoolClass(size, &class_size);
+
+        surface->internal->flags &= ~SDL_INTERNAL_SURFACE_POOLED;
+        if (index >= 0) {
+            SDL_SurfacePoolClass *pool = &SDL_surface_pool[index];
+            SDL_bool pooled = SDL_FALSE;
+
+            SDL_LockSpinlock(&SDL_surface_pool_lock);
+            if (pool->count < SDL_SURFACE_POOL_DEPTH &&
+                SDL_surface_pool_bytes + class_size <= SDL_SURFACE_POOL_LIMIT) {
+                pool->buffers[pool->count++] = surface->pixels;
+                SDL_surface_pool_bytes += class_size;
+                pooled = SDL_TRUE;
+            }
+            SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+            if (pooled) {
+                surface->pixels = NULL;
+                surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+                return;
+            }
+            size = class_size;
+        }
+    }
+
+    if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_SURFACES, -(Sint64)size, 0, 0);
+        SDL_aligned_free(surface->pixels);
+        surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+    } else {
+        SDL_free(surface->pixels);
+    }
+    surface->pixels = NULL;
+}
+
+void SDL_QuitSurfacePixelPool(void)
+{
+    int i;
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    for (i = 0; i < SDL_arraysize(SDL_surface_pool); ++i) {
+        SDL_SurfacePoolClass *pool = &SDL_surface_pool[i];
+
+        while (pool->count > 0) {
+            SDL_aligned_free(pool->buffers[--pool->count]);
+        }
+    }
+    SDL_TrackMemory(SDL_MEMORY_CATEGORY_SURFACES, -(Sint64)SDL_surface_pool_bytes, 0, 0);
+    SDL_surface_pool_bytes = 0;
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+}
+
 static SDL_Surface *SDL_InitializeSurface(SDL_InternalSurface *mem, int width, int height, SDL_PixelFormat format, SDL_Colorspace colorspace, SDL_PropertiesID props, void *pixels, int pitch, SDL_bool onstack)
 {
     SDL_Surface *surface = &mem->surface;
@@ -140,6 +303,8 @@ static SDL_Surface *SDL_InitializeSurface(SDL_InternalSurface *mem, int width, i
     surface->internal = &mem->internal;
     if (onstack) {
         surface->internal->flags |= SDL_INTERNAL_SURFACE_STACK;
+    } else {
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_SURFACES, sizeof(*mem), 0, 1);
     }
 
     surface->internal->format = SDL_GetPixelFormatDetails(format);
@@ -180,10 +345,7 @@ static SDL_Surface *SDL_InitializeSurface(SDL_InternalSurface *mem, int width, i
     return surface;
 }
 
-/*
- * Create an empty surface of the appropriate depth using the given format
- */
-SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
+static SDL_Surface *SDL_CreateSurfaceInternal(int width, int height, SDL_PixelFormat format, SDL_Colorspace colorspace, size_t alignment)
 {
     size_t pitch, size;
     SDL_InternalSurface *mem;
@@ -199,9 +361,17 @@ SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
         return NULL;
     }
 
-    if (SDL_CalculateSurfaceSize(format, width, height, &size, &pitch, SDL_FALSE /* not minimal pitch */) < 0) {
-        /* Overflow... */
-        return NULL;
+    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+        if (SDL_CalculateSurfaceSize(format, width, height, &size, &pitch, SDL_FALSE /* not minimal pitch */) < 0) {
+            /* Overflow... */
+            return NULL;
+        }
+        alignment = 0;
+    } else {
+        if (SDL_CalculateRGBSize(format, width, height, &size, &pitch, alignment) < 0) {
+            /* Overflow... */
+            return NULL;
+        }
     }
 
     /* Allocate and initialize the surface */
@@ -210,16 +380,14 @@ SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
         return NULL;
     }
 
-    surface = SDL_InitializeSurface(mem, width, height, format, SDL_COLORSPACE_UNKNOWN, 0, NULL, (int)pitch, SDL_FALSE);
+    surface = SDL_InitializeSurface(mem, width, height, format, colorspace, 0, NULL, (int)pitch, SDL_FALSE);
     if (surface) {
         if (surface->w && surface->h) {
             surface->flags &= ~SDL_SURFACE_PREALLOCATED;
-            surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
-            if (!surface->pixels) {
+            if (SDL_AllocSurfacePixels(surface, alignment) < 0) {
                 SDL_DestroySurface(surface);
                 return NULL;
             }
-            surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
 
             /* This is important for bitmaps */
             SDL_memset(surface->pixels, 0, size);
@@ -228,6 +396,45 @@ SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
     return surface;
 }
 
+/*
+ * Create an empty surface of the appropriate depth using the given format
+ */
+SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
+{
+    return SDL_CreateSurfaceInternal(width, height, format, SDL_COLORSPACE_UNKNOWN, 0);
+}
+
+SDL_Surface *SDL_CreateSurfaceWithProperties(SDL_PropertiesID props)
+{
+    Sint64 width = SDL_GetNumberProperty(props, SDL_PROP_SURFACE_CREATE_WIDTH_NUMBER, 0);
+    Sint64 height = SDL_GetNumberProperty(props, SDL_PROP_SURFACE_CREATE_HEIGHT_NUMBER, 0);
+    SDL_PixelFormat format = (SDL_PixelFormat)SDL_GetNumberProperty(props, SDL_PROP_SURFACE_CREATE_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN);
+    SDL_Colorspace colorspace = (SDL_Colorspace)SDL_GetNumberProperty(props, SDL_PROP_SURFACE_CREATE_COLORSPACE_NUMBER, SDL_COLORSPACE_UNKNOWN);
+    Sint64 alignment = SDL_GetNumberProperty(props, SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER, 0);
+
+    if (width < 0 || width > SDL_MAX_SINT32) {
+        SDL_InvalidParamError("width");
+        return NULL;
+    }
+
+    if (height < 0 || height > SDL_MAX_SINT32) {
+        SDL_InvalidParamError("height");
+        return NULL;
+    }
+
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        SDL_InvalidParamError("format");
+        return NULL;
+    }
+
+    if (alignment < 0 || alignment > SDL_MAX_SINT32 || (alignment & (alignment - 1)) != 0) {
+        SDL_SetError("Pitch alignment must be a power of two");
+        return NULL;
+    }
+
+    return SDL_CreateSurfaceInternal((int)width, (int)height, format, colorspace, (size_t)alignment);
+}
+
 /*
  * Create an RGB surface from an existing memory buffer using the given
  * enum SDL_PIXELFORMAT_* format
@@ -271,6 +478,215 @@ SDL_Surface *SDL_CreateSurfaceFrom(int width, int height, SDL_PixelFormat format
     return SDL_InitializeSurface(mem, width, height, format, SDL_COLORSPACE_UNKNOWN, 0, pixels, pitch, SDL_FALSE);
 }
 
+SDL_Surface *SDL_CreateSurfaceView(SDL_Surface *parent, const SDL_Rect *rect)
+{
+    SDL_Rect area;
+    SDL_Surface *surface;
+    Uint8 *pixels;
+    int bits_per_pixel;
+    Uint32 colorkey;
+
+    if (!SDL_SurfaceValid(parent)) {
+        SDL_InvalidParamError("parent");
+        return NULL;
+    }
+
+    if (SDL_ISPIXELFORMAT_FOURCC(parent->format)) {
+        SDL_SetError("Can't create a view of a FOURCC surface");
+        return NULL;
+    }
+
+    area.x = 0;
+    area.y = 0;
+    area.w = parent->w;
+    area.h = parent->h;
+    if (rect && !SDL_GetRectIntersection(rect, &area, &area)) {
+        SDL_SetError("The view rectangle is outside the parent surface");
+        return NULL;
+    }
+
+    bits_per_pixel = SDL_BITSPERPIXEL(parent->format);
+    if (((area.x * bits_per_pixel) % 8) != 0) {
+        SDL_SetError("The view must start on a byte boundary");
+        return NULL;
+    }
+
+#if SDL_HAVE_RLE
+    /* The parent pixels have to stay where they are while the view exists */
+    if (SDL_SetBooleanProperty(SDL_GetSurfaceProperties(parent), SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN, SDL_TRUE) < 0) {
+        return NULL;
+    }
+    if ((parent->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL) && !parent->pixels) {
+        /* Decode the pixels, and encode them again now that they'll be kept */
+        if (SDL_LockSurface(parent) < 0) {
+            return NULL;
+        }
+        SDL_UnlockSurface(parent);
+    }
+#endif
+    if (!parent->pixels) {
+        SDL_SetError("The parent surface doesn't have any pixels");
+        return NULL;
+    }
+
+    pixels = (Uint8 *)parent->pixels + area.y * parent->pitch + (area.x * bits_per_pixel) / 8;
+    surface = SDL_CreateSurfaceFrom(area.w, area.h, parent->format, pixels, parent->pitch);
+    if (!surface) {
+        return NULL;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(parent->format) && parent->internal->palette) {
+        SDL_SetSurfacePalette(surface, parent->internal->palette);
+    }
+    surface->internal->colorspace = parent->internal->colorspace;
+
+    if (SDL_GetSurfaceColorKey(parent, &colorkey) == 0) {
+        SDL_SetSurfaceColorKey(surface, SDL_TRUE, colorkey);
+    }
+    SDL_SetSurfaceColorMod(surface, parent->internal->map.info.r, parent->internal->map.info.g, parent->internal->map.info.b);
+    SDL_SetSurfaceAlphaMod(surface, parent->internal->map.info.a);
+    {
+        SDL_BlendMode blendMode;
+        if (SDL_GetSurfaceBlendMode(parent, &blendMode) == 0) {
+            SDL_SetSurfaceBlendMode(surface, blendMode);
+        }
+    }
+
+    /* Keep the parent alive as long as the view */
+    ++parent->refcount;
+    surface->internal->parent = parent;
+    SDL_UpdateSurfaceLockFlag(surface);
+
+    return surface;
+}
+
+int SDL_EnableSurfaceDamage(SDL_Surface *surface)
+{
+    if (!surface->internal->damage) {
+        surface->internal->damage = (SDL_SurfaceDamage *)SDL_calloc(1, sizeof(*surface->internal->damage));
+        if (!surface->internal->damage) {
+            return -1;
+        }
+    }
+
+    /* Nothing has been presented yet, so all of the surface is new */
+    SDL_AddSurfaceDamage(surface, NULL);
+    return 0;
+}
+
+static Sint64 SDL_GetRectArea(const SDL_Rect *rect)
+{
+    return (Sint64)rect->w * rect->h;
+}
+
+static void SDL_RemoveSurfaceDamageRect(SDL_SurfaceDamage *damage, int index)
+{
+    damage->rects[index] = damage->rects[--damage->num_rects];
+}
+
+/* Adds a rectangle to the damage, merging it with rectangles it overlaps or touches
+   when that doesn't cover much more area than the rectangles did separately. */
+void SDL_AddSurfaceDamage(SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_SurfaceDamage *damage;
+    SDL_Rect bounds, area, existing;
+    int i;
+
+    /* Any change to the pixels comes through here, so cached copies are out of date */
+    ++surface->internal->generation;
+
+    if (surface->internal->parent) {
+        /* A view changes the pixels of its parent */
+        SDL_Surface *parent = surface->internal->parent;
+        const size_t offset = (size_t)((Uint8 *)surface->pixels - (Uint8 *)parent->pixels);
+
+        bounds.x = (int)((offset % parent->pitch) * 8 / SDL_BITSPERPIXEL(parent->format));
+        bounds.y = (int)(offset / parent->pitch);
+        bounds.w = surface->w;
+        bounds.h = surface->h;
+        if (rect) {
+            SDL_Rect translated = *rect;
+            translated.x += bounds.x;
+            translated.y += bounds.y;
+            if (SDL_GetRectIntersection(&translated, &bounds, &area)) {
+                SDL_AddSurfaceDamage(parent, &area);
+            }
+        } else {
+            SDL_AddSurfaceDamage(parent, &bounds);
+        }
+    }
+
+    damage = surface->internal->damage;
+    if (!damage) {
+        return;
+    }
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+    if (!rect) {
+        area = bounds;
+    } else if (!SDL_GetRectIntersection(rect, &bounds, &area)) {
+        return;
+    }
+
+    for (;;) {
+        int best = -1;
+        Sint64 best_growth = 0;
+
+        for (i = 0; i < damage->num_rects; ++i) {
+            const SDL_Rect *other = &damage->rects[i];
+            SDL_Rect merged;
+            Sint64 growth;
+
+            if (other->x <= area.x && other->y <= area.y &&
+                other->x + other->w >= area.x + area.w &&
+                other->y + other->h >= area.y + area.h) {
+                /* Already damaged */
+                return;
+            }
+
+            SDL_GetRectUnion(other, &area, &merged);
+            growth = SDL_GetRectArea(&merged) - SDL_GetRectArea(other) - SDL_GetRectArea(&area);
+            if (best < 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+
+        if (best < 0 || (best_growth > 0 && damage->num_rects < SDL_SURFACE_MAX_DAMAGE_RECTS)) {
+            break;
+        }
+
+        /* Merge with the closest rectangle and try again with the result */
+        existing = damage->rects[best];
+        SDL_GetRectUnion(&existing, &area, &area);
+        SDL_RemoveSurfaceDamageRect(damage, best);
+    }
+
+    damage->rects[damage->num_rects++] = area;
+}
+
+const SDL_Rect *SDL_GetSurfaceDamage(SDL_Surface *surface, int *num_rects)
+{
+    SDL_SurfaceDamage *damage = surface->internal->damage;
+
+    if (!damage) {
+        *num_rects = 0;
+        return NULL;
+    }
+    *num_rects = damage->num_rects;
+    return damage->rects;
+}
+
+void SDL_ClearSurfaceDamage(SDL_Surface *surface)
+{
+    if (surface->internal->damage) {
+        surface->internal->damage->num_rects = 0;
+    }
+}
+
 SDL_PropertiesID SDL_GetSurfaceProperties(SDL_Surface *surface)
 {
     if (!SDL_SurfaceValid(surface)) {
@@ -423,6 +839,7 @@ int SDL_SetSurfacePalette(SDL_Surface *surface, SDL_Palette *palette)
     }
 
     SDL_InvalidateMap(&surface->internal->map);
+    ++surface->internal->generation;
 
     return 0;
 }
@@ -453,6 +870,7 @@ int SDL_AddSurfaceAlternateImage(SDL_Surface *surface, SDL_Surface *image)
     images[surface->internal->num_images] = image;
     surface->internal->images = images;
     ++surface->internal->num_images;
+    ++surface->internal->generation;
     ++image->refcount;
     return 0;
 }
@@ -494,6 +912,71 @@ SDL_Surface **SDL_GetSurfaceImages(SDL_Surface *surface, int *count)
     return images;
 }
 
+static Uint32 SDL_GetSurfaceImagesGeneration(SDL_Surface *surface)
+{
+    Uint32 generation = surface->internal->generation;
+
+    for (int i = 0; i < surface->internal->num_images; ++i) {
+        generation += surface->internal->images[i]->internal->generation;
+    }
+    return generation;
+}
+
+static void SDL_FreeSurfaceImageCache(SDL_Surface *surface)
+{
+    SDL_SurfaceImageCache *cache = surface->internal->scaled_images;
+
+    if (cache) {
+        for (int i = 0; i < SDL_arraysize(cache->images); ++i) {
+            SDL_DestroySurface(cache->images[i]);
+        }
+        SDL_free(cache);
+        surface->internal->scaled_images = NULL;
+    }
+}
+
+static SDL_Surface *SDL_GetCachedSurfaceImage(SDL_Surface *surface, int w, int h)
+{
+    SDL_SurfaceImageCache *cache = surface->internal->scaled_images;
+
+    if (!cache) {
+        return NULL;
+    }
+
+    if (cache->generation != SDL_GetSurfaceImagesGeneration(surface)) {
+        // The pixels have changed since these were scaled
+        SDL_FreeSurfaceImageCache(surface);
+        return NULL;
+    }
+
+    for (int i = 0; i < SDL_arraysize(cache->images); ++i) {
+        SDL_Surface *image = cache->images[i];
+        if (image && image->w == w && image->h == h) {
+            return image;
+        }
+    }
+    return NULL;
+}
+
+static void SDL_CacheSurfaceImage(SDL_Surface *surface, SDL_Surface *image)
+{
+    SDL_SurfaceImageCache *cache = surface->internal->scaled_images;
+
+    if (!cache) {
+        cache = (SDL_SurfaceImageCache *)SDL_calloc(1, sizeof(*cache));
+        if (!cache) {
+            return;
+        }
+        cache->generation = SDL_GetSurfaceImagesGeneration(surface);
+        surface->internal->scaled_images = cache;
+    }
+
+    SDL_DestroySurface(cache->images[cache->next]);
+    cache->images[cache->next] = image;
+    ++image->refcount;
+    cache->next = (cache->next + 1) % SDL_arraysize(cache->images);
+}
+
 SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale)
 {
     if (!SDL_SurfaceValid(surface)) {
@@ -536,8 +1019,18 @@ SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale)
         return closest;
     }
 
-    // We need to scale an image to the correct size
-    return SDL_ScaleSurface(closest, desired_w, desired_h, SDL_SCALEMODE_LINEAR);
+    // We need to scale an image to the correct size, reuse it if we did that already
+    SDL_Surface *scaled = SDL_GetCachedSurfaceImage(surface, desired_w, desired_h);
+    if (scaled) {
+        ++scaled->refcount;
+        return scaled;
+    }
+
+    scaled = SDL_ScaleSurface(closest, desired_w, desired_h, SDL_SCALEMODE_BEST);
+    if (scaled) {
+        SDL_CacheSurfaceImage(surface, scaled);
+    }
+    return scaled;
 }
 
 void SDL_RemoveSurfaceAlternateImages(SDL_Surface *surface)
@@ -553,7 +1046,9 @@ void SDL_RemoveSurfaceAlternateImages(SDL_Surface *surface)
         SDL_free(surface->internal->images);
         surface->internal->images = NULL;
         surface->internal->num_images = 0;
+        ++surface->internal->generation;
     }
+    SDL_FreeSurfaceImageCache(surface);
 }
 
 int SDL_SetSurfaceRLE(SDL_Surface *surface, SDL_bool enabled)
@@ -649,11 +1144,100 @@ int SDL_GetSurfaceColorKey(SDL_Surface *surface, Uint32 *key)
     return 0;
 }
 
-/* This is a fairly slow function to switch from colorkey to alpha
+/* Clears the alpha of as many pixels of a row matching the colorkey as it can, returning the number of pixels done */
+typedef int (*SDL_ColorkeyToAlphaRowFunc)(void *pixels, int width, Uint32 ckey, Uint32 cmpmask, Uint32 mask);
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_ColorkeyToAlphaRow16_SSE2(void *pixels, int width, Uint32 ckey, Uint32 cmpmask, Uint32 mask)
+{
+    Uint16 *row = (Uint16 *)pixels;
+    const __m128i vckey = _mm_set1_epi16((short)ckey);
+    const __m128i vcmpmask = _mm_set1_epi16((short)cmpmask);
+    const __m128i vamask = _mm_set1_epi16((short)~mask);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        __m128i px = _mm_loadu_si128((const __m128i *)(row + i));
+        __m128i clear = _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(px, vcmpmask), vckey), vamask);
+        _mm_storeu_si128((__m128i *)(row + i), _mm_andnot_si128(clear, px));
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") SDL_ColorkeyToAlphaRow32_SSE2(void *pixels, int width, Uint32 ckey, Uint32 cmpmask, Uint32 mask)
+{
+    Uint32 *row = (Uint32 *)pixels;
+    const __m128i vckey = _mm_set1_epi32((int)ckey);
+    const __m128i vcmpmask = _mm_set1_epi32((int)cmpmask);
+    const __m128i vamask = _mm_set1_epi32((int)~mask);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i *)(row + i));
+        __m128i clear = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(px, vcmpmask), vckey), vamask);
+        _mm_storeu_si128((__m128i *)(row + i), _mm_andnot_si128(clear, px));
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_ColorkeyToAlphaRow16_NEON(void *pixels, int width, Uint32 ckey, Uint32 cmpmask, Uint32 mask)
+{
+    Uint16 *row = (Uint16 *)pixels;
+    const uint16x8_t vckey = vdupq_n_u16((Uint16)ckey);
+    const uint16x8_t vcmpmask = vdupq_n_u16((Uint16)cmpmask);
+    const uint16x8_t vamask = vdupq_n_u16((Uint16)~mask);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        uint16x8_t px = vld1q_u16(row + i);
+        uint16x8_t clear = vandq_u16(vceqq_u16(vandq_u16(px, vcmpmask), vckey), vamask);
+        vst1q_u16(row + i, vbicq_u16(px, clear));
+    }
+    return i;
+}
+
+static int SDL_ColorkeyToAlphaRow32_NEON(void *pixels, int width, Uint32 ckey, Uint32 cmpmask, Uint32 mask)
+{
+    Uint32 *row = (Uint32 *)pixels;
+    const uint32x4_t vckey = vdupq_n_u32(ckey);
+    const uint32x4_t vcmpmask = vdupq_n_u32(cmpmask);
+    const uint32x4_t vamask = vdupq_n_u32(~mask);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        uint32x4_t px = vld1q_u32(row + i);
+        uint32x4_t clear = vandq_u32(vceqq_u32(vandq_u32(px, vcmpmask), vckey), vamask);
+        vst1q_u32(row + i, vbicq_u32(px, clear));
+    }
+    return i;
+}
+#endif
+
+static SDL_ColorkeyToAlphaRowFunc SDL_GetColorkeyToAlphaRowFunc(int bpp)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return (bpp == 2) ? SDL_ColorkeyToAlphaRow16_SSE2 : SDL_ColorkeyToAlphaRow32_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return (bpp == 2) ? SDL_ColorkeyToAlphaRow16_NEON : SDL_ColorkeyToAlphaRow32_NEON;
+    }
+#endif
+    (void)bpp;
+    return NULL;
+}
+
+/* Switch from colorkey to alpha, clearing the alpha of every pixel matching the colorkey
    NB: it doesn't handle bpp 1 or 3, because they have no alpha channel */
 static void SDL_ConvertColorkeyToAlpha(SDL_Surface *surface, SDL_bool ignore_alpha)
 {
+    SDL_ColorkeyToAlphaRowFunc row_func;
     int x, y, bpp;
+    Uint32 ckey, mask, cmpmask;
 
     if (!SDL_SurfaceValid(surface)) {
         return;
@@ -665,71 +1249,40 @@ static void SDL_ConvertColorkeyToAlpha(SDL_Surface *surface, SDL_bool ignore_alp
     }
 
     bpp = SDL_BYTESPERPIXEL(surface->format);
+    if (bpp != 2 && bpp != 4) {
+        return;
+    }
+
+    mask = ~surface->internal->format->Amask;
+    if (bpp == 2) {
+        mask &= 0xFFFF;
+    }
+
+    /* Ignore, or not, alpha in colorkey comparison */
+    cmpmask = ignore_alpha ? mask : (bpp == 2 ? 0xFFFF : ~0u);
+    ckey = surface->internal->map.info.colorkey & cmpmask;
+
+    row_func = SDL_GetColorkeyToAlphaRowFunc(bpp);
 
     SDL_LockSurface(surface);
 
-    if (bpp == 2) {
-        Uint16 *row, *spot;
-        Uint16 ckey = (Uint16)surface->internal->map.info.colorkey;
-        Uint16 mask = (Uint16)(~surface->internal->format->Amask);
-
-        /* Ignore, or not, alpha in colorkey comparison */
-        if (ignore_alpha) {
-            ckey &= mask;
-            row = (Uint16 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if ((*spot & mask) == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
-                }
-                row += surface->pitch / 2;
-            }
-        } else {
-            row = (Uint16 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if (*spot == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
-                }
-                row += surface->pitch / 2;
-            }
-        }
-    } else if (bpp == 4) {
-        Uint32 *row, *spot;
-        Uint32 ckey = surface->internal->map.info.colorkey;
-        Uint32 mask = ~surface->internal->format->Amask;
-
-        /* Ignore, or not, alpha in colorkey comparison */
-        if (ignore_alpha) {
-            ckey &= mask;
-            row = (Uint32 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if ((*spot & mask) == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+
+        x = row_func ? row_func(row, surface->w, ckey, cmpmask, mask) : 0;
+        if (bpp == 2) {
+            Uint16 *spot = (Uint16 *)row;
+            for (; x < surface->w; ++x) {
+                if ((spot[x] & cmpmask) == ckey) {
+                    spot[x] &= (Uint16)mask;
                 }
-                row += surface->pitch / 4;
             }
         } else {
-            row = (Uint32 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if (*spot == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
+            Uint32 *spot = (Uint32 *)row;
+            for (; x < surface->w; ++x) {
+                if ((spot[x] & cmpmask) == ckey) {
+                    spot[x] &= mask;
                 }
-                row += surface->pitch / 4;
             }
         }
     }
@@ -972,6 +1525,7 @@ int SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
     if (SDL_ValidateMap(src, dst) < 0) {
         return -1;
     }
+    SDL_AddSurfaceDamage(dst, dstrect);
     return src->internal->map.blit(src, srcrect, dst, dstrect);
 }
 
@@ -1230,6 +1784,8 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
         return SDL_SetError("Size too large for scaling");
     }
 
+    SDL_AddSurfaceDamage(dst, dstrect);
+
     if (!(src->internal->map.info.flags & SDL_COPY_NEAREST)) {
         src->internal->map.info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(&src->internal->map);
@@ -1250,7 +1806,7 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
             SDL_BYTESPERPIXEL(src->format) == 4 &&
             src->format != SDL_PIXELFORMAT_ARGB2101010) {
             /* fast path */
-            return SDL_SoftStretch(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
+            return SDL_SoftStretch(src, srcrect, dst, dstrect, scaleMode);
         } else {
             /* Use intermediate surface(s) */
             SDL_Surface *tmp1 = NULL;
@@ -1300,7 +1856,7 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
                 SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                SDL_SoftStretch(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
+                SDL_SoftStretch(src, &srcrect2, tmp2, NULL, scaleMode);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
                 SDL_SetSurfaceAlphaMod(tmp2, alpha);
@@ -1313,7 +1869,7 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
                 ret = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
                 SDL_DestroySurface(tmp2);
             } else {
-                ret = SDL_SoftStretch(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
+                ret = SDL_SoftStretch(src, &srcrect2, dst, dstrect, scaleMode);
             }
 
             SDL_DestroySurface(tmp1);
@@ -1687,6 +2243,13 @@ int SDL_LockSurface(SDL_Surface *surface)
         return SDL_InvalidParamError("surface");
     }
 
+    if (surface->internal->parent) {
+        /* The view and its parent share their pixels, so lock them together */
+        if (SDL_LockSurface(surface->internal->parent) < 0) {
+            return -1;
+        }
+    }
+
     if (!surface->internal->locked) {
 #if SDL_HAVE_RLE
         /* Perform the lock */
@@ -1697,6 +2260,9 @@ int SDL_LockSurface(SDL_Surface *surface)
 #endif
     }
 
+    /* The pixels may be changed directly while the surface is locked */
+    SDL_AddSurfaceDamage(surface, NULL);
+
     /* Increment the surface lock count, for recursive locks */
     ++surface->internal->locked;
     surface->flags |= SDL_SURFACE_LOCKED;
@@ -1715,7 +2281,13 @@ void SDL_UnlockSurface(SDL_Surface *surface)
     }
 
     /* Only perform an unlock if we are locked */
-    if (!surface->internal->locked || (--surface->internal->locked > 0)) {
+    if (!surface->internal->locked) {
+        return;
+    }
+    if (surface->internal->parent) {
+        SDL_UnlockSurface(surface->internal->parent);
+    }
+    if (--surface->internal->locked > 0) {
         return;
     }
 
@@ -1801,6 +2373,8 @@ int SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
         return 0;
     }
 
+    SDL_AddSurfaceDamage(surface, NULL);
+
     switch (flip) {
     case SDL_FLIP_HORIZONTAL:
         return SDL_FlipSurfaceHorizontal(surface);
@@ -2300,13 +2874,128 @@ int SDL_ConvertPixels(int width, int height,
 /*
  * Premultiply the alpha on a block of pixels
  *
- * Here are some ideas for optimization:
+ * The 8888 formats are handled a vector of pixels at a time where the CPU
+ * supports it, with the division by 255 done exactly as the scalar code does:
+ * for x <= 255 * 255, x / 255 == (x + 1 + (x >> 8)) >> 8
+ *
+ * Here are some ideas for further optimization:
  * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
  * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
  */
 
+/* Premultiplies as many pixels of a row as it can, returning the number of pixels done */
+typedef int (*SDL_PremultiplyAlphaRowFunc)(const Uint32 *src, Uint32 *dst, int width, int alpha_shift);
+
+#ifdef SDL_AVX2_INTRINSICS
+static int SDL_TARGETING("avx2") SDL_PremultiplyAlphaRow8888_AVX2(const Uint32 *src, Uint32 *dst, int width, int alpha_shift)
+{
+    const __m128i shift = _mm_cvtsi32_si128(alpha_shift);
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        __m256i px = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i a = _mm256_and_si256(_mm256_srl_epi32(px, shift), _mm256_set1_epi32(0xFF));
+        __m256i lo, hi, alo, ahi;
+
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+        alo = _mm256_unpacklo_epi32(a, a);
+        ahi = _mm256_unpackhi_epi32(a, a);
+        lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(px, zero), alo);
+        hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(px, zero), ahi);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, one), _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, one), _mm256_srli_epi16(hi, 8)), 8);
+        lo = _mm256_packus_epi16(lo, hi);
+        lo = _mm256_or_si256(_mm256_andnot_si256(amask, lo), _mm256_and_si256(amask, px));
+        _mm256_storeu_si256((__m256i *)(dst + i), lo);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_PremultiplyAlphaRow8888_SSE2(const Uint32 *src, Uint32 *dst, int width, int alpha_shift)
+{
+    const __m128i shift = _mm_cvtsi32_si128(alpha_shift);
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i a = _mm_and_si128(_mm_srl_epi32(px, shift), _mm_set1_epi32(0xFF));
+        __m128i lo, hi, alo, ahi;
+
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        alo = _mm_unpacklo_epi32(a, a);
+        ahi = _mm_unpackhi_epi32(a, a);
+        lo = _mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), alo);
+        hi = _mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), ahi);
+        lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+        lo = _mm_packus_epi16(lo, hi);
+        lo = _mm_or_si128(_mm_andnot_si128(amask, lo), _mm_and_si128(amask, px));
+        _mm_storeu_si128((__m128i *)(dst + i), lo);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_PremultiplyAlphaRow8888_NEON(const Uint32 *src, Uint32 *dst, int width, int alpha_shift)
+{
+    const int32x4_t shift = vdupq_n_s32(-alpha_shift);
+    const uint32x4_t amask = vdupq_n_u32(0xFFu << alpha_shift);
+    const uint16x8_t one = vdupq_n_u16(1);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        uint32x4_t px = vld1q_u32(src + i);
+        uint8x16_t px8 = vreinterpretq_u8_u32(px);
+        uint32x4_t a = vandq_u32(vshlq_u32(px, shift), vdupq_n_u32(0xFF));
+        uint32x4x2_t a2;
+        uint16x8_t lo, hi;
+        uint32x4_t result;
+
+        a = vorrq_u32(a, vshlq_n_u32(a, 16));
+        a2 = vzipq_u32(a, a);
+        lo = vmulq_u16(vmovl_u8(vget_low_u8(px8)), vreinterpretq_u16_u32(a2.val[0]));
+        hi = vmulq_u16(vmovl_u8(vget_high_u8(px8)), vreinterpretq_u16_u32(a2.val[1]));
+        lo = vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8));
+        hi = vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8));
+        result = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+        vst1q_u32(dst + i, vbslq_u32(amask, px, result));
+    }
+    return i;
+}
+#endif
+
+static SDL_PremultiplyAlphaRowFunc SDL_GetPremultiplyAlphaRowFunc(void)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_PremultiplyAlphaRow8888_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_PremultiplyAlphaRow8888_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_PremultiplyAlphaRow8888_NEON;
+    }
+#endif
+    return NULL;
+}
+
 static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
+    SDL_PremultiplyAlphaRowFunc row_func = SDL_GetPremultiplyAlphaRowFunc();
     int c;
     Uint32 srcpixel;
     Uint32 srcR, srcG, srcB, srcA;
@@ -2316,7 +3005,10 @@ static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src
     while (height--) {
         const Uint32 *src_px = (const Uint32 *)src;
         Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
+        c = row_func ? row_func(src_px, dst_px, width, 24) : 0;
+        src_px += c;
+        dst_px += c;
+        for (c = width - c; c; --c) {
             /* Component bytes extraction. */
             srcpixel = *src_px++;
             RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
@@ -2338,6 +3030,7 @@ static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src
 
 static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
+    SDL_PremultiplyAlphaRowFunc row_func = SDL_GetPremultiplyAlphaRowFunc();
     int c;
     Uint32 srcpixel;
     Uint32 srcR, srcG, srcB, srcA;
@@ -2347,7 +3040,10 @@ static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src
     while (height--) {
         const Uint32 *src_px = (const Uint32 *)src;
         Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
+        c = row_func ? row_func(src_px, dst_px, width, 0) : 0;
+        src_px += c;
+        dst_px += c;
+        for (c = width - c; c; --c) {
             /* Component bytes extraction. */
             srcpixel = *src_px++;
             RGBA_FROM_RGBA8888(srcpixel, srcR, srcG, srcB, srcA);
@@ -2367,11 +3063,41 @@ static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src
     }
 }
 
+#ifdef SDL_SSE_INTRINSICS
+static void SDL_TARGETING("sse") SDL_PremultiplyAlpha_AXYZ128_SSE(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    int c;
+
+    while (height--) {
+        const float *src_px = (const float *)src;
+        float *dst_px = (float *)dst;
+        for (c = width; c; --c) {
+            __m128 px = _mm_loadu_ps(src_px);
+            __m128 a = _mm_shuffle_ps(px, px, _MM_SHUFFLE(0, 0, 0, 0));
+
+            /* Multiply every component by alpha, then put alpha back in the first lane */
+            _mm_storeu_ps(dst_px, _mm_move_ss(_mm_mul_ps(px, a), px));
+            src_px += 4;
+            dst_px += 4;
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+#endif
+
 static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
     int c;
     float flR, flG, flB, flA;
 
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        SDL_PremultiplyAlpha_AXYZ128_SSE(width, height, src, src_pitch, dst, dst_pitch);
+        return;
+    }
+#endif
+
     while (height--) {
         const float *src_px = (const float *)src;
         float *dst_px = (float *)dst;
@@ -2785,6 +3511,7 @@ int SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g,
 {
     Uint32 pixel = 0;
     size_t bytes_per_pixel;
+    SDL_Rect pixel_rect;
     Uint8 *p;
     int result = -1;
 
@@ -2810,6 +3537,12 @@ int SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g,
 
     p = (Uint8 *)surface->pixels + y * surface->pitch + x * bytes_per_pixel;
 
+    pixel_rect.x = x;
+    pixel_rect.y = y;
+    pixel_rect.w = 1;
+    pixel_rect.h = 1;
+    SDL_AddSurfaceDamage(surface, &pixel_rect);
+
     if (bytes_per_pixel <= sizeof(pixel) && !SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
         pixel = SDL_MapRGBA(surface->internal->format, surface->internal->palette, r, g, b, a);
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
@@ -2868,6 +3601,7 @@ int SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, floa
     } else {
         /* This is really slow, but it gets the job done */
         float rgba[4];
+        SDL_Rect pixel_rect;
         Uint8 *p;
 
         if (SDL_MUSTLOCK(surface)) {
@@ -2878,6 +3612,12 @@ int SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, floa
 
         p = (Uint8 *)surface->pixels + y * surface->pitch + x * SDL_BYTESPERPIXEL(surface->format);
 
+        pixel_rect.x = x;
+        pixel_rect.y = y;
+        pixel_rect.w = 1;
+        pixel_rect.h = 1;
+        SDL_AddSurfaceDamage(surface, &pixel_rect);
+
         rgba[0] = r;
         rgba[1] = g;
         rgba[2] = b;
@@ -2931,16 +3671,15 @@ void SDL_DestroySurface(SDL_Surface *surface)
 #endif
     SDL_SetSurfacePalette(surface, NULL);
 
-    if (surface->flags & SDL_SURFACE_PREALLOCATED) {
-        /* Don't free */
-    } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-        /* Free aligned */
-        SDL_aligned_free(surface->pixels);
-    } else {
-        /* Normal */
-        SDL_free(surface->pixels);
+    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
+        SDL_FreeSurfacePixels(surface);
+    }
+    if (surface->internal->parent) {
+        SDL_DestroySurface(surface->internal->parent);
     }
+    SDL_free(surface->internal->damage);
     if (!(surface->internal->flags & SDL_INTERNAL_SURFACE_STACK)) {
+        SDL_TrackMemory(SDL_MEMORY_CATEGORY_SURFACES, -(Sint64)sizeof(SDL_InternalSurface), 0, -1);
         SDL_free(surface);
     }
 }
@@ -33,6 +33,29 @@ typedef Uint32 SDL_SurfaceDataFlags;
 #define SDL_INTERNAL_SURFACE_DONTFREE   0x00000001u /**< Surface is referenced internally */
 #define SDL_INTERNAL_SURFACE_STACK      0x00000002u /**< Surface is allocated on the stack */
 #define SDL_INTERNAL_SURFACE_RLEACCEL   0x00000004u /**< Surface is RLE encoded */
+#define SDL_INTERNAL_SURFACE_POOLED     0x00000008u /**< Surface pixels come from the pixel buffer pool */
+
+/* The minimum alignment of the pixel memory of surfaces created by SDL */
+#define SDL_SURFACE_PIXELS_ALIGNMENT    64
+
+#define SDL_SURFACE_MAX_DAMAGE_RECTS    16
+
+/** Regions of a surface that changed since the damage was last cleared */
+typedef struct SDL_SurfaceDamage
+{
+    int num_rects;
+    SDL_Rect rects[SDL_SURFACE_MAX_DAMAGE_RECTS];
+} SDL_SurfaceDamage;
+
+#define SDL_SURFACE_MAX_SCALED_IMAGES   4
+
+/** Images scaled from a surface with alternate images for display scales, see SDL_GetSurfaceImage() */
+typedef struct SDL_SurfaceImageCache
+{
+    Uint32 generation;
+    int next;
+    SDL_Surface *images[SDL_SURFACE_MAX_SCALED_IMAGES];
+} SDL_SurfaceImageCache;
 
 /* Surface internal data definition */
 struct SDL_SurfaceData
@@ -56,12 +79,24 @@ struct SDL_SurfaceData
     int num_images;
     SDL_Surface **images;
 
+    /** images scaled for display scales, if any */
+    SDL_SurfaceImageCache *scaled_images;
+
+    /** incremented whenever the pixels or images of the surface change */
+    Uint32 generation;
+
     /** information needed for surfaces requiring locks */
     int locked;
 
+    /** the surface whose pixels this is a view of, if any */
+    SDL_Surface *parent;
+
     /** clipping information */
     SDL_Rect clip_rect;
 
+    /** changed regions, if damage tracking is enabled */
+    SDL_SurfaceDamage *damage;
+
     /** info for fast blit mapping to other surfaces */
     SDL_BlitMap map;
 };
@@ -76,6 +111,13 @@ typedef struct SDL_InternalSurface
 /* Surface functions */
 extern SDL_bool SDL_SurfaceValid(SDL_Surface *surface);
 extern void SDL_UpdateSurfaceLockFlag(SDL_Surface *surface);
+extern int SDL_AllocSurfacePixels(SDL_Surface *surface, size_t alignment);
+extern void SDL_FreeSurfacePixels(SDL_Surface *surface);
+extern void SDL_QuitSurfacePixelPool(void);
+extern int SDL_EnableSurfaceDamage(SDL_Surface *surface);
+extern void SDL_AddSurfaceDamage(SDL_Surface *surface, const SDL_Rect *rect);
+extern const SDL_Rect *SDL_GetSurfaceDamage(SDL_Surface *surface, int *num_rects);
+extern void SDL_ClearSurfaceDamage(SDL_Surface *surface);
 extern float SDL_GetDefaultSDRWhitePoint(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace colorspace);
 extern float SDL_GetDefaultHDRHeadroom(SDL_Colorspace colorspace);
@@ -91,6 +91,8 @@ struct SDL_Window
 
     float opacity;
 
+    SDL_PresentMode present_mode;
+
     SDL_Surface *surface;
     SDL_bool surface_valid;
 
@@ -282,6 +284,8 @@ struct SDL_VideoDevice
     void (*OnWindowEnter)(SDL_VideoDevice *_this, SDL_Window *window);
     int (*UpdateWindowShape)(SDL_VideoDevice *_this, SDL_Window *window, SDL_Surface *shape);
     int (*FlashWindow)(SDL_VideoDevice *_this, SDL_Window *window, SDL_FlashOperation operation);
+    SDL_bool (*WindowSupportsPresentMode)(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode);
+    int (*SetWindowPresentMode)(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode);
     int (*SetWindowFocusable)(SDL_VideoDevice *_this, SDL_Window *window, SDL_bool focusable);
     int (*SyncWindow)(SDL_VideoDevice *_this, SDL_Window *window);
 
@@ -348,6 +352,7 @@ struct SDL_VideoDevice
     int (*SetClipboardData)(SDL_VideoDevice *_this);
     void *(*GetClipboardData)(SDL_VideoDevice *_this, const char *mime_type, size_t *size);
     SDL_bool (*HasClipboardData)(SDL_VideoDevice *_this, const char *mime_type);
+    SDL_IOStream *(*OpenClipboardData)(SDL_VideoDevice *_this, const char *mime_type);
     /* If you implement *ClipboardData, you don't need to implement *ClipboardText */
     int (*SetClipboardText)(SDL_VideoDevice *_this, const char *text);
     char *(*GetClipboardText)(SDL_VideoDevice *_this);
@@ -34,6 +34,7 @@
 #include "../SDL_properties_c.h"
 #include "../timer/SDL_timer_c.h"
 #include "../camera/SDL_camera_c.h"
+#include "../power/SDL_power_c.h"
 #include "../render/SDL_sysrender.h"
 
 #ifdef SDL_VIDEO_OPENGL
@@ -257,6 +258,7 @@ typedef struct
     void *pixels;
     int pitch;
     int bytes_per_pixel;
+    SDL_bool zero_copy; /* pixels is the streaming texture's own lock memory */
 } SDL_WindowTextureData;
 
 static Uint32 SDL_DefaultGraphicsBackends(SDL_VideoDevice *_this)
@@ -284,7 +286,9 @@ static void SDLCALL SDL_CleanupWindowTextureData(void *userdata, void *value)
     if (data->renderer) {
         SDL_DestroyRenderer(data->renderer);
     }
-    SDL_free(data->pixels);
+    if (!data->zero_copy) {
+        SDL_free(data->pixels);
+    }
     SDL_free(data);
 }
 
@@ -369,8 +373,11 @@ static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, S
         SDL_DestroyTexture(data->texture);
         data->texture = NULL;
     }
-    SDL_free(data->pixels);
+    if (!data->zero_copy) {
+        SDL_free(data->pixels);
+    }
     data->pixels = NULL;
+    data->zero_copy = SDL_FALSE;
 
     /* Find the first format with or without an alpha channel */
     *format = texture_formats[0];
@@ -396,11 +403,22 @@ static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, S
 
     /* Create framebuffer data */
     data->bytes_per_pixel = SDL_BYTESPERPIXEL(*format);
-    data->pitch = (((w * data->bytes_per_pixel) + 3) & ~3);
 
-    {
+    if (data->renderer->persistent_lock_memory && !data->texture->native) {
+        /* Let the application draw straight into the texture's staging memory,
+           each update then only has to upload the changed area. */
+        if (SDL_LockTexture(data->texture, NULL, &data->pixels, &data->pitch) == 0) {
+            SDL_UnlockTexture(data->texture);
+            data->zero_copy = SDL_TRUE;
+        }
+    }
+
+    if (!data->zero_copy) {
         /* Make static analysis happy about potential SDL_malloc(0) calls. */
-        const size_t allocsize = (size_t)h * data->pitch;
+        size_t allocsize;
+
+        data->pitch = (((w * data->bytes_per_pixel) + 3) & ~3);
+        allocsize = (size_t)h * data->pitch;
         data->pixels = SDL_malloc((allocsize > 0) ? allocsize : 1);
         if (!data->pixels) {
             return -1;
@@ -460,11 +478,22 @@ static int SDL_UpdateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, c
 
     /* Update a single rect that contains subrects for best DMA performance */
     if (SDL_GetSpanEnclosingRect(w, h, numrects, rects, &rect)) {
-        src = (void *)((Uint8 *)data->pixels +
-                       rect.y * data->pitch +
-                       rect.x * data->bytes_per_pixel);
-        if (SDL_UpdateTexture(data->texture, &rect, src, data->pitch) < 0) {
-            return -1;
+        if (data->zero_copy) {
+            /* The surface already lives in the texture memory, locking and
+               unlocking the rect uploads just that area. */
+            int locked_pitch;
+
+            if (SDL_LockTexture(data->texture, &rect, &src, &locked_pitch) < 0) {
+                return -1;
+            }
+            SDL_UnlockTexture(data->texture);
+        } else {
+            src = (void *)((Uint8 *)data->pixels +
+                           rect.y * data->pitch +
+                           rect.x * data->bytes_per_pixel);
+            if (SDL_UpdateTexture(data->texture, &rect, src, data->pitch) < 0) {
+                return -1;
+            }
         }
 
         if (SDL_RenderTexture(data->renderer, data->texture, NULL, NULL) < 0) {
@@ -553,6 +582,28 @@ const char *SDL_GetVideoDriver(int index)
     return NULL;
 }
 
+/* The driver that was picked automatically last time, and the environment it
+   was picked in, so reinitializing video doesn't probe drivers that already
+   failed in the same environment. */
+static int cached_bootstrap = -1;
+static Uint32 cached_bootstrap_environment;
+
+static Uint32 SDL_GetVideoEnvironmentHash(void)
+{
+    static const char *variables[] = { "DISPLAY", "WAYLAND_DISPLAY", "XDG_SESSION_TYPE", "XDG_RUNTIME_DIR" };
+    Uint32 crc = 0;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(variables); ++i) {
+        const char *value = SDL_getenv(variables[i]);
+        if (!value) {
+            value = "";
+        }
+        crc = SDL_crc32(crc, value, SDL_strlen(value) + 1);
+    }
+    return crc;
+}
+
 /*
  * Initialize the video and event subsystems -- determine native pixel format
  */
@@ -563,6 +614,8 @@ int SDL_VideoInit(const char *driver_name)
     SDL_bool init_keyboard = SDL_FALSE;
     SDL_bool init_mouse = SDL_FALSE;
     SDL_bool init_touch = SDL_FALSE;
+    SDL_bool auto_selected = SDL_FALSE;
+    Uint32 environment = 0;
     int i = 0;
 
     /* Check to make sure we don't overwrite '_this' */
@@ -615,12 +668,21 @@ int SDL_VideoInit(const char *driver_name)
             driver_attempt = (driver_attempt_end) ? (driver_attempt_end + 1) : NULL;
         }
     } else {
-        for (i = 0; bootstrap[i]; ++i) {
+        environment = SDL_GetVideoEnvironmentHash();
+        if (cached_bootstrap >= 0 && cached_bootstrap_environment == environment) {
+            i = cached_bootstrap;
             video = bootstrap[i]->create();
-            if (video) {
-                break;
+        }
+        if (!video) {
+            for (i = 0; bootstrap[i]; ++i) {
+                video = bootstrap[i]->create();
+                if (video) {
+                    break;
+                }
             }
         }
+        cached_bootstrap = -1; /* set again once the driver has initialized */
+        auto_selected = SDL_TRUE;
     }
     if (!video) {
         if (driver_name) {
@@ -654,6 +716,11 @@ int SDL_VideoInit(const char *driver_name)
         return SDL_SetError("The video driver did not add any displays");
     }
 
+    if (auto_selected) {
+        cached_bootstrap = i;
+        cached_bootstrap_environment = environment;
+    }
+
     SDL_AddHintCallback(SDL_HINT_VIDEO_SYNC_WINDOW_OPERATIONS, SDL_SyncHintWatcher, NULL);
 
     /* Disable the screen saver by default. This is a change from <= 2.0.1,
@@ -3467,6 +3534,11 @@ SDL_Surface *SDL_GetWindowSurface(SDL_Window *window)
         if (window->surface) {
             window->surface_valid = SDL_TRUE;
             window->surface->internal->flags |= SDL_INTERNAL_SURFACE_DONTFREE;
+
+            if (SDL_GetHintBoolean(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING, SDL_FALSE)) {
+                /* This is an optimization, so updating the whole surface still works if it fails */
+                SDL_EnableSurfaceDamage(window->surface);
+            }
         }
     }
     return window->surface;
@@ -3498,6 +3570,21 @@ int SDL_UpdateWindowSurface(SDL_Window *window)
 
     CHECK_WINDOW_MAGIC(window, -1);
 
+    if (window->surface_valid && window->surface->internal->damage) {
+        SDL_Rect rects[SDL_SURFACE_MAX_DAMAGE_RECTS];
+        int numrects;
+        const SDL_Rect *damage = SDL_GetSurfaceDamage(window->surface, &numrects);
+
+        if (numrects == 0) {
+            /* Nothing changed since the last update */
+            return 0;
+        }
+        SDL_memcpy(rects, damage, numrects * sizeof(*rects));
+        SDL_ClearSurfaceDamage(window->surface);
+
+        return SDL_UpdateWindowSurfaceRects(window, rects, numrects);
+    }
+
     full_rect.x = 0;
     full_rect.y = 0;
     SDL_GetWindowSizeInPixels(window, &full_rect.w, &full_rect.h);
@@ -3829,6 +3916,52 @@ int SDL_FlashWindow(SDL_Window *window, SDL_FlashOperation operation)
     return SDL_Unsupported();
 }
 
+SDL_bool SDL_WindowSupportsPresentMode(SDL_Window *window, SDL_PresentMode mode)
+{
+    CHECK_WINDOW_MAGIC(window, SDL_FALSE);
+
+    if (mode == SDL_PRESENTMODE_FIFO) {
+        return SDL_TRUE;
+    }
+    if (_this->WindowSupportsPresentMode) {
+        return _this->WindowSupportsPresentMode(_this, window, mode);
+    }
+    return SDL_FALSE;
+}
+
+int SDL_SetWindowPresentMode(SDL_Window *window, SDL_PresentMode mode)
+{
+    CHECK_WINDOW_MAGIC(window, -1);
+
+    if (mode == window->present_mode) {
+        return 0;
+    }
+    if (!SDL_WindowSupportsPresentMode(window, mode)) {
+        return SDL_Unsupported();
+    }
+    if (_this->SetWindowPresentMode) {
+        if (_this->SetWindowPresentMode(_this, window, mode) < 0) {
+            return -1;
+        }
+    }
+    window->present_mode = mode;
+    return 0;
+}
+
+int SDL_GetWindowPresentMode(SDL_Window *window, SDL_PresentMode *mode)
+{
+    if (mode) {
+        *mode = SDL_PRESENTMODE_FIFO;
+    }
+
+    CHECK_WINDOW_MAGIC(window, -1);
+
+    if (mode) {
+        *mode = window->present_mode;
+    }
+    return 0;
+}
+
 void SDL_OnWindowShown(SDL_Window *window)
 {
     /* Set window state if we have pending window flags cached */
@@ -4001,6 +4134,7 @@ void SDL_OnWindowFocusGained(SDL_Window *window)
 
 static SDL_bool SDL_ShouldMinimizeOnFocusLoss(SDL_Window *window)
 {
+    static SDL_CachedHint minimize_on_focus_loss_hint = SDL_CACHED_HINT(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS);
     const char *hint;
 
     if (!(window->flags & SDL_WINDOW_FULLSCREEN) || window->is_destroying) {
@@ -4025,7 +4159,7 @@ static SDL_bool SDL_ShouldMinimizeOnFocusLoss(SDL_Window *window)
 #endif
 
     /* Real fullscreen windows should minimize on focus loss so the desktop video mode is restored */
-    hint = SDL_GetHint(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS);
+    hint = SDL_GetCachedHint(&minimize_on_focus_loss_hint);
     if (!hint || !*hint || SDL_strcasecmp(hint, "auto") == 0) {
         if (window->fullscreen_exclusive && !SDL_ModeSwitchingEmulated(_this)) {
             return SDL_TRUE;
@@ -4033,7 +4167,7 @@ static SDL_bool SDL_ShouldMinimizeOnFocusLoss(SDL_Window *window)
             return SDL_FALSE;
         }
     }
-    return SDL_GetHintBoolean(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS, SDL_FALSE);
+    return SDL_GetStringBoolean(hint, SDL_FALSE);
 }
 
 void SDL_OnWindowFocusLost(SDL_Window *window)
@@ -5562,7 +5696,8 @@ int SDL_ShowSimpleMessageBox(SDL_MessageBoxFlags flags, const char *title, const
 
 SDL_bool SDL_ShouldAllowTopmost(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_WINDOW_ALLOW_TOPMOST, SDL_TRUE);
+    static SDL_CachedHint allow_topmost_hint = SDL_CACHED_HINT(SDL_HINT_WINDOW_ALLOW_TOPMOST);
+    return SDL_GetCachedHintBoolean(&allow_topmost_hint, SDL_TRUE);
 }
 
 int SDL_ShowWindowSystemMenu(SDL_Window *window, int x, int y)
@@ -5657,6 +5792,9 @@ void SDL_OnApplicationDidEnterBackground(void)
 
 void SDL_OnApplicationWillEnterForeground(void)
 {
+    /* We may have been suspended for a while, the battery state is stale */
+    SDL_InvalidatePowerInfo();
+
     SDL_SendAppEvent(SDL_EVENT_WILL_ENTER_FOREGROUND);
 }
 
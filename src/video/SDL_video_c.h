@@ -59,6 +59,11 @@ extern void SDL_VideoQuit(void);
 
 extern int SDL_SetWindowTextureVSync(struct SDL_VideoDevice *_this, SDL_Window *window, int vsync);
 
+/* Load a BMP into a surface made by `create`, which can return one that wraps
+   memory it owns, such as a locked texture. NULL uses SDL_CreateSurface(). */
+typedef SDL_Surface *(*SDL_LoadBMPCreateSurfaceFunc)(int width, int height, SDL_PixelFormat format, void *userdata);
+extern SDL_Surface *SDL_LoadBMP_IO_Internal(SDL_IOStream *src, SDL_bool closeio, SDL_LoadBMPCreateSurfaceFunc create, void *userdata);
+
 extern int SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a);
 
 #if defined(SDL_VIDEO_DRIVER_X11) || defined(SDL_VIDEO_DRIVER_WAYLAND) || defined(SDL_VIDEO_DRIVER_EMSCRIPTEN)
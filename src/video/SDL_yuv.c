@@ -22,6 +22,7 @@
 
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "SDL_blit.h"
 
 #include "yuv2rgb/yuv_rgb.h"
 
@@ -302,6 +303,188 @@ static int GetYUVPlanes(int width, int height, SDL_PixelFormat format, const voi
     return 0;
 }
 
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_bool yuv_rgb_avx2(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasAVX2()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_P010) {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_XBGR2101010:
+            yuvp010_xbgr2101010_avx2(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA64:
+            yuvp010_rgba64_avx2(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA128_FLOAT:
+            yuvp010_rgba128f_avx2(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+#else
+static SDL_bool yuv_rgb_avx2(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return SDL_FALSE;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_bool yuv_rgb_neon(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasNEON()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_P010) {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_XBGR2101010:
+            yuvp010_xbgr2101010_neon(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA64:
+            yuvp010_rgba64_neon(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA128_FLOAT:
+            yuvp010_rgba128f_neon(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+#else
+static SDL_bool yuv_rgb_neon(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return SDL_FALSE;
+}
+#endif
+
 #ifdef SDL_SSE2_INTRINSICS
 static SDL_bool SDL_TARGETING("sse2") yuv_rgb_sse(
     SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
@@ -579,6 +762,12 @@ static SDL_bool yuv_rgb_std(
         case SDL_PIXELFORMAT_XBGR2101010:
             yuvp010_xbgr2101010_std(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
             return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA64:
+            yuvp010_rgba64_std(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA128_FLOAT:
+            yuvp010_rgba128f_std(width, height, (const uint16_t *)y, (const uint16_t *)u, (const uint16_t *)v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
         default:
             break;
         }
@@ -586,6 +775,96 @@ static SDL_bool yuv_rgb_std(
     return SDL_FALSE;
 }
 
+/* Returns SDL_TRUE if yuv_rgb_std() handles the conversion, the SIMD paths support a subset of it */
+static SDL_bool IsYUVToRGBFastPath(SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace)
+{
+    switch (src_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+        case SDL_PIXELFORMAT_RGB24:
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            return SDL_TRUE;
+        default:
+            return SDL_FALSE;
+        }
+    case SDL_PIXELFORMAT_P010:
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_XBGR2101010:
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBA64:
+        case SDL_PIXELFORMAT_RGBA128_FLOAT:
+            /* These are only direct outputs if they keep the source transfer function */
+            return (SDL_COLORSPACETRANSFER(src_colorspace) == SDL_COLORSPACETRANSFER(dst_colorspace));
+        default:
+            return SDL_FALSE;
+        }
+    default:
+        return SDL_FALSE;
+    }
+}
+
+typedef struct
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    Uint32 width;
+    Uint32 height;
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+    Uint8 *rgb;
+    Uint32 rgb_stride;
+    YCbCrType yuv_type;
+    int rows_per_band;
+} yuv_rgb_bands;
+
+static void yuv_rgb_band(void *userdata, int band0, int band1)
+{
+    const yuv_rgb_bands *bands = (const yuv_rgb_bands *)userdata;
+    const Uint32 row = (Uint32)band0 * bands->rows_per_band;
+    const Uint32 height = SDL_min((Uint32)band1 * bands->rows_per_band, bands->height) - row;
+    /* The packed formats keep their chroma in the luma rows */
+    const Uint32 uv_row = (bands->rows_per_band == 2) ? (row / 2) * bands->uv_stride : row * bands->y_stride;
+    const Uint8 *y = bands->y + row * bands->y_stride;
+    const Uint8 *u = bands->u + uv_row;
+    const Uint8 *v = bands->v + uv_row;
+    Uint8 *rgb = bands->rgb + row * bands->rgb_stride;
+
+    if (yuv_rgb_avx2(bands->src_format, bands->dst_format, bands->width, height, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    if (yuv_rgb_neon(bands->src_format, bands->dst_format, bands->width, height, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    if (yuv_rgb_sse(bands->src_format, bands->dst_format, bands->width, height, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    if (yuv_rgb_lsx(bands->src_format, bands->dst_format, bands->width, height, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    yuv_rgb_std(bands->src_format, bands->dst_format, bands->width, height, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type);
+}
+
 int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
                                  SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
                                  SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
@@ -607,15 +886,30 @@ int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
             return -1;
         }
 
-        if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-            return 0;
-        }
-
-        if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-            return 0;
-        }
-
-        if (yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        if (IsYUVToRGBFastPath(src_format, src_colorspace, dst_format, dst_colorspace)) {
+            yuv_rgb_bands bands;
+
+            bands.src_format = src_format;
+            bands.dst_format = dst_format;
+            bands.width = width;
+            bands.height = height;
+            bands.y = y;
+            bands.u = u;
+            bands.v = v;
+            bands.y_stride = y_stride;
+            bands.uv_stride = uv_stride;
+            bands.rgb = (Uint8 *)dst;
+            bands.rgb_stride = dst_pitch;
+            bands.yuv_type = yuv_type;
+
+            /* Bands are whole rows of chroma samples, so the 2x2 formats are split on row pairs */
+            if (IsPlanar2x2Format(src_format)) {
+                bands.rows_per_band = 2;
+                SDL_RunBlitBands(width * 2, (height + 1) / 2, yuv_rgb_band, &bands);
+            } else {
+                bands.rows_per_band = 1;
+                SDL_RunBlitBands(width, height, yuv_rgb_band, &bands);
+            }
             return 0;
         }
     }
@@ -670,6 +964,86 @@ int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
     return SDL_SetError("Unsupported YUV conversion");
 }
 
+SDL_bool SDL_ConvertPixels_YUVRect_to_RGB(int width, int height, const SDL_Rect *rect,
+                                          SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, const void *src, int src_pitch,
+                                          SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, void *dst, int dst_pitch)
+{
+    const Uint8 *y = NULL;
+    const Uint8 *u = NULL;
+    const Uint8 *v = NULL;
+    Uint32 y_stride = 0;
+    Uint32 uv_stride = 0;
+    YCbCrType yuv_type = YCBCR_601_LIMITED;
+    yuv_rgb_bands bands;
+    size_t y_offset, uv_offset;
+
+    if (src_colorspace == SDL_COLORSPACE_UNKNOWN) {
+        src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
+    }
+    if (dst_colorspace == SDL_COLORSPACE_UNKNOWN) {
+        dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
+    }
+
+    /* Chroma is shared by pixel pairs, so the rectangle has to start on one */
+    if ((rect->x & 1) || (IsPlanar2x2Format(src_format) && (rect->y & 1)) ||
+        rect->x < 0 || rect->y < 0 || rect->w <= 0 || rect->h <= 0 ||
+        rect->x + rect->w > width || rect->y + rect->h > height) {
+        return SDL_FALSE;
+    }
+    if (SDL_COLORSPACEPRIMARIES(src_colorspace) != SDL_COLORSPACEPRIMARIES(dst_colorspace) ||
+        !IsYUVToRGBFastPath(src_format, src_colorspace, dst_format, dst_colorspace)) {
+        return SDL_FALSE;
+    }
+    if (GetYUVConversionType(src_colorspace, &yuv_type) < 0 ||
+        GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
+        return SDL_FALSE;
+    }
+
+    switch (src_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        y_offset = (size_t)rect->y * y_stride + rect->x;
+        uv_offset = (size_t)(rect->y / 2) * uv_stride + (rect->x / 2);
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        y_offset = (size_t)rect->y * y_stride + rect->x;
+        uv_offset = (size_t)(rect->y / 2) * uv_stride + rect->x;
+        break;
+    case SDL_PIXELFORMAT_P010:
+        y_offset = (size_t)rect->y * y_stride + rect->x * sizeof(Uint16);
+        uv_offset = (size_t)(rect->y / 2) * uv_stride + rect->x * sizeof(Uint16);
+        break;
+    default:
+        /* The packed formats keep their chroma in the luma rows */
+        y_offset = (size_t)rect->y * y_stride + rect->x * 2;
+        uv_offset = y_offset;
+        break;
+    }
+
+    bands.src_format = src_format;
+    bands.dst_format = dst_format;
+    bands.width = rect->w;
+    bands.height = rect->h;
+    bands.y = y + y_offset;
+    bands.u = u + uv_offset;
+    bands.v = v + uv_offset;
+    bands.y_stride = y_stride;
+    bands.uv_stride = uv_stride;
+    bands.rgb = (Uint8 *)dst;
+    bands.rgb_stride = dst_pitch;
+    bands.yuv_type = yuv_type;
+
+    if (IsPlanar2x2Format(src_format)) {
+        bands.rows_per_band = 2;
+        SDL_RunBlitBands(rect->w * 2, (rect->h + 1) / 2, yuv_rgb_band, &bands);
+    } else {
+        bands.rows_per_band = 1;
+        SDL_RunBlitBands(rect->w, rect->h, yuv_rgb_band, &bands);
+    }
+    return SDL_TRUE;
+}
+
 struct RGB2YUVFactors
 {
     int y_offset;
@@ -115,6 +115,11 @@ int KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
         return 0;
     }
 
+    /* The last commit is on screen now, so the overlay buffer it replaced is free */
+    if (dispdata->atomic) {
+        KMSDRM_AtomicCommitDone(_this, dispdata);
+    }
+
     /* Release the previous front buffer */
     if (windata->bo) {
         KMSDRM_gbm_surface_release_buffer(windata->gs, windata->bo);
@@ -147,7 +152,26 @@ int KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
         return 0;
     }
 
-    if (!windata->bo) {
+    if (dispdata->atomic) {
+        /* With atomic modesetting, the first swap sets the mode and the
+           following ones flip the primary plane and the overlay plane
+           together, exactly like the legacy path below does. */
+        SDL_bool async = (_this->egl_data->egl_swapinterval == 0 && viddata->async_pageflip_support);
+
+        if (KMSDRM_AtomicCommit(_this, window, fb_info->fb_id, windata->bo ? SDL_FALSE : SDL_TRUE, async) != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not queue atomic commit: %s", SDL_GetError());
+            return 0;
+        }
+
+        /* See the immediate wait for vsync below. */
+        if (windata->double_buffer && windata->waiting_for_flip) {
+            if (!KMSDRM_WaitPageflip(_this, windata)) {
+                SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Immediate wait for previous pageflip failed");
+                return 0;
+            }
+            KMSDRM_AtomicCommitDone(_this, dispdata);
+        }
+    } else if (!windata->bo) {
         /* On the first swap, immediately present the new front buffer. Before
            drmModePageFlip can be used the CRTC has to be configured to use
            the current connector and mode with drmModeSetCrtc */
@@ -47,6 +47,7 @@
 #include <dirent.h>
 #include <errno.h>
 #include <poll.h>
+#include <string.h>
 #include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/utsname.h>
@@ -288,6 +289,8 @@ static SDL_VideoDevice *KMSDRM_CreateDevice(void)
     device->MaximizeWindow = KMSDRM_MaximizeWindow;
     device->MinimizeWindow = KMSDRM_MinimizeWindow;
     device->RestoreWindow = KMSDRM_RestoreWindow;
+    device->WindowSupportsPresentMode = KMSDRM_WindowSupportsPresentMode;
+    device->SetWindowPresentMode = KMSDRM_SetWindowPresentMode;
     device->DestroyWindow = KMSDRM_DestroyWindow;
 
     device->GL_LoadLibrary = KMSDRM_GLES_LoadLibrary;
@@ -767,6 +770,450 @@ static int KMSDRM_CrtcGetOrientation(uint32_t drm_fd, uint32_t crtc_id)
     return orientation;
 }
 
+/*****************************************************************************/
+/* Atomic modesetting.                                                       */
+/* When the driver supports it we configure the CRTC and its planes with     */
+/* drmModeAtomicCommit(), which lets us put a video buffer on an overlay     */
+/* plane and flip it together with the GLES front buffer. If anything we     */
+/* need is missing, dispdata->atomic stays false and the legacy              */
+/* drmModeSetCrtc() / drmModePageFlip() path is used instead.                */
+/*****************************************************************************/
+
+static uint32_t KMSDRM_GetObjectPropId(uint32_t drm_fd, uint32_t object_id,
+                                       uint32_t object_type, char const *name)
+{
+    drmModeObjectPropertiesPtr props;
+    uint32_t prop_id;
+
+    props = KMSDRM_drmModeObjectGetProperties(drm_fd, object_id, object_type);
+    if (!props) {
+        return 0;
+    }
+
+    prop_id = KMSDRM_CrtcGetPropId(drm_fd, props, name);
+
+    KMSDRM_drmModeFreeObjectProperties(props);
+
+    return prop_id;
+}
+
+static SDL_bool KMSDRM_GetObjectPropValue(uint32_t drm_fd, uint32_t object_id,
+                                          uint32_t object_type, char const *name,
+                                          uint64_t *value)
+{
+    drmModeObjectPropertiesPtr props;
+    uint32_t i;
+    SDL_bool found = SDL_FALSE;
+
+    props = KMSDRM_drmModeObjectGetProperties(drm_fd, object_id, object_type);
+    if (!props) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; !found && i < props->count_props; ++i) {
+        drmModePropertyPtr drm_prop = KMSDRM_drmModeGetProperty(drm_fd, props->props[i]);
+
+        if (!drm_prop) {
+            continue;
+        }
+
+        if (SDL_strcmp(drm_prop->name, name) == 0) {
+            *value = props->prop_values[i];
+            found = SDL_TRUE;
+        }
+
+        KMSDRM_drmModeFreeProperty(drm_prop);
+    }
+
+    KMSDRM_drmModeFreeObjectProperties(props);
+
+    return found;
+}
+
+static SDL_bool KMSDRM_InitPlane(uint32_t drm_fd, uint32_t plane_id, KMSDRM_Plane *plane)
+{
+    drmModeObjectPropertiesPtr props;
+
+    props = KMSDRM_drmModeObjectGetProperties(drm_fd, plane_id, DRM_MODE_OBJECT_PLANE);
+    if (!props) {
+        return SDL_FALSE;
+    }
+
+    SDL_zerop(plane);
+    plane->fb_id_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "FB_ID");
+    plane->crtc_id_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "CRTC_ID");
+    plane->src_x_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "SRC_X");
+    plane->src_y_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "SRC_Y");
+    plane->src_w_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "SRC_W");
+    plane->src_h_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "SRC_H");
+    plane->crtc_x_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "CRTC_X");
+    plane->crtc_y_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "CRTC_Y");
+    plane->crtc_w_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "CRTC_W");
+    plane->crtc_h_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "CRTC_H");
+    plane->zpos_prop = KMSDRM_CrtcGetPropId(drm_fd, props, "zpos");
+
+    KMSDRM_drmModeFreeObjectProperties(props);
+
+    if (!plane->fb_id_prop || !plane->crtc_id_prop ||
+        !plane->src_x_prop || !plane->src_y_prop || !plane->src_w_prop || !plane->src_h_prop ||
+        !plane->crtc_x_prop || !plane->crtc_y_prop || !plane->crtc_w_prop || !plane->crtc_h_prop) {
+        return SDL_FALSE;
+    }
+
+    plane->plane_id = plane_id;
+    return SDL_TRUE;
+}
+
+/* Find a plane of the given type that can be used with the CRTC of this display
+   and, if format isn't 0, that can scan out buffers of that format. */
+static SDL_bool KMSDRM_FindPlane(SDL_VideoDevice *_this, SDL_DisplayData *dispdata,
+                                 uint64_t type, uint32_t format, KMSDRM_Plane *out_plane)
+{
+    SDL_VideoData *viddata = _this->internal;
+    drmModePlaneRes *plane_resources;
+    uint32_t i, j;
+    SDL_bool found = SDL_FALSE;
+
+    plane_resources = KMSDRM_drmModeGetPlaneResources(viddata->drm_fd);
+    if (!plane_resources) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; !found && i < plane_resources->count_planes; i++) {
+        drmModePlane *plane = KMSDRM_drmModeGetPlane(viddata->drm_fd, plane_resources->planes[i]);
+        uint64_t plane_type;
+        SDL_bool usable;
+
+        if (!plane) {
+            continue;
+        }
+
+        /* Skip planes that can't reach our CRTC, are in use by another CRTC,
+           or are already taken by this display. */
+        usable = (plane->possible_crtcs & (1u << dispdata->crtc_index)) &&
+                 (plane->crtc_id == 0 || plane->crtc_id == dispdata->crtc->crtc_id) &&
+                 plane->plane_id != dispdata->primary_plane.plane_id &&
+                 plane->plane_id != dispdata->overlay_plane.plane_id;
+
+        if (usable && format) {
+            usable = SDL_FALSE;
+            for (j = 0; j < plane->count_formats; j++) {
+                if (plane->formats[j] == format) {
+                    usable = SDL_TRUE;
+                    break;
+                }
+            }
+        }
+
+        if (usable &&
+            KMSDRM_GetObjectPropValue(viddata->drm_fd, plane->plane_id, DRM_MODE_OBJECT_PLANE,
+                                      "type", &plane_type) &&
+            plane_type == type) {
+            found = KMSDRM_InitPlane(viddata->drm_fd, plane->plane_id, out_plane);
+        }
+
+        KMSDRM_drmModeFreePlane(plane);
+    }
+
+    KMSDRM_drmModeFreePlaneResources(plane_resources);
+
+    return found;
+}
+
+/* Look up everything we need to drive the CRTC of this display atomically. */
+static void KMSDRM_InitAtomic(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
+{
+    SDL_VideoData *viddata = _this->internal;
+    drmModeRes *resources;
+    int i;
+
+    if (dispdata->atomic_init) {
+        return;
+    }
+
+    dispdata->atomic_init = SDL_TRUE;
+    dispdata->atomic = SDL_FALSE;
+    dispdata->crtc_index = -1;
+    SDL_zero(dispdata->primary_plane);
+    SDL_zero(dispdata->overlay_plane);
+
+    if (!viddata->atomic_support) {
+        return;
+    }
+
+    resources = KMSDRM_drmModeGetResources(viddata->drm_fd);
+    if (!resources) {
+        return;
+    }
+
+    for (i = 0; i < resources->count_crtcs; i++) {
+        if (resources->crtcs[i] == dispdata->crtc->crtc_id) {
+            dispdata->crtc_index = i;
+            break;
+        }
+    }
+
+    KMSDRM_drmModeFreeResources(resources);
+
+    if (dispdata->crtc_index < 0) {
+        return;
+    }
+
+    dispdata->crtc_active_prop = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->crtc->crtc_id,
+                                                        DRM_MODE_OBJECT_CRTC, "ACTIVE");
+    dispdata->crtc_mode_id_prop = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->crtc->crtc_id,
+                                                         DRM_MODE_OBJECT_CRTC, "MODE_ID");
+    dispdata->connector_crtc_id_prop = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->connector->connector_id,
+                                                              DRM_MODE_OBJECT_CONNECTOR, "CRTC_ID");
+
+    if (!dispdata->crtc_active_prop || !dispdata->crtc_mode_id_prop || !dispdata->connector_crtc_id_prop) {
+        return;
+    }
+
+    if (!KMSDRM_FindPlane(_this, dispdata, DRM_PLANE_TYPE_PRIMARY, 0, &dispdata->primary_plane)) {
+        return;
+    }
+
+    dispdata->atomic = SDL_TRUE;
+}
+
+/* Remove an overlay framebuffer, unless it's still wanted, on screen or in a pending commit. */
+static void KMSDRM_ReleaseOverlayFB(SDL_VideoData *viddata, SDL_DisplayData *dispdata, uint32_t fb_id)
+{
+    if (fb_id &&
+        fb_id != dispdata->overlay.fb_id &&
+        fb_id != dispdata->overlay_front_fb &&
+        fb_id != dispdata->overlay_next_fb) {
+        KMSDRM_drmModeRmFB(viddata->drm_fd, fb_id);
+    }
+}
+
+/* Turn off the overlay plane with a legacy call, outside of any commit. */
+static void KMSDRM_DisableOverlayPlane(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
+{
+    SDL_VideoData *viddata = _this->internal;
+    uint32_t front_fb = dispdata->overlay_front_fb;
+    uint32_t next_fb = dispdata->overlay_next_fb;
+
+    if (!dispdata->overlay_plane.plane_id || (!front_fb && !next_fb)) {
+        return;
+    }
+
+    KMSDRM_drmModeSetPlane(viddata->drm_fd, dispdata->overlay_plane.plane_id,
+                           dispdata->crtc->crtc_id, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    dispdata->overlay_front_fb = 0;
+    dispdata->overlay_next_fb = 0;
+    dispdata->overlay_dirty = SDL_TRUE;
+    KMSDRM_ReleaseOverlayFB(viddata, dispdata, front_fb);
+    KMSDRM_ReleaseOverlayFB(viddata, dispdata, next_fb);
+}
+
+static SDL_bool KMSDRM_AtomicSetPlane(drmModeAtomicReq *req, const KMSDRM_Plane *plane,
+                                      uint32_t crtc_id, uint32_t fb_id,
+                                      const SDL_Rect *src_rect, const SDL_Rect *dst_rect,
+                                      Sint64 zpos)
+{
+    SDL_bool ok = SDL_TRUE;
+
+    ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->fb_id_prop, fb_id) >= 0);
+    ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->crtc_id_prop, fb_id ? crtc_id : 0) >= 0);
+    if (fb_id) {
+        /* Source coordinates are in 16.16 fixed point */
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->src_x_prop, (uint64_t)src_rect->x << 16) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->src_y_prop, (uint64_t)src_rect->y << 16) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->src_w_prop, (uint64_t)src_rect->w << 16) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->src_h_prop, (uint64_t)src_rect->h << 16) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->crtc_x_prop, (uint64_t)(int64_t)dst_rect->x) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->crtc_y_prop, (uint64_t)(int64_t)dst_rect->y) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->crtc_w_prop, dst_rect->w) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->crtc_h_prop, dst_rect->h) >= 0);
+        if (zpos >= 0 && plane->zpos_prop) {
+            ok &= (KMSDRM_drmModeAtomicAddProperty(req, plane->plane_id, plane->zpos_prop, (uint64_t)zpos) >= 0);
+        }
+    }
+    return ok;
+}
+
+/* Build and submit one atomic request: the primary plane showing fb_id,
+   the overlay plane (or its removal), and the whole mode if mode_blob_id isn't 0. */
+static int KMSDRM_AtomicRequest(SDL_VideoDevice *_this, SDL_Window *window, uint32_t fb_id,
+                                uint32_t mode_blob_id, SDL_bool show_overlay, uint32_t flags)
+{
+    SDL_VideoData *viddata = _this->internal;
+    SDL_WindowData *windata = window->internal;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    const uint32_t crtc_id = dispdata->crtc->crtc_id;
+    const SDL_Rect screen_rect = { 0, 0, dispdata->mode.hdisplay, dispdata->mode.vdisplay };
+    drmModeAtomicReq *req;
+    SDL_bool ok = SDL_TRUE;
+    int ret;
+
+    req = KMSDRM_drmModeAtomicAlloc();
+    if (!req) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (mode_blob_id) {
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, dispdata->connector->connector_id,
+                                               dispdata->connector_crtc_id_prop, crtc_id) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, crtc_id, dispdata->crtc_mode_id_prop, mode_blob_id) >= 0);
+        ok &= (KMSDRM_drmModeAtomicAddProperty(req, crtc_id, dispdata->crtc_active_prop, 1) >= 0);
+    }
+
+    ok &= KMSDRM_AtomicSetPlane(req, &dispdata->primary_plane, crtc_id, fb_id,
+                                &screen_rect, &screen_rect, -1);
+
+    if (dispdata->overlay_plane.plane_id) {
+        const KMSDRM_Overlay *overlay = &dispdata->overlay;
+
+        ok &= KMSDRM_AtomicSetPlane(req, &dispdata->overlay_plane, crtc_id,
+                                    show_overlay ? overlay->fb_id : 0,
+                                    &overlay->src_rect, &overlay->dst_rect, overlay->zpos);
+    }
+
+    if (ok) {
+        ret = KMSDRM_drmModeAtomicCommit(viddata->drm_fd, req, flags, &windata->waiting_for_flip);
+    } else {
+        errno = ENOMEM;
+        ret = -1;
+    }
+
+    KMSDRM_drmModeAtomicFree(req);
+
+    return ret;
+}
+
+/* Called once the last commit is on screen: the overlay FB it replaced can go. */
+void KMSDRM_AtomicCommitDone(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
+{
+    uint32_t old_fb = dispdata->overlay_front_fb;
+
+    if (old_fb != dispdata->overlay_next_fb) {
+        dispdata->overlay_front_fb = dispdata->overlay_next_fb;
+        KMSDRM_ReleaseOverlayFB(_this->internal, dispdata, old_fb);
+    }
+}
+
+/* Show fb_id on the primary plane, together with the current overlay.
+   With modeset, the connector, mode and CRTC are (re)configured too and the
+   commit blocks; otherwise it completes with a page flip event, like
+   drmModePageFlip() would. */
+int KMSDRM_AtomicCommit(SDL_VideoDevice *_this, SDL_Window *window, uint32_t fb_id, SDL_bool modeset, SDL_bool async)
+{
+    SDL_VideoData *viddata = _this->internal;
+    SDL_WindowData *windata = window->internal;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    SDL_bool show_overlay = (dispdata->overlay.fb_id != 0);
+    uint32_t mode_blob_id = 0;
+    uint32_t flags;
+    uint32_t old_front_fb, old_next_fb;
+    int ret;
+
+    if (modeset) {
+        if (KMSDRM_drmModeCreatePropertyBlob(viddata->drm_fd, &dispdata->mode,
+                                             sizeof(dispdata->mode), &mode_blob_id) != 0) {
+            return SDL_SetError("Couldn't create the DRM mode blob");
+        }
+    }
+
+    /* A new mode or a new overlay configuration may be more than the display
+       controller can do, so check before committing: a failed commit can't
+       be undone on screen. If it's the overlay that doesn't fit, drop it and
+       keep the GLES output running. */
+    if (modeset || dispdata->overlay_dirty) {
+        flags = DRM_MODE_ATOMIC_TEST_ONLY;
+        if (modeset) {
+            flags |= DRM_MODE_ATOMIC_ALLOW_MODESET;
+        }
+
+        ret = KMSDRM_AtomicRequest(_this, window, fb_id, mode_blob_id, show_overlay, flags);
+        if (ret != 0 && show_overlay) {
+            uint32_t rejected_fb = dispdata->overlay.fb_id;
+
+            SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "The display can't show this overlay, hiding it");
+            dispdata->overlay.fb_id = 0;
+            KMSDRM_ReleaseOverlayFB(viddata, dispdata, rejected_fb);
+            show_overlay = SDL_FALSE;
+
+            ret = KMSDRM_AtomicRequest(_this, window, fb_id, mode_blob_id, show_overlay, flags);
+        }
+
+        if (ret != 0) {
+            if (mode_blob_id) {
+                KMSDRM_drmModeDestroyPropertyBlob(viddata->drm_fd, mode_blob_id);
+            }
+            return SDL_SetError("Atomic test commit failed: %s", strerror(errno));
+        }
+    }
+
+    if (modeset) {
+        flags = DRM_MODE_ATOMIC_ALLOW_MODESET;
+    } else {
+        flags = DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT;
+        if (async) {
+            flags |= DRM_MODE_PAGE_FLIP_ASYNC;
+        }
+    }
+
+    ret = KMSDRM_AtomicRequest(_this, window, fb_id, mode_blob_id, show_overlay, flags);
+    if (ret != 0 && (flags & DRM_MODE_PAGE_FLIP_ASYNC)) {
+        /* Many drivers refuse async flips that touch more than the primary plane */
+        flags &= ~DRM_MODE_PAGE_FLIP_ASYNC;
+        ret = KMSDRM_AtomicRequest(_this, window, fb_id, mode_blob_id, show_overlay, flags);
+    }
+
+    if (ret != 0) {
+        if (mode_blob_id) {
+            KMSDRM_drmModeDestroyPropertyBlob(viddata->drm_fd, mode_blob_id);
+        }
+        return SDL_SetError("Atomic commit failed: %s", strerror(errno));
+    }
+
+    if (modeset) {
+        if (dispdata->mode_blob_id) {
+            KMSDRM_drmModeDestroyPropertyBlob(viddata->drm_fd, dispdata->mode_blob_id);
+        }
+        dispdata->mode_blob_id = mode_blob_id;
+    } else {
+        windata->waiting_for_flip = SDL_TRUE;
+    }
+
+    old_front_fb = dispdata->overlay_front_fb;
+    old_next_fb = dispdata->overlay_next_fb;
+    dispdata->overlay_next_fb = show_overlay ? dispdata->overlay.fb_id : 0;
+    if (modeset) {
+        /* Blocking commit, there is no flip event to wait for. */
+        dispdata->overlay_front_fb = dispdata->overlay_next_fb;
+    }
+    dispdata->overlay_dirty = SDL_FALSE;
+    KMSDRM_ReleaseOverlayFB(viddata, dispdata, old_front_fb);
+    KMSDRM_ReleaseOverlayFB(viddata, dispdata, old_next_fb);
+
+    return 0;
+}
+
+/* Free the overlay and mode blob before the DRM fd goes away. */
+static void KMSDRM_DeinitAtomic(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
+{
+    SDL_VideoData *viddata = _this->internal;
+    uint32_t fb_id = dispdata->overlay.fb_id;
+
+    KMSDRM_DisableOverlayPlane(_this, dispdata);
+
+    dispdata->overlay.fb_id = 0;
+    KMSDRM_ReleaseOverlayFB(viddata, dispdata, fb_id);
+
+    if (dispdata->mode_blob_id) {
+        KMSDRM_drmModeDestroyPropertyBlob(viddata->drm_fd, dispdata->mode_blob_id);
+        dispdata->mode_blob_id = 0;
+    }
+
+    dispdata->atomic_init = SDL_FALSE;
+    dispdata->atomic = SDL_FALSE;
+}
+
 /* Gets a DRM connector, builds an SDL_Display with it, and adds it to the
    list of SDL Displays in _this->displays[]  */
 static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connector, drmModeRes *resources)
@@ -936,7 +1383,8 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     /* save previous vrr state */
     dispdata->saved_vrr = KMSDRM_CrtcGetVrr(viddata->drm_fd, crtc->crtc_id);
     /* try to enable vrr */
-    if (KMSDRM_ConnectorCheckVrrCapable(viddata->drm_fd, connector->connector_id, "VRR_CAPABLE")) {
+    dispdata->vrr_capable = KMSDRM_ConnectorCheckVrrCapable(viddata->drm_fd, connector->connector_id, "VRR_CAPABLE");
+    if (dispdata->vrr_capable) {
         SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Enabling VRR");
         KMSDRM_CrtcSetVrr(viddata->drm_fd, crtc->crtc_id, SDL_TRUE);
     }
@@ -1107,6 +1555,14 @@ static int KMSDRM_GBMInit(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
     /* Set the FD we just opened as current DRM master. */
     KMSDRM_drmSetMaster(viddata->drm_fd);
 
+    /* Atomic modesetting needs universal planes, so the primary plane shows up. */
+    viddata->atomic_support = SDL_FALSE;
+    if (SDL_GetHintBoolean(SDL_HINT_KMSDRM_ATOMIC, SDL_FALSE) &&
+        KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) == 0 &&
+        KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0) {
+        viddata->atomic_support = SDL_TRUE;
+    }
+
     /* Create the GBM device. */
     viddata->gbm_dev = KMSDRM_gbm_create_device(viddata->drm_fd);
     if (!viddata->gbm_dev) {
@@ -1151,6 +1607,15 @@ static void KMSDRM_DestroySurfaces(SDL_VideoDevice *_this, SDL_Window *window)
     /**********************************************/
     /*KMSDRM_WaitPageflip(_this, windata);*/
 
+    /*****************************************************************/
+    /* drmModeSetCrtc() only knows about the primary plane, so turn  */
+    /* the overlay off first. It comes back with the next modeset.   */
+    /*****************************************************************/
+
+    if (dispdata->atomic) {
+        KMSDRM_DisableOverlayPlane(_this, dispdata);
+    }
+
     /************************************************************************/
     /* Restore the original CRTC configuration: configure the crtc with the */
     /* original video mode and make it point to the original TTY buffer.    */
@@ -1467,6 +1932,7 @@ void KMSDRM_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
     SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
     SDL_VideoData *viddata;
     SDL_bool is_vulkan = window->flags & SDL_WINDOW_VULKAN; /* Is this a VK window? */
+    SDL_DisplayID *displays;
     unsigned int i, j;
 
     if (!windata) {
@@ -1499,6 +1965,18 @@ void KMSDRM_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
                 _this->gl_config.driver_loaded = 0;
             }
 
+            /* Free the overlays and mode blobs while the DRM fd is still open. */
+            displays = SDL_GetDisplays(NULL);
+            if (displays) {
+                for (i = 0; displays[i]; ++i) {
+                    SDL_DisplayData *display_data = SDL_GetDisplayDriverData(displays[i]);
+                    if (display_data) {
+                        KMSDRM_DeinitAtomic(_this, display_data);
+                    }
+                }
+                SDL_free(displays);
+            }
+
             /* Free display plane, and destroy GBM device. */
             KMSDRM_GBMDeinit(_this, dispdata);
         }
@@ -1602,6 +2080,9 @@ int KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Properti
             }
         }
 
+        /* Find out whether we can drive this display with atomic commits. */
+        KMSDRM_InitAtomic(_this, dispdata);
+
         /* Manually load the GL library. KMSDRM_EGL_LoadLibrary() has already
            been called by SDL_CreateWindow() but we don't do anything there,
            our KMSDRM_EGL_LoadLibrary() is a dummy precisely to be able to load it here.
@@ -1668,6 +2149,13 @@ int KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Properti
 
     viddata->windows[viddata->num_windows++] = window;
 
+    /* Windows on VRR capable displays start out with VRR on, a previous
+       window may have restored the state from before SDL was started. */
+    if (dispdata->vrr_capable) {
+        KMSDRM_CrtcSetVrr(viddata->drm_fd, dispdata->crtc->crtc_id, SDL_TRUE);
+        window->present_mode = SDL_PRESENTMODE_VRR;
+    }
+
     /* If we have just created a Vulkan window, establish that we are in Vulkan mode now. */
     viddata->vulkan_mode = is_vulkan;
 
@@ -1685,6 +2173,25 @@ int KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Properti
     return ret;
 }
 
+SDL_bool KMSDRM_WindowSupportsPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode)
+{
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+
+    return (mode == SDL_PRESENTMODE_VRR && dispdata && dispdata->vrr_capable);
+}
+
+int KMSDRM_SetWindowPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode)
+{
+    SDL_VideoData *viddata = _this->internal;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+
+    if (!dispdata || !dispdata->crtc) {
+        return SDL_SetError("Window isn't on a display");
+    }
+    KMSDRM_CrtcSetVrr(viddata->drm_fd, dispdata->crtc->crtc_id, (mode == SDL_PRESENTMODE_VRR));
+    return 0;
+}
+
 void KMSDRM_SetWindowTitle(SDL_VideoDevice *_this, SDL_Window *window)
 {
 }
@@ -1726,4 +2233,260 @@ void KMSDRM_RestoreWindow(SDL_VideoDevice *_this, SDL_Window *window)
 {
 }
 
+
+/*****************************************************************************/
+/* Overlay planes.                                                           */
+/*****************************************************************************/
+
+#define KMSDRM_FOURCC(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+/* Map an SDL pixel format to a DRM fourcc, and report how many planes it has */
+static uint32_t KMSDRM_DRMFormatFromSDL(SDL_PixelFormat format, int *num_planes)
+{
+    *num_planes = 1;
+
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+        return KMSDRM_FOURCC('A', 'R', '2', '4');
+    case SDL_PIXELFORMAT_XRGB8888:
+        return KMSDRM_FOURCC('X', 'R', '2', '4');
+    case SDL_PIXELFORMAT_ABGR8888:
+        return KMSDRM_FOURCC('A', 'B', '2', '4');
+    case SDL_PIXELFORMAT_XBGR8888:
+        return KMSDRM_FOURCC('X', 'B', '2', '4');
+    case SDL_PIXELFORMAT_YUY2:
+        return KMSDRM_FOURCC('Y', 'U', 'Y', 'V');
+    case SDL_PIXELFORMAT_UYVY:
+        return KMSDRM_FOURCC('U', 'Y', 'V', 'Y');
+    case SDL_PIXELFORMAT_YVYU:
+        return KMSDRM_FOURCC('Y', 'V', 'Y', 'U');
+    case SDL_PIXELFORMAT_NV12:
+        *num_planes = 2;
+        return KMSDRM_FOURCC('N', 'V', '1', '2');
+    case SDL_PIXELFORMAT_NV21:
+        *num_planes = 2;
+        return KMSDRM_FOURCC('N', 'V', '2', '1');
+    case SDL_PIXELFORMAT_P010:
+        *num_planes = 2;
+        return KMSDRM_FOURCC('P', '0', '1', '0');
+    case SDL_PIXELFORMAT_IYUV:
+        *num_planes = 3;
+        return KMSDRM_FOURCC('Y', 'U', '1', '2');
+    case SDL_PIXELFORMAT_YV12:
+        *num_planes = 3;
+        return KMSDRM_FOURCC('Y', 'V', '1', '2');
+    default:
+        return 0;
+    }
+}
+
+/* Turn a DMA-BUF described by props into a DRM framebuffer */
+static int KMSDRM_ImportOverlayFB(SDL_VideoData *viddata, SDL_PropertiesID props,
+                                  uint32_t drm_format, int num_planes,
+                                  int width, int height, uint32_t *fb_id)
+{
+    static const char *fd_props[3] = {
+        SDL_PROP_KMSDRM_OVERLAY_PLANE0_FD_NUMBER,
+        SDL_PROP_KMSDRM_OVERLAY_PLANE1_FD_NUMBER,
+        SDL_PROP_KMSDRM_OVERLAY_PLANE2_FD_NUMBER
+    };
+    static const char *pitch_props[3] = {
+        SDL_PROP_KMSDRM_OVERLAY_PLANE0_PITCH_NUMBER,
+        SDL_PROP_KMSDRM_OVERLAY_PLANE1_PITCH_NUMBER,
+        SDL_PROP_KMSDRM_OVERLAY_PLANE2_PITCH_NUMBER
+    };
+    static const char *offset_props[3] = {
+        SDL_PROP_KMSDRM_OVERLAY_PLANE0_OFFSET_NUMBER,
+        SDL_PROP_KMSDRM_OVERLAY_PLANE1_OFFSET_NUMBER,
+        SDL_PROP_KMSDRM_OVERLAY_PLANE2_OFFSET_NUMBER
+    };
+    uint32_t handles[4] = { 0, 0, 0, 0 };
+    uint32_t pitches[4] = { 0, 0, 0, 0 };
+    uint32_t offsets[4] = { 0, 0, 0, 0 };
+    uint64_t modifiers[4] = { 0, 0, 0, 0 };
+    uint64_t modifier;
+    int fd = -1;
+    int i, j, ret = 0;
+
+    modifier = (uint64_t)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_MODIFIER_NUMBER, (Sint64)DRM_FORMAT_MOD_INVALID);
+
+    for (i = 0; i < num_planes; i++) {
+        Sint64 pitch, offset;
+
+        /* Chroma planes default to following the luma plane in the same buffer */
+        fd = (int)SDL_GetNumberProperty(props, fd_props[i], fd);
+        if (i == 0) {
+            pitch = SDL_GetNumberProperty(props, pitch_props[i], 0);
+            offset = SDL_GetNumberProperty(props, offset_props[i], 0);
+        } else {
+            Sint64 prev_height = (i == 1) ? height : (height + 1) / 2;
+
+            pitch = SDL_GetNumberProperty(props, pitch_props[i], (num_planes == 3) ? (pitches[0] + 1) / 2 : pitches[0]);
+            offset = SDL_GetNumberProperty(props, offset_props[i], offsets[i - 1] + pitches[i - 1] * prev_height);
+        }
+
+        if (fd < 0) {
+            ret = SDL_SetError("Missing DMA-BUF file descriptor for overlay plane %d", i);
+            break;
+        }
+        if (pitch <= 0 || offset < 0) {
+            ret = SDL_SetError("Invalid pitch or offset for overlay plane %d", i);
+            break;
+        }
+
+        if (KMSDRM_drmPrimeFDToHandle(viddata->drm_fd, fd, &handles[i]) != 0) {
+            ret = SDL_SetError("Couldn't import DMA-BUF for overlay plane %d: %s", i, strerror(errno));
+            break;
+        }
+        pitches[i] = (uint32_t)pitch;
+        offsets[i] = (uint32_t)offset;
+        modifiers[i] = modifier;
+    }
+
+    if (ret == 0) {
+        if (modifier != DRM_FORMAT_MOD_INVALID) {
+            ret = KMSDRM_drmModeAddFB2WithModifiers(viddata->drm_fd, width, height, drm_format,
+                                                    handles, pitches, offsets, modifiers,
+                                                    fb_id, DRM_MODE_FB_MODIFIERS);
+        } else {
+            ret = KMSDRM_drmModeAddFB2(viddata->drm_fd, width, height, drm_format,
+                                       handles, pitches, offsets, fb_id, 0);
+        }
+        if (ret != 0) {
+            ret = SDL_SetError("Couldn't create overlay framebuffer: %s", strerror(errno));
+        }
+    }
+
+    /* The framebuffer holds its own references to the buffers, so drop our
+       GEM handles. Planes sharing a DMA-BUF share a handle, close it once. */
+    for (i = 0; i < num_planes; i++) {
+        SDL_bool duplicate = SDL_FALSE;
+
+        for (j = 0; j < i; j++) {
+            if (handles[j] == handles[i]) {
+                duplicate = SDL_TRUE;
+            }
+        }
+        if (handles[i] && !duplicate) {
+            struct drm_gem_close gem_close;
+
+            SDL_zero(gem_close);
+            gem_close.handle = handles[i];
+            KMSDRM_drmIoctl(viddata->drm_fd, DRM_IOCTL_GEM_CLOSE, &gem_close);
+        }
+    }
+
+    return ret;
+}
+
+int SDL_SetKMSDRMWindowOverlay(SDL_Window *window, SDL_PropertiesID props)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+    SDL_VideoData *viddata;
+    SDL_DisplayData *dispdata;
+    SDL_PixelFormat format;
+    KMSDRM_Overlay overlay;
+    uint32_t drm_format, old_fb;
+    int num_planes, width, height;
+
+    if (!_this) {
+        return SDL_SetError("Video subsystem has not been initialized");
+    }
+    if (!SDL_ObjectValid(window, SDL_OBJECT_TYPE_WINDOW)) {
+        return SDL_InvalidParamError("window");
+    }
+    if (SDL_strcmp(_this->name, "kmsdrm") != 0) {
+        return SDL_SetError("Overlays are only available with the kmsdrm video driver");
+    }
+
+    viddata = _this->internal;
+    dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    if (!window->internal || !viddata->gbm_init || (window->flags & SDL_WINDOW_VULKAN)) {
+        return SDL_SetError("Overlays are only available on OpenGL ES windows");
+    }
+    if (!dispdata->atomic) {
+        return SDL_SetError("Overlays need atomic modesetting, which isn't available");
+    }
+
+    if (!props) {
+        old_fb = dispdata->overlay.fb_id;
+        dispdata->overlay.fb_id = 0;
+        dispdata->overlay_dirty = SDL_TRUE;
+        KMSDRM_ReleaseOverlayFB(viddata, dispdata, old_fb);
+        return 0;
+    }
+
+    format = (SDL_PixelFormat)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_FORMAT_NUMBER, SDL_PIXELFORMAT_NV12);
+    drm_format = KMSDRM_DRMFormatFromSDL(format, &num_planes);
+    if (!drm_format) {
+        return SDL_SetError("Unsupported overlay format %s", SDL_GetPixelFormatName(format));
+    }
+
+    width = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_WIDTH_NUMBER, 0);
+    height = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_HEIGHT_NUMBER, 0);
+    if (width <= 0 || height <= 0) {
+        return SDL_SetError("Invalid overlay size %dx%d", width, height);
+    }
+
+    overlay.src_rect.x = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_SRC_X_NUMBER, 0);
+    overlay.src_rect.y = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_SRC_Y_NUMBER, 0);
+    overlay.src_rect.w = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_SRC_W_NUMBER, width - overlay.src_rect.x);
+    overlay.src_rect.h = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_SRC_H_NUMBER, height - overlay.src_rect.y);
+    if (overlay.src_rect.x < 0 || overlay.src_rect.y < 0 ||
+        overlay.src_rect.w <= 0 || overlay.src_rect.h <= 0 ||
+        overlay.src_rect.x + overlay.src_rect.w > width ||
+        overlay.src_rect.y + overlay.src_rect.h > height) {
+        return SDL_SetError("Overlay source rectangle is outside of the buffer");
+    }
+
+    overlay.dst_rect.x = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_X_NUMBER, 0);
+    overlay.dst_rect.y = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_Y_NUMBER, 0);
+    overlay.dst_rect.w = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_W_NUMBER, dispdata->mode.hdisplay);
+    overlay.dst_rect.h = (int)SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_H_NUMBER, dispdata->mode.vdisplay);
+    if (overlay.dst_rect.w <= 0 || overlay.dst_rect.h <= 0) {
+        return SDL_SetError("Invalid overlay destination size");
+    }
+
+    overlay.zpos = SDL_GetNumberProperty(props, SDL_PROP_KMSDRM_OVERLAY_ZPOS_NUMBER, -1);
+
+    /* Keep using the plane we already have if it can scan out this format. */
+    if (dispdata->overlay_plane.plane_id) {
+        drmModePlane *plane = KMSDRM_drmModeGetPlane(viddata->drm_fd, dispdata->overlay_plane.plane_id);
+        SDL_bool supported = SDL_FALSE;
+        uint32_t i;
+
+        if (plane) {
+            for (i = 0; i < plane->count_formats; i++) {
+                if (plane->formats[i] == drm_format) {
+                    supported = SDL_TRUE;
+                    break;
+                }
+            }
+            KMSDRM_drmModeFreePlane(plane);
+        }
+
+        if (!supported) {
+            KMSDRM_DisableOverlayPlane(_this, dispdata);
+            SDL_zero(dispdata->overlay_plane);
+        }
+    }
+
+    if (!dispdata->overlay_plane.plane_id &&
+        !KMSDRM_FindPlane(_this, dispdata, DRM_PLANE_TYPE_OVERLAY, drm_format, &dispdata->overlay_plane)) {
+        return SDL_SetError("No overlay plane can show %s buffers", SDL_GetPixelFormatName(format));
+    }
+
+    if (KMSDRM_ImportOverlayFB(viddata, props, drm_format, num_planes, width, height, &overlay.fb_id) != 0) {
+        return -1;
+    }
+
+    /* The new framebuffer goes on screen with the next SDL_GL_SwapWindow() */
+    old_fb = dispdata->overlay.fb_id;
+    dispdata->overlay = overlay;
+    dispdata->overlay_dirty = SDL_TRUE;
+    KMSDRM_ReleaseOverlayFB(viddata, dispdata, old_fb);
+
+    return 0;
+}
+
 #endif /* SDL_VIDEO_DRIVER_KMSDRM */
@@ -65,6 +65,30 @@
 #define DRM_CAP_CURSOR_HEIGHT   9
 #endif
 
+#ifndef DRM_CLIENT_CAP_UNIVERSAL_PLANES
+#define DRM_CLIENT_CAP_UNIVERSAL_PLANES 2
+#endif
+
+#ifndef DRM_CLIENT_CAP_ATOMIC
+#define DRM_CLIENT_CAP_ATOMIC 3
+#endif
+
+#ifndef DRM_MODE_OBJECT_PLANE
+#define DRM_MODE_OBJECT_PLANE       0xeeeeeeee
+#endif
+
+#ifndef DRM_MODE_ATOMIC_TEST_ONLY
+#define DRM_MODE_ATOMIC_TEST_ONLY       0x0100
+#define DRM_MODE_ATOMIC_NONBLOCK        0x0200
+#define DRM_MODE_ATOMIC_ALLOW_MODESET   0x0400
+#endif
+
+#ifndef DRM_PLANE_TYPE_OVERLAY
+#define DRM_PLANE_TYPE_OVERLAY  0
+#define DRM_PLANE_TYPE_PRIMARY  1
+#define DRM_PLANE_TYPE_CURSOR   2
+#endif
+
 #ifndef GBM_FORMAT_ARGB8888
 #define GBM_FORMAT_ARGB8888  ((uint32_t)('A') | ((uint32_t)('R') << 8) | ((uint32_t)('2') << 16) | ((uint32_t)('4') << 24))
 #define GBM_BO_USE_CURSOR   (1 << 1)
@@ -83,6 +107,7 @@ struct SDL_VideoData
     SDL_bool video_init;             /* Has VideoInit succeeded? */
     SDL_bool vulkan_mode;            /* Are we in Vulkan mode? One VK window is enough to be. */
     SDL_bool async_pageflip_support; /* Does the hardware support async. pageflips? */
+    SDL_bool atomic_support;         /* Does the driver support atomic modesetting? */
 
     SDL_Window **windows;
     int max_windows;
@@ -94,6 +119,26 @@ struct SDL_VideoData
 
 };
 
+/* A DRM plane, with the IDs of the properties we set on it in atomic commits */
+typedef struct KMSDRM_Plane
+{
+    uint32_t plane_id; /* 0 if no plane has been picked yet */
+    uint32_t fb_id_prop;
+    uint32_t crtc_id_prop;
+    uint32_t src_x_prop, src_y_prop, src_w_prop, src_h_prop;
+    uint32_t crtc_x_prop, crtc_y_prop, crtc_w_prop, crtc_h_prop;
+    uint32_t zpos_prop; /* 0 if the plane has no zpos property */
+} KMSDRM_Plane;
+
+/* What SDL_SetKMSDRMWindowOverlay() asked us to show on the overlay plane */
+typedef struct KMSDRM_Overlay
+{
+    uint32_t fb_id; /* 0 if the overlay is hidden */
+    SDL_Rect src_rect;
+    SDL_Rect dst_rect;
+    Sint64 zpos; /* -1 to leave the plane's zpos alone */
+} KMSDRM_Overlay;
+
 struct SDL_DisplayModeData
 {
     int mode_index;
@@ -109,6 +154,7 @@ struct SDL_DisplayData
 
     drmModeCrtc *saved_crtc; /* CRTC to restore on quit */
     SDL_bool saved_vrr;
+    SDL_bool vrr_capable;
 
     /* DRM & GBM cursor stuff lives here, not in an SDL_Cursor's internal struct,
        because setting/unsetting up these is done on window creation/destruction,
@@ -119,6 +165,25 @@ struct SDL_DisplayData
     uint64_t cursor_w, cursor_h;
 
     SDL_bool default_cursor_init;
+
+    /* Atomic modesetting state. If the driver or the CRTC doesn't support it,
+       "atomic" is false and we use drmModeSetCrtc() and drmModePageFlip(). */
+    SDL_bool atomic_init;
+    SDL_bool atomic;
+    int crtc_index;
+    uint32_t crtc_active_prop;
+    uint32_t crtc_mode_id_prop;
+    uint32_t connector_crtc_id_prop;
+    uint32_t mode_blob_id;
+    KMSDRM_Plane primary_plane;
+    KMSDRM_Plane overlay_plane;
+
+    /* The overlay framebuffer we were asked to show, the one being scanned
+       out and the one in the pending commit. They can all be the same FB. */
+    KMSDRM_Overlay overlay;
+    SDL_bool overlay_dirty;
+    uint32_t overlay_front_fb;
+    uint32_t overlay_next_fb;
 };
 
 struct SDL_WindowData
@@ -150,6 +215,8 @@ int KMSDRM_CreateSurfaces(SDL_VideoDevice *_this, SDL_Window *window);
 KMSDRM_FBInfo *KMSDRM_FBFromBO(SDL_VideoDevice *_this, struct gbm_bo *bo);
 KMSDRM_FBInfo *KMSDRM_FBFromBO2(SDL_VideoDevice *_this, struct gbm_bo *bo, int w, int h);
 SDL_bool KMSDRM_WaitPageflip(SDL_VideoDevice *_this, SDL_WindowData *windata);
+void KMSDRM_AtomicCommitDone(SDL_VideoDevice *_this, SDL_DisplayData *dispdata);
+int KMSDRM_AtomicCommit(SDL_VideoDevice *_this, SDL_Window *window, uint32_t fb_id, SDL_bool modeset, SDL_bool async);
 
 /****************************************************************************/
 /* SDL_VideoDevice functions declaration                                    */
@@ -162,6 +229,8 @@ int KMSDRM_GetDisplayModes(SDL_VideoDevice *_this, SDL_VideoDisplay *display);
 int KMSDRM_SetDisplayMode(SDL_VideoDevice *_this, SDL_VideoDisplay *display, SDL_DisplayMode *mode);
 int KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_PropertiesID create_props);
 void KMSDRM_SetWindowTitle(SDL_VideoDevice *_this, SDL_Window *window);
+SDL_bool KMSDRM_WindowSupportsPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode);
+int KMSDRM_SetWindowPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode);
 int KMSDRM_SetWindowPosition(SDL_VideoDevice *_this, SDL_Window *window);
 void KMSDRM_SetWindowSize(SDL_VideoDevice *_this, SDL_Window *window);
 int KMSDRM_SetWindowFullscreen(SDL_VideoDevice *_this, SDL_Window *window, SDL_VideoDisplay *_display, SDL_FullscreenOp fullscreen);
@@ -85,6 +85,27 @@ void OFFSCREEN_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
 
 void OFFSCREEN_SetWindowSize(SDL_VideoDevice *_this, SDL_Window *window)
 {
+#ifdef SDL_VIDEO_OPENGL_EGL
+    SDL_WindowData *offscreen_window = window->internal;
+
+    /* Pbuffers can't be resized, so replace it with one of the new size */
+    if (offscreen_window->egl_surface != EGL_NO_SURFACE &&
+        (window->floating.w != window->w || window->floating.h != window->h)) {
+        EGLSurface egl_surface = SDL_EGL_CreateOffscreenSurface(_this, window->floating.w, window->floating.h);
+
+        if (egl_surface != EGL_NO_SURFACE) {
+            const SDL_bool current = (SDL_GL_GetCurrentWindow() == window);
+            SDL_GLContext context = SDL_GL_GetCurrentContext();
+
+            if (current) {
+                SDL_EGL_MakeCurrent(_this, egl_surface, context);
+            }
+            SDL_EGL_DestroySurface(_this, offscreen_window->egl_surface);
+            offscreen_window->egl_surface = egl_surface;
+        }
+    }
+#endif /* SDL_VIDEO_OPENGL_EGL */
+
     SDL_SendWindowEvent(window, SDL_EVENT_WINDOW_RESIZED, window->floating.w, window->floating.h);
 }
 #endif /* SDL_VIDEO_DRIVER_OFFSCREEN */
@@ -628,6 +628,390 @@ __EOF__
 __EOF__
 }
 
+# The byte offset of each channel within a pixel, as it is laid out in memory
+# on a little endian machine.  Channels that aren't listed aren't stored.
+my %format_byte = (
+    "XRGB8888" => { "R" => 2, "G" => 1, "B" => 0 },
+    "XBGR8888" => { "B" => 2, "G" => 1, "R" => 0 },
+    "ARGB8888" => { "A" => 3, "R" => 2, "G" => 1, "B" => 0 },
+    "RGBA8888" => { "R" => 3, "G" => 2, "B" => 1, "A" => 0 },
+    "ABGR8888" => { "A" => 3, "B" => 2, "G" => 1, "R" => 0 },
+    "BGRA8888" => { "B" => 3, "G" => 2, "R" => 1, "A" => 0 },
+);
+
+# The vectorized modulate and blend blitters, in order of preference
+my @simd_variants = (
+    {
+        "name" => "AVX2",
+        "guard" => "#ifdef SDL_AVX2_INTRINSICS",
+        "cpu" => "SDL_CPU_AVX2",
+        "target" => "SDL_TARGETING(\"avx2\") ",
+        "type" => "__m256i",
+        "pixels" => 8,
+        "prefix" => "_mm256_",
+        "load" => "_mm256_loadu_si256((const __m256i *)",
+        "store" => "_mm256_storeu_si256((__m256i *)",
+    },
+    {
+        "name" => "SSE41",
+        "guard" => "#ifdef SDL_SSE4_1_INTRINSICS",
+        "cpu" => "SDL_CPU_SSE4_1",
+        "target" => "SDL_TARGETING(\"sse4.1\") ",
+        "type" => "__m128i",
+        "pixels" => 4,
+        "prefix" => "_mm_",
+        "load" => "_mm_loadu_si128((const __m128i *)",
+        "store" => "_mm_storeu_si128((__m128i *)",
+    },
+    {
+        "name" => "NEON",
+        "guard" => "#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)",
+        "cpu" => "SDL_CPU_NEON",
+        "pixels" => 16,
+    },
+);
+
+# Returns the channel stored at each byte of a destination pixel, with the
+# unused byte of formats without alpha treated as alpha, so it always ends
+# up in the top byte.
+sub get_dst_layout
+{
+    my $dst = shift;
+    my @layout = ("A", "A", "A", "A");
+
+    foreach my $channel (keys %{$format_byte{$dst}}) {
+        $layout[$format_byte{$dst}{$channel}] = $channel;
+    }
+    die "$dst must store alpha in the top byte\n" if ($layout[3] ne "A");
+    return @layout;
+}
+
+sub output_simdhelpers
+{
+    print FILE <<__EOF__;
+/* The vectorized blitters below implement the modulate and SDL_COPY_BLEND
+ * paths of the generated blitters, producing exactly the same results.
+ * The source pixels are first swizzled into the destination channel order,
+ * which always has alpha (or the unused channel) in the top byte.
+ */
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_Blit_MultDiv255_AVX2(__m256i a, __m256i b)
+{
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(1));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_Blit_ModulateBlend_AVX2(__m256i src, __m256i dst, __m256i modulate, int flags)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i v255 = _mm256_set1_epi16(0xFF);
+    __m256i s_lo = _mm256_unpacklo_epi8(src, zero);
+    __m256i s_hi = _mm256_unpackhi_epi8(src, zero);
+
+    if (flags & SDL_COPY_MODULATE_MASK) {
+        s_lo = SDL_Blit_MultDiv255_AVX2(s_lo, modulate);
+        s_hi = SDL_Blit_MultDiv255_AVX2(s_hi, modulate);
+    }
+    if (flags & SDL_COPY_BLEND) {
+        const __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+        const __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+        __m256i d_lo = _mm256_unpacklo_epi8(dst, zero);
+        __m256i d_hi = _mm256_unpackhi_epi8(dst, zero);
+
+        /* Premultiply the color channels, leaving alpha unchanged */
+        s_lo = SDL_Blit_MultDiv255_AVX2(s_lo, _mm256_blend_epi16(a_lo, v255, 0x88));
+        s_hi = SDL_Blit_MultDiv255_AVX2(s_hi, _mm256_blend_epi16(a_hi, v255, 0x88));
+        d_lo = _mm256_add_epi16(SDL_Blit_MultDiv255_AVX2(d_lo, _mm256_sub_epi16(v255, a_lo)), s_lo);
+        d_hi = _mm256_add_epi16(SDL_Blit_MultDiv255_AVX2(d_hi, _mm256_sub_epi16(v255, a_hi)), s_hi);
+        return _mm256_packus_epi16(d_lo, d_hi);
+    }
+    return _mm256_packus_epi16(s_lo, s_hi);
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1") SDL_Blit_MultDiv255_SSE41(__m128i a, __m128i b)
+{
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1") SDL_Blit_ModulateBlend_SSE41(__m128i src, __m128i dst, __m128i modulate, int flags)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(0xFF);
+    __m128i s_lo = _mm_unpacklo_epi8(src, zero);
+    __m128i s_hi = _mm_unpackhi_epi8(src, zero);
+
+    if (flags & SDL_COPY_MODULATE_MASK) {
+        s_lo = SDL_Blit_MultDiv255_SSE41(s_lo, modulate);
+        s_hi = SDL_Blit_MultDiv255_SSE41(s_hi, modulate);
+    }
+    if (flags & SDL_COPY_BLEND) {
+        const __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+        const __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+        __m128i d_lo = _mm_unpacklo_epi8(dst, zero);
+        __m128i d_hi = _mm_unpackhi_epi8(dst, zero);
+
+        /* Premultiply the color channels, leaving alpha unchanged */
+        s_lo = SDL_Blit_MultDiv255_SSE41(s_lo, _mm_blend_epi16(a_lo, v255, 0x88));
+        s_hi = SDL_Blit_MultDiv255_SSE41(s_hi, _mm_blend_epi16(a_hi, v255, 0x88));
+        d_lo = _mm_add_epi16(SDL_Blit_MultDiv255_SSE41(d_lo, _mm_sub_epi16(v255, a_lo)), s_lo);
+        d_hi = _mm_add_epi16(SDL_Blit_MultDiv255_SSE41(d_hi, _mm_sub_epi16(v255, a_hi)), s_hi);
+        return _mm_packus_epi16(d_lo, d_hi);
+    }
+    return _mm_packus_epi16(s_lo, s_hi);
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if defined(SDL_NEON_INTRINSICS) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+static SDL_INLINE uint8x16_t SDL_Blit_MultDiv255_NEON(uint8x16_t a, uint8x16_t b)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(a), vget_low_u8(b)), one);
+    uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(a), vget_high_u8(b)), one);
+
+    lo = vaddq_u16(lo, vshrq_n_u16(lo, 8));
+    hi = vaddq_u16(hi, vshrq_n_u16(hi, 8));
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+/* Blends 16 pixels, deinterleaved into planes by vld4q_u8() */
+static SDL_INLINE void SDL_Blit_ModulateBlend_NEON(uint8x16_t *dstR, uint8x16_t *dstG, uint8x16_t *dstB, uint8x16_t *dstA,
+                                                   uint8x16_t srcR, uint8x16_t srcG, uint8x16_t srcB, uint8x16_t srcA,
+                                                   const uint8x16_t *modulate, int flags)
+{
+    if (flags & SDL_COPY_MODULATE_MASK) {
+        srcR = SDL_Blit_MultDiv255_NEON(srcR, modulate[0]);
+        srcG = SDL_Blit_MultDiv255_NEON(srcG, modulate[1]);
+        srcB = SDL_Blit_MultDiv255_NEON(srcB, modulate[2]);
+        srcA = SDL_Blit_MultDiv255_NEON(srcA, modulate[3]);
+    }
+    if (flags & SDL_COPY_BLEND) {
+        const uint8x16_t invA = vsubq_u8(vdupq_n_u8(0xFF), srcA);
+
+        *dstR = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstR, invA), SDL_Blit_MultDiv255_NEON(srcR, srcA));
+        *dstG = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstG, invA), SDL_Blit_MultDiv255_NEON(srcG, srcA));
+        *dstB = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstB, invA), SDL_Blit_MultDiv255_NEON(srcB, srcA));
+        *dstA = vqaddq_u8(SDL_Blit_MultDiv255_NEON(*dstA, invA), srcA);
+    } else {
+        *dstR = srcR;
+        *dstG = srcG;
+        *dstB = srcB;
+        *dstA = srcA;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+__EOF__
+}
+
+sub output_simdfunc_x86
+{
+    my $src = shift;
+    my $dst = shift;
+    my $simd = shift;
+    my $src_has_alpha = ($src =~ /A/) ? 1 : 0;
+    my $dst_has_alpha = ($dst =~ /A/) ? 1 : 0;
+    my @layout = get_dst_layout($dst);
+    my $type = $simd->{"type"};
+    my $mm = $simd->{"prefix"};
+    my $width = $simd->{"pixels"};
+    my $lanes = $width / 4;
+
+    # The shuffle works within 128-bit lanes, so the mask repeats per lane
+    my @shuffle;
+    for (my $pixel = 0; $pixel < 4; ++$pixel) {
+        foreach my $channel (@layout) {
+            if (exists $format_byte{$src}{$channel}) {
+                push(@shuffle, $pixel * 4 + $format_byte{$src}{$channel});
+            } else {
+                push(@shuffle, -128);
+            }
+        }
+    }
+    my $shuffle = join(", ", (reverse @shuffle) x $lanes);
+    my %modulate_name = ("R" => "modulateR", "G" => "modulateG", "B" => "modulateB", "A" => "modulateA");
+    my $modulate = join(", ", (map { $modulate_name{$_} } reverse @layout) x (2 * $lanes));
+
+    print FILE <<__EOF__;
+$simd->{"guard"}
+static void $simd->{"target"}SDL_Blit_${src}_${dst}_Modulate_Blend_$simd->{"name"}(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const Sint16 modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF;
+    const Sint16 modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF;
+    const Sint16 modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF;
+    const Sint16 modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF;
+    const $type modulate = ${mm}set_epi16($modulate);
+    const $type shuffle = ${mm}set_epi8($shuffle);
+__EOF__
+    if (!$src_has_alpha) {
+        print FILE <<__EOF__;
+    const $type fill = ${mm}set1_epi32((int)0xFF000000);
+__EOF__
+    }
+    if (!$dst_has_alpha) {
+        print FILE <<__EOF__;
+    const $type keep = ${mm}set1_epi32(0x00FFFFFF);
+__EOF__
+    }
+    my $swizzle = "${mm}shuffle_epi8(pixels, shuffle)";
+    if (!$src_has_alpha) {
+        $swizzle = "${mm}or_si${\($width * 32)}($swizzle, fill)";
+    }
+    my $result = "pixels";
+    if (!$dst_has_alpha) {
+        $result = "${mm}and_si${\($width * 32)}(pixels, keep)";
+    }
+    print FILE <<__EOF__;
+    Uint32 srcbuf[$width], dstbuf[$width];
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            $type pixels;
+
+            if (n < $width) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                s = srcbuf;
+                d = dstbuf;
+            }
+            pixels = $simd->{"load"}s);
+            pixels = SDL_Blit_ModulateBlend_$simd->{"name"}($swizzle, $simd->{"load"}d), modulate, flags);
+            $simd->{"store"}d, $result);
+            if (n < $width) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += $width;
+            dst += $width;
+            n -= $width;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+__EOF__
+}
+
+sub output_simdfunc_neon
+{
+    my $src = shift;
+    my $dst = shift;
+    my $simd = shift;
+    my $dst_has_alpha = ($dst =~ /A/) ? 1 : 0;
+    my $width = $simd->{"pixels"};
+    my %plane;
+
+    foreach my $channel ("R", "G", "B", "A") {
+        if (exists $format_byte{$src}{$channel}) {
+            $plane{"s$channel"} = "s.val[$format_byte{$src}{$channel}]";
+        } else {
+            $plane{"s$channel"} = "vdupq_n_u8(0xFF)";
+        }
+        if (exists $format_byte{$dst}{$channel}) {
+            $plane{"d$channel"} = "&d.val[$format_byte{$dst}{$channel}]";
+        } else {
+            $plane{"d$channel"} = "&d.val[3]";
+        }
+    }
+
+    print FILE <<__EOF__;
+$simd->{"guard"}
+static void SDL_Blit_${src}_${dst}_Modulate_Blend_$simd->{"name"}(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    uint8x16_t modulate[4];
+    Uint32 srcbuf[$width], dstbuf[$width];
+
+    modulate[0] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 0xFF);
+    modulate[1] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 0xFF);
+    modulate[2] = vdupq_n_u8((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 0xFF);
+    modulate[3] = vdupq_n_u8((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 0xFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const Uint32 *sp = src;
+            Uint32 *dp = dst;
+            uint8x16x4_t s, d;
+
+            if (n < $width) {
+                /* Blend the end of the row through a temporary buffer */
+                SDL_memcpy(srcbuf, src, n * sizeof(Uint32));
+                SDL_memcpy(dstbuf, dst, n * sizeof(Uint32));
+                sp = srcbuf;
+                dp = dstbuf;
+            }
+            s = vld4q_u8((const Uint8 *)sp);
+            d = vld4q_u8((const Uint8 *)dp);
+            SDL_Blit_ModulateBlend_NEON($plane{"dR"}, $plane{"dG"}, $plane{"dB"}, $plane{"dA"},
+                                        $plane{"sR"}, $plane{"sG"}, $plane{"sB"}, $plane{"sA"},
+                                        modulate, flags);
+__EOF__
+    if (!$dst_has_alpha) {
+        print FILE <<__EOF__;
+            d.val[3] = vdupq_n_u8(0);
+__EOF__
+    }
+    print FILE <<__EOF__;
+            vst4q_u8((Uint8 *)dp, d);
+            if (n < $width) {
+                SDL_memcpy(dst, dstbuf, n * sizeof(Uint32));
+                break;
+            }
+            src += $width;
+            dst += $width;
+            n -= $width;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+#endif
+
+__EOF__
+}
+
+sub output_simdfuncs
+{
+    my $src = shift;
+    my $dst = shift;
+
+    foreach my $simd (@simd_variants) {
+        if ($simd->{"name"} eq "NEON") {
+            output_simdfunc_neon($src, $dst, $simd);
+        } else {
+            output_simdfunc_x86($src, $dst, $simd);
+        }
+    }
+}
+
+sub output_simdfunctable
+{
+    my $src = shift;
+    my $dst = shift;
+
+    foreach my $simd (@simd_variants) {
+        print FILE <<__EOF__;
+$simd->{"guard"}
+    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND), $simd->{"cpu"}, SDL_Blit_${src}_${dst}_Modulate_Blend_$simd->{"name"} },
+#endif
+__EOF__
+    }
+}
+
 sub output_copyfunc_h
 {
 }
@@ -639,6 +1023,7 @@ sub output_copyinc
 #include "SDL_blit_auto.h"
 
 __EOF__
+    output_simdhelpers();
 }
 
 sub output_copyfunctable
@@ -650,6 +1035,7 @@ __EOF__
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
             my $dst = $dst_formats[$j];
+            output_simdfunctable($src, $dst);
             for (my $modulate = 0; $modulate <= 1; ++$modulate) {
                 for (my $blend = 0; $blend <= 1; ++$blend) {
                     for (my $scale = 0; $scale <= 1; ++$scale) {
@@ -713,6 +1099,7 @@ sub output_copyfunc_c
             }
         }
     }
+    output_simdfuncs($src, $dst);
 }
 
 open_file("SDL_blit_auto.h");
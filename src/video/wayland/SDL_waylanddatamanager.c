@@ -23,6 +23,7 @@
 
 #ifdef SDL_VIDEO_DRIVER_WAYLAND
 
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
@@ -41,6 +42,9 @@
  */
 #define PIPE_TIMEOUT_NS SDL_MS_TO_NS(14)
 
+/* Streams are read when the application asks, so they can wait for a slow sender */
+#define PIPE_STREAM_TIMEOUT_NS SDL_NS_PER_SECOND
+
 static ssize_t write_pipe(int fd, const void *buffer, size_t total_length, size_t *pos)
 {
     int ready = 0;
@@ -384,6 +388,89 @@ void *Wayland_data_offer_receive(SDL_WaylandDataOffer *offer,
     return buffer;
 }
 
+static Sint64 SDLCALL pipe_stream_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    return SDL_Unsupported();
+}
+
+static size_t SDLCALL pipe_stream_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    const int fd = (int)(intptr_t)userdata;
+    size_t total = 0;
+
+    while (total < size) {
+        ssize_t bytes_read;
+        const int ready = SDL_IOReady(fd, SDL_IOR_READ, PIPE_STREAM_TIMEOUT_NS);
+
+        if (ready == 0) {
+            SDL_SetError("Pipe timeout");
+            *status = SDL_IO_STATUS_ERROR;
+            break;
+        } else if (ready < 0) {
+            SDL_SetError("Pipe select error");
+            *status = SDL_IO_STATUS_ERROR;
+            break;
+        }
+
+        bytes_read = read(fd, (Uint8 *)ptr + total, size - total);
+        if (bytes_read > 0) {
+            total += bytes_read;
+        } else if (bytes_read == 0) {
+            *status = SDL_IO_STATUS_EOF;
+            break;
+        } else if (errno != EAGAIN && errno != EINTR) {
+            SDL_SetError("Could not read pipe");
+            *status = SDL_IO_STATUS_ERROR;
+            break;
+        }
+    }
+    return total;
+}
+
+static int SDLCALL pipe_stream_close(void *userdata)
+{
+    close((int)(intptr_t)userdata);
+    return 0;
+}
+
+SDL_IOStream *Wayland_data_offer_open(SDL_WaylandDataOffer *offer, const char *mime_type)
+{
+    SDL_WaylandDataDevice *data_device = NULL;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *io;
+    int pipefd[2];
+
+    if (!offer) {
+        SDL_SetError("Invalid data offer");
+        return NULL;
+    }
+    data_device = offer->data_device;
+    if (!data_device) {
+        SDL_SetError("Data device not initialized");
+        return NULL;
+    }
+    if (pipe2(pipefd, O_CLOEXEC | O_NONBLOCK) == -1) {
+        SDL_SetError("Could not read pipe");
+        return NULL;
+    }
+
+    wl_data_offer_receive(offer->offer, mime_type, pipefd[1]);
+    WAYLAND_wl_display_flush(data_device->video_data->display);
+    close(pipefd[1]);
+
+    /* The sender writes into the pipe as the stream is read, nothing is buffered up front */
+    SDL_zero(iface);
+    iface.seek = pipe_stream_seek;
+    iface.read = pipe_stream_read;
+    iface.close = pipe_stream_close;
+
+    io = SDL_OpenIO(&iface, (void *)(intptr_t)pipefd[0]);
+    if (!io) {
+        close(pipefd[0]);
+    }
+    return io;
+}
+
 void *Wayland_primary_selection_offer_receive(SDL_WaylandPrimarySelectionOffer *offer,
                                               const char *mime_type, size_t *length)
 {
@@ -0,0 +1,225 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#ifdef SDL_VIDEO_DRIVER_WAYLAND
+
+#include "SDL_waylandvideo.h"
+#include "SDL_waylandwindow.h"
+#include "SDL_waylandframebuffer.h"
+
+/* The window surface is kept in client memory and only the parts that changed
+ * since a buffer was last attached are copied into it, so a small update never
+ * touches the whole image, and a buffer still held by the compositor is never
+ * written to. If every buffer is busy, the update is deferred: its damage stays
+ * recorded against all buffers and goes out with the next one.
+ */
+
+static void AddStaleRect(SDL_Rect *stale, const SDL_Rect *rect)
+{
+    if (SDL_RectEmpty(stale)) {
+        *stale = *rect;
+    } else {
+        SDL_GetRectUnion(stale, rect, stale);
+    }
+}
+
+static struct Wayland_SHMBuffer *GetFreeBuffer(Wayland_Framebuffer *fb, int *index)
+{
+    int i;
+
+    for (i = 0; i < WAYLAND_FRAMEBUFFER_BUFFER_COUNT; ++i) {
+        const int n = (fb->next_buffer + i) % WAYLAND_FRAMEBUFFER_BUFFER_COUNT;
+        struct Wayland_SHMBuffer *buffer = &fb->buffers[n];
+
+        if (buffer->busy) {
+            continue;
+        }
+
+        /* Buffers are allocated on first use, so short-lived or rarely
+         * updated windows only ever need one or two of them.
+         */
+        if (!buffer->wl_buffer && Wayland_AllocSHMBuffer(fb->width, fb->height, fb->shm_format, buffer) < 0) {
+            return NULL;
+        }
+
+        *index = n;
+        return buffer;
+    }
+    return NULL;
+}
+
+int Wayland_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format,
+                                    void **pixels, int *pitch)
+{
+    SDL_WindowData *wind = window->internal;
+    Wayland_Framebuffer *fb;
+    int w, h, i;
+
+    /* EGL and Vulkan own the buffers attached to their surfaces. */
+    if (wind->egl_window || (window->flags & SDL_WINDOW_VULKAN)) {
+        return SDL_SetError("Window framebuffer support not available");
+    }
+
+    /* Free the old framebuffer surface */
+    Wayland_DestroyWindowFramebuffer(_this, window);
+
+    SDL_GetWindowSizeInPixels(window, &w, &h);
+    w = SDL_max(w, 1);
+    h = SDL_max(h, 1);
+
+    fb = (Wayland_Framebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return -1;
+    }
+
+    fb->width = w;
+    fb->height = h;
+    fb->pitch = w * 4;
+    fb->pixels = SDL_calloc(h, fb->pitch);
+    if (!fb->pixels) {
+        SDL_free(fb);
+        return -1;
+    }
+
+    if (window->flags & SDL_WINDOW_TRANSPARENT) {
+        fb->shm_format = WL_SHM_FORMAT_ARGB8888;
+        *format = SDL_PIXELFORMAT_ARGB8888;
+    } else {
+        fb->shm_format = WL_SHM_FORMAT_XRGB8888;
+        *format = SDL_PIXELFORMAT_XRGB8888;
+    }
+
+    /* Nothing has been copied into any of the buffers yet */
+    for (i = 0; i < WAYLAND_FRAMEBUFFER_BUFFER_COUNT; ++i) {
+        fb->stale[i].w = w;
+        fb->stale[i].h = h;
+    }
+
+    wind->framebuffer = fb;
+    *pixels = fb->pixels;
+    *pitch = fb->pitch;
+    return 0;
+}
+
+int Wayland_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects,
+                                    int numrects)
+{
+    SDL_VideoData *data = _this->internal;
+    SDL_WindowData *wind = window->internal;
+    Wayland_Framebuffer *fb = wind->framebuffer;
+    const SDL_Rect bounds = { 0, 0, fb ? fb->width : 0, fb ? fb->height : 0 };
+    struct Wayland_SHMBuffer *buffer;
+    SDL_Rect damage = { 0, 0, 0, 0 };
+    SDL_Rect rect;
+    SDL_bool use_damage_buffer;
+    Uint8 *src, *dst;
+    int i, index;
+
+    if (!fb) {
+        return SDL_SetError("Window has no framebuffer");
+    }
+
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            AddStaleRect(&damage, &rect);
+        }
+    }
+    if (SDL_RectEmpty(&damage)) {
+        return 0;
+    }
+    for (i = 0; i < WAYLAND_FRAMEBUFFER_BUFFER_COUNT; ++i) {
+        AddStaleRect(&fb->stale[i], &damage);
+    }
+
+    /* Attaching a buffer before the shell surface is configured is a protocol
+     * error; the exposure event sent once it is shown will trigger a redraw.
+     */
+    if (wind->surface_status == WAYLAND_SURFACE_STATUS_HIDDEN ||
+        wind->surface_status == WAYLAND_SURFACE_STATUS_WAITING_FOR_CONFIGURE ||
+        wind->surface_status == WAYLAND_SURFACE_STATUS_SHOW_PENDING) {
+        return 0;
+    }
+
+    buffer = GetFreeBuffer(fb, &index);
+    if (!buffer) {
+        /* Pick up any release events that have already arrived and retry once. */
+        WAYLAND_wl_display_dispatch_pending(data->display);
+        buffer = GetFreeBuffer(fb, &index);
+        if (!buffer) {
+            return 0;
+        }
+    }
+
+    /* Bring the buffer up to date with the window surface */
+    rect = fb->stale[index];
+    src = (Uint8 *)fb->pixels + rect.y * fb->pitch + rect.x * 4;
+    dst = (Uint8 *)buffer->shm_data + rect.y * fb->pitch + rect.x * 4;
+    for (i = 0; i < rect.h; ++i) {
+        SDL_memcpy(dst, src, rect.w * 4);
+        src += fb->pitch;
+        dst += fb->pitch;
+    }
+    SDL_zero(fb->stale[index]);
+
+    wl_surface_attach(wind->surface, buffer->wl_buffer, 0, 0);
+
+    /* Only the updated rects are damaged; the compositor keeps the rest of
+     * the previous frame, which the new buffer matches.
+     */
+    use_damage_buffer = wl_compositor_get_version(data->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION;
+    if (use_damage_buffer) {
+        for (i = 0; i < numrects; ++i) {
+            if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+                wl_surface_damage_buffer(wind->surface, rect.x, rect.y, rect.w, rect.h);
+            }
+        }
+    } else {
+        wl_surface_damage(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+    }
+
+    Wayland_RequestPresentationFeedback(window);
+    wl_surface_commit(wind->surface);
+    buffer->busy = SDL_TRUE;
+    fb->next_buffer = (index + 1) % WAYLAND_FRAMEBUFFER_BUFFER_COUNT;
+
+    WAYLAND_wl_display_flush(data->display);
+    return 0;
+}
+
+void Wayland_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
+{
+    SDL_WindowData *wind = window->internal;
+    Wayland_Framebuffer *fb = wind->framebuffer;
+    int i;
+
+    if (fb) {
+        for (i = 0; i < WAYLAND_FRAMEBUFFER_BUFFER_COUNT; ++i) {
+            Wayland_ReleaseSHMBuffer(&fb->buffers[i]);
+        }
+        SDL_free(fb->pixels);
+        SDL_free(fb);
+        wind->framebuffer = NULL;
+    }
+}
+
+#endif /* SDL_VIDEO_DRIVER_WAYLAND */
@@ -465,7 +465,7 @@ static Wayland_CachedCustomCursor *Wayland_GetCachedCustomCursor(SDL_Cursor *cur
     }
 
     /* Allocate shared memory buffer for this cursor */
-    if (Wayland_AllocSHMBuffer(surface->w, surface->h, &cache->shmBuffer) != 0) {
+    if (Wayland_AllocSHMBuffer(surface->w, surface->h, WL_SHM_FORMAT_ARGB8888, &cache->shmBuffer) != 0) {
         SDL_free(cache);
         SDL_DestroySurface(surface);
         return NULL;
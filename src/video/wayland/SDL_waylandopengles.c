@@ -126,6 +126,7 @@ int Wayland_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
      */
     if (data->double_buffer) {
         /* Feed the frame to Wayland. This will set it so the wl_surface_frame callback can fire again. */
+        Wayland_RequestPresentationFeedback(window);
         if (!_this->egl_data->eglSwapBuffers(_this->egl_data->egl_display, data->egl_surface)) {
             return SDL_EGL_SetError("unable to show color buffer in an OS-native window", "eglSwapBuffers");
         }
@@ -176,6 +177,7 @@ int Wayland_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
 
     if (!data->double_buffer) {
         /* Feed the frame to Wayland. This will set it so the wl_surface_frame callback can fire again. */
+        Wayland_RequestPresentationFeedback(window);
         if (!_this->egl_data->eglSwapBuffers(_this->egl_data->egl_display, data->egl_surface)) {
             return SDL_EGL_SetError("unable to show color buffer in an OS-native window", "eglSwapBuffers");
         }
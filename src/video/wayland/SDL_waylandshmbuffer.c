@@ -107,19 +107,21 @@ static int CreateTempFD(off_t size)
 
 static void buffer_handle_release(void *data, struct wl_buffer *wl_buffer)
 {
-    /* NOP */
+    struct Wayland_SHMBuffer *shmBuffer = (struct Wayland_SHMBuffer *)data;
+
+    /* The compositor is done reading from the buffer, so it can be reused. */
+    shmBuffer->busy = SDL_FALSE;
 }
 
 static struct wl_buffer_listener buffer_listener = {
     buffer_handle_release
 };
 
-int Wayland_AllocSHMBuffer(int width, int height, struct Wayland_SHMBuffer *shmBuffer)
+int Wayland_AllocSHMBuffer(int width, int height, Uint32 shm_format, struct Wayland_SHMBuffer *shmBuffer)
 {
     SDL_VideoDevice *vd = SDL_GetVideoDevice();
     SDL_VideoData *data = vd->internal;
     struct wl_shm_pool *shm_pool;
-    const Uint32 SHM_FMT = WL_SHM_FORMAT_ARGB8888;
 
     if (!shmBuffer) {
         return SDL_InvalidParamError("shmBuffer");
@@ -143,7 +145,8 @@ int Wayland_AllocSHMBuffer(int width, int height, struct Wayland_SHMBuffer *shmB
     SDL_assert(shmBuffer->shm_data != NULL);
 
     shm_pool = wl_shm_create_pool(data->shm, shm_fd, shmBuffer->shm_data_size);
-    shmBuffer->wl_buffer = wl_shm_pool_create_buffer(shm_pool, 0, width, height, stride, SHM_FMT);
+    shmBuffer->wl_buffer = wl_shm_pool_create_buffer(shm_pool, 0, width, height, stride, shm_format);
+    shmBuffer->busy = SDL_FALSE;
     wl_buffer_add_listener(shmBuffer->wl_buffer, &buffer_listener, shmBuffer);
 
     wl_shm_pool_destroy(shm_pool);
@@ -164,6 +167,7 @@ void Wayland_ReleaseSHMBuffer(struct Wayland_SHMBuffer *shmBuffer)
             shmBuffer->shm_data = NULL;
         }
         shmBuffer->shm_data_size = 0;
+        shmBuffer->busy = SDL_FALSE;
     }
 }
 
@@ -29,10 +29,11 @@ struct Wayland_SHMBuffer
     struct wl_buffer *wl_buffer;
     void *shm_data;
     int shm_data_size;
+    SDL_bool busy; /* Attached and not yet released by the compositor */
 };
 
-/* Allocates an SHM buffer with the format WL_SHM_FORMAT_ARGB8888 */
-extern int Wayland_AllocSHMBuffer(int width, int height, struct Wayland_SHMBuffer *shmBuffer);
+/* Allocates an SHM buffer with a 32-bit WL_SHM_FORMAT_* format */
+extern int Wayland_AllocSHMBuffer(int width, int height, Uint32 shm_format, struct Wayland_SHMBuffer *shmBuffer);
 extern void Wayland_ReleaseSHMBuffer(struct Wayland_SHMBuffer *shmBuffer);
 
 #endif
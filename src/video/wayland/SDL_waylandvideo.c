@@ -28,6 +28,7 @@
 
 #include "SDL_waylandclipboard.h"
 #include "SDL_waylandevents_c.h"
+#include "SDL_waylandframebuffer.h"
 #include "SDL_waylandkeyboard.h"
 #include "SDL_waylandmessagebox.h"
 #include "SDL_waylandmouse.h"
@@ -38,6 +39,7 @@
 
 #include <fcntl.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 #include <xkbcommon/xkbcommon.h>
 
@@ -52,9 +54,11 @@
 #include "kde-output-order-v1-client-protocol.h"
 #include "keyboard-shortcuts-inhibit-unstable-v1-client-protocol.h"
 #include "pointer-constraints-unstable-v1-client-protocol.h"
+#include "presentation-time-client-protocol.h"
 #include "primary-selection-unstable-v1-client-protocol.h"
 #include "relative-pointer-unstable-v1-client-protocol.h"
 #include "tablet-v2-client-protocol.h"
+#include "tearing-control-v1-client-protocol.h"
 #include "text-input-unstable-v3-client-protocol.h"
 #include "viewporter-client-protocol.h"
 #include "xdg-activation-v1-client-protocol.h"
@@ -530,6 +534,10 @@ static SDL_VideoDevice *Wayland_CreateDevice(SDL_bool require_preferred_protocol
     device->GL_GetEGLSurface = Wayland_GLES_GetEGLSurface;
 #endif
 
+    device->CreateWindowFramebuffer = Wayland_CreateWindowFramebuffer;
+    device->UpdateWindowFramebuffer = Wayland_UpdateWindowFramebuffer;
+    device->DestroyWindowFramebuffer = Wayland_DestroyWindowFramebuffer;
+
     device->CreateSDLWindow = Wayland_CreateWindow;
     device->ShowWindow = Wayland_ShowWindow;
     device->HideWindow = Wayland_HideWindow;
@@ -555,6 +563,8 @@ static SDL_VideoDevice *Wayland_CreateDevice(SDL_bool require_preferred_protocol
     device->DestroyWindow = Wayland_DestroyWindow;
     device->SetWindowHitTest = Wayland_SetWindowHitTest;
     device->FlashWindow = Wayland_FlashWindow;
+    device->WindowSupportsPresentMode = Wayland_WindowSupportsPresentMode;
+    device->SetWindowPresentMode = Wayland_SetWindowPresentMode;
     device->HasScreenKeyboardSupport = Wayland_HasScreenKeyboardSupport;
     device->ShowWindowSystemMenu = Wayland_ShowWindowSystemMenu;
     device->SyncWindow = Wayland_SyncWindow;
@@ -568,6 +578,7 @@ static SDL_VideoDevice *Wayland_CreateDevice(SDL_bool require_preferred_protocol
     device->SetClipboardData = Wayland_SetClipboardData;
     device->GetClipboardData = Wayland_GetClipboardData;
     device->HasClipboardData = Wayland_HasClipboardData;
+    device->OpenClipboardData = Wayland_OpenClipboardData;
     device->StartTextInput = Wayland_StartTextInput;
     device->StopTextInput = Wayland_StopTextInput;
     device->UpdateTextInputArea = Wayland_UpdateTextInputArea;
@@ -1125,6 +1136,17 @@ static struct libdecor_interface libdecor_interface = {
 };
 #endif
 
+static void handle_presentation_clock_id(void *data, struct wp_presentation *presentation, uint32_t clk_id)
+{
+    SDL_VideoData *d = data;
+
+    d->presentation_clock = clk_id;
+}
+
+static const struct wp_presentation_listener presentation_listener = {
+    handle_presentation_clock_id
+};
+
 static void display_handle_global(void *data, struct wl_registry *registry, uint32_t id,
                                   const char *interface, uint32_t version)
 {
@@ -1197,6 +1219,12 @@ static void display_handle_global(void *data, struct wl_registry *registry, uint
         kde_output_order_v1_add_listener(d->kde_output_order, &kde_output_order_listener, d);
     } else if (SDL_strcmp(interface, "frog_color_management_factory_v1") == 0) {
         d->frog_color_management_factory_v1 = wl_registry_bind(d->registry, id, &frog_color_management_factory_v1_interface, 1);
+    } else if (SDL_strcmp(interface, "wp_presentation") == 0) {
+        d->presentation_clock = CLOCK_MONOTONIC;
+        d->presentation = wl_registry_bind(d->registry, id, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(d->presentation, &presentation_listener, d);
+    } else if (SDL_strcmp(interface, "wp_tearing_control_manager_v1") == 0) {
+        d->tearing_control_manager = wl_registry_bind(d->registry, id, &wp_tearing_control_manager_v1_interface, 1);
     }
 }
 
@@ -1305,6 +1333,8 @@ int Wayland_VideoInit(SDL_VideoDevice *_this)
         _this->HasPrimarySelectionText = Wayland_HasPrimarySelectionText;
     }
 
+    SDL_AddEventWaitSource(WAYLAND_wl_display_get_fd(data->display));
+
     data->initializing = SDL_FALSE;
 
     return 0;
@@ -1472,6 +1502,16 @@ static void Wayland_VideoCleanup(SDL_VideoDevice *_this)
         data->frog_color_management_factory_v1 = NULL;
     }
 
+    if (data->presentation) {
+        wp_presentation_destroy(data->presentation);
+        data->presentation = NULL;
+    }
+
+    if (data->tearing_control_manager) {
+        wp_tearing_control_manager_v1_destroy(data->tearing_control_manager);
+        data->tearing_control_manager = NULL;
+    }
+
     if (data->compositor) {
         wl_compositor_destroy(data->compositor);
         data->compositor = NULL;
@@ -1532,6 +1572,8 @@ SDL_bool Wayland_VideoReconnect(SDL_VideoDevice *_this)
 
 void Wayland_VideoQuit(SDL_VideoDevice *_this)
 {
+    SDL_RemoveEventWaitSource(WAYLAND_wl_display_get_fd(_this->internal->display));
+
     Wayland_VideoCleanup(_this);
 
 #ifdef HAVE_LIBDECOR_H
@@ -84,6 +84,9 @@ struct SDL_VideoData
     struct wp_alpha_modifier_v1 *wp_alpha_modifier_v1;
     struct kde_output_order_v1 *kde_output_order;
     struct frog_color_management_factory_v1 *frog_color_management_factory_v1;
+    struct wp_presentation *presentation;
+    Uint32 presentation_clock;
+    struct wp_tearing_control_manager_v1 *tearing_control_manager;
 
     struct xkb_context *xkb_context;
     struct SDL_WaylandInput *input;
@@ -32,6 +32,8 @@
 #include "SDL_waylandvideo.h"
 #include "../../SDL_hints_c.h"
 
+#include <time.h>
+
 #include "alpha-modifier-v1-client-protocol.h"
 #include "xdg-shell-client-protocol.h"
 #include "xdg-decoration-unstable-v1-client-protocol.h"
@@ -42,6 +44,8 @@
 #include "xdg-foreign-unstable-v2-client-protocol.h"
 #include "xdg-dialog-v1-client-protocol.h"
 #include "frog-color-management-v1-client-protocol.h"
+#include "presentation-time-client-protocol.h"
+#include "tearing-control-v1-client-protocol.h"
 
 #ifdef HAVE_LIBDECOR_H
 #include <libdecor.h>
@@ -657,11 +661,15 @@ static void surface_frame_done(void *data, struct wl_callback *cb, uint32_t time
     /* XXX: This is needed to work around an Nvidia egl-wayland bug due to buffer coordinates
      *      being used with wl_surface_damage, which causes part of the output to not be
      *      updated when using a viewport with an output region larger than the source region.
+     *
+     *      The SHM framebuffer damages exactly what it updates, so leave it alone.
      */
-    if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
-        wl_surface_damage_buffer(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
-    } else {
-        wl_surface_damage(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+    if (!wind->framebuffer) {
+        if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
+            wl_surface_damage_buffer(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+        } else {
+            wl_surface_damage(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+        }
     }
 
     if (wind->surface_status == WAYLAND_SURFACE_STATUS_WAITING_FOR_FRAME) {
@@ -710,6 +718,96 @@ static const struct wl_callback_listener gles_swap_frame_listener = {
     gles_swap_frame_done
 };
 
+typedef struct Wayland_PresentationFeedback
+{
+    SDL_WindowData *window;
+    struct wp_presentation_feedback *feedback;
+    struct wl_list link;
+} Wayland_PresentationFeedback;
+
+static void FreePresentationFeedback(Wayland_PresentationFeedback *fb)
+{
+    WAYLAND_wl_list_remove(&fb->link);
+    wp_presentation_feedback_destroy(fb->feedback);
+    SDL_free(fb);
+}
+
+static void presentation_feedback_handle_sync_output(void *data, struct wp_presentation_feedback *feedback, struct wl_output *output)
+{
+    /* NOP */
+}
+
+static void presentation_feedback_handle_presented(void *data, struct wp_presentation_feedback *feedback,
+                                                   uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec,
+                                                   uint32_t refresh, uint32_t seq_hi, uint32_t seq_lo, uint32_t flags)
+{
+    Wayland_PresentationFeedback *fb = (Wayland_PresentationFeedback *)data;
+    SDL_WindowData *wind = fb->window;
+    const Uint64 present_ns = SDL_SECONDS_TO_NS(((Uint64)tv_sec_hi << 32) | tv_sec_lo) + tv_nsec;
+    Uint64 now_ns = present_ns;
+    Uint64 deadline_ns = 0;
+    Sint64 offset = 0;
+    struct timespec now;
+
+    /* Timestamps are in the compositor's presentation clock, so map them onto
+     * the SDL_GetTicksNS() timeline by sampling both clocks together.
+     */
+    if (clock_gettime((clockid_t)wind->waylandData->presentation_clock, &now) == 0) {
+        now_ns = SDL_SECONDS_TO_NS((Uint64)now.tv_sec) + now.tv_nsec;
+        offset = (Sint64)SDL_GetTicksNS() - (Sint64)now_ns;
+    }
+
+    /* Predict the first refresh that hasn't happened yet. */
+    if (refresh) {
+        deadline_ns = present_ns + refresh;
+        if (deadline_ns <= now_ns) {
+            deadline_ns += ((now_ns - deadline_ns) / refresh + 1) * refresh;
+        }
+    }
+
+    const SDL_PropertiesID props = SDL_GetWindowProperties(wind->sdlwindow);
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_WAYLAND_PRESENTATION_TIME_NUMBER, (Sint64)present_ns + offset);
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_WAYLAND_PRESENTATION_REFRESH_NUMBER, refresh);
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_WAYLAND_PRESENTATION_SEQUENCE_NUMBER, (Sint64)(((Uint64)seq_hi << 32) | seq_lo));
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_WAYLAND_PRESENTATION_FLAGS_NUMBER, flags);
+    SDL_SetNumberProperty(props, SDL_PROP_WINDOW_WAYLAND_NEXT_FRAME_DEADLINE_NUMBER, deadline_ns ? (Sint64)deadline_ns + offset : 0);
+
+    FreePresentationFeedback(fb);
+}
+
+static void presentation_feedback_handle_discarded(void *data, struct wp_presentation_feedback *feedback)
+{
+    FreePresentationFeedback((Wayland_PresentationFeedback *)data);
+}
+
+static const struct wp_presentation_feedback_listener presentation_feedback_listener = {
+    presentation_feedback_handle_sync_output,
+    presentation_feedback_handle_presented,
+    presentation_feedback_handle_discarded
+};
+
+void Wayland_RequestPresentationFeedback(SDL_Window *window)
+{
+    SDL_WindowData *wind = window->internal;
+    SDL_VideoData *data = wind->waylandData;
+    Wayland_PresentationFeedback *fb;
+
+    if (!data->presentation || (window->flags & SDL_WINDOW_EXTERNAL)) {
+        return;
+    }
+
+    fb = SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return;
+    }
+
+    /* Applies to the next commit of the surface. */
+    fb->window = wind;
+    fb->feedback = wp_presentation_feedback(data->presentation, wind->surface);
+    wp_presentation_feedback_add_listener(fb->feedback, &presentation_feedback_listener, fb);
+    WAYLAND_wl_list_insert(&wind->presentation_feedback_list, &fb->link);
+}
+
 static void handle_configure_xdg_shell_surface(void *data, struct xdg_surface *xdg, uint32_t serial)
 {
     SDL_WindowData *wind = (SDL_WindowData *)data;
@@ -2360,6 +2458,7 @@ int Wayland_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Propert
     }
 
     data->waylandData = c;
+    WAYLAND_wl_list_init(&data->presentation_feedback_list);
     data->sdlwindow = window;
 
     data->windowed_scale_factor = 1.0f;
@@ -2651,6 +2750,30 @@ int Wayland_SetWindowOpacity(SDL_VideoDevice *_this, SDL_Window *window, float o
     return SDL_SetError("wayland: set window opacity failed; compositor lacks support for the required wp_alpha_modifier_v1 protocol");
 }
 
+SDL_bool Wayland_WindowSupportsPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode)
+{
+    /* Vulkan WSI drives tearing control itself, so the swapchain present mode is used for those windows */
+    return mode == SDL_PRESENTMODE_IMMEDIATE && _this->internal->tearing_control_manager &&
+           !(window->flags & SDL_WINDOW_VULKAN);
+}
+
+int Wayland_SetWindowPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode)
+{
+    SDL_WindowData *wind = window->internal;
+
+    if (!wind->tearing_control) {
+        if (!_this->internal->tearing_control_manager) {
+            return SDL_SetError("wayland: compositor lacks support for the required wp_tearing_control_manager_v1 protocol");
+        }
+        wind->tearing_control = wp_tearing_control_manager_v1_get_tearing_control(_this->internal->tearing_control_manager, wind->surface);
+    }
+
+    /* The hint takes effect with the next commit of the window contents */
+    wp_tearing_control_v1_set_presentation_hint(wind->tearing_control,
+                                                (mode == SDL_PRESENTMODE_IMMEDIATE) ? WP_TEARING_CONTROL_V1_PRESENTATION_HINT_ASYNC : WP_TEARING_CONTROL_V1_PRESENTATION_HINT_VSYNC);
+    return 0;
+}
+
 void Wayland_SetWindowTitle(SDL_VideoDevice *_this, SDL_Window *window)
 {
     SDL_WindowData *wind = window->internal;
@@ -2784,6 +2907,10 @@ void Wayland_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
             frog_color_managed_surface_destroy(wind->frog_color_managed_surface);
         }
 
+        if (wind->tearing_control) {
+            wp_tearing_control_v1_destroy(wind->tearing_control);
+        }
+
         SDL_free(wind->outputs);
         SDL_free(wind->app_id);
 
@@ -2797,6 +2924,11 @@ void Wayland_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
             wl_callback_destroy(wind->surface_frame_callback);
         }
 
+        Wayland_PresentationFeedback *fb, *tmp;
+        wl_list_for_each_safe (fb, tmp, &wind->presentation_feedback_list, link) {
+            FreePresentationFeedback(fb);
+        }
+
         if (!(window->flags & SDL_WINDOW_EXTERNAL)) {
             wl_surface_destroy(wind->surface);
         } else {
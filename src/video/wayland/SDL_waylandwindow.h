@@ -83,6 +83,7 @@ struct SDL_WindowData
     } surface_status;
 
     struct wl_egl_window *egl_window;
+    struct Wayland_Framebuffer *framebuffer;
     struct SDL_WaylandInput *keyboard_device;
 #ifdef SDL_VIDEO_OPENGL_EGL
     EGLSurface egl_surface;
@@ -99,9 +100,13 @@ struct SDL_WindowData
     struct xdg_dialog_v1 *xdg_dialog_v1;
     struct wp_alpha_modifier_surface_v1 *wp_alpha_modifier_surface_v1;
     struct frog_color_managed_surface *frog_color_managed_surface;
+    struct wp_tearing_control_v1 *tearing_control;
 
     SDL_AtomicInt swap_interval_ready;
 
+    /* Outstanding wp_presentation_feedback requests */
+    struct wl_list presentation_feedback_list;
+
     SDL_DisplayData **outputs;
     int num_outputs;
 
@@ -205,8 +210,11 @@ extern void Wayland_ShowWindowSystemMenu(SDL_Window *window, int x, int y);
 extern void Wayland_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window);
 extern int Wayland_SuspendScreenSaver(SDL_VideoDevice *_this);
 
+extern void Wayland_RequestPresentationFeedback(SDL_Window *window);
 extern int Wayland_SetWindowHitTest(SDL_Window *window, SDL_bool enabled);
 extern int Wayland_FlashWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_FlashOperation operation);
+extern SDL_bool Wayland_WindowSupportsPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode);
+extern int Wayland_SetWindowPresentMode(SDL_VideoDevice *_this, SDL_Window *window, SDL_PresentMode mode);
 extern int Wayland_SyncWindow(SDL_VideoDevice *_this, SDL_Window *window);
 
 extern void Wayland_RemoveOutputFromWindow(SDL_WindowData *window, SDL_DisplayData *display_data);
@@ -28,6 +28,7 @@
 #include "../../events/scancodes_windows.h"
 #include "../../main/SDL_main_callbacks.h"
 #include "../../core/windows/SDL_hid.h"
+#include "../../power/SDL_power_c.h"
 
 /* Dropfile support */
 #include <shellapi.h>
@@ -763,13 +764,15 @@ void WIN_PollRawInput(SDL_VideoDevice *_this)
         if (count == 0 || count == (UINT)-1) {
             if (!data->rawinput || (count == (UINT)-1 && GetLastError() == ERROR_INSUFFICIENT_BUFFER)) {
                 const UINT RAWINPUT_BUFFER_SIZE_INCREMENT = 96;   // 2 64-bit raw mouse packets
-                BYTE *rawinput = (BYTE *)SDL_realloc(data->rawinput, data->rawinput_size + RAWINPUT_BUFFER_SIZE_INCREMENT);
+                // Double the buffer so a burst from a high polling rate mouse is drained in a few calls
+                UINT increment = SDL_max(data->rawinput_size, RAWINPUT_BUFFER_SIZE_INCREMENT);
+                BYTE *rawinput = (BYTE *)SDL_realloc(data->rawinput, data->rawinput_size + increment);
                 if (!rawinput) {
                     break;
                 }
                 input = (RAWINPUT *)(rawinput + ((BYTE *)input - data->rawinput));
                 data->rawinput = rawinput;
-                data->rawinput_size += RAWINPUT_BUFFER_SIZE_INCREMENT;
+                data->rawinput_size += increment;
             } else {
                 break;
             }
@@ -1885,6 +1888,12 @@ LRESULT CALLBACK WIN_WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPara
         WIN_RefreshDisplays(SDL_GetVideoDevice());
     } break;
 
+    case WM_POWERBROADCAST:
+    {
+        // The power source or battery level changed, or we resumed from sleep
+        SDL_InvalidatePowerInfo();
+    } break;
+
     case WM_NCCALCSIZE:
     {
         SDL_WindowFlags window_flags = SDL_GetWindowFlags(data->window);
@@ -2166,8 +2175,35 @@ int WIN_WaitEventTimeout(SDL_VideoDevice *_this, Sint64 timeoutNS)
     if (g_WindowsEnableMessageLoop) {
 #if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
         DWORD timeout, ret;
-        timeout = timeoutNS < 0 ? INFINITE : (DWORD)SDL_NS_TO_MS(timeoutNS);
-        ret = MsgWaitForMultipleObjects(0, NULL, FALSE, timeout, QS_ALLINPUT);
+        /* Wake up if there is input in the queue, even if a previous pump left it there */
+        const DWORD flags = MWMO_INPUTAVAILABLE;
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+        HANDLE timer = (timeoutNS > 0) ? SDL_GetWaitableTimer() : NULL;
+        if (timer) {
+            /* Use a high resolution timer so short polling intervals don't wake up early or spin */
+            LARGE_INTEGER due_time;
+            due_time.QuadPart = -((LONGLONG)timeoutNS / 100);
+            if (SetWaitableTimerEx(timer, &due_time, 0, NULL, NULL, NULL, 0)) {
+                ret = MsgWaitForMultipleObjectsEx(1, &timer, INFINITE, QS_ALLINPUT, flags);
+                if (ret == WAIT_OBJECT_0) {
+                    return 0;
+                }
+                CancelWaitableTimer(timer);
+                if (ret == WAIT_OBJECT_0 + 1) {
+                    return 1;
+                } else {
+                    return 0;
+                }
+            }
+        }
+#endif
+        if (timeoutNS < 0) {
+            timeout = INFINITE;
+        } else {
+            /* Round up so we don't spin when less than a millisecond is left */
+            timeout = (DWORD)SDL_NS_TO_MS(timeoutNS + SDL_NS_PER_MS - 1);
+        }
+        ret = MsgWaitForMultipleObjectsEx(0, NULL, timeout, QS_ALLINPUT, flags);
         if (ret == WAIT_OBJECT_0) {
             return 1;
         } else {
@@ -259,6 +259,173 @@ static void *GetSelectionData(SDL_VideoDevice *_this, Atom selection_type,
     return data;
 }
 
+/* A selection transfer that is read as the stream is, one INCR chunk at a time */
+typedef struct X11_SelectionStream
+{
+    SDL_VideoDevice *_this;
+    Window window;
+    Atom selection;
+    Atom selection_type;
+    Atom XA_MIME;
+    unsigned char *chunk;
+    size_t chunk_size;
+    size_t chunk_pos;
+    SDL_bool incr;
+    SDL_bool done;
+} X11_SelectionStream;
+
+/* Ask the owner for the next INCR chunk and wait for it */
+static SDL_bool FetchSelectionChunk(X11_SelectionStream *stream)
+{
+    SDL_VideoData *videodata = stream->_this->internal;
+    Display *display = videodata->display;
+    Atom seln_type;
+    int seln_format;
+    unsigned long count;
+    unsigned long overflow;
+
+    if (stream->chunk) {
+        X11_XFree(stream->chunk);
+        stream->chunk = NULL;
+    }
+    stream->chunk_size = 0;
+    stream->chunk_pos = 0;
+
+    /* Deleting the property tells the owner we're done with the previous chunk */
+    X11_XDeleteProperty(display, stream->window, stream->selection);
+    X11_XFlush(display);
+
+    if (!WaitForSelection(stream->_this, stream->selection_type, &videodata->selection_incr_waiting)) {
+        return SDL_FALSE;
+    }
+    if (X11_XGetWindowProperty(display, stream->window, stream->selection, 0, INT_MAX / 4, False,
+                               stream->XA_MIME, &seln_type, &seln_format, &count, &overflow, &stream->chunk) != Success) {
+        stream->chunk = NULL;
+        return SDL_SetError("Couldn't read selection chunk") == 0;
+    }
+    if (count == 0) {
+        stream->done = SDL_TRUE;
+    }
+    stream->chunk_size = (size_t)count;
+    return SDL_TRUE;
+}
+
+static Sint64 SDLCALL X11_SelectionStream_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    return SDL_Unsupported();
+}
+
+static size_t SDLCALL X11_SelectionStream_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    X11_SelectionStream *stream = (X11_SelectionStream *)userdata;
+    size_t total = 0;
+
+    while (total < size) {
+        if (stream->chunk_pos < stream->chunk_size) {
+            const size_t amount = SDL_min(size - total, stream->chunk_size - stream->chunk_pos);
+            SDL_memcpy((Uint8 *)ptr + total, stream->chunk + stream->chunk_pos, amount);
+            stream->chunk_pos += amount;
+            total += amount;
+            continue;
+        }
+
+        if (!stream->incr || stream->done) {
+            stream->done = SDL_TRUE;
+            *status = SDL_IO_STATUS_EOF;
+            break;
+        }
+        if (!FetchSelectionChunk(stream)) {
+            *status = SDL_IO_STATUS_ERROR;
+            break;
+        }
+    }
+    return total;
+}
+
+static int SDLCALL X11_SelectionStream_close(void *userdata)
+{
+    X11_SelectionStream *stream = (X11_SelectionStream *)userdata;
+    Display *display = stream->_this->internal->display;
+
+    if (stream->chunk) {
+        X11_XFree(stream->chunk);
+    }
+    X11_XDeleteProperty(display, stream->window, stream->selection);
+    X11_XFlush(display);
+    SDL_free(stream);
+    return 0;
+}
+
+static SDL_IOStream *OpenSelectionData(SDL_VideoDevice *_this, Atom selection_type, const char *mime_type)
+{
+    SDL_VideoData *videodata = _this->internal;
+    Display *display = videodata->display;
+    X11_SelectionStream *stream;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *io;
+    Window window;
+    Window owner;
+    Atom seln_type;
+    int seln_format;
+    unsigned long count;
+    unsigned long overflow;
+
+    window = GetWindow(_this);
+    owner = X11_XGetSelectionOwner(display, selection_type);
+    if (owner == None) {
+        SDL_SetError("No clipboard data for %s", mime_type);
+        return NULL;
+    } else if (owner == window) {
+        return SDL_OpenInternalClipboardData(_this, mime_type);
+    }
+
+    stream = (X11_SelectionStream *)SDL_calloc(1, sizeof(*stream));
+    if (!stream) {
+        return NULL;
+    }
+    stream->_this = _this;
+    stream->window = window;
+    stream->selection = X11_XInternAtom(display, "SDL_SELECTION", False);
+    stream->selection_type = selection_type;
+    stream->XA_MIME = X11_XInternAtom(display, mime_type, False);
+
+    /* Request that the selection owner copy the data to our window */
+    X11_XConvertSelection(display, selection_type, stream->XA_MIME, stream->selection, window, CurrentTime);
+    if (!WaitForSelection(_this, selection_type, &videodata->selection_waiting) ||
+        X11_XGetWindowProperty(display, window, stream->selection, 0, INT_MAX / 4, False,
+                               stream->XA_MIME, &seln_type, &seln_format, &count, &overflow, &stream->chunk) != Success) {
+        SDL_free(stream);
+        return NULL;
+    }
+
+    if (seln_type == X11_XInternAtom(display, "INCR", False)) {
+        /* The real data follows in chunks, fetched as the stream is read */
+        X11_XFree(stream->chunk);
+        stream->chunk = NULL;
+        stream->incr = SDL_TRUE;
+    } else if (seln_type == stream->XA_MIME) {
+        stream->chunk_size = (size_t)count;
+    } else {
+        if (stream->chunk) {
+            X11_XFree(stream->chunk);
+        }
+        SDL_free(stream);
+        SDL_SetError("No clipboard data for %s", mime_type);
+        return NULL;
+    }
+
+    SDL_zero(iface);
+    iface.seek = X11_SelectionStream_seek;
+    iface.read = X11_SelectionStream_read;
+    iface.close = X11_SelectionStream_close;
+
+    io = SDL_OpenIO(&iface, stream);
+    if (!io) {
+        X11_SelectionStream_close(stream);
+    }
+    return io;
+}
+
 const char **X11_GetTextMimeTypes(SDL_VideoDevice *_this, size_t *num_mime_types)
 {
     *num_mime_types = SDL_arraysize(text_mime_types);
@@ -287,6 +454,17 @@ void *X11_GetClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t
     return GetSelectionData(_this, XA_CLIPBOARD, mime_type, length);
 }
 
+SDL_IOStream *X11_OpenClipboardData(SDL_VideoDevice *_this, const char *mime_type)
+{
+    SDL_VideoData *videodata = _this->internal;
+    Atom XA_CLIPBOARD = X11_XInternAtom(videodata->display, "CLIPBOARD", 0);
+    if (XA_CLIPBOARD == None) {
+        SDL_SetError("Couldn't access X clipboard");
+        return NULL;
+    }
+    return OpenSelectionData(_this, XA_CLIPBOARD, mime_type);
+}
+
 SDL_bool X11_HasClipboardData(SDL_VideoDevice *_this, const char *mime_type)
 {
     size_t length;
@@ -37,6 +37,7 @@ extern const char **X11_GetTextMimeTypes(SDL_VideoDevice *_this, size_t *num_mim
 extern int X11_SetClipboardData(SDL_VideoDevice *_this);
 extern void *X11_GetClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t *length);
 extern SDL_bool X11_HasClipboardData(SDL_VideoDevice *_this, const char *mime_type);
+extern SDL_IOStream *X11_OpenClipboardData(SDL_VideoDevice *_this, const char *mime_type);
 extern int X11_SetPrimarySelectionText(SDL_VideoDevice *_this, const char *text);
 extern char *X11_GetPrimarySelectionText(SDL_VideoDevice *_this);
 extern SDL_bool X11_HasPrimarySelectionText(SDL_VideoDevice *_this);
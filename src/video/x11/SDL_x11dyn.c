@@ -50,6 +50,9 @@ typedef struct
 #ifndef SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES
 #define SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES NULL
 #endif
+#ifndef SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT
+#define SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT NULL
+#endif
 #ifndef SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR
 #define SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR NULL
 #endif
@@ -63,6 +66,7 @@ static x11dynlib x11libs[] = {
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XCURSOR },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XINPUT2 },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XFIXES },
+    { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XPRESENT },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XRANDR },
     { NULL, SDL_VIDEO_DRIVER_X11_DYNAMIC_XSS }
 };
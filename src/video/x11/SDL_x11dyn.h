@@ -62,6 +62,9 @@
 #ifdef SDL_VIDEO_DRIVER_X11_XRANDR
 #include <X11/extensions/Xrandr.h>
 #endif
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+#include <X11/extensions/Xpresent.h>
+#endif
 #ifdef SDL_VIDEO_DRIVER_X11_XSCRNSAVER
 #include <X11/extensions/scrnsaver.h>
 #endif
@@ -236,8 +236,16 @@ static void X11_HandleGenericEvent(SDL_VideoDevice *_this, XEvent *xev)
 
     /* event is a union, so cookie == &event, but this is type safe. */
     XGenericEventCookie *cookie = &xev->xcookie;
+    if (!g_X11EventHook && X11_HandleXinput2EventWithoutData(_this, cookie)) {
+        return;
+    }
     if (X11_XGetEventData(videodata->display, cookie)) {
         if (!g_X11EventHook || g_X11EventHook(g_X11EventHookData, xev)) {
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+            if (videodata->have_present && cookie->extension == videodata->present_opcode) {
+                X11_HandlePresentEvent(_this, cookie);
+            } else
+#endif
             X11_HandleXinput2Event(_this, cookie);
         }
         X11_XFreeEventData(videodata->display, cookie);
@@ -751,11 +759,45 @@ SDL_WindowData *X11_FindWindow(SDL_VideoDevice *_this, Window window)
     return NULL;
 }
 
+/* Convert an X server timestamp, in milliseconds, to the SDL_GetTicksNS() timebase */
+Uint64 X11_GetEventTimestamp(unsigned long time)
+{
+    static Uint32 last;
+    static Uint64 rollover;
+    static Uint64 timestamp_offset;
+    const Uint64 now = SDL_GetTicksNS();
+    Uint64 timestamp;
+
+    if (time == CurrentTime) {
+        /* Let the event be stamped when it's queued */
+        return 0;
+    }
+
+    if ((Uint32)time < last && (last - (Uint32)time) > 0x80000000) {
+        /* 32-bit server time rollover, events may arrive slightly out of order otherwise */
+        rollover += 0x100000000LLU;
+    }
+    last = (Uint32)time;
+
+    timestamp = SDL_MS_TO_NS(rollover + (Uint32)time);
+    if (!timestamp_offset) {
+        timestamp_offset = (now - timestamp);
+    }
+    timestamp += timestamp_offset;
+
+    if (timestamp > now) {
+        timestamp_offset -= (timestamp - now);
+        timestamp = now;
+    }
+    return timestamp;
+}
+
 void X11_HandleKeyEvent(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_KeyboardID keyboardID, XEvent *xevent)
 {
     SDL_VideoData *videodata = (SDL_VideoData *)_this->internal;
     Display *display = videodata->display;
     KeyCode keycode = xevent->xkey.keycode;
+    Uint64 timestamp = X11_GetEventTimestamp(xevent->xkey.time);
     KeySym keysym = NoSymbol;
     int text_length = 0;
     char text[64];
@@ -802,9 +844,9 @@ void X11_HandleKeyEvent(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_
             videodata->filter_time = xevent->xkey.time;
 
             if (orig_event_type == KeyPress) {
-                SDL_SendKeyboardKey(0, keyboardID, orig_keycode, scancode, SDL_PRESSED);
+                SDL_SendKeyboardKey(timestamp, keyboardID, orig_keycode, scancode, SDL_PRESSED);
             } else {
-                SDL_SendKeyboardKey(0, keyboardID, orig_keycode, scancode, SDL_RELEASED);
+                SDL_SendKeyboardKey(timestamp, keyboardID, orig_keycode, scancode, SDL_RELEASED);
             }
 #endif
             return;
@@ -830,7 +872,7 @@ void X11_HandleKeyEvent(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_
         if (xevent->type == KeyPress) {
             /* Don't send the key if it looks like a duplicate of a filtered key sent by an IME */
             if (xevent->xkey.keycode != videodata->filter_code || xevent->xkey.time != videodata->filter_time) {
-                SDL_SendKeyboardKey(0, keyboardID, keycode, videodata->key_layout[keycode], SDL_PRESSED);
+                SDL_SendKeyboardKey(timestamp, keyboardID, keycode, videodata->key_layout[keycode], SDL_PRESSED);
             }
             if (*text) {
                 text[text_length] = '\0';
@@ -841,7 +883,7 @@ void X11_HandleKeyEvent(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_
                 /* We're about to get a repeated key down, ignore the key up */
                 return;
             }
-            SDL_SendKeyboardKey(0, keyboardID, keycode, videodata->key_layout[keycode], SDL_RELEASED);
+            SDL_SendKeyboardKey(timestamp, keyboardID, keycode, videodata->key_layout[keycode], SDL_RELEASED);
         }
     }
 
@@ -855,12 +897,13 @@ void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, S
     SDL_Window *window = windowdata->window;
     const SDL_VideoData *videodata = (SDL_VideoData *)_this->internal;
     Display *display = videodata->display;
+    Uint64 timestamp = X11_GetEventTimestamp(time);
     int xticks = 0, yticks = 0;
 #ifdef DEBUG_XEVENTS
     SDL_Log("window 0x%lx: ButtonPress (X11 button = %d)\n", windowdata->xwindow, button);
 #endif
     if (X11_IsWheelEvent(display, button, &xticks, &yticks)) {
-        SDL_SendMouseWheel(0, window, mouseID, (float)-xticks, (float)yticks, SDL_MOUSEWHEEL_NORMAL);
+        SDL_SendMouseWheel(timestamp, window, mouseID, (float)-xticks, (float)yticks, SDL_MOUSEWHEEL_NORMAL);
     } else {
         SDL_bool ignore_click = SDL_FALSE;
         if (button == Button1) {
@@ -881,13 +924,13 @@ void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, S
             windowdata->last_focus_event_time = 0;
         }
         if (!ignore_click) {
-            SDL_SendMouseButton(0, window, mouseID, SDL_PRESSED, button);
+            SDL_SendMouseButton(timestamp, window, mouseID, SDL_PRESSED, button);
         }
     }
     X11_UpdateUserTime(windowdata, time);
 }
 
-void X11_HandleButtonRelease(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_MouseID mouseID, int button)
+void X11_HandleButtonRelease(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_MouseID mouseID, int button, const unsigned long time)
 {
     SDL_Window *window = windowdata->window;
     const SDL_VideoData *videodata = (SDL_VideoData *)_this->internal;
@@ -902,7 +945,7 @@ void X11_HandleButtonRelease(SDL_VideoDevice *_this, SDL_WindowData *windowdata,
             /* see explanation at case ButtonPress */
             button -= (8 - SDL_BUTTON_X1);
         }
-        SDL_SendMouseButton(0, window, mouseID, SDL_RELEASED, button);
+        SDL_SendMouseButton(X11_GetEventTimestamp(time), window, mouseID, SDL_RELEASED, button);
     }
 }
 
@@ -1051,7 +1094,10 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
             }
 
             X11_UpdateKeymap(_this, SDL_TRUE);
-        } else if (xevent->type == PropertyNotify && videodata && videodata->windowlist) {
+        } else if (xevent->type == PropertyNotify && videodata && videodata->windowlist &&
+                   (xevent->xproperty.atom == videodata->_ICC_PROFILE || ScreenCount(display) > 1)) {
+            /* Root window properties change often (e.g. _NET_ACTIVE_WINDOW), so only pay
+               for the round trip to look up the atom name when it could be an ICC profile. */
             char *name_of_atom = X11_XGetAtomName(display, xevent->xproperty.atom);
 
             if (SDL_strncmp(name_of_atom, "_ICC_PROFILE", sizeof("_ICC_PROFILE") - 1) == 0) {
@@ -1116,7 +1162,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
 #endif
 
         if (!mouse->relative_mode) {
-            SDL_SendMouseMotion(0, data->window, SDL_GLOBAL_MOUSE_ID, SDL_FALSE, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
+            SDL_SendMouseMotion(X11_GetEventTimestamp(xevent->xcrossing.time), data->window, SDL_GLOBAL_MOUSE_ID, SDL_FALSE, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
         }
 
         /* We ungrab in LeaveNotify, so we may need to grab again here */
@@ -1140,7 +1186,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
         }
 #endif
         if (!SDL_GetMouse()->relative_mode) {
-            SDL_SendMouseMotion(0, data->window, SDL_GLOBAL_MOUSE_ID, SDL_FALSE, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
+            SDL_SendMouseMotion(X11_GetEventTimestamp(xevent->xcrossing.time), data->window, SDL_GLOBAL_MOUSE_ID, SDL_FALSE, (float)xevent->xcrossing.x, (float)xevent->xcrossing.y);
         }
 
         if (xevent->xcrossing.mode != NotifyGrab &&
@@ -1270,6 +1316,13 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
         /* Have we been resized or moved? */
     case ConfigureNotify:
     {
+        /* Only the latest geometry matters; skip to the newest queued ConfigureNotify so an
+           interactive resize doesn't cost two round trips for every intermediate size. */
+        if (!g_X11EventHook && X11_XEventsQueued(display, QueuedAlready) > 0) {
+            while (X11_XCheckTypedWindowEvent(display, xevent->xconfigure.window, ConfigureNotify, xevent)) {
+            }
+        }
+
 #ifdef DEBUG_XEVENTS
         SDL_Log("window 0x%lx: ConfigureNotify! (position: %d,%d, size: %dx%d)\n", xevent->xany.window,
                xevent->xconfigure.x, xevent->xconfigure.y,
@@ -1283,6 +1336,9 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
             Window *Children;
             /* Translate these coordinates back to relative to root */
             X11_XQueryTree(data->videodata->display, xevent->xconfigure.window, &Root, &Parent, &Children, &NumChildren);
+            if (Children) {
+                X11_XFree(Children);
+            }
             X11_XTranslateCoordinates(xevent->xconfigure.display,
                                       Parent, DefaultRootWindow(xevent->xconfigure.display),
                                       xevent->xconfigure.x, xevent->xconfigure.y,
@@ -1480,7 +1536,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
 #endif
 
             X11_ProcessHitTest(_this, data, (float)xevent->xmotion.x, (float)xevent->xmotion.y, SDL_FALSE);
-            SDL_SendMouseMotion(0, data->window, SDL_GLOBAL_MOUSE_ID, SDL_FALSE, (float)xevent->xmotion.x, (float)xevent->xmotion.y);
+            SDL_SendMouseMotion(X11_GetEventTimestamp(xevent->xmotion.time), data->window, SDL_GLOBAL_MOUSE_ID, SDL_FALSE, (float)xevent->xmotion.x, (float)xevent->xmotion.y);
         }
     } break;
 
@@ -1502,7 +1558,7 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
             break;
         }
 
-        X11_HandleButtonRelease(_this, data, SDL_GLOBAL_MOUSE_ID, xevent->xbutton.button);
+        X11_HandleButtonRelease(_this, data, SDL_GLOBAL_MOUSE_ID, xevent->xbutton.button, xevent->xbutton.time);
     } break;
 
     case PropertyNotify:
@@ -1928,7 +1984,7 @@ void X11_PumpEvents(SDL_VideoDevice *_this)
 {
     SDL_VideoData *data = _this->internal;
     XEvent xevent;
-    int i;
+    int i, n;
 
     /* Check if a display had the mode changed and is waiting for a window to asynchronously become
      * fullscreen. If there is no fullscreen window past the elapsed timeout, revert the mode switch.
@@ -1967,9 +2023,14 @@ void X11_PumpEvents(SDL_VideoDevice *_this)
 
     SDL_zero(xevent);
 
-    /* Keep processing pending events */
-    while (X11_PollEvent(data->display, &xevent)) {
-        X11_DispatchEvent(_this, &xevent);
+    /* Read everything the server has sent in one go and dispatch it from the queue,
+       only going back to the socket once the batch has been handled. */
+    for (n = X11_XEventsQueued(data->display, QueuedAfterFlush); n > 0;
+         n = X11_XEventsQueued(data->display, QueuedAfterReading)) {
+        while (n-- > 0 && X11_XEventsQueued(data->display, QueuedAlready) > 0) {
+            X11_XNextEvent(data->display, &xevent);
+            X11_DispatchEvent(_this, &xevent);
+        }
     }
 
 #ifdef SDL_USE_IME
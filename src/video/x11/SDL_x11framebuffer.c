@@ -25,6 +25,10 @@
 #include "SDL_x11video.h"
 #include "SDL_x11framebuffer.h"
 
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+#include <time.h>
+#endif
+
 #ifndef NO_SHARED_MEMORY
 
 /* Shared memory error handler routine */
@@ -47,6 +51,264 @@ static SDL_bool have_mitshm(Display *dpy)
 
 #endif /* !NO_SHARED_MEMORY */
 
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+static SDL_bool have_present(SDL_VideoData *videodata)
+{
+    if (!videodata->present_checked) {
+        int event_base, error_base, major = 1, minor = 0;
+
+        videodata->present_checked = SDL_TRUE;
+        if (SDL_X11_HAVE_XPRESENT &&
+            X11_XPresentQueryExtension(videodata->display, &videodata->present_opcode, &event_base, &error_base) &&
+            X11_XPresentQueryVersion(videodata->display, &major, &minor)) {
+            videodata->have_present = SDL_GetHintBoolean(SDL_HINT_VIDEO_X11_PRESENT, SDL_TRUE);
+        }
+    }
+    return videodata->have_present;
+}
+
+static void X11_DestroyPresentPixmaps(SDL_WindowData *data)
+{
+    Display *display = data->videodata->display;
+    int i;
+
+    if (data->present_event_id) {
+        X11_XPresentFreeInput(display, data->xwindow, data->present_event_id);
+        data->present_event_id = 0;
+    }
+    for (i = 0; i < SDL_arraysize(data->present_pixmaps); ++i) {
+        if (data->present_pixmaps[i]) {
+            X11_XFreePixmap(display, data->present_pixmaps[i]);
+            data->present_pixmaps[i] = None;
+        }
+        data->present_busy[i] = SDL_FALSE;
+    }
+    data->use_present = SDL_FALSE;
+}
+
+/* The image is uploaded into an idle pixmap and handed to the server with
+ * PresentPixmap, which can flip it or copy it on vblank instead of drawing
+ * straight into the window. Each pixmap tracks the area where it lags the
+ * image, so only changed rows are uploaded, and a pixmap is never touched
+ * until the server reports it idle again.
+ */
+static SDL_bool X11_CreatePresentPixmaps(SDL_WindowData *data, int w, int h, int depth)
+{
+    Display *display = data->videodata->display;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(data->present_pixmaps); ++i) {
+        data->present_pixmaps[i] = X11_XCreatePixmap(display, data->xwindow, w, h, depth);
+        if (!data->present_pixmaps[i]) {
+            X11_DestroyPresentPixmaps(data);
+            return SDL_FALSE;
+        }
+        data->present_stale[i].x = 0;
+        data->present_stale[i].y = 0;
+        data->present_stale[i].w = w;
+        data->present_stale[i].h = h;
+    }
+    SDL_zero(data->present_pending);
+    data->present_event_id = X11_XPresentSelectInput(display, data->xwindow, PresentCompleteNotifyMask | PresentIdleNotifyMask);
+    data->use_present = SDL_TRUE;
+    return SDL_TRUE;
+}
+
+static void X11_PutImage(SDL_WindowData *data, Drawable drawable, int x, int y, int w, int h)
+{
+    Display *display = data->videodata->display;
+
+#ifndef NO_SHARED_MEMORY
+    if (data->use_mitshm) {
+        X11_XShmPutImage(display, drawable, data->gc, data->ximage, x, y, x, y, w, h, False);
+        return;
+    }
+#endif
+    X11_XPutImage(display, drawable, data->gc, data->ximage, x, y, x, y, w, h);
+}
+
+static SDL_bool X11_PresentWindowFramebuffer(SDL_WindowData *data, const SDL_Rect *rects, int numrects, int window_w, int window_h)
+{
+    Display *display = data->videodata->display;
+    const SDL_Rect bounds = { 0, 0, window_w, window_h };
+    XserverRegion update = None;
+    uint32_t options = PresentOptionNone;
+    uint64_t target_msc = 0;
+    SDL_Rect damage, rect;
+    int i, index = -1;
+
+    SDL_zero(damage);
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            if (SDL_RectEmpty(&damage)) {
+                damage = rect;
+            } else {
+                SDL_GetRectUnion(&damage, &rect, &damage);
+            }
+        }
+    }
+    if (SDL_RectEmpty(&damage)) {
+        return SDL_TRUE;
+    }
+
+    for (i = 0; i < SDL_arraysize(data->present_pixmaps); ++i) {
+        if (SDL_RectEmpty(&data->present_stale[i])) {
+            data->present_stale[i] = damage;
+        } else {
+            SDL_GetRectUnion(&data->present_stale[i], &damage, &data->present_stale[i]);
+        }
+        if (index < 0 && !data->present_busy[i]) {
+            index = i;
+        }
+    }
+
+    /* Both pixmaps are still queued. Drawing into the window now would be covered
+       by the older frames when they complete, so skip this update. Its damage is
+       recorded above and goes out with the next one. */
+    if (index < 0) {
+        if (SDL_RectEmpty(&data->present_pending)) {
+            data->present_pending = damage;
+        } else {
+            SDL_GetRectUnion(&data->present_pending, &damage, &data->present_pending);
+        }
+        return SDL_TRUE;
+    }
+
+    rect = data->present_stale[index];
+    X11_PutImage(data, data->present_pixmaps[index], rect.x, rect.y, rect.w, rect.h);
+    SDL_zero(data->present_stale[index]);
+
+#ifdef SDL_VIDEO_DRIVER_X11_XFIXES
+    if (SDL_X11_HAVE_XFIXES) {
+        XRectangle *xrects = SDL_small_alloc(XRectangle, numrects + 1, NULL);
+        if (xrects) {
+            int n = 0;
+            for (i = 0; i < numrects; ++i) {
+                if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+                    xrects[n].x = (short)rect.x;
+                    xrects[n].y = (short)rect.y;
+                    xrects[n].width = (unsigned short)rect.w;
+                    xrects[n].height = (unsigned short)rect.h;
+                    ++n;
+                }
+            }
+            if (SDL_GetRectIntersection(&data->present_pending, &bounds, &rect)) {
+                xrects[n].x = (short)rect.x;
+                xrects[n].y = (short)rect.y;
+                xrects[n].width = (unsigned short)rect.w;
+                xrects[n].height = (unsigned short)rect.h;
+                ++n;
+            }
+            update = X11_XFixesCreateRegion(display, xrects, n);
+            SDL_small_free(xrects, NULL);
+        }
+    }
+#endif
+
+    if (data->framebuffer_vsync == 0) {
+        options |= PresentOptionAsync;
+    } else if (data->present_last_msc) {
+        /* Adaptive vsync targets the next refresh but doesn't wait if it's already late */
+        if (data->framebuffer_vsync < 0) {
+            options |= PresentOptionAsync;
+            target_msc = data->present_last_msc + 1;
+        } else {
+            target_msc = data->present_last_msc + data->framebuffer_vsync;
+        }
+    }
+
+    X11_XPresentPixmap(display, data->xwindow, data->present_pixmaps[index], ++data->present_serial,
+                       None, update, 0, 0, None, None, None, options, target_msc, 0, 0, NULL, 0);
+    data->present_busy[index] = SDL_TRUE;
+    SDL_zero(data->present_pending);
+
+#ifdef SDL_VIDEO_DRIVER_X11_XFIXES
+    if (update != None) {
+        X11_XFixesDestroyRegion(display, update);
+    }
+#endif
+    return SDL_TRUE;
+}
+
+void X11_HandlePresentEvent(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
+{
+    SDL_WindowData *data;
+    int i;
+
+    if (cookie->evtype == PresentIdleNotify) {
+        const XPresentIdleNotifyEvent *ev = (const XPresentIdleNotifyEvent *)cookie->data;
+
+        data = X11_FindWindow(_this, ev->window);
+        if (data) {
+            for (i = 0; i < SDL_arraysize(data->present_pixmaps); ++i) {
+                if (data->present_pixmaps[i] == ev->pixmap) {
+                    data->present_busy[i] = SDL_FALSE;
+                }
+            }
+        }
+    } else if (cookie->evtype == PresentCompleteNotify) {
+        const XPresentCompleteNotifyEvent *ev = (const XPresentCompleteNotifyEvent *)cookie->data;
+        Sint64 offset = 0, refresh = 0, deadline = 0;
+        struct timespec now;
+
+        data = X11_FindWindow(_this, ev->window);
+        if (!data || ev->kind != PresentCompleteKindPixmap || !ev->msc) {
+            return;
+        }
+
+        /* UST is in microseconds on CLOCK_MONOTONIC; map it onto SDL_GetTicksNS() */
+        if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+            offset = (Sint64)SDL_GetTicksNS() - (Sint64)(SDL_SECONDS_TO_NS((Uint64)now.tv_sec) + now.tv_nsec);
+        }
+        if (data->present_last_msc && ev->msc > data->present_last_msc && ev->ust > data->present_last_ust) {
+            refresh = (Sint64)SDL_US_TO_NS(ev->ust - data->present_last_ust) / (Sint64)(ev->msc - data->present_last_msc);
+        }
+        if (refresh) {
+            deadline = (Sint64)SDL_US_TO_NS(ev->ust) + refresh + offset;
+            while (deadline <= (Sint64)SDL_GetTicksNS()) {
+                deadline += refresh;
+            }
+        }
+        data->present_last_ust = ev->ust;
+        data->present_last_msc = ev->msc;
+
+        const SDL_PropertiesID props = SDL_GetWindowProperties(data->window);
+        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_X11_PRESENTATION_TIME_NUMBER, (Sint64)SDL_US_TO_NS(ev->ust) + offset);
+        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_X11_PRESENTATION_REFRESH_NUMBER, refresh);
+        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_X11_PRESENTATION_SEQUENCE_NUMBER, (Sint64)ev->msc);
+        SDL_SetBooleanProperty(props, SDL_PROP_WINDOW_X11_PRESENTATION_FLIPPED_BOOLEAN, ev->mode == PresentCompleteModeFlip);
+        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_X11_NEXT_FRAME_DEADLINE_NUMBER, deadline);
+    }
+}
+#endif /* SDL_VIDEO_DRIVER_X11_XPRESENT */
+
+int X11_SetWindowFramebufferVSync(SDL_VideoDevice *_this, SDL_Window *window, int vsync)
+{
+    SDL_WindowData *data = window->internal;
+
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    if (have_present(data->videodata)) {
+        data->framebuffer_vsync = vsync;
+        return 0;
+    }
+#endif
+    if (vsync != SDL_WINDOW_SURFACE_VSYNC_DISABLED) {
+        return SDL_Unsupported();
+    }
+    data->framebuffer_vsync = vsync;
+    return 0;
+}
+
+int X11_GetWindowFramebufferVSync(SDL_VideoDevice *_this, SDL_Window *window, int *vsync)
+{
+    SDL_WindowData *data = window->internal;
+
+    if (vsync) {
+        *vsync = data->framebuffer_vsync;
+    }
+    return 0;
+}
+
 int X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format,
                                 void **pixels, int *pitch)
 {
@@ -120,6 +382,11 @@ int X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_
                 data->ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
                 data->use_mitshm = SDL_TRUE;
                 *pixels = shminfo->shmaddr;
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+                if (have_present(data->videodata)) {
+                    X11_CreatePresentPixmaps(data, w, h, vinfo.depth);
+                }
+#endif
                 return 0;
             }
         }
@@ -139,6 +406,11 @@ int X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_
         return SDL_SetError("Couldn't create XImage");
     }
     data->ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    if (have_present(data->videodata)) {
+        X11_CreatePresentPixmaps(data, w, h, vinfo.depth);
+    }
+#endif
     return 0;
 }
 
@@ -153,6 +425,13 @@ int X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, cons
 
     SDL_GetWindowSizeInPixels(window, &window_w, &window_h);
 
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    if (data->use_present && X11_PresentWindowFramebuffer(data, rects, numrects, window_w, window_h)) {
+        X11_XSync(display, False);
+        return 0;
+    }
+#endif
+
 #ifndef NO_SHARED_MEMORY
     if (data->use_mitshm) {
         for (i = 0; i < numrects; ++i) {
@@ -233,6 +512,10 @@ void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
 
     display = data->videodata->display;
 
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    X11_DestroyPresentPixmaps(data);
+#endif
+
     if (data->ximage) {
         XDestroyImage(data->ximage);
 
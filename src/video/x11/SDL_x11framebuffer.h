@@ -30,5 +30,7 @@ extern int X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *windo
 extern int X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window,
                                        const SDL_Rect *rects, int numrects);
 extern void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window);
+extern int X11_SetWindowFramebufferVSync(SDL_VideoDevice *_this, SDL_Window *window, int vsync);
+extern int X11_GetWindowFramebufferVSync(SDL_VideoDevice *_this, SDL_Window *window, int *vsync);
 
 #endif /* SDL_x11framebuffer_h_ */
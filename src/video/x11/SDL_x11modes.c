@@ -439,29 +439,28 @@ static void CalculateXRandRRefreshRate(const XRRModeInfo *info, int *numerator,
     }
 }
 
-static SDL_bool SetXRandRModeInfo(Display *display, XRRScreenResources *res, RRCrtc crtc,
+static void GetXRandRCrtcScale(Display *display, RRCrtc crtc, XFixed *scale_w, XFixed *scale_h)
+{
+    XRRCrtcTransformAttributes *attr;
+
+    *scale_w = 0x10000;
+    *scale_h = 0x10000;
+    if (X11_XRRGetCrtcTransform(display, crtc, &attr) && attr) {
+        *scale_w = attr->currentTransform.matrix[0][0];
+        *scale_h = attr->currentTransform.matrix[1][1];
+        X11_XFree(attr);
+    }
+}
+
+/* The rotation and scale are those of the CRTC driving the output, look them
+   up once by the caller rather than once per mode. */
+static SDL_bool SetXRandRModeInfo(XRRScreenResources *res, Rotation rotation, XFixed scale_w, XFixed scale_h,
                                   RRMode modeID, SDL_DisplayMode *mode)
 {
     int i;
     for (i = 0; i < res->nmode; ++i) {
         const XRRModeInfo *info = &res->modes[i];
         if (info->id == modeID) {
-            XRRCrtcInfo *crtcinfo;
-            Rotation rotation = 0;
-            XFixed scale_w = 0x10000, scale_h = 0x10000;
-            XRRCrtcTransformAttributes *attr;
-
-            crtcinfo = X11_XRRGetCrtcInfo(display, res, crtc);
-            if (crtcinfo) {
-                rotation = crtcinfo->rotation;
-                X11_XRRFreeCrtcInfo(crtcinfo);
-            }
-            if (X11_XRRGetCrtcTransform(display, crtc, &attr) && attr) {
-                scale_w = attr->currentTransform.matrix[0][0];
-                scale_h = attr->currentTransform.matrix[1][1];
-                X11_XFree(attr);
-            }
-
             if (rotation & (XRANDR_ROTATION_LEFT | XRANDR_ROTATION_RIGHT)) {
                 mode->w = (info->height * scale_w + 0xffff) >> 16;
                 mode->h = (info->width * scale_h + 0xffff) >> 16;
@@ -485,38 +484,33 @@ static void SetXRandRDisplayName(Display *dpy, Atom EDID, char *name, const size
 {
     /* See if we can get the EDID data for the real monitor name */
     int inches;
-    int nprop;
-    Atom *props = X11_XRRListOutputProperties(dpy, output, &nprop);
-    int i;
-
-    for (i = 0; i < nprop; ++i) {
-        unsigned char *prop;
-        int actual_format;
-        unsigned long nitems, bytes_after;
-        Atom actual_type;
-
-        if (props[i] == EDID) {
-            if (X11_XRRGetOutputProperty(dpy, output, props[i], 0, 100, False,
-                                         False, AnyPropertyType, &actual_type,
-                                         &actual_format, &nitems, &bytes_after,
-                                         &prop) == Success) {
-                MonitorInfo *info = decode_edid(prop);
-                if (info) {
+    unsigned char *prop = NULL;
+    int actual_format;
+    unsigned long nitems, bytes_after;
+    Atom actual_type;
+
+    /* Ask for the property directly instead of listing the output properties
+       first, and only fetch the 128 byte base block that holds the monitor
+       descriptors. An output without EDID comes back with no type. */
+    if (EDID != None &&
+        X11_XRRGetOutputProperty(dpy, output, EDID, 0, 128 / 4, False,
+                                 False, AnyPropertyType, &actual_type,
+                                 &actual_format, &nitems, &bytes_after,
+                                 &prop) == Success) {
+        if (actual_type != None && actual_format == 8 && nitems >= 128) {
+            MonitorInfo *info = decode_edid(prop);
+            if (info) {
 #ifdef X11MODES_DEBUG
-                    printf("Found EDID data for %s\n", name);
-                    dump_monitor_info(info);
+                printf("Found EDID data for %s\n", name);
+                dump_monitor_info(info);
 #endif
-                    SDL_strlcpy(name, info->dsc_product_name, namelen);
-                    SDL_free(info);
-                }
-                X11_XFree(prop);
+                SDL_strlcpy(name, info->dsc_product_name, namelen);
+                SDL_free(info);
             }
-            break;
         }
-    }
-
-    if (props) {
-        X11_XFree(props);
+        if (prop) {
+            X11_XFree(prop);
+        }
     }
 
     inches = (int)((SDL_sqrtf(widthmm * widthmm + heightmm * heightmm) / 25.4f) + 0.5f);
@@ -530,9 +524,10 @@ static void SetXRandRDisplayName(Display *dpy, Atom EDID, char *name, const size
 #endif
 }
 
+/* display_name may be NULL if the caller doesn't need the monitor name, which
+   skips reading and decoding the EDID. */
 static int X11_FillXRandRDisplayInfo(SDL_VideoDevice *_this, Display *dpy, int screen, RROutput outputid, XRRScreenResources *res, SDL_VideoDisplay *display, char *display_name, size_t display_name_size)
 {
-    Atom EDID = X11_XInternAtom(dpy, "EDID", False);
     XRROutputInfo *output_info;
     int display_x, display_y;
     unsigned long display_mm_width, display_mm_height;
@@ -542,13 +537,15 @@ static int X11_FillXRandRDisplayInfo(SDL_VideoDevice *_this, Display *dpy, int s
     RRMode modeID;
     RRCrtc output_crtc;
     XRRCrtcInfo *crtc;
+    Rotation rotation;
+    XFixed scale_w, scale_h;
     XVisualInfo vinfo;
     Uint32 pixelformat;
     XPixmapFormatValues *pixmapformats;
     int scanline_pad;
     int i, n;
 
-    if (!display || !display_name) {
+    if (!display) {
         return -1; /* invalid parameters */
     }
 
@@ -579,7 +576,9 @@ static int X11_FillXRandRDisplayInfo(SDL_VideoDevice *_this, Display *dpy, int s
         return -1; /* ignore this one. */
     }
 
-    SDL_strlcpy(display_name, output_info->name, display_name_size);
+    if (display_name) {
+        SDL_strlcpy(display_name, output_info->name, display_name_size);
+    }
     display_mm_width = output_info->mm_width;
     display_mm_height = output_info->mm_height;
     output_crtc = output_info->crtc;
@@ -598,6 +597,7 @@ static int X11_FillXRandRDisplayInfo(SDL_VideoDevice *_this, Display *dpy, int s
 
     display_x = crtc->x;
     display_y = crtc->y;
+    rotation = crtc->rotation;
 
     X11_XRRFreeCrtcInfo(crtc);
 
@@ -624,11 +624,14 @@ static int X11_FillXRandRDisplayInfo(SDL_VideoDevice *_this, Display *dpy, int s
     displaydata->use_xrandr = SDL_TRUE;
     displaydata->xrandr_output = outputid;
 
-    SetXRandRModeInfo(dpy, res, output_crtc, modeID, &mode);
-    SetXRandRDisplayName(dpy, EDID, display_name, display_name_size, outputid, display_mm_width, display_mm_height);
+    GetXRandRCrtcScale(dpy, output_crtc, &scale_w, &scale_h);
+    SetXRandRModeInfo(res, rotation, scale_w, scale_h, modeID, &mode);
+    if (display_name) {
+        SetXRandRDisplayName(dpy, _this->internal->EDID, display_name, display_name_size, outputid, display_mm_width, display_mm_height);
+    }
 
     SDL_zero(*display);
-    if (*display_name) {
+    if (display_name && *display_name) {
         display->name = display_name;
     }
     display->desktop_mode = mode;
@@ -658,9 +661,9 @@ static int X11_AddXRandRDisplay(SDL_VideoDevice *_this, Display *dpy, int screen
 static int X11_UpdateXRandRDisplay(SDL_VideoDevice *_this, Display *dpy, int screen, RROutput outputid, XRRScreenResources *res, SDL_VideoDisplay *existing_display)
 {
     SDL_VideoDisplay display;
-    char display_name[128];
 
-    if (X11_FillXRandRDisplayInfo(_this, dpy, screen, outputid, res, &display, display_name, sizeof(display_name)) == -1) {
+    /* The name was set when the display was added, don't re-read the EDID on every output change */
+    if (X11_FillXRandRDisplayInfo(_this, dpy, screen, outputid, res, &display, NULL, 0) == -1) {
         return -1; /* failed to query current display state */
     }
 
@@ -935,7 +938,15 @@ int X11_GetDisplayModes(SDL_VideoDevice *_this, SDL_VideoDisplay *sdl_display)
         Display *display = _this->internal->display;
         XRRScreenResources *res;
 
-        res = X11_XRRGetScreenResources(display, RootWindow(display, data->screen));
+        /* The current resources don't make the server reprobe the outputs,
+           which can take a long time with several monitors attached. */
+        res = X11_XRRGetScreenResourcesCurrent(display, RootWindow(display, data->screen));
+        if (!res || res->noutput == 0) {
+            if (res) {
+                X11_XRRFreeScreenResources(res);
+            }
+            res = X11_XRRGetScreenResources(display, RootWindow(display, data->screen));
+        }
         if (res) {
             SDL_DisplayModeData *modedata;
             XRROutputInfo *output_info;
@@ -943,6 +954,16 @@ int X11_GetDisplayModes(SDL_VideoDevice *_this, SDL_VideoDisplay *sdl_display)
 
             output_info = X11_XRRGetOutputInfo(display, res, data->xrandr_output);
             if (output_info && output_info->connection != RR_Disconnected) {
+                Rotation rotation = 0;
+                XFixed scale_w, scale_h;
+                XRRCrtcInfo *crtcinfo = X11_XRRGetCrtcInfo(display, res, output_info->crtc);
+
+                if (crtcinfo) {
+                    rotation = crtcinfo->rotation;
+                    X11_XRRFreeCrtcInfo(crtcinfo);
+                }
+                GetXRandRCrtcScale(display, output_info->crtc, &scale_w, &scale_h);
+
                 for (i = 0; i < output_info->nmode; ++i) {
                     modedata = (SDL_DisplayModeData *)SDL_calloc(1, sizeof(SDL_DisplayModeData));
                     if (!modedata) {
@@ -950,7 +971,7 @@ int X11_GetDisplayModes(SDL_VideoDevice *_this, SDL_VideoDisplay *sdl_display)
                     }
                     mode.internal = modedata;
 
-                    if (!SetXRandRModeInfo(display, res, output_info->crtc, output_info->modes[i], &mode) ||
+                    if (!SetXRandRModeInfo(res, rotation, scale_w, scale_h, output_info->modes[i], &mode) ||
                         !SDL_AddFullscreenDisplayMode(sdl_display, &mode)) {
                         SDL_free(modedata);
                     }
@@ -25,6 +25,7 @@
 #include <unistd.h> /* For getpid() and readlink() */
 
 #include "../../core/linux/SDL_system_theme.h"
+#include "../../events/SDL_events_c.h"
 #include "../../events/SDL_keyboard_c.h"
 #include "../../events/SDL_mouse_c.h"
 #include "../SDL_pixels_c.h"
@@ -214,6 +215,8 @@ static SDL_VideoDevice *X11_CreateDevice(void)
     device->CreateWindowFramebuffer = X11_CreateWindowFramebuffer;
     device->UpdateWindowFramebuffer = X11_UpdateWindowFramebuffer;
     device->DestroyWindowFramebuffer = X11_DestroyWindowFramebuffer;
+    device->SetWindowFramebufferVSync = X11_SetWindowFramebufferVSync;
+    device->GetWindowFramebufferVSync = X11_GetWindowFramebufferVSync;
     device->SetWindowHitTest = X11_SetWindowHitTest;
     device->AcceptDragAndDrop = X11_AcceptDragAndDrop;
     device->UpdateWindowShape = X11_UpdateWindowShape;
@@ -261,6 +264,7 @@ static SDL_VideoDevice *X11_CreateDevice(void)
     device->SetClipboardData = X11_SetClipboardData;
     device->GetClipboardData = X11_GetClipboardData;
     device->HasClipboardData = X11_HasClipboardData;
+    device->OpenClipboardData = X11_OpenClipboardData;
     device->SetPrimarySelectionText = X11_SetPrimarySelectionText;
     device->GetPrimarySelectionText = X11_GetPrimarySelectionText;
     device->HasPrimarySelectionText = X11_HasPrimarySelectionText;
@@ -425,6 +429,8 @@ int X11_VideoInit(SDL_VideoDevice *_this)
     GET_ATOM(XdndFinished);
     GET_ATOM(XdndSelection);
     GET_ATOM(XKLAVIER_STATE);
+    GET_ATOM(_ICC_PROFILE);
+    GET_ATOM(EDID);
 
     /* Detect the window manager */
     X11_CheckWindowManager(_this);
@@ -460,6 +466,8 @@ int X11_VideoInit(SDL_VideoDevice *_this)
     X11_InitPen(_this);
 #endif
 
+    SDL_AddEventWaitSource(ConnectionNumber(data->display));
+
     return 0;
 }
 
@@ -467,6 +475,8 @@ void X11_VideoQuit(SDL_VideoDevice *_this)
 {
     SDL_VideoData *data = _this->internal;
 
+    SDL_RemoveEventWaitSource(ConnectionNumber(data->display));
+
     if (data->clipboard_window) {
         X11_XDestroyWindow(data->display, data->clipboard_window);
     }
@@ -103,6 +103,8 @@ struct SDL_VideoData
     Atom XdndFinished;
     Atom XdndSelection;
     Atom XKLAVIER_STATE;
+    Atom _ICC_PROFILE;
+    Atom EDID;
 
     SDL_Scancode key_layout[256];
     SDL_bool selection_waiting;
@@ -121,6 +123,13 @@ struct SDL_VideoData
 
     int xrandr_event_base;
 
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    /* The Present extension, checked when the first window framebuffer is created */
+    SDL_bool present_checked;
+    SDL_bool have_present;
+    int present_opcode;
+#endif
+
 #ifdef SDL_VIDEO_DRIVER_X11_HAS_XKBLOOKUPKEYSYM
     XkbDescPtr xkb;
 #endif
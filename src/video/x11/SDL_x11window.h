@@ -53,6 +53,19 @@ struct SDL_WindowData
 #endif
     XImage *ximage;
     GC gc;
+#ifdef SDL_VIDEO_DRIVER_X11_XPRESENT
+    /* Window framebuffer presentation through the Present extension */
+    SDL_bool use_present;
+    Pixmap present_pixmaps[2];
+    SDL_bool present_busy[2];
+    SDL_Rect present_stale[2]; /* area of each pixmap out of date with the ximage */
+    SDL_Rect present_pending;  /* area updated while both pixmaps were busy, not presented yet */
+    XID present_event_id;
+    Uint32 present_serial;
+    Uint64 present_last_ust;
+    Uint64 present_last_msc;
+#endif
+    int framebuffer_vsync;
     XIC ic;
     SDL_bool created;
     int border_left;
@@ -288,6 +288,25 @@ static void xinput2_pen_ensure_window(SDL_VideoDevice *_this, const SDL_Pen *pen
 }
 #endif
 
+/* Raw motion arrives at the full device rate, but outside of relative mode all it
+   does is mark the global mouse state dirty, which only needs the event header.
+   Skipping X11_XGetEventData() for these saves decoding and allocating every one. */
+SDL_bool X11_HandleXinput2EventWithoutData(SDL_VideoDevice *_this, const XGenericEventCookie *cookie)
+{
+#ifdef SDL_VIDEO_DRIVER_X11_XINPUT2
+    SDL_VideoData *videodata = (SDL_VideoData *)_this->internal;
+
+    if (cookie->extension == xinput2_opcode && cookie->evtype == XI_RawMotion) {
+        SDL_Mouse *mouse = SDL_GetMouse();
+        if (!mouse->relative_mode || mouse->relative_mode_warp) {
+            videodata->global_mouse_changed = SDL_TRUE;
+            return SDL_TRUE;
+        }
+    }
+#endif
+    return SDL_FALSE;
+}
+
 void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
 {
 #ifdef SDL_VIDEO_DRIVER_X11_XINPUT2
@@ -371,7 +390,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
             }
         }
 
-        SDL_SendMouseMotion(0, mouse->focus, (SDL_MouseID)rawev->sourceid, SDL_TRUE, (float)processed_coords[0], (float)processed_coords[1]);
+        SDL_SendMouseMotion(X11_GetEventTimestamp(rawev->time), mouse->focus, (SDL_MouseID)rawev->sourceid, SDL_TRUE, (float)processed_coords[0], (float)processed_coords[1]);
         devinfo->prev_coords[0] = coords[0];
         devinfo->prev_coords[1] = coords[1];
     } break;
@@ -445,10 +464,10 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
                         break; /* Don't pass on this event */
                     }
                 }
-                SDL_SendPenTipEvent(0, pen->header.id,
+                SDL_SendPenTipEvent(X11_GetEventTimestamp(xev->time), pen->header.id,
                                     pressed ? SDL_PRESSED : SDL_RELEASED);
             } else {
-                SDL_SendPenButton(0, pen->header.id,
+                SDL_SendPenButton(X11_GetEventTimestamp(xev->time), pen->header.id,
                                   pressed ? SDL_PRESSED : SDL_RELEASED,
                                   button - 1);
             }
@@ -465,7 +484,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
                 X11_HandleButtonPress(_this, windowdata, (SDL_MouseID)xev->sourceid, button,
                                       (float)xev->event_x, (float)xev->event_y, xev->time);
             } else {
-                X11_HandleButtonRelease(_this, windowdata, (SDL_MouseID)xev->sourceid, button);
+                X11_HandleButtonRelease(_this, windowdata, (SDL_MouseID)xev->sourceid, button, xev->time);
             }
         }
     } break;
@@ -501,7 +520,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
 
             xinput2_pen_ensure_window(_this, pen, xev->event);
 
-            SDL_SendPenMotion(0, pen->header.id,
+            SDL_SendPenMotion(X11_GetEventTimestamp(xev->time), pen->header.id,
                               SDL_TRUE,
                               &pen_status);
             break;
@@ -513,7 +532,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
                 SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
                 if (window) {
                     X11_ProcessHitTest(_this, window->internal, (float)xev->event_x, (float)xev->event_y, SDL_FALSE);
-                    SDL_SendMouseMotion(0, window, (SDL_MouseID)xev->sourceid, SDL_FALSE, (float)xev->event_x, (float)xev->event_y);
+                    SDL_SendMouseMotion(X11_GetEventTimestamp(xev->time), window, (SDL_MouseID)xev->sourceid, SDL_FALSE, (float)xev->event_x, (float)xev->event_y);
                 }
             }
         }
@@ -526,7 +545,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
         float x, y;
         SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
         xinput2_normalize_touch_coordinates(window, xev->event_x, xev->event_y, &x, &y);
-        SDL_SendTouch(0, xev->sourceid, xev->detail, window, SDL_TRUE, x, y, 1.0);
+        SDL_SendTouch(X11_GetEventTimestamp(xev->time), xev->sourceid, xev->detail, window, SDL_TRUE, x, y, 1.0);
     } break;
 
     case XI_TouchEnd:
@@ -535,7 +554,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
         float x, y;
         SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
         xinput2_normalize_touch_coordinates(window, xev->event_x, xev->event_y, &x, &y);
-        SDL_SendTouch(0, xev->sourceid, xev->detail, window, SDL_FALSE, x, y, 1.0);
+        SDL_SendTouch(X11_GetEventTimestamp(xev->time), xev->sourceid, xev->detail, window, SDL_FALSE, x, y, 1.0);
     } break;
 
     case XI_TouchUpdate:
@@ -544,7 +563,7 @@ void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie)
         float x, y;
         SDL_Window *window = xinput2_get_sdlwindow(videodata, xev->event);
         xinput2_normalize_touch_coordinates(window, xev->event_x, xev->event_y, &x, &y);
-        SDL_SendTouchMotion(0, xev->sourceid, xev->detail, window, x, y, 1.0);
+        SDL_SendTouchMotion(X11_GetEventTimestamp(xev->time), xev->sourceid, xev->detail, window, x, y, 1.0);
     } break;
 #endif /* SDL_VIDEO_DRIVER_X11_XINPUT2_SUPPORTS_MULTITOUCH */
     }
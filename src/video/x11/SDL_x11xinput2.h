@@ -33,6 +33,7 @@ typedef struct XGenericEventCookie XGenericEventCookie;
 extern SDL_bool X11_InitXinput2(SDL_VideoDevice *_this);
 extern void X11_InitXinput2Multitouch(SDL_VideoDevice *_this);
 extern void X11_HandleXinput2Event(SDL_VideoDevice *_this, XGenericEventCookie *cookie);
+extern SDL_bool X11_HandleXinput2EventWithoutData(SDL_VideoDevice *_this, const XGenericEventCookie *cookie);
 extern int X11_Xinput2IsInitialized(void);
 extern int X11_Xinput2IsMultitouchSupported(void);
 extern void X11_Xinput2SelectTouch(SDL_VideoDevice *_this, SDL_Window *window);
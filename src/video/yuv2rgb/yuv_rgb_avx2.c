@@ -0,0 +1,346 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+#include "SDL_internal.h"
+
+#if SDL_HAVE_YUV
+#include "yuv_rgb_internal.h"
+
+#ifdef SDL_AVX2_INTRINSICS
+
+/* The 8-bit kernels use the same 16-bit arithmetic as the sse implementation,
+ * 32 pixels of two lines at a time. The 10-bit kernels use the same 32-bit
+ * arithmetic as the standard c implementation, 16 pixels of two lines at a time.
+ * Columns and lines that don't fill a whole block are converted by the
+ * standard c implementation.
+ */
+
+typedef void (*yuv_std_func)(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+typedef void (*yuv16_std_func)(
+        uint32_t width, uint32_t height,
+        const uint16_t *y, const uint16_t *u, const uint16_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") yuv_rgba_line32_avx2(
+	const uint8_t *y_ptr, uint8_t *rgb_ptr,
+	__m256i r_uv_1, __m256i g_uv_1, __m256i b_uv_1, __m256i r_uv_2, __m256i g_uv_2, __m256i b_uv_2,
+	__m256i y_shift, __m256i y_factor, int rgb_format)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i a = _mm256_set1_epi8((char)0xFF);
+	__m256i y, y_1, y_2, r, g, b, c0, c1, c2, c3;
+	__m256i lo_01, hi_01, lo_23, hi_23, rgb_1, rgb_2, rgb_3, rgb_4;
+
+	/* y_1 holds pixels 0-7 and 16-23, y_2 pixels 8-15 and 24-31, like the uv contributions */
+	y = _mm256_loadu_si256((const __m256i *)y_ptr);
+	y_1 = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_unpacklo_epi8(y, zero), y_shift), y_factor);
+	y_2 = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_unpackhi_epi8(y, zero), y_shift), y_factor);
+
+	r = _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(r_uv_1, y_1), PRECISION),
+	                        _mm256_srai_epi16(_mm256_add_epi16(r_uv_2, y_2), PRECISION));
+	g = _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(g_uv_1, y_1), PRECISION),
+	                        _mm256_srai_epi16(_mm256_add_epi16(g_uv_2, y_2), PRECISION));
+	b = _mm256_packus_epi16(_mm256_srai_epi16(_mm256_add_epi16(b_uv_1, y_1), PRECISION),
+	                        _mm256_srai_epi16(_mm256_add_epi16(b_uv_2, y_2), PRECISION));
+
+	/* byte order of the pixels in memory */
+	switch (rgb_format) {
+	case RGB_FORMAT_RGBA:
+		c0 = a; c1 = b; c2 = g; c3 = r;
+		break;
+	case RGB_FORMAT_BGRA:
+		c0 = a; c1 = r; c2 = g; c3 = b;
+		break;
+	case RGB_FORMAT_ARGB:
+		c0 = b; c1 = g; c2 = r; c3 = a;
+		break;
+	default: /* RGB_FORMAT_ABGR */
+		c0 = r; c1 = g; c2 = b; c3 = a;
+		break;
+	}
+
+	lo_01 = _mm256_unpacklo_epi8(c0, c1);
+	hi_01 = _mm256_unpackhi_epi8(c0, c1);
+	lo_23 = _mm256_unpacklo_epi8(c2, c3);
+	hi_23 = _mm256_unpackhi_epi8(c2, c3);
+	rgb_1 = _mm256_unpacklo_epi16(lo_01, lo_23); /* pixels 0-3 and 16-19 */
+	rgb_2 = _mm256_unpackhi_epi16(lo_01, lo_23); /* pixels 4-7 and 20-23 */
+	rgb_3 = _mm256_unpacklo_epi16(hi_01, hi_23); /* pixels 8-11 and 24-27 */
+	rgb_4 = _mm256_unpackhi_epi16(hi_01, hi_23); /* pixels 12-15 and 28-31 */
+
+	_mm256_storeu_si256((__m256i *)(rgb_ptr), _mm256_permute2x128_si256(rgb_1, rgb_2, 0x20));
+	_mm256_storeu_si256((__m256i *)(rgb_ptr + 32), _mm256_permute2x128_si256(rgb_3, rgb_4, 0x20));
+	_mm256_storeu_si256((__m256i *)(rgb_ptr + 64), _mm256_permute2x128_si256(rgb_1, rgb_2, 0x31));
+	_mm256_storeu_si256((__m256i *)(rgb_ptr + 96), _mm256_permute2x128_si256(rgb_3, rgb_4, 0x31));
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") yuv_rgba_avx2(
+	uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type, int yuv_format, int rgb_format, yuv_std_func std_function)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const int uv_pixel_stride = (yuv_format == YUV_FORMAT_NV12) ? 2 : 1;
+	const SDL_bool uv_swapped = (V < U);
+	const uint32_t converted = (width & ~31);
+	const __m256i y_shift = _mm256_set1_epi16(param->y_shift);
+	const __m256i y_factor = _mm256_set1_epi16(param->y_factor);
+	const __m256i v_r_factor = _mm256_set1_epi16(param->v_r_factor);
+	const __m256i u_g_factor = _mm256_set1_epi16(param->u_g_factor);
+	const __m256i v_g_factor = _mm256_set1_epi16(param->v_g_factor);
+	const __m256i u_b_factor = _mm256_set1_epi16(param->u_b_factor);
+	const __m256i uv_offset = _mm256_set1_epi16(-128);
+	uint32_t xpos, ypos;
+
+	for (ypos = 0; ypos + 1 < height; ypos += 2) {
+		const uint8_t *y_ptr1 = Y + ypos * Y_stride,
+			*y_ptr2 = Y + (ypos + 1) * Y_stride,
+			*u_ptr = U + (ypos / 2) * UV_stride,
+			*v_ptr = V + (ypos / 2) * UV_stride;
+
+		uint8_t *rgb_ptr1 = RGB + ypos * RGB_stride,
+			*rgb_ptr2 = RGB + (ypos + 1) * RGB_stride;
+
+		for (xpos = 0; xpos < converted; xpos += 32) {
+			__m256i u, v, r_tmp, g_tmp, b_tmp;
+			__m256i r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2;
+
+			if (yuv_format == YUV_FORMAT_NV12) {
+				/* Load the 16 interleaved pairs from the first byte of the block,
+				 * which doesn't read past the end of the line for NV21 */
+				const __m256i uv = _mm256_loadu_si256((const __m256i *)(uv_swapped ? v_ptr : u_ptr));
+				const __m256i first = _mm256_and_si256(uv, _mm256_set1_epi16(0xFF));
+				const __m256i second = _mm256_srli_epi16(uv, 8);
+				u = uv_swapped ? second : first;
+				v = uv_swapped ? first : second;
+			} else {
+				u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)u_ptr));
+				v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)v_ptr));
+			}
+			u = _mm256_add_epi16(u, uv_offset);
+			v = _mm256_add_epi16(v, uv_offset);
+
+			r_tmp = _mm256_mullo_epi16(v, v_r_factor);
+			g_tmp = _mm256_add_epi16(_mm256_mullo_epi16(u, u_g_factor), _mm256_mullo_epi16(v, v_g_factor));
+			b_tmp = _mm256_mullo_epi16(u, u_b_factor);
+
+			/* each uv sample covers two pixels */
+			r_uv_1 = _mm256_unpacklo_epi16(r_tmp, r_tmp);
+			g_uv_1 = _mm256_unpacklo_epi16(g_tmp, g_tmp);
+			b_uv_1 = _mm256_unpacklo_epi16(b_tmp, b_tmp);
+			r_uv_2 = _mm256_unpackhi_epi16(r_tmp, r_tmp);
+			g_uv_2 = _mm256_unpackhi_epi16(g_tmp, g_tmp);
+			b_uv_2 = _mm256_unpackhi_epi16(b_tmp, b_tmp);
+
+			yuv_rgba_line32_avx2(y_ptr1, rgb_ptr1, r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2, y_shift, y_factor, rgb_format);
+			yuv_rgba_line32_avx2(y_ptr2, rgb_ptr2, r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2, y_shift, y_factor, rgb_format);
+
+			y_ptr1 += 32;
+			y_ptr2 += 32;
+			u_ptr += 16 * uv_pixel_stride;
+			v_ptr += 16 * uv_pixel_stride;
+			rgb_ptr1 += 32 * 4;
+			rgb_ptr2 += 32 * 4;
+		}
+	}
+
+	/* Catch the right column, if needed */
+	if (converted != width && height >= 2) {
+		std_function(width - converted, height & ~1,
+			Y + converted, U + (converted / 2) * uv_pixel_stride, V + (converted / 2) * uv_pixel_stride,
+			Y_stride, UV_stride, RGB + converted * 4, RGB_stride, yuv_type);
+	}
+
+	/* Catch the last line, if needed */
+	if (height & 1) {
+		ypos = height - 1;
+		std_function(width, 1,
+			Y + ypos * Y_stride, U + (ypos / 2) * UV_stride, V + (ypos / 2) * UV_stride,
+			Y_stride, UV_stride, RGB + ypos * RGB_stride, RGB_stride, yuv_type);
+	}
+}
+
+#define YUV_AVX2_FUNCTION(AVX2_FUNCTION_NAME, STD_FUNCTION_NAME, YUV_FORMAT, RGB_FORMAT) \
+void SDL_TARGETING("avx2") AVX2_FUNCTION_NAME(uint32_t width, uint32_t height, \
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride, \
+	uint8_t *RGB, uint32_t RGB_stride, \
+	YCbCrType yuv_type) \
+{ \
+	yuv_rgba_avx2(width, height, Y, U, V, Y_stride, UV_stride, RGB, RGB_stride, yuv_type, YUV_FORMAT, RGB_FORMAT, STD_FUNCTION_NAME); \
+}
+
+YUV_AVX2_FUNCTION(yuv420_rgba_avx2, yuv420_rgba_std, YUV_FORMAT_420, RGB_FORMAT_RGBA)
+YUV_AVX2_FUNCTION(yuv420_bgra_avx2, yuv420_bgra_std, YUV_FORMAT_420, RGB_FORMAT_BGRA)
+YUV_AVX2_FUNCTION(yuv420_argb_avx2, yuv420_argb_std, YUV_FORMAT_420, RGB_FORMAT_ARGB)
+YUV_AVX2_FUNCTION(yuv420_abgr_avx2, yuv420_abgr_std, YUV_FORMAT_420, RGB_FORMAT_ABGR)
+YUV_AVX2_FUNCTION(yuvnv12_rgba_avx2, yuvnv12_rgba_std, YUV_FORMAT_NV12, RGB_FORMAT_RGBA)
+YUV_AVX2_FUNCTION(yuvnv12_bgra_avx2, yuvnv12_bgra_std, YUV_FORMAT_NV12, RGB_FORMAT_BGRA)
+YUV_AVX2_FUNCTION(yuvnv12_argb_avx2, yuvnv12_argb_std, YUV_FORMAT_NV12, RGB_FORMAT_ARGB)
+YUV_AVX2_FUNCTION(yuvnv12_abgr_avx2, yuvnv12_abgr_std, YUV_FORMAT_NV12, RGB_FORMAT_ABGR)
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") yuvp010_save8_avx2(uint8_t *rgb_ptr, __m256i r, __m256i g, __m256i b, int rgb_format)
+{
+	if (rgb_format == RGB_FORMAT_XBGR2101010) {
+		__m256i rgb = _mm256_or_si256(_mm256_set1_epi32((int)0xC0000000), r);
+		rgb = _mm256_or_si256(rgb, _mm256_slli_epi32(g, 10));
+		rgb = _mm256_or_si256(rgb, _mm256_slli_epi32(b, 20));
+		_mm256_storeu_si256((__m256i *)rgb_ptr, rgb);
+	} else if (rgb_format == RGB_FORMAT_RGBA64) {
+		__m256i rg, ba, rgba_1, rgba_2;
+
+		/* expand to 16 bits, like expand10() */
+		r = _mm256_or_si256(_mm256_slli_epi32(r, 6), _mm256_srli_epi32(r, 4));
+		g = _mm256_or_si256(_mm256_slli_epi32(g, 6), _mm256_srli_epi32(g, 4));
+		b = _mm256_or_si256(_mm256_slli_epi32(b, 6), _mm256_srli_epi32(b, 4));
+		rg = _mm256_or_si256(r, _mm256_slli_epi32(g, 16));
+		ba = _mm256_or_si256(b, _mm256_set1_epi32((int)0xFFFF0000));
+		rgba_1 = _mm256_unpacklo_epi32(rg, ba); /* pixels 0-1 and 4-5 */
+		rgba_2 = _mm256_unpackhi_epi32(rg, ba); /* pixels 2-3 and 6-7 */
+		_mm256_storeu_si256((__m256i *)(rgb_ptr), _mm256_permute2x128_si256(rgba_1, rgba_2, 0x20));
+		_mm256_storeu_si256((__m256i *)(rgb_ptr + 32), _mm256_permute2x128_si256(rgba_1, rgba_2, 0x31));
+	} else { /* RGB_FORMAT_RGBA128_FLOAT */
+		const __m256 scale = _mm256_set1_ps(1023.0f);
+		const __m256 rf = _mm256_div_ps(_mm256_cvtepi32_ps(r), scale);
+		const __m256 gf = _mm256_div_ps(_mm256_cvtepi32_ps(g), scale);
+		const __m256 bf = _mm256_div_ps(_mm256_cvtepi32_ps(b), scale);
+		const __m256 af = _mm256_set1_ps(1.0f);
+		const __m256 rg_lo = _mm256_unpacklo_ps(rf, gf);
+		const __m256 rg_hi = _mm256_unpackhi_ps(rf, gf);
+		const __m256 ba_lo = _mm256_unpacklo_ps(bf, af);
+		const __m256 ba_hi = _mm256_unpackhi_ps(bf, af);
+		const __m256 rgba_1 = _mm256_shuffle_ps(rg_lo, ba_lo, _MM_SHUFFLE(1, 0, 1, 0)); /* pixels 0 and 4 */
+		const __m256 rgba_2 = _mm256_shuffle_ps(rg_lo, ba_lo, _MM_SHUFFLE(3, 2, 3, 2)); /* pixels 1 and 5 */
+		const __m256 rgba_3 = _mm256_shuffle_ps(rg_hi, ba_hi, _MM_SHUFFLE(1, 0, 1, 0)); /* pixels 2 and 6 */
+		const __m256 rgba_4 = _mm256_shuffle_ps(rg_hi, ba_hi, _MM_SHUFFLE(3, 2, 3, 2)); /* pixels 3 and 7 */
+		_mm256_storeu_ps((float *)(rgb_ptr), _mm256_permute2f128_ps(rgba_1, rgba_2, 0x20));
+		_mm256_storeu_ps((float *)(rgb_ptr + 32), _mm256_permute2f128_ps(rgba_3, rgba_4, 0x20));
+		_mm256_storeu_ps((float *)(rgb_ptr + 64), _mm256_permute2f128_ps(rgba_1, rgba_2, 0x31));
+		_mm256_storeu_ps((float *)(rgb_ptr + 96), _mm256_permute2f128_ps(rgba_3, rgba_4, 0x31));
+	}
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") yuvp010_line16_avx2(
+	const uint8_t *y_ptr, uint8_t *rgb_ptr,
+	__m256i r_uv_1, __m256i g_uv_1, __m256i b_uv_1, __m256i r_uv_2, __m256i g_uv_2, __m256i b_uv_2,
+	__m256i y_shift, __m256i y_factor, int rgb_format, int rgb_pixel_stride)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i max = _mm256_set1_epi32(1023);
+	const __m256i y = _mm256_loadu_si256((const __m256i *)y_ptr);
+	__m256i y_1 = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(y));
+	__m256i y_2 = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(y, 1));
+	__m256i r, g, b;
+
+	y_1 = _mm256_mullo_epi32(_mm256_srai_epi32(_mm256_sub_epi32(y_1, y_shift), 6), y_factor);
+	y_2 = _mm256_mullo_epi32(_mm256_srai_epi32(_mm256_sub_epi32(y_2, y_shift), 6), y_factor);
+
+	/* same as clamp10() */
+	r = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(y_1, r_uv_1), PRECISION), zero), max);
+	g = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(y_1, g_uv_1), PRECISION), zero), max);
+	b = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(y_1, b_uv_1), PRECISION), zero), max);
+	yuvp010_save8_avx2(rgb_ptr, r, g, b, rgb_format);
+
+	r = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(y_2, r_uv_2), PRECISION), zero), max);
+	g = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(y_2, g_uv_2), PRECISION), zero), max);
+	b = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(y_2, b_uv_2), PRECISION), zero), max);
+	yuvp010_save8_avx2(rgb_ptr + 8 * rgb_pixel_stride, r, g, b, rgb_format);
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") yuvp010_avx2(
+	uint32_t width, uint32_t height,
+	const uint16_t *Y, const uint16_t *U, const uint16_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type, int rgb_format, yuv16_std_func std_function)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const int rgb_pixel_stride = (rgb_format == RGB_FORMAT_RGBA128_FLOAT) ? 16 : (rgb_format == RGB_FORMAT_RGBA64) ? 8 : 4;
+	const SDL_bool uv_swapped = (V < U);
+	const uint32_t converted = (width & ~15);
+	const __m256i y_shift = _mm256_set1_epi32(param->y_shift);
+	const __m256i y_factor = _mm256_set1_epi32(param->y_factor);
+	const __m256i v_r_factor = _mm256_set1_epi32(param->v_r_factor);
+	const __m256i u_g_factor = _mm256_set1_epi32(param->u_g_factor);
+	const __m256i v_g_factor = _mm256_set1_epi32(param->v_g_factor);
+	const __m256i u_b_factor = _mm256_set1_epi32(param->u_b_factor);
+	const __m256i uv_offset = _mm256_set1_epi32(512);
+	const __m256i index_1 = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	const __m256i index_2 = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+	uint32_t xpos, ypos;
+
+	for (ypos = 0; ypos + 1 < height; ypos += 2) {
+		const uint8_t *y_ptr1 = (const uint8_t *)Y + ypos * Y_stride,
+			*y_ptr2 = (const uint8_t *)Y + (ypos + 1) * Y_stride,
+			*uv_ptr = (const uint8_t *)(uv_swapped ? V : U) + (ypos / 2) * UV_stride;
+
+		uint8_t *rgb_ptr1 = RGB + ypos * RGB_stride,
+			*rgb_ptr2 = RGB + (ypos + 1) * RGB_stride;
+
+		for (xpos = 0; xpos < converted; xpos += 16) {
+			const __m256i uv = _mm256_loadu_si256((const __m256i *)uv_ptr);
+			const __m256i first = _mm256_srli_epi32(_mm256_and_si256(uv, _mm256_set1_epi32(0xFFFF)), 6);
+			const __m256i second = _mm256_srli_epi32(uv, 16 + 6);
+			const __m256i u = _mm256_sub_epi32(uv_swapped ? second : first, uv_offset);
+			const __m256i v = _mm256_sub_epi32(uv_swapped ? first : second, uv_offset);
+			const __m256i r_tmp = _mm256_mullo_epi32(v, v_r_factor);
+			const __m256i g_tmp = _mm256_add_epi32(_mm256_mullo_epi32(u, u_g_factor), _mm256_mullo_epi32(v, v_g_factor));
+			const __m256i b_tmp = _mm256_mullo_epi32(u, u_b_factor);
+
+			/* each uv sample covers two pixels */
+			const __m256i r_uv_1 = _mm256_permutevar8x32_epi32(r_tmp, index_1);
+			const __m256i g_uv_1 = _mm256_permutevar8x32_epi32(g_tmp, index_1);
+			const __m256i b_uv_1 = _mm256_permutevar8x32_epi32(b_tmp, index_1);
+			const __m256i r_uv_2 = _mm256_permutevar8x32_epi32(r_tmp, index_2);
+			const __m256i g_uv_2 = _mm256_permutevar8x32_epi32(g_tmp, index_2);
+			const __m256i b_uv_2 = _mm256_permutevar8x32_epi32(b_tmp, index_2);
+
+			yuvp010_line16_avx2(y_ptr1, rgb_ptr1, r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2, y_shift, y_factor, rgb_format, rgb_pixel_stride);
+			yuvp010_line16_avx2(y_ptr2, rgb_ptr2, r_uv_1, g_uv_1, b_uv_1, r_uv_2, g_uv_2, b_uv_2, y_shift, y_factor, rgb_format, rgb_pixel_stride);
+
+			y_ptr1 += 16 * sizeof(uint16_t);
+			y_ptr2 += 16 * sizeof(uint16_t);
+			uv_ptr += 16 * sizeof(uint16_t);
+			rgb_ptr1 += 16 * rgb_pixel_stride;
+			rgb_ptr2 += 16 * rgb_pixel_stride;
+		}
+	}
+
+	/* Catch the right column, if needed */
+	if (converted != width && height >= 2) {
+		std_function(width - converted, height & ~1,
+			Y + converted, U + converted, V + converted,
+			Y_stride, UV_stride, RGB + converted * rgb_pixel_stride, RGB_stride, yuv_type);
+	}
+
+	/* Catch the last line, if needed */
+	if (height & 1) {
+		ypos = height - 1;
+		std_function(width, 1,
+			(const uint16_t *)((const uint8_t *)Y + ypos * Y_stride),
+			(const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride),
+			(const uint16_t *)((const uint8_t *)V + (ypos / 2) * UV_stride),
+			Y_stride, UV_stride, RGB + ypos * RGB_stride, RGB_stride, yuv_type);
+	}
+}
+
+#define YUVP010_AVX2_FUNCTION(AVX2_FUNCTION_NAME, STD_FUNCTION_NAME, RGB_FORMAT) \
+void SDL_TARGETING("avx2") AVX2_FUNCTION_NAME(uint32_t width, uint32_t height, \
+	const uint16_t *Y, const uint16_t *U, const uint16_t *V, uint32_t Y_stride, uint32_t UV_stride, \
+	uint8_t *RGB, uint32_t RGB_stride, \
+	YCbCrType yuv_type) \
+{ \
+	yuvp010_avx2(width, height, Y, U, V, Y_stride, UV_stride, RGB, RGB_stride, yuv_type, RGB_FORMAT, STD_FUNCTION_NAME); \
+}
+
+YUVP010_AVX2_FUNCTION(yuvp010_xbgr2101010_avx2, yuvp010_xbgr2101010_std, RGB_FORMAT_XBGR2101010)
+YUVP010_AVX2_FUNCTION(yuvp010_rgba64_avx2, yuvp010_rgba64_std, RGB_FORMAT_RGBA64)
+YUVP010_AVX2_FUNCTION(yuvp010_rgba128f_avx2, yuvp010_rgba128f_std, RGB_FORMAT_RGBA128_FLOAT)
+
+#endif  // SDL_AVX2_INTRINSICS
+
+#endif // SDL_HAVE_YUV
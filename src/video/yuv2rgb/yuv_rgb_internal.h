@@ -79,3 +79,5 @@ static const RGB2YUVParam RGB2YUV[4] = {
 #define RGB_FORMAT_ARGB		5
 #define RGB_FORMAT_ABGR		6
 #define RGB_FORMAT_XBGR2101010 7
+#define RGB_FORMAT_RGBA64	8
+#define RGB_FORMAT_RGBA128_FLOAT 9
@@ -0,0 +1,308 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+#include "SDL_internal.h"
+
+#if SDL_HAVE_YUV
+#include "yuv_rgb_internal.h"
+
+#ifdef SDL_NEON_INTRINSICS
+
+/* The 8-bit kernels use the same 16-bit arithmetic as the sse implementation,
+ * 16 pixels of two lines at a time. The 10-bit kernels use the same 32-bit
+ * arithmetic as the standard c implementation, 8 pixels of two lines at a time.
+ * Columns and lines that don't fill a whole block are converted by the
+ * standard c implementation.
+ */
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define HAVE_NEON_DIVIDE
+#endif
+
+typedef void (*yuv_std_func)(
+        uint32_t width, uint32_t height,
+        const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+typedef void (*yuv16_std_func)(
+        uint32_t width, uint32_t height,
+        const uint16_t *y, const uint16_t *u, const uint16_t *v, uint32_t y_stride, uint32_t uv_stride,
+        uint8_t *rgb, uint32_t rgb_stride,
+        YCbCrType yuv_type);
+
+SDL_FORCE_INLINE void yuv_rgba_line16_neon(
+	const uint8_t *y_ptr, uint8_t *rgb_ptr,
+	int16x8_t r_uv_1, int16x8_t g_uv_1, int16x8_t b_uv_1, int16x8_t r_uv_2, int16x8_t g_uv_2, int16x8_t b_uv_2,
+	int16x8_t y_shift, int16x8_t y_factor, int rgb_format)
+{
+	const uint8x16_t y = vld1q_u8(y_ptr);
+	const int16x8_t y_1 = vmulq_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))), y_shift), y_factor);
+	const int16x8_t y_2 = vmulq_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))), y_shift), y_factor);
+	const uint8x16_t r = vcombine_u8(vqmovun_s16(vshrq_n_s16(vaddq_s16(r_uv_1, y_1), PRECISION)),
+	                                 vqmovun_s16(vshrq_n_s16(vaddq_s16(r_uv_2, y_2), PRECISION)));
+	const uint8x16_t g = vcombine_u8(vqmovun_s16(vshrq_n_s16(vaddq_s16(g_uv_1, y_1), PRECISION)),
+	                                 vqmovun_s16(vshrq_n_s16(vaddq_s16(g_uv_2, y_2), PRECISION)));
+	const uint8x16_t b = vcombine_u8(vqmovun_s16(vshrq_n_s16(vaddq_s16(b_uv_1, y_1), PRECISION)),
+	                                 vqmovun_s16(vshrq_n_s16(vaddq_s16(b_uv_2, y_2), PRECISION)));
+	const uint8x16_t a = vdupq_n_u8(0xFF);
+	uint8x16x4_t rgba;
+
+	/* byte order of the pixels in memory */
+	switch (rgb_format) {
+	case RGB_FORMAT_RGBA:
+		rgba.val[0] = a; rgba.val[1] = b; rgba.val[2] = g; rgba.val[3] = r;
+		break;
+	case RGB_FORMAT_BGRA:
+		rgba.val[0] = a; rgba.val[1] = r; rgba.val[2] = g; rgba.val[3] = b;
+		break;
+	case RGB_FORMAT_ARGB:
+		rgba.val[0] = b; rgba.val[1] = g; rgba.val[2] = r; rgba.val[3] = a;
+		break;
+	default: /* RGB_FORMAT_ABGR */
+		rgba.val[0] = r; rgba.val[1] = g; rgba.val[2] = b; rgba.val[3] = a;
+		break;
+	}
+	vst4q_u8(rgb_ptr, rgba);
+}
+
+SDL_FORCE_INLINE void yuv_rgba_neon(
+	uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type, int yuv_format, int rgb_format, yuv_std_func std_function)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const int uv_pixel_stride = (yuv_format == YUV_FORMAT_NV12) ? 2 : 1;
+	const SDL_bool uv_swapped = (V < U);
+	const uint32_t converted = (width & ~15);
+	const int16x8_t y_shift = vdupq_n_s16(param->y_shift);
+	const int16x8_t y_factor = vdupq_n_s16(param->y_factor);
+	const int16x8_t uv_offset = vdupq_n_s16(128);
+	uint32_t xpos, ypos;
+
+	for (ypos = 0; ypos + 1 < height; ypos += 2) {
+		const uint8_t *y_ptr1 = Y + ypos * Y_stride,
+			*y_ptr2 = Y + (ypos + 1) * Y_stride,
+			*u_ptr = U + (ypos / 2) * UV_stride,
+			*v_ptr = V + (ypos / 2) * UV_stride;
+
+		uint8_t *rgb_ptr1 = RGB + ypos * RGB_stride,
+			*rgb_ptr2 = RGB + (ypos + 1) * RGB_stride;
+
+		for (xpos = 0; xpos < converted; xpos += 16) {
+			int16x8_t u, v, r_tmp, g_tmp, b_tmp;
+			int16x8x2_t r_uv, g_uv, b_uv;
+
+			if (yuv_format == YUV_FORMAT_NV12) {
+				/* Load the 8 interleaved pairs from the first byte of the block,
+				 * which doesn't read past the end of the line for NV21 */
+				const uint8x8x2_t uv = vld2_u8(uv_swapped ? v_ptr : u_ptr);
+				u = vreinterpretq_s16_u16(vmovl_u8(uv.val[uv_swapped ? 1 : 0]));
+				v = vreinterpretq_s16_u16(vmovl_u8(uv.val[uv_swapped ? 0 : 1]));
+			} else {
+				u = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u_ptr)));
+				v = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v_ptr)));
+			}
+			u = vsubq_s16(u, uv_offset);
+			v = vsubq_s16(v, uv_offset);
+
+			r_tmp = vmulq_n_s16(v, param->v_r_factor);
+			g_tmp = vaddq_s16(vmulq_n_s16(u, param->u_g_factor), vmulq_n_s16(v, param->v_g_factor));
+			b_tmp = vmulq_n_s16(u, param->u_b_factor);
+
+			/* each uv sample covers two pixels */
+			r_uv = vzipq_s16(r_tmp, r_tmp);
+			g_uv = vzipq_s16(g_tmp, g_tmp);
+			b_uv = vzipq_s16(b_tmp, b_tmp);
+
+			yuv_rgba_line16_neon(y_ptr1, rgb_ptr1, r_uv.val[0], g_uv.val[0], b_uv.val[0], r_uv.val[1], g_uv.val[1], b_uv.val[1], y_shift, y_factor, rgb_format);
+			yuv_rgba_line16_neon(y_ptr2, rgb_ptr2, r_uv.val[0], g_uv.val[0], b_uv.val[0], r_uv.val[1], g_uv.val[1], b_uv.val[1], y_shift, y_factor, rgb_format);
+
+			y_ptr1 += 16;
+			y_ptr2 += 16;
+			u_ptr += 8 * uv_pixel_stride;
+			v_ptr += 8 * uv_pixel_stride;
+			rgb_ptr1 += 16 * 4;
+			rgb_ptr2 += 16 * 4;
+		}
+	}
+
+	/* Catch the right column, if needed */
+	if (converted != width && height >= 2) {
+		std_function(width - converted, height & ~1,
+			Y + converted, U + (converted / 2) * uv_pixel_stride, V + (converted / 2) * uv_pixel_stride,
+			Y_stride, UV_stride, RGB + converted * 4, RGB_stride, yuv_type);
+	}
+
+	/* Catch the last line, if needed */
+	if (height & 1) {
+		ypos = height - 1;
+		std_function(width, 1,
+			Y + ypos * Y_stride, U + (ypos / 2) * UV_stride, V + (ypos / 2) * UV_stride,
+			Y_stride, UV_stride, RGB + ypos * RGB_stride, RGB_stride, yuv_type);
+	}
+}
+
+#define YUV_NEON_FUNCTION(NEON_FUNCTION_NAME, STD_FUNCTION_NAME, YUV_FORMAT, RGB_FORMAT) \
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height, \
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride, \
+	uint8_t *RGB, uint32_t RGB_stride, \
+	YCbCrType yuv_type) \
+{ \
+	yuv_rgba_neon(width, height, Y, U, V, Y_stride, UV_stride, RGB, RGB_stride, yuv_type, YUV_FORMAT, RGB_FORMAT, STD_FUNCTION_NAME); \
+}
+
+YUV_NEON_FUNCTION(yuv420_rgba_neon, yuv420_rgba_std, YUV_FORMAT_420, RGB_FORMAT_RGBA)
+YUV_NEON_FUNCTION(yuv420_bgra_neon, yuv420_bgra_std, YUV_FORMAT_420, RGB_FORMAT_BGRA)
+YUV_NEON_FUNCTION(yuv420_argb_neon, yuv420_argb_std, YUV_FORMAT_420, RGB_FORMAT_ARGB)
+YUV_NEON_FUNCTION(yuv420_abgr_neon, yuv420_abgr_std, YUV_FORMAT_420, RGB_FORMAT_ABGR)
+YUV_NEON_FUNCTION(yuvnv12_rgba_neon, yuvnv12_rgba_std, YUV_FORMAT_NV12, RGB_FORMAT_RGBA)
+YUV_NEON_FUNCTION(yuvnv12_bgra_neon, yuvnv12_bgra_std, YUV_FORMAT_NV12, RGB_FORMAT_BGRA)
+YUV_NEON_FUNCTION(yuvnv12_argb_neon, yuvnv12_argb_std, YUV_FORMAT_NV12, RGB_FORMAT_ARGB)
+YUV_NEON_FUNCTION(yuvnv12_abgr_neon, yuvnv12_abgr_std, YUV_FORMAT_NV12, RGB_FORMAT_ABGR)
+
+SDL_FORCE_INLINE void yuvp010_save4_neon(uint8_t *rgb_ptr, int32x4_t r, int32x4_t g, int32x4_t b, int rgb_format)
+{
+	if (rgb_format == RGB_FORMAT_XBGR2101010) {
+		uint32x4_t rgb = vorrq_u32(vdupq_n_u32(0xC0000000), vreinterpretq_u32_s32(r));
+		rgb = vorrq_u32(rgb, vshlq_n_u32(vreinterpretq_u32_s32(g), 10));
+		rgb = vorrq_u32(rgb, vshlq_n_u32(vreinterpretq_u32_s32(b), 20));
+		vst1q_u32((uint32_t *)rgb_ptr, rgb);
+	} else if (rgb_format == RGB_FORMAT_RGBA64) {
+		uint16x4x4_t rgba;
+
+		/* expand to 16 bits, like expand10() */
+		rgba.val[0] = vmovn_u32(vreinterpretq_u32_s32(r));
+		rgba.val[1] = vmovn_u32(vreinterpretq_u32_s32(g));
+		rgba.val[2] = vmovn_u32(vreinterpretq_u32_s32(b));
+		rgba.val[0] = vorr_u16(vshl_n_u16(rgba.val[0], 6), vshr_n_u16(rgba.val[0], 4));
+		rgba.val[1] = vorr_u16(vshl_n_u16(rgba.val[1], 6), vshr_n_u16(rgba.val[1], 4));
+		rgba.val[2] = vorr_u16(vshl_n_u16(rgba.val[2], 6), vshr_n_u16(rgba.val[2], 4));
+		rgba.val[3] = vdup_n_u16(0xFFFF);
+		vst4_u16((uint16_t *)rgb_ptr, rgba);
+	} else { /* RGB_FORMAT_RGBA128_FLOAT */
+#ifdef HAVE_NEON_DIVIDE
+		const float32x4_t scale = vdupq_n_f32(1023.0f);
+		float32x4x4_t rgba;
+
+		rgba.val[0] = vdivq_f32(vcvtq_f32_s32(r), scale);
+		rgba.val[1] = vdivq_f32(vcvtq_f32_s32(g), scale);
+		rgba.val[2] = vdivq_f32(vcvtq_f32_s32(b), scale);
+		rgba.val[3] = vdupq_n_f32(1.0f);
+		vst4q_f32((float *)rgb_ptr, rgba);
+#endif
+	}
+}
+
+SDL_FORCE_INLINE void yuvp010_line8_neon(
+	const uint8_t *y_ptr, uint8_t *rgb_ptr,
+	int32x4_t r_uv_1, int32x4_t g_uv_1, int32x4_t b_uv_1, int32x4_t r_uv_2, int32x4_t g_uv_2, int32x4_t b_uv_2,
+	int32x4_t y_shift, int32x4_t y_factor, int rgb_format, int rgb_pixel_stride)
+{
+	const int32x4_t zero = vdupq_n_s32(0);
+	const int32x4_t max = vdupq_n_s32(1023);
+	const uint16x8_t y = vld1q_u16((const uint16_t *)y_ptr);
+	const int32x4_t y_1 = vmulq_s32(vshrq_n_s32(vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(y))), y_shift), 6), y_factor);
+	const int32x4_t y_2 = vmulq_s32(vshrq_n_s32(vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(y))), y_shift), 6), y_factor);
+	int32x4_t r, g, b;
+
+	/* same as clamp10() */
+	r = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(y_1, r_uv_1), PRECISION), zero), max);
+	g = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(y_1, g_uv_1), PRECISION), zero), max);
+	b = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(y_1, b_uv_1), PRECISION), zero), max);
+	yuvp010_save4_neon(rgb_ptr, r, g, b, rgb_format);
+
+	r = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(y_2, r_uv_2), PRECISION), zero), max);
+	g = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(y_2, g_uv_2), PRECISION), zero), max);
+	b = vminq_s32(vmaxq_s32(vshrq_n_s32(vaddq_s32(y_2, b_uv_2), PRECISION), zero), max);
+	yuvp010_save4_neon(rgb_ptr + 4 * rgb_pixel_stride, r, g, b, rgb_format);
+}
+
+SDL_FORCE_INLINE void yuvp010_neon(
+	uint32_t width, uint32_t height,
+	const uint16_t *Y, const uint16_t *U, const uint16_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type, int rgb_format, yuv16_std_func std_function)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+	const int rgb_pixel_stride = (rgb_format == RGB_FORMAT_RGBA128_FLOAT) ? 16 : (rgb_format == RGB_FORMAT_RGBA64) ? 8 : 4;
+	const SDL_bool uv_swapped = (V < U);
+	const int32x4_t y_shift = vdupq_n_s32(param->y_shift);
+	const int32x4_t y_factor = vdupq_n_s32(param->y_factor);
+	const int32x4_t uv_offset = vdupq_n_s32(512);
+	uint32_t converted = (width & ~7);
+	uint32_t xpos, ypos;
+
+#ifndef HAVE_NEON_DIVIDE
+	if (rgb_format == RGB_FORMAT_RGBA128_FLOAT) {
+		/* No exact float division, use the standard c implementation */
+		converted = 0;
+	}
+#endif
+
+	for (ypos = 0; ypos + 1 < height && converted > 0; ypos += 2) {
+		const uint8_t *y_ptr1 = (const uint8_t *)Y + ypos * Y_stride,
+			*y_ptr2 = (const uint8_t *)Y + (ypos + 1) * Y_stride,
+			*uv_ptr = (const uint8_t *)(uv_swapped ? V : U) + (ypos / 2) * UV_stride;
+
+		uint8_t *rgb_ptr1 = RGB + ypos * RGB_stride,
+			*rgb_ptr2 = RGB + (ypos + 1) * RGB_stride;
+
+		for (xpos = 0; xpos < converted; xpos += 8) {
+			const uint16x4x2_t uv = vld2_u16((const uint16_t *)uv_ptr);
+			const int32x4_t u = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vmovl_u16(uv.val[uv_swapped ? 1 : 0]), 6)), uv_offset);
+			const int32x4_t v = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vmovl_u16(uv.val[uv_swapped ? 0 : 1]), 6)), uv_offset);
+			const int32x4_t r_tmp = vmulq_n_s32(v, param->v_r_factor);
+			const int32x4_t g_tmp = vaddq_s32(vmulq_n_s32(u, param->u_g_factor), vmulq_n_s32(v, param->v_g_factor));
+			const int32x4_t b_tmp = vmulq_n_s32(u, param->u_b_factor);
+
+			/* each uv sample covers two pixels */
+			const int32x4x2_t r_uv = vzipq_s32(r_tmp, r_tmp);
+			const int32x4x2_t g_uv = vzipq_s32(g_tmp, g_tmp);
+			const int32x4x2_t b_uv = vzipq_s32(b_tmp, b_tmp);
+
+			yuvp010_line8_neon(y_ptr1, rgb_ptr1, r_uv.val[0], g_uv.val[0], b_uv.val[0], r_uv.val[1], g_uv.val[1], b_uv.val[1], y_shift, y_factor, rgb_format, rgb_pixel_stride);
+			yuvp010_line8_neon(y_ptr2, rgb_ptr2, r_uv.val[0], g_uv.val[0], b_uv.val[0], r_uv.val[1], g_uv.val[1], b_uv.val[1], y_shift, y_factor, rgb_format, rgb_pixel_stride);
+
+			y_ptr1 += 8 * sizeof(uint16_t);
+			y_ptr2 += 8 * sizeof(uint16_t);
+			uv_ptr += 8 * sizeof(uint16_t);
+			rgb_ptr1 += 8 * rgb_pixel_stride;
+			rgb_ptr2 += 8 * rgb_pixel_stride;
+		}
+	}
+
+	/* Catch the right column, if needed */
+	if (converted != width && height >= 2) {
+		std_function(width - converted, height & ~1,
+			Y + converted, U + converted, V + converted,
+			Y_stride, UV_stride, RGB + converted * rgb_pixel_stride, RGB_stride, yuv_type);
+	}
+
+	/* Catch the last line, if needed */
+	if (height & 1) {
+		ypos = height - 1;
+		std_function(width, 1,
+			(const uint16_t *)((const uint8_t *)Y + ypos * Y_stride),
+			(const uint16_t *)((const uint8_t *)U + (ypos / 2) * UV_stride),
+			(const uint16_t *)((const uint8_t *)V + (ypos / 2) * UV_stride),
+			Y_stride, UV_stride, RGB + ypos * RGB_stride, RGB_stride, yuv_type);
+	}
+}
+
+#define YUVP010_NEON_FUNCTION(NEON_FUNCTION_NAME, STD_FUNCTION_NAME, RGB_FORMAT) \
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height, \
+	const uint16_t *Y, const uint16_t *U, const uint16_t *V, uint32_t Y_stride, uint32_t UV_stride, \
+	uint8_t *RGB, uint32_t RGB_stride, \
+	YCbCrType yuv_type) \
+{ \
+	yuvp010_neon(width, height, Y, U, V, Y_stride, UV_stride, RGB, RGB_stride, yuv_type, RGB_FORMAT, STD_FUNCTION_NAME); \
+}
+
+YUVP010_NEON_FUNCTION(yuvp010_xbgr2101010_neon, yuvp010_xbgr2101010_std, RGB_FORMAT_XBGR2101010)
+YUVP010_NEON_FUNCTION(yuvp010_rgba64_neon, yuvp010_rgba64_std, RGB_FORMAT_RGBA64)
+YUVP010_NEON_FUNCTION(yuvp010_rgba128f_neon, yuvp010_rgba128f_std, RGB_FORMAT_RGBA128_FLOAT)
+
+#endif  // SDL_NEON_INTRINSICS
+
+#endif // SDL_HAVE_YUV
@@ -40,6 +40,12 @@ static uint16_t clamp10(int32_t v)
     }
 }
 
+// expand a 10-bit value to the full 16-bit range
+static uint16_t expand10(uint16_t v)
+{
+    return (uint16_t)((v << 6) | (v >> 4));
+}
+
 #define YUV_BITS    8
 
 #define STD_FUNCTION_NAME	yuv420_rgb565_std
@@ -140,6 +146,16 @@ static uint16_t clamp10(int32_t v)
 #define RGB_FORMAT			RGB_FORMAT_XBGR2101010
 #include "yuv_rgb_std_func.h"
 
+#define STD_FUNCTION_NAME	yuvp010_rgba64_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA64
+#include "yuv_rgb_std_func.h"
+
+#define STD_FUNCTION_NAME	yuvp010_rgba128f_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA128_FLOAT
+#include "yuv_rgb_std_func.h"
+
 void rgb24_yuv420_std(
         uint32_t width, uint32_t height,
         const uint8_t *RGB, uint32_t RGB_stride,
@@ -74,6 +74,24 @@
 		(((Uint32)clamp10(y_tmp+r_tmp)) << 0); \
 	rgb_ptr += 4; \
 
+#elif RGB_FORMAT == RGB_FORMAT_RGBA64
+
+#define PACK_PIXEL(rgb_ptr) \
+	((Uint16 *)rgb_ptr)[0] = expand10(clamp10(y_tmp+r_tmp)); \
+	((Uint16 *)rgb_ptr)[1] = expand10(clamp10(y_tmp+g_tmp)); \
+	((Uint16 *)rgb_ptr)[2] = expand10(clamp10(y_tmp+b_tmp)); \
+	((Uint16 *)rgb_ptr)[3] = 0xFFFF; \
+	rgb_ptr += 8; \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA128_FLOAT
+
+#define PACK_PIXEL(rgb_ptr) \
+	((float *)rgb_ptr)[0] = clamp10(y_tmp+r_tmp) / 1023.0f; \
+	((float *)rgb_ptr)[1] = clamp10(y_tmp+g_tmp) / 1023.0f; \
+	((float *)rgb_ptr)[2] = clamp10(y_tmp+b_tmp) / 1023.0f; \
+	((float *)rgb_ptr)[3] = 1.0f; \
+	rgb_ptr += 16; \
+
 #else
 #error PACK_PIXEL unimplemented
 #endif
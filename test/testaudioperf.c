@@ -0,0 +1,403 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the throughput of audio format conversion, resampling, audio streams and
+   device mixing with many bound streams. Everything is reported in sample frames per
+   second on one core, which is what matters when sizing voice counts. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Input for every test: this many frames of a sine wave, in the largest format used */
+#define INPUT_FRAMES 48000
+#define MAX_CHANNELS 8
+
+static float *sine_input = NULL;
+static int duration_ms = 200;
+
+typedef struct
+{
+    SDL_AudioSpec src;
+    SDL_AudioSpec dst;
+} ConversionSpec;
+
+static const ConversionSpec conversions[] = {
+    { { SDL_AUDIO_S16, 2, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+    { { SDL_AUDIO_F32, 2, 48000 }, { SDL_AUDIO_S16, 2, 48000 } },
+    { { SDL_AUDIO_U8, 1, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+    { { SDL_AUDIO_S32, 2, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+    { { SDL_AUDIO_S16, 2, 48000 }, { SDL_AUDIO_S16BE, 2, 48000 } },
+    { { SDL_AUDIO_F32, 6, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+    { { SDL_AUDIO_F32, 8, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+    { { SDL_AUDIO_S16, 2, 44100 }, { SDL_AUDIO_F32, 2, 48000 } },
+    { { SDL_AUDIO_S16, 1, 22050 }, { SDL_AUDIO_S16, 2, 48000 } },
+};
+
+static const struct
+{
+    int src_rate;
+    int dst_rate;
+} resample_ratios[] = {
+    { 44100, 48000 },
+    { 48000, 44100 },
+    { 22050, 48000 },
+    { 48000, 16000 },
+    { 48000, 96000 },
+    { 96000, 48000 },
+    { 8000, 48000 },
+};
+
+static const int mix_stream_counts[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+
+static const char *quality_name(SDL_AudioResampleQuality quality)
+{
+    switch (quality) {
+    case SDL_AUDIO_RESAMPLE_QUALITY_LOW:
+        return "low";
+    case SDL_AUDIO_RESAMPLE_QUALITY_HIGH:
+        return "high";
+    default:
+        return "medium";
+    }
+}
+
+static const char *spec_name(const SDL_AudioSpec *spec, char *buf, size_t buflen)
+{
+    const char *format = SDL_GetAudioFormatName(spec->format);
+    if (SDL_strncmp(format, "SDL_AUDIO_", 10) == 0) {
+        format += 10;
+    }
+    SDL_snprintf(buf, buflen, "%s %dch %dHz", format, spec->channels, spec->freq);
+    return buf;
+}
+
+/* Fills `frames` frames of `spec` with the sine wave, by converting it from F32 */
+static Uint8 *make_input(const SDL_AudioSpec *spec, int frames, int *len)
+{
+    const SDL_AudioSpec f32 = { SDL_AUDIO_F32, spec->channels, spec->freq };
+    Uint8 *data = NULL;
+
+    if (SDL_ConvertAudioSamples(&f32, (const Uint8 *)sine_input, frames * spec->channels * (int)sizeof(float), spec, &data, len) < 0) {
+        return NULL;
+    }
+    return data;
+}
+
+static SDL_bool time_elapsed(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) >= (SDL_GetPerformanceFrequency() * duration_ms) / 1000;
+}
+
+static double frames_per_second(Uint64 frames, Uint64 start)
+{
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    return (double)frames / seconds;
+}
+
+static void bench_convert_samples(void)
+{
+    int i;
+
+    SDL_Log("SDL_ConvertAudioSamples:");
+    for (i = 0; i < SDL_arraysize(conversions); i++) {
+        const ConversionSpec *conv = &conversions[i];
+        const int frames = (INPUT_FRAMES / 48000) * conv->src.freq;
+        char src_name[64], dst_name[64];
+        Uint64 start, total = 0;
+        Uint8 *input;
+        int input_len;
+
+        input = make_input(&conv->src, frames, &input_len);
+        if (!input) {
+            SDL_Log("  Couldn't create input: %s", SDL_GetError());
+            continue;
+        }
+
+        start = SDL_GetPerformanceCounter();
+        do {
+            Uint8 *output = NULL;
+            int output_len = 0;
+            if (SDL_ConvertAudioSamples(&conv->src, input, input_len, &conv->dst, &output, &output_len) < 0) {
+                SDL_Log("  Conversion failed: %s", SDL_GetError());
+                break;
+            }
+            SDL_free(output);
+            total += frames;
+        } while (!time_elapsed(start));
+
+        SDL_Log("  %-22s -> %-22s %10.2f Mframes/s", spec_name(&conv->src, src_name, sizeof(src_name)),
+                spec_name(&conv->dst, dst_name, sizeof(dst_name)), frames_per_second(total, start) / 1000000.0);
+        SDL_free(input);
+    }
+}
+
+/* Puts the input through a stream in device-sized pieces, the way an app feeding a device would */
+static double stream_throughput(const SDL_AudioSpec *src, const SDL_AudioSpec *dst, SDL_AudioResampleQuality quality, int chunk_frames)
+{
+    const int frames = (INPUT_FRAMES / 48000) * src->freq;
+    const int src_frame_size = SDL_AUDIO_FRAMESIZE(*src);
+    const int out_len = chunk_frames * SDL_AUDIO_FRAMESIZE(*dst);
+    SDL_AudioStream *stream = NULL;
+    Uint8 *input = NULL;
+    Uint8 *output = NULL;
+    Uint64 start, total = 0;
+    double result = 0.0;
+    int input_len;
+
+    input = make_input(src, frames, &input_len);
+    output = (Uint8 *)SDL_malloc(out_len);
+    stream = SDL_CreateAudioStream(src, dst);
+    if (!input || !output || !stream) {
+        SDL_Log("  Couldn't set up stream: %s", SDL_GetError());
+        goto done;
+    }
+    SDL_SetNumberProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, quality);
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        int offset;
+        for (offset = 0; offset < input_len; offset += chunk_frames * src_frame_size) {
+            const int len = SDL_min(chunk_frames * src_frame_size, input_len - offset);
+            SDL_PutAudioStreamData(stream, input + offset, len);
+            while (SDL_GetAudioStreamData(stream, output, out_len) == out_len) {
+            }
+        }
+        total += frames;
+    } while (!time_elapsed(start));
+    result = frames_per_second(total, start);
+
+done:
+    SDL_DestroyAudioStream(stream);
+    SDL_free(output);
+    SDL_free(input);
+    return result;
+}
+
+static void bench_streams(void)
+{
+    int i;
+
+    SDL_Log("SDL_AudioStream put/get, 512 frame chunks:");
+    for (i = 0; i < SDL_arraysize(conversions); i++) {
+        const ConversionSpec *conv = &conversions[i];
+        char src_name[64], dst_name[64];
+        const double fps = stream_throughput(&conv->src, &conv->dst, SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM, 512);
+
+        SDL_Log("  %-22s -> %-22s %10.2f Mframes/s", spec_name(&conv->src, src_name, sizeof(src_name)),
+                spec_name(&conv->dst, dst_name, sizeof(dst_name)), fps / 1000000.0);
+    }
+}
+
+static void bench_resampler(void)
+{
+    int i, quality;
+
+    /* The resampler itself is internal, so this goes through F32 streams that only change the rate */
+    SDL_Log("Resampling, F32 stereo, by input frames:");
+    for (i = 0; i < SDL_arraysize(resample_ratios); i++) {
+        const SDL_AudioSpec src = { SDL_AUDIO_F32, 2, resample_ratios[i].src_rate };
+        const SDL_AudioSpec dst = { SDL_AUDIO_F32, 2, resample_ratios[i].dst_rate };
+
+        for (quality = SDL_AUDIO_RESAMPLE_QUALITY_LOW; quality <= SDL_AUDIO_RESAMPLE_QUALITY_HIGH; quality++) {
+            const double fps = stream_throughput(&src, &dst, (SDL_AudioResampleQuality)quality, 1024);
+            SDL_Log("  %6d Hz -> %6d Hz  %-7s %10.2f Mframes/s", src.freq, dst.freq,
+                    quality_name((SDL_AudioResampleQuality)quality), fps / 1000000.0);
+        }
+    }
+}
+
+typedef struct
+{
+    const Uint8 *data;
+    int len;
+    int offset;
+} StreamFeed;
+
+static void SDLCALL feed_stream(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    StreamFeed *feed = (StreamFeed *)userdata;
+
+    while (additional_amount > 0) {
+        const int len = SDL_min(additional_amount, feed->len - feed->offset);
+        SDL_PutAudioStreamData(stream, feed->data + feed->offset, len);
+        feed->offset = (feed->offset + len) % feed->len;
+        additional_amount -= len;
+    }
+}
+
+static int SDLCALL compare_sint64(const void *a, const void *b)
+{
+    const Sint64 left = *(const Sint64 *)a;
+    const Sint64 right = *(const Sint64 *)b;
+    return (left < right) ? -1 : (left > right) ? 1 : 0;
+}
+
+static void bench_device_mix(void)
+{
+    const SDL_AudioSpec device_spec = { SDL_AUDIO_F32, 2, 48000 };
+    const SDL_AudioSpec stream_spec = { SDL_AUDIO_S16, 2, 44100 };
+    SDL_AudioStream *streams[512];
+    StreamFeed feeds[512];
+    SDL_AudioSpec spec;
+    SDL_AudioDeviceID device;
+    Uint8 *input = NULL;
+    int input_len = 0;
+    int sample_frames = 0;
+    int i, j;
+
+    device = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &device_spec);
+    if (!device) {
+        SDL_Log("Couldn't open audio device: %s", SDL_GetError());
+        return;
+    }
+    SDL_GetAudioDeviceFormat(device, &spec, &sample_frames);
+    input = make_input(&stream_spec, stream_spec.freq, &input_len);
+    if (!input) {
+        SDL_Log("Couldn't create input: %s", SDL_GetError());
+        SDL_CloseAudioDevice(device);
+        return;
+    }
+
+    SDL_Log("Device mixing on '%s', %d frame buffers, S16 44100Hz streams into %s %dHz:",
+            SDL_GetCurrentAudioDriver(), sample_frames, SDL_GetAudioFormatName(spec.format), spec.freq);
+
+    for (i = 0; i < SDL_arraysize(mix_stream_counts); i++) {
+        const int count = mix_stream_counts[i];
+        const Uint64 period_ns = ((Uint64)sample_frames * SDL_NS_PER_SECOND) / spec.freq;
+        const int samples = SDL_max(20, (int)(((Uint64)duration_ms * SDL_NS_PER_MS) / period_ns));
+        Sint64 *mix_times = (Sint64 *)SDL_malloc(samples * sizeof(Sint64));
+        int created = 0;
+
+        if (!mix_times) {
+            break;
+        }
+
+        for (j = 0; j < count; j++) {
+            streams[j] = SDL_CreateAudioStream(&stream_spec, &spec);
+            if (!streams[j]) {
+                break;
+            }
+            feeds[j].data = input;
+            feeds[j].len = input_len;
+            feeds[j].offset = (j * 4 * 97) % input_len;  /* don't let every stream mix identical data */
+            SDL_SetAudioStreamGetCallback(streams[j], feed_stream, &feeds[j]);
+            created++;
+        }
+        if (created < count || SDL_BindAudioStreams(device, streams, count) < 0) {
+            SDL_Log("  Couldn't set up %d streams: %s", count, SDL_GetError());
+        } else {
+            SDL_PropertiesID props = SDL_GetAudioDeviceProperties(device);
+            Sint64 max_mix;
+
+            /* Let it settle, then sample the last mix time once per device buffer */
+            SDL_DelayNS(period_ns * 4);
+            for (j = 0; j < samples; j++) {
+                SDL_DelayNS(period_ns);
+                props = SDL_GetAudioDeviceProperties(device);
+                mix_times[j] = SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_MIX_TIME_NS_NUMBER, 0);
+            }
+            max_mix = SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_MAX_MIX_TIME_NS_NUMBER, 0);
+            SDL_qsort(mix_times, samples, sizeof(Sint64), compare_sint64);
+
+            {
+                const Sint64 median = SDL_max(mix_times[samples / 2], 1);
+                const double stream_fps = ((double)sample_frames * count * SDL_NS_PER_SECOND) / (double)median;
+                SDL_Log("  %3d streams: median mix %8.1f us (%5.1f%% of a buffer), max so far %8.1f us, %10.2f Mframes/s of streams",
+                        count, median / 1000.0, (100.0 * median) / period_ns, max_mix / 1000.0, stream_fps / 1000000.0);
+            }
+        }
+
+        SDL_UnbindAudioStreams(streams, created);
+        for (j = 0; j < created; j++) {
+            SDL_DestroyAudioStream(streams[j]);
+        }
+        SDL_free(mix_times);
+    }
+
+    SDL_CloseAudioDevice(device);
+    SDL_free(input);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *only = NULL;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration_ms = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--only") == 0 && argv[i + 1]) {
+                only = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || duration_ms < 1) {
+            static const char *options[] = { "[--duration ms]", "[--only convert|stream|resample|mix]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    /* Mixing cost is what's being measured, so don't depend on real hardware unless asked to */
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, SDL_getenv("SDL_AUDIO_DRIVER") ? SDL_getenv("SDL_AUDIO_DRIVER") : "dummy");
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_Log("Couldn't initialize audio: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    sine_input = (float *)SDL_malloc(INPUT_FRAMES * MAX_CHANNELS * sizeof(float));
+    if (!sine_input) {
+        SDL_Quit();
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+    for (i = 0; i < INPUT_FRAMES * MAX_CHANNELS; i++) {
+        sine_input[i] = 0.5f * SDL_sinf((float)(i / MAX_CHANNELS) * 2.0f * SDL_PI_F * 440.0f / 48000.0f);
+    }
+
+    SDL_Log("Each measurement runs for at least %d ms", duration_ms);
+    if (!only || SDL_strcmp(only, "convert") == 0) {
+        bench_convert_samples();
+    }
+    if (!only || SDL_strcmp(only, "stream") == 0) {
+        bench_streams();
+    }
+    if (!only || SDL_strcmp(only, "resample") == 0) {
+        bench_resampler();
+    }
+    if (!only || SDL_strcmp(only, "mix") == 0) {
+        bench_device_mix();
+    }
+
+    SDL_free(sine_input);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
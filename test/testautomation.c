@@ -22,6 +22,7 @@ static SDLTest_CommonState *state;
 
 /* All test suites */
 static SDLTest_TestSuiteReference *testSuites[] = {
+    &asyncioTestSuite,
     &audioTestSuite,
     &clipboardTestSuite,
     &eventsTestSuite,
@@ -45,7 +46,9 @@ static SDLTest_TestSuiteReference *testSuites[] = {
     &iostrmTestSuite,
     &sdltestTestSuite,
     &stdlibTestSuite,
+    &storageTestSuite,
     &surfaceTestSuite,
+    &threadTestSuite,
     &timeTestSuite,
     &timerTestSuite,
     &videoTestSuite,
@@ -58,6 +61,7 @@ static SDLTest_TestSuiteReference *testSuites[] = {
 static void
 quit(int rc)
 {
+    SDLTest_SetBenchmarkOptions(NULL, NULL, 0.0f);
     SDLTest_CommonQuit(state);
     /* Let 'main()' return normally */
     if (rc != 0) {
@@ -76,6 +80,9 @@ int main(int argc, char *argv[])
     SDL_Event event;
     int list = 0;
     SDL_bool randomOrder = SDL_FALSE;
+    const char *benchmarkOutput = NULL;
+    const char *benchmarkBaseline = NULL;
+    float benchmarkThreshold = 0.1f;
 
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO | SDL_INIT_AUDIO);
@@ -122,6 +129,21 @@ int main(int argc, char *argv[])
             } else if (SDL_strcasecmp(argv[i], "--random-order") == 0) {
                 consumed = 1;
                 randomOrder = SDL_TRUE;
+            } else if (SDL_strcasecmp(argv[i], "--benchmark-output") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkOutput = argv[i + 1];
+                    consumed = 2;
+                }
+            } else if (SDL_strcasecmp(argv[i], "--benchmark-baseline") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkBaseline = argv[i + 1];
+                    consumed = 2;
+                }
+            } else if (SDL_strcasecmp(argv[i], "--benchmark-threshold") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkThreshold = (float)SDL_atof(argv[i + 1]) / 100.0f;
+                    consumed = 2;
+                }
             }
 
         }
@@ -133,6 +155,9 @@ int main(int argc, char *argv[])
                 "[--filter suite_name|test_name]",
                 "[--list]",
                 "[--random-order]",
+                "[--benchmark-output file.json]",
+                "[--benchmark-baseline file.json]",
+                "[--benchmark-threshold percent]",
                 NULL };
             SDLTest_CommonLogUsage(state, argv[0], options);
             quit(1);
@@ -168,6 +193,11 @@ int main(int argc, char *argv[])
         SDL_RenderClear(renderer);
     }
 
+    /* Set up benchmark output and the baseline to compare against */
+    if (SDLTest_SetBenchmarkOptions(benchmarkOutput, benchmarkBaseline, benchmarkThreshold) < 0) {
+        quit(1);
+    }
+
     /* Call Harness */
     result = SDLTest_RunSuites(testSuites, userRunSeed, userExecKey, filter, testIterations, randomOrder);
 
@@ -0,0 +1,312 @@
+/**
+ * Async I/O test suite
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+#define ASYNCIO_CHUNK_SIZE  4096
+#define ASYNCIO_NUM_CHUNKS  16
+#define ASYNCIO_NUM_FILES   64
+
+static const char *AsyncIOTestFilename = "asyncio_test";
+
+/* Helper functions */
+
+static Uint8 AsyncIOPatternByte(Uint64 offset)
+{
+    return (Uint8)((offset * 7) ^ (offset >> 8));
+}
+
+static SDL_bool WaitForAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome)
+{
+    const Uint64 timeout = SDL_GetTicks() + 10000;
+
+    while (SDL_GetTicks() < timeout) {
+        if (SDL_WaitAsyncIOResult(queue, outcome, 100)) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+static void GetAsyncIOTestFilename(char *path, size_t maxlen, int index)
+{
+    SDL_snprintf(path, maxlen, "%s_%d", AsyncIOTestFilename, index);
+}
+
+/* Test case functions */
+
+/**
+ * Writes a file out of order with SDL_WriteAsyncIO and reads it back with SDL_ReadAsyncIO.
+ */
+static int asyncio_testReadWrite(void *arg)
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOOutcome outcome;
+    Uint8 *data, *readback;
+    const size_t total = ASYNCIO_CHUNK_SIZE * ASYNCIO_NUM_CHUNKS;
+    SDL_bool seen[ASYNCIO_NUM_CHUNKS];
+    int i, result, errors;
+    size_t j;
+
+    data = (Uint8 *)SDL_malloc(total);
+    readback = (Uint8 *)SDL_calloc(1, total + ASYNCIO_CHUNK_SIZE);
+    SDLTest_AssertCheck(data && readback, "Allocate test buffers");
+    if (!data || !readback) {
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+    for (j = 0; j < total; ++j) {
+        data[j] = AsyncIOPatternByte(j);
+    }
+
+    queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertPass("Call to SDL_CreateAsyncIOQueue()");
+    SDLTest_AssertCheck(queue != NULL, "Verify queue is not NULL");
+
+    asyncio = SDL_AsyncIOFromFile(AsyncIOTestFilename, "w+");
+    SDLTest_AssertPass("Call to SDL_AsyncIOFromFile(..., \"w+\")");
+    SDLTest_AssertCheck(asyncio != NULL, "Verify file opened, got error: %s", asyncio ? "none" : SDL_GetError());
+    if (!queue || !asyncio) {
+        SDL_DestroyAsyncIOQueue(queue);
+        SDL_free(data);
+        SDL_free(readback);
+        return TEST_ABORTED;
+    }
+
+    /* Write the chunks back to front, with the chunk number as userdata */
+    for (i = ASYNCIO_NUM_CHUNKS - 1; i >= 0; --i) {
+        result = SDL_WriteAsyncIO(asyncio, data + i * ASYNCIO_CHUNK_SIZE, (Uint64)i * ASYNCIO_CHUNK_SIZE, ASYNCIO_CHUNK_SIZE, queue, (void *)(intptr_t)i);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_WriteAsyncIO() for chunk %d, expected 0, got %d", i, result);
+    }
+
+    SDL_zeroa(seen);
+    errors = 0;
+    for (i = 0; i < ASYNCIO_NUM_CHUNKS; ++i) {
+        if (!WaitForAsyncIOResult(queue, &outcome)) {
+            ++errors;
+            break;
+        }
+        if (outcome.type != SDL_ASYNCIO_TASK_WRITE || outcome.result != SDL_ASYNCIO_COMPLETE ||
+            outcome.bytes_transferred != ASYNCIO_CHUNK_SIZE || outcome.asyncio != asyncio ||
+            outcome.offset != (Uint64)(intptr_t)outcome.userdata * ASYNCIO_CHUNK_SIZE ||
+            seen[(intptr_t)outcome.userdata]) {
+            ++errors;
+        } else {
+            seen[(intptr_t)outcome.userdata] = SDL_TRUE;
+        }
+    }
+    SDLTest_AssertCheck(errors == 0, "Verify every write completed once, %d errors", errors);
+    SDLTest_AssertCheck(SDL_GetAsyncIOSize(asyncio) == (Sint64)total, "Verify SDL_GetAsyncIOSize(), expected %d, got %d", (int)total, (int)SDL_GetAsyncIOSize(asyncio));
+
+    /* Read it back in one go, asking for more than is there */
+    result = SDL_ReadAsyncIO(asyncio, readback, 0, total + ASYNCIO_CHUNK_SIZE, queue, NULL);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_ReadAsyncIO(), expected 0, got %d", result);
+    SDLTest_AssertCheck(WaitForAsyncIOResult(queue, &outcome), "Verify read finished");
+    SDLTest_AssertCheck(outcome.type == SDL_ASYNCIO_TASK_READ && outcome.result == SDL_ASYNCIO_COMPLETE, "Verify read succeeded");
+    SDLTest_AssertCheck(outcome.bytes_requested == total + ASYNCIO_CHUNK_SIZE, "Verify bytes requested");
+    SDLTest_AssertCheck(outcome.bytes_transferred == total, "Verify short read at end of file, expected %d, got %d", (int)total, (int)outcome.bytes_transferred);
+    SDLTest_AssertCheck(SDL_memcmp(data, readback, total) == 0, "Verify data read back matches");
+
+    /* Start some reads and close it while they're in flight; the close comes last */
+    for (i = 0; i < 4; ++i) {
+        result = SDL_ReadAsyncIO(asyncio, readback + i * ASYNCIO_CHUNK_SIZE, (Uint64)(i + 8) * ASYNCIO_CHUNK_SIZE, ASYNCIO_CHUNK_SIZE, queue, NULL);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_ReadAsyncIO() before close, expected 0, got %d", result);
+    }
+    result = SDL_CloseAsyncIO(asyncio, SDL_TRUE, queue, data);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_CloseAsyncIO(), expected 0, got %d", result);
+    result = SDL_ReadAsyncIO(asyncio, readback, 0, ASYNCIO_CHUNK_SIZE, queue, NULL);
+    SDLTest_AssertCheck(result < 0, "Verify SDL_ReadAsyncIO() fails after close, got %d", result);
+
+    errors = 0;
+    for (i = 0; i < 5; ++i) {
+        if (!WaitForAsyncIOResult(queue, &outcome)) {
+            ++errors;
+            break;
+        }
+        if (outcome.result != SDL_ASYNCIO_COMPLETE) {
+            ++errors;
+        } else if (i < 4 && outcome.type != SDL_ASYNCIO_TASK_READ) {
+            ++errors;
+        } else if (i == 4 && (outcome.type != SDL_ASYNCIO_TASK_CLOSE || outcome.userdata != data)) {
+            ++errors;
+        }
+    }
+    SDLTest_AssertCheck(errors == 0, "Verify the reads finished before the close, %d errors", errors);
+    SDLTest_AssertCheck(SDL_memcmp(readback, data + 8 * ASYNCIO_CHUNK_SIZE, 4 * ASYNCIO_CHUNK_SIZE) == 0, "Verify data read before close matches");
+    SDLTest_AssertCheck(!SDL_GetAsyncIOResult(queue, &outcome), "Verify queue is empty");
+
+    SDL_DestroyAsyncIOQueue(queue);
+    SDLTest_AssertPass("Call to SDL_DestroyAsyncIOQueue()");
+
+    SDL_RemovePath(AsyncIOTestFilename);
+    SDL_free(data);
+    SDL_free(readback);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Loads lots of small files at once with SDL_LoadFileAsync.
+ */
+static int asyncio_testLoadFile(void *arg)
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOOutcome outcome;
+    char path[64];
+    char expected[64];
+    SDL_bool seen[ASYNCIO_NUM_FILES];
+    int i, result, errors;
+
+    for (i = 0; i < ASYNCIO_NUM_FILES; ++i) {
+        SDL_IOStream *io;
+
+        GetAsyncIOTestFilename(path, sizeof(path), i);
+        io = SDL_IOFromFile(path, "wb");
+        if (!io) {
+            SDLTest_AssertCheck(io != NULL, "Create test file %s", path);
+            return TEST_ABORTED;
+        }
+        SDL_IOprintf(io, "This is file number %d", i);
+        SDL_CloseIO(io);
+    }
+
+    queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateAsyncIOQueue() is not NULL");
+    if (!queue) {
+        return TEST_ABORTED;
+    }
+
+    result = SDL_LoadFileAsync("nonexistent", queue, NULL);
+    SDLTest_AssertCheck(result < 0, "Verify SDL_LoadFileAsync() of a missing file fails, got %d", result);
+
+    errors = 0;
+    for (i = 0; i < ASYNCIO_NUM_FILES; ++i) {
+        GetAsyncIOTestFilename(path, sizeof(path), i);
+        if (SDL_LoadFileAsync(path, queue, (void *)(intptr_t)i) < 0) {
+            ++errors;
+        }
+    }
+    SDLTest_AssertCheck(errors == 0, "Verify SDL_LoadFileAsync() calls, %d errors", errors);
+
+    SDL_zeroa(seen);
+    errors = 0;
+    for (i = 0; i < ASYNCIO_NUM_FILES; ++i) {
+        int index;
+
+        if (!WaitForAsyncIOResult(queue, &outcome)) {
+            ++errors;
+            break;
+        }
+        index = (int)(intptr_t)outcome.userdata;
+        SDL_snprintf(expected, sizeof(expected), "This is file number %d", index);
+        if (outcome.type != SDL_ASYNCIO_TASK_READ || outcome.result != SDL_ASYNCIO_COMPLETE ||
+            index < 0 || index >= ASYNCIO_NUM_FILES || seen[index] || !outcome.buffer ||
+            outcome.bytes_transferred != SDL_strlen(expected) ||
+            SDL_strcmp((const char *)outcome.buffer, expected) != 0) {
+            ++errors;
+        } else {
+            seen[index] = SDL_TRUE;
+        }
+        SDL_free(outcome.buffer);
+    }
+    SDLTest_AssertCheck(errors == 0, "Verify every file loaded once with the right contents, %d errors", errors);
+
+    /* Destroying a queue with loads still pending frees their buffers */
+    for (i = 0; i < ASYNCIO_NUM_FILES; ++i) {
+        GetAsyncIOTestFilename(path, sizeof(path), i);
+        SDL_LoadFileAsync(path, queue, NULL);
+    }
+    SDL_DestroyAsyncIOQueue(queue);
+    SDLTest_AssertPass("Call to SDL_DestroyAsyncIOQueue() with loads pending");
+
+    for (i = 0; i < ASYNCIO_NUM_FILES; ++i) {
+        GetAsyncIOTestFilename(path, sizeof(path), i);
+        SDL_RemovePath(path);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static SDL_AtomicInt g_waitDone;
+
+static int SDLCALL asyncio_waitThread(void *userdata)
+{
+    SDL_AsyncIOOutcome outcome;
+    SDL_bool result;
+
+    result = SDL_WaitAsyncIOResult((SDL_AsyncIOQueue *)userdata, &outcome, -1);
+    SDL_AtomicSet(&g_waitDone, 1);
+    return result ? 1 : 0;
+}
+
+/**
+ * Checks empty queues, bad parameters and SDL_SignalAsyncIOQueue.
+ */
+static int asyncio_testQueue(void *arg)
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOOutcome outcome;
+    SDL_Thread *thread;
+    int status = -1;
+
+    SDLTest_AssertCheck(SDL_AsyncIOFromFile(AsyncIOTestFilename, "a") == NULL, "Verify append mode is rejected");
+    SDLTest_AssertCheck(SDL_AsyncIOFromFile("nonexistent", "r") == NULL, "Verify opening a missing file fails");
+
+    queue = SDL_CreateAsyncIOQueue();
+    SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateAsyncIOQueue() is not NULL");
+    if (!queue) {
+        return TEST_ABORTED;
+    }
+
+    SDLTest_AssertCheck(!SDL_GetAsyncIOResult(queue, &outcome), "Verify an empty queue has no results");
+    SDLTest_AssertCheck(!SDL_WaitAsyncIOResult(queue, &outcome, 10), "Verify waiting on an empty queue times out");
+
+    SDL_AtomicSet(&g_waitDone, 0);
+    thread = SDL_CreateThread(asyncio_waitThread, "AsyncIOWait", queue);
+    if (thread) {
+        /* Keep signaling until the thread has started waiting and wakes up */
+        while (!SDL_AtomicGet(&g_waitDone)) {
+            SDL_SignalAsyncIOQueue(queue);
+            SDL_Delay(10);
+        }
+        SDL_WaitThread(thread, &status);
+        SDLTest_AssertCheck(status == 0, "Verify signaled thread woke up without a result, got %d", status);
+    }
+
+    SDL_DestroyAsyncIOQueue(queue);
+    SDLTest_AssertPass("Call to SDL_DestroyAsyncIOQueue()");
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Async I/O test cases */
+static const SDLTest_TestCaseReference asyncioTest1 = {
+    (SDLTest_TestCaseFp)asyncio_testReadWrite, "asyncio_testReadWrite", "Write and read a file with SDL_WriteAsyncIO and SDL_ReadAsyncIO", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference asyncioTest2 = {
+    (SDLTest_TestCaseFp)asyncio_testLoadFile, "asyncio_testLoadFile", "Load many files with SDL_LoadFileAsync", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference asyncioTest3 = {
+    (SDLTest_TestCaseFp)asyncio_testQueue, "asyncio_testQueue", "Check SDL_AsyncIOQueue waiting and signaling", TEST_ENABLED
+};
+
+/* Sequence of Async I/O test cases */
+static const SDLTest_TestCaseReference *asyncioTests[] = {
+    &asyncioTest1, &asyncioTest2, &asyncioTest3, NULL
+};
+
+/* Async I/O test suite (global) */
+SDLTest_TestSuiteReference asyncioTestSuite = {
+    "AsyncIO",
+    NULL,
+    asyncioTests,
+    NULL
+};
@@ -1033,6 +1033,7 @@ static int audio_resampleLoss(void *arg)
     { 50, 5000, SDL_PI_D / 2, 20000, 10000, 999, 0.0001 },
     { 50, 440, 0, 22050, 96000, 79, 0.0120 },
     { 50, 440, 0, 96000, 22050, 80, 0.0002 },
+    { 50, 440, 0, 48000, 16000, 140, 0.0001 },
     { 0 }
   };
 
@@ -1442,6 +1443,1127 @@ cleanup:
 
     return status;
 }
+
+#define SINGLE_PRODUCER_TOTAL_SAMPLES (1024 * 1024)
+
+static int SDLCALL single_producer_thread(void *arg)
+{
+    SDL_AudioStream *stream = (SDL_AudioStream *)arg;
+    static Sint16 chunk[96 * 1024];  /* larger than the stream's ring, to exercise the locked fallback. */
+    const int chunk_sizes[] = { 64, 1000, 4096, 96 * 1024, 17, 20000 };
+    int next = 0;
+    int i = 0;
+
+    while (next < SINGLE_PRODUCER_TOTAL_SAMPLES) {
+        int count = chunk_sizes[i++ % SDL_arraysize(chunk_sizes)];
+        int j;
+        count = SDL_min(count, SINGLE_PRODUCER_TOTAL_SAMPLES - next);
+        for (j = 0; j < count; j++) {
+            chunk[j] = (Sint16)(next + j);
+        }
+        if (SDL_PutAudioStreamData(stream, chunk, count * (int)sizeof(Sint16)) != 0) {
+            return -1;
+        }
+        next += count;
+    }
+    return 0;
+}
+
+/**
+ * Feed a single producer stream from another thread and check nothing is lost or reordered.
+ *
+ * \sa SDL_SetAudioStreamSingleProducer
+ */
+static int audio_singleProducerStream(void *arg)
+{
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    SDL_Thread *thread;
+    Sint16 buf[4096];
+    int received = 0;
+    int mismatches = 0;
+    int thread_result = -1;
+    int ret;
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 1;
+    spec.freq = 48000;
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertPass("Call to SDL_CreateAudioStream()");
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    ret = SDL_SetAudioStreamSingleProducer(stream, SDL_TRUE);
+    SDLTest_AssertPass("Call to SDL_SetAudioStreamSingleProducer(stream, SDL_TRUE)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    thread = SDL_CreateThread(single_producer_thread, "AudioProducer", stream);
+    SDLTest_AssertCheck(thread != NULL, "Expected SDL_CreateThread to succeed");
+    if (thread == NULL) {
+        SDL_DestroyAudioStream(stream);
+        return TEST_ABORTED;
+    }
+
+    while (received < SINGLE_PRODUCER_TOTAL_SAMPLES) {
+        int i, n;
+        ret = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+        if (ret < 0) {
+            break;
+        }
+        n = ret / (int)sizeof(Sint16);
+        for (i = 0; i < n; i++) {
+            if (buf[i] != (Sint16)(received + i)) {
+                mismatches++;
+            }
+        }
+        received += n;
+        if (n == 0) {
+            SDL_Delay(1);
+        }
+    }
+
+    SDL_WaitThread(thread, &thread_result);
+    SDLTest_AssertCheck(thread_result == 0, "Expected producer thread to succeed, got %d", thread_result);
+    SDLTest_AssertCheck(received == SINGLE_PRODUCER_TOTAL_SAMPLES, "Expected %d samples, got %d", SINGLE_PRODUCER_TOTAL_SAMPLES, received);
+    SDLTest_AssertCheck(mismatches == 0, "Expected samples in order, got %d mismatches", mismatches);
+
+    /* Data sitting in the ring must be visible to queries and dropped by clear. */
+    SDL_memset(buf, 0, sizeof(buf));
+    ret = SDL_PutAudioStreamData(stream, buf, 1024);
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    ret = SDL_GetAudioStreamQueued(stream);
+    SDLTest_AssertCheck(ret == 1024, "Expected 1024 bytes queued, got %d", ret);
+    ret = SDL_ClearAudioStream(stream);
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    ret = SDL_GetAudioStreamQueued(stream);
+    SDLTest_AssertCheck(ret == 0, "Expected 0 bytes queued after clear, got %d", ret);
+
+    ret = SDL_SetAudioStreamSingleProducer(stream, SDL_FALSE);
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+
+#define MIX_THREADS_NUM_STREAMS 32
+
+static SDL_AtomicInt g_mixThreadsCallbacks;
+
+static void SDLCALL mix_threads_callback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    SDL_AtomicIncRef(&g_mixThreadsCallbacks);
+}
+
+/**
+ * Play many streams through one device with SDL_HINT_AUDIO_MIX_THREADS set and check they all get consumed.
+ *
+ * \sa SDL_BindAudioStreams
+ */
+static int audio_mixThreads(void *arg)
+{
+    SDL_AudioSpec spec;
+    SDL_AudioStream *streams[MIX_THREADS_NUM_STREAMS];
+    SDL_AudioDeviceID devid;
+    float *data;
+    const int num_frames = 4800;
+    int i, ret;
+    int remaining = 0;
+    Uint64 start;
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32;
+    spec.channels = 2;
+    spec.freq = 48000;
+
+    SDL_SetHint(SDL_HINT_AUDIO_MIX_THREADS, "4");
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_AUDIO_MIX_THREADS, \"4\")");
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec)");
+    if (devid == 0) {
+        SDLTest_Log("No playback device available: %s", SDL_GetError());
+        SDL_ResetHint(SDL_HINT_AUDIO_MIX_THREADS);
+        return TEST_SKIPPED;
+    }
+
+    data = (float *)SDL_malloc(num_frames * 2 * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Expected SDL_malloc to succeed");
+    if (data == NULL) {
+        SDL_CloseAudioDevice(devid);
+        SDL_ResetHint(SDL_HINT_AUDIO_MIX_THREADS);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < num_frames * 2; i++) {
+        data[i] = 0.01f * (float)SDL_sin(i * 0.01);
+    }
+
+    SDL_AtomicSet(&g_mixThreadsCallbacks, 0);
+
+    /* Half the streams need resampling, so the workers have something to do. */
+    for (i = 0; i < MIX_THREADS_NUM_STREAMS; i++) {
+        SDL_AudioSpec src_spec = spec;
+        if (i & 1) {
+            src_spec.freq = 44100;
+        }
+        streams[i] = SDL_CreateAudioStream(&src_spec, NULL);
+        SDLTest_AssertCheck(streams[i] != NULL, "Expected SDL_CreateAudioStream to succeed");
+        if (streams[i] == NULL) {
+            break;
+        }
+        SDL_SetAudioStreamGetCallback(streams[i], mix_threads_callback, NULL);
+    }
+
+    if (i == MIX_THREADS_NUM_STREAMS) {
+        /* Pause the device so it doesn't start mixing until every stream has data. */
+        SDL_PauseAudioDevice(devid);
+        ret = SDL_BindAudioStreams(devid, streams, MIX_THREADS_NUM_STREAMS);
+        SDLTest_AssertPass("Call to SDL_BindAudioStreams(%d streams)", MIX_THREADS_NUM_STREAMS);
+        SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+        for (i = 0; i < MIX_THREADS_NUM_STREAMS; i++) {
+            ret = SDL_PutAudioStreamData(streams[i], data, num_frames * 2 * sizeof(float));
+            SDLTest_AssertCheck(ret == 0, "Expected SDL_PutAudioStreamData to succeed, got %d", ret);
+            SDL_FlushAudioStream(streams[i]);
+        }
+        SDL_ResumeAudioDevice(devid);
+
+        /* 0.1 seconds of audio, give the device plenty of time to play it. */
+        start = SDL_GetTicks();
+        do {
+            SDL_Delay(10);
+            remaining = 0;
+            for (i = 0; i < MIX_THREADS_NUM_STREAMS; i++) {
+                remaining += SDL_GetAudioStreamAvailable(streams[i]);
+            }
+        } while (remaining > 0 && SDL_GetTicks() - start < 5000);
+
+        SDLTest_AssertCheck(remaining == 0, "Expected every stream to be consumed, %d bytes remaining", remaining);
+        SDLTest_AssertCheck(SDL_AtomicGet(&g_mixThreadsCallbacks) >= MIX_THREADS_NUM_STREAMS, "Expected get callbacks for every stream, got %d", SDL_AtomicGet(&g_mixThreadsCallbacks));
+
+        SDL_UnbindAudioStreams(streams, MIX_THREADS_NUM_STREAMS);
+        SDLTest_AssertPass("Call to SDL_UnbindAudioStreams()");
+        i = MIX_THREADS_NUM_STREAMS;
+    }
+
+    while (i-- > 0) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(data);
+    SDL_CloseAudioDevice(devid);
+    SDL_ResetHint(SDL_HINT_AUDIO_MIX_THREADS);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check SDL_MixAudio against a straightforward implementation, for lengths around the SIMD block sizes.
+ *
+ * \sa SDL_MixAudio
+ */
+static int audio_mixAudio(void *arg)
+{
+    const float volumes[] = { 1.0f, 0.5f, 0.3f, 1.7f };
+    float fsrc[67], fdst[67], fexpected[67];
+    Sint16 ssrc[67], sdst[67], sexpected[67];
+    int v, len, offset, i, ret;
+
+    for (v = 0; v < SDL_arraysize(volumes); v++) {
+        const float volume = volumes[v];
+        const int ivolume = (int)SDL_roundf(volume * 128);
+
+        for (len = 0; len <= 64; len++) {
+            /* use odd offsets too, the SIMD paths can't assume the buffers are aligned. */
+            for (offset = 0; offset <= 3; offset += 3) {
+                int mismatches = 0;
+
+                for (i = 0; i < len + offset; i++) {
+                    fsrc[i] = SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+                    fdst[i] = SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+                    ssrc[i] = SDLTest_RandomSint16();
+                    sdst[i] = SDLTest_RandomSint16();
+                }
+
+                for (i = offset; i < len + offset; i++) {
+                    const float fsample = fdst[i] + fsrc[i] * volume;
+                    const int ssample = sdst[i] + (Sint16)((ssrc[i] * ivolume) / 128);
+                    fexpected[i] = SDL_clamp(fsample, -1.0f, 1.0f);
+                    sexpected[i] = (Sint16)SDL_clamp(ssample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+                }
+
+                ret = SDL_MixAudio((Uint8 *)&fdst[offset], (const Uint8 *)&fsrc[offset], SDL_AUDIO_F32, len * sizeof(float), volume);
+                SDLTest_AssertCheck(ret == 0, "Expected SDL_MixAudio(SDL_AUDIO_F32) to return 0, got %d", ret);
+                ret = SDL_MixAudio((Uint8 *)&sdst[offset], (const Uint8 *)&ssrc[offset], SDL_AUDIO_S16, len * sizeof(Sint16), volume);
+                SDLTest_AssertCheck(ret == 0, "Expected SDL_MixAudio(SDL_AUDIO_S16) to return 0, got %d", ret);
+
+                for (i = offset; i < len + offset; i++) {
+                    if (fdst[i] != fexpected[i] || sdst[i] != sexpected[i]) {
+                        mismatches++;
+                    }
+                }
+                if (mismatches) {
+                    SDLTest_AssertCheck(SDL_FALSE, "Expected mixed samples to match for volume %f, length %d, offset %d; %d mismatches", volume, len, offset, mismatches);
+                }
+            }
+        }
+    }
+    SDLTest_AssertPass("Mixed F32 and S16 audio with various volumes and lengths");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check the signal-to-noise ratio of each resampler quality, and that better quality is better.
+ *
+ * \sa SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER
+ */
+static int audio_resampleQuality(void *arg)
+{
+    const struct {
+        int rate_in;
+        int rate_out;
+        int channels;
+        double min_snr[3]; /* low, medium, high */
+    } test_specs[] = {
+        { 44100, 48000, 2, { 60, 80, 100 } },
+        { 48000, 44100, 1, { 60, 80, 100 } },
+        { 48000, 44100, 2, { 60, 80, 100 } },
+        { 22050, 48000, 1, { 50, 75, 100 } },
+        { 48000, 32000, 2, { 60, 80, 100 } },
+    };
+    const int time = 2;
+    const int sine_freq = 440;
+    int spec_idx, quality, i, j;
+
+    for (spec_idx = 0; spec_idx < SDL_arraysize(test_specs); spec_idx++) {
+        const int rate_in = test_specs[spec_idx].rate_in;
+        const int rate_out = test_specs[spec_idx].rate_out;
+        const int channels = test_specs[spec_idx].channels;
+        const int frames_in = time * rate_in;
+        const int frames_out = time * rate_out;
+        const int len_in = frames_in * channels * (int)sizeof(float);
+        const int len_out = frames_out * channels * (int)sizeof(float);
+        float *buf_in = (float *)SDL_malloc(len_in);
+        float *buf_out = (float *)SDL_malloc(len_out);
+        double snr[3] = { 0, 0, 0 };
+
+        SDLTest_AssertCheck(buf_in && buf_out, "Expected buffers to be allocated");
+        if (!buf_in || !buf_out) {
+            SDL_free(buf_in);
+            SDL_free(buf_out);
+            return TEST_ABORTED;
+        }
+
+        for (i = 0; i < frames_in; i++) {
+            const float f = (float)sine_wave_sample(i, rate_in, sine_freq, 0);
+            for (j = 0; j < channels; j++) {
+                buf_in[i * channels + j] = f;
+            }
+        }
+
+        for (quality = SDL_AUDIO_RESAMPLE_QUALITY_LOW; quality <= SDL_AUDIO_RESAMPLE_QUALITY_HIGH; quality++) {
+            SDL_AudioSpec spec_in, spec_out;
+            SDL_AudioStream *stream;
+            double sum_squared_error = 0;
+            double sum_squared_value = 0;
+            int ret;
+
+            SDL_zero(spec_in);
+            spec_in.format = SDL_AUDIO_F32;
+            spec_in.channels = channels;
+            spec_in.freq = rate_in;
+            spec_out = spec_in;
+            spec_out.freq = rate_out;
+
+            stream = SDL_CreateAudioStream(&spec_in, &spec_out);
+            SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+            if (stream == NULL) {
+                break;
+            }
+            SDL_SetNumberProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, quality);
+
+            ret = convert_audio_chunks(stream, buf_in, len_in, buf_out, len_out);
+            SDLTest_AssertCheck(ret == len_out, "Expected %d bytes, got %d", len_out, ret);
+            SDL_DestroyAudioStream(stream);
+
+            /* Skip the very start and end, where the filters run into the silence around the input. */
+            for (i = 64; i < frames_out - 64; i++) {
+                const double target = sine_wave_sample(i, rate_out, sine_freq, 0);
+                for (j = 0; j < channels; j++) {
+                    const double error = target - buf_out[i * channels + j];
+                    sum_squared_error += error * error;
+                    sum_squared_value += target * target;
+                }
+            }
+            snr[quality] = 10 * SDL_log10(sum_squared_value / sum_squared_error);
+            SDLTest_AssertCheck(snr[quality] >= test_specs[spec_idx].min_snr[quality],
+                                "Resampling %d channel(s) from %d Hz to %d Hz at quality %d: signal-to-noise ratio %f dB should be no less than %f dB",
+                                channels, rate_in, rate_out, quality, snr[quality], test_specs[spec_idx].min_snr[quality]);
+        }
+
+        SDLTest_AssertCheck(snr[SDL_AUDIO_RESAMPLE_QUALITY_LOW] < snr[SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM] &&
+                            snr[SDL_AUDIO_RESAMPLE_QUALITY_MEDIUM] < snr[SDL_AUDIO_RESAMPLE_QUALITY_HIGH],
+                            "Expected higher quality to give a better signal-to-noise ratio");
+
+        SDL_free(buf_in);
+        SDL_free(buf_out);
+    }
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    const void *buf;
+    int buflen;
+    int count;
+} NoCopyRelease;
+
+static void SDLCALL nocopy_release_callback(void *userdata, const void *buf, int buflen)
+{
+    NoCopyRelease *release = (NoCopyRelease *)userdata;
+    release->buf = buf;
+    release->buflen = buflen;
+    release->count++;
+}
+
+/**
+ * Put caller-owned buffers into a stream and check when they are released.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+static int audio_putAudioStreamDataNoCopy(void *arg)
+{
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    NoCopyRelease first, second, empty;
+    Sint16 data_first[1024];
+    Sint16 data_second[512];
+    Sint16 data_copied[256];
+    Sint16 out[1024];
+    int i, ret, mismatches;
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 1;
+    spec.freq = 48000;
+
+    SDL_zero(first);
+    SDL_zero(second);
+    SDL_zero(empty);
+
+    for (i = 0; i < SDL_arraysize(data_first); i++) {
+        data_first[i] = (Sint16)i;
+    }
+    for (i = 0; i < SDL_arraysize(data_second); i++) {
+        data_second[i] = (Sint16)-i;
+    }
+    for (i = 0; i < SDL_arraysize(data_copied); i++) {
+        data_copied[i] = (Sint16)(i * 3);
+    }
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertPass("Call to SDL_CreateAudioStream()");
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    ret = SDL_PutAudioStreamDataNoCopy(stream, data_first, 0, nocopy_release_callback, &empty);
+    SDLTest_AssertPass("Call to SDL_PutAudioStreamDataNoCopy(stream, data, 0, ...)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    SDLTest_AssertCheck(empty.count == 1, "Expected an empty buffer to be released right away, got %d releases", empty.count);
+
+    ret = SDL_PutAudioStreamDataNoCopy(stream, data_first, sizeof(data_first), nocopy_release_callback, &first);
+    SDLTest_AssertPass("Call to SDL_PutAudioStreamDataNoCopy(stream, data_first, ...)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    ret = SDL_PutAudioStreamData(stream, data_copied, sizeof(data_copied));
+    SDLTest_AssertPass("Call to SDL_PutAudioStreamData(stream, data_copied, ...)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    SDLTest_AssertCheck(first.count == 0, "Expected the buffer to still be in use, got %d releases", first.count);
+
+    ret = SDL_GetAudioStreamData(stream, out, sizeof(out));
+    SDLTest_AssertCheck(ret == (int)sizeof(out), "Expected %d bytes, got %d", (int)sizeof(out), ret);
+    mismatches = 0;
+    for (i = 0; i < SDL_arraysize(out); i++) {
+        if (out[i] != data_first[i]) {
+            mismatches++;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Expected the data to come out unchanged, got %d mismatched samples", mismatches);
+
+    ret = SDL_GetAudioStreamData(stream, out, sizeof(data_copied));
+    SDLTest_AssertCheck(ret == (int)sizeof(data_copied), "Expected %d bytes, got %d", (int)sizeof(data_copied), ret);
+    SDLTest_AssertCheck(SDL_memcmp(out, data_copied, sizeof(data_copied)) == 0, "Expected the copied data to follow the borrowed data");
+    SDLTest_AssertCheck(first.count == 1, "Expected the buffer to be released once, got %d releases", first.count);
+    SDLTest_AssertCheck(first.buf == data_first && first.buflen == (int)sizeof(data_first),
+                        "Expected the callback to get the original buffer and length");
+
+    ret = SDL_PutAudioStreamDataNoCopy(stream, data_second, sizeof(data_second), nocopy_release_callback, &second);
+    SDLTest_AssertPass("Call to SDL_PutAudioStreamDataNoCopy(stream, data_second, ...)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    ret = SDL_ClearAudioStream(stream);
+    SDLTest_AssertPass("Call to SDL_ClearAudioStream(stream)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    SDLTest_AssertCheck(second.count == 1, "Expected clearing the stream to release the buffer, got %d releases", second.count);
+
+    ret = SDL_PutAudioStreamDataNoCopy(stream, data_second, sizeof(data_second), nocopy_release_callback, &second);
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    ret = SDL_PutAudioStreamDataNoCopy(stream, data_first, sizeof(data_first), NULL, NULL);
+    SDLTest_AssertCheck(ret == 0, "Expected a NULL callback to be accepted, got %d", ret);
+
+    SDL_DestroyAudioStream(stream);
+    SDLTest_AssertPass("Call to SDL_DestroyAudioStream(stream)");
+    SDLTest_AssertCheck(second.count == 2, "Expected destroying the stream to release the buffer, got %d releases", second.count);
+
+    ret = SDL_PutAudioStreamDataNoCopy(NULL, data_first, sizeof(data_first), nocopy_release_callback, &first);
+    SDLTest_AssertCheck(ret < 0, "Expected a NULL stream to fail, got %d", ret);
+    SDLTest_AssertCheck(first.count == 1, "Expected a failed put not to release the buffer, got %d releases", first.count);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_AtomicInt calls;
+    SDL_AtomicInt bad_buffers;
+    int buffer_size;
+} DeviceCallbackData;
+
+static void SDLCALL device_callback(void *userdata, const SDL_AudioSpec *spec, Uint8 *buffer, int buflen)
+{
+    DeviceCallbackData *data = (DeviceCallbackData *)userdata;
+    if (buflen <= 0 || buflen > data->buffer_size || (buflen % SDL_AUDIO_FRAMESIZE(*spec)) != 0) {
+        SDL_AtomicAdd(&data->bad_buffers, 1);
+    }
+    SDL_memset(buffer, 0, buflen);
+    SDL_AtomicAdd(&data->calls, 1);
+}
+
+/**
+ * Write a playback device's buffer directly from a callback.
+ *
+ * \sa SDL_SetAudioDeviceCallback
+ */
+static int audio_deviceCallback(void *arg)
+{
+    DeviceCallbackData data;
+    SDL_AudioSpec spec;
+    SDL_AudioDeviceID devid, devid2;
+    int sample_frames = 0;
+    int init_count = 0;
+    int ret;
+    Uint64 start;
+
+    SDL_zero(data);
+
+    /* Restart the audio subsystem, so nothing else has the default device open. */
+    while (SDL_WasInit(SDL_INIT_AUDIO)) {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        init_count++;
+    }
+    SDLTest_AssertPass("Call to SDL_QuitSubSystem(SDL_INIT_AUDIO) %d times", init_count);
+    ret = SDL_InitSubSystem(SDL_INIT_AUDIO);
+    SDLTest_AssertPass("Call to SDL_InitSubSystem(SDL_INIT_AUDIO)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL)");
+    if (devid == 0) {
+        SDLTest_Log("No playback device available: %s", SDL_GetError());
+        while (--init_count > 0) {
+            SDL_InitSubSystem(SDL_INIT_AUDIO);
+        }
+        return TEST_SKIPPED;
+    }
+
+    ret = SDL_GetAudioDeviceFormat(devid, &spec, &sample_frames);
+    SDLTest_AssertCheck(ret == 0, "Expected SDL_GetAudioDeviceFormat to succeed, got %d", ret);
+    data.buffer_size = sample_frames * SDL_AUDIO_FRAMESIZE(spec);
+
+    /* A device that is shared can't be taken over. */
+    devid2 = SDL_OpenAudioDevice(devid, NULL);
+    SDLTest_AssertCheck(devid2 != 0, "Expected opening a second logical device to succeed");
+    ret = SDL_SetAudioDeviceCallback(devid, device_callback, &data);
+    SDLTest_AssertPass("Call to SDL_SetAudioDeviceCallback() on a shared device");
+    SDLTest_AssertCheck(ret < 0, "Expected failure, got %d", ret);
+    SDL_CloseAudioDevice(devid2);
+
+    ret = SDL_SetAudioDeviceCallback(devid, device_callback, &data);
+    SDLTest_AssertPass("Call to SDL_SetAudioDeviceCallback()");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    /* ...and nothing else can open it while the callback is set. */
+    devid2 = SDL_OpenAudioDevice(devid, NULL);
+    SDLTest_AssertCheck(devid2 == 0, "Expected opening a second logical device to fail");
+    if (devid2) {
+        SDL_CloseAudioDevice(devid2);
+    }
+
+    start = SDL_GetTicks();
+    while (SDL_AtomicGet(&data.calls) < 4 && (SDL_GetTicks() - start) < 5000) {
+        SDL_Delay(10);
+    }
+    SDLTest_AssertCheck(SDL_AtomicGet(&data.calls) >= 4, "Expected the callback to run, got %d calls", SDL_AtomicGet(&data.calls));
+    SDLTest_AssertCheck(SDL_AtomicGet(&data.bad_buffers) == 0, "Expected whole frames no bigger than the device buffer, got %d bad buffers", SDL_AtomicGet(&data.bad_buffers));
+
+    ret = SDL_SetAudioDeviceCallback(devid, NULL, NULL);
+    SDLTest_AssertPass("Call to SDL_SetAudioDeviceCallback(devid, NULL, NULL)");
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    devid2 = SDL_OpenAudioDevice(devid, NULL);
+    SDLTest_AssertCheck(devid2 != 0, "Expected opening a second logical device to succeed again");
+    if (devid2) {
+        SDL_CloseAudioDevice(devid2);
+    }
+
+    SDL_CloseAudioDevice(devid);
+    SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+    /* Put the subsystem's reference count back where it was. */
+    while (--init_count > 0) {
+        SDL_InitSubSystem(SDL_INIT_AUDIO);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check the instrumentation reported through stream and device properties.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ * \sa SDL_GetAudioDeviceProperties
+ */
+static int audio_instrumentation(void *arg)
+{
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    SDL_AudioDeviceID devid;
+    SDL_PropertiesID props;
+    Sint16 buf[2000];
+    Sint64 value;
+    int ret;
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 1;
+    spec.freq = 48000;
+    SDL_zeroa(buf);
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    ret = SDL_PutAudioStreamData(stream, buf, 960 * sizeof(Sint16));
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertPass("Call to SDL_GetAudioStreamProperties()");
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUED_FRAMES_NUMBER, -1);
+    SDLTest_AssertCheck(value == 960, "Expected 960 queued frames, got %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_LATENCY_NS_NUMBER, -1);
+    SDLTest_AssertCheck(value == 20 * SDL_NS_PER_MS, "Expected 20ms of latency, got %" SDL_PRIs64 "ns", value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_UNDERRUNS_NUMBER, -1);
+    SDLTest_AssertCheck(value == 0, "Expected no underruns, got %" SDL_PRIs64, value);
+
+    /* Running dry counts once, no matter how many reads come back short. */
+    ret = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+    SDLTest_AssertCheck(ret == 960 * sizeof(Sint16), "Expected a short read, got %d bytes", ret);
+    ret = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+    SDLTest_AssertCheck(ret == 0, "Expected an empty read, got %d bytes", ret);
+    props = SDL_GetAudioStreamProperties(stream);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_UNDERRUNS_NUMBER, -1);
+    SDLTest_AssertCheck(value == 1, "Expected 1 underrun, got %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUED_FRAMES_NUMBER, -1);
+    SDLTest_AssertCheck(value == 0, "Expected no queued frames, got %" SDL_PRIs64, value);
+
+    /* Keeping up, then running dry again, counts again. */
+    ret = SDL_PutAudioStreamData(stream, buf, sizeof(buf));
+    SDLTest_AssertCheck(ret == 0, "Expected 0, got %d", ret);
+    ret = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+    SDLTest_AssertCheck(ret == sizeof(buf), "Expected a full read, got %d bytes", ret);
+    ret = SDL_GetAudioStreamData(stream, buf, sizeof(buf));
+    SDLTest_AssertCheck(ret == 0, "Expected an empty read, got %d bytes", ret);
+    props = SDL_GetAudioStreamProperties(stream);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_UNDERRUNS_NUMBER, -1);
+    SDLTest_AssertCheck(value == 2, "Expected 2 underruns, got %" SDL_PRIs64, value);
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec)");
+    if (devid == 0) {
+        SDLTest_Log("No playback device available: %s", SDL_GetError());
+        SDL_DestroyAudioStream(stream);
+        return TEST_COMPLETED;
+    }
+
+    ret = SDL_BindAudioStream(devid, stream);
+    SDLTest_AssertCheck(ret == 0, "Expected SDL_BindAudioStream to succeed, got %d", ret);
+    SDL_Delay(100);
+
+    props = SDL_GetAudioDeviceProperties(devid);
+    SDLTest_AssertPass("Call to SDL_GetAudioDeviceProperties()");
+    SDLTest_AssertCheck(props != 0, "Expected a valid property ID");
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_LATENCY_NS_NUMBER, -1);
+    SDLTest_AssertCheck(value > 0, "Expected the device to have some latency, got %" SDL_PRIs64 "ns", value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_XRUNS_NUMBER, -1);
+    SDLTest_AssertCheck(value >= 0, "Expected an xrun count, got %" SDL_PRIs64, value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_WAKE_JITTER_NS_NUMBER, -1);
+    SDLTest_AssertCheck(value >= 0, "Expected a wake jitter, got %" SDL_PRIs64 "ns", value);
+    value = SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_MAX_MIX_TIME_NS_NUMBER, -1);
+    SDLTest_AssertCheck(value >= SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_MIX_TIME_NS_NUMBER, -1),
+                        "Expected the longest mix time to be at least the last one, got %" SDL_PRIs64 "ns", value);
+
+    /* A bound stream adds the device latency to its own. */
+    value = SDL_GetNumberProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_LATENCY_NS_NUMBER, -1);
+    SDLTest_AssertCheck(value == SDL_GetNumberProperty(SDL_GetAudioDeviceProperties(devid), SDL_PROP_AUDIODEVICE_LATENCY_NS_NUMBER, -2),
+                        "Expected an empty bound stream to report the device latency, got %" SDL_PRIs64 "ns", value);
+
+    SDL_CloseAudioDevice(devid);
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+
+/* Builds a WAVE file in memory with a fmt chunk of the given length followed by a data chunk. */
+static Uint8 *audio_buildWAV(const Uint8 *fmt, Uint32 fmtlen, const Uint8 *data, Uint32 datalen, size_t *length)
+{
+    const Uint32 riffsize = 4 + 8 + fmtlen + 8 + datalen;
+    Uint8 *wav = (Uint8 *)SDL_malloc(8 + riffsize);
+    Uint8 *p = wav;
+    Uint32 value;
+
+    if (!wav) {
+        return NULL;
+    }
+
+    SDL_memcpy(p, "RIFF", 4);
+    value = SDL_Swap32LE(riffsize);
+    SDL_memcpy(p + 4, &value, 4);
+    SDL_memcpy(p + 8, "WAVEfmt ", 8);
+    value = SDL_Swap32LE(fmtlen);
+    SDL_memcpy(p + 16, &value, 4);
+    SDL_memcpy(p + 20, fmt, fmtlen);
+    p += 20 + fmtlen;
+    SDL_memcpy(p, "data", 4);
+    value = SDL_Swap32LE(datalen);
+    SDL_memcpy(p + 4, &value, 4);
+    SDL_memcpy(p + 8, data, datalen);
+
+    *length = 8 + riffsize;
+    return wav;
+}
+
+/* Reads everything out of a WAV stream and compares it with what SDL_LoadWAV_IO decoded. */
+static void audio_checkWAVStream(const char *name, const Uint8 *wav, size_t wavlen)
+{
+    SDL_AudioSpec spec, streamspec;
+    SDL_AudioStream *stream;
+    Uint8 *expected = NULL;
+    Uint32 expectedlen = 0;
+    Uint8 *actual;
+    int framesize, total, ret;
+    Sint64 frames;
+    const int seekframe = 1000;
+
+    ret = SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wavlen), SDL_TRUE, &spec, &expected, &expectedlen);
+    SDLTest_AssertCheck(ret == 0, "%s: expected SDL_LoadWAV_IO to succeed, got %d (%s)", name, ret, SDL_GetError());
+    if (ret != 0) {
+        return;
+    }
+
+    stream = SDL_OpenWAVStream(SDL_IOFromConstMem(wav, wavlen), SDL_TRUE, &streamspec);
+    SDLTest_AssertPass("Call to SDL_OpenWAVStream()");
+    SDLTest_AssertCheck(stream != NULL, "%s: expected SDL_OpenWAVStream to succeed (%s)", name, SDL_GetError());
+    if (stream == NULL) {
+        SDL_free(expected);
+        return;
+    }
+    SDLTest_AssertCheck(streamspec.format == spec.format && streamspec.channels == spec.channels && streamspec.freq == spec.freq,
+                        "%s: expected the stream spec to match the loaded spec", name);
+
+    framesize = SDL_AUDIO_FRAMESIZE(spec);
+    frames = SDL_GetNumberProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER, -1);
+    SDLTest_AssertCheck(frames * framesize == expectedlen, "%s: expected %d frames, got %" SDL_PRIs64, name, (int)(expectedlen / framesize), frames);
+
+    /* Read it back in odd sizes to cross block boundaries. */
+    actual = (Uint8 *)SDL_malloc(expectedlen + 4096);
+    total = 0;
+    while (actual) {
+        ret = SDL_GetAudioStreamData(stream, actual + total, SDL_min(777 * framesize, (int)expectedlen + 4096 - total));
+        if (ret <= 0) {
+            break;
+        }
+        total += ret;
+    }
+    SDLTest_AssertCheck(total == (int)expectedlen, "%s: expected %d bytes from the stream, got %d", name, (int)expectedlen, total);
+    SDLTest_AssertCheck(actual && total == (int)expectedlen && SDL_memcmp(actual, expected, expectedlen) == 0,
+                        "%s: expected the streamed data to match the loaded data", name);
+
+    /* Seek into the middle of a block and read to the end. */
+    ret = SDL_SeekWAVStream(stream, seekframe);
+    SDLTest_AssertCheck(ret == 0, "%s: expected SDL_SeekWAVStream to succeed, got %d", name, ret);
+    total = 0;
+    while (actual) {
+        ret = SDL_GetAudioStreamData(stream, actual + total, (int)expectedlen + 4096 - total);
+        if (ret <= 0) {
+            break;
+        }
+        total += ret;
+    }
+    SDLTest_AssertCheck(total == (int)expectedlen - seekframe * framesize, "%s: expected %d bytes after seeking, got %d",
+                        name, (int)expectedlen - seekframe * framesize, total);
+    SDLTest_AssertCheck(actual && total == (int)expectedlen - seekframe * framesize &&
+                            SDL_memcmp(actual, expected + seekframe * framesize, total) == 0,
+                        "%s: expected the data after seeking to match the loaded data", name);
+
+    SDL_free(actual);
+    SDL_free(expected);
+    SDL_DestroyAudioStream(stream);
+}
+
+/**
+ * \brief Stream PCM and IMA ADPCM WAVE files and compare them with SDL_LoadWAV_IO.
+ *
+ * \sa SDL_OpenWAVStream
+ * \sa SDL_SeekWAVStream
+ */
+static int audio_openWAVStream(void *arg)
+{
+    /* 16-bit PCM, stereo, 44100 Hz. */
+    static const Uint8 pcmfmt[16] = { 0x01, 0x00, 0x02, 0x00, 0x44, 0xac, 0x00, 0x00, 0x10, 0xb1, 0x02, 0x00, 0x04, 0x00, 0x10, 0x00 };
+    /* IMA ADPCM, mono, 22050 Hz, 256 byte blocks with 505 samples each. */
+    static const Uint8 imafmt[20] = { 0x11, 0x00, 0x01, 0x00, 0x22, 0x56, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00, 0x02, 0x00, 0xf9, 0x01 };
+    /* 24-bit PCM, stereo, 48000 Hz. */
+    static const Uint8 pcm24fmt[16] = { 0x01, 0x00, 0x02, 0x00, 0x80, 0xbb, 0x00, 0x00, 0x00, 0x65, 0x04, 0x00, 0x06, 0x00, 0x18, 0x00 };
+    const Uint32 pcmlen = 10007 * 4;
+    const Uint32 imalen = 9 * 256;
+    Uint8 *data, *wav;
+    size_t wavlen;
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    Uint32 i;
+    int ret;
+
+    data = (Uint8 *)SDL_malloc(pcmlen);
+    SDLTest_AssertCheck(data != NULL, "Expected SDL_malloc to succeed");
+    if (data == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < pcmlen; i++) {
+        data[i] = (Uint8)SDLTest_RandomUint8();
+    }
+    wav = audio_buildWAV(pcmfmt, sizeof(pcmfmt), data, pcmlen, &wavlen);
+    if (wav) {
+        audio_checkWAVStream("PCM", wav, wavlen);
+        SDL_free(wav);
+    }
+
+    /* 24-bit PCM gets shifted to 32 bits. */
+    wav = audio_buildWAV(pcm24fmt, sizeof(pcm24fmt), data, pcmlen - (pcmlen % 6), &wavlen);
+    if (wav) {
+        Uint8 *buf = NULL;
+        Uint32 len = 0;
+        ret = SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wavlen), SDL_TRUE, &spec, &buf, &len);
+        SDLTest_AssertCheck(ret == 0 && spec.format == SDL_AUDIO_S32LE && len == (pcmlen - (pcmlen % 6)) / 3 * 4,
+                            "Expected 24-bit data to load as S32LE, got %d, format 0x%x, %u bytes", ret, (unsigned int)spec.format, (unsigned int)len);
+        if (ret == 0) {
+            int errors = 0;
+            for (i = 0; i < len / 4; i++) {
+                errors += (buf[i * 4] != 0) + (buf[i * 4 + 1] != data[i * 3]) + (buf[i * 4 + 2] != data[i * 3 + 1]) + (buf[i * 4 + 3] != data[i * 3 + 2]);
+            }
+            SDLTest_AssertCheck(errors == 0, "Expected every 24-bit sample to be shifted to 32 bits, %d bytes differ", errors);
+        }
+        SDL_free(buf);
+        audio_checkWAVStream("24-bit PCM", wav, wavlen);
+        SDL_free(wav);
+    }
+
+    /* Random ADPCM nibbles with a sane block header: a zero sample and step index. */
+    for (i = 0; i < imalen; i++) {
+        data[i] = (i % 256) < 4 ? 0 : (Uint8)SDLTest_RandomUint8();
+    }
+    wav = audio_buildWAV(imafmt, sizeof(imafmt), data, imalen, &wavlen);
+    if (wav) {
+        audio_checkWAVStream("IMA ADPCM", wav, wavlen);
+        SDL_free(wav);
+    }
+
+    SDL_free(data);
+
+    /* Seeking needs a stream from SDL_OpenWAVStream. */
+    stream = SDL_CreateAudioStream(NULL, NULL);
+    ret = SDL_SeekWAVStream(stream, 0);
+    SDLTest_AssertCheck(ret < 0, "Expected SDL_SeekWAVStream to fail on a regular stream, got %d", ret);
+    SDL_DestroyAudioStream(stream);
+
+    stream = SDL_OpenWAVStream(SDL_IOFromConstMem("RIFF", 4), SDL_TRUE, NULL);
+    SDLTest_AssertCheck(stream == NULL, "Expected SDL_OpenWAVStream to fail on a truncated header");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check planar input and channel map swizzles for the layouts with a SIMD path.
+ *
+ * \sa SDL_PutAudioStreamPlanarData
+ * \sa SDL_SetAudioStreamInputChannelMap
+ */
+static int audio_planarAndSwizzle(void *arg)
+{
+    static const int map71[8] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+    static const int map51[6] = { 0, 1, 4, 5, 2, 3 };
+    const int num_frames = 1003;  /* not a multiple of any SIMD group. */
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    Sint32 *input, *output;
+    const void *planes[8];
+    int i, ch, ret, errors;
+
+    input = (Sint32 *)SDL_malloc(num_frames * 8 * sizeof(Sint32));
+    output = (Sint32 *)SDL_malloc(num_frames * 8 * sizeof(Sint32));
+    SDLTest_AssertCheck(input != NULL && output != NULL, "Expected SDL_malloc to succeed");
+    if (input == NULL || output == NULL) {
+        SDL_free(input);
+        SDL_free(output);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < num_frames * 8; i++) {
+        input[i] = (Sint32)SDLTest_RandomUint32();
+    }
+
+    /* Swizzle 7.1 S32 and 5.1 S16 through the input channel map. */
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_S32;
+    spec.channels = 8;
+    spec.freq = 48000;
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream) {
+        ret = SDL_SetAudioStreamInputChannelMap(stream, map71, 8);
+        SDLTest_AssertCheck(ret == 0, "Expected SDL_SetAudioStreamInputChannelMap to succeed, got %d", ret);
+        SDL_PutAudioStreamData(stream, input, num_frames * 8 * sizeof(Sint32));
+        ret = SDL_GetAudioStreamData(stream, output, num_frames * 8 * sizeof(Sint32));
+        SDLTest_AssertCheck(ret == num_frames * 8 * (int)sizeof(Sint32), "Expected all frames back, got %d bytes", ret);
+        errors = 0;
+        for (i = 0; i < num_frames; i++) {
+            for (ch = 0; ch < 8; ch++) {
+                errors += (output[i * 8 + ch] != input[i * 8 + map71[ch]]);
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Expected the 7.1 samples to follow the channel map, %d didn't", errors);
+        SDL_DestroyAudioStream(stream);
+    }
+
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 6;
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream) {
+        const Sint16 *in16 = (const Sint16 *)input;
+        const Sint16 *out16 = (const Sint16 *)output;
+        ret = SDL_SetAudioStreamInputChannelMap(stream, map51, 6);
+        SDLTest_AssertCheck(ret == 0, "Expected SDL_SetAudioStreamInputChannelMap to succeed, got %d", ret);
+        SDL_PutAudioStreamData(stream, input, num_frames * 6 * sizeof(Sint16));
+        ret = SDL_GetAudioStreamData(stream, output, num_frames * 6 * sizeof(Sint16));
+        SDLTest_AssertCheck(ret == num_frames * 6 * (int)sizeof(Sint16), "Expected all frames back, got %d bytes", ret);
+        errors = 0;
+        for (i = 0; i < num_frames; i++) {
+            for (ch = 0; ch < 6; ch++) {
+                errors += (out16[i * 6 + ch] != in16[i * 6 + map51[ch]]);
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Expected the 5.1 samples to follow the channel map, %d didn't", errors);
+        SDL_DestroyAudioStream(stream);
+    }
+
+    /* Planar stereo F32 takes the SIMD path, planar 3-channel U8 with a missing channel doesn't. */
+    spec.format = SDL_AUDIO_F32;
+    spec.channels = 2;
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream) {
+        planes[0] = input;
+        planes[1] = input + num_frames;
+        ret = SDL_PutAudioStreamPlanarData(stream, planes, 3, num_frames);
+        SDLTest_AssertCheck(ret < 0, "Expected a channel count mismatch to fail, got %d", ret);
+        ret = SDL_PutAudioStreamPlanarData(stream, planes, -1, num_frames);
+        SDLTest_AssertCheck(ret == 0, "Expected SDL_PutAudioStreamPlanarData to succeed, got %d", ret);
+        ret = SDL_GetAudioStreamData(stream, output, num_frames * 2 * sizeof(Sint32));
+        SDLTest_AssertCheck(ret == num_frames * 2 * (int)sizeof(Sint32), "Expected all frames back, got %d bytes", ret);
+        errors = 0;
+        for (i = 0; i < num_frames; i++) {
+            errors += SDL_memcmp(&output[i * 2], &input[i], 4) != 0;
+            errors += SDL_memcmp(&output[i * 2 + 1], &input[num_frames + i], 4) != 0;
+        }
+        SDLTest_AssertCheck(errors == 0, "Expected the planar stereo samples to be interleaved, %d weren't", errors);
+        SDL_DestroyAudioStream(stream);
+    }
+
+    spec.format = SDL_AUDIO_U8;
+    spec.channels = 3;
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream) {
+        const Uint8 *in8 = (const Uint8 *)input;
+        const Uint8 *out8 = (const Uint8 *)output;
+        planes[0] = in8;
+        planes[1] = NULL;
+        planes[2] = in8 + num_frames;
+        ret = SDL_PutAudioStreamPlanarData(stream, planes, 3, num_frames);
+        SDLTest_AssertCheck(ret == 0, "Expected SDL_PutAudioStreamPlanarData to succeed, got %d", ret);
+        ret = SDL_GetAudioStreamData(stream, output, num_frames * 3);
+        SDLTest_AssertCheck(ret == num_frames * 3, "Expected all frames back, got %d bytes", ret);
+        errors = 0;
+        for (i = 0; i < num_frames; i++) {
+            errors += (out8[i * 3] != in8[i]) + (out8[i * 3 + 1] != 0x80) + (out8[i * 3 + 2] != in8[num_frames + i]);
+        }
+        SDLTest_AssertCheck(errors == 0, "Expected the planar U8 samples to be interleaved with silence, %d weren't", errors);
+        SDL_DestroyAudioStream(stream);
+    }
+
+    SDL_free(input);
+    SDL_free(output);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check that a stream with reserved queue chunks in realtime mode stops allocating.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+static int audio_queuePool(void *arg)
+{
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    SDL_PropertiesID props;
+    Uint8 input[4000], output[4000];
+    int i, ret, before, after;
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 2;
+    spec.freq = 48000;
+    for (i = 0; i < (int)sizeof(input); i++) {
+        input[i] = (Uint8)i;
+    }
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_GetAudioStreamProperties(stream);
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUE_CHUNK_SIZE_NUMBER, 1024);
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUE_RESERVED_CHUNKS_NUMBER, 8);
+    SDL_SetBooleanProperty(props, SDL_PROP_AUDIOSTREAM_QUEUE_REALTIME_BOOLEAN, SDL_TRUE);
+
+    /* The first round trip reserves the chunks and sizes the work buffers. */
+    ret = SDL_PutAudioStreamData(stream, input, sizeof(input));
+    SDLTest_AssertCheck(ret == 0, "Expected SDL_PutAudioStreamData to succeed, got %d", ret);
+    ret = SDL_GetAudioStreamData(stream, output, sizeof(output));
+    SDLTest_AssertCheck(ret == sizeof(output), "Expected %d bytes, got %d", (int)sizeof(output), ret);
+
+    before = SDL_GetNumAllocations();
+    for (i = 0; i < 10; i++) {
+        SDL_PutAudioStreamData(stream, input, sizeof(input));
+        ret = SDL_GetAudioStreamData(stream, output, sizeof(output));
+        if (ret != sizeof(output) || SDL_memcmp(input, output, sizeof(output)) != 0) {
+            break;
+        }
+    }
+    after = SDL_GetNumAllocations();
+    SDLTest_AssertCheck(i == 10, "Expected every round trip to return the data that was put in");
+    SDLTest_AssertCheck(before == after, "Expected no allocations once prefilled, the count went from %d to %d", before, after);
+
+    /* Bigger chunks only apply once the stream is empty, and the data survives the switch. */
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUE_CHUNK_SIZE_NUMBER, 512);
+    SDL_PutAudioStreamData(stream, input, sizeof(input) / 2);
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUE_CHUNK_SIZE_NUMBER, 2048);
+    SDL_PutAudioStreamData(stream, input + sizeof(input) / 2, sizeof(input) / 2);
+    ret = SDL_GetAudioStreamData(stream, output, sizeof(output));
+    SDLTest_AssertCheck(ret == sizeof(output) && SDL_memcmp(input, output, sizeof(output)) == 0,
+                        "Expected the data to come through a chunk size change intact");
+
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_AudioStream *stream;
+    const Sint16 *input;
+    float *output;
+    int input_len;
+    int output_len;
+} ConvertBenchmarkData;
+
+static void convert_benchmark_body(void *arg)
+{
+    ConvertBenchmarkData *data = (ConvertBenchmarkData *)arg;
+    SDL_PutAudioStreamData(data->stream, data->input, data->input_len);
+    SDL_GetAudioStreamData(data->stream, data->output, data->output_len);
+}
+
+/**
+ * \brief Time S16 to F32 conversion and resampling through an audio stream.
+ *
+ * \sa SDLTest_RunBenchmark
+ */
+static int audio_convertBenchmark(void *arg)
+{
+    const int num_frames = 4800;
+    const SDL_AudioSpec spec_in = { SDL_AUDIO_S16, 2, 48000 };
+    const SDL_AudioSpec spec_out = { SDL_AUDIO_F32, 2, 44100 };
+    ConvertBenchmarkData data;
+    SDLTest_BenchmarkResult result;
+    Sint16 *input;
+    int i, ret;
+
+    input = (Sint16 *)SDL_calloc(num_frames * 2, sizeof(Sint16));
+    SDL_zero(data);
+    data.input = input;
+    data.input_len = num_frames * 2 * (int)sizeof(Sint16);
+    data.output_len = num_frames * 2 * (int)sizeof(float);
+    data.output = (float *)SDL_malloc(data.output_len);
+    data.stream = SDL_CreateAudioStream(&spec_in, &spec_out);
+    SDLTest_AssertCheck(input && data.output && data.stream, "Expected the benchmark buffers and stream to be created");
+    if (!input || !data.output || !data.stream) {
+        SDL_DestroyAudioStream(data.stream);
+        SDL_free(data.output);
+        SDL_free(input);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < num_frames * 2; i++) {
+        input[i] = (Sint16)(sine_wave_sample(i / 2, 48000, 440, 0) * 32767.0);
+    }
+
+    SDL_zero(result);
+    ret = SDLTest_RunBenchmark("audio_convert_s16_48k_to_f32_44k", convert_benchmark_body, &data, 10, 100, data.input_len, num_frames, &result);
+    SDLTest_AssertCheck(ret == TEST_COMPLETED, "Expected the benchmark to run");
+    SDLTest_AssertCheck(result.iterations == 100 && result.minNS <= result.medianNS && result.medianNS <= result.p99NS,
+                        "Expected ordered statistics, got min %" SDL_PRIu64 ", median %" SDL_PRIu64 ", p99 %" SDL_PRIu64,
+                        result.minNS, result.medianNS, result.p99NS);
+
+    SDL_DestroyAudioStream(data.stream);
+    SDL_free(data.output);
+    SDL_free(input);
+
+    return ret;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1523,13 +2645,58 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_singleProducerStream, "audio_singleProducerStream", "Feed a single producer audio stream from another thread.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_mixThreads, "audio_mixThreads", "Mix many streams on a worker pool.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_mixAudio, "audio_mixAudio", "Check SDL_MixAudio results for F32 and S16.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest22 = {
+    audio_resampleQuality, "audio_resampleQuality", "Check the signal-to-noise ratio of each resampler quality.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest23 = {
+    audio_putAudioStreamDataNoCopy, "audio_putAudioStreamDataNoCopy", "Put caller-owned buffers into an audio stream.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest24 = {
+    audio_deviceCallback, "audio_deviceCallback", "Write a device buffer directly from a callback.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest25 = {
+    audio_instrumentation, "audio_instrumentation", "Check latency and underrun reporting for streams and devices.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest26 = {
+    audio_openWAVStream, "audio_openWAVStream", "Decode WAVE files on demand through an audio stream.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest27 = {
+    audio_planarAndSwizzle, "audio_planarAndSwizzle", "Check planar input and 5.1/7.1 channel map swizzles.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest28 = {
+    audio_queuePool, "audio_queuePool", "Check the memory pool settings of an audio stream's queue.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest29 = {
+    audio_convertBenchmark, "audio_convertBenchmark", "Time audio format conversion and resampling.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTestGetAudioFormatName,
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, &audioTest22,
+    &audioTest23, &audioTest24, &audioTest25, &audioTest26, &audioTest27, &audioTest28, &audioTest29, NULL
 };
 
 /* Audio test suite (global) */
@@ -561,6 +561,63 @@ static int clipboard_testPrimarySelectionTextFunctions(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Streaming reads of clipboard data
+ * \sa SDL_OpenClipboardData
+ */
+static int clipboard_testOpenClipboardData(void *arg)
+{
+    static const Uint8 pattern[] = { 0x00, 0x01, 0x02, 0x03, 0xFE, 0xFF, 0x7F, 0x80, 0x10 };
+    TestClipboardData test_data = {
+        pattern,
+        sizeof(pattern)
+    };
+    Uint8 buffer[sizeof(pattern) + 4];
+    SDL_IOStream *stream;
+    size_t amount;
+    int result;
+
+    result = SDL_SetClipboardData(ClipboardDataCallback, ClipboardCleanupCallback, &test_data, test_mime_types, SDL_arraysize(test_mime_types));
+    SDLTest_AssertPass("Call to SDL_SetClipboardData()");
+    SDLTest_AssertCheck(result == 0, "Validate SDL_SetClipboardData() result, expected 0, got %i", result);
+
+    stream = SDL_OpenClipboardData(test_mime_types[TEST_MIME_TYPE_DATA]);
+    SDLTest_AssertPass("Call to SDL_OpenClipboardData(\"%s\")", test_mime_types[TEST_MIME_TYPE_DATA]);
+    SDLTest_AssertCheck(stream != NULL, "Verify SDL_OpenClipboardData() result, expected !NULL, got %p", (void *)stream);
+    if (stream) {
+        /* Read in two pieces, past the end of the data */
+        amount = SDL_ReadIO(stream, buffer, 3);
+        SDLTest_AssertCheck(amount == 3, "Verify first read size, expected 3, got %u", (unsigned int)amount);
+        amount = SDL_ReadIO(stream, buffer + 3, sizeof(buffer) - 3);
+        SDLTest_AssertCheck(amount == sizeof(pattern) - 3, "Verify second read size, expected %u, got %u", (unsigned int)(sizeof(pattern) - 3), (unsigned int)amount);
+        SDLTest_AssertCheck(SDL_memcmp(buffer, pattern, sizeof(pattern)) == 0, "Verify stream contents");
+        amount = SDL_ReadIO(stream, buffer, sizeof(buffer));
+        SDLTest_AssertCheck(amount == 0, "Verify final read size, expected 0, got %u", (unsigned int)amount);
+        SDLTest_AssertCheck(SDL_GetIOStatus(stream) == SDL_IO_STATUS_EOF, "Verify stream is at end of file");
+        result = SDL_CloseIO(stream);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_CloseIO() result, expected 0, got %i", result);
+    }
+
+    stream = SDL_OpenClipboardData(test_mime_types[TEST_MIME_TYPE_TEXT]);
+    SDLTest_AssertPass("Call to SDL_OpenClipboardData(\"%s\")", test_mime_types[TEST_MIME_TYPE_TEXT]);
+    SDLTest_AssertCheck(stream != NULL, "Verify SDL_OpenClipboardData() result, expected !NULL, got %p", (void *)stream);
+    if (stream) {
+        amount = SDL_ReadIO(stream, buffer, sizeof(buffer));
+        SDLTest_AssertCheck(amount == 4 && SDL_memcmp(buffer, "TEST", 4) == 0, "Verify text contents, expected \"TEST\"");
+        SDL_CloseIO(stream);
+    }
+
+    stream = SDL_OpenClipboardData("test/invalid");
+    SDLTest_AssertPass("Call to SDL_OpenClipboardData(\"test/invalid\")");
+    SDLTest_AssertCheck(stream == NULL, "Verify SDL_OpenClipboardData() result, expected NULL, got %p", (void *)stream);
+
+    result = SDL_ClearClipboardData();
+    SDLTest_AssertPass("Call to SDL_ClearClipboardData()");
+    SDLTest_AssertCheck(result == 0, "Validate SDL_ClearClipboardData() result, expected 0, got %i", result);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 static const SDLTest_TestCaseReference clipboardTest1 = {
@@ -575,9 +632,13 @@ static const SDLTest_TestCaseReference clipboardTest3 = {
     (SDLTest_TestCaseFp)clipboard_testPrimarySelectionTextFunctions, "clipboard_testPrimarySelectionTextFunctions", "End-to-end test of SDL_xyzPrimarySelectionText functions", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference clipboardTest4 = {
+    (SDLTest_TestCaseFp)clipboard_testOpenClipboardData, "clipboard_testOpenClipboardData", "Streaming reads of clipboard data", TEST_ENABLED
+};
+
 /* Sequence of Clipboard test cases */
 static const SDLTest_TestCaseReference *clipboardTests[] = {
-    &clipboardTest1, &clipboardTest2, &clipboardTest3,  NULL
+    &clipboardTest1, &clipboardTest2, &clipboardTest3, &clipboardTest4, NULL
 };
 
 /* Clipboard test suite (global) */
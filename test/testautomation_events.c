@@ -5,6 +5,11 @@
 #include <SDL3/SDL_test.h>
 #include "testautomation_suites.h"
 
+#if defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)
+#include <poll.h>
+#define HAVE_EVENT_WAIT_FD
+#endif
+
 /* ================= Test Case Implementation ================== */
 
 /* Test case functions */
@@ -203,6 +208,310 @@ static int events_addDelEventWatchWithUserdata(void *arg)
     return TEST_COMPLETED;
 }
 
+#define EVENT_PRODUCERS       4
+#define EVENTS_PER_PRODUCER   5000
+
+static int SDLCALL events_producerThread(void *data)
+{
+    const int producer = (int)(intptr_t)data;
+    int i;
+
+    for (i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = producer;
+        event.user.data1 = (void *)(intptr_t)i;
+        while (SDL_PushEvent(&event) <= 0) {
+            SDL_Delay(1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Pushes events from several threads while polling them on this one.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PeepEvents
+ */
+static int events_pushFromThreads(void *arg)
+{
+    SDL_Thread *threads[EVENT_PRODUCERS];
+    int next_expected[EVENT_PRODUCERS];
+    int received = 0;
+    int out_of_order = 0;
+    int i;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < EVENT_PRODUCERS; ++i) {
+        next_expected[i] = 0;
+        threads[i] = SDL_CreateThread(events_producerThread, "EventProducer", (void *)(intptr_t)i);
+        SDLTest_AssertCheck(threads[i] != NULL, "Check SDL_CreateThread(), got: %s", threads[i] ? "thread" : SDL_GetError());
+    }
+
+    while (received < EVENT_PRODUCERS * EVENTS_PER_PRODUCER) {
+        SDL_Event events[16];
+        int count, j;
+
+        /* Mix filtered peeks in with the gets, they share the queue with the producers */
+        if ((received % 7) == 0) {
+            SDL_HasEvent(SDL_EVENT_USER);
+        }
+        count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+        if (count < 0) {
+            SDLTest_AssertCheck(count >= 0, "Check SDL_PeepEvents(), got: %s", SDL_GetError());
+            break;
+        }
+        if (count == 0) {
+            SDL_Delay(0);
+            continue;
+        }
+        for (j = 0; j < count; ++j) {
+            const int producer = events[j].user.code;
+            if (events[j].type != SDL_EVENT_USER || producer < 0 || producer >= EVENT_PRODUCERS) {
+                continue;
+            }
+            if ((int)(intptr_t)events[j].user.data1 != next_expected[producer]) {
+                ++out_of_order;
+            }
+            next_expected[producer] = (int)(intptr_t)events[j].user.data1 + 1;
+            ++received;
+        }
+    }
+
+    for (i = 0; i < EVENT_PRODUCERS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+        SDLTest_AssertCheck(next_expected[i] == EVENTS_PER_PRODUCER, "Check events from producer %d, expected: %d, got: %d", i, EVENTS_PER_PRODUCER, next_expected[i]);
+    }
+    SDLTest_AssertCheck(out_of_order == 0, "Check events from each producer arrive in order, got %d out of order", out_of_order);
+    SDLTest_AssertCheck(!SDL_HasEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST), "Check the queue is empty");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks filtered retrieval across event categories and batched polling.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_FlushEvent
+ * \sa SDL_PollEvents
+ */
+static int events_filterAndPollEvents(void *arg)
+{
+    const Uint32 types[] = { SDL_EVENT_USER, SDL_EVENT_USER + 0x100, SDL_EVENT_USER + 0x1000, SDL_EVENT_USER + 1 };
+    const int num_pushed = 40;
+    SDL_Event events[64];
+    int i, count, last, in_order, polled;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < num_pushed; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = types[i % SDL_arraysize(types)];
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+
+    /* This range spans two event categories, they should still come back in the order they were pushed */
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_PEEKEVENT, SDL_EVENT_USER, SDL_EVENT_USER + 0x100);
+    SDLTest_AssertCheck(count == 30, "Check SDL_PeepEvents(SDL_PEEKEVENT) count, expected: 30, got: %d", count);
+    last = -1;
+    in_order = 1;
+    for (i = 0; i < count; ++i) {
+        if (events[i].user.code <= last || (events[i].user.code % 4) == 2) {
+            in_order = 0;
+        }
+        last = events[i].user.code;
+    }
+    SDLTest_AssertCheck(in_order, "Check peeked events are in range and in order");
+
+    SDLTest_AssertCheck(SDL_HasEvent(types[2]), "Check SDL_HasEvent() returns true");
+    SDL_FlushEvent(types[2]);
+    SDLTest_AssertCheck(!SDL_HasEvent(types[2]), "Check SDL_HasEvent() returns false after SDL_FlushEvent()");
+
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, types[3], types[3]);
+    SDLTest_AssertCheck(count == 10, "Check SDL_PeepEvents(SDL_GETEVENT) count, expected: 10, got: %d", count);
+    in_order = 1;
+    for (i = 0; i < count; ++i) {
+        if (events[i].type != types[3] || events[i].user.code != (i * 4 + 3)) {
+            in_order = 0;
+        }
+    }
+    SDLTest_AssertCheck(in_order, "Check retrieved events are the right type and in order");
+
+    /* What's left comes back from a batched poll in order */
+    polled = 0;
+    last = -1;
+    in_order = 1;
+    while ((count = SDL_PollEvents(events, 7)) > 0) {
+        for (i = 0; i < count; ++i) {
+            if (events[i].type == types[0] || events[i].type == types[1]) {
+                if (events[i].user.code <= last) {
+                    in_order = 0;
+                }
+                last = events[i].user.code;
+                ++polled;
+            }
+        }
+    }
+    SDLTest_AssertCheck(count == 0, "Check SDL_PollEvents() finished with 0, got: %d", count);
+    SDLTest_AssertCheck(polled == 20, "Check SDL_PollEvents() event count, expected: 20, got: %d", polled);
+    SDLTest_AssertCheck(in_order, "Check polled events are in order");
+    SDLTest_AssertCheck(SDL_PollEvents(NULL, 1) < 0, "Check SDL_PollEvents(NULL) fails");
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks that consecutive motion events are merged when requested.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ * \sa SDL_GetMotionHistory
+ */
+static int events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    SDL_Event events[32];
+    int i, count;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "1");
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, \"1\")");
+
+    for (i = 0; i < 15; ++i) {
+        if (i == 10) {
+            SDL_zero(event);
+            event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+            event.button.which = 1;
+            event.button.button = SDL_BUTTON_LEFT;
+            event.button.state = SDL_PRESSED;
+            SDL_PushEvent(&event);
+        }
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.which = 1;
+        event.motion.x = (float)i;
+        event.motion.xrel = 1.0f;
+        event.motion.yrel = -2.0f;
+        SDL_PushEvent(&event);
+    }
+
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(count == 3, "Check merged event count, expected: 3, got: %d", count);
+    if (count == 3) {
+        SDLTest_AssertCheck(events[0].type == SDL_EVENT_MOUSE_MOTION && events[0].motion.x == 9.0f,
+                            "Check first motion event ends at x=9, got: %g", events[0].motion.x);
+        SDLTest_AssertCheck(events[0].motion.xrel == 10.0f && events[0].motion.yrel == -20.0f,
+                            "Check first motion event accumulated 10,-20, got: %g,%g", events[0].motion.xrel, events[0].motion.yrel);
+        SDLTest_AssertCheck(events[1].type == SDL_EVENT_MOUSE_BUTTON_DOWN, "Check the button event stays between the motion");
+        SDLTest_AssertCheck(events[2].type == SDL_EVENT_MOUSE_MOTION && events[2].motion.xrel == 5.0f,
+                            "Check second motion event accumulated 5, got: %g", events[2].motion.xrel);
+    }
+
+    count = SDL_GetMotionHistory(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(count == 15, "Check SDL_GetMotionHistory() count, expected: 15, got: %d", count);
+    for (i = 0; i < count; ++i) {
+        if (events[i].motion.x != (float)i) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == count, "Check the motion history holds every sample in order");
+    SDLTest_AssertCheck(SDL_GetMotionHistory(events, SDL_arraysize(events)) == 0, "Check the motion history is empty after reading it");
+
+    /* Finger motion is merged per finger */
+    for (i = 0; i < 6; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_FINGER_MOTION;
+        event.tfinger.touchID = 1;
+        event.tfinger.fingerID = (i < 4) ? 1 : 2;
+        event.tfinger.x = (float)i;
+        event.tfinger.dx = 0.5f;
+        SDL_PushEvent(&event);
+    }
+
+    count = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(count == 2, "Check merged finger event count, expected: 2, got: %d", count);
+    if (count == 2) {
+        SDLTest_AssertCheck(events[0].tfinger.fingerID == 1 && events[0].tfinger.x == 3.0f && events[0].tfinger.dx == 2.0f,
+                            "Check first finger ends at x=3 having moved 2, got: %g, %g", events[0].tfinger.x, events[0].tfinger.dx);
+        SDLTest_AssertCheck(events[1].tfinger.fingerID == 2 && events[1].tfinger.dx == 1.0f,
+                            "Check second finger moved 1, got: %g", events[1].tfinger.dx);
+    }
+    count = SDL_GetMotionHistory(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(count == 6, "Check SDL_GetMotionHistory() finger count, expected: 6, got: %d", count);
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
+#ifdef HAVE_EVENT_WAIT_FD
+static SDL_bool isReadable(int fd)
+{
+    struct pollfd info;
+
+    info.fd = fd;
+    info.events = POLLIN;
+    info.revents = 0;
+    return (poll(&info, 1, 0) > 0) ? SDL_TRUE : SDL_FALSE;
+}
+#endif
+
+/**
+ * Checks that the event wait handle follows the event queue
+ *
+ * \sa SDL_GetEventWaitProperties
+ */
+static int events_waitHandle(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_Event event;
+
+    props = SDL_GetEventWaitProperties();
+    SDLTest_AssertCheck(props != 0, "Check SDL_GetEventWaitProperties() result, got: %s", props ? "props" : SDL_GetError());
+    if (!props) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_GetEventWaitProperties() == props, "Check SDL_GetEventWaitProperties() returns the same properties again");
+
+#ifdef HAVE_EVENT_WAIT_FD
+    {
+        const int fd = (int)SDL_GetNumberProperty(props, SDL_PROP_EVENT_WAIT_FD_NUMBER, -1);
+        int count = 0;
+
+        SDLTest_AssertCheck(fd >= 0, "Check SDL_PROP_EVENT_WAIT_FD_NUMBER, got: %d", fd);
+
+        while (SDL_PollEvent(&event)) {
+        }
+        SDLTest_AssertCheck(!isReadable(fd), "Check the fd isn't readable with an empty queue");
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        SDL_PushEvent(&event);
+        SDL_PushEvent(&event);
+        SDLTest_AssertCheck(isReadable(fd), "Check the fd is readable after pushing events");
+
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_USER) {
+                ++count;
+            }
+        }
+        SDLTest_AssertCheck(count == 2, "Check both events were polled, got: %d", count);
+        SDLTest_AssertCheck(!isReadable(fd), "Check the fd isn't readable after polling every event");
+    }
+#endif
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -218,11 +527,31 @@ static const SDLTest_TestCaseReference eventsTest_addDelEventWatchWithUserdata =
     events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_pushFromThreads = {
+    events_pushFromThreads, "events_pushFromThreads", "Pushes events from several threads and polls them in order", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_filterAndPollEvents = {
+    events_filterAndPollEvents, "events_filterAndPollEvents", "Retrieves events by type range and in batches", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_coalesceMotion = {
+    events_coalesceMotion, "events_coalesceMotion", "Merges consecutive motion events and keeps their history", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_waitHandle = {
+    events_waitHandle, "events_waitHandle", "Checks that the event wait handle is signaled while events are queued", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
     &eventsTest_pushPumpAndPollUserevent,
     &eventsTest_addDelEventWatch,
     &eventsTest_addDelEventWatchWithUserdata,
+    &eventsTest_pushFromThreads,
+    &eventsTest_filterAndPollEvents,
+    &eventsTest_coalesceMotion,
+    &eventsTest_waitHandle,
     NULL
 };
 
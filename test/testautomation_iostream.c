@@ -361,6 +361,75 @@ static int iostrm_testDynamicMem(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests the allocation behavior of dynamic memory streams.
+ *
+ * \sa SDL_IOFromDynamicMem
+ */
+static int iostrm_testDynamicMemGrowth(void *arg)
+{
+    static const char chunk[] = "0123456789abcdef";
+    SDL_IOStream *rw;
+    SDL_PropertiesID props;
+    void *mem, *last;
+    int i, moves;
+    size_t s;
+
+    /* Reserving up front means the memory never moves while writing */
+    rw = SDL_IOFromDynamicMem();
+    SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_IOFromDynamicMem does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    props = SDL_GetIOProperties(rw);
+    SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_CAPACITY_NUMBER, 64 * 1024);
+    SDL_WriteIO(rw, chunk, 1);
+    last = SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+    moves = 0;
+    for (i = 0; i < 4000; ++i) {
+        SDL_WriteIO(rw, chunk, sizeof(chunk) - 1);
+        mem = SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+        if (mem != last) {
+            ++moves;
+            last = mem;
+        }
+    }
+    SDLTest_AssertCheck(moves == 0, "Verify memory was not reallocated within the reserved capacity, moved %d times", moves);
+    SDL_CloseIO(rw);
+
+    /* Without a reservation, growth is geometric */
+    rw = SDL_IOFromDynamicMem();
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    props = SDL_GetIOProperties(rw);
+    last = NULL;
+    moves = 0;
+    for (i = 0; i < 64 * 1024; ++i) {
+        SDL_WriteIO(rw, chunk, sizeof(chunk) - 1);
+        mem = SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+        if (mem != last) {
+            ++moves;
+            last = mem;
+        }
+    }
+    SDLTest_AssertCheck(moves <= 24, "Verify 1 MB of small writes moved the memory at most 24 times, moved %d times", moves);
+    SDLTest_AssertCheck(SDL_GetIOSize(rw) == 64 * 1024 * (Sint64)(sizeof(chunk) - 1), "Verify stream size after writing");
+
+    /* Take ownership of the memory, which is null terminated */
+    SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDL_WriteIO(rw, "Overwritten", 11);
+    s = (size_t)SDL_GetIOSize(rw);
+    mem = SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+    SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+    SDL_CloseIO(rw);
+    SDLTest_AssertCheck(mem != NULL && SDL_strlen((const char *)mem) == s, "Verify taken memory is null terminated at the stream size");
+    SDLTest_AssertCheck(mem != NULL && SDL_strncmp((const char *)mem, "Overwrittenbcdef0123", 20) == 0, "Verify taken memory contents");
+    SDL_free(mem);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests reading from file.
  *
@@ -393,6 +462,213 @@ static int iostrm_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading from a memory-mapped file.
+ *
+ * \sa SDL_IOFromMappedFile
+ * \sa SDL_CloseIO
+ */
+static int iostrm_testMappedFile(void *arg)
+{
+    SDL_IOStream *rw;
+    SDL_PropertiesID props;
+    const char *mem;
+    Sint64 size;
+    int result;
+
+    rw = SDL_IOFromMappedFile(IOStreamReadTestFilename, SDL_IO_ACCESS_SEQUENTIAL);
+    SDLTest_AssertPass("Call to SDL_IOFromMappedFile(..,SDL_IO_ACCESS_SEQUENTIAL) succeeded");
+    if (rw == NULL) {
+        /* Not every platform can map files */
+        SDLTest_Log("SDL_IOFromMappedFile failed: %s", SDL_GetError());
+        return TEST_SKIPPED;
+    }
+
+    /* The mapping is exposed directly */
+    props = SDL_GetIOProperties(rw);
+    mem = (const char *)SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_MAPPED_MEMORY_POINTER, NULL);
+    size = SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_MAPPED_SIZE_NUMBER, -1);
+    SDLTest_AssertCheck(size == (Sint64)SDL_strlen(IOStreamHelloWorldTestString), "Verify mapped size, expected %i, got %" SDL_PRIs64, (int)SDL_strlen(IOStreamHelloWorldTestString), size);
+    SDLTest_AssertCheck(mem != NULL && SDL_memcmp(mem, IOStreamHelloWorldTestString, (size_t)size) == 0, "Verify mapped memory matches file contents");
+    SDLTest_AssertCheck(SDL_GetIOSize(rw) == size, "Verify SDL_GetIOSize matches mapped size");
+
+    /* Run generic tests; the mapping is read-only */
+    testGenericIOStreamValidations(rw, SDL_FALSE);
+
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Missing files fail cleanly */
+    rw = SDL_IOFromMappedFile("nonexistent", SDL_IO_ACCESS_RANDOM);
+    SDLTest_AssertCheck(rw == NULL, "Verify mapping a nonexistent file returns NULL");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests buffering another stream.
+ *
+ * \sa SDL_IOFromBuffered
+ * \sa SDL_CloseIO
+ */
+static int iostrm_testBuffered(void *arg)
+{
+    SDL_IOStream *src;
+    SDL_IOStream *rw;
+    char buf[sizeof(IOStreamHelloWorldTestString)];
+    Uint8 u8 = 0;
+    Uint16 u16 = 0;
+    Uint32 u32 = 0;
+    Uint64 u64 = 0;
+    Sint64 i;
+    size_t s;
+    int result;
+
+    /* A buffer smaller than the test string exercises refills and flushes */
+    src = SDL_IOFromDynamicMem();
+    SDLTest_AssertCheck(src != NULL, "Verify opening memory with SDL_IOFromDynamicMem does not return NULL");
+    rw = SDL_IOFromBuffered(src, 5, SDL_TRUE);
+    SDLTest_AssertPass("Call to SDL_IOFromBuffered(src, 5, SDL_TRUE) succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_IOFromBuffered does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    testGenericIOStreamValidations(rw, SDL_TRUE);
+
+    /* Typed values go through the inline path and across buffer boundaries */
+    SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(SDL_WriteU8(rw, 0x12), "Verify SDL_WriteU8");
+    SDLTest_AssertCheck(SDL_WriteU16LE(rw, 0x3456), "Verify SDL_WriteU16LE");
+    SDLTest_AssertCheck(SDL_WriteU32BE(rw, 0x789abcde), "Verify SDL_WriteU32BE");
+    SDLTest_AssertCheck(SDL_WriteU64LE(rw, 0x0123456789abcdefULL), "Verify SDL_WriteU64LE");
+    i = SDL_TellIO(rw);
+    SDLTest_AssertCheck(i == 15, "Verify position after typed writes, expected 15, got %" SDL_PRIs64, i);
+    i = SDL_GetIOSize(rw);
+    SDLTest_AssertCheck(i == 15, "Verify size after typed writes, expected 15, got %" SDL_PRIs64, i);
+
+    SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8) && u8 == 0x12, "Verify SDL_ReadU8, got 0x%x", u8);
+    SDLTest_AssertCheck(SDL_ReadU16LE(rw, &u16) && u16 == 0x3456, "Verify SDL_ReadU16LE, got 0x%x", u16);
+    SDLTest_AssertCheck(SDL_ReadU32BE(rw, &u32) && u32 == 0x789abcde, "Verify SDL_ReadU32BE, got 0x%x", u32);
+    SDLTest_AssertCheck(SDL_ReadU64LE(rw, &u64) && u64 == 0x0123456789abcdefULL, "Verify SDL_ReadU64LE, got 0x%" SDL_PRIx64, u64);
+    SDLTest_AssertCheck(!SDL_ReadU8(rw, &u8), "Verify SDL_ReadU8 fails at the end of the stream");
+    SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_EOF, "Verify stream status is SDL_IO_STATUS_EOF");
+
+    /* A write after a partial read lands where the application left off */
+    SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8), "Verify SDL_ReadU8");
+    SDLTest_AssertCheck(SDL_WriteU16BE(rw, 0xaabb), "Verify SDL_WriteU16BE");
+    SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(SDL_ReadU32BE(rw, &u32) && u32 == 0x12aabb78, "Verify mixed read and write, expected 0x12aabb78, got 0x%x", u32);
+
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Read-only sources stay read-only, and the source is left where reading stopped */
+    src = SDL_IOFromConstMem(IOStreamHelloWorldCompString, sizeof(IOStreamHelloWorldCompString) - 1);
+    rw = SDL_IOFromBuffered(src, 0, SDL_FALSE);
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_IOFromBuffered(src, 0, SDL_FALSE) does not return NULL");
+    if (rw == NULL) {
+        SDL_CloseIO(src);
+        return TEST_ABORTED;
+    }
+    testGenericIOStreamValidations(rw, SDL_FALSE);
+
+    SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+    SDL_zeroa(buf);
+    s = SDL_ReadIO(rw, buf, 3);
+    SDLTest_AssertCheck(s == 3 && SDL_memcmp(buf, "Hel", 3) == 0, "Verify reading 3 bytes, got '%s'", buf);
+    i = SDL_SeekIO(rw, -2, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(i == 1, "Verify seeking back inside the buffer, expected 1, got %" SDL_PRIs64, i);
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+    i = SDL_TellIO(src);
+    SDLTest_AssertCheck(i == 1, "Verify source position after closing, expected 1, got %" SDL_PRIs64, i);
+    SDL_CloseIO(src);
+
+    /* Invalid parameters */
+    rw = SDL_IOFromBuffered(NULL, 0, SDL_FALSE);
+    SDLTest_AssertCheck(rw == NULL, "Verify SDL_IOFromBuffered(NULL, ...) returns NULL");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests vectored reads and writes, native and emulated.
+ *
+ * \sa SDL_ReadIOV
+ * \sa SDL_WriteIOV
+ */
+static int iostrm_testVectored(void *arg)
+{
+    SDL_IOStream *streams[3];
+    char header[6], body[7], tail[8];
+    SDL_IOVec vecs[3];
+    size_t s;
+    int i;
+
+    /* Dynamic memory has its own writev, buffered streams gather, and
+       constant memory falls back to reading one buffer at a time */
+    streams[0] = SDL_IOFromDynamicMem();
+    streams[1] = SDL_IOFromBuffered(SDL_IOFromDynamicMem(), 4, SDL_TRUE);
+    streams[2] = SDL_IOFromConstMem(IOStreamHelloWorldCompString, sizeof(IOStreamHelloWorldCompString) - 1);
+
+    for (i = 0; i < SDL_arraysize(streams); ++i) {
+        SDL_IOStream *rw = streams[i];
+        SDLTest_AssertCheck(rw != NULL, "Verify stream %d was created", i);
+        if (rw == NULL) {
+            continue;
+        }
+
+        if (i < 2) {
+            vecs[0].ptr = (void *)"Hello";
+            vecs[0].size = 5;
+            vecs[1].ptr = NULL;
+            vecs[1].size = 0;
+            vecs[2].ptr = (void *)" World!";
+            vecs[2].size = 7;
+            s = SDL_WriteIOV(rw, vecs, 3);
+            SDLTest_AssertCheck(s == 12, "Verify SDL_WriteIOV on stream %d, expected 12, got %d", i, (int)s);
+            SDLTest_AssertCheck(SDL_TellIO(rw) == 12, "Verify position after SDL_WriteIOV on stream %d", i);
+            SDL_SeekIO(rw, 0, SDL_IO_SEEK_SET);
+        } else {
+            s = SDL_WriteIOV(rw, vecs, 3);
+            SDLTest_AssertCheck(s == 0, "Verify SDL_WriteIOV on read-only stream, expected 0, got %d", (int)s);
+        }
+
+        SDL_zeroa(header);
+        SDL_zeroa(body);
+        SDL_zeroa(tail);
+        vecs[0].ptr = header;
+        vecs[0].size = sizeof(header) - 1;
+        vecs[1].ptr = body;
+        vecs[1].size = sizeof(body) - 1;
+        vecs[2].ptr = tail;
+        vecs[2].size = sizeof(tail) - 1;
+        s = SDL_ReadIOV(rw, vecs, 3);
+        SDLTest_AssertCheck(s == 12, "Verify short SDL_ReadIOV on stream %d, expected 12, got %d", i, (int)s);
+        SDLTest_AssertCheck(SDL_strcmp(header, "Hello") == 0 && SDL_strcmp(body, " World") == 0 && SDL_strcmp(tail, "!") == 0,
+                            "Verify SDL_ReadIOV contents on stream %d, got '%s' '%s' '%s'", i, header, body, tail);
+
+        s = SDL_ReadIOV(rw, vecs, 3);
+        SDLTest_AssertCheck(s == 0, "Verify SDL_ReadIOV at end of stream %d, expected 0, got %d", i, (int)s);
+        SDLTest_AssertCheck(SDL_GetIOStatus(rw) == SDL_IO_STATUS_EOF, "Verify stream %d status is SDL_IO_STATUS_EOF", i);
+
+        SDL_CloseIO(rw);
+    }
+
+    /* Invalid parameters */
+    s = SDL_ReadIOV(NULL, vecs, 1);
+    SDLTest_AssertCheck(s == 0, "Verify SDL_ReadIOV(NULL, ...) returns 0");
+    s = SDL_WriteIOV(NULL, vecs, 1);
+    SDLTest_AssertCheck(s == 0, "Verify SDL_WriteIOV(NULL, ...) returns 0");
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -686,10 +962,27 @@ static const SDLTest_TestCaseReference iostrmTest9 = {
     (SDLTest_TestCaseFp)iostrm_testCompareRWFromMemWithRWFromFile, "iostrm_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile IOStream for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference iostrmTest10 = {
+    (SDLTest_TestCaseFp)iostrm_testMappedFile, "iostrm_testMappedFile", "Tests reading from a memory-mapped file", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest11 = {
+    (SDLTest_TestCaseFp)iostrm_testBuffered, "iostrm_testBuffered", "Tests buffering another stream", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest12 = {
+    (SDLTest_TestCaseFp)iostrm_testVectored, "iostrm_testVectored", "Tests vectored reads and writes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest13 = {
+    (SDLTest_TestCaseFp)iostrm_testDynamicMemGrowth, "iostrm_testDynamicMemGrowth", "Tests allocation behavior of dynamic memory", TEST_ENABLED
+};
+
 /* Sequence of IOStream test cases */
 static const SDLTest_TestCaseReference *iostrmTests[] = {
     &iostrmTest1, &iostrmTest2, &iostrmTest3, &iostrmTest4, &iostrmTest5, &iostrmTest6,
-    &iostrmTest7, &iostrmTest8, &iostrmTest9, NULL
+    &iostrmTest7, &iostrmTest8, &iostrmTest9, &iostrmTest10, &iostrmTest11, &iostrmTest12,
+    &iostrmTest13, NULL
 };
 
 /* IOStream test suite (global) */
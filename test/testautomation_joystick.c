@@ -61,6 +61,38 @@ static int TestVirtualJoystick(void *arg)
             SDL_UpdateJoysticks();
             SDLTest_AssertCheck(SDL_GetJoystickButton(joystick, SDL_GAMEPAD_BUTTON_SOUTH) == SDL_RELEASED, "SDL_GetJoystickButton(SDL_GAMEPAD_BUTTON_SOUTH) == SDL_RELEASED");
 
+            {
+                Sint16 axes[SDL_GAMEPAD_AXIS_MAX];
+                Uint8 buttons[SDL_GAMEPAD_BUTTON_MAX];
+                SDL_JoystickSnapshot snapshot;
+
+                SDL_zero(snapshot);
+                snapshot.axes = axes;
+                snapshot.num_axes = SDL_arraysize(axes);
+                snapshot.buttons = buttons;
+                snapshot.num_buttons = SDL_arraysize(buttons);
+
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualAxis(joystick, SDL_GAMEPAD_AXIS_LEFTX, 1000) == 0, "SDL_SetJoystickVirtualAxis(SDL_GAMEPAD_AXIS_LEFTX, 1000)");
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualButton(joystick, SDL_GAMEPAD_BUTTON_EAST, SDL_PRESSED) == 0, "SDL_SetJoystickVirtualButton(SDL_GAMEPAD_BUTTON_EAST, SDL_PRESSED)");
+                SDL_UpdateJoysticks();
+                SDLTest_AssertCheck(SDL_GetJoystickSnapshot(joystick, &snapshot) == 0, "SDL_GetJoystickSnapshot()");
+                SDLTest_AssertCheck(snapshot.num_axes == desc.naxes, "snapshot.num_axes == %d, got %d", desc.naxes, snapshot.num_axes);
+                SDLTest_AssertCheck(snapshot.num_buttons == desc.nbuttons, "snapshot.num_buttons == %d, got %d", desc.nbuttons, snapshot.num_buttons);
+                SDLTest_AssertCheck(snapshot.num_hats == 0 && snapshot.num_touchpad_fingers == 0 && snapshot.num_sensors == 0, "NULL snapshot arrays are skipped");
+                SDLTest_AssertCheck(axes[SDL_GAMEPAD_AXIS_LEFTX] == 1000, "snapshot axes[SDL_GAMEPAD_AXIS_LEFTX] == 1000");
+                SDLTest_AssertCheck(buttons[SDL_GAMEPAD_BUTTON_EAST] == SDL_PRESSED, "snapshot buttons[SDL_GAMEPAD_BUTTON_EAST] == SDL_PRESSED");
+
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualButton(joystick, SDL_GAMEPAD_BUTTON_EAST, SDL_RELEASED) == 0, "SDL_SetJoystickVirtualButton(SDL_GAMEPAD_BUTTON_EAST, SDL_RELEASED)");
+                SDL_UpdateJoysticks();
+                snapshot.num_axes = SDL_arraysize(axes);
+                snapshot.num_buttons = SDL_arraysize(buttons);
+                SDLTest_AssertCheck(SDL_GetJoystickSnapshot(joystick, &snapshot) == 0, "SDL_GetJoystickSnapshot()");
+                SDLTest_AssertCheck(buttons[SDL_GAMEPAD_BUTTON_EAST] == SDL_RELEASED, "snapshot buttons[SDL_GAMEPAD_BUTTON_EAST] == SDL_RELEASED");
+
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualAxis(joystick, SDL_GAMEPAD_AXIS_LEFTX, 0) == 0, "SDL_SetJoystickVirtualAxis(SDL_GAMEPAD_AXIS_LEFTX, 0)");
+                SDL_UpdateJoysticks();
+            }
+
             gamepad = SDL_OpenGamepad(SDL_GetJoystickID(joystick));
             SDLTest_AssertCheck(gamepad != NULL, "SDL_OpenGamepad() succeeded");
             if (gamepad) {
@@ -130,6 +162,71 @@ static int TestVirtualJoystick(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Check batched reads of virtual gamepad sensor data
+ *
+ * \sa SDL_GetGamepadSensorDataBatch
+ */
+static int TestVirtualGamepadSensorBatch(void *arg)
+{
+    SDL_VirtualJoystickDesc desc;
+    SDL_VirtualJoystickSensorDesc sensor_desc;
+    SDL_JoystickID device_id;
+    SDL_Gamepad *gamepad;
+    SDL_GamepadSensorSample samples[8];
+    int i, count;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_GAMEPAD) == 0, "SDL_InitSubSystem(SDL_INIT_GAMEPAD)");
+
+    SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
+
+    SDL_zero(sensor_desc);
+    sensor_desc.type = SDL_SENSOR_GYRO;
+    sensor_desc.rate = 1000.0f;
+
+    SDL_zero(desc);
+    desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+    desc.naxes = SDL_GAMEPAD_AXIS_MAX;
+    desc.nbuttons = SDL_GAMEPAD_BUTTON_MAX;
+    desc.nsensors = 1;
+    desc.sensors = &sensor_desc;
+    desc.name = "Virtual Sensor Gamepad";
+    device_id = SDL_AttachVirtualJoystick(&desc);
+    SDLTest_AssertCheck(device_id > 0, "SDL_AttachVirtualJoystick()");
+    if (device_id > 0) {
+        gamepad = SDL_OpenGamepad(device_id);
+        SDLTest_AssertCheck(gamepad != NULL, "SDL_OpenGamepad()");
+        if (gamepad) {
+            SDLTest_AssertCheck(SDL_SetGamepadSensorEnabled(gamepad, SDL_SENSOR_GYRO, SDL_TRUE) == 0, "SDL_SetGamepadSensorEnabled(SDL_SENSOR_GYRO)");
+            SDLTest_AssertCheck(SDL_GetGamepadSensorDataBatch(gamepad, SDL_SENSOR_ACCEL, samples, SDL_arraysize(samples)) < 0, "SDL_GetGamepadSensorDataBatch(SDL_SENSOR_ACCEL) fails");
+            count = SDL_GetGamepadSensorDataBatch(gamepad, SDL_SENSOR_GYRO, samples, SDL_arraysize(samples));
+            SDLTest_AssertCheck(count == 0, "First SDL_GetGamepadSensorDataBatch() returns 0 samples, got %d", count);
+
+            for (i = 0; i < 3; ++i) {
+                const float data[3] = { (float)i, 0.0f, 0.0f };
+                SDLTest_AssertCheck(SDL_SendJoystickVirtualSensorData(SDL_GetGamepadJoystick(gamepad), SDL_SENSOR_GYRO, i + 1, data, SDL_arraysize(data)) == 0, "SDL_SendJoystickVirtualSensorData()");
+            }
+            SDL_UpdateJoysticks();
+
+            count = SDL_GetGamepadSensorDataBatch(gamepad, SDL_SENSOR_GYRO, samples, 2);
+            SDLTest_AssertCheck(count == 2, "SDL_GetGamepadSensorDataBatch() returns 2 samples, got %d", count);
+            SDLTest_AssertCheck(count == 2 && samples[0].sensor_timestamp == 1 && samples[1].sensor_timestamp == 2, "Samples are returned oldest first");
+            count = SDL_GetGamepadSensorDataBatch(gamepad, SDL_SENSOR_GYRO, samples, SDL_arraysize(samples));
+            SDLTest_AssertCheck(count == 1, "SDL_GetGamepadSensorDataBatch() returns the remaining sample, got %d", count);
+            SDLTest_AssertCheck(count == 1 && samples[0].data[0] == 2.0f, "The remaining sample has the last value");
+
+            SDL_CloseGamepad(gamepad);
+        }
+        SDLTest_AssertCheck(SDL_DetachVirtualJoystick(device_id) == 0, "SDL_DetachVirtualJoystick()");
+    }
+
+    SDL_ResetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS);
+
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Joystick routine test cases */
@@ -138,8 +235,13 @@ static const SDLTest_TestCaseReference joystickTest1 = {
 };
 
 /* Sequence of Joystick routine test cases */
+static const SDLTest_TestCaseReference joystickTest2 = {
+    (SDLTest_TestCaseFp)TestVirtualGamepadSensorBatch, "TestVirtualGamepadSensorBatch", "Test batched gamepad sensor reads", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference *joystickTests[] = {
     &joystickTest1,
+    &joystickTest2,
     NULL
 };
 
@@ -188,6 +188,43 @@ static int log_testHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Check asynchronous logging
+ */
+static int log_testAsync(void *arg)
+{
+    int count, flushed_count;
+    int enable_result, disable_result;
+    int i;
+
+    SDL_SetHint(SDL_HINT_LOGGING, NULL);
+    SDLTest_AssertPass("SDL_SetHint(SDL_HINT_LOGGING, NULL)");
+
+    /* The test harness logs its own output, so only check results after restoring the log function */
+    EnableTestLog(&count);
+    enable_result = SDL_SetLogAsync(SDL_TRUE);
+    for (i = 0; i < 10; ++i) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "test %d", i);
+    }
+    SDL_FlushLog();
+    flushed_count = count;
+
+    for (i = 0; i < 100; ++i) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "test %d", i);
+    }
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, "test");
+    disable_result = SDL_SetLogAsync(SDL_FALSE);
+    DisableTestLog();
+
+    SDLTest_AssertCheck(enable_result == 0, "SDL_SetLogAsync(SDL_TRUE), expected: 0, got: %d", enable_result);
+    SDLTest_AssertCheck(flushed_count == 10, "Check result value after SDL_FlushLog(), expected: 10, got: %d", flushed_count);
+    SDLTest_AssertCheck(disable_result == 0, "SDL_SetLogAsync(SDL_FALSE), expected: 0, got: %d", disable_result);
+    SDLTest_AssertCheck(count == 110, "Check result value after disabling, expected: 110, got: %d", count);
+    SDLTest_AssertCheck(SDL_GetLogDroppedCount() == 0, "Check dropped messages, expected: 0, got: %d", SDL_GetLogDroppedCount());
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Log test cases */
@@ -195,9 +232,13 @@ static const SDLTest_TestCaseReference logTestHint = {
     (SDLTest_TestCaseFp)log_testHint, "log_testHint", "Check SDL_HINT_LOGGING functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference logTestAsync = {
+    (SDLTest_TestCaseFp)log_testAsync, "log_testAsync", "Check asynchronous logging", TEST_ENABLED
+};
+
 /* Sequence of Log test cases */
 static const SDLTest_TestCaseReference *logTests[] = {
-    &logTestHint, NULL
+    &logTestHint, &logTestAsync, NULL
 };
 
 /* Timer test suite (global) */
@@ -176,6 +176,15 @@ SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_NV12_FORMAT, SDL_PIXELFORMAT_NV12 == SDL
 SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_NV21_FORMAT, SDL_PIXELFORMAT_NV21 == SDL_DEFINE_PIXELFOURCC('N', 'V', '2', '1'));
 SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_P010_FORMAT, SDL_PIXELFORMAT_P010 == SDL_DEFINE_PIXELFOURCC('P', '0', '1', '0'));
 SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_EXTERNAL_OES_FORMAT, SDL_PIXELFORMAT_EXTERNAL_OES == SDL_DEFINE_PIXELFOURCC('O', 'E', 'S', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_BC1_FORMAT, SDL_PIXELFORMAT_BC1 == SDL_DEFINE_PIXELFOURCC('B', 'C', '1', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_BC2_FORMAT, SDL_PIXELFORMAT_BC2 == SDL_DEFINE_PIXELFOURCC('B', 'C', '2', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_BC3_FORMAT, SDL_PIXELFORMAT_BC3 == SDL_DEFINE_PIXELFOURCC('B', 'C', '3', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_BC4_FORMAT, SDL_PIXELFORMAT_BC4 == SDL_DEFINE_PIXELFOURCC('B', 'C', '4', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_BC5_FORMAT, SDL_PIXELFORMAT_BC5 == SDL_DEFINE_PIXELFOURCC('B', 'C', '5', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_BC7_FORMAT, SDL_PIXELFORMAT_BC7 == SDL_DEFINE_PIXELFOURCC('B', 'C', '7', ' '));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_ETC2_RGB8_FORMAT, SDL_PIXELFORMAT_ETC2_RGB8 == SDL_DEFINE_PIXELFOURCC('E', 'T', 'C', '2'));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_ETC2_RGBA8_FORMAT, SDL_PIXELFORMAT_ETC2_RGBA8 == SDL_DEFINE_PIXELFOURCC('E', 'T', '2', 'A'));
+SDL_COMPILE_TIME_ASSERT(SDL_PIXELFORMAT_ASTC_4X4_FORMAT, SDL_PIXELFORMAT_ASTC_4X4 == SDL_DEFINE_PIXELFOURCC('A', 'S', '4', '4'));
 
 /* Verify the colorspaces are laid out as expected */
 SDL_COMPILE_TIME_ASSERT(SDL_COLORSPACE_SRGB_FORMAT, SDL_COLORSPACE_SRGB ==
@@ -496,6 +505,255 @@ static int pixels_allocFreePalette(void *arg)
     return TEST_COMPLETED;
 }
 
+/* The nearest color search that SDL_MapRGBA() is documented to do for palettes */
+static Uint8 pixels_findColorLinear(const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    unsigned int smallest = ~0U;
+    Uint8 pixel = 0;
+    int i;
+
+    for (i = 0; i < palette->ncolors; ++i) {
+        int rd = palette->colors[i].r - r;
+        int gd = palette->colors[i].g - g;
+        int bd = palette->colors[i].b - b;
+        int ad = palette->colors[i].a - a;
+        unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+            pixel = (Uint8)i;
+            smallest = distance;
+        }
+    }
+    return pixel;
+}
+
+/**
+ * Call to SDL_MapRGB for an indexed format, checking against a linear search
+ *
+ * \sa SDL_MapRGB
+ * \sa SDL_SetPaletteColors
+ */
+static int pixels_mapRGBPalette(void *arg)
+{
+    const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_INDEX8);
+    SDL_Palette *palette;
+    SDL_Color colors[256];
+    int i, pass, mismatches;
+
+    palette = SDL_CreatePalette(SDL_arraysize(colors));
+    SDLTest_AssertCheck(palette != NULL, "Verify SDL_CreatePalette() result is not NULL");
+    if (!palette) {
+        return TEST_ABORTED;
+    }
+
+    /* The second pass changes the palette after the first pass has looked up colors in it */
+    for (pass = 0; pass < 2; ++pass) {
+        for (i = 0; i < SDL_arraysize(colors); ++i) {
+            colors[i].r = SDLTest_RandomUint8();
+            colors[i].g = SDLTest_RandomUint8();
+            colors[i].b = SDLTest_RandomUint8();
+            colors[i].a = (i % 8) ? SDL_ALPHA_OPAQUE : SDLTest_RandomUint8();
+        }
+        /* Duplicate entries must map to the first one */
+        colors[200] = colors[100];
+        SDL_SetPaletteColors(palette, colors, 0, SDL_arraysize(colors));
+
+        mismatches = 0;
+        for (i = 0; i < 10000; ++i) {
+            Uint8 r = SDLTest_RandomUint8();
+            Uint8 g = SDLTest_RandomUint8();
+            Uint8 b = SDLTest_RandomUint8();
+            Uint8 a = (i % 4) ? SDL_ALPHA_OPAQUE : SDLTest_RandomUint8();
+            Uint32 expected = pixels_findColorLinear(palette, r, g, b, a);
+            Uint32 actual = SDL_MapRGBA(details, palette, r, g, b, a);
+            if (actual != expected) {
+                if (mismatches++ == 0) {
+                    SDLTest_AssertCheck(SDL_FALSE, "Color %d,%d,%d,%d: expected index %" SDL_PRIu32 ", got %" SDL_PRIu32, r, g, b, a, expected, actual);
+                }
+            }
+        }
+        for (i = 0; i < SDL_arraysize(colors); ++i) {
+            Uint32 expected = pixels_findColorLinear(palette, colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+            Uint32 actual = SDL_MapRGBA(details, palette, colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+            if (actual != expected) {
+                ++mismatches;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Pass %d: %d colors mapped differently than a linear search", pass, mismatches);
+        SDLTest_AssertCheck(SDL_MapRGB(details, palette, colors[200].r, colors[200].g, colors[200].b) == 100,
+                            "Verify a duplicate color maps to its first entry");
+    }
+
+    SDL_DestroyPalette(palette);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Call to SDL_ConvertPixelsAndColorspace with wide YUV images
+ *
+ * The SIMD paths and the threaded conversion must produce the same pixels
+ * as narrow conversions, which only use the scalar code.
+ */
+static int pixels_convertYUVToRGB(void *arg)
+{
+    const struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_Colorspace src_colorspace;
+        SDL_PixelFormat dst_format;
+        SDL_Colorspace dst_colorspace;
+        int dst_bpp;
+    } cases[] = {
+        { SDL_PIXELFORMAT_NV12, SDL_COLORSPACE_BT709_LIMITED, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 4 },
+        { SDL_PIXELFORMAT_NV12, SDL_COLORSPACE_JPEG, SDL_PIXELFORMAT_ABGR8888, SDL_COLORSPACE_SRGB, 4 },
+        { SDL_PIXELFORMAT_NV21, SDL_COLORSPACE_BT709_LIMITED, SDL_PIXELFORMAT_RGBA8888, SDL_COLORSPACE_SRGB, 4 },
+        { SDL_PIXELFORMAT_NV21, SDL_COLORSPACE_JPEG, SDL_PIXELFORMAT_BGRX8888, SDL_COLORSPACE_SRGB, 4 },
+        { SDL_PIXELFORMAT_P010, SDL_COLORSPACE_BT2020_FULL, SDL_PIXELFORMAT_XBGR2101010, SDL_COLORSPACE_HDR10, 4 },
+        { SDL_PIXELFORMAT_P010, SDL_COLORSPACE_BT2020_FULL, SDL_PIXELFORMAT_RGBA64, SDL_COLORSPACE_HDR10, 8 },
+        { SDL_PIXELFORMAT_P010, SDL_COLORSPACE_BT2020_FULL, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_HDR10, 16 },
+        { SDL_PIXELFORMAT_IYUV, SDL_COLORSPACE_BT709_LIMITED, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 4 },
+        { SDL_PIXELFORMAT_YV12, SDL_COLORSPACE_JPEG, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 4 },
+    };
+    const int w = 517, h = 131;
+    const int src_pitch = 1040; /* room for w P010 pixels */
+    const size_t src_size = (size_t)src_pitch * (h + (h + 1) / 2);
+    Uint8 *src = (Uint8 *)SDL_malloc(src_size);
+    Uint8 *dst1 = (Uint8 *)SDL_malloc((size_t)w * h * 16);
+    Uint8 *dst2 = (Uint8 *)SDL_malloc((size_t)w * h * 16);
+    int i, x, ret;
+
+    SDLTest_AssertCheck(src && dst1 && dst2, "Verify buffers were allocated");
+    if (!src || !dst1 || !dst2) {
+        SDL_free(src);
+        SDL_free(dst1);
+        SDL_free(dst2);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        const SDL_PixelFormat src_format = cases[i].src_format;
+        const SDL_PixelFormat dst_format = cases[i].dst_format;
+        const int dst_pitch = w * cases[i].dst_bpp;
+        size_t offset;
+
+        /* Fill the planes with limited range values, the luma rows come first */
+        if (src_format == SDL_PIXELFORMAT_P010) {
+            for (offset = 0; offset < src_size; offset += 2) {
+                Uint16 value = (Uint16)((64 + SDLTest_RandomIntegerInRange(0, 876)) << 6);
+                SDL_memcpy(&src[offset], &value, sizeof(value));
+            }
+        } else {
+            /* Keep the chroma near grey so the scalar code doesn't clip out of gamut colors differently */
+            for (offset = 0; offset < src_size; ++offset) {
+                if (offset < (size_t)src_pitch * h) {
+                    src[offset] = (Uint8)SDLTest_RandomIntegerInRange(16, 235);
+                } else {
+                    src[offset] = (Uint8)SDLTest_RandomIntegerInRange(80, 176);
+                }
+            }
+        }
+
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+        ret = SDL_ConvertPixelsAndColorspace(w, h, src_format, cases[i].src_colorspace, 0, src, src_pitch, dst_format, cases[i].dst_colorspace, 0, dst1, dst_pitch);
+        SDLTest_AssertCheck(ret == 0, "Convert %s to %s, expected 0, got %d", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), ret);
+
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "4");
+        ret = SDL_ConvertPixelsAndColorspace(w, h, src_format, cases[i].src_colorspace, 0, src, src_pitch, dst_format, cases[i].dst_colorspace, 0, dst2, dst_pitch);
+        SDLTest_AssertCheck(ret == 0, "Convert %s to %s with threads, expected 0, got %d", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), ret);
+        SDLTest_AssertCheck(SDL_memcmp(dst1, dst2, (size_t)dst_pitch * h) == 0, "Verify threaded %s to %s conversion matches", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format));
+
+        if (src_format == SDL_PIXELFORMAT_IYUV || src_format == SDL_PIXELFORMAT_YV12) {
+            /* The chroma planes can't be offset along with the luma plane */
+            continue;
+        }
+
+        /* Convert two pixel wide columns, the chroma plane is offset along with the luma plane */
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+        for (x = 0; x < w; x += 2) {
+            const int bytes_per_sample = (src_format == SDL_PIXELFORMAT_P010) ? 2 : 1;
+            ret = SDL_ConvertPixelsAndColorspace(SDL_min(2, w - x), h, src_format, cases[i].src_colorspace, 0, src + x * bytes_per_sample, src_pitch, dst_format, cases[i].dst_colorspace, 0, dst2 + x * cases[i].dst_bpp, dst_pitch);
+            if (ret < 0) {
+                break;
+            }
+        }
+        SDLTest_AssertCheck(ret == 0, "Convert %s to %s in columns, expected 0, got %d", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format), ret);
+        SDLTest_AssertCheck(SDL_memcmp(dst1, dst2, (size_t)dst_pitch * h) == 0, "Verify wide %s to %s conversion matches narrow conversion", SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format));
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    SDL_free(src);
+    SDL_free(dst1);
+    SDL_free(dst2);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that SDL_MapRGBAArray and SDL_GetRGBAArray match SDL_MapRGBA and SDL_GetRGBA
+ */
+static int pixels_mapRGBAArray(void *arg)
+{
+    SDL_Color colors[37], result[37];
+    Uint8 pixels[37 * 4], expected[4];
+    SDL_Palette *palette;
+    int i, j, bpp;
+    int failures;
+
+    palette = SDL_CreatePalette(256);
+    SDLTest_AssertCheck(palette != NULL, "Verify palette is not NULL");
+    if (!palette) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < palette->ncolors; i++) {
+        palette->colors[i].r = (Uint8)(i * 7);
+        palette->colors[i].g = (Uint8)(i * 13);
+        palette->colors[i].b = (Uint8)(i * 29);
+        palette->colors[i].a = (Uint8)i;
+    }
+    for (i = 0; i < SDL_arraysize(colors); i++) {
+        colors[i].r = (Uint8)SDLTest_RandomUint8();
+        colors[i].g = (Uint8)SDLTest_RandomUint8();
+        colors[i].b = (Uint8)SDLTest_RandomUint8();
+        colors[i].a = (Uint8)SDLTest_RandomUint8();
+    }
+
+    for (i = 0; i < g_numAllFormats; i++) {
+        const SDL_PixelFormatDetails *format = SDL_GetPixelFormatDetails(g_AllFormats[i]);
+        if (!format || format->bytes_per_pixel > 4 || SDL_ISPIXELFORMAT_FOURCC(format->format)) {
+            continue;
+        }
+        bpp = format->bytes_per_pixel;
+
+        SDL_MapRGBAArray(format, palette, colors, pixels, SDL_arraysize(colors));
+        failures = 0;
+        for (j = 0; j < SDL_arraysize(colors); j++) {
+            Uint32 pixel = SDL_MapRGBA(format, palette, colors[j].r, colors[j].g, colors[j].b, colors[j].a);
+            SDL_memcpy(expected, (Uint8 *)&pixel + ((SDL_BYTEORDER == SDL_BIG_ENDIAN) ? (4 - bpp) : 0), bpp);
+            if (SDL_memcmp(&pixels[j * bpp], expected, bpp) != 0) {
+                ++failures;
+            }
+        }
+        SDLTest_AssertCheck(failures == 0, "Check SDL_MapRGBAArray matches SDL_MapRGBA for %s, %d failures", g_AllFormatsVerbose[i], failures);
+
+        SDL_GetRGBAArray(pixels, format, palette, result, SDL_arraysize(colors));
+        failures = 0;
+        for (j = 0; j < SDL_arraysize(colors); j++) {
+            Uint32 pixel = 0;
+            SDL_Color color;
+            SDL_memcpy((Uint8 *)&pixel + ((SDL_BYTEORDER == SDL_BIG_ENDIAN) ? (4 - bpp) : 0), &pixels[j * bpp], bpp);
+            SDL_GetRGBA(pixel, format, palette, &color.r, &color.g, &color.b, &color.a);
+            if (SDL_memcmp(&result[j], &color, sizeof(color)) != 0) {
+                ++failures;
+            }
+        }
+        SDLTest_AssertCheck(failures == 0, "Check SDL_GetRGBAArray matches SDL_GetRGBA for %s, %d failures", g_AllFormatsVerbose[i], failures);
+    }
+
+    SDL_DestroyPalette(palette);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -511,9 +769,21 @@ static const SDLTest_TestCaseReference pixelsTest3 = {
     (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference pixelsTest4 = {
+    (SDLTest_TestCaseFp)pixels_mapRGBPalette, "pixels_mapRGBPalette", "Call to SDL_MapRGB with a palette", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference pixelsTest5 = {
+    (SDLTest_TestCaseFp)pixels_convertYUVToRGB, "pixels_convertYUVToRGB", "Call to SDL_ConvertPixelsAndColorspace with wide YUV images", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference pixelsTest6 = {
+    (SDLTest_TestCaseFp)pixels_mapRGBAArray, "pixels_mapRGBAArray", "Call to SDL_MapRGBAArray and SDL_GetRGBAArray", TEST_ENABLED
+};
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] = {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, &pixelsTest6, NULL
 };
 
 /* Pixels test suite (global) */
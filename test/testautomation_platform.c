@@ -121,6 +121,8 @@ static int platform_testEndianessAndSwap(void *arg)
  * Tests SDL_GetXYZ() functions
  * \sa SDL_GetPlatform
  * \sa SDL_GetCPUCount
+ * \sa SDL_GetCPUCoreCount
+ * \sa SDL_GetCPUCacheSharingMask
  * \sa SDL_GetRevision
  * \sa SDL_GetCPUCacheLineSize
  */
@@ -129,6 +131,7 @@ static int platform_testGetFunctions(void *arg)
     const char *platform;
     const char *revision;
     int ret;
+    Uint64 mask;
     size_t len;
 
     platform = SDL_GetPlatform();
@@ -148,6 +151,24 @@ static int platform_testGetFunctions(void *arg)
                         "SDL_GetCPUCount(): expected count > 0, was: %i",
                         ret);
 
+    ret = SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_PERFORMANCE);
+    SDLTest_AssertPass("SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_PERFORMANCE)");
+    SDLTest_AssertCheck(ret > 0,
+                        "SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_PERFORMANCE): expected count > 0, was: %i",
+                        ret);
+
+    ret = SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_EFFICIENCY);
+    SDLTest_AssertPass("SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_EFFICIENCY)");
+    SDLTest_AssertCheck(ret >= 0,
+                        "SDL_GetCPUCoreCount(SDL_CPU_CORE_TYPE_EFFICIENCY): expected count >= 0, was: %i",
+                        ret);
+
+    mask = SDL_GetCPUCacheSharingMask(0);
+    SDLTest_AssertPass("SDL_GetCPUCacheSharingMask(0)");
+    SDLTest_AssertCheck((mask & 1) != 0,
+                        "SDL_GetCPUCacheSharingMask(0): expected CPU 0 in mask, was: 0x%" SDL_PRIx64,
+                        mask);
+
     ret = SDL_GetCPUCacheLineSize();
     SDLTest_AssertPass("SDL_GetCPUCacheLineSize()");
     SDLTest_AssertCheck(ret >= 0,
@@ -382,6 +382,122 @@ static int properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test concurrent readers
+ */
+#define NUM_READER_THREADS  4
+#define NUM_READER_LOOPS    10000
+
+typedef struct
+{
+    SDL_PropertiesID props;
+    SDL_AtomicInt mismatches;
+} ReaderData;
+
+static int SDLCALL properties_readerThread(void *arg)
+{
+    ReaderData *data = (ReaderData *)arg;
+    int i;
+
+    for (i = 0; i < NUM_READER_LOOPS; ++i) {
+        const char *number = SDL_GetStringProperty(data->props, "number", NULL);
+        if (!number || SDL_strcmp(number, "42") != 0) {
+            SDL_AtomicIncRef(&data->mismatches);
+        }
+        if (SDL_GetNumberProperty(data->props, "number", 0) != 42) {
+            SDL_AtomicIncRef(&data->mismatches);
+        }
+        if (!SDL_GetBooleanProperty(data->props, "boolean", SDL_FALSE)) {
+            SDL_AtomicIncRef(&data->mismatches);
+        }
+    }
+    return 0;
+}
+
+static int properties_testConcurrentReads(void *arg)
+{
+    ReaderData data;
+    SDL_Thread *threads[NUM_READER_THREADS];
+    int i;
+
+    SDL_zero(data);
+    data.props = SDL_CreateProperties();
+    SDLTest_AssertPass("Call to SDL_CreateProperties()");
+    SDLTest_AssertCheck(data.props != 0,
+        "Verify props were created, got: %" SDL_PRIu32, data.props);
+    if (!data.props) {
+        return TEST_ABORTED;
+    }
+    SDL_SetNumberProperty(data.props, "number", 42);
+    SDL_SetBooleanProperty(data.props, "boolean", SDL_TRUE);
+
+    for (i = 0; i < NUM_READER_THREADS; ++i) {
+        threads[i] = SDL_CreateThread(properties_readerThread, "properties_reader", &data);
+    }
+    for (i = 0; i < NUM_READER_LOOPS / 10; ++i) {
+        SDL_SetStringProperty(data.props, "other", "value");
+    }
+    for (i = 0; i < NUM_READER_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    SDLTest_AssertCheck(SDL_AtomicGet(&data.mismatches) == 0,
+        "Verify readers saw consistent values, got %d mismatches", SDL_AtomicGet(&data.mismatches));
+
+    SDL_DestroyProperties(data.props);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that destroyed property IDs stay invalid
+ */
+#define NUM_STALE_IDS 2048
+
+static int properties_testStaleIDs(void *arg)
+{
+    SDL_PropertiesID stale, props;
+    SDL_PropertiesID ids[NUM_STALE_IDS];
+    int i, result, num_valid = 0, num_unique = 1;
+
+    stale = SDL_CreateProperties();
+    SDLTest_AssertPass("Call to SDL_CreateProperties()");
+    SDLTest_AssertCheck(stale != 0,
+        "Verify props were created, got: %" SDL_PRIu32, stale);
+    SDL_DestroyProperties(stale);
+
+    result = SDL_SetNumberProperty(stale, "number", 1);
+    SDLTest_AssertCheck(result == -1,
+        "Verify setting a property on destroyed props fails, got: %d", result);
+
+    /* Churn through destroyed IDs, none of them may come back as the stale one */
+    for (i = 0; i < NUM_STALE_IDS; ++i) {
+        props = SDL_CreateProperties();
+        if (props) {
+            ++num_valid;
+            if (props != stale) {
+                ++num_unique;
+            }
+        }
+        ids[i] = props;
+        if (i % 2) {
+            SDL_DestroyProperties(ids[i - 1]);
+            SDL_DestroyProperties(ids[i]);
+            ids[i - 1] = ids[i] = 0;
+        }
+    }
+    SDLTest_AssertCheck(num_valid == NUM_STALE_IDS,
+        "Verify all props were created, got: %d", num_valid);
+    SDLTest_AssertCheck(num_unique == num_valid + 1,
+        "Verify a destroyed ID was never handed out again, got %d reused", num_valid + 1 - num_unique);
+
+    result = SDL_SetNumberProperty(stale, "number", 1);
+    SDLTest_AssertCheck(result == -1,
+        "Verify destroyed props are still invalid, got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -401,12 +517,22 @@ static const SDLTest_TestCaseReference propertiesTestLocking = {
     (SDLTest_TestCaseFp)properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestConcurrentReads = {
+    (SDLTest_TestCaseFp)properties_testConcurrentReads, "properties_testConcurrentReads", "Test reading properties from several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTestStaleIDs = {
+    (SDLTest_TestCaseFp)properties_testStaleIDs, "properties_testStaleIDs", "Test that destroyed property IDs stay invalid", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
     &propertiesTestBasic,
     &propertiesTestCopy,
     &propertiesTestCleanup,
     &propertiesTestLocking,
+    &propertiesTestConcurrentReads,
+    &propertiesTestStaleIDs,
     NULL
 };
 
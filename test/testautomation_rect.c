@@ -900,6 +900,92 @@ static int rect_testIntersectRectParam(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests SDL_GetRectIntersections() and SDL_GetRectIntersectionsFloat() against the single rect versions
+ *
+ * \sa SDL_GetRectIntersections
+ * \sa SDL_GetRectIntersectionsFloat
+ */
+static int rect_testIntersectRects(void *arg)
+{
+    SDL_Rect rects[64], results[64], clip, expected;
+    SDL_FRect frects[64], fresults[64], fclip, fexpected;
+    SDL_bool visible[64], intersection;
+    int i, count, expectedCount = 0, fexpectedCount = 0;
+
+    clip.x = SDLTest_RandomIntegerInRange(-50, 50);
+    clip.y = SDLTest_RandomIntegerInRange(-50, 50);
+    clip.w = SDLTest_RandomIntegerInRange(1, 100);
+    clip.h = SDLTest_RandomIntegerInRange(1, 100);
+    fclip.x = (float)clip.x;
+    fclip.y = (float)clip.y;
+    fclip.w = (float)clip.w;
+    fclip.h = (float)clip.h;
+    for (i = 0; i < SDL_arraysize(rects); ++i) {
+        rects[i].x = SDLTest_RandomIntegerInRange(-150, 150);
+        rects[i].y = SDLTest_RandomIntegerInRange(-150, 150);
+        rects[i].w = SDLTest_RandomIntegerInRange(-10, 100);
+        rects[i].h = SDLTest_RandomIntegerInRange(-10, 100);
+        frects[i].x = rects[i].x + 0.5f;
+        frects[i].y = rects[i].y - 0.25f;
+        frects[i].w = (float)rects[i].w;
+        frects[i].h = (float)rects[i].h;
+    }
+    /* rects that can't be safely intersected are rejected rather than clipped */
+    rects[0].x = SDL_MAX_SINT32 / 2;
+    rects[1].w = SDL_MAX_SINT32 / 2;
+    frects[0].x = (float)(SDL_MIN_SINT32 / 2);
+    frects[1].h = (float)(SDL_MAX_SINT32 / 2);
+
+    count = SDL_GetRectIntersections(rects, SDL_arraysize(rects), &clip, results, visible);
+    for (i = 0; i < SDL_arraysize(rects); ++i) {
+        intersection = SDL_GetRectIntersection(&rects[i], &clip, &expected);
+        if (intersection) {
+            ++expectedCount;
+        } else {
+            expected.x = rects[i].x;
+            expected.y = rects[i].y;
+            expected.w = 0;
+            expected.h = 0;
+        }
+        SDLTest_AssertCheck(visible[i] == intersection && SDL_RectsEqual(&results[i], &expected),
+                            "Check rect %d: got (%d,%d,%d,%d) visible %d, expected (%d,%d,%d,%d) visible %d",
+                            i, results[i].x, results[i].y, results[i].w, results[i].h, visible[i],
+                            expected.x, expected.y, expected.w, expected.h, intersection);
+    }
+    SDLTest_AssertCheck(count == expectedCount, "Check visible count, expected %d, got %d", expectedCount, count);
+
+    count = SDL_GetRectIntersectionsFloat(frects, SDL_arraysize(frects), &fclip, fresults, visible);
+    for (i = 0; i < SDL_arraysize(frects); ++i) {
+        intersection = SDL_GetRectIntersectionFloat(&frects[i], &fclip, &fexpected);
+        if (intersection) {
+            ++fexpectedCount;
+        } else {
+            fexpected.x = frects[i].x;
+            fexpected.y = frects[i].y;
+            fexpected.w = 0.0f;
+            fexpected.h = 0.0f;
+        }
+        SDLTest_AssertCheck(visible[i] == intersection && SDL_RectsEqualFloat(&fresults[i], &fexpected),
+                            "Check float rect %d: got (%f,%f,%f,%f) visible %d, expected (%f,%f,%f,%f) visible %d",
+                            i, fresults[i].x, fresults[i].y, fresults[i].w, fresults[i].h, visible[i],
+                            fexpected.x, fexpected.y, fexpected.w, fexpected.h, intersection);
+    }
+    SDLTest_AssertCheck(count == fexpectedCount, "Check float visible count, expected %d, got %d", fexpectedCount, count);
+
+    /* clipping in place, without a visibility mask */
+    count = SDL_GetRectIntersections(rects, SDL_arraysize(rects), &clip, rects, NULL);
+    SDLTest_AssertCheck(count == expectedCount, "Check in place visible count, expected %d, got %d", expectedCount, count);
+    SDLTest_AssertCheck(SDL_memcmp(rects, results, sizeof(rects)) == 0, "Check in place results match");
+
+    count = SDL_GetRectIntersections(NULL, 1, &clip, results, NULL);
+    SDLTest_AssertCheck(count < 0, "Check that function fails when rects is NULL");
+    count = SDL_GetRectIntersections(rects, 1, NULL, results, NULL);
+    SDLTest_AssertCheck(count < 0, "Check that function fails when clip is NULL");
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests SDL_HasRectIntersection() with B fully inside A
  *
@@ -1990,6 +2076,11 @@ static const SDLTest_TestCaseReference rectTestIntersectRectParam = {
     (SDLTest_TestCaseFp)rect_testIntersectRectParam, "rect_testIntersectRectParam", "Negative tests against SDL_GetRectIntersection with invalid parameters", TEST_ENABLED
 };
 
+/* SDL_GetRectIntersections */
+static const SDLTest_TestCaseReference rectTestIntersectRects = {
+    (SDLTest_TestCaseFp)rect_testIntersectRects, "rect_testIntersectRects", "Tests SDL_GetRectIntersections and SDL_GetRectIntersectionsFloat against the single rect versions", TEST_ENABLED
+};
+
 /* SDL_HasRectIntersection */
 static const SDLTest_TestCaseReference rectTestHasIntersectionInside = {
     (SDLTest_TestCaseFp)rect_testHasIntersectionInside, "rect_testHasIntersectionInside", "Tests SDL_HasRectIntersection with B fully contained in A", TEST_ENABLED
@@ -2103,6 +2194,7 @@ static const SDLTest_TestCaseReference *rectTests[] = {
     &rectTestIntersectRectPoint,
     &rectTestIntersectRectEmpty,
     &rectTestIntersectRectParam,
+    &rectTestIntersectRects,
     &rectTestHasIntersectionInside,
     &rectTestHasIntersectionOutside,
     &rectTestHasIntersectionPartial,
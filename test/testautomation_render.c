@@ -293,6 +293,180 @@ static int render_testBlit(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Fills instances with the same layout as render_testBlit.
+ */
+static int fillBlitInstances(SDL_TextureInstance *instances, int max_instances, float tw, float th)
+{
+    float i, j, ni, nj;
+    int count = 0;
+
+    ni = TESTRENDER_SCREEN_W - tw;
+    nj = TESTRENDER_SCREEN_H - th;
+    for (j = 0; j <= nj; j += 4) {
+        for (i = 0; i <= ni; i += 4) {
+            SDL_TextureInstance *instance;
+
+            if (count == max_instances) {
+                return count;
+            }
+            instance = &instances[count++];
+            instance->srcrect.x = 0.0f;
+            instance->srcrect.y = 0.0f;
+            instance->srcrect.w = tw;
+            instance->srcrect.h = th;
+            instance->dstrect.x = i;
+            instance->dstrect.y = j;
+            instance->dstrect.w = tw;
+            instance->dstrect.h = th;
+            instance->angle = 0.0f;
+            instance->color.r = 1.0f;
+            instance->color.g = 1.0f;
+            instance->color.b = 1.0f;
+            instance->color.a = 1.0f;
+        }
+    }
+    return count;
+}
+
+/**
+ * Tests blitting many copies of a texture in a single call.
+ *
+ * \sa SDL_RenderTextureInstanced
+ */
+static int render_testBlitInstanced(void *arg)
+{
+    int ret;
+    SDL_TextureInstance instances[256];
+    SDL_Texture *tface;
+    SDL_Surface *referenceSurface = NULL;
+    float tw, th;
+    int count;
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Need drawcolor or just skip test. */
+    SDLTest_AssertCheck(hasDrawColor(), "hasDrawColor)");
+
+    /* Create face surface. */
+    tface = loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    CHECK_FUNC(SDL_GetTextureSize, (tface, &tw, &th))
+    count = fillBlitInstances(instances, SDL_arraysize(instances), tw, th);
+
+    ret = SDL_RenderTextureInstanced(renderer, tface, instances, count);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderTextureInstanced, expected: 0, got: %i", ret);
+
+    /* See if it's the same */
+    referenceSurface = SDLTest_ImageBlit();
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    /* Clean up. */
+    SDL_DestroyTexture(tface);
+    SDL_DestroySurface(referenceSurface);
+    referenceSurface = NULL;
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_RenderCommandList *list;
+    SDL_Texture *texture;
+    float tw, th;
+    int result;
+} RecordCommandListData;
+
+static int SDLCALL recordCommandListThread(void *arg)
+{
+    RecordCommandListData *data = (RecordCommandListData *)arg;
+    SDL_TextureInstance instances[256];
+    const int count = fillBlitInstances(instances, SDL_arraysize(instances), data->tw, data->th);
+    int i;
+
+    /* Record one instance at a time, the list should merge them into one run */
+    data->result = 0;
+    for (i = 0; i < count; ++i) {
+        if (SDL_RecordRenderTextureInstanced(data->list, data->texture, &instances[i], 1) < 0) {
+            data->result = -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Tests recording draws on another thread and submitting them.
+ *
+ * \sa SDL_CreateRenderCommandList
+ * \sa SDL_RecordRenderTextureInstanced
+ * \sa SDL_SubmitRenderCommandList
+ */
+static int render_testCommandList(void *arg)
+{
+    int ret;
+    RecordCommandListData data;
+    SDL_Thread *thread;
+    SDL_Surface *referenceSurface = NULL;
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Need drawcolor or just skip test. */
+    SDLTest_AssertCheck(hasDrawColor(), "hasDrawColor)");
+
+    SDL_zero(data);
+    data.texture = loadTestFace();
+    SDLTest_AssertCheck(data.texture != NULL, "Verify loadTestFace() result");
+    if (data.texture == NULL) {
+        return TEST_ABORTED;
+    }
+    CHECK_FUNC(SDL_GetTextureSize, (data.texture, &data.tw, &data.th))
+
+    data.list = SDL_CreateRenderCommandList();
+    SDLTest_AssertCheck(data.list != NULL, "Validate result from SDL_CreateRenderCommandList, expected: non-NULL");
+    if (data.list == NULL) {
+        SDL_DestroyTexture(data.texture);
+        return TEST_ABORTED;
+    }
+
+    thread = SDL_CreateThread(recordCommandListThread, "RecordCommandList", &data);
+    SDLTest_AssertCheck(thread != NULL, "Validate result from SDL_CreateThread, expected: non-NULL");
+    SDL_WaitThread(thread, NULL);
+    SDLTest_AssertCheck(data.result == 0, "Validate result from SDL_RecordRenderTextureInstanced, expected: 0, got: %i", data.result);
+
+    ret = SDL_SubmitRenderCommandList(renderer, data.list);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SubmitRenderCommandList, expected: 0, got: %i", ret);
+
+    /* See if it's the same */
+    referenceSurface = SDLTest_ImageBlit();
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Submitting a cleared list draws nothing */
+    clearScreen();
+    SDL_ClearRenderCommandList(data.list);
+    ret = SDL_SubmitRenderCommandList(renderer, data.list);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SubmitRenderCommandList, expected: 0, got: %i", ret);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    /* Clean up. */
+    SDL_DestroyRenderCommandList(data.list);
+    SDL_DestroyTexture(data.texture);
+    SDL_DestroySurface(referenceSurface);
+    referenceSurface = NULL;
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests tiled blitting routines.
  */
@@ -610,6 +784,44 @@ static int render_testBlit9Grid(void *arg)
         SDL_RenderPresent(renderer);
     }
 
+    /* 9-grid blit - source rectangle past the texture */
+    {
+        SDL_FRect src;
+        SDL_Surface *surface;
+        Uint8 r = 0, g = 0, b = 0, a = 0;
+
+        SDLTest_Log("9-grid blit - clipped source");
+
+        /* Clear surface. */
+        clearScreen();
+
+        /* The left half of the source is outside the texture, so only the right half of the destination is drawn */
+        src.x = -5.0f;
+        src.y = 0.0f;
+        src.w = 10.0f;
+        src.h = 5.0f;
+        rect.x = 0.0f;
+        rect.y = 0.0f;
+        rect.w = (float)TESTRENDER_SCREEN_W;
+        rect.h = (float)TESTRENDER_SCREEN_H;
+        ret = SDL_RenderTexture9Grid(renderer, texture, &src, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, &rect);
+        SDLTest_AssertCheck(ret == 0, "Validate results from call to SDL_RenderTexture9Grid, expected: 0, got: %i", ret);
+
+        surface = SDL_RenderReadPixels(renderer, NULL);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface ? "surface" : SDL_GetError());
+        if (surface) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, TESTRENDER_SCREEN_W / 4, TESTRENDER_SCREEN_H / 2, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Validate left half is not drawn, expected: 0,0,0, got: %d,%d,%d", r, g, b);
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 60, 30, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == 2 * COLOR_SEPARATION && g == 2 * COLOR_SEPARATION && b == 0,
+                                "Validate right half shows the texture, expected: %d,%d,0, got: %d,%d,%d", 2 * COLOR_SEPARATION, 2 * COLOR_SEPARATION, r, g, b);
+            SDL_DestroySurface(surface);
+        }
+
+        /* Make current */
+        SDL_RenderPresent(renderer);
+    }
+
     /* Clean up. */
     SDL_DestroySurface(referenceSurface);
     SDL_DestroySurface(source);
@@ -1536,55 +1748,1464 @@ static int render_testUVWrapping(void *arg)
     return TEST_COMPLETED;
 }
 
-/* ================= Test References ================== */
+/**
+ * Renders a grid of sprites from the test face as individual geometry draws.
+ */
+static SDL_Surface *renderGeometryGrid(SDL_bool merge_geometry)
+{
+    SDL_Surface *target;
+    SDL_Surface *face;
+    SDL_Renderer *grid_renderer;
+    SDL_Texture *tface;
+    SDL_FColor color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    int x, y;
 
-/* Render test cases */
-static const SDLTest_TestCaseReference renderTestGetNumRenderDrivers = {
-    (SDLTest_TestCaseFp)render_testGetNumRenderDrivers, "render_testGetNumRenderDrivers", "Tests call to SDL_GetNumRenderDrivers", TEST_ENABLED
-};
+    target = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    if (!target) {
+        return NULL;
+    }
 
-static const SDLTest_TestCaseReference renderTestPrimitives = {
-    (SDLTest_TestCaseFp)render_testPrimitives, "render_testPrimitives", "Tests rendering primitives", TEST_ENABLED
-};
+    SDL_SetHint(SDL_HINT_RENDER_MERGE_GEOMETRY, merge_geometry ? "1" : "0");
+    grid_renderer = SDL_CreateSoftwareRenderer(target);
+    SDL_ResetHint(SDL_HINT_RENDER_MERGE_GEOMETRY);
+    SDLTest_AssertCheck(grid_renderer != NULL, "Validate result from SDL_CreateSoftwareRenderer, expected: non-NULL");
+    if (!grid_renderer) {
+        SDL_DestroySurface(target);
+        return NULL;
+    }
 
-static const SDLTest_TestCaseReference renderTestPrimitivesWithViewport = {
-    (SDLTest_TestCaseFp)render_testPrimitivesWithViewport, "render_testPrimitivesWithViewport", "Tests rendering primitives within a viewport", TEST_ENABLED
-};
+    face = SDLTest_ImageFace();
+    tface = face ? SDL_CreateTextureFromSurface(grid_renderer, face) : NULL;
+    SDL_DestroySurface(face);
+    if (!tface) {
+        SDL_DestroyRenderer(grid_renderer);
+        SDL_DestroySurface(target);
+        return NULL;
+    }
 
-static const SDLTest_TestCaseReference renderTestBlit = {
-    (SDLTest_TestCaseFp)render_testBlit, "render_testBlit", "Tests blitting", TEST_ENABLED
-};
+    CHECK_FUNC(SDL_SetRenderDrawColor, (grid_renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (grid_renderer))
 
-static const SDLTest_TestCaseReference renderTestBlitTiled = {
-    (SDLTest_TestCaseFp)render_testBlitTiled, "render_testBlitTiled", "Tests tiled blitting", TEST_ENABLED
-};
+    for (y = 0; y < TESTRENDER_SCREEN_H; y += 10) {
+        for (x = 0; x < TESTRENDER_SCREEN_W; x += 10) {
+            SDL_Vertex verts[3];
+            int i;
 
-static const SDLTest_TestCaseReference renderTestBlit9Grid = {
-    (SDLTest_TestCaseFp)render_testBlit9Grid, "render_testBlit9Grid", "Tests 9-grid blitting", TEST_ENABLED
-};
+            for (i = 0; i < 3; ++i) {
+                verts[i].color = color;
+            }
+            verts[0].position.x = (float)x;
+            verts[0].position.y = (float)y;
+            verts[0].tex_coord.x = 0.0f;
+            verts[0].tex_coord.y = 0.0f;
+            verts[1].position.x = (float)(x + 10);
+            verts[1].position.y = (float)y;
+            verts[1].tex_coord.x = 1.0f;
+            verts[1].tex_coord.y = 0.0f;
+            verts[2].position.x = (float)(x + 10);
+            verts[2].position.y = (float)(y + 10);
+            verts[2].tex_coord.x = 1.0f;
+            verts[2].tex_coord.y = 1.0f;
+            CHECK_FUNC(SDL_RenderGeometry, (grid_renderer, tface, verts, 3, NULL, 0))
+        }
+    }
+    CHECK_FUNC(SDL_FlushRenderer, (grid_renderer))
 
-static const SDLTest_TestCaseReference renderTestBlitColor = {
-    (SDLTest_TestCaseFp)render_testBlitColor, "render_testBlitColor", "Tests blitting with color", TEST_ENABLED
-};
+    SDL_DestroyTexture(tface);
+    SDL_DestroyRenderer(grid_renderer);
+    return target;
+}
 
-static const SDLTest_TestCaseReference renderTestBlendModes = {
-    (SDLTest_TestCaseFp)render_testBlendModes, "render_testBlendModes", "Tests rendering blend modes", TEST_ENABLED
-};
+/**
+ * Tests that merging consecutive geometry draws doesn't change the output
+ *
+ * \sa SDL_HINT_RENDER_MERGE_GEOMETRY
+ */
+static int render_testMergeGeometry(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Surface *mergedSurface;
+    int ret;
 
-static const SDLTest_TestCaseReference renderTestViewport = {
-    (SDLTest_TestCaseFp)render_testViewport, "render_testViewport", "Tests viewport", TEST_ENABLED
-};
+    referenceSurface = renderGeometryGrid(SDL_FALSE);
+    mergedSurface = renderGeometryGrid(SDL_TRUE);
+    SDLTest_AssertCheck(referenceSurface != NULL && mergedSurface != NULL, "Verify geometry grids were rendered");
+    if (referenceSurface && mergedSurface) {
+        ret = SDLTest_CompareSurfaces(mergedSurface, referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+    }
 
-static const SDLTest_TestCaseReference renderTestClipRect = {
-    (SDLTest_TestCaseFp)render_testClipRect, "render_testClipRect", "Tests clip rect", TEST_ENABLED
-};
+    SDL_DestroySurface(referenceSurface);
+    SDL_DestroySurface(mergedSurface);
+    return TEST_COMPLETED;
+}
 
-static const SDLTest_TestCaseReference renderTestLogicalSize = {
-    (SDLTest_TestCaseFp)render_testLogicalSize, "render_testLogicalSize", "Tests logical size", TEST_ENABLED
-};
+/**
+ * Renders a scene of clears, fills, points, copies and geometry through a software renderer.
+ */
+static SDL_Surface *renderBandedScene(const char *threads)
+{
+    SDL_Surface *target;
+    SDL_Surface *face;
+    SDL_Renderer *scene_renderer;
+    SDL_Texture *tface;
+    SDL_Rect viewport = { 7, 13, 480, 340 };
+    SDL_Rect cliprect = { 40, 30, 300, 200 };
+    SDL_Vertex verts[3];
+    int i;
 
-static const SDLTest_TestCaseReference renderTestUVWrapping = {
-    (SDLTest_TestCaseFp)render_testUVWrapping, "render_testUVWrapping", "Tests geometry UV wrapping", TEST_ENABLED
+    target = SDL_CreateSurface(512, 384, RENDER_COMPARE_FORMAT);
+    if (!target) {
+        return NULL;
+    }
+
+    scene_renderer = SDL_CreateSoftwareRenderer(target);
+    SDLTest_AssertCheck(scene_renderer != NULL, "Validate result from SDL_CreateSoftwareRenderer, expected: non-NULL");
+    if (!scene_renderer) {
+        SDL_DestroySurface(target);
+        return NULL;
+    }
+
+    face = SDLTest_ImageFace();
+    tface = face ? SDL_CreateTextureFromSurface(scene_renderer, face) : NULL;
+    SDL_DestroySurface(face);
+    if (!tface) {
+        SDL_DestroyRenderer(scene_renderer);
+        SDL_DestroySurface(target);
+        return NULL;
+    }
+
+    SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, threads);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (scene_renderer, 20, 40, 60, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (scene_renderer))
+    CHECK_FUNC(SDL_SetRenderViewport, (scene_renderer, &viewport))
+    CHECK_FUNC(SDL_SetRenderDrawBlendMode, (scene_renderer, SDL_BLENDMODE_BLEND))
+    CHECK_FUNC(SDL_SetTextureBlendMode, (tface, SDL_BLENDMODE_BLEND))
+    for (i = 0; i < 100; ++i) {
+        SDL_FRect rect;
+
+        rect.x = (float)((i * 53) % 500) - 20.0f;
+        rect.y = (float)((i * 31) % 360) - 20.0f;
+        rect.w = 41.0f;
+        rect.h = 27.0f;
+        CHECK_FUNC(SDL_SetRenderDrawColor, (scene_renderer, (Uint8)(i * 3), (Uint8)(255 - i), (Uint8)(i * 7), 128))
+        CHECK_FUNC(SDL_RenderFillRect, (scene_renderer, &rect))
+        CHECK_FUNC(SDL_RenderPoint, (scene_renderer, rect.x + 50.0f, rect.y + 50.0f))
+
+        CHECK_FUNC(SDL_GetTextureSize, (tface, &rect.w, &rect.h))
+        CHECK_FUNC(SDL_SetTextureColorMod, (tface, 255, (Uint8)(i * 2), 128))
+        CHECK_FUNC(SDL_RenderTexture, (scene_renderer, tface, NULL, &rect))
+    }
+
+    CHECK_FUNC(SDL_SetRenderClipRect, (scene_renderer, &cliprect))
+    for (i = 0; i < 3; ++i) {
+        verts[i].color.r = (i == 0) ? 1.0f : 0.0f;
+        verts[i].color.g = (i == 1) ? 1.0f : 0.0f;
+        verts[i].color.b = (i == 2) ? 1.0f : 0.0f;
+        verts[i].color.a = 0.75f;
+        verts[i].tex_coord.x = 0.0f;
+        verts[i].tex_coord.y = 0.0f;
+    }
+    verts[0].position.x = 10.0f;
+    verts[0].position.y = 5.0f;
+    verts[1].position.x = 430.0f;
+    verts[1].position.y = 90.0f;
+    verts[2].position.x = 150.0f;
+    verts[2].position.y = 330.0f;
+    CHECK_FUNC(SDL_RenderGeometry, (scene_renderer, NULL, verts, 3, NULL, 0))
+    CHECK_FUNC(SDL_FlushRenderer, (scene_renderer))
+
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    SDL_DestroyTexture(tface);
+    SDL_DestroyRenderer(scene_renderer);
+    return target;
+}
+
+/**
+ * Tests that rendering in bands on several threads matches rendering serially
+ *
+ * \sa SDL_HINT_SURFACE_BLIT_THREADS
+ */
+static int render_testBandedRendering(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Surface *bandedSurface;
+    int ret;
+
+    referenceSurface = renderBandedScene("1");
+    bandedSurface = renderBandedScene("4");
+    SDLTest_AssertCheck(referenceSurface != NULL && bandedSurface != NULL, "Verify scenes were rendered");
+    if (referenceSurface && bandedSurface) {
+        ret = SDLTest_CompareSurfaces(bandedSurface, referenceSurface, 0);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+    }
+
+    SDL_DestroySurface(referenceSurface);
+    SDL_DestroySurface(bandedSurface);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that rendering statistics are collected for each presented frame
+ *
+ * \sa SDL_GetRenderStats
+ */
+static int render_testRenderStats(void *arg)
+{
+    SDL_RenderStats first, stats;
+    SDL_FRect rect = { 0.0f, 0.0f, 10.0f, 10.0f };
+    int ret;
+
+    ret = SDL_GetRenderStats(renderer, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_GetRenderStats(NULL), expected: <0, got: %i", ret);
+
+    SDL_RenderPresent(renderer);
+    ret = SDL_GetRenderStats(renderer, &first);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+    rect.x = 20.0f;
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+    SDL_RenderPresent(renderer);
+
+    ret = SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.frame == first.frame + 1, "Validate frame count, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, first.frame + 1, stats.frame);
+    SDLTest_AssertCheck(stats.flushes >= 1, "Validate flush count, expected: >=1, got: %i", stats.flushes);
+    SDLTest_AssertCheck(stats.draw_commands >= 2, "Validate draw command count, expected: >=2, got: %i", stats.draw_commands);
+    SDLTest_AssertCheck(stats.state_changes >= 1, "Validate state change count, expected: >=1, got: %i", stats.state_changes);
+    SDLTest_AssertCheck(stats.commands >= stats.draw_commands + stats.state_changes, "Validate command count, expected: >=%i, got: %i", stats.draw_commands + stats.state_changes, stats.commands);
+    SDLTest_AssertCheck(stats.vertex_bytes > 0, "Validate vertex bytes, expected: >0, got: %" SDL_PRIu64, stats.vertex_bytes);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that texture memory is accounted to the renderer and the global statistics
+ *
+ * \sa SDL_GetRendererMemoryStats
+ * \sa SDL_GetMemoryStats
+ */
+static int render_testMemoryStats(void *arg)
+{
+    SDL_MemoryStats before, global_before, stats;
+    SDL_Texture *texture;
+    int ret;
+
+    ret = SDL_GetRendererMemoryStats(renderer, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_GetRendererMemoryStats(NULL), expected: <0, got: %i", ret);
+
+    CHECK_FUNC(SDL_GetRendererMemoryStats, (renderer, &before))
+    CHECK_FUNC(SDL_GetMemoryStats, (SDL_MEMORY_CATEGORY_TEXTURES, &global_before))
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 32);
+    SDLTest_AssertCheck(texture != NULL, "Verify texture creation");
+    if (!texture) {
+        return TEST_ABORTED;
+    }
+
+    CHECK_FUNC(SDL_GetRendererMemoryStats, (renderer, &stats))
+    SDLTest_AssertCheck(stats.count == before.count + 1, "Validate texture count, expected: %i, got: %i", before.count + 1, stats.count);
+    SDLTest_AssertCheck(stats.bytes > before.bytes, "Validate texture bytes, expected: >%" SDL_PRIu64 ", got: %" SDL_PRIu64, before.bytes, stats.bytes);
+    SDLTest_AssertCheck(stats.gpu_bytes >= before.gpu_bytes + 64 * 32 * 4, "Validate texture GPU bytes, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, before.gpu_bytes + 64 * 32 * 4, stats.gpu_bytes);
+
+    CHECK_FUNC(SDL_GetMemoryStats, (SDL_MEMORY_CATEGORY_TEXTURES, &stats))
+    SDLTest_AssertCheck(stats.count == global_before.count + 1, "Validate global texture count, expected: %i, got: %i", global_before.count + 1, stats.count);
+
+    SDL_DestroyTexture(texture);
+
+    CHECK_FUNC(SDL_GetRendererMemoryStats, (renderer, &stats))
+    SDLTest_AssertCheck(stats.count == before.count && stats.bytes == before.bytes && stats.gpu_bytes == before.gpu_bytes,
+                        "Validate renderer statistics after destroying the texture, expected: %i/%" SDL_PRIu64 "/%" SDL_PRIu64 ", got: %i/%" SDL_PRIu64 "/%" SDL_PRIu64,
+                        before.count, before.bytes, before.gpu_bytes, stats.count, stats.bytes, stats.gpu_bytes);
+    CHECK_FUNC(SDL_GetMemoryStats, (SDL_MEMORY_CATEGORY_TEXTURES, &stats))
+    SDLTest_AssertCheck(stats.count == global_before.count && stats.gpu_bytes == global_before.gpu_bytes,
+                        "Validate global texture statistics after destroying the texture, expected: %i/%" SDL_PRIu64 ", got: %i/%" SDL_PRIu64,
+                        global_before.count, global_before.gpu_bytes, stats.count, stats.gpu_bytes);
+
+    ret = SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_COUNT, &stats);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_COUNT), expected: <0, got: %i", ret);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests streaming more vertex data through a single frame than fits in the
+ * renderer's vertex buffers, so the backends have to cycle through them.
+ *
+ * \sa SDL_RenderGeometry
+ */
+static int render_testLargeVertexStream(void *arg)
+{
+    const int cells = 16;
+    const int cell_size = 8;
+    const int quads = 2048;
+    const int num_vertices = quads * 6;
+    SDL_Vertex *verts;
+    SDL_Surface *surface;
+    int i, j;
+
+    /* 16 draws of 12288 vertices is well over the 4 MB streamed by the OpenGL renderer */
+    verts = (SDL_Vertex *)SDL_malloc(num_vertices * sizeof(*verts));
+    SDLTest_AssertCheck(verts != NULL, "Verify vertex allocation");
+    if (!verts) {
+        return TEST_ABORTED;
+    }
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+
+    for (i = 0; i < cells; ++i) {
+        const float x = (float)((i % 4) * cell_size);
+        const float y = (float)((i / 4) * cell_size);
+        const float size = (float)cell_size;
+        SDL_FColor color;
+
+        color.r = (float)(i * 16) / 255.0f;
+        color.g = (float)(255 - i * 16) / 255.0f;
+        color.b = 1.0f;
+        color.a = 1.0f;
+
+        for (j = 0; j < num_vertices; ++j) {
+            static const float corners[6][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 } };
+
+            verts[j].position.x = x + corners[j % 6][0] * size;
+            verts[j].position.y = y + corners[j % 6][1] * size;
+            verts[j].color = color;
+            verts[j].tex_coord.x = 0.0f;
+            verts[j].tex_coord.y = 0.0f;
+        }
+
+        /* Alternate the blend mode so the draws aren't merged into one oversized batch */
+        CHECK_FUNC(SDL_SetRenderDrawBlendMode, (renderer, (i & 1) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE))
+        CHECK_FUNC(SDL_RenderGeometry, (renderer, NULL, verts, num_vertices, NULL, 0))
+    }
+    SDL_free(verts);
+    CHECK_FUNC(SDL_SetRenderDrawBlendMode, (renderer, SDL_BLENDMODE_NONE))
+
+    surface = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface ? "surface" : SDL_GetError());
+    if (surface) {
+        for (i = 0; i < cells; ++i) {
+            Uint8 r = 0, g = 0, b = 0, a = 0;
+
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, (i % 4) * cell_size + cell_size / 2, (i / 4) * cell_size + cell_size / 2, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == i * 16 && g == 255 - i * 16 && b == 255,
+                                "Validate cell %d color, expected: %d,%d,255, got: %d,%d,%d", i, i * 16, 255 - i * 16, r, g, b);
+        }
+        SDL_DestroySurface(surface);
+    }
+    SDL_RenderPresent(renderer);
+
+    return TEST_COMPLETED;
+}
+
+static void drawQueueTestFrame(SDL_Renderer *queue_renderer, int count)
+{
+    SDL_FRect rect = { 0.0f, 0.0f, 2.0f, 2.0f };
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        rect.x = (float)(i % 32) * 2.0f;
+        rect.y = (float)(i / 32) * 2.0f;
+        SDL_RenderFillRect(queue_renderer, &rect);
+    }
+    SDL_RenderPresent(queue_renderer);
+}
+
+/**
+ * Tests preallocating command queue memory and giving it back after busy frames
+ *
+ * \sa SDL_CreateRendererWithProperties
+ * \sa SDL_GetRenderStats
+ */
+static int render_testCommandQueueReserve(void *arg)
+{
+    SDL_Surface *target;
+    SDL_Renderer *queue_renderer;
+    SDL_PropertiesID props;
+    SDL_RenderStats stats;
+    int i;
+
+    target = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(target != NULL, "Verify SDL_CreateSurface() result");
+    if (!target) {
+        return TEST_ABORTED;
+    }
+
+    /* With enough reserved up front, even the first busy frame doesn't allocate */
+    props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_SURFACE_POINTER, target);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_CREATE_COMMAND_RESERVE_NUMBER, 512);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_CREATE_VERTEX_RESERVE_NUMBER, 256 * 1024);
+    queue_renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(queue_renderer != NULL, "Validate result from SDL_CreateRendererWithProperties, got: %s", queue_renderer ? "renderer" : SDL_GetError());
+    if (!queue_renderer) {
+        SDL_DestroySurface(target);
+        return TEST_ABORTED;
+    }
+    drawQueueTestFrame(queue_renderer, 256);
+    CHECK_FUNC(SDL_GetRenderStats, (queue_renderer, &stats))
+    SDLTest_AssertCheck(stats.peak_commands >= 256, "Validate peak command count, expected: >=256, got: %i", stats.peak_commands);
+    SDLTest_AssertCheck(stats.peak_vertex_bytes > 0, "Validate peak vertex bytes, expected: >0, got: %" SDL_PRIu64, stats.peak_vertex_bytes);
+    SDLTest_AssertCheck(stats.queue_allocations == 0, "Validate queue allocations with a reserve, expected: 0, got: %i", stats.queue_allocations);
+    SDL_DestroyRenderer(queue_renderer);
+
+    /* Without a reserve the first busy frame allocates, later ones reuse that memory,
+       and after some quiet frames the memory is given back */
+    props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_SURFACE_POINTER, target);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_CREATE_QUEUE_SHRINK_FRAMES_NUMBER, 2);
+    queue_renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(queue_renderer != NULL, "Validate result from SDL_CreateRendererWithProperties, got: %s", queue_renderer ? "renderer" : SDL_GetError());
+    if (!queue_renderer) {
+        SDL_DestroySurface(target);
+        return TEST_ABORTED;
+    }
+    drawQueueTestFrame(queue_renderer, 256);
+    CHECK_FUNC(SDL_GetRenderStats, (queue_renderer, &stats))
+    SDLTest_AssertCheck(stats.queue_allocations > 0, "Validate queue allocations on the first frame, expected: >0, got: %i", stats.queue_allocations);
+    drawQueueTestFrame(queue_renderer, 256);
+    CHECK_FUNC(SDL_GetRenderStats, (queue_renderer, &stats))
+    SDLTest_AssertCheck(stats.queue_allocations == 0, "Validate queue allocations on a repeated frame, expected: 0, got: %i", stats.queue_allocations);
+    for (i = 0; i < 4; ++i) {
+        drawQueueTestFrame(queue_renderer, 1);
+    }
+    drawQueueTestFrame(queue_renderer, 256);
+    CHECK_FUNC(SDL_GetRenderStats, (queue_renderer, &stats))
+    SDLTest_AssertCheck(stats.queue_allocations > 0, "Validate queue allocations after shrinking, expected: >0, got: %i", stats.queue_allocations);
+    SDL_DestroyRenderer(queue_renderer);
+
+    SDL_DestroySurface(target);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests presenting from a background thread with the software renderer
+ *
+ * \sa SDL_CreateRendererWithProperties
+ * \sa SDL_RenderPresent
+ */
+static int render_testSoftwareThreadedPresent(void *arg)
+{
+    SDL_Window *present_window;
+    SDL_Renderer *present_renderer;
+    SDL_PropertiesID props;
+    SDL_Surface *surface;
+    Uint8 r, g, b, a;
+    int i, w, h;
+
+    present_window = SDL_CreateWindow("testThreadedPresent", 64, 48, 0);
+    SDLTest_AssertCheck(present_window != NULL, "Verify SDL_CreateWindow() result");
+    if (!present_window) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetStringProperty(props, SDL_PROP_RENDERER_CREATE_NAME_STRING, SDL_SOFTWARE_RENDERER);
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_WINDOW_POINTER, present_window);
+    SDL_SetBooleanProperty(props, SDL_PROP_RENDERER_CREATE_SOFTWARE_THREADED_PRESENT_BOOLEAN, SDL_TRUE);
+    present_renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(present_renderer != NULL, "Validate result from SDL_CreateRendererWithProperties, got: %s", present_renderer ? "renderer" : SDL_GetError());
+    if (!present_renderer) {
+        SDL_DestroyWindow(present_window);
+        return TEST_ABORTED;
+    }
+
+    /* Each frame is drawn into a back buffer while the previous one is presented */
+    for (i = 0; i < 4; ++i) {
+        if (i == 2) {
+            CHECK_FUNC(SDL_SetWindowSize, (present_window, 80, 60))
+            SDL_PumpEvents();
+        }
+        CHECK_FUNC(SDL_SetRenderDrawColor, (present_renderer, 0, (Uint8)(64 * i), 255, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderClear, (present_renderer))
+        surface = SDL_RenderReadPixels(present_renderer, NULL);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface ? "surface" : SDL_GetError());
+        if (surface) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 1, 1, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == 0 && g == 64 * i && b == 255, "Verify frame %d pixel, expected: 0,%d,255, got: %d,%d,%d", i, 64 * i, r, g, b);
+            SDL_DestroySurface(surface);
+        }
+        CHECK_FUNC(SDL_RenderPresent, (present_renderer))
+    }
+    CHECK_FUNC(SDL_GetCurrentRenderOutputSize, (present_renderer, &w, &h))
+    SDLTest_AssertCheck(w == 80 && h == 60, "Verify output size after resizing, expected: 80x60, got: %dx%d", w, h);
+
+    SDL_DestroyRenderer(present_renderer);
+    SDL_DestroyWindow(present_window);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests the blend operations that read the render target
+ *
+ * \sa SDL_ComposeCustomBlendMode
+ * \sa SDL_SetRenderDrawBlendMode
+ */
+static int render_testAdvancedBlendOperations(void *arg)
+{
+    static const struct
+    {
+        SDL_BlendOperation operation;
+        const char *name;
+        Uint8 expected[3];
+    } tests[] = {
+        { SDL_BLENDOPERATION_MULTIPLY, "multiply", { 128, 64, 0 } },
+        { SDL_BLENDOPERATION_SCREEN, "screen", { 255, 192, 128 } },
+        { SDL_BLENDOPERATION_OVERLAY, "overlay", { 255, 128, 0 } },
+    };
+    SDL_Surface *surface;
+    SDL_BlendMode mode;
+    Uint8 r, g, b, a;
+    int i, ret;
+
+    for (i = 0; i < SDL_arraysize(tests); ++i) {
+        mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ZERO, tests[i].operation,
+                                          SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ZERO, SDL_BLENDOPERATION_ADD);
+        ret = SDL_SetRenderDrawBlendMode(renderer, mode);
+        if (ret < 0) {
+            SDLTest_Log("The %s renderer doesn't support the %s blend operation", SDL_GetRendererName(renderer), tests[i].name);
+            CHECK_FUNC(SDL_SetRenderDrawBlendMode, (renderer, SDL_BLENDMODE_NONE))
+            return TEST_SKIPPED;
+        }
+
+        /* Draw a color over a 50% gray destination */
+        CHECK_FUNC(SDL_SetRenderDrawBlendMode, (renderer, SDL_BLENDMODE_NONE))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 128, 0, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderClear, (renderer))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 128, 128, 128, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+        CHECK_FUNC(SDL_SetRenderDrawBlendMode, (renderer, mode))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 128, 0, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+
+        surface = SDL_RenderReadPixels(renderer, NULL);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface ? "surface" : SDL_GetError());
+        if (surface) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (surface, 1, 1, &r, &g, &b, &a))
+            SDLTest_AssertCheck(SDL_abs(r - tests[i].expected[0]) <= 2 &&
+                                SDL_abs(g - tests[i].expected[1]) <= 2 &&
+                                SDL_abs(b - tests[i].expected[2]) <= 2,
+                                "Verify %s result, expected: %d,%d,%d, got: %d,%d,%d", tests[i].name,
+                                tests[i].expected[0], tests[i].expected[1], tests[i].expected[2], r, g, b);
+            SDL_DestroySurface(surface);
+        }
+    }
+    CHECK_FUNC(SDL_SetRenderDrawBlendMode, (renderer, SDL_BLENDMODE_NONE))
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that debug text matches the test font drawn one character at a time
+ *
+ * \sa SDL_RenderDebugText
+ */
+static int render_testDebugText(void *arg)
+{
+    static const Uint32 codepoints[] = { 'H', 'i', 0xE9, '!', 0x263A };
+    const int size = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    const int width = SDL_arraysize(codepoints) * size;
+    SDL_Surface *surface;
+    Uint8 r, g, b, a, ref_r, ref_g, ref_b, ref_a;
+    int lit = 0, mismatched = 0;
+    int i, x, y, ret;
+
+    ret = SDL_RenderDebugText(renderer, 0.0f, 0.0f, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate SDL_RenderDebugText fails without a string, got: %i", ret);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 128, 0, SDL_ALPHA_OPAQUE))
+
+    /* "Hi", e-acute, "!" and a codepoint outside of the font, as UTF-8 */
+    CHECK_FUNC(SDL_RenderDebugText, (renderer, 0.0f, 0.0f, "Hi\xC3\xA9!\xE2\x98\xBA"))
+    for (i = 0; i < SDL_arraysize(codepoints); ++i) {
+        CHECK_FUNC(SDLTest_DrawCharacter, (renderer, (float)(i * size), (float)(2 * size), codepoints[i]))
+    }
+
+    surface = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface ? "surface" : SDL_GetError());
+    if (surface) {
+        for (y = 0; y < size; ++y) {
+            for (x = 0; x < width; ++x) {
+                SDL_ReadSurfacePixel(surface, x, y, &r, &g, &b, &a);
+                SDL_ReadSurfacePixel(surface, x, 2 * size + y, &ref_r, &ref_g, &ref_b, &ref_a);
+                if (r != ref_r || g != ref_g || b != ref_b) {
+                    ++mismatched;
+                }
+                if (r || g || b) {
+                    ++lit;
+                }
+            }
+        }
+        SDLTest_AssertCheck(lit > 0, "Verify debug text was drawn, got %d lit pixels", lit);
+        SDLTest_AssertCheck(mismatched == 0, "Verify debug text matches the test font, got %d mismatched pixels", mismatched);
+        SDL_DestroySurface(surface);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that state changes which don't affect the output are removed without changing the result
+ *
+ * \sa SDL_GetRenderStats
+ */
+static int render_testRedundantState(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_RenderStats stats;
+    SDL_Rect viewport, other;
+    int ret;
+
+    viewport.x = TESTRENDER_SCREEN_W / 3;
+    viewport.y = TESTRENDER_SCREEN_H / 3;
+    viewport.w = TESTRENDER_SCREEN_W / 2;
+    viewport.h = TESTRENDER_SCREEN_H / 2;
+    other.x = 0;
+    other.y = 0;
+    other.w = TESTRENDER_SCREEN_W / 4;
+    other.h = TESTRENDER_SCREEN_H / 4;
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &viewport, RENDER_COLOR_GREEN))
+
+    /* Clear surface. */
+    clearScreen();
+    SDL_RenderPresent(renderer);
+
+    /* Change the state several times before drawing anything */
+    CHECK_FUNC(SDL_SetRenderViewport, (renderer, &other))
+    CHECK_FUNC(SDL_SetRenderClipRect, (renderer, &other))
+    CHECK_FUNC(SDL_SetRenderViewport, (renderer, &viewport))
+    CHECK_FUNC(SDL_SetRenderClipRect, (renderer, NULL))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+    CHECK_FUNC(SDL_SetRenderViewport, (renderer, NULL))
+
+    /* Check to see if final image matches. */
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    SDL_RenderPresent(renderer);
+
+    ret = SDL_GetRenderStats(renderer, &stats);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(stats.redundant_commands >= 2, "Validate redundant command count, expected: >=2, got: %i", stats.redundant_commands);
+
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    int calls;
+    int result;
+} AsyncUpdateState;
+
+static void SDLCALL asyncUpdateCallback(void *userdata, SDL_Texture *texture, int result)
+{
+    AsyncUpdateState *state = (AsyncUpdateState *)userdata;
+
+    state->calls++;
+    state->result = result;
+}
+
+/**
+ * Tests scheduling texture updates that are done when the renderer flushes
+ *
+ * \sa SDL_UpdateTextureAsync
+ */
+static int render_testUpdateTextureAsync(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Texture *texture;
+    AsyncUpdateState state;
+    Uint32 pixels[4 * 4];
+    int i, ret;
+
+    for (i = 0; i < SDL_arraysize(pixels); ++i) {
+        pixels[i] = RENDER_COLOR_GREEN;
+    }
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_GREEN))
+
+    /* Clear surface. */
+    clearScreen();
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 4, 4);
+    SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture() result");
+    if (texture == NULL) {
+        SDL_DestroySurface(referenceSurface);
+        return TEST_ABORTED;
+    }
+
+    /* The update is done when the renderer flushes, before the callback is called */
+    SDL_zero(state);
+    ret = SDL_UpdateTextureAsync(texture, NULL, pixels, sizeof(pixels[0]) * 4, asyncUpdateCallback, &state);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTextureAsync, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(state.calls == 0, "Validate callback isn't called right away, got: %i calls", state.calls);
+    CHECK_FUNC(SDL_FlushRenderer, (renderer))
+    SDLTest_AssertCheck(state.calls == 1, "Validate callback was called once, got: %i calls", state.calls);
+    SDLTest_AssertCheck(state.result == 0, "Validate callback result, expected: 0, got: %i", state.result);
+
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, NULL))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Destroying the texture cancels pending updates */
+    SDL_zero(state);
+    ret = SDL_UpdateTextureAsync(texture, NULL, pixels, sizeof(pixels[0]) * 4, asyncUpdateCallback, &state);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTextureAsync, expected: 0, got: %i", ret);
+    SDL_DestroyTexture(texture);
+    SDLTest_AssertCheck(state.calls == 1, "Validate callback was called once, got: %i calls", state.calls);
+    SDLTest_AssertCheck(state.result < 0, "Validate callback result, expected: <0, got: %i", state.result);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    int calls;
+    SDL_PixelFormat format;
+    int w, h;
+    Uint8 r, g, b;
+} AsyncReadState;
+
+static void SDLCALL asyncReadCallback(void *userdata, SDL_Surface *surface)
+{
+    AsyncReadState *state = (AsyncReadState *)userdata;
+
+    state->calls++;
+    if (surface) {
+        state->format = surface->format;
+        state->w = surface->w;
+        state->h = surface->h;
+        if (!SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
+            SDL_ReadSurfacePixel(surface, 0, 0, &state->r, &state->g, &state->b, NULL);
+        }
+    }
+}
+
+/**
+ * Tests reading pixels back without waiting for the GPU
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+static int render_testReadPixelsAsync(void *arg)
+{
+    AsyncReadState state, yuvState;
+    SDL_Rect rect;
+    int ret;
+
+    /* Clear surface. */
+    clearScreen();
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+
+    rect.x = 8;
+    rect.y = 4;
+    rect.w = 16;
+    rect.h = 8;
+
+    ret = SDL_RenderReadPixelsAsync(renderer, &rect, SDL_PIXELFORMAT_XRGB8888, NULL, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate SDL_RenderReadPixelsAsync fails without a callback, got: %i", ret);
+
+    /* The pixels are delivered on a later present */
+    SDL_zero(state);
+    ret = SDL_RenderReadPixelsAsync(renderer, &rect, SDL_PIXELFORMAT_XRGB8888, asyncReadCallback, &state);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixelsAsync, expected: 0, got: %i, %s", ret, SDL_GetError());
+    SDL_zero(yuvState);
+    ret = SDL_RenderReadPixelsAsync(renderer, &rect, SDL_PIXELFORMAT_NV12, asyncReadCallback, &yuvState);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixelsAsync, expected: 0, got: %i, %s", ret, SDL_GetError());
+    SDLTest_AssertCheck(state.calls == 0, "Validate callback isn't called right away, got: %i calls", state.calls);
+
+    /* Drawing after the read doesn't change what was read */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+
+    /* Presenting a few times gives the GPU time to finish */
+    SDL_RenderPresent(renderer);
+    SDL_RenderPresent(renderer);
+    SDL_RenderPresent(renderer);
+
+    SDLTest_AssertCheck(state.calls == 1, "Validate callback was called once, got: %i calls", state.calls);
+    SDLTest_AssertCheck(state.format == SDL_PIXELFORMAT_XRGB8888, "Validate surface format, expected: %s, got: %s", SDL_GetPixelFormatName(SDL_PIXELFORMAT_XRGB8888), SDL_GetPixelFormatName(state.format));
+    SDLTest_AssertCheck(state.w == rect.w && state.h == rect.h, "Validate surface size, expected: %dx%d, got: %dx%d", rect.w, rect.h, state.w, state.h);
+    SDLTest_AssertCheck(state.r == 0 && state.g == 255 && state.b == 0, "Validate pixel color, expected: 0,255,0, got: %d,%d,%d", state.r, state.g, state.b);
+
+    SDLTest_AssertCheck(yuvState.calls == 1, "Validate callback was called once, got: %i calls", yuvState.calls);
+    SDLTest_AssertCheck(yuvState.format == SDL_PIXELFORMAT_NV12, "Validate surface format, expected: %s, got: %s", SDL_GetPixelFormatName(SDL_PIXELFORMAT_NV12), SDL_GetPixelFormatName(yuvState.format));
+    SDLTest_AssertCheck(yuvState.w == rect.w && yuvState.h == rect.h, "Validate surface size, expected: %dx%d, got: %dx%d", rect.w, rect.h, yuvState.w, yuvState.h);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests creating and updating block compressed textures
+ *
+ * \sa SDL_CreateTexture
+ * \sa SDL_UpdateTexture
+ */
+static int render_testCompressedTexture(void *arg)
+{
+    /* A solid green BC1 block: color0 = color1 = RGB565 green, all indices 0 */
+    const Uint8 green_block[8] = { 0xe0, 0x07, 0xe0, 0x07, 0x00, 0x00, 0x00, 0x00 };
+    Uint8 blocks[8 * 4 * 4];
+    const SDL_PixelFormat *formats;
+    SDL_Surface *referenceSurface;
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    SDL_bool supported = SDL_FALSE;
+    int i, ret;
+
+    formats = (const SDL_PixelFormat *)SDL_GetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, NULL);
+    for (i = 0; formats && formats[i] != SDL_PIXELFORMAT_UNKNOWN; ++i) {
+        if (formats[i] == SDL_PIXELFORMAT_BC1) {
+            supported = SDL_TRUE;
+        }
+    }
+
+    if (!supported) {
+        /* There is no fallback for compressed formats */
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_BC1, SDL_TEXTUREACCESS_STATIC, 16, 16);
+        SDLTest_AssertCheck(texture == NULL, "Verify SDL_CreateTexture() fails for unsupported compressed formats");
+        return TEST_COMPLETED;
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_BC1, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+    SDLTest_AssertCheck(texture == NULL, "Verify SDL_CreateTexture() fails for streaming compressed textures");
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_BC1, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture() result");
+    if (texture == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(blocks); i += sizeof(green_block)) {
+        SDL_memcpy(&blocks[i], green_block, sizeof(green_block));
+    }
+    CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, blocks, 8 * 4))
+
+    /* Updates have to cover whole blocks */
+    rect.x = 1;
+    rect.y = 0;
+    rect.w = 4;
+    rect.h = 4;
+    ret = SDL_UpdateTexture(texture, &rect, blocks, 8);
+    SDLTest_AssertCheck(ret < 0, "Validate result from unaligned SDL_UpdateTexture, expected: <0, got: %i", ret);
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_GREEN))
+
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, NULL))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing a mipmapped texture at a fraction of its size, after updating it.
+ */
+static int render_testMipmaps(void *arg)
+{
+    const int texture_w = TESTRENDER_SCREEN_W * 4;
+    const int texture_h = TESTRENDER_SCREEN_H * 4;
+    SDL_PropertiesID props;
+    SDL_Surface *referenceSurface;
+    SDL_Surface *surface;
+    SDL_Texture *texture;
+    SDL_bool mipmaps;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, RENDER_COMPARE_FORMAT);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, texture_w);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, texture_h);
+    SDL_SetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_MIPMAPS_BOOLEAN, SDL_TRUE);
+    texture = SDL_CreateTextureWithProperties(renderer, props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTextureWithProperties() result");
+    if (texture == NULL) {
+        return TEST_ABORTED;
+    }
+    mipmaps = SDL_GetBooleanProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_MIPMAPS_BOOLEAN, SDL_FALSE);
+    SDLTest_Log("Texture mipmaps: %s", mipmaps ? "true" : "false");
+
+    /* Fill the texture with red, draw it so the mipmaps are in use, then change it to green */
+    surface = SDL_CreateSurface(texture_w, texture_h, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (surface, NULL, SDL_MapSurfaceRGB(surface, 255, 0, 0)))
+    CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, surface->pixels, surface->pitch))
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, NULL))
+    CHECK_FUNC(SDL_FlushRenderer, (renderer))
+
+    CHECK_FUNC(SDL_FillSurfaceRect, (surface, NULL, RENDER_COLOR_GREEN))
+    CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, surface->pixels, surface->pitch))
+
+    /* Create expected result */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_GREEN))
+
+    /* The downscaled levels must reflect the update, with both filtering modes that use them */
+    clearScreen();
+    CHECK_FUNC(SDL_SetTextureScaleMode, (texture, SDL_SCALEMODE_LINEAR))
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, NULL))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    clearScreen();
+    CHECK_FUNC(SDL_SetTextureScaleMode, (texture, SDL_SCALEMODE_BEST))
+    CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, NULL))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroySurface(surface);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that destroyed transient render targets are reused.
+ */
+static int render_testTransientTarget(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_Surface *referenceSurface;
+    SDL_Texture *target, *reused, *other;
+    SDL_BlendMode blendMode;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, RENDER_COMPARE_FORMAT);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, SDL_TEXTUREACCESS_TARGET);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, TESTRENDER_SCREEN_W);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, TESTRENDER_SCREEN_H);
+    SDL_SetBooleanProperty(props, SDL_PROP_TEXTURE_CREATE_TRANSIENT_BOOLEAN, SDL_TRUE);
+
+    target = SDL_CreateTextureWithProperties(renderer, props);
+    SDLTest_AssertCheck(target != NULL, "Verify SDL_CreateTextureWithProperties() result");
+    if (target == NULL) {
+        SDL_DestroyProperties(props);
+        return TEST_ABORTED;
+    }
+    CHECK_FUNC(SDL_SetTextureBlendMode, (target, SDL_BLENDMODE_ADD))
+    CHECK_FUNC(SDL_SetRenderTarget, (renderer, target))
+    SDL_DestroyTexture(target);
+    SDLTest_AssertCheck(SDL_GetRenderTarget(renderer) == NULL, "Verify destroying the render target resets it");
+    SDLTest_AssertCheck(SDL_SetTextureBlendMode(target, SDL_BLENDMODE_NONE) < 0, "Verify a pooled texture can't be used");
+
+    /* A matching request gets the pooled texture back, with its state reset */
+    reused = SDL_CreateTextureWithProperties(renderer, props);
+    SDLTest_AssertCheck(reused == target, "Verify the render target was reused, expected: %p, got: %p", (void *)target, (void *)reused);
+    if (reused == NULL) {
+        SDL_DestroyProperties(props);
+        return TEST_ABORTED;
+    }
+    CHECK_FUNC(SDL_GetTextureBlendMode, (reused, &blendMode))
+    SDLTest_AssertCheck(blendMode == SDL_BLENDMODE_BLEND, "Validate reused blend mode, expected: %d, got: %d", SDL_BLENDMODE_BLEND, blendMode);
+
+    /* The pool is keyed by size */
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, TESTRENDER_SCREEN_W / 2);
+    other = SDL_CreateTextureWithProperties(renderer, props);
+    SDLTest_AssertCheck(other != NULL && other != reused, "Verify a different size gets a new render target");
+    SDL_DestroyProperties(props);
+
+    /* The reused target works like a new one */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_GREEN))
+
+    CHECK_FUNC(SDL_SetRenderTarget, (renderer, reused))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+    CHECK_FUNC(SDL_SetRenderTarget, (renderer, NULL))
+
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTexture, (renderer, reused, NULL, NULL))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_DestroyTexture(other);
+    SDL_DestroyTexture(reused);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests loading a BMP file straight into a texture
+ *
+ * \sa SDL_LoadBMPTexture
+ */
+static int render_testLoadBMPTexture(void *arg)
+{
+    const char *sampleFilename = "testLoadBMPTexture.bmp";
+    SDL_Surface *referenceSurface;
+    SDL_Surface *image;
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    SDL_FRect dst;
+    float tw, th;
+    int x, y, ret;
+
+    /* One a multiple of the row alignment wide, and one with padded rows */
+    for (x = 0; x < 2; ++x) {
+        const int w = TESTRENDER_SCREEN_W - x;
+
+        image = SDL_CreateSurface(w, TESTRENDER_SCREEN_H, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(image != NULL, "Verify SDL_CreateSurface() result");
+        if (!image) {
+            return TEST_ABORTED;
+        }
+        for (y = 0; y < image->h; ++y) {
+            rect.x = 0;
+            rect.y = y;
+            rect.w = w;
+            rect.h = 1;
+            CHECK_FUNC(SDL_FillSurfaceRect, (image, &rect, SDL_MapSurfaceRGB(image, (Uint8)(y * 4), 100, (Uint8)(255 - y * 4))))
+        }
+        ret = SDL_SaveBMP(image, sampleFilename);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SaveBMP, expected: 0, got: %i", ret);
+
+        referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+        CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, SDL_MapSurfaceRGB(referenceSurface, 0, 0, 0)))
+        CHECK_FUNC(SDL_BlitSurface, (image, NULL, referenceSurface, NULL))
+        SDL_DestroySurface(image);
+
+        clearScreen();
+
+        texture = SDL_LoadBMPTexture(renderer, sampleFilename);
+        SDLTest_AssertCheck(texture != NULL, "Verify SDL_LoadBMPTexture() result, got: %s", texture ? "texture" : SDL_GetError());
+        if (!texture) {
+            SDL_DestroySurface(referenceSurface);
+            SDL_RemovePath(sampleFilename);
+            return TEST_ABORTED;
+        }
+        CHECK_FUNC(SDL_GetTextureSize, (texture, &tw, &th))
+        SDLTest_AssertCheck(tw == (float)w && th == (float)TESTRENDER_SCREEN_H, "Verify texture size, expected: %dx%d, got: %gx%g", w, TESTRENDER_SCREEN_H, tw, th);
+
+        CHECK_FUNC(SDL_SetTextureBlendMode, (texture, SDL_BLENDMODE_NONE))
+        dst.x = 0.0f;
+        dst.y = 0.0f;
+        dst.w = (float)w;
+        dst.h = (float)TESTRENDER_SCREEN_H;
+        CHECK_FUNC(SDL_RenderTexture, (renderer, texture, NULL, &dst))
+        compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+        SDL_DestroyTexture(texture);
+        SDL_DestroySurface(referenceSurface);
+    }
+
+    /* Failures close the stream and don't leak a texture */
+    texture = SDL_LoadBMPTexture(renderer, "testLoadBMPTexture-missing.bmp");
+    SDLTest_AssertCheck(texture == NULL, "Verify SDL_LoadBMPTexture() fails for a missing file");
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    SDL_RemovePath(sampleFilename);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing batched thick lines and circles
+ *
+ * \sa SDL_RenderThickLines
+ * \sa SDL_RenderFillCircles
+ */
+static int render_testThickPrimitives(void *arg)
+{
+    SDL_Surface *target;
+    SDL_Renderer *shape_renderer;
+    SDL_FPoint points[3];
+    SDL_FPoint centers[2];
+    Uint8 r, g, b, a;
+    int ret;
+
+    target = SDL_CreateSurface(64, 64, RENDER_COMPARE_FORMAT);
+    SDLTest_AssertCheck(target != NULL, "Verify SDL_CreateSurface() result");
+    if (!target) {
+        return TEST_ABORTED;
+    }
+    shape_renderer = SDL_CreateSoftwareRenderer(target);
+    SDLTest_AssertCheck(shape_renderer != NULL, "Validate result from SDL_CreateSoftwareRenderer, expected: non-NULL");
+    if (!shape_renderer) {
+        SDL_DestroySurface(target);
+        return TEST_ABORTED;
+    }
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (shape_renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (shape_renderer))
+    CHECK_FUNC(SDL_SetRenderDrawBlendMode, (shape_renderer, SDL_BLENDMODE_BLEND))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (shape_renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+
+    /* An L shaped polyline, 5 pixels thick */
+    points[0].x = 8.0f;
+    points[0].y = 8.0f;
+    points[1].x = 8.0f;
+    points[1].y = 40.0f;
+    points[2].x = 40.0f;
+    points[2].y = 40.0f;
+    CHECK_FUNC(SDL_RenderThickLines, (shape_renderer, points, SDL_arraysize(points), 5.0f))
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (shape_renderer, 0, 255, 0, SDL_ALPHA_OPAQUE))
+    centers[0].x = 48.0f;
+    centers[0].y = 12.0f;
+    centers[1].x = 24.0f;
+    centers[1].y = 20.0f;
+    CHECK_FUNC(SDL_RenderFillCircles, (shape_renderer, centers, SDL_arraysize(centers), 6.0f))
+    CHECK_FUNC(SDL_FlushRenderer, (shape_renderer))
+
+    /* Inside each line, at the joint, and well clear of the shapes */
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 8, 24, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Verify vertical line pixel, expected: 255,0,0, got: %d,%d,%d", r, g, b);
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 24, 40, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Verify horizontal line pixel, expected: 255,0,0, got: %d,%d,%d", r, g, b);
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 8, 40, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Verify line joint pixel, expected: 255,0,0, got: %d,%d,%d", r, g, b);
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 16, 24, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Verify pixel beside the line, expected: 0,0,0, got: %d,%d,%d", r, g, b);
+
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 48, 12, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 0 && g == 255 && b == 0, "Verify circle center pixel, expected: 0,255,0, got: %d,%d,%d", r, g, b);
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 26, 22, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 0 && g == 255 && b == 0, "Verify pixel inside circle, expected: 0,255,0, got: %d,%d,%d", r, g, b);
+    CHECK_FUNC(SDL_ReadSurfacePixel, (target, 24, 30, &r, &g, &b, &a))
+    SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Verify pixel outside circle, expected: 0,0,0, got: %d,%d,%d", r, g, b);
+
+    ret = SDL_RenderThickLines(shape_renderer, points, SDL_arraysize(points), 0.0f);
+    SDLTest_AssertCheck(ret < 0, "Verify SDL_RenderThickLines() rejects a zero thickness, got: %d", ret);
+    ret = SDL_RenderFillCircles(shape_renderer, centers, SDL_arraysize(centers), -1.0f);
+    SDLTest_AssertCheck(ret < 0, "Verify SDL_RenderFillCircles() rejects a negative radius, got: %d", ret);
+
+    SDL_DestroyRenderer(shape_renderer);
+    SDL_DestroySurface(target);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests creating, updating and drawing from a layered texture
+ *
+ * \sa SDL_UpdateTextureLayer
+ * \sa SDL_RenderTextureLayer
+ */
+static int render_testTextureLayers(void *arg)
+{
+    const Uint32 colors[3] = { 0xFFFF0000, 0xFF00FF00, 0xFF0000FF };
+    SDL_Surface *target;
+    SDL_Renderer *layer_renderer;
+    SDL_Texture *texture;
+    SDL_PropertiesID props;
+    Uint32 pixels[4 * 4];
+    SDL_FRect dst;
+    Uint8 r, g, b, a;
+    float tw, th;
+    int i, j, ret;
+
+    target = SDL_CreateSurface(64, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(target != NULL, "Verify SDL_CreateSurface() result");
+    if (!target) {
+        return TEST_ABORTED;
+    }
+    layer_renderer = SDL_CreateSoftwareRenderer(target);
+    SDLTest_AssertCheck(layer_renderer != NULL, "Validate result from SDL_CreateSoftwareRenderer, expected: non-NULL");
+    if (!layer_renderer) {
+        SDL_DestroySurface(target);
+        return TEST_ABORTED;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, SDL_PIXELFORMAT_ARGB8888);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, 4);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, 4);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_LAYERS_NUMBER, SDL_arraysize(colors));
+    texture = SDL_CreateTextureWithProperties(layer_renderer, props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTextureWithProperties() result, got: %s", texture ? "texture" : SDL_GetError());
+    if (!texture) {
+        SDL_DestroyRenderer(layer_renderer);
+        SDL_DestroySurface(target);
+        return TEST_ABORTED;
+    }
+    CHECK_FUNC(SDL_GetTextureSize, (texture, &tw, &th))
+    SDLTest_AssertCheck(tw == 4.0f && th == 12.0f, "Verify texture size, expected: 4x12, got: %gx%g", tw, th);
+    ret = (int)SDL_GetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_LAYERS_NUMBER, 0);
+    SDLTest_AssertCheck(ret == 3, "Verify SDL_PROP_TEXTURE_LAYERS_NUMBER, expected: 3, got: %d", ret);
+
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        for (j = 0; j < SDL_arraysize(pixels); ++j) {
+            pixels[j] = colors[i];
+        }
+        CHECK_FUNC(SDL_UpdateTextureLayer, (texture, i, NULL, pixels, 4 * sizeof(Uint32)))
+    }
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (layer_renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (layer_renderer))
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        dst.x = i * 16.0f;
+        dst.y = 0.0f;
+        dst.w = 16.0f;
+        dst.h = 16.0f;
+        CHECK_FUNC(SDL_RenderTextureLayer, (layer_renderer, texture, SDL_arraysize(colors) - 1 - i, NULL, &dst))
+    }
+    CHECK_FUNC(SDL_FlushRenderer, (layer_renderer))
+
+    /* Each copy comes from a single layer, even along its edges */
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        const Uint32 expected = colors[SDL_arraysize(colors) - 1 - i];
+
+        for (j = 0; j < 16; j += 15) {
+            CHECK_FUNC(SDL_ReadSurfacePixel, (target, i * 16 + 8, j, &r, &g, &b, &a))
+            SDLTest_AssertCheck(r == ((expected >> 16) & 0xFF) && g == ((expected >> 8) & 0xFF) && b == (expected & 0xFF),
+                                "Verify pixel from layer %d at row %d, expected: 0x%.8" SDL_PRIX32 ", got: %d,%d,%d",
+                                (int)SDL_arraysize(colors) - 1 - i, j, expected, r, g, b);
+        }
+    }
+
+    ret = SDL_RenderTextureLayer(layer_renderer, texture, SDL_arraysize(colors), NULL, NULL);
+    SDLTest_AssertCheck(ret < 0, "Verify SDL_RenderTextureLayer() rejects an out of range layer, got: %d", ret);
+    ret = SDL_UpdateTextureLayer(texture, -1, NULL, pixels, 4 * sizeof(Uint32));
+    SDLTest_AssertCheck(ret < 0, "Verify SDL_UpdateTextureLayer() rejects an out of range layer, got: %d", ret);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(layer_renderer);
+    SDL_DestroySurface(target);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests drawing with a custom fragment shader
+ *
+ * \sa SDL_CreateRenderShader
+ * \sa SDL_SetRenderShader
+ * \sa SDL_DestroyRenderShader
+ */
+static int render_testCustomShader(void *arg)
+{
+    const char *invert_source =
+        "varying vec4 v_color;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(vec3(1.0) - v_color.rgb, v_color.a);\n"
+        "}\n";
+    SDL_RenderShader *shader;
+    SDL_PropertiesID props;
+    SDL_Surface *surface;
+    SDL_FRect rect;
+    Uint8 r, g, b, a;
+    int ret;
+
+    props = SDL_CreateProperties();
+    SDL_SetStringProperty(props, SDL_PROP_RENDER_SHADER_CREATE_GLSL_FRAGMENT_STRING, invert_source);
+    shader = SDL_CreateRenderShader(renderer, props);
+    SDL_DestroyProperties(props);
+    if (!shader) {
+        SDLTest_Log("Custom shaders aren't supported by the %s renderer: %s", SDL_GetRendererName(renderer), SDL_GetError());
+        CHECK_FUNC(SDL_SetRenderShader, (renderer, NULL))
+        return TEST_SKIPPED;
+    }
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+    CHECK_FUNC(SDL_RenderClear, (renderer))
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+
+    /* The left half is drawn inverted, the right half with the built-in shaders again */
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = TESTRENDER_SCREEN_W / 2.0f;
+    rect.h = TESTRENDER_SCREEN_H;
+    CHECK_FUNC(SDL_SetRenderShader, (renderer, shader))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+    CHECK_FUNC(SDL_SetRenderShader, (renderer, NULL))
+    rect.x = TESTRENDER_SCREEN_W / 2.0f;
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+
+    surface = SDL_RenderReadPixels(renderer, NULL);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got: %s", surface ? "surface" : SDL_GetError());
+    if (surface) {
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, TESTRENDER_SCREEN_W / 4, TESTRENDER_SCREEN_H / 2, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 0 && g == 255 && b == 255, "Verify shaded pixel, expected: 0,255,255, got: %d,%d,%d", r, g, b);
+        CHECK_FUNC(SDL_ReadSurfacePixel, (surface, TESTRENDER_SCREEN_W * 3 / 4, TESTRENDER_SCREEN_H / 2, &r, &g, &b, &a))
+        SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Verify unshaded pixel, expected: 255,0,0, got: %d,%d,%d", r, g, b);
+        SDL_DestroySurface(surface);
+    }
+
+    /* Destroying the current shader goes back to the built-in shaders */
+    CHECK_FUNC(SDL_SetRenderShader, (renderer, shader))
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+    SDL_DestroyRenderShader(shader);
+    ret = SDL_SetRenderShader(renderer, shader);
+    SDLTest_AssertCheck(ret < 0, "Verify SDL_SetRenderShader() rejects a destroyed shader, got: %d", ret);
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, NULL))
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Render test cases */
+static const SDLTest_TestCaseReference renderTestGetNumRenderDrivers = {
+    (SDLTest_TestCaseFp)render_testGetNumRenderDrivers, "render_testGetNumRenderDrivers", "Tests call to SDL_GetNumRenderDrivers", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestPrimitives = {
+    (SDLTest_TestCaseFp)render_testPrimitives, "render_testPrimitives", "Tests rendering primitives", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestPrimitivesWithViewport = {
+    (SDLTest_TestCaseFp)render_testPrimitivesWithViewport, "render_testPrimitivesWithViewport", "Tests rendering primitives within a viewport", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlit = {
+    (SDLTest_TestCaseFp)render_testBlit, "render_testBlit", "Tests blitting", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlitInstanced = {
+    (SDLTest_TestCaseFp)render_testBlitInstanced, "render_testBlitInstanced", "Tests instanced blitting", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestCommandList = {
+    (SDLTest_TestCaseFp)render_testCommandList, "render_testCommandList", "Tests recording and submitting render command lists", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlitTiled = {
+    (SDLTest_TestCaseFp)render_testBlitTiled, "render_testBlitTiled", "Tests tiled blitting", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlit9Grid = {
+    (SDLTest_TestCaseFp)render_testBlit9Grid, "render_testBlit9Grid", "Tests 9-grid blitting", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlitColor = {
+    (SDLTest_TestCaseFp)render_testBlitColor, "render_testBlitColor", "Tests blitting with color", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlendModes = {
+    (SDLTest_TestCaseFp)render_testBlendModes, "render_testBlendModes", "Tests rendering blend modes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestViewport = {
+    (SDLTest_TestCaseFp)render_testViewport, "render_testViewport", "Tests viewport", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestClipRect = {
+    (SDLTest_TestCaseFp)render_testClipRect, "render_testClipRect", "Tests clip rect", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestLogicalSize = {
+    (SDLTest_TestCaseFp)render_testLogicalSize, "render_testLogicalSize", "Tests logical size", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestUVWrapping = {
+    (SDLTest_TestCaseFp)render_testUVWrapping, "render_testUVWrapping", "Tests geometry UV wrapping", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestMergeGeometry = {
+    (SDLTest_TestCaseFp)render_testMergeGeometry, "render_testMergeGeometry", "Tests merging consecutive geometry draws", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBandedRendering = {
+    (SDLTest_TestCaseFp)render_testBandedRendering, "render_testBandedRendering", "Tests software rendering in bands on several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderStats = {
+    (SDLTest_TestCaseFp)render_testRenderStats, "render_testRenderStats", "Tests collecting rendering statistics", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestMemoryStats = {
+    (SDLTest_TestCaseFp)render_testMemoryStats, "render_testMemoryStats", "Tests texture memory statistics", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRedundantState = {
+    (SDLTest_TestCaseFp)render_testRedundantState, "render_testRedundantState", "Tests removing redundant state changes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestUpdateTextureAsync = {
+    (SDLTest_TestCaseFp)render_testUpdateTextureAsync, "render_testUpdateTextureAsync", "Tests scheduling texture updates", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestReadPixelsAsync = {
+    (SDLTest_TestCaseFp)render_testReadPixelsAsync, "render_testReadPixelsAsync", "Tests reading pixels back asynchronously", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestCompressedTexture = {
+    (SDLTest_TestCaseFp)render_testCompressedTexture, "render_testCompressedTexture", "Tests block compressed textures", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestMipmaps = {
+    (SDLTest_TestCaseFp)render_testMipmaps, "render_testMipmaps", "Tests mipmapped textures", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestTransientTarget = {
+    (SDLTest_TestCaseFp)render_testTransientTarget, "render_testTransientTarget", "Tests reusing transient render targets", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestLoadBMPTexture = {
+    (SDLTest_TestCaseFp)render_testLoadBMPTexture, "render_testLoadBMPTexture", "Tests loading BMP files into textures", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestThickPrimitives = {
+    (SDLTest_TestCaseFp)render_testThickPrimitives, "render_testThickPrimitives", "Tests drawing batched thick lines and circles", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestTextureLayers = {
+    (SDLTest_TestCaseFp)render_testTextureLayers, "render_testTextureLayers", "Tests layered textures", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestLargeVertexStream = {
+    (SDLTest_TestCaseFp)render_testLargeVertexStream, "render_testLargeVertexStream", "Tests streaming more vertices than fit in the vertex buffers in one frame", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestCommandQueueReserve = {
+    (SDLTest_TestCaseFp)render_testCommandQueueReserve, "render_testCommandQueueReserve", "Tests command queue preallocation and shrinking", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSoftwareThreadedPresent = {
+    (SDLTest_TestCaseFp)render_testSoftwareThreadedPresent, "render_testSoftwareThreadedPresent", "Tests presenting from a background thread with the software renderer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestAdvancedBlendOperations = {
+    (SDLTest_TestCaseFp)render_testAdvancedBlendOperations, "render_testAdvancedBlendOperations", "Tests the blend operations that read the render target", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestDebugText = {
+    (SDLTest_TestCaseFp)render_testDebugText, "render_testDebugText", "Tests drawing debug text from the built-in font atlas", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestCustomShader = {
+    (SDLTest_TestCaseFp)render_testCustomShader, "render_testCustomShader", "Tests drawing with a custom fragment shader", TEST_ENABLED
 };
 
 /* Sequence of Render test cases */
@@ -1593,6 +3214,8 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestPrimitives,
     &renderTestPrimitivesWithViewport,
     &renderTestBlit,
+    &renderTestBlitInstanced,
+    &renderTestCommandList,
     &renderTestBlitTiled,
     &renderTestBlit9Grid,
     &renderTestBlitColor,
@@ -1601,6 +3224,25 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestClipRect,
     &renderTestLogicalSize,
     &renderTestUVWrapping,
+    &renderTestMergeGeometry,
+    &renderTestBandedRendering,
+    &renderTestRenderStats,
+    &renderTestMemoryStats,
+    &renderTestLargeVertexStream,
+    &renderTestRedundantState,
+    &renderTestUpdateTextureAsync,
+    &renderTestReadPixelsAsync,
+    &renderTestCompressedTexture,
+    &renderTestMipmaps,
+    &renderTestTransientTarget,
+    &renderTestLoadBMPTexture,
+    &renderTestThickPrimitives,
+    &renderTestTextureLayers,
+    &renderTestCustomShader,
+    &renderTestCommandQueueReserve,
+    &renderTestSoftwareThreadedPresent,
+    &renderTestAdvancedBlendOperations,
+    &renderTestDebugText,
     NULL
 };
 
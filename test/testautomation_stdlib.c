@@ -912,6 +912,59 @@ static int stdlib_aligned_alloc(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Calls to SDL_CreateMemoryArena, SDL_AllocateArenaMemory, SDL_ResetMemoryArena and SDL_DestroyMemoryArena
+ */
+static int stdlib_memory_arena(void *arg)
+{
+    const size_t alignment = 2 * sizeof(void *);
+    SDL_MemoryArena *arena;
+    Uint8 *first = NULL;
+    Uint8 *ptr;
+    size_t i, size;
+
+    arena = SDL_CreateMemoryArena(256);
+    SDLTest_AssertPass("Call to SDL_CreateMemoryArena(256)");
+    SDLTest_AssertCheck(arena != NULL, "Check output, expected non-NULL, got: %p", (void *)arena);
+    if (!arena) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < 100; ++i) {
+        size = (i * 37) % 300;
+        ptr = (Uint8 *)SDL_AllocateArenaMemory(arena, size);
+        if (!ptr || (((size_t)ptr) % alignment) != 0) {
+            break;
+        }
+        if (i == 0) {
+            first = ptr;
+        }
+        SDL_memset(ptr, (int)i, size);
+    }
+    SDLTest_AssertPass("Call to SDL_AllocateArenaMemory() with sizes 0 through 299");
+    SDLTest_AssertCheck(i == 100, "Check all allocations succeeded and were aligned, expected 100, got: %" SIZE_FORMAT, i);
+
+    SDL_ResetMemoryArena(arena);
+    SDLTest_AssertPass("Call to SDL_ResetMemoryArena()");
+    ptr = (Uint8 *)SDL_AllocateArenaMemory(arena, 16);
+    SDLTest_AssertCheck(ptr == first, "Check memory is reused after reset, expected %p, got: %p", (void *)first, (void *)ptr);
+
+    ptr = (Uint8 *)SDL_AllocateArenaMemory(arena, 4096);
+    SDLTest_AssertPass("Call to SDL_AllocateArenaMemory(4096)");
+    SDLTest_AssertCheck(ptr != NULL, "Check allocation larger than the block size, expected non-NULL, got: %p", (void *)ptr);
+    if (ptr) {
+        SDL_memset(ptr, 0xAA, 4096);
+    }
+
+    ptr = (Uint8 *)SDL_AllocateArenaMemory(NULL, 16);
+    SDLTest_AssertCheck(ptr == NULL, "Check SDL_AllocateArenaMemory(NULL) fails, got: %p", (void *)ptr);
+
+    SDL_DestroyMemoryArena(arena);
+    SDLTest_AssertPass("Call to SDL_DestroyMemoryArena()");
+
+    return TEST_COMPLETED;
+}
+
 typedef struct
 {
     size_t a;
@@ -1188,6 +1241,126 @@ stdlib_iconv(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Calls to UTF-8 routines with long ASCII runs mixed with other characters
+ */
+static int
+stdlib_utf8(void *arg)
+{
+    /* 20 ASCII characters, U+00C9 and U+1F4BB, then 18 more ASCII characters */
+    const char *text = "Hello, world! ABCDEF\xc3\x89\xf0\x9f\x92\xbb" "abcdefghijklmnopqr";
+    const Uint16 expected16[] = { 'H', 'e', 'l', 'l', 'o', ',', ' ', 'w', 'o', 'r', 'l', 'd', '!', ' ', 'A', 'B', 'C', 'D', 'E', 'F', 0xc9, 0xd83d, 0xdcbb };
+    const char *ascii = "The quick brown fox jumps over the lazy dog";
+    Uint16 *utf16;
+    Uint8 *utf32;
+    size_t len;
+    size_t i;
+    int result;
+
+    len = SDL_utf8strlen(text);
+    SDLTest_AssertPass("Call to SDL_utf8strlen(\"%s\")", text);
+    SDLTest_AssertCheck(len == 40, "Check result value, expected: 40, got: %d", (int)len);
+
+    len = SDL_utf8strnlen(text, 22);
+    SDLTest_AssertPass("Call to SDL_utf8strnlen(\"%s\", 22)", text);
+    SDLTest_AssertCheck(len == 21, "Check result value, expected: 21, got: %d", (int)len);
+
+    len = SDL_utf8strnlen("Hello, world! ABCDEF\0GHIJKLMNOP", 32);
+    SDLTest_AssertPass("Call to SDL_utf8strnlen() with an embedded null");
+    SDLTest_AssertCheck(len == 20, "Check result value, expected: 20, got: %d", (int)len);
+
+    result = SDL_strcasecmp(ascii, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG");
+    SDLTest_AssertPass("Call to SDL_strcasecmp() with ASCII");
+    SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %d", result);
+
+    result = SDL_strcasecmp(ascii, "The quick brown fox jumps over the lazy cat");
+    SDLTest_AssertPass("Call to SDL_strcasecmp() with a difference at the end");
+    SDLTest_AssertCheck(result > 0, "Check result value, expected: >0, got: %d", result);
+
+    result = SDL_strcasecmp("\xc3\x89T\xc3\x89", "\xc3\xa9t\xc3\xa9");
+    SDLTest_AssertPass("Call to SDL_strcasecmp() with non-ASCII case folding");
+    SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %d", result);
+
+    result = SDL_strncasecmp("HELLO, WORLD! abcdef\xc3\x89x", "hello, world! ABCDEF\xc3\xa9y", 22);
+    SDLTest_AssertPass("Call to SDL_strncasecmp() stopping after a non-ASCII character");
+    SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %d", result);
+
+    result = SDL_strncasecmp("Hello", "Help", 3);
+    SDLTest_AssertPass("Call to SDL_strncasecmp(\"Hello\", \"Help\", 3)");
+    SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %d", result);
+
+    utf16 = (Uint16 *)SDL_iconv_string("UTF-16LE", "UTF-8", text, SDL_strlen(text) + 1);
+    SDLTest_AssertPass("Call to SDL_iconv_string(\"UTF-16LE\", \"UTF-8\", ...)");
+    SDLTest_AssertCheck(utf16 != NULL, "Check result value, expected: non-NULL");
+    if (utf16) {
+        SDL_bool match = SDL_TRUE;
+        for (i = 0; i < SDL_arraysize(expected16); ++i) {
+            const Uint8 *bytes = (const Uint8 *)&utf16[i];
+            if ((bytes[0] | (bytes[1] << 8)) != expected16[i]) {
+                match = SDL_FALSE;
+            }
+        }
+        SDLTest_AssertCheck(match, "Check converted UTF-16LE text");
+        SDL_free(utf16);
+    }
+
+    utf32 = (Uint8 *)SDL_iconv_string("UTF-32BE", "UTF-8", ascii, SDL_strlen(ascii) + 1);
+    SDLTest_AssertPass("Call to SDL_iconv_string(\"UTF-32BE\", \"UTF-8\", ...)");
+    SDLTest_AssertCheck(utf32 != NULL, "Check result value, expected: non-NULL");
+    if (utf32) {
+        SDL_bool match = SDL_TRUE;
+        for (i = 0; i <= SDL_strlen(ascii); ++i) {
+            const Uint8 *bytes = &utf32[i * 4];
+            if (bytes[0] || bytes[1] || bytes[2] || bytes[3] != (Uint8)ascii[i]) {
+                match = SDL_FALSE;
+            }
+        }
+        SDLTest_AssertCheck(match, "Check converted UTF-32BE text");
+        SDL_free(utf32);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Calls to SDL_crc16 and SDL_crc32
+ */
+static int
+stdlib_crc(void *arg)
+{
+    Uint8 data[1000];
+    Uint32 crc32, split32;
+    Uint16 crc16, split16;
+    size_t i;
+
+    crc32 = SDL_crc32(0, "123456789", 9);
+    SDLTest_AssertPass("Call to SDL_crc32(0, \"123456789\", 9)");
+    SDLTest_AssertCheck(crc32 == 0xCBF43926, "Check result value, expected: 0xCBF43926, got: 0x%.8" SDL_PRIX32, crc32);
+
+    crc16 = SDL_crc16(0, "123456789", 9);
+    SDLTest_AssertPass("Call to SDL_crc16(0, \"123456789\", 9)");
+    SDLTest_AssertCheck(crc16 == 0xBB3D, "Check result value, expected: 0xBB3D, got: 0x%.4x", crc16);
+
+    for (i = 0; i < SDL_arraysize(data); ++i) {
+        data[i] = (Uint8)(i * 31 + (i >> 3));
+    }
+
+    /* Checksumming in pieces must match checksumming in one go, whatever path handles each piece */
+    crc32 = SDL_crc32(0, data, sizeof(data));
+    crc16 = SDL_crc16(0, data, sizeof(data));
+    for (i = 0; i < sizeof(data); i += 37) {
+        split32 = SDL_crc32(SDL_crc32(0, data, i), data + i, sizeof(data) - i);
+        split16 = SDL_crc16(SDL_crc16(0, data, i), data + i, sizeof(data) - i);
+        if (split32 != crc32 || split16 != crc16) {
+            break;
+        }
+    }
+    SDLTest_AssertPass("Call to SDL_crc32() and SDL_crc16() on split buffers");
+    SDLTest_AssertCheck(i >= sizeof(data), "Check split results match, failed at offset: %d", (int)i);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Standard C routine test cases */
@@ -1223,6 +1396,18 @@ static const SDLTest_TestCaseReference stdlibTest_aligned_alloc = {
     stdlib_aligned_alloc, "stdlib_aligned_alloc", "Call to SDL_aligned_alloc", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTest_memory_arena = {
+    stdlib_memory_arena, "stdlib_memory_arena", "Calls to SDL memory arena functions", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTestUTF8 = {
+    stdlib_utf8, "stdlib_utf8", "Calls to UTF-8 string routines", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTestCRC = {
+    stdlib_crc, "stdlib_crc", "Calls to SDL_crc16 and SDL_crc32", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference stdlibTestOverflow = {
     stdlib_overflow, "stdlib_overflow", "Overflow detection", TEST_ENABLED
 };
@@ -1241,8 +1426,11 @@ static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest_getsetenv,
     &stdlibTest_sscanf,
     &stdlibTest_aligned_alloc,
+    &stdlibTest_memory_arena,
     &stdlibTestOverflow,
     &stdlibIconv,
+    &stdlibTestUTF8,
+    &stdlibTestCRC,
     NULL
 };
 
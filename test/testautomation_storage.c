@@ -0,0 +1,331 @@
+/**
+ * Storage test suite
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+static const char *ArchiveTestFilename = "storage_test.zip";
+static const char *StorageTestDirectory = "storage_test_dir";
+
+typedef struct ArchiveTestEntry
+{
+    const char *name;
+    const char *data;
+    Uint32 offset;
+} ArchiveTestEntry;
+
+/* Helper functions */
+
+/* Write a ZIP archive with the given entries stored uncompressed, the way
+   "zip -0" would. The CRCs are left zero, which the reader doesn't check. */
+static SDL_bool WriteTestArchive(const char *file, ArchiveTestEntry *entries, int num_entries, Uint16 method)
+{
+    SDL_IOStream *io = SDL_IOFromFile(file, "wb");
+    SDL_bool result = SDL_TRUE;
+    Sint64 cd_offset, cd_end;
+    int i;
+
+    if (!io) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < num_entries; ++i) {
+        const Uint16 name_length = (Uint16)SDL_strlen(entries[i].name);
+        const Uint32 size = (Uint32)SDL_strlen(entries[i].data);
+
+        entries[i].offset = (Uint32)SDL_TellIO(io);
+        result = result && SDL_WriteU32LE(io, 0x04034b50);
+        result = result && SDL_WriteU16LE(io, 10);           /* version needed */
+        result = result && SDL_WriteU16LE(io, 0);            /* flags */
+        result = result && SDL_WriteU16LE(io, method);
+        result = result && SDL_WriteU16LE(io, 0);            /* time */
+        result = result && SDL_WriteU16LE(io, (44 << 9) | (3 << 5) | 15); /* 2024-03-15 */
+        result = result && SDL_WriteU32LE(io, 0);            /* crc32 */
+        result = result && SDL_WriteU32LE(io, size);
+        result = result && SDL_WriteU32LE(io, size);
+        result = result && SDL_WriteU16LE(io, name_length);
+        result = result && SDL_WriteU16LE(io, 4);            /* extra length */
+        result = result && SDL_WriteIO(io, entries[i].name, name_length) == name_length;
+        result = result && SDL_WriteU32LE(io, 0);            /* an empty padding extra field */
+        result = result && SDL_WriteIO(io, entries[i].data, size) == size;
+    }
+
+    cd_offset = SDL_TellIO(io);
+    for (i = 0; i < num_entries; ++i) {
+        const Uint16 name_length = (Uint16)SDL_strlen(entries[i].name);
+        const Uint32 size = (Uint32)SDL_strlen(entries[i].data);
+
+        result = result && SDL_WriteU32LE(io, 0x02014b50);
+        result = result && SDL_WriteU16LE(io, 20);           /* version made by */
+        result = result && SDL_WriteU16LE(io, 10);           /* version needed */
+        result = result && SDL_WriteU16LE(io, 0);            /* flags */
+        result = result && SDL_WriteU16LE(io, method);
+        result = result && SDL_WriteU16LE(io, 0);            /* time */
+        result = result && SDL_WriteU16LE(io, (44 << 9) | (3 << 5) | 15);
+        result = result && SDL_WriteU32LE(io, 0);            /* crc32 */
+        result = result && SDL_WriteU32LE(io, size);
+        result = result && SDL_WriteU32LE(io, size);
+        result = result && SDL_WriteU16LE(io, name_length);
+        result = result && SDL_WriteU16LE(io, 0);            /* extra length */
+        result = result && SDL_WriteU16LE(io, 0);            /* comment length */
+        result = result && SDL_WriteU16LE(io, 0);            /* disk number */
+        result = result && SDL_WriteU16LE(io, 0);            /* internal attributes */
+        result = result && SDL_WriteU32LE(io, 0);            /* external attributes */
+        result = result && SDL_WriteU32LE(io, entries[i].offset);
+        result = result && SDL_WriteIO(io, entries[i].name, name_length) == name_length;
+    }
+    cd_end = SDL_TellIO(io);
+
+    result = result && SDL_WriteU32LE(io, 0x06054b50);
+    result = result && SDL_WriteU16LE(io, 0);                /* disk number */
+    result = result && SDL_WriteU16LE(io, 0);                /* central directory disk */
+    result = result && SDL_WriteU16LE(io, (Uint16)num_entries);
+    result = result && SDL_WriteU16LE(io, (Uint16)num_entries);
+    result = result && SDL_WriteU32LE(io, (Uint32)(cd_end - cd_offset));
+    result = result && SDL_WriteU32LE(io, (Uint32)cd_offset);
+    result = result && SDL_WriteU16LE(io, 7);                /* comment length */
+    result = result && SDL_WriteIO(io, "comment", 7) == 7;
+
+    if (SDL_CloseIO(io) < 0) {
+        result = SDL_FALSE;
+    }
+    return result;
+}
+
+static int SDLCALL CountArchiveEntries(void *userdata, const char *dirname, const char *fname)
+{
+    int *count = (int *)userdata;
+    ++*count;
+    return 1;
+}
+
+/* Test case functions */
+
+/**
+ * Opens a ZIP archive with SDL_OpenArchiveStorage and checks the paths in it.
+ */
+static int storage_testArchive(void *arg)
+{
+    ArchiveTestEntry entries[] = {
+        { "readme.txt", "Hello, archive!", 0 },
+        { "data/", "", 0 },
+        { "data/level1.map", "level one", 0 },
+        { "data/level2.map", "level two", 0 },
+        { "sounds/sfx/jump.wav", "boing", 0 },
+    };
+    SDL_Storage *storage;
+    SDL_PathInfo info;
+    char buffer[64];
+    Uint64 size = 0;
+    char **matches;
+    int count, result;
+
+    SDLTest_AssertCheck(WriteTestArchive(ArchiveTestFilename, entries, SDL_arraysize(entries), 0), "Write the test archive");
+
+    storage = SDL_OpenArchiveStorage(ArchiveTestFilename);
+    SDLTest_AssertPass("Call to SDL_OpenArchiveStorage()");
+    SDLTest_AssertCheck(storage != NULL, "Verify storage is not NULL, got error: %s", storage ? "none" : SDL_GetError());
+    if (!storage) {
+        SDL_RemovePath(ArchiveTestFilename);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_StorageReady(storage), "Verify storage is ready");
+
+    result = SDL_GetStorageFileSize(storage, "readme.txt", &size);
+    SDLTest_AssertCheck(result == 0 && size == 15, "Verify size of readme.txt, expected 15, got %d", (int)size);
+
+    SDL_zero(buffer);
+    result = SDL_ReadStorageFile(storage, "readme.txt", buffer, size);
+    SDLTest_AssertCheck(result == 0 && SDL_strcmp(buffer, "Hello, archive!") == 0, "Verify contents of readme.txt, got \"%s\"", buffer);
+
+    SDL_zero(buffer);
+    result = SDL_ReadStorageFile(storage, "sounds/sfx/jump.wav", buffer, 5);
+    SDLTest_AssertCheck(result == 0 && SDL_strcmp(buffer, "boing") == 0, "Verify contents of a nested file, got \"%s\"", buffer);
+
+    SDL_zero(info);
+    result = SDL_GetStoragePathInfo(storage, "sounds/sfx", &info);
+    SDLTest_AssertCheck(result == 0 && info.type == SDL_PATHTYPE_DIRECTORY, "Verify an implied directory exists");
+
+    SDL_zero(info);
+    result = SDL_GetStoragePathInfo(storage, "data/level2.map", &info);
+    SDLTest_AssertCheck(result == 0 && info.type == SDL_PATHTYPE_FILE && info.size == 9, "Verify path info of data/level2.map");
+    SDLTest_AssertCheck(info.modify_time != 0, "Verify the modification time is set");
+
+    count = 0;
+    result = SDL_EnumerateStorageDirectory(storage, "", CountArchiveEntries, &count);
+    SDLTest_AssertCheck(result == 0 && count == 3, "Verify enumerating the root, expected 3 entries, got %d", count);
+
+    count = 0;
+    result = SDL_EnumerateStorageDirectory(storage, "data", CountArchiveEntries, &count);
+    SDLTest_AssertCheck(result == 0 && count == 2, "Verify enumerating data, expected 2 entries, got %d", count);
+
+    count = 0;
+    matches = SDL_GlobStorageDirectory(storage, "", "*/*.map", SDL_GLOB_CASEINSENSITIVE, &count);
+    SDLTest_AssertCheck(matches != NULL && count == 2, "Verify globbing */*.map, expected 2 matches, got %d", count);
+    SDL_free(matches);
+
+    result = SDL_GetStoragePathInfo(storage, "missing.txt", &info);
+    SDLTest_AssertCheck(result < 0, "Verify a missing path fails");
+
+    result = SDL_ReadStorageFile(storage, "data", buffer, 0);
+    SDLTest_AssertCheck(result < 0, "Verify reading a directory fails");
+
+    result = SDL_ReadStorageFile(storage, "readme.txt", buffer, sizeof(buffer));
+    SDLTest_AssertCheck(result < 0, "Verify reading past the end of a file fails");
+
+    result = SDL_WriteStorageFile(storage, "new.txt", "x", 1);
+    SDLTest_AssertCheck(result < 0, "Verify the archive is read-only");
+
+    SDL_CloseStorage(storage);
+    SDL_RemovePath(ArchiveTestFilename);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Writes files in a transaction, and checks they only change when it's committed.
+ */
+static int storage_testTransaction(void *arg)
+{
+    SDL_Storage *storage;
+    char buffer[32];
+    Uint64 size = 0;
+    int result;
+
+    SDL_CreateDirectory(StorageTestDirectory);
+    storage = SDL_OpenFileStorage(StorageTestDirectory);
+    SDLTest_AssertPass("Call to SDL_OpenFileStorage()");
+    SDLTest_AssertCheck(storage != NULL, "Verify storage is not NULL, got error: %s", storage ? "none" : SDL_GetError());
+    if (!storage) {
+        return TEST_ABORTED;
+    }
+
+    result = SDL_WriteStorageFile(storage, "save.dat", "0123456789", 10);
+    SDLTest_AssertCheck(result == 0, "Write save.dat");
+
+    result = SDL_WriteStorageFileRange(storage, "save.dat", 2, "ab", 2);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_WriteStorageFileRange() outside a transaction");
+    SDL_zero(buffer);
+    SDL_ReadStorageFile(storage, "save.dat", buffer, 10);
+    SDLTest_AssertCheck(SDL_strcmp(buffer, "01ab456789") == 0, "Verify the range was written in place, got \"%s\"", buffer);
+
+    result = SDL_BeginStorageTransaction(storage);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_BeginStorageTransaction()");
+    result = SDL_BeginStorageTransaction(storage);
+    SDLTest_AssertCheck(result < 0, "Verify transactions can't be nested");
+
+    result = SDL_WriteStorageFileRange(storage, "save.dat", 8, "xyz", 3);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_WriteStorageFileRange() in a transaction");
+    result = SDL_WriteStorageFile(storage, "other.dat", "new", 3);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_WriteStorageFile() in a transaction");
+
+    SDL_zero(buffer);
+    SDL_ReadStorageFile(storage, "save.dat", buffer, 10);
+    SDLTest_AssertCheck(SDL_strcmp(buffer, "01ab456789") == 0, "Verify save.dat is unchanged before commit, got \"%s\"", buffer);
+    result = SDL_GetStoragePathInfo(storage, "other.dat", NULL);
+    SDLTest_AssertCheck(result < 0, "Verify other.dat doesn't exist before commit");
+
+    result = SDL_CommitStorageTransaction(storage);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_CommitStorageTransaction()");
+
+    SDL_zero(buffer);
+    SDL_GetStorageFileSize(storage, "save.dat", &size);
+    SDL_ReadStorageFile(storage, "save.dat", buffer, size);
+    SDLTest_AssertCheck(size == 11 && SDL_strcmp(buffer, "01ab4567xyz") == 0, "Verify save.dat after commit, got \"%s\"", buffer);
+    SDL_zero(buffer);
+    SDL_ReadStorageFile(storage, "other.dat", buffer, 3);
+    SDLTest_AssertCheck(SDL_strcmp(buffer, "new") == 0, "Verify other.dat after commit, got \"%s\"", buffer);
+    result = SDL_GetStoragePathInfo(storage, "save.dat.sdlpending", NULL);
+    SDLTest_AssertCheck(result < 0, "Verify no temporary file is left behind");
+
+    result = SDL_BeginStorageTransaction(storage);
+    SDLTest_AssertCheck(result == 0, "Begin a transaction to roll back");
+    SDL_WriteStorageFile(storage, "save.dat", "discarded", 9);
+    result = SDL_RollbackStorageTransaction(storage);
+    SDLTest_AssertCheck(result == 0, "Call to SDL_RollbackStorageTransaction()");
+    SDL_zero(buffer);
+    SDL_ReadStorageFile(storage, "save.dat", buffer, 11);
+    SDLTest_AssertCheck(SDL_strcmp(buffer, "01ab4567xyz") == 0, "Verify save.dat is unchanged after rollback, got \"%s\"", buffer);
+    result = SDL_CommitStorageTransaction(storage);
+    SDLTest_AssertCheck(result < 0, "Verify committing without a transaction fails");
+
+    SDL_RemoveStoragePath(storage, "save.dat");
+    SDL_RemoveStoragePath(storage, "other.dat");
+    SDL_CloseStorage(storage);
+    SDL_RemovePath(StorageTestDirectory);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks that SDL_OpenArchiveStorage rejects files it can't read.
+ */
+static int storage_testArchiveInvalid(void *arg)
+{
+    ArchiveTestEntry entries[] = {
+        { "packed.bin", "not really deflated", 0 },
+    };
+    SDL_Storage *storage;
+    SDL_IOStream *io;
+    char buffer[32];
+    int result;
+
+    io = SDL_IOFromFile(ArchiveTestFilename, "wb");
+    SDLTest_AssertCheck(io != NULL, "Create a file that isn't an archive");
+    if (io) {
+        SDL_WriteIO(io, "This is not a ZIP archive, just some text.", 42);
+        SDL_CloseIO(io);
+    }
+    storage = SDL_OpenArchiveStorage(ArchiveTestFilename);
+    SDLTest_AssertCheck(storage == NULL, "Verify opening a non-archive fails");
+    SDL_CloseStorage(storage);
+
+    storage = SDL_OpenArchiveStorage("storage_test_missing.zip");
+    SDLTest_AssertCheck(storage == NULL, "Verify opening a missing file fails");
+
+    /* Compressed entries are indexed but can't be read */
+    SDLTest_AssertCheck(WriteTestArchive(ArchiveTestFilename, entries, SDL_arraysize(entries), 8), "Write an archive with a deflated entry");
+    storage = SDL_OpenArchiveStorage(ArchiveTestFilename);
+    SDLTest_AssertCheck(storage != NULL, "Verify storage is not NULL, got error: %s", storage ? "none" : SDL_GetError());
+    if (storage) {
+        Uint64 size = 0;
+        result = SDL_GetStorageFileSize(storage, "packed.bin", &size);
+        SDLTest_AssertCheck(result == 0 && size == 19, "Verify size of a deflated entry");
+        result = SDL_ReadStorageFile(storage, "packed.bin", buffer, size);
+        SDLTest_AssertCheck(result < 0, "Verify reading a deflated entry fails");
+        SDL_CloseStorage(storage);
+    }
+
+    SDL_RemovePath(ArchiveTestFilename);
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Storage test cases */
+static const SDLTest_TestCaseReference storageTest1 = {
+    (SDLTest_TestCaseFp)storage_testArchive, "storage_testArchive", "Read files and directories from a ZIP archive", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference storageTest2 = {
+    (SDLTest_TestCaseFp)storage_testArchiveInvalid, "storage_testArchiveInvalid", "Reject archives and entries that can't be read", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference storageTest3 = {
+    (SDLTest_TestCaseFp)storage_testTransaction, "storage_testTransaction", "Write files in a transaction and commit or roll it back", TEST_ENABLED
+};
+
+/* Sequence of Storage test cases */
+static const SDLTest_TestCaseReference *storageTests[] = {
+    &storageTest1, &storageTest2, &storageTest3, NULL
+};
+
+/* Storage test suite (global) */
+SDLTest_TestSuiteReference storageTestSuite = {
+    "Storage",
+    NULL,
+    storageTests,
+    NULL
+};
@@ -13,6 +13,7 @@
 #define ISNAN(X)    isnan((float)(X))
 
 /* Test collections */
+extern SDLTest_TestSuiteReference asyncioTestSuite;
 extern SDLTest_TestSuiteReference audioTestSuite;
 extern SDLTest_TestSuiteReference clipboardTestSuite;
 extern SDLTest_TestSuiteReference eventsTestSuite;
@@ -34,8 +35,10 @@ extern SDLTest_TestSuiteReference renderTestSuite;
 extern SDLTest_TestSuiteReference iostrmTestSuite;
 extern SDLTest_TestSuiteReference sdltestTestSuite;
 extern SDLTest_TestSuiteReference stdlibTestSuite;
+extern SDLTest_TestSuiteReference storageTestSuite;
 extern SDLTest_TestSuiteReference subsystemsTestSuite;
 extern SDLTest_TestSuiteReference surfaceTestSuite;
+extern SDLTest_TestSuiteReference threadTestSuite;
 extern SDLTest_TestSuiteReference timeTestSuite;
 extern SDLTest_TestSuiteReference timerTestSuite;
 extern SDLTest_TestSuiteReference videoTestSuite;
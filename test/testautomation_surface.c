@@ -920,6 +920,263 @@ static int surface_testBlitBlendMul(void *arg)
     return TEST_COMPLETED;
 }
 
+static Uint8 MultDiv255(Uint32 a, Uint32 b)
+{
+    Uint32 x = a * b + 1;
+    return (Uint8)((x + (x >> 8)) >> 8);
+}
+
+/**
+ * Tests color and alpha modulated blending between 32-bit formats against a reference implementation
+ */
+static int surface_testBlitModulateBlend(void *arg)
+{
+    const SDL_PixelFormat src_formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888
+    };
+    const SDL_PixelFormat dst_formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888
+    };
+    const int w = 37, h = 3;
+    const Uint8 modR = 200, modG = 100, modB = 50, modA = 180;
+    int i, j, mode, x, y;
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+            for (mode = 0; mode < 3; ++mode) {
+                SDL_Surface *src = SDL_CreateSurface(w, h, src_formats[i]);
+                SDL_Surface *dst = SDL_CreateSurface(w, h, dst_formats[j]);
+                SDL_Surface *orig;
+                const SDL_PixelFormatDetails *src_details = SDL_GetPixelFormatDetails(src_formats[i]);
+                const SDL_PixelFormatDetails *dst_details = SDL_GetPixelFormatDetails(dst_formats[j]);
+                const SDL_bool blend = (mode > 0);
+                const SDL_bool alphamod = (mode > 1);
+                Uint32 seed = 1;
+                int errors = 0;
+
+                SDLTest_AssertCheck(src && dst, "SDL_CreateSurface()");
+                if (!src || !dst) {
+                    SDL_DestroySurface(src);
+                    SDL_DestroySurface(dst);
+                    return TEST_ABORTED;
+                }
+                for (y = 0; y < h; ++y) {
+                    for (x = 0; x < w; ++x) {
+                        seed = seed * 1103515245 + 12345;
+                        ((Uint32 *)((Uint8 *)src->pixels + y * src->pitch))[x] = seed;
+                        seed = seed * 1103515245 + 12345;
+                        ((Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch))[x] = seed;
+                    }
+                }
+                SDL_SetSurfaceColorMod(src, modR, modG, modB);
+                SDL_SetSurfaceAlphaMod(src, alphamod ? modA : 255);
+                SDL_SetSurfaceBlendMode(src, blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+
+                orig = SDL_DuplicateSurface(dst);
+                SDLTest_AssertCheck(orig != NULL, "SDL_DuplicateSurface()");
+                CHECK_FUNC(SDL_BlitSurface, (src, NULL, dst, NULL));
+
+                for (y = 0; orig && y < h && errors == 0; ++y) {
+                    for (x = 0; x < w; ++x) {
+                        Uint32 s = ((Uint32 *)((Uint8 *)src->pixels + y * src->pitch))[x];
+                        Uint32 d = ((Uint32 *)((Uint8 *)orig->pixels + y * orig->pitch))[x];
+                        Uint32 actual = ((Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch))[x];
+                        Uint8 sR, sG, sB, sA, dR, dG, dB, dA;
+                        Uint8 eR, eG, eB, eA, aR, aG, aB, aA;
+
+                        SDL_GetRGBA(s, src_details, NULL, &sR, &sG, &sB, &sA);
+                        SDL_GetRGBA(d, dst_details, NULL, &dR, &dG, &dB, &dA);
+                        sR = MultDiv255(sR, modR);
+                        sG = MultDiv255(sG, modG);
+                        sB = MultDiv255(sB, modB);
+                        if (alphamod) {
+                            sA = MultDiv255(sA, modA);
+                        }
+                        if (blend) {
+                            eR = MultDiv255(dR, 255 - sA) + MultDiv255(sR, sA);
+                            eG = MultDiv255(dG, 255 - sA) + MultDiv255(sG, sA);
+                            eB = MultDiv255(dB, 255 - sA) + MultDiv255(sB, sA);
+                            eA = MultDiv255(dA, 255 - sA) + sA;
+                        } else {
+                            eR = sR;
+                            eG = sG;
+                            eB = sB;
+                            eA = sA;
+                        }
+                        if (!SDL_ISPIXELFORMAT_ALPHA(dst_formats[j])) {
+                            eA = 255;
+                        }
+
+                        SDL_GetRGBA(actual, dst_details, NULL, &aR, &aG, &aB, &aA);
+                        if (aR != eR || aG != eG || aB != eB || aA != eA) {
+                            SDLTest_AssertCheck(SDL_FALSE, "Checking %s -> %s blit (mode %d) at %d,%d, expected %d,%d,%d,%d, got %d,%d,%d,%d",
+                                                SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]), mode, x, y,
+                                                eR, eG, eB, eA, aR, aG, aB, aA);
+                            ++errors;
+                            break;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(errors == 0, "Checking %s -> %s blit (mode %d)",
+                                    SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]), mode);
+
+                SDL_DestroySurface(orig);
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that blits split across threads match blits on a single thread
+ */
+static int surface_testBlitThreads(void *arg)
+{
+    const int w = 640, h = 480;
+    SDL_Surface *src, *dst, *serial, *threaded;
+    Uint32 seed = 1;
+    int i, x, y, ret;
+
+    src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    dst = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src && dst, "SDL_CreateSurface()");
+    if (!src || !dst) {
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < h; ++y) {
+        for (x = 0; x < w; ++x) {
+            seed = seed * 1103515245 + 12345;
+            ((Uint32 *)((Uint8 *)src->pixels + y * src->pitch))[x] = seed;
+            seed = seed * 1103515245 + 12345;
+            ((Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch))[x] = seed;
+        }
+    }
+
+    for (i = 0; i < 4; ++i) {
+        const SDL_PixelFormat format = (i == 0) ? SDL_PIXELFORMAT_XBGR8888 : SDL_PIXELFORMAT_ARGB8888;
+        const SDL_Rect dstrect = { 3, 5, w - 7, h - 11 };
+
+        SDL_SetSurfaceBlendMode(src, (i == 1) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceColorMod(src, 255, (i == 1) ? 128 : 255, 255);
+
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+        serial = SDL_ConvertSurface(dst, format);
+        SDLTest_AssertCheck(serial != NULL, "SDL_ConvertSurface()");
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "4");
+        threaded = SDL_ConvertSurface(dst, format);
+        SDLTest_AssertCheck(threaded != NULL, "SDL_ConvertSurface()");
+        if (!serial || !threaded) {
+            SDL_DestroySurface(serial);
+            SDL_DestroySurface(threaded);
+            break;
+        }
+
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+        if (i < 2) {
+            CHECK_FUNC(SDL_BlitSurface, (src, NULL, serial, &dstrect));
+        } else {
+            CHECK_FUNC(SDL_BlitSurfaceScaled, (src, NULL, serial, &dstrect, (i == 2) ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR));
+        }
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "4");
+        if (i < 2) {
+            CHECK_FUNC(SDL_BlitSurface, (src, NULL, threaded, &dstrect));
+        } else {
+            CHECK_FUNC(SDL_BlitSurfaceScaled, (src, NULL, threaded, &dstrect, (i == 2) ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR));
+        }
+
+        ret = SDLTest_CompareSurfaces(threaded, serial, 0);
+        SDLTest_AssertCheck(ret == 0, "Validate threaded blit %d matches serial blit, expected: 0, got: %i", i, ret);
+
+        SDL_DestroySurface(serial);
+        SDL_DestroySurface(threaded);
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that SDL_SCALEMODE_BEST averages the pixels when reducing a surface
+ */
+static int surface_testScaleBest(void *arg)
+{
+    const struct {
+        int src_w, src_h, dst_w, dst_h;
+    } sizes[] = {
+        { 256, 256, 64, 64 },
+        { 300, 200, 70, 130 },
+        { 7, 301, 7, 3 },
+        { 640, 480, 1, 1 },
+    };
+    int i, x, y;
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        SDL_Surface *src = SDL_CreateSurface(sizes[i].src_w, sizes[i].src_h, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *solid = SDL_CreateSurface(sizes[i].src_w, sizes[i].src_h, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *dst = NULL;
+        int max_error = 0;
+
+        SDLTest_AssertCheck(src && solid, "SDL_CreateSurface()");
+        if (!src || !solid) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(solid);
+            return TEST_ABORTED;
+        }
+
+        /* A checkerboard of single pixels averages to gray */
+        for (y = 0; y < src->h; ++y) {
+            for (x = 0; x < src->w; ++x) {
+                ((Uint32 *)((Uint8 *)src->pixels + y * src->pitch))[x] = ((x ^ y) & 1) ? 0xFFFFFFFF : 0xFF000000;
+            }
+        }
+        dst = SDL_ScaleSurface(src, sizes[i].dst_w, sizes[i].dst_h, SDL_SCALEMODE_BEST);
+        SDLTest_AssertCheck(dst != NULL, "SDL_ScaleSurface(%dx%d -> %dx%d)", sizes[i].src_w, sizes[i].src_h, sizes[i].dst_w, sizes[i].dst_h);
+        if (dst) {
+            for (y = 0; y < dst->h; ++y) {
+                for (x = 0; x < dst->w; ++x) {
+                    Uint8 r, g, b, a;
+                    SDL_ReadSurfacePixel(dst, x, y, &r, &g, &b, &a);
+                    max_error = SDL_max(max_error, SDL_abs(r - 128));
+                    max_error = SDL_max(max_error, SDL_abs(a - 255));
+                }
+            }
+            SDLTest_AssertCheck(max_error <= 8, "Checking averaged checkerboard, expected maximum error <= 8, got %d", max_error);
+            SDL_DestroySurface(dst);
+        }
+
+        /* A solid color stays exactly the same */
+        SDL_FillSurfaceRect(solid, NULL, 0x80C04020);
+        dst = SDL_ScaleSurface(solid, sizes[i].dst_w, sizes[i].dst_h, SDL_SCALEMODE_BEST);
+        SDLTest_AssertCheck(dst != NULL, "SDL_ScaleSurface()");
+        if (dst) {
+            int errors = 0;
+            for (y = 0; y < dst->h; ++y) {
+                for (x = 0; x < dst->w; ++x) {
+                    if (((Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch))[x] != 0x80C04020) {
+                        ++errors;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(errors == 0, "Checking scaled solid color, expected 0 errors, got %d", errors);
+            SDL_DestroySurface(dst);
+        }
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(solid);
+    }
+
+    return TEST_COMPLETED;
+}
+
 static int surface_testOverflow(void *arg)
 {
     char buf[1024];
@@ -1367,6 +1624,610 @@ static int surface_testPremultiplyAlpha(void *arg)
 }
 
 
+/**
+ * Tests that premultiplying 8888 pixels matches the scalar formula exactly
+ * for every alpha value, including the row tails left over by vector code.
+ */
+static int surface_testPremultiplyAlphaExact(void *arg)
+{
+    const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+    };
+    const int w = 37, h = 16;
+    SDL_Surface *surface;
+    Uint32 *original;
+    int i, x, y, ret;
+
+    original = (Uint32 *)SDL_malloc(w * h * sizeof(*original));
+    SDLTest_AssertCheck(original != NULL, "SDL_malloc()");
+    if (!original) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(formats[i]);
+        int mismatches = 0;
+
+        surface = SDL_CreateSurface(w, h, formats[i]);
+        SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface(%s)", SDL_GetPixelFormatName(formats[i]));
+        if (!surface) {
+            continue;
+        }
+
+        /* Every alpha value appears in the surface, with varied colors */
+        for (y = 0; y < h; ++y) {
+            Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+            for (x = 0; x < w; ++x) {
+                Uint8 a = (Uint8)(y * w + x);
+                row[x] = SDL_MapRGBA(details, NULL, (Uint8)SDLTest_RandomUint8(), (Uint8)(255 - x * 7), (Uint8)(y * 16 + 15), a);
+                original[y * w + x] = row[x];
+            }
+        }
+
+        ret = SDL_PremultiplySurfaceAlpha(surface, SDL_FALSE);
+        SDLTest_AssertCheck(ret == 0, "SDL_PremultiplySurfaceAlpha(), expected 0, got %d", ret);
+
+        for (y = 0; y < h; ++y) {
+            const Uint32 *row = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+            for (x = 0; x < w; ++x) {
+                Uint8 r, g, b, a;
+                Uint32 expected;
+
+                SDL_GetRGBA(original[y * w + x], details, NULL, &r, &g, &b, &a);
+                expected = SDL_MapRGBA(details, NULL, (Uint8)((r * a) / 255), (Uint8)((g * a) / 255), (Uint8)((b * a) / 255), a);
+                if (row[x] != expected) {
+                    if (mismatches++ == 0) {
+                        SDLTest_AssertCheck(SDL_FALSE, "%s pixel %d,%d: expected 0x%.8" SDL_PRIx32 ", got 0x%.8" SDL_PRIx32,
+                                            SDL_GetPixelFormatName(formats[i]), x, y, expected, row[x]);
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "%s: %d mismatched pixels", SDL_GetPixelFormatName(formats[i]), mismatches);
+
+        SDL_DestroySurface(surface);
+    }
+    SDL_free(original);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests the conversion of 8-bit sRGB and 10-bit PQ pixels to and from linear floating point.
+ */
+static int surface_testTransferConversion(void *arg)
+{
+    Uint8 srgb[256 * 4];
+    float linear[256 * 4];
+    Uint16 half[256 * 4];
+    Uint8 roundtrip[256 * 4];
+    Uint32 pq[1024];
+    float nits[1024 * 4];
+    int i, ret, mismatches = 0;
+
+    for (i = 0; i < 256; ++i) {
+        srgb[i * 4 + 0] = (Uint8)i;
+        srgb[i * 4 + 1] = (Uint8)(255 - i);
+        srgb[i * 4 + 2] = (Uint8)(i ^ 0x55);
+        srgb[i * 4 + 3] = (Uint8)i;
+    }
+    ret = SDL_ConvertPixelsAndColorspace(256, 1, SDL_PIXELFORMAT_RGBA32, SDL_COLORSPACE_SRGB, 0, srgb, sizeof(srgb),
+                                         SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, linear, sizeof(linear));
+    SDLTest_AssertCheck(ret == 0, "SDL_ConvertPixelsAndColorspace(sRGB), expected 0, got %d", ret);
+    for (i = 0; i < 256 * 4; ++i) {
+        float v = srgb[i] / 255.0f;
+        float expected;
+
+        if ((i % 4) == 3) {
+            expected = v;
+        } else if (v <= 0.04045f) {
+            expected = v / 12.92f;
+        } else {
+            expected = SDL_powf((v + 0.055f) / 1.055f, 2.4f);
+        }
+        if (SDL_fabsf(linear[i] - expected) > 0.00001f) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "sRGB to linear: %d mismatched components", mismatches);
+
+    /* Linear back to 8-bit sRGB should give back the original values */
+    ret = SDL_ConvertPixelsAndColorspace(256, 1, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, linear, sizeof(linear),
+                                         SDL_PIXELFORMAT_RGBA32, SDL_COLORSPACE_SRGB, 0, roundtrip, sizeof(roundtrip));
+    SDLTest_AssertCheck(ret == 0, "SDL_ConvertPixelsAndColorspace(linear), expected 0, got %d", ret);
+    SDLTest_AssertCheck(SDL_memcmp(srgb, roundtrip, sizeof(srgb)) == 0, "Verify sRGB to linear to sRGB round trip");
+
+    ret = SDL_ConvertPixelsAndColorspace(256, 1, SDL_PIXELFORMAT_RGBA32, SDL_COLORSPACE_SRGB, 0, srgb, sizeof(srgb),
+                                         SDL_PIXELFORMAT_RGBA64_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, half, sizeof(half));
+    SDLTest_AssertCheck(ret == 0, "SDL_ConvertPixelsAndColorspace(sRGB to half), expected 0, got %d", ret);
+    SDL_memset(roundtrip, 0, sizeof(roundtrip));
+    ret = SDL_ConvertPixelsAndColorspace(256, 1, SDL_PIXELFORMAT_RGBA64_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, half, sizeof(half),
+                                         SDL_PIXELFORMAT_RGBA32, SDL_COLORSPACE_SRGB, 0, roundtrip, sizeof(roundtrip));
+    SDLTest_AssertCheck(ret == 0, "SDL_ConvertPixelsAndColorspace(half to sRGB), expected 0, got %d", ret);
+    SDLTest_AssertCheck(SDL_memcmp(srgb, roundtrip, sizeof(srgb)) == 0, "Verify sRGB to half float to sRGB round trip");
+
+    /* A gray PQ ramp covers 0 to 10000 nits, and the default SDR white point is 203 nits */
+    for (i = 0; i < 1024; ++i) {
+        pq[i] = (3u << 30) | ((Uint32)i << 20) | ((Uint32)i << 10) | (Uint32)i;
+    }
+    ret = SDL_ConvertPixelsAndColorspace(1024, 1, SDL_PIXELFORMAT_ARGB2101010, SDL_COLORSPACE_HDR10, 0, pq, sizeof(pq),
+                                         SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, nits, sizeof(nits));
+    SDLTest_AssertCheck(ret == 0, "SDL_ConvertPixelsAndColorspace(PQ), expected 0, got %d", ret);
+    SDLTest_AssertCheck(SDL_fabsf(nits[0]) < 0.00001f && nits[3] == 1.0f, "PQ black: expected 0.0, 1.0, got %g, %g", nits[0], nits[3]);
+    mismatches = 0;
+    for (i = 1; i < 1024; ++i) {
+        /* A PQ ramp converts to a strictly increasing luminance */
+        if (!(nits[i * 4 + 0] > nits[(i - 1) * 4 + 0]) || nits[i * 4 + 3] != 1.0f) {
+            ++mismatches;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "PQ to linear: %d non-increasing samples", mismatches);
+    SDLTest_AssertCheck(SDL_fabsf(nits[1023 * 4 + 0] - 10000.0f / 203.0f) < 0.5f, "PQ peak: expected %g, got %g", 10000.0f / 203.0f, nits[1023 * 4 + 0]);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests saving and loading BMP files with and without row padding.
+ */
+static int surface_testLoadBitmapPitch(void *arg)
+{
+    const char *sampleFilename = "testLoadBitmapPitch.bmp";
+    const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_XRGB8888 };
+    const int widths[] = { 1, 3, 16, 21, 37, 64, 79 };
+    int i, j, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(widths); ++j) {
+            SDL_Surface *face, *rface;
+
+            face = SDL_CreateSurface(widths[j], 7, formats[i]);
+            SDLTest_AssertCheck(face != NULL, "Verify %s surface of width %d is not NULL", SDL_GetPixelFormatName(formats[i]), widths[j]);
+            if (!face) {
+                return TEST_ABORTED;
+            }
+            for (y = 0; y < face->h; ++y) {
+                for (x = 0; x < face->w; ++x) {
+                    SDL_WriteSurfacePixel(face, x, y, (Uint8)(x * 3), (Uint8)(y * 30), (Uint8)(x + y), SDL_ALPHA_OPAQUE);
+                }
+            }
+
+            ret = SDL_SaveBMP(face, sampleFilename);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SaveBMP, expected: 0, got: %i", ret);
+            rface = SDL_LoadBMP(sampleFilename);
+            SDLTest_AssertCheck(rface != NULL, "Verify result from SDL_LoadBMP is not NULL");
+            if (rface) {
+                ret = SDLTest_CompareSurfaces(rface, face, 0);
+                SDLTest_AssertCheck(ret == 0, "Validate loaded %s image of width %d, expected: 0, got: %i", SDL_GetPixelFormatName(formats[i]), widths[j], ret);
+                SDL_DestroySurface(rface);
+            }
+            SDL_DestroySurface(face);
+        }
+    }
+
+    unlink(sampleFilename);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that surfaces are accounted in the memory statistics.
+ */
+static int surface_testMemoryStats(void *arg)
+{
+    const int w = 1024, h = 1024;
+    SDL_MemoryStats before, stats;
+    SDL_Surface *surface;
+    void *pixels;
+    int ret;
+
+    ret = SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, NULL);
+    SDLTest_AssertCheck(ret < 0, "Validate result from SDL_GetMemoryStats(NULL), expected: <0, got: %i", ret);
+
+    ret = SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, &before);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetMemoryStats, expected: 0, got: %i", ret);
+
+    surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify surface creation");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, &stats);
+    SDLTest_AssertCheck(stats.count == before.count + 1, "Validate surface count, expected: %i, got: %i", before.count + 1, stats.count);
+    SDLTest_AssertCheck(stats.bytes >= before.bytes + (Uint64)surface->pitch * h, "Validate surface bytes, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, before.bytes + (Uint64)surface->pitch * h, stats.bytes);
+    SDLTest_AssertCheck(stats.gpu_bytes == 0, "Validate surface GPU bytes, expected: 0, got: %" SDL_PRIu64, stats.gpu_bytes);
+    SDL_DestroySurface(surface);
+
+    SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, &stats);
+    SDLTest_AssertCheck(stats.count == before.count, "Validate surface count after destroying the surface, expected: %i, got: %i", before.count, stats.count);
+
+    /* Pixels provided by the application aren't counted */
+    pixels = SDL_malloc((size_t)w * h * 4);
+    SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, &before);
+    surface = SDL_CreateSurfaceFrom(w, h, SDL_PIXELFORMAT_ARGB8888, pixels, w * 4);
+    SDLTest_AssertCheck(surface != NULL, "Verify surface creation from pixels");
+    SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, &stats);
+    SDLTest_AssertCheck(stats.count == before.count + 1, "Validate surface count, expected: %i, got: %i", before.count + 1, stats.count);
+    SDLTest_AssertCheck(stats.bytes < before.bytes + (Uint64)w * h * 4, "Validate surface bytes, expected: <%" SDL_PRIu64 ", got: %" SDL_PRIu64, before.bytes + (Uint64)w * h * 4, stats.bytes);
+    SDL_DestroySurface(surface);
+    SDL_free(pixels);
+
+    SDL_GetMemoryStats(SDL_MEMORY_CATEGORY_SURFACES, &stats);
+    SDLTest_AssertCheck(stats.count == before.count && stats.bytes == before.bytes,
+                        "Validate surface statistics after destroying the surface, expected: %i/%" SDL_PRIu64 ", got: %i/%" SDL_PRIu64,
+                        before.count, before.bytes, stats.count, stats.bytes);
+
+    return TEST_COMPLETED;
+}
+
+/* The blend the RLE blitter does for translucent pixels on 32-bit destinations */
+static Uint32 surface_blendRLE888(Uint32 s, Uint32 d)
+{
+    Uint32 alpha = s >> 24;
+    Uint32 s1 = s & 0xff00ff;
+    Uint32 d1 = d & 0xff00ff;
+    d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+    s &= 0xff00;
+    d &= 0xff00;
+    d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+    return d1 | d | 0xff000000;
+}
+
+/**
+ * Tests RLE accelerated alpha blits onto 32-bit surfaces, with and without clipping,
+ * and keeping the original pixels of an RLE surface.
+ */
+static int surface_testBlitRLEAlpha(void *arg)
+{
+    const int w = 67, h = 9;
+    SDL_Surface *src, *dst;
+    Uint32 *background;
+    int i, x, y, ret, pass;
+
+    src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    dst = SDL_CreateSurface(w + 8, h, SDL_PIXELFORMAT_XRGB8888);
+    background = (Uint32 *)SDL_malloc((w + 8) * h * sizeof(*background));
+    SDLTest_AssertCheck(src && dst && background, "Create surfaces");
+    if (!src || !dst || !background) {
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        SDL_free(background);
+        return TEST_ABORTED;
+    }
+
+    /* Runs of opaque, transparent and translucent pixels of varying lengths */
+    for (y = 0; y < h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (x = 0; x < w; ++x) {
+            int kind = ((x / (y + 1)) + y) % 3;
+            Uint32 alpha = (kind == 0) ? 0xff : (kind == 1) ? 0 : (Uint32)(1 + (x * 37 + y * 11) % 254);
+            row[x] = (alpha << 24) | (SDLTest_RandomUint32() & 0x00ffffff);
+        }
+    }
+    for (i = 0; i < (w + 8) * h; ++i) {
+        background[i] = 0xff000000 | (SDLTest_RandomUint32() & 0x00ffffff);
+    }
+
+    ret = SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    SDLTest_AssertCheck(ret == 0, "SDL_SetSurfaceBlendMode(), expected 0, got %d", ret);
+    ret = SDL_SetSurfaceRLE(src, SDL_TRUE);
+    SDLTest_AssertCheck(ret == 0, "SDL_SetSurfaceRLE(), expected 0, got %d", ret);
+
+    /* Blit at x = 4 unclipped, then at x = -5 and x = 13 clipped on the left and right */
+    for (pass = 0; pass < 3; ++pass) {
+        const int offset = (pass == 0) ? 4 : (pass == 1) ? -5 : 13;
+        SDL_Rect rect = { offset, 0, w, h };
+        Uint32 *copy = SDL_malloc(w * h * sizeof(*copy));
+        int mismatches = 0;
+
+        if (!copy) {
+            break;
+        }
+        for (y = 0; y < h; ++y) {
+            SDL_memcpy((Uint8 *)dst->pixels + y * dst->pitch, &background[y * (w + 8)], (w + 8) * sizeof(Uint32));
+        }
+
+        /* The source pixels aren't available while the surface is encoded, so save them first */
+        SDL_LockSurface(src);
+        for (y = 0; y < h; ++y) {
+            SDL_memcpy(&copy[y * w], (Uint8 *)src->pixels + y * src->pitch, w * sizeof(Uint32));
+        }
+        SDL_UnlockSurface(src);
+
+        ret = SDL_BlitSurface(src, NULL, dst, &rect);
+        SDLTest_AssertCheck(ret == 0, "SDL_BlitSurface(), expected 0, got %d", ret);
+        SDLTest_AssertCheck(SDL_SurfaceHasRLE(src), "Verify surface is RLE accelerated");
+
+        for (y = 0; y < h; ++y) {
+            const Uint32 *row = (const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch);
+            for (x = 0; x < w + 8; ++x) {
+                const int sx = x - offset;
+                Uint32 expected = background[y * (w + 8) + x];
+                if (sx >= 0 && sx < w) {
+                    Uint32 pixel = copy[y * w + sx];
+                    Uint32 alpha = pixel >> 24;
+                    if (alpha == 0xff) {
+                        expected = pixel;
+                    } else if (alpha) {
+                        expected = surface_blendRLE888(pixel, expected);
+                    }
+                }
+                if ((row[x] & 0x00ffffff) != (expected & 0x00ffffff)) {
+                    ++mismatches;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Blit at x = %d: %d mismatched pixels", offset, mismatches);
+        SDL_free(copy);
+    }
+
+    /* Keeping the pixels gives them back unchanged, transparent colors included */
+    {
+        SDL_Surface *kept = SDL_DuplicateSurface(src);
+        Uint32 *original = SDL_malloc(w * h * sizeof(*original));
+        int mismatches = 0;
+
+        SDLTest_AssertCheck(kept && original, "Duplicate surface");
+        if (kept && original) {
+            for (y = 0; y < h; ++y) {
+                SDL_memcpy(&original[y * w], (Uint8 *)kept->pixels + y * kept->pitch, w * sizeof(Uint32));
+            }
+            SDL_SetBooleanProperty(SDL_GetSurfaceProperties(kept), SDL_PROP_SURFACE_RLE_KEEP_PIXELS_BOOLEAN, SDL_TRUE);
+            SDL_SetSurfaceBlendMode(kept, SDL_BLENDMODE_BLEND);
+            SDL_SetSurfaceRLE(kept, SDL_TRUE);
+            ret = SDL_BlitSurface(kept, NULL, dst, NULL);
+            SDLTest_AssertCheck(ret == 0, "SDL_BlitSurface(), expected 0, got %d", ret);
+            SDLTest_AssertCheck(kept->pixels != NULL, "Verify the pixels were kept after encoding");
+
+            SDL_LockSurface(kept);
+            for (y = 0; y < h; ++y) {
+                if (SDL_memcmp(&original[y * w], (Uint8 *)kept->pixels + y * kept->pitch, w * sizeof(Uint32)) != 0) {
+                    ++mismatches;
+                }
+            }
+            SDL_UnlockSurface(kept);
+            SDLTest_AssertCheck(mismatches == 0, "Verify the kept pixels are unchanged, %d rows differ", mismatches);
+        }
+        SDL_free(original);
+        SDL_DestroySurface(kept);
+    }
+
+    SDL_free(background);
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests surface views sharing the pixels of a parent surface.
+ */
+static int surface_testSurfaceView(void *arg)
+{
+    SDL_Surface *parent, *view, *crop, *indexed, *indexed_view;
+    SDL_Rect rect = { 10, 5, 20, 15 };
+    SDL_Rect clipped = { 50, 40, 100, 100 };
+    SDL_Rect outside = { 100, 100, 10, 10 };
+    Uint8 r, g, b, a;
+    int ret, x, y, mismatches;
+
+    parent = SDL_CreateSurface(64, 48, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(parent != NULL, "SDL_CreateSurface()");
+    if (!parent) {
+        return TEST_ABORTED;
+    }
+    SDL_FillSurfaceRect(parent, NULL, SDL_MapSurfaceRGB(parent, 0, 0, 255));
+
+    view = SDL_CreateSurfaceView(parent, &rect);
+    SDLTest_AssertCheck(view != NULL, "SDL_CreateSurfaceView()");
+    if (!view) {
+        SDL_DestroySurface(parent);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(view->w == rect.w && view->h == rect.h, "Verify view size, expected %dx%d, got %dx%d", rect.w, rect.h, view->w, view->h);
+    SDLTest_AssertCheck(view->format == parent->format && view->pitch == parent->pitch, "Verify view format and pitch");
+    SDLTest_AssertCheck(view->pixels == (Uint8 *)parent->pixels + rect.y * parent->pitch + rect.x * 4, "Verify view pixels point into the parent");
+
+    /* Drawing to the view draws to the parent */
+    ret = SDL_FillSurfaceRect(view, NULL, SDL_MapSurfaceRGB(view, 255, 0, 0));
+    SDLTest_AssertCheck(ret == 0, "SDL_FillSurfaceRect(), expected 0, got %d", ret);
+    mismatches = 0;
+    for (y = 0; y < parent->h; ++y) {
+        for (x = 0; x < parent->w; ++x) {
+            SDL_Point point = { x, y };
+            SDL_bool inside = SDL_PointInRect(&point, &rect);
+            SDL_ReadSurfacePixel(parent, x, y, &r, &g, &b, &a);
+            if (inside ? (r != 255 || b != 0) : (r != 0 || b != 255)) {
+                ++mismatches;
+            }
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify only the view area was filled, %d mismatched pixels", mismatches);
+
+    /* Blitting from the view is the same as cropping the parent */
+    crop = SDL_CreateSurface(rect.w, rect.h, SDL_PIXELFORMAT_ARGB8888);
+    if (crop) {
+        SDL_BlitSurface(view, NULL, crop, NULL);
+        SDL_ReadSurfacePixel(crop, rect.w - 1, rect.h - 1, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Verify blitted view color, expected 255,0,0, got %d,%d,%d", r, g, b);
+        SDL_DestroySurface(crop);
+    }
+
+    /* Locking the view locks the parent */
+    SDL_LockSurface(view);
+    SDLTest_AssertCheck(parent->flags & SDL_SURFACE_LOCKED, "Verify the parent is locked with the view");
+    SDL_UnlockSurface(view);
+    SDLTest_AssertCheck(!(parent->flags & SDL_SURFACE_LOCKED), "Verify the parent is unlocked with the view");
+
+    /* The view rectangle is clipped to the parent */
+    crop = SDL_CreateSurfaceView(parent, &clipped);
+    SDLTest_AssertCheck(crop && crop->w == 14 && crop->h == 8, "Verify clipped view size, expected 14x8, got %dx%d", crop ? crop->w : 0, crop ? crop->h : 0);
+    SDL_DestroySurface(crop);
+    crop = SDL_CreateSurfaceView(parent, &outside);
+    SDLTest_AssertCheck(crop == NULL, "Verify a view outside the parent fails");
+
+    /* The view keeps the parent alive */
+    SDL_DestroySurface(parent);
+    SDL_ReadSurfacePixel(view, 0, 0, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Verify view color after destroying the parent, expected 255,0,0, got %d,%d,%d", r, g, b);
+    SDL_DestroySurface(view);
+
+    /* Indexed views share the palette */
+    indexed = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_INDEX8);
+    if (indexed) {
+        indexed_view = SDL_CreateSurfaceView(indexed, NULL);
+        SDLTest_AssertCheck(indexed_view && SDL_GetSurfacePalette(indexed_view) == SDL_GetSurfacePalette(indexed), "Verify the view shares the parent palette");
+        SDL_DestroySurface(indexed_view);
+        SDL_DestroySurface(indexed);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests a view of a surface that is RLE accelerated.
+ */
+static int surface_testSurfaceViewRLE(void *arg)
+{
+    SDL_Surface *parent, *dst, *view;
+    SDL_Rect rect = { 4, 4, 8, 8 };
+    Uint8 r, g, b, a;
+    int ret;
+
+    parent = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_ARGB8888);
+    dst = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(parent && dst, "Create surfaces");
+    if (!parent || !dst) {
+        SDL_DestroySurface(parent);
+        SDL_DestroySurface(dst);
+        return TEST_ABORTED;
+    }
+    SDL_FillSurfaceRect(parent, NULL, SDL_MapSurfaceRGBA(parent, 0, 255, 0, 255));
+    SDL_SetSurfaceBlendMode(parent, SDL_BLENDMODE_BLEND);
+    SDL_SetSurfaceRLE(parent, SDL_TRUE);
+
+    /* Encode the parent, which releases its pixels */
+    ret = SDL_BlitSurface(parent, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == 0, "SDL_BlitSurface(), expected 0, got %d", ret);
+
+    view = SDL_CreateSurfaceView(parent, &rect);
+    SDLTest_AssertCheck(view != NULL, "SDL_CreateSurfaceView()");
+    if (view) {
+        SDL_ReadSurfacePixel(view, 0, 0, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 0 && g == 255 && b == 0 && a == 255, "Verify view color, expected 0,255,0,255, got %d,%d,%d,%d", r, g, b, a);
+
+        /* Encoding the parent again keeps the memory the view refers to */
+        ret = SDL_BlitSurface(parent, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "SDL_BlitSurface(), expected 0, got %d", ret);
+        SDLTest_AssertCheck(view->pixels == (Uint8 *)parent->pixels + rect.y * parent->pitch + rect.x * 4, "Verify view pixels still point into the parent");
+        SDL_DestroySurface(view);
+    }
+
+    SDL_DestroySurface(parent);
+    SDL_DestroySurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests surface creation with a specific pitch alignment and pixel buffer reuse.
+ */
+static int surface_testCreateWithProperties(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_Surface *surface;
+    void *pixels;
+    int i;
+    SDL_bool cleared;
+
+    /* Rows are 4 byte aligned by default, the pixels are aligned for SIMD */
+    surface = SDL_CreateSurface(17, 3, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (surface) {
+        SDLTest_AssertCheck(surface->pitch == 17 * 4, "Verify default pitch, expected %d, got %d", 17 * 4, surface->pitch);
+        SDLTest_AssertCheck(((uintptr_t)surface->pixels % 64) == 0, "Verify pixels are 64 byte aligned");
+        SDL_DestroySurface(surface);
+    }
+
+    surface = SDL_CreateSurface(5, 3, SDL_PIXELFORMAT_RGB24);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (surface) {
+        SDLTest_AssertCheck(surface->pitch == 16, "Verify default pitch, expected 16, got %d", surface->pitch);
+        SDL_DestroySurface(surface);
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_WIDTH_NUMBER, 17);
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_HEIGHT_NUMBER, 3);
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_FORMAT_NUMBER, SDL_PIXELFORMAT_ARGB8888);
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_COLORSPACE_NUMBER, SDL_COLORSPACE_SRGB_LINEAR);
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER, 256);
+    surface = SDL_CreateSurfaceWithProperties(props);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurfaceWithProperties()");
+    if (surface) {
+        SDLTest_AssertCheck(surface->w == 17 && surface->h == 3, "Verify size, expected 17x3, got %dx%d", surface->w, surface->h);
+        SDLTest_AssertCheck(surface->pitch == 256, "Verify pitch, expected 256, got %d", surface->pitch);
+        SDLTest_AssertCheck(((uintptr_t)surface->pixels % 256) == 0, "Verify pixels are 256 byte aligned");
+        SDLTest_AssertCheck(SDL_GetSurfaceColorspace(surface) == SDL_COLORSPACE_SRGB_LINEAR, "Verify colorspace");
+        SDL_DestroySurface(surface);
+    }
+
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER, 64);
+    surface = SDL_CreateSurfaceWithProperties(props);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurfaceWithProperties()");
+    if (surface) {
+        SDLTest_AssertCheck(surface->pitch == 128, "Verify pitch, expected 128, got %d", surface->pitch);
+        SDL_DestroySurface(surface);
+    }
+
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER, 1);
+    surface = SDL_CreateSurfaceWithProperties(props);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurfaceWithProperties()");
+    if (surface) {
+        SDLTest_AssertCheck(surface->pitch == 17 * 4, "Verify minimal pitch, expected %d, got %d", 17 * 4, surface->pitch);
+        SDL_DestroySurface(surface);
+    }
+
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER, 24);
+    surface = SDL_CreateSurfaceWithProperties(props);
+    SDLTest_AssertCheck(surface == NULL, "Should reject alignment that isn't a power of two");
+
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_PITCH_ALIGNMENT_NUMBER, 0);
+    SDL_SetNumberProperty(props, SDL_PROP_SURFACE_CREATE_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN);
+    surface = SDL_CreateSurfaceWithProperties(props);
+    SDLTest_AssertCheck(surface == NULL, "Should reject missing format");
+    SDL_DestroyProperties(props);
+
+    /* Buffers of destroyed surfaces are handed out again, cleared */
+    surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    SDL_FillSurfaceRect(surface, NULL, 0xFFFFFFFF);
+    pixels = surface->pixels;
+    SDL_DestroySurface(surface);
+
+    surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(surface->pixels == pixels, "Verify pixel buffer was reused");
+    cleared = SDL_TRUE;
+    for (i = 0; i < surface->h * surface->pitch; ++i) {
+        if (((Uint8 *)surface->pixels)[i] != 0) {
+            cleared = SDL_FALSE;
+            break;
+        }
+    }
+    SDLTest_AssertCheck(cleared, "Verify reused pixel buffer is cleared");
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -1434,6 +2295,34 @@ static const SDLTest_TestCaseReference surfaceTestBlitBlendMul = {
     (SDLTest_TestCaseFp)surface_testBlitBlendMul, "surface_testBlitBlendMul", "Tests blitting routines with mul blending mode.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestBlitModulateBlend = {
+    (SDLTest_TestCaseFp)surface_testBlitModulateBlend, "surface_testBlitModulateBlend", "Tests color and alpha modulated blending against a reference implementation.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitThreads = {
+    (SDLTest_TestCaseFp)surface_testBlitThreads, "surface_testBlitThreads", "Tests that threaded blits match blits on a single thread.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestScaleBest = {
+    (SDLTest_TestCaseFp)surface_testScaleBest, "surface_testScaleBest", "Tests area averaging when reducing a surface.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitRLEAlpha = {
+    (SDLTest_TestCaseFp)surface_testBlitRLEAlpha, "surface_testBlitRLEAlpha", "Tests RLE accelerated alpha blits.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestSurfaceView = {
+    (SDLTest_TestCaseFp)surface_testSurfaceView, "surface_testSurfaceView", "Tests surface views of a parent surface.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestSurfaceViewRLE = {
+    (SDLTest_TestCaseFp)surface_testSurfaceViewRLE, "surface_testSurfaceViewRLE", "Tests surface views of an RLE surface.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestCreateWithProperties = {
+    (SDLTest_TestCaseFp)surface_testCreateWithProperties, "surface_testCreateWithProperties", "Tests surface creation properties and pixel buffer reuse.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
@@ -1454,6 +2343,22 @@ static const SDLTest_TestCaseReference surfaceTestPremultiplyAlpha = {
     surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Test alpha premultiply operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestPremultiplyAlphaExact = {
+    surface_testPremultiplyAlphaExact, "surface_testPremultiplyAlphaExact", "Test alpha premultiply of every alpha value.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestTransferConversion = {
+    surface_testTransferConversion, "surface_testTransferConversion", "Test sRGB and PQ conversion to linear.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestLoadBitmapPitch = {
+    surface_testLoadBitmapPitch, "surface_testLoadBitmapPitch", "Test loading BMP files with padded rows.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestMemoryStats = {
+    surface_testMemoryStats, "surface_testMemoryStats", "Test surface memory statistics.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestSaveLoadBitmap,
@@ -1472,11 +2377,22 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestBlitBlendAddPremultiplied,
     &surfaceTestBlitBlendMod,
     &surfaceTestBlitBlendMul,
+    &surfaceTestBlitModulateBlend,
+    &surfaceTestBlitThreads,
+    &surfaceTestScaleBest,
+    &surfaceTestBlitRLEAlpha,
+    &surfaceTestSurfaceView,
+    &surfaceTestSurfaceViewRLE,
+    &surfaceTestCreateWithProperties,
     &surfaceTestOverflow,
     &surfaceTestFlip,
     &surfaceTestPalette,
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
+    &surfaceTestPremultiplyAlphaExact,
+    &surfaceTestTransferConversion,
+    &surfaceTestLoadBitmapPitch,
+    &surfaceTestMemoryStats,
     NULL
 };
 
@@ -0,0 +1,480 @@
+/**
+ * Thread test suite
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+/* Test case functions */
+
+static SDL_AtomicInt g_jobCount;
+
+static void SDLCALL thread_countJob(void *userdata)
+{
+    SDL_AtomicIncRef(&g_jobCount);
+}
+
+/**
+ * Call to SDL_SubmitJob and SDL_WaitThreadPool
+ */
+static int thread_submitJobs(void *arg)
+{
+    const int num_jobs = 10000;
+    SDL_ThreadPool *pool;
+    int i, result;
+
+    pool = SDL_CreateThreadPool(0, SDL_THREAD_PRIORITY_NORMAL);
+    SDLTest_AssertPass("Call to SDL_CreateThreadPool(0, SDL_THREAD_PRIORITY_NORMAL)");
+    SDLTest_AssertCheck(pool != NULL, "Check result value, expected: non-NULL, got: %p", (void *)pool);
+    if (!pool) {
+        return TEST_ABORTED;
+    }
+
+    SDL_AtomicSet(&g_jobCount, 0);
+    for (i = 0; i < num_jobs; ++i) {
+        result = SDL_SubmitJob(pool, thread_countJob, NULL);
+        if (result != 0) {
+            SDLTest_AssertCheck(result == 0, "Check result from SDL_SubmitJob(), expected: 0, got: %d", result);
+            break;
+        }
+    }
+    SDLTest_AssertPass("Call to SDL_SubmitJob() %d times", i);
+
+    SDL_WaitThreadPool(pool);
+    SDLTest_AssertPass("Call to SDL_WaitThreadPool()");
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_jobCount) == num_jobs, "Check job count, expected: %d, got: %d", num_jobs, SDL_AtomicGet(&g_jobCount));
+
+    result = SDL_SubmitJob(pool, NULL, NULL);
+    SDLTest_AssertCheck(result < 0, "Check result from SDL_SubmitJob() with NULL callback, expected: <0, got: %d", result);
+
+    SDL_DestroyThreadPool(pool);
+    SDLTest_AssertPass("Call to SDL_DestroyThreadPool()");
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_ThreadPool *pool;
+    SDL_AtomicInt *counter;
+    int expected;
+    SDL_bool in_order;
+} thread_chainData;
+
+static void SDLCALL thread_chainJob(void *userdata)
+{
+    thread_chainData *data = (thread_chainData *)userdata;
+
+    /* Each job in the chain must see every earlier job finished */
+    data->in_order = (SDL_AtomicAdd(data->counter, 1) == data->expected);
+}
+
+/**
+ * Call to SDL_CreateJob, SDL_AddJobDependency, SDL_RunJob and SDL_WaitJob
+ */
+static int thread_jobDependencies(void *arg)
+{
+    thread_chainData data[64];
+    SDL_Job *jobs[SDL_arraysize(data)];
+    SDL_AtomicInt counter;
+    SDL_ThreadPool *pool;
+    int i, result;
+
+    pool = SDL_CreateThreadPool(4, SDL_THREAD_PRIORITY_NORMAL);
+    SDLTest_AssertPass("Call to SDL_CreateThreadPool(4, SDL_THREAD_PRIORITY_NORMAL)");
+    SDLTest_AssertCheck(pool != NULL, "Check result value, expected: non-NULL, got: %p", (void *)pool);
+    if (!pool) {
+        return TEST_ABORTED;
+    }
+
+    SDL_AtomicSet(&counter, 0);
+    for (i = 0; i < SDL_arraysize(data); ++i) {
+        data[i].pool = pool;
+        data[i].counter = &counter;
+        data[i].expected = i;
+        data[i].in_order = SDL_FALSE;
+        jobs[i] = SDL_CreateJob(pool, thread_chainJob, &data[i]);
+        SDLTest_AssertCheck(jobs[i] != NULL, "Check result from SDL_CreateJob(), expected: non-NULL, got: %p", (void *)jobs[i]);
+        if (!jobs[i]) {
+            return TEST_ABORTED;
+        }
+        if (i > 0) {
+            result = SDL_AddJobDependency(jobs[i], jobs[i - 1]);
+            SDLTest_AssertCheck(result == 0, "Check result from SDL_AddJobDependency(), expected: 0, got: %d", result);
+        }
+    }
+
+    /* Start the chain from the end so the dependencies do the ordering */
+    for (i = SDL_arraysize(data) - 1; i >= 0; --i) {
+        result = SDL_RunJob(jobs[i]);
+        SDLTest_AssertCheck(result == 0, "Check result from SDL_RunJob(), expected: 0, got: %d", result);
+    }
+    result = SDL_RunJob(jobs[0]);
+    SDLTest_AssertCheck(result < 0, "Check result from SDL_RunJob() on a started job, expected: <0, got: %d", result);
+    result = SDL_AddJobDependency(jobs[1], jobs[0]);
+    SDLTest_AssertCheck(result < 0, "Check result from SDL_AddJobDependency() on a started job, expected: <0, got: %d", result);
+
+    SDL_WaitJob(jobs[SDL_arraysize(data) - 1]);
+    SDLTest_AssertPass("Call to SDL_WaitJob() on the last job");
+    SDLTest_AssertCheck(SDL_AtomicGet(&counter) == SDL_arraysize(data), "Check job count, expected: %d, got: %d", (int)SDL_arraysize(data), SDL_AtomicGet(&counter));
+    for (i = 0; i < SDL_arraysize(data) - 1; ++i) {
+        SDL_WaitJob(jobs[i]);
+    }
+    for (i = 0; i < SDL_arraysize(data); ++i) {
+        SDLTest_AssertCheck(data[i].in_order, "Check job %d ran after its dependency", i);
+    }
+
+    SDL_DestroyThreadPool(pool);
+    SDLTest_AssertPass("Call to SDL_DestroyThreadPool()");
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_ThreadPool *pool;
+    int depth;
+} thread_forkData;
+
+static void SDLCALL thread_forkJob(void *userdata)
+{
+    thread_forkData *data = (thread_forkData *)userdata;
+    thread_forkData children[2];
+    SDL_Job *jobs[2];
+    int i;
+
+    SDL_AtomicIncRef(&g_jobCount);
+    if (data->depth == 0) {
+        return;
+    }
+
+    /* Waiting from inside a job runs other jobs instead of blocking the worker */
+    for (i = 0; i < 2; ++i) {
+        children[i].pool = data->pool;
+        children[i].depth = data->depth - 1;
+        jobs[i] = SDL_CreateJob(data->pool, thread_forkJob, &children[i]);
+        SDL_RunJob(jobs[i]);
+    }
+    for (i = 0; i < 2; ++i) {
+        SDL_WaitJob(jobs[i]);
+    }
+}
+
+/**
+ * Call to SDL_WaitJob from inside jobs on a small pool
+ */
+static int thread_nestedJobs(void *arg)
+{
+    const int depth = 10;
+    const int expected = (1 << (depth + 1)) - 1;
+    thread_forkData data;
+    SDL_ThreadPool *pool;
+    SDL_Job *job;
+
+    pool = SDL_CreateThreadPool(2, SDL_THREAD_PRIORITY_NORMAL);
+    SDLTest_AssertPass("Call to SDL_CreateThreadPool(2, SDL_THREAD_PRIORITY_NORMAL)");
+    SDLTest_AssertCheck(pool != NULL, "Check result value, expected: non-NULL, got: %p", (void *)pool);
+    if (!pool) {
+        return TEST_ABORTED;
+    }
+
+    SDL_AtomicSet(&g_jobCount, 0);
+    data.pool = pool;
+    data.depth = depth;
+    job = SDL_CreateJob(pool, thread_forkJob, &data);
+    SDLTest_AssertCheck(job != NULL, "Check result from SDL_CreateJob(), expected: non-NULL, got: %p", (void *)job);
+    SDL_WaitJob(job);
+    SDLTest_AssertPass("Call to SDL_WaitJob() on an unstarted job");
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_jobCount) == expected, "Check job count, expected: %d, got: %d", expected, SDL_AtomicGet(&g_jobCount));
+
+    SDL_DestroyThreadPool(pool);
+    SDLTest_AssertPass("Call to SDL_DestroyThreadPool()");
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL thread_wakeAtomicThread(void *data)
+{
+    SDL_AtomicInt *value = (SDL_AtomicInt *)data;
+
+    SDL_Delay(10);
+    SDL_AtomicSet(value, 1);
+    SDL_BroadcastAtomicInt(value);
+    return 0;
+}
+
+/**
+ * Call to SDL_WaitAtomicInt, SDL_WaitAtomicIntTimeout and SDL_BroadcastAtomicInt
+ */
+static int thread_waitAtomicInt(void *arg)
+{
+    SDL_AtomicInt value;
+    SDL_Thread *thread;
+    int result;
+
+    SDL_AtomicSet(&value, 0);
+    result = SDL_WaitAtomicIntTimeout(&value, 1, -1);
+    SDLTest_AssertCheck(result == 0, "Check result from SDL_WaitAtomicIntTimeout() with a different value, expected: 0, got: %d", result);
+    result = SDL_WaitAtomicIntTimeout(&value, 0, 10);
+    SDLTest_AssertCheck(result == SDL_MUTEX_TIMEDOUT, "Check result from SDL_WaitAtomicIntTimeout() with nobody waking, expected: %d, got: %d", SDL_MUTEX_TIMEDOUT, result);
+
+    thread = SDL_CreateThread(thread_wakeAtomicThread, "WakeAtomic", &value);
+    SDLTest_AssertCheck(thread != NULL, "Check result from SDL_CreateThread(), expected: non-NULL, got: %p", (void *)thread);
+    while (SDL_AtomicGet(&value) == 0) {
+        result = SDL_WaitAtomicInt(&value, 0);
+        if (result != 0) {
+            SDLTest_AssertCheck(result == 0, "Check result from SDL_WaitAtomicInt(), expected: 0, got: %d", result);
+            break;
+        }
+    }
+    SDLTest_AssertCheck(SDL_AtomicGet(&value) == 1, "Check value after waking, expected: 1, got: %d", SDL_AtomicGet(&value));
+    SDL_WaitThread(thread, NULL);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    int counter;
+    int turn;
+} thread_lockData;
+
+static int SDLCALL thread_lockThread(void *data)
+{
+    thread_lockData *shared = (thread_lockData *)data;
+    int i;
+
+    for (i = 0; i < 100000; ++i) {
+        SDL_LockMutex(shared->lock);
+        SDL_LockMutex(shared->lock); /* mutexes are recursive */
+        ++shared->counter;
+        SDL_UnlockMutex(shared->lock);
+        SDL_UnlockMutex(shared->lock);
+    }
+    return 0;
+}
+
+static int SDLCALL thread_pingPongThread(void *data)
+{
+    thread_lockData *shared = (thread_lockData *)data;
+    int i;
+
+    SDL_LockMutex(shared->lock);
+    for (i = 0; i < 1000; ++i) {
+        while (shared->turn != 1) {
+            SDL_WaitCondition(shared->cond, shared->lock);
+        }
+        shared->turn = 0;
+        SDL_SignalCondition(shared->cond);
+    }
+    SDL_UnlockMutex(shared->lock);
+    return 0;
+}
+
+/**
+ * Call to SDL_LockMutex and SDL_WaitCondition from several threads
+ */
+static int thread_contendedMutex(void *arg)
+{
+    thread_lockData shared;
+    SDL_Thread *threads[4];
+    int i, result;
+
+    SDL_zero(shared);
+    shared.lock = SDL_CreateMutex();
+    shared.cond = SDL_CreateCondition();
+    SDLTest_AssertCheck(shared.lock && shared.cond, "Check result from SDL_CreateMutex() and SDL_CreateCondition()");
+    if (!shared.lock || !shared.cond) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        threads[i] = SDL_CreateThread(thread_lockThread, "LockMutex", &shared);
+    }
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDLTest_AssertCheck(shared.counter == 100000 * SDL_arraysize(threads), "Check counter, expected: %d, got: %d", 100000 * (int)SDL_arraysize(threads), shared.counter);
+
+    result = SDL_TryLockMutex(shared.lock);
+    SDLTest_AssertCheck(result == 0, "Check result from SDL_TryLockMutex() on an unlocked mutex, expected: 0, got: %d", result);
+    SDL_UnlockMutex(shared.lock);
+
+    threads[0] = SDL_CreateThread(thread_pingPongThread, "PingPong", &shared);
+    SDL_LockMutex(shared.lock);
+    for (i = 0; i < 1000; ++i) {
+        shared.turn = 1;
+        SDL_SignalCondition(shared.cond);
+        while (shared.turn != 0) {
+            SDL_WaitCondition(shared.cond, shared.lock);
+        }
+    }
+    result = SDL_WaitConditionTimeout(shared.cond, shared.lock, 10);
+    SDLTest_AssertCheck(result == SDL_MUTEX_TIMEDOUT, "Check result from SDL_WaitConditionTimeout() with nobody signaling, expected: %d, got: %d", SDL_MUTEX_TIMEDOUT, result);
+    SDL_UnlockMutex(shared.lock);
+    SDL_WaitThread(threads[0], NULL);
+    SDLTest_AssertPass("Passed the turn back and forth 1000 times");
+
+    SDL_DestroyCondition(shared.cond);
+    SDL_DestroyMutex(shared.lock);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_SpinLock spinlock;
+    SDL_TicketLock ticketlock;
+    int spin_counter;
+    int ticket_counter;
+} thread_atomicLockData;
+
+static int SDLCALL thread_atomicLockThread(void *data)
+{
+    thread_atomicLockData *shared = (thread_atomicLockData *)data;
+    int i;
+
+    for (i = 0; i < 100000; ++i) {
+        SDL_LockSpinlock(&shared->spinlock);
+        ++shared->spin_counter;
+        SDL_UnlockSpinlock(&shared->spinlock);
+
+        SDL_LockTicketLock(&shared->ticketlock);
+        ++shared->ticket_counter;
+        SDL_UnlockTicketLock(&shared->ticketlock);
+    }
+    return 0;
+}
+
+/**
+ * Call to SDL_LockSpinlock and SDL_LockTicketLock from several threads
+ */
+static int thread_contendedAtomicLocks(void *arg)
+{
+    thread_atomicLockData shared;
+    SDL_Thread *threads[4];
+    const int expected = 100000 * SDL_arraysize(threads);
+    SDL_bool result;
+    int i;
+
+    SDL_zero(shared);
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        threads[i] = SDL_CreateThread(thread_atomicLockThread, "AtomicLock", &shared);
+    }
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDLTest_AssertCheck(shared.spin_counter == expected, "Check spinlock counter, expected: %d, got: %d", expected, shared.spin_counter);
+    SDLTest_AssertCheck(shared.ticket_counter == expected, "Check ticket lock counter, expected: %d, got: %d", expected, shared.ticket_counter);
+
+    result = SDL_TryLockTicketLock(&shared.ticketlock);
+    SDLTest_AssertCheck(result == SDL_TRUE, "Check result from SDL_TryLockTicketLock() on an unlocked lock, expected: SDL_TRUE, got: %s", result ? "SDL_TRUE" : "SDL_FALSE");
+    result = SDL_TryLockTicketLock(&shared.ticketlock);
+    SDLTest_AssertCheck(result == SDL_FALSE, "Check result from SDL_TryLockTicketLock() on a locked lock, expected: SDL_FALSE, got: %s", result ? "SDL_TRUE" : "SDL_FALSE");
+    SDL_UnlockTicketLock(&shared.ticketlock);
+
+    return TEST_COMPLETED;
+}
+
+static SDL_TLSID g_tlsID;
+static SDL_TLSID g_tlsIDs[16];
+static SDL_AtomicInt g_tlsDestroyed;
+
+static void SDLCALL thread_tlsDestructor(void *value)
+{
+    SDL_AtomicIncRef(&g_tlsDestroyed);
+}
+
+static int SDLCALL thread_tlsThread(void *data)
+{
+    int i;
+
+    if (SDL_GetTLS(&g_tlsID) != NULL) {
+        return -1;
+    }
+    SDL_SetTLS(&g_tlsID, data, thread_tlsDestructor);
+    for (i = 0; i < SDL_arraysize(g_tlsIDs); ++i) {
+        SDL_SetTLS(&g_tlsIDs[i], (char *)data + i, NULL);
+    }
+    for (i = 0; i < SDL_arraysize(g_tlsIDs); ++i) {
+        if (SDL_GetTLS(&g_tlsIDs[i]) != (char *)data + i) {
+            return -1;
+        }
+    }
+    return (SDL_GetTLS(&g_tlsID) == data) ? 0 : -1;
+}
+
+/**
+ * Call to SDL_SetTLS and SDL_GetTLS from several threads
+ */
+static int thread_threadLocalStorage(void *arg)
+{
+    static char values[4][64];
+    SDL_Thread *threads[SDL_arraysize(values)];
+    int i, status;
+
+    SDL_AtomicSet(&g_tlsDestroyed, 0);
+    SDLTest_AssertCheck(SDL_GetTLS(&g_tlsID) == NULL, "Check SDL_GetTLS() before any value was set");
+    SDL_SetTLS(&g_tlsID, values, NULL);
+    SDLTest_AssertPass("Call to SDL_SetTLS()");
+
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        threads[i] = SDL_CreateThread(thread_tlsThread, "TLS", values[i]);
+    }
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        status = -1;
+        SDL_WaitThread(threads[i], &status);
+        SDLTest_AssertCheck(status == 0, "Check thread %d saw only its own values, expected: 0, got: %d", i, status);
+    }
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_tlsDestroyed) == SDL_arraysize(threads), "Check destructor calls, expected: %d, got: %d", (int)SDL_arraysize(threads), SDL_AtomicGet(&g_tlsDestroyed));
+    SDLTest_AssertCheck(SDL_GetTLS(&g_tlsID) == values, "Check SDL_GetTLS() on the main thread is unchanged");
+
+    SDL_SetTLS(&g_tlsID, NULL, NULL);
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Thread test cases */
+static const SDLTest_TestCaseReference threadTest1 = {
+    (SDLTest_TestCaseFp)thread_submitJobs, "thread_submitJobs", "Call to SDL_SubmitJob and SDL_WaitThreadPool", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest2 = {
+    (SDLTest_TestCaseFp)thread_jobDependencies, "thread_jobDependencies", "Call to SDL_CreateJob and SDL_AddJobDependency with a chain of jobs", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest3 = {
+    (SDLTest_TestCaseFp)thread_nestedJobs, "thread_nestedJobs", "Call to SDL_WaitJob from inside jobs", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest4 = {
+    (SDLTest_TestCaseFp)thread_waitAtomicInt, "thread_waitAtomicInt", "Call to SDL_WaitAtomicInt and SDL_BroadcastAtomicInt", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest5 = {
+    (SDLTest_TestCaseFp)thread_contendedMutex, "thread_contendedMutex", "Call to SDL_LockMutex and SDL_WaitCondition from several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest6 = {
+    (SDLTest_TestCaseFp)thread_contendedAtomicLocks, "thread_contendedAtomicLocks", "Call to SDL_LockSpinlock and SDL_LockTicketLock from several threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadTest7 = {
+    (SDLTest_TestCaseFp)thread_threadLocalStorage, "thread_threadLocalStorage", "Call to SDL_SetTLS and SDL_GetTLS from several threads", TEST_ENABLED
+};
+
+/* Sequence of Thread test cases */
+static const SDLTest_TestCaseReference *threadTests[] = {
+    &threadTest1, &threadTest2, &threadTest3, &threadTest4, &threadTest5, &threadTest6, &threadTest7, NULL
+};
+
+/* Thread test suite (global) */
+SDLTest_TestSuiteReference threadTestSuite = {
+    "Thread",
+    NULL,
+    threadTests,
+    NULL
+};
@@ -165,6 +165,180 @@ static int timer_addRemoveTimer(void *arg)
     SDLTest_AssertCheck(result < 0, "Check result value, expected: <0, got: %i", result);
     SDLTest_AssertCheck(g_timerCallbackCalled == 1, "Check callback WAS called, expected: 1, got: %i", g_timerCallbackCalled);
 
+    /* Let a timer finish without removing it, so the next timer reuses it */
+    g_paramCheck = 0;
+    id = SDL_AddTimer(10, timerTestCallback, NULL);
+    SDL_Delay(100);
+    SDL_ClearError();
+    id = SDL_AddTimer(10000, timerTestCallback, NULL);
+    SDLTest_AssertPass("Call to SDL_AddTimer(10000,...) after a timer finished");
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %" SDL_PRIu32, id);
+    SDLTest_AssertCheck(*SDL_GetError() == '\0', "Check SDL_GetError() is empty, got: %s", SDL_GetError());
+    result = SDL_RemoveTimer(id);
+    SDLTest_AssertCheck(result == 0, "Check result value, expected: 0, got: %i", result);
+
+    return TEST_COMPLETED;
+}
+
+#define NUM_MANY_TIMERS 2000
+
+static SDL_AtomicInt g_manyTimersFired;
+static SDL_AtomicInt g_manyTimersBad;
+
+static Uint64 SDLCALL timerManyCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    if ((intptr_t)param & 1) {
+        /* These were all removed before they were due */
+        SDL_AtomicAdd(&g_manyTimersBad, 1);
+    }
+    SDL_AtomicAdd(&g_manyTimersFired, 1);
+    return 0;
+}
+
+/**
+ * Call to SDL_AddTimerNS and SDL_RemoveTimer with lots of timers
+ */
+static int timer_addRemoveManyTimers(void *arg)
+{
+    static SDL_TimerID ids[NUM_MANY_TIMERS];
+    int i, fired, removed = 0;
+    Uint64 start;
+
+    SDL_AtomicSet(&g_manyTimersFired, 0);
+    SDL_AtomicSet(&g_manyTimersBad, 0);
+
+    for (i = 0; i < NUM_MANY_TIMERS; ++i) {
+        /* Odd timers are due well after we remove them */
+        const Uint64 interval = (i & 1) ? SDL_MS_TO_NS(10000) : SDL_MS_TO_NS(1 + (i % 20));
+        ids[i] = SDL_AddTimerNS(interval, timerManyCallback, (void *)(intptr_t)i);
+        if (!ids[i]) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == NUM_MANY_TIMERS, "Check %d timers were added, got: %d", NUM_MANY_TIMERS, i);
+
+    for (i = 1; i < NUM_MANY_TIMERS; i += 2) {
+        if (SDL_RemoveTimer(ids[i]) == 0) {
+            ++removed;
+        }
+    }
+    SDLTest_AssertCheck(removed == NUM_MANY_TIMERS / 2, "Check %d timers were removed, got: %d", NUM_MANY_TIMERS / 2, removed);
+
+    start = SDL_GetTicks();
+    while (SDL_AtomicGet(&g_manyTimersFired) < NUM_MANY_TIMERS / 2 && (SDL_GetTicks() - start) < 5000) {
+        SDL_Delay(10);
+    }
+    fired = SDL_AtomicGet(&g_manyTimersFired);
+    SDLTest_AssertCheck(fired == NUM_MANY_TIMERS / 2, "Check %d timers fired, got: %d", NUM_MANY_TIMERS / 2, fired);
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_manyTimersBad) == 0, "Check removed timers didn't fire, got: %d", SDL_AtomicGet(&g_manyTimersBad));
+
+    /* The fired timers were one-shot, so they're gone already */
+    SDLTest_AssertCheck(SDL_RemoveTimer(ids[0]) < 0, "Check SDL_RemoveTimer() of a fired timer fails");
+
+    return TEST_COMPLETED;
+}
+
+static SDL_AtomicInt g_fastTimerFired;
+
+static Uint64 SDLCALL timerSlowCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    SDL_Delay(300);
+    return 0;
+}
+
+static Uint64 SDLCALL timerFastCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    SDL_AtomicAdd(&g_fastTimerFired, 1);
+    return interval;
+}
+
+/**
+ * Call to SDL_AddTimerNS with timer dispatch threads
+ */
+static int timer_dispatchThreads(void *arg)
+{
+    SDL_TimerID slow, fast;
+    SDL_PropertiesID props;
+    Sint64 fired;
+    int fast_fired;
+    int init_count = 0;
+
+    /* Restart the timer subsystem with worker threads */
+    while (SDL_WasInit(SDL_INIT_TIMER)) {
+        SDL_QuitSubSystem(SDL_INIT_TIMER);
+        ++init_count;
+    }
+    SDL_SetHint(SDL_HINT_TIMER_DISPATCH_THREADS, "2");
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_TIMER) == 0, "Call to SDL_InitSubSystem(SDL_INIT_TIMER) with SDL_HINT_TIMER_DISPATCH_THREADS=2");
+
+    SDL_AtomicSet(&g_fastTimerFired, 0);
+    slow = SDL_AddTimerNS(SDL_MS_TO_NS(1), timerSlowCallback, NULL);
+    fast = SDL_AddTimerNS(SDL_MS_TO_NS(10), timerFastCallback, NULL);
+    SDLTest_AssertCheck(slow && fast, "Check timers were added");
+
+    props = SDL_GetTimerProperties(fast);
+    SDLTest_AssertCheck(props != 0, "Check SDL_GetTimerProperties() returned properties");
+    SDLTest_AssertCheck(SDL_GetTimerProperties(0) == 0, "Check SDL_GetTimerProperties(0) fails");
+
+    /* The slow callback blocks one worker, the fast timer should keep firing */
+    SDL_Delay(200);
+    fast_fired = SDL_AtomicGet(&g_fastTimerFired);
+    SDLTest_AssertCheck(fast_fired >= 5, "Check fast timer kept firing during slow callback, expected: >=5, got: %d", fast_fired);
+
+    props = SDL_GetTimerProperties(fast);
+    fired = SDL_GetNumberProperty(props, SDL_PROP_TIMER_FIRED_NUMBER, -1);
+    SDLTest_AssertCheck(fired >= fast_fired, "Check SDL_PROP_TIMER_FIRED_NUMBER, expected: >=%d, got: %" SDL_PRIs64, fast_fired, fired);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_TIMER_MAX_LATE_NS_NUMBER, -1) >= SDL_GetNumberProperty(props, SDL_PROP_TIMER_LATE_NS_NUMBER, -1),
+                        "Check SDL_PROP_TIMER_MAX_LATE_NS_NUMBER >= SDL_PROP_TIMER_LATE_NS_NUMBER");
+    SDLTest_AssertCheck(SDL_SetBooleanProperty(props, SDL_PROP_TIMER_SERIALIZED_BOOLEAN, SDL_TRUE) == 0, "Call to SDL_SetBooleanProperty(SDL_PROP_TIMER_SERIALIZED_BOOLEAN)");
+
+    SDL_Delay(50);
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_fastTimerFired) > fast_fired, "Check serialized timer keeps firing");
+
+    SDL_RemoveTimer(fast);
+    SDL_RemoveTimer(slow);
+
+    /* Put things back the way they were */
+    SDL_QuitSubSystem(SDL_INIT_TIMER);
+    SDL_ResetHint(SDL_HINT_TIMER_DISPATCH_THREADS);
+    while (init_count--) {
+        SDL_InitSubSystem(SDL_INIT_TIMER);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Call to SDL_DelayUntilNS with a series of absolute deadlines
+ */
+static int timer_delayUntilNS(void *arg)
+{
+    const Uint64 frameNS = 5 * SDL_NS_PER_MS;
+    const int numFrames = 10;
+    Uint64 start, deadline, now;
+    int i;
+
+    /* A deadline in the past returns right away */
+    SDL_DelayUntilNS(0);
+    SDLTest_AssertPass("Call to SDL_DelayUntilNS(0)");
+
+    /* Each deadline is computed from the previous one, so lateness doesn't accumulate */
+    start = SDL_GetTicksNS();
+    deadline = start;
+    for (i = 0; i < numFrames; ++i) {
+        deadline += frameNS;
+        SDL_DelayUntilNS(deadline);
+        now = SDL_GetTicksNS();
+        SDLTest_AssertCheck(now >= deadline, "Check wakeup time, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, deadline, now);
+    }
+    SDLTest_AssertPass("Call to SDL_DelayUntilNS() %d times", numFrames);
+
+    /* Relative delays go through the same path */
+    start = SDL_GetTicksNS();
+    SDL_DelayNS(frameNS);
+    now = SDL_GetTicksNS();
+    SDLTest_AssertCheck(now - start >= frameNS, "Check SDL_DelayNS() duration, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, frameNS, now - start);
+
     return TEST_COMPLETED;
 }
 
@@ -187,9 +361,21 @@ static const SDLTest_TestCaseReference timerTest4 = {
     (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    (SDLTest_TestCaseFp)timer_addRemoveManyTimers, "timer_addRemoveManyTimers", "Call to SDL_AddTimerNS and SDL_RemoveTimer with lots of timers", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest6 = {
+    (SDLTest_TestCaseFp)timer_dispatchThreads, "timer_dispatchThreads", "Call to SDL_AddTimerNS with timer dispatch threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest7 = {
+    (SDLTest_TestCaseFp)timer_delayUntilNS, "timer_delayUntilNS", "Call to SDL_DelayUntilNS with absolute deadlines", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, &timerTest7, NULL
 };
 
 /* Timer test suite (global) */
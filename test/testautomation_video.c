@@ -2386,6 +2386,81 @@ static int video_getWindowSurface(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests window surface updates with damage tracking
+ */
+static int video_windowSurfaceDamage(void *arg)
+{
+    const char *title = "video_windowSurfaceDamage Test Window";
+    SDL_Window *window;
+    SDL_Surface *surface, *view, *image;
+    SDL_Rect rect;
+    int i, result;
+
+    SDL_SetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING, "1");
+
+    window = SDL_CreateWindow(title, 320, 320, 0);
+    SDLTest_AssertPass("Call to SDL_CreateWindow('Title',320,320,0)");
+    SDLTest_AssertCheck(window != NULL, "Validate that returned window is not NULL");
+
+    surface = SDL_GetWindowSurface(window);
+    SDLTest_AssertPass("Call to SDL_GetWindowSurface(window)");
+    SDLTest_AssertCheck(surface != NULL, "Validate that returned surface is not NULL");
+    if (!surface) {
+        SDL_DestroyWindow(window);
+        SDL_ResetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING);
+        return TEST_ABORTED;
+    }
+
+    /* The first update covers the whole surface, the second has nothing to do */
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Verify first update; expected: 0, got: %d", result);
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Verify update without changes; expected: 0, got: %d", result);
+
+    /* More changes than the damage can hold separately */
+    for (i = 0; i < 40; ++i) {
+        rect.x = (i * 37) % 300;
+        rect.y = (i * 53) % 300;
+        rect.w = 10;
+        rect.h = 10;
+        SDL_FillSurfaceRect(surface, &rect, SDL_MapSurfaceRGB(surface, (Uint8)i, 0, 0));
+    }
+    SDL_WriteSurfacePixel(surface, 319, 319, 255, 255, 255, 255);
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Verify update after fills; expected: 0, got: %d", result);
+
+    /* Blits into the window surface and views of it */
+    image = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(image != NULL, "Validate that image surface is not NULL");
+    rect.x = 100;
+    rect.y = 100;
+    rect.w = 64;
+    rect.h = 64;
+    view = SDL_CreateSurfaceView(surface, &rect);
+    SDLTest_AssertCheck(view != NULL, "Validate that view surface is not NULL");
+    if (image && view) {
+        SDL_BlitSurface(image, NULL, surface, NULL);
+        SDL_BlitSurfaceScaled(image, NULL, view, NULL, SDL_SCALEMODE_LINEAR);
+        result = SDL_UpdateWindowSurface(window);
+        SDLTest_AssertCheck(result == 0, "Verify update after blits; expected: 0, got: %d", result);
+    }
+    SDL_DestroySurface(view);
+    SDL_DestroySurface(image);
+
+    /* Locking marks the whole surface as changed */
+    SDL_LockSurface(surface);
+    SDL_UnlockSurface(surface);
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Verify update after lock; expected: 0, got: %d", result);
+
+    /* Clean up */
+    SDL_DestroyWindow(window);
+    SDL_ResetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Video test cases */
@@ -2477,6 +2552,10 @@ static const SDLTest_TestCaseReference videoTestGetWindowSurface = {
     (SDLTest_TestCaseFp)video_getWindowSurface, "video_getWindowSurface", "Checks window surface functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference videoTestWindowSurfaceDamage = {
+    (SDLTest_TestCaseFp)video_windowSurfaceDamage, "video_windowSurfaceDamage", "Checks window surface updates with damage tracking", TEST_ENABLED
+};
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTestEnableDisableScreensaver,
@@ -2501,6 +2580,7 @@ static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTestCreateMinimized,
     &videoTestCreateMaximized,
     &videoTestGetWindowSurface,
+    &videoTestWindowSurfaceDamage,
     NULL
 };
 
@@ -0,0 +1,299 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the throughput of every surface blit format and flag combination,
+   and points out the ones that fall through to the generic SDL_Blit_Slow path. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    const char *name;
+    SDL_BlendMode blend;
+    SDL_bool colorkey;
+    SDL_bool modulate_color;
+    SDL_bool modulate_alpha;
+    SDL_bool scale;
+} BlitMode;
+
+static const SDL_PixelFormat formats[] = {
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_XRGB4444,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_XRGB1555,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_BGR565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_XBGR8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_BGRA8888,
+    SDL_PIXELFORMAT_ARGB2101010,
+};
+
+static const BlitMode modes[] = {
+    { "copy", SDL_BLENDMODE_NONE, SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_FALSE },
+    { "colorkey", SDL_BLENDMODE_NONE, SDL_TRUE, SDL_FALSE, SDL_FALSE, SDL_FALSE },
+    { "blend", SDL_BLENDMODE_BLEND, SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_FALSE },
+    { "blend+colorkey", SDL_BLENDMODE_BLEND, SDL_TRUE, SDL_FALSE, SDL_FALSE, SDL_FALSE },
+    { "add", SDL_BLENDMODE_ADD, SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_FALSE },
+    { "mod", SDL_BLENDMODE_MOD, SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_FALSE },
+    { "modulate", SDL_BLENDMODE_NONE, SDL_FALSE, SDL_TRUE, SDL_FALSE, SDL_FALSE },
+    { "modulate+alpha", SDL_BLENDMODE_BLEND, SDL_FALSE, SDL_TRUE, SDL_TRUE, SDL_FALSE },
+    { "scale", SDL_BLENDMODE_NONE, SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_TRUE },
+    { "scale+blend", SDL_BLENDMODE_BLEND, SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_TRUE },
+};
+
+static SDL_LogOutputFunction default_log = NULL;
+static void *default_log_userdata = NULL;
+static SDL_bool slow_blit_seen = SDL_FALSE;
+
+/* SDL_CalculateBlit() logs a debug message when it has to use SDL_Blit_Slow */
+static void SDLCALL capture_slow_blit(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    if (category == SDL_LOG_CATEGORY_VIDEO && priority == SDL_LOG_PRIORITY_DEBUG &&
+        SDL_strncmp(message, "Blit from ", 10) == 0) {
+        if (SDL_strstr(message, "SDL_Blit_Slow")) {
+            slow_blit_seen = SDL_TRUE;
+        }
+        return;
+    }
+    if (priority > SDL_LOG_PRIORITY_DEBUG || category != SDL_LOG_CATEGORY_VIDEO) {
+        default_log(default_log_userdata, category, priority, message);
+    }
+}
+
+static SDL_Surface *create_surface(SDL_PixelFormat format, int w, int h)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+        SDL_Color colors[256];
+        int i;
+
+        if (!palette) {
+            SDL_DestroySurface(surface);
+            return NULL;
+        }
+        for (i = 0; i < SDL_arraysize(colors); i++) {
+            colors[i].r = (Uint8)i;
+            colors[i].g = (Uint8)(255 - i);
+            colors[i].b = (Uint8)(i * 7);
+            colors[i].a = (Uint8)(i | 0x80);
+        }
+        SDL_SetPaletteColors(palette, colors, 0, SDL_arraysize(colors));
+    }
+
+    /* A gradient with some fully transparent / colorkeyed pixels */
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            const Uint8 c = (Uint8)(x + y);
+            SDL_WriteSurfacePixel(surface, x, y, ((x ^ y) & 15) ? c : 0, (Uint8)x, (Uint8)y, ((x ^ y) & 15) ? (Uint8)(x * 3) : 0);
+        }
+    }
+    return surface;
+}
+
+static SDL_bool setup_mode(SDL_Surface *src, const BlitMode *mode)
+{
+    if (SDL_SetSurfaceBlendMode(src, mode->blend) < 0) {
+        return SDL_FALSE;
+    }
+    if (SDL_SetSurfaceColorKey(src, mode->colorkey, SDL_MapSurfaceRGB(src, 0, 0, 0)) < 0) {
+        return SDL_FALSE;
+    }
+    if (mode->modulate_color) {
+        SDL_SetSurfaceColorMod(src, 200, 128, 64);
+    }
+    if (mode->modulate_alpha) {
+        SDL_SetSurfaceAlphaMod(src, 128);
+    }
+    return SDL_TRUE;
+}
+
+static int blit(SDL_Surface *src, SDL_Surface *dst, const BlitMode *mode)
+{
+    if (mode->scale) {
+        return SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_NEAREST);
+    }
+    return SDL_BlitSurface(src, NULL, dst, NULL);
+}
+
+static void log_cpu_features(void)
+{
+    SDL_Log("CPU features:%s%s%s%s%s%s%s%s",
+            SDL_HasMMX() ? " MMX" : "",
+            SDL_HasSSE() ? " SSE" : "",
+            SDL_HasSSE2() ? " SSE2" : "",
+            SDL_HasSSE41() ? " SSE4.1" : "",
+            SDL_HasAVX2() ? " AVX2" : "",
+            SDL_HasAVX512F() ? " AVX-512F" : "",
+            SDL_HasNEON() ? " NEON" : "",
+            SDL_HasAltiVec() ? " AltiVec" : "");
+    SDL_Log("Set " SDL_HINT_CPU_FEATURE_MASK " (for example to \"-avx2\" or \"-all\") to measure other paths.");
+}
+
+static SDL_bool format_matches(SDL_PixelFormat format, const char *filter)
+{
+    const char *name;
+
+    if (!filter) {
+        return SDL_TRUE;
+    }
+    name = SDL_GetPixelFormatName(format);
+    return SDL_strcasecmp(name, filter) == 0 ||
+           (SDL_strncmp(name, "SDL_PIXELFORMAT_", 16) == 0 && SDL_strcasecmp(name + 16, filter) == 0);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *src_filter = NULL;
+    const char *dst_filter = NULL;
+    SDL_bool slow_only = SDL_FALSE;
+    int size = 256;
+    int duration_ms = 50;
+    int entries = 0;
+    int slow_entries = 0;
+    int i, s, d, m;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                size = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration_ms = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--src") == 0 && argv[i + 1]) {
+                src_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--dst") == 0 && argv[i + 1]) {
+                dst_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--slow-only") == 0) {
+                slow_only = SDL_TRUE;
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0 || size < 2 || duration_ms < 1) {
+            static const char *options[] = { "[--size pixels]", "[--duration ms]", "[--src FORMAT]", "[--dst FORMAT]", "[--slow-only]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    log_cpu_features();
+    SDL_Log("%dx%d pixels, at least %d ms per entry", size, size, duration_ms);
+    SDL_Log("%-28s %-28s %-16s %12s", "Source", "Destination", "Mode", "Mpixels/s");
+
+    SDL_GetLogOutputFunction(&default_log, &default_log_userdata);
+    SDL_SetLogOutputFunction(capture_slow_blit, NULL);
+    SDL_SetLogPriority(SDL_LOG_CATEGORY_VIDEO, SDL_LOG_PRIORITY_DEBUG);
+
+    for (s = 0; s < SDL_arraysize(formats); s++) {
+        if (!format_matches(formats[s], src_filter)) {
+            continue;
+        }
+        for (d = 0; d < SDL_arraysize(formats); d++) {
+            SDL_Surface *dst;
+
+            if (!format_matches(formats[d], dst_filter)) {
+                continue;
+            }
+
+            dst = create_surface(formats[d], size, size);
+            if (!dst) {
+                SDL_Log("Couldn't create %s surface: %s", SDL_GetPixelFormatName(formats[d]), SDL_GetError());
+                continue;
+            }
+
+            for (m = 0; m < SDL_arraysize(modes); m++) {
+                const BlitMode *mode = &modes[m];
+                const int src_size = mode->scale ? (size * 2) / 3 : size;
+                const Uint64 frequency = SDL_GetPerformanceFrequency();
+                const Uint64 min_ticks = (frequency * duration_ms) / 1000;
+                SDL_Surface *src = create_surface(formats[s], src_size, src_size);
+                Uint64 start, elapsed;
+                int count = 0;
+                double mpixels;
+
+                if (!src || !setup_mode(src, mode)) {
+                    SDL_DestroySurface(src);
+                    continue;
+                }
+
+                /* Warm up, which also picks the blitter and tells us if it's the slow one */
+                slow_blit_seen = SDL_FALSE;
+                if (blit(src, dst, mode) < 0) {
+                    SDL_DestroySurface(src);
+                    continue;
+                }
+                blit(src, dst, mode);
+
+                start = SDL_GetPerformanceCounter();
+                do {
+                    blit(src, dst, mode);
+                    count++;
+                    elapsed = SDL_GetPerformanceCounter() - start;
+                } while (elapsed < min_ticks);
+
+                mpixels = ((double)size * size * count) / ((double)elapsed / frequency) / 1000000.0;
+
+                ++entries;
+                if (slow_blit_seen) {
+                    ++slow_entries;
+                }
+                if (slow_blit_seen || !slow_only) {
+                    SDL_Log("%-28s %-28s %-16s %12.1f%s", SDL_GetPixelFormatName(formats[s]), SDL_GetPixelFormatName(formats[d]),
+                            mode->name, mpixels, slow_blit_seen ? "  SDL_Blit_Slow" : "");
+                }
+
+                SDL_DestroySurface(src);
+            }
+
+            SDL_DestroySurface(dst);
+        }
+    }
+
+    SDL_SetLogOutputFunction(default_log, default_log_userdata);
+
+    SDL_Log("%d combinations measured, %d use SDL_Blit_Slow", entries, slow_entries);
+
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
@@ -0,0 +1,476 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the event queue: SDL_PushEvent/SDL_PollEvent throughput with several
+   producer threads, SDL_PeepEvents filtering cost at various queue depths, the
+   overhead of event watchers, and on Linux the end-to-end latency of input from
+   a synthetic uinput joystick to SDL_PollEvent(). */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#ifdef SDL_PLATFORM_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/uinput.h>
+#endif
+
+#define MAX_PRODUCERS       16
+#define MAX_LATENCY_SAMPLES (256 * 1024)
+
+static int duration_ms = 200;
+static int max_producers = 8;
+static Uint64 *latency_samples = NULL;
+static int num_latency_samples = 0;
+
+static SDL_bool time_elapsed(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) >= (SDL_GetPerformanceFrequency() * duration_ms) / 1000;
+}
+
+static double elapsed_seconds(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static int SDLCALL compare_uint64(const void *a, const void *b)
+{
+    const Uint64 A = *(const Uint64 *)a;
+    const Uint64 B = *(const Uint64 *)b;
+    return (A < B) ? -1 : (A > B) ? 1 : 0;
+}
+
+static void add_latency_sample(Uint64 ns)
+{
+    if (num_latency_samples < MAX_LATENCY_SAMPLES) {
+        latency_samples[num_latency_samples++] = ns;
+    }
+}
+
+static Uint64 latency_percentile(int percent)
+{
+    if (num_latency_samples == 0) {
+        return 0;
+    }
+    return latency_samples[((num_latency_samples - 1) * percent) / 100];
+}
+
+static void sort_latency_samples(void)
+{
+    SDL_qsort(latency_samples, num_latency_samples, sizeof(*latency_samples), compare_uint64);
+}
+
+typedef struct
+{
+    SDL_AtomicInt *stop;
+    Uint32 type;
+    Uint64 pushed;
+    Uint64 rejected;
+} Producer;
+
+static int SDLCALL producer_thread(void *data)
+{
+    Producer *producer = (Producer *)data;
+    SDL_Event event;
+
+    SDL_zero(event);
+    while (!SDL_AtomicGet(producer->stop)) {
+        event.type = producer->type;
+        event.common.timestamp = 0; /* let SDL stamp it, that's what the latency is measured against */
+        if (SDL_PushEvent(&event) == 1) {
+            ++producer->pushed;
+        } else {
+            /* The queue is full, give the consumer a chance to catch up */
+            ++producer->rejected;
+            SDL_CPUPauseInstruction();
+        }
+    }
+    return 0;
+}
+
+static void bench_push_poll(void)
+{
+    int num_producers;
+
+    SDL_Log("Push/poll throughput:");
+    SDL_Log("  %9s %14s %14s %12s %12s %12s", "producers", "pushed/s", "polled/s", "queue full", "p50 lat us", "p99 lat us");
+
+    for (num_producers = 1; num_producers <= max_producers; num_producers *= 2) {
+        Producer producers[MAX_PRODUCERS];
+        SDL_Thread *threads[MAX_PRODUCERS];
+        SDL_AtomicInt stop;
+        SDL_Event event;
+        Uint64 start, polled = 0, pushed = 0, rejected = 0;
+        double seconds;
+        int i;
+
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+        SDL_AtomicSet(&stop, 0);
+        num_latency_samples = 0;
+
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i < num_producers; i++) {
+            SDL_zero(producers[i]);
+            producers[i].stop = &stop;
+            producers[i].type = SDL_EVENT_USER;
+            threads[i] = SDL_CreateThread(producer_thread, "EventProducer", &producers[i]);
+        }
+
+        while (!time_elapsed(start)) {
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_EVENT_USER) {
+                    add_latency_sample(SDL_GetTicksNS() - event.common.timestamp);
+                    ++polled;
+                }
+            }
+        }
+        seconds = elapsed_seconds(start);
+
+        SDL_AtomicSet(&stop, 1);
+        for (i = 0; i < num_producers; i++) {
+            SDL_WaitThread(threads[i], NULL);
+            pushed += producers[i].pushed;
+            rejected += producers[i].rejected;
+        }
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+        sort_latency_samples();
+        SDL_Log("  %9d %14.0f %14.0f %12" SDL_PRIu64 " %12.2f %12.2f", num_producers,
+                pushed / seconds, polled / seconds, rejected,
+                latency_percentile(50) / 1000.0, latency_percentile(99) / 1000.0);
+    }
+}
+
+static void bench_peep(void)
+{
+    static const int depths[] = { 16, 256, 4096, 32768 };
+    int i;
+
+    SDL_Log("SDL_PeepEvents filtering cost (queue holds SDL_EVENT_USER, the filter looks for SDL_EVENT_USER + 1):");
+    SDL_Log("  %7s %12s %12s %14s", "depth", "peek ns", "has ns", "ns per event");
+
+    for (i = 0; i < SDL_arraysize(depths); i++) {
+        SDL_Event event;
+        Uint64 start, peeks = 0, has = 0;
+        double peek_ns, has_ns;
+        int j;
+
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        for (j = 0; j < depths[i]; j++) {
+            if (SDL_PushEvent(&event) != 1) {
+                break;
+            }
+        }
+
+        start = SDL_GetPerformanceCounter();
+        while (!time_elapsed(start)) {
+            SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_EVENT_USER + 1, SDL_EVENT_USER + 1);
+            ++peeks;
+        }
+        peek_ns = (elapsed_seconds(start) * 1e9) / peeks;
+
+        start = SDL_GetPerformanceCounter();
+        while (!time_elapsed(start)) {
+            SDL_HasEvent(SDL_EVENT_USER + 1);
+            ++has;
+        }
+        has_ns = (elapsed_seconds(start) * 1e9) / has;
+
+        SDL_Log("  %7d %12.1f %12.1f %14.3f", depths[i], peek_ns, has_ns, peek_ns / depths[i]);
+    }
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+}
+
+static SDL_bool SDLCALL count_watcher(void *userdata, SDL_Event *event)
+{
+    (void)event;
+    ++*(Uint64 *)userdata;
+    return SDL_TRUE;
+}
+
+static void bench_watchers(void)
+{
+    static const int watcher_counts[] = { 0, 1, 4, 16, 64 };
+    double baseline_ns = 0.0;
+    Uint64 watched = 0;
+    int i;
+
+    SDL_Log("Event watcher overhead (push followed by poll, one thread):");
+    SDL_Log("  %8s %14s %14s", "watchers", "ns per event", "ns per watch");
+
+    for (i = 0; i < SDL_arraysize(watcher_counts); i++) {
+        SDL_Event event;
+        Uint64 start, events = 0;
+        double ns;
+        int j;
+
+        for (j = 0; j < watcher_counts[i]; j++) {
+            SDL_AddEventWatch(count_watcher, &watched);
+        }
+
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+        SDL_zero(event);
+        start = SDL_GetPerformanceCounter();
+        while (!time_elapsed(start)) {
+            /* Batch a little so polling isn't dominated by pumping */
+            for (j = 0; j < 64; j++) {
+                event.type = SDL_EVENT_USER;
+                event.common.timestamp = 0;
+                SDL_PushEvent(&event);
+            }
+            while (SDL_PollEvent(&event)) {
+                ++events;
+            }
+        }
+        ns = (elapsed_seconds(start) * 1e9) / events;
+        if (watcher_counts[i] == 0) {
+            baseline_ns = ns;
+            SDL_Log("  %8d %14.1f %14s", watcher_counts[i], ns, "-");
+        } else {
+            SDL_Log("  %8d %14.1f %14.2f", watcher_counts[i], ns, (ns - baseline_ns) / watcher_counts[i]);
+        }
+
+        for (j = 0; j < watcher_counts[i]; j++) {
+            SDL_DelEventWatch(count_watcher, &watched);
+        }
+    }
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+}
+
+#if defined(SDL_PLATFORM_LINUX) && defined(UI_DEV_SETUP)
+#define UINPUT_DEVICE_NAME "SDL event latency test"
+#define UINPUT_PRESSES     200
+
+static void uinput_emit(int fd, int type, int code, int value)
+{
+    struct input_event ie;
+
+    SDL_zero(ie);
+    ie.type = type;
+    ie.code = code;
+    ie.value = value;
+    if (write(fd, &ie, sizeof(ie)) != sizeof(ie)) {
+        SDL_Log("uinput write failed: %s", strerror(errno));
+    }
+}
+
+static int uinput_create(void)
+{
+    struct uinput_setup setup;
+    struct uinput_abs_setup abs;
+    int axis;
+    int fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+
+    if (fd < 0) {
+        return -1;
+    }
+
+    /* A minimal gamepad, so SDL's evdev backend classifies it as a joystick */
+    ioctl(fd, UI_SET_EVBIT, EV_KEY);
+    ioctl(fd, UI_SET_KEYBIT, BTN_SOUTH);
+    ioctl(fd, UI_SET_KEYBIT, BTN_EAST);
+    ioctl(fd, UI_SET_EVBIT, EV_ABS);
+    for (axis = ABS_X; axis <= ABS_Y; axis++) {
+        SDL_zero(abs);
+        abs.code = axis;
+        abs.absinfo.minimum = -32768;
+        abs.absinfo.maximum = 32767;
+        ioctl(fd, UI_SET_ABSBIT, axis);
+        ioctl(fd, UI_ABS_SETUP, &abs);
+    }
+
+    SDL_zero(setup);
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x1209; /* pid.codes test vendor */
+    setup.id.product = 0x0001;
+    SDL_strlcpy(setup.name, UINPUT_DEVICE_NAME, sizeof(setup.name));
+    if (ioctl(fd, UI_DEV_SETUP, &setup) < 0 || ioctl(fd, UI_DEV_CREATE) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static SDL_Joystick *wait_for_uinput_joystick(void)
+{
+    const Uint64 timeout = SDL_GetTicks() + 5000;
+    SDL_Event event;
+
+    while (SDL_GetTicks() < timeout) {
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_JOYSTICK_ADDED) {
+                const char *name = SDL_GetJoystickNameForID(event.jdevice.which);
+                if (name && SDL_strcmp(name, UINPUT_DEVICE_NAME) == 0) {
+                    return SDL_OpenJoystick(event.jdevice.which);
+                }
+            }
+        }
+        SDL_Delay(10);
+    }
+    return NULL;
+}
+
+static void bench_uinput_latency(void)
+{
+    SDL_Joystick *joystick;
+    Uint64 to_queue[UINPUT_PRESSES];
+    int num_to_queue = 0;
+    int fd, i;
+
+    SDL_Log("End-to-end input latency (uinput button write to SDL_PollEvent):");
+
+    if (SDL_InitSubSystem(SDL_INIT_JOYSTICK) < 0) {
+        SDL_Log("  skipped, couldn't initialize joysticks: %s", SDL_GetError());
+        return;
+    }
+
+    fd = uinput_create();
+    if (fd < 0) {
+        SDL_Log("  skipped, couldn't create a uinput device: %s", strerror(errno));
+        SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+        return;
+    }
+
+    joystick = wait_for_uinput_joystick();
+    if (!joystick) {
+        SDL_Log("  skipped, SDL didn't pick up the uinput device (check /dev/input permissions)");
+        ioctl(fd, UI_DEV_DESTROY);
+        close(fd);
+        SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+        return;
+    }
+
+    num_latency_samples = 0;
+    for (i = 0; i < UINPUT_PRESSES; i++) {
+        const Uint8 down = (i % 2) == 0;
+        const Uint64 timeout = SDL_GetTicksNS() + SDL_NS_PER_SECOND;
+        const Uint64 written = SDL_GetTicksNS();
+        SDL_Event event;
+        SDL_bool seen = SDL_FALSE;
+
+        uinput_emit(fd, EV_KEY, BTN_SOUTH, down);
+        uinput_emit(fd, EV_SYN, SYN_REPORT, 0);
+
+        while (!seen && SDL_GetTicksNS() < timeout) {
+            while (SDL_PollEvent(&event)) {
+                if ((event.type == SDL_EVENT_JOYSTICK_BUTTON_DOWN || event.type == SDL_EVENT_JOYSTICK_BUTTON_UP) &&
+                    event.jbutton.which == SDL_GetJoystickID(joystick)) {
+                    add_latency_sample(SDL_GetTicksNS() - written);
+                    if (event.common.timestamp > written) {
+                        to_queue[num_to_queue++] = event.common.timestamp - written;
+                    }
+                    seen = SDL_TRUE;
+                    break;
+                }
+            }
+        }
+        if (!seen) {
+            SDL_Log("  button event %d never arrived", i);
+            break;
+        }
+        SDL_Delay(2);
+    }
+
+    sort_latency_samples();
+    SDL_qsort(to_queue, num_to_queue, sizeof(*to_queue), compare_uint64);
+    SDL_Log("  %d presses, to poll p50 %.1f us p99 %.1f us, to queue p50 %.1f us",
+            num_latency_samples, latency_percentile(50) / 1000.0, latency_percentile(99) / 1000.0,
+            num_to_queue ? to_queue[num_to_queue / 2] / 1000.0 : 0.0);
+
+    SDL_CloseJoystick(joystick);
+    ioctl(fd, UI_DEV_DESTROY);
+    close(fd);
+    SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+}
+#else
+static void bench_uinput_latency(void)
+{
+    SDL_Log("End-to-end input latency: skipped, uinput is only available on Linux");
+}
+#endif /* SDL_PLATFORM_LINUX && UI_DEV_SETUP */
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *only = NULL;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration_ms = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                max_producers = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--only") == 0 && argv[i + 1]) {
+                only = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || duration_ms < 1 || max_producers < 1 || max_producers > MAX_PRODUCERS) {
+            static const char *options[] = { "[--duration ms]", "[--threads 1-16]", "[--only push|peep|watch|uinput]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_Log("Couldn't initialize events: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    latency_samples = (Uint64 *)SDL_malloc(MAX_LATENCY_SAMPLES * sizeof(*latency_samples));
+    if (!latency_samples) {
+        SDL_Quit();
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    SDL_Log("Each measurement runs for at least %d ms", duration_ms);
+    if (!only || SDL_strcmp(only, "push") == 0) {
+        bench_push_poll();
+    }
+    if (!only || SDL_strcmp(only, "peep") == 0) {
+        bench_peep();
+    }
+    if (!only || SDL_strcmp(only, "watch") == 0) {
+        bench_watchers();
+    }
+    if (!only || SDL_strcmp(only, "uinput") == 0) {
+        bench_uinput_latency();
+    }
+
+    SDL_free(latency_samples);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
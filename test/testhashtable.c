@@ -0,0 +1,209 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks and times the internal hash table: insert, find and remove. */
+
+/* Hack #1: avoid inclusion of SDL_main.h by SDL_internal.h */
+#define SDL_main_h_
+
+/* Hack #2: avoid dynapi renaming (must be done before #include <SDL3/SDL.h>) */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+
+/* Hack #3: undo Hack #1 */
+#ifdef SDL_main_h_
+#undef SDL_main_h_
+#endif
+#ifdef SDL_MAIN_NOIMPL
+#undef SDL_MAIN_NOIMPL
+#endif
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include "../src/SDL_hashtable.c"
+
+#define NUM_KEYS 200000
+
+static int num_nuked;
+
+static void SDLCALL count_nuke(const void *key, const void *value, void *data)
+{
+    ++num_nuked;
+}
+
+static const void *make_key(int i)
+{
+    /* Spread the keys out like pointers would be, 0 isn't a valid key for SDL_HashID callers. */
+    return (const void *)(uintptr_t)((Uint32)(i + 1) * 16);
+}
+
+static double elapsed_ms(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static SDL_bool test_basic(void)
+{
+    SDL_HashTable *table;
+    const void *value = NULL;
+    const void *key = NULL;
+    void *iter = NULL;
+    int i, count;
+    Uint64 start;
+
+    /* Start small so the table has to grow a lot on the way. */
+    table = SDL_CreateHashTable(NULL, 4, SDL_HashID, SDL_KeyMatchID, count_nuke, SDL_FALSE);
+    if (!table) {
+        SDL_Log("SDL_CreateHashTable() failed: %s", SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < NUM_KEYS; ++i) {
+        if (!SDL_InsertIntoHashTable(table, make_key(i), (const void *)(uintptr_t)i)) {
+            SDL_Log("Insert of key %d failed", i);
+            return SDL_FALSE;
+        }
+    }
+    SDL_Log("Inserted %d keys in %.2f ms", NUM_KEYS, elapsed_ms(start));
+
+    if (SDL_InsertIntoHashTable(table, make_key(0), NULL)) {
+        SDL_Log("Duplicate insert into a non-stackable table succeeded");
+        return SDL_FALSE;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < NUM_KEYS; ++i) {
+        if (!SDL_FindInHashTable(table, make_key(i), &value) || value != (const void *)(uintptr_t)i) {
+            SDL_Log("Find of key %d failed", i);
+            return SDL_FALSE;
+        }
+    }
+    SDL_Log("Found %d keys in %.2f ms", NUM_KEYS, elapsed_ms(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = NUM_KEYS; i < NUM_KEYS * 2; ++i) {
+        if (SDL_FindInHashTable(table, make_key(i), NULL)) {
+            SDL_Log("Found key %d that was never inserted", i);
+            return SDL_FALSE;
+        }
+    }
+    SDL_Log("Missed %d keys in %.2f ms", NUM_KEYS, elapsed_ms(start));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < NUM_KEYS; i += 2) {
+        if (!SDL_RemoveFromHashTable(table, make_key(i))) {
+            SDL_Log("Remove of key %d failed", i);
+            return SDL_FALSE;
+        }
+    }
+    SDL_Log("Removed %d keys in %.2f ms", NUM_KEYS / 2, elapsed_ms(start));
+
+    if (num_nuked != NUM_KEYS / 2) {
+        SDL_Log("Expected %d nuked items, got %d", NUM_KEYS / 2, num_nuked);
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < NUM_KEYS; ++i) {
+        const SDL_bool expected = (i % 2) != 0;
+        if (SDL_FindInHashTable(table, make_key(i), NULL) != expected) {
+            SDL_Log("Key %d should %sbe present after removal", i, expected ? "" : "not ");
+            return SDL_FALSE;
+        }
+    }
+
+    count = 0;
+    while (SDL_IterateHashTable(table, &key, &value, &iter)) {
+        if ((uintptr_t)key != (uintptr_t)make_key((int)(uintptr_t)value)) {
+            SDL_Log("Iterated key doesn't match its value");
+            return SDL_FALSE;
+        }
+        ++count;
+    }
+    if (count != NUM_KEYS / 2) {
+        SDL_Log("Expected to iterate %d items, got %d", NUM_KEYS / 2, count);
+        return SDL_FALSE;
+    }
+
+    SDL_EmptyHashTable(table);
+    if (!SDL_HashTableEmpty(table) || num_nuked != NUM_KEYS) {
+        SDL_Log("SDL_EmptyHashTable() didn't remove everything");
+        return SDL_FALSE;
+    }
+
+    SDL_DestroyHashTable(table);
+    return SDL_TRUE;
+}
+
+static SDL_bool test_stackable(void)
+{
+    SDL_HashTable *table;
+    const void *value = NULL;
+    void *iter = NULL;
+    Uint32 seen = 0;
+    int i;
+
+    table = SDL_CreateHashTable(NULL, 16, SDL_HashString, SDL_KeyMatchString, NULL, SDL_TRUE);
+    if (!table) {
+        SDL_Log("SDL_CreateHashTable() failed: %s", SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    SDL_InsertIntoHashTable(table, "other", (const void *)(uintptr_t)100);
+    for (i = 0; i < 8; ++i) {
+        SDL_InsertIntoHashTable(table, "key", (const void *)(uintptr_t)i);
+    }
+
+    while (SDL_IterateHashTableKey(table, "key", &value, &iter)) {
+        seen |= (1u << (uintptr_t)value);
+    }
+    if (seen != 0xFF) {
+        SDL_Log("Stacked values weren't all found: 0x%" SDL_PRIx32, seen);
+        return SDL_FALSE;
+    }
+
+    SDL_DestroyHashTable(table);
+    return SDL_TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    int result;
+    SDLTest_CommonState *state;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    result = (test_basic() && test_stackable()) ? 0 : 1;
+    if (result == 0) {
+        SDL_Log("All hash table tests passed");
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
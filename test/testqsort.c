@@ -61,6 +61,84 @@ test_sort(const char *desc, int *nums, const int arraylen)
     }
 }
 
+typedef struct
+{
+    Uint32 id;
+    float depth;
+    Uint8 pad;
+} sprite;
+
+static int SDLCALL
+sprite_compare(const void *_a, const void *_b)
+{
+    const sprite *a = (const sprite *)_a;
+    const sprite *b = (const sprite *)_b;
+    if (a->depth < b->depth) {
+        return -1;
+    } else if (a->depth > b->depth) {
+        return 1;
+    }
+    return (a->id < b->id) ? -1 : ((a->id > b->id) ? 1 : 0);
+}
+
+static void
+test_radix(const char *desc, const int *nums, const int arraylen)
+{
+    static sprite sprites[1024 * 100];
+    static Sint64 wide[1024 * 100];
+    Uint64 start, qsort_ticks, radix_ticks;
+    int i;
+
+    SDL_assert(SDL_arraysize(sprites) >= arraylen);
+
+    SDL_Log("test: %s (radix) arraylen=%d", desc, arraylen);
+
+    /* Sort by float depth, the id breaks ties to check the sort is stable */
+    for (i = 0; i < arraylen; i++) {
+        sprites[i].id = (Uint32)i;
+        sprites[i].depth = (float)(nums[i] % 1000) - 500.0f;
+        sprites[i].pad = 0;
+    }
+    start = SDL_GetPerformanceCounter();
+    if (SDL_RadixSort32(sprites, arraylen, sizeof(sprites[0]), (size_t)((Uint8 *)&sprites[0].depth - (Uint8 *)&sprites[0]), SDL_RADIX_KEY_FLOAT) < 0) {
+        SDL_Log("SDL_RadixSort32 failed: %s", SDL_GetError());
+        return;
+    }
+    radix_ticks = SDL_GetPerformanceCounter() - start;
+    for (i = 1; i < arraylen; i++) {
+        if (sprite_compare(&sprites[i - 1], &sprites[i]) > 0) {
+            SDL_Log("radix sort is broken!");
+            return;
+        }
+    }
+
+    for (i = 0; i < arraylen; i++) {
+        sprites[i].id = (Uint32)i;
+        sprites[i].depth = (float)(nums[i] % 1000) - 500.0f;
+    }
+    start = SDL_GetPerformanceCounter();
+    SDL_qsort(sprites, arraylen, sizeof(sprites[0]), sprite_compare);
+    qsort_ticks = SDL_GetPerformanceCounter() - start;
+
+    SDL_Log("  qsort: %.3f ms, radix sort: %.3f ms",
+            (double)qsort_ticks * 1000.0 / SDL_GetPerformanceFrequency(),
+            (double)radix_ticks * 1000.0 / SDL_GetPerformanceFrequency());
+
+    for (i = 0; i < arraylen; i++) {
+        wide[i] = ((Sint64)nums[i] - 500000) * 0x100000001LL;
+    }
+    if (SDL_RadixSort64(wide, arraylen, sizeof(wide[0]), 0, SDL_RADIX_KEY_SIGNED) < 0) {
+        SDL_Log("SDL_RadixSort64 failed: %s", SDL_GetError());
+        return;
+    }
+    for (i = 1; i < arraylen; i++) {
+        if (wide[i - 1] > wide[i]) {
+            SDL_Log("64-bit radix sort is broken!");
+            return;
+        }
+    }
+}
+
 int main(int argc, char *argv[])
 {
     static int nums[1024 * 100];
@@ -133,6 +211,17 @@ int main(int argc, char *argv[])
             nums[i] = SDL_rand_r(&seed, 1000000);
         }
         test_sort("random sorted", nums, arraylen);
+
+        /* Median-of-3 killer, this used to go quadratic */
+        for (i = 0; i < arraylen; i++) {
+            nums[i] = (i % 2) ? (arraylen / 2 + i) : i;
+        }
+        test_sort("median-of-3 killer", nums, arraylen);
+
+        for (i = 0; i < arraylen; i++) {
+            nums[i] = SDL_rand_r(&seed, 1000000);
+        }
+        test_radix("random sorted", nums, arraylen);
     }
 
     SDL_Quit();
@@ -0,0 +1,460 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Runs a fixed set of scenes on every render driver and reports frame time statistics,
+   so backends can be compared against each other and across releases.
+
+   This works headless too: with SDL_VIDEO_DRIVER=dummy only the software renderer is available. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define WINDOW_WIDTH  1280
+#define WINDOW_HEIGHT 720
+#define ATLAS_SIZE    256
+#define ATLAS_CELLS   4
+#define CELL_SIZE     (ATLAS_SIZE / ATLAS_CELLS)
+
+typedef struct
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *atlas;
+    SDL_Texture *targets[2];
+    int sprites;
+    int frame;
+} SceneContext;
+
+typedef void (*SceneFunc)(SceneContext *ctx);
+
+typedef struct
+{
+    const char *name;
+    SceneFunc draw;
+} Scene;
+
+/* Deterministic positions, so every driver gets the same work */
+static Uint32 scene_random(Uint32 *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+static void sprite_position(Uint32 *state, int frame, SDL_FRect *rect)
+{
+    const float w = (float)(CELL_SIZE / 2 + scene_random(state) % CELL_SIZE);
+    rect->w = w;
+    rect->h = w;
+    rect->x = (float)((scene_random(state) + frame * 3) % (WINDOW_WIDTH - (int)w));
+    rect->y = (float)((scene_random(state) + frame * 2) % (WINDOW_HEIGHT - (int)w));
+}
+
+static void atlas_cell(Uint32 *state, SDL_FRect *rect)
+{
+    const Uint32 cell = scene_random(state) % (ATLAS_CELLS * ATLAS_CELLS);
+    rect->x = (float)((cell % ATLAS_CELLS) * CELL_SIZE);
+    rect->y = (float)((cell / ATLAS_CELLS) * CELL_SIZE);
+    rect->w = (float)CELL_SIZE;
+    rect->h = (float)CELL_SIZE;
+}
+
+static void draw_sprites(SceneContext *ctx)
+{
+    Uint32 state = 1;
+    int i;
+
+    SDL_SetTextureBlendMode(ctx->atlas, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < ctx->sprites; i++) {
+        SDL_FRect src, dst;
+        atlas_cell(&state, &src);
+        sprite_position(&state, ctx->frame, &dst);
+        SDL_RenderTexture(ctx->renderer, ctx->atlas, &src, &dst);
+    }
+}
+
+static void draw_blendmodes(SceneContext *ctx)
+{
+    static const SDL_BlendMode blendmodes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    Uint32 state = 2;
+    int i;
+
+    /* Changing state every draw defeats batching, which is the point */
+    for (i = 0; i < ctx->sprites / 2; i++) {
+        const SDL_BlendMode blendmode = blendmodes[i % SDL_arraysize(blendmodes)];
+        SDL_FRect src, dst;
+
+        atlas_cell(&state, &src);
+        sprite_position(&state, ctx->frame, &dst);
+        if (i & 1) {
+            SDL_SetTextureBlendMode(ctx->atlas, blendmode);
+            SDL_SetTextureColorMod(ctx->atlas, (Uint8)i, (Uint8)(i * 3), 255);
+            SDL_RenderTexture(ctx->renderer, ctx->atlas, &src, &dst);
+        } else {
+            SDL_SetRenderDrawBlendMode(ctx->renderer, blendmode);
+            SDL_SetRenderDrawColor(ctx->renderer, (Uint8)(i * 5), (Uint8)i, 128, 128);
+            SDL_RenderFillRect(ctx->renderer, &dst);
+        }
+    }
+    SDL_SetTextureColorMod(ctx->atlas, 255, 255, 255);
+    SDL_SetRenderDrawBlendMode(ctx->renderer, SDL_BLENDMODE_NONE);
+}
+
+static void draw_geometry(SceneContext *ctx)
+{
+    const int segments = 32;
+    const int meshes = SDL_max(ctx->sprites / 10, 1);
+    SDL_Vertex vertices[32 + 1];
+    int indices[32 * 3];
+    Uint32 state = 3;
+    int i, j;
+
+    for (j = 0; j < segments; j++) {
+        indices[j * 3 + 0] = 0;
+        indices[j * 3 + 1] = 1 + j;
+        indices[j * 3 + 2] = 1 + ((j + 1) % segments);
+    }
+
+    SDL_SetTextureBlendMode(ctx->atlas, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < meshes; i++) {
+        SDL_FRect dst;
+        const float radius = 40.0f;
+
+        sprite_position(&state, ctx->frame, &dst);
+        vertices[0].position.x = dst.x + radius;
+        vertices[0].position.y = dst.y + radius;
+        vertices[0].color.r = vertices[0].color.g = vertices[0].color.b = vertices[0].color.a = 1.0f;
+        vertices[0].tex_coord.x = vertices[0].tex_coord.y = 0.5f;
+        for (j = 0; j < segments; j++) {
+            const float angle = (2.0f * SDL_PI_F * j) / segments + (ctx->frame * 0.01f);
+            SDL_Vertex *v = &vertices[1 + j];
+            v->position.x = vertices[0].position.x + SDL_cosf(angle) * radius;
+            v->position.y = vertices[0].position.y + SDL_sinf(angle) * radius;
+            v->color.r = (float)j / segments;
+            v->color.g = 1.0f - v->color.r;
+            v->color.b = 0.5f;
+            v->color.a = 0.75f;
+            v->tex_coord.x = 0.5f + SDL_cosf(angle) * 0.5f;
+            v->tex_coord.y = 0.5f + SDL_sinf(angle) * 0.5f;
+        }
+        SDL_RenderGeometry(ctx->renderer, (i & 1) ? ctx->atlas : NULL, vertices, segments + 1, indices, segments * 3);
+    }
+}
+
+static void draw_ninegrid(SceneContext *ctx)
+{
+    const SDL_FRect src = { 0.0f, 0.0f, (float)CELL_SIZE, (float)CELL_SIZE };
+    const int panels = SDL_max(ctx->sprites / 10, 1);
+    Uint32 state = 4;
+    int i;
+
+    SDL_SetTextureBlendMode(ctx->atlas, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < panels; i++) {
+        SDL_FRect dst;
+        sprite_position(&state, ctx->frame, &dst);
+        dst.w *= 2.0f;
+        dst.h *= 1.5f;
+        SDL_RenderTexture9Grid(ctx->renderer, ctx->atlas, &src, 8.0f, 8.0f, 8.0f, 8.0f, 1.0f, &dst);
+    }
+}
+
+static void draw_text(SceneContext *ctx)
+{
+    const int lines = SDL_max(ctx->sprites / 20, 1);
+    char text[80];
+    int i;
+
+    SDL_SetRenderDrawColor(ctx->renderer, 255, 255, 255, 255);
+    for (i = 0; i < lines; i++) {
+        const float y = (float)((i * 10) % (WINDOW_HEIGHT - 10));
+        const float x = (float)(((i * 10) / (WINDOW_HEIGHT - 10)) * 8 % 640);
+        SDL_snprintf(text, sizeof(text), "Line %d of frame %d: the quick brown fox jumps over the lazy dog", i, ctx->frame);
+        SDLTest_DrawString(ctx->renderer, x, y, text);
+    }
+}
+
+static void draw_targets(SceneContext *ctx)
+{
+    const int switches = 8;
+    Uint32 state = 5;
+    int i, j;
+
+    for (i = 0; i < switches; i++) {
+        SDL_Texture *target = ctx->targets[i & 1];
+        SDL_FRect dst;
+
+        SDL_SetRenderTarget(ctx->renderer, target);
+        SDL_SetRenderDrawColor(ctx->renderer, (Uint8)(i * 30), 0, 0, 255);
+        SDL_RenderClear(ctx->renderer);
+        for (j = 0; j < ctx->sprites / (switches * 4); j++) {
+            SDL_FRect src;
+            atlas_cell(&state, &src);
+            sprite_position(&state, ctx->frame, &dst);
+            dst.x = SDL_fmodf(dst.x, (float)ATLAS_SIZE);
+            dst.y = SDL_fmodf(dst.y, (float)ATLAS_SIZE);
+            SDL_RenderTexture(ctx->renderer, ctx->atlas, &src, &dst);
+        }
+
+        SDL_SetRenderTarget(ctx->renderer, NULL);
+        dst.x = (float)((i * ATLAS_SIZE) % WINDOW_WIDTH);
+        dst.y = (float)(((i * ATLAS_SIZE) / WINDOW_WIDTH) * ATLAS_SIZE);
+        dst.w = dst.h = (float)ATLAS_SIZE;
+        SDL_RenderTexture(ctx->renderer, target, NULL, &dst);
+    }
+}
+
+static const Scene scenes[] = {
+    { "sprites", draw_sprites },
+    { "blendmodes", draw_blendmodes },
+    { "geometry", draw_geometry },
+    { "ninegrid", draw_ninegrid },
+    { "text", draw_text },
+    { "targets", draw_targets },
+};
+
+static SDL_Texture *create_atlas(SDL_Renderer *renderer)
+{
+    SDL_Surface *surface = SDL_CreateSurface(ATLAS_SIZE, ATLAS_SIZE, SDL_PIXELFORMAT_RGBA32);
+    SDL_Texture *texture = NULL;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+
+    /* Each cell is a soft colored disc with a frame, usable for sprites and 9-grid alike */
+    for (y = 0; y < ATLAS_SIZE; y++) {
+        for (x = 0; x < ATLAS_SIZE; x++) {
+            const int cell = (y / CELL_SIZE) * ATLAS_CELLS + (x / CELL_SIZE);
+            const int cx = (x % CELL_SIZE) - CELL_SIZE / 2;
+            const int cy = (y % CELL_SIZE) - CELL_SIZE / 2;
+            const int d2 = cx * cx + cy * cy;
+            const SDL_bool border = (x % CELL_SIZE) < 4 || (y % CELL_SIZE) < 4 ||
+                                    (x % CELL_SIZE) >= CELL_SIZE - 4 || (y % CELL_SIZE) >= CELL_SIZE - 4;
+            const Uint8 a = border ? 255 : (Uint8)SDL_max(0, 255 - d2 / 4);
+            SDL_WriteSurfacePixel(surface, x, y, (Uint8)(cell * 16), (Uint8)(255 - cell * 16), (Uint8)(x ^ y), a);
+        }
+    }
+
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+static int SDLCALL compare_ticks(const void *a, const void *b)
+{
+    const Uint64 left = *(const Uint64 *)a;
+    const Uint64 right = *(const Uint64 *)b;
+    return (left < right) ? -1 : (left > right) ? 1 : 0;
+}
+
+static double ticks_to_ms(Uint64 ticks)
+{
+    return (double)ticks * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static double percentile_ms(Uint64 *ticks, int count, int percent)
+{
+    return ticks_to_ms(ticks[SDL_min(count - 1, (count * percent) / 100)]);
+}
+
+static void log_histogram(const Uint64 *frame_ticks, int count)
+{
+    static const double limits[] = { 1.0, 2.0, 4.0, 8.0, 16.7, 33.3 };
+    int buckets[SDL_arraysize(limits) + 1];
+    int i, j;
+
+    SDL_zeroa(buckets);
+    for (i = 0; i < count; i++) {
+        const double ms = ticks_to_ms(frame_ticks[i]);
+        for (j = 0; j < SDL_arraysize(limits) && ms >= limits[j]; j++) {
+        }
+        buckets[j]++;
+    }
+
+    SDL_Log("    frame histogram: <1ms %d, <2ms %d, <4ms %d, <8ms %d, <16.7ms %d, <33.3ms %d, >=33.3ms %d",
+            buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5], buckets[6]);
+}
+
+static void run_scene(SceneContext *ctx, const Scene *scene, int warmup, int frames, SDL_bool histogram)
+{
+    Uint64 *record = (Uint64 *)SDL_malloc(frames * sizeof(Uint64));
+    Uint64 *present = (Uint64 *)SDL_malloc(frames * sizeof(Uint64));
+    Uint64 *frame = (Uint64 *)SDL_malloc(frames * sizeof(Uint64));
+    Uint64 total = 0;
+    int i;
+
+    if (!record || !present || !frame) {
+        SDL_Log("Out of memory");
+        goto done;
+    }
+
+    for (i = 0; i < warmup + frames; i++) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        Uint64 recorded, presented;
+
+        SDL_PumpEvents();
+
+        ctx->frame = i;
+        SDL_SetRenderDrawColor(ctx->renderer, 32, 32, 48, 255);
+        SDL_RenderClear(ctx->renderer);
+        scene->draw(ctx);
+        recorded = SDL_GetPerformanceCounter();
+
+        SDL_RenderPresent(ctx->renderer);
+        presented = SDL_GetPerformanceCounter();
+
+        if (i >= warmup) {
+            record[i - warmup] = recorded - start;
+            present[i - warmup] = presented - recorded;
+            frame[i - warmup] = presented - start;
+            total += presented - start;
+        }
+    }
+
+    SDL_qsort(record, frames, sizeof(Uint64), compare_ticks);
+    SDL_qsort(present, frames, sizeof(Uint64), compare_ticks);
+    SDL_qsort(frame, frames, sizeof(Uint64), compare_ticks);
+
+    SDL_Log("  %-12s %10.3f %10.3f %10.3f %10.3f %10.3f %9.1f", scene->name,
+            percentile_ms(record, frames, 50), percentile_ms(present, frames, 50),
+            percentile_ms(frame, frames, 50), percentile_ms(frame, frames, 99),
+            ticks_to_ms(frame[frames - 1]), frames / (ticks_to_ms(total) / 1000.0));
+    if (histogram) {
+        log_histogram(frame, frames);
+    }
+
+done:
+    SDL_free(record);
+    SDL_free(present);
+    SDL_free(frame);
+}
+
+static void run_driver(const char *driver, const char *scene_filter, int sprites, int warmup, int frames, SDL_bool histogram)
+{
+    SceneContext ctx;
+    SDL_Window *window;
+    int i;
+
+    SDL_zero(ctx);
+    window = SDL_CreateWindow("testrenderperf", WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_HIDDEN);
+    if (!window) {
+        SDL_Log("Couldn't create window: %s", SDL_GetError());
+        return;
+    }
+
+    ctx.renderer = SDL_CreateRenderer(window, driver);
+    if (!ctx.renderer) {
+        SDL_Log("Renderer '%s' unavailable: %s", driver, SDL_GetError());
+        SDL_DestroyWindow(window);
+        return;
+    }
+    SDL_SetRenderVSync(ctx.renderer, 0);
+
+    ctx.sprites = sprites;
+    ctx.atlas = create_atlas(ctx.renderer);
+    ctx.targets[0] = SDL_CreateTexture(ctx.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, ATLAS_SIZE, ATLAS_SIZE);
+    ctx.targets[1] = SDL_CreateTexture(ctx.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, ATLAS_SIZE, ATLAS_SIZE);
+    if (!ctx.atlas || !ctx.targets[0] || !ctx.targets[1]) {
+        SDL_Log("Couldn't create textures for '%s': %s", driver, SDL_GetError());
+    } else {
+        SDL_Log("Renderer '%s': %d sprites, %d frames after %d warmup frames (times in ms)", driver, sprites, frames, warmup);
+        SDL_Log("  %-12s %10s %10s %10s %10s %10s %9s", "scene", "record p50", "present p50", "frame p50", "frame p99", "frame max", "fps");
+        for (i = 0; i < SDL_arraysize(scenes); i++) {
+            if (!scene_filter || SDL_strcmp(scene_filter, scenes[i].name) == 0) {
+                run_scene(&ctx, &scenes[i], warmup, frames, histogram);
+            }
+        }
+    }
+
+    SDL_DestroyTexture(ctx.atlas);
+    SDL_DestroyTexture(ctx.targets[0]);
+    SDL_DestroyTexture(ctx.targets[1]);
+    SDLTest_CleanupTextDrawing();
+    SDL_DestroyRenderer(ctx.renderer);
+    SDL_DestroyWindow(window);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const char *driver_filter = NULL;
+    const char *scene_filter = NULL;
+    SDL_bool histogram = SDL_FALSE;
+    int sprites = 2000;
+    int warmup = 20;
+    int frames = 200;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--driver") == 0 && argv[i + 1]) {
+                driver_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--scene") == 0 && argv[i + 1]) {
+                scene_filter = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--sprites") == 0 && argv[i + 1]) {
+                sprites = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--warmup") == 0 && argv[i + 1]) {
+                warmup = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--histogram") == 0) {
+                histogram = SDL_TRUE;
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0 || sprites < 1 || warmup < 0 || frames < 1) {
+            static const char *options[] = {
+                "[--driver name]", "[--scene sprites|blendmodes|geometry|ninegrid|text|targets]",
+                "[--sprites N]", "[--warmup N]", "[--frames N]", "[--histogram]", NULL
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_Log("Couldn't initialize video: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    SDL_Log("Video driver: %s", SDL_GetCurrentVideoDriver());
+    for (i = 0; i < SDL_GetNumRenderDrivers(); i++) {
+        const char *driver = SDL_GetRenderDriver(i);
+        if (!driver_filter || SDL_strcmp(driver_filter, driver) == 0) {
+            run_driver(driver, scene_filter, sprites, warmup, frames, histogram);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
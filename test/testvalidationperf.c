@@ -0,0 +1,229 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the fixed cost that every API call pays before doing any real work:
+   validating renderer and texture handles, rejecting invalid ones, and the
+   error buffer functions that the failure paths go through. The renderer is
+   a software renderer on a surface, so no video driver is needed. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Calls made between checks of the clock */
+#define CALLS_PER_BATCH 64
+
+static int duration_ms = 200;
+
+static SDL_bool time_elapsed(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) >= (SDL_GetPerformanceFrequency() * duration_ms) / 1000;
+}
+
+static double elapsed_seconds(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static void log_result(const char *name, Uint64 start, Uint64 calls)
+{
+    SDL_Log("  %-40s %10.1f", name, (elapsed_seconds(start) * 1e9) / calls);
+}
+
+static void bench_validation(SDL_Renderer *renderer, SDL_Texture *texture1, SDL_Texture *texture2)
+{
+    Uint8 r, g, b, a;
+    float w, h;
+    Uint64 start, calls;
+    int i;
+
+    SDL_Log("Object validation cost:");
+    SDL_Log("  %-40s %10s", "call", "ns/call");
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_GetRenderDrawColor(renderer)", start, calls);
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_GetTextureSize(texture1, &w, &h);
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_GetTextureSize(texture)", start, calls);
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_GetTextureSize((i & 1) ? texture2 : texture1, &w, &h);
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_GetTextureSize(alternating textures)", start, calls);
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_GetRenderDrawColor(NULL, &r, &g, &b, &a);
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_GetRenderDrawColor(NULL)", start, calls);
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_GetRenderDrawColor((SDL_Renderer *)texture1, &r, &g, &b, &a);
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_GetRenderDrawColor(texture)", start, calls);
+}
+
+static void bench_errors(void)
+{
+    Uint64 start, calls;
+    int i;
+
+    SDL_Log("Error buffer cost:");
+    SDL_Log("  %-40s %10s", "call", "ns/call");
+
+    SDL_ClearError();
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_ClearError();
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_ClearError()", start, calls);
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_GetError();
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_GetError()", start, calls);
+
+    calls = 0;
+    start = SDL_GetPerformanceCounter();
+    while (!time_elapsed(start)) {
+        for (i = 0; i < CALLS_PER_BATCH; i++) {
+            SDL_SetError("Parameter '%s' is invalid", "renderer");
+        }
+        calls += CALLS_PER_BATCH;
+    }
+    log_result("SDL_SetError(\"...%s...\")", start, calls);
+    SDL_ClearError();
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *surface = NULL;
+    SDL_Renderer *renderer = NULL;
+    SDL_Texture *texture1 = NULL;
+    SDL_Texture *texture2 = NULL;
+    const char *only = NULL;
+    int result = 1;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration_ms = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--only") == 0 && argv[i + 1]) {
+                only = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || duration_ms < 1) {
+            static const char *options[] = { "[--duration ms]", "[--only validation|errors]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        goto done;
+    }
+
+    surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA8888);
+    if (!surface) {
+        SDL_Log("Couldn't create surface: %s", SDL_GetError());
+        goto done;
+    }
+    renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer) {
+        SDL_Log("Couldn't create renderer: %s", SDL_GetError());
+        goto done;
+    }
+    texture1 = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    texture2 = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    if (!texture1 || !texture2) {
+        SDL_Log("Couldn't create textures: %s", SDL_GetError());
+        goto done;
+    }
+
+    SDL_Log("Each measurement runs for at least %d ms", duration_ms);
+    if (!only || SDL_strcmp(only, "validation") == 0) {
+        bench_validation(renderer, texture1, texture2);
+    }
+    if (!only || SDL_strcmp(only, "errors") == 0) {
+        bench_errors();
+    }
+    result = 0;
+
+done:
+    if (texture2) {
+        SDL_DestroyTexture(texture2);
+    }
+    if (texture1) {
+        SDL_DestroyTexture(texture1);
+    }
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}